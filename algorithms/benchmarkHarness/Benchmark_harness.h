@@ -0,0 +1,284 @@
+#ifndef _BENCHMARK_HARNESS_H_
+#define _BENCHMARK_HARNESS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+
+    - bench::measure runs a function a few times to warm up, the caches, the branch
+      predictors, the pages of the buffers, then some more times, each one after a setup that
+      is not timed, e.g. a copy of the input for an algorithm that changes it, and keeps the
+      time of every one of them, their median, min and max.
+
+    - bench::Perf_events counts the cycles, the instructions and the misses of the last level
+      cache of the runs with perf_event_open, on linux, when the kernel lets it,
+      /proc/sys/kernel/perf_event_paranoid of at most 2, or in a container that allows the
+      syscall. without them the counts of a Result are not available, the times are.
+
+    - the results print as a line of a table, or all of them as json, an array of objects
+      with the algorithm, the version, the size, the times in ns, the ns per element and the
+      counts per run, or null, for a dashboard that keeps them over time.
+
+    - bench::do_not_optimize(value) keeps the compiler from throwing away a result that is
+      never used, or the loop that computes it.
+
+*/
+namespace bench
+{
+    struct Options
+    {
+        std::size_t warmup {2};
+        std::size_t repetitions {9};
+    };
+
+    struct Counters
+    {
+        bool available {false};
+        std::uint64_t cycles {0};
+        std::uint64_t instructions {0};
+        std::uint64_t cache_misses {0};
+    };
+
+    struct Result
+    {
+        std::string algorithm;
+        std::string version;
+        std::size_t n {0};
+        double median_ns {0.0};
+        double min_ns {0.0};
+        double max_ns {0.0};
+        // the mean of the runs
+        Counters counters;
+
+        double ns_per_element() const { return this->n == 0 ? this->median_ns : this->median_ns / static_cast<double>(this->n); }
+    };
+
+    template<class T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    class Perf_events
+    {
+    private:
+#if defined(__linux__)
+        int fds[3] {-1, -1, -1};
+
+        static int open(std::uint64_t config, int group)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = group == -1 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+
+    public:
+        Perf_events()
+        {
+#if defined(__linux__)
+            this->fds[0] = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+            if (this->fds[0] == -1)
+                return;
+            this->fds[1] = open(PERF_COUNT_HW_INSTRUCTIONS, this->fds[0]);
+            this->fds[2] = open(PERF_COUNT_HW_CACHE_MISSES, this->fds[0]);
+            if (this->fds[1] == -1 || this->fds[2] == -1)
+                this->close();
+#endif
+        }
+
+        Perf_events(const Perf_events&) = delete;
+        Perf_events& operator=(const Perf_events&) = delete;
+
+        ~Perf_events() { this->close(); }
+
+        bool available() const
+        {
+#if defined(__linux__)
+            return this->fds[0] != -1;
+#else
+            return false;
+#endif
+        }
+
+        void start()
+        {
+#if defined(__linux__)
+            if (!this->available())
+                return;
+            ioctl(this->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(this->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        Counters stop()
+        {
+            Counters counters;
+#if defined(__linux__)
+            if (!this->available())
+                return counters;
+            ioctl(this->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            // the number of events, then their values, in the order they were opened
+            std::uint64_t values[4] {};
+            if (read(this->fds[0], values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) && values[0] == 3)
+                counters = Counters {true, values[1], values[2], values[3]};
+#endif
+            return counters;
+        }
+
+    private:
+        void close()
+        {
+#if defined(__linux__)
+            for (int& fd : this->fds)
+                if (fd != -1)
+                    ::close(std::exchange(fd, -1));
+#endif
+        }
+    };
+
+    // the times of f(), each run after setup()
+    template<class Setup, class F>
+    Result measure(std::string algorithm, std::string version, std::size_t n, const Options& options, Perf_events& events, Setup setup, F f)
+    {
+        std::vector<double> times;
+        times.reserve(options.repetitions);
+        Counters total {events.available()};
+        for (std::size_t run = 0; run < options.warmup + options.repetitions; ++run)
+        {
+            setup();
+            events.start();
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto end = std::chrono::steady_clock::now();
+            const Counters counters = events.stop();
+            if (run < options.warmup)
+                continue;
+            times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            total.available = total.available && counters.available;
+            total.cycles += counters.cycles;
+            total.instructions += counters.instructions;
+            total.cache_misses += counters.cache_misses;
+        }
+
+        Result result {std::move(algorithm), std::move(version), n, 0.0, 0.0, 0.0, {}};
+        if (times.empty())
+            return result;
+        std::sort(times.begin(), times.end());
+        const std::size_t middle = times.size() / 2;
+        result.median_ns = times.size() % 2 == 1 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+        result.min_ns = times.front();
+        result.max_ns = times.back();
+        if (total.available)
+        {
+            const std::uint64_t runs = times.size();
+            result.counters = Counters {true, total.cycles / runs, total.instructions / runs, total.cache_misses / runs};
+        }
+        return result;
+    }
+
+    template<class F>
+    Result measure(std::string algorithm, std::string version, std::size_t n, const Options& options, Perf_events& events, F f)
+    {
+        return measure(std::move(algorithm), std::move(version), n, options, events, [] {}, f);
+    }
+
+    inline void print_header(std::ostream& os, bool counters)
+    {
+        os << std::setw(20) << std::left << "algorithm" << std::setw(12) << "version" << std::setw(12) << std::right << "n"
+           << std::setw(14) << "median ns" << std::setw(12) << "ns/element";
+        if (counters)
+            os << std::setw(10) << "ipc" << std::setw(14) << "misses/elem";
+        os << std::endl;
+    }
+
+    // the line of the result, with how many times the time of base it takes
+    inline void print(std::ostream& os, const Result& result, const Result* base = nullptr)
+    {
+        os << std::setw(20) << std::left << result.algorithm << std::setw(12) << result.version << std::setw(12) << std::right << result.n
+           << std::fixed << std::setprecision(0) << std::setw(14) << result.median_ns
+           << std::setprecision(3) << std::setw(12) << result.ns_per_element();
+        if (result.counters.available)
+        {
+            const double ipc = result.counters.cycles == 0 ? 0.0 : static_cast<double>(result.counters.instructions) / result.counters.cycles;
+            os << std::setprecision(2) << std::setw(10) << ipc
+               << std::setprecision(4) << std::setw(14) << static_cast<double>(result.counters.cache_misses) / std::max<std::size_t>(1, result.n);
+        }
+        if (base != nullptr && base != &result && result.median_ns > 0)
+            os << std::setprecision(2) << "    x" << base->median_ns / result.median_ns;
+        os << std::endl;
+    }
+
+    namespace detail
+    {
+        inline std::string quoted(const std::string& s)
+        {
+            std::string out {"\""};
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    out += {'\\', c};
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out += escape;
+                }
+                else
+                    out += c;
+            }
+            return out + '"';
+        }
+    }
+
+    inline void write_json(std::ostream& os, const std::vector<Result>& results)
+    {
+        os << "[\n";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            os << "  {\"algorithm\": " << detail::quoted(r.algorithm) << ", \"version\": " << detail::quoted(r.version)
+               << ", \"n\": " << r.n << std::fixed << std::setprecision(1)
+               << ", \"median_ns\": " << r.median_ns << ", \"min_ns\": " << r.min_ns << ", \"max_ns\": " << r.max_ns
+               << std::setprecision(4) << ", \"ns_per_element\": " << r.ns_per_element();
+            if (r.counters.available)
+                os << ", \"cycles\": " << r.counters.cycles << ", \"instructions\": " << r.counters.instructions
+                   << ", \"cache_misses\": " << r.counters.cache_misses;
+            else
+                os << ", \"cycles\": null, \"instructions\": null, \"cache_misses\": null";
+            os << (i + 1 < results.size() ? "},\n" : "}\n");
+        }
+        os << "]\n";
+    }
+}
+
+#endif
@@ -0,0 +1,477 @@
+/*
+
+    - runs the algorithms of ../nonModifyingSequenceOperations and ../modifyingSequenceOperations
+      against the std ones, and against the ones of ../simdAlgorithms, ../searchers,
+      ../parallelAlgorithms, ../compaction, ../blockAlgorithms and ../shuffling where there is
+      one, on vectors of ints of some sizes, and prints the median of the runs, with the ipc
+      and the misses of the cache where perf_event_open is allowed, and how many times faster
+      than std every one is.
+
+    - the index.cpp of every algorithm is included in a namespace of its own, local_count_if,
+      local_search, ..., so it is its template that runs, with the std headers included before,
+      so they are not in the namespace. their main is never called. some of them use C++20,
+      so it is built with it:
+        g++ -std=c++20 -O2 -pthread index.cpp ../simdAlgorithms/Simd_algorithms.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - the options, all of them can be left out:
+        ./a.out --sizes 1000,100000,10000000 --warmup 2 --repetitions 9 --filter count --json results.json
+      --filter runs the algorithms with the text in the name, --json writes all of the results
+      to the file, for the dashboards.
+
+*/
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../fastRandom/Fast_random.h"
+#include "Benchmark_harness.h"
+#include "../blockAlgorithms/Block_algorithms.h"
+#include "../compaction/Compaction.h"
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../searchers/Searchers.h"
+#include "../shuffling/Parallel_shuffle.h"
+#include "../simdAlgorithms/Simd_algorithms.h"
+
+// the main of every one of them has no return, it is not the main of the program
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+namespace local_adjacent_find {
+#include "../nonModifyingSequenceOperations/adjacent_find/index.cpp"
+}
+namespace local_all_of {
+#include "../nonModifyingSequenceOperations/all_of/index.cpp"
+}
+namespace local_any_of {
+#include "../nonModifyingSequenceOperations/any_of/index.cpp"
+}
+namespace local_count {
+#include "../nonModifyingSequenceOperations/count/index.cpp"
+}
+namespace local_count_if {
+#include "../nonModifyingSequenceOperations/count_if/index.cpp"
+}
+namespace local_equal {
+#include "../nonModifyingSequenceOperations/equal/index.cpp"
+}
+namespace local_find {
+#include "../nonModifyingSequenceOperations/find/index.cpp"
+}
+namespace local_find_end {
+#include "../nonModifyingSequenceOperations/find_end/index.cpp"
+}
+namespace local_find_first_of {
+#include "../nonModifyingSequenceOperations/find_first_of/index.cpp"
+}
+namespace local_find_if {
+#include "../nonModifyingSequenceOperations/find_if/index.cpp"
+}
+namespace local_find_if_not {
+#include "../nonModifyingSequenceOperations/find_if_not/index.cpp"
+}
+namespace local_for_each {
+#include "../nonModifyingSequenceOperations/for_each/index.cpp"
+}
+namespace local_for_each_n {
+#include "../nonModifyingSequenceOperations/for_each_n/index.cpp"
+}
+namespace local_mismatch {
+#include "../nonModifyingSequenceOperations/mismatch/index.cpp"
+}
+namespace local_none_of {
+#include "../nonModifyingSequenceOperations/none_of/index.cpp"
+}
+namespace local_search {
+#include "../nonModifyingSequenceOperations/search/index.cpp"
+}
+namespace local_search_n {
+#include "../nonModifyingSequenceOperations/search_n/index.cpp"
+}
+namespace local_copy {
+#include "../modifyingSequenceOperations/copy/index.cpp"
+}
+namespace local_copy_backward {
+#include "../modifyingSequenceOperations/copy_backward/index.cpp"
+}
+namespace local_copy_if {
+#include "../modifyingSequenceOperations/copy_if/index.cpp"
+}
+namespace local_copy_n {
+#include "../modifyingSequenceOperations/copy_n/index.cpp"
+}
+namespace local_fill {
+#include "../modifyingSequenceOperations/fill/index.cpp"
+}
+namespace local_fill_n {
+#include "../modifyingSequenceOperations/fill_n/index.cpp"
+}
+namespace local_generate {
+#include "../modifyingSequenceOperations/generate/index.cpp"
+}
+namespace local_generate_n {
+#include "../modifyingSequenceOperations/generate_n/index.cpp"
+}
+namespace local_move {
+#include "../modifyingSequenceOperations/move/index.cpp"
+}
+namespace local_move_backward {
+#include "../modifyingSequenceOperations/move_backward/index.cpp"
+}
+namespace local_random_shuffle {
+#include "../modifyingSequenceOperations/random_shuffle/index.cpp"
+}
+namespace local_remove {
+#include "../modifyingSequenceOperations/remove/index.cpp"
+}
+namespace local_remove_copy {
+#include "../modifyingSequenceOperations/remove_copy/index.cpp"
+}
+namespace local_remove_copy_if {
+#include "../modifyingSequenceOperations/remove_copy_if/index.cpp"
+}
+namespace local_remove_if {
+#include "../modifyingSequenceOperations/remove_if/index.cpp"
+}
+namespace local_replace {
+#include "../modifyingSequenceOperations/replace/index.cpp"
+}
+namespace local_replace_copy {
+#include "../modifyingSequenceOperations/replace_copy/index.cpp"
+}
+namespace local_replace_copy_if {
+#include "../modifyingSequenceOperations/replace_copy_if/index.cpp"
+}
+namespace local_replace_if {
+#include "../modifyingSequenceOperations/replace_if/index.cpp"
+}
+namespace local_reverse {
+#include "../modifyingSequenceOperations/reverse/index.cpp"
+}
+namespace local_reverse_copy {
+#include "../modifyingSequenceOperations/reverse_copy/index.cpp"
+}
+namespace local_rotate {
+#include "../modifyingSequenceOperations/rotate/index.cpp"
+}
+namespace local_rotate_copy {
+#include "../modifyingSequenceOperations/rotate_copy/index.cpp"
+}
+namespace local_shuffle {
+#include "../modifyingSequenceOperations/shuffle/index.cpp"
+}
+namespace local_swap_ranges {
+#include "../modifyingSequenceOperations/swap_ranges/index.cpp"
+}
+namespace local_transform {
+#include "../modifyingSequenceOperations/transform/index.cpp"
+}
+namespace local_unique {
+#include "../modifyingSequenceOperations/unique/index.cpp"
+}
+#pragma GCC diagnostic pop
+
+using Ints = std::vector<int>;
+
+struct Suite
+{
+    bench::Options options;
+    bench::Perf_events events;
+    std::string filter;
+    std::vector<bench::Result> results;
+
+    // the std version, then the local one, then, if there is one, the optimized one, with
+    // the name of where it is from, every run after setup
+    template<class Setup, class Std, class Local>
+    void compare(const std::string& algorithm, std::size_t n, Setup setup, Std std_version, Local local_version)
+    {
+        this->compare(algorithm, n, setup, std_version, local_version, "", [] { return 0; });
+    }
+
+    template<class Setup, class Std, class Local, class Optimized>
+    void compare(const std::string& algorithm, std::size_t n, Setup setup, Std std_version, Local local_version,
+                 const std::string& optimized_name, Optimized optimized_version)
+    {
+        if (algorithm.find(this->filter) == std::string::npos)
+            return;
+        const auto run = [&](const char* version, auto f)
+        {
+            this->results.push_back(bench::measure(algorithm, version, n, this->options, this->events, setup, [&f] { bench::do_not_optimize(f()); }));
+        };
+        const std::size_t base = this->results.size();
+        run("std", std_version);
+        run("local", local_version);
+        if (!optimized_name.empty())
+            run(optimized_name.c_str(), optimized_version);
+        for (std::size_t i = base; i < this->results.size(); ++i)
+            bench::print(std::cout, this->results[i], &this->results[base]);
+    }
+};
+
+std::vector<std::size_t> parse_sizes(const std::string& text)
+{
+    std::vector<std::size_t> sizes;
+    std::stringstream ss {text};
+    for (std::string size; std::getline(ss, size, ',');)
+        sizes.push_back(std::strtoul(size.c_str(), nullptr, 10));
+    return sizes;
+}
+
+void run_all(Suite& suite, std::size_t n)
+{
+    const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(n);
+    fast_random::Xoshiro256ss gen {n};
+    fast_random::Uniform_int<int> values {0, 999};
+    fast_random::Uniform_int<int> few {0, 3};
+
+    // values in [0, 1000), they are found at random, half of them are less than 500
+    Ints data(n);
+    for (int& x : data)
+        x = values(gen);
+    Ints duplicates(n);
+    for (int& x : duplicates)
+        x = few(gen);
+    Ints increasing(n);
+    std::iota(increasing.begin(), increasing.end(), 0);
+    const Ints same {data};
+    // the needles are in none of them, so all of the range is looked at
+    const Ints needle {1, 2, 3, 4, 5, 6, 7, 1000};
+    const Ints absent {-1, -2, -3, -4};
+    const auto less_than_500 = [](int x) { return x < 500; };
+    const auto absent_value = [](int x) { return x < 0; };
+    const auto present_value = [](int x) { return x >= 0; };
+    const auto twice_plus_one = [](int x) { return 2 * x + 1; };
+
+    Ints work(n);
+    Ints out(n);
+    const auto reset = [&] { std::copy(data.begin(), data.end(), work.begin()); };
+    const auto reset_duplicates = [&] { std::copy(duplicates.begin(), duplicates.end(), work.begin()); };
+    const auto nothing = [] {};
+    const auto position = [&](Ints::const_iterator it) { return it - data.cbegin(); };
+
+    suite.compare("adjacent_find", n, nothing,
+        [&] { return std::adjacent_find(increasing.cbegin(), increasing.cend()) - increasing.cbegin(); },
+        [&] { return local_adjacent_find::adjacent_find(increasing.cbegin(), increasing.cend()) - increasing.cbegin(); });
+    suite.compare("all_of", n, nothing,
+        [&] { return std::all_of(data.cbegin(), data.cend(), present_value); },
+        [&] { return local_all_of::all_of(data.cbegin(), data.cend(), present_value); },
+        "par", [&] { return parallel::all_of(parallel::par, data.cbegin(), data.cend(), present_value); });
+    suite.compare("any_of", n, nothing,
+        [&] { return std::any_of(data.cbegin(), data.cend(), absent_value); },
+        [&] { return local_any_of::any_of(data.cbegin(), data.cend(), absent_value); },
+        "par", [&] { return parallel::any_of(parallel::par, data.cbegin(), data.cend(), absent_value); });
+    suite.compare("none_of", n, nothing,
+        [&] { return std::none_of(data.cbegin(), data.cend(), absent_value); },
+        [&] { return local_none_of::none_of(data.cbegin(), data.cend(), absent_value); },
+        "par", [&] { return parallel::none_of(parallel::par, data.cbegin(), data.cend(), absent_value); });
+    suite.compare("count", n, nothing,
+        [&] { return std::count(data.cbegin(), data.cend(), 7); },
+        [&] { return local_count::count(data.cbegin(), data.cend(), 7); },
+        "simd", [&] { return simd::count(data.cbegin(), data.cend(), 7); });
+    suite.compare("count_if", n, nothing,
+        [&] { return std::count_if(data.cbegin(), data.cend(), less_than_500); },
+        [&] { return local_count_if::count_if(data.cbegin(), data.cend(), less_than_500); },
+        "par", [&] { return parallel::count_if(parallel::par, data.cbegin(), data.cend(), less_than_500); });
+    suite.compare("equal", n, nothing,
+        [&] { return std::equal(data.cbegin(), data.cend(), same.cbegin()); },
+        [&] { return local_equal::equal(data.cbegin(), data.cend(), same.cbegin()); },
+        "simd", [&] { return simd::equal(data.cbegin(), data.cend(), same.cbegin()); });
+    suite.compare("mismatch", n, nothing,
+        [&] { return position(std::mismatch(data.cbegin(), data.cend(), same.cbegin()).first); },
+        [&] { return position(local_mismatch::mismatch(data.cbegin(), data.cend(), same.cbegin()).first); },
+        "simd", [&] { return position(simd::mismatch(data.cbegin(), data.cend(), same.cbegin()).first); });
+    suite.compare("find", n, nothing,
+        [&] { return position(std::find(data.cbegin(), data.cend(), -1)); },
+        [&] { return position(local_find::find(data.cbegin(), data.cend(), -1)); },
+        "simd", [&] { return position(simd::find(data.cbegin(), data.cend(), -1)); });
+    suite.compare("find_if", n, nothing,
+        [&] { return position(std::find_if(data.cbegin(), data.cend(), absent_value)); },
+        [&] { return position(local_find_if::find_if(data.cbegin(), data.cend(), absent_value)); },
+        "par", [&] { return position(parallel::find_if(parallel::par, data.cbegin(), data.cend(), absent_value)); });
+    suite.compare("find_if_not", n, nothing,
+        [&] { return position(std::find_if_not(data.cbegin(), data.cend(), present_value)); },
+        [&] { return position(local_find_if_not::find_if_not(data.cbegin(), data.cend(), present_value)); },
+        "par", [&] { return position(parallel::find_if_not(parallel::par, data.cbegin(), data.cend(), present_value)); });
+    suite.compare("find_first_of", n, nothing,
+        [&] { return position(std::find_first_of(data.cbegin(), data.cend(), absent.cbegin(), absent.cend())); },
+        [&] { return position(local_find_first_of::find_first_of(data.cbegin(), data.cend(), absent.cbegin(), absent.cend())); });
+    suite.compare("search", n, nothing,
+        [&] { return position(std::search(data.cbegin(), data.cend(), needle.cbegin(), needle.cend())); },
+        [&] { return position(local_search::search(data.cbegin(), data.cend(), needle.cbegin(), needle.cend())); },
+        "searchers", [&] { return position(searchers::search(data.cbegin(), data.cend(), needle.cbegin(), needle.cend())); });
+    suite.compare("find_end", n, nothing,
+        [&] { return position(std::find_end(data.cbegin(), data.cend(), needle.cbegin(), needle.cend())); },
+        [&] { return position(local_find_end::find_end(data.cbegin(), data.cend(), needle.cbegin(), needle.cend())); },
+        "searchers", [&] { return position(searchers::find_end(data.cbegin(), data.cend(), needle.cbegin(), needle.cend())); });
+    suite.compare("search_n", n, nothing,
+        [&] { return position(std::search_n(data.cbegin(), data.cend(), 4, 1000)); },
+        [&] { return position(local_search_n::search_n(data.cbegin(), data.cend(), 4, 1000)); },
+        "searchers", [&] { return position(searchers::search_n(data.cbegin(), data.cend(), 4, 1000)); });
+    suite.compare("for_each", n, reset,
+        [&] { std::for_each(work.begin(), work.end(), [](int& x) { x += 1; }); return work.back(); },
+        [&] { local_for_each::for_each(work.begin(), work.end(), [](int& x) { x += 1; }); return work.back(); },
+        "par", [&] { parallel::for_each(parallel::par, work.begin(), work.end(), [](int& x) { x += 1; }); return work.back(); });
+    suite.compare("for_each_n", n, reset,
+        [&] { return std::for_each_n(work.begin(), size, [](int& x) { x += 1; }) - work.begin(); },
+        [&] { return local_for_each_n::for_each_n(work.begin(), size, [](int& x) { x += 1; }) - work.begin(); });
+
+    suite.compare("copy", n, nothing,
+        [&] { return std::copy(data.cbegin(), data.cend(), out.begin()) - out.begin(); },
+        [&] { return local_copy::copy(data.cbegin(), data.cend(), out.begin()) - out.begin(); });
+    suite.compare("copy_backward", n, nothing,
+        [&] { return std::copy_backward(data.cbegin(), data.cend(), out.end()) - out.begin(); },
+        [&] { return local_copy_backward::copy_backward(data.cbegin(), data.cend(), out.end()) - out.begin(); });
+    suite.compare("copy_n", n, nothing,
+        [&] { return std::copy_n(data.cbegin(), size, out.begin()) - out.begin(); },
+        [&] { return local_copy_n::copy_n(data.cbegin(), size, out.begin()) - out.begin(); });
+    suite.compare("copy_if", n, nothing,
+        [&] { return std::copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500) - out.begin(); },
+        [&] { return local_copy_if::copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500) - out.begin(); },
+        "compaction", [&] { return compaction::copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500) - out.begin(); });
+    suite.compare("move", n, reset,
+        [&] { return std::move(work.begin(), work.end(), out.begin()) - out.begin(); },
+        [&] { return local_move::move(work.begin(), work.end(), out.begin()) - out.begin(); });
+    suite.compare("move_backward", n, reset,
+        [&] { return std::move_backward(work.begin(), work.end(), out.end()) - out.begin(); },
+        [&] { return local_move_backward::move_backward(work.begin(), work.end(), out.end()) - out.begin(); });
+    suite.compare("fill", n, nothing,
+        [&] { std::fill(out.begin(), out.end(), 42); return out.back(); },
+        [&] { local_fill::fill(out.begin(), out.end(), 42); return out.back(); },
+        "par", [&] { parallel::fill(parallel::par, out.begin(), out.end(), 42); return out.back(); });
+    suite.compare("fill_n", n, nothing,
+        [&] { return std::fill_n(out.begin(), size, 42) - out.begin(); },
+        [&] { return local_fill_n::fill_n(out.begin(), size, 42) - out.begin(); });
+    suite.compare("generate", n, nothing,
+        [&] { int i {0}; std::generate(out.begin(), out.end(), [&i] { return i++; }); return out.back(); },
+        [&] { int i {0}; local_generate::generate(out.begin(), out.end(), [&i] { return i++; }); return out.back(); });
+    suite.compare("generate_n", n, nothing,
+        [&] { int i {0}; return std::generate_n(out.begin(), size, [&i] { return i++; }) - out.begin(); },
+        [&] { int i {0}; return local_generate_n::generate_n(out.begin(), size, [&i] { return i++; }) - out.begin(); });
+    suite.compare("transform", n, nothing,
+        [&] { return std::transform(data.cbegin(), data.cend(), out.begin(), twice_plus_one) - out.begin(); },
+        [&] { return local_transform::transform(data.cbegin(), data.cend(), out.begin(), twice_plus_one) - out.begin(); },
+        "par", [&] { return parallel::transform(parallel::par, data.cbegin(), data.cend(), out.begin(), twice_plus_one) - out.begin(); });
+    suite.compare("replace", n, reset,
+        [&] { std::replace(work.begin(), work.end(), 7, 0); return work.back(); },
+        [&] { local_replace::replace(work.begin(), work.end(), 7, 0); return work.back(); },
+        "par", [&] { parallel::replace(parallel::par, work.begin(), work.end(), 7, 0); return work.back(); });
+    suite.compare("replace_if", n, reset,
+        [&] { std::replace_if(work.begin(), work.end(), less_than_500, 0); return work.back(); },
+        [&] { local_replace_if::replace_if(work.begin(), work.end(), less_than_500, 0); return work.back(); },
+        "par", [&] { parallel::replace_if(parallel::par, work.begin(), work.end(), less_than_500, 0); return work.back(); });
+    suite.compare("replace_copy", n, nothing,
+        [&] { return std::replace_copy(data.cbegin(), data.cend(), out.begin(), 7, 0) - out.begin(); },
+        [&] { return local_replace_copy::replace_copy(data.cbegin(), data.cend(), out.begin(), 7, 0) - out.begin(); });
+    suite.compare("replace_copy_if", n, nothing,
+        [&] { return std::replace_copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500, 0) - out.begin(); },
+        [&] { return local_replace_copy_if::replace_copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500, 0) - out.begin(); });
+    suite.compare("remove", n, reset,
+        [&] { return std::remove(work.begin(), work.end(), 7) - work.begin(); },
+        [&] { return local_remove::remove(work.begin(), work.end(), 7) - work.begin(); },
+        "compaction", [&] { return compaction::remove(work.begin(), work.end(), 7) - work.begin(); });
+    suite.compare("remove_if", n, reset,
+        [&] { return std::remove_if(work.begin(), work.end(), less_than_500) - work.begin(); },
+        [&] { return local_remove_if::remove_if(work.begin(), work.end(), less_than_500) - work.begin(); },
+        "compaction", [&] { return compaction::remove_if(work.begin(), work.end(), less_than_500) - work.begin(); });
+    suite.compare("remove_copy", n, nothing,
+        [&] { return std::remove_copy(data.cbegin(), data.cend(), out.begin(), 7) - out.begin(); },
+        [&] { return local_remove_copy::remove_copy(data.cbegin(), data.cend(), out.begin(), 7) - out.begin(); });
+    suite.compare("remove_copy_if", n, nothing,
+        [&] { return std::remove_copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500) - out.begin(); },
+        [&] { return local_remove_copy_if::remove_copy_if(data.cbegin(), data.cend(), out.begin(), less_than_500) - out.begin(); });
+    suite.compare("unique", n, reset_duplicates,
+        [&] { return std::unique(work.begin(), work.end()) - work.begin(); },
+        [&] { return local_unique::unique(work.begin(), work.end()) - work.begin(); },
+        "compaction", [&] { return compaction::unique(work.begin(), work.end()) - work.begin(); });
+    suite.compare("reverse", n, reset,
+        [&] { std::reverse(work.begin(), work.end()); return work.back(); },
+        [&] { local_reverse::reverse(work.begin(), work.end()); return work.back(); },
+        "block", [&] { block::reverse(work.begin(), work.end()); return work.back(); });
+    suite.compare("reverse_copy", n, nothing,
+        [&] { return std::reverse_copy(data.cbegin(), data.cend(), out.begin()) - out.begin(); },
+        [&] { return local_reverse_copy::reverse_copy(data.cbegin(), data.cend(), out.begin()) - out.begin(); });
+    // the local rotate calls rotate on its iterators, it is std::rotate too for the ones of a vector
+    suite.compare("rotate", n, reset,
+        [&] { return std::rotate(work.begin(), work.begin() + size / 3, work.end()) - work.begin(); },
+        [&] { return local_rotate::rotate(work.data(), work.data() + size / 3, work.data() + size) - work.data(); },
+        "block", [&] { return block::rotate(work.begin(), work.begin() + size / 3, work.end()) - work.begin(); });
+    suite.compare("rotate_copy", n, nothing,
+        [&] { return std::rotate_copy(data.cbegin(), data.cbegin() + size / 3, data.cend(), out.begin()) - out.begin(); },
+        [&] { return local_rotate_copy::rotate_copy(data.cbegin(), data.cbegin() + size / 3, data.cend(), out.begin()) - out.begin(); },
+        "block par", [&] { return block::rotate_copy(parallel::par, data.cbegin(), data.cbegin() + size / 3, data.cend(), out.begin()) - out.begin(); });
+    suite.compare("swap_ranges", n, reset,
+        [&] { return std::swap_ranges(work.begin(), work.begin() + size / 2, work.begin() + size / 2) - work.begin(); },
+        [&] { return local_swap_ranges::swap_ranges(work.begin(), work.begin() + size / 2, work.begin() + size / 2) - work.begin(); },
+        "block", [&] { return block::swap_ranges(work.begin(), work.begin() + size / 2, work.begin() + size / 2) - work.begin(); });
+    suite.compare("shuffle", n, reset,
+        [&] { std::mt19937_64 g {1}; std::shuffle(work.begin(), work.end(), g); return work.back(); },
+        [&] { std::mt19937_64 g {1}; local_shuffle::shuffle(work.begin(), work.end(), g); return work.back(); },
+        "shuffling", [&] { shuffling::shuffle(parallel::par, work.begin(), work.end(), 1); return work.back(); });
+    suite.compare("random_shuffle", n, reset,
+        [&] { fast_random::Xoshiro256ss g {1}; fast_random::shuffle(work.begin(), work.end(), g); return work.back(); },
+        [&] { local_random_shuffle::random_shuffle(work.begin(), work.end()); return work.back(); });
+}
+
+int main(int argc, char* argv[])
+{
+    Suite suite;
+    std::vector<std::size_t> sizes {1'000, 100'000, 10'000'000};
+    std::string json;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string option {argv[i]};
+        if (option == "--sizes")
+            sizes = parse_sizes(argv[i + 1]);
+        else if (option == "--warmup")
+            suite.options.warmup = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (option == "--repetitions")
+            suite.options.repetitions = std::max<std::size_t>(1, std::strtoul(argv[i + 1], nullptr, 10));
+        else if (option == "--filter")
+            suite.filter = argv[i + 1];
+        else if (option == "--json")
+            json = argv[i + 1];
+        else
+        {
+            std::cerr << "unknown option " << option << '\n';
+            return 1;
+        }
+    }
+
+    std::cout << "simd: " << simd::instruction_set() << ", threads: " << std::thread::hardware_concurrency()
+              << (suite.events.available() ? "" : ", no hardware counters") << std::endl;
+    bench::print_header(std::cout, suite.events.available());
+    for (std::size_t n : sizes)
+        run_all(suite, n);
+
+    if (!json.empty())
+    {
+        std::ofstream file {json};
+        bench::write_json(file, suite.results);
+        if (!file)
+        {
+            std::cerr << "cannot write " << json << '\n';
+            return 1;
+        }
+    }
+
+    return 0;
+}
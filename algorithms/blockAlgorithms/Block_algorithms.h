@@ -0,0 +1,696 @@
+#ifndef _BLOCK_ALGORITHMS_H_
+#define _BLOCK_ALGORITHMS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+/*
+
+    - reverse, swap_ranges, rotate, rotate_copy, shift_left and shift_right of
+      ../modifyingSequenceOperations, with the signatures of the std ones, that move blocks
+      of memory, not one element at a time, when the range is contiguous, a pointer, or an
+      iterator of std::vector or std::basic_string, of trivially copyable elements. the other
+      ranges run the std algorithm, or a std::move for the shifts, that are C++20.
+
+    - reverse swaps 16 or 32 bytes of the front with as many of the back, with the lanes of
+      the vectors swizzled in reverse, with AVX2 or SSE2, for elements of 1, 2, 4 or 8 bytes.
+      swap_ranges swaps blocks of 256 bytes through a buffer on the stack.
+
+    - rotate moves the shorter side to a buffer, the longer one over with memmove, and the
+      shorter one back, when the shorter side is at most rotate_buffer_bytes. a longer one is
+      swapped, in blocks, with the end of the other side, Gries-Mills, that puts it in its
+      place and leaves a rotate of a smaller range, until the shorter side fits the buffer.
+      the swaps and the moves go through the memory in order, not in the cycles of the gcd of
+      the sides, that jump all over it.
+
+    - copy, copy_n, copy_backward, move and move_backward of the same ranges, when both sides
+      are of the same elements, and a const_iterator is a source too, are one memmove, fill
+      and fill_n a memset when the bytes of the value are all the same, or stores of a vector
+      of it repeated, or copies of the elements already filled. a fill of more bytes than
+      the last level cache, non_temporal_bytes(), goes around the cache with streaming
+      stores, it would only push out of it what is used again. memmove of glibc does that
+      already for a large copy, faster than streaming stores of a vector at a time. the
+      other ranges, a back_inserter or elements that are not trivial, run the std algorithm.
+
+    - the overloads with an execution policy of ../parallelAlgorithms first split the range in
+      chunks that run as tasks of a Work_stealing_pool: the pairs of the front and of the back
+      for reverse, the blocks of the swaps and the copies. a shift, and the memmove of a
+      rotate, copies the first elements of the source of every chunk, that the chunk before
+      it writes over, to a buffer first, then every chunk moves the rest of its part and puts
+      them back, when the shift is less than a quarter of a chunk, or copies the chunks at
+      once when the source and the destination do not overlap.
+
+*/
+namespace block
+{
+    inline constexpr std::size_t rotate_buffer_bytes {1 << 20};
+
+    // the size of the last level cache, 32 MB when the system does not say
+    inline std::size_t non_temporal_bytes()
+    {
+        static const std::size_t bytes = []
+        {
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+            const long size = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+            if (size > 0)
+                return static_cast<std::size_t>(size);
+#endif
+            return std::size_t {32} << 20;
+        }();
+        return bytes;
+    }
+
+    namespace detail
+    {
+        template<class It>
+        using Value_type = typename std::iterator_traits<It>::value_type;
+
+        template<class It, class = void>
+        struct Contiguous : std::false_type {};
+
+        template<class T>
+        struct Contiguous<T*> : std::true_type {};
+
+        // an output iterator, a back_inserter, has a value_type of void, it is not a range of memory
+        template<class It>
+        using Is_element_iterator = std::enable_if_t<!std::is_pointer_v<It> && !std::is_void_v<Value_type<It>>
+            && !std::is_same_v<Value_type<It>, bool>>;
+
+        template<class It>
+        struct Contiguous<It, Is_element_iterator<It>>
+        {
+            using value_type = Value_type<It>;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || (std::is_same_v<value_type, char> && std::is_same_v<It, std::string::iterator>);
+        };
+
+        // a range that is only read from, a const_iterator too
+        template<class It, class = void>
+        struct Contiguous_source : Contiguous<It> {};
+
+        template<class It>
+        struct Contiguous_source<It, Is_element_iterator<It>>
+        {
+            using value_type = Value_type<It>;
+
+            static constexpr bool value = Contiguous<It>::value
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>
+                || (std::is_same_v<value_type, char> && std::is_same_v<It, std::string::const_iterator>);
+        };
+
+        template<class It>
+        constexpr bool is_block = Contiguous<It>::value && std::is_trivially_copyable_v<Value_type<It>>
+            && !std::is_const_v<std::remove_reference_t<typename std::iterator_traits<It>::reference>>;
+
+        // a copy from InputIt to OutputIt is a memmove, the elements are the same trivial type, an
+        // assignment of one is a copy of its bytes
+        template<class InputIt, class OutputIt>
+        constexpr bool is_block_copy = Contiguous_source<InputIt>::value && is_block<OutputIt>
+            && std::is_same_v<Value_type<InputIt>, Value_type<OutputIt>>
+            && std::is_trivially_copy_assignable_v<Value_type<OutputIt>>;
+
+        template<class InputIt, class OutputIt>
+        constexpr bool is_block_move = Contiguous<InputIt>::value && is_block<OutputIt>
+            && std::is_same_v<Value_type<InputIt>, Value_type<OutputIt>>
+            && std::is_trivially_move_assignable_v<Value_type<OutputIt>>;
+
+        template<class It>
+        constexpr bool is_block_fill = is_block<It> && std::is_trivially_copy_assignable_v<Value_type<It>>;
+
+        template<class It>
+        auto data(It it) { return std::addressof(*it); }
+
+#if defined(__AVX2__)
+        using Vector = __m256i;
+
+        inline Vector load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+        inline void store(void* p, Vector v) { _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+        // around the cache, p is aligned to a vector
+        inline void stream(void* p, Vector v) { _mm256_stream_si256(static_cast<__m256i*>(p), v); }
+
+        // the elements of the given size of a vector, the last one first
+        template<std::size_t size>
+        Vector reverse_lanes(Vector v)
+        {
+            v = _mm256_permute4x64_epi64(v, 0x4E);
+            if constexpr (size == 8)
+                return _mm256_shuffle_epi32(v, 0x4E);
+            else if constexpr (size == 4)
+                return _mm256_shuffle_epi32(v, 0x1B);
+            else if constexpr (size == 2)
+                return _mm256_shuffle_epi8(v, _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                                               14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+            else
+                return _mm256_shuffle_epi8(v, _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                               15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        }
+#elif defined(__SSE2__)
+        using Vector = __m128i;
+
+        inline Vector load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+        inline void store(void* p, Vector v) { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+        inline void stream(void* p, Vector v) { _mm_stream_si128(static_cast<__m128i*>(p), v); }
+
+        template<std::size_t size>
+        Vector reverse_lanes(Vector v)
+        {
+            if constexpr (size == 8)
+                return _mm_shuffle_epi32(v, 0x4E);
+            else
+            {
+                v = _mm_shuffle_epi32(v, 0x1B);
+                if constexpr (size == 4)
+                    return v;
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+                if constexpr (size == 2)
+                    return v;
+                return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            }
+        }
+#endif
+
+        // swaps front[k] with back[-1 - k] for the k of [0, n), the two do not overlap
+        template<class T>
+        void swap_reversed(T* front, T* back, std::size_t n)
+        {
+            std::size_t k {0};
+#if defined(__AVX2__) || defined(__SSE2__)
+            if constexpr (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                constexpr std::size_t lanes = sizeof(Vector) / sizeof(T);
+                for (; k + lanes <= n; k += lanes)
+                {
+                    const Vector a = load(front + k);
+                    const Vector b = load(back - k - lanes);
+                    store(front + k, reverse_lanes<sizeof(T)>(b));
+                    store(back - k - lanes, reverse_lanes<sizeof(T)>(a));
+                }
+            }
+#endif
+            for (; k < n; ++k)
+                std::swap(front[k], back[-1 - static_cast<std::ptrdiff_t>(k)]);
+        }
+
+        template<class T>
+        void swap_blocks(T* a, T* b, std::size_t n)
+        {
+            constexpr std::size_t block = 256;
+            unsigned char buffer[block];
+            unsigned char* x = reinterpret_cast<unsigned char*>(a);
+            unsigned char* y = reinterpret_cast<unsigned char*>(b);
+            std::size_t bytes = n * sizeof(T);
+            for (; bytes >= block; bytes -= block, x += block, y += block)
+            {
+                std::memcpy(buffer, x, block);
+                std::memcpy(x, y, block);
+                std::memcpy(y, buffer, block);
+            }
+            std::memcpy(buffer, x, bytes);
+            std::memcpy(x, y, bytes);
+            std::memcpy(y, buffer, bytes);
+        }
+
+        // memset when the bytes of value are all the same, stores of a vector of the value repeated when
+        // it divides one, around the cache for more bytes than it holds, else copies of what is filled
+        template<class T>
+        void fill_block(T* p, std::size_t n, const T& value)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, std::addressof(value), sizeof(T));
+            unsigned char* to = reinterpret_cast<unsigned char*>(p);
+            const std::size_t size = n * sizeof(T);
+            const bool around = size >= non_temporal_bytes();
+            const bool same = std::all_of(bytes, bytes + sizeof(T), [&bytes](unsigned char b) { return b == bytes[0]; });
+
+#if defined(__AVX2__) || defined(__SSE2__)
+            if constexpr (sizeof(Vector) % sizeof(T) == 0)
+            {
+                if (same && !around)
+                {
+                    std::memset(to, bytes[0], size);
+                    return;
+                }
+                unsigned char pattern[sizeof(Vector)];
+                for (std::size_t i = 0; i < sizeof(Vector); i += sizeof(T))
+                    std::memcpy(pattern + i, bytes, sizeof(T));
+                const Vector v = load(pattern);
+                constexpr std::size_t lanes = sizeof(Vector) / sizeof(T);
+                std::size_t k = 0;
+                if (around)
+                {
+                    for (; k < n && reinterpret_cast<std::uintptr_t>(p + k) % sizeof(Vector) != 0; ++k)
+                        p[k] = value;
+                    for (; k + lanes <= n; k += lanes)
+                        stream(p + k, v);
+                    _mm_sfence();
+                }
+                else
+                    for (; k + lanes <= n; k += lanes)
+                        store(p + k, v);
+                for (; k < n; ++k)
+                    p[k] = value;
+                return;
+            }
+#endif
+
+            if (same)
+            {
+                std::memset(to, bytes[0], size);
+                return;
+            }
+            if (n == 0)
+                return;
+            // the elements so far copied after them, doubling, up to 4 KB a copy
+            const std::size_t most = std::max<std::size_t>(1, 4096 / sizeof(T)) * sizeof(T);
+            std::memcpy(to, bytes, sizeof(T));
+            for (std::size_t filled = sizeof(T); filled < size;)
+            {
+                const std::size_t k = std::min({filled, size - filled, most});
+                std::memcpy(to + filled, to + filled - k, k);
+                filled += k;
+            }
+        }
+
+        template<class Policy, class F>
+        void for_chunks(const Policy& policy, std::size_t n, const F& f)
+        {
+            if constexpr (parallel::detail::is_parallel<Policy, int*>)
+            {
+                Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+                parallel::detail::for_chunks(pool, n, parallel::detail::num_chunks(pool, n), f);
+            }
+            else
+                f(0, 0, n);
+        }
+
+        template<class Policy, class F>
+        void for_parts(const Policy& policy, std::size_t parts, const F& f)
+        {
+            if constexpr (parallel::detail::is_parallel<Policy, int*>)
+                parallel::detail::for_chunks(parallel::detail::pool_of(policy), parts, parts,
+                    [&f](std::size_t part, std::size_t, std::size_t) { f(part); });
+            else
+                for (std::size_t part = 0; part < parts; ++part)
+                    f(part);
+        }
+
+        template<class Policy, class T>
+        void swap_ranges(const Policy& policy, T* a, T* b, std::size_t n)
+        {
+            for_chunks(policy, n, [a, b](std::size_t, std::size_t begin, std::size_t end) { swap_blocks(a + begin, b + begin, end - begin); });
+        }
+
+        template<class Policy, class T>
+        void copy(const Policy& policy, const T* from, T* to, std::size_t n)
+        {
+            for_chunks(policy, n, [from, to](std::size_t, std::size_t begin, std::size_t end)
+            {
+                std::memcpy(static_cast<void*>(to + begin), from + begin, (end - begin) * sizeof(T));
+            });
+        }
+
+        // the n - k elements from data + k to data, or from data to data + k, they overlap
+        template<class Policy, class T>
+        void shift(const Policy& policy, T* data, std::size_t n, std::size_t k, bool left)
+        {
+            const std::size_t moved = n - k;
+            T* to = left ? data : data + k;
+            T* from = left ? data + k : data;
+            if (moved == 0 || k == 0)
+                return;
+            if (k >= moved)
+            {
+                detail::copy(policy, from, to, moved);
+                return;
+            }
+
+            std::size_t chunks {1};
+            if constexpr (parallel::detail::is_parallel<Policy, int*>)
+                chunks = std::min(parallel::detail::num_chunks(parallel::detail::pool_of(policy), moved), moved / (4 * k));
+            if (chunks < 2)
+            {
+                std::memmove(static_cast<void*>(to), from, moved * sizeof(T));
+                return;
+            }
+
+            // the first k of the source of every chunk that the chunk before it writes, or the last k
+            // of the ones that the chunk after it writes, for a shift to the right
+            const auto bounds = [moved, chunks](std::size_t chunk) { return moved / chunks * chunk + std::min(chunk, moved % chunks); };
+            std::vector<T> saved(chunks * k);
+            const auto saved_of = [&](std::size_t chunk) { return left ? bounds(chunk + 1) : bounds(chunk); };
+            for_parts(policy, chunks, [&](std::size_t chunk)
+            {
+                if (left ? chunk + 1 < chunks : chunk > 0)
+                    std::memcpy(static_cast<void*>(saved.data() + chunk * k), data + saved_of(chunk), k * sizeof(T));
+            });
+            for_parts(policy, chunks, [&](std::size_t chunk)
+            {
+                const std::size_t begin = bounds(chunk);
+                const std::size_t size = bounds(chunk + 1) - begin;
+                if (left && chunk + 1 < chunks)
+                {
+                    std::memmove(static_cast<void*>(to + begin), from + begin, (size - k) * sizeof(T));
+                    std::memcpy(static_cast<void*>(to + begin + size - k), saved.data() + chunk * k, k * sizeof(T));
+                }
+                else if (!left && chunk > 0)
+                {
+                    std::memmove(static_cast<void*>(to + begin + k), from + begin + k, (size - k) * sizeof(T));
+                    std::memcpy(static_cast<void*>(to + begin), saved.data() + chunk * k, k * sizeof(T));
+                }
+                else
+                    std::memmove(static_cast<void*>(to + begin), from + begin, size * sizeof(T));
+            });
+        }
+
+        template<class Policy, class T>
+        void rotate(const Policy& policy, T* first, std::size_t left, std::size_t right)
+        {
+            while (left != 0 && right != 0)
+            {
+                if (std::min(left, right) * sizeof(T) <= rotate_buffer_bytes)
+                {
+                    const std::size_t shorter = std::min(left, right);
+                    std::vector<unsigned char> buffer(shorter * sizeof(T));
+                    T* const last = first + left + right;
+                    if (left <= right)
+                    {
+                        std::memcpy(buffer.data(), first, buffer.size());
+                        shift(policy, first, left + right, left, true);
+                        std::memcpy(static_cast<void*>(last - left), buffer.data(), buffer.size());
+                    }
+                    else
+                    {
+                        std::memcpy(buffer.data(), last - right, buffer.size());
+                        shift(policy, first, left + right, right, false);
+                        std::memcpy(static_cast<void*>(first), buffer.data(), buffer.size());
+                    }
+                    return;
+                }
+
+                // the shorter side goes to its place, what is left is a rotate of the rest
+                if (left < right)
+                {
+                    swap_ranges(policy, first, first + right, left);
+                    right -= left;
+                }
+                else
+                {
+                    swap_ranges(policy, first, first + left, right);
+                    first += right;
+                    left -= right;
+                }
+            }
+        }
+
+        template<class Policy, class RandomIt>
+        void reverse(const Policy& policy, RandomIt first, RandomIt last)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n < 2)
+                return;
+            auto* p = data(first);
+            for_chunks(policy, n / 2, [p, n](std::size_t, std::size_t begin, std::size_t end) { swap_reversed(p + begin, p + n - begin, end - begin); });
+        }
+    }
+
+    template<class BidirIt>
+    void reverse(BidirIt first, BidirIt last)
+    {
+        if constexpr (detail::is_block<BidirIt>)
+            detail::reverse(parallel::seq, first, last);
+        else
+            std::reverse(first, last);
+    }
+
+    template<class ForwardIt1, class ForwardIt2>
+    ForwardIt2 swap_ranges(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2)
+    {
+        if constexpr (detail::is_block<ForwardIt1> && detail::is_block<ForwardIt2>
+            && std::is_same_v<detail::Value_type<ForwardIt1>, detail::Value_type<ForwardIt2>>)
+        {
+            const std::size_t n = static_cast<std::size_t>(last1 - first1);
+            if (n != 0)
+                detail::swap_blocks(detail::data(first1), detail::data(first2), n);
+            return first2 + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+            return std::swap_ranges(first1, last1, first2);
+    }
+
+    template<class ForwardIt>
+    ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last)
+    {
+        if constexpr (detail::is_block<ForwardIt>)
+        {
+            if (first != last)
+                detail::rotate(parallel::seq, detail::data(first), static_cast<std::size_t>(middle - first), static_cast<std::size_t>(last - middle));
+            return first + (last - middle);
+        }
+        else
+            return std::rotate(first, middle, last);
+    }
+
+    template<class ForwardIt, class OutputIt>
+    OutputIt rotate_copy(ForwardIt first, ForwardIt middle, ForwardIt last, OutputIt d_first)
+    {
+        // std::copy of trivially copyable elements is a memmove already
+        return std::rotate_copy(first, middle, last, d_first);
+    }
+
+    template<class ForwardIt>
+    ForwardIt shift_left(ForwardIt first, ForwardIt last, typename std::iterator_traits<ForwardIt>::difference_type n)
+    {
+        const auto size = std::distance(first, last);
+        if (n <= 0)
+            return last;
+        if (n >= size)
+            return first;
+        if constexpr (detail::is_block<ForwardIt>)
+            detail::shift(parallel::seq, detail::data(first), static_cast<std::size_t>(size), static_cast<std::size_t>(n), true);
+        else
+            return std::move(std::next(first, n), last, first);
+        return std::next(first, size - n);
+    }
+
+    template<class ForwardIt>
+    ForwardIt shift_right(ForwardIt first, ForwardIt last, typename std::iterator_traits<ForwardIt>::difference_type n)
+    {
+        const auto size = std::distance(first, last);
+        if (n <= 0)
+            return first;
+        if (n >= size)
+            return last;
+        if constexpr (detail::is_block<ForwardIt>)
+            detail::shift(parallel::seq, detail::data(first), static_cast<std::size_t>(size), static_cast<std::size_t>(n), false);
+        else
+            std::move_backward(first, std::next(first, size - n), last);
+        return std::next(first, n);
+    }
+
+    template<class InputIt, class OutputIt>
+    OutputIt copy(InputIt first, InputIt last, OutputIt d_first)
+    {
+        if constexpr (detail::is_block_copy<InputIt, OutputIt>)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n != 0)
+                std::memmove(detail::data(d_first), detail::data(first), n * sizeof(detail::Value_type<OutputIt>));
+            return d_first + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+            return std::copy(first, last, d_first);
+    }
+
+    template<class InputIt, class Size, class OutputIt>
+    OutputIt copy_n(InputIt first, Size count, OutputIt d_first)
+    {
+        if constexpr (detail::is_block_copy<InputIt, OutputIt>)
+        {
+            if (!(count > 0))
+                return d_first;
+            return block::copy(first, first + count, d_first);
+        }
+        else
+            return std::copy_n(first, count, d_first);
+    }
+
+    template<class BidirIt1, class BidirIt2>
+    BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last)
+    {
+        if constexpr (detail::is_block_copy<BidirIt1, BidirIt2>)
+        {
+            const std::ptrdiff_t n = last - first;
+            if (n != 0)
+                std::memmove(detail::data(d_last - n), detail::data(first), static_cast<std::size_t>(n) * sizeof(detail::Value_type<BidirIt2>));
+            return d_last - n;
+        }
+        else
+            return std::copy_backward(first, last, d_last);
+    }
+
+    template<class InputIt, class OutputIt>
+    OutputIt move(InputIt first, InputIt last, OutputIt d_first)
+    {
+        if constexpr (detail::is_block_move<InputIt, OutputIt>)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n != 0)
+                std::memmove(detail::data(d_first), detail::data(first), n * sizeof(detail::Value_type<OutputIt>));
+            return d_first + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+            return std::move(first, last, d_first);
+    }
+
+    template<class BidirIt1, class BidirIt2>
+    BidirIt2 move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last)
+    {
+        if constexpr (detail::is_block_move<BidirIt1, BidirIt2>)
+        {
+            const std::ptrdiff_t n = last - first;
+            if (n != 0)
+                std::memmove(detail::data(d_last - n), detail::data(first), static_cast<std::size_t>(n) * sizeof(detail::Value_type<BidirIt2>));
+            return d_last - n;
+        }
+        else
+            return std::move_backward(first, last, d_last);
+    }
+
+    template<class ForwardIt, class T>
+    void fill(ForwardIt first, ForwardIt last, const T& value)
+    {
+        if constexpr (detail::is_block_fill<ForwardIt> && std::is_convertible_v<const T&, detail::Value_type<ForwardIt>>)
+        {
+            const detail::Value_type<ForwardIt> element = value;
+            detail::fill_block(detail::data(first), static_cast<std::size_t>(last - first), element);
+        }
+        else
+            std::fill(first, last, value);
+    }
+
+    template<class OutputIt, class Size, class T>
+    OutputIt fill_n(OutputIt first, Size count, const T& value)
+    {
+        if constexpr (detail::is_block_fill<OutputIt> && std::is_convertible_v<const T&, detail::Value_type<OutputIt>>)
+        {
+            if (!(count > 0))
+                return first;
+            block::fill(first, first + count, value);
+            return first + count;
+        }
+        else
+            return std::fill_n(first, count, value);
+    }
+
+    template<class Policy, class RandomIt>
+    void reverse(Policy&& policy, RandomIt first, RandomIt last)
+    {
+        if constexpr (detail::is_block<RandomIt>)
+            detail::reverse(policy, first, last);
+        else
+            std::reverse(first, last);
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2>
+    RandomIt2 swap_ranges(Policy&& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2)
+    {
+        if constexpr (detail::is_block<RandomIt1> && detail::is_block<RandomIt2>
+            && std::is_same_v<detail::Value_type<RandomIt1>, detail::Value_type<RandomIt2>>)
+        {
+            const std::size_t n = static_cast<std::size_t>(last1 - first1);
+            if (n != 0)
+                detail::swap_ranges(policy, detail::data(first1), detail::data(first2), n);
+            return first2 + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+            return std::swap_ranges(first1, last1, first2);
+    }
+
+    template<class Policy, class RandomIt>
+    RandomIt rotate(Policy&& policy, RandomIt first, RandomIt middle, RandomIt last)
+    {
+        if constexpr (detail::is_block<RandomIt>)
+        {
+            if (first != last)
+                detail::rotate(policy, detail::data(first), static_cast<std::size_t>(middle - first), static_cast<std::size_t>(last - middle));
+            return first + (last - middle);
+        }
+        else
+            return std::rotate(first, middle, last);
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2>
+    RandomIt2 rotate_copy(Policy&& policy, RandomIt1 first, RandomIt1 middle, RandomIt1 last, RandomIt2 d_first)
+    {
+        if constexpr (detail::is_block<RandomIt2> && std::is_same_v<detail::Value_type<RandomIt1>, detail::Value_type<RandomIt2>>
+            && detail::Contiguous<RandomIt1>::value)
+        {
+            const std::size_t left = static_cast<std::size_t>(middle - first);
+            const std::size_t right = static_cast<std::size_t>(last - middle);
+            if (right != 0)
+                detail::copy(policy, detail::data(middle), detail::data(d_first), right);
+            if (left != 0)
+                detail::copy(policy, detail::data(first), detail::data(d_first) + right, left);
+            return d_first + static_cast<std::ptrdiff_t>(left + right);
+        }
+        else
+            return std::rotate_copy(first, middle, last, d_first);
+    }
+
+    template<class Policy, class RandomIt>
+    RandomIt shift_left(Policy&& policy, RandomIt first, RandomIt last, typename std::iterator_traits<RandomIt>::difference_type n)
+    {
+        const auto size = last - first;
+        if constexpr (detail::is_block<RandomIt>)
+        {
+            if (n <= 0)
+                return last;
+            if (n >= size)
+                return first;
+            detail::shift(policy, detail::data(first), static_cast<std::size_t>(size), static_cast<std::size_t>(n), true);
+            return first + (size - n);
+        }
+        else
+            return block::shift_left(first, last, n);
+    }
+
+    template<class Policy, class RandomIt>
+    RandomIt shift_right(Policy&& policy, RandomIt first, RandomIt last, typename std::iterator_traits<RandomIt>::difference_type n)
+    {
+        const auto size = last - first;
+        if constexpr (detail::is_block<RandomIt>)
+        {
+            if (n <= 0)
+                return first;
+            if (n >= size)
+                return last;
+            detail::shift(policy, detail::data(first), static_cast<std::size_t>(size), static_cast<std::size_t>(n), false);
+            return first + n;
+        }
+        else
+            return block::shift_right(first, last, n);
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "Block_algorithms.h"
+
+struct Sample
+{
+    std::int64_t time;
+    float value;
+};
+
+int main()
+{
+    std::string str = "hello world";
+    block::reverse(str.begin(), str.end());
+    std::cout << str << '\n';
+
+    std::vector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+    block::rotate(v.begin(), v.begin() + 3, v.end());
+    for (int i : v)
+        std::cout << i << ' ';
+    std::cout << '\n';
+
+    // a window of the last samples, the oldest ones are shifted out for the new ones
+    std::vector<Sample> window(4'000'000);
+    for (std::size_t i = 0; i < window.size(); ++i)
+        window[i] = Sample {static_cast<std::int64_t>(i), static_cast<float>(i) / 2};
+    const std::ptrdiff_t arrived = 250'000;
+    auto free = block::shift_left(parallel::par, window.begin(), window.end(), arrived);
+    for (std::ptrdiff_t i = 0; i < arrived; ++i)
+        free[i] = Sample {static_cast<std::int64_t>(window.size()) + i, 0.0f};
+    std::cout << "oldest: " << window.front().time << ", newest: " << window.back().time << '\n';
+
+    // the ring buffer, with its oldest sample at head, in order again
+    const std::ptrdiff_t head = 1'234'567;
+    block::rotate(parallel::par, window.begin(), window.begin() + head, window.end());
+    block::rotate(parallel::par, window.begin(), window.end() - head, window.end());
+    std::cout << "oldest: " << window.front().time << ", newest: " << window.back().time << '\n';
+
+    std::vector<Sample> copy(window.size());
+    block::rotate_copy(parallel::par, window.begin(), window.begin() + head, window.end(), copy.begin());
+    block::swap_ranges(parallel::par, copy.begin(), copy.begin() + head, window.begin());
+    std::cout << "first of the window: " << window.front().time << '\n';
+
+    block::reverse(parallel::par, window.begin(), window.end());
+    std::cout << "first of the reversed window: " << window.front().time << '\n';
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+#ifndef _BYTE_SET_H_
+#define _BYTE_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*
+
+    - a byte_set::Set is a set of bytes, "find any delimiter of these" in a text is
+      find_first_of of the text and the set, and a range of bytes is looked at 16 or 32 of
+      them at a time, not compared with every byte of the set, one by one.
+
+    - the set is a bool for every one of the 256 bytes, and for the shuffles a bit for every
+      byte in two tables of 16 bytes, one for the bytes below 0x80 and one for the others: the byte
+      of a table at the low 4 bits of a byte has the bit high 4 bits % 8 set when it is in the
+      set. PSHUFB (SSSE3, AVX2 on 32 bytes), or TBL of NEON, looks up 16 bytes in a table at
+      once, and a second shuffle gives the bit to test for the high 4 bits.
+
+    - with SSE2 only, there is no shuffle, a set of up to 16 bytes compares each of them with
+      16 bytes of the range, a bigger one tests the bits one byte at a time.
+
+    - find_first_of and find_first_not_of take the range of bytes and a set, or a second range
+      of the same type that the set is made of, with the signature of std::find_first_of, for a
+      pointer or an iterator of std::string or std::vector of char, signed char or unsigned
+      char, the other ranges run std::find_first_of.
+
+*/
+namespace byte_set
+{
+    class Set
+    {
+    private:
+        bool bytes[256] {};
+        alignas(16) std::uint8_t tables[2][16] {};
+        unsigned char members[16] {};
+        std::size_t num_members {0};
+
+        template<bool in_set>
+        std::size_t find_scalar(const unsigned char* data, std::size_t i, std::size_t n) const
+        {
+            return static_cast<std::size_t>(std::find_if(data + i, data + n, [this](unsigned char byte) {
+                return this->bytes[byte] == in_set;
+            }) - data);
+        }
+
+    public:
+        Set() = default;
+
+        explicit Set(std::string_view bytes)
+        {
+            for (char byte : bytes)
+                this->insert(static_cast<unsigned char>(byte));
+        }
+
+        template<class InputIt>
+        Set(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                this->insert(static_cast<unsigned char>(*first));
+        }
+
+        void insert(unsigned char byte)
+        {
+            if (this->contains(byte))
+                return;
+            this->bytes[byte] = true;
+            this->tables[byte >> 7][byte & 15] |= static_cast<std::uint8_t>(1 << ((byte >> 4) & 7));
+            if (this->num_members < 16)
+                this->members[this->num_members] = byte;
+            ++this->num_members;
+        }
+
+        bool contains(unsigned char byte) const
+        {
+            return this->bytes[byte];
+        }
+
+        std::size_t size() const { return this->num_members; }
+
+        // the index of the first of the n bytes that is in the set, or not in it, n if none is
+        template<bool in_set = true>
+        std::size_t find(const unsigned char* data, std::size_t n) const
+        {
+            std::size_t i {0};
+            [[maybe_unused]] constexpr unsigned flip = in_set ? 0 : 0xFFFFFFFF;
+#if defined(__AVX2__) || defined(__SSSE3__) || (defined(__ARM_NEON) && defined(__aarch64__))
+            // the bit to test in the byte of the table, for the high 4 bits of a byte
+            alignas(16) static constexpr std::uint8_t high_bits[16] {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+#endif
+#if defined(__AVX2__)
+            const __m256i low_table_32 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(this->tables[0])));
+            const __m256i high_table_32 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(this->tables[1])));
+            const __m256i bit_table_32 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(high_bits)));
+            const __m256i nibble_32 = _mm256_set1_epi8(0x0F);
+            for (; i + 32 <= n; i += 32)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const __m256i low = _mm256_and_si256(v, nibble_32);
+                const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_32);
+                // the sign bit of a byte picks the table
+                const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(low_table_32, low), _mm256_shuffle_epi8(high_table_32, low), v);
+                const __m256i bit = _mm256_shuffle_epi8(bit_table_32, high);
+                const __m256i in = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+                const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(in)) ^ flip;
+                if (mask != 0)
+                    return i + static_cast<std::size_t>(__builtin_ctz(mask));
+            }
+#endif
+#if defined(__SSSE3__)
+            const __m128i low_table = _mm_load_si128(reinterpret_cast<const __m128i*>(this->tables[0]));
+            const __m128i high_table = _mm_load_si128(reinterpret_cast<const __m128i*>(this->tables[1]));
+            const __m128i bit_table = _mm_load_si128(reinterpret_cast<const __m128i*>(high_bits));
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i low = _mm_and_si128(v, nibble);
+                const __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+                const __m128i upper = _mm_cmplt_epi8(v, _mm_setzero_si128());
+                const __m128i row = _mm_or_si128(_mm_andnot_si128(upper, _mm_shuffle_epi8(low_table, low)),
+                                                 _mm_and_si128(upper, _mm_shuffle_epi8(high_table, low)));
+                const __m128i bit = _mm_shuffle_epi8(bit_table, high);
+                const __m128i in = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+                const unsigned mask = (static_cast<unsigned>(_mm_movemask_epi8(in)) ^ flip) & 0xFFFF;
+                if (mask != 0)
+                    return i + static_cast<std::size_t>(__builtin_ctz(mask));
+            }
+#elif defined(__SSE2__)
+            if (this->num_members <= 16)
+            {
+                __m128i each[16];
+                for (std::size_t k = 0; k < this->num_members; ++k)
+                    each[k] = _mm_set1_epi8(static_cast<char>(this->members[k]));
+                for (; i + 16 <= n; i += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    __m128i in = _mm_setzero_si128();
+                    for (std::size_t k = 0; k < this->num_members; ++k)
+                        in = _mm_or_si128(in, _mm_cmpeq_epi8(v, each[k]));
+                    const unsigned mask = (static_cast<unsigned>(_mm_movemask_epi8(in)) ^ flip) & 0xFFFF;
+                    if (mask != 0)
+                        return i + static_cast<std::size_t>(__builtin_ctz(mask));
+                }
+            }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            const uint8x16_t low_table = vld1q_u8(this->tables[0]);
+            const uint8x16_t high_table = vld1q_u8(this->tables[1]);
+            const uint8x16_t bit_table = vld1q_u8(high_bits);
+            const uint8x16_t nibble = vdupq_n_u8(0x0F);
+            for (; i + 16 <= n; i += 16)
+            {
+                const uint8x16_t v = vld1q_u8(data + i);
+                const uint8x16_t low = vandq_u8(v, nibble);
+                const uint8x16_t upper = vcltq_s8(vreinterpretq_s8_u8(v), vdupq_n_s8(0));
+                const uint8x16_t row = vbslq_u8(upper, vqtbl1q_u8(high_table, low), vqtbl1q_u8(low_table, low));
+                const uint8x16_t bit = vqtbl1q_u8(bit_table, vshrq_n_u8(v, 4));
+                const uint8x16_t in = vceqq_u8(vandq_u8(row, bit), bit);
+                // 4 bits for every byte, NEON has no movemask
+                std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(in), 4)), 0);
+                if (!in_set)
+                    mask = ~mask;
+                if (mask != 0)
+                    return i + static_cast<std::size_t>(__builtin_ctzll(mask)) / 4;
+            }
+#endif
+            return this->find_scalar<in_set>(data, i, n);
+        }
+    };
+
+    namespace detail
+    {
+        template<class T>
+        constexpr bool is_byte = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+        template<class It>
+        using Value_type = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+
+        template<class It, class = void>
+        struct Contiguous_bytes : std::false_type {};
+
+        template<class T>
+        struct Contiguous_bytes<T*> : std::bool_constant<is_byte<std::remove_cv_t<T>>> {};
+
+        template<class It>
+        struct Contiguous_bytes<It, std::enable_if_t<!std::is_pointer_v<It> && is_byte<Value_type<It>>>>
+        {
+            using value_type = Value_type<It>;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>
+                || (std::is_same_v<value_type, char> && (std::is_same_v<It, std::string::iterator>
+                    || std::is_same_v<It, std::string::const_iterator>));
+        };
+
+        template<bool in_set, class InputIt>
+        InputIt find(InputIt first, InputIt last, const Set& set)
+        {
+            if constexpr (Contiguous_bytes<InputIt>::value)
+            {
+                if (first == last)
+                    return last;
+                const unsigned char* data = reinterpret_cast<const unsigned char*>(std::addressof(*first));
+                return first + set.find<in_set>(data, static_cast<std::size_t>(last - first));
+            }
+            else
+                return std::find_if(first, last, [&set](auto byte) { return set.contains(static_cast<unsigned char>(byte)) == in_set; });
+        }
+    }
+
+    template<class InputIt>
+    InputIt find_first_of(InputIt first, InputIt last, const Set& set)
+    {
+        return detail::find<true>(first, last, set);
+    }
+
+    template<class InputIt>
+    InputIt find_first_not_of(InputIt first, InputIt last, const Set& set)
+    {
+        return detail::find<false>(first, last, set);
+    }
+
+    template<class InputIt, class ForwardIt>
+    InputIt find_first_of(InputIt first, InputIt last, ForwardIt s_first, ForwardIt s_last)
+    {
+        if constexpr (detail::Contiguous_bytes<InputIt>::value
+            && std::is_same_v<detail::Value_type<InputIt>, detail::Value_type<ForwardIt>>)
+            return detail::find<true>(first, last, Set(s_first, s_last));
+        else
+            return std::find_first_of(first, last, s_first, s_last);
+    }
+}
+
+#endif
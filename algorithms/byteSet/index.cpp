@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Byte_set.h"
+
+int main()
+{
+    // the example of find_first_of, on bytes
+    const std::string v {"0 2 3 25 5"};
+    for (const std::string t : {"1934", "1679"})
+    {
+        const auto result = byte_set::find_first_of(v.begin(), v.end(), t.begin(), t.end());
+        if (result == v.end())
+            std::cout << "No bytes of \"" << v << "\" are in \"" << t << "\"\n";
+        else
+            std::cout << "Found a match (" << *result << ") at position " << result - v.begin() << " of \"" << v << "\"\n";
+    }
+
+    // the fields of a line split at any delimiter of a set made once
+    const byte_set::Set delimiters {",;|\t"};
+    const std::string line {"id,name;age|city\tcountry"};
+    for (auto first = line.begin();;)
+    {
+        auto last = byte_set::find_first_of(first, line.end(), delimiters);
+        std::cout << '[' << std::string(first, last) << ']';
+        if (last == line.end())
+            break;
+        first = last + 1;
+    }
+    std::cout << '\n';
+
+    // the punctuation of a word removed, like clean_string
+    const byte_set::Set punctuation {".,;:!?"};
+    const std::string word {"...Wherefore,art;thou?"};
+    std::string clean;
+    for (auto first = word.begin(); first != word.end();)
+    {
+        first = byte_set::find_first_not_of(first, word.end(), punctuation);
+        auto last = byte_set::find_first_of(first, word.end(), punctuation);
+        clean.append(first, last);
+        first = last;
+    }
+    std::cout << word << " -> " << clean << '\n';
+
+    // a set of more than 16 bytes, some of them of the upper half
+    const byte_set::Set vowels {"aeiouyAEIOUY\xe0\xe8\xe9\xf6\xfc"};
+    const std::string text {std::string(100, 'x') + "caf\xe9"};
+    std::cout << vowels.size() << " vowels, the first one at " << byte_set::find_first_of(text.begin(), text.end(), vowels) - text.begin() << '\n';
+
+    constexpr std::string_view indented {"  \t  text"};
+    const byte_set::Set whitespace {" \t\n"};
+    std::cout << "text at " << byte_set::find_first_not_of(indented.begin(), indented.end(), whitespace) - indented.begin() << '\n';
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+
+    - compares std::find_first_of, a loop with a chain of ==, like clean_string, and a loop
+      that tests a table of 256 bools, like Char_set of ../../standardTemplateLibrary/challengeThree/Tokenizer.h,
+      against byte_set::find_first_of of ../byteSet/Byte_set.h, finding all the bytes of a
+      set in romeoAndJuliet.txt repeated: the punctuation ".,;:!?", a set of 1 byte, '\n',
+      and one of 20 bytes, then find_first_not_of of the letters, the end of every word.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+      and with -mssse3 or -mavx2 for the shuffles, without them SSE2 compares every byte of
+      a set of up to 16 bytes.
+
+    - 100'000'000 bytes by default, the number can be given on the command line, e.g.
+      ./a.out 10000000, run it from this directory, it reads
+      ../../ioAndStream/challenge4/romeoAndJuliet.txt
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "../byteSet/Byte_set.h"
+
+template <typename Find>
+void run(const std::string& name, const std::string& text, Find find)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t found {0};
+    for (auto it = find(text.begin(), text.end()); it != text.end(); it = find(it + 1, text.end()))
+        ++found;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "    " << std::setw(20) << std::left << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(8) << text.size() / seconds / 1e9 << " GB/s" << std::setw(12) << found << std::endl;
+}
+
+void compare(const std::string& text, const std::string& bytes)
+{
+    std::cout << bytes.size() << " bytes" << std::endl;
+    run("std::find_first_of", text, [&bytes](auto first, auto last) { return std::find_first_of(first, last, bytes.begin(), bytes.end()); });
+    if (bytes == ".,;:!?")
+        run("== chain", text, [](auto first, auto last) {
+            return std::find_if(first, last, [](char c) { return c == '.' || c == ',' || c == ';' || c == ':' || c == '!' || c == '?'; });
+        });
+    bool table[256] {};
+    for (char c : bytes)
+        table[static_cast<unsigned char>(c)] = true;
+    run("bool table", text, [&table](auto first, auto last) {
+        return std::find_if(first, last, [&table](char c) { return table[static_cast<unsigned char>(c)]; });
+    });
+    const byte_set::Set set {bytes};
+    run("byte_set::Set", text, [&set](auto first, auto last) { return byte_set::find_first_of(first, last, set); });
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000'000;
+
+    std::ifstream file {"../../ioAndStream/challenge4/romeoAndJuliet.txt"};
+    if (!file)
+        throw std::runtime_error {"romeoAndJuliet.txt can not be opened"};
+    std::stringstream book;
+    book << file.rdbuf();
+    std::string text;
+    while (text.size() < n)
+        text += book.str();
+    text.resize(n);
+
+    std::cout << n << " bytes, GB/s and number of bytes found" << std::endl;
+    for (const std::string bytes : {".,;:!?", "\n", "()[]{}<>'\"-_*&^%$#@~`"})
+        compare(text, bytes);
+
+    std::string letters;
+    for (char c = 'a'; c <= 'z'; ++c)
+        letters += {c, static_cast<char>(c - 'a' + 'A')};
+    std::cout << "not one of the " << letters.size() << " letters" << std::endl;
+    run("std::find_if_not", text, [&letters](auto first, auto last) {
+        return std::find_if_not(first, last, [&letters](char c) { return letters.find(c) != std::string::npos; });
+    });
+    const byte_set::Set set {letters};
+    run("byte_set::Set", text, [&set](auto first, auto last) { return byte_set::find_first_not_of(first, last, set); });
+
+    return 0;
+}
@@ -0,0 +1,707 @@
+#ifndef _COMPACTION_H_
+#define _COMPACTION_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+    - remove, remove_if, unique, copy_if and partition of ../modifyingSequenceOperations,
+      with the signatures of the std ones, without a branch on the predicate: the element is
+      written to the next place of the output either way, and the place moves on by
+      pred(element), 0 or 1, so the order of kept and removed elements, however random, costs
+      nothing. std::remove_if has a branch for every element, that is wrong about half the
+      time on elements that are kept at random.
+
+    - the elements are copied, not moved, and an element is written over itself, so it is
+      for trivially copyable elements and random access iterators, the other ones run the
+      std algorithm. unique needs an equivalence, like std::unique, partition is the
+      branchless Lomuto one, it keeps the order of neither part, like std::partition.
+
+    - remove_if and copy_if of a contiguous range, a pointer, or an iterator of std::vector
+      or std::basic_string, of elements of 4 or 8 bytes, take the predicate of 16, or 8, of
+      them at once as the bits of a mask, and compress the kept ones to the front of a
+      vector, written at once: vpcompressd / vpcompressq with AVX-512, a permutation from a
+      table of the 256, or 16, masks with AVX2.
+
+    - copy_if compacts 64 elements at a time in a buffer, and copies the kept ones out, so
+      it writes no more than std::copy_if does, to an output iterator of any kind.
+
+    - adjacent_find, unique and unique_copy of a contiguous range of integers, enums or
+      pointers of 4 or 8 bytes, with the == of them, std::equal_to, a sorted list of ids,
+      compare a vector of them to the same one shifted by one lane, its neighbours before
+      it, and the mask of the lanes that differ is the one of the kept ones, compressed like
+      the ones of remove_if. unique takes the shifted vector from the vector before it, not
+      from memory, where the kept ones of the vector before can be already. a predicate of
+      its own, or elements of other kinds, run the branchless loop, or the std algorithm.
+
+    - the overloads with an execution policy of ../parallelAlgorithms first remove, or
+      copy, in the chunks of the range at once, with the counts of the kept elements of the
+      chunks added up for where the ones of a chunk go: copy_if and unique_copy count the
+      kept elements of every chunk in a first pass, remove_if, remove and unique compact
+      every chunk in place, then move its kept elements down to the end of the ones of the
+      chunks before it. a chunk of unique and unique_copy compares its first element to the
+      last one of the chunk before it, adjacent_find looks at the pair of its last element
+      and the first of the next chunk too, and stops like find_if, after a match before it.
+
+*/
+namespace compaction
+{
+    namespace detail
+    {
+        template<class P>
+        constexpr bool is_policy = std::is_same_v<std::decay_t<P>, parallel::Sequenced_policy>
+            || std::is_same_v<std::decay_t<P>, parallel::Parallel_policy>
+            || std::is_same_v<std::decay_t<P>, parallel::Parallel_unsequenced_policy>;
+
+        template<class It>
+        using Value_type = typename std::iterator_traits<It>::value_type;
+
+        template<class It>
+        constexpr bool is_random_access = std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+        template<class It>
+        constexpr bool is_branchless = is_random_access<It> && std::is_trivially_copyable_v<Value_type<It>>;
+
+        template<class It, class = void>
+        struct Contiguous : std::false_type {};
+
+        template<class T>
+        struct Contiguous<T*> : std::true_type {};
+
+        template<class It>
+        struct Contiguous<It, std::enable_if_t<!std::is_pointer_v<It> && !std::is_same_v<Value_type<It>, bool>>>
+        {
+            using value_type = Value_type<It>;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>
+                || (std::is_same_v<value_type, char> && (std::is_same_v<It, std::string::iterator>
+                    || std::is_same_v<It, std::string::const_iterator>));
+        };
+
+        template<class It>
+        constexpr bool is_vectorized = Contiguous<It>::value && std::is_trivially_copyable_v<Value_type<It>>
+            && (sizeof(Value_type<It>) == 4 || sizeof(Value_type<It>) == 8);
+
+        // elements that are equal when their bytes are, compared by std::equal_to
+        template<class It, class BinaryPred>
+        constexpr bool is_vectorized_equal = is_vectorized<It>
+            && (std::is_integral_v<Value_type<It>> || std::is_enum_v<Value_type<It>> || std::is_pointer_v<Value_type<It>>)
+            && (std::is_same_v<std::decay_t<BinaryPred>, std::equal_to<>>
+                || std::is_same_v<std::decay_t<BinaryPred>, std::equal_to<Value_type<It>>>);
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+        // the lanes of the kept ones of 8 lanes of 4 bytes, first, for every mask of them
+        inline constexpr std::array<std::uint64_t, 256> lanes_of_4 = []
+        {
+            std::array<std::uint64_t, 256> lanes {};
+            for (unsigned mask = 0; mask < 256; ++mask)
+            {
+                unsigned k {0};
+                for (unsigned lane = 0; lane < 8; ++lane)
+                    if ((mask >> lane) & 1)
+                        lanes[mask] |= static_cast<std::uint64_t>(lane) << (8 * k++);
+            }
+            return lanes;
+        }();
+
+        // the same for 4 lanes of 8 bytes, as the 2 lanes of 4 bytes of each of them
+        inline constexpr std::array<std::uint64_t, 16> lanes_of_8 = []
+        {
+            std::array<std::uint64_t, 16> lanes {};
+            for (unsigned mask = 0; mask < 16; ++mask)
+            {
+                unsigned k {0};
+                for (unsigned lane = 0; lane < 4; ++lane)
+                    if ((mask >> lane) & 1)
+                    {
+                        lanes[mask] |= static_cast<std::uint64_t>(2 * lane) << (8 * k++);
+                        lanes[mask] |= static_cast<std::uint64_t>(2 * lane + 1) << (8 * k++);
+                    }
+            }
+            return lanes;
+        }();
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#if defined(__AVX512F__)
+        using Vector = __m512i;
+        constexpr std::size_t vector_bytes = 64;
+#else
+        using Vector = __m256i;
+        constexpr std::size_t vector_bytes = 32;
+#endif
+
+        template<class T>
+        Vector load(const T* p)
+        {
+#if defined(__AVX512F__)
+            return _mm512_loadu_si512(p);
+#else
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+#endif
+        }
+
+        // the lanes of v that are in mask, first, to out: a whole vector is written
+        template<class T>
+        void compress_store(T* out, Vector v, unsigned mask)
+        {
+#if defined(__AVX512F__)
+            if constexpr (sizeof(T) == 4)
+                _mm512_storeu_si512(out, _mm512_maskz_compress_epi32(static_cast<__mmask16>(mask), v));
+            else
+                _mm512_storeu_si512(out, _mm512_maskz_compress_epi64(static_cast<__mmask8>(mask), v));
+#else
+            const std::uint64_t order = sizeof(T) == 4 ? lanes_of_4[mask] : lanes_of_8[mask];
+            const __m256i permutation = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(order)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(v, permutation));
+#endif
+        }
+
+        // the mask of the lanes of a and b that differ
+        template<class T>
+        unsigned not_equal(Vector a, Vector b)
+        {
+#if defined(__AVX512F__)
+            if constexpr (sizeof(T) == 4)
+                return _mm512_cmpneq_epi32_mask(a, b);
+            else
+                return _mm512_cmpneq_epi64_mask(a, b);
+#else
+            if constexpr (sizeof(T) == 4)
+                return ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))) & 0xff;
+            else
+                return ~static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))) & 0xf;
+#endif
+        }
+
+        // the lanes of v one up, the first one is the last one of before
+        template<class T>
+        Vector shift_in(Vector before, Vector v)
+        {
+#if defined(__AVX512F__)
+            // with a mask of all the lanes, the one without a mask starts from an undefined vector gcc warns about
+            if constexpr (sizeof(T) == 4)
+                return _mm512_mask_alignr_epi32(v, 0xffff, v, before, 15);
+            else
+                return _mm512_mask_alignr_epi64(v, 0xff, v, before, 7);
+#else
+            const __m256i middle = _mm256_permute2x128_si256(before, v, 0x21);
+            return _mm256_alignr_epi8(v, middle, 16 - sizeof(T));
+#endif
+        }
+#endif
+
+        // the n elements of in that keep(element) is true for, to out, that is not after in, or
+        // is somewhere else with room for n, and how many
+        template<class T, class Keep>
+        std::size_t compact(const T* in, std::size_t n, T* out, const Keep& keep)
+        {
+            std::size_t i {0};
+            std::size_t w {0};
+#if defined(__AVX512F__) || defined(__AVX2__)
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                constexpr std::size_t lanes = vector_bytes / sizeof(T);
+                for (; i + lanes <= n; i += lanes)
+                {
+                    unsigned mask {0};
+                    for (std::size_t k = 0; k < lanes; ++k)
+                        mask |= static_cast<unsigned>(static_cast<bool>(keep(in[i + k]))) << k;
+                    // it is not after in + i + lanes
+                    compress_store(out + w, load(in + i), mask);
+                    w += static_cast<std::size_t>(__builtin_popcount(mask));
+                }
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                const T value = in[i];
+                out[w] = value;
+                w += static_cast<bool>(keep(value));
+            }
+            return w;
+        }
+
+        template<class RandomIt, class Keep>
+        RandomIt remove_if(RandomIt first, RandomIt last, const Keep& keep)
+        {
+            using T = Value_type<RandomIt>;
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if constexpr (is_vectorized<RandomIt>)
+            {
+                if (n == 0)
+                    return first;
+                T* data = std::addressof(*first);
+                return first + static_cast<std::ptrdiff_t>(compact(data, n, data, keep));
+            }
+            else
+            {
+                std::size_t w {0};
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const T value = first[i];
+                    first[w] = value;
+                    w += static_cast<bool>(keep(value));
+                }
+                return first + static_cast<std::ptrdiff_t>(w);
+            }
+        }
+
+        // the index of the first of two equal neighbours of the n elements of in, n when none are
+        template<class T>
+        std::size_t adjacent_equal(const T* in, std::size_t n)
+        {
+            std::size_t i {0};
+#if defined(__AVX512F__) || defined(__AVX2__)
+            constexpr std::size_t lanes = vector_bytes / sizeof(T);
+            constexpr unsigned all = (1u << lanes) - 1;
+            // the vector from in + i + 1 is the one from in + i shifted by one lane
+            for (; i + lanes < n; i += lanes)
+            {
+                const unsigned equal = ~not_equal<T>(load(in + i), load(in + i + 1)) & all;
+                if (equal != 0)
+                    return i + static_cast<std::size_t>(__builtin_ctz(equal));
+            }
+#endif
+            for (; i + 1 < n; ++i)
+                if (in[i] == in[i + 1])
+                    return i;
+            return n;
+        }
+
+        // unique of the n elements of in, n > 0, to out, that is not after in, or is somewhere
+        // else with room for n, the ones equal to the one before them are dropped
+        template<class T>
+        std::size_t unique_equal(const T* in, std::size_t n, T* out)
+        {
+            T previous = in[0];
+            out[0] = previous;
+            std::size_t i {1};
+            std::size_t w {1};
+#if defined(__AVX512F__) || defined(__AVX2__)
+            constexpr std::size_t lanes = vector_bytes / sizeof(T);
+            Vector before {};
+            for (; i + lanes <= n; i += lanes)
+            {
+                // the store of a vector can be over the ones after the kept ones, up to in + i + lanes,
+                // so the neighbours of a vector are the ones kept in a register
+                const Vector v = load(in + i);
+                const unsigned mask = not_equal<T>(v, i == 1 ? load(in) : shift_in<T>(before, v));
+                previous = in[i + lanes - 1];
+                compress_store(out + w, v, mask);
+                w += static_cast<std::size_t>(__builtin_popcount(mask));
+                before = v;
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                const T value = in[i];
+                out[w] = value;
+                w += !(value == previous);
+                previous = value;
+            }
+            return w;
+        }
+
+        // how many of the n elements of in unique keeps, the first one is compared to in[-1] when
+        // after is true
+        template<class T>
+        std::size_t count_unique(const T* in, std::size_t n, bool after)
+        {
+            if (n == 0)
+                return 0;
+            std::size_t i {after ? 0u : 1u};
+            std::size_t kept {after ? 0u : 1u};
+#if defined(__AVX512F__) || defined(__AVX2__)
+            constexpr std::size_t lanes = vector_bytes / sizeof(T);
+            for (; i + lanes <= n; i += lanes)
+                kept += static_cast<std::size_t>(__builtin_popcount(not_equal<T>(load(in + i), load(in + i - 1))));
+#endif
+            for (; i < n; ++i)
+                kept += !(in[i] == in[i - 1]);
+            return kept;
+        }
+
+        // unique_copy of the n elements of data, through a buffer of 64 elements, a block after
+        // the first one, or the first one with after, starts at the element before it, that is
+        // compacted with it and left out
+        template<class T, class OutputIt>
+        OutputIt unique_copy(const T* data, std::size_t n, OutputIt d_first, bool after)
+        {
+            constexpr std::size_t block = 64;
+            T buffer[block + 1];
+            for (std::size_t i = 0; i < n; i += block)
+            {
+                const std::size_t from = i == 0 && !after ? 0 : 1;
+                const std::size_t kept = unique_equal(data + i - from, std::min(block, n - i) + from, buffer);
+                d_first = std::copy(buffer + from, buffer + kept, d_first);
+            }
+            return d_first;
+        }
+
+        // unique of the n elements of in, to out, that is not after in
+        template<class InIt, class OutIt, class BinaryPred>
+        std::size_t unique(InIt in, std::size_t n, OutIt out, BinaryPred& p)
+        {
+            if (n == 0)
+                return 0;
+            if constexpr (is_vectorized_equal<InIt, BinaryPred> && std::is_same_v<InIt, OutIt>)
+                return unique_equal(std::addressof(*in), n, std::addressof(*out));
+            out[0] = in[0];
+            std::size_t w {1};
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                const Value_type<InIt> value = in[i];
+                out[w] = value;
+                w += !p(out[w - 1], value);
+            }
+            return w;
+        }
+
+        // moves the kept elements of every chunk down, after the ones of the chunks before it
+        template<class RandomIt>
+        RandomIt join(RandomIt first, std::size_t n, std::size_t chunks, const std::vector<std::size_t>& kept)
+        {
+            std::size_t w {kept[0]};
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+            {
+                RandomIt begin = first + static_cast<std::ptrdiff_t>(n / chunks * chunk + std::min(chunk, n % chunks));
+                if (begin != first + static_cast<std::ptrdiff_t>(w))
+                    std::move(begin, begin + static_cast<std::ptrdiff_t>(kept[chunk]), first + static_cast<std::ptrdiff_t>(w));
+                w += kept[chunk];
+            }
+            return first + static_cast<std::ptrdiff_t>(w);
+        }
+    }
+
+    template<class ForwardIt, class UnaryPred, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt remove_if(ForwardIt first, ForwardIt last, UnaryPred p)
+    {
+        if constexpr (detail::is_branchless<ForwardIt>)
+            return detail::remove_if(first, last, [&p](const auto& value) { return !p(value); });
+        else
+            return std::remove_if(first, last, p);
+    }
+
+    template<class ForwardIt, class T, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt remove(ForwardIt first, ForwardIt last, const T& value)
+    {
+        return compaction::remove_if(first, last, [&value](const auto& element) { return element == value; });
+    }
+
+    template<class InputIt, class OutputIt, class UnaryPred, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first, UnaryPred p)
+    {
+        using T = detail::Value_type<InputIt>;
+        if constexpr (detail::is_vectorized<InputIt> && std::is_default_constructible_v<T>)
+        {
+            constexpr std::size_t block = 64;
+            T buffer[block];
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n == 0)
+                return d_first;
+            const T* data = std::addressof(*first);
+            for (std::size_t i = 0; i < n; i += block)
+            {
+                const std::size_t kept = detail::compact(data + i, std::min(block, n - i), buffer, p);
+                d_first = std::copy(buffer, buffer + kept, d_first);
+            }
+            return d_first;
+        }
+        else
+            return std::copy_if(first, last, d_first, p);
+    }
+
+    template<class ForwardIt, class BinaryPred, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt unique(ForwardIt first, ForwardIt last, BinaryPred p)
+    {
+        if constexpr (detail::is_branchless<ForwardIt>)
+            return first + static_cast<std::ptrdiff_t>(detail::unique(first, static_cast<std::size_t>(last - first), first, p));
+        else
+            return std::unique(first, last, p);
+    }
+
+    template<class ForwardIt, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt unique(ForwardIt first, ForwardIt last)
+    {
+        return compaction::unique(first, last, std::equal_to<> {});
+    }
+
+    template<class InputIt, class OutputIt, class BinaryPred, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt unique_copy(InputIt first, InputIt last, OutputIt d_first, BinaryPred p)
+    {
+        if constexpr (detail::is_vectorized_equal<InputIt, BinaryPred>)
+        {
+            if (first == last)
+                return d_first;
+            return detail::unique_copy(std::addressof(*first), static_cast<std::size_t>(last - first), d_first, false);
+        }
+        else
+            return std::unique_copy(first, last, d_first, p);
+    }
+
+    template<class InputIt, class OutputIt, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt unique_copy(InputIt first, InputIt last, OutputIt d_first)
+    {
+        return compaction::unique_copy(first, last, d_first, std::equal_to<> {});
+    }
+
+    template<class ForwardIt, class BinaryPred, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt adjacent_find(ForwardIt first, ForwardIt last, BinaryPred p)
+    {
+        if constexpr (detail::is_vectorized_equal<ForwardIt, BinaryPred>)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n == 0)
+                return last;
+            const std::size_t i = detail::adjacent_equal(std::addressof(*first), n);
+            return i == n ? last : first + static_cast<std::ptrdiff_t>(i);
+        }
+        else
+            return std::adjacent_find(first, last, p);
+    }
+
+    template<class ForwardIt, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt adjacent_find(ForwardIt first, ForwardIt last)
+    {
+        return compaction::adjacent_find(first, last, std::equal_to<> {});
+    }
+
+    template<class ForwardIt, class UnaryPred, std::enable_if_t<!detail::is_policy<ForwardIt>, int> = 0>
+    ForwardIt partition(ForwardIt first, ForwardIt last, UnaryPred p)
+    {
+        if constexpr (detail::is_branchless<ForwardIt>)
+        {
+            using T = detail::Value_type<ForwardIt>;
+            // the ones before w are true, the ones from w to i are false
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            std::size_t w {0};
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const T value = first[i];
+                const bool is_true = static_cast<bool>(p(value));
+                first[i] = first[w];
+                first[w] = value;
+                w += is_true;
+            }
+            return first + static_cast<std::ptrdiff_t>(w);
+        }
+        else
+            return std::partition(first, last, p);
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt remove_if(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt>)
+            return compaction::remove_if(first, last, p);
+        else
+        {
+            Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+            const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+            if (chunks == 1)
+                return compaction::remove_if(first, last, p);
+            std::vector<std::size_t> kept(chunks);
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                kept[chunk] = static_cast<std::size_t>(compaction::remove_if(first + begin, first + end, p) - (first + begin));
+            });
+            return detail::join(first, n, chunks, kept);
+        }
+    }
+
+    template<class Policy, class RandomIt, class T, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt remove(Policy&& policy, RandomIt first, RandomIt last, const T& value)
+    {
+        return compaction::remove_if(policy, first, last, [&value](const auto& element) { return element == value; });
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class UnaryPred, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 copy_if(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, UnaryPred p)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt1, RandomIt2>)
+            return compaction::copy_if(first, last, d_first, p);
+        else
+        {
+            Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+            const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+            if (chunks == 1)
+                return compaction::copy_if(first, last, d_first, p);
+            // how many every chunk keeps, then where they go
+            std::vector<std::size_t> offsets(chunks + 1);
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                offsets[chunk + 1] = static_cast<std::size_t>(std::count_if(first + begin, first + end, p));
+            });
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                compaction::copy_if(first + begin, first + end, d_first + static_cast<std::ptrdiff_t>(offsets[chunk]), p);
+            });
+            return d_first + static_cast<std::ptrdiff_t>(offsets[chunks]);
+        }
+    }
+
+    template<class Policy, class RandomIt, class BinaryPred, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt unique(Policy&& policy, RandomIt first, RandomIt last, BinaryPred p)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt>)
+            return compaction::unique(first, last, p);
+        else
+        {
+            Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+            const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+            if (chunks == 1)
+                return compaction::unique(first, last, p);
+
+            // a chunk that starts with an element equal to the one before it drops the ones
+            // equal to its first one, found before any chunk writes
+            const auto bounds = [n, chunks](std::size_t chunk) { return n / chunks * chunk + std::min(chunk, n % chunks); };
+            std::vector<char> keeps_first(chunks, 1);
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+                keeps_first[chunk] = !p(first[bounds(chunk) - 1], first[bounds(chunk)]);
+
+            std::vector<std::size_t> kept(chunks);
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                if (!keeps_first[chunk])
+                {
+                    const std::size_t equal = begin;
+                    while (begin != end && p(first[equal], first[begin]))
+                        ++begin;
+                }
+                RandomIt out = first + static_cast<std::ptrdiff_t>(bounds(chunk));
+                if constexpr (detail::is_branchless<RandomIt>)
+                    kept[chunk] = detail::unique(first + static_cast<std::ptrdiff_t>(begin), end - begin, out, p);
+                else
+                {
+                    RandomIt in = first + static_cast<std::ptrdiff_t>(begin);
+                    RandomIt in_last = std::unique(in, first + static_cast<std::ptrdiff_t>(end), p);
+                    kept[chunk] = static_cast<std::size_t>(in_last - in);
+                    if (in != out)
+                        std::move(in, in_last, out);
+                }
+            });
+            return detail::join(first, n, chunks, kept);
+        }
+    }
+
+    template<class Policy, class RandomIt, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt unique(Policy&& policy, RandomIt first, RandomIt last)
+    {
+        return compaction::unique(policy, first, last, std::equal_to<> {});
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class BinaryPred, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 unique_copy(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, BinaryPred p)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt1, RandomIt2>)
+            return compaction::unique_copy(first, last, d_first, p);
+        else
+        {
+            Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+            const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+            if (chunks == 1)
+                return compaction::unique_copy(first, last, d_first, p);
+            // the first element of a chunk after the first one is kept when it is not equal to
+            // the last one of the chunk before it
+            std::vector<std::size_t> offsets(chunks + 1);
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                if constexpr (detail::is_vectorized_equal<RandomIt1, BinaryPred>)
+                    offsets[chunk + 1] = detail::count_unique(std::addressof(*(first + begin)), end - begin, begin != 0);
+                else
+                {
+                    std::size_t kept {0};
+                    for (std::size_t i = begin; i < end; ++i)
+                        kept += i == 0 || !p(first[i - 1], first[i]);
+                    offsets[chunk + 1] = kept;
+                }
+            });
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                RandomIt2 out = d_first + static_cast<std::ptrdiff_t>(offsets[chunk]);
+                if constexpr (detail::is_vectorized_equal<RandomIt1, BinaryPred>)
+                    detail::unique_copy(std::addressof(*(first + begin)), end - begin, out, begin != 0);
+                else
+                    for (std::size_t i = begin; i < end; ++i)
+                        if (i == 0 || !p(first[i - 1], first[i]))
+                            *out++ = first[i];
+            });
+            return d_first + static_cast<std::ptrdiff_t>(offsets[chunks]);
+        }
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 unique_copy(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first)
+    {
+        return compaction::unique_copy(policy, first, last, d_first, std::equal_to<> {});
+    }
+
+    template<class Policy, class RandomIt, class BinaryPred, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt adjacent_find(Policy&& policy, RandomIt first, RandomIt last, BinaryPred p)
+    {
+        const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt>)
+            return compaction::adjacent_find(first, last, p);
+        else
+        {
+            Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+            const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+            if (chunks == 1)
+                return compaction::adjacent_find(first, last, p);
+            // a block is looked at with the element after it, so the pairs across the chunks are
+            // the ones of the chunks before them, and found every block, like find_if
+            constexpr std::size_t block = 4096;
+            std::atomic<std::size_t> found {n};
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                for (std::size_t from = begin; from < end; from += block)
+                {
+                    if (from >= found.load(std::memory_order_relaxed))
+                        return;
+                    const RandomIt to = first + static_cast<std::ptrdiff_t>(std::min(n, std::min(end, from + block) + 1));
+                    const RandomIt it = compaction::adjacent_find(first + static_cast<std::ptrdiff_t>(from), to, p);
+                    if (it != to)
+                    {
+                        parallel::detail::store_min(found, static_cast<std::size_t>(it - first));
+                        return;
+                    }
+                }
+            });
+            return first + static_cast<std::ptrdiff_t>(found.load());
+        }
+    }
+
+    template<class Policy, class RandomIt, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt adjacent_find(Policy&& policy, RandomIt first, RandomIt last)
+    {
+        return compaction::adjacent_find(policy, first, last, std::equal_to<> {});
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include "Compaction.h"
+
+struct Event
+{
+    int account;
+    int amount;
+};
+
+int main()
+{
+    std::string str2 = "Text\n with\tsome \t  whitespaces\n\n";
+    str2.erase(compaction::remove_if(str2.begin(), str2.end(), [](unsigned char x) { return std::isspace(x); }), str2.end());
+    std::cout << str2 << '\n';
+
+    // the events of the accounts, 8 bytes each, so 8 of them, or 4, are looked at at once
+    std::vector<Event> events(1'000'000);
+    std::mt19937 gen {1};
+    for (Event& event : events)
+        event = Event {static_cast<int>(gen() % 100), static_cast<int>(gen() % 2001) - 1000};
+
+    std::vector<Event> withdrawals(events.size());
+    withdrawals.erase(compaction::copy_if(events.begin(), events.end(), withdrawals.begin(), [](const Event& e) { return e.amount < 0; }),
+                      withdrawals.end());
+    std::cout << "withdrawals: " << withdrawals.size() << " of " << events.size() << '\n';
+
+    std::vector<Event> large {events};
+    large.erase(compaction::remove_if(parallel::par, large.begin(), large.end(), [](const Event& e) { return e.amount > -900 && e.amount < 900; }),
+                large.end());
+    std::cout << "over 900 either way: " << large.size() << '\n';
+
+    std::vector<int> v {1, 2, 2, 2, 3, 3, 2, 2, 1};
+    v.erase(compaction::unique(v.begin(), v.end()), v.end());
+    for (int i : v)
+        std::cout << i << ' ';
+    std::cout << '\n';
+
+    // the sorted ids of the accounts of the events, once each, 8 of them compared to their
+    // neighbours at once with -mavx2
+    std::vector<std::uint32_t> ids(events.size());
+    std::transform(events.begin(), events.end(), ids.begin(), [](const Event& e) { return static_cast<std::uint32_t>(e.account); });
+    std::sort(ids.begin(), ids.end());
+    std::cout << "first repeated id: " << *compaction::adjacent_find(ids.begin(), ids.end()) << '\n';
+    std::vector<std::uint32_t> accounts;
+    compaction::unique_copy(ids.begin(), ids.end(), std::back_inserter(accounts));
+    ids.erase(compaction::unique(parallel::par, ids.begin(), ids.end()), ids.end());
+    std::cout << "accounts: " << accounts.size() << ", the same with par: " << std::boolalpha << (ids == accounts) << '\n';
+
+    std::vector<int> numbers {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto middle = compaction::partition(numbers.begin(), numbers.end(), [](int i) { return i % 2 == 0; });
+    std::cout << "even: ";
+    for (auto it = numbers.begin(); it != middle; ++it)
+        std::cout << *it << ' ';
+    std::cout << "odd: ";
+    for (auto it = middle; it != numbers.end(); ++it)
+        std::cout << *it << ' ';
+    std::cout << '\n';
+
+    return 0;
+}
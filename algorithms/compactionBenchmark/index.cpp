@@ -0,0 +1,134 @@
+/*
+
+    - compares std::remove_if, std::copy_if, std::unique and std::partition against the ones
+      of ../compaction/Compaction.h, and remove_if and copy_if with par on pools of 1, 2, 4,
+      ... threads, up to twice the cores, on events of 8 bytes that are kept at random, half
+      of them, so the branch on the predicate of the std ones is wrong half the time, and
+      checks that they give the same results.
+
+    - build it with, -mavx2 or -mavx512f for the compress of 4 or 8 events at a time:
+        g++ -std=c++17 -O2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 50'000'000 events by default, the number can be given on the command line, e.g.
+      ./a.out 10000000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../compaction/Compaction.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+struct Event
+{
+    std::int32_t account;
+    std::int32_t amount;
+};
+
+bool operator==(const Event& a, const Event& b)
+{
+    return a.account == b.account && a.amount == b.amount;
+}
+
+bool is_withdrawal(const Event& e)
+{
+    return e.amount < 0;
+}
+
+bool same_account(const Event& a, const Event& b)
+{
+    return a.account == b.account;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ns per event of f(copy of events), that returns the end of what it kept
+template <typename F>
+std::vector<Event> run(const std::string& name, const std::vector<Event>& events, F f, const std::vector<Event>* expected = nullptr)
+{
+    std::vector<Event> copy {events};
+    const auto start = std::chrono::steady_clock::now();
+    const auto last = f(copy);
+    copy.erase(last, copy.end());
+    const double seconds = seconds_since(start);
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << seconds * 1e9 / events.size()
+        << (expected == nullptr || copy == *expected ? "" : "    WRONG") << std::endl;
+    return copy;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50'000'000;
+
+    std::vector<Event> events(n);
+    std::mt19937_64 gen {42};
+    for (Event& event : events)
+        event = Event {static_cast<std::int32_t>(gen() % 4), static_cast<std::int32_t>(gen() % 2001) - 1000};
+
+    std::cout << n << " events, ns per event" << std::endl;
+    const std::vector<Event> removed = run("std::remove_if", events, [](std::vector<Event>& v) {
+        return std::remove_if(v.begin(), v.end(), is_withdrawal);
+    });
+    run("compaction::remove_if", events, [](std::vector<Event>& v) {
+        return compaction::remove_if(v.begin(), v.end(), is_withdrawal);
+    }, &removed);
+
+    std::vector<Event> out(n);
+    const std::vector<Event> copied = run("std::copy_if", events, [&out](std::vector<Event>& v) {
+        auto last = std::copy_if(v.begin(), v.end(), out.begin(), is_withdrawal);
+        v.assign(out.begin(), last);
+        return v.end();
+    });
+    run("compaction::copy_if", events, [&out](std::vector<Event>& v) {
+        auto last = compaction::copy_if(v.begin(), v.end(), out.begin(), is_withdrawal);
+        v.assign(out.begin(), last);
+        return v.end();
+    }, &copied);
+
+    const std::vector<Event> unique = run("std::unique", events, [](std::vector<Event>& v) {
+        return std::unique(v.begin(), v.end(), same_account);
+    });
+    run("compaction::unique", events, [](std::vector<Event>& v) {
+        return compaction::unique(v.begin(), v.end(), same_account);
+    }, &unique);
+
+    run("std::partition", events, [](std::vector<Event>& v) {
+        std::partition(v.begin(), v.end(), is_withdrawal);
+        return v.end();
+    });
+    run("compaction::partition", events, [](std::vector<Event>& v) {
+        compaction::partition(v.begin(), v.end(), is_withdrawal);
+        return v.end();
+    });
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        run("remove_if, par, " + std::to_string(threads) + " threads", events, [&pool](std::vector<Event>& v) {
+            return compaction::remove_if(parallel::par.on(pool), v.begin(), v.end(), is_withdrawal);
+        }, &removed);
+        run("copy_if, par, " + std::to_string(threads) + " threads", events, [&pool, &out](std::vector<Event>& v) {
+            auto last = compaction::copy_if(parallel::par.on(pool), v.begin(), v.end(), out.begin(), is_withdrawal);
+            v.assign(out.begin(), last);
+            return v.end();
+        }, &copied);
+        run("unique, par, " + std::to_string(threads) + " threads", events, [&pool](std::vector<Event>& v) {
+            return compaction::unique(parallel::par.on(pool), v.begin(), v.end(), same_account);
+        }, &unique);
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+
+    - compares std::adjacent_find, std::unique and std::unique_copy against the ones of
+      ../compaction/Compaction.h on a sorted list of account ids of 4 bytes, each one there
+      1 to 3 times, so about half of them are dropped at random: the branchless loop of a
+      predicate of its own, the vectors of the std::equal_to of the ids, and those with par
+      on pools of 1, 2, 4, ... threads, up to twice the cores. adjacent_find looks at a list
+      of distinct ids, with one repeat in the last element.
+
+    - the results have to be the ones of the std algorithms, a mismatch is reported and the
+      exit code is 1. the times are the medians of ../benchmarkHarness/Benchmark_harness.h, a
+      warm up and 5 runs, each one on a fresh copy of the ids.
+
+    - build it with, -mavx2 or -mavx512f for the compare and the compress of 8 ids, or 16, at
+      a time, without them it is the branchless loop:
+        g++ -std=c++17 -O2 -mavx2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 100'000'000 ids by default, the number can be given on the command line, e.g.
+      ./a.out 10000000
+
+    - on one core of an x86-64 at -O2, 100M ids, ns an id:
+                                        -mavx2      -mavx512f
+        std::adjacent_find              2.16        2.32
+        compaction::adjacent_find       1.07        0.89
+        std::unique                    11.07       12.22
+        unique, own predicate           8.12        8.48
+        compaction::unique              1.22        1.23
+        std::unique_copy               12.18       12.15
+        compaction::unique_copy         2.44        2.46
+        unique, par, 1 thread           2.01        2.24
+      adjacent_find reads 4 to 4.5 GB a second, the speed of the memory. std::unique has a branch
+      on every id that is wrong about half the time on these, the loop of a predicate none,
+      compaction::unique compares and compresses 8 ids at a time. unique_copy writes through a buffer
+      and then copies it out. on one core par only adds the move of the kept ids of every
+      chunk down, after the ones before them.
+
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../compaction/Compaction.h"
+#include "../fastRandom/Fast_random.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+const bench::Options options {1, 5};
+std::size_t mismatches {0};
+
+// ns an id of f(copy of ids), that returns the end of what it kept
+template<class F>
+std::vector<std::uint32_t> run(const std::string& name, const std::vector<std::uint32_t>& ids, F f, const std::vector<std::uint32_t>* expected = nullptr)
+{
+    static bench::Perf_events events;
+    std::vector<std::uint32_t> copy;
+    std::vector<std::uint32_t>::iterator last;
+    const double ns = bench::measure("compaction", name, ids.size(), options, events, [&] { copy = ids; }, [&] { last = f(copy); })
+        .ns_per_element();
+    copy.erase(last, copy.end());
+    const bool mismatch = expected != nullptr && copy != *expected;
+    mismatches += mismatch;
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+              << std::setw(10) << std::right << ns
+              << (mismatch ? "    WRONG" : "") << std::endl;
+    return copy;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000'000;
+
+    fast_random::Xoshiro256ss gen {42};
+    std::vector<std::uint32_t> ids(n), distinct(n);
+    std::uint32_t id {0};
+    for (std::size_t i = 0; i < n;)
+    {
+        const std::size_t repeats = 1 + static_cast<std::size_t>(fast_random::bounded(gen, 3));
+        for (std::size_t k = 0; k < repeats && i < n; ++k)
+            ids[i++] = id;
+        id += 1 + static_cast<std::uint32_t>(fast_random::bounded(gen, 4));
+    }
+    for (std::size_t i = 0; i < n; ++i)
+        distinct[i] = static_cast<std::uint32_t>(i);
+    if (n > 1)
+        distinct[n - 1] = distinct[n - 2];
+    const auto own_equal = [](std::uint32_t a, std::uint32_t b) { return a == b; };
+
+    std::cout << n << " ids, ns an id" << std::endl;
+    // adjacent_find keeps the ids before the repeat
+    const std::vector<std::uint32_t> before_repeat = run("std::adjacent_find", distinct, [](std::vector<std::uint32_t>& v) {
+        return std::adjacent_find(v.begin(), v.end());
+    });
+    run("compaction::adjacent_find", distinct, [](std::vector<std::uint32_t>& v) {
+        return compaction::adjacent_find(v.begin(), v.end());
+    }, &before_repeat);
+
+    const std::vector<std::uint32_t> unique = run("std::unique", ids, [](std::vector<std::uint32_t>& v) {
+        return std::unique(v.begin(), v.end());
+    });
+    run("unique, own predicate", ids, [&own_equal](std::vector<std::uint32_t>& v) {
+        return compaction::unique(v.begin(), v.end(), own_equal);
+    }, &unique);
+    run("compaction::unique", ids, [](std::vector<std::uint32_t>& v) {
+        return compaction::unique(v.begin(), v.end());
+    }, &unique);
+
+    std::vector<std::uint32_t> out(n);
+    run("std::unique_copy", ids, [&out](std::vector<std::uint32_t>& v) {
+        auto last = std::unique_copy(v.begin(), v.end(), out.begin());
+        v.assign(out.begin(), last);
+        return v.end();
+    }, &unique);
+    run("compaction::unique_copy", ids, [&out](std::vector<std::uint32_t>& v) {
+        auto last = compaction::unique_copy(v.begin(), v.end(), out.begin());
+        v.assign(out.begin(), last);
+        return v.end();
+    }, &unique);
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        run("adjacent_find, par, " + std::to_string(threads) + " threads", distinct, [&pool](std::vector<std::uint32_t>& v) {
+            return compaction::adjacent_find(parallel::par.on(pool), v.begin(), v.end());
+        }, &before_repeat);
+        run("unique, par, " + std::to_string(threads) + " threads", ids, [&pool](std::vector<std::uint32_t>& v) {
+            return compaction::unique(parallel::par.on(pool), v.begin(), v.end());
+        }, &unique);
+        run("unique_copy, par, " + std::to_string(threads) + " threads", ids, [&pool, &out](std::vector<std::uint32_t>& v) {
+            auto last = compaction::unique_copy(parallel::par.on(pool), v.begin(), v.end(), out.begin());
+            v.assign(out.begin(), last);
+            return v.end();
+        }, &unique);
+    }
+
+    std::cout << "mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
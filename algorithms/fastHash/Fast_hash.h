@@ -0,0 +1,283 @@
+#ifndef _FAST_HASH_H_
+#define _FAST_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*
+
+    - hashes for the hash tables, the Bloom filters and the interning of the examples, in
+      place of std::hash: the one of libstdc++ is murmur for the strings and the number as
+      it is for the integers, a table of a power of two of slots keeps only its low bits.
+
+    - hash_bytes is wyhash, its final version: the bytes are read 8 at a time, two words
+      are folded into one with a 64 x 64 = 128 bit multiply, the xor of its halves, a key of
+      up to 16 bytes is one load of each end and two multiplies, a longer one 48 bytes a
+      round in three chains. hash_int is two of those multiplies of a number and the seed,
+      mix a bijection of the numbers, two multiplies and xor shifts, for a number that has
+      to stay unique. the hashes are the ones of the byte order of the machine.
+
+    - every one takes a seed, the hash of a key is another for another seed, a table whose
+      keys come from outside, e.g. the names of a file, hashes them with a seed of its own,
+      process_seed() is one from std::random_device given once in a process, so the keys
+      that all go to one slot can't be made in advance. Hash<T> is the functor of the
+      default seed, Random_hash<T> the one of process_seed(), both have no state.
+
+    - hash_many hashes n keys at once, 4 lanes side by side: the keys of up to 16 bytes are
+      read without a branch on their length, the loads of the ends of a short key come from
+      a block of zeros when it is too short for them and a select keeps the right ones, so
+      keys of random lengths do not mispredict, and the 4 multiplies of a step are
+      independent. the 128 bit multiply is not one of AVX2, the lanes are scalar ones,
+      the hashes are the ones of hash_bytes.
+
+*/
+namespace fast_hash
+{
+    namespace detail
+    {
+        constexpr std::uint64_t secret[4] {0xA0761D6478BD642F, 0xE7037ED1A0B428DB, 0x8EBC6AF09C88C6E3, 0x589965CC75374CC3};
+
+        // the low and the high half of a * b
+        inline void mum(std::uint64_t& a, std::uint64_t& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            __extension__ using Uint128 = unsigned __int128;
+            const Uint128 product = static_cast<Uint128>(a) * b;
+            a = static_cast<std::uint64_t>(product);
+            b = static_cast<std::uint64_t>(product >> 64);
+#else
+            const std::uint64_t a_high = a >> 32, a_low = a & 0xFFFFFFFF, b_high = b >> 32, b_low = b & 0xFFFFFFFF;
+            const std::uint64_t high_high = a_high * b_high, high_low = a_high * b_low;
+            const std::uint64_t low_high = a_low * b_high, low_low = a_low * b_low;
+            const std::uint64_t t = low_low + (high_low << 32);
+            const std::uint64_t low = t + (low_high << 32);
+            const std::uint64_t carry = (t < low_low) + (low < t);
+            b = high_high + (high_low >> 32) + (low_high >> 32) + carry;
+            a = low;
+#endif
+        }
+
+        inline std::uint64_t fold(std::uint64_t a, std::uint64_t b)
+        {
+            mum(a, b);
+            return a ^ b;
+        }
+
+        inline std::uint64_t read8(const unsigned char* p)
+        {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+
+        inline std::uint64_t read4(const unsigned char* p)
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        // the one, two or three bytes of a key of 1 to 3 bytes
+        inline std::uint64_t read3(const unsigned char* p, std::size_t size)
+        {
+            return static_cast<std::uint64_t>(p[0]) << 16 | static_cast<std::uint64_t>(p[size >> 1]) << 8 | p[size - 1];
+        }
+
+        inline std::uint64_t seeded(std::uint64_t seed)
+        {
+            return seed ^ fold(seed ^ secret[0], secret[1]);
+        }
+
+        inline std::uint64_t finish(std::uint64_t a, std::uint64_t b, std::uint64_t seed, std::size_t size)
+        {
+            a ^= secret[1];
+            b ^= seed;
+            mum(a, b);
+            return fold(a ^ secret[0] ^ size, b ^ secret[1]);
+        }
+
+        // the seed after the words of a key of more than 16 bytes, and the last 16 bytes of it in a and b
+        inline std::uint64_t long_words(const unsigned char* p, std::size_t size, std::uint64_t seed, std::uint64_t& a, std::uint64_t& b)
+        {
+            std::size_t i = size;
+            if (i > 48)
+            {
+                std::uint64_t see1 = seed, see2 = seed;
+                do
+                {
+                    seed = fold(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                    see1 = fold(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                    see2 = fold(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16)
+            {
+                seed = fold(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+            return seed;
+        }
+
+        alignas(16) constexpr unsigned char zeros[16] {};
+    }
+
+    constexpr std::uint64_t default_seed = 0;
+
+    inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = default_seed)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        seed = detail::seeded(seed);
+        std::uint64_t a, b;
+        if (size <= 16)
+        {
+            if (size >= 4)
+            {
+                const std::size_t shift = (size >> 3) << 2;
+                a = detail::read4(p) << 32 | detail::read4(p + shift);
+                b = detail::read4(p + size - 4) << 32 | detail::read4(p + size - 4 - shift);
+            }
+            else if (size > 0)
+            {
+                a = detail::read3(p, size);
+                b = 0;
+            }
+            else
+                a = b = 0;
+        }
+        else
+            seed = detail::long_words(p, size, seed, a, b);
+        return detail::finish(a, b, seed, size);
+    }
+
+    inline std::uint64_t hash_string(std::string_view s, std::uint64_t seed = default_seed)
+    {
+        return hash_bytes(s.data(), s.size(), seed);
+    }
+
+    // a bijection of the 64 bit numbers, every bit of x changes about half of the bits of it
+    inline std::uint64_t mix(std::uint64_t x)
+    {
+        x = (x ^ (x >> 32)) * 0xD6E8FEB86659FD93;
+        x = (x ^ (x >> 32)) * 0xD6E8FEB86659FD93;
+        return x ^ (x >> 32);
+    }
+
+    inline std::uint64_t hash_int(std::uint64_t x, std::uint64_t seed = default_seed)
+    {
+        return detail::fold(x ^ detail::secret[0] ^ seed, detail::fold(x ^ detail::secret[1], seed ^ detail::secret[2]));
+    }
+
+    // seeded once from std::random_device, the same for the whole process
+    inline std::uint64_t process_seed()
+    {
+        static const std::uint64_t seed = []
+        {
+            std::random_device device;
+            return static_cast<std::uint64_t>(device()) << 32 ^ device();
+        }();
+        return seed;
+    }
+
+    inline std::uint64_t hash_value(std::string_view key, std::uint64_t seed)
+    {
+        return hash_string(key, seed);
+    }
+
+    template<class T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, int> = 0>
+    std::uint64_t hash_value(T key, std::uint64_t seed)
+    {
+        return hash_int(static_cast<std::uint64_t>(key), seed);
+    }
+
+    template<class T>
+    std::uint64_t hash_value(T* key, std::uint64_t seed)
+    {
+        return hash_int(reinterpret_cast<std::uintptr_t>(key), seed);
+    }
+
+    // a functor for std::unordered_map and the tables of the examples, the strings find a std::string_view too
+    template<class T>
+    struct Hash
+    {
+        using is_transparent = void;
+
+        template<class K>
+        std::size_t operator()(const K& key) const
+        {
+            return static_cast<std::size_t>(hash_value(key, default_seed));
+        }
+    };
+
+    template<class T>
+    struct Random_hash
+    {
+        using is_transparent = void;
+
+        template<class K>
+        std::size_t operator()(const K& key) const
+        {
+            return static_cast<std::size_t>(hash_value(key, process_seed()));
+        }
+    };
+
+    /*
+        the hashes of keys[0, n) into hashes, the ones of hash_string with the seed. a lane of
+        a short key loads from the key when it is long enough for a load and from zeros when it
+        is not, the loads are selects of the pointer, not branches.
+    */
+    template<class Key>
+    void hash_many(const Key* keys, std::size_t n, std::uint64_t* hashes, std::uint64_t seed = default_seed)
+    {
+        constexpr std::size_t lanes = 4;
+        const std::uint64_t key_seed = seed;
+        seed = detail::seeded(seed);
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            std::uint64_t a[lanes], b[lanes], s[lanes];
+            std::size_t sizes[lanes];
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+            {
+                const std::string_view key {keys[i + lane]};
+                const unsigned char* p = reinterpret_cast<const unsigned char*>(key.data());
+                const std::size_t size = key.size();
+                sizes[lane] = size;
+                s[lane] = seed;
+                if (size > 16)
+                {
+                    s[lane] = detail::long_words(p, size, seed, a[lane], b[lane]);
+                    continue;
+                }
+                // a key of 4 to 16 bytes, or the zeros for a shorter one
+                const bool is_four = size >= 4;
+                const unsigned char* q = is_four ? p : detail::zeros;
+                const std::size_t q_size = is_four ? size : 4;
+                const std::size_t shift = (q_size >> 3) << 2;
+                const std::uint64_t a4 = detail::read4(q) << 32 | detail::read4(q + shift);
+                const std::uint64_t b4 = detail::read4(q + q_size - 4) << 32 | detail::read4(q + q_size - 4 - shift);
+                // a key of 1 to 3 bytes, or the zeros for an empty one
+                const unsigned char* r = size > 0 ? p : detail::zeros;
+                const std::uint64_t a3 = detail::read3(r, size > 0 ? size : 1);
+                a[lane] = is_four ? a4 : (size > 0 ? a3 : 0);
+                b[lane] = is_four ? b4 : 0;
+            }
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                hashes[i + lane] = detail::finish(a[lane], b[lane], s[lane], sizes[lane]);
+        }
+        for (; i < n; ++i)
+            hashes[i] = hash_string(std::string_view {keys[i]}, key_seed);
+    }
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Fast_hash.h"
+
+int main()
+{
+    // the same key, another hash for another seed
+    std::cout << std::hex;
+    std::cout << "hash_string(\"Soul\"):          " << fast_hash::hash_string("Soul") << '\n';
+    std::cout << "hash_string(\"Soul\", 1):       " << fast_hash::hash_string("Soul", 1) << '\n';
+    std::cout << "hash_int(42):                 " << fast_hash::hash_int(42) << '\n';
+    std::cout << "mix(1), mix(2):               " << fast_hash::mix(1) << ' ' << fast_hash::mix(2) << '\n';
+    std::cout << std::dec;
+
+    // a table of names from outside, seeded once in the process, found by a std::string_view
+    std::unordered_map<std::string, int, fast_hash::Random_hash<std::string>> watches {{"Soul", 2}, {"Halk", 5}};
+    std::cout << "Halk: " << watches.at("Halk") << '\n';
+
+    // many keys at once, the hashes are the ones of hash_string
+    const std::vector<std::string_view> keys {"G", "PG", "PG-13", "R", "NC-17", "a name longer than sixteen bytes"};
+    std::vector<std::uint64_t> hashes(keys.size());
+    fast_hash::hash_many(keys.data(), keys.size(), hashes.data());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        std::cout << std::setw(34) << std::left << keys[i] << (hashes[i] == fast_hash::hash_string(keys[i]) ? "same" : "not the same") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+
+    - compares std::hash, murmur in libstdc++, with the hashes of ../fastHash/Fast_hash.h:
+        short keys, 1 to 16 bytes of random length, one at a time with std::hash and
+          hash_string, and all of them with hash_many,
+        keys of 1 KB, the bytes a second,
+        the integers, std::hash, the number itself, hash_int and mix, and the load of the
+          fullest of 2^16 buckets, a table that keeps the low bits, for the multiples of 2^16,
+        the find of short keys in a std::unordered_map with std::hash and fast_hash::Hash.
+
+    - the hashes of hash_many are the ones of hash_string, the distinct short keys have
+      distinct hashes, a mismatch is reported and the exit code is 1.
+
+    - the times are the medians of ../benchmarkHarness/Benchmark_harness.h, a warm up and 5
+      runs.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+      4M short keys by default, the number can be given on the command line, e.g. ./a.out 1000000
+
+    - on one core of an x86-64 at -O2, 4M keys, two runs:
+        short keys         std::hash 40-47 ns    hash_string 14-15 ns   hash_many 12 ns
+        keys of 1 KB       std::hash 2.2-2.3 GB/s   hash_bytes 5.8-8.1 GB/s
+        integers           std::hash 1.8 ns     hash_int 12 ns        mix 12 ns
+        multiples of 2^16  std::hash 1M in one bucket of 2^16, hash_int 38, mix 35
+        a find             std::hash 474-492 ns   fast_hash::Hash 297-337 ns
+      the integers are a chain, every one is the latency of a hash, std::hash of an
+      integer is no hash at all, a table of a power of two of slots keeps its low bits.
+      the keys of random lengths mispredict the length in std::hash and in hash_string,
+      hash_many has no branch on it, it is the same or a bit faster. a find of a table of
+      1M keys is the misses of the cache of its nodes, most of it is not the hash.
+
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../fastHash/Fast_hash.h"
+
+const bench::Options options {1, 5};
+
+// the most keys of one of 2^16 buckets, the low bits of their hashes
+template<class H>
+std::size_t fullest_bucket(std::size_t n, H hash)
+{
+    std::vector<std::size_t> buckets(1 << 16);
+    for (std::uint64_t i = 0; i < n; ++i)
+        ++buckets[hash(i << 16) & 0xFFFF];
+    return *std::max_element(buckets.begin(), buckets.end());
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4'000'000;
+    std::mt19937_64 gen {3};
+
+    std::string text;
+    std::vector<std::string_view> keys;
+    {
+        std::vector<std::size_t> offsets;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            offsets.push_back(text.size());
+            for (std::size_t size = 1 + gen() % 16; size > 0; --size)
+                text.push_back(static_cast<char>('a' + gen() % 26));
+            offsets.push_back(text.size());
+        }
+        for (std::size_t i = 0; i < offsets.size(); i += 2)
+            keys.emplace_back(text.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    bench::Perf_events events;
+    std::uint64_t sum {0};
+    const double std_short = bench::measure("short keys", "std::hash", n, options, events, [&] {
+        for (const std::string_view key : keys)
+            sum += std::hash<std::string_view> {}(key);
+    }).ns_per_element();
+
+    std::vector<std::uint64_t> hashes(n);
+    const double one_short = bench::measure("short keys", "hash_string", n, options, events, [&] {
+        for (std::size_t i = 0; i < n; ++i)
+            hashes[i] = fast_hash::hash_string(keys[i]);
+    }).ns_per_element();
+
+    std::vector<std::uint64_t> many(n);
+    const double many_short = bench::measure("short keys", "hash_many", n, options, events, [&] {
+        fast_hash::hash_many(keys.data(), n, many.data());
+    }).ns_per_element();
+
+    bool failed {false};
+    if (hashes != many)
+    {
+        std::cout << "the hashes of hash_many are not the ones of hash_string" << std::endl;
+        failed = true;
+    }
+    const std::size_t distinct_keys = std::unordered_set<std::string_view>(keys.begin(), keys.end()).size();
+    std::sort(hashes.begin(), hashes.end());
+    const std::size_t distinct_hashes = std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+    if (distinct_keys != distinct_hashes)
+    {
+        std::cout << distinct_keys << " distinct keys have " << distinct_hashes << " distinct hashes" << std::endl;
+        failed = true;
+    }
+
+    std::string block(1 << 10, 'x');
+    for (char &c : block)
+        c = static_cast<char>(gen());
+    const std::size_t num_blocks = std::max<std::size_t>(1, n / 4);
+    const double std_long = bench::measure("keys of 1 KB", "std::hash", num_blocks, options, events, [&] {
+        for (std::size_t i = 0; i < num_blocks; ++i)
+        {
+            block[i % block.size()] ^= 1;
+            sum += std::hash<std::string_view> {}(block);
+        }
+    }).median_ns;
+    const double fast_long = bench::measure("keys of 1 KB", "hash_bytes", num_blocks, options, events, [&] {
+        for (std::size_t i = 0; i < num_blocks; ++i)
+        {
+            block[i % block.size()] ^= 1;
+            sum += fast_hash::hash_bytes(block.data(), block.size());
+        }
+    }).median_ns;
+
+    const double std_int = bench::measure("integers", "std::hash", n, options, events, [&] {
+        for (std::uint64_t i = 0; i < n; ++i)
+            sum += std::hash<std::uint64_t> {}(i * 0x9E3779B97F4A7C15 + sum);
+    }).ns_per_element();
+    const double fast_int = bench::measure("integers", "hash_int", n, options, events, [&] {
+        for (std::uint64_t i = 0; i < n; ++i)
+            sum += fast_hash::hash_int(i * 0x9E3779B97F4A7C15 + sum);
+    }).ns_per_element();
+    const double mix_int = bench::measure("integers", "mix", n, options, events, [&] {
+        for (std::uint64_t i = 0; i < n; ++i)
+            sum += fast_hash::mix(i * 0x9E3779B97F4A7C15 + sum);
+    }).ns_per_element();
+
+    const std::size_t bucketed = std::min<std::size_t>(n, 1 << 20);
+    const std::size_t std_fullest = fullest_bucket(bucketed, std::hash<std::uint64_t> {});
+    const std::size_t int_fullest = fullest_bucket(bucketed, [](std::uint64_t x) { return fast_hash::hash_int(x); });
+    const std::size_t mix_fullest = fullest_bucket(bucketed, fast_hash::mix);
+
+    // a table of a fourth of the keys, every key looked up
+    std::unordered_map<std::string_view, int> std_table;
+    std::unordered_map<std::string_view, int, fast_hash::Hash<std::string_view>> fast_table;
+    for (std::size_t i = 0; i < n; i += 4)
+    {
+        std_table.emplace(keys[i], static_cast<int>(i));
+        fast_table.emplace(keys[i], static_cast<int>(i));
+    }
+    std::size_t std_found {0}, fast_found {0};
+    const double std_find = bench::measure("a find", "std::hash", n, options, events, [&] {
+        std_found = 0;
+        for (const std::string_view key : keys)
+            std_found += std_table.count(key);
+    }).ns_per_element();
+    const double fast_find = bench::measure("a find", "fast_hash::Hash", n, options, events, [&] {
+        fast_found = 0;
+        for (const std::string_view key : keys)
+            fast_found += fast_table.count(key);
+    }).ns_per_element();
+    if (std_found != fast_found)
+    {
+        std::cout << "the tables found " << std_found << " and " << fast_found << " keys" << std::endl;
+        failed = true;
+    }
+
+    const double bytes = static_cast<double>(num_blocks) * block.size();
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << n << " short keys, " << distinct_keys << " distinct, " << sum % 10 << std::endl;
+    std::cout << "short keys         std::hash " << std_short << " ns   hash_string " << one_short
+        << " ns   hash_many " << many_short << " ns" << std::endl;
+    std::cout << "keys of 1 KB       std::hash " << bytes / std_long << " GB/s   hash_bytes " << bytes / fast_long
+        << " GB/s" << std::endl;
+    std::cout << "integers           std::hash " << std_int << " ns   hash_int " << fast_int << " ns   mix "
+        << mix_int << " ns" << std::endl;
+    std::cout << "multiples of 2^16  the fullest of 2^16 buckets of " << bucketed << ": std::hash " << std_fullest
+        << ", hash_int " << int_fullest << ", mix " << mix_fullest << std::endl;
+    std::cout << "a find             std::hash " << std_find << " ns   fast_hash::Hash " << fast_find << " ns"
+        << std::endl;
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,495 @@
+#ifndef _FAST_RANDOM_H_
+#define _FAST_RANDOM_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - generators of random numbers with a small state, for the places that seed a
+      std::mt19937, 624 words of state, 5 KB with libstdc++, and draw dice rolls through a
+      std::uniform_int_distribution: they are uniform random bit generators, so std::shuffle,
+      std::sample and the std distributions take them too.
+
+    - Xoshiro256ss is xoshiro256**, 32 bytes of state and 64 bits a call, seeded from one
+      number with splitmix64, jump() moves it 2^128 numbers ahead, for a generator that does
+      not overlap it. Pcg32 is a PCG XSH RR, 16 bytes and 32 bits a call, with 2^63 streams.
+      Philox4x32 is Philox-4x32-10, a counter based one: the numbers are a function of the
+      seed, the stream and a counter, so a thread, or a job, that has its own stream gets its
+      own numbers without handing out states, and discard(n) costs nothing.
+
+    - bounded(gen, range) is a number in [0, range) with Lemire's multiply: the high half of
+      random * range, a division only when the low half is less than range, and another
+      random number only for the few that would make some results more likely. Uniform_int
+      is the distribution of [a, b] with it, uniform_real a double in [0, 1) from 53 bits.
+
+    - Xoshiro256ss_x4 is four xoshiro256** a jump apart, with their states side by side, so
+      fill makes 4 numbers at once with AVX2 or SSE2, and fill_bounded fills an array with
+      numbers in [0, range), e.g. dice rolls, 8 of 32 bits out of the 4, multiplied at once,
+      one at a time only when one of them is close to being rejected.
+      the numbers are the same with AVX2, SSE2 or none of them.
+
+*/
+namespace fast_random
+{
+    namespace detail
+    {
+        inline std::uint64_t rotl(std::uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        // the high 64 bits of a * b, and the low ones in low
+        inline std::uint64_t mul_high(std::uint64_t a, std::uint64_t b, std::uint64_t& low)
+        {
+#if defined(__SIZEOF_INT128__)
+            __extension__ using Uint128 = unsigned __int128;
+            const Uint128 product = static_cast<Uint128>(a) * b;
+            low = static_cast<std::uint64_t>(product);
+            return static_cast<std::uint64_t>(product >> 64);
+#else
+            const std::uint64_t a_low = a & 0xFFFFFFFF, a_high = a >> 32;
+            const std::uint64_t b_low = b & 0xFFFFFFFF, b_high = b >> 32;
+            const std::uint64_t low_low = a_low * b_low;
+            const std::uint64_t middle = a_high * b_low + (low_low >> 32);
+            const std::uint64_t middle2 = a_low * b_high + (middle & 0xFFFFFFFF);
+            low = a * b;
+            return a_high * b_high + (middle >> 32) + (middle2 >> 32);
+#endif
+        }
+
+        // a number of [0, range) from the 32 bits x, next() gives other ones when x is one of the few that are rejected
+        template<class Next>
+        std::uint32_t lemire32(std::uint32_t x, std::uint32_t range, Next&& next)
+        {
+            std::uint64_t m = static_cast<std::uint64_t>(x) * range;
+            std::uint32_t low = static_cast<std::uint32_t>(m);
+            if (low < range)
+            {
+                const std::uint32_t threshold = static_cast<std::uint32_t>(-range) % range;
+                while (low < threshold)
+                {
+                    m = static_cast<std::uint64_t>(next()) * range;
+                    low = static_cast<std::uint32_t>(m);
+                }
+            }
+            return static_cast<std::uint32_t>(m >> 32);
+        }
+
+        template<class URBG, class U>
+        constexpr bool gives_all_of = URBG::min() == 0 && URBG::max() == std::numeric_limits<U>::max();
+    }
+
+    inline std::uint64_t splitmix64(std::uint64_t& state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        return z ^ (z >> 31);
+    }
+
+    class Xoshiro256ss
+    {
+    private:
+        std::uint64_t s[4];
+
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256ss(std::uint64_t seed = 0x853C49E6748FEA9B)
+        {
+            for (std::uint64_t& word : this->s)
+                word = splitmix64(seed);
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()()
+        {
+            const std::uint64_t result = detail::rotl(this->s[1] * 5, 7) * 9;
+            const std::uint64_t t = this->s[1] << 17;
+            this->s[2] ^= this->s[0];
+            this->s[3] ^= this->s[1];
+            this->s[1] ^= this->s[2];
+            this->s[0] ^= this->s[3];
+            this->s[2] ^= t;
+            this->s[3] = detail::rotl(this->s[3], 45);
+            return result;
+        }
+
+        // as if 2^128 numbers were taken
+        void jump()
+        {
+            static constexpr std::uint64_t jumps[4] {0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA, 0x39ABDC4529B1661C};
+            std::uint64_t t[4] {};
+            for (std::uint64_t jump : jumps)
+                for (int bit = 0; bit < 64; ++bit)
+                {
+                    if ((jump >> bit) & 1)
+                        for (int i = 0; i < 4; ++i)
+                            t[i] ^= this->s[i];
+                    (*this)();
+                }
+            for (int i = 0; i < 4; ++i)
+                this->s[i] = t[i];
+        }
+
+        void discard(unsigned long long n)
+        {
+            for (; n > 0; --n)
+                (*this)();
+        }
+
+        const std::uint64_t* state() const { return this->s; }
+    };
+
+    class Pcg32
+    {
+    private:
+        std::uint64_t state {0};
+        std::uint64_t increment;
+
+    public:
+        using result_type = std::uint32_t;
+
+        explicit Pcg32(std::uint64_t seed = 0x853C49E6748FEA9B, std::uint64_t stream = 0xDA3E39CB94B95BDB)
+            : increment((stream << 1) | 1)
+        {
+            (*this)();
+            this->state += seed;
+            (*this)();
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()()
+        {
+            const std::uint64_t old = this->state;
+            this->state = old * 6364136223846793005ULL + this->increment;
+            const std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+            const std::uint32_t rotation = static_cast<std::uint32_t>(old >> 59);
+            return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+        }
+
+        void discard(unsigned long long n)
+        {
+            for (; n > 0; --n)
+                (*this)();
+        }
+    };
+
+    class Philox4x32
+    {
+    private:
+        std::array<std::uint32_t, 4> counter;
+        std::array<std::uint32_t, 2> key;
+        std::array<std::uint32_t, 4> block {};
+        std::size_t index {4};
+
+        void next_block()
+        {
+            this->block = Philox4x32::generate(this->counter, this->key);
+            // the low 64 bits of the counter count the blocks, the high ones are the stream
+            if (++this->counter[0] == 0)
+                ++this->counter[1];
+            this->index = 0;
+        }
+
+    public:
+        using result_type = std::uint32_t;
+
+        explicit Philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0)
+            : counter {0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)},
+              key {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        // the 4 numbers of a counter and a key, 10 rounds
+        static std::array<std::uint32_t, 4> generate(std::array<std::uint32_t, 4> c, std::array<std::uint32_t, 2> k)
+        {
+            for (int round = 0; round < 10; ++round)
+            {
+                const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53) * c[0];
+                const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57) * c[2];
+                c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                     static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+                k[0] += 0x9E3779B9;
+                k[1] += 0xBB67AE85;
+            }
+            return c;
+        }
+
+        result_type operator()()
+        {
+            if (this->index == 4)
+                this->next_block();
+            return this->block[this->index++];
+        }
+
+        void discard(unsigned long long n)
+        {
+            const unsigned long long left = 4 - this->index;
+            if (n <= left)
+            {
+                this->index += static_cast<std::size_t>(n);
+                return;
+            }
+            n -= left;
+            const std::uint64_t blocks = (static_cast<std::uint64_t>(this->counter[1]) << 32 | this->counter[0]) + n / 4;
+            this->counter[0] = static_cast<std::uint32_t>(blocks);
+            this->counter[1] = static_cast<std::uint32_t>(blocks >> 32);
+            this->next_block();
+            this->index = static_cast<std::size_t>(n % 4);
+        }
+    };
+
+    // a number of [0, range), range is not 0
+    template<class URBG>
+    std::uint64_t bounded(URBG& gen, std::uint64_t range)
+    {
+        if constexpr (detail::gives_all_of<URBG, std::uint32_t>)
+        {
+            if (range <= std::numeric_limits<std::uint32_t>::max())
+                return detail::lemire32(static_cast<std::uint32_t>(gen()), static_cast<std::uint32_t>(range),
+                    [&gen] { return static_cast<std::uint32_t>(gen()); });
+            return std::uniform_int_distribution<std::uint64_t> {0, range - 1}(gen);
+        }
+        else if constexpr (detail::gives_all_of<URBG, std::uint64_t>)
+        {
+            std::uint64_t low;
+            std::uint64_t high = detail::mul_high(static_cast<std::uint64_t>(gen()), range, low);
+            if (low < range)
+            {
+                const std::uint64_t threshold = (0 - range) % range;
+                while (low < threshold)
+                    high = detail::mul_high(static_cast<std::uint64_t>(gen()), range, low);
+            }
+            return high;
+        }
+        else
+            return std::uniform_int_distribution<std::uint64_t> {0, range - 1}(gen);
+    }
+
+    template<class T = int>
+    class Uniform_int
+    {
+    private:
+        T a;
+        T b;
+
+    public:
+        using result_type = T;
+
+        Uniform_int(T a, T b) : a(a), b(b) {}
+
+        template<class URBG>
+        T operator()(URBG& gen) const
+        {
+            using U = std::make_unsigned_t<T>;
+            const std::uint64_t range = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(this->b) - static_cast<U>(this->a))) + 1;
+            // all the 64 bit numbers
+            if (range == 0)
+                return static_cast<T>(gen());
+            return static_cast<T>(static_cast<U>(static_cast<U>(this->a) + static_cast<U>(bounded(gen, range))));
+        }
+
+        T min() const { return this->a; }
+        T max() const { return this->b; }
+    };
+
+    // a double in [0, 1)
+    template<class URBG>
+    double uniform_real(URBG& gen)
+    {
+        if constexpr (detail::gives_all_of<URBG, std::uint64_t>)
+            return static_cast<double>(static_cast<std::uint64_t>(gen()) >> 11) * 0x1.0p-53;
+        else
+            return std::generate_canonical<double, std::numeric_limits<double>::digits>(gen);
+    }
+
+    template<class RandomIt, class URBG>
+    void shuffle(RandomIt first, RandomIt last, URBG&& gen)
+    {
+        using diff_t = typename std::iterator_traits<RandomIt>::difference_type;
+        for (diff_t i = last - first - 1; i > 0; --i)
+        {
+            using std::swap;
+            swap(first[i], first[static_cast<diff_t>(bounded(gen, static_cast<std::uint64_t>(i) + 1))]);
+        }
+    }
+
+    class Xoshiro256ss_x4
+    {
+    private:
+        // the word of the state, then the generator
+        alignas(32) std::uint64_t s[4][4];
+        // the numbers for the rejected ones of fill_bounded
+        Xoshiro256ss spare;
+
+        // one number of every generator
+        void next(std::uint64_t* out)
+        {
+#if defined(__AVX2__)
+            __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(this->s[0]));
+            __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(this->s[1]));
+            __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(this->s[2]));
+            __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(this->s[3]));
+            const __m256i times5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+            const __m256i rotated = _mm256_or_si256(_mm256_slli_epi64(times5, 7), _mm256_srli_epi64(times5, 57));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated));
+            const __m256i t = _mm256_slli_epi64(s1, 17);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(this->s[0]), s0);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(this->s[1]), s1);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(this->s[2]), s2);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(this->s[3]), s3);
+#elif defined(__SSE2__)
+            for (int half = 0; half < 4; half += 2)
+            {
+                __m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(this->s[0] + half));
+                __m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(this->s[1] + half));
+                __m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(this->s[2] + half));
+                __m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(this->s[3] + half));
+                const __m128i times5 = _mm_add_epi64(_mm_slli_epi64(s1, 2), s1);
+                const __m128i rotated = _mm_or_si128(_mm_slli_epi64(times5, 7), _mm_srli_epi64(times5, 57));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + half), _mm_add_epi64(_mm_slli_epi64(rotated, 3), rotated));
+                const __m128i t = _mm_slli_epi64(s1, 17);
+                s2 = _mm_xor_si128(s2, s0);
+                s3 = _mm_xor_si128(s3, s1);
+                s1 = _mm_xor_si128(s1, s2);
+                s0 = _mm_xor_si128(s0, s3);
+                s2 = _mm_xor_si128(s2, t);
+                s3 = _mm_or_si128(_mm_slli_epi64(s3, 45), _mm_srli_epi64(s3, 19));
+                _mm_store_si128(reinterpret_cast<__m128i*>(this->s[0] + half), s0);
+                _mm_store_si128(reinterpret_cast<__m128i*>(this->s[1] + half), s1);
+                _mm_store_si128(reinterpret_cast<__m128i*>(this->s[2] + half), s2);
+                _mm_store_si128(reinterpret_cast<__m128i*>(this->s[3] + half), s3);
+            }
+#else
+            for (int i = 0; i < 4; ++i)
+            {
+                out[i] = detail::rotl(this->s[1][i] * 5, 7) * 9;
+                const std::uint64_t t = this->s[1][i] << 17;
+                this->s[2][i] ^= this->s[0][i];
+                this->s[3][i] ^= this->s[1][i];
+                this->s[1][i] ^= this->s[2][i];
+                this->s[0][i] ^= this->s[3][i];
+                this->s[2][i] ^= t;
+                this->s[3][i] = detail::rotl(this->s[3][i], 45);
+            }
+#endif
+        }
+
+        // the 8 numbers of 32 bits of one number of every generator, in [0, range)
+        void next_bounded(std::uint32_t* out, std::uint32_t range)
+        {
+            alignas(32) std::uint64_t x[4];
+            this->next(x);
+#if defined(__AVX2__)
+            const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(x));
+            const __m256i r = _mm256_set1_epi64x(range);
+            const __m256i even = _mm256_mul_epu32(v, r);
+            const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(v, 32), r);
+            const __m256i high_half = _mm256_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000ULL));
+            const __m256i results = _mm256_or_si256(_mm256_srli_epi64(even, 32), _mm256_and_si256(odd, high_half));
+            const __m256i lows = _mm256_or_si256(_mm256_andnot_si256(high_half, even), _mm256_slli_epi64(odd, 32));
+            // low < range, unsigned, as a signed compare of both with the sign bit flipped
+            const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000));
+            const __m256i below = _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(range)), sign), _mm256_xor_si256(lows, sign));
+            if (_mm256_testz_si256(below, below))
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), results);
+                return;
+            }
+#elif defined(__SSE2__)
+            const __m128i r = _mm_set1_epi64x(range);
+            const __m128i high_half = _mm_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000ULL));
+            const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000));
+            const __m128i limit = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(range)), sign);
+            __m128i results[2];
+            __m128i below = _mm_setzero_si128();
+            for (int half = 0; half < 2; ++half)
+            {
+                const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(x + 2 * half));
+                const __m128i even = _mm_mul_epu32(v, r);
+                const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(v, 32), r);
+                results[half] = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, high_half));
+                const __m128i lows = _mm_or_si128(_mm_andnot_si128(high_half, even), _mm_slli_epi64(odd, 32));
+                below = _mm_or_si128(below, _mm_cmpgt_epi32(limit, _mm_xor_si128(lows, sign)));
+            }
+            if (_mm_movemask_epi8(below) == 0)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), results[0]);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), results[1]);
+                return;
+            }
+#endif
+            for (int i = 0; i < 8; ++i)
+                out[i] = detail::lemire32(static_cast<std::uint32_t>(x[i / 2] >> (32 * (i % 2))), range,
+                    [this] { return static_cast<std::uint32_t>(this->spare() >> 32); });
+        }
+
+    public:
+        explicit Xoshiro256ss_x4(std::uint64_t seed = 0x853C49E6748FEA9B) : spare(seed ^ 0x5851F42D4C957F2D)
+        {
+            Xoshiro256ss gen {seed};
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int word = 0; word < 4; ++word)
+                    this->s[word][i] = gen.state()[word];
+                gen.jump();
+            }
+        }
+
+        // out[4 * j + i] is the j-th number of the i-th generator, the numbers after n of the last 4 are lost
+        void fill(std::uint64_t* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+                this->next(out + i);
+            if (i < n)
+            {
+                std::uint64_t last[4];
+                this->next(last);
+                std::copy(last, last + (n - i), out + i);
+            }
+        }
+
+        // n numbers of [0, range), range is not 0
+        void fill_bounded(std::uint32_t* out, std::size_t n, std::uint32_t range)
+        {
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+                this->next_bounded(out + i, range);
+            if (i < n)
+            {
+                std::uint32_t last[8];
+                this->next_bounded(last, range);
+                std::copy(last, last + (n - i), out + i);
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Fast_random.h"
+
+int main()
+{
+    // seeded once from the device, like the std::mt19937 of the examples, 32 bytes of state and not 5 KB
+    fast_random::Xoshiro256ss gen {std::random_device {}()};
+    fast_random::Uniform_int<int> dice {1, 6};
+    std::cout << "sizeof Xoshiro256ss: " << sizeof(gen) << ", std::mt19937: " << sizeof(std::mt19937) << '\n';
+    std::cout << "a die: " << dice(gen) << '\n';
+
+    std::vector<int> v {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    fast_random::shuffle(v.begin(), v.end(), gen);
+    std::copy(v.begin(), v.end(), std::ostream_iterator<int>(std::cout, " "));
+    std::cout << '\n';
+
+    // any of them for std::shuffle too
+    fast_random::Pcg32 pcg {42};
+    std::shuffle(v.begin(), v.end(), pcg);
+    std::copy(v.begin(), v.end(), std::ostream_iterator<int>(std::cout, " "));
+    std::cout << '\n';
+
+    // a stream of Philox for every thread, the same numbers for the same seed however they are run
+    std::vector<long long> sums(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < sums.size(); ++i)
+        threads.emplace_back([&sums, i] {
+            fast_random::Philox4x32 philox {2024, i};
+            for (int roll = 0; roll < 1'000'000; ++roll)
+                sums[i] += static_cast<long long>(fast_random::bounded(philox, 6)) + 1;
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+    for (std::size_t i = 0; i < sums.size(); ++i)
+        std::cout << "thread " << i << ", the mean of 1'000'000 rolls: " << static_cast<double>(sums[i]) / 1'000'000 << '\n';
+
+    // 10 million rolls filled at once
+    std::vector<std::uint32_t> rolls(10'000'000);
+    fast_random::Xoshiro256ss_x4 bulk {7};
+    bulk.fill_bounded(rolls.data(), rolls.size(), 6);
+    std::vector<int> counts(6);
+    for (std::uint32_t roll : rolls)
+        ++counts[roll];
+    for (std::size_t face = 0; face < counts.size(); ++face)
+        std::cout << face + 1 << ": " << counts[face] << "  ";
+    std::cout << '\n';
+
+    return 0;
+}
@@ -3,10 +3,15 @@
 #include <iterator>
 #include <numeric>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 template<class InputIt, class OutputIt>
 OutputIt copy(InputIt first, InputIt last, OutputIt d_first)
 {
+    // the same trivial elements, one after the other on both sides, are one memmove
+    if constexpr (block::detail::is_block_copy<InputIt, OutputIt>)
+        return block::copy(first, last, d_first);
+
     for (; first != last; (void)++first, (void)++d_first)
         *d_first = *first;
  
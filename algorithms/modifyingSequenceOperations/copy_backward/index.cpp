@@ -2,10 +2,14 @@
 #include <iostream>
 #include <numeric>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 template<class BidirIt1, class BidirIt2>
 BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last)
 {
+    if constexpr (block::detail::is_block_copy<BidirIt1, BidirIt2>)
+        return block::copy_backward(first, last, d_last);
+
     while (first != last)
         *(--d_last) = *(--last);
     
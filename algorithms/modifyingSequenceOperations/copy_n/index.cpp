@@ -4,11 +4,15 @@
 #include <numeric>
 #include <string>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 
 template<class InputIt, class Size, class OutputIt>
 constexpr OutputIt copy_n(InputIt first, Size count, OutputIt result)
 {
+    if constexpr (block::detail::is_block_copy<InputIt, OutputIt>)
+        return block::copy_n(first, count, result);
+
     if (count > 0)
     {
         *result = *first;
@@ -2,10 +2,15 @@
 #include <complex>
 #include <iostream>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 template<class ForwardIt, class T = typename std::iterator_traits<ForwardIt>::value_type>
 void fill(ForwardIt first, ForwardIt last, const T& value)
 {
+    // a memset, or stores of a vector of the value, for trivial elements one after the other
+    if constexpr (block::detail::is_block_fill<ForwardIt>)
+        return block::fill(first, last, value);
+
     for (; first != last; ++first)
         *first = value;
 }
@@ -3,10 +3,14 @@
 #include <iostream>
 #include <iterator>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 template<class OutputIt, class Size, class T = typename std::iterator_traits<OutputIt>::value_type>
 OutputIt fill_n(OutputIt first, Size count, const T& value)
 {
+    if constexpr (block::detail::is_block_fill<OutputIt>)
+        return block::fill_n(first, count, value);
+
     for (Size i = 0; i < count; i++)
         *first++ = value;
 
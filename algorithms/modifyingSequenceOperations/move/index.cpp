@@ -5,10 +5,15 @@
 #include <list>
 #include <thread>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 template<class InputIt, class OutputIt>
 OutputIt move(InputIt first, InputIt last, OutputIt d_first)
 {
+    // a move of trivial elements is a copy, one memmove
+    if constexpr (block::detail::is_block_move<InputIt, OutputIt>)
+        return block::move(first, last, d_first);
+
     for (; first != last; ++d_first, ++first)
         *d_first = std::move(*first);
  
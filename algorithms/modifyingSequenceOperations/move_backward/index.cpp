@@ -4,12 +4,16 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include "../../blockAlgorithms/Block_algorithms.h"
 
 using container = std::vector<std::string>;
 
 template<class BidirIt1, class BidirIt2>
 BidirIt2 move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last)
 {
+    if constexpr (block::detail::is_block_move<BidirIt1, BidirIt2>)
+        return block::move_backward(first, last, d_last);
+
     while (first != last)
         *(--d_last) = std::move(*(--last));
  
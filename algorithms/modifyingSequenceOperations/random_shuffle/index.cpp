@@ -3,6 +3,7 @@
 #include <iterator>
 #include <random>
 #include <vector>
+#include "../../fastRandom/Fast_random.h"
 
 template<class RandomIt>
 void random_shuffle(RandomIt first, RandomIt last)
@@ -36,7 +37,7 @@ int main()
     std::vector<int> v{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
  
     std::random_device rd;
-    std::mt19937 g(rd());
+    fast_random::Xoshiro256ss g(rd());
  
     std::shuffle(v.begin(), v.end(), g);
  
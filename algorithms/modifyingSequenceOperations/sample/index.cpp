@@ -3,6 +3,7 @@
 #include <iterator>
 #include <random>
 #include <string>
+#include "../../fastRandom/Fast_random.h"
  
 int main()
 {
@@ -11,6 +12,6 @@ int main()
         in.end(), 
         std::back_inserter(out), 
         4, 
-        std::mt19937 {std::random_device{}()});
+        fast_random::Xoshiro256ss {std::random_device{}()});
     std::cout << "Four random letters out of " << in << " : " << out << '\n';
 }
\ No newline at end of file
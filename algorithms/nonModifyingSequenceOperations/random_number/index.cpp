@@ -1,11 +1,12 @@
 #include <random>
 #include <iostream>
+#include "../../fastRandom/Fast_random.h"
 
 int main()
 {
     std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> dist6(1, 6); // distribution in range [1, 6]
+    fast_random::Xoshiro256ss rng(dev());
+    fast_random::Uniform_int<int> dist6(1, 6); // distribution in range [1, 6]
 
     std::cout << dist6(rng) << std::endl;
 }
\ No newline at end of file
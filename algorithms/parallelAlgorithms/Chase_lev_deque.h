@@ -0,0 +1,131 @@
+#ifndef _CHASE_LEV_DEQUE_H_
+#define _CHASE_LEV_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+
+    - the deque of Chase and Lev, "Dynamic circular work-stealing deque": one thread, the
+      owner, pushes and pops at the bottom, any other thread steals from the top, no lock.
+      the fences of the version of Le, Pop, Cohen and Zappa Nardelli for weak memory models
+      are seq_cst loads and stores of top and bottom here, on x86 the same instructions as
+      the fences or cheaper ones, and ThreadSanitizer understands them.
+
+    - a push is a few plain loads and stores, a pop one exchange more, and a compare and swap
+      only when it takes the last element, the one a thief can take too, a steal is one
+      compare and swap, it fails when another thief or the owner took the element first.
+
+    - the elements are in a ring that the owner doubles when it is full, the old rings are
+      kept until the deque is destroyed, a thief that read the pointer of one before it grew
+      can still read its element from it.
+
+    - T is a pointer, or a small trivially copyable type, for an empty deque pop and steal
+      return T {}.
+
+*/
+template <typename T>
+class Chase_lev_deque
+{
+private:
+    struct Ring
+    {
+        const std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit Ring(std::int64_t capacity) : mask(capacity - 1), items(new std::atomic<T>[static_cast<std::size_t>(capacity)]) {}
+
+        T get(std::int64_t i) const { return this->items[static_cast<std::size_t>(i & this->mask)].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T item) { this->items[static_cast<std::size_t>(i & this->mask)].store(item, std::memory_order_relaxed); }
+    };
+
+    // top and bottom on lines of their own, the thieves write top and the owner bottom
+    alignas(64) std::atomic<std::int64_t> top {0};
+    alignas(64) std::atomic<std::int64_t> bottom {0};
+    std::atomic<Ring*> ring;
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    Ring* grow(Ring* old, std::int64_t b, std::int64_t t)
+    {
+        this->rings.push_back(std::make_unique<Ring>((old->mask + 1) * 2));
+        Ring* const bigger = this->rings.back().get();
+        for (std::int64_t i = t; i < b; ++i)
+            bigger->put(i, old->get(i));
+        this->ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+public:
+    // capacity is a power of 2
+    explicit Chase_lev_deque(std::size_t capacity = 256)
+    {
+        this->rings.push_back(std::make_unique<Ring>(static_cast<std::int64_t>(capacity)));
+        this->ring.store(this->rings.back().get(), std::memory_order_relaxed);
+    }
+
+    Chase_lev_deque(const Chase_lev_deque&) = delete;
+    Chase_lev_deque& operator=(const Chase_lev_deque&) = delete;
+
+    // the owner only
+    void push(T item)
+    {
+        const std::int64_t b = this->bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = this->top.load(std::memory_order_acquire);
+        Ring* r = this->ring.load(std::memory_order_relaxed);
+        if (b - t > r->mask)
+            r = this->grow(r, b, t);
+        r->put(b, item);
+        this->bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // the owner only, the last one pushed
+    T pop()
+    {
+        const std::int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+        Ring* const r = this->ring.load(std::memory_order_relaxed);
+        // the store of bottom before the load of top, seq_cst, like the one of a thief
+        this->bottom.store(b, std::memory_order_seq_cst);
+        std::int64_t t = this->top.load(std::memory_order_seq_cst);
+        if (t > b)
+        {
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+            return T {};
+        }
+        T item = r->get(b);
+        if (t == b)
+        {
+            // the last one, the owner and a thief race for it
+            if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = T {};
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // any thread, the oldest one
+    T steal()
+    {
+        std::int64_t t = this->top.load(std::memory_order_seq_cst);
+        const std::int64_t b = this->bottom.load(std::memory_order_seq_cst);
+        if (t >= b)
+            return T {};
+        Ring* const r = this->ring.load(std::memory_order_acquire);
+        const T item = r->get(t);
+        if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return T {};
+        return item;
+    }
+
+    // a guess when another thread pushes or steals at the same time
+    std::int64_t size() const
+    {
+        const std::int64_t b = this->bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = this->top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+};
+
+#endif
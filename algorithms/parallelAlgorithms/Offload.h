@@ -0,0 +1,148 @@
+#ifndef _OFFLOAD_H_
+#define _OFFLOAD_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(BASICS_OFFLOAD)
+#if !defined(_OPENMP)
+#error "BASICS_OFFLOAD needs -fopenmp"
+#endif
+#include <omp.h>
+#endif
+
+/*
+
+    - the loops that can run on a GPU, OpenMP target regions, compiled in with BASICS_OFFLOAD
+      and -fopenmp (the BASICS_OFFLOAD option of CMakeLists.txt), for a device of the
+      offload compilers of the toolchain, e.g. nvptx-none for gcc, without them or without
+      a device the regions run on the host. without BASICS_OFFLOAD there is no OpenMP at all
+      and use_device is always false.
+
+    - use_device decides: Target::host never, Target::device always, a region runs on the
+      host when there is no device, that checks the path, Target::automatic when there is a
+      device and the range has min_size elements at least, below that the launch and the
+      copies cost more than the loop on the cores.
+
+    - a range goes to the device in chunks of chunk_size elements, a target task a chunk
+      that copies it in, runs the loop and copies the results back, in_flight of them at a
+      time on as many host threads, so the copies of one chunk overlap the loop of another
+      one, and the device holds in_flight chunks, not the range.
+
+    - a loop that reads and writes every element once is bound by the bus, 8 bytes an
+      element each way over PCIe is slower than the cores read them from memory, the device
+      pays off for loops that compute a lot an element. the results are the ones of the host
+      as long as the functions use no library the device does not have the same of, integer
+      arithmetic is exact, doubles are IEEE on both, the compiler must not fuse a multiply
+      and an add where the host does not, -std=c++17 is -ffp-contract=off for gcc.
+
+    - the functions run on the device, they have to be visible to its compiler, a lambda or
+      an inline function of a header, and must not throw. the ranges are pointers, of
+      trivially copyable elements, the output is the input or does not overlap it.
+
+*/
+namespace offload
+{
+    enum class Target
+    {
+        automatic,
+        host,
+        device
+    };
+
+    inline constexpr std::size_t def_min_size {1 << 22};
+    inline constexpr std::size_t chunk_size {1 << 20};
+    inline constexpr int in_flight {3};
+
+    // the devices OpenMP sees, 0 without BASICS_OFFLOAD
+    inline int device_count()
+    {
+#if defined(BASICS_OFFLOAD)
+        static const int count = omp_get_num_devices();
+        return count;
+#else
+        return 0;
+#endif
+    }
+
+    inline bool use_device([[maybe_unused]] Target target, [[maybe_unused]] std::size_t n,
+        [[maybe_unused]] std::size_t min_size = def_min_size)
+    {
+#if defined(BASICS_OFFLOAD)
+        return target == Target::device || (target == Target::automatic && n >= min_size && device_count() > 0);
+#else
+        return false;
+#endif
+    }
+
+    inline std::size_t num_chunks(std::size_t n)
+    {
+        return (n + chunk_size - 1) / chunk_size;
+    }
+
+    // d_first[i] = op(first[i]) on the device
+    template<class T, class U, class UnaryOp>
+    U* transform(const T* first, const T* last, U* d_first, UnaryOp op)
+    {
+        const std::size_t n = last - first;
+#if defined(BASICS_OFFLOAD)
+        const bool in_place = static_cast<const void*>(first) == static_cast<const void*>(d_first);
+#pragma omp parallel num_threads(in_flight)
+#pragma omp single
+        for (std::size_t from = 0; from < n; from += chunk_size)
+        {
+            const std::size_t count = std::min(chunk_size, n - from);
+            const std::size_t to = from + count;
+            if (in_place)
+            {
+#pragma omp target teams distribute parallel for map(tofrom: d_first[from:count]) nowait
+                for (std::size_t i = from; i < to; ++i)
+                    d_first[i] = op(first[i]);
+            }
+            else
+            {
+#pragma omp target teams distribute parallel for map(to: first[from:count]) map(from: d_first[from:count]) nowait
+                for (std::size_t i = from; i < to; ++i)
+                    d_first[i] = op(first[i]);
+            }
+        }
+#else
+        for (std::size_t i = 0; i < n; ++i)
+            d_first[i] = op(first[i]);
+#endif
+        return d_first + n;
+    }
+
+    // the elements p is true of, counted on the device, a count a chunk added up on the host
+    template<class T, class UnaryPred>
+    std::ptrdiff_t count_if(const T* first, const T* last, UnaryPred p)
+    {
+        const std::size_t n = last - first;
+        std::vector<std::ptrdiff_t> counts(num_chunks(n));
+        std::ptrdiff_t* count_of = counts.data();
+#if defined(BASICS_OFFLOAD)
+#pragma omp parallel num_threads(in_flight)
+#pragma omp single
+        for (std::size_t chunk = 0; chunk < counts.size(); ++chunk)
+        {
+            const std::size_t from = chunk * chunk_size;
+            const std::size_t count = std::min(chunk_size, n - from);
+            const std::size_t to = from + count;
+#pragma omp target teams distribute parallel for map(to: first[from:count]) map(tofrom: count_of[chunk:1]) \
+    reduction(+: count_of[chunk:1]) nowait
+            for (std::size_t i = from; i < to; ++i)
+                count_of[chunk] += static_cast<bool>(p(first[i]));
+        }
+#else
+        for (std::size_t i = 0; i < n; ++i)
+            count_of[i / chunk_size] += static_cast<bool>(p(first[i]));
+#endif
+        std::ptrdiff_t total = 0;
+        for (std::ptrdiff_t count : counts)
+            total += count;
+        return total;
+    }
+}
+
+#endif
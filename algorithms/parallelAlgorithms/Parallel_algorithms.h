@@ -0,0 +1,453 @@
+#ifndef _PARALLEL_ALGORITHMS_H_
+#define _PARALLEL_ALGORITHMS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "Offload.h"
+#include "Work_stealing_pool.h"
+#include "../fastRandom/Fast_random.h"
+
+/*
+
+    - the algorithms of ../nonModifyingSequenceOperations and ../modifyingSequenceOperations
+      that can be split, with the signatures of the reference ones and an execution policy
+      first, like the ones of <execution>: parallel::seq runs the std one, parallel::par
+      splits the range in chunks that run as tasks of a Work_stealing_pool, and
+      parallel::par_unseq does too and lets the compiler vectorize the loop of a chunk, the
+      element accesses must not depend on each other.
+
+    - par and par_unseq run on default_pool, a pool with a thread for every core, or on
+      another one with par.on(pool).
+
+    - a range of less than min_chunk elements, or one without random access iterators, runs
+      like with seq. the chunks are at least min_chunk elements, and at most 8 per thread of
+      the pool, so a thread that is done early steals a part of the work of a slow one.
+
+    - count_if, reduce and transform_reduce keep a result per chunk and add them up in
+      order at the end. find_if, and find, any_of, all_of, none_of with it, keep the index
+      of the first match found so far: a chunk after it stops, a chunk before it goes on,
+      so the result is the first match, the one of the sequential algorithm.
+
+    - generate and generate_n call a generator with a state one element after the other, the
+      values depend on the order, so they have no par. generate_indexed makes first[i] g(i),
+      a function of the index only, and generate_random makes it g(gen), gen a
+      fast_random::Philox4x32 of the seed and the stream i, a counter based generator, so an
+      element gets its own numbers however many it draws. the values are the same for seq,
+      par and any number of threads, bit for bit. g is called from the threads at once.
+
+    - parallel::par_offload is par_unseq, but transform of one range and count_if on
+      pointers go to the device of Offload.h when use_device says so, a range of min_size
+      elements at least by default, par_offload.at(offload::Target::device) always. the
+      functions are the ones of a device, see Offload.h, without BASICS_OFFLOAD it is
+      par_unseq.
+
+    - an exception thrown by an element access or a function is rethrown by the algorithm,
+      the first one of them, not std::terminate like with <execution>.
+
+*/
+namespace parallel
+{
+    struct Sequenced_policy {};
+
+    struct Parallel_policy
+    {
+        Work_stealing_pool* pool {nullptr};
+
+        Parallel_policy on(Work_stealing_pool& pool) const { return Parallel_policy {&pool}; }
+    };
+
+    struct Parallel_unsequenced_policy
+    {
+        Work_stealing_pool* pool {nullptr};
+
+        Parallel_unsequenced_policy on(Work_stealing_pool& pool) const { return Parallel_unsequenced_policy {&pool}; }
+    };
+
+    struct Offload_policy
+    {
+        Work_stealing_pool* pool {nullptr};
+        offload::Target target {offload::Target::automatic};
+        std::size_t min_size {offload::def_min_size};
+
+        Offload_policy on(Work_stealing_pool& pool) const { return Offload_policy {&pool, this->target, this->min_size}; }
+        Offload_policy at(offload::Target target, std::size_t min_size = offload::def_min_size) const
+        {
+            return Offload_policy {this->pool, target, min_size};
+        }
+    };
+
+    inline constexpr Sequenced_policy seq {};
+    inline constexpr Parallel_policy par {};
+    inline constexpr Parallel_unsequenced_policy par_unseq {};
+    inline constexpr Offload_policy par_offload {};
+
+    inline constexpr std::size_t min_chunk {1 << 14};
+
+    inline Work_stealing_pool& default_pool()
+    {
+        static Work_stealing_pool pool;
+        return pool;
+    }
+
+    namespace detail
+    {
+        template<class Policy, class... Its>
+        constexpr bool is_parallel = !std::is_same_v<std::decay_t<Policy>, Sequenced_policy>
+            && (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Its>::iterator_category> && ...);
+
+        template<class Policy>
+        constexpr bool is_offload = std::is_same_v<std::decay_t<Policy>, Offload_policy>;
+
+        template<class Policy>
+        constexpr bool is_unsequenced = std::is_same_v<std::decay_t<Policy>, Parallel_unsequenced_policy> || is_offload<Policy>;
+
+        // the range of pointers on the device, the Offload_policy and use_device send it there
+        inline bool on_device(const Offload_policy& policy, std::size_t n)
+        {
+            return offload::use_device(policy.target, n, policy.min_size);
+        }
+
+        template<class Policy>
+        Work_stealing_pool& pool_of(const Policy& policy)
+        {
+            return policy.pool != nullptr ? *policy.pool : default_pool();
+        }
+
+        inline std::size_t num_chunks(const Work_stealing_pool& pool, std::size_t n)
+        {
+            return std::max<std::size_t>(1, std::min(n / min_chunk, pool.size() * 8));
+        }
+
+        // f(chunk, begin, end) for the chunks of [0, n), the ones on the right are split off as tasks
+        template<class F>
+        void for_chunks(Work_stealing_pool& pool, std::size_t n, std::size_t chunks, const F& f)
+        {
+            const auto bounds = [n, chunks](std::size_t chunk) { return n / chunks * chunk + std::min(chunk, n % chunks); };
+            if (chunks == 1)
+            {
+                f(0, 0, n);
+                return;
+            }
+
+            Work_stealing_pool::Task_group group;
+            std::function<void(std::size_t, std::size_t)> split = [&](std::size_t first, std::size_t last)
+            {
+                while (last - first > 1)
+                {
+                    const std::size_t middle = first + (last - first) / 2;
+                    pool.run(group, [&split, middle, last] { split(middle, last); });
+                    last = middle;
+                }
+                f(first, bounds(first), bounds(first + 1));
+            };
+            split(0, chunks);
+            pool.wait(group);
+        }
+
+        inline void store_min(std::atomic<std::size_t>& found, std::size_t i)
+        {
+            std::size_t current = found.load(std::memory_order_relaxed);
+            while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                ;
+        }
+    }
+
+    template<class Policy, class RandomIt, class UnaryFunc>
+    void for_each(Policy&& policy, RandomIt first, RandomIt last, UnaryFunc f)
+    {
+        if constexpr (!detail::is_parallel<Policy, RandomIt>)
+            std::for_each(first, last, f);
+        else
+        {
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            const std::size_t n = last - first;
+            detail::for_chunks(pool, n, detail::num_chunks(pool, n), [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                if constexpr (detail::is_unsequenced<Policy>)
+                {
+#if defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+                    for (std::size_t i = begin; i < end; ++i)
+                        f(first[i]);
+                }
+                else
+                    for (std::size_t i = begin; i < end; ++i)
+                        f(first[i]);
+            });
+        }
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred>
+    typename std::iterator_traits<RandomIt>::difference_type count_if(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p)
+    {
+        using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+        if constexpr (!detail::is_parallel<Policy, RandomIt>)
+            return std::count_if(first, last, p);
+        else
+        {
+            const std::size_t n = last - first;
+            if constexpr (detail::is_offload<Policy> && std::is_pointer_v<RandomIt>)
+                if (detail::on_device(policy, n))
+                    return offload::count_if(first, last, p);
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            const std::size_t chunks = detail::num_chunks(pool, n);
+            std::vector<Difference> counts(chunks);
+            detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                // no branch, a match adds 1, so the loop can be vectorized
+                Difference count = 0;
+                for (std::size_t i = begin; i < end; ++i)
+                    count += static_cast<bool>(p(first[i]));
+                counts[chunk] = count;
+            });
+            return std::accumulate(counts.begin(), counts.end(), Difference {0});
+        }
+    }
+
+    template<class Policy, class RandomIt, class T>
+    typename std::iterator_traits<RandomIt>::difference_type count(Policy&& policy, RandomIt first, RandomIt last, const T& value)
+    {
+        return parallel::count_if(policy, first, last, [&value](const auto& item) { return item == value; });
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred>
+    RandomIt find_if(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p)
+    {
+        if constexpr (!detail::is_parallel<Policy, RandomIt>)
+            return std::find_if(first, last, p);
+        else
+        {
+            // the chunks look at found every block, so one after a match stops soon
+            constexpr std::size_t block = 1024;
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            const std::size_t n = last - first;
+            std::atomic<std::size_t> found {n};
+            detail::for_chunks(pool, n, detail::num_chunks(pool, n), [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                for (std::size_t from = begin; from < end; from += block)
+                {
+                    if (from >= found.load(std::memory_order_relaxed))
+                        return;
+                    const std::size_t to = std::min(end, from + block);
+                    for (std::size_t i = from; i < to; ++i)
+                        if (p(first[i]))
+                        {
+                            detail::store_min(found, i);
+                            return;
+                        }
+                }
+            });
+            return first + found.load();
+        }
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred>
+    RandomIt find_if_not(Policy&& policy, RandomIt first, RandomIt last, UnaryPred q)
+    {
+        return parallel::find_if(policy, first, last, [&q](const auto& item) { return !q(item); });
+    }
+
+    template<class Policy, class RandomIt, class T>
+    RandomIt find(Policy&& policy, RandomIt first, RandomIt last, const T& value)
+    {
+        return parallel::find_if(policy, first, last, [&value](const auto& item) { return item == value; });
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred>
+    bool any_of(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p)
+    {
+        return parallel::find_if(policy, first, last, p) != last;
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred>
+    bool all_of(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p)
+    {
+        return parallel::find_if_not(policy, first, last, p) == last;
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred>
+    bool none_of(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p)
+    {
+        return parallel::find_if(policy, first, last, p) == last;
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class UnaryOp>
+    RandomIt2 transform(Policy&& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 d_first, UnaryOp unary_op)
+    {
+        if constexpr (!detail::is_parallel<Policy, RandomIt1, RandomIt2>)
+            return std::transform(first1, last1, d_first, unary_op);
+        else
+        {
+            const std::size_t n = last1 - first1;
+            if constexpr (detail::is_offload<Policy> && std::is_pointer_v<RandomIt1> && std::is_pointer_v<RandomIt2>)
+                if (detail::on_device(policy, n))
+                    return offload::transform(first1, last1, d_first, unary_op);
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            detail::for_chunks(pool, n, detail::num_chunks(pool, n), [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                if constexpr (detail::is_unsequenced<Policy>)
+                {
+#if defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+                    for (std::size_t i = begin; i < end; ++i)
+                        d_first[i] = unary_op(first1[i]);
+                }
+                else
+                    for (std::size_t i = begin; i < end; ++i)
+                        d_first[i] = unary_op(first1[i]);
+            });
+            return d_first + n;
+        }
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class RandomIt3, class BinaryOp>
+    RandomIt3 transform(Policy&& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt3 d_first, BinaryOp binary_op)
+    {
+        if constexpr (!detail::is_parallel<Policy, RandomIt1, RandomIt2, RandomIt3>)
+            return std::transform(first1, last1, first2, d_first, binary_op);
+        else
+        {
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            const std::size_t n = last1 - first1;
+            detail::for_chunks(pool, n, detail::num_chunks(pool, n), [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                if constexpr (detail::is_unsequenced<Policy>)
+                {
+#if defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+                    for (std::size_t i = begin; i < end; ++i)
+                        d_first[i] = binary_op(first1[i], first2[i]);
+                }
+                else
+                    for (std::size_t i = begin; i < end; ++i)
+                        d_first[i] = binary_op(first1[i], first2[i]);
+            });
+            return d_first + n;
+        }
+    }
+
+    template<class Policy, class RandomIt, class UnaryPred, class T = typename std::iterator_traits<RandomIt>::value_type>
+    void replace_if(Policy&& policy, RandomIt first, RandomIt last, UnaryPred p, const T& new_value)
+    {
+        parallel::for_each(policy, first, last, [&p, &new_value](auto& item)
+        {
+            if (p(item))
+                item = new_value;
+        });
+    }
+
+    template<class Policy, class RandomIt, class T = typename std::iterator_traits<RandomIt>::value_type>
+    void replace(Policy&& policy, RandomIt first, RandomIt last, const T& old_value, const T& new_value)
+    {
+        parallel::replace_if(policy, first, last, [&old_value](const auto& item) { return item == old_value; }, new_value);
+    }
+
+    template<class Policy, class RandomIt, class T = typename std::iterator_traits<RandomIt>::value_type>
+    void fill(Policy&& policy, RandomIt first, RandomIt last, const T& value)
+    {
+        parallel::for_each(policy, first, last, [&value](auto& item) { item = value; });
+    }
+
+    // first[i] = g(i)
+    template<class Policy, class ForwardIt, class IndexedGenerator>
+    void generate_indexed(Policy&& policy, ForwardIt first, ForwardIt last, IndexedGenerator g)
+    {
+        if constexpr (!detail::is_parallel<Policy, ForwardIt>)
+        {
+            for (std::size_t i = 0; first != last; ++first, ++i)
+                *first = g(i);
+        }
+        else
+        {
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            const std::size_t n = last - first;
+            detail::for_chunks(pool, n, detail::num_chunks(pool, n), [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    first[i] = g(i);
+            });
+        }
+    }
+
+    template<class Policy, class ForwardIt, class Size, class IndexedGenerator>
+    ForwardIt generate_indexed_n(Policy&& policy, ForwardIt first, Size count, IndexedGenerator g)
+    {
+        if (!(count > 0))
+            return first;
+        const ForwardIt last = std::next(first, count);
+        parallel::generate_indexed(policy, first, last, g);
+        return last;
+    }
+
+    // first[i] = g(gen), gen a Philox4x32 {seed, i} for element i alone
+    template<class Policy, class ForwardIt, class RandomGenerator>
+    void generate_random(Policy&& policy, ForwardIt first, ForwardIt last, std::uint64_t seed, RandomGenerator g)
+    {
+        parallel::generate_indexed(policy, first, last, [seed, &g](std::size_t i)
+        {
+            fast_random::Philox4x32 gen {seed, static_cast<std::uint64_t>(i)};
+            return g(gen);
+        });
+    }
+
+    template<class Policy, class ForwardIt, class Size, class RandomGenerator>
+    ForwardIt generate_random_n(Policy&& policy, ForwardIt first, Size count, std::uint64_t seed, RandomGenerator g)
+    {
+        if (!(count > 0))
+            return first;
+        const ForwardIt last = std::next(first, count);
+        parallel::generate_random(policy, first, last, seed, g);
+        return last;
+    }
+
+    // op is associative and commutative, the chunks are added up from init in order
+    template<class Policy, class RandomIt, class T, class BinaryReductionOp, class UnaryTransformOp>
+    T transform_reduce(Policy&& policy, RandomIt first, RandomIt last, T init, BinaryReductionOp reduce, UnaryTransformOp transform)
+    {
+        if constexpr (!detail::is_parallel<Policy, RandomIt>)
+            return std::transform_reduce(first, last, init, reduce, transform);
+        else
+        {
+            Work_stealing_pool& pool = detail::pool_of(policy);
+            const std::size_t n = last - first;
+            if (n == 0)
+                return init;
+            const std::size_t chunks = detail::num_chunks(pool, n);
+            std::vector<T> sums(chunks, init);
+            detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                T sum = transform(first[begin]);
+                for (std::size_t i = begin + 1; i < end; ++i)
+                    sum = reduce(std::move(sum), transform(first[i]));
+                sums[chunk] = std::move(sum);
+            });
+            for (T& sum : sums)
+                init = reduce(std::move(init), std::move(sum));
+            return init;
+        }
+    }
+
+    template<class Policy, class RandomIt, class T, class BinaryOp>
+    T reduce(Policy&& policy, RandomIt first, RandomIt last, T init, BinaryOp op)
+    {
+        return parallel::transform_reduce(policy, first, last, std::move(init), op, [](const auto& item) { return item; });
+    }
+
+    template<class Policy, class RandomIt, class T>
+    T reduce(Policy&& policy, RandomIt first, RandomIt last, T init)
+    {
+        return parallel::reduce(policy, first, last, std::move(init), std::plus<> {});
+    }
+}
+
+#endif
@@ -0,0 +1,280 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "Work_stealing_pool.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    // the pool and the queue of the worker the thread is, nullptr for the other threads
+    thread_local const Work_stealing_pool* current_pool {nullptr};
+    thread_local std::size_t current_index {0};
+
+    // the cores of a list of /sys, e.g. 0-3,8-11
+    std::vector<int> parse_cpu_list(const std::string& list)
+    {
+        std::vector<int> cpus;
+        std::stringstream ranges {list};
+        std::string range;
+        while (std::getline(ranges, range, ','))
+        {
+            const std::size_t dash = range.find('-');
+            const int from = std::stoi(range.substr(0, dash));
+            const int to = dash == std::string::npos ? from : std::stoi(range.substr(dash + 1));
+            for (int cpu = from; cpu <= to; ++cpu)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    // the cores of every node the process can run on, one node of all of them without /sys
+    std::vector<std::vector<int>> numa_nodes(const std::vector<int>& allowed)
+    {
+        std::vector<std::vector<int>> nodes;
+        for (int node = 0;; ++node)
+        {
+            std::ifstream file {"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+            std::string list;
+            if (!file || !std::getline(file, list))
+                break;
+            std::vector<int> cpus;
+            for (int cpu : parse_cpu_list(list))
+                if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end())
+                    cpus.push_back(cpu);
+            if (!cpus.empty())
+                nodes.push_back(cpus);
+        }
+        if (nodes.empty())
+            nodes.push_back(allowed);
+        return nodes;
+    }
+
+    std::vector<int> allowed_cpus()
+    {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set))
+                    cpus.push_back(cpu);
+#endif
+        return cpus;
+    }
+
+    void pin(const std::vector<int>& cpus)
+    {
+#if defined(__linux__)
+        if (cpus.empty())
+            return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+            CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpus;
+#endif
+    }
+}
+
+std::size_t Work_stealing_pool::default_workers()
+{
+    const unsigned cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+Work_stealing_pool::Work_stealing_pool(std::size_t num_workers, Placement placement)
+    : queued(0), sleeping(0), stopping(false)
+{
+    for (std::size_t i = 0; i < num_workers; ++i)
+        this->workers.push_back(std::make_unique<Worker>());
+    this->place(placement);
+    for (std::size_t i = 0; i < num_workers; ++i)
+        this->threads.emplace_back(&Work_stealing_pool::work, this, i);
+}
+
+Work_stealing_pool::~Work_stealing_pool()
+{
+    this->wait(this->submitted);
+    {
+        std::lock_guard<std::mutex> lock {this->sleep_mutex};
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+    for (std::thread& thread : this->threads)
+        thread.join();
+}
+
+// the cores of every worker and the order it steals in, before the workers start
+void Work_stealing_pool::place(Placement placement)
+{
+    const std::size_t n = this->workers.size();
+    std::vector<std::size_t> node_of(n, 0);
+    const std::vector<int> allowed = placement == Placement::any ? std::vector<int> {} : allowed_cpus();
+
+    if (placement == Placement::cores && !allowed.empty())
+        for (std::size_t i = 0; i < n; ++i)
+            this->workers[i]->cpus = {allowed[(i + 1) % allowed.size()]};
+    else if (placement == Placement::numa_nodes && !allowed.empty())
+    {
+        const std::vector<std::vector<int>> nodes = numa_nodes(allowed);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            node_of[i] = i % nodes.size();
+            this->workers[i]->cpus = nodes[node_of[i]];
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::vector<std::size_t>& victims = this->workers[i]->victims;
+        for (std::size_t k = 1; k < n; ++k)
+            if (node_of[(i + k) % n] == node_of[i])
+                victims.push_back((i + k) % n);
+        for (std::size_t k = 1; k < n; ++k)
+            if (node_of[(i + k) % n] != node_of[i])
+                victims.push_back((i + k) % n);
+    }
+    for (std::size_t i = 0; i < n; ++i)
+        this->outside_victims.push_back(i);
+}
+
+std::size_t Work_stealing_pool::queue_index() const
+{
+    return current_pool == this ? current_index : this->workers.size();
+}
+
+bool Work_stealing_pool::own_queue_empty() const
+{
+    const std::size_t index = this->queue_index();
+    if (index < this->workers.size())
+        return this->workers[index]->tasks.size() == 0;
+    return this->outside.count.load(std::memory_order_relaxed) == 0;
+}
+
+void Work_stealing_pool::run(Task_group& group, std::function<void()> task)
+{
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    Task* const wrapped = new Task([&group, task = std::move(task)]
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock {group.mutex};
+            if (!group.error)
+                group.error = std::current_exception();
+        }
+        group.pending.fetch_sub(1, std::memory_order_release);
+    });
+
+    // counted before it is in the queue, so the count is never less than the tasks queued
+    this->queued.fetch_add(1, std::memory_order_seq_cst);
+    const std::size_t index = this->queue_index();
+    if (index < this->workers.size())
+        this->workers[index]->tasks.push(wrapped);
+    else
+    {
+        std::lock_guard<std::mutex> lock {this->outside.mutex};
+        this->outside.tasks.push_back(wrapped);
+        this->outside.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // a worker counts itself in sleeping before it looks at queued, and run looks at sleeping
+    // after it counted the task, one of them sees the other, no lock when nobody sleeps
+    if (this->sleeping.load(std::memory_order_seq_cst) == 0)
+        return;
+    // a worker that saw no task and is about to sleep has the lock, it sees this one after
+    {
+        std::lock_guard<std::mutex> lock {this->sleep_mutex};
+    }
+    this->wake.notify_one();
+}
+
+// the bottom of the own deque, the queue of the outside threads, or the top of another deque
+Work_stealing_pool::Task* Work_stealing_pool::take(std::size_t index)
+{
+    const bool is_worker = index < this->workers.size();
+    if (is_worker)
+        if (Task* const task = this->workers[index]->tasks.pop())
+            return task;
+
+    if (this->outside.count.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock {this->outside.mutex};
+        if (!this->outside.tasks.empty())
+        {
+            // a worker takes the oldest one, like a steal, an outside thread the newest one
+            Task* task;
+            if (is_worker)
+            {
+                task = this->outside.tasks.front();
+                this->outside.tasks.pop_front();
+            }
+            else
+            {
+                task = this->outside.tasks.back();
+                this->outside.tasks.pop_back();
+            }
+            this->outside.count.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    for (std::size_t victim : is_worker ? this->workers[index]->victims : this->outside_victims)
+        if (Task* const task = this->workers[victim]->tasks.steal())
+            return task;
+    return nullptr;
+}
+
+bool Work_stealing_pool::try_run(std::size_t index)
+{
+    Task* const task = this->take(index);
+    if (task == nullptr)
+        return false;
+    this->queued.fetch_sub(1, std::memory_order_relaxed);
+    (*task)();
+    delete task;
+    return true;
+}
+
+void Work_stealing_pool::work(std::size_t index)
+{
+    current_pool = this;
+    current_index = index;
+    pin(this->workers[index]->cpus);
+    while (true)
+    {
+        if (this->try_run(index))
+            continue;
+        std::unique_lock<std::mutex> lock {this->sleep_mutex};
+        this->sleeping.fetch_add(1, std::memory_order_seq_cst);
+        this->wake.wait(lock, [this] { return this->stopping || this->queued.load(std::memory_order_seq_cst) > 0; });
+        this->sleeping.fetch_sub(1, std::memory_order_relaxed);
+        if (this->stopping)
+            return;
+    }
+}
+
+void Work_stealing_pool::wait(Task_group& group)
+{
+    while (group.pending.load(std::memory_order_acquire) != 0)
+        if (!this->try_run(this->queue_index()))
+            std::this_thread::yield();
+
+    std::lock_guard<std::mutex> lock {group.mutex};
+    if (group.error)
+    {
+        std::exception_ptr error = group.error;
+        group.error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
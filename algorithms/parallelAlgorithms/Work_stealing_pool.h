@@ -0,0 +1,193 @@
+#ifndef _WORK_STEALING_POOL_H_
+#define _WORK_STEALING_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Chase_lev_deque.h"
+
+/*
+
+    - a Work_stealing_pool runs tasks on its worker threads, every worker has a
+      Chase_lev_deque of its own, a task that a worker runs pushes the tasks it makes to the
+      bottom of its deque and the worker pops them from the bottom, the last one first, while
+      the cache still has its data, no lock. a worker that has nothing to do steals from the
+      top of another deque, the oldest task, the biggest part of the work that was split.
+
+    - a thread that is not a worker pushes to one more queue, the one of the outside threads,
+      with a mutex, the deques have one owner, the workers take from it after their own deque.
+
+    - the tasks of a Task_group are waited for together, wait runs tasks, of any group, until
+      the ones of its group are done, so the waiting thread works too and a task can wait
+      for the tasks it made, and it rethrows the first exception one of them threw.
+
+    - submit(f) runs f as a task of no group and returns a std::future of its result, or of
+      its exception, the destructor of the pool waits for the submitted tasks. get() of the
+      future blocks and runs no task, a pool of 0 workers runs f in submit, and a task waits
+      for the tasks it made with a Task_group, not a future.
+
+    - parallel_for(first, last, f) calls f(i) for every i of [first, last), with lazy binary
+      splitting: a thread runs its range grain indices at a time, and splits half of what is
+      left off as a task only when its own queue is empty, when no task of it is waiting to
+      be stolen. a range that runs on a pool with nothing else to do is split a few times,
+      one that is stolen from again and again is split into many pieces, the grain adapts to
+      the load without a guess of the cost of f. grain is (last - first) / (size() * 64) by
+      default, the most indices that run without a look at the queue.
+
+    - placement puts the workers on the cores, Placement::cores pins worker i to the i + 1th
+      core the process can run on, the first one is for the thread that waits, and
+      Placement::numa_nodes spreads the workers over the NUMA nodes, a worker can run on
+      every core of its node and steals from the workers of its node first, the tasks it
+      takes have their data in the memory of its node more often. only on Linux, elsewhere
+      and on a machine of one node the workers are where the system puts them.
+
+    - size is the number of threads that work, the workers and the one waiting, a pool of 0
+      workers runs everything in wait.
+
+*/
+class Work_stealing_pool
+{
+public:
+    class Task_group
+    {
+        friend class Work_stealing_pool;
+
+    private:
+        std::atomic<std::size_t> pending {0};
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+
+    enum class Placement
+    {
+        any,
+        cores,
+        numa_nodes
+    };
+
+    explicit Work_stealing_pool(std::size_t num_workers = default_workers(), Placement placement = Placement::any);
+    ~Work_stealing_pool();
+
+    Work_stealing_pool(const Work_stealing_pool&) = delete;
+    Work_stealing_pool& operator=(const Work_stealing_pool&) = delete;
+
+    std::size_t size() const { return this->threads.size() + 1; }
+
+    void run(Task_group& group, std::function<void()> task);
+    void wait(Task_group& group);
+
+    template <typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& f);
+
+    template <typename F>
+    void parallel_for(std::size_t first, std::size_t last, const F& f, std::size_t grain = 0);
+
+    // a thread for every core but the one of the thread that waits
+    static std::size_t default_workers();
+
+private:
+    using Task = std::function<void()>;
+
+    struct alignas(64) Worker
+    {
+        Chase_lev_deque<Task*> tasks;
+        std::vector<std::size_t> victims; // the workers it steals from, in order, the ones of its node first
+        std::vector<int> cpus;            // the cores it runs on, empty for anywhere
+    };
+
+    struct alignas(64) Outside_queue
+    {
+        std::mutex mutex;
+        std::deque<Task*> tasks;
+        std::atomic<std::size_t> count {0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    Outside_queue outside;
+    std::vector<std::size_t> outside_victims;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> queued;
+    std::atomic<std::size_t> sleeping;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping;
+    Task_group submitted;
+
+    std::size_t queue_index() const;
+    bool own_queue_empty() const;
+    void place(Placement placement);
+    Task* take(std::size_t index);
+    bool try_run(std::size_t index);
+    void work(std::size_t index);
+};
+
+template <typename F>
+std::future<std::invoke_result_t<std::decay_t<F>>> Work_stealing_pool::submit(F&& f)
+{
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    // shared, a std::function is copyable and a packaged_task is not
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+    std::future<Result> result = task->get_future();
+    if (this->workers.empty())
+        (*task)();
+    else
+        this->run(this->submitted, [task] { (*task)(); });
+    return result;
+}
+
+template <typename F>
+void Work_stealing_pool::parallel_for(std::size_t first, std::size_t last, const F& f, std::size_t grain)
+{
+    if (first >= last)
+        return;
+    if (grain == 0)
+        grain = std::max<std::size_t>(1, (last - first) / (this->size() * 64));
+
+    Task_group group;
+    std::function<void(std::size_t, std::size_t)> range = [&](std::size_t begin, std::size_t end)
+    {
+        while (begin < end)
+        {
+            if (end - begin > grain && this->own_queue_empty())
+            {
+                const std::size_t middle = begin + (end - begin) / 2;
+                this->run(group, [&range, middle, end] { range(middle, end); });
+                end = middle;
+                continue;
+            }
+            const std::size_t stop = begin + std::min(grain, end - begin);
+            for (std::size_t i = begin; i < stop; ++i)
+                f(i);
+            begin = stop;
+        }
+    };
+    try
+    {
+        range(first, last);
+    }
+    catch (...)
+    {
+        // the tasks have range and group, they are done before they go away
+        try
+        {
+            this->wait(group);
+        }
+        catch (...)
+        {
+        }
+        throw;
+    }
+    this->wait(group);
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Parallel_algorithms.h"
+#include "Work_stealing_pool.h"
+
+int main()
+{
+    std::vector<int> v(10'000'000);
+    std::iota(v.begin(), v.end(), 1);
+
+    // the examples of count_if, find_if, any_of and transform, on 10 million numbers
+    std::cout << "threads: " << parallel::default_pool().size() << '\n';
+    auto divisible_by_4 = [](int i) { return i % 4 == 0; };
+    std::cout << "numbers divisible by four: " << parallel::count_if(parallel::par, v.begin(), v.end(), divisible_by_4)
+              << " (std: " << std::count_if(v.begin(), v.end(), divisible_by_4) << ")\n";
+
+    auto it = parallel::find_if(parallel::par, v.begin(), v.end(), [](int i) { return i > 1000 && i % 997 == 0; });
+    if (it != v.end())
+        std::cout << "first multiple of 997 after 1000: " << *it << '\n';
+
+    std::cout << std::boolalpha
+              << "any divisible by 10'000'019: " << parallel::any_of(parallel::par, v.begin(), v.end(), [](int i) { return i % 10'000'019 == 0; }) << '\n'
+              << "all positive: " << parallel::all_of(parallel::par, v.begin(), v.end(), [](int i) { return i > 0; }) << '\n';
+
+    std::vector<long long> doubled(v.size());
+    parallel::transform(parallel::par_unseq, v.begin(), v.end(), doubled.begin(), [](int i) { return 2LL * i; });
+    std::cout << "sum of the doubled: " << parallel::reduce(parallel::par, doubled.begin(), doubled.end(), 0LL)
+              << " (std: " << std::reduce(doubled.begin(), doubled.end(), 0LL) << ")\n";
+
+    // a pool of its own, and the sequential policy on a string, it runs the std algorithm
+    Work_stealing_pool pool {3};
+    parallel::replace_if(parallel::par.on(pool), v.begin(), v.end(), [](int i) { return i % 2 == 0; }, 0);
+    std::cout << "zeros on a pool of " << pool.size() << ": " << parallel::count(parallel::par.on(pool), v.begin(), v.end(), 0) << '\n';
+
+    // a future of a task, and a loop split as the workers steal, on workers pinned to the cores
+    Work_stealing_pool pinned {3, Work_stealing_pool::Placement::cores};
+    std::future<long long> total = pinned.submit([&v] { return std::accumulate(v.begin(), v.end(), 0LL); });
+    std::vector<int> squares(1'000'000);
+    pinned.parallel_for(0, squares.size(), [&squares](std::size_t i) { squares[i] = static_cast<int>(i % 1000 * (i % 1000)); });
+    std::cout << "sum of the zeros and odds: " << total.get() << ", last square: " << squares.back() << '\n';
+
+    // dice rolls, a Philox stream for every element, the same on 1 thread and on the pool of 3
+    std::vector<int> rolls(10'000'000), rolls_seq(rolls.size());
+    auto roll = [](fast_random::Philox4x32& gen) { return static_cast<int>(fast_random::bounded(gen, 6)) + 1; };
+    parallel::generate_random(parallel::par.on(pool), rolls.begin(), rolls.end(), 2024, roll);
+    parallel::generate_random(parallel::seq, rolls_seq.begin(), rolls_seq.end(), 2024, roll);
+    std::cout << "mean of the rolls: " << parallel::reduce(parallel::par, rolls.begin(), rolls.end(), 0LL) / 1e7
+              << ", the same with seq: " << std::boolalpha << (rolls == rolls_seq) << '\n';
+    parallel::generate_indexed_n(parallel::par, squares.begin(), squares.size(), [](std::size_t i) { return static_cast<int>(i % 1000 * (i % 1000)); });
+    std::cout << "last square: " << squares.back() << '\n';
+
+    std::string hello {"hello"};
+    parallel::transform(parallel::seq, hello.begin(), hello.end(), hello.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    std::cout << "hello = " << hello << '\n';
+
+    // the first exception of a chunk comes out of the algorithm
+    try
+    {
+        parallel::for_each(parallel::par, v.begin(), v.end(), [](int i) { if (i == 5'000'001) throw std::runtime_error {"5'000'001"}; });
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "caught: " << e.what() << '\n';
+    }
+
+    return 0;
+}
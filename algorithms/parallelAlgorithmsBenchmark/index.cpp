@@ -0,0 +1,109 @@
+/*
+
+    - compares the std algorithms against the ones of ../parallelAlgorithms/Parallel_algorithms.h
+      with par and par_unseq on pools of 1, 2, 4, ... threads, up to twice the cores: transform
+      of a vector into another one, count_if, find_if of the last element, so every chunk is
+      looked at, reduce, and generate_random of numbers of [0, 1000) with a Philox stream an
+      element, and checks that they give the same results.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 100'000'000 ints by default, the number can be given on the command line, e.g.
+      ./a.out 10000000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+struct Times
+{
+    double transform;
+    double count_if;
+    double find_if;
+    double reduce;
+    double generate;
+    std::uint64_t sum;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Policy>
+Times run(const Policy& policy, const std::vector<int>& values, std::vector<int>& out)
+{
+    Times times {};
+    const int last = values.back();
+
+    auto start = std::chrono::steady_clock::now();
+    parallel::transform(policy, values.begin(), values.end(), out.begin(), [](int i) { return i * 3 + 1; });
+    times.transform = seconds_since(start);
+    times.sum += static_cast<std::uint32_t>(out[out.size() / 2]);
+
+    start = std::chrono::steady_clock::now();
+    times.sum += parallel::count_if(policy, out.begin(), out.end(), [](int i) { return i % 7 == 0; });
+    times.count_if = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    times.sum += parallel::find_if(policy, values.begin(), values.end(), [last](int i) { return i == last; }) - values.begin();
+    times.find_if = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    times.sum += parallel::reduce(policy, out.begin(), out.end(), std::int64_t {0});
+    times.reduce = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    parallel::generate_random(policy, out.begin(), out.end(), 2024, [](fast_random::Philox4x32& gen) {
+        return static_cast<int>(fast_random::bounded(gen, 1000));
+    });
+    times.generate = seconds_since(start);
+    times.sum += parallel::reduce(policy, out.begin(), out.end(), std::int64_t {0});
+
+    return times;
+}
+
+void print(const std::string& name, const Times& times, std::size_t n)
+{
+    std::cout << std::setw(24) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(12) << std::right << times.transform * 1e9 / n
+        << std::setw(12) << times.count_if * 1e9 / n
+        << std::setw(12) << times.find_if * 1e9 / n
+        << std::setw(12) << times.reduce * 1e9 / n
+        << std::setw(12) << times.generate * 1e9 / n
+        << "    " << times.sum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000'000;
+
+    std::vector<int> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<int> out(n);
+
+    std::cout << n << " ints, ns per element of transform, count_if, find_if, reduce, generate_random" << std::endl;
+    print("std", run(parallel::seq, values, out), n);
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        print("par, " + std::to_string(threads) + " threads", run(parallel::par.on(pool), values, out), n);
+        print("par_unseq, " + std::to_string(threads) + " threads", run(parallel::par_unseq.on(pool), values, out), n);
+    }
+
+    return 0;
+}
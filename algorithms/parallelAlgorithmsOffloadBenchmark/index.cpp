@@ -0,0 +1,138 @@
+/*
+
+    - transform and count_if of ../parallelAlgorithms/Parallel_algorithms.h with par_unseq,
+      the cores, and with par_offload, the device of Offload.h: automatic, the device when
+      there is one and the range is large, and always the device, Target::device, whose
+      target regions run on the host when there is none. transform of ints, a light
+      function, transform of doubles by a polynomial of degree 16, a heavy one, the ints in
+      place, and count_if.
+
+    - every result has to be the one of par_unseq, bit for bit, the doubles too, a mismatch
+      is reported and the exit code is 1. the times are the medians of
+      ../benchmarkHarness/Benchmark_harness.h, a warm up and 5 runs.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread -fopenmp -DBASICS_OFFLOAD index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+      or with -DBASICS_OFFLOAD=ON in CMake, without it par_offload is par_unseq.
+
+    - 20'000'000 elements by default, the number can be given on the command line, e.g.
+      ./a.out 100000000
+
+    - on one core of an x86-64 at -O2, no device, ns an element:
+                                   ints  polynomial   in place    count_if
+        par_unseq                 1.615       9.427      1.130       2.768
+        par_offload               1.626       8.378      1.264       2.479
+        par_offload, device       1.638       9.180      1.192       2.901
+      automatic stays on the cores without a device. forced, the target regions run on the
+      host, a chunk a task of OpenMP, no copies, about the loops of par_unseq. on a GPU the
+      light loops are bound by the bus, 8 bytes an int there and back, the polynomial is the
+      one that can gain.
+
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../parallelAlgorithms/Offload.h"
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+struct Times
+{
+    double ints;
+    double polynomial;
+    double in_place;
+    double count_if;
+};
+
+struct Results
+{
+    std::vector<int> ints;
+    std::vector<double> polynomial;
+    std::vector<int> in_place;
+    std::ptrdiff_t count;
+};
+
+const bench::Options options {1, 5};
+
+// ns an element of every loop
+template <typename Policy>
+Times run(const std::string& name, const Policy& policy, const std::vector<int>& values, const std::vector<double>& xs, Results& results)
+{
+    static bench::Perf_events events;
+    Times times {};
+    const std::size_t n = values.size();
+    const int* first = values.data();
+    const int* last = first + n;
+
+    times.ints = bench::measure("ints", name, n, options, events, [&] {
+        parallel::transform(policy, first, last, results.ints.data(), [](int i) { return i * 3 + 1; });
+    }).ns_per_element();
+
+    times.polynomial = bench::measure("polynomial", name, n, options, events, [&] {
+        parallel::transform(policy, xs.data(), xs.data() + xs.size(), results.polynomial.data(), [](double x) {
+            double y = 1.0;
+            for (int k = 0; k < 16; ++k)
+                y = y * x + 1.0 / (k + 1);
+            return y;
+        });
+    }).ns_per_element();
+
+    times.in_place = bench::measure("in place", name, n, options, events, [&] { results.in_place = values; }, [&] {
+        parallel::transform(policy, results.in_place.data(), results.in_place.data() + n, results.in_place.data(),
+            [](int i) { return i ^ (i >> 3); });
+    }).ns_per_element();
+
+    times.count_if = bench::measure("count_if", name, n, options, events, [&] {
+        results.count = parallel::count_if(policy, first, last, [](int i) { return i % 7 == 0; });
+    }).ns_per_element();
+
+    return times;
+}
+
+void print(const std::string& name, const Times& times)
+{
+    std::cout << std::setw(24) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << times.ints
+        << std::setw(12) << times.polynomial
+        << std::setw(11) << times.in_place
+        << std::setw(12) << times.count_if << std::endl;
+}
+
+int mismatches_of(const Results& expected, const Results& results)
+{
+    return (results.ints != expected.ints)
+        + (std::memcmp(results.polynomial.data(), expected.polynomial.data(), expected.polynomial.size() * sizeof(double)) != 0)
+        + (results.in_place != expected.in_place)
+        + (results.count != expected.count);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20'000'000;
+
+    std::vector<int> values(n);
+    std::iota(values.begin(), values.end(), -static_cast<int>(n / 2));
+    std::vector<double> xs(n);
+    for (std::size_t i = 0; i < n; ++i)
+        xs[i] = static_cast<double>(i % 2001) / 1000 - 1;
+
+    const auto make_results = [n] { return Results {std::vector<int>(n), std::vector<double>(n), {}, 0}; };
+    Results expected = make_results(), automatic = make_results(), device = make_results();
+
+    std::cout << n << " elements, " << offload::device_count() << " devices, ns an element:" << std::endl
+        << std::setw(24) << "" << "      ints  polynomial   in place    count_if" << std::endl;
+    print("par_unseq", run("par_unseq", parallel::par_unseq, values, xs, expected));
+    print("par_offload", run("par_offload", parallel::par_offload, values, xs, automatic));
+    print("par_offload, device", run("par_offload, device", parallel::par_offload.at(offload::Target::device), values, xs, device));
+
+    const int mismatches = mismatches_of(expected, automatic) + mismatches_of(expected, device);
+    std::cout << "mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
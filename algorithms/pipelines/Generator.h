@@ -0,0 +1,225 @@
+#ifndef _GENERATOR_H_
+#define _GENERATOR_H_
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Generator is the generator<T> of a C++20 coroutine in C++17: a stateful lambda that
+      gives the next value as a std::optional, std::nullopt when there is none left, and
+      the Generator makes an input range of it, the values are made one at a time as the
+      loop over it asks for them, nothing is kept but the state of the lambda:
+        auto counter = pipeline::generate([n = 0]() mutable { return n < 3 ? std::optional<int>(n++) : std::nullopt; });
+
+    - lines(in) is a Generator of the lines of a stream, a file with lines(path), as
+      std::getline gives them, without the '\n', views into one buffer of 64 KiB that the
+      stream is read into, a line cut by its end is moved to its front before the next read,
+      the buffer grows when a line is longer than it. words(line) is a Generator of the
+      runs of a text between whitespace, views into the text. the memory is the buffer and
+      the state, not the lines of the file or the words of a line.
+
+    - a Generator is a range, for (std::string_view line : lines) or the start of a
+      pipeline of Pipeline.h, lines | pipeline::filter(...) | pipeline::count(), it is an
+      input range, what is read is gone, a second loop over it goes on from where the
+      first one stopped. a view lives until the next value is pulled, so a stage keeps a
+      std::string of it and not the view, and the generator has to outlive the loops over
+      it, it is not copied or moved, the iterators point to it.
+
+*/
+namespace pipeline
+{
+    template<class F>
+    class Generator
+    {
+    public:
+        using value_type = typename std::invoke_result_t<F&>::value_type;
+
+    private:
+        F f;
+        std::optional<value_type> current;
+        bool started {false};
+
+        void next() { this->current = this->f(); }
+
+    public:
+        // what the postfix ++ gives, the value before the next one is pulled
+        struct Old_value
+        {
+            value_type value;
+
+            const value_type& operator*() const { return this->value; }
+        };
+
+        class iterator
+        {
+        private:
+            Generator* generator;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename Generator::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            explicit iterator(Generator* generator = nullptr) : generator(generator) {}
+
+            reference operator*() const { return *this->generator->current; }
+            pointer operator->() const { return &*this->generator->current; }
+
+            iterator& operator++()
+            {
+                this->generator->next();
+                return *this;
+            }
+
+            Old_value operator++(int)
+            {
+                Old_value old {*this->generator->current};
+                this->generator->next();
+                return old;
+            }
+
+            // the end is a null generator, or one that has nothing left
+            bool at_end() const { return this->generator == nullptr || !this->generator->current; }
+
+            friend bool operator==(const iterator& a, const iterator& b)
+            {
+                return a.at_end() == b.at_end() && (a.at_end() || a.generator == b.generator);
+            }
+            friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+        };
+
+        explicit Generator(F f) : f(std::move(f)) {}
+
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+
+        // the first value is pulled by the first begin, another one goes on from the current value
+        iterator begin()
+        {
+            if (!this->started)
+            {
+                this->started = true;
+                this->next();
+            }
+            return iterator {this};
+        }
+
+        iterator end() { return iterator {}; }
+    };
+
+    template<class F>
+    Generator<std::decay_t<F>> generate(F&& f) { return Generator<std::decay_t<F>> {std::forward<F>(f)}; }
+
+    namespace detail
+    {
+        class Line_reader
+        {
+        private:
+            std::ifstream file;
+            std::istream* in;
+            std::vector<char> buffer;
+            std::size_t begin {0};
+            std::size_t end {0};
+            std::size_t scanned {0};  // the bytes after begin that have no '\n'
+            bool at_eof {false};
+
+            // a moved reader reads its own file, not the one of the reader it was moved from
+            std::istream& stream() { return this->file.is_open() ? this->file : *this->in; }
+
+        public:
+            Line_reader(std::istream& in, std::size_t block_size) : in(&in), buffer(block_size > 0 ? block_size : 1) {}
+
+            Line_reader(const std::string& path, std::size_t block_size)
+                : file(path, std::ios::binary), in(nullptr), buffer(block_size > 0 ? block_size : 1)
+            {
+                if (!this->file)
+                    throw std::runtime_error("cannot open " + path);
+            }
+
+            std::optional<std::string_view> operator()()
+            {
+                for (;;)
+                {
+                    const char* first = this->buffer.data() + this->begin;
+                    const void* newline = std::memchr(first + this->scanned, '\n', this->end - this->begin - this->scanned);
+                    if (newline != nullptr)
+                    {
+                        const std::size_t size = static_cast<std::size_t>(static_cast<const char*>(newline) - first);
+                        this->begin += size + 1;
+                        this->scanned = 0;
+                        return std::string_view {first, size};
+                    }
+                    if (this->at_eof)
+                    {
+                        if (this->begin == this->end)
+                            return std::nullopt;
+                        const std::string_view last {first, this->end - this->begin};
+                        this->begin = this->end;
+                        this->scanned = 0;
+                        return last;
+                    }
+
+                    // the cut line to the front, the bytes of it were scanned already
+                    this->scanned = this->end - this->begin;
+                    std::memmove(this->buffer.data(), first, this->scanned);
+                    this->begin = 0;
+                    this->end = this->scanned;
+                    if (this->end == this->buffer.size())
+                        this->buffer.resize(this->buffer.size() * 2);
+
+                    std::istream& in = this->stream();
+                    in.read(this->buffer.data() + this->end, static_cast<std::streamsize>(this->buffer.size() - this->end));
+                    this->end += static_cast<std::size_t>(in.gcount());
+                    if (!in)
+                        this->at_eof = true;
+                }
+            }
+        };
+
+        inline bool is_space(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+    }
+
+    inline Generator<detail::Line_reader> lines(std::istream& in, std::size_t block_size = 64 * 1024)
+    {
+        return Generator<detail::Line_reader> {detail::Line_reader {in, block_size}};
+    }
+
+    // throws std::runtime_error when the file cannot be opened
+    inline Generator<detail::Line_reader> lines(const std::string& path, std::size_t block_size = 64 * 1024)
+    {
+        return Generator<detail::Line_reader> {detail::Line_reader {path, block_size}};
+    }
+
+    inline auto words(std::string_view text)
+    {
+        return generate([text, position = std::size_t {0}]() mutable -> std::optional<std::string_view>
+        {
+            while (position < text.size() && detail::is_space(text[position]))
+                ++position;
+            if (position == text.size())
+                return std::nullopt;
+            const std::size_t begin = position;
+            while (position < text.size() && !detail::is_space(text[position]))
+                ++position;
+            return text.substr(begin, position - begin);
+        });
+    }
+}
+
+#endif
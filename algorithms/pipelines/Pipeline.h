@@ -0,0 +1,378 @@
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+/*
+
+    - a pipeline is a range and stages, filter, transform and take, that run on its elements
+      one at a time, the way std::copy_if to a vector, std::transform of it to another one and
+      std::accumulate of that one would, but in one loop, without the vectors in between:
+        pipeline::from(events) | pipeline::filter(is_withdrawal) | pipeline::transform(amount) | pipeline::reduce(0LL)
+
+    - nothing runs until the pipeline ends in one of the terminals, reduce, count, for_each or
+      to_vector. every stage is a function that takes an element and gives it to the next
+      one, the terminal is the last one, the compiler inlines all of them in the loop over the
+      range, when they are lambdas, a function passed by its name is a pointer to it, that the
+      compiler may call without inlining it. take(n) stops the loop after its n-th element, the
+      rest of the range is not read.
+
+    - from(range) keeps a reference to the range, a container, an array, ..., it has to
+      outlive the pipeline, from(first, last) takes the iterators. a range that is an lvalue
+      can start a pipeline without from: numbers | pipeline::filter(is_even).
+
+    - reduce(policy, init, op) of ../parallelAlgorithms runs the stages on the chunks of a
+      range with random access iterators on the threads of a Work_stealing_pool, every chunk
+      reduces its own elements and the results are reduced in the order of the chunks, so op
+      has to be associative, like for std::reduce. with a take the elements that are kept
+      depend on the ones before them, so such a pipeline runs with parallel::seq.
+
+*/
+namespace pipeline
+{
+    template<class Pred>
+    struct Filter
+    {
+        Pred pred;
+
+        template<class In>
+        using output = In;
+
+        template<class Next>
+        auto wrap(Next next) const
+        {
+            return [pred = this->pred, next = std::move(next)](auto&& value) mutable -> bool
+            {
+                return !pred(value) || next(std::forward<decltype(value)>(value));
+            };
+        }
+    };
+
+    template<class F>
+    struct Transform
+    {
+        F f;
+
+        template<class In>
+        using output = std::invoke_result_t<F&, In>;
+
+        template<class Next>
+        auto wrap(Next next) const
+        {
+            return [f = this->f, next = std::move(next)](auto&& value) mutable -> bool
+            {
+                return next(std::invoke(f, std::forward<decltype(value)>(value)));
+            };
+        }
+    };
+
+    struct Take
+    {
+        std::size_t n;
+
+        template<class In>
+        using output = In;
+
+        template<class Next>
+        auto wrap(Next next) const
+        {
+            // false after the last one, so the loop stops without reading one more
+            return [left = this->n, next = std::move(next)](auto&& value) mutable -> bool
+            {
+                if (left == 0)
+                    return false;
+                --left;
+                return next(std::forward<decltype(value)>(value)) && left != 0;
+            };
+        }
+    };
+
+    template<class Pred>
+    Filter<std::decay_t<Pred>> filter(Pred&& pred) { return {std::forward<Pred>(pred)}; }
+
+    template<class F>
+    Transform<std::decay_t<F>> transform(F&& f) { return {std::forward<F>(f)}; }
+
+    inline Take take(std::size_t n) { return {n}; }
+
+    namespace detail
+    {
+        template<class T>
+        struct is_stage : std::false_type {};
+
+        template<class Pred>
+        struct is_stage<Filter<Pred>> : std::true_type {};
+
+        template<class F>
+        struct is_stage<Transform<F>> : std::true_type {};
+
+        template<>
+        struct is_stage<Take> : std::true_type {};
+
+        template<class In, class... Stages>
+        struct Output { using type = In; };
+
+        template<class In, class Stage, class... Stages>
+        struct Output<In, Stage, Stages...> : Output<typename Stage::template output<In>, Stages...> {};
+    }
+
+    template<class It, class... Stages>
+    class Pipeline
+    {
+    private:
+        It first;
+        It last;
+        std::tuple<Stages...> stages;
+
+        template<std::size_t I, class Sink>
+        auto wrap(Sink sink) const
+        {
+            if constexpr (I == 0)
+                return sink;
+            else
+                return this->wrap<I - 1>(std::get<I - 1>(this->stages).wrap(std::move(sink)));
+        }
+
+    public:
+        // what the last stage gives to the terminal, a reference to an element when no stage transforms them
+        using reference = typename detail::Output<typename std::iterator_traits<It>::reference, Stages...>::type;
+        using value_type = std::decay_t<reference>;
+
+        static constexpr bool has_take = (std::is_same_v<Stages, Take> || ...);
+
+        Pipeline(It first, It last, std::tuple<Stages...> stages) : first(first), last(last), stages(std::move(stages)) {}
+
+        It begin() const { return this->first; }
+        It end() const { return this->last; }
+
+        template<class Stage>
+        Pipeline<It, Stages..., Stage> then(Stage stage) const
+        {
+            return {this->first, this->last, std::tuple_cat(this->stages, std::make_tuple(std::move(stage)))};
+        }
+
+        // runs the stages on [first, last) until the sink, that gets what the last stage gives,
+        // returns false, and returns the iterator after the element it stopped at
+        template<class Sink>
+        It run_until(It first, It last, Sink sink) const
+        {
+            auto f = this->wrap<sizeof...(Stages)>(std::move(sink));
+            while (first != last)
+                if (!f(*first++))
+                    break;
+            return first;
+        }
+
+        // without a take nothing stops it, a loop without the check is one the compiler vectorizes
+        template<class Sink>
+        void run(It first, It last, Sink sink) const
+        {
+            if constexpr (has_take)
+                this->run_until(first, last, std::move(sink));
+            else
+            {
+                auto f = this->wrap<sizeof...(Stages)>(std::move(sink));
+                for (; first != last; ++first)
+                    f(*first);
+            }
+        }
+
+        template<class Sink>
+        void run(Sink sink) const { this->run(this->first, this->last, std::move(sink)); }
+    };
+
+    namespace detail
+    {
+        template<class T>
+        struct is_pipeline : std::false_type {};
+
+        template<class It, class... Stages>
+        struct is_pipeline<Pipeline<It, Stages...>> : std::true_type {};
+
+        template<class P>
+        constexpr bool is_policy = std::is_same_v<std::decay_t<P>, parallel::Sequenced_policy>
+            || std::is_same_v<std::decay_t<P>, parallel::Parallel_policy>
+            || std::is_same_v<std::decay_t<P>, parallel::Parallel_unsequenced_policy>;
+
+        // a container, an array, ..., that is not a pipeline already
+        template<class Range>
+        using if_range = std::enable_if_t<!is_pipeline<std::remove_cv_t<Range>>::value, decltype(std::begin(std::declval<Range&>()))>;
+    }
+
+    template<class It>
+    Pipeline<It> from(It first, It last) { return {first, last, {}}; }
+
+    template<class Range>
+    auto from(Range& range) { return from(std::begin(range), std::end(range)); }
+
+    template<class It, class... Stages, class Stage, class = std::enable_if_t<detail::is_stage<Stage>::value>>
+    Pipeline<It, Stages..., Stage> operator|(const Pipeline<It, Stages...>& p, Stage stage)
+    {
+        return p.then(std::move(stage));
+    }
+
+    template<class Range, class Stage, class = std::enable_if_t<detail::is_stage<Stage>::value>, class = detail::if_range<Range>>
+    auto operator|(Range& range, Stage stage)
+    {
+        return from(range).then(std::move(stage));
+    }
+
+    template<class T, class Op>
+    struct Reduce
+    {
+        T init;
+        Op op;
+
+        template<class It, class... Stages>
+        T operator()(const Pipeline<It, Stages...>& p) const
+        {
+            T result = this->init;
+            Op op = this->op;
+            p.run([&result, &op](auto&& value) { result = op(std::move(result), std::forward<decltype(value)>(value)); return true; });
+            return result;
+        }
+    };
+
+    template<class Policy, class T, class Op>
+    struct Parallel_reduce
+    {
+        Policy policy;
+        T init;
+        Op op;
+
+        template<class It, class... Stages>
+        T operator()(const Pipeline<It, Stages...>& p) const
+        {
+            if constexpr (!parallel::detail::is_parallel<Policy, It> || Pipeline<It, Stages...>::has_take)
+                return Reduce<T, Op> {this->init, this->op}(p);
+            else
+            {
+                const std::size_t n = static_cast<std::size_t>(p.end() - p.begin());
+                Work_stealing_pool& pool = parallel::detail::pool_of(this->policy);
+                const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+                std::vector<std::optional<T>> partials(chunks);
+                parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+                {
+                    std::optional<T> partial;
+                    Op op = this->op;
+                    const auto first = p.begin() + static_cast<typename std::iterator_traits<It>::difference_type>(begin);
+                    const auto last = p.begin() + static_cast<typename std::iterator_traits<It>::difference_type>(end);
+                    // the first element that comes out of the stages starts the sum of the chunk, in a
+                    // loop of its own, so the one of the rest has no branch on it
+                    const auto rest = p.run_until(first, last, [&partial](auto&& value)
+                    {
+                        partial.emplace(std::forward<decltype(value)>(value));
+                        return false;
+                    });
+                    if (!partial)
+                        return;
+                    T sum = std::move(*partial);
+                    p.run(rest, last, [&sum, &op](auto&& value) { sum = op(std::move(sum), std::forward<decltype(value)>(value)); return true; });
+                    partials[chunk] = std::move(sum);
+                });
+
+                T result = this->init;
+                for (std::optional<T>& partial : partials)
+                    if (partial)
+                        result = this->op(std::move(result), std::move(*partial));
+                return result;
+            }
+        }
+    };
+
+    struct Count
+    {
+        template<class It, class... Stages>
+        std::size_t operator()(const Pipeline<It, Stages...>& p) const
+        {
+            std::size_t count {0};
+            p.run([&count](auto&&) { ++count; return true; });
+            return count;
+        }
+    };
+
+    template<class F>
+    struct For_each
+    {
+        F f;
+
+        template<class It, class... Stages>
+        F operator()(const Pipeline<It, Stages...>& p) const
+        {
+            F f = this->f;
+            p.run([&f](auto&& value) { std::invoke(f, std::forward<decltype(value)>(value)); return true; });
+            return f;
+        }
+    };
+
+    struct To_vector
+    {
+        template<class It, class... Stages>
+        std::vector<typename Pipeline<It, Stages...>::value_type> operator()(const Pipeline<It, Stages...>& p) const
+        {
+            std::vector<typename Pipeline<It, Stages...>::value_type> result;
+            p.run([&result](auto&& value) { result.emplace_back(std::forward<decltype(value)>(value)); return true; });
+            return result;
+        }
+    };
+
+    template<class T, class Op = std::plus<>, std::enable_if_t<!detail::is_policy<T>, int> = 0>
+    Reduce<T, std::decay_t<Op>> reduce(T init, Op&& op = {}) { return {std::move(init), std::forward<Op>(op)}; }
+
+    template<class Policy, class T, class Op = std::plus<>, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    Parallel_reduce<std::decay_t<Policy>, T, std::decay_t<Op>> reduce(Policy&& policy, T init, Op&& op = {})
+    {
+        return {std::forward<Policy>(policy), std::move(init), std::forward<Op>(op)};
+    }
+
+    inline Count count() { return {}; }
+
+    template<class F>
+    For_each<std::decay_t<F>> for_each(F&& f) { return {std::forward<F>(f)}; }
+
+    inline To_vector to_vector() { return {}; }
+
+    namespace detail
+    {
+        template<class T>
+        struct is_terminal : std::false_type {};
+
+        template<class T, class Op>
+        struct is_terminal<Reduce<T, Op>> : std::true_type {};
+
+        template<class Policy, class T, class Op>
+        struct is_terminal<Parallel_reduce<Policy, T, Op>> : std::true_type {};
+
+        template<>
+        struct is_terminal<Count> : std::true_type {};
+
+        template<class F>
+        struct is_terminal<For_each<F>> : std::true_type {};
+
+        template<>
+        struct is_terminal<To_vector> : std::true_type {};
+    }
+
+    template<class It, class... Stages, class Terminal, class = std::enable_if_t<detail::is_terminal<Terminal>::value>>
+    auto operator|(const Pipeline<It, Stages...>& p, const Terminal& terminal)
+    {
+        return terminal(p);
+    }
+
+    template<class Range, class Terminal, class = std::enable_if_t<detail::is_terminal<Terminal>::value>, class = detail::if_range<Range>>
+    auto operator|(Range& range, const Terminal& terminal)
+    {
+        return terminal(from(range));
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Generator.h"
+#include "Pipeline.h"
+
+struct Event
+{
+    int account;
+    int amount;
+};
+
+class Person
+{
+private:
+    std::string name;
+    int age;
+
+public:
+    Person(std::string name, int age) : name(name), age(age) {}
+
+    const std::string& get_name() const { return this->name; }
+    int get_age() const { return this->age; }
+};
+
+int main()
+{
+    std::vector<int> nums(10);
+    std::iota(nums.begin(), nums.end(), 1);
+
+    // the squares of the even ones, no vector of the even ones, or of the squares
+    const int sum = nums
+        | pipeline::filter([] (int num) { return num % 2 == 0; })
+        | pipeline::transform([] (int num) { return num * num; })
+        | pipeline::reduce(0);
+    std::cout << "sum of the even squares: " << sum << std::endl;
+
+    // the first 2 older than 20, the rest is not looked at
+    std::vector<Person> people {{"Larry", 18}, {"Moe", 30}, {"Curly", 25}, {"Shemp", 40}};
+    const std::vector<std::string> names = pipeline::from(people)
+        | pipeline::filter([] (const Person& p) { return p.get_age() > 20; })
+        | pipeline::take(2)
+        | pipeline::transform(&Person::get_name)
+        | pipeline::to_vector();
+    for (const std::string& name : names)
+        std::cout << name << " ";
+    std::cout << std::endl;
+
+    std::vector<Event> events(10'000'000);
+    for (std::size_t i = 0; i < events.size(); ++i)
+        events[i] = Event {static_cast<int>(i % 100), static_cast<int>(i % 2001) - 1000};
+
+    const auto withdrawals = pipeline::from(events)
+        | pipeline::filter([] (const Event& e) { return e.amount < 0; })
+        | pipeline::transform([] (const Event& e) { return static_cast<long long>(-e.amount); });
+    std::cout << "withdrawals: " << (withdrawals | pipeline::count())
+              << ", total: " << (withdrawals | pipeline::reduce(0LL))
+              << ", total with par: " << (withdrawals | pipeline::reduce(parallel::par, 0LL)) << std::endl;
+
+    withdrawals
+        | pipeline::take(3)
+        | pipeline::for_each([] (long long amount) { std::cout << amount << " "; });
+    std::cout << std::endl;
+
+    // the lines and their words made one at a time, views into the buffer of the lines
+    std::istringstream text {"Larry 18 Moe 30\nCurly 25\n\nShemp 40 and the rest\n"};
+    auto text_lines = pipeline::lines(text);
+    text_lines
+        | pipeline::filter([] (std::string_view line) { return !line.empty(); })
+        | pipeline::for_each([] (std::string_view line)
+        {
+            auto line_words = pipeline::words(line);
+            std::cout << (line_words | pipeline::count()) << " words: " << line << std::endl;
+        });
+
+    std::istringstream numbers {"3 1 4\n1 5 9 2\n6\n"};
+    auto number_lines = pipeline::lines(numbers);
+    const std::size_t num_words = number_lines
+        | pipeline::transform([] (std::string_view line) { auto line_words = pipeline::words(line); return line_words | pipeline::count(); })
+        | pipeline::reduce(std::size_t {0});
+    std::cout << "numbers: " << num_words << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+
+    - compares the sum of the withdrawals of events, with std::copy_if to a vector, std::transform
+      of it to a vector of the amounts and std::accumulate of them, against a pipeline of
+      ../pipelines/Pipeline.h, filter | transform | reduce, a loop written by hand, and the
+      reduce of the pipeline with par on pools of 1, 2, 4, ... threads, up to twice the cores,
+      and checks that they give the same sum. the times are the medians of
+      ../benchmarkHarness/Benchmark_harness.h, a warm up and 5 runs.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 50'000'000 events by default, the number can be given on the command line, e.g.
+      ./a.out 10000000
+
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+#include "../pipelines/Pipeline.h"
+
+struct Event
+{
+    std::int32_t account;
+    std::int32_t amount;
+};
+
+// lambdas, not functions, a function is passed as a pointer, that the compiler may not inline
+const auto is_withdrawal = [](const Event& e) { return e.amount < 0; };
+const auto amount = [](const Event& e) { return -static_cast<std::int64_t>(e.amount); };
+
+const bench::Options options {1, 5};
+
+// ns per event of f()
+template <typename F>
+std::int64_t run(const std::string& name, std::size_t n, bench::Perf_events& events, F f, std::int64_t expected = -1)
+{
+    std::int64_t sum {0};
+    const bench::Result result = bench::measure("withdrawals", name, n, options, events, [&sum, &f] {
+        sum = f();
+        bench::do_not_optimize(sum);
+    });
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << result.ns_per_element()
+        << (expected == -1 || sum == expected ? "" : "    WRONG") << std::endl;
+    return sum;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50'000'000;
+
+    std::vector<Event> events(n);
+    std::mt19937_64 gen {42};
+    for (Event& event : events)
+        event = Event {static_cast<std::int32_t>(gen() % 100), static_cast<std::int32_t>(gen() % 2001) - 1000};
+
+    bench::Perf_events counters;
+    std::cout << n << " events, ns per event" << std::endl;
+    const std::int64_t sum = run("copy_if, transform, accumulate", n, counters, [&events] {
+        std::vector<Event> withdrawals;
+        std::copy_if(events.begin(), events.end(), std::back_inserter(withdrawals), is_withdrawal);
+        std::vector<std::int64_t> amounts(withdrawals.size());
+        std::transform(withdrawals.begin(), withdrawals.end(), amounts.begin(), amount);
+        return std::accumulate(amounts.begin(), amounts.end(), std::int64_t {0});
+    });
+    run("loop", n, counters, [&events] {
+        std::int64_t sum {0};
+        for (const Event& e : events)
+            if (is_withdrawal(e))
+                sum += amount(e);
+        return sum;
+    }, sum);
+    run("pipeline", n, counters, [&events] {
+        return events | pipeline::filter(is_withdrawal) | pipeline::transform(amount) | pipeline::reduce(std::int64_t {0});
+    }, sum);
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        run("pipeline, par, " + std::to_string(threads) + " threads", n, counters, [&events, &pool] {
+            return events | pipeline::filter(is_withdrawal) | pipeline::transform(amount)
+                | pipeline::reduce(parallel::par.on(pool), std::int64_t {0});
+        }, sum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+#ifndef _RESERVOIR_H_
+#define _RESERVOIR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+/*
+
+    - a sampling::Reservoir keeps a sample of k of the items pushed into it, every one of
+      them with the same chance, without knowing how many there are going to be, the words of
+      a file, the events of the accounts, ..., like std::sample does for a range of a known
+      size. the sample is in no order, std::sample keeps the order of the range.
+
+    - it is Algorithm L: after the first k, it chooses how many of the next items are not
+      kept, a number of log(random) / log(1 - w), w goes down the more items there are, so
+      most of them are only counted, and the item after them replaces one of the sample at
+      random. to_skip() says how many are not kept, a stream can discard(n) them without
+      reading them, push of a range with random access iterators jumps over them.
+
+    - the same seed gives the same sample of the same items. a reservoir for every thread, or
+      every file, with its own seed, sees a part, and merge makes them one sample of all of
+      their items: every item of the sample is from the first one with the chance of how many
+      items it has seen, of the ones left, so an item of a reservoir that saw more is taken
+      more often. the merged one goes on sampling the items pushed after it.
+
+    - sampling::sample(policy, first, last, out, k, seed) samples a range with random access
+      iterators on the threads of a Work_stealing_pool, a reservoir for every chunk, merged in
+      the order of the chunks. the chunks depend on the size of the range, not on the
+      threads, so parallel::seq, par and par_unseq on any pool give the same sample.
+
+*/
+namespace sampling
+{
+    inline constexpr std::size_t max_chunks {64};
+
+    template<class T, class URBG = std::mt19937_64>
+    class Reservoir
+    {
+    private:
+        std::size_t capacity;
+        std::vector<T> items;
+        std::uint64_t num_seen {0};
+        // the index of the next item that is kept, once the sample is full
+        std::uint64_t next {0};
+        double w {0.0};
+        URBG gen;
+
+        // a random number in (0, 1)
+        double random()
+        {
+            double u {0.0};
+            while (u == 0.0)
+                u = std::generate_canonical<double, std::numeric_limits<double>::digits>(this->gen);
+            return u;
+        }
+
+        std::size_t random_index(std::size_t n)
+        {
+            return std::uniform_int_distribution<std::size_t> {0, n - 1}(this->gen);
+        }
+
+        void choose_next()
+        {
+            const double skip = std::floor(std::log(this->random()) / std::log1p(-this->w));
+            const double left = static_cast<double>(std::numeric_limits<std::uint64_t>::max() - this->num_seen);
+            this->next = skip < left ? this->num_seen + static_cast<std::uint64_t>(skip) : std::numeric_limits<std::uint64_t>::max();
+        }
+
+        // w of k items out of num_seen is the k-th smallest of num_seen random numbers, Beta(k, num_seen - k + 1)
+        void restart()
+        {
+            const double k = static_cast<double>(this->capacity);
+            const double x = std::gamma_distribution<double> {k}(this->gen);
+            const double y = std::gamma_distribution<double> {static_cast<double>(this->num_seen) - k + 1.0}(this->gen);
+            this->w = x / (x + y);
+            this->choose_next();
+        }
+
+    public:
+        Reservoir(std::size_t capacity, URBG gen) : capacity(capacity), gen(std::move(gen))
+        {
+            this->items.reserve(capacity);
+        }
+
+        Reservoir(std::size_t capacity, std::uint64_t seed) : Reservoir(capacity, URBG(seed)) {}
+
+        template<class U>
+        void push(U&& item)
+        {
+            if (this->items.size() < this->capacity)
+            {
+                this->items.emplace_back(std::forward<U>(item));
+                ++this->num_seen;
+                if (this->items.size() == this->capacity)
+                {
+                    this->w = std::exp(std::log(this->random()) / static_cast<double>(this->capacity));
+                    this->choose_next();
+                }
+                return;
+            }
+            if (this->capacity != 0 && this->num_seen == this->next)
+            {
+                this->items[this->random_index(this->capacity)] = std::forward<U>(item);
+                this->w *= std::exp(std::log(this->random()) / static_cast<double>(this->capacity));
+                ++this->num_seen;
+                this->choose_next();
+                return;
+            }
+            ++this->num_seen;
+        }
+
+        template<class InputIt>
+        void push(InputIt first, InputIt last)
+        {
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+            {
+                while (first != last)
+                {
+                    const std::uint64_t skip = std::min<std::uint64_t>(this->to_skip(), static_cast<std::uint64_t>(last - first));
+                    this->discard(skip);
+                    first += static_cast<typename std::iterator_traits<InputIt>::difference_type>(skip);
+                    if (first != last)
+                        this->push(*first++);
+                }
+            }
+            else
+                for (; first != last; ++first)
+                    this->push(*first);
+        }
+
+        // how many of the next items are not kept
+        std::uint64_t to_skip() const
+        {
+            if (this->items.size() < this->capacity)
+                return 0;
+            return this->capacity == 0 ? std::numeric_limits<std::uint64_t>::max() - this->num_seen : this->next - this->num_seen;
+        }
+
+        // counts n items that are not kept, at most to_skip()
+        void discard(std::uint64_t n)
+        {
+            this->num_seen += std::min(n, this->to_skip());
+        }
+
+        // the items of the other one, and the ones it has seen, the capacities are the same
+        void merge(Reservoir other)
+        {
+            if (other.capacity != this->capacity)
+                throw std::invalid_argument {"the reservoirs have different capacities"};
+            if (other.num_seen == 0)
+                return;
+
+            std::uint64_t a = this->num_seen;
+            std::uint64_t b = other.num_seen;
+            std::vector<T> from_a = std::move(this->items);
+            std::vector<T>& from_b = other.items;
+            this->items.clear();
+            this->items.reserve(this->capacity);
+            const std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(this->capacity, a + b));
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const bool first = std::uniform_int_distribution<std::uint64_t> {0, a + b - 1}(this->gen) < a;
+                std::vector<T>& from = first ? from_a : from_b;
+                (first ? a : b) -= 1;
+                std::swap(from[this->random_index(from.size())], from.back());
+                this->items.push_back(std::move(from.back()));
+                from.pop_back();
+            }
+
+            this->num_seen += other.num_seen;
+            if (this->capacity != 0 && this->items.size() == this->capacity)
+                this->restart();
+        }
+
+        const std::vector<T>& sample() const { return this->items; }
+        std::vector<T>& sample() { return this->items; }
+        std::uint64_t seen() const { return this->num_seen; }
+        std::size_t size() const { return this->capacity; }
+    };
+
+    template<class Policy, class RandomIt, class OutputIt>
+    OutputIt sample(Policy&& policy, RandomIt first, RandomIt last, OutputIt out, std::size_t k, std::uint64_t seed)
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        const std::size_t chunks = std::max<std::size_t>(1, std::min(n / parallel::min_chunk, max_chunks));
+
+        std::vector<Reservoir<T>> reservoirs;
+        reservoirs.reserve(chunks);
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            std::seed_seq seeds {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), static_cast<std::uint32_t>(chunk)};
+            reservoirs.emplace_back(k, std::mt19937_64 {seeds});
+        }
+
+        const auto push = [&](std::size_t chunk, std::size_t begin, std::size_t end)
+        {
+            reservoirs[chunk].push(first + begin, first + end);
+        };
+        if constexpr (parallel::detail::is_parallel<Policy, RandomIt>)
+            parallel::detail::for_chunks(parallel::detail::pool_of(policy), n, chunks, push);
+        else
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                push(chunk, n / chunks * chunk + std::min(chunk, n % chunks), n / chunks * (chunk + 1) + std::min(chunk + 1, n % chunks));
+
+        for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+            reservoirs[0].merge(std::move(reservoirs[chunk]));
+        return std::move(reservoirs[0].sample().begin(), reservoirs[0].sample().end(), out);
+    }
+}
+
+#endif
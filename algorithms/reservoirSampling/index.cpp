@@ -0,0 +1,93 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Reservoir.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+struct Event
+{
+    std::string account;
+    double amount;
+};
+
+std::ostream& operator<<(std::ostream& os, const Event& event)
+{
+    os << event.account << (event.amount < 0 ? " withdraw " : " deposit ") << (event.amount < 0 ? -event.amount : event.amount);
+    return os;
+}
+
+// the events of the accounts a thread handles, made up from the seed
+void make_events(sampling::Reservoir<Event>& events, const std::vector<std::string>& accounts, std::uint64_t seed)
+{
+    std::mt19937_64 gen {seed};
+    for (int i = 0; i < 1'000'000; ++i)
+    {
+        const std::string& account = accounts[gen() % accounts.size()];
+        const double amount = static_cast<double>(static_cast<int>(gen() % 2000) - 1000);
+        events.push(Event {account, amount});
+    }
+}
+
+int main()
+{
+    // 5 words of a file, read one at a time, twice with the same seed
+    for (int run = 0; run < 2; ++run)
+    {
+        std::ifstream in {"../../ioAndStream/challenge4/romeoAndJuliet.txt"};
+        if (!in)
+        {
+            std::cerr << "could not open romeoAndJuliet.txt" << std::endl;
+            return 1;
+        }
+        sampling::Reservoir<std::string> words {5, 2024};
+        std::string word;
+        while (in >> word)
+            words.push(std::move(word));
+        std::cout << "5 of the " << words.seen() << " words:";
+        for (const std::string& w : words.sample())
+            std::cout << ' ' << w;
+        std::cout << '\n';
+    }
+
+    // a reservoir for every thread, merged in the order of the threads
+    const std::vector<std::vector<std::string>> accounts {{"Larry", "Moe"}, {"Curly", "Shemp", "Joe"}};
+    std::vector<sampling::Reservoir<Event>> reservoirs;
+    for (std::size_t i = 0; i < accounts.size(); ++i)
+        reservoirs.emplace_back(4, 100 + i);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < accounts.size(); ++i)
+        threads.emplace_back(make_events, std::ref(reservoirs[i]), std::cref(accounts[i]), 7 * i);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    sampling::Reservoir<Event> events {std::move(reservoirs[0])};
+    events.merge(std::move(reservoirs[1]));
+    std::cout << "4 of the " << events.seen() << " events:\n";
+    for (const Event& event : events.sample())
+        std::cout << "  " << event << '\n';
+
+    // 10 of 100 million numbers, the same sample with seq and with par on any pool
+    std::vector<int> numbers(100'000'000);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    std::vector<int> seq(10), par(10);
+    Work_stealing_pool pool {3};
+    sampling::sample(parallel::seq, numbers.begin(), numbers.end(), seq.begin(), 10, 1);
+    sampling::sample(parallel::par.on(pool), numbers.begin(), numbers.end(), par.begin(), 10, 1);
+    for (int n : par)
+        std::cout << n << ' ';
+    std::cout << "\nthe same with seq: " << std::boolalpha << (seq == par) << '\n';
+
+    return 0;
+}
@@ -0,0 +1,576 @@
+#ifndef _SCAN_H_
+#define _SCAN_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - inclusive_scan, exclusive_scan and reduce with the signatures of the std ones of
+      <numeric>, the running totals of a range, and its total. a sum, std::plus, of a
+      contiguous range of integers of 4 or 8 bytes, int, std::int64_t, ..., adds up 8 or 4 of
+      them at a time: the prefix sums of a vector of them in log steps of shifts and adds, with
+      AVX2 or SSE2, plus the total of the vectors before it. the other ones run the std
+      algorithm.
+
+    - the overloads with an execution policy of ../parallelAlgorithms take two passes over
+      the chunks of the range on the threads of a Work_stealing_pool: the total of every
+      chunk, the scan of the totals, one after the other, and the scan of every chunk with
+      the total of the ones before it as its init. op has to be associative, the order of the
+      elements is kept, like for std::inclusive_scan with a policy.
+
+    - sum(first, last, summation) adds up floating point numbers, the result of a naive loop
+      depends on the order, and it loses the small ones next to a big total: Summation::kahan
+      carries the part lost by every add in a second number, and what that one loses in a
+      third, Klein's second order version of Neumaier's, correct to the last bits but 4 times
+      slower, and Summation::pairwise adds the two halves of the range, down to blocks of 256
+      that are added up in 8 totals, an error of O(log n) instead of O(n), and as fast as the
+      naive loop. both split the range at places that depend only on its size, so sum with any
+      policy, on any number of threads, gives the same number, to the last bit.
+      Summation::naive with a policy adds up the chunks of the threads.
+
+*/
+namespace scan
+{
+    enum class Summation { naive, kahan, pairwise };
+
+    inline constexpr std::size_t pairwise_block {256};
+    inline constexpr std::size_t kahan_block {1 << 16};
+
+    namespace detail
+    {
+        template<class P>
+        constexpr bool is_policy = std::is_same_v<std::decay_t<P>, parallel::Sequenced_policy>
+            || std::is_same_v<std::decay_t<P>, parallel::Parallel_policy>
+            || std::is_same_v<std::decay_t<P>, parallel::Parallel_unsequenced_policy>;
+
+        template<class It>
+        using Value_type = typename std::iterator_traits<It>::value_type;
+
+        template<class It, class = void>
+        struct Contiguous : std::false_type {};
+
+        template<class T>
+        struct Contiguous<T*> : std::true_type {};
+
+        template<class It>
+        struct Contiguous<It, std::enable_if_t<!std::is_pointer_v<It> && !std::is_same_v<Value_type<It>, bool>>>
+        {
+            using value_type = Value_type<It>;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>;
+        };
+
+        template<class Op, class T>
+        constexpr bool is_plus = std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>;
+
+        // a sum of integers that is added up a vector at a time, from in to out
+        template<class InputIt, class OutputIt, class Op, class T>
+        constexpr bool is_vectorized = Contiguous<InputIt>::value && Contiguous<OutputIt>::value
+            && std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8)
+            && std::is_same_v<Value_type<InputIt>, T> && std::is_same_v<Value_type<OutputIt>, T> && is_plus<Op, T>;
+
+        template<class It>
+        auto data(It it) { return std::addressof(*it); }
+
+        // op(a, b), a sum of integers wraps around, like the vectors do
+        template<class BinaryOp, class T, class U>
+        T combine(BinaryOp& op, const T& a, const U& b)
+        {
+            if constexpr (is_plus<BinaryOp, T> && std::is_integral_v<T> && std::is_integral_v<U> && !std::is_same_v<T, bool>)
+                return static_cast<T>(static_cast<std::make_unsigned_t<T>>(a) + static_cast<std::make_unsigned_t<T>>(static_cast<T>(b)));
+            else
+                return op(a, b);
+        }
+
+        // the prefix sums of data[0, n) plus carry to out, or the exclusive ones, returns the total
+        template<bool inclusive, class T>
+        T scan_plus(const T* data, std::size_t n, T* out, T carry)
+        {
+            using U = std::make_unsigned_t<T>;
+            std::size_t i {0};
+#if defined(__AVX2__)
+            __m256i total = sizeof(T) == 4 ? _mm256_set1_epi32(static_cast<int>(carry)) : _mm256_set1_epi64x(static_cast<long long>(carry));
+            for (; i + 32 / sizeof(T) <= n; i += 32 / sizeof(T))
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i x = v;
+                if constexpr (sizeof(T) == 4)
+                {
+                    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+                    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+                    // the last one of the low half to every one of the high half
+                    x = _mm256_add_epi32(x, _mm256_permute2x128_si256(_mm256_shuffle_epi32(x, 0xFF), x, 0x08));
+                    x = _mm256_add_epi32(x, total);
+                    total = _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+                    if constexpr (!inclusive)
+                        x = _mm256_sub_epi32(x, v);
+                }
+                else
+                {
+                    x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+                    x = _mm256_add_epi64(x, _mm256_permute2x128_si256(_mm256_unpackhi_epi64(x, x), x, 0x08));
+                    x = _mm256_add_epi64(x, total);
+                    total = _mm256_permute4x64_epi64(x, 0xFF);
+                    if constexpr (!inclusive)
+                        x = _mm256_sub_epi64(x, v);
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+            }
+            carry = static_cast<T>(sizeof(T) == 4 ? static_cast<T>(_mm256_extract_epi32(total, 0)) : static_cast<T>(_mm256_extract_epi64(total, 0)));
+#elif defined(__SSE2__)
+            __m128i total = sizeof(T) == 4 ? _mm_set1_epi32(static_cast<int>(carry)) : _mm_set1_epi64x(static_cast<long long>(carry));
+            for (; i + 16 / sizeof(T) <= n; i += 16 / sizeof(T))
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i x = v;
+                if constexpr (sizeof(T) == 4)
+                {
+                    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+                    x = _mm_add_epi32(x, total);
+                    total = _mm_shuffle_epi32(x, 0xFF);
+                    if constexpr (!inclusive)
+                        x = _mm_sub_epi32(x, v);
+                }
+                else
+                {
+                    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+                    x = _mm_add_epi64(x, total);
+                    total = _mm_unpackhi_epi64(x, x);
+                    if constexpr (!inclusive)
+                        x = _mm_sub_epi64(x, v);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+            }
+            if constexpr (sizeof(T) == 4)
+                carry = static_cast<T>(_mm_cvtsi128_si32(total));
+            else
+                carry = static_cast<T>(_mm_cvtsi128_si64(total));
+#endif
+            // the adds wrap around, like the ones of the vectors
+            for (; i < n; ++i)
+            {
+                const T value = data[i];
+                const T next = static_cast<T>(static_cast<U>(carry) + static_cast<U>(value));
+                out[i] = inclusive ? next : carry;
+                carry = next;
+            }
+            return carry;
+        }
+
+        template<class T>
+        T reduce_plus(const T* data, std::size_t n, T init)
+        {
+            using U = std::make_unsigned_t<T>;
+            // independent totals, that the compiler keeps in vectors
+            U totals[8] {};
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+                for (std::size_t j = 0; j < 8; ++j)
+                    totals[j] += static_cast<U>(data[i + j]);
+            U total = static_cast<U>(init);
+            for (; i < n; ++i)
+                total += static_cast<U>(data[i]);
+            for (U t : totals)
+                total += t;
+            return static_cast<T>(total);
+        }
+
+        inline std::size_t bounds(std::size_t n, std::size_t chunks, std::size_t chunk)
+        {
+            return n / chunks * chunk + std::min(chunk, n % chunks);
+        }
+
+        // the chunks of the passes, none with a policy without threads, or of a range without random access
+        template<class Policy, class... Its>
+        std::size_t chunks_of(const Policy& policy, std::size_t n)
+        {
+            if constexpr (parallel::detail::is_parallel<Policy, Its...>)
+                return parallel::detail::num_chunks(parallel::detail::pool_of(policy), n);
+            else
+                return 1;
+        }
+
+        template<class Policy, class F>
+        void for_chunks(const Policy& policy, std::size_t n, std::size_t chunks, const F& f)
+        {
+            if constexpr (parallel::detail::is_parallel<Policy, int*>)
+                parallel::detail::for_chunks(parallel::detail::pool_of(policy), n, chunks, f);
+            else
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                    f(chunk, bounds(n, chunks, chunk), bounds(n, chunks, chunk + 1));
+        }
+
+        template<class T, class RandomIt>
+        T pairwise_leaf(RandomIt first, std::size_t n)
+        {
+            T totals[8] {};
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+                for (std::size_t j = 0; j < 8; ++j)
+                    totals[j] += static_cast<T>(first[i + j]);
+            T tail {};
+            for (; i < n; ++i)
+                tail += static_cast<T>(first[i]);
+            return ((totals[0] + totals[1]) + (totals[2] + totals[3])) + ((totals[4] + totals[5]) + (totals[6] + totals[7])) + tail;
+        }
+
+        // where a part of the pairwise sum is split, a multiple of 8 so the leaves have no tail but the last
+        inline std::size_t pairwise_split(std::size_t n)
+        {
+            return n / 2 / 8 * 8;
+        }
+
+        // the parts of [offset, offset + n) at the given depth of the tree of the pairwise sum
+        inline void pairwise_leaves(std::size_t offset, std::size_t n, std::size_t depth, std::vector<std::pair<std::size_t, std::size_t>>& leaves)
+        {
+            if (n <= pairwise_block || depth == 0)
+            {
+                leaves.emplace_back(offset, n);
+                return;
+            }
+            const std::size_t m = pairwise_split(n);
+            pairwise_leaves(offset, m, depth - 1, leaves);
+            pairwise_leaves(offset + m, n - m, depth - 1, leaves);
+        }
+
+        template<class T, class RandomIt>
+        T pairwise(RandomIt first, std::size_t n)
+        {
+            if (n <= pairwise_block)
+                return pairwise_leaf<T>(first, n);
+            const std::size_t m = pairwise_split(n);
+            const T left = pairwise<T>(first, m);
+            const T right = pairwise<T>(first + static_cast<std::ptrdiff_t>(m), n - m);
+            return left + right;
+        }
+
+        // the sums of the leaves put together as pairwise puts together its halves
+        template<class T>
+        T pairwise_combine(std::size_t n, std::size_t depth, const T*& sums)
+        {
+            if (n <= pairwise_block || depth == 0)
+                return *sums++;
+            const std::size_t m = pairwise_split(n);
+            const T left = pairwise_combine<T>(m, depth - 1, sums);
+            const T right = pairwise_combine<T>(n - m, depth - 1, sums);
+            return left + right;
+        }
+
+        // what a + b loses to rounding, a + b - (a + b), exact
+        template<class T>
+        T lost(T a, T b, T sum)
+        {
+            return std::abs(a) >= std::abs(b) ? (a - sum) + b : (b - sum) + a;
+        }
+
+        template<class T>
+        struct Kahan
+        {
+            T sum {};
+            // what the adds to sum lost, and what the adds to it lost, a long range of small
+            // numbers has a compensation big enough to lose some of its own
+            T compensation {};
+            T second {};
+
+            void add(T value)
+            {
+                const T s = this->sum + value;
+                const T lost = detail::lost(this->sum, value, s);
+                this->sum = s;
+                const T c = this->compensation + lost;
+                this->second += detail::lost(this->compensation, lost, c);
+                this->compensation = c;
+            }
+
+            T result() const { return this->sum + (this->compensation + this->second); }
+        };
+
+        template<class T, class RandomIt>
+        Kahan<T> kahan(RandomIt first, std::size_t n)
+        {
+            Kahan<T> k;
+            for (std::size_t i = 0; i < n; ++i)
+                k.add(static_cast<T>(first[i]));
+            return k;
+        }
+    }
+
+    template<class InputIt, class OutputIt, class BinaryOp, class T, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op, T init)
+    {
+        if constexpr (detail::is_vectorized<InputIt, OutputIt, BinaryOp, T>)
+        {
+            const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            if (n != 0)
+                detail::scan_plus<true>(detail::data(first), n, detail::data(d_first), init);
+            return d_first + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+            return std::inclusive_scan(first, last, d_first, op, std::move(init));
+    }
+
+    template<class InputIt, class OutputIt, class BinaryOp, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op)
+    {
+        using T = detail::Value_type<InputIt>;
+        if constexpr (detail::is_vectorized<InputIt, OutputIt, BinaryOp, T>)
+            return scan::inclusive_scan(first, last, d_first, op, T {0});
+        else
+            return std::inclusive_scan(first, last, d_first, op);
+    }
+
+    template<class InputIt, class OutputIt, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first)
+    {
+        return scan::inclusive_scan(first, last, d_first, std::plus<> {});
+    }
+
+    template<class InputIt, class OutputIt, class T, class BinaryOp, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init, BinaryOp op)
+    {
+        if constexpr (detail::is_vectorized<InputIt, OutputIt, BinaryOp, T>)
+        {
+            const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            if (n != 0)
+                detail::scan_plus<false>(detail::data(first), n, detail::data(d_first), init);
+            return d_first + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+            return std::exclusive_scan(first, last, d_first, std::move(init), op);
+    }
+
+    template<class InputIt, class OutputIt, class T, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init)
+    {
+        return scan::exclusive_scan(first, last, d_first, std::move(init), std::plus<> {});
+    }
+
+    template<class InputIt, class T, class BinaryOp, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    T reduce(InputIt first, InputIt last, T init, BinaryOp op)
+    {
+        if constexpr (detail::is_vectorized<InputIt, InputIt, BinaryOp, T>)
+        {
+            const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            return n == 0 ? init : detail::reduce_plus(detail::data(first), n, init);
+        }
+        else
+            return std::reduce(first, last, std::move(init), op);
+    }
+
+    template<class InputIt, class T, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    T reduce(InputIt first, InputIt last, T init)
+    {
+        return scan::reduce(first, last, std::move(init), std::plus<> {});
+    }
+
+    template<class InputIt, std::enable_if_t<!detail::is_policy<InputIt>, int> = 0>
+    detail::Value_type<InputIt> reduce(InputIt first, InputIt last)
+    {
+        return scan::reduce(first, last, detail::Value_type<InputIt> {});
+    }
+
+    namespace detail
+    {
+        // the totals of the chunks, their scan from init, then every chunk scanned from the total of
+        // the ones before it, init is null for an inclusive scan without one
+        template<bool inclusive, class Policy, class RandomIt1, class RandomIt2, class T, class BinaryOp>
+        RandomIt2 scan(const Policy& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, const T* init, BinaryOp op, std::size_t chunks)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            const auto at = [](std::size_t i) { return static_cast<std::ptrdiff_t>(i); };
+            std::vector<T> totals(chunks);
+            detail::for_chunks(policy, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                if (chunk + 1 < chunks)
+                    totals[chunk] = scan::reduce(first + at(begin + 1), first + at(end), static_cast<T>(first[at(begin)]), op);
+            });
+            // the total before every chunk, the last one is not needed
+            for (std::size_t chunk = chunks - 1; chunk > 0; --chunk)
+                totals[chunk] = std::move(totals[chunk - 1]);
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+                totals[chunk] = chunk == 1 ? (init == nullptr ? totals[1] : detail::combine(op, *init, totals[1])) : detail::combine(op, totals[chunk - 1], totals[chunk]);
+
+            detail::for_chunks(policy, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                if constexpr (inclusive)
+                {
+                    if (chunk == 0 && init == nullptr)
+                        scan::inclusive_scan(first + at(begin), first + at(end), d_first + at(begin), op);
+                    else
+                        scan::inclusive_scan(first + at(begin), first + at(end), d_first + at(begin), op, chunk == 0 ? *init : totals[chunk]);
+                }
+                else
+                    scan::exclusive_scan(first + at(begin), first + at(end), d_first + at(begin), chunk == 0 ? *init : totals[chunk], op);
+            });
+            return d_first + at(n);
+        }
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class BinaryOp, class T, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 inclusive_scan(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, BinaryOp op, T init)
+    {
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt1, RandomIt2>)
+            return scan::inclusive_scan(first, last, d_first, op, std::move(init));
+        else
+        {
+            const std::size_t chunks = detail::chunks_of<Policy, RandomIt1, RandomIt2>(policy, static_cast<std::size_t>(last - first));
+            if (chunks == 1)
+                return scan::inclusive_scan(first, last, d_first, op, std::move(init));
+            return detail::scan<true>(policy, first, last, d_first, &init, op, chunks);
+        }
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class BinaryOp, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 inclusive_scan(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, BinaryOp op)
+    {
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt1, RandomIt2>)
+            return scan::inclusive_scan(first, last, d_first, op);
+        else
+        {
+            const std::size_t chunks = detail::chunks_of<Policy, RandomIt1, RandomIt2>(policy, static_cast<std::size_t>(last - first));
+            if (chunks == 1)
+                return scan::inclusive_scan(first, last, d_first, op);
+            return detail::scan<true>(policy, first, last, d_first, static_cast<const detail::Value_type<RandomIt1>*>(nullptr), op, chunks);
+        }
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 inclusive_scan(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first)
+    {
+        return scan::inclusive_scan(policy, first, last, d_first, std::plus<> {});
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class T, class BinaryOp, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 exclusive_scan(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, T init, BinaryOp op)
+    {
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt1, RandomIt2>)
+            return scan::exclusive_scan(first, last, d_first, std::move(init), op);
+        else
+        {
+            const std::size_t chunks = detail::chunks_of<Policy, RandomIt1, RandomIt2>(policy, static_cast<std::size_t>(last - first));
+            if (chunks == 1)
+                return scan::exclusive_scan(first, last, d_first, std::move(init), op);
+            return detail::scan<false>(policy, first, last, d_first, &init, op, chunks);
+        }
+    }
+
+    template<class Policy, class RandomIt1, class RandomIt2, class T, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    RandomIt2 exclusive_scan(Policy&& policy, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, T init)
+    {
+        return scan::exclusive_scan(policy, first, last, d_first, std::move(init), std::plus<> {});
+    }
+
+    // op is associative and commutative, the totals of the chunks are added up from init in order
+    template<class Policy, class RandomIt, class T, class BinaryOp, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    T reduce(Policy&& policy, RandomIt first, RandomIt last, T init, BinaryOp op)
+    {
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt>)
+            return scan::reduce(first, last, std::move(init), op);
+        else
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            const std::size_t chunks = detail::chunks_of<Policy, RandomIt>(policy, n);
+            if (chunks == 1)
+                return scan::reduce(first, last, std::move(init), op);
+            std::vector<T> totals(chunks, init);
+            detail::for_chunks(policy, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                totals[chunk] = scan::reduce(first + static_cast<std::ptrdiff_t>(begin + 1), first + static_cast<std::ptrdiff_t>(end),
+                                             static_cast<T>(first[static_cast<std::ptrdiff_t>(begin)]), op);
+            });
+            for (T& total : totals)
+                init = detail::combine(op, init, total);
+            return init;
+        }
+    }
+
+    template<class Policy, class RandomIt, class T, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    T reduce(Policy&& policy, RandomIt first, RandomIt last, T init)
+    {
+        return scan::reduce(policy, first, last, std::move(init), std::plus<> {});
+    }
+
+    template<class Policy, class RandomIt, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    detail::Value_type<RandomIt> reduce(Policy&& policy, RandomIt first, RandomIt last)
+    {
+        return scan::reduce(policy, first, last, detail::Value_type<RandomIt> {});
+    }
+
+    // the sum of the floating point numbers, or of the integers, that are exact with any summation
+    template<class Policy, class RandomIt, std::enable_if_t<detail::is_policy<Policy>, int> = 0>
+    detail::Value_type<RandomIt> sum(Policy&& policy, RandomIt first, RandomIt last, Summation summation = Summation::pairwise)
+    {
+        using T = detail::Value_type<RandomIt>;
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (!std::is_floating_point_v<T> || summation == Summation::naive)
+            return scan::reduce(policy, first, last, T {});
+
+        if (summation == Summation::kahan)
+        {
+            // blocks of the same size whatever the threads, put together in order
+            const std::size_t blocks = std::max<std::size_t>(1, (n + kahan_block - 1) / kahan_block);
+            std::vector<detail::Kahan<T>> partials(blocks);
+            const auto add = [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                for (std::size_t block = begin; block < end; ++block)
+                {
+                    const std::size_t offset = block * kahan_block;
+                    partials[block] = detail::kahan<T>(first + static_cast<std::ptrdiff_t>(offset), std::min(kahan_block, n - std::min(n, offset)));
+                }
+            };
+            detail::for_chunks(policy, blocks, std::min(blocks, detail::chunks_of<Policy, RandomIt>(policy, n)), add);
+            detail::Kahan<T> total;
+            for (const detail::Kahan<T>& partial : partials)
+            {
+                total.add(partial.sum);
+                total.add(partial.compensation);
+                total.add(partial.second);
+            }
+            return total.result();
+        }
+
+        // the leaves of the tree of the sum on the threads, put together as its halves are
+        const std::size_t chunks = detail::chunks_of<Policy, RandomIt>(policy, n);
+        if (chunks == 1)
+            return detail::pairwise<T>(first, n);
+        std::size_t depth {0};
+        while ((std::size_t {1} << depth) < chunks)
+            ++depth;
+        std::vector<std::pair<std::size_t, std::size_t>> leaves;
+        detail::pairwise_leaves(0, n, depth, leaves);
+        std::vector<T> sums(leaves.size());
+        detail::for_chunks(policy, leaves.size(), leaves.size(), [&](std::size_t leaf, std::size_t, std::size_t)
+        {
+            sums[leaf] = detail::pairwise<T>(first + static_cast<std::ptrdiff_t>(leaves[leaf].first), leaves[leaf].second);
+        });
+        const T* next = sums.data();
+        return detail::pairwise_combine<T>(n, depth, next);
+    }
+
+    template<class RandomIt, std::enable_if_t<!detail::is_policy<RandomIt>, int> = 0>
+    detail::Value_type<RandomIt> sum(RandomIt first, RandomIt last, Summation summation = Summation::pairwise)
+    {
+        return scan::sum(parallel::seq, first, last, summation);
+    }
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "Scan.h"
+
+int main()
+{
+    // the balance after every transaction of an account, and where it started before each one
+    const std::vector<std::int64_t> amounts {10'000, -2'500, 4'000, -12'000, 700};
+    std::vector<std::int64_t> after(amounts.size());
+    std::vector<std::int64_t> before(amounts.size());
+    scan::inclusive_scan(amounts.begin(), amounts.end(), after.begin(), std::plus<> {}, std::int64_t {1'000});
+    scan::exclusive_scan(amounts.begin(), amounts.end(), before.begin(), std::int64_t {1'000});
+    for (std::size_t i = 0; i < amounts.size(); ++i)
+        std::cout << std::setw(8) << before[i] << " + " << std::setw(7) << amounts[i] << " = " << after[i] << std::endl;
+
+    // the average of the scores of a quiz
+    const std::vector<int> scores {5, 3, 4, 5, 2, 4};
+    std::cout << "average score: " << static_cast<double>(scan::reduce(scores.begin(), scores.end())) / scores.size() << std::endl;
+
+    // 0.1 ten million times, the naive loop drifts away from 1e6
+    std::vector<float> tenths(10'000'000, 0.1f);
+    std::cout << std::setprecision(10)
+              << "naive:    " << scan::sum(tenths.begin(), tenths.end(), scan::Summation::naive) << std::endl
+              << "kahan:    " << scan::sum(tenths.begin(), tenths.end(), scan::Summation::kahan) << std::endl
+              << "pairwise: " << scan::sum(tenths.begin(), tenths.end()) << std::endl;
+
+    // the running totals of 100 million numbers on the threads, the same as the sequential ones
+    std::vector<std::int64_t> numbers(100'000'000, 1);
+    scan::inclusive_scan(parallel::par, numbers.begin(), numbers.end(), numbers.begin());
+    std::cout << "last running total: " << numbers.back()
+              << ", pairwise sum with par: " << scan::sum(parallel::par, tenths.begin(), tenths.end()) << std::endl;
+}
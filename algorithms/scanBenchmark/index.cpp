@@ -0,0 +1,137 @@
+/*
+
+    - compares std::inclusive_scan, std::exclusive_scan and std::accumulate of 32 and 64 bit
+      numbers against the ones of ../scan/Scan.h, sequential and with par on pools of 1, 2,
+      4, ... threads, up to twice the cores, and the naive, kahan and pairwise sums of floats,
+      with how far each one is from the exact sum, and checks that they give the same
+      results. the times are the medians of ../benchmarkHarness/Benchmark_harness.h, a warm
+      up and 5 runs.
+
+    - build it with:
+        g++ -std=c++17 -O2 -march=native -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 50'000'000 numbers by default, the number can be given on the command line, e.g.
+      ./a.out 10000000
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+#include "../scan/Scan.h"
+
+const bench::Options options {1, 5};
+
+// ns per number of f(), then whether check() finds its result the expected one, not timed
+template <typename F, typename Check>
+void run(const std::string& name, std::size_t n, F f, Check check)
+{
+    static bench::Perf_events events;
+    const bench::Result result = bench::measure("scan", name, n, options, events, f);
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << result.ns_per_element()
+        << (check() ? "" : "    WRONG") << std::endl;
+}
+
+template <typename F>
+void run(const std::string& name, std::size_t n, F f)
+{
+    run(name, n, f, [] { return true; });
+}
+
+template <typename T>
+void compare(const std::string& type, const std::vector<T>& numbers)
+{
+    const std::size_t n = numbers.size();
+    std::vector<T> expected(n);
+    std::vector<T> out(n);
+    std::inclusive_scan(numbers.begin(), numbers.end(), expected.begin());
+    const T total = std::accumulate(numbers.begin(), numbers.end(), T {0});
+
+    std::cout << type << ", ns per number" << std::endl;
+    T result {0};
+    const auto same = [&] { return out == expected; };
+    const auto shifted = [&] { return std::equal(out.begin() + 1, out.end(), expected.begin()); };
+    const auto right = [&] { return result == total; };
+    run("std::inclusive_scan", n, [&] { std::inclusive_scan(numbers.begin(), numbers.end(), out.begin()); });
+    run("scan::inclusive_scan", n, [&] { scan::inclusive_scan(numbers.begin(), numbers.end(), out.begin()); }, same);
+    run("std::exclusive_scan", n, [&] { std::exclusive_scan(numbers.begin(), numbers.end(), out.begin(), T {0}); });
+    run("scan::exclusive_scan", n, [&] { scan::exclusive_scan(numbers.begin(), numbers.end(), out.begin(), T {0}); }, shifted);
+    run("std::accumulate", n, [&] { result = std::accumulate(numbers.begin(), numbers.end(), T {0}); });
+    run("scan::reduce", n, [&] { result = scan::reduce(numbers.begin(), numbers.end()); }, right);
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        const auto par = parallel::par.on(pool);
+        run("inclusive_scan, par, " + std::to_string(threads) + " threads", n, [&] {
+            scan::inclusive_scan(par, numbers.begin(), numbers.end(), out.begin());
+        }, same);
+        run("reduce, par, " + std::to_string(threads) + " threads", n, [&] { result = scan::reduce(par, numbers.begin(), numbers.end()); }, right);
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50'000'000;
+
+    // small enough that the sums of 32 bits do not overflow
+    std::mt19937_64 gen {42};
+    std::vector<std::int32_t> ints(n);
+    for (std::int32_t& x : ints)
+        x = static_cast<std::int32_t>(gen() % 201) - 100;
+    std::vector<std::int64_t> longs(n);
+    for (std::int64_t& x : longs)
+        x = static_cast<std::int64_t>(gen() % 2'000'001) - 1'000'000;
+    compare("int32", ints);
+    compare("int64", longs);
+
+    // the error of every sum of floats to the sum of the same numbers as doubles, as good as exact for them
+    std::uniform_real_distribution<float> dist {0.0f, 1.0f};
+    std::vector<float> floats(n);
+    for (float& x : floats)
+        x = dist(gen);
+    double exact {0};
+    for (float x : floats)
+        exact += x;
+    std::cout << "float sums, ns per number, relative error" << std::endl;
+    const auto sum = [&](const std::string& name, auto f) {
+        float result {0};
+        run(name, n, [&] { result = f(); });
+        std::cout << std::setw(46) << "" << std::scientific << std::setprecision(2) << std::abs(result - exact) / exact << std::endl;
+        return result;
+    };
+    sum("std::accumulate", [&] { return std::accumulate(floats.begin(), floats.end(), 0.0f); });
+    sum("scan::sum, naive", [&] { return scan::sum(floats.begin(), floats.end(), scan::Summation::naive); });
+    const float kahan = sum("scan::sum, kahan", [&] { return scan::sum(floats.begin(), floats.end(), scan::Summation::kahan); });
+    const float pairwise = sum("scan::sum, pairwise", [&] { return scan::sum(floats.begin(), floats.end()); });
+
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        const auto par = parallel::par.on(pool);
+        float result {0};
+        // the same bits as the sequential ones, whatever the threads
+        run("kahan, par, " + std::to_string(threads) + " threads", n, [&] {
+            result = scan::sum(par, floats.begin(), floats.end(), scan::Summation::kahan);
+        }, [&] { return result == kahan; });
+        run("pairwise, par, " + std::to_string(threads) + " threads", n, [&] {
+            result = scan::sum(par, floats.begin(), floats.end());
+        }, [&] { return result == pairwise; });
+    }
+
+    return 0;
+}
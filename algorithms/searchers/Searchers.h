@@ -0,0 +1,478 @@
+#ifndef _SEARCHERS_H_
+#define _SEARCHERS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - searchers like the ones of <functional>, made once from a pattern and used for any number
+      of ranges, with std::search(first, last, searcher) or by calling them, that copy the
+      pattern, so it does not have to live as long as they do:
+
+        Horspool_searcher, Boyer-Moore-Horspool: the element of the range under the last one of
+        the pattern says how far the pattern can move, its length when the element is not in
+        it, so a long pattern looks at a small part of the range, and at n * m elements at
+        worst, aaa...a for ba...a.
+
+        Two_way_searcher, Crochemore-Perrin: the pattern is cut where the right part is the
+        greatest of its suffixes, it is compared right part first then left part, and moved
+        by what was matched, or by its period, at most 2 * n comparisons, with the ordering
+        < of the elements and no table.
+
+        Short_needle_searcher, for the patterns of bytes, char, unsigned char, ..., of a few
+        of them: with SSE2 the first and the last byte of the pattern are compared with 16
+        positions of the range at a time, and only the positions where both are equal
+        compare the bytes in between. the range is a pointer or an iterator of a std::string
+        or a std::vector, the other ones run std::search.
+
+    - Reverse_searcher<Searcher> finds the last match with a searcher of the reversed pattern
+      that runs backwards on the range, it is the searcher of find_end.
+
+    - search, find_end and search_n with the signatures of the std ones choose for the random
+      access ranges: the short needle one for a pattern of up to 64 bytes, Horspool for a
+      longer one, Two-Way for the elements with a < and std::search for the other ones.
+      search_n looks at the element count - 1 after the start, and when it is not the value
+      no match starts before it, so it moves by count elements, a run of the value is matched
+      backwards from there and forwards until it is long enough.
+
+*/
+namespace searchers
+{
+    namespace detail
+    {
+        template<class T>
+        constexpr bool is_byte = std::is_integral_v<T> && sizeof(T) == 1 && !std::is_same_v<T, bool>;
+
+        template<class T, class = void>
+        struct Has_less : std::false_type {};
+
+        template<class T>
+        struct Has_less<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>> : std::true_type {};
+
+        template<class It>
+        constexpr bool is_random_access = std::is_base_of_v<std::random_access_iterator_tag,
+            typename std::iterator_traits<It>::iterator_category>;
+
+        template<class It>
+        using Value_type = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+
+        template<class It, class = void>
+        struct Contiguous_bytes : std::false_type {};
+
+        template<class T>
+        struct Contiguous_bytes<T*> : std::bool_constant<is_byte<std::remove_cv_t<T>>> {};
+
+        template<class It>
+        struct Contiguous_bytes<It, std::enable_if_t<!std::is_pointer_v<It> && is_byte<Value_type<It>>>>
+        {
+            using value_type = Value_type<It>;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>
+                || (std::is_same_v<value_type, char> && (std::is_same_v<It, std::string::iterator>
+                    || std::is_same_v<It, std::string::const_iterator>));
+        };
+
+        // the skip of Horspool, a table for the bytes and a hash table for the other types
+        template<class T, bool = is_byte<T>>
+        class Skip_table
+        {
+        private:
+            std::unordered_map<T, std::ptrdiff_t> skips;
+            std::ptrdiff_t length;
+
+        public:
+            Skip_table(const std::vector<T>& pattern)
+                : length(static_cast<std::ptrdiff_t>(pattern.size()))
+            {
+                for (std::ptrdiff_t i = 0; i + 1 < this->length; ++i)
+                    this->skips[pattern[i]] = this->length - 1 - i;
+            }
+
+            template<class U>
+            std::ptrdiff_t operator[](const U& value) const
+            {
+                auto it = this->skips.find(value);
+                return it == this->skips.end() ? this->length : it->second;
+            }
+        };
+
+        template<class T>
+        class Skip_table<T, true>
+        {
+        private:
+            std::array<std::ptrdiff_t, 256> skips;
+
+        public:
+            Skip_table(const std::vector<T>& pattern)
+            {
+                const std::ptrdiff_t length = static_cast<std::ptrdiff_t>(pattern.size());
+                this->skips.fill(length);
+                for (std::ptrdiff_t i = 0; i + 1 < length; ++i)
+                    this->skips[static_cast<unsigned char>(pattern[i])] = length - 1 - i;
+            }
+
+            template<class U>
+            std::ptrdiff_t operator[](const U& value) const
+            {
+                return this->skips[static_cast<unsigned char>(value)];
+            }
+        };
+    }
+
+    template<class T>
+    class Horspool_searcher
+    {
+    private:
+        std::vector<T> pattern;
+        detail::Skip_table<T> skips;
+
+    public:
+        template<class RandomIt>
+        Horspool_searcher(RandomIt first, RandomIt last)
+            : pattern(first, last), skips(this->pattern) {}
+
+        template<class RandomIt>
+        std::pair<RandomIt, RandomIt> operator()(RandomIt first, RandomIt last) const
+        {
+            const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(this->pattern.size());
+            const std::ptrdiff_t n = last - first;
+            if (m == 0)
+                return {first, first};
+            const T& back = this->pattern.back();
+            for (std::ptrdiff_t j = 0; j <= n - m;)
+            {
+                const auto& under = first[j + m - 1];
+                if (under == back && std::equal(this->pattern.begin(), this->pattern.end() - 1, first + j))
+                    return {first + j, first + j + m};
+                j += this->skips[under];
+            }
+            return {last, last};
+        }
+    };
+
+    template<class RandomIt>
+    Horspool_searcher(RandomIt, RandomIt) -> Horspool_searcher<detail::Value_type<RandomIt>>;
+
+    template<class T>
+    class Two_way_searcher
+    {
+        static_assert(detail::Has_less<T>::value, "Two-Way orders the elements with <");
+
+    private:
+        std::vector<T> pattern;
+        std::ptrdiff_t cut;     // the last element of the left part, -1 when it is empty
+        std::ptrdiff_t period;
+        bool periodic;          // the left part is a suffix of the first period of the right one
+
+        // the start - 1 of the greatest suffix for <, or for > when reversed, and its period
+        std::pair<std::ptrdiff_t, std::ptrdiff_t> maximal_suffix(bool reversed) const
+        {
+            const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(this->pattern.size());
+            std::ptrdiff_t suffix = -1;
+            std::ptrdiff_t j = 0;
+            std::ptrdiff_t k = 1;
+            std::ptrdiff_t p = 1;
+            while (j + k < m)
+            {
+                const T& a = this->pattern[j + k];
+                const T& b = this->pattern[suffix + k];
+                if (reversed ? b < a : a < b)
+                {
+                    j += k;
+                    k = 1;
+                    p = j - suffix;
+                }
+                else if (a == b)
+                {
+                    if (k != p)
+                        ++k;
+                    else
+                    {
+                        j += p;
+                        k = 1;
+                    }
+                }
+                else
+                {
+                    suffix = j++;
+                    k = p = 1;
+                }
+            }
+            return {suffix, p};
+        }
+
+    public:
+        template<class RandomIt>
+        Two_way_searcher(RandomIt first, RandomIt last)
+            : pattern(first, last), cut(-1), period(1), periodic(false)
+        {
+            const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(this->pattern.size());
+            if (m == 0)
+                return;
+            const auto [less_suffix, less_period] = this->maximal_suffix(false);
+            const auto [greater_suffix, greater_period] = this->maximal_suffix(true);
+            if (less_suffix > greater_suffix)
+            {
+                this->cut = less_suffix;
+                this->period = less_period;
+            }
+            else
+            {
+                this->cut = greater_suffix;
+                this->period = greater_period;
+            }
+            this->periodic = this->period + this->cut + 1 <= m
+                && std::equal(this->pattern.begin(), this->pattern.begin() + this->cut + 1, this->pattern.begin() + this->period);
+            if (!this->periodic)
+                this->period = std::max(this->cut + 1, m - this->cut - 1) + 1;
+        }
+
+        template<class RandomIt>
+        std::pair<RandomIt, RandomIt> operator()(RandomIt first, RandomIt last) const
+        {
+            const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(this->pattern.size());
+            const std::ptrdiff_t n = last - first;
+            if (m == 0)
+                return {first, first};
+            // the elements of the pattern up to memory are known to match, after a periodic move
+            std::ptrdiff_t memory = -1;
+            for (std::ptrdiff_t j = 0; j <= n - m;)
+            {
+                // with nothing known the first element compared moves the pattern by 1 when it
+                // differs, std::find moves it to the next one that is equal
+                if (memory == -1 && this->cut + 1 < m)
+                {
+                    const T& next = this->pattern[this->cut + 1];
+                    j = std::find(first + j + this->cut + 1, first + (n - m + this->cut + 2), next) - first - this->cut - 1;
+                    if (j > n - m)
+                        break;
+                }
+                std::ptrdiff_t i = std::max(this->cut, memory) + 1;
+                while (i < m && this->pattern[i] == first[i + j])
+                    ++i;
+                if (i < m)
+                {
+                    j += i - this->cut;
+                    memory = -1;
+                    continue;
+                }
+                i = this->cut;
+                while (i > memory && this->pattern[i] == first[i + j])
+                    --i;
+                if (i <= memory)
+                    return {first + j, first + j + m};
+                j += this->period;
+                memory = this->periodic ? m - this->period - 1 : -1;
+            }
+            return {last, last};
+        }
+    };
+
+    template<class RandomIt>
+    Two_way_searcher(RandomIt, RandomIt) -> Two_way_searcher<detail::Value_type<RandomIt>>;
+
+    template<class T>
+    class Short_needle_searcher
+    {
+        static_assert(detail::is_byte<T>, "the short needles are bytes");
+
+    private:
+        std::vector<T> pattern;
+
+    public:
+        template<class RandomIt>
+        Short_needle_searcher(RandomIt first, RandomIt last)
+            : pattern(first, last) {}
+
+        template<class RandomIt>
+        std::pair<RandomIt, RandomIt> operator()(RandomIt first, RandomIt last) const
+        {
+            const std::size_t m = this->pattern.size();
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if constexpr (!detail::Contiguous_bytes<RandomIt>::value)
+            {
+                RandomIt it = std::search(first, last, this->pattern.begin(), this->pattern.end());
+                return {it, it == last ? last : it + m};
+            }
+            else
+            {
+                if (m == 0)
+                    return {first, first};
+                if (n < m)
+                    return {last, last};
+                const unsigned char* s = reinterpret_cast<const unsigned char*>(std::addressof(*first));
+                const unsigned char* p = reinterpret_cast<const unsigned char*>(this->pattern.data());
+                std::size_t i = 0;
+#if defined(__SSE2__)
+                const __m128i front = _mm_set1_epi8(static_cast<char>(p[0]));
+                const __m128i back = _mm_set1_epi8(static_cast<char>(p[m - 1]));
+                for (; i + m - 1 + 16 <= n; i += 16)
+                {
+                    const __m128i fronts = _mm_cmpeq_epi8(front, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+                    const __m128i backs = _mm_cmpeq_epi8(back, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1)));
+                    for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(fronts, backs))); mask != 0; mask &= mask - 1)
+                    {
+                        const std::size_t at = i + static_cast<std::size_t>(__builtin_ctz(mask));
+                        if (m <= 2 || std::memcmp(s + at + 1, p + 1, m - 2) == 0)
+                            return {first + at, first + at + m};
+                    }
+                }
+#endif
+                // memchr finds the next first byte of the pattern in what is left
+                while (i + m <= n)
+                {
+                    const void* found = std::memchr(s + i, p[0], n - m + 1 - i);
+                    if (found == nullptr)
+                        break;
+                    i = static_cast<std::size_t>(static_cast<const unsigned char*>(found) - s);
+                    if (std::memcmp(s + i + 1, p + 1, m - 1) == 0)
+                        return {first + i, first + i + m};
+                    ++i;
+                }
+                return {last, last};
+            }
+        }
+    };
+
+    template<class RandomIt>
+    Short_needle_searcher(RandomIt, RandomIt) -> Short_needle_searcher<detail::Value_type<RandomIt>>;
+
+    template<class Searcher>
+    class Reverse_searcher
+    {
+    private:
+        Searcher searcher;
+
+    public:
+        template<class RandomIt>
+        Reverse_searcher(RandomIt first, RandomIt last)
+            : searcher(std::make_reverse_iterator(last), std::make_reverse_iterator(first)) {}
+
+        // the last match, the end of the range when there is none
+        template<class RandomIt>
+        std::pair<RandomIt, RandomIt> operator()(RandomIt first, RandomIt last) const
+        {
+            const auto [begin, end] = this->searcher(std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+            if (begin == std::make_reverse_iterator(first))
+                return {last, last};
+            return {end.base(), begin.base()};
+        }
+    };
+
+    template<class ForwardIt1, class ForwardIt2>
+    ForwardIt1 search(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last)
+    {
+        using T = detail::Value_type<ForwardIt1>;
+        if constexpr (detail::is_random_access<ForwardIt1> && std::is_same_v<T, detail::Value_type<ForwardIt2>>)
+        {
+            const std::vector<T> pattern(s_first, s_last);
+            if constexpr (detail::is_byte<T>)
+            {
+                if (pattern.size() <= 64)
+                    return Short_needle_searcher<T>(pattern.begin(), pattern.end())(first, last).first;
+                return Horspool_searcher<T>(pattern.begin(), pattern.end())(first, last).first;
+            }
+            else if constexpr (detail::Has_less<T>::value)
+                return Two_way_searcher<T>(pattern.begin(), pattern.end())(first, last).first;
+            else
+                return std::search(first, last, pattern.begin(), pattern.end());
+        }
+        else
+            return std::search(first, last, s_first, s_last);
+    }
+
+    template<class ForwardIt, class Searcher>
+    ForwardIt search(ForwardIt first, ForwardIt last, const Searcher& searcher)
+    {
+        return searcher(first, last).first;
+    }
+
+    template<class ForwardIt1, class ForwardIt2>
+    ForwardIt1 find_end(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last)
+    {
+        using T = detail::Value_type<ForwardIt1>;
+        if constexpr (detail::is_random_access<ForwardIt1> && std::is_same_v<T, detail::Value_type<ForwardIt2>>)
+        {
+            const std::vector<T> pattern(s_first, s_last);
+            if (pattern.empty())
+                return last;
+            if constexpr (detail::is_byte<T>)
+                return Reverse_searcher<Horspool_searcher<T>>(pattern.begin(), pattern.end())(first, last).first;
+            else if constexpr (detail::Has_less<T>::value)
+                return Reverse_searcher<Two_way_searcher<T>>(pattern.begin(), pattern.end())(first, last).first;
+            else
+                return std::find_end(first, last, pattern.begin(), pattern.end());
+        }
+        else
+            return std::find_end(first, last, s_first, s_last);
+    }
+
+    // with a Reverse_searcher
+    template<class ForwardIt, class Searcher>
+    ForwardIt find_end(ForwardIt first, ForwardIt last, const Searcher& searcher)
+    {
+        return searcher(first, last).first;
+    }
+
+    template<class ForwardIt, class Size, class T, class BinaryPred>
+    ForwardIt search_n(ForwardIt first, ForwardIt last, Size count, const T& value, BinaryPred p)
+    {
+        if constexpr (detail::is_random_access<ForwardIt>)
+        {
+            if (count <= 0)
+                return first;
+            const auto n = static_cast<typename std::iterator_traits<ForwardIt>::difference_type>(count);
+            while (last - first >= n)
+            {
+                ForwardIt probe = first + (n - 1);
+                if (!p(*probe, value))
+                {
+                    first = probe + 1;
+                    continue;
+                }
+                // the run of the value that ends at probe, a match starts at its start or after probe
+                ForwardIt start = probe;
+                while (start != first && p(*(start - 1), value))
+                    --start;
+                if (start == first)
+                    return first;
+                if (last - start < n)
+                    return last;
+                ForwardIt end = start + n;
+                ForwardIt it = probe + 1;
+                while (it != end && p(*it, value))
+                    ++it;
+                if (it == end)
+                    return start;
+                first = it + 1;
+            }
+            return last;
+        }
+        else
+            return std::search_n(first, last, count, value, p);
+    }
+
+    template<class ForwardIt, class Size, class T>
+    ForwardIt search_n(ForwardIt first, ForwardIt last, Size count, const T& value)
+    {
+        return searchers::search_n(first, last, count, value, std::equal_to<> {});
+    }
+}
+
+#endif
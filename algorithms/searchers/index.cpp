@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Searchers.h"
+
+using namespace std::literals;
+
+int main()
+{
+    // the examples of search, find_end and search_n
+    const auto quote
+    {
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed "
+        "do eiusmod tempor incididunt ut labore et dolore magna aliqua"sv
+    };
+
+    for (const auto word : {"pisci"sv, "Pisci"sv, "dolor"sv})
+    {
+        std::cout << "The string " << std::quoted(word) << ' ';
+        const auto it = searchers::search(quote.begin(), quote.end(), word.begin(), word.end());
+        if (it == quote.end())
+            std::cout << "not found\n";
+        else
+            std::cout << "found at offset " << it - quote.begin()
+                      << ", the last one at " << searchers::find_end(quote.begin(), quote.end(), word.begin(), word.end()) - quote.begin() << '\n';
+    }
+
+    // a searcher is made once and used for many ranges
+    const std::string needle {"dolore magna"};
+    const searchers::Horspool_searcher horspool(needle.begin(), needle.end());
+    const searchers::Two_way_searcher two_way(needle.begin(), needle.end());
+    const searchers::Short_needle_searcher short_needle(needle.begin(), needle.end());
+    for (const std::string& haystack : {std::string(quote), "no match here"s, std::string(1000, 'x') + "dolore magna"})
+        std::cout << std::setw(14) << std::left << haystack.substr(0, 12) + ".."
+                  << " horspool: " << std::search(haystack.begin(), haystack.end(), horspool) - haystack.begin()
+                  << ", two-way: " << std::search(haystack.begin(), haystack.end(), two_way) - haystack.begin()
+                  << ", short needle: " << std::search(haystack.begin(), haystack.end(), short_needle) - haystack.begin() << '\n';
+
+    const auto v = {2, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4};
+    for (const auto& x : {std::array {1, 2, 3}, {4, 5, 6}})
+    {
+        const searchers::Reverse_searcher<searchers::Two_way_searcher<int>> last_of(x.begin(), x.end());
+        auto it = searchers::find_end(v.begin(), v.end(), last_of);
+        if (it == v.end())
+            std::cout << "Sequence not found\n";
+        else
+            std::cout << "Last occurrence is at: " << it - v.begin() << '\n';
+    }
+
+    const std::string sequence {".0_0.000.0_0."};
+    for (int n : {4, 3, 2})
+        std::cout << std::boolalpha << "Has " << n << " consecutive zeros: "
+                  << (searchers::search_n(sequence.begin(), sequence.end(), n, '0') != sequence.end()) << '\n';
+
+    const std::vector<int> numbers {1, -1, 1, 1, -1, -1, 2};
+    auto it = searchers::search_n(numbers.begin(), numbers.end(), 4, 1, [](int x, int y) { return std::abs(x) == y; });
+    std::cout << "4 of magnitude 1 from: " << it - numbers.begin() << '\n';
+
+    return 0;
+}
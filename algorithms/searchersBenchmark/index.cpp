@@ -0,0 +1,107 @@
+/*
+
+    - compares std::search, and the searchers of <functional>, against the ones of
+      ../searchers/Searchers.h, made once for every needle, counting the matches of a few
+      needles in romeoAndJuliet.txt repeated, short ones, a long one and one that is not in
+      it, then the time of one find_end, as GB/s of all the text, and the index it finds,
+      and a text of 'a's with the needle "baa...a", the worst case of Horspool.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - 100'000'000 bytes by default, the number can be given on the command line, e.g.
+      ./a.out 10000000, run it from this directory, it reads
+      ../../ioAndStream/challenge4/romeoAndJuliet.txt
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../searchers/Searchers.h"
+
+template <typename Search>
+void run(const std::string& name, const std::string& text, Search search)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t matches {0};
+    for (auto it = search(text.begin(), text.end()); it != text.end(); it = search(it + 1, text.end()))
+        ++matches;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "    " << std::setw(28) << std::left << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(8) << text.size() / seconds / 1e9 << " GB/s" << std::setw(12) << matches << std::endl;
+}
+
+template <typename Find_end>
+void run_once(const std::string& name, const std::string& text, Find_end find_end)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto it = find_end();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "    " << std::setw(28) << std::left << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(8) << text.size() / seconds / 1e9 << " GB/s" << std::setw(12) << it - text.begin() << std::endl;
+}
+
+template <typename Searcher>
+auto with(const Searcher& searcher)
+{
+    return [&searcher](auto first, auto last) { return searcher(first, last).first; };
+}
+
+void compare(const std::string& text, const std::string& needle)
+{
+    std::cout << '"' << (needle.size() > 40 ? needle.substr(0, 37) + "..." : needle) << "\", " << needle.size() << " bytes" << std::endl;
+    run("std::search", text, [&needle](auto first, auto last) { return std::search(first, last, needle.begin(), needle.end()); });
+    const std::boyer_moore_horspool_searcher std_horspool(needle.begin(), needle.end());
+    run("std::boyer_moore_horspool", text, with(std_horspool));
+    const searchers::Horspool_searcher horspool(needle.begin(), needle.end());
+    run("Horspool_searcher", text, with(horspool));
+    const searchers::Two_way_searcher two_way(needle.begin(), needle.end());
+    run("Two_way_searcher", text, with(two_way));
+    const searchers::Short_needle_searcher short_needle(needle.begin(), needle.end());
+    run("Short_needle_searcher", text, with(short_needle));
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000'000;
+
+    std::ifstream file {"../../ioAndStream/challenge4/romeoAndJuliet.txt"};
+    if (!file)
+        throw std::runtime_error {"romeoAndJuliet.txt can not be opened"};
+    std::stringstream book;
+    book << file.rdbuf();
+    std::string text;
+    while (text.size() < n)
+        text += book.str();
+    text.resize(n);
+
+    std::cout << n << " bytes, GB/s and number of matches" << std::endl;
+    for (const std::string needle : {"Romeo", "Juliet", "wherefore art thou", "What's in a name? that which we call a rose", "Hamlet"})
+        compare(text, needle);
+
+    // one match near the end, and none, so all the text is looked at
+    for (const std::string needle : {"Nurse", "Hamlet"})
+    {
+        std::cout << "find_end of \"" << needle << '"' << std::endl;
+        run_once("std::find_end", text, [&] { return std::find_end(text.begin(), text.end(), needle.begin(), needle.end()); });
+        const searchers::Reverse_searcher<searchers::Horspool_searcher<char>> horspool(needle.begin(), needle.end());
+        run_once("Reverse_searcher", text, [&] { return searchers::find_end(text.begin(), text.end(), horspool); });
+    }
+
+    const std::string a_s(n / 10, 'a');
+    const std::string b_a_s = 'b' + std::string(63, 'a');
+    std::cout << "the worst case of Horspool, " << a_s.size() << " bytes" << std::endl;
+    run("Horspool_searcher", a_s, with(searchers::Horspool_searcher(b_a_s.begin(), b_a_s.end())));
+    run("Two_way_searcher", a_s, with(searchers::Two_way_searcher(b_a_s.begin(), b_a_s.end())));
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+#ifndef _PARALLEL_SHUFFLE_H_
+#define _PARALLEL_SHUFFLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../fastRandom/Fast_random.h"
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+/*
+
+    - shuffling::shuffle(policy, first, last, seed) is a uniform shuffle of a range, every
+      order with the same chance, for ranges much bigger than the cache: the swaps of
+      Fisher-Yates go anywhere in the range, a miss of the cache for every element once it is
+      bigger than the last level one.
+
+    - every element goes to a bucket chosen at random, the elements of a bucket are put next
+      to each other in a buffer, in the order of the range, and every bucket is shuffled with
+      Fisher-Yates on its way back to the range, in a part of it that is about 256 KB, so its
+      swaps stay in the cache. the elements of a bucket are a random set of the range, of
+      its size, and they are in a random order, so the range is too.
+
+    - the chunks of the range, at most max_shuffle_chunks of them, choose the buckets of
+      their elements, count them, and choose them again, with the same generator, to move
+      them to their bucket, so there is no array of the buckets, then the buckets are
+      shuffled, as tasks of the Work_stealing_pool of the policy. every chunk and every
+      bucket has its own fast_random::Xoshiro256ss from the seed and its number.
+
+    - the chunks and the buckets depend on the size of the range, not on the threads, so the
+      same seed gives the same order with parallel::seq, par and par_unseq, on any pool. a
+      range of less than shuffle_threshold elements, or elements that are not default
+      constructible, for the buffer, is shuffled with fast_random::shuffle.
+
+*/
+namespace shuffling
+{
+    inline constexpr std::size_t shuffle_threshold {1 << 16};
+    inline constexpr std::size_t max_shuffle_chunks {64};
+    inline constexpr std::size_t bucket_bytes {1 << 18};
+    inline constexpr std::size_t max_buckets {4096};
+
+    namespace detail
+    {
+        // the generator of a chunk, or of a bucket
+        inline fast_random::Xoshiro256ss generator(std::uint64_t seed, std::uint64_t stream)
+        {
+            std::uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03);
+            return fast_random::Xoshiro256ss {fast_random::splitmix64(state)};
+        }
+
+        inline std::size_t bounds(std::size_t n, std::size_t parts, std::size_t part)
+        {
+            return n / parts * part + std::min(part, n % parts);
+        }
+
+        template<class Policy, class RandomIt, class F>
+        void for_parts(const Policy& policy, std::size_t parts, const F& f)
+        {
+            if constexpr (parallel::detail::is_parallel<Policy, RandomIt>)
+                parallel::detail::for_chunks(parallel::detail::pool_of(policy), parts, parts,
+                    [&f](std::size_t part, std::size_t, std::size_t) { f(part); });
+            else
+                for (std::size_t part = 0; part < parts; ++part)
+                    f(part);
+        }
+    }
+
+    template<class Policy, class RandomIt>
+    void shuffle(Policy&& policy, RandomIt first, RandomIt last, std::uint64_t seed)
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (n < shuffle_threshold || !std::is_default_constructible_v<T>)
+        {
+            fast_random::Xoshiro256ss gen {seed};
+            fast_random::shuffle(first, last, gen);
+            return;
+        }
+
+        if constexpr (std::is_default_constructible_v<T>)
+        {
+            const std::size_t buckets = std::clamp<std::size_t>(n / std::max<std::size_t>(1, bucket_bytes / sizeof(T)), 2, max_buckets);
+            const std::size_t chunks = std::clamp<std::size_t>(n / parallel::min_chunk, 1, max_shuffle_chunks);
+
+            // how many of every bucket every chunk has, then where they go in the buffer
+            std::vector<std::size_t> offsets(chunks * buckets);
+            detail::for_parts<Policy, RandomIt>(policy, chunks, [&](std::size_t chunk)
+            {
+                fast_random::Xoshiro256ss gen = detail::generator(seed, chunk);
+                std::size_t* counts = offsets.data() + chunk * buckets;
+                for (std::size_t i = detail::bounds(n, chunks, chunk); i < detail::bounds(n, chunks, chunk + 1); ++i)
+                    ++counts[fast_random::bounded(gen, buckets)];
+            });
+            std::vector<std::size_t> bucket_begin(buckets + 1);
+            std::size_t offset {0};
+            for (std::size_t bucket = 0; bucket < buckets; ++bucket)
+            {
+                bucket_begin[bucket] = offset;
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                    offset += std::exchange(offsets[chunk * buckets + bucket], offset);
+            }
+            bucket_begin[buckets] = n;
+
+            std::vector<T> buffer(n);
+            detail::for_parts<Policy, RandomIt>(policy, chunks, [&](std::size_t chunk)
+            {
+                fast_random::Xoshiro256ss gen = detail::generator(seed, chunk);
+                std::size_t* next = offsets.data() + chunk * buckets;
+                for (std::size_t i = detail::bounds(n, chunks, chunk); i < detail::bounds(n, chunks, chunk + 1); ++i)
+                    buffer[next[fast_random::bounded(gen, buckets)]++] = std::move(first[i]);
+            });
+
+            // the inside out Fisher-Yates, from the bucket of the buffer to the same places of the range
+            detail::for_parts<Policy, RandomIt>(policy, buckets, [&](std::size_t bucket)
+            {
+                fast_random::Xoshiro256ss gen = detail::generator(seed, chunks + bucket);
+                const std::size_t begin = bucket_begin[bucket];
+                const std::size_t size = bucket_begin[bucket + 1] - begin;
+                RandomIt out = first + static_cast<typename std::iterator_traits<RandomIt>::difference_type>(begin);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    const std::size_t j = static_cast<std::size_t>(fast_random::bounded(gen, i + 1));
+                    if (j != i)
+                        out[i] = std::move(out[j]);
+                    out[j] = std::move(buffer[begin + i]);
+                }
+            });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "Parallel_shuffle.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+int main()
+{
+    // an index array of 10 million, shuffled on the threads of the default pool
+    std::vector<std::uint32_t> indexes(10'000'000);
+    std::iota(indexes.begin(), indexes.end(), 0);
+    shuffling::shuffle(parallel::par, indexes.begin(), indexes.end(), 2024);
+    std::cout << "threads: " << parallel::default_pool().size() << ", the first ones:";
+    for (std::size_t i = 0; i < 8; ++i)
+        std::cout << ' ' << indexes[i];
+    std::cout << '\n';
+
+    // the same order with seq, and on a pool of 4
+    std::vector<std::uint32_t> seq(indexes.size());
+    std::iota(seq.begin(), seq.end(), 0);
+    shuffling::shuffle(parallel::seq, seq.begin(), seq.end(), 2024);
+    std::vector<std::uint32_t> four(indexes.size());
+    std::iota(four.begin(), four.end(), 0);
+    Work_stealing_pool pool {3};
+    shuffling::shuffle(parallel::par.on(pool), four.begin(), four.end(), 2024);
+    std::cout << std::boolalpha << "the same with seq: " << (seq == indexes) << ", on a pool of " << pool.size() << ": " << (four == indexes) << '\n';
+
+    // still every index once
+    std::sort(four.begin(), four.end());
+    std::vector<std::uint32_t> expected(four.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    std::cout << "a permutation: " << (four == expected) << '\n';
+
+    // a small range is a Fisher-Yates
+    std::vector<int> v {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    shuffling::shuffle(parallel::par, v.begin(), v.end(), 1);
+    for (int i : v)
+        std::cout << i << ' ';
+    std::cout << '\n';
+
+    return 0;
+}
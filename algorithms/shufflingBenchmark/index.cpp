@@ -0,0 +1,90 @@
+/*
+
+    - compares std::shuffle with a std::mt19937, and fast_random::shuffle with a Xoshiro256ss,
+      the Fisher-Yates of one element at a time, against shuffling::shuffle of
+      ../shuffling/Parallel_shuffle.h with par on pools of 1, 2, 4, ... threads, up to twice
+      the cores, of an index array of std::uint32_t, and checks that every one is still a
+      permutation.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 1'000'000, 10'000'000 and 100'000'000 indexes by default, the biggest number can be
+      given on the command line, e.g. ./a.out 2000000000, 2e9 takes about 16 GB, the array and
+      the buffer of the shuffle, 4 bytes for every index of both.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../fastRandom/Fast_random.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+#include "../shuffling/Parallel_shuffle.h"
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// every index once, with the sum and the sum of the squares, so it needs no copy of them
+bool is_permutation(const std::vector<std::uint32_t>& indexes)
+{
+    const std::uint64_t n = indexes.size();
+    std::uint64_t sum {0}, squares {0};
+    for (std::uint64_t i : indexes)
+    {
+        sum += i;
+        squares += i * i;
+    }
+    return sum == n * (n - 1) / 2 && squares == (n - 1) * n * (2 * n - 1) / 6;
+}
+
+template <typename Shuffle>
+void run(const std::string& name, std::vector<std::uint32_t>& indexes, Shuffle shuffle)
+{
+    std::iota(indexes.begin(), indexes.end(), 0);
+    const auto start = std::chrono::steady_clock::now();
+    shuffle(indexes);
+    const double seconds = seconds_since(start);
+    std::cout << std::setw(32) << std::left << name << std::fixed << std::setprecision(2)
+        << std::setw(10) << std::right << seconds * 1e9 / indexes.size()
+        << (is_permutation(indexes) ? "" : "    WRONG") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t max = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000'000;
+
+    for (std::size_t n = 1'000'000; n <= max; n *= 10)
+    {
+        std::vector<std::uint32_t> indexes(n);
+        std::cout << '\n' << n << " indexes, ns per index" << std::endl;
+        run("std::shuffle, std::mt19937", indexes, [](std::vector<std::uint32_t>& v) {
+            std::shuffle(v.begin(), v.end(), std::mt19937 {42});
+        });
+        run("fast_random::shuffle", indexes, [](std::vector<std::uint32_t>& v) {
+            fast_random::Xoshiro256ss gen {42};
+            fast_random::shuffle(v.begin(), v.end(), gen);
+        });
+
+        const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+        {
+            Work_stealing_pool pool {threads - 1};
+            run("shuffling::shuffle, " + std::to_string(threads) + " threads", indexes, [&pool](std::vector<std::uint32_t>& v) {
+                shuffling::shuffle(parallel::par.on(pool), v.begin(), v.end(), 42);
+            });
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,346 @@
+#ifndef _MIN_MAX_H_
+#define _MIN_MAX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - the SQUARE and MAX macros of ../../standardTemplateLibrary/genericProgrammingWithMacro
+      as constexpr function templates, square, min, max and clamp: an argument is evaluated
+      once, MAX(i++, j) is not, and both are of one type, MAX(num, num2) of an int and a
+      double does not compile without a type given.
+
+    - the reductions of a range, header only: min_max, the smallest and the largest in one
+      pass, argmin and argmax, the first smallest and the first largest like std::min_element
+      and std::max_element, and clamp_all, std::clamp of every element in place. a range is
+      two iterators, or a container with data() and size(), a std::vector, a std::array.
+
+    - on a contiguous range of an arithmetic type, not bool, the loops go through vectors of
+      32 bytes of the compiler, 8 ints, 4 doubles, 32 chars, a few of them at a time: the
+      instructions are the ones of the build, two SSE2 registers a vector for x86-64, one
+      AVX2 one with -march=x86-64-v3, NEON on aarch64, and a pass is bound by the bandwidth
+      of the memory. the other ranges, and a constant evaluation, take the loop of one
+      element at a time.
+
+    - argmin and argmax are two passes, the value, then the first element equal to it, the
+      second one stops there. the results are the ones of the std algorithms, a NaN too:
+      < is false for it, so one that is the first element is the result and one after it is
+      skipped. -0.0 and 0.0 are equal, either of them can be the min or the max.
+
+    - min_max of an empty range throws std::invalid_argument, argmin and argmax return last,
+      clamp_all throws std::invalid_argument when hi < lo.
+
+*/
+namespace simd
+{
+    template<class T>
+    constexpr T square(const T& a)
+    {
+        return a * a;
+    }
+
+    template<class T>
+    constexpr const T& min(const T& a, const T& b)
+    {
+        return b < a ? b : a;
+    }
+
+    template<class T>
+    constexpr const T& max(const T& a, const T& b)
+    {
+        return a < b ? b : a;
+    }
+
+    template<class T>
+    constexpr const T& clamp(const T& v, const T& lo, const T& hi)
+    {
+        return v < lo ? lo : hi < v ? hi : v;
+    }
+
+    namespace detail_min_max
+    {
+        constexpr std::size_t vector_bytes = 32;
+        // vectors a step, independent, so the compares of one do not wait for another
+        constexpr std::size_t unroll = 4;
+
+        template<class T>
+        struct Lanes
+        {
+            typedef T type __attribute__((vector_size(vector_bytes)));
+            static constexpr std::size_t count = vector_bytes / sizeof(T);
+        };
+
+        template<class T>
+        constexpr bool is_vector_type = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+        template<class It, class = void>
+        struct Contiguous : std::false_type {};
+
+        template<class T>
+        struct Contiguous<T*> : std::bool_constant<is_vector_type<std::remove_cv_t<T>>> {};
+
+        template<class It>
+        struct Contiguous<It, std::enable_if_t<!std::is_pointer_v<It>
+            && is_vector_type<typename std::iterator_traits<It>::value_type>>>
+        {
+            using value_type = typename std::iterator_traits<It>::value_type;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>;
+        };
+
+        template<class It>
+        constexpr bool is_contiguous = Contiguous<It>::value;
+
+        template<class T>
+        using Vector = typename Lanes<T>::type;
+
+        // out parameters, a vector of 32 bytes returned by value is another ABI with AVX and without
+        template<class T>
+        void load(Vector<T>& v, const T* p)
+        {
+            std::memcpy(&v, p, vector_bytes);
+        }
+
+        template<class T>
+        void broadcast(Vector<T>& v, T value)
+        {
+            for (std::size_t i = 0; i < Lanes<T>::count; ++i)
+                v[i] = value;
+        }
+
+        // every lane starts at the first element, so a NaN first stays, like in the std loop
+        template<class T>
+        std::pair<T, T> min_max(const T* p, std::size_t n)
+        {
+            constexpr std::size_t lanes = Lanes<T>::count;
+            constexpr std::size_t step = lanes * unroll;
+            Vector<T> lo[unroll], hi[unroll];
+            for (std::size_t u = 0; u < unroll; ++u)
+            {
+                broadcast(lo[u], p[0]);
+                hi[u] = lo[u];
+            }
+
+            std::size_t i = 0;
+            for (; i + step <= n; i += step)
+                for (std::size_t u = 0; u < unroll; ++u)
+                {
+                    Vector<T> v;
+                    load(v, p + i + u * lanes);
+                    lo[u] = v < lo[u] ? v : lo[u];
+                    hi[u] = hi[u] < v ? v : hi[u];
+                }
+
+            T min = p[0], max = p[0];
+            for (std::size_t u = 0; u < unroll; ++u)
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                {
+                    min = lo[u][lane] < min ? lo[u][lane] : min;
+                    max = max < hi[u][lane] ? hi[u][lane] : max;
+                }
+            for (; i < n; ++i)
+            {
+                min = p[i] < min ? p[i] : min;
+                max = max < p[i] ? p[i] : max;
+            }
+            return {min, max};
+        }
+
+        template<class T>
+        T min_of(const T* p, std::size_t n, bool largest)
+        {
+            constexpr std::size_t lanes = Lanes<T>::count;
+            constexpr std::size_t step = lanes * unroll;
+            Vector<T> acc[unroll];
+            for (std::size_t u = 0; u < unroll; ++u)
+                broadcast(acc[u], p[0]);
+
+            std::size_t i = 0;
+            if (largest)
+                for (; i + step <= n; i += step)
+                    for (std::size_t u = 0; u < unroll; ++u)
+                    {
+                        Vector<T> v;
+                        load(v, p + i + u * lanes);
+                        acc[u] = acc[u] < v ? v : acc[u];
+                    }
+            else
+                for (; i + step <= n; i += step)
+                    for (std::size_t u = 0; u < unroll; ++u)
+                    {
+                        Vector<T> v;
+                        load(v, p + i + u * lanes);
+                        acc[u] = v < acc[u] ? v : acc[u];
+                    }
+
+            T result = p[0];
+            for (std::size_t u = 0; u < unroll; ++u)
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    result = largest ? (result < acc[u][lane] ? acc[u][lane] : result) : (acc[u][lane] < result ? acc[u][lane] : result);
+            for (; i < n; ++i)
+                result = largest ? (result < p[i] ? p[i] : result) : (p[i] < result ? p[i] : result);
+            return result;
+        }
+
+        // the index of the first element equal to value, n when none is
+        template<class T>
+        std::size_t find_equal(const T* p, std::size_t n, T value)
+        {
+            constexpr std::size_t lanes = Lanes<T>::count;
+            Vector<T> target, v;
+            broadcast(target, value);
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                load(v, p + i);
+                const auto equal = v == target;
+                std::uint64_t words[vector_bytes / 8];
+                std::memcpy(words, &equal, vector_bytes);
+                if ((words[0] | words[1] | words[2] | words[3]) != 0)
+                    break;
+            }
+            for (; i < n; ++i)
+                if (p[i] == value)
+                    return i;
+            return n;
+        }
+
+        template<class T>
+        void clamp_all(T* p, std::size_t n, T lo, T hi)
+        {
+            constexpr std::size_t lanes = Lanes<T>::count;
+            Vector<T> low, high, v;
+            broadcast(low, lo);
+            broadcast(high, hi);
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                load(v, p + i);
+                v = v < low ? low : v;
+                v = high < v ? high : v;
+                std::memcpy(p + i, &v, vector_bytes);
+            }
+            for (; i < n; ++i)
+                p[i] = p[i] < lo ? lo : hi < p[i] ? hi : p[i];
+        }
+
+        template<class It>
+        auto address(It it) { return &*it; }
+    }
+
+    // {the smallest, the largest}, of a range that is not empty
+    template<class InputIt>
+    constexpr std::pair<typename std::iterator_traits<InputIt>::value_type, typename std::iterator_traits<InputIt>::value_type>
+        min_max(InputIt first, InputIt last)
+    {
+        using T = typename std::iterator_traits<InputIt>::value_type;
+        if (first == last)
+            throw std::invalid_argument {"min_max of an empty range"};
+        if constexpr (detail_min_max::is_contiguous<InputIt>)
+            if (!__builtin_is_constant_evaluated())
+                return detail_min_max::min_max(detail_min_max::address(first), static_cast<std::size_t>(last - first));
+
+        T min = *first, max = *first;
+        for (++first; first != last; ++first)
+        {
+            min = *first < min ? *first : min;
+            max = max < *first ? *first : max;
+        }
+        return {min, max};
+    }
+
+    template<class ForwardIt>
+    constexpr ForwardIt argmin(ForwardIt first, ForwardIt last)
+    {
+        if (first == last)
+            return last;
+        if constexpr (detail_min_max::is_contiguous<ForwardIt>)
+            if (!__builtin_is_constant_evaluated())
+            {
+                const auto* p = detail_min_max::address(first);
+                const std::size_t n = static_cast<std::size_t>(last - first);
+                const auto value = detail_min_max::min_of(p, n, false);
+                return value == value ? first + detail_min_max::find_equal(p, n, value) : first;
+            }
+
+        ForwardIt smallest = first;
+        for (++first; first != last; ++first)
+            if (*first < *smallest)
+                smallest = first;
+        return smallest;
+    }
+
+    template<class ForwardIt>
+    constexpr ForwardIt argmax(ForwardIt first, ForwardIt last)
+    {
+        if (first == last)
+            return last;
+        if constexpr (detail_min_max::is_contiguous<ForwardIt>)
+            if (!__builtin_is_constant_evaluated())
+            {
+                const auto* p = detail_min_max::address(first);
+                const std::size_t n = static_cast<std::size_t>(last - first);
+                const auto value = detail_min_max::min_of(p, n, true);
+                return value == value ? first + detail_min_max::find_equal(p, n, value) : first;
+            }
+
+        ForwardIt largest = first;
+        for (++first; first != last; ++first)
+            if (*largest < *first)
+                largest = first;
+        return largest;
+    }
+
+    template<class ForwardIt, class T>
+    constexpr void clamp_all(ForwardIt first, ForwardIt last, const T& lo, const T& hi)
+    {
+        using V = typename std::iterator_traits<ForwardIt>::value_type;
+        if (hi < lo)
+            throw std::invalid_argument {"clamp_all with hi < lo"};
+        if constexpr (detail_min_max::is_contiguous<ForwardIt> && std::is_same_v<V, T>)
+            if (!__builtin_is_constant_evaluated())
+            {
+                if (first != last)
+                    detail_min_max::clamp_all(detail_min_max::address(first), static_cast<std::size_t>(last - first), lo, hi);
+                return;
+            }
+
+        for (; first != last; ++first)
+            *first = simd::clamp<V>(*first, lo, hi);
+    }
+
+    // the same of a container, a std::vector, a std::array, ..., or anything with data() and size()
+    template<class Range>
+    constexpr auto min_max(const Range& range) -> decltype(simd::min_max(range.data(), range.data() + range.size()))
+    {
+        return simd::min_max(range.data(), range.data() + range.size());
+    }
+
+    template<class Range>
+    constexpr auto argmin(const Range& range) -> decltype(static_cast<std::size_t>(range.size()))
+    {
+        return static_cast<std::size_t>(simd::argmin(range.data(), range.data() + range.size()) - range.data());
+    }
+
+    template<class Range>
+    constexpr auto argmax(const Range& range) -> decltype(static_cast<std::size_t>(range.size()))
+    {
+        return static_cast<std::size_t>(simd::argmax(range.data(), range.data() + range.size()) - range.data());
+    }
+
+    template<class Range, class T>
+    constexpr auto clamp_all(Range& range, const T& lo, const T& hi) -> decltype(void(range.data() + range.size()))
+    {
+        simd::clamp_all(range.data(), range.data() + range.size(), lo, hi);
+    }
+}
+
+#endif
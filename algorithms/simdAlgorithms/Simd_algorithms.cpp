@@ -0,0 +1,551 @@
+#include <atomic>
+#include <cstring>
+#include "Simd_algorithms.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/*
+
+    - every instruction set has a kernel for each of the 4 element sizes, the elements are
+      loaded as unsigned integers of their size, equal elements are the ones with equal bits.
+
+    - the x86 kernels are built for their instructions with the target attribute, whatever the
+      flags of the build are, and run only when __builtin_cpu_supports says the cpu has them.
+
+    - a vector of equal elements is a mask of the bytes, 0xFF for the bytes of the equal ones,
+      find looks for its first byte, count adds 1 for every one of its bytes and divides by
+      the element size at the end, the bytes are added up in 8 bits, 255 vectors at a time.
+      AVX-512 compares to a mask of the elements, and loads the end of the range with a mask,
+      the ones before it load what does not fill a vector in one element at a time.
+
+*/
+namespace
+{
+    using Bytes = const unsigned char*;
+
+    template<class V>
+    V load(Bytes p)
+    {
+        V value;
+        std::memcpy(&value, p, sizeof(V));
+        return value;
+    }
+
+    // from the element i, the ones that did not fill a vector
+    template<class V>
+    std::size_t find_scalar(Bytes p, std::size_t i, std::size_t n, V value)
+    {
+        for (; i < n; ++i)
+            if (load<V>(p + i * sizeof(V)) == value)
+                return i;
+        return n;
+    }
+
+    template<class V>
+    std::size_t count_scalar(Bytes p, std::size_t i, std::size_t n, V value)
+    {
+        std::size_t count {0};
+        for (; i < n; ++i)
+            count += load<V>(p + i * sizeof(V)) == value;
+        return count;
+    }
+
+    std::size_t mismatch_scalar(Bytes p, Bytes q, std::size_t i, std::size_t n)
+    {
+        while (i < n && p[i] == q[i])
+            ++i;
+        return i;
+    }
+
+    template<class V>
+    std::size_t find_of_scalar(const void* data, std::size_t n, std::uint64_t value)
+    {
+        return find_scalar<V>(static_cast<Bytes>(data), 0, n, static_cast<V>(value));
+    }
+
+    template<class V>
+    std::size_t count_of_scalar(const void* data, std::size_t n, std::uint64_t value)
+    {
+        return count_scalar<V>(static_cast<Bytes>(data), 0, n, static_cast<V>(value));
+    }
+
+    std::size_t mismatch_of_scalar(const void* first1, const void* first2, std::size_t n)
+    {
+        return mismatch_scalar(static_cast<Bytes>(first1), static_cast<Bytes>(first2), 0, n);
+    }
+
+#if defined(SIMD_X86)
+
+#define SIMD_SSE2 __attribute__((target("sse2")))
+#define SIMD_AVX2 __attribute__((target("avx2")))
+#define SIMD_AVX512 __attribute__((target("avx512f,avx512bw,popcnt")))
+
+    template<class V>
+    SIMD_SSE2 __m128i set1_128(V value)
+    {
+        if constexpr (sizeof(V) == 1)
+            return _mm_set1_epi8(static_cast<char>(value));
+        else if constexpr (sizeof(V) == 2)
+            return _mm_set1_epi16(static_cast<short>(value));
+        else if constexpr (sizeof(V) == 4)
+            return _mm_set1_epi32(static_cast<int>(value));
+        else
+            return _mm_set1_epi64x(static_cast<long long>(value));
+    }
+
+    // SSE2 has no compare of 64 bits, they are equal when both of their halves are
+    template<class V>
+    SIMD_SSE2 __m128i equal_128(__m128i a, __m128i b)
+    {
+        if constexpr (sizeof(V) == 1)
+            return _mm_cmpeq_epi8(a, b);
+        else if constexpr (sizeof(V) == 2)
+            return _mm_cmpeq_epi16(a, b);
+        else if constexpr (sizeof(V) == 4)
+            return _mm_cmpeq_epi32(a, b);
+        else
+        {
+            const __m128i halves = _mm_cmpeq_epi32(a, b);
+            return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    }
+
+    SIMD_SSE2 __m128i load_128(Bytes p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    SIMD_SSE2 std::uint64_t mask_128(__m128i bytes)
+    {
+        return static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(bytes)));
+    }
+
+    // the sum of the bytes, 0 or 1 each, added up in 8 bits, of up to 255 vectors
+    SIMD_SSE2 std::size_t sum_128(__m128i sums)
+    {
+        const __m128i halves = _mm_sad_epu8(sums, _mm_setzero_si128());
+        return static_cast<std::size_t>(_mm_cvtsi128_si32(halves)) + static_cast<std::size_t>(_mm_extract_epi16(halves, 4));
+    }
+
+    template<class V>
+    SIMD_SSE2 std::size_t find_sse2(const void* data, std::size_t n, std::uint64_t value)
+    {
+        const Bytes p = static_cast<Bytes>(data);
+        const std::size_t bytes = n * sizeof(V);
+        const __m128i needle = set1_128<V>(static_cast<V>(value));
+        std::size_t i {0};
+        for (; i + 64 <= bytes; i += 64)
+        {
+            const __m128i e0 = equal_128<V>(load_128(p + i), needle);
+            const __m128i e1 = equal_128<V>(load_128(p + i + 16), needle);
+            const __m128i e2 = equal_128<V>(load_128(p + i + 32), needle);
+            const __m128i e3 = equal_128<V>(load_128(p + i + 48), needle);
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3))) != 0)
+            {
+                const std::uint64_t mask = mask_128(e0) | mask_128(e1) << 16 | mask_128(e2) << 32 | mask_128(e3) << 48;
+                return (i + static_cast<std::size_t>(__builtin_ctzll(mask))) / sizeof(V);
+            }
+        }
+        for (; i + 16 <= bytes; i += 16)
+        {
+            const std::uint64_t mask = mask_128(equal_128<V>(load_128(p + i), needle));
+            if (mask != 0)
+                return (i + static_cast<std::size_t>(__builtin_ctzll(mask))) / sizeof(V);
+        }
+        return find_scalar<V>(p, i / sizeof(V), n, static_cast<V>(value));
+    }
+
+    template<class V>
+    SIMD_SSE2 std::size_t count_sse2(const void* data, std::size_t n, std::uint64_t value)
+    {
+        const Bytes p = static_cast<Bytes>(data);
+        const std::size_t bytes = n * sizeof(V);
+        const __m128i needle = set1_128<V>(static_cast<V>(value));
+        std::size_t equal_bytes {0};
+        std::size_t i {0};
+        while (i + 16 <= bytes)
+        {
+            const std::size_t end = std::min(bytes - (bytes - i) % 16, i + 255 * 16);
+            __m128i sums = _mm_setzero_si128();
+            for (; i < end; i += 16)
+                sums = _mm_sub_epi8(sums, equal_128<V>(load_128(p + i), needle));
+            equal_bytes += sum_128(sums);
+        }
+        return equal_bytes / sizeof(V) + count_scalar<V>(p, i / sizeof(V), n, static_cast<V>(value));
+    }
+
+    SIMD_SSE2 std::size_t mismatch_sse2(const void* first1, const void* first2, std::size_t n)
+    {
+        const Bytes p = static_cast<Bytes>(first1);
+        const Bytes q = static_cast<Bytes>(first2);
+        std::size_t i {0};
+        for (; i + 16 <= n; i += 16)
+        {
+            const std::uint64_t mask = mask_128(_mm_cmpeq_epi8(load_128(p + i), load_128(q + i))) ^ 0xFFFF;
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+        }
+        return mismatch_scalar(p, q, i, n);
+    }
+
+    template<class V>
+    SIMD_AVX2 __m256i set1_256(V value)
+    {
+        if constexpr (sizeof(V) == 1)
+            return _mm256_set1_epi8(static_cast<char>(value));
+        else if constexpr (sizeof(V) == 2)
+            return _mm256_set1_epi16(static_cast<short>(value));
+        else if constexpr (sizeof(V) == 4)
+            return _mm256_set1_epi32(static_cast<int>(value));
+        else
+            return _mm256_set1_epi64x(static_cast<long long>(value));
+    }
+
+    template<class V>
+    SIMD_AVX2 __m256i equal_256(__m256i a, __m256i b)
+    {
+        if constexpr (sizeof(V) == 1)
+            return _mm256_cmpeq_epi8(a, b);
+        else if constexpr (sizeof(V) == 2)
+            return _mm256_cmpeq_epi16(a, b);
+        else if constexpr (sizeof(V) == 4)
+            return _mm256_cmpeq_epi32(a, b);
+        else
+            return _mm256_cmpeq_epi64(a, b);
+    }
+
+    SIMD_AVX2 __m256i load_256(Bytes p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    SIMD_AVX2 std::uint64_t mask_256(__m256i bytes)
+    {
+        return static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(bytes)));
+    }
+
+    SIMD_AVX2 std::size_t sum_256(__m256i sums)
+    {
+        const __m256i quarters = _mm256_sad_epu8(sums, _mm256_setzero_si256());
+        const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(quarters), _mm256_extracti128_si256(quarters, 1));
+        return static_cast<std::size_t>(_mm_cvtsi128_si32(halves)) + static_cast<std::size_t>(_mm_extract_epi16(halves, 4));
+    }
+
+    template<class V>
+    SIMD_AVX2 std::size_t find_avx2(const void* data, std::size_t n, std::uint64_t value)
+    {
+        const Bytes p = static_cast<Bytes>(data);
+        const std::size_t bytes = n * sizeof(V);
+        const __m256i needle = set1_256<V>(static_cast<V>(value));
+        std::size_t i {0};
+        for (; i + 64 <= bytes; i += 64)
+        {
+            const __m256i e0 = equal_256<V>(load_256(p + i), needle);
+            const __m256i e1 = equal_256<V>(load_256(p + i + 32), needle);
+            if (!_mm256_testz_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e0, e1)))
+            {
+                const std::uint64_t mask = mask_256(e0) | mask_256(e1) << 32;
+                return (i + static_cast<std::size_t>(__builtin_ctzll(mask))) / sizeof(V);
+            }
+        }
+        for (; i + 32 <= bytes; i += 32)
+        {
+            const std::uint64_t mask = mask_256(equal_256<V>(load_256(p + i), needle));
+            if (mask != 0)
+                return (i + static_cast<std::size_t>(__builtin_ctzll(mask))) / sizeof(V);
+        }
+        return find_scalar<V>(p, i / sizeof(V), n, static_cast<V>(value));
+    }
+
+    template<class V>
+    SIMD_AVX2 std::size_t count_avx2(const void* data, std::size_t n, std::uint64_t value)
+    {
+        const Bytes p = static_cast<Bytes>(data);
+        const std::size_t bytes = n * sizeof(V);
+        const __m256i needle = set1_256<V>(static_cast<V>(value));
+        std::size_t equal_bytes {0};
+        std::size_t i {0};
+        while (i + 32 <= bytes)
+        {
+            const std::size_t end = std::min(bytes - (bytes - i) % 32, i + 255 * 32);
+            __m256i sums = _mm256_setzero_si256();
+            for (; i < end; i += 32)
+                sums = _mm256_sub_epi8(sums, equal_256<V>(load_256(p + i), needle));
+            equal_bytes += sum_256(sums);
+        }
+        return equal_bytes / sizeof(V) + count_scalar<V>(p, i / sizeof(V), n, static_cast<V>(value));
+    }
+
+    SIMD_AVX2 std::size_t mismatch_avx2(const void* first1, const void* first2, std::size_t n)
+    {
+        const Bytes p = static_cast<Bytes>(first1);
+        const Bytes q = static_cast<Bytes>(first2);
+        std::size_t i {0};
+        for (; i + 32 <= n; i += 32)
+        {
+            const std::uint64_t mask = mask_256(_mm256_cmpeq_epi8(load_256(p + i), load_256(q + i))) ^ 0xFFFFFFFF;
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+        }
+        return mismatch_scalar(p, q, i, n);
+    }
+
+    template<class V>
+    SIMD_AVX512 __m512i set1_512(V value)
+    {
+        if constexpr (sizeof(V) == 1)
+            return _mm512_set1_epi8(static_cast<char>(value));
+        else if constexpr (sizeof(V) == 2)
+            return _mm512_set1_epi16(static_cast<short>(value));
+        else if constexpr (sizeof(V) == 4)
+            return _mm512_set1_epi32(static_cast<int>(value));
+        else
+            return _mm512_set1_epi64(static_cast<long long>(value));
+    }
+
+    // a bit for every element
+    template<class V>
+    SIMD_AVX512 std::uint64_t equal_512(__m512i a, __m512i b)
+    {
+        if constexpr (sizeof(V) == 1)
+            return _mm512_cmpeq_epi8_mask(a, b);
+        else if constexpr (sizeof(V) == 2)
+            return _mm512_cmpeq_epi16_mask(a, b);
+        else if constexpr (sizeof(V) == 4)
+            return _mm512_cmpeq_epi32_mask(a, b);
+        else
+            return _mm512_cmpeq_epi64_mask(a, b);
+    }
+
+    // the bytes of [p, p + bytes), bytes is less than 64, the others are 0 and p + bytes on is not read
+    SIMD_AVX512 __m512i load_end_512(Bytes p, std::size_t bytes)
+    {
+        return _mm512_maskz_loadu_epi8((std::uint64_t {1} << bytes) - 1, p);
+    }
+
+    template<class V>
+    SIMD_AVX512 std::size_t find_avx512(const void* data, std::size_t n, std::uint64_t value)
+    {
+        constexpr std::size_t per_vector = 64 / sizeof(V);
+        const Bytes p = static_cast<Bytes>(data);
+        const __m512i needle = set1_512<V>(static_cast<V>(value));
+        std::size_t i {0};
+        for (; i + per_vector <= n; i += per_vector)
+        {
+            const std::uint64_t mask = equal_512<V>(_mm512_loadu_si512(p + i * sizeof(V)), needle);
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+        }
+        if (i == n)
+            return n;
+        const std::uint64_t rest = (std::uint64_t {1} << (n - i)) - 1;
+        const std::uint64_t mask = equal_512<V>(load_end_512(p + i * sizeof(V), (n - i) * sizeof(V)), needle) & rest;
+        return mask != 0 ? i + static_cast<std::size_t>(__builtin_ctzll(mask)) : n;
+    }
+
+    template<class V>
+    SIMD_AVX512 std::size_t count_avx512(const void* data, std::size_t n, std::uint64_t value)
+    {
+        constexpr std::size_t per_vector = 64 / sizeof(V);
+        const Bytes p = static_cast<Bytes>(data);
+        const __m512i needle = set1_512<V>(static_cast<V>(value));
+        std::size_t count {0};
+        std::size_t i {0};
+        for (; i + per_vector <= n; i += per_vector)
+            count += static_cast<std::size_t>(__builtin_popcountll(equal_512<V>(_mm512_loadu_si512(p + i * sizeof(V)), needle)));
+        if (i == n)
+            return count;
+        const std::uint64_t rest = (std::uint64_t {1} << (n - i)) - 1;
+        const std::uint64_t mask = equal_512<V>(load_end_512(p + i * sizeof(V), (n - i) * sizeof(V)), needle) & rest;
+        return count + static_cast<std::size_t>(__builtin_popcountll(mask));
+    }
+
+    SIMD_AVX512 std::size_t mismatch_avx512(const void* first1, const void* first2, std::size_t n)
+    {
+        const Bytes p = static_cast<Bytes>(first1);
+        const Bytes q = static_cast<Bytes>(first2);
+        std::size_t i {0};
+        for (; i + 64 <= n; i += 64)
+        {
+            const std::uint64_t mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(p + i), _mm512_loadu_si512(q + i));
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+        }
+        if (i == n)
+            return n;
+        const std::uint64_t mask = _mm512_cmpneq_epi8_mask(load_end_512(p + i, n - i), load_end_512(q + i, n - i));
+        return mask != 0 ? i + static_cast<std::size_t>(__builtin_ctzll(mask)) : n;
+    }
+
+#elif defined(SIMD_NEON)
+
+    template<class V>
+    uint8x16_t equal_neon(uint8x16_t a, V value)
+    {
+        if constexpr (sizeof(V) == 1)
+            return vceqq_u8(a, vdupq_n_u8(value));
+        else if constexpr (sizeof(V) == 2)
+            return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a), vdupq_n_u16(value)));
+        else if constexpr (sizeof(V) == 4)
+            return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vdupq_n_u32(value)));
+        else
+            return vreinterpretq_u8_u64(vceqq_u64(vreinterpretq_u64_u8(a), vdupq_n_u64(value)));
+    }
+
+    // NEON has no movemask, the shift and narrow keeps 4 bits of every byte
+    std::uint64_t mask_neon(uint8x16_t bytes)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(bytes), 4)), 0);
+    }
+
+    template<class V>
+    std::size_t find_neon(const void* data, std::size_t n, std::uint64_t value)
+    {
+        const Bytes p = static_cast<Bytes>(data);
+        const std::size_t bytes = n * sizeof(V);
+        std::size_t i {0};
+        for (; i + 16 <= bytes; i += 16)
+        {
+            const std::uint64_t mask = mask_neon(equal_neon<V>(vld1q_u8(p + i), static_cast<V>(value)));
+            if (mask != 0)
+                return (i + static_cast<std::size_t>(__builtin_ctzll(mask)) / 4) / sizeof(V);
+        }
+        return find_scalar<V>(p, i / sizeof(V), n, static_cast<V>(value));
+    }
+
+    template<class V>
+    std::size_t count_neon(const void* data, std::size_t n, std::uint64_t value)
+    {
+        const Bytes p = static_cast<Bytes>(data);
+        const std::size_t bytes = n * sizeof(V);
+        std::size_t equal_bytes {0};
+        std::size_t i {0};
+        while (i + 16 <= bytes)
+        {
+            const std::size_t end = std::min(bytes - (bytes - i) % 16, i + 255 * 16);
+            uint8x16_t sums = vdupq_n_u8(0);
+            for (; i < end; i += 16)
+                sums = vsubq_u8(sums, equal_neon<V>(vld1q_u8(p + i), static_cast<V>(value)));
+            equal_bytes += vaddlvq_u8(sums);
+        }
+        return equal_bytes / sizeof(V) + count_scalar<V>(p, i / sizeof(V), n, static_cast<V>(value));
+    }
+
+    std::size_t mismatch_neon(const void* first1, const void* first2, std::size_t n)
+    {
+        const Bytes p = static_cast<Bytes>(first1);
+        const Bytes q = static_cast<Bytes>(first2);
+        std::size_t i {0};
+        for (; i + 16 <= n; i += 16)
+        {
+            const std::uint64_t mask = ~mask_neon(vceqq_u8(vld1q_u8(p + i), vld1q_u8(q + i)));
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctzll(mask)) / 4;
+        }
+        return mismatch_scalar(p, q, i, n);
+    }
+
+#endif
+
+    using Find = std::size_t (*)(const void*, std::size_t, std::uint64_t);
+    using Mismatch = std::size_t (*)(const void*, const void*, std::size_t);
+
+    // the kernels of an instruction set, find and count of elements of 1, 2, 4 and 8 bytes
+    struct Kernels
+    {
+        const char* name;
+        bool (*supported)();
+        Find find[4];
+        Find count[4];
+        Mismatch mismatch;
+    };
+
+#define SIMD_KERNELS(name, supported, find, count, mismatch)                                  \
+    Kernels {name, supported,                                                                  \
+             {find<std::uint8_t>, find<std::uint16_t>, find<std::uint32_t>, find<std::uint64_t>},     \
+             {count<std::uint8_t>, count<std::uint16_t>, count<std::uint32_t>, count<std::uint64_t>}, \
+             mismatch}
+
+    // the best ones first
+    const Kernels all_kernels[] {
+#if defined(SIMD_X86)
+        SIMD_KERNELS("avx512", [] { return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"); },
+                     find_avx512, count_avx512, mismatch_avx512),
+        SIMD_KERNELS("avx2", [] { return static_cast<bool>(__builtin_cpu_supports("avx2")); },
+                     find_avx2, count_avx2, mismatch_avx2),
+        SIMD_KERNELS("sse2", [] { return static_cast<bool>(__builtin_cpu_supports("sse2")); },
+                     find_sse2, count_sse2, mismatch_sse2),
+#elif defined(SIMD_NEON)
+        SIMD_KERNELS("neon", [] { return true; }, find_neon, count_neon, mismatch_neon),
+#endif
+        SIMD_KERNELS("scalar", [] { return true; }, find_of_scalar, count_of_scalar, mismatch_of_scalar),
+    };
+
+    const Kernels& best_kernels()
+    {
+        for (const Kernels& kernels : all_kernels)
+            if (kernels.supported())
+                return kernels;
+        return all_kernels[std::size(all_kernels) - 1];
+    }
+
+    std::atomic<const Kernels*> chosen {nullptr};
+
+    const Kernels& kernels()
+    {
+        const Kernels* kernels = chosen.load(std::memory_order_relaxed);
+        if (kernels == nullptr)
+        {
+            kernels = &best_kernels();
+            const Kernels* none {nullptr};
+            if (!chosen.compare_exchange_strong(none, kernels, std::memory_order_relaxed))
+                kernels = none;
+        }
+        return *kernels;
+    }
+
+    // 1, 2, 4 and 8 are 0, 1, 2 and 3
+    std::size_t size_index(std::size_t size)
+    {
+        return static_cast<std::size_t>(__builtin_ctzll(size));
+    }
+}
+
+const char* simd::instruction_set()
+{
+    return kernels().name;
+}
+
+bool simd::use_instruction_set(const char* name)
+{
+    for (const Kernels& kernels : all_kernels)
+        if (std::strcmp(kernels.name, name) == 0)
+        {
+            if (!kernels.supported())
+                return false;
+            chosen.store(&kernels, std::memory_order_relaxed);
+            return true;
+        }
+    return false;
+}
+
+std::size_t simd::detail::find(const void* data, std::size_t n, std::size_t size, std::uint64_t value)
+{
+    return kernels().find[size_index(size)](data, n, value);
+}
+
+std::size_t simd::detail::count(const void* data, std::size_t n, std::size_t size, std::uint64_t value)
+{
+    return kernels().count[size_index(size)](data, n, value);
+}
+
+std::size_t simd::detail::mismatch(const void* first1, const void* first2, std::size_t n)
+{
+    return kernels().mismatch(first1, first2, n);
+}
@@ -0,0 +1,195 @@
+#ifndef _SIMD_ALGORITHMS_H_
+#define _SIMD_ALGORITHMS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - find, count, mismatch and equal of ../nonModifyingSequenceOperations, with the signatures
+      of the std ones, that compare 16, 32 or 64 bytes at a time when the range is contiguous:
+      a pointer, or an iterator of std::vector or std::basic_string, of an integral type of
+      1, 2, 4 or 8 bytes, char, int, std::uint64_t, ..., not bool. the other ranges run the
+      std algorithm, the choice is made at compile time.
+
+    - the instructions are chosen once, the first time one of them runs, by what the cpu
+      supports: AVX-512 (with BW for the bytes and the shorts), AVX2 or SSE2 on x86-64, NEON on
+      aarch64, a loop of one element at a time on the other ones. use_instruction_set picks
+      other ones, one the cpu supports, e.g. to compare them, instruction_set says which ones
+      run.
+
+    - find and count take a value of any integral type, with the comparison of the std
+      algorithm: a value that converted to the element type is not equal to itself, 300 for
+      a char, is equal to no element, so find returns last and count 0.
+
+    - equal is a compare of the bytes, two integers are equal when their bytes are, mismatch
+      finds the first byte that differs and returns the element it is in.
+
+*/
+namespace simd
+{
+    // "avx512", "avx2", "sse2", "neon" or "scalar"
+    const char* instruction_set();
+
+    // false, and nothing changes, when the cpu, or the build, does not have them
+    bool use_instruction_set(const char* name);
+
+    namespace detail
+    {
+        // the index of the first of the n elements of the given size equal to value, n if none is
+        std::size_t find(const void* data, std::size_t n, std::size_t size, std::uint64_t value);
+        std::size_t count(const void* data, std::size_t n, std::size_t size, std::uint64_t value);
+        // the index of the first of the n bytes that differ, n if none does
+        std::size_t mismatch(const void* first1, const void* first2, std::size_t n);
+
+        template<class T>
+        constexpr bool is_simd_type = std::is_integral_v<T> && !std::is_same_v<T, bool>
+            && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+        template<class It, class = void>
+        struct Contiguous : std::false_type {};
+
+        template<class T>
+        struct Contiguous<T*> : std::bool_constant<is_simd_type<std::remove_cv_t<T>>> {};
+
+        template<class T>
+        constexpr bool is_char_type = std::is_same_v<T, char> || std::is_same_v<T, wchar_t>
+            || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+        // a std::basic_string is only made of the types std::char_traits is for
+        template<class It, class T>
+        constexpr bool is_string_iterator()
+        {
+            if constexpr (is_char_type<T>)
+                return std::is_same_v<It, typename std::basic_string<T>::iterator>
+                    || std::is_same_v<It, typename std::basic_string<T>::const_iterator>;
+            else
+                return false;
+        }
+
+        template<class It>
+        struct Contiguous<It, std::enable_if_t<!std::is_pointer_v<It>
+            && is_simd_type<typename std::iterator_traits<It>::value_type>>>
+        {
+            using value_type = typename std::iterator_traits<It>::value_type;
+
+            static constexpr bool value = std::is_same_v<It, typename std::vector<value_type>::iterator>
+                || std::is_same_v<It, typename std::vector<value_type>::const_iterator>
+                || is_string_iterator<It, value_type>();
+        };
+
+        template<class It>
+        constexpr bool is_contiguous = Contiguous<It>::value;
+
+        template<class It>
+        using Value_type = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+
+        // the element the iterator is at, it is not dereferenced when the range is empty
+        template<class It>
+        auto address(It it) { return std::addressof(*it); }
+
+        // std::equal_to compares like find, and it is in a system header, so a comparison of a
+        // signed element with an unsigned value does not warn
+        template<class V, class T>
+        bool representable(const T& value)
+        {
+            return std::equal_to<> {}(static_cast<V>(value), value);
+        }
+
+        template<class V>
+        std::uint64_t bits(V value)
+        {
+            std::uint64_t bits {0};
+            std::memcpy(&bits, &value, sizeof(V));
+            return bits;
+        }
+    }
+
+    template<class InputIt, class T>
+    InputIt find(InputIt first, InputIt last, const T& value)
+    {
+        if constexpr (detail::is_contiguous<InputIt> && std::is_integral_v<T>)
+        {
+            using V = detail::Value_type<InputIt>;
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n == 0 || !detail::representable<V>(value))
+                return last;
+            return first + detail::find(detail::address(first), n, sizeof(V), detail::bits(static_cast<V>(value)));
+        }
+        else
+            return std::find(first, last, value);
+    }
+
+    template<class InputIt, class T>
+    typename std::iterator_traits<InputIt>::difference_type count(InputIt first, InputIt last, const T& value)
+    {
+        if constexpr (detail::is_contiguous<InputIt> && std::is_integral_v<T>)
+        {
+            using V = detail::Value_type<InputIt>;
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            if (n == 0 || !detail::representable<V>(value))
+                return 0;
+            return static_cast<typename std::iterator_traits<InputIt>::difference_type>(
+                detail::count(detail::address(first), n, sizeof(V), detail::bits(static_cast<V>(value))));
+        }
+        else
+            return std::count(first, last, value);
+    }
+
+    template<class InputIt1, class InputIt2>
+    std::pair<InputIt1, InputIt2> mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
+    {
+        if constexpr (detail::is_contiguous<InputIt1> && detail::is_contiguous<InputIt2>
+            && std::is_same_v<detail::Value_type<InputIt1>, detail::Value_type<InputIt2>>)
+        {
+            const std::size_t n = static_cast<std::size_t>(std::min<std::ptrdiff_t>(last1 - first1, last2 - first2));
+            if (n == 0)
+                return {first1, first2};
+            const std::size_t size = sizeof(detail::Value_type<InputIt1>);
+            const std::size_t i = detail::mismatch(detail::address(first1), detail::address(first2), n * size) / size;
+            return {first1 + i, first2 + i};
+        }
+        else
+            return std::mismatch(first1, last1, first2, last2);
+    }
+
+    // the second range is as long as the first one
+    template<class InputIt1, class InputIt2>
+    std::pair<InputIt1, InputIt2> mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+    {
+        if constexpr (detail::is_contiguous<InputIt1> && detail::is_contiguous<InputIt2>)
+            return simd::mismatch(first1, last1, first2, first2 + (last1 - first1));
+        else
+            return std::mismatch(first1, last1, first2);
+    }
+
+    template<class InputIt1, class InputIt2>
+    bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
+    {
+        if constexpr (detail::is_contiguous<InputIt1> && detail::is_contiguous<InputIt2>
+            && std::is_same_v<detail::Value_type<InputIt1>, detail::Value_type<InputIt2>>)
+            return last1 - first1 == last2 - first2 && simd::mismatch(first1, last1, first2, last2).first == last1;
+        else
+            return std::equal(first1, last1, first2, last2);
+    }
+
+    template<class InputIt1, class InputIt2>
+    bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+    {
+        if constexpr (detail::is_contiguous<InputIt1> && detail::is_contiguous<InputIt2>)
+            return simd::equal(first1, last1, first2, first2 + (last1 - first1));
+        else
+            return std::equal(first1, last1, first2);
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+#include "Simd_algorithms.h"
+
+int main()
+{
+    std::cout << "instructions: " << simd::instruction_set() << '\n';
+
+    // a log, its lines are counted and the first error is found without a loop over the bytes
+    const std::string log {
+        "2024-05-01 10:00:01 INFO start\n"
+        "2024-05-01 10:00:02 INFO listening on 8080\n"
+        "2024-05-01 10:00:07 WARN slow request\n"
+        "2024-05-01 10:00:09 ERROR connection reset\n"
+        "2024-05-01 10:00:11 INFO retry\n"};
+    std::cout << "lines: " << simd::count(log.begin(), log.end(), '\n') << '\n';
+
+    const std::string error {"ERROR"};
+    for (auto line = log.begin(); line != log.end();)
+    {
+        auto end = simd::find(line, log.end(), '\n');
+        if (end - line > 25 && simd::equal(line + 20, line + 25, error.begin()))
+        {
+            std::cout << "first error: " << std::string(line, end) << '\n';
+            break;
+        }
+        line = end + 1;
+    }
+
+    // ints, and a value that no char is equal to, like with std::count
+    std::vector<int> v {1, 2, 3, 4, 4, 3, 7, 8, 9, 10};
+    for (const int target : {3, 4, 5})
+        std::cout << "number: " << target << ", count: " << simd::count(v.begin(), v.end(), target) << '\n';
+    std::cout << "300 in the log: " << simd::count(log.begin(), log.end(), 300) << '\n';
+
+    std::vector<std::uint64_t> a(1000, 7);
+    std::vector<std::uint64_t> b(a);
+    b[777] = 8;
+    std::cout << "first difference at: " << simd::mismatch(a.begin(), a.end(), b.begin()).first - a.begin() << '\n';
+
+    // a list is not contiguous, it runs std::find
+    std::list<int> l {5, 6, 7};
+    std::cout << "7 in the list: " << std::boolalpha << (simd::find(l.begin(), l.end(), 7) != l.end()) << '\n';
+
+    for (const char* name : {"avx512", "avx2", "sse2", "neon", "scalar"})
+        if (simd::use_instruction_set(name))
+            std::cout << name << ": " << simd::count(log.data(), log.data() + log.size(), 'I') << " I's\n";
+
+    return 0;
+}
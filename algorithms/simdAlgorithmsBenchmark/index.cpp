@@ -0,0 +1,124 @@
+/*
+
+    - compares the std algorithms against the ones of ../simdAlgorithms/Simd_algorithms.h on a
+      buffer of log lines, with each of the instruction sets the cpu has: count of the '\n', the
+      lines, find of a byte that is not in it, so all of it is looked at, mismatch and equal of
+      two copies that differ in the last byte, and count of an int in a vector of ints the
+      size of the buffer.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp ../simdAlgorithms/Simd_algorithms.cpp
+
+    - 256 MB by default, the number of bytes can be given on the command line, e.g.
+      ./a.out 10000000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simdAlgorithms/Simd_algorithms.h"
+
+struct Algorithms
+{
+    template <typename InputIt, typename T>
+    static auto count(InputIt first, InputIt last, const T& value) { return simd::count(first, last, value); }
+
+    template <typename InputIt, typename T>
+    static InputIt find(InputIt first, InputIt last, const T& value) { return simd::find(first, last, value); }
+
+    template <typename InputIt1, typename InputIt2>
+    static auto mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2) { return simd::mismatch(first1, last1, first2); }
+
+    template <typename InputIt1, typename InputIt2>
+    static bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) { return simd::equal(first1, last1, first2); }
+};
+
+struct Std_algorithms
+{
+    template <typename InputIt, typename T>
+    static auto count(InputIt first, InputIt last, const T& value) { return std::count(first, last, value); }
+
+    template <typename InputIt, typename T>
+    static InputIt find(InputIt first, InputIt last, const T& value) { return std::find(first, last, value); }
+
+    template <typename InputIt1, typename InputIt2>
+    static auto mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2) { return std::mismatch(first1, last1, first2); }
+
+    template <typename InputIt1, typename InputIt2>
+    static bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) { return std::equal(first1, last1, first2); }
+};
+
+std::string make_log(std::size_t n)
+{
+    const std::vector<std::string> levels {"INFO", "INFO", "INFO", "WARN", "ERROR"};
+    std::mt19937 rng {42};
+    std::string log;
+    log.reserve(n + 128);
+    while (log.size() < n)
+    {
+        log += "2024-05-01 10:00:";
+        log += std::to_string(10 + rng() % 50);
+        log += ' ';
+        log += levels[rng() % levels.size()];
+        log += " request ";
+        log += std::to_string(rng());
+        log += " took ";
+        log += std::to_string(rng() % 1000);
+        log += " ms\n";
+    }
+    log.resize(n);
+    return log;
+}
+
+template <typename F>
+double gb_per_second(std::size_t bytes, std::size_t& sum, F f)
+{
+    const int repeats = 5;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i)
+        sum += static_cast<std::size_t>(f());
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return bytes * repeats / seconds / 1e9;
+}
+
+template <typename A>
+void run(const std::string& name, const std::string& log, const std::string& copy, const std::vector<int>& ints)
+{
+    std::size_t sum {0};
+    const std::size_t n = log.size();
+    std::cout << std::setw(12) << std::left << name << std::fixed << std::setprecision(2) << std::right
+        << std::setw(10) << gb_per_second(n, sum, [&] { return A::count(log.begin(), log.end(), '\n'); })
+        << std::setw(10) << gb_per_second(n, sum, [&] { return A::find(log.begin(), log.end(), '\x01') - log.begin(); })
+        << std::setw(10) << gb_per_second(2 * n, sum, [&] { return A::mismatch(log.begin(), log.end(), copy.begin()).first - log.begin(); })
+        << std::setw(10) << gb_per_second(2 * n, sum, [&] { return A::equal(log.begin(), log.end(), copy.begin()); })
+        << std::setw(10) << gb_per_second(ints.size() * sizeof(int), sum, [&] { return A::count(ints.begin(), ints.end(), 7); })
+        << "    " << sum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256'000'000;
+
+    const std::string log = make_log(n);
+    std::string copy = log;
+    copy.back() = '!';
+    std::vector<int> ints(n / sizeof(int));
+    std::mt19937 rng {7};
+    for (int& i : ints)
+        i = static_cast<int>(rng() % 16);
+
+    std::cout << n << " bytes, GB/s of count '\\n', find, mismatch, equal, count of ints" << std::endl;
+    run<Std_algorithms>("std", log, copy, ints);
+    for (const char* name : {"scalar", "sse2", "neon", "avx2", "avx512"})
+        if (simd::use_instruction_set(name))
+            run<Algorithms>(name, log, copy, ints);
+
+    return 0;
+}
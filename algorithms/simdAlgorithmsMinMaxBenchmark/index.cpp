@@ -0,0 +1,143 @@
+/*
+
+    - compares the std loops against the reductions of ../simdAlgorithms/Min_max.h on a vector
+      of random ints: std::minmax_element against simd::min_max, std::min_element against
+      simd::argmin, and std::clamp of every element against simd::clamp_all.
+
+    - before that, short ranges of ints, chars and doubles, of 0 to 200 elements, with NaNs
+      among the doubles, have to give the results of std::min_element, std::max_element and
+      std::clamp, the same value and the same position, a mismatch is reported and the exit code is 1.
+
+    - the times are the medians of ../benchmarkHarness/Benchmark_harness.h, a warm up and 5 runs.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+      or with -march=x86-64-v3 for the AVX2 registers.
+
+    - 100M ints by default, 400 MB, the number can be given on the command line, e.g.
+      ./a.out 1000000000 for 1B ints, 4 GB, and 8 more for the copies of the clamp.
+
+    - on one core of an x86-64 at -O2, 100M ints, GB/s of std and simd, clamp reads and writes:
+                                        -O2             -march=x86-64-v3
+        minmax_element and min_max      0.46    2.3     0.45    3.5
+        min_element and argmin          0.57    1.0     0.62    3.2
+        std::clamp and clamp_all        3.8     6.0     2.6     9.0
+      5 to 8 times minmax_element, 2 to 5 times min_element, and clamp_all 1.6 to 3.5 times
+      std::clamp, nearer the bandwidth of the memory. SSE2 has no
+      min of 32 bit ints, a compare and a blend of three instructions for each, so min_max
+      and argmin, two passes, are bound by the instructions at -O2 and much less with the
+      pminsd and pmaxsd of AVX2.
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../simdAlgorithms/Min_max.h"
+#include "../fastRandom/Fast_random.h"
+
+const bench::Options options {1, 5};
+
+bool same(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+template<class T>
+std::size_t check(const std::vector<T>& v)
+{
+    std::size_t mismatches = 0;
+    if (v.empty())
+    {
+        mismatches += simd::argmin(v.begin(), v.end()) != v.end() || simd::argmax(v.begin(), v.end()) != v.end();
+        return mismatches;
+    }
+    // the values of min_element and max_element, minmax_element compares the elements in pairs
+    // first, a NaN is not skipped the same way
+    const auto [min, max] = simd::min_max(v);
+    mismatches += !same(static_cast<double>(min), static_cast<double>(*std::min_element(v.begin(), v.end())));
+    mismatches += !same(static_cast<double>(max), static_cast<double>(*std::max_element(v.begin(), v.end())));
+    mismatches += simd::argmin(v) != static_cast<std::size_t>(std::min_element(v.begin(), v.end()) - v.begin());
+    mismatches += simd::argmax(v) != static_cast<std::size_t>(std::max_element(v.begin(), v.end()) - v.begin());
+
+    std::vector<T> clamped(v), expected_clamped(v);
+    const T lo = v[v.size() / 3], hi = v[v.size() / 2];
+    if (!(hi < lo) && lo == lo && hi == hi)
+    {
+        simd::clamp_all(clamped, lo, hi);
+        for (T& x : expected_clamped)
+            x = std::clamp(x, lo, hi);
+        for (std::size_t i = 0; i < v.size(); ++i)
+            mismatches += !same(static_cast<double>(clamped[i]), static_cast<double>(expected_clamped[i]));
+    }
+    return mismatches;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+    fast_random::Xoshiro256ss gen {2024};
+
+    std::size_t mismatches = 0;
+    for (std::size_t size = 0; size <= 200; ++size)
+        for (int round = 0; round < 20; ++round)
+        {
+            std::vector<int> ints(size);
+            std::vector<signed char> chars(size);
+            std::vector<double> doubles(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                ints[i] = static_cast<int>(fast_random::bounded(gen, 1000)) - 500;
+                chars[i] = static_cast<signed char>(fast_random::bounded(gen, 256) - 128);
+                doubles[i] = fast_random::bounded(gen, 50) == 0 ? std::numeric_limits<double>::quiet_NaN()
+                    : static_cast<double>(fast_random::bounded(gen, 100)) / 4 - 10;
+            }
+            mismatches += check(ints) + check(chars) + check(doubles);
+        }
+
+    std::vector<int> v(n);
+    for (int& x : v)
+        x = static_cast<int>(gen());
+    const double bytes = static_cast<double>(n * sizeof(int));
+    bench::Perf_events events;
+
+    std::pair<int, int> expected, result;
+    const double minmax_std = bytes / bench::measure("min and max", "std::minmax_element", n, options, events, [&] {
+        const auto it = std::minmax_element(v.begin(), v.end());
+        expected = {*it.first, *it.second};
+    }).median_ns;
+    const double minmax_simd = bytes / bench::measure("min and max", "simd::min_max", n, options, events, [&] { result = simd::min_max(v); }).median_ns;
+    mismatches += result != expected;
+
+    std::size_t expected_at = 0, at = 0;
+    const double argmin_std = bytes / bench::measure("argmin", "std::min_element", n, options, events, [&] {
+        expected_at = static_cast<std::size_t>(std::min_element(v.begin(), v.end()) - v.begin());
+    }).median_ns;
+    const double argmin_simd = bytes / bench::measure("argmin", "simd::argmin", n, options, events, [&] { at = simd::argmin(v); }).median_ns;
+    mismatches += at != expected_at;
+
+    // every run clamps a fresh copy, the ints of a clamped one are all in the range
+    std::vector<int> copy(n), simd_copy(n);
+    const int lo = -1'000'000'000, hi = 1'000'000'000;
+    const double clamp_std = 2 * bytes / bench::measure("clamp", "std::clamp", n, options, events, [&] { copy = v; }, [&] {
+        for (int& x : copy)
+            x = std::clamp(x, lo, hi);
+    }).median_ns;
+    const double clamp_simd = 2 * bytes / bench::measure("clamp", "simd::clamp_all", n, options, events, [&] { simd_copy = v; },
+        [&] { simd::clamp_all(simd_copy, lo, hi); }).median_ns;
+    mismatches += simd_copy != copy;
+
+    std::cout << n << " ints, GB/s, std and simd:" << '\n' << std::fixed << std::setprecision(2)
+              << std::setw(36) << std::left << "minmax_element and min_max" << std::right << std::setw(8) << minmax_std << std::setw(8) << minmax_simd << '\n'
+              << std::setw(36) << std::left << "min_element and argmin" << std::right << std::setw(8) << argmin_std << std::setw(8) << argmin_simd << '\n'
+              << std::setw(36) << std::left << "std::clamp and clamp_all" << std::right << std::setw(8) << clamp_std << std::setw(8) << clamp_simd << '\n';
+    std::cout << "mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#ifndef _RADIX_SORT_H_
+#define _RADIX_SORT_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - radix_sort sorts a contiguous range, a std::vector, a std::array, a pointer, ..., of
+      integers or floating point numbers by the bytes of their values, a byte at a time from
+      the lowest one, LSD: every pass moves the elements to a buffer in the order of the byte,
+      keeping the order of the pass before for the same byte, so after the last pass they are
+      in order. the counts of every byte of every pass are made in one pass first, and a pass
+      where all the elements have the same byte is skipped, so ints of 0 to 65535 take 2
+      passes, not 4.
+
+    - the values are made unsigned integers that are in the same order: the sign bit of a
+      signed one is flipped, a negative floating point number has all its bits flipped and a
+      positive one only its sign bit, -0.0 is before 0.0, a NaN with the sign bit after all the
+      other ones, -NaN before them.
+
+    - radix_sort(first, last, key) sorts records by a key that key(record) gives, an integer
+      or a floating point number, e.g. the age of a Person, and keeps the order of the
+      records with the same key, like std::stable_sort. small trivially copyable records are
+      moved every pass, the other ones are sorted as pairs of their key and their index, and
+      moved once at the end.
+
+    - less than 256 elements are sorted with std::sort, or std::stable_sort for the records.
+
+*/
+namespace sorting
+{
+    inline constexpr std::size_t radix_threshold {256};
+
+    namespace detail
+    {
+        template<std::size_t size>
+        struct Unsigned_of;
+
+        template<> struct Unsigned_of<1> { using type = std::uint8_t; };
+        template<> struct Unsigned_of<2> { using type = std::uint16_t; };
+        template<> struct Unsigned_of<4> { using type = std::uint32_t; };
+        template<> struct Unsigned_of<8> { using type = std::uint64_t; };
+
+        template<class K>
+        using Unsigned_key = typename Unsigned_of<sizeof(K)>::type;
+
+        template<class K>
+        constexpr bool is_radix_key = (std::is_integral_v<K> && !std::is_same_v<K, bool>)
+            || (std::is_floating_point_v<K> && std::numeric_limits<K>::is_iec559 && sizeof(K) <= 8);
+
+        // an unsigned integer in the order of the key
+        template<class K>
+        Unsigned_key<K> ordered_bits(K key)
+        {
+            using U = Unsigned_key<K>;
+            constexpr U sign = U {1} << (sizeof(K) * 8 - 1);
+            if constexpr (std::is_floating_point_v<K>)
+            {
+                U bits;
+                std::memcpy(&bits, &key, sizeof(K));
+                return (bits & sign) != 0 ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+            }
+            else if constexpr (std::is_signed_v<K>)
+                return static_cast<U>(static_cast<U>(key) ^ sign);
+            else
+                return static_cast<U>(key);
+        }
+
+        // sorts the n items of data by bits(item), false when they end up in data, true in buffer
+        template<class U, class T, class Bits>
+        bool lsd(T* data, T* buffer, std::size_t n, const Bits& bits)
+        {
+            constexpr std::size_t passes = sizeof(U);
+            std::vector<std::array<std::size_t, 256>> counts(passes);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const U b = bits(data[i]);
+                for (std::size_t pass = 0; pass < passes; ++pass)
+                    ++counts[pass][(b >> (pass * 8)) & 0xFF];
+            }
+
+            T* from = data;
+            T* to = buffer;
+            for (std::size_t pass = 0; pass < passes; ++pass)
+            {
+                std::array<std::size_t, 256>& offsets = counts[pass];
+                if (std::find(offsets.begin(), offsets.end(), n) != offsets.end())
+                    continue;
+                std::size_t offset {0};
+                for (std::size_t& count : offsets)
+                    offset += std::exchange(count, offset);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const std::size_t byte = (bits(from[i]) >> (pass * 8)) & 0xFF;
+                    to[offsets[byte]++] = std::move(from[i]);
+                }
+                std::swap(from, to);
+            }
+            return from != data;
+        }
+    }
+
+    template<class RandomIt>
+    void radix_sort(RandomIt first, RandomIt last)
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        static_assert(detail::is_radix_key<T>, "radix_sort sorts integers and floating point numbers");
+
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (n < radix_threshold)
+        {
+            std::sort(first, last);
+            return;
+        }
+        T* data = std::addressof(*first);
+        std::vector<T> buffer(n);
+        if (detail::lsd<detail::Unsigned_key<T>>(data, buffer.data(), n, [](T value) { return detail::ordered_bits(value); }))
+            std::copy(buffer.begin(), buffer.end(), data);
+    }
+
+    template<class RandomIt, class Key>
+    void radix_sort(RandomIt first, RandomIt last, Key key)
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        using K = std::decay_t<std::invoke_result_t<Key&, const T&>>;
+        using U = detail::Unsigned_key<K>;
+        static_assert(detail::is_radix_key<K>, "the key is an integer or a floating point number");
+
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (n < radix_threshold)
+        {
+            std::stable_sort(first, last, [&key](const T& a, const T& b) { return std::invoke(key, a) < std::invoke(key, b); });
+            return;
+        }
+
+        const auto bits = [&key](const T& item) { return detail::ordered_bits(static_cast<K>(std::invoke(key, item))); };
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && sizeof(T) <= 16)
+        {
+            T* data = std::addressof(*first);
+            std::vector<T> buffer(n);
+            if (detail::lsd<U>(data, buffer.data(), n, bits))
+                std::copy(buffer.begin(), buffer.end(), data);
+        }
+        else
+        {
+            struct Entry
+            {
+                U key;
+                std::size_t index;
+            };
+            std::vector<Entry> entries(n);
+            for (std::size_t i = 0; i < n; ++i)
+                entries[i] = Entry {bits(first[i]), i};
+            std::vector<Entry> buffer(n);
+            const std::vector<Entry>& sorted = detail::lsd<U>(entries.data(), buffer.data(), n, [](const Entry& entry) { return entry.key; })
+                ? buffer : entries;
+
+            std::vector<T> records;
+            records.reserve(n);
+            for (const Entry& entry : sorted)
+                records.push_back(std::move(first[entry.index]));
+            std::move(records.begin(), records.end(), first);
+        }
+    }
+}
+
+#endif
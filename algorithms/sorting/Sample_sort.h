@@ -0,0 +1,115 @@
+#ifndef _SAMPLE_SORT_H_
+#define _SAMPLE_SORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+/*
+
+    - sample_sort sorts a range with any comparator on the threads of a Work_stealing_pool,
+      with the policies of ../parallelAlgorithms/Parallel_algorithms.h: parallel::seq runs
+      std::sort, parallel::par and parallel::par_unseq split the range in buckets.
+
+    - a sample of 32 elements for every bucket, taken at random with a seed that is the size
+      of the range, so a sort of the same range splits it the same way every time, is sorted
+      and every 32nd one of them is a splitter. the chunks of the range find the bucket of
+      their elements with a binary search of the splitters, count them, and move them to
+      their bucket in a buffer, then every bucket is sorted with std::sort and moved back, as
+      tasks of the pool.
+
+    - there are up to 8 buckets for every thread of the pool, at most 256, so the bucket of
+      an element is one byte. equal elements go to the same bucket, a range of a few
+      different values has a few big buckets that take longer.
+
+    - a range of less than sample_sort_threshold elements, a pool of one thread, or elements
+      that are not default constructible, for the buffer, run std::sort. like std::sort the
+      order of equal elements is not kept.
+
+*/
+namespace sorting
+{
+    inline constexpr std::size_t sample_sort_threshold {1 << 16};
+
+    template<class Policy, class RandomIt, class Compare = std::less<>>
+    void sample_sort(Policy&& policy, RandomIt first, RandomIt last, Compare comp = {})
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        if constexpr (!parallel::detail::is_parallel<Policy, RandomIt> || !std::is_default_constructible_v<T>)
+            std::sort(first, last, comp);
+        else
+        {
+            constexpr std::size_t oversampling = 32;
+            Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            const std::size_t buckets = std::min<std::size_t>({256, pool.size() * 8, n / oversampling});
+            if (n < sample_sort_threshold || buckets < 2)
+            {
+                std::sort(first, last, comp);
+                return;
+            }
+
+            std::mt19937_64 random {n};
+            std::vector<T> sample;
+            sample.reserve(buckets * oversampling);
+            for (std::size_t i = 0; i < buckets * oversampling; ++i)
+                sample.push_back(first[random() % n]);
+            std::sort(sample.begin(), sample.end(), comp);
+            std::vector<T> splitters;
+            for (std::size_t i = 1; i < buckets; ++i)
+                splitters.push_back(std::move(sample[i * oversampling]));
+
+            // the bucket of every element, and how many of every bucket every chunk has
+            const std::size_t chunks = parallel::detail::num_chunks(pool, n);
+            std::vector<std::uint8_t> bucket_of(n);
+            std::vector<std::size_t> offsets(chunks * buckets);
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                std::size_t* counts = offsets.data() + chunk * buckets;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const std::size_t bucket = std::upper_bound(splitters.begin(), splitters.end(), first[i], comp) - splitters.begin();
+                    bucket_of[i] = static_cast<std::uint8_t>(bucket);
+                    ++counts[bucket];
+                }
+            });
+
+            // the buckets one after the other, in a bucket the elements of the chunks in order
+            std::vector<std::size_t> bucket_begin(buckets + 1);
+            std::size_t offset {0};
+            for (std::size_t bucket = 0; bucket < buckets; ++bucket)
+            {
+                bucket_begin[bucket] = offset;
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                    offset += std::exchange(offsets[chunk * buckets + bucket], offset);
+            }
+            bucket_begin[buckets] = n;
+
+            std::vector<T> buffer(n);
+            parallel::detail::for_chunks(pool, n, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                std::size_t* next = offsets.data() + chunk * buckets;
+                for (std::size_t i = begin; i < end; ++i)
+                    buffer[next[bucket_of[i]]++] = std::move(first[i]);
+            });
+
+            parallel::detail::for_chunks(pool, buckets, buckets, [&](std::size_t bucket, std::size_t, std::size_t)
+            {
+                const auto begin = buffer.begin() + bucket_begin[bucket];
+                const auto end = buffer.begin() + bucket_begin[bucket + 1];
+                std::sort(begin, end, comp);
+                std::move(begin, end, first + bucket_begin[bucket]);
+            });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+
+    - build it together with the pool of ../parallelAlgorithms:
+        g++ -std=c++17 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+*/
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "Radix_sort.h"
+#include "Sample_sort.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+class Person
+{
+    friend std::ostream& operator<<(std::ostream& os, const Person& p);
+
+private:
+    std::string name;
+    int age;
+
+public:
+    Person(std::string name, int age) : name(name), age(age) {}
+
+    const std::string& get_name() const { return this->name; }
+    int get_age() const { return this->age; }
+};
+
+std::ostream& operator<<(std::ostream& os, const Person& p)
+{
+    os << p.name << ":" << p.age;
+    return os;
+}
+
+template <typename T>
+void print(const std::vector<T>& values)
+{
+    for (const T& value : values)
+        std::cout << value << ' ';
+    std::cout << '\n';
+}
+
+int main()
+{
+    std::vector<int> ints {503, 87, -512, 61, 908, 170, -897, 275, 653, 426, 154, 509, -612, 677, 765, 703};
+    sorting::radix_sort(ints.begin(), ints.end());
+    print(ints);
+
+    // more than radix_threshold elements, the bytes are looked at
+    std::vector<double> doubles(1000);
+    std::mt19937 gen {1};
+    std::normal_distribution<double> normal {0.0, 100.0};
+    for (double& d : doubles)
+        d = normal(gen);
+    sorting::radix_sort(doubles.begin(), doubles.end());
+    std::cout << "1000 doubles: " << doubles.front() << " .. " << doubles.back()
+              << ", sorted: " << std::boolalpha << std::is_sorted(doubles.begin(), doubles.end()) << '\n';
+
+    // the people by age, Moe and Larry are both 30 and stay in their order
+    std::vector<Person> people {{"Larry", 30}, {"Curly", 25}, {"Moe", 30}, {"Shemp", 18}};
+    sorting::radix_sort(people.begin(), people.end(), [](const Person& p) { return p.get_age(); });
+    print(people);
+
+    // a million words with a comparator, on the threads of the default pool
+    std::vector<std::string> words(1'000'000);
+    for (std::string& word : words)
+        word = std::to_string(gen() % 100'000);
+    std::vector<std::string> copy {words};
+    sorting::sample_sort(parallel::par, words.begin(), words.end(), std::greater<> {});
+    std::sort(copy.begin(), copy.end(), std::greater<> {});
+    std::cout << "threads: " << parallel::default_pool().size() << ", the same as std::sort: " << (words == copy)
+              << ", first: " << words.front() << ", last: " << words.back() << '\n';
+
+    Work_stealing_pool pool {3};
+    std::vector<int> numbers(200'000);
+    std::iota(numbers.rbegin(), numbers.rend(), 0);
+    sorting::sample_sort(parallel::par.on(pool), numbers.begin(), numbers.end());
+    std::cout << "on a pool of " << pool.size() << ": " << numbers[0] << ' ' << numbers[1] << " .. " << numbers.back() << '\n';
+
+    return 0;
+}
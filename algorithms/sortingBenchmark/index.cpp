@@ -0,0 +1,130 @@
+/*
+
+    - compares std::sort against the sorts of ../sorting: radix_sort of random ints and
+      doubles, radix_sort by a key of records, with std::stable_sort for the same order, and
+      sample_sort with par on pools of 1, 2, 4, ... threads, up to twice the cores, of the ints
+      with std::greater, and checks that they give the same results.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 1'000'000, 10'000'000 and 100'000'000 elements by default, the biggest number can be
+      given on the command line, e.g. ./a.out 1000000000, 1e9 takes about 12 GB, the doubles,
+      a copy of them and the buffer of the sort.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+#include "../sorting/Radix_sort.h"
+#include "../sorting/Sample_sort.h"
+
+struct Record
+{
+    std::uint32_t id;
+    std::int32_t age;
+};
+
+bool operator==(const Record& a, const Record& b)
+{
+    return a.id == b.id && a.age == b.age;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ns per element of sort(copy of values), and if it is the same as expected
+template <typename T, typename Sort>
+void run(const std::string& name, const std::vector<T>& values, const std::vector<T>& expected, Sort sort)
+{
+    std::vector<T> copy {values};
+    const auto start = std::chrono::steady_clock::now();
+    sort(copy);
+    const double seconds = seconds_since(start);
+    std::cout << std::setw(32) << std::left << name << std::fixed << std::setprecision(2)
+        << std::setw(10) << std::right << seconds * 1e9 / values.size()
+        << (copy == expected ? "" : "    WRONG") << std::endl;
+}
+
+template <typename T, typename Less>
+std::vector<T> std_sorted(const std::vector<T>& values, Less less, bool stable = false)
+{
+    std::vector<T> sorted {values};
+    const auto start = std::chrono::steady_clock::now();
+    if (stable)
+        std::stable_sort(sorted.begin(), sorted.end(), less);
+    else
+        std::sort(sorted.begin(), sorted.end(), less);
+    std::cout << std::setw(32) << std::left << (stable ? "std::stable_sort" : "std::sort") << std::fixed << std::setprecision(2)
+        << std::setw(10) << std::right << seconds_since(start) * 1e9 / values.size() << std::endl;
+    return sorted;
+}
+
+void benchmark(std::size_t n)
+{
+    std::mt19937_64 gen {n};
+    std::cout << '\n' << n << " elements, ns per element" << std::endl;
+    {
+        std::vector<std::int32_t> ints(n);
+        for (std::int32_t& i : ints)
+            i = static_cast<std::int32_t>(gen());
+
+        std::cout << "ints:" << std::endl;
+        const std::vector<std::int32_t> sorted = std_sorted(ints, std::less<> {});
+        run("radix_sort", ints, sorted, [](std::vector<std::int32_t>& v) { sorting::radix_sort(v.begin(), v.end()); });
+
+        std::cout << "ints, std::greater:" << std::endl;
+        const std::vector<std::int32_t> descending = std_sorted(ints, std::greater<> {});
+        const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t threads = 1; threads <= 2 * cores; threads *= 2)
+        {
+            Work_stealing_pool pool {threads - 1};
+            run("sample_sort, " + std::to_string(threads) + " threads", ints, descending, [&pool](std::vector<std::int32_t>& v) {
+                sorting::sample_sort(parallel::par.on(pool), v.begin(), v.end(), std::greater<> {});
+            });
+        }
+    }
+    {
+        std::vector<double> doubles(n);
+        std::normal_distribution<double> normal {0.0, 1e6};
+        for (double& d : doubles)
+            d = normal(gen);
+
+        std::cout << "doubles:" << std::endl;
+        const std::vector<double> sorted = std_sorted(doubles, std::less<> {});
+        run("radix_sort", doubles, sorted, [](std::vector<double>& v) { sorting::radix_sort(v.begin(), v.end()); });
+    }
+    {
+        std::vector<Record> records(n);
+        for (std::size_t i = 0; i < n; ++i)
+            records[i] = Record {static_cast<std::uint32_t>(i), static_cast<std::int32_t>(gen() % 100)};
+
+        std::cout << "records by age:" << std::endl;
+        const std::vector<Record> sorted = std_sorted(records, [](const Record& a, const Record& b) { return a.age < b.age; }, true);
+        run("radix_sort by age", records, sorted, [](std::vector<Record>& v) {
+            sorting::radix_sort(v.begin(), v.end(), [](const Record& r) { return r.age; });
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t max = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000'000;
+
+    for (std::size_t n = 1'000'000; n <= max; n *= 10)
+        benchmark(n);
+
+    return 0;
+}
@@ -0,0 +1,297 @@
+#ifndef _WINDOWS_H_
+#define _WINDOWS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+
+    - aggregates of a stream of events in windows of time, updated in O(1) an event, none of
+      them rescans the events of the window: the withdrawals of an account in the last 24
+      hours, the largest one in the last hour, the deposits of the day. times are integers,
+      seconds or any other unit, the width of a window is in the same unit.
+
+    - an operation is a struct of identity() and combine(a, b), associative, Sum, Min and
+      Max are the ones here. Sum can also take a value back out, the others cannot, which is
+      what decides the window that fits them.
+
+    - Tumbling: windows one after the other, [k * width, (k + 1) * width), the aggregate of
+      the current one, a time past its end starts the next one, any operation.
+
+    - Two_stack: the sliding window (now - width, now] over the events themselves, exact, for
+      any operation: the new events go on a back stack with the aggregate of all of it, the
+      old ones are popped from a front stack that has the aggregate of every event above it,
+      when it is empty the back stack is moved over, every event is moved once, O(1)
+      amortized, and the aggregate is the one of the two tops. the times of the events do
+      not go down.
+
+    - Sliding_sums: sliding sums for many keys, one an account, in num_buckets buckets of
+      width / num_buckets each in a ring, a running total a key, an event adds to its bucket
+      and to the total, a bucket that leaves the window is subtracted from the total and
+      cleared, subtract on evict. the memory is fixed, num_buckets values a key, the window
+      is the buckets of the last width, the one of now included, which is between
+      width - bucket width and width of the events before now, 24 buckets of an hour for a
+      day is the usual one. the buckets, heads and totals are arrays of all the keys,
+      contiguous, for batches and checkpoints. T needs T{}, += and -=, an arithmetic type or
+      a struct of them.
+
+*/
+namespace windows
+{
+    template<class T>
+    struct Sum
+    {
+        static T identity() { return T {}; }
+        static T combine(const T& a, const T& b) { return a + b; }
+    };
+
+    template<class T>
+    struct Min
+    {
+        static T identity() { return std::numeric_limits<T>::max(); }
+        static T combine(const T& a, const T& b) { return std::min(a, b); }
+    };
+
+    template<class T>
+    struct Max
+    {
+        static T identity() { return std::numeric_limits<T>::lowest(); }
+        static T combine(const T& a, const T& b) { return std::max(a, b); }
+    };
+
+    // floor(time / width), for negative times too
+    inline std::int64_t floor_div(std::int64_t time, std::int64_t width)
+    {
+        const std::int64_t q = time / width;
+        return q * width > time ? q - 1 : q;
+    }
+
+    inline void check_width(std::int64_t width)
+    {
+        if (width <= 0)
+            throw std::invalid_argument {"the width of a window has to be positive"};
+    }
+
+    template<class T, class Op = Sum<T>>
+    class Tumbling
+    {
+    private:
+        std::int64_t width;
+        std::int64_t start {std::numeric_limits<std::int64_t>::min()};
+        T aggregate {Op::identity()};
+        std::size_t count {0};
+
+    public:
+        explicit Tumbling(std::int64_t width) : width(width)
+        {
+            check_width(width);
+        }
+
+        // true when the event starts a new window, and the one before it is over
+        bool add(std::int64_t time, const T& value)
+        {
+            const std::int64_t window = floor_div(time, this->width) * this->width;
+            const bool next = window != this->start;
+            if (next)
+            {
+                this->start = window;
+                this->aggregate = Op::identity();
+                this->count = 0;
+            }
+            this->aggregate = Op::combine(this->aggregate, value);
+            ++this->count;
+            return next;
+        }
+
+        // the aggregate of the window of time, the identity when no event is in it
+        T get(std::int64_t time) const
+        {
+            return floor_div(time, this->width) * this->width == this->start ? this->aggregate : Op::identity();
+        }
+
+        std::int64_t get_start() const { return this->start; }
+        std::size_t size() const { return this->count; }
+    };
+
+    template<class T, class Op = Sum<T>>
+    class Two_stack
+    {
+    private:
+        struct Entry
+        {
+            std::int64_t time;
+            T value;
+            T aggregate;
+        };
+
+        std::int64_t width;
+        std::int64_t last {std::numeric_limits<std::int64_t>::min()};
+        // the oldest on top, its aggregate is of the entries above it and itself
+        std::vector<Entry> front;
+        // the newest on top, its aggregate is of the whole stack
+        std::vector<Entry> back;
+
+        void flip()
+        {
+            for (auto it = this->back.rbegin(); it != this->back.rend(); ++it)
+            {
+                const T above = this->front.empty() ? Op::identity() : this->front.back().aggregate;
+                this->front.push_back({it->time, it->value, Op::combine(it->value, above)});
+            }
+            this->back.clear();
+        }
+
+    public:
+        explicit Two_stack(std::int64_t width) : width(width)
+        {
+            check_width(width);
+        }
+
+        void push(std::int64_t time, const T& value)
+        {
+            if (time < this->last)
+                throw std::invalid_argument {"the events of a Two_stack window have to come in the order of time"};
+            this->evict(time);
+            this->last = time;
+            const T below = this->back.empty() ? Op::identity() : this->back.back().aggregate;
+            this->back.push_back({time, value, Op::combine(below, value)});
+        }
+
+        // drops the events at now - width or before
+        void evict(std::int64_t now)
+        {
+            const std::int64_t edge = now - this->width;
+            for (;;)
+            {
+                if (this->front.empty())
+                {
+                    if (this->back.empty() || this->back.front().time > edge)
+                        return;
+                    this->flip();
+                }
+                if (this->front.back().time > edge)
+                    return;
+                this->front.pop_back();
+            }
+        }
+
+        // the aggregate of the events in (now - width, now]
+        T get(std::int64_t now)
+        {
+            this->evict(now);
+            const T older = this->front.empty() ? Op::identity() : this->front.back().aggregate;
+            const T newer = this->back.empty() ? Op::identity() : this->back.back().aggregate;
+            return Op::combine(older, newer);
+        }
+
+        std::size_t size() const { return this->front.size() + this->back.size(); }
+    };
+
+    template<class T>
+    class Sliding_sums
+    {
+    private:
+        static constexpr std::int64_t none {std::numeric_limits<std::int64_t>::min()};
+
+        std::int64_t bucket_width;
+        std::size_t num_buckets;
+        std::vector<T> buckets;          // num_buckets a key
+        std::vector<T> totals;           // a key
+        std::vector<std::int64_t> heads; // the bucket number of the newest bucket of a key, none before the first event
+
+        std::size_t slot_of(std::int64_t bucket) const
+        {
+            const std::int64_t n = static_cast<std::int64_t>(this->num_buckets);
+            return static_cast<std::size_t>((bucket % n + n) % n);
+        }
+
+        // the buckets that left the window by time are taken out of the total
+        void advance(std::size_t key, std::int64_t bucket)
+        {
+            std::int64_t& head = this->heads[key];
+            if (head != none && bucket <= head)
+                return;
+            T* first = this->buckets.data() + key * this->num_buckets;
+            if (head == none || bucket - head >= static_cast<std::int64_t>(this->num_buckets))
+            {
+                std::fill(first, first + this->num_buckets, T {});
+                this->totals[key] = T {};
+            }
+            else
+                for (std::int64_t b = head + 1; b <= bucket; ++b)
+                {
+                    T& old = first[this->slot_of(b)];
+                    this->totals[key] -= old;
+                    old = T {};
+                }
+            head = bucket;
+        }
+
+    public:
+        Sliding_sums(std::int64_t width, std::size_t num_buckets, std::size_t num_keys = 0)
+            : bucket_width(num_buckets == 0 ? 0 : width / static_cast<std::int64_t>(num_buckets)), num_buckets(num_buckets)
+        {
+            check_width(width);
+            if (num_buckets == 0 || width % static_cast<std::int64_t>(num_buckets) != 0)
+                throw std::invalid_argument {"the width of a window has to be a multiple of its buckets"};
+            this->resize(num_keys);
+        }
+
+        // new keys have empty windows
+        void resize(std::size_t num_keys)
+        {
+            this->buckets.resize(num_keys * this->num_buckets);
+            this->totals.resize(num_keys);
+            this->heads.resize(num_keys, none);
+        }
+
+        // false when time is before the window of the newest event of the key, nothing is added
+        bool add(std::size_t key, std::int64_t time, const T& value)
+        {
+            const std::int64_t bucket = floor_div(time, this->bucket_width);
+            this->advance(key, bucket);
+            if (bucket <= this->heads[key] - static_cast<std::int64_t>(this->num_buckets))
+                return false;
+            this->buckets[key * this->num_buckets + this->slot_of(bucket)] += value;
+            this->totals[key] += value;
+            return true;
+        }
+
+        // the sum of the window of the key at time, moves its window up to time
+        const T& get(std::size_t key, std::int64_t time)
+        {
+            this->advance(key, floor_div(time, this->bucket_width));
+            return this->totals[key];
+        }
+
+        // the sum as of the newest event of the key, without moving its window
+        const T& get(std::size_t key) const { return this->totals[key]; }
+
+        // the arrays, to write them out, and to read them back with assign, the totals are the sums of the buckets
+        const std::vector<T>& get_buckets() const { return this->buckets; }
+        const std::vector<std::int64_t>& get_heads() const { return this->heads; }
+
+        void assign(std::vector<T> buckets, std::vector<std::int64_t> heads)
+        {
+            if (buckets.size() != heads.size() * this->num_buckets)
+                throw std::invalid_argument {"the buckets are not num_buckets a key"};
+            this->buckets = std::move(buckets);
+            this->heads = std::move(heads);
+            this->totals.assign(this->heads.size(), T {});
+            for (std::size_t key = 0; key < this->heads.size(); ++key)
+                for (std::size_t i = 0; i < this->num_buckets; ++i)
+                    this->totals[key] += this->buckets[key * this->num_buckets + i];
+        }
+
+        std::int64_t get_width() const { return this->bucket_width * static_cast<std::int64_t>(this->num_buckets); }
+        std::size_t get_num_buckets() const { return this->num_buckets; }
+        std::size_t size() const { return this->heads.size(); }
+    };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "Windows.h"
+
+struct Event
+{
+    std::int64_t time;    // seconds
+    std::size_t account;
+    std::int64_t cents;
+};
+
+int main()
+{
+    constexpr std::int64_t hour {3600};
+    constexpr std::int64_t day {24 * hour};
+    const std::vector<Event> events {
+        {0, 0, 10000}, {2 * hour, 1, 2500}, {5 * hour, 0, 40000}, {20 * hour, 0, 5000},
+        {23 * hour, 1, 7500}, {25 * hour, 0, 1000}, {30 * hour, 0, 2000}, {50 * hour, 1, 100}};
+
+    // the withdrawals of every account in the last day, in buckets of an hour
+    windows::Sliding_sums<std::int64_t> withdrawn {day, 24, 2};
+    // the largest withdrawal of the last 6 hours, and the total of every calendar day
+    windows::Two_stack<std::int64_t, windows::Max<std::int64_t>> largest {6 * hour};
+    windows::Tumbling<std::int64_t> daily {day};
+
+    for (const Event& event : events)
+    {
+        withdrawn.add(event.account, event.time, event.cents);
+        largest.push(event.time, event.cents);
+        if (daily.add(event.time, event.cents) && event.time != 0)
+            std::cout << "day " << daily.get_start() / day << " starts" << '\n';
+        std::cout << "hour " << event.time / hour << ": account " << event.account << " withdrew "
+                  << withdrawn.get(event.account) << " cents in the last day, the largest of 6 hours "
+                  << largest.get(event.time) << ", the day so far " << daily.get(event.time) << '\n';
+    }
+
+    // a query moves the window, nothing was withdrawn from account 0 in the day before hour 60
+    std::cout << "account 0 at hour 60: " << withdrawn.get(0, 60 * hour) << " cents" << '\n';
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+
+    - the scaling of a transform of a vector into another one on a Work_stealing_pool of
+      ../parallelAlgorithms, on pools of 1, 2, 4, ... threads, up to twice the cores:
+      parallel_for with the grain it picks, with a grain of 1024, parallel::transform of
+      Parallel_algorithms.h, that cuts the range in fixed chunks, and parallel_for with the
+      workers pinned to the cores and spread over the NUMA nodes.
+
+    - a transform with the same cost for every element and one with a cost that grows with
+      the index, the last elements are 16 times the work of the first ones, about the same
+      on average, the fixed chunks of the end are the slow ones and the lazy splitting of
+      parallel_for splits them more.
+
+    - the cost of a task, run on a task group and waited for, and submit with a future,
+      in ns per task.
+
+    - the time is in ns per element, the median of ../benchmarkHarness/Benchmark_harness.h,
+      a warm up and 5 runs, with the speedup over std::transform and a checksum of the
+      output, the same for all.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../parallelAlgorithms/Work_stealing_pool.cpp
+
+    - 10'000'000 elements by default, the number can be given on the command line, e.g.
+      ./a.out 1000000
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../benchmarkHarness/Benchmark_harness.h"
+#include "../parallelAlgorithms/Parallel_algorithms.h"
+#include "../parallelAlgorithms/Work_stealing_pool.h"
+
+const bench::Options options {1, 5};
+
+// a few multiplies and adds per round, rounds of them for an element
+inline float element(float x, int rounds)
+{
+    float y = x;
+    for (int r = 0; r < rounds; ++r)
+        y = y * 0.999f + std::sqrt(y + 1.0f) * 0.001f;
+    return y;
+}
+
+inline int rounds_of(std::size_t i, std::size_t n, bool uneven)
+{
+    return uneven ? 1 + static_cast<int>(15 * i / n) : 8;
+}
+
+std::uint64_t checksum(const std::vector<float>& out)
+{
+    std::uint64_t sum {0};
+    for (std::size_t i = 0; i < out.size(); i += 4099)
+        sum = sum * 31 + static_cast<std::uint64_t>(out[i] * 1000.0f);
+    return sum;
+}
+
+// seconds of f(), the median of the runs
+template <typename F>
+double median_of(F f)
+{
+    static bench::Perf_events events;
+    return bench::measure("", "", 0, options, events, f).median_ns * 1e-9;
+}
+
+void print(const std::string& name, std::size_t threads, double seconds, double baseline, std::size_t n, std::uint64_t sum)
+{
+    std::cout << std::setw(44) << std::left << name << std::setw(8) << std::right << threads
+        << std::fixed << std::setprecision(2) << std::setw(10) << seconds * 1e9 / n
+        << std::setw(10) << baseline / seconds << std::setw(22) << sum << std::endl;
+}
+
+void bench_transform(bool uneven, const std::vector<float>& in, std::vector<float>& out, std::size_t max_threads)
+{
+    const std::size_t n = in.size();
+    const std::string kind = uneven ? ", uneven" : ", even";
+
+    const double baseline = median_of([&] {
+        std::size_t i = 0;
+        std::transform(in.begin(), in.end(), out.begin(), [&](float x) { return element(x, rounds_of(i++, n, uneven)); });
+    });
+    print("std::transform" + kind, 1, baseline, baseline, n, checksum(out));
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        const auto body = [&](std::size_t i) { out[i] = element(in[i], rounds_of(i, n, uneven)); };
+
+        double seconds = median_of([&] { pool.parallel_for(0, n, body); });
+        print("parallel_for" + kind, threads, seconds, baseline, n, checksum(out));
+
+        seconds = median_of([&] { pool.parallel_for(0, n, body, 1024); });
+        print("parallel_for, grain 1024" + kind, threads, seconds, baseline, n, checksum(out));
+
+        seconds = median_of([&] {
+            parallel::transform(parallel::par.on(pool), in.begin(), in.end(), out.begin(), [&](const float& x) {
+                return element(x, rounds_of(static_cast<std::size_t>(&x - in.data()), n, uneven));
+            });
+        });
+        print("parallel::transform" + kind, threads, seconds, baseline, n, checksum(out));
+
+        Work_stealing_pool pinned {threads - 1, Work_stealing_pool::Placement::cores};
+        seconds = median_of([&] { pinned.parallel_for(0, n, body); });
+        print("parallel_for, pinned" + kind, threads, seconds, baseline, n, checksum(out));
+
+        Work_stealing_pool spread {threads - 1, Work_stealing_pool::Placement::numa_nodes};
+        seconds = median_of([&] { spread.parallel_for(0, n, body); });
+        print("parallel_for, numa nodes" + kind, threads, seconds, baseline, n, checksum(out));
+    }
+}
+
+void bench_tasks(std::size_t max_threads)
+{
+    constexpr std::size_t num_tasks {100'000};
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        Work_stealing_pool pool {threads - 1};
+        std::atomic<std::uint64_t> sum {0};
+
+        double seconds = median_of([&] {
+            Work_stealing_pool::Task_group group;
+            for (std::size_t i = 0; i < num_tasks; ++i)
+                pool.run(group, [&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+            pool.wait(group);
+        });
+        print("run and wait, ns per task", threads, seconds, seconds, num_tasks, sum.load());
+
+        std::vector<std::future<std::size_t>> futures(num_tasks);
+        std::uint64_t total {0};
+        seconds = median_of([&] {
+            for (std::size_t i = 0; i < num_tasks; ++i)
+                futures[i] = pool.submit([i] { return i; });
+            total = 0;
+            for (std::future<std::size_t>& future : futures)
+                total += future.get();
+        });
+        print("submit and get, ns per task", threads, seconds, seconds, num_tasks, total);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10'000'000;
+    const std::size_t max_threads = 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<float> in(n);
+    for (std::size_t i = 0; i < n; ++i)
+        in[i] = static_cast<float>(i % 1000) * 0.01f;
+    std::vector<float> out(n);
+
+    std::cout << std::setw(44) << std::left << "ns per element" << std::setw(8) << std::right << "threads"
+        << std::setw(10) << "" << std::setw(10) << "speedup" << std::setw(22) << "checksum" << std::endl;
+    bench_transform(false, in, out, max_threads);
+    bench_transform(true, in, out, max_threads);
+    bench_tasks(max_threads);
+
+    return 0;
+}
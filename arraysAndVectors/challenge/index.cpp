@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include "../multidimentialArray/Matrix.h"
 
 int main()
 {
@@ -39,5 +40,15 @@ int main()
   std::cout << "index 0 of vector1 is: " << vector1.at(0) << std::endl;
   std::cout << "index 1 of vector1 is: " << vector1.at(1) << std::endl;
 
+  // the rows of vector_2d are two more blocks of memory, a Matrix keeps them in one
+  Matrix<int> matrix_2d(2, 2);
+  for (size_t col {0}; col < 2; col++) {
+    matrix_2d(0, col) = vector1.at(col);
+    matrix_2d(1, col) = vector2.at(col);
+  }
+
+  std::cout << "index 0 of row 0 from matrix_2d is: " << matrix_2d.at(0, 0) << std::endl;
+  std::cout << "index 1 of row 1 from matrix_2d is: " << matrix_2d.at(1, 1) << std::endl;
+
   return 0;
 }
@@ -0,0 +1,468 @@
+#ifndef _MATRIX_H_
+#define _MATRIX_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../../algorithms/parallelAlgorithms/Parallel_algorithms.h"
+#include "../../algorithms/parallelAlgorithms/Work_stealing_pool.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+/*
+
+    - Matrix<T> is rows x cols values in one allocation, row after row, the int[3][4] of
+      index.cpp with a size known at run time, m[r][c] or m(r, c), at(r, c) throws
+      std::out_of_range. a std::vector<std::vector<T>> has a block of its own for every row,
+      somewhere in the memory, and a pointer to follow to get to it, a 10K x 10K grid is 10K
+      allocations and a column of it touches 10K of them.
+
+    - Matrix_view<T> is a part of a matrix, the address of its first value, its rows, its
+      cols and the stride, the distance from one row to the next, so block(r, c, rows, cols)
+      of a matrix, or of a view, is a view of the same values, no copy. a Matrix_view<T>
+      converts to a Matrix_view<const T>, and a Matrix to both, the functions below take the
+      type of the values from their last argument, a Matrix or a Matrix_view.
+
+    - transpose(src, dst) goes through src in tiles of transpose_tile x transpose_tile, that
+      fit in the L1 cache with the tile of dst, so a column of dst is written a tile at a
+      time, not one value per cache line for a whole column.
+
+    - multiply(a, b, c) is c = a b, the blocked GEMM of GotoBLAS: b in blocks of gemm_kc rows
+      and gemm_nc columns, copied to a buffer in panels of a few columns, every panel in the
+      order it is read, a of gemm_mc rows at a time, that stays in the L2 cache, and tiles of
+      c of 6 rows that a kernel adds up in registers for the whole block of k. the kernel is
+      FMA instructions of AVX2 for float and double, when the compiler targets them, -mfma
+      -mavx2 or -march=native, and a plain loop for the other types. c can not be a part of
+      a or b, std::invalid_argument when the sizes do not match.
+
+    - transpose and multiply with an execution policy of ../../algorithms/parallelAlgorithms
+      split the tiles of rows, or the blocks of gemm_mc rows, between the threads of a
+      Work_stealing_pool, the buffer of a block of b is packed once and shared by them.
+      build with ../../algorithms/parallelAlgorithms/Work_stealing_pool.cpp and -pthread for
+      them.
+
+*/
+template <typename T>
+class Matrix_view
+{
+private:
+    T* first {nullptr};
+    std::size_t num_rows {0};
+    std::size_t num_cols {0};
+    std::size_t row_stride {0};
+
+public:
+    constexpr Matrix_view() = default;
+    constexpr Matrix_view(T* first, std::size_t rows, std::size_t cols, std::size_t stride)
+        : first(first), num_rows(rows), num_cols(cols), row_stride(stride) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Matrix_view(Matrix_view<U> other)
+        : first(other.data()), num_rows(other.rows()), num_cols(other.cols()), row_stride(other.stride()) {}
+
+    constexpr std::size_t rows() const { return this->num_rows; }
+    constexpr std::size_t cols() const { return this->num_cols; }
+    constexpr std::size_t stride() const { return this->row_stride; }
+    constexpr T* data() const { return this->first; }
+
+    constexpr T* operator[](std::size_t row) const { return this->first + row * this->row_stride; }
+    constexpr T& operator()(std::size_t row, std::size_t col) const { return this->first[row * this->row_stride + col]; }
+
+    T& at(std::size_t row, std::size_t col) const
+    {
+        if (row >= this->num_rows || col >= this->num_cols)
+            throw std::out_of_range {"the index is not in the matrix"};
+        return (*this)(row, col);
+    }
+
+    Matrix_view block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const
+    {
+        if (row > this->num_rows || rows > this->num_rows - row || col > this->num_cols || cols > this->num_cols - col)
+            throw std::out_of_range {"the block is not in the matrix"};
+        return Matrix_view {(*this)[row] + col, rows, cols, this->row_stride};
+    }
+
+    void fill(const T& value) const
+    {
+        for (std::size_t row = 0; row < this->num_rows; ++row)
+            std::fill_n((*this)[row], this->num_cols, value);
+    }
+};
+
+template <typename T>
+class Matrix
+{
+    static_assert(!std::is_same_v<T, bool>, "the values of a std::vector<bool> are not in an array");
+
+private:
+    std::size_t num_rows {0};
+    std::size_t num_cols {0};
+    std::vector<T> values;
+
+public:
+    using value_type = T;
+
+    Matrix() = default;
+
+    Matrix(std::size_t rows, std::size_t cols, const T& value = T {})
+        : num_rows(rows), num_cols(cols), values(rows * cols, value) {}
+
+    // Matrix<int> m {{1, 2, 3}, {4, 5, 6}}, every row has the size of the first one
+    Matrix(std::initializer_list<std::initializer_list<T>> rows)
+        : num_rows(rows.size()), num_cols(rows.size() == 0 ? 0 : rows.begin()->size())
+    {
+        this->values.reserve(this->num_rows * this->num_cols);
+        for (const std::initializer_list<T>& row : rows)
+        {
+            if (row.size() != this->num_cols)
+                throw std::invalid_argument {"the rows of a matrix have the same size"};
+            this->values.insert(this->values.end(), row.begin(), row.end());
+        }
+    }
+
+    std::size_t rows() const { return this->num_rows; }
+    std::size_t cols() const { return this->num_cols; }
+    std::size_t size() const { return this->values.size(); }
+
+    T* data() { return this->values.data(); }
+    const T* data() const { return this->values.data(); }
+
+    T* operator[](std::size_t row) { return this->data() + row * this->num_cols; }
+    const T* operator[](std::size_t row) const { return this->data() + row * this->num_cols; }
+
+    T& operator()(std::size_t row, std::size_t col) { return this->values[row * this->num_cols + col]; }
+    const T& operator()(std::size_t row, std::size_t col) const { return this->values[row * this->num_cols + col]; }
+
+    T& at(std::size_t row, std::size_t col) { return this->view().at(row, col); }
+    const T& at(std::size_t row, std::size_t col) const { return this->view().at(row, col); }
+
+    Matrix_view<T> view() { return Matrix_view<T> {this->data(), this->num_rows, this->num_cols, this->num_cols}; }
+    Matrix_view<const T> view() const { return Matrix_view<const T> {this->data(), this->num_rows, this->num_cols, this->num_cols}; }
+
+    operator Matrix_view<T>() { return this->view(); }
+    operator Matrix_view<const T>() const { return this->view(); }
+
+    Matrix_view<T> block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols)
+    {
+        return this->view().block(row, col, rows, cols);
+    }
+
+    Matrix_view<const T> block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const
+    {
+        return this->view().block(row, col, rows, cols);
+    }
+
+    void fill(const T& value) { std::fill(this->values.begin(), this->values.end(), value); }
+
+    bool operator==(const Matrix& rhs) const
+    {
+        return this->num_rows == rhs.num_rows && this->num_cols == rhs.num_cols && this->values == rhs.values;
+    }
+
+    bool operator!=(const Matrix& rhs) const { return !(*this == rhs); }
+};
+
+inline constexpr std::size_t transpose_tile {32};
+inline constexpr std::size_t gemm_mc {72};
+inline constexpr std::size_t gemm_kc {256};
+inline constexpr std::size_t gemm_nc {2048};
+
+namespace detail_matrix
+{
+    // a, b and src take the T of the last argument, so that a Matrix, or a Matrix_view<T>,
+    // converts to them
+    template <typename T>
+    struct Identity { using type = T; };
+
+    template <typename T>
+    using Const_view = Matrix_view<const typename Identity<T>::type>;
+
+    // the rows of a tile of c
+    inline constexpr std::size_t mr {6};
+
+    template <typename T>
+    void check_transpose(Matrix_view<const T> src, Matrix_view<T> dst)
+    {
+        if (dst.rows() != src.cols() || dst.cols() != src.rows())
+            throw std::invalid_argument {"transpose needs a destination of src.cols() rows and src.rows() cols"};
+    }
+
+    // the tiles of the rows [first, last) of src
+    template <typename T>
+    void transpose_rows(Matrix_view<const T> src, Matrix_view<T> dst, std::size_t first, std::size_t last)
+    {
+        for (std::size_t row = first; row < last; row += transpose_tile)
+        {
+            const std::size_t row_end = std::min(last, row + transpose_tile);
+            for (std::size_t col = 0; col < src.cols(); col += transpose_tile)
+            {
+                const std::size_t col_end = std::min(src.cols(), col + transpose_tile);
+                for (std::size_t i = row; i < row_end; ++i)
+                    for (std::size_t j = col; j < col_end; ++j)
+                        dst(j, i) = src(i, j);
+            }
+        }
+    }
+
+    // nr is the columns of a tile of c, run its mr x nr values from mr rows of a and a panel of b
+    template <typename T>
+    struct Kernel
+    {
+        static constexpr std::size_t nr {8};
+
+        static void run(const T* const a[mr], const T* panel, std::size_t kc, T* tile)
+        {
+            T sums[mr][nr] {};
+            for (std::size_t k = 0; k < kc; ++k)
+                for (std::size_t r = 0; r < mr; ++r)
+                    for (std::size_t c = 0; c < nr; ++c)
+                        sums[r][c] += a[r][k] * panel[k * nr + c];
+            for (std::size_t r = 0; r < mr; ++r)
+                for (std::size_t c = 0; c < nr; ++c)
+                    tile[r * nr + c] = sums[r][c];
+        }
+    };
+
+#if defined(__AVX2__) && defined(__FMA__)
+    // 6 rows of 2 vectors, 12 registers of sums, 2 of the panel and one of a
+    template <>
+    struct Kernel<double>
+    {
+        static constexpr std::size_t nr {8};
+
+        static void run(const double* const a[mr], const double* panel, std::size_t kc, double* tile)
+        {
+            __m256d sums[mr][2];
+            for (std::size_t r = 0; r < mr; ++r)
+                sums[r][0] = sums[r][1] = _mm256_setzero_pd();
+            for (std::size_t k = 0; k < kc; ++k)
+            {
+                const __m256d b0 = _mm256_loadu_pd(panel + k * nr);
+                const __m256d b1 = _mm256_loadu_pd(panel + k * nr + 4);
+                for (std::size_t r = 0; r < mr; ++r)
+                {
+                    const __m256d x = _mm256_broadcast_sd(a[r] + k);
+                    sums[r][0] = _mm256_fmadd_pd(x, b0, sums[r][0]);
+                    sums[r][1] = _mm256_fmadd_pd(x, b1, sums[r][1]);
+                }
+            }
+            for (std::size_t r = 0; r < mr; ++r)
+            {
+                _mm256_storeu_pd(tile + r * nr, sums[r][0]);
+                _mm256_storeu_pd(tile + r * nr + 4, sums[r][1]);
+            }
+        }
+    };
+
+    template <>
+    struct Kernel<float>
+    {
+        static constexpr std::size_t nr {16};
+
+        static void run(const float* const a[mr], const float* panel, std::size_t kc, float* tile)
+        {
+            __m256 sums[mr][2];
+            for (std::size_t r = 0; r < mr; ++r)
+                sums[r][0] = sums[r][1] = _mm256_setzero_ps();
+            for (std::size_t k = 0; k < kc; ++k)
+            {
+                const __m256 b0 = _mm256_loadu_ps(panel + k * nr);
+                const __m256 b1 = _mm256_loadu_ps(panel + k * nr + 8);
+                for (std::size_t r = 0; r < mr; ++r)
+                {
+                    const __m256 x = _mm256_broadcast_ss(a[r] + k);
+                    sums[r][0] = _mm256_fmadd_ps(x, b0, sums[r][0]);
+                    sums[r][1] = _mm256_fmadd_ps(x, b1, sums[r][1]);
+                }
+            }
+            for (std::size_t r = 0; r < mr; ++r)
+            {
+                _mm256_storeu_ps(tile + r * nr, sums[r][0]);
+                _mm256_storeu_ps(tile + r * nr + 8, sums[r][1]);
+            }
+        }
+    };
+#endif
+
+    template <typename T>
+    void check_multiply(Matrix_view<const T> a, Matrix_view<const T> b, Matrix_view<T> c)
+    {
+        if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols())
+            throw std::invalid_argument {"multiply needs a of m x k, b of k x n and c of m x n"};
+    }
+
+    // the rows [row, row + kc) and the columns [col, col + nc) of b, in panels of nr columns,
+    // the last one filled up with zeros
+    template <typename T>
+    void pack(Matrix_view<const T> b, std::size_t row, std::size_t kc, std::size_t col, std::size_t nc, T* packed)
+    {
+        constexpr std::size_t nr = Kernel<T>::nr;
+        for (std::size_t panel = 0; panel * nr < nc; ++panel, packed += kc * nr)
+        {
+            const std::size_t width = std::min(nr, nc - panel * nr);
+            for (std::size_t k = 0; k < kc; ++k)
+            {
+                const T* const from = b[row + k] + col + panel * nr;
+                std::copy(from, from + width, packed + k * nr);
+                std::fill(packed + k * nr + width, packed + (k + 1) * nr, T {});
+            }
+        }
+    }
+
+    // the rows [first, last) and the columns [col, col + nc) of c get the product of the same
+    // rows and the columns [depth, depth + kc) of a with the packed block of b added
+    template <typename T>
+    void multiply_rows(Matrix_view<const T> a, const T* packed, Matrix_view<T> c, std::size_t first, std::size_t last,
+                       std::size_t depth, std::size_t kc, std::size_t col, std::size_t nc)
+    {
+        constexpr std::size_t nr = Kernel<T>::nr;
+        T tile[mr * nr];
+        for (std::size_t panel = 0; panel * nr < nc; ++panel)
+        {
+            const std::size_t width = std::min(nr, nc - panel * nr);
+            for (std::size_t row = first; row < last; row += mr)
+            {
+                // the missing rows of the last tile read the last row again, their sums are not used
+                const std::size_t height = std::min(mr, last - row);
+                const T* rows[mr];
+                for (std::size_t r = 0; r < mr; ++r)
+                    rows[r] = a[row + std::min(r, height - 1)] + depth;
+                Kernel<T>::run(rows, packed + panel * kc * nr, kc, tile);
+                for (std::size_t r = 0; r < height; ++r)
+                {
+                    T* const out = c[row + r] + col + panel * nr;
+                    for (std::size_t j = 0; j < width; ++j)
+                        out[j] += tile[r * nr + j];
+                }
+            }
+        }
+    }
+
+    // every block of b packed, and f(packed, depth, kc, col, nc) for it
+    template <typename T, typename F>
+    void for_blocks(Matrix_view<const T> b, const F& f)
+    {
+        constexpr std::size_t nr = Kernel<T>::nr;
+        std::vector<T> packed(gemm_kc * ((gemm_nc + nr - 1) / nr * nr));
+        for (std::size_t col = 0; col < b.cols(); col += gemm_nc)
+        {
+            const std::size_t nc = std::min(gemm_nc, b.cols() - col);
+            for (std::size_t depth = 0; depth < b.rows(); depth += gemm_kc)
+            {
+                const std::size_t kc = std::min(gemm_kc, b.rows() - depth);
+                pack(b, depth, kc, col, nc, packed.data());
+                f(static_cast<const T*>(packed.data()), depth, kc, col, nc);
+            }
+        }
+    }
+}
+
+template <typename T>
+void transpose(detail_matrix::Const_view<T> src, Matrix_view<T> dst)
+{
+    detail_matrix::check_transpose<T>(src, dst);
+    detail_matrix::transpose_rows<T>(src, dst, 0, src.rows());
+}
+
+template <typename Policy, typename T>
+void transpose(Policy&& policy, detail_matrix::Const_view<T> src, Matrix_view<T> dst)
+{
+    detail_matrix::check_transpose<T>(src, dst);
+    if constexpr (!parallel::detail::is_parallel<Policy>)
+        detail_matrix::transpose_rows<T>(src, dst, 0, src.rows());
+    else
+    {
+        // every chunk is whole tiles of rows
+        Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+        const std::size_t tiles = (src.rows() + transpose_tile - 1) / transpose_tile;
+        const std::size_t chunks = std::max<std::size_t>(1, std::min(tiles, pool.size() * 8));
+        parallel::detail::for_chunks(pool, tiles, chunks, [&](std::size_t, std::size_t begin, std::size_t end)
+        {
+            detail_matrix::transpose_rows<T>(src, dst, begin * transpose_tile, std::min(src.rows(), end * transpose_tile));
+        });
+    }
+}
+
+template <typename T>
+void transpose(detail_matrix::Const_view<T> src, Matrix<T>& dst)
+{
+    transpose<T>(src, dst.view());
+}
+
+template <typename Policy, typename T>
+void transpose(Policy&& policy, detail_matrix::Const_view<T> src, Matrix<T>& dst)
+{
+    transpose<Policy, T>(std::forward<Policy>(policy), src, dst.view());
+}
+
+template <typename T>
+Matrix<T> transposed(const Matrix<T>& m)
+{
+    Matrix<T> result(m.cols(), m.rows());
+    transpose(m, result);
+    return result;
+}
+
+template <typename T>
+void multiply(detail_matrix::Const_view<T> a, detail_matrix::Const_view<T> b, Matrix_view<T> c)
+{
+    detail_matrix::check_multiply<T>(a, b, c);
+    c.fill(T {});
+    detail_matrix::for_blocks<T>(b, [&](const T* packed, std::size_t depth, std::size_t kc, std::size_t col, std::size_t nc)
+    {
+        for (std::size_t row = 0; row < a.rows(); row += gemm_mc)
+            detail_matrix::multiply_rows<T>(a, packed, c, row, std::min(a.rows(), row + gemm_mc), depth, kc, col, nc);
+    });
+}
+
+template <typename Policy, typename T>
+void multiply(Policy&& policy, detail_matrix::Const_view<T> a, detail_matrix::Const_view<T> b, Matrix_view<T> c)
+{
+    if constexpr (!parallel::detail::is_parallel<Policy>)
+        multiply<T>(a, b, c);
+    else
+    {
+        detail_matrix::check_multiply<T>(a, b, c);
+        c.fill(T {});
+        Work_stealing_pool& pool = parallel::detail::pool_of(policy);
+        const std::size_t blocks = (a.rows() + gemm_mc - 1) / gemm_mc;
+        const std::size_t chunks = std::max<std::size_t>(1, std::min(blocks, pool.size() * 4));
+        detail_matrix::for_blocks<T>(b, [&](const T* packed, std::size_t depth, std::size_t kc, std::size_t col, std::size_t nc)
+        {
+            parallel::detail::for_chunks(pool, blocks, chunks, [&](std::size_t, std::size_t begin, std::size_t end)
+            {
+                for (std::size_t block = begin; block < end; ++block)
+                    detail_matrix::multiply_rows<T>(a, packed, c, block * gemm_mc, std::min(a.rows(), (block + 1) * gemm_mc),
+                                                    depth, kc, col, nc);
+            });
+        });
+    }
+}
+
+template <typename T>
+void multiply(detail_matrix::Const_view<T> a, detail_matrix::Const_view<T> b, Matrix<T>& c)
+{
+    multiply<T>(a, b, c.view());
+}
+
+template <typename Policy, typename T>
+void multiply(Policy&& policy, detail_matrix::Const_view<T> a, detail_matrix::Const_view<T> b, Matrix<T>& c)
+{
+    multiply<Policy, T>(std::forward<Policy>(policy), a, b, c.view());
+}
+
+template <typename T>
+Matrix<T> operator*(const Matrix<T>& a, const Matrix<T>& b)
+{
+    Matrix<T> c(a.rows(), b.cols());
+    multiply(a, b, c);
+    return c;
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include <iostream>
+#include "Matrix.h"
 
 int main()
 {
@@ -10,5 +11,27 @@ int main()
 
   std::cout << "The number of index [2][3] is: " << numbers[2][3] << std::endl;
 
+  // the same numbers in one block of memory, with a size that can be chosen at run time
+  Matrix<int> matrix {
+    {1, 2, 3, 4},
+    {5, 6, 7, 8},
+    {9, 10, 11, 12}
+  };
+
+  std::cout << "The number of index [2][3] of the matrix is: " << matrix[2][3] << std::endl;
+
+  // the 2 x 2 block at row 1 and column 2 is a view of the same numbers, no copy
+  Matrix_view<int> block {matrix.block(1, 2, 2, 2)};
+  block(0, 0) = 70;
+  std::cout << "The number of index [1][2] after changing the block is: " << matrix(1, 2) << std::endl;
+
+  Matrix<int> product {matrix * transposed(matrix)};
+  std::cout << "The matrix times its transpose is " << product.rows() << " x " << product.cols() << ":" << std::endl;
+  for (size_t row {0}; row < product.rows(); row++) {
+    for (size_t col {0}; col < product.cols(); col++)
+      std::cout << product(row, col) << " ";
+    std::cout << std::endl;
+  }
+
   return 0;
 }
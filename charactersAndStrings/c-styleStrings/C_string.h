@@ -0,0 +1,228 @@
+#ifndef _C_STRING_H_
+#define _C_STRING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+  - the strlen, strcpy, strcat and strcmp of index.cpp, bounded, and 16 bytes at a time with
+    SSE2, 32 with AVX2, the bytes of a block are compared with the '\0' at once:
+
+      - str_len(s) is strlen(s), str_len(s, max) looks at max characters at most
+      - str_copy_n(dest, src, n) copies n characters of src at most, and a '\0', dest has
+        room for n + 1, and returns the end of the copy, the address of its '\0'
+      - str_append(end, limit, src) copies src to end, the '\0' of a string in a buffer that
+        ends at limit, as much of it as fits, and returns the new end, a chain of appends
+        writes at the cursor and does not walk the string again the way every strcat does
+      - str_compare(a, b) is strcmp(a, b), < 0, 0 or > 0 as the first byte that differs
+
+  - a block can go past the '\0' of a string, into memory that is not its own. str_len
+    reads aligned blocks, an aligned block is never on two pages, so it is never on a page
+    that is not mapped, the bytes before s are masked out. str_compare reads unaligned blocks
+    and compares a byte at a time when a block of a or b would cross a page. the address
+    sanitizer would see the bytes over the end as an overflow, it does not check these
+    functions, the way it does not check the ones of the C library.
+
+*/
+#if defined(__GNUC__) || defined(__clang__)
+#define C_STRING_UNCHECKED __attribute__((no_sanitize_address))
+#else
+#define C_STRING_UNCHECKED
+#endif
+
+namespace detail_c_string
+{
+  constexpr std::size_t page_size = 4096;
+
+#if defined(__AVX2__)
+  constexpr std::size_t block_size = 32;
+  using Block = __m256i;
+
+  C_STRING_UNCHECKED inline Block load_aligned(const char *p) { return _mm256_load_si256(reinterpret_cast<const __m256i *>(p)); }
+  C_STRING_UNCHECKED inline Block load(const char *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+  inline Block equal(Block x, Block y) { return _mm256_cmpeq_epi8(x, y); }
+  inline Block zero() { return _mm256_setzero_si256(); }
+  inline Block min(Block x, Block y) { return _mm256_min_epu8(x, y); }
+  inline std::uint32_t mask(Block x) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(x)); }
+#elif defined(__SSE2__)
+  constexpr std::size_t block_size = 16;
+  using Block = __m128i;
+
+  C_STRING_UNCHECKED inline Block load_aligned(const char *p) { return _mm_load_si128(reinterpret_cast<const __m128i *>(p)); }
+  C_STRING_UNCHECKED inline Block load(const char *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+  inline Block equal(Block x, Block y) { return _mm_cmpeq_epi8(x, y); }
+  inline Block zero() { return _mm_setzero_si128(); }
+  inline Block min(Block x, Block y) { return _mm_min_epu8(x, y); }
+  inline std::uint32_t mask(Block x) { return static_cast<std::uint32_t>(_mm_movemask_epi8(x)); }
+#else
+  constexpr std::size_t block_size = 1;
+#endif
+
+  // the loops take 4 blocks at a time, a group, once the first ones are done
+  constexpr std::size_t group_size = 4 * block_size;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+  // a bit per byte of the aligned block that is a '\0'
+  C_STRING_UNCHECKED inline std::uint32_t zeros(const char *block)
+  {
+    return mask(equal(load_aligned(block), zero()));
+  }
+
+  // whether the aligned group has a '\0', the smallest byte of the 4 blocks is 0
+  C_STRING_UNCHECKED inline bool group_has_zero(const char *group)
+  {
+    const Block smallest = min(min(load_aligned(group), load_aligned(group + block_size)),
+                               min(load_aligned(group + 2 * block_size), load_aligned(group + 3 * block_size)));
+    return mask(equal(smallest, zero())) != 0;
+  }
+
+  // a 0 for every byte of x that differs from the one of y or is a '\0', the min of x and
+  // 0xff where they are equal
+  inline Block same(Block x, Block y)
+  {
+    return min(x, equal(x, y));
+  }
+
+  // a bit per byte of a that differs from the one of b or is a '\0'
+  C_STRING_UNCHECKED inline std::uint32_t stops(const char *a, const char *b)
+  {
+    const Block x = load(a);
+    return mask(equal(same(x, load(b)), zero()));
+  }
+
+  C_STRING_UNCHECKED inline bool group_stops(const char *a, const char *b)
+  {
+    const Block both = min(min(same(load(a), load(b)), same(load(a + block_size), load(b + block_size))),
+                           min(same(load(a + 2 * block_size), load(b + 2 * block_size)),
+                               same(load(a + 3 * block_size), load(b + 3 * block_size))));
+    return mask(equal(both, zero())) != 0;
+  }
+#endif
+
+  // the size bytes from p are on one page
+  inline bool in_page(const char *p, std::size_t size)
+  {
+    return reinterpret_cast<std::uintptr_t>(p) % page_size <= page_size - size;
+  }
+}
+
+// the characters of s before the first '\0', or max when there is none in the first max
+C_STRING_UNCHECKED inline std::size_t str_len(const char *s, std::size_t max)
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+  using namespace detail_c_string;
+
+  const std::size_t offset = reinterpret_cast<std::uintptr_t>(s) % block_size;
+  const char *block = reinterpret_cast<const char *>(reinterpret_cast<std::uintptr_t>(s) - offset);
+  std::uint32_t found = zeros(block) >> offset;
+  std::size_t length {0};
+  if (found == 0) {
+    length = block_size - offset;
+    block += block_size;
+    // a block at a time up to a group, an aligned group is on one page too
+    for (; length < max && reinterpret_cast<std::uintptr_t>(block) % group_size != 0; block += block_size, length += block_size) {
+      found = zeros(block);
+      if (found != 0)
+        break;
+    }
+    if (found == 0) {
+      for (; length < max && !group_has_zero(block); block += group_size, length += group_size)
+        ;
+      for (; length < max; block += block_size, length += block_size) {
+        found = zeros(block);
+        if (found != 0)
+          break;
+      }
+    }
+  }
+  if (found != 0)
+    length += static_cast<std::size_t>(__builtin_ctz(found));
+  return length < max ? length : max;
+#else
+  std::size_t length {0};
+  while (length < max && s[length] != '\0')
+    length++;
+  return length;
+#endif
+}
+
+inline std::size_t str_len(const char *s)
+{
+  return str_len(s, SIZE_MAX);
+}
+
+inline char *str_copy_n(char *dest, const char *src, std::size_t n)
+{
+  const std::size_t length = str_len(src, n);
+  std::memcpy(dest, src, length);
+  dest[length] = '\0';
+  return dest + length;
+}
+
+// end < limit, the '\0' at end is in the buffer
+inline char *str_append(char *end, const char *limit, const char *src)
+{
+  return str_copy_n(end, src, static_cast<std::size_t>(limit - end) - 1);
+}
+
+C_STRING_UNCHECKED inline int str_compare(const char *a, const char *b)
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+  using namespace detail_c_string;
+
+  // the first block alone, most strings that differ differ in it
+  if (in_page(a, block_size) && in_page(b, block_size)) {
+    const std::uint32_t stop = stops(a, b);
+    if (stop != 0) {
+      const int i = __builtin_ctz(stop);
+      return static_cast<unsigned char>(a[i]) - static_cast<unsigned char>(b[i]);
+    }
+    a += block_size;
+    b += block_size;
+  }
+
+  for (;;) {
+    // the bytes up to the end of the page of a or of b, whichever is first
+    const std::size_t room_a = page_size - reinterpret_cast<std::uintptr_t>(a) % page_size;
+    const std::size_t room_b = page_size - reinterpret_cast<std::uintptr_t>(b) % page_size;
+    std::size_t room = room_a < room_b ? room_a : room_b;
+
+    for (; room >= group_size && !group_stops(a, b); room -= group_size) {
+      a += group_size;
+      b += group_size;
+    }
+    for (; room >= block_size; room -= block_size) {
+      const std::uint32_t stop = stops(a, b);
+      if (stop != 0) {
+        const int i = __builtin_ctz(stop);
+        return static_cast<unsigned char>(a[i]) - static_cast<unsigned char>(b[i]);
+      }
+      a += block_size;
+      b += block_size;
+    }
+    // a byte at a time up to the next page of the one that is at the end of one
+    for (; room > 0; room--) {
+      if (*a != *b || *a == '\0')
+        return static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b);
+      a++;
+      b++;
+    }
+  }
+#else
+  while (*a == *b && *a != '\0') {
+    a++;
+    b++;
+  }
+  return static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b);
+#endif
+}
+
+#endif
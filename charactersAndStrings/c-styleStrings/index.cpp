@@ -13,11 +13,20 @@
     strlen("Frank") => 5
     the type of 5 is size_t not an integer
 
+  strcat looks for the \0 of the string it appends to, every time, a chain of them walks
+  the start of the string again for every piece. the str_copy_n and str_append of
+  C_string.h return the new end of the string, the next piece goes there, and never write
+  past the end of the buffer:
+
+    char *end = str_copy_n(full_name, first_name, sizeof(full_name) - 1);
+    end = str_append(end, full_name + sizeof(full_name), " ");
+
 */
 
 #include <iostream>
 #include <cctype> // for character-based functions
 #include <cstring> // for c-style string functions
+#include "C_string.h"
 
 int main()
 {
@@ -35,9 +44,12 @@ int main()
   std::cout << "Your first name " << first_name << " has " << strlen(first_name) << " characters." << std::endl;
   std::cout << "Your last name " << last_name << " has " << strlen(last_name) << " characters." << std::endl;
 
-  strcpy(full_name, first_name);
-  strcat(full_name, " ");
-  strcat(full_name, last_name);
+  // strcpy(full_name, first_name);
+  // strcat(full_name, " ");
+  // strcat(full_name, last_name);
+  char *end = str_copy_n(full_name, first_name, sizeof(full_name) - 1);
+  end = str_append(end, full_name + sizeof(full_name), " ");
+  end = str_append(end, full_name + sizeof(full_name), last_name);
 
   std::cout << "Your full name is " << full_name << "." << std::endl;
  
@@ -53,7 +65,9 @@ int main()
   else
     std::cout << temp << " and " << full_name << " are not equal" << "." << std::endl;
 
-  for (size_t i {0}; i < strlen(full_name); i++)
+  // strlen in the condition would look for the \0 again on every character
+  const size_t length {str_len(full_name)};
+  for (size_t i {0}; i < length; i++)
     if (isalpha(full_name[i]))
       full_name[i] = toupper(full_name[i]);
 
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Substitution_cipher.h"
+
+namespace
+{
+  std::uint16_t changed_rows(const unsigned char *table)
+  {
+    std::uint16_t rows {0};
+    for (int c {0}; c < 256; c++)
+      if (table[c] != c)
+        rows |= static_cast<std::uint16_t>(1u << (c / 16));
+    return rows;
+  }
+}
+
+Substitution_cipher::Substitution_cipher(std::string_view alphabet, std::string_view key)
+{
+  if (alphabet.size() != key.size())
+    throw std::invalid_argument("Substitution_cipher: the key and the alphabet have different lengths");
+
+  bool in_alphabet[256] {};
+  bool in_key[256] {};
+  for (int c {0}; c < 256; c++)
+    this->encrypt_table[c] = this->decrypt_table[c] = static_cast<unsigned char>(c);
+
+  for (std::size_t i {0}; i < alphabet.size(); i++) {
+    const unsigned char plain = static_cast<unsigned char>(alphabet[i]);
+    const unsigned char cipher = static_cast<unsigned char>(key[i]);
+    if (in_alphabet[plain] || in_key[cipher])
+      throw std::invalid_argument("Substitution_cipher: a character is twice in the alphabet or in the key");
+    in_alphabet[plain] = in_key[cipher] = true;
+    this->encrypt_table[plain] = cipher;
+    this->decrypt_table[cipher] = plain;
+  }
+
+  // a character of the key that is not in the alphabet would be left as it is and be the
+  // encryption of another one too
+  for (int c {0}; c < 256; c++)
+    if (in_alphabet[c] != in_key[c])
+      throw std::invalid_argument("Substitution_cipher: the key is not the characters of the alphabet in another order");
+
+  this->encrypt_rows = changed_rows(this->encrypt_table);
+  this->decrypt_rows = changed_rows(this->decrypt_table);
+}
+
+void Substitution_cipher::encrypt(char *data, std::size_t n) const
+{
+  detail_cipher::substitute(this->encrypt_table, this->encrypt_rows, reinterpret_cast<unsigned char *>(data), n);
+}
+
+void Substitution_cipher::decrypt(char *data, std::size_t n) const
+{
+  detail_cipher::substitute(this->decrypt_table, this->decrypt_rows, reinterpret_cast<unsigned char *>(data), n);
+}
+
+std::string Substitution_cipher::encrypt(std::string_view text) const
+{
+  std::string result {text};
+  this->encrypt(result.data(), result.size());
+  return result;
+}
+
+std::string Substitution_cipher::decrypt(std::string_view text) const
+{
+  std::string result {text};
+  this->decrypt(result.data(), result.size());
+  return result;
+}
+
+/*
+
+  - a buffer is read, split between the threads, a part each, 64 bytes at least, and
+    written once they all end, the threads only read the table and write their own part.
+
+*/
+std::uint64_t Substitution_cipher::apply_file(const unsigned char *table, std::uint16_t rows,
+  const std::string &in_path, const std::string &out_path, std::size_t num_threads, std::size_t buffer_size) const
+{
+  std::ifstream in {in_path, std::ios::binary};
+  if (!in)
+    throw std::runtime_error("open " + in_path + ": the file can not be opened");
+  std::ofstream out {out_path, std::ios::binary | std::ios::trunc};
+  if (!out)
+    throw std::runtime_error("open " + out_path + ": the file can not be created");
+
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  buffer_size = std::max<std::size_t>(buffer_size, 64);
+  std::unique_ptr<unsigned char[]> buffer {new unsigned char[buffer_size]};
+
+  std::uint64_t total {0};
+  while (in) {
+    in.read(reinterpret_cast<char *>(buffer.get()), static_cast<std::streamsize>(buffer_size));
+    const std::size_t n = static_cast<std::size_t>(in.gcount());
+    if (n == 0)
+      break;
+
+    const std::size_t part = std::max<std::size_t>((n + num_threads - 1) / num_threads, 64);
+    if (part >= n)
+      detail_cipher::substitute(table, rows, buffer.get(), n);
+    else {
+      std::vector<std::thread> threads;
+      for (std::size_t begin {part}; begin < n; begin += part)
+        threads.emplace_back([table, rows, &buffer, begin, end = std::min(begin + part, n)] {
+          detail_cipher::substitute(table, rows, buffer.get() + begin, end - begin);
+        });
+      detail_cipher::substitute(table, rows, buffer.get(), part);
+      for (std::thread &thread : threads)
+        thread.join();
+    }
+
+    if (!out.write(reinterpret_cast<const char *>(buffer.get()), static_cast<std::streamsize>(n)))
+      throw std::runtime_error("write " + out_path + ": the file can not be written");
+    total += n;
+  }
+  if (in.bad())
+    throw std::runtime_error("read " + in_path + ": the file can not be read");
+
+  out.flush();
+  if (!out)
+    throw std::runtime_error("write " + out_path + ": the file can not be written");
+  return total;
+}
+
+std::uint64_t Substitution_cipher::encrypt_file(const std::string &in_path, const std::string &out_path,
+  std::size_t num_threads, std::size_t buffer_size) const
+{
+  return this->apply_file(this->encrypt_table, this->encrypt_rows, in_path, out_path, num_threads, buffer_size);
+}
+
+std::uint64_t Substitution_cipher::decrypt_file(const std::string &in_path, const std::string &out_path,
+  std::size_t num_threads, std::size_t buffer_size) const
+{
+  return this->apply_file(this->decrypt_table, this->decrypt_rows, in_path, out_path, num_threads, buffer_size);
+}
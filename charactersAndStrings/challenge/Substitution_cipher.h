@@ -0,0 +1,119 @@
+#ifndef _SUBSTITUTION_CIPHER_H_
+#define _SUBSTITUTION_CIPHER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "../../tooling/cpuDispatch/Cpu_dispatch.h"
+
+#if defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+/*
+
+  - Substitution_cipher(alphabet, key) replaces alphabet[i] by key[i], the key is the same
+    characters in another order, every other character is left as it is. the two tables of
+    256 bytes, one per direction, are made once, a character is one load from a table, not a
+    find in the alphabet, decrypt(encrypt(text)) is text. a key that is not a permutation
+    of the alphabet, or an alphabet with a character twice, throws std::invalid_argument.
+
+  - with AVX2 the table is looked up 32 characters at a time: a row of the table is the 16
+    bytes of one high nibble, _mm256_shuffle_epi8 looks the low nibbles up in a row, a blend
+    keeps the ones whose high nibble it is, only the rows that change a character are looked
+    up, the 4 of the letters. the AVX2 version is compiled in every build for x86 and taken
+    when the cpu has it, see tooling/cpuDispatch/Cpu_dispatch.h.
+
+  - encrypt_file and decrypt_file stream a file of any size through a buffer of
+    buffer_size bytes, the buffer split between num_threads threads, 0 is one per hardware
+    thread, and return the bytes written. errors throw std::runtime_error.
+
+*/
+namespace detail_cipher
+{
+  inline void substitute_scalar(const unsigned char *table, std::uint16_t, unsigned char *data, std::size_t n)
+  {
+    for (std::size_t i {0}; i < n; i++)
+      data[i] = table[data[i]];
+  }
+
+#if defined(CPU_DISPATCH_X86)
+  CPU_DISPATCH_AVX2 inline void substitute_avx2(const unsigned char *table, std::uint16_t rows, unsigned char *data,
+    std::size_t n)
+  {
+    std::size_t i {0};
+    __m256i row_tables[16];
+    __m256i row_nibbles[16];
+    int num_rows {0};
+    for (int r {0}; r < 16; r++)
+      if (rows & (1u << r)) {
+        row_tables[num_rows] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table + 16 * r)));
+        row_nibbles[num_rows] = _mm256_set1_epi8(static_cast<char>(r));
+        num_rows++;
+      }
+
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    for (; i + 32 <= n; i += 32) {
+      __m256i *const at = reinterpret_cast<__m256i *>(data + i);
+      const __m256i bytes = _mm256_loadu_si256(at);
+      const __m256i low = _mm256_and_si256(bytes, low_nibble);
+      const __m256i high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble);
+      __m256i result = bytes;
+      for (int k {0}; k < num_rows; k++) {
+        const __m256i in_row = _mm256_cmpeq_epi8(high, row_nibbles[k]);
+        result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(row_tables[k], low), in_row);
+      }
+      _mm256_storeu_si256(at, result);
+    }
+    substitute_scalar(table, rows, data + i, n - i);
+  }
+#endif
+
+  // table[c] for every byte, rows has bit r set when table[16 * r, 16 * r + 16) changes a byte
+  inline void substitute(const unsigned char *table, std::uint16_t rows, unsigned char *data, std::size_t n)
+  {
+    static const cpu_dispatch::Dispatch<void(const unsigned char*, std::uint16_t, unsigned char*, std::size_t)> versions {
+      {cpu_dispatch::Isa::scalar, substitute_scalar},
+#if defined(CPU_DISPATCH_X86)
+      {cpu_dispatch::Isa::avx2, substitute_avx2},
+#endif
+    };
+    if (rows != 0)
+      versions(table, rows, data, n);
+  }
+}
+
+class Substitution_cipher
+{
+private:
+  unsigned char encrypt_table[256];
+  unsigned char decrypt_table[256];
+  std::uint16_t encrypt_rows;
+  std::uint16_t decrypt_rows;
+
+  std::uint64_t apply_file(const unsigned char *table, std::uint16_t rows, const std::string &in_path,
+    const std::string &out_path, std::size_t num_threads, std::size_t buffer_size) const;
+
+public:
+  static constexpr std::size_t def_buffer_size = std::size_t {1} << 24;
+
+  Substitution_cipher(std::string_view alphabet, std::string_view key);
+
+  char encrypt(char c) const { return static_cast<char>(this->encrypt_table[static_cast<unsigned char>(c)]); }
+  char decrypt(char c) const { return static_cast<char>(this->decrypt_table[static_cast<unsigned char>(c)]); }
+
+  // in place
+  void encrypt(char *data, std::size_t n) const;
+  void decrypt(char *data, std::size_t n) const;
+
+  std::string encrypt(std::string_view text) const;
+  std::string decrypt(std::string_view text) const;
+
+  std::uint64_t encrypt_file(const std::string &in_path, const std::string &out_path,
+    std::size_t num_threads = 0, std::size_t buffer_size = def_buffer_size) const;
+  std::uint64_t decrypt_file(const std::string &in_path, const std::string &out_path,
+    std::size_t num_threads = 0, std::size_t buffer_size = def_buffer_size) const;
+};
+
+#endif
@@ -1,46 +1,60 @@
+/*
+
+  - build it with the cipher:
+      g++ -std=c++17 -O2 -mavx2 -pthread index.cpp Substitution_cipher.cpp
+
+  - with no arguments every line of the input is encrypted and decrypted, until the end of
+    it, with encrypt or decrypt, an input file and an output file, the file is, e.g.
+      ./a.out encrypt message.txt message.enc
+
+*/
+
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
 #include <string>
-#include <random>
+#include "Substitution_cipher.h"
 
-int main()
+int main(int argc, char *argv[])
 {
-  std::string alphabet {"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890"};
+  std::string alphabet {"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"};
   std::string key {"XZNLWEBGJHQDYVTKFUOMPCIASRxznlwebgjhqdyvtkfuompciasr"};
-
-  std::random_device rd; // obtain a random number from hardware
-  std::mt19937 gen(rd()); // seed the generator
-  std::uniform_int_distribution<> distr(0, key.length() - 1); // define the range
+  const Substitution_cipher cipher {alphabet, key};
+
+  if (argc == 4) {
+    const std::string mode {argv[1]};
+    try {
+      std::uint64_t bytes {0};
+      if (mode == "encrypt")
+        bytes = cipher.encrypt_file(argv[2], argv[3]);
+      else if (mode == "decrypt")
+        bytes = cipher.decrypt_file(argv[2], argv[3]);
+      else {
+        std::cerr << "the mode is encrypt or decrypt, not " << mode << std::endl;
+        return 1;
+      }
+      std::cout << bytes << " bytes " << mode << "ed into " << argv[3] << std::endl;
+    }
+    catch (const std::runtime_error &e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
 
   std::string message {};
   std::cout << "Enter your message: ";
-  std::getline(std::cin, message);
+  while (std::getline(std::cin, message)) {
+    std::cout << std::endl << "Encrypting and decrypting is processing..." << std::endl << std::endl;
 
-  std::cout << std::endl << "Encrypting and decrypting is processing..." << std::endl << std::endl;
+    const std::string encrypted_message {cipher.encrypt(message)};
+    const std::string decrypted_message {cipher.decrypt(encrypted_message)};
 
-  std::vector<size_t> alphabet_indexes {};
-  std::vector<size_t> key_indexes {};
-  int ran_num {};
-
-  for (size_t i {0}; i < message.length(); i++) {
-    key_indexes.push_back(distr(gen));
-    alphabet_indexes.push_back(alphabet.find(message[i]));
+    std::cout << "Encrypted message is: " << encrypted_message << std::endl << std::endl;
+    std::cout << "Decrypted message is: " << decrypted_message << std::endl << std::endl;
+    std::cout << "Enter your message: ";
   }
-
-  std::string encrypted_message {};
-  std::string decrypted_message {};
-
-  for (size_t i {0}; i < message.length(); i++) {
-    encrypted_message += key.at(key_indexes.at(i));
-
-    if (alphabet_indexes.at(i) != std::string::npos) {
-      decrypted_message += alphabet.at(alphabet_indexes.at(i));
-    } else {
-      decrypted_message += message.at(i);
-    }
-  }
-
-  std::cout << "Encrypted message is: " << encrypted_message << std::endl << std::endl;
-  std::cout << "Decrypted message is: " << decrypted_message << std::endl << std::endl;
+  std::cout << std::endl;
 
   return 0;
 }
@@ -0,0 +1,164 @@
+/*
+
+  - checks the Substitution_cipher of ../challenge first: every byte, at every length and
+    offset around the 32 of a SIMD step, is what its table says and decrypts back, and a file
+    streamed with small buffers and several threads decrypts back to the same bytes.
+
+  - then compares, in MB/s, the find in the alphabet per character with a += of the result,
+    as the challenge did, a scalar lookup in a table of 256, the lookup of the cipher, and
+    encrypt_file on a file of the same size, the time of a disk write with it.
+
+  - build it together with the cipher:
+      g++ -std=c++17 -O2 -mavx2 -pthread index.cpp ../challenge/Substitution_cipher.cpp
+
+  - 256 MB by default, the size in MB can be given on the command line, e.g. ./a.out 16
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../challenge/Substitution_cipher.h"
+
+const std::string alphabet {"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+const std::string key {"XZNLWEBGJHQDYVTKFUOMPCIASRxznlwebgjhqdyvtkfuompciasr"};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename F>
+void run(const std::string &name, std::size_t bytes, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const std::uint64_t checksum = f();
+  const double seconds = seconds_since(start);
+  std::cout << std::setw(28) << std::left << name << std::setw(10) << std::right << std::fixed 
+    << std::setprecision(0) << bytes / seconds / 1e6 << " MB/s" << std::setw(16) << checksum << std::endl;
+}
+
+std::uint64_t checksum_of(const std::string &text)
+{
+  std::uint64_t sum {0};
+  for (std::size_t i {0}; i < text.size(); i += 4096)
+    sum += static_cast<unsigned char>(text[i]);
+  return sum;
+}
+
+bool write_file(const std::string &path, const std::string &text)
+{
+  std::ofstream out {path, std::ios::binary};
+  return static_cast<bool>(out.write(text.data(), static_cast<std::streamsize>(text.size())));
+}
+
+std::string read_file(const std::string &path)
+{
+  std::ifstream in {path, std::ios::binary};
+  return std::string {std::istreambuf_iterator<char> {in}, std::istreambuf_iterator<char> {}};
+}
+
+bool check(const Substitution_cipher &cipher)
+{
+  std::string all(256 + 100, '\0');
+  for (std::size_t i {0}; i < all.size(); i++)
+    all[i] = static_cast<char>(i * 7);
+
+  for (std::size_t offset {0}; offset < 33; offset++)
+    for (std::size_t length {0}; offset + length <= all.size(); length += length < 70 ? 1 : 37) {
+      std::string text = all.substr(offset, length);
+      std::string encrypted {text};
+      cipher.encrypt(encrypted.data(), encrypted.size());
+      for (std::size_t i {0}; i < text.size(); i++)
+        if (encrypted[i] != cipher.encrypt(text[i]))
+          return false;
+      cipher.decrypt(encrypted.data(), encrypted.size());
+      if (encrypted != text)
+        return false;
+    }
+
+  std::mt19937 gen {3};
+  std::string text(1'000'003, '\0');
+  for (char &c : text)
+    c = static_cast<char>(gen());
+  const std::string plain_path {"cipher_check.txt"}, encrypted_path {"cipher_check.enc"}, decrypted_path {"cipher_check.dec"};
+  bool same = write_file(plain_path, text);
+  for (std::size_t threads : {1, 3, 8})
+    for (std::size_t buffer_size : {1, 4099, 1 << 20}) {
+      same = same && cipher.encrypt_file(plain_path, encrypted_path, threads, buffer_size) == text.size()
+        && read_file(encrypted_path) == cipher.encrypt(text)
+        && cipher.decrypt_file(encrypted_path, decrypted_path, threads, buffer_size) == text.size()
+        && read_file(decrypted_path) == text;
+    }
+  std::remove(plain_path.c_str());
+  std::remove(encrypted_path.c_str());
+  std::remove(decrypted_path.c_str());
+  return same;
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+  const std::size_t size = megabytes * 1'000'000;
+  const Substitution_cipher cipher {alphabet, key};
+
+  if (!check(cipher)) {
+    std::cout << "round trip: failed" << std::endl;
+    return 1;
+  }
+  std::cout << "round trip: ok" << std::endl;
+
+  // text, letters, digits, spaces and newlines
+  const std::string chars {alphabet + "0123456789     \n.,"};
+  std::mt19937 gen {7};
+  std::uniform_int_distribution<std::size_t> pick {0, chars.size() - 1};
+  std::string text(size, ' ');
+  for (char &c : text)
+    c = chars[pick(gen)];
+
+  run("find and +=", size, [&] {
+    std::string encrypted {};
+    for (char c : text) {
+      const std::size_t i = alphabet.find(c);
+      encrypted += i == std::string::npos ? c : key[i];
+    }
+    return checksum_of(encrypted);
+  });
+  // copied before the clock starts, the copy is not timed, the page faults are not either
+  std::string encrypted {text};
+  unsigned char table[256];
+  for (int c {0}; c < 256; c++)
+    table[c] = static_cast<unsigned char>(cipher.encrypt(static_cast<char>(c)));
+  run("scalar table", size, [&] {
+    for (char &c : encrypted)
+      c = static_cast<char>(table[static_cast<unsigned char>(c)]);
+    return checksum_of(encrypted);
+  });
+  encrypted = text;
+  run("Substitution_cipher", size, [&] {
+    cipher.encrypt(encrypted.data(), encrypted.size());
+    return checksum_of(encrypted);
+  });
+
+  const std::string plain_path {"cipher_bench.txt"}, encrypted_path {"cipher_bench.enc"};
+  if (write_file(plain_path, text))
+    run("encrypt_file", size, [&] {
+      cipher.encrypt_file(plain_path, encrypted_path);
+      std::ifstream in {encrypted_path, std::ios::binary};
+      std::string first(1 << 20, '\0');
+      in.read(first.data(), static_cast<std::streamsize>(first.size()));
+      return checksum_of(first);
+    });
+  std::remove(plain_path.c_str());
+  std::remove(encrypted_path.c_str());
+
+  return 0;
+}
@@ -0,0 +1,447 @@
+#ifndef _ROPE_H_
+#define _ROPE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/*
+
+  - a rope, the text of an editor, a balanced tree of chunks of characters that are never
+    changed, a std::string moves every character after an insert or an erase, a rope makes
+    new nodes on one path of the tree:
+
+      - insert, erase, replace and append are O(log n), a split of the tree at the positions
+        and a join of the parts, the way an AVL tree joins two trees, the height of the
+        children of a node differs by 1 at most
+      - substr shares the chunks of the text, a chunk of a leaf is a slice of a buffer that
+        is shared by all its slices, only the nodes on the edges of the range are new
+      - a copy is a shared_ptr, O(1), the copies are snapshots of the text, an undo is a
+        copy from before the edit
+      - the text is cut into chunks of 1 KiB, 16 lines of the cache, and two leaves next to
+        each other that fit in 2 KiB are merged into one, a chain of short inserts at the
+        cursor makes leaves of 2 KiB and not leaves of a character
+      - for_each_chunk, find and the iterators read the chunks in order, a scan is linear,
+        at the speed of the chunks and not of a search down the tree for every character
+
+  - the buffer of a text stays as long as one of its slices is in a rope, an erase of most
+    of a text does not give back its memory.
+
+*/
+
+class Rope
+{
+public:
+  static constexpr std::size_t chunk_size = 1024;
+  static constexpr std::size_t max_leaf = 2 * chunk_size;
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+  struct Node;
+  using Node_ptr = std::shared_ptr<const Node>;
+  using Buffer_ptr = std::shared_ptr<const std::string>;
+
+  struct Node
+  {
+    std::size_t length;
+    // 0 for a leaf
+    int height;
+    Node_ptr left;
+    Node_ptr right;
+    // a leaf, the characters from data are a slice of text
+    Buffer_ptr text;
+    const char *data;
+  };
+
+  Node_ptr root;
+
+  explicit Rope(Node_ptr root) : root {std::move(root)} {}
+
+  static Node_ptr leaf(Buffer_ptr text, const char *data, std::size_t length)
+  {
+    return std::make_shared<const Node>(Node {length, 0, nullptr, nullptr, std::move(text), data});
+  }
+
+  static Node_ptr node(Node_ptr left, Node_ptr right)
+  {
+    const std::size_t length {left->length + right->length};
+    const int height {1 + std::max(left->height, right->height)};
+    return std::make_shared<const Node>(Node {length, height, std::move(left), std::move(right), nullptr, nullptr});
+  }
+
+  static bool fit(const Node_ptr &left, const Node_ptr &right)
+  {
+    return left->height == 0 && right->height == 0 && left->length + right->length <= max_leaf;
+  }
+
+  static Node_ptr merged(const Node_ptr &left, const Node_ptr &right)
+  {
+    auto text = std::make_shared<std::string>();
+    text->reserve(left->length + right->length);
+    text->append(left->data, left->length).append(right->data, right->length);
+    const char *data {text->data()};
+    const std::size_t length {text->size()};
+    return leaf(std::move(text), data, length);
+  }
+
+  // a node of two trees of about the same height, the leaves next to each other are merged
+  // when they fit in one, the height is never more than the one of the node
+  static Node_ptr pair(const Node_ptr &left, const Node_ptr &right)
+  {
+    if (fit(left, right))
+      return merged(left, right);
+    if (left->height == 1 && right->height == 0 && fit(left->right, right))
+      return node(left->left, merged(left->right, right));
+    if (right->height == 1 && left->height == 0 && fit(left, right->left))
+      return node(merged(left, right->left), right->right);
+    return node(left, right);
+  }
+
+  // left is taller than right by 2 or more, right goes down the right side of left to a
+  // subtree of its height, and the nodes on the way back up are rotated
+  static Node_ptr join_right(const Node_ptr &left, const Node_ptr &right)
+  {
+    const Node_ptr joined {left->right->height <= right->height + 1 ? pair(left->right, right) : join_right(left->right, right)};
+    if (joined->height <= left->left->height + 1)
+      return node(left->left, joined);
+    // joined is 2 taller than left->left
+    if (joined->left->height > joined->right->height) {
+      const Node_ptr &middle {joined->left};
+      return node(node(left->left, middle->left), node(middle->right, joined->right));
+    }
+    return node(node(left->left, joined->left), joined->right);
+  }
+
+  static Node_ptr join_left(const Node_ptr &left, const Node_ptr &right)
+  {
+    const Node_ptr joined {right->left->height <= left->height + 1 ? pair(left, right->left) : join_left(left, right->left)};
+    if (joined->height <= right->right->height + 1)
+      return node(joined, right->right);
+    if (joined->right->height > joined->left->height) {
+      const Node_ptr &middle {joined->right};
+      return node(node(joined->left, middle->left), node(middle->right, right->right));
+    }
+    return node(joined->left, node(joined->right, right->right));
+  }
+
+  // O(the difference of the heights)
+  static Node_ptr join(const Node_ptr &left, const Node_ptr &right)
+  {
+    if (!left)
+      return right;
+    if (!right)
+      return left;
+    if (left->height > right->height + 1)
+      return join_right(left, right);
+    if (right->height > left->height + 1)
+      return join_left(left, right);
+    return pair(left, right);
+  }
+
+  // the characters before position and the ones from it, the joins on the way back up cost
+  // O(log n) all together, the heights of the parts grow one level at a time
+  static std::pair<Node_ptr, Node_ptr> split(const Node_ptr &tree, std::size_t position)
+  {
+    if (!tree || position == 0)
+      return {nullptr, tree};
+    if (position >= tree->length)
+      return {tree, nullptr};
+    if (tree->height == 0)
+      return {leaf(tree->text, tree->data, position), leaf(tree->text, tree->data + position, tree->length - position)};
+
+    const std::size_t left_length {tree->left->length};
+    if (position <= left_length) {
+      auto parts = split(tree->left, position);
+      return {std::move(parts.first), join(parts.second, tree->right)};
+    }
+    auto parts = split(tree->right, position - left_length);
+    return {join(tree->left, parts.first), std::move(parts.second)};
+  }
+
+  // the characters of [from, to), from < to <= tree->length, a split without the parts
+  // that are not kept, the nodes inside the range are shared as they are
+  static Node_ptr slice(const Node_ptr &tree, std::size_t from, std::size_t to)
+  {
+    if (from == 0 && to == tree->length)
+      return tree;
+    if (tree->height == 0)
+      return leaf(tree->text, tree->data + from, to - from);
+
+    const std::size_t left_length {tree->left->length};
+    if (to <= left_length)
+      return slice(tree->left, from, to);
+    if (from >= left_length)
+      return slice(tree->right, from - left_length, to - left_length);
+    return join(slice(tree->left, from, left_length), slice(tree->right, 0, to - left_length));
+  }
+
+  // leaves of chunk_size, the last one is shorter, the halves are whole chunks
+  static Node_ptr build(const Buffer_ptr &text, const char *data, std::size_t length)
+  {
+    if (length <= chunk_size)
+      return leaf(text, data, length);
+    const std::size_t half {(length + chunk_size - 1) / chunk_size / 2 * chunk_size};
+    return node(build(text, data, half), build(text, data + half, length - half));
+  }
+
+  static Node_ptr build(std::string text)
+  {
+    if (text.empty())
+      return nullptr;
+    const Buffer_ptr buffer {std::make_shared<const std::string>(std::move(text))};
+    return build(buffer, buffer->data(), buffer->size());
+  }
+
+  // f of the chunks of [from, to), from < to <= tree->length, false when f stopped it
+  template <typename F>
+  static bool visit(const Node *tree, std::size_t from, std::size_t to, F &f)
+  {
+    if (tree->height == 0) {
+      const std::string_view chunk {tree->data + from, to - from};
+      if constexpr (std::is_same_v<decltype(f(chunk)), bool>)
+        return f(chunk);
+      else {
+        f(chunk);
+        return true;
+      }
+    }
+    const std::size_t left_length {tree->left->length};
+    if (from < left_length && !visit(tree->left.get(), from, std::min(to, left_length), f))
+      return false;
+    if (to > left_length)
+      return visit(tree->right.get(), from > left_length ? from - left_length : 0, to - left_length, f);
+    return true;
+  }
+
+  void check(std::size_t position, const char *what) const
+  {
+    if (position > this->size())
+      throw std::out_of_range(std::string {"Rope::"} + what + ": the position is past the end of the text");
+  }
+
+public:
+  class const_iterator
+  {
+  private:
+    friend class Rope;
+
+    // the leaf of the next character is found from the root, O(log n) once per leaf, an
+    // iterator is 4 words, the algorithms copy it, a stack of the path is a copy per step
+    const Node *root {nullptr};
+    const char *current {nullptr};
+    const char *end {nullptr};
+    std::size_t position {0};
+
+    void find_leaf()
+    {
+      if (!this->root || this->position >= this->root->length) {
+        this->current = this->end = nullptr;
+        return;
+      }
+      const Node *tree {this->root};
+      std::size_t offset {this->position};
+      while (tree->height > 0) {
+        if (offset < tree->left->length)
+          tree = tree->left.get();
+        else {
+          offset -= tree->left->length;
+          tree = tree->right.get();
+        }
+      }
+      this->current = tree->data + offset;
+      this->end = tree->data + tree->length;
+    }
+
+    const_iterator(const Node *root, std::size_t position) : root {root}, position {position}
+    {
+      this->find_leaf();
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char *;
+    using reference = const char &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return *this->current; }
+    pointer operator->() const { return this->current; }
+
+    const_iterator &operator++()
+    {
+      this->position++;
+      if (++this->current == this->end)
+        this->find_leaf();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator before {*this};
+      ++*this;
+      return before;
+    }
+
+    // two positions of a rope can be the same character of a buffer that it has twice
+    bool operator==(const const_iterator &other) const { return this->position == other.position; }
+    bool operator!=(const const_iterator &other) const { return this->position != other.position; }
+  };
+
+  Rope() = default;
+  explicit Rope(std::string text) : root {build(std::move(text))} {}
+
+  std::size_t size() const { return this->root ? this->root->length : 0; }
+  std::size_t length() const { return this->size(); }
+  bool empty() const { return !this->root; }
+  int height() const { return this->root ? this->root->height : 0; }
+
+  // O(log n)
+  char operator[](std::size_t position) const
+  {
+    const Node *tree {this->root.get()};
+    while (tree->height > 0) {
+      if (position < tree->left->length)
+        tree = tree->left.get();
+      else {
+        position -= tree->left->length;
+        tree = tree->right.get();
+      }
+    }
+    return tree->data[position];
+  }
+
+  char at(std::size_t position) const
+  {
+    if (position >= this->size())
+      throw std::out_of_range("Rope::at: the position is past the end of the text");
+    return (*this)[position];
+  }
+
+  Rope substr(std::size_t position, std::size_t count = npos) const
+  {
+    this->check(position, "substr");
+    const std::size_t last {count < this->size() - position ? position + count : this->size()};
+    return Rope {position < last ? slice(this->root, position, last) : nullptr};
+  }
+
+  Rope &insert(std::size_t position, const Rope &text)
+  {
+    this->check(position, "insert");
+    auto parts = split(this->root, position);
+    this->root = join(join(parts.first, text.root), parts.second);
+    return *this;
+  }
+
+  Rope &insert(std::size_t position, std::string_view text)
+  {
+    return this->insert(position, Rope {std::string {text}});
+  }
+
+  Rope &erase(std::size_t position, std::size_t count = npos)
+  {
+    this->check(position, "erase");
+    auto parts = split(this->root, position);
+    this->root = join(parts.first, split(parts.second, count).second);
+    return *this;
+  }
+
+  Rope &replace(std::size_t position, std::size_t count, std::string_view text)
+  {
+    this->check(position, "replace");
+    auto parts = split(this->root, position);
+    this->root = join(join(parts.first, build(std::string {text})), split(parts.second, count).second);
+    return *this;
+  }
+
+  Rope &append(const Rope &text)
+  {
+    this->root = join(this->root, text.root);
+    return *this;
+  }
+
+  Rope &append(std::string_view text) { return this->append(Rope {std::string {text}}); }
+  Rope &operator+=(const Rope &text) { return this->append(text); }
+  Rope &operator+=(std::string_view text) { return this->append(text); }
+
+  friend Rope operator+(const Rope &left, const Rope &right) { return Rope {join(left.root, right.root)}; }
+
+  // f(std::string_view) of the chunks of [position, position + count) in order, a bool f
+  // stops at the first false
+  template <typename F>
+  void for_each_chunk(std::size_t position, std::size_t count, F f) const
+  {
+    this->check(position, "for_each_chunk");
+    const std::size_t last {count < this->size() - position ? position + count : this->size()};
+    if (position < last)
+      visit(this->root.get(), position, last, f);
+  }
+
+  template <typename F>
+  void for_each_chunk(F f) const
+  {
+    this->for_each_chunk(0, npos, std::move(f));
+  }
+
+  // the chunks in a window of the last needle.size() - 1 characters, a match can be on two
+  std::size_t find(std::string_view needle, std::size_t position = 0) const
+  {
+    if (position > this->size())
+      return npos;
+    if (needle.empty())
+      return position;
+
+    std::string window;
+    std::size_t window_position {position};
+    std::size_t found {npos};
+    this->for_each_chunk(position, npos, [&](std::string_view chunk) {
+      window.append(chunk);
+      const std::size_t at {window.find(needle)};
+      if (at != std::string::npos) {
+        found = window_position + at;
+        return false;
+      }
+      const std::size_t dropped {window.size() - std::min(window.size(), needle.size() - 1)};
+      window.erase(0, dropped);
+      window_position += dropped;
+      return true;
+    });
+    return found;
+  }
+
+  std::string str() const
+  {
+    std::string text;
+    text.reserve(this->size());
+    this->for_each_chunk([&text](std::string_view chunk) { text.append(chunk); });
+    return text;
+  }
+
+  const_iterator begin() const { return const_iterator {this->root.get(), 0}; }
+  const_iterator end() const { return const_iterator {this->root.get(), this->size()}; }
+  // an iterator at position, O(log n)
+  const_iterator iterator_at(std::size_t position) const { return const_iterator {this->root.get(), position}; }
+
+  friend bool operator==(const Rope &left, const Rope &right)
+  {
+    return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+  }
+
+  friend bool operator!=(const Rope &left, const Rope &right) { return !(left == right); }
+
+  friend std::ostream &operator<<(std::ostream &os, const Rope &rope)
+  {
+    rope.for_each_chunk([&os](std::string_view chunk) { os << chunk; });
+    return os;
+  }
+};
+
+#endif
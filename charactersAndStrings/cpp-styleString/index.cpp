@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include "Rope.h"
 
 int main()
 {
@@ -115,6 +116,29 @@ int main()
   
   std::cout << std::endl;
 
+  std::cout << "Rope" << std::endl 
+    << "------------------------------" << std::endl;
+
+  Rope r1 {"This is a test"};
+
+  r1.insert(10, "short ");
+  std::cout << "r1 after insert: " << r1 << std::endl;
+  r1.erase(0, 5);
+  std::cout << "r1 after erase: " << r1 << std::endl;
+  r1.replace(5, 5, "one");
+  std::cout << "r1 after replace: " << r1 << std::endl;
+
+  Rope r2 {r1.substr(5, 3)};
+  std::cout << "r2 is a substr of r1 that shares its chunks: " << r2 << std::endl;
+  std::cout << "r1 + r2: " << r1 + Rope {" "} + r2 << std::endl;
+  std::cout << "test is at: " << r1.find("test") << std::endl;
+
+  for (char c : r2)
+    std::cout << c << ' ';
+  std::cout << std::endl;
+  
+  std::cout << std::endl;
+
   std::cout << "getline" << std::endl 
     << "------------------------------" << std::endl;
 
@@ -0,0 +1,193 @@
+/*
+
+  - the Rope of ../cpp-styleString/Rope.h against a std::string, the text of an editor,
+    romeoAndJuliet.txt 1000 times, 138 MB, or the number of times given as the first
+    argument:
+
+      - the text from the string of the file, the rope is built on it and does not copy it
+      - 200 inserts of 16 characters and 200 erases of 16 at random positions, or the number
+        given as the second argument, and 1000 characters typed at a cursor in the middle
+      - 1000 substrs of 64 KiB, and a snapshot of the text, the copy an undo keeps
+      - a scan, the lines counted with std::count, over the chunks of the rope and with its
+        iterators
+
+  - the texts have to be the same after the edits, the substrs and the counts too.
+
+  - on one core of an x86-64 at -O2, 138 MB:
+
+                                   std::string          Rope
+        from the file, ms                  0.000        16.2
+        400 edits, ms                   2436             3.93
+        1000 characters typed, ms       6645             0.97
+        1000 substrs of 64 KiB, ms         9.17          6.94
+        a snapshot, ms                    13.9           0.000
+        lines, chunks, ms                 53.3          83.6
+        lines, iterators, ms              53.3         101
+
+    height of the rope: 20
+
+    an edit of the rope is about 10 us whatever the size of the text, a split and a join of
+    20 levels, one of the string moves half of it, 70 MB, 6 ms, 600 times more. a character
+    typed at the cursor is 1 us, it is merged into the leaf before it. a scan over the chunks
+    is 1.6 times slower than the one of the string, a leaf is 1 KiB and the next one is not
+    next to it in memory, the iterators find the leaf of the next chunk from the root.
+
+      g++ -std=c++17 -O2 index.cpp
+
+  - run it from this directory, it reads ../../ioAndStream/challenge4/romeoAndJuliet.txt
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../cpp-styleString/Rope.h"
+
+template <typename F>
+double best_of_5(F f)
+{
+  double best = 1e300;
+  for (int run = 0; run < 5; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+// the edits change the text, they are timed once
+template <typename F>
+double once(F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void print(const std::string &what, double text, double rope)
+{
+  std::cout << std::setw(32) << std::left << what << std::right << std::fixed << std::setprecision(3) << std::setw(14)
+            << text * 1e3 << std::setw(14) << rope * 1e3 << std::endl;
+}
+
+struct Edit
+{
+  bool insert;
+  std::size_t position;
+};
+
+int main(int argc, char *argv[])
+{
+  const std::size_t copies = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+  const std::size_t edits = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  std::size_t mismatches = 0;
+
+  std::ifstream file {"../../ioAndStream/challenge4/romeoAndJuliet.txt"};
+  if (!file)
+    throw std::runtime_error {"romeoAndJuliet.txt can not be opened"};
+  std::stringstream book;
+  book << file.rdbuf();
+  std::string loaded;
+  loaded.reserve(book.str().size() * copies);
+  for (std::size_t i = 0; i < copies; ++i)
+    loaded += book.str();
+
+  std::uint64_t seed = 12345;
+  auto next = [&seed]() {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<std::uint32_t>(seed >> 33);
+  };
+  auto at = [&next](std::size_t size) { return (static_cast<std::size_t>(next()) << 32 | next()) % size; };
+
+  std::cout << loaded.size() << " characters" << std::endl;
+  std::cout << std::setw(32) << "" << std::setw(14) << "std::string" << std::setw(14) << "Rope" << std::endl;
+
+  std::string text;
+  Rope rope;
+  {
+    std::string for_text {loaded}, for_rope {loaded};
+    const double moved = once([&] { text = std::move(for_text); });
+    const double built = once([&] { rope = Rope {std::move(for_rope)}; });
+    print("from the file, ms", moved, built);
+  }
+
+  // the same edits on both, an insert and an erase in turn
+  std::vector<Edit> plan;
+  std::size_t size = text.size();
+  for (std::size_t i = 0; i < 2 * edits; ++i)
+  {
+    const bool insert = i % 2 == 0;
+    plan.push_back({insert, at(size - 16)});
+    size = insert ? size + 16 : size - 16;
+  }
+  const std::string inserted {"a rose by any na"};
+  const double text_edits = once([&] {
+    for (const Edit &edit : plan)
+      edit.insert ? text.insert(edit.position, inserted) : text.erase(edit.position, 16);
+  });
+  const double rope_edits = once([&] {
+    for (const Edit &edit : plan)
+      edit.insert ? rope.insert(edit.position, inserted) : rope.erase(edit.position, 16);
+  });
+  print(std::to_string(plan.size()) + " edits, ms", text_edits, rope_edits);
+
+  const std::size_t cursor = text.size() / 2;
+  const std::string typed {"wherefore art thou Romeo? "};
+  const double text_typing = once([&] {
+    for (std::size_t i = 0; i < 1000; ++i)
+      text.insert(cursor + i, 1, typed[i % typed.size()]);
+  });
+  const double rope_typing = once([&] {
+    for (std::size_t i = 0; i < 1000; ++i)
+      rope.insert(cursor + i, std::string_view {&typed[i % typed.size()], 1});
+  });
+  print("1000 characters typed, ms", text_typing, rope_typing);
+  mismatches += rope.size() != text.size() || rope.str() != text;
+
+  std::vector<std::size_t> starts;
+  for (std::size_t i = 0; i < 1000; ++i)
+    starts.push_back(at(text.size() - 65536));
+  std::vector<std::string> text_parts(starts.size());
+  std::vector<Rope> rope_parts(starts.size());
+  const double text_substrs = best_of_5([&] {
+    for (std::size_t i = 0; i < starts.size(); ++i)
+      text_parts[i] = text.substr(starts[i], 65536);
+  });
+  const double rope_substrs = best_of_5([&] {
+    for (std::size_t i = 0; i < starts.size(); ++i)
+      rope_parts[i] = rope.substr(starts[i], 65536);
+  });
+  print("1000 substrs of 64 KiB, ms", text_substrs, rope_substrs);
+  for (std::size_t i = 0; i < starts.size(); ++i)
+    mismatches += rope_parts[i].str() != text_parts[i];
+
+  std::string text_snapshot;
+  Rope rope_snapshot;
+  const double text_copy = best_of_5([&] { text_snapshot = text; });
+  const double rope_copy = best_of_5([&] { rope_snapshot = rope; });
+  print("a snapshot, ms", text_copy, rope_copy);
+
+  std::size_t text_lines = 0, chunk_lines = 0, iterator_lines = 0;
+  const double text_scan = best_of_5([&] { text_lines = std::count(text.begin(), text.end(), '\n'); });
+  const double chunk_scan = best_of_5([&] {
+    chunk_lines = 0;
+    rope.for_each_chunk([&](std::string_view chunk) { chunk_lines += std::count(chunk.begin(), chunk.end(), '\n'); });
+  });
+  const double iterator_scan = best_of_5([&] { iterator_lines = std::count(rope.begin(), rope.end(), '\n'); });
+  print("lines, chunks, ms", text_scan, chunk_scan);
+  print("lines, iterators, ms", text_scan, iterator_scan);
+  mismatches += chunk_lines != text_lines || iterator_lines != text_lines;
+
+  std::cout << "height of the rope: " << rope.height() << ", mismatches: " << mismatches << std::endl;
+
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+cmake_minimum_required(VERSION 3.23)
+
+#[[
+
+  - the macro benchmarks, the challenge programs run end to end on the datasets of
+    tooling/datasets, as a script:
+      cmake -P cmake/Macro.cmake
+      cmake -DBINARY_DIR=/tmp/macro -DTEXT_MB=100 -DTRANSACTIONS=10000000 -P cmake/Macro.cmake
+
+  - it builds the programs in BINARY_DIR/release, Release, makes the inputs in
+    BINARY_DIR/inputs:
+      romeoAndJuliet.txt   TEXT_MB MB of Zipf text, 1000 by default, EXPONENT 1.07
+      responses.txt        STUDENTS students, 20M by default, CORRECT 0.7 of the answers right
+      accounts.csv         ACCOUNTS accounts, 1M by default, of the MIX 40:40:20 of checking,
+                           saving and trust
+      transactions.csv     TRANSACTIONS of them, 100M by default, WITHDRAWALS 0.4 of them
+                           withdrawals and OVERDRAFTS 0.05 of those over the balance
+    and runs every program once on them, with the run of tooling_datasets, what they print
+    is in BINARY_DIR/inputs/<label>.log,
+    the label with _ for its spaces and without its -, challengeThree_build.log.
+
+  - the report, BINARY_DIR/macro_report.txt, is the time of every run, reading and writing
+    the files too, its MB of input and records a second, and the peak of its resident
+    set. the inputs are made again every time, the same for the same sizes.
+
+  - on one core of an x86-64, the defaults, 3m50s with the inputs:
+      program                        s    MB/s   M records/s   peak MB
+      challengeThree --build      60.7    16.5             -      1117
+      challengeThree --sketch 1   22.9    43.6             -       958
+      challenge2 --batch           4.7    64.2           4.3      1546
+      challenge --batch           42.2    37.9           2.4        87
+    the index and the sketch hold the counts of 1 GB of words, the grader the whole file
+    and its report, the accounts are read a line at a time and are all it holds.
+
+]]
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if(NOT BINARY_DIR)
+  set(BINARY_DIR "${SOURCE_DIR}/build-macro")
+endif()
+foreach(setting "TEXT_MB|1000" "EXPONENT|1.07" "STUDENTS|20000000" "CORRECT|0.7" "ACCOUNTS|1000000" "MIX|40:40:20"
+    "TRANSACTIONS|100000000" "WITHDRAWALS|0.4" "OVERDRAFTS|0.05")
+  string(REPLACE "|" ";" setting "${setting}")
+  list(GET setting 0 name)
+  list(GET setting 1 value)
+  if(NOT DEFINED ${name})
+    set(${name} ${value})
+  endif()
+endforeach()
+
+set(release "${BINARY_DIR}/release")
+set(inputs "${BINARY_DIR}/inputs")
+set(report "${BINARY_DIR}/macro_report.txt")
+file(MAKE_DIRECTORY "${inputs}")
+file(REMOVE "${report}")
+
+function(macro_check result what)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${what} failed: ${result}")
+  endif()
+endfunction()
+
+set(targets tooling_datasets standardTemplateLibrary_challengeThree ioAndStream_challenge2 polymorphism_challenge)
+message(STATUS "building Release")
+execute_process(COMMAND "${CMAKE_COMMAND}" -S "${SOURCE_DIR}" -B "${release}" -DCMAKE_BUILD_TYPE=Release
+    "-DBASICS_BENCH_MARCH_VARIANTS="
+  OUTPUT_FILE "${BINARY_DIR}/configure.txt" RESULT_VARIABLE result)
+macro_check("${result}" "configure")
+execute_process(COMMAND "${CMAKE_COMMAND}" --build "${release}" --target ${targets}
+  OUTPUT_FILE "${BINARY_DIR}/build.txt" ERROR_FILE "${BINARY_DIR}/build.txt" RESULT_VARIABLE result)
+macro_check("${result}" "build, see ${BINARY_DIR}/build.txt")
+
+function(macro_make what)
+  message(STATUS "making ${what}")
+  execute_process(COMMAND "${release}/tooling_datasets" ${what} ${ARGN} WORKING_DIRECTORY "${inputs}"
+    RESULT_VARIABLE result)
+  macro_check("${result}" "making ${what}")
+endfunction()
+
+macro_make(text romeoAndJuliet.txt ${TEXT_MB} ${EXPONENT})
+macro_make(responses responses.txt ${STUDENTS} ${CORRECT})
+macro_make(bank accounts.csv transactions.csv ${ACCOUNTS} ${TRANSACTIONS} ${WITHDRAWALS} ${OVERDRAFTS} ${MIX})
+
+# label|the files it reads|its records|the program and its arguments, it runs in inputs
+set(runs
+  "challengeThree --build|romeoAndJuliet.txt|0|standardTemplateLibrary_challengeThree --build index.idx"
+  "challengeThree --sketch 1|romeoAndJuliet.txt|0|standardTemplateLibrary_challengeThree --sketch 1"
+  "challenge2 --batch|responses.txt|${STUDENTS}|ioAndStream_challenge2 --batch responses.txt"
+  "challenge --batch|accounts.csv transactions.csv|${TRANSACTIONS}|polymorphism_challenge --batch accounts.csv transactions.csv")
+
+foreach(run IN LISTS runs)
+  string(REPLACE "|" ";" fields "${run}")
+  list(POP_FRONT fields label files records command)
+  separate_arguments(files UNIX_COMMAND "${files}")
+  separate_arguments(command UNIX_COMMAND "${command}")
+  list(POP_FRONT command program)
+  set(bytes 0)
+  foreach(file IN LISTS files)
+    file(SIZE "${inputs}/${file}" size)
+    math(EXPR bytes "${bytes} + ${size}")
+  endforeach()
+
+  string(REPLACE " " "_" log "${label}")
+  string(REPLACE "-" "" log "${log}")
+  message(STATUS "running ${label}")
+  execute_process(COMMAND "${release}/tooling_datasets" run "${report}" "${log}" ${bytes} ${records} "${inputs}"
+      "${release}/${program}" ${command}
+    RESULT_VARIABLE result)
+  macro_check("${result}" "${label}, see ${inputs}/${log}.log")
+endforeach()
+
+file(READ "${report}" text)
+message("\n${text}")
+message(STATUS "report: ${report}")
@@ -0,0 +1,173 @@
+cmake_minimum_required(VERSION 3.23)
+
+#[[
+
+  - the profile guided build of the challenge programs, run as a script:
+      cmake -P cmake/Pgo.cmake
+      cmake -DBINARY_DIR=/tmp/pgo -DRUNS=5 -P cmake/Pgo.cmake
+
+  - it makes the training inputs in BINARY_DIR/inputs, the romeoAndJuliet.txt of
+    ioAndStream/challenge3 repeated SCALE times and the responses.txt of ioAndStream/challenge2
+    repeated 1000 * SCALE times, builds the programs in BINARY_DIR/release, Release, and in
+    BINARY_DIR/pgo, PgoGenerate, runs the instrumented ones on the inputs, builds them again
+    with the profile, PgoUse, and runs both builds RUNS times.
+
+  - the report, BINARY_DIR/pgo_report.txt, is the best time of every program in both builds,
+    the whole run, reading and writing the files too, and the speedup. the output of the
+    runs is in BINARY_DIR/logs.
+
+]]
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if(NOT BINARY_DIR)
+  set(BINARY_DIR "${SOURCE_DIR}/build-pgo")
+endif()
+if(NOT SCALE)
+  set(SCALE 20)
+endif()
+if(NOT RUNS)
+  set(RUNS 3)
+endif()
+
+set(inputs "${BINARY_DIR}/inputs")
+set(logs "${BINARY_DIR}/logs")
+file(MAKE_DIRECTORY "${inputs}" "${logs}")
+
+# name|the directory it runs in|its arguments, the programs read and write in inputs
+set(programs
+  "ioAndStream_challenge2|${inputs}|--batch responses.txt"
+  "ioAndStream_challenge3|${inputs}|Romeo Juliet love death night"
+  "ioAndStream_challenge4|${inputs}|romeoAndJuliet.txt numbered.txt 1"
+  "ioAndStream_copyingFile2|${inputs}|romeoAndJuliet.txt copy.txt"
+  "standardTemplateLibrary_challengeThree|${inputs}|--build index.idx"
+  "bench_standardTemplateLibrary_challengeThree|${SOURCE_DIR}/standardTemplateLibrary/challengeThreeBenchmark|${SCALE}"
+  "bench_ioAndStream_challenge|${inputs}|1000000"
+  "bench_exception_challenge|${inputs}|"
+  "bench_polymorphism_challenge|${inputs}|1000000"
+  "bench_polymorphism_challengeDispatch|${inputs}|1000000")
+
+function(pgo_check result what)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${what} failed: ${result}")
+  endif()
+endfunction()
+
+function(pgo_repeat from to times)
+  file(READ "${from}" text)
+  set(first_line "")
+  if(ARGN)
+    # the answer key of the responses is once, the students are repeated
+    string(FIND "${text}" "\n" end)
+    math(EXPR end "${end} + 1")
+    string(SUBSTRING "${text}" 0 ${end} first_line)
+    string(SUBSTRING "${text}" ${end} -1 text)
+  endif()
+  set(copies "${text}")
+  set(count 1)
+  while(count LESS times)
+    string(APPEND copies "${text}")
+    math(EXPR count "${count} + 1")
+  endwhile()
+  file(WRITE "${to}" "${first_line}${copies}")
+endfunction()
+
+message(STATUS "inputs: ${inputs}")
+math(EXPR responses_scale "${SCALE} * 1000")
+pgo_repeat("${SOURCE_DIR}/ioAndStream/challenge3/romeoAndJuliet.txt" "${inputs}/romeoAndJuliet.txt" ${SCALE})
+pgo_repeat("${SOURCE_DIR}/ioAndStream/challenge2/responses.txt" "${inputs}/responses.txt" ${responses_scale} key)
+
+set(targets "")
+foreach(program IN LISTS programs)
+  string(REPLACE "|" ";" fields "${program}")
+  list(GET fields 0 name)
+  list(APPEND targets ${name})
+endforeach()
+
+function(pgo_build dir type)
+  execute_process(COMMAND "${CMAKE_COMMAND}" -S "${SOURCE_DIR}" -B "${dir}" -DCMAKE_BUILD_TYPE=${type}
+      "-DBASICS_BENCH_MARCH_VARIANTS=" -DBASICS_PGO_DIR=${dir}/profile
+    OUTPUT_FILE "${logs}/configure_${type}.txt" RESULT_VARIABLE result)
+  pgo_check("${result}" "configure of ${type}")
+  execute_process(COMMAND "${CMAKE_COMMAND}" --build "${dir}" --target ${targets}
+    OUTPUT_FILE "${logs}/build_${type}.txt" ERROR_FILE "${logs}/build_${type}.txt" RESULT_VARIABLE result)
+  pgo_check("${result}" "build of ${type}, see ${logs}/build_${type}.txt")
+endfunction()
+
+# the best time of RUNS runs, in microseconds
+function(pgo_time out dir name cwd args runs)
+  set(best "")
+  foreach(run RANGE 1 ${runs})
+    string(TIMESTAMP start "%s%f")
+    execute_process(COMMAND "${dir}/${name}" ${args} WORKING_DIRECTORY "${cwd}"
+      OUTPUT_FILE "${logs}/${name}.txt" ERROR_FILE "${logs}/${name}.txt" RESULT_VARIABLE result)
+    string(TIMESTAMP end "%s%f")
+    pgo_check("${result}" "${name}")
+    math(EXPR elapsed "${end} - ${start}")
+    if(best STREQUAL "" OR elapsed LESS best)
+      set(best ${elapsed})
+    endif()
+  endforeach()
+  set(${out} ${best} PARENT_SCOPE)
+endfunction()
+
+message(STATUS "building Release")
+pgo_build("${BINARY_DIR}/release" Release)
+
+message(STATUS "building PgoGenerate")
+file(REMOVE_RECURSE "${BINARY_DIR}/pgo/profile")
+pgo_build("${BINARY_DIR}/pgo" PgoGenerate)
+
+message(STATUS "training")
+foreach(program IN LISTS programs)
+  string(REPLACE "|" ";" fields "${program}")
+  list(POP_FRONT fields name cwd args)
+  separate_arguments(args UNIX_COMMAND "${args}")
+  pgo_time(ignored "${BINARY_DIR}/pgo" ${name} "${cwd}" "${args}" 1)
+endforeach()
+
+message(STATUS "building PgoUse")
+pgo_build("${BINARY_DIR}/pgo" PgoUse)
+
+# the name on the left of 46 characters, the values on the right of 11 each
+function(pgo_row out name)
+  string(LENGTH "${name}" length)
+  math(EXPR padding "46 - ${length}")
+  string(REPEAT " " ${padding} spaces)
+  set(row "${name}${spaces}")
+  foreach(value IN LISTS ARGN)
+    string(LENGTH "${value}" length)
+    math(EXPR padding "11 - ${length}")
+    string(REPEAT " " ${padding} spaces)
+    string(APPEND row "${spaces}${value}")
+  endforeach()
+  set(${out} "${row}\n" PARENT_SCOPE)
+endfunction()
+
+pgo_row(report program "Release ms" "PGO ms" speedup)
+foreach(program IN LISTS programs)
+  string(REPLACE "|" ";" fields "${program}")
+  list(POP_FRONT fields name cwd args)
+  separate_arguments(args UNIX_COMMAND "${args}")
+  message(STATUS "timing ${name}")
+  pgo_time(release "${BINARY_DIR}/release" ${name} "${cwd}" "${args}" ${RUNS})
+  pgo_time(pgo "${BINARY_DIR}/pgo" ${name} "${cwd}" "${args}" ${RUNS})
+
+  # ms with one decimal and the speedup with two, in integers
+  math(EXPR release_ms "${release} / 1000")
+  math(EXPR release_tenth "${release} / 100 % 10")
+  math(EXPR pgo_ms "${pgo} / 1000")
+  math(EXPR pgo_tenth "${pgo} / 100 % 10")
+  math(EXPR speedup "${release} * 100 / (${pgo} + 1)")
+  math(EXPR speedup_units "${speedup} / 100")
+  math(EXPR speedup_hundredths "${speedup} % 100")
+  if(speedup_hundredths LESS 10)
+    set(speedup_hundredths "0${speedup_hundredths}")
+  endif()
+
+  pgo_row(row ${name} "${release_ms}.${release_tenth}" "${pgo_ms}.${pgo_tenth}" "${speedup_units}.${speedup_hundredths}x")
+  string(APPEND report "${row}")
+endforeach()
+
+file(WRITE "${BINARY_DIR}/pgo_report.txt" "${report}")
+message("\n${report}")
+message(STATUS "report: ${BINARY_DIR}/pgo_report.txt")
@@ -1,128 +1,165 @@
 #include <iostream>
-#include <vector>
 #include <iomanip>
+#include <stdexcept>
+#include <string>
+#include "../../functions/challenge/Number_list.h"
+#include "../../tooling/batchInput/Batch_io.h"
+#include "../../tooling/fastConsole/Fast_console.h"
 
-int main()
-{
-  std::vector<int> numbers;
-  char option {};
+/*
 
-  do {
-    std::cout << "P. print numbers" << std::endl;
-    std::cout << "A. add a number" << std::endl;
-    std::cout << "M. display mean of the numbers" << std::endl;
-    std::cout << "S. display the smallest number" << std::endl;
-    std::cout << "L. display the largest number" << std::endl;
-    std::cout << "C. clear the list" << std::endl;
-    std::cout << "Q. quit" << std::endl << std::endl;
+  ./a.out                     the menu, one option at a time
+  ./a.out --batch [commands]  the options of a file, or of stdin, as one batch, the same
+                              switch without the menu and the prompts, see Batch_io.h
 
-    std::cout << "Enter the option: ";
-    std::cin >> option;
-
-    switch (option) {
-      case 'P':
-      case 'p': {
-        if (!static_cast<bool>(numbers.size()))
-          std::cout << "[] - This list is empty." << std::endl;
-        else {
-          std::cout << "[ ";
-
-          for (auto number : numbers)
-            std::cout << number << " ";
-          
-          std::cout << "]" << std::endl;
-        }
-        break;
-      }
+*/
 
-      case 'A':
-      case 'a': {
-        int num {};
-        bool is_num_exist {false};
+// read_number gives the number of the a option, from std::cin or from the batch
+template <typename Read_number>
+void run_option(char option, Number_list &numbers, std::ostream &os, Read_number read_number)
+{
+  switch (option) {
+    case 'P':
+    case 'p': {
+      if (numbers.empty())
+        os << "[] - This list is empty." << '\n';
+      else {
+        os << "[ ";
+
+        for (auto number : numbers.get_numbers())
+          os << number << " ";
+        
+        os << "]" << '\n';
+      }
+      break;
+    }
 
-        std::cout << "Enter an integer: ";
-        std::cin >> num;
+    case 'A':
+    case 'a': {
+      const int num {read_number()};
 
-        for (auto number : numbers)
-          is_num_exist = number == num;
+      if (!numbers.add(num))
+        os << "The numebr exist before." << '\n';
+      else
+        os << num << " is added." << '\n';
+      break;
+    }
 
-        if (is_num_exist)
-          std::cout << "The numebr exist before." << std::endl;
-        else {
-          numbers.push_back(num);
-          std::cout << num << " is added." << std::endl;
-        }
-        break;
+    case 'M':
+    case 'm': {
+      if (numbers.empty())
+        os << "[] - This list is empty and could not find the mean." << '\n';
+      else {
+        os << std::fixed << std::setprecision(1);
+        os << "The mean is " << numbers.get_mean() << '\n';
       }
+      break;
+    }
 
-      case 'M':
-      case 'm': {
-        if (!static_cast<bool>(numbers.size()))
-          std::cout << "[] - This list is empty and could not find the mean." << std::endl;
-        else {
-          int mean {};
+    case 'S':
+    case 's': {
+      if (numbers.empty())
+        os << "[] - This list is empty and could not find the smallest." << '\n';
+      else
+        os << "The smallest is " << numbers.get_smallest() << '\n';
+      break;
+    }
 
-          for (auto number : numbers)
-            mean += number;
+    case 'L':
+    case 'l': {
+      if (numbers.empty())
+        os << "[] - This list is empty and could not find the largest." << '\n';
+      else
+        os << "The largest is " << numbers.get_largest() << '\n';
+      break;
+    }
 
-          std::cout << std::fixed << std::setprecision(1);
-          std::cout << "The mean is " << static_cast<double>(mean) / numbers.size() << std::endl;
-        }
-        break;
-      }
+    case 'C':
+    case 'c': {
+      numbers.clear();
+      os << "He list was cleared." << '\n';
+      break;
+    }
 
-      case 'S':
-      case 's': {
-        if (!static_cast<bool>(numbers.size()))
-          std::cout << "[] - This list is empty and could not find the smallest." << std::endl;
-        else {
-          int smallest {INT_MAX};
+    case 'Q':
+    case 'q': {
+      os << "Goodbye..." << '\n';
+      break;
+    }
 
-          for (auto number : numbers)
-            if (number < smallest)
-              smallest = number;
+    default: {
+      os << option << " is unknown, please try again." << '\n';
+      break;
+    }
+  }
+}
 
-          std::cout << "The smallest is " << smallest << std::endl;
-        }
-        break;
-      }
+// until Q or the end of the commands, a number that is not one ends it
+int run_batch(const char *file)
+{
+  const std::string commands {batch_io::read_all(file)};
+  batch_io::Scanner scanner {commands};
+  batch_io::Output_buffer buffer;
+  std::ostream os {&buffer};
+  Number_list numbers;
+  char option {};
 
-      case 'L':
-      case 'l': {
-        if (!static_cast<bool>(numbers.size()))
-          std::cout << "[] - This list is empty and could not find the largest." << std::endl;
-        else {
-          int largest {INT_MIN};
+  while (scanner.next_char(option)) {
+    run_option(option, numbers, os, [&scanner]() {
+      int num {};
+      if (!scanner.next_int(num))
+        throw std::runtime_error("line " + std::to_string(scanner.get_line()) + ": an integer is expected after A");
+      return num;
+    });
 
-          for (auto number : numbers)
-            if (number > largest)
-              largest = number;
+    if (option == 'Q' || option == 'q')
+      break;
+  }
 
-          std::cout << "The largest is " << largest << std::endl;
-        }
-        break;
-      }
+  return 0;
+}
 
-      case 'C':
-      case 'c': {
-        numbers.clear();
-        std::cout << "He list was cleared." << std::endl;
-        break;
-      }
+int main(int argc, char *argv[])
+{
+  const char *file {nullptr};
+  if (batch_io::is_batch(argc, argv, file)) {
+    try {
+      return run_batch(file);
+    }
+    catch (const std::runtime_error &ex) {
+      std::cerr << ex.what() << std::endl;
+      return 1;
+    }
+  }
 
-      case 'Q':
-      case 'q': {
-        std::cout << "Goodbye..." << std::endl;
-        break;
-      }
+  fast_console::Guard console;
+  Number_list numbers;
+  char option {};
 
-      default: {
-        std::cout << option << " is unknown, please try again." << std::endl;
-        break;
-      }
-    }
+  do {
+    std::cout << "P. print numbers" << '\n';
+    std::cout << "A. add a number" << '\n';
+    std::cout << "M. display mean of the numbers" << '\n';
+    std::cout << "S. display the smallest number" << '\n';
+    std::cout << "L. display the largest number" << '\n';
+    std::cout << "C. clear the list" << '\n';
+    std::cout << "Q. quit" << "\n\n";
+
+    // q at the end of the input, and 0 for a word that is not a number, its line goes
+    std::cout << "Enter the option: ";
+    if (!console.input().next_char(option))
+      option = 'q';
+
+    run_option(option, numbers, std::cout, [&console]() {
+      int num {};
+
+      std::cout << "Enter an integer: ";
+      if (!console.input().next_int(num))
+        console.input().ignore_line();
+      return num;
+    });
 
-    std::cout << std::endl << std::endl;
+    std::cout << "\n\n";
   } while (option != 'Q' && option != 'q');
 
   return 0;
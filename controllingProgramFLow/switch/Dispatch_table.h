@@ -0,0 +1,73 @@
+#ifndef _DISPATCH_TABLE_H_
+#define _DISPATCH_TABLE_H_
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/*
+
+  - a Dispatch_table<R(Args...)> is a switch over the 256 values of a byte as data: one
+    function pointer per byte, the byte indexes it, no compare and no branch but the call.
+    the table is a literal type, made with on and on_either_case when the program is
+    compiled, and every byte without a handler calls the fallback:
+
+      constexpr auto menu = Dispatch_table<void(Number_list &)> {unknown}
+        .on_either_case('p', print_numbers)
+        .on_either_case('a', add_number);
+
+      menu('a', numbers);   // add_number('a', numbers)
+
+  - a handler takes the byte it was called for first, the fallback can say which byte it
+    did not know, then the arguments of the table.
+
+  - a switch the compiler turns into a jump table is one indirect jump too, and can inline
+    the handlers, the table can not, switchBenchmark measures which one is faster for the
+    inputs of a parser.
+
+*/
+template <typename Signature>
+class Dispatch_table;
+
+template <typename R, typename... Args>
+class Dispatch_table<R(Args...)>
+{
+public:
+  using Handler = R (*)(char, Args...);
+
+private:
+  std::array<Handler, 256> handlers {};
+
+  static constexpr std::size_t index(char c) { return static_cast<unsigned char>(c); }
+
+public:
+  constexpr explicit Dispatch_table(Handler fallback)
+  {
+    for (Handler &handler : this->handlers)
+      handler = fallback;
+  }
+
+  constexpr Dispatch_table on(char c, Handler handler) const
+  {
+    Dispatch_table table {*this};
+    table.handlers[index(c)] = handler;
+    return table;
+  }
+
+  // the ASCII letter c in upper and lower case
+  constexpr Dispatch_table on_either_case(char c, Handler handler) const
+  {
+    const char lower = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    const char upper = c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    return this->on(lower, handler).on(upper, handler);
+  }
+
+  constexpr Handler operator[](char c) const { return this->handlers[index(c)]; }
+
+  R operator()(char c, Args... args) const
+  {
+    return this->handlers[index(c)](c, std::forward<Args>(args)...);
+  }
+};
+
+#endif
@@ -1,4 +1,29 @@
 #include <iostream>
+#include "Dispatch_table.h"
+
+void turn(char key, int &dx, int &dy)
+{
+  switch (key) {
+    case 'l': case 'L': dx = -1; dy = 0; break;
+    case 'r': case 'R': dx = 1; dy = 0; break;
+    case 'u': case 'U': dx = 0; dy = 1; break;
+    default: dx = 0; dy = -1; break;
+  }
+}
+
+void stay(char key, int &dx, int &dy)
+{
+  std::cout << key << " is not a direction." << std::endl;
+  dx = 0;
+  dy = 0;
+}
+
+// the keys of the directions in a table of a handler per byte, see Dispatch_table.h
+constexpr auto keys = Dispatch_table<void(int &, int &)> {stay}
+  .on_either_case('l', turn)
+  .on_either_case('r', turn)
+  .on_either_case('u', turn)
+  .on_either_case('d', turn);
 
 int main()
 {
@@ -22,5 +47,11 @@ int main()
     }
   }
 
+  int dx {0}, dy {0};
+  for (char key : {'L', 'u', 'x'}) {
+    keys(key, dx, dy);
+    std::cout << key << " moves by " << dx << ", " << dy << std::endl;
+  }
+
   return 0;
 }
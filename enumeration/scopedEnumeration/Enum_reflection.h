@@ -0,0 +1,332 @@
+#ifndef _ENUM_REFLECTION_H_
+#define _ENUM_REFLECTION_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+/*
+
+    - an enum is declared once, with a list of its names and values, and the enum, its names,
+      its validity and its parsing are all made from that list, so they can not drift apart:
+
+        #define GROCERY_ITEMS(X) X(Milk, 350) X(Bread, 250) X(Apple, 132) X(Orange, 100)
+        REFLECTED_ENUM(Grocery_item, int, GROCERY_ITEMS)
+
+      REFLECTED_MEMBER_ENUM is the same one for an enum declared in a class.
+
+    - Enum_info<E> is computed at compile time from the list: the entries in their order,
+      and, when the values are at most dense_limit apart, a table from value - min to entry,
+      and a bitset of the valid values, enum_name and enum_is_valid are one load then, else a
+      binary search of the sorted values. enum_from_string is a perfect hash, no two names of
+      the enum are in the same slot, with seeds found at compile time, two hashes, one slot
+      and one compare of the name.
+
+    - enum_name of a value that is not in the enum is an empty std::string_view,
+      enum_from_string of a name that is not in it is std::nullopt.
+
+*/
+template <typename E>
+struct Enum_entry
+{
+    E value;
+    std::string_view name;
+};
+
+namespace detail_enum
+{
+    template <typename E, std::size_t N>
+    constexpr std::array<Enum_entry<E>, N> make_entries(const Enum_entry<E> (&entries)[N])
+    {
+        std::array<Enum_entry<E>, N> result {};
+        for (std::size_t i = 0; i < N; ++i)
+            result[i] = entries[i];
+        return result;
+    }
+
+    // FNV-1a, with the seed in the offset basis, then the finalizer of murmur3, the low bits
+    // of FNV-1a only depend on the low bits of the characters and of the seed
+    constexpr std::uint32_t hash(std::string_view name, std::uint32_t seed)
+    {
+        std::uint32_t h = 2166136261u ^ seed;
+        for (char c : name)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    constexpr std::size_t slots_for(std::size_t n)
+    {
+        std::size_t slots = 1;
+        while (slots < 2 * n)
+            slots *= 2;
+        return slots;
+    }
+}
+
+#define DETAIL_ENUM_VALUE(name, value) name = value,
+#define DETAIL_ENUM_ENTRY(name, value) Enum_entry<Enum_type> {Enum_type::name, #name},
+
+// found by argument dependent lookup, a friend of the class for an enum declared in one
+#define DETAIL_ENUM_ENTRIES(prefix, Name, list)                                  \
+    prefix constexpr auto reflect_enum(Name)                                     \
+    {                                                                            \
+        using Enum_type = Name;                                                  \
+        return detail_enum::make_entries<Name>({list(DETAIL_ENUM_ENTRY)});       \
+    }
+
+#define REFLECTED_ENUM(Name, Underlying, list)                                   \
+    enum class Name : Underlying {list(DETAIL_ENUM_VALUE)};                      \
+    DETAIL_ENUM_ENTRIES(, Name, list)
+
+#define REFLECTED_MEMBER_ENUM(Name, Underlying, list)                            \
+    enum class Name : Underlying {list(DETAIL_ENUM_VALUE)};                      \
+    DETAIL_ENUM_ENTRIES(friend, Name, list)
+
+template <typename E>
+class Enum_info
+{
+    static_assert(std::is_enum_v<E>, "Enum_info is for an enum declared with REFLECTED_ENUM");
+
+public:
+    using underlying_type = std::underlying_type_t<E>;
+
+    static constexpr auto entries = reflect_enum(E {});
+    static constexpr std::size_t count = entries.size();
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    static constexpr std::uint64_t dense_limit = 4096;
+
+private:
+    static constexpr underlying_type bound(bool lowest)
+    {
+        underlying_type result = static_cast<underlying_type>(entries[0].value);
+        for (const Enum_entry<E>& entry : entries)
+        {
+            const underlying_type value = static_cast<underlying_type>(entry.value);
+            if (lowest ? value < result : value > result)
+                result = value;
+        }
+        return result;
+    }
+
+public:
+    static constexpr underlying_type min = bound(true);
+    static constexpr underlying_type max = bound(false);
+
+private:
+    // max - min, in 64 bits, an enum of int64 from the lowest to the highest is more than dense_limit
+    static constexpr std::uint64_t span = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min);
+
+public:
+    static constexpr bool dense = span < dense_limit;
+
+private:
+    static constexpr std::size_t range = dense ? static_cast<std::size_t>(span) + 1 : 1;
+
+    // the entry of every value from min, the first one of a value that is twice, uint16 max for a hole
+    static constexpr std::array<std::uint16_t, range> make_places()
+    {
+        std::array<std::uint16_t, range> places {};
+        for (std::uint16_t& place : places)
+            place = std::numeric_limits<std::uint16_t>::max();
+        if (dense)
+            for (std::size_t i = count; i-- > 0;)
+                places[static_cast<std::uint64_t>(entries[i].value) - static_cast<std::uint64_t>(min)] = static_cast<std::uint16_t>(i);
+        return places;
+    }
+
+    static constexpr std::array<std::uint64_t, (range + 63) / 64> make_valid()
+    {
+        std::array<std::uint64_t, (range + 63) / 64> valid {};
+        if (dense)
+            for (const Enum_entry<E>& entry : entries)
+            {
+                const std::size_t bit = static_cast<std::size_t>(static_cast<std::uint64_t>(entry.value) - static_cast<std::uint64_t>(min));
+                valid[bit / 64] |= std::uint64_t {1} << (bit % 64);
+            }
+        return valid;
+    }
+
+    // the entries by value, for the enums that are not dense
+    static constexpr std::array<std::uint16_t, count> make_sorted()
+    {
+        std::array<std::uint16_t, count> sorted {};
+        for (std::size_t i = 0; i < count; ++i)
+            sorted[i] = static_cast<std::uint16_t>(i);
+        for (std::size_t i = 1; i < count; ++i)
+            for (std::size_t j = i; j > 0 && entries[sorted[j]].value < entries[sorted[j - 1]].value; --j)
+            {
+                const std::uint16_t t = sorted[j];
+                sorted[j] = sorted[j - 1];
+                sorted[j - 1] = t;
+            }
+        return sorted;
+    }
+
+    static constexpr std::size_t num_slots = detail_enum::slots_for(count);
+    static constexpr std::size_t num_buckets = detail_enum::slots_for((count + 1) / 2) / 2;
+    static constexpr std::uint32_t max_seed = 100000;
+
+    static_assert(count > 0 && count < std::numeric_limits<std::uint16_t>::max(), "an enum of 1 to 65534 names");
+
+    /*
+
+        - hash and displace: a name hashed with seed 0 picks a bucket, about 2 names per
+          bucket, and the names of a bucket are hashed again with the seed of the bucket, to
+          a slot of their own. the buckets with the most names are placed first, while most
+          slots are free, a seed is tried until all the names of its bucket land in free ones.
+
+    */
+    struct Perfect_hash
+    {
+        std::array<std::uint32_t, num_buckets> seeds {};
+        std::array<std::uint16_t, num_slots> slots {};
+        bool found {true};
+    };
+
+    static constexpr Perfect_hash make_hash()
+    {
+        Perfect_hash result {};
+        for (std::uint16_t& slot : result.slots)
+            slot = std::numeric_limits<std::uint16_t>::max();
+
+        std::array<std::size_t, count> bucket_of {};
+        std::array<std::size_t, num_buckets> bucket_size {};
+        std::size_t largest {0};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bucket_of[i] = detail_enum::hash(entries[i].name, 0) & (num_buckets - 1);
+            const std::size_t size = ++bucket_size[bucket_of[i]];
+            largest = size > largest ? size : largest;
+        }
+
+        for (std::size_t size = largest; size > 0; --size)
+            for (std::size_t bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                if (bucket_size[bucket] != size)
+                    continue;
+                std::uint32_t seed = 1;
+                for (; seed < max_seed; ++seed)
+                {
+                    std::array<std::size_t, num_slots> taken {};
+                    std::size_t num_taken {0};
+                    bool fits {true};
+                    for (std::size_t i = 0; i < count && fits; ++i)
+                    {
+                        if (bucket_of[i] != bucket)
+                            continue;
+                        const std::size_t slot = detail_enum::hash(entries[i].name, seed) & (num_slots - 1);
+                        fits = result.slots[slot] == std::numeric_limits<std::uint16_t>::max();
+                        for (std::size_t t = 0; t < num_taken && fits; ++t)
+                            fits = taken[t] != slot;
+                        taken[num_taken++] = slot;
+                    }
+                    if (fits)
+                        break;
+                }
+                if (seed == max_seed)
+                {
+                    result.found = false;
+                    return result;
+                }
+                result.seeds[bucket] = seed;
+                for (std::size_t i = 0; i < count; ++i)
+                    if (bucket_of[i] == bucket)
+                        result.slots[detail_enum::hash(entries[i].name, seed) & (num_slots - 1)] = static_cast<std::uint16_t>(i);
+            }
+        return result;
+    }
+
+    static constexpr std::array<std::uint16_t, range> places = make_places();
+    static constexpr std::array<std::uint64_t, (range + 63) / 64> valid = make_valid();
+    static constexpr std::array<std::uint16_t, count> sorted = make_sorted();
+    static constexpr Perfect_hash perfect_hash = make_hash();
+    static_assert(perfect_hash.found, "no seed puts the names of a bucket in slots of their own, two names are the same");
+
+public:
+    // the index of the entry of value, npos when it is not in the enum
+    static constexpr std::size_t index_of(E value)
+    {
+        const underlying_type v = static_cast<underlying_type>(value);
+        if (v < min || v > max)
+            return npos;
+        if constexpr (dense)
+        {
+            const std::uint16_t place = places[static_cast<std::uint64_t>(v) - static_cast<std::uint64_t>(min)];
+            return place == std::numeric_limits<std::uint16_t>::max() ? npos : place;
+        }
+        else
+        {
+            std::size_t low = 0, high = count;
+            while (low < high)
+            {
+                const std::size_t middle = low + (high - low) / 2;
+                if (static_cast<underlying_type>(entries[sorted[middle]].value) < v)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return low < count && entries[sorted[low]].value == value ? sorted[low] : npos;
+        }
+    }
+
+    static constexpr bool is_valid(E value)
+    {
+        if constexpr (dense)
+        {
+            const underlying_type v = static_cast<underlying_type>(value);
+            if (v < min || v > max)
+                return false;
+            const std::size_t bit = static_cast<std::size_t>(static_cast<std::uint64_t>(v) - static_cast<std::uint64_t>(min));
+            return (valid[bit / 64] >> (bit % 64)) & 1;
+        }
+        else
+            return index_of(value) != npos;
+    }
+
+    static constexpr std::string_view name(E value)
+    {
+        const std::size_t i = index_of(value);
+        return i == npos ? std::string_view {} : entries[i].name;
+    }
+
+    static constexpr std::optional<E> from_string(std::string_view name)
+    {
+        const std::uint32_t seed = perfect_hash.seeds[detail_enum::hash(name, 0) & (num_buckets - 1)];
+        const std::uint16_t slot = perfect_hash.slots[detail_enum::hash(name, seed) & (num_slots - 1)];
+        if (slot == std::numeric_limits<std::uint16_t>::max() || entries[slot].name != name)
+            return std::nullopt;
+        return entries[slot].value;
+    }
+};
+
+template <typename E>
+constexpr std::string_view enum_name(E value)
+{
+    return Enum_info<E>::name(value);
+}
+
+template <typename E>
+constexpr bool enum_is_valid(E value)
+{
+    return Enum_info<E>::is_valid(value);
+}
+
+template <typename E>
+constexpr std::optional<E> enum_from_string(std::string_view name)
+{
+    return Enum_info<E>::from_string(name);
+}
+
+#endif
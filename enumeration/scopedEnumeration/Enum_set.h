@@ -0,0 +1,254 @@
+#ifndef _ENUM_SET_H_
+#define _ENUM_SET_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include "Enum_reflection.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+    - Enum_set<E> is a set of the values of an enum of Enum_reflection.h, one bit per name, the
+      bit of the index of its entry, a set of the 4 grocery items is 8 bytes, not a vector of 4
+      bytes per item, and the values of the enum do not have to be small or dense.
+
+    - contains, insert and erase are a shift and a mask, size() is a popcount per 64 names,
+      |, &, ^ and - are one operation per 64, 256 names at a time with AVX2, the loops of
+      the other sizes are vectorized by the compiler anyway. ~ is the names that are not in
+      the set, only the bits of names.
+
+    - insert of a value that is not a name of the enum does nothing and returns false.
+
+    - the iterator gives the values in the order of the names, with a count trailing zeros
+      per value.
+
+*/
+namespace detail_enum_set
+{
+    inline int popcount(std::uint64_t word)
+    {
+        return __builtin_popcountll(word);
+    }
+
+    template <std::size_t Words>
+    inline void combine_or(std::array<std::uint64_t, Words>& lhs, const std::array<std::uint64_t, Words>& rhs)
+    {
+        std::size_t i {0};
+#if defined(__AVX2__)
+        for (; i + 4 <= Words; i += 4)
+        {
+            __m256i* const at = reinterpret_cast<__m256i*>(lhs.data() + i);
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs.data() + i));
+            _mm256_storeu_si256(at, _mm256_or_si256(_mm256_loadu_si256(at), b));
+        }
+#endif
+        for (; i < Words; ++i)
+            lhs[i] |= rhs[i];
+    }
+
+    template <std::size_t Words>
+    inline void combine_and(std::array<std::uint64_t, Words>& lhs, const std::array<std::uint64_t, Words>& rhs)
+    {
+        std::size_t i {0};
+#if defined(__AVX2__)
+        for (; i + 4 <= Words; i += 4)
+        {
+            __m256i* const at = reinterpret_cast<__m256i*>(lhs.data() + i);
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs.data() + i));
+            _mm256_storeu_si256(at, _mm256_and_si256(_mm256_loadu_si256(at), b));
+        }
+#endif
+        for (; i < Words; ++i)
+            lhs[i] &= rhs[i];
+    }
+}
+
+template <typename E>
+class Enum_set
+{
+public:
+    static constexpr std::size_t capacity = Enum_info<E>::count;
+
+private:
+    static constexpr std::size_t num_words = (capacity + 63) / 64;
+    using Words = std::array<std::uint64_t, num_words>;
+
+    Words words {};
+
+    // the bits of the names in the last word
+    static constexpr std::uint64_t last_mask = capacity % 64 == 0 ? ~std::uint64_t {0} : (std::uint64_t {1} << (capacity % 64)) - 1;
+
+public:
+    class iterator
+    {
+    private:
+        const Words* words;
+        std::size_t bit;
+
+        void skip()
+        {
+            while (this->bit < capacity)
+            {
+                const std::uint64_t rest = (*this->words)[this->bit / 64] >> (this->bit % 64);
+                if (rest != 0)
+                {
+                    this->bit += static_cast<std::size_t>(__builtin_ctzll(rest));
+                    return;
+                }
+                this->bit = (this->bit / 64 + 1) * 64;
+            }
+            this->bit = capacity;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const E*;
+        using reference = E;
+
+        iterator(const Words* words, std::size_t bit) : words(words), bit(bit) { this->skip(); }
+
+        E operator*() const { return Enum_info<E>::entries[this->bit].value; }
+        iterator& operator++()
+        {
+            ++this->bit;
+            this->skip();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old {*this};
+            ++*this;
+            return old;
+        }
+        bool operator==(const iterator& rhs) const { return this->bit == rhs.bit; }
+        bool operator!=(const iterator& rhs) const { return this->bit != rhs.bit; }
+    };
+
+    constexpr Enum_set() = default;
+
+    Enum_set(std::initializer_list<E> values)
+    {
+        for (E value : values)
+            this->insert(value);
+    }
+
+    static Enum_set all()
+    {
+        Enum_set set;
+        for (std::uint64_t& word : set.words)
+            word = ~std::uint64_t {0};
+        set.words[num_words - 1] = last_mask;
+        return set;
+    }
+
+    bool insert(E value)
+    {
+        const std::size_t i = Enum_info<E>::index_of(value);
+        if (i == Enum_info<E>::npos)
+            return false;
+        this->words[i / 64] |= std::uint64_t {1} << (i % 64);
+        return true;
+    }
+
+    void erase(E value)
+    {
+        const std::size_t i = Enum_info<E>::index_of(value);
+        if (i != Enum_info<E>::npos)
+            this->words[i / 64] &= ~(std::uint64_t {1} << (i % 64));
+    }
+
+    bool contains(E value) const
+    {
+        const std::size_t i = Enum_info<E>::index_of(value);
+        return i != Enum_info<E>::npos && (this->words[i / 64] >> (i % 64)) & 1;
+    }
+
+    // every name of other is in this one
+    bool includes(const Enum_set& other) const
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+            if ((other.words[i] & ~this->words[i]) != 0)
+                return false;
+        return true;
+    }
+
+    bool intersects(const Enum_set& other) const
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+            if ((other.words[i] & this->words[i]) != 0)
+                return true;
+        return false;
+    }
+
+    std::size_t size() const
+    {
+        std::size_t count {0};
+        for (std::uint64_t word : this->words)
+            count += static_cast<std::size_t>(detail_enum_set::popcount(word));
+        return count;
+    }
+
+    bool empty() const
+    {
+        for (std::uint64_t word : this->words)
+            if (word != 0)
+                return false;
+        return true;
+    }
+
+    void clear() { this->words = Words {}; }
+
+    Enum_set& operator|=(const Enum_set& rhs)
+    {
+        detail_enum_set::combine_or(this->words, rhs.words);
+        return *this;
+    }
+
+    Enum_set& operator&=(const Enum_set& rhs)
+    {
+        detail_enum_set::combine_and(this->words, rhs.words);
+        return *this;
+    }
+
+    Enum_set& operator^=(const Enum_set& rhs)
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+            this->words[i] ^= rhs.words[i];
+        return *this;
+    }
+
+    Enum_set& operator-=(const Enum_set& rhs)
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+            this->words[i] &= ~rhs.words[i];
+        return *this;
+    }
+
+    Enum_set operator~() const
+    {
+        Enum_set result {all()};
+        result -= *this;
+        return result;
+    }
+
+    friend Enum_set operator|(Enum_set lhs, const Enum_set& rhs) { return lhs |= rhs; }
+    friend Enum_set operator&(Enum_set lhs, const Enum_set& rhs) { return lhs &= rhs; }
+    friend Enum_set operator^(Enum_set lhs, const Enum_set& rhs) { return lhs ^= rhs; }
+    friend Enum_set operator-(Enum_set lhs, const Enum_set& rhs) { return lhs -= rhs; }
+
+    bool operator==(const Enum_set& rhs) const { return this->words == rhs.words; }
+    bool operator!=(const Enum_set& rhs) const { return this->words != rhs.words; }
+
+    iterator begin() const { return iterator {&this->words, 0}; }
+    iterator end() const { return iterator {&this->words, capacity}; }
+};
+
+#endif
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <optional>
+#include "Enum_reflection.h"
+#include "Enum_set.h"
 
 /*
 
@@ -8,23 +11,26 @@
 
 */
 
-enum class Grocery_item : int {Milk = 350, 
-    Bread = 250, 
-    Apple = 132, 
-    Orange = 100};
+/*
+
+    the names, the values, the validity and the parsing of the items all come
+    from this one list, a new item is one more X(...) here, no switch to update.
+    it declares:
+
+        enum class Grocery_item : int {Milk = 350, Bread = 250, Apple = 132, Orange = 100};
+
+*/
+#define GROCERY_ITEMS(X) X(Milk, 350) X(Bread, 250) X(Apple, 132) X(Orange, 100)
+REFLECTED_ENUM(Grocery_item, int, GROCERY_ITEMS)
 
 std::ostream& operator<<(std::ostream& os, const Grocery_item g)
 {
     std::underlying_type_t<Grocery_item> value = std::underlying_type_t<Grocery_item>(g);
 
-    switch(g)
-    {
-        case Grocery_item::Milk: os << "Milk"; break;
-        case Grocery_item::Bread: os << "Bread"; break;
-        case Grocery_item::Apple: os << "Apple"; break;
-        case Grocery_item::Orange: os << "Orange"; break;
-        default: os << "Invalid item"; break;
-    }
+    if (enum_is_valid(g))
+        os << enum_name(g);
+    else
+        os << "Invalid item";
 
     os << " : " << value;
     
@@ -33,14 +39,7 @@ std::ostream& operator<<(std::ostream& os, const Grocery_item g)
 
 bool is_valid_grocery_item(const Grocery_item& g)
 {
-    switch(g)
-    {
-        case Grocery_item::Milk:
-        case Grocery_item::Bread:
-        case Grocery_item::Apple:
-        case Grocery_item::Orange: return true;
-        default: return false;
-    }
+    return enum_is_valid(g);
 }
 
 void display_grocery_list(const std::vector<Grocery_item>& groceries)
@@ -95,15 +94,17 @@ class Player
     friend std::ostream& operator<<(std::ostream &os, const Player& p);
 
 public:
-    enum class Mode {Attack, Defense, Idle};
-    enum class Direction {North, South, East, West};
+    #define PLAYER_MODES(X) X(Attack, 0) X(Defense, 1) X(Idle, 2)
+    #define PLAYER_DIRECTIONS(X) X(North, 0) X(South, 1) X(East, 2) X(West, 3)
+    REFLECTED_MEMBER_ENUM(Mode, int, PLAYER_MODES)
+    REFLECTED_MEMBER_ENUM(Direction, int, PLAYER_DIRECTIONS)
 
     Player(std::string name,
         Mode mode = Mode::Idle,
         Direction direction = Direction::North)
         : name(name), mode(mode), direction(direction) {}
 
-    std::string get_name() const { return this->name; }
+    const std::string& get_name() const { return this->name; }
     void set_name(std::string name) { this->name = name; }
 
     Mode get_mode() const { return this->mode; }
@@ -120,31 +121,12 @@ private:
 
 std::string get_player_mode(Player::Mode mode)
 {
-    std::string result;
-
-    switch(mode)
-    {
-        case Player::Mode::Attack: result = "Attack"; break;
-        case Player::Mode::Defense: result = "Defense"; break;
-        case Player::Mode::Idle: result = "Idle"; break;
-    }
-    
-    return result;
+    return std::string {enum_name(mode)};
 }
 
 std::string get_player_direction(Player::Direction direction)
 {
-    std::string result;
-
-    switch(direction)
-    {
-        case Player::Direction::North: result = "North"; break;
-        case Player::Direction::South: result = "South"; break;
-        case Player::Direction::East: result = "East"; break;
-        case Player::Direction::West: result = "West"; break;
-    }
-    
-    return result;
+    return std::string {enum_name(direction)};
 }
 
 std::ostream& operator<<(std::ostream& os, const Player &p)
@@ -169,10 +151,78 @@ void test2()
     std::cout << p3 << std::endl;
 }
 
+/*
+
+    test three
+
+*/
+
+void test3()
+{
+    std::cout << std::endl << "test3============" << std::endl;
+
+    // the names of a log line back to items, two hashes and one compare each
+    for (std::string name : {"Apple", "Milk", "Pear", "Orange"})
+    {
+        std::optional<Grocery_item> item = enum_from_string<Grocery_item>(name);
+        if (item)
+            std::cout << name << " -> " << *item << std::endl;
+        else
+            std::cout << name << " is not an item" << std::endl;
+    }
+
+    // computed by the compiler, nothing runs for them
+    static_assert(enum_name(Grocery_item::Bread) == "Bread");
+    static_assert(Enum_info<Grocery_item>::count == 4);
+    static_assert(enum_from_string<Player::Mode>("Defense") == Player::Mode::Defense);
+
+    for (const auto& entry : Enum_info<Player::Direction>::entries)
+        std::cout << entry.name << " ";
+    std::cout << std::endl;
+}
+
+/*
+
+    test four
+
+*/
+
+void display_grocery_set(const Enum_set<Grocery_item>& groceries)
+{
+    for (Grocery_item g : groceries)
+        std::cout << g << std::endl;
+    std::cout << "Total items: " << groceries.size() << std::endl;
+}
+
+void test4()
+{
+    std::cout << std::endl << "test4============" << std::endl;
+
+    // the shopping list of test1 as one bit per item, an invalid item is not added and milk is there once
+    Enum_set<Grocery_item> shopping_list {Grocery_item::Apple, Grocery_item::Milk, Grocery_item::Orange};
+    if (!shopping_list.insert(Grocery_item(1000)))
+        std::cout << "Invalid item is not added" << std::endl;
+    shopping_list.insert(Grocery_item(350));
+    display_grocery_set(shopping_list);
+
+    Enum_set<Grocery_item> in_the_fridge {Grocery_item::Milk, Grocery_item::Bread};
+    std::cout << std::endl << "Still to buy:" << std::endl;
+    display_grocery_set(shopping_list - in_the_fridge);
+    std::cout << std::endl << "Bought and in the fridge:" << std::endl;
+    display_grocery_set(shopping_list & in_the_fridge);
+    std::cout << std::endl << "Never on the list:" << std::endl;
+    display_grocery_set(~shopping_list);
+
+    std::cout << std::endl << "sizeof the set: " << sizeof(shopping_list)
+        << " bytes, of a vector of the items: " << sizeof(Grocery_item) << " bytes per item" << std::endl;
+}
+
 int main()
 {
     test1();
     test2();
+    test3();
+    test4();
     
     return 0;
 }
@@ -0,0 +1,110 @@
+/*
+
+    - compares the filtering of records tagged with grocery items, the tags as a
+      std::vector<Grocery_item> per record against an Enum_set<Grocery_item>: the records
+      with both milk and apple, and the count of every tag of all the records.
+
+    - build it with:
+        g++ -std=c++17 -O2 -mavx2 index.cpp
+
+    - the number of records can be lowered on the command line, e.g. ./a.out 100000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../scopedEnumeration/Enum_reflection.h"
+#include "../scopedEnumeration/Enum_set.h"
+
+#define GROCERY_ITEMS(X) X(Milk, 350) X(Bread, 250) X(Apple, 132) X(Orange, 100)
+REFLECTED_ENUM(Grocery_item, int, GROCERY_ITEMS)
+
+struct Vector_record
+{
+    int id;
+    std::vector<Grocery_item> tags;
+};
+
+struct Set_record
+{
+    int id;
+    Enum_set<Grocery_item> tags;
+};
+
+// the best of 5 runs
+template <typename Fn>
+void run(const std::string& name, std::size_t n, Fn f)
+{
+    double best {1e9};
+    std::size_t checksum {0};
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        checksum = f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::cout << std::setw(32) << std::left << name << std::setw(10) << std::right << std::fixed
+        << std::setprecision(2) << best * 1e9 / static_cast<double>(n) << " ns per record, checksum " << checksum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+
+    std::mt19937 random {7};
+    std::vector<Vector_record> vector_records(n);
+    std::vector<Set_record> set_records(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        vector_records[i].id = set_records[i].id = static_cast<int>(i);
+        for (const auto& entry : Enum_info<Grocery_item>::entries)
+            if (random() % 2)
+            {
+                vector_records[i].tags.push_back(entry.value);
+                set_records[i].tags.insert(entry.value);
+            }
+    }
+
+    std::cout << "records: " << n << ", bytes of tags: vector " << sizeof(std::vector<Grocery_item>)
+        << " + 4 per tag, set " << sizeof(Enum_set<Grocery_item>) << std::endl;
+
+    run("vector, milk and apple", n, [&] {
+        std::size_t found {0};
+        for (const Vector_record& record : vector_records)
+            if (std::find(record.tags.begin(), record.tags.end(), Grocery_item::Milk) != record.tags.end()
+                && std::find(record.tags.begin(), record.tags.end(), Grocery_item::Apple) != record.tags.end())
+                ++found;
+        return found;
+    });
+
+    const Enum_set<Grocery_item> wanted {Grocery_item::Milk, Grocery_item::Apple};
+    run("Enum_set, milk and apple", n, [&] {
+        std::size_t found {0};
+        for (const Set_record& record : set_records)
+            found += record.tags.includes(wanted);
+        return found;
+    });
+
+    run("vector, count of tags", n, [&] {
+        std::size_t count {0};
+        for (const Vector_record& record : vector_records)
+            count += record.tags.size();
+        return count;
+    });
+
+    run("Enum_set, count of tags", n, [&] {
+        std::size_t count {0};
+        for (const Set_record& record : set_records)
+            count += record.tags.size();
+        return count;
+    });
+
+    return 0;
+}
@@ -2,14 +2,14 @@
 #include "Illigal_balance_exception.h"
 #include "Insufficent_funds_exception.h"
 
-Account::Account(const std::string name, const double balance)
+Account::Account(const std::string name, const Money balance)
     :   name(name), balance(balance)
 {
-    if (balance < 0.0)
-        throw Illigal_balance_exception();
+    if (balance < Money {})
+        throw Illigal_balance_exception(name, balance);
 }
 
-bool Account::deposit(double amount)
+bool Account::deposit(Money amount)
 {
     if (amount >= 0) {
         this->balance += amount;
@@ -19,15 +19,22 @@ bool Account::deposit(double amount)
         return false;
 }
 
-bool Account::withdraw(double amount)
+bool Account::withdraw(Money amount)
+{
+    if (Account::try_withdraw(amount) == Withdraw_status::Insufficient_funds)
+        throw Insufficent_funds_exception(this->name, amount, this->balance);
+    return true;
+}
+
+Withdraw_status Account::try_withdraw(Money amount)
 {
     if (this->balance - amount < 0)
-        throw Insufficent_funds_exception();
+        return Withdraw_status::Insufficient_funds;
     this->balance -= amount;
-    return true;
+    return Withdraw_status::Ok;
 }
 
-double Account::get_balance() const
+Money Account::get_balance() const
 {
     return this->balance;
 }
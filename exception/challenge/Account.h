@@ -3,26 +3,31 @@
 
 #include <iostream>
 #include "I_Printable.h"
+#include "Money.h"
+#include "Withdraw_status.h"
 
 class Account : public I_Printable
 {
 private:
   static constexpr const char *def_name = "Unnamed Account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
 
 protected:
   std::string name;
-  double balance;
+  Money balance;
 
 public:
-  Account(const std::string name = def_name, const double balance = def_balance);
+  Account(const std::string name = def_name, const Money balance = def_balance);
 
   virtual ~Account() = default;
 
-  virtual bool deposit(double amount) = 0;
-  virtual bool withdraw(double amount) = 0;
+  virtual bool deposit(Money amount) = 0;
+  virtual bool withdraw(Money amount) = 0;
 
-  double get_balance() const;
+  // same rules as withdraw, but a refused withdraw is reported instead of thrown
+  virtual Withdraw_status try_withdraw(Money amount) = 0;
+
+  Money get_balance() const;
 };
 
 #endif
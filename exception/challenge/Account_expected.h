@@ -0,0 +1,64 @@
+#ifndef _ACCOUNT_EXPECTED_H_
+#define _ACCOUNT_EXPECTED_H_
+
+#include <string>
+#include <utility>
+#include "Account.h"
+#include "Expected.h"
+#include "Illigal_balance_exception.h"
+#include "Insufficent_funds_exception.h"
+
+/*
+
+  - the accounts of the challenge with the errors returned in an Expected, not thrown, for
+    the hot paths: open_account is the constructor that throws Illigal_balance_exception,
+    expected_withdraw is withdraw that throws Insufficent_funds_exception. they fail on the
+    same amounts and change the same balances.
+
+  - Account_error has the what() of the exception it is, and value() of an Expected that
+    holds one throws that exception, a caller that still catches them does not change.
+
+*/
+enum class Account_error {Illigal_balance,
+  Insufficent_funds};
+
+inline const char *what(Account_error error) noexcept
+{
+  switch (error) {
+    case Account_error::Illigal_balance:
+      return Illigal_balance_exception {}.what();
+    default:
+      return Insufficent_funds_exception {}.what();
+  }
+}
+
+[[noreturn]] inline void throw_error(Account_error error)
+{
+  if (error == Account_error::Illigal_balance)
+    throw Illigal_balance_exception();
+  throw Insufficent_funds_exception();
+}
+
+// an account of type A, e.g. open_account<Saving_account>("Larry", 2000, 5.0)
+template <typename A, typename... Args>
+Expected<A, Account_error> open_account(std::string name, Money balance, Args &&...args)
+{
+  if (balance < Money {})
+    return unexpected(Account_error::Illigal_balance);
+  return A {std::move(name), balance, std::forward<Args>(args)...};
+}
+
+// true, or false when the limit of a trust account is reached, as withdraw returns
+inline Expected<bool, Account_error> expected_withdraw(Account &account, Money amount)
+{
+  switch (account.try_withdraw(amount)) {
+    case Withdraw_status::Ok:
+      return true;
+    case Withdraw_status::Insufficient_funds:
+      return unexpected(Account_error::Insufficent_funds);
+    default:
+      return false;
+  }
+}
+
+#endif
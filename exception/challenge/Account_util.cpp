@@ -6,7 +6,7 @@ void display(const std::vector<Account*> &accounts)
     std::cout << *ptr << std::endl;
 }
 
-void deposit(std::vector<Account*> &accounts, double amount)
+void deposit(std::vector<Account*> &accounts, Money amount)
 {
   for (const auto &ptr: accounts)
     if (ptr->deposit(amount))
@@ -15,11 +15,18 @@ void deposit(std::vector<Account*> &accounts, double amount)
       std::cout << "Failed deposit of " << amount << " to " << *ptr << std::endl;
 }
 
-void withdraw(std::vector<Account*> &accounts, double amount)
+void withdraw(std::vector<Account*> &accounts, Money amount)
 {
   for (const auto &ptr: accounts)
-    if (ptr->withdraw(amount))
-      std::cout << "Withdraw " << amount << " from " << *ptr << std::endl;
-    else
-      std::cout << "Failed withdraw of " << amount << " from " << *ptr << std::endl;
+    switch (ptr->try_withdraw(amount)) {
+      case Withdraw_status::Ok:
+        std::cout << "Withdraw " << amount << " from " << *ptr << std::endl;
+        break;
+      case Withdraw_status::Insufficient_funds:
+        std::cout << "Failed withdraw of " << amount << " from " << *ptr << ", insufficient funds" << std::endl;
+        break;
+      default:
+        std::cout << "Failed withdraw of " << amount << " from " << *ptr << std::endl;
+        break;
+    }
 }
@@ -6,7 +6,7 @@
 #include "Account.h"
 
 void display(const std::vector<Account*> &accounts);
-void deposit(std::vector<Account*> &accounts, double amount);
-void withdraw(std::vector<Account*> &accounts, double amount);
+void deposit(std::vector<Account*> &accounts, Money amount);
+void withdraw(std::vector<Account*> &accounts, Money amount);
 
 #endif
@@ -1,24 +1,28 @@
 #include <iostream>
-#include <iomanip>
 #include "Checking_account.h" 
 
-Checking_account::Checking_account(const std::string name, const double balance)
+Checking_account::Checking_account(const std::string name, const Money balance)
   : Account(name, balance)
 {}
 
-bool Checking_account::deposit(double amount)
+bool Checking_account::deposit(Money amount)
 {
   return Account::deposit(amount);
 }
 
-bool Checking_account::withdraw(double amount)
+bool Checking_account::withdraw(Money amount)
 {
   amount += this->fee_withdraw;
   return Account::withdraw(amount);
 }
 
+Withdraw_status Checking_account::try_withdraw(Money amount)
+{
+  amount += this->fee_withdraw;
+  return Account::try_withdraw(amount);
+}
+
 void Checking_account::print(std::ostream &os) const
 {
-  std::cout << std::fixed << std::setprecision(2);
   os << "Checking_account: { name: " << this->name << ", balance: " << this->balance << " }";
 }
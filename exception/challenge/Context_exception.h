@@ -0,0 +1,106 @@
+#ifndef _CONTEXT_EXCEPTION_H_
+#define _CONTEXT_EXCEPTION_H_
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include "Money.h"
+
+/*
+
+    - Context_exception is an exception with the account and the amounts it is about, kept
+      as fields in the object, not a std::string: the name is copied into a buffer of the
+      object, cut at max_name characters, so making and throwing one never allocates, the
+      only allocation is the one of the runtime for the thrown object.
+
+    - the message is only made by what(), the first time it is called, into a buffer of
+      the object, e.g. "Isufficent funds: 5001.50 from Moe, balance 1000.00.", an
+      exception that is caught and counted is never formatted. the summary alone is
+      the message when there are no fields.
+
+    - what() writes the buffer the first time, an exception shared between threads has
+      what() called once before.
+
+*/
+class Context_exception : public std::exception
+{
+public:
+    static constexpr std::size_t max_name = 47;
+    static constexpr std::size_t max_summary = 40;
+    // the summary, the name, two amounts and the ": ", " from ", ", balance ", ".\0"
+    static constexpr std::size_t max_message = max_summary + max_name + 2 * Money::max_chars + 20;
+
+private:
+    const char *summary;
+    char name[max_name + 1];
+    Money amount;
+    Money balance;
+    bool has_amount;
+    bool has_balance;
+    mutable bool formatted;
+    mutable char message[max_message];
+
+    static char *append(char *p, std::string_view text)
+    {
+        std::memcpy(p, text.data(), text.size());
+        return p + text.size();
+    }
+
+    // cut at max_summary characters
+    static std::string_view without_dot(const char *summary)
+    {
+        std::string_view text {summary};
+        if (!text.empty() && text.back() == '.')
+            text.remove_suffix(1);
+        return text.substr(0, max_summary);
+    }
+
+protected:
+    // summary is a string literal, the message when there is no context
+    explicit Context_exception(const char *summary) noexcept
+        : summary(summary), name{}, has_amount(false), has_balance(false), formatted(false)
+    {}
+
+    Context_exception(const char *summary, std::string_view account, Money amount, Money balance, bool has_amount) noexcept
+        : Context_exception(summary)
+    {
+        const std::size_t n = account.size() < max_name ? account.size() : max_name;
+        std::memcpy(this->name, account.data(), n);
+        this->name[n] = '\0';
+        this->amount = amount;
+        this->balance = balance;
+        this->has_amount = has_amount;
+        this->has_balance = true;
+    }
+
+public:
+    std::string_view get_account() const noexcept { return this->name; }
+    Money get_amount() const noexcept { return this->amount; }
+    Money get_balance() const noexcept { return this->balance; }
+
+    virtual const char *what() const noexcept override
+    {
+        if (!this->has_balance)
+            return this->summary;
+        if (!this->formatted)
+        {
+            char *p = append(this->message, without_dot(this->summary));
+            p = append(p, ": ");
+            if (this->has_amount)
+            {
+                p = this->amount.format(p);
+                p = append(p, " from ");
+            }
+            p = append(p, this->name);
+            p = append(p, ", balance ");
+            p = this->balance.format(p);
+            p = append(p, ".");
+            *p = '\0';
+            this->formatted = true;
+        }
+        return this->message;
+    }
+};
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef _EXPECTED_H_
+#define _EXPECTED_H_
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+
+  - Expected<T, E> is either a value T or an error E, returned instead of thrown, the error
+    is one more return value, a branch for the caller, nothing unwinds the stack and no
+    exception object is allocated. it is std::expected of C++23, for C++17.
+
+  - a function returns a value, or unexpected(error) for an error:
+
+      Expected<Money, Account_error> checked(Money balance)
+      {
+        if (balance < Money {})
+          return unexpected(Account_error::Illigal_balance);
+        return balance;
+      }
+
+  - value() of an error throws: it calls throw_error(error), found by argument dependent
+    lookup next to E, so a caller that wants the exception still gets the one it would
+    have caught before. error() of a value, and * and -> of an error, are undefined.
+
+*/
+template <typename E>
+class Unexpected
+{
+private:
+  E err;
+
+public:
+  constexpr explicit Unexpected(E err)
+    : err(std::move(err))
+  {}
+
+  constexpr const E &error() const & { return this->err; }
+  constexpr E &&error() && { return std::move(this->err); }
+};
+
+template <typename E>
+constexpr Unexpected<std::decay_t<E>> unexpected(E &&err)
+{
+  return Unexpected<std::decay_t<E>> {std::forward<E>(err)};
+}
+
+template <typename T, typename E>
+class Expected
+{
+  static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>, "Expected holds values");
+  // an assignment that changes a value to an error or back keeps the old member in one of them
+  static_assert(std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>,
+    "Expected needs T or E nothrow move constructible");
+
+private:
+  union {
+    T val;
+    E err;
+  };
+  bool has_val;
+
+  template <typename Other>
+  void construct_from(Other &&other)
+  {
+    if (other.has_val)
+      ::new (static_cast<void *>(&this->val)) T(std::forward<Other>(other).val);
+    else
+      ::new (static_cast<void *>(&this->err)) E(std::forward<Other>(other).err);
+  }
+
+  // the member New from arg in place of the member Old, a constructor that throws leaves
+  // old as it was, the way std::expected does it
+  template <typename New, typename Old, typename Arg>
+  void reinit(New &member, Old &old, Arg &&arg)
+  {
+    if constexpr (std::is_nothrow_constructible_v<New, Arg &&>) {
+      old.~Old();
+      ::new (static_cast<void *>(&member)) New(std::forward<Arg>(arg));
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<New>) {
+      New made(std::forward<Arg>(arg));
+      old.~Old();
+      ::new (static_cast<void *>(&member)) New(std::move(made));
+    }
+    else {
+      Old kept(std::move(old));
+      old.~Old();
+      try {
+        ::new (static_cast<void *>(&member)) New(std::forward<Arg>(arg));
+      }
+      catch (...) {
+        ::new (static_cast<void *>(&old)) Old(std::move(kept));
+        throw;
+      }
+    }
+  }
+
+  void destroy()
+  {
+    if (this->has_val)
+      this->val.~T();
+    else
+      this->err.~E();
+  }
+
+public:
+  using value_type = T;
+  using error_type = E;
+
+  template <typename U = T, typename = std::enable_if_t<std::is_constructible_v<T, U &&>
+    && !std::is_same_v<std::decay_t<U>, Expected>>>
+  Expected(U &&value)
+    : val(std::forward<U>(value)), has_val(true)
+  {}
+
+  template <typename G>
+  Expected(const Unexpected<G> &error)
+    : err(error.error()), has_val(false)
+  {}
+
+  template <typename G>
+  Expected(Unexpected<G> &&error)
+    : err(std::move(error).error()), has_val(false)
+  {}
+
+  Expected(const Expected &other)
+    : has_val(other.has_val)
+  {
+    this->construct_from(other);
+  }
+
+  Expected(Expected &&other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>)
+    : has_val(other.has_val)
+  {
+    this->construct_from(std::move(other));
+  }
+
+  Expected &operator=(const Expected &rhs)
+  {
+    if (this != &rhs) {
+      Expected copy {rhs};
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  // a value to a value and an error to an error are assigned, a value to an error or back
+  // goes through reinit, a move that throws leaves *this holding what it held, not neither
+  Expected &operator=(Expected &&rhs) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>
+    && std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_assignable_v<E>)
+  {
+    if (this == &rhs)
+      return *this;
+    if (this->has_val && rhs.has_val)
+      this->val = std::move(rhs.val);
+    else if (!this->has_val && !rhs.has_val)
+      this->err = std::move(rhs.err);
+    else if (rhs.has_val) {
+      this->reinit(this->val, this->err, std::move(rhs.val));
+      this->has_val = true;
+    }
+    else {
+      this->reinit(this->err, this->val, std::move(rhs.err));
+      this->has_val = false;
+    }
+    return *this;
+  }
+
+  ~Expected()
+  {
+    this->destroy();
+  }
+
+  constexpr bool has_value() const noexcept { return this->has_val; }
+  constexpr explicit operator bool() const noexcept { return this->has_val; }
+
+  T &value() &
+  {
+    if (!this->has_val)
+      throw_error(this->err);
+    return this->val;
+  }
+
+  const T &value() const &
+  {
+    if (!this->has_val)
+      throw_error(this->err);
+    return this->val;
+  }
+
+  T &&value() &&
+  {
+    if (!this->has_val)
+      throw_error(this->err);
+    return std::move(this->val);
+  }
+
+  template <typename U>
+  T value_or(U &&other) const &
+  {
+    return this->has_val ? this->val : static_cast<T>(std::forward<U>(other));
+  }
+
+  T &operator*() & noexcept { return this->val; }
+  const T &operator*() const & noexcept { return this->val; }
+  T *operator->() noexcept { return &this->val; }
+  const T *operator->() const noexcept { return &this->val; }
+
+  const E &error() const & noexcept { return this->err; }
+};
+
+#endif
@@ -7,20 +7,30 @@
 
     - the class destructor will never throw an exception so by default is noexcept.
 
+    - the account and the amounts are kept by Context_exception and only formatted by
+      what(), throwing it does not allocate.
+
 */
 
-#include <iostream>
+#include <string_view>
+#include "Context_exception.h"
 
-class Illigal_balance_exception: public std::exception
+class Illigal_balance_exception: public Context_exception
 {
+private:
+    static constexpr const char *summary = "Invalid balance.";
+
 public:
-    Illigal_balance_exception() noexcept = default;
-    ~Illigal_balance_exception() = default;
+    Illigal_balance_exception() noexcept
+        : Context_exception(summary)
+    {}
 
-    virtual const char *what() const noexcept override
-    {
-        return "Invalid balance.";
-    }
+    // an account opened with a balance below zero
+    Illigal_balance_exception(std::string_view account, Money balance) noexcept
+        : Context_exception(summary, account, Money {}, balance, false)
+    {}
+
+    ~Illigal_balance_exception() = default;
 };
 
 #endif
@@ -7,20 +7,30 @@
 
     - the class destructor will never throw an exception so by default is noexcept.
 
+    - the account and the amounts are kept by Context_exception and only formatted by
+      what(), throwing it does not allocate.
+
 */
 
-#include <iostream>
+#include <string_view>
+#include "Context_exception.h"
 
-class Insufficent_funds_exception: public std::exception
+class Insufficent_funds_exception: public Context_exception
 {
+private:
+    static constexpr const char *summary = "Isufficent funds.";
+
 public:
-    Insufficent_funds_exception() noexcept = default;
-    ~Insufficent_funds_exception() = default;
+    Insufficent_funds_exception() noexcept
+        : Context_exception(summary)
+    {}
 
-    virtual const char *what() const noexcept override
-    {
-        return "Isufficent funds.";
-    }
+    // a withdraw of amount, fees included, from an account with balance
+    Insufficent_funds_exception(std::string_view account, Money amount, Money balance) noexcept
+        : Context_exception(summary, account, amount, balance, true)
+    {}
+
+    ~Insufficent_funds_exception() = default;
 };
 
 #endif
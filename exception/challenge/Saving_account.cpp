@@ -2,21 +2,26 @@
 #include <iomanip>
 #include "Saving_account.h"
 
-Saving_account::Saving_account(const std::string name, const double balance, const double int_rate)
+Saving_account::Saving_account(const std::string name, const Money balance, const double int_rate)
   : Account(name , balance), int_rate(int_rate)
 {}
 
-bool Saving_account::deposit(double amount) 
+bool Saving_account::deposit(Money amount) 
 {
   amount += amount * (int_rate / 100);
   return Account::deposit(amount);
 }
 
-bool Saving_account::withdraw(double amount) 
+bool Saving_account::withdraw(Money amount) 
 {
   return Account::withdraw(amount);
 }
 
+Withdraw_status Saving_account::try_withdraw(Money amount) 
+{
+  return Account::try_withdraw(amount);
+}
+
 void Saving_account::print(std::ostream &os) const 
 {
   std::cout << std::fixed << std::setprecision(2);
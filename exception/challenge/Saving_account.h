@@ -9,7 +9,7 @@ class Saving_account: public Account
 {
 private:
   static constexpr const char *def_name = "Unnamed savings account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
   static constexpr double def_int_rate = 0.0;
 
 protected:
@@ -17,13 +17,14 @@ protected:
 
 public:
   Saving_account(const std::string name = def_name, 
-    const double balance = def_balance, 
+    const Money balance = def_balance, 
     const double int_rate = def_int_rate);
   
   virtual ~Saving_account() = default;
 
-  virtual bool deposit(double amount) override;
-  virtual bool withdraw(double amount) override;
+  virtual bool deposit(Money amount) override;
+  virtual bool withdraw(Money amount) override;
+  virtual Withdraw_status try_withdraw(Money amount) override;
   virtual void print(std::ostream &os) const override;
 };
 
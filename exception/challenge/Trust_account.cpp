@@ -2,11 +2,11 @@
 #include <iomanip>
 #include "Trust_account.h"
 
-Trust_account::Trust_account(const std::string name, const double balance, const double int_rate)
+Trust_account::Trust_account(const std::string name, const Money balance, const double int_rate)
   : Saving_account(name, balance, int_rate), num_withdrawls(0)
 {}
 
-bool Trust_account::deposit(double amount) 
+bool Trust_account::deposit(Money amount) 
 {
   if (amount >= this->bonus_threshold)
     amount += this->bonus_amount;
@@ -14,7 +14,7 @@ bool Trust_account::deposit(double amount)
   return Saving_account::deposit(amount);
 }
 
-bool Trust_account::withdraw(double amount) 
+bool Trust_account::withdraw(Money amount) 
 {
   if (this->num_withdrawls >= this->max_withdrawls || amount > this->balance * this->max_withdraw_percent)
     return false;
@@ -23,6 +23,15 @@ bool Trust_account::withdraw(double amount)
   return Saving_account::withdraw(amount);
 }
 
+Withdraw_status Trust_account::try_withdraw(Money amount) 
+{
+  if (this->num_withdrawls >= this->max_withdrawls || amount > this->balance * this->max_withdraw_percent)
+    return Withdraw_status::Limit_reached;
+
+  this->num_withdrawls++;
+  return Saving_account::try_withdraw(amount);
+}
+
 void Trust_account::print(std::ostream &os) const 
 {
   std::cout << std::fixed << std::setprecision(2);
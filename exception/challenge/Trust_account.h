@@ -9,10 +9,10 @@ class Trust_account final: public Saving_account
 {
 private:
   static constexpr const char *def_name = "Unnamed trust account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
   static constexpr double def_int_rate = 0.0;
-  static constexpr double bonus_amount = 50.0;
-  static constexpr double bonus_threshold = 5000.0;
+  static constexpr Money bonus_amount = 50.0;
+  static constexpr Money bonus_threshold = 5000.0;
   static constexpr int max_withdrawls = 3;
   static constexpr double max_withdraw_percent = 0.2;
 
@@ -21,13 +21,14 @@ protected:
 
 public:
   Trust_account(const std::string name = def_name, 
-    const double balance = def_balance, 
+    const Money balance = def_balance, 
     const double int_rate = def_int_rate);
 
   virtual ~Trust_account() = default;
 
-  virtual bool deposit(double amount) override;
-  virtual bool withdraw(double amount) override;
+  virtual bool deposit(Money amount) override;
+  virtual bool withdraw(Money amount) override;
+  virtual Withdraw_status try_withdraw(Money amount) override;
   virtual void print(std::ostream &os) const override;
 };
 
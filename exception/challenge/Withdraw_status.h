@@ -0,0 +1,14 @@
+#ifndef _WITHDRAW_STATUS_H_
+#define _WITHDRAW_STATUS_H_
+
+/*
+
+    - the result of a non throwing withdraw, Ok means the balance was changed.
+
+*/
+
+enum class Withdraw_status {Ok, 
+    Insufficient_funds, 
+    Limit_reached};
+
+#endif
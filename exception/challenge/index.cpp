@@ -13,11 +13,15 @@
     - destructor
         - do not throw exceptions from your destructor
 
+    - an error can also be returned, an Expected of Account_expected.h is the account or the
+      error, the same errors, checked with an if, for the paths that fail often
+
 */
 
 #include <iostream>
 #include <memory>
 #include "Account.h"
+#include "Account_expected.h"
 #include "Checking_account.h"
 #include "Illigal_balance_exception.h"
 #include "Insufficent_funds_exception.h"
@@ -40,6 +44,29 @@ int main()
         std::cerr << ex.what() << std::endl;
     }
 
+    Expected<Checking_account, Account_error> larrys_account = open_account<Checking_account>("Larry", -10.0);
+    if (!larrys_account)
+        std::cerr << what(larrys_account.error()) << std::endl;
+
+    Expected<Checking_account, Account_error> curlys_account = open_account<Checking_account>("Curly", 1000.0);
+    if (curlys_account)
+    {
+        Expected<bool, Account_error> withdrawn = expected_withdraw(*curlys_account, 5000);
+        if (!withdrawn)
+            std::cerr << what(withdrawn.error()) << std::endl;
+        std::cout << *curlys_account << std::endl;
+
+        // value() of an error throws the exception it is
+        try
+        {
+            expected_withdraw(*curlys_account, 5000).value();
+        }
+        catch (const Insufficent_funds_exception &ex)
+        {
+            std::cerr << ex.what() << std::endl;
+        }
+    }
+
     std::cout << "Program completed successfully" << std::endl;
 
     return 0;
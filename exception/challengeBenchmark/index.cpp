@@ -0,0 +1,95 @@
+/*
+
+    - compares the throwing withdraw against try_withdraw and expected_withdraw of
+      exception/challenge on a workload where a large share of the withdrawals fail.
+
+    - build it together with the challenge sources:
+        g++ -std=c++17 -O2 index.cpp ../challenge/Account.cpp ../challenge/Checking_account.cpp 
+            ../challenge/Saving_account.cpp ../challenge/Trust_account.cpp ../challenge/I_Printable.cpp
+
+*/
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../challenge/Account.h"
+#include "../challenge/Account_expected.h"
+#include "../challenge/Checking_account.h"
+#include "../challenge/Insufficent_funds_exception.h"
+
+constexpr std::size_t num_accounts {1000};
+constexpr std::size_t num_withdrawls {1'000'000};
+constexpr double failure_rate {0.08};
+
+std::vector<std::unique_ptr<Account>> make_accounts()
+{
+    std::vector<std::unique_ptr<Account>> accounts;
+    for (std::size_t i {0}; i < num_accounts; i++)
+        accounts.push_back(std::make_unique<Checking_account>("Moe", 1'000'000'000.0));
+    return accounts;
+}
+
+// every withdraw is either small enough to pass or so large that it always fails
+std::vector<Money> make_amounts()
+{
+    std::mt19937 gen {42};
+    std::bernoulli_distribution fails {failure_rate};
+
+    std::vector<Money> amounts;
+    for (std::size_t i {0}; i < num_withdrawls; i++)
+        amounts.push_back(fails(gen) ? Money {1e12} : Money {1.0});
+    return amounts;
+}
+
+template<typename Fn>
+double measure(const char *name, Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::size_t failed = fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ": " << elapsed.count() << " ms, " << failed << " failed" << std::endl;
+    return elapsed.count();
+}
+
+int main()
+{
+    const std::vector<Money> amounts = make_amounts();
+
+    auto throwing_accounts = make_accounts();
+    double throwing = measure("withdraw (throws)", [&]() {
+        std::size_t failed {0};
+        for (std::size_t i {0}; i < amounts.size(); i++)
+            try {
+                throwing_accounts[i % num_accounts]->withdraw(amounts[i]);
+            }
+            catch (const Insufficent_funds_exception &) {
+                failed++;
+            }
+        return failed;
+    });
+
+    auto status_accounts = make_accounts();
+    double status = measure("try_withdraw (status)", [&]() {
+        std::size_t failed {0};
+        for (std::size_t i {0}; i < amounts.size(); i++)
+            if (status_accounts[i % num_accounts]->try_withdraw(amounts[i]) != Withdraw_status::Ok)
+                failed++;
+        return failed;
+    });
+
+    auto expected_accounts = make_accounts();
+    double expected = measure("expected_withdraw (Expected)", [&]() {
+        std::size_t failed {0};
+        for (std::size_t i {0}; i < amounts.size(); i++)
+            if (!expected_withdraw(*expected_accounts[i % num_accounts], amounts[i]))
+                failed++;
+        return failed;
+    });
+
+    std::cout << "speedup: " << throwing / status << "x, " << throwing / expected << "x with Expected" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+
+    - measures what an error costs when it is thrown: a throw caught 1, 8 and 64 calls
+      up the stack, every call with a local to destroy, and caught by the first, the 4th
+      or the 8th catch clause, against the same error returned in an Expected and as a
+      status code, the ways the hot paths of exception/challenge can report it. the
+      calls that do not fail are measured too, a try block costs nothing until it throws.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - the number of calls per row can be lowered on the command line, e.g. ./a.out 10000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../challenge/Account_expected.h"
+#include "../challenge/Expected.h"
+#include "../challenge/Illigal_balance_exception.h"
+#include "../challenge/Insufficent_funds_exception.h"
+
+// destroyed on the way up, by the unwinder for a throw and by the returns for the others
+struct Frame
+{
+    static inline int destroyed {0};
+    ~Frame() { destroyed++; }
+};
+
+__attribute__((noinline)) int throw_at(int depth, bool fail)
+{
+    Frame frame;
+    if (depth == 0)
+    {
+        if (fail)
+            throw Insufficent_funds_exception();
+        return 1;
+    }
+    return throw_at(depth - 1, fail) + 1;
+}
+
+__attribute__((noinline)) Expected<int, Account_error> expected_at(int depth, bool fail)
+{
+    Frame frame;
+    if (depth == 0)
+    {
+        if (fail)
+            return unexpected(Account_error::Insufficent_funds);
+        return 1;
+    }
+    Expected<int, Account_error> result = expected_at(depth - 1, fail);
+    if (!result)
+        return result;
+    return *result + 1;
+}
+
+// -1 for the error
+__attribute__((noinline)) int status_at(int depth, bool fail)
+{
+    Frame frame;
+    if (depth == 0)
+        return fail ? -1 : 1;
+    const int result = status_at(depth - 1, fail);
+    if (result < 0)
+        return result;
+    return result + 1;
+}
+
+// the error is caught by the last catch clause, -1
+int catch_by_1(int depth, bool fail)
+{
+    try
+    {
+        return throw_at(depth, fail);
+    }
+    catch (const Insufficent_funds_exception &) { return -1; }
+}
+
+int catch_by_4(int depth, bool fail)
+{
+    try
+    {
+        return throw_at(depth, fail);
+    }
+    catch (const Illigal_balance_exception &) { return -2; }
+    catch (const std::invalid_argument &) { return -3; }
+    catch (const std::overflow_error &) { return -4; }
+    catch (const Insufficent_funds_exception &) { return -1; }
+}
+
+int catch_by_8(int depth, bool fail)
+{
+    try
+    {
+        return throw_at(depth, fail);
+    }
+    catch (const Illigal_balance_exception &) { return -2; }
+    catch (const std::invalid_argument &) { return -3; }
+    catch (const std::overflow_error &) { return -4; }
+    catch (const std::out_of_range &) { return -5; }
+    catch (const std::length_error &) { return -6; }
+    catch (const std::bad_alloc &) { return -7; }
+    catch (const std::logic_error &) { return -8; }
+    catch (const Insufficent_funds_exception &) { return -1; }
+}
+
+// the best of 5 runs of n calls
+template <typename Fn>
+void run(const std::string &name, long n, Fn f)
+{
+    double best {1e9};
+    long checksum {0};
+    for (int i {0}; i < 5; i++)
+    {
+        checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (long k {0}; k < n; k++)
+            checksum += f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::cout << std::setw(36) << std::left << name << std::setw(10) << std::right << std::fixed
+        << std::setprecision(1) << best * 1e9 / static_cast<double>(n) << " ns per call, checksum " << checksum << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const long n = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 20000;
+    // read from a volatile so the compiler does not know which calls fail
+    volatile bool fails {true};
+    volatile bool passes {false};
+
+    for (int depth : {1, 8, 64})
+    {
+        const std::string at = " at depth " + std::to_string(depth);
+        std::cout << std::endl;
+        run("status, passes" + at, n, [&] { return status_at(depth, passes); });
+        run("Expected, passes" + at, n, [&] { return expected_at(depth, passes).value_or(-1); });
+        run("throw, passes" + at, n, [&] { return catch_by_1(depth, passes); });
+        run("status, fails" + at, n, [&] { return status_at(depth, fails); });
+        run("Expected, fails" + at, n, [&] { return expected_at(depth, fails).value_or(-1); });
+        run("throw, 1st catch" + at, n, [&] { return catch_by_1(depth, fails); });
+        run("throw, 4th catch" + at, n, [&] { return catch_by_4(depth, fails); });
+        run("throw, 8th catch" + at, n, [&] { return catch_by_8(depth, fails); });
+    }
+    std::cout << std::endl << "frames destroyed: " << Frame::destroyed << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#ifndef _NUMBER_LIST_H_
+#define _NUMBER_LIST_H_
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+/*
+
+  - Number_list keeps numbers in the order they were added, without duplicates, and
+    their count, sum, smallest and largest, updated by every add, so the mean, the
+    smallest and the largest do not look at the numbers again.
+
+  - whether a number is already in the list is a lookup in a hash set, not a scan of the
+    vector, so adding n numbers is O(n), not O(n^2).
+
+  - the sum is 64 bits, the mean of ints never overflows it.
+
+*/
+class Number_list
+{
+private:
+  std::vector<int> numbers;
+  std::unordered_set<int> seen;
+  long long sum {0};
+  int smallest {0};
+  int largest {0};
+
+public:
+  // room for count numbers, so a long list is not rehashed on the way
+  void reserve(std::size_t count)
+  {
+    this->numbers.reserve(count);
+    this->seen.reserve(count);
+  }
+
+  // false when the number is already in the list
+  bool add(int number)
+  {
+    if (!this->seen.insert(number).second)
+      return false;
+
+    if (this->numbers.empty() || number < this->smallest)
+      this->smallest = number;
+    if (this->numbers.empty() || number > this->largest)
+      this->largest = number;
+    this->sum += number;
+    this->numbers.push_back(number);
+    return true;
+  }
+
+  bool contains(int number) const { return this->seen.count(number) != 0; }
+
+  void clear()
+  {
+    this->numbers.clear();
+    this->seen.clear();
+    this->sum = 0;
+  }
+
+  bool empty() const { return this->numbers.empty(); }
+  std::size_t size() const { return this->numbers.size(); }
+  const std::vector<int> &get_numbers() const { return this->numbers; }
+
+  // the ones below are for a list that is not empty
+  long long get_sum() const { return this->sum; }
+  double get_mean() const { return static_cast<double>(this->sum) / this->numbers.size(); }
+  int get_smallest() const { return this->smallest; }
+  int get_largest() const { return this->largest; }
+};
+
+#endif
@@ -1,124 +1,110 @@
 #include <iostream>
-#include <vector>
 #include <iomanip>
 #include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include "Number_list.h"
+#include "../../tooling/batchInput/Batch_io.h"
+#include "../../tooling/fastConsole/Fast_console.h"
+
+/*
+
+  ./a.out                     the menu, one option at a time
+  ./a.out --batch [commands]  the options of a file, or of stdin, as one batch, without
+                              the menu and the prompts, the same output for each option,
+                              see Batch_io.h
+
+*/
+
 
 void print_menu(void);
-void print_numbers(const std::vector<int> &numbers);
-void add_number(std::vector<int> &numbers);
-void print_mean_of_numbers(const std::vector<int> &numbers);
-void print_smallet_number(const std::vector<int> &numbers);
-void print_larget_number(const std::vector<int> &numbers);
-void clear_list(std::vector<int> &numbers);
+void print_numbers(const Number_list &numbers, std::ostream &os);
+void add_number(Number_list &numbers, int num, std::ostream &os);
+void print_mean_of_numbers(const Number_list &numbers, std::ostream &os);
+void print_smallet_number(const Number_list &numbers, std::ostream &os);
+void print_larget_number(const Number_list &numbers, std::ostream &os);
+void clear_list(Number_list &numbers, std::ostream &os);
 bool is_app_running(char &option);
-char get_option(void);
-void default_option(char option);
-void quit(void);
-void print_list(const std::vector<int> &numbers);
-double calc_mean(const std::vector<int> &numbers);
+char get_option(fast_console::Input &input);
+int get_number(fast_console::Input &input);
+void default_option(char option, std::ostream &os);
+void quit(std::ostream &os);
+void print_list(const Number_list &numbers, std::ostream &os);
+double calc_mean(const Number_list &numbers);
+int run_batch(const char *file);
 
 void print_menu(void)
 {
-  std::cout << "P. print numbers" << std::endl;
-  std::cout << "A. add a number" << std::endl;
-  std::cout << "M. display mean of the numbers" << std::endl;
-  std::cout << "S. display the smallest number" << std::endl;
-  std::cout << "L. display the largest number" << std::endl;
-  std::cout << "C. clear the list" << std::endl;
-  std::cout << "Q. quit" << std::endl << std::endl;
+  std::cout << "P. print numbers" << '\n';
+  std::cout << "A. add a number" << '\n';
+  std::cout << "M. display mean of the numbers" << '\n';
+  std::cout << "S. display the smallest number" << '\n';
+  std::cout << "L. display the largest number" << '\n';
+  std::cout << "C. clear the list" << '\n';
+  std::cout << "Q. quit" << "\n\n";
 }
 
-void print_list(const std::vector<int> &numbers)
+void print_list(const Number_list &numbers, std::ostream &os)
 {
-  std::cout << "[ ";
+  os << "[ ";
 
-  for (auto number : numbers)
-    std::cout << number << " ";
-  
-  std::cout << "]" << std::endl;
+  for (auto number : numbers.get_numbers())
+    os << number << " ";
+
+  os << "]" << '\n';
 }
 
-void print_numbers(const std::vector<int> &numbers)
+void print_numbers(const Number_list &numbers, std::ostream &os)
 {
-  if (!static_cast<bool>(numbers.size()))
-    std::cout << "[] - This list is empty." << std::endl;
+  if (numbers.empty())
+    os << "[] - This list is empty." << '\n';
   else
-    print_list(numbers);
+    print_list(numbers, os);
 }
 
-void add_number(std::vector<int> &numbers)
+void add_number(Number_list &numbers, int num, std::ostream &os)
 {
-  int num {};
-  bool is_num_exist {false};
-
-  std::cout << "Enter an integer: ";
-  std::cin >> num;
-
-  for (auto number : numbers)
-    is_num_exist = number == num;
-
-  if (is_num_exist)
-    std::cout << "The numebr exist before." << std::endl;
-  else {
-    numbers.push_back(num);
-    std::cout << num << " is added." << std::endl;
-  }
+  if (!numbers.add(num))
+    os << "The numebr exist before." << '\n';
+  else
+    os << num << " is added." << '\n';
 }
 
-double calc_mean(const std::vector<int> &numbers)
+double calc_mean(const Number_list &numbers)
 {
-  int mean {};
-
-  for (auto number : numbers)
-    mean += number;
-
-  return static_cast<double>(mean) / numbers.size();
+  return numbers.get_mean();
 }
 
-void print_mean_of_numbers(const std::vector<int> &numbers)
+void print_mean_of_numbers(const Number_list &numbers, std::ostream &os)
 {
-  if (!static_cast<bool>(numbers.size()))
-    std::cout << "[] - This list is empty and could not find the mean." << std::endl;
+  if (numbers.empty())
+    os << "[] - This list is empty and could not find the mean." << '\n';
   else {
-    std::cout << std::fixed << std::setprecision(1);
-    std::cout << "The mean is " << calc_mean(numbers) << std::endl;
+    os << std::fixed << std::setprecision(1);
+    os << "The mean is " << calc_mean(numbers) << '\n';
   }
 }
 
-void print_smallet_number(const std::vector<int> &numbers)
+void print_smallet_number(const Number_list &numbers, std::ostream &os)
 {
-  if (!static_cast<bool>(numbers.size()))
-    std::cout << "[] - This list is empty and could not find the smallest." << std::endl;
-  else {
-    int smallest {INT_MAX};
-
-    for (auto number : numbers)
-      if (number < smallest)
-        smallest = number;
-
-    std::cout << "The smallest is " << smallest << std::endl;
-  }
+  if (numbers.empty())
+    os << "[] - This list is empty and could not find the smallest." << '\n';
+  else
+    os << "The smallest is " << numbers.get_smallest() << '\n';
 }
 
-void print_larget_number(const std::vector<int> &numbers)
+void print_larget_number(const Number_list &numbers, std::ostream &os)
 {
-  if (!static_cast<bool>(numbers.size()))
-    std::cout << "[] - This list is empty and could not find the largest." << std::endl;
-  else {
-    int largest {INT_MIN};
-
-    for (auto number : numbers)
-      if (number > largest)
-        largest = number;
-
-    std::cout << "The largest is " << largest << std::endl;
-  }
+  if (numbers.empty())
+    os << "[] - This list is empty and could not find the largest." << '\n';
+  else
+    os << "The largest is " << numbers.get_largest() << '\n';
 }
 
-void clear_list(std::vector<int> &numbers)
+void clear_list(Number_list &numbers, std::ostream &os)
 {
   numbers.clear();
-  std::cout << "He list was cleared." << std::endl;
+  os << "He list was cleared." << '\n';
 }
 
 bool is_app_running(char &option)
@@ -126,69 +112,125 @@ bool is_app_running(char &option)
   return option != 'Q';
 }
 
-char get_option(void)
+// Q at the end of the input, the menu does not wait for an option that never comes
+char get_option(fast_console::Input &input)
 {
-  char option {};
+  char option {'Q'};
   std::cout << "Enter the option: ";
-  std::cin >> option;
+  input.next_char(option);
   return toupper(option);
 }
 
-void default_option(char option)
+// 0 for a word that is not a number, and the rest of its line goes
+int get_number(fast_console::Input &input)
 {
-  std::cout << option << " is unknown, please try again." << std::endl;
+  int num {};
+  std::cout << "Enter an integer: ";
+  if (!input.next_int(num))
+    input.ignore_line();
+  return num;
 }
 
-void quit(void)
+void default_option(char option, std::ostream &os)
 {
-  std::cout << "Goodbye..." << std::endl;
+  os << option << " is unknown, please try again." << '\n';
 }
 
-int main()
+void quit(std::ostream &os)
 {
-  std::vector<int> numbers;
-  char option {};
-
-  do {
-    print_menu();
-
-    option = get_option();
+  os << "Goodbye..." << '\n';
+}
 
-    switch (option) {
-      case 'P': 
-        print_numbers(numbers);
-        break;
+// one option, the menu and the batch run the same handlers, read_number gives the number of A
+template <typename Read_number>
+void run_option(char option, Number_list &numbers, std::ostream &os, Read_number read_number)
+{
+  switch (option) {
+    case 'P':
+      print_numbers(numbers, os);
+      break;
+
+    case 'A':
+      add_number(numbers, read_number(), os);
+      break;
+
+    case 'M':
+      print_mean_of_numbers(numbers, os);
+      break;
+
+    case 'S':
+      print_smallet_number(numbers, os);
+      break;
+
+    case 'L':
+      print_larget_number(numbers, os);
+      break;
+
+    case 'C':
+      clear_list(numbers, os);
+      break;
+
+    case 'Q':
+      quit(os);
+      break;
+
+    default:
+      default_option(option, os);
+      break;
+  }
+}
 
-      case 'A': 
-        add_number(numbers);
-        break;
+// until Q or the end of the commands, a number that is not one ends it, std::cin would
+// wait for it forever
+int run_batch(const char *file)
+{
+  const std::string commands {batch_io::read_all(file)};
+  batch_io::Scanner scanner {commands};
+  batch_io::Output_buffer buffer;
+  std::ostream os {&buffer};
+  Number_list numbers;
+  char option {};
 
-      case 'M': 
-        print_mean_of_numbers(numbers);
-        break;
+  while (scanner.next_char(option)) {
+    option = toupper(option);
+    run_option(option, numbers, os, [&scanner]() {
+      int num {};
+      if (!scanner.next_int(num))
+        throw std::runtime_error("line " + std::to_string(scanner.get_line()) + ": an integer is expected after A");
+      return num;
+    });
+
+    if (!is_app_running(option))
+      break;
+  }
 
-      case 'S': 
-        print_smallet_number(numbers);
-        break;
+  return 0;
+}
 
-      case 'L':
-        print_larget_number(numbers);
-        break;
+int main(int argc, char *argv[])
+{
+  const char *file {nullptr};
+  if (batch_io::is_batch(argc, argv, file)) {
+    try {
+      return run_batch(file);
+    }
+    catch (const std::runtime_error &ex) {
+      std::cerr << ex.what() << std::endl;
+      return 1;
+    }
+  }
 
-      case 'C': 
-        clear_list(numbers);
-        break;
+  fast_console::Guard console;
+  Number_list numbers;
+  char option {};
 
-      case 'Q': 
-        quit();
-        break;
+  do {
+    print_menu();
 
-      default: 
-        default_option(option);
-        break;
-    }
+    option = get_option(console.input());
+    run_option(option, numbers, std::cout, [&console]() { return get_number(console.input()); });
 
-    std::cout << std::endl << std::endl;
+    std::cout << "\n\n";
   } while (is_app_running(option));
 
   return 0;
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <cmath>
+#include <vector>
+#include "Batch_math.h"
 
 int main()
 {
@@ -16,5 +18,16 @@ int main()
   std::cout << "The floor of " << num << " is " << floor(num) << "." << std::endl;
   std::cout << "The round of " << num << " is " << round(num) << "." << std::endl;
 
+  // the same functions on num and the 3 numbers after it at once
+  std::vector<double> nums {num, num + 1, num + 2, num + 3};
+  std::vector<double> sines = batch_math::sin(nums);
+  std::vector<double> fast_sines = batch_math::sin(nums, batch_math::Accuracy::fast);
+  std::vector<double> roots = batch_math::cbrt(nums);
+
+  std::cout << std::endl;
+  for (size_t i = 0; i < nums.size(); ++i)
+    std::cout << "sin(" << nums[i] << ") = " << sines[i] << ", fast " << fast_sines[i]
+              << ", cbrt(" << nums[i] << ") = " << roots[i] << std::endl;
+
   return 0;
 }
@@ -0,0 +1,120 @@
+/*
+
+    - compares sqrt, cbrt, sin, cos, ceil, floor and round of <cmath>, one double at a time,
+      against the batch ones of ../math/Batch_math.h, the accurate and the fast ones, on the
+      same array, in ns per number, with the largest error to the ones of <cmath>, in ulp,
+      and, for the fast sin and cos, not relative.
+
+    - build it with:
+        g++ -std=c++17 -O2 -march=native index.cpp
+      without -mavx2 or -march=native the batch ones are one at a time too.
+
+    - 10'000'000 numbers by default, the number can be given on the command line, e.g.
+      ./a.out 1000000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../math/Batch_math.h"
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double ulp_distance(double a, double b)
+{
+    if (a == b)
+        return 0;
+    std::int64_t ia;
+    std::int64_t ib;
+    std::memcpy(&ia, &a, sizeof a);
+    std::memcpy(&ib, &b, sizeof b);
+    // the doubles in the order of the integers, the negative ones below the positive ones
+    ia = ia < 0 ? INT64_MIN - ia : ia;
+    ib = ib < 0 ? INT64_MIN - ib : ib;
+    return static_cast<double>(ia > ib ? static_cast<std::uint64_t>(ia) - static_cast<std::uint64_t>(ib)
+                                       : static_cast<std::uint64_t>(ib) - static_cast<std::uint64_t>(ia));
+}
+
+// ns per number of f(), then the largest ulp and absolute distances of out to expected, not timed
+template <typename F>
+void run(const std::string& name, const std::vector<double>& out, const std::vector<double>& expected, F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const double seconds = seconds_since(start);
+    double max_ulp {0};
+    double max_abs {0};
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        max_ulp = std::max(max_ulp, ulp_distance(out[i], expected[i]));
+        max_abs = std::max(max_abs, std::abs(out[i] - expected[i]));
+    }
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << seconds * 1e9 / out.size()
+        << std::setw(14) << max_ulp << std::scientific << std::setprecision(2)
+        << std::setw(12) << max_abs << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10'000'000;
+
+    std::mt19937_64 gen {42};
+    std::vector<double> positive(n);
+    std::vector<double> samples(n);
+    std::uniform_real_distribution<double> magnitude {0.0, 1000.0};
+    std::uniform_real_distribution<double> signal {-1000.0, 1000.0};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        positive[i] = magnitude(gen);
+        samples[i] = signal(gen);
+    }
+
+    std::vector<double> expected(n);
+    std::vector<double> out(n);
+    const auto each = [&](const std::vector<double>& in, double (*f)(double)) {
+        for (std::size_t i = 0; i < n; ++i)
+            expected[i] = f(in[i]);
+    };
+    std::cout << std::setw(36) << std::left << "ns per number" << std::setw(10) << std::right << ""
+        << std::setw(14) << "max ulp" << std::setw(12) << "max abs" << std::endl;
+
+    using batch_math::Accuracy;
+    run("std::sqrt", expected, expected, [&] { each(positive, std::sqrt); });
+    run("batch_math::sqrt", out, expected, [&] { batch_math::sqrt(positive.data(), out.data(), n); });
+
+    run("std::cbrt", expected, expected, [&] { each(samples, std::cbrt); });
+    run("batch_math::cbrt", out, expected, [&] { batch_math::cbrt(samples.data(), out.data(), n); });
+    run("batch_math::cbrt, fast", out, expected, [&] { batch_math::cbrt(samples.data(), out.data(), n, Accuracy::fast); });
+
+    run("std::sin", expected, expected, [&] { each(samples, std::sin); });
+    run("batch_math::sin", out, expected, [&] { batch_math::sin(samples.data(), out.data(), n); });
+    run("batch_math::sin, fast", out, expected, [&] { batch_math::sin(samples.data(), out.data(), n, Accuracy::fast); });
+
+    run("std::cos", expected, expected, [&] { each(samples, std::cos); });
+    run("batch_math::cos", out, expected, [&] { batch_math::cos(samples.data(), out.data(), n); });
+    run("batch_math::cos, fast", out, expected, [&] { batch_math::cos(samples.data(), out.data(), n, Accuracy::fast); });
+
+    run("std::ceil", expected, expected, [&] { each(samples, std::ceil); });
+    run("batch_math::ceil", out, expected, [&] { batch_math::ceil(samples.data(), out.data(), n); });
+
+    run("std::floor", expected, expected, [&] { each(samples, std::floor); });
+    run("batch_math::floor", out, expected, [&] { batch_math::floor(samples.data(), out.data(), n); });
+
+    run("std::round", expected, expected, [&] { each(samples, std::round); });
+    run("batch_math::round", out, expected, [&] { batch_math::round(samples.data(), out.data(), n); });
+
+    return 0;
+}
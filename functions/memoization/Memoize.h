@@ -0,0 +1,386 @@
+#ifndef _MEMOIZE_H_
+#define _MEMOIZE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+
+    - memo::memoize(f, capacity) wraps a pure function, a function pointer or a lambda that
+      is not generic, in an object that is called the same way and keeps up to capacity of
+      its results, keyed on a tuple of copies of its arguments, hashed with std::hash of each
+      one, so a call with arguments it has seen returns the kept result without calling f.
+      f has to give the same result for the same arguments, and not depend on anything else,
+      a static variable, a global, ..., like the one of ../staticVariableInFunction.
+
+    - when the cache is full a new result evicts an old one: memo::Lru evicts the one used
+      the longest ago, it moves every result it returns to the front of a list, memo::Clock
+      keeps a bit for every result that is set when it is used, and a hand that goes around
+      them, clears the bits that are set and evicts the first one that is not, no list to
+      update on a hit, close to LRU for most patterns.
+
+    - memo::memoize_concurrent(f, capacity, shards) can be called from several threads, the
+      keys are spread over shards caches by their hash, each one with its own mutex, so
+      threads that call it with different arguments rarely wait on the same one. f runs
+      outside the lock, two threads that miss the same key at once both call it and the
+      second result replaces the first, the same one.
+
+    - stats() counts the hits, the misses and the evictions, the hit rate tells whether the
+      cache is worth keeping.
+
+*/
+namespace memo
+{
+    struct Lru {};
+    struct Clock {};
+
+    struct Stats
+    {
+        std::uint64_t hits {0};
+        std::uint64_t misses {0};
+        std::uint64_t evictions {0};
+
+        double hit_rate() const { return this->hits + this->misses == 0 ? 0.0 : static_cast<double>(this->hits) / (this->hits + this->misses); }
+    };
+
+    namespace detail
+    {
+        // the arguments and the result of a function pointer or of the operator() of a lambda
+        template<class F>
+        struct Signature : Signature<decltype(&F::operator())> {};
+
+        template<class R, class... Args>
+        struct Signature<R (*)(Args...)>
+        {
+            using key_type = std::tuple<std::decay_t<Args>...>;
+            using result_type = std::decay_t<R>;
+        };
+
+        template<class R, class... Args>
+        struct Signature<R (&)(Args...)> : Signature<R (*)(Args...)> {};
+
+        template<class R, class... Args>
+        struct Signature<R(Args...)> : Signature<R (*)(Args...)> {};
+
+        template<class C, class R, class... Args>
+        struct Signature<R (C::*)(Args...)> : Signature<R (*)(Args...)> {};
+
+        template<class C, class R, class... Args>
+        struct Signature<R (C::*)(Args...) const> : Signature<R (*)(Args...)> {};
+
+        inline std::size_t combine(std::size_t seed, std::size_t hash)
+        {
+            return seed ^ (hash + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+        }
+
+        struct Tuple_hash
+        {
+            template<class... Ts>
+            std::size_t operator()(const std::tuple<Ts...>& key) const
+            {
+                return std::apply([](const Ts&... values)
+                {
+                    std::size_t seed {0};
+                    ((seed = combine(seed, std::hash<Ts> {}(values))), ...);
+                    return seed;
+                }, key);
+            }
+        };
+
+        template<class Key, class Value, class Eviction>
+        class Cache;
+
+        template<class Key, class Value>
+        class Cache<Key, Value, Lru>
+        {
+        private:
+            using Entries = std::list<std::pair<Key, Value>>;
+
+            std::size_t capacity;
+            Entries entries;
+            std::unordered_map<Key, typename Entries::iterator, Tuple_hash> index;
+
+        public:
+            explicit Cache(std::size_t capacity) : capacity(capacity == 0 ? 1 : capacity)
+            {
+                this->index.reserve(this->capacity);
+            }
+
+            std::optional<Value> find(const Key& key)
+            {
+                const auto it = this->index.find(key);
+                if (it == this->index.end())
+                    return std::nullopt;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->second;
+            }
+
+            // true when it evicted one
+            bool insert(Key key, Value value)
+            {
+                const auto it = this->index.find(key);
+                if (it != this->index.end())
+                {
+                    it->second->second = std::move(value);
+                    this->entries.splice(this->entries.begin(), this->entries, it->second);
+                    return false;
+                }
+                bool evicted {false};
+                if (this->entries.size() == this->capacity)
+                {
+                    // the node of the oldest one is reused for the new one
+                    const auto last = std::prev(this->entries.end());
+                    this->index.erase(last->first);
+                    last->first = std::move(key);
+                    last->second = std::move(value);
+                    this->entries.splice(this->entries.begin(), this->entries, last);
+                    evicted = true;
+                }
+                else
+                    this->entries.emplace_front(std::move(key), std::move(value));
+                this->index.emplace(this->entries.front().first, this->entries.begin());
+                return evicted;
+            }
+
+            std::size_t size() const { return this->entries.size(); }
+
+            void clear()
+            {
+                this->entries.clear();
+                this->index.clear();
+            }
+        };
+
+        template<class Key, class Value>
+        class Cache<Key, Value, Clock>
+        {
+        private:
+            struct Slot
+            {
+                Key key;
+                Value value;
+                bool referenced;
+            };
+
+            std::size_t capacity;
+            std::vector<Slot> slots;
+            std::size_t hand {0};
+            std::unordered_map<Key, std::size_t, Tuple_hash> index;
+
+        public:
+            explicit Cache(std::size_t capacity) : capacity(capacity == 0 ? 1 : capacity)
+            {
+                this->slots.reserve(this->capacity);
+                this->index.reserve(this->capacity);
+            }
+
+            std::optional<Value> find(const Key& key)
+            {
+                const auto it = this->index.find(key);
+                if (it == this->index.end())
+                    return std::nullopt;
+                Slot& slot = this->slots[it->second];
+                slot.referenced = true;
+                return slot.value;
+            }
+
+            bool insert(Key key, Value value)
+            {
+                const auto it = this->index.find(key);
+                if (it != this->index.end())
+                {
+                    Slot& slot = this->slots[it->second];
+                    slot.value = std::move(value);
+                    slot.referenced = true;
+                    return false;
+                }
+                if (this->slots.size() < this->capacity)
+                {
+                    this->index.emplace(key, this->slots.size());
+                    this->slots.push_back(Slot {std::move(key), std::move(value), false});
+                    return false;
+                }
+                // a second chance for every one used since the hand last passed it
+                while (this->slots[this->hand].referenced)
+                {
+                    this->slots[this->hand].referenced = false;
+                    this->hand = this->hand + 1 == this->capacity ? 0 : this->hand + 1;
+                }
+                Slot& victim = this->slots[this->hand];
+                this->index.erase(victim.key);
+                this->index.emplace(key, this->hand);
+                victim = Slot {std::move(key), std::move(value), false};
+                this->hand = this->hand + 1 == this->capacity ? 0 : this->hand + 1;
+                return true;
+            }
+
+            std::size_t size() const { return this->slots.size(); }
+
+            void clear()
+            {
+                this->slots.clear();
+                this->index.clear();
+                this->hand = 0;
+            }
+        };
+    }
+
+    template<class F, class Eviction = Lru>
+    class Memoized
+    {
+    public:
+        using key_type = typename detail::Signature<F>::key_type;
+        using result_type = typename detail::Signature<F>::result_type;
+
+    private:
+        F f;
+        detail::Cache<key_type, result_type, Eviction> cache;
+        Stats counts;
+
+    public:
+        Memoized(F f, std::size_t capacity) : f(std::move(f)), cache(capacity) {}
+
+        template<class... Args>
+        result_type operator()(Args&&... args)
+        {
+            key_type key {std::forward<Args>(args)...};
+            if (std::optional<result_type> result = this->cache.find(key))
+            {
+                ++this->counts.hits;
+                return std::move(*result);
+            }
+            ++this->counts.misses;
+            result_type result = std::apply(this->f, static_cast<const key_type&>(key));
+            this->counts.evictions += this->cache.insert(std::move(key), result);
+            return result;
+        }
+
+        Stats stats() const { return this->counts; }
+        std::size_t size() const { return this->cache.size(); }
+
+        void clear()
+        {
+            this->cache.clear();
+            this->counts = Stats {};
+        }
+    };
+
+    template<class F, class Eviction = Lru>
+    class Concurrent_memoized
+    {
+    public:
+        using key_type = typename detail::Signature<F>::key_type;
+        using result_type = typename detail::Signature<F>::result_type;
+
+    private:
+        struct Shard
+        {
+            std::mutex mutex;
+            detail::Cache<key_type, result_type, Eviction> cache;
+            Stats counts;
+
+            explicit Shard(std::size_t capacity) : cache(capacity) {}
+        };
+
+        F f;
+        std::vector<std::unique_ptr<Shard>> shards;
+
+        Shard& shard_of(const key_type& key) const
+        {
+            // the high bits of the hash times the golden ratio, the low ones pick the bucket of the
+            // map of the shard, and std::hash of an integer is the integer
+            const std::uint64_t hash = static_cast<std::uint64_t>(detail::Tuple_hash {}(key)) * 0x9E3779B97F4A7C15ull;
+            return *this->shards[static_cast<std::size_t>(hash >> 32) % this->shards.size()];
+        }
+
+    public:
+        static constexpr std::size_t def_num_shards = 16;
+
+        Concurrent_memoized(F f, std::size_t capacity, std::size_t num_shards = def_num_shards) : f(std::move(f))
+        {
+            num_shards = num_shards == 0 ? 1 : num_shards;
+            for (std::size_t i = 0; i < num_shards; ++i)
+                this->shards.push_back(std::make_unique<Shard>((capacity + num_shards - 1) / num_shards));
+        }
+
+        template<class... Args>
+        result_type operator()(Args&&... args)
+        {
+            key_type key {std::forward<Args>(args)...};
+            Shard& shard = this->shard_of(key);
+            {
+                std::lock_guard<std::mutex> lock {shard.mutex};
+                if (std::optional<result_type> result = shard.cache.find(key))
+                {
+                    ++shard.counts.hits;
+                    return std::move(*result);
+                }
+                ++shard.counts.misses;
+            }
+            result_type result = std::apply(this->f, static_cast<const key_type&>(key));
+            std::lock_guard<std::mutex> lock {shard.mutex};
+            shard.counts.evictions += shard.cache.insert(std::move(key), result);
+            return result;
+        }
+
+        // the sums of the shards, each one read under its lock
+        Stats stats() const
+        {
+            Stats total;
+            for (const std::unique_ptr<Shard>& shard : this->shards)
+            {
+                std::lock_guard<std::mutex> lock {shard->mutex};
+                total.hits += shard->counts.hits;
+                total.misses += shard->counts.misses;
+                total.evictions += shard->counts.evictions;
+            }
+            return total;
+        }
+
+        std::size_t size() const
+        {
+            std::size_t size {0};
+            for (const std::unique_ptr<Shard>& shard : this->shards)
+            {
+                std::lock_guard<std::mutex> lock {shard->mutex};
+                size += shard->cache.size();
+            }
+            return size;
+        }
+
+        void clear()
+        {
+            for (const std::unique_ptr<Shard>& shard : this->shards)
+            {
+                std::lock_guard<std::mutex> lock {shard->mutex};
+                shard->cache.clear();
+                shard->counts = Stats {};
+            }
+        }
+    };
+
+    template<class Eviction = Lru, class F>
+    Memoized<std::decay_t<F>, Eviction> memoize(F&& f, std::size_t capacity = 1024)
+    {
+        return {std::forward<F>(f), capacity};
+    }
+
+    template<class Eviction = Lru, class F>
+    Concurrent_memoized<std::decay_t<F>, Eviction> memoize_concurrent(F&& f, std::size_t capacity = 1024,
+                                                                      std::size_t num_shards = Concurrent_memoized<std::decay_t<F>, Eviction>::def_num_shards)
+    {
+        return Concurrent_memoized<std::decay_t<F>, Eviction>(std::forward<F>(f), capacity, num_shards);
+    }
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+
+  memoize keeps the results of a function for the arguments it was called with,
+  the next call with the same ones returns the kept result and does not run the function.
+  it only works for a pure function, one whose result depends only on its arguments.
+
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Memoize.h"
+
+std::uint64_t fibonacci(unsigned n)
+{
+  if (n <= 1)
+    return n;
+  return fibonacci(n - 1) + fibonacci(n - 2);
+}
+
+int main()
+{
+  // the slow recursion runs once for every n, the other calls are hits
+  auto fast_fibonacci = memo::memoize(fibonacci, 64);
+  for (int round = 0; round < 3; ++round)
+    for (unsigned n = 30; n < 35; ++n)
+      std::cout << fast_fibonacci(n) << " ";
+  std::cout << std::endl;
+  memo::Stats stats = fast_fibonacci.stats();
+  std::cout << "hits: " << stats.hits << ", misses: " << stats.misses << std::endl;
+
+  // only 2 are kept, the clock evicts one that was not used since the hand passed it
+  auto greet = memo::memoize<memo::Clock>([](const std::string &name, int times) {
+    std::string greeting;
+    for (int i = 0; i < times; ++i)
+      greeting += "hello " + name + " ";
+    return greeting;
+  }, 2);
+  std::cout << greet("Moe", 2) << std::endl;
+  std::cout << greet("Larry", 1) << std::endl;
+  std::cout << greet("Moe", 2) << std::endl;
+  std::cout << greet("Curly", 1) << std::endl;
+  stats = greet.stats();
+  std::cout << "hits: " << stats.hits << ", misses: " << stats.misses << ", evictions: " << stats.evictions << std::endl;
+
+  // shared by 4 threads, the shards have their own locks
+  auto shared = memo::memoize_concurrent(fibonacci, 64);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&shared] {
+      for (unsigned n = 20; n < 30; ++n)
+        shared(n);
+    });
+  for (std::thread &thread : threads)
+    thread.join();
+  stats = shared.stats();
+  std::cout << "hit rate with 4 threads: " << stats.hit_rate() << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef _SPAN_H_
+#define _SPAN_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
+
+/*
+
+    - Span<T> is the address of the first element of an array and its size, the (int arr[],
+      size_t size) pair of index.cpp in one argument, that nothing is copied into and that
+      owns nothing, the array has to outlive it. Span<const T> is for an array the function
+      does not change, a Span<T> converts to it.
+
+    - it is built from a pointer and a size, from an array, the size is the one of its type,
+      or from anything with data() and size(), a std::vector, a std::array, an Array of
+      ../../standardTemplateLibrary/creatingGenericArrayTemplate, ..., and converts to a
+      std::span with C++20.
+
+    - subspan(offset, count) is a part of it, with no copy, std::out_of_range when the part is
+      not in it.
+
+*/
+template <typename T>
+class Span;
+
+template <typename T>
+struct Is_span : std::false_type {};
+
+template <typename T>
+struct Is_span<Span<T>> : std::true_type {};
+
+template <typename T>
+class Span
+{
+private:
+    T* first {nullptr};
+    std::size_t count {0};
+
+    template <typename C>
+    using Data_of = std::remove_pointer_t<decltype(std::declval<C&>().data())>;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using iterator = T*;
+
+    constexpr Span() = default;
+    constexpr Span(T* first, std::size_t count) : first(first), count(count) {}
+
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) : first(array), count(N) {}
+
+    // a vector, a std::array, ... of T, or of the T without const for a Span<const T>
+    template <typename C, typename = std::enable_if_t<!Is_span<std::remove_cv_t<C>>::value
+                                                      && std::is_convertible_v<Data_of<C> (*)[], T (*)[]>>>
+    constexpr Span(C& container) : first(container.data()), count(container.size()) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(Span<U> other) : first(other.data()), count(other.size()) {}
+
+    constexpr T* data() const { return this->first; }
+    constexpr std::size_t size() const { return this->count; }
+    constexpr bool empty() const { return this->count == 0; }
+
+    constexpr T& operator[](std::size_t index) const { return this->first[index]; }
+
+    constexpr iterator begin() const { return this->first; }
+    constexpr iterator end() const { return this->first + this->count; }
+
+    Span subspan(std::size_t offset, std::size_t count) const
+    {
+        if (offset > this->count || count > this->count - offset)
+            throw std::out_of_range {"the subspan is not in the span"};
+        return Span {this->first + offset, count};
+    }
+
+#if defined(__cpp_lib_span)
+    constexpr operator std::span<T>() const { return std::span<T> {this->first, this->count}; }
+#endif
+};
+
+#endif
@@ -28,9 +28,13 @@
 */
 
 #include <iostream>
+#include <vector>
+#include "Span.h"
 
 void print_arr(const int arr[], size_t size);
 void change_arr(int arr[], size_t size, int new_value);
+void print_arr(Span<const int> arr);
+void change_arr(Span<int> arr, int new_value);
 
 void print_arr(const int arr[], size_t size)
 {
@@ -47,6 +51,25 @@ void change_arr(int arr[], size_t size, int new_value)
     arr[i] = new_value;
 }
 
+/*
+
+  a Span is the address and the size in one argument, it knows the size of the array it was
+  built from, and the same function takes an array, a vector or a part of one of them.
+
+*/
+void print_arr(Span<const int> arr)
+{
+  for (int value : arr)
+    std::cout << value << " ";
+  std::cout << std::endl;
+}
+
+void change_arr(Span<int> arr, int new_value)
+{
+  for (int &value : arr)
+    value = new_value;
+}
+
 int main()
 {
   int array[] {10, 20, 30, 40, 50};
@@ -57,5 +80,12 @@ int main()
   change_arr(array, 5, 100);
   print_arr(array, 5);
 
+  std::vector<int> vector {1, 2, 3, 4, 5};
+
+  change_arr(Span<int> {array}.subspan(1, 3), 7);
+  print_arr(Span<const int> {array});
+  change_arr(vector, 9);
+  print_arr(vector);
+
   return 0;
 }
@@ -0,0 +1,239 @@
+#ifndef _BIG_UNSIGNED_H_
+#define _BIG_UNSIGNED_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+
+    - a Big_unsigned is a whole number of any size, its digits in base 2^32, the lowest one
+      first, without zeros at the top, so 0 has none. it adds, subtracts and multiplies, a
+      subtraction below 0 throws std::underflow_error.
+
+    - * is the schoolbook product, the digits of one number times those of the other, with a
+      64 bit total for each one, Karatsuba splits the numbers of more than karatsuba_digits
+      digits in halves and multiplies them with 3 products of the halves instead of 4.
+
+    - to_string divides by 10^9 at a time, a quadratic number of steps, it is for printing.
+
+*/
+class Big_unsigned
+{
+    friend std::ostream& operator<<(std::ostream& os, const Big_unsigned& value)
+    {
+        return os << value.to_string();
+    }
+
+private:
+    std::vector<std::uint32_t> digits;
+
+    static constexpr std::size_t karatsuba_digits = 48;
+
+    void trim()
+    {
+        while (!this->digits.empty() && this->digits.back() == 0)
+            this->digits.pop_back();
+    }
+
+    // out[0, a_n + b_n) += a * b, out has room for them
+    static void add_product(const std::uint32_t* a, std::size_t a_n, const std::uint32_t* b, std::size_t b_n, std::uint32_t* out)
+    {
+        for (std::size_t i = 0; i < a_n; ++i)
+        {
+            std::uint64_t carry {0};
+            for (std::size_t j = 0; j < b_n; ++j)
+            {
+                const std::uint64_t t = static_cast<std::uint64_t>(a[i]) * b[j] + out[i + j] + carry;
+                out[i + j] = static_cast<std::uint32_t>(t);
+                carry = t >> 32;
+            }
+            for (std::size_t k = i + b_n; carry != 0; ++k)
+            {
+                const std::uint64_t t = static_cast<std::uint64_t>(out[k]) + carry;
+                out[k] = static_cast<std::uint32_t>(t);
+                carry = t >> 32;
+            }
+        }
+    }
+
+    static Big_unsigned from(const std::uint32_t* digits, std::size_t n)
+    {
+        Big_unsigned value;
+        value.digits.assign(digits, digits + n);
+        value.trim();
+        return value;
+    }
+
+    // the digits of value times 2^(32 shift) added to this
+    void add_shifted(const Big_unsigned& value, std::size_t shift)
+    {
+        if (this->digits.size() < value.digits.size() + shift)
+            this->digits.resize(value.digits.size() + shift, 0);
+        std::uint64_t carry {0};
+        std::size_t i = 0;
+        for (; i < value.digits.size(); ++i)
+        {
+            const std::uint64_t t = static_cast<std::uint64_t>(this->digits[i + shift]) + value.digits[i] + carry;
+            this->digits[i + shift] = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+        for (i += shift; carry != 0; ++i)
+        {
+            if (i == this->digits.size())
+                this->digits.push_back(0);
+            const std::uint64_t t = static_cast<std::uint64_t>(this->digits[i]) + carry;
+            this->digits[i] = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+
+    static Big_unsigned multiply(const std::uint32_t* a, std::size_t a_n, const std::uint32_t* b, std::size_t b_n)
+    {
+        if (a_n == 0 || b_n == 0)
+            return {};
+        if (std::min(a_n, b_n) <= karatsuba_digits)
+        {
+            Big_unsigned product;
+            product.digits.assign(a_n + b_n, 0);
+            add_product(a, a_n, b, b_n, product.digits.data());
+            product.trim();
+            return product;
+        }
+
+        // a = a1 2^(32 m) + a0, b the same, a b = z2 2^(64 m) + z1 2^(32 m) + z0
+        const std::size_t m = std::max(a_n, b_n) / 2;
+        const std::size_t a0_n = std::min(a_n, m);
+        const std::size_t b0_n = std::min(b_n, m);
+        const Big_unsigned a0 = from(a, a0_n);
+        const Big_unsigned a1 = from(a + a0_n, a_n - a0_n);
+        const Big_unsigned b0 = from(b, b0_n);
+        const Big_unsigned b1 = from(b + b0_n, b_n - b0_n);
+        const Big_unsigned z0 = a0 * b0;
+        const Big_unsigned z2 = a1 * b1;
+        const Big_unsigned z1 = (a0 + a1) * (b0 + b1) - z0 - z2;
+
+        Big_unsigned product = z0;
+        product.add_shifted(z1, m);
+        product.add_shifted(z2, 2 * m);
+        product.trim();
+        return product;
+    }
+
+public:
+    Big_unsigned() = default;
+
+    Big_unsigned(std::uint64_t value)
+    {
+        for (; value != 0; value >>= 32)
+            this->digits.push_back(static_cast<std::uint32_t>(value));
+    }
+
+    bool is_zero() const { return this->digits.empty(); }
+
+    // the number of bits, 0 for 0
+    std::size_t bit_width() const
+    {
+        if (this->digits.empty())
+            return 0;
+        std::size_t bits = 32 * (this->digits.size() - 1);
+        for (std::uint32_t top = this->digits.back(); top != 0; top >>= 1)
+            ++bits;
+        return bits;
+    }
+
+    // the value when it fits in 64 bits, std::overflow_error when it does not
+    std::uint64_t to_uint64() const
+    {
+        if (this->digits.size() > 2)
+            throw std::overflow_error {"Big_unsigned does not fit in 64 bits"};
+        std::uint64_t value {0};
+        for (std::size_t i = this->digits.size(); i-- > 0;)
+            value = value << 32 | this->digits[i];
+        return value;
+    }
+
+    Big_unsigned& operator+=(const Big_unsigned& other)
+    {
+        this->add_shifted(other, 0);
+        return *this;
+    }
+
+    Big_unsigned& operator-=(const Big_unsigned& other)
+    {
+        if (*this < other)
+            throw std::underflow_error {"Big_unsigned subtraction below 0"};
+        std::int64_t borrow {0};
+        for (std::size_t i = 0; i < this->digits.size(); ++i)
+        {
+            std::int64_t t = static_cast<std::int64_t>(this->digits[i]) - borrow - (i < other.digits.size() ? other.digits[i] : 0);
+            borrow = t < 0;
+            if (t < 0)
+                t += std::int64_t {1} << 32;
+            this->digits[i] = static_cast<std::uint32_t>(t);
+            if (borrow == 0 && i >= other.digits.size())
+                break;
+        }
+        this->trim();
+        return *this;
+    }
+
+    Big_unsigned& operator*=(const Big_unsigned& other)
+    {
+        return *this = *this * other;
+    }
+
+    friend Big_unsigned operator+(Big_unsigned a, const Big_unsigned& b) { return a += b; }
+    friend Big_unsigned operator-(Big_unsigned a, const Big_unsigned& b) { return a -= b; }
+
+    friend Big_unsigned operator*(const Big_unsigned& a, const Big_unsigned& b)
+    {
+        return multiply(a.digits.data(), a.digits.size(), b.digits.data(), b.digits.size());
+    }
+
+    friend bool operator==(const Big_unsigned& a, const Big_unsigned& b) { return a.digits == b.digits; }
+    friend bool operator!=(const Big_unsigned& a, const Big_unsigned& b) { return !(a == b); }
+
+    friend bool operator<(const Big_unsigned& a, const Big_unsigned& b)
+    {
+        if (a.digits.size() != b.digits.size())
+            return a.digits.size() < b.digits.size();
+        return std::lexicographical_compare(a.digits.rbegin(), a.digits.rend(), b.digits.rbegin(), b.digits.rend());
+    }
+
+    std::string to_string() const
+    {
+        if (this->digits.empty())
+            return "0";
+        // the remainders of the divisions by 10^9, 9 decimal digits each, the lowest first
+        std::vector<std::uint32_t> rest = this->digits;
+        std::vector<std::uint32_t> parts;
+        while (!rest.empty())
+        {
+            std::uint64_t remainder {0};
+            for (std::size_t i = rest.size(); i-- > 0;)
+            {
+                const std::uint64_t t = remainder << 32 | rest[i];
+                rest[i] = static_cast<std::uint32_t>(t / 1'000'000'000);
+                remainder = t % 1'000'000'000;
+            }
+            parts.push_back(static_cast<std::uint32_t>(remainder));
+            while (!rest.empty() && rest.back() == 0)
+                rest.pop_back();
+        }
+
+        std::string s = std::to_string(parts.back());
+        for (std::size_t i = parts.size() - 1; i-- > 0;)
+        {
+            const std::string part = std::to_string(parts[i]);
+            s.append(9 - part.size(), '0').append(part);
+        }
+        return s;
+    }
+};
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef _FIBONACCI_H_
+#define _FIBONACCI_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "Big_unsigned.h"
+
+/*
+
+    - fibonacci(n) is F(n) from a table made at compile time, F(93) is the last one that fits
+      in 64 bits, a bigger n throws std::out_of_range instead of wrapping around, and it is
+      constexpr, fibonacci(50) in a static_assert or an array bound costs nothing at run time.
+
+    - fibonacci_mod(n, m) is F(n) mod m for any n, with fast doubling, F(2k) = F(k) (2 F(k + 1)
+      - F(k)) and F(2k + 1) = F(k)^2 + F(k + 1)^2 from the top bit of n down, O(log n) steps
+      instead of the O(phi^n) calls of the recursion, m = 0 is mod 2^64, what the unsigned
+      adds of the recursion give after they wrap.
+
+    - fibonacci_big(n) is the exact F(n), a Big_unsigned of about 0.694 n bits, with the same
+      doubling, the numbers double in size at every step, so the last products, Karatsuba
+      ones, take most of the time, F(1'000'000) in about a tenth of a second.
+
+    - the batch versions take many n at once: a gather from the table, fast doubling for
+      each one mod m, and for the exact ones every distinct n once, in increasing order,
+      starting from the F(k), F(k + 1) of the one before it when it is close, a few adds,
+      instead of from the top.
+
+*/
+inline constexpr unsigned max_fibonacci_u64 = 93;
+
+namespace detail_fibonacci
+{
+    constexpr std::array<std::uint64_t, max_fibonacci_u64 + 1> make_table()
+    {
+        std::array<std::uint64_t, max_fibonacci_u64 + 1> table {};
+        table[1] = 1;
+        for (std::size_t i = 2; i < table.size(); ++i)
+            table[i] = table[i - 1] + table[i - 2];
+        return table;
+    }
+
+    // a + b and a * b mod m, m = 0 is mod 2^64
+    inline std::uint64_t add_mod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+    {
+        if (m == 0)
+            return a + b;
+        return a >= m - b ? a - (m - b) : a + b;
+    }
+
+    inline std::uint64_t mul_mod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+    {
+        if (m == 0)
+            return a * b;
+#if defined(__SIZEOF_INT128__)
+        __extension__ using Uint128 = unsigned __int128;
+        return static_cast<std::uint64_t>(static_cast<Uint128>(a) * b % m);
+#else
+        std::uint64_t product {0};
+        for (a %= m; b != 0; b >>= 1)
+        {
+            if (b & 1)
+                product = add_mod(product, a, m);
+            a = add_mod(a, a, m);
+        }
+        return product;
+#endif
+    }
+
+    // F(n) and F(n + 1) mod m
+    inline std::array<std::uint64_t, 2> doubling_mod(std::uint64_t n, std::uint64_t m)
+    {
+        std::uint64_t a {0};
+        std::uint64_t b {m == 1 ? 0u : 1u};
+        for (int bit = 63; bit >= 0; --bit)
+        {
+            // 2 F(k + 1) - F(k), with m - a for -a
+            const std::uint64_t twice_b_minus_a = add_mod(add_mod(b, b, m), m == 0 ? 0 - a : (a == 0 ? 0 : m - a), m);
+            const std::uint64_t c = mul_mod(a, twice_b_minus_a, m);
+            const std::uint64_t d = add_mod(mul_mod(a, a, m), mul_mod(b, b, m), m);
+            if ((n >> bit) & 1)
+            {
+                a = d;
+                b = add_mod(c, d, m);
+            }
+            else
+            {
+                a = c;
+                b = d;
+            }
+        }
+        return {a, b};
+    }
+
+    // F(n) and F(n + 1) to a and b, from the top bit of n
+    inline void doubling(std::uint64_t n, Big_unsigned& a, Big_unsigned& b)
+    {
+        a = 0;
+        b = 1;
+        int bit = 63;
+        while (bit > 0 && (n >> bit) == 0)
+            --bit;
+        for (; bit >= 0; --bit)
+        {
+            const Big_unsigned c = a * (b + b - a);
+            Big_unsigned d = a * a + b * b;
+            if ((n >> bit) & 1)
+            {
+                a = d;
+                b = c + d;
+            }
+            else
+            {
+                a = c;
+                b = std::move(d);
+            }
+        }
+    }
+}
+
+inline constexpr std::array<std::uint64_t, max_fibonacci_u64 + 1> fibonacci_table = detail_fibonacci::make_table();
+
+constexpr std::uint64_t fibonacci(unsigned n)
+{
+    if (n > max_fibonacci_u64)
+        throw std::out_of_range {"fibonacci of more than 93 does not fit in 64 bits"};
+    return fibonacci_table[n];
+}
+
+inline std::uint64_t fibonacci_mod(std::uint64_t n, std::uint64_t m)
+{
+    if (n <= max_fibonacci_u64)
+        return m == 0 ? fibonacci_table[n] : fibonacci_table[n] % m;
+    return detail_fibonacci::doubling_mod(n, m)[0];
+}
+
+inline Big_unsigned fibonacci_big(std::uint64_t n)
+{
+    if (n <= max_fibonacci_u64)
+        return fibonacci_table[n];
+    Big_unsigned a;
+    Big_unsigned b;
+    detail_fibonacci::doubling(n, a, b);
+    return a;
+}
+
+// out[i] = fibonacci(ns[i]), std::out_of_range before any of them is written when one is more than 93
+inline void fibonacci(const unsigned* ns, std::size_t count, std::uint64_t* out)
+{
+    if (std::any_of(ns, ns + count, [](unsigned n) { return n > max_fibonacci_u64; }))
+        throw std::out_of_range {"fibonacci of more than 93 does not fit in 64 bits"};
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = fibonacci_table[ns[i]];
+}
+
+inline std::vector<std::uint64_t> fibonacci(const std::vector<unsigned>& ns)
+{
+    std::vector<std::uint64_t> out(ns.size());
+    fibonacci(ns.data(), ns.size(), out.data());
+    return out;
+}
+
+inline std::vector<std::uint64_t> fibonacci_mod(const std::vector<std::uint64_t>& ns, std::uint64_t m)
+{
+    std::vector<std::uint64_t> out(ns.size());
+    for (std::size_t i = 0; i < ns.size(); ++i)
+        out[i] = fibonacci_mod(ns[i], m);
+    return out;
+}
+
+inline std::vector<Big_unsigned> fibonacci_big(const std::vector<std::uint64_t>& ns)
+{
+    // the distinct n in increasing order, each one from the one before it
+    std::vector<std::size_t> order(ns.size());
+    std::iota(order.begin(), order.end(), std::size_t {0});
+    std::sort(order.begin(), order.end(), [&ns](std::size_t i, std::size_t j) { return ns[i] < ns[j]; });
+
+    std::vector<Big_unsigned> out(ns.size());
+    std::uint64_t k {0};
+    Big_unsigned a {0};
+    Big_unsigned b {1};
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const std::uint64_t n = ns[order[i]];
+        if (i > 0 && n == ns[order[i - 1]])
+        {
+            out[order[i]] = out[order[i - 1]];
+            continue;
+        }
+        // a few steps forward are a few adds, a long way is a doubling from the top
+        if (n - k <= 64)
+        {
+            for (; k < n; ++k)
+            {
+                a += b;
+                std::swap(a, b);
+            }
+        }
+        else
+        {
+            detail_fibonacci::doubling(n, a, b);
+            k = n;
+        }
+        out[order[i]] = a;
+    }
+    return out;
+}
+
+#endif
@@ -5,20 +5,40 @@
   F1 = 1
   Fn = (Fn − 1) + (Fn − 2)
 
+  the recursion below calls itself about phi^n times, and wraps around past F93,
+  Fibonacci.h has the same numbers from a table, by fast doubling and exact ones of any size
+
 */
 
+#include <cstdint>
 #include <iostream>
+#include <vector>
+#include "Fibonacci.h"
 
-unsigned long long int fibonacci(unsigned long long int n)
+unsigned long long int fibonacci_recursive(unsigned long long int n)
 {
   if (n <= 1)
     return n;
-  return fibonacci(n - 1) + fibonacci(n - 2);
+  return fibonacci_recursive(n - 1) + fibonacci_recursive(n - 2);
 }
 
 int main()
 {
-  std::cout << fibonacci(10) << std::endl;
+  std::cout << fibonacci_recursive(10) << std::endl;
+
+  // from the table made at compile time
+  static_assert(fibonacci(10) == 55);
+  std::cout << fibonacci(93) << std::endl;
+
+  // the last 9 digits of F(10^18), and the exact F(200)
+  std::cout << fibonacci_mod(1'000'000'000'000'000'000, 1'000'000'000) << std::endl;
+  std::cout << fibonacci_big(200) << std::endl;
+
+  // many at once
+  const std::vector<unsigned> ns {1, 2, 3, 5, 8, 13, 21};
+  for (std::uint64_t f : fibonacci(ns))
+    std::cout << f << " ";
+  std::cout << std::endl;
 
   return 0;
 }
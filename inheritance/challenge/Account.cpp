@@ -1,10 +1,10 @@
 #include "Account.h"
 
-Account::Account(const std::string name, const double balance)
+Account::Account(const std::string name, const Money balance)
   : name(name), balance(balance)
 {}
 
-bool Account::deposit(const double amount)
+bool Account::deposit(const Money amount)
 {
   if (amount >= 0) {
     this->balance += amount;
@@ -14,7 +14,7 @@ bool Account::deposit(const double amount)
     return false;
 }
 
-bool Account::withdraw(const double amount)
+bool Account::withdraw(const Money amount)
 {
   if (this->balance - amount >= 0) {
     this->balance -= amount;
@@ -24,7 +24,7 @@ bool Account::withdraw(const double amount)
     return false;
 }
 
-double Account::get_balance() const
+Money Account::get_balance() const
 {
   return this->balance;
 }
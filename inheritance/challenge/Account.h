@@ -2,6 +2,7 @@
 #define _ACCOUNT_H_
 
 #include <iostream>
+#include "Money.h"
 
 class Account
 {
@@ -9,18 +10,18 @@ class Account
 
 private:
   static constexpr const char *def_name = "Unnamed Account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
 
 protected:
   std::string name;
-  double balance;
+  Money balance;
 
 public:
-  Account(const std::string name = def_name, const double balance = def_balance);
+  Account(const std::string name = def_name, const Money balance = def_balance);
 
-  bool deposit(const double amount);
-  bool withdraw(const double amount);
-  double get_balance() const;
+  bool deposit(const Money amount);
+  bool withdraw(const Money amount);
+  Money get_balance() const;
 };
 
 #endif
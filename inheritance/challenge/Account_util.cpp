@@ -6,7 +6,7 @@ void display(const std::vector<Account> &accounts)
     std::cout << account << std::endl;
 }
 
-void deposit(std::vector<Account> &accounts, double amount)
+void deposit(std::vector<Account> &accounts, Money amount)
 {
   for (auto &account: accounts)
     if (account.deposit(amount))
@@ -15,7 +15,7 @@ void deposit(std::vector<Account> &accounts, double amount)
       std::cout << "Failed deposit of " << amount << " to " << account << std::endl;
 }
 
-void withdraw(std::vector<Account> &accounts, double amount)
+void withdraw(std::vector<Account> &accounts, Money amount)
 {
   for (auto &account: accounts)
     if (account.withdraw(amount))
@@ -30,7 +30,7 @@ void display(const std::vector<Saving_account> &saving_accounts)
     std::cout << saving_account << std::endl;
 }
 
-void deposit(std::vector<Saving_account> &saving_accounts, double amount)
+void deposit(std::vector<Saving_account> &saving_accounts, Money amount)
 {
   for (auto &saving_account: saving_accounts)
     if (saving_account.deposit(amount))
@@ -39,7 +39,7 @@ void deposit(std::vector<Saving_account> &saving_accounts, double amount)
       std::cout << "Failed deposit of " << amount << " to " << saving_account << std::endl;
 }
 
-void withdraw(std::vector<Saving_account> &saving_accounts, double amount)
+void withdraw(std::vector<Saving_account> &saving_accounts, Money amount)
 {
   for (auto &saving_account: saving_accounts)
     if (saving_account.withdraw(amount))
@@ -54,7 +54,7 @@ void display(const std::vector<Checking_account> &checking_accounts)
     std::cout << checking_account << std::endl;
 }
 
-void deposit(std::vector<Checking_account> &checking_accounts, double amount)
+void deposit(std::vector<Checking_account> &checking_accounts, Money amount)
 {
   for (auto &checking_account: checking_accounts)
     if (checking_account.deposit(amount))
@@ -63,7 +63,7 @@ void deposit(std::vector<Checking_account> &checking_accounts, double amount)
       std::cout << "Failed deposit of " << amount << " to " << checking_account << std::endl;
 }
 
-void withdraw(std::vector<Checking_account> &checking_accounts, double amount)
+void withdraw(std::vector<Checking_account> &checking_accounts, Money amount)
 {
   for (auto &checking_account: checking_accounts)
     if (checking_account.withdraw(amount))
@@ -78,7 +78,7 @@ void display(const std::vector<Trust_account> &trust_accounts)
     std::cout << trust_account << std::endl;
 }
 
-void deposit(std::vector<Trust_account> &trust_accounts, double amount)
+void deposit(std::vector<Trust_account> &trust_accounts, Money amount)
 {
   for (auto &trust_account: trust_accounts)
     if (trust_account.deposit(amount))
@@ -87,7 +87,7 @@ void deposit(std::vector<Trust_account> &trust_accounts, double amount)
       std::cout << "Failed deposit of " << amount << " to " << trust_account << std::endl;
 }
 
-void withdraw(std::vector<Trust_account> &trust_accounts, double amount)
+void withdraw(std::vector<Trust_account> &trust_accounts, Money amount)
 {
   for (auto &trust_account: trust_accounts)
     if (trust_account.withdraw(amount))
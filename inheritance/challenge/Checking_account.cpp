@@ -1,10 +1,10 @@
 #include "Checking_account.h"
 
-Checking_account::Checking_account(const std::string name, const double balance)
+Checking_account::Checking_account(const std::string name, const Money balance)
   : Account(name, balance)
 {}
 
-bool Checking_account::withdraw(double amount)
+bool Checking_account::withdraw(Money amount)
 {
   amount += this->fee_withdraw;
   return Account::withdraw(amount);
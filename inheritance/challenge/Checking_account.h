@@ -9,13 +9,13 @@ class Checking_account: public Account
 
 private:
   static constexpr const char *def_name = "Unnamed checking account";
-  static constexpr double def_balance = 0.0;
-  static constexpr double fee_withdraw = 1.50;
+  static constexpr Money def_balance = 0.0;
+  static constexpr Money fee_withdraw = 1.50;
 
 public:
-  Checking_account(const std::string name = def_name, const double balance = def_balance);
+  Checking_account(const std::string name = def_name, const Money balance = def_balance);
 
-  bool withdraw(double amount);
+  bool withdraw(Money amount);
 };
 
 #endif
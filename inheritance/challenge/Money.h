@@ -0,0 +1,149 @@
+#ifndef _MONEY_H_
+#define _MONEY_H_
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+/*
+
+  - Money stores an amount as a whole number of cents in a 64-bit integer,
+    so adding and subtracting never rounds.
+
+  - it converts implicitly from double (in dollars, rounded to the nearest cent)
+    so call sites like deposit(1000) keep working.
+
+  - + and - throw std::overflow_error instead of wrapping around, a double of more cents
+    than an int64 has, or a NaN, throws it too.
+
+*/
+class Money
+{
+  friend std::ostream &operator<<(std::ostream &os, const Money &money);
+
+private:
+  std::int64_t cents;
+
+  static constexpr std::int64_t max_cents = std::numeric_limits<std::int64_t>::max();
+  static constexpr std::int64_t min_cents = std::numeric_limits<std::int64_t>::min();
+
+  // the cast of a double out of the range is undefined, false for a NaN too
+  static constexpr std::int64_t round(double value)
+  {
+    const double rounded = value >= 0 ? value + 0.5 : value - 0.5;
+    if (!(rounded < 0x1p63 && rounded > -0x1p63))
+      throw std::overflow_error("Money overflow.");
+    return static_cast<std::int64_t>(rounded);
+  }
+
+public:
+  // longest formatted value: "-92233720368547758.08"
+  static constexpr int max_chars = 21;
+
+  constexpr Money()
+    : cents{0}
+  {}
+
+  constexpr Money(double amount)
+    : cents{round(amount * 100)}
+  {}
+
+  static constexpr Money from_cents(std::int64_t cents)
+  {
+    Money money;
+    money.cents = cents;
+    return money;
+  }
+
+  constexpr std::int64_t get_cents() const
+  {
+    return this->cents;
+  }
+
+  constexpr double to_double() const
+  {
+    return static_cast<double>(this->cents) / 100;
+  }
+
+  constexpr Money operator+(const Money &rhs) const
+  {
+    if ((rhs.cents > 0 && this->cents > max_cents - rhs.cents) 
+      || (rhs.cents < 0 && this->cents < min_cents - rhs.cents))
+      throw std::overflow_error("Money overflow.");
+    return from_cents(this->cents + rhs.cents);
+  }
+
+  constexpr Money operator-(const Money &rhs) const
+  {
+    if ((rhs.cents < 0 && this->cents > max_cents + rhs.cents) 
+      || (rhs.cents > 0 && this->cents < min_cents + rhs.cents))
+      throw std::overflow_error("Money overflow.");
+    return from_cents(this->cents - rhs.cents);
+  }
+
+  // scaling (interest, percentages) rounds to the nearest cent
+  constexpr Money operator*(double factor) const
+  {
+    return from_cents(round(static_cast<double>(this->cents) * factor));
+  }
+
+  constexpr Money &operator+=(const Money &rhs)
+  {
+    return *this = *this + rhs;
+  }
+
+  constexpr Money &operator-=(const Money &rhs)
+  {
+    return *this = *this - rhs;
+  }
+
+  constexpr bool operator==(const Money &rhs) const { return this->cents == rhs.cents; }
+  constexpr bool operator!=(const Money &rhs) const { return this->cents != rhs.cents; }
+  constexpr bool operator<(const Money &rhs) const { return this->cents < rhs.cents; }
+  constexpr bool operator>(const Money &rhs) const { return this->cents > rhs.cents; }
+  constexpr bool operator<=(const Money &rhs) const { return this->cents <= rhs.cents; }
+  constexpr bool operator>=(const Money &rhs) const { return this->cents >= rhs.cents; }
+
+  /*
+
+    - writes the amount as "[-]dollars.cc" into buff, which needs room for max_chars,
+      and returns a pointer past the last character, no terminator is written.
+
+  */
+  char *format(char *buff) const
+  {
+    // work on the magnitude as unsigned so min_cents does not overflow
+    std::uint64_t value = this->cents < 0 
+      ? ~static_cast<std::uint64_t>(this->cents) + 1 
+      : static_cast<std::uint64_t>(this->cents);
+
+    char digits[max_chars];
+    char *p = digits + max_chars;
+
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+    *--p = '.';
+    do {
+      *--p = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+
+    if (this->cents < 0)
+      *buff++ = '-';
+    while (p != digits + max_chars)
+      *buff++ = *p++;
+    return buff;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Money &money)
+{
+  char buff[Money::max_chars];
+  os.write(buff, money.format(buff) - buff);
+  return os;
+}
+
+#endif
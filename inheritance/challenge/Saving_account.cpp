@@ -1,10 +1,10 @@
 #include "Saving_account.h"
 
-Saving_account::Saving_account(const std::string name, const double balance, const double int_rate)
+Saving_account::Saving_account(const std::string name, const Money balance, const double int_rate)
   : Account(name , balance), int_rate(int_rate)
 {}
 
-bool Saving_account::deposit(double amount)
+bool Saving_account::deposit(Money amount)
 {
   amount += amount * (int_rate / 100);
   return Account::deposit(amount);
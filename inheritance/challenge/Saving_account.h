@@ -11,7 +11,7 @@ class Saving_account: public Account
 
 private:
   static constexpr const char *def_name = "Unnamed savings account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
   static constexpr double def_int_rate = 0.0;
 
 protected:
@@ -19,10 +19,10 @@ protected:
 
 public:
   Saving_account(const std::string name = def_name, 
-    const double balance = def_balance, 
+    const Money balance = def_balance, 
     const double int_rate = def_int_rate);
 
-  bool deposit(double amount);
+  bool deposit(Money amount);
 };
 
 #endif
@@ -1,17 +1,17 @@
 #include "Trust_account.h"
 
-Trust_account::Trust_account(const std::string name, const double balance, const double int_rate)
+Trust_account::Trust_account(const std::string name, const Money balance, const double int_rate)
   : Saving_account(name, balance, int_rate), num_withdrawls(0)
 {}
 
-bool Trust_account::deposit(double amount)
+bool Trust_account::deposit(Money amount)
 {
   if (amount >= this->bonus_threshold)
     amount += this->bonus_amount;
   return Saving_account::deposit(amount);
 }
 
-bool Trust_account::withdraw(double amount)
+bool Trust_account::withdraw(Money amount)
 {
   if (this->num_withdrawls >= this->max_withdrawls || amount > this->balance * this->max_withdraw_percent)
     return false;
@@ -11,10 +11,10 @@ class Trust_account: public Saving_account
 
 private:
   static constexpr const char *def_name = "Unnamed trust account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
   static constexpr double def_int_rate = 0.0;
-  static constexpr double bonus_amount = 50.0;
-  static constexpr double bonus_threshold = 5000.0;
+  static constexpr Money bonus_amount = 50.0;
+  static constexpr Money bonus_threshold = 5000.0;
   static constexpr int max_withdrawls = 3;
   static constexpr double max_withdraw_percent = 0.2;
 
@@ -23,11 +23,11 @@ protected:
 
 public:
   Trust_account(const std::string name = def_name, 
-    const double balance = def_balance, 
+    const Money balance = def_balance, 
     const double int_rate = def_int_rate);
 
-  bool deposit(double amount);
-  bool withdraw(double amount);
+  bool deposit(Money amount);
+  bool withdraw(Money amount);
 };
 
 #endif
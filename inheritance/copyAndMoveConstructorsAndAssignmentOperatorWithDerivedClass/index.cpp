@@ -1,4 +1,5 @@
 #include <iostream>
+#include <utility>
 
 class Base
 {
@@ -22,7 +23,7 @@ public:
     std::cout << "Base copy constructor" << std::endl;
   }
 
-  Base(Base &&source)
+  Base(Base &&source) noexcept
     : num{source.num}
   {
     std::cout << "Base move constructor" << std::endl;
@@ -40,7 +41,7 @@ public:
     return *this;
   }
 
-  Base &operator=(Base &&rhs)
+  Base &operator=(Base &&rhs) noexcept
   {
     std::cout << "Base move assignment operator" << std::endl;
 
@@ -81,10 +82,11 @@ public:
     std::cout << "Derived copy constructor" << std::endl;
   }
 
-  Derived(Derived &&source)
-    : Base{source}, double_value{source.double_value}
+  // the Base part is moved too, Base{source} would copy it, source has a name, it is an l-value
+  Derived(Derived &&source) noexcept
+    : Base{std::move(source)}, double_value{source.double_value}
   {
-    std::cout << "Derived copy constructor" << std::endl;
+    std::cout << "Derived move constructor" << std::endl;
     source.double_value = 0;
   }
 
@@ -100,7 +102,7 @@ public:
     return *this;
   }
 
-  Derived &operator=(Derived &&rhs)
+  Derived &operator=(Derived &&rhs) noexcept
   {
     std::cout << "Derived move assignment operator" << std::endl;
 
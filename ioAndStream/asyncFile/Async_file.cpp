@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../challenge4/Line_numberer.h"
+#include "Async_file.h"
+
+namespace
+{
+    constexpr std::size_t page_size = 4096;
+
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    // closes the descriptor when the task returns or throws
+    class File
+    {
+    private:
+        int fd;
+
+    public:
+        File(const std::string &path, int flags)
+            : fd{::open(path.c_str(), flags, 0644)}
+        {
+            if (this->fd < 0)
+                fail("open " + path);
+        }
+
+        ~File()
+        {
+            ::close(this->fd);
+        }
+
+        File(const File &) = delete;
+        File &operator=(const File &) = delete;
+
+        int get() const
+        {
+            return this->fd;
+        }
+
+        std::uintmax_t get_size(const std::string &path) const
+        {
+            struct stat st;
+            if (::fstat(this->fd, &st) < 0)
+                fail("stat " + path);
+            return static_cast<std::uintmax_t>(st.st_size);
+        }
+    };
+
+    // page aligned, the blocks are on page boundaries like the ones of the page cache
+    struct Aligned_delete
+    {
+        void operator()(char *buff) const
+        {
+            ::operator delete(buff, std::align_val_t{page_size});
+        }
+    };
+
+    using Buffer = std::unique_ptr<char, Aligned_delete>;
+
+    Buffer make_buffer(std::size_t size)
+    {
+        return Buffer{static_cast<char *>(::operator new(size, std::align_val_t{page_size}))};
+    }
+
+    // reads size bytes at offset, less only at the end of the file
+    Task<std::size_t> read_block(Io_context &io, Io_context::Operation &operation, int fd, char *buff,
+        std::size_t size, std::uint64_t offset)
+    {
+        std::size_t got = co_await operation;
+        while (got < size)
+        {
+            io.read(operation, fd, buff + got, size - got, offset + got);
+            const std::size_t count = co_await operation;
+            if (count == 0)
+                break;
+            got += count;
+        }
+        co_return got;
+    }
+
+    // one of the depth tasks of the copy, the next block nobody took yet is *next
+    Task<void> copy_blocks(Io_context &io, int in, int out, std::uintmax_t size, std::size_t block_size,
+        std::uintmax_t &next, std::uintmax_t &copied)
+    {
+        Buffer buff = make_buffer(block_size);
+        Io_context::Operation operation;
+        while (next < size)
+        {
+            const std::uintmax_t offset = next;
+            next += block_size;
+            const std::size_t want = static_cast<std::size_t>(std::min<std::uintmax_t>(block_size, size - offset));
+
+            io.read(operation, in, buff.get(), want, offset);
+            const std::size_t got = co_await read_block(io, operation, in, buff.get(), want, offset);
+            std::size_t put = 0;
+            while (put < got)
+            {
+                io.write(operation, out, buff.get() + put, got - put, offset + put);
+                put += co_await operation;
+            }
+            copied += got;
+        }
+    }
+
+    // on_block(text) for the blocks of the file in order, the next depth - 1 ones in flight
+    template <typename On_block>
+    Task<void> read_in_order(Io_context &io, int fd, std::uintmax_t size, std::size_t depth, std::size_t block_size,
+        On_block &on_block)
+    {
+        const std::uintmax_t num_blocks = (size + block_size - 1) / block_size;
+        depth = static_cast<std::size_t>(std::max<std::uintmax_t>(1, std::min<std::uintmax_t>(depth, num_blocks)));
+        Buffer buff = make_buffer(depth * block_size);
+        std::vector<Io_context::Operation> operations(depth);
+        const auto start = [&](std::uintmax_t block)
+        {
+            const std::uintmax_t offset = block * block_size;
+            io.read(operations[block % depth], fd, buff.get() + block % depth * block_size,
+                static_cast<std::size_t>(std::min<std::uintmax_t>(block_size, size - offset)), offset);
+        };
+
+        std::exception_ptr error;
+        try
+        {
+            for (std::uintmax_t block = 0; block < std::min<std::uintmax_t>(depth, num_blocks); ++block)
+                start(block);
+            for (std::uintmax_t block = 0; block < num_blocks; ++block)
+            {
+                const std::uintmax_t offset = block * block_size;
+                const std::size_t want = static_cast<std::size_t>(std::min<std::uintmax_t>(block_size, size - offset));
+                char *const data = buff.get() + block % depth * block_size;
+                const std::size_t got = co_await read_block(io, operations[block % depth], fd, data, want, offset);
+                on_block(std::string_view{data, got});
+                // the file got shorter while reading
+                if (got < want)
+                    break;
+                if (block + depth < num_blocks)
+                    start(block + depth);
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        // the kernel writes to the buffer of every read in flight, they end before it goes
+        for (Io_context::Operation &operation : operations)
+            if (operation.busy())
+            {
+                try
+                {
+                    co_await operation;
+                }
+                catch (const std::runtime_error &)
+                {
+                }
+            }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // same characters as operator>> skips, the ones of Word_search.cpp
+    inline bool is_space(char c)
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+}
+
+Task<std::uintmax_t> async_copy_file(Io_context &io, std::string from, std::string to, std::size_t depth,
+    std::size_t block_size)
+{
+    File in {from, O_RDONLY};
+    File out {to, O_RDWR | O_CREAT};
+
+    struct stat st, out_st;
+    if (::fstat(in.get(), &st) < 0)
+        fail("stat " + from);
+    if (::fstat(out.get(), &out_st) < 0)
+        fail("stat " + to);
+    if (st.st_dev == out_st.st_dev && st.st_ino == out_st.st_ino)
+        throw std::runtime_error(from + " and " + to + " are the same file");
+    // the size first, the blocks are written at their offsets in any order
+    if (::ftruncate(out.get(), 0) < 0 || ::ftruncate(out.get(), st.st_size) < 0)
+        fail("ftruncate " + to);
+
+    const std::uintmax_t size = static_cast<std::uintmax_t>(st.st_size);
+    std::uintmax_t next = 0;
+    std::uintmax_t copied = 0;
+    std::vector<Task<void>> copies;
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, depth); ++i)
+        copies.push_back(copy_blocks(io, in.get(), out.get(), size, block_size, next, copied));
+    co_await when_all(std::move(copies));
+    co_return copied;
+}
+
+Task<std::uintmax_t> async_number_lines(Io_context &io, std::string from, std::string to, std::size_t depth,
+    std::size_t block_size)
+{
+    File in {from, O_RDONLY};
+    std::ofstream out {to, std::ios::binary};
+    if (!out)
+        throw std::runtime_error("open " + to + ": " + std::strerror(errno));
+
+    Line_numberer numberer {out};
+    auto on_block = [&numberer](std::string_view text) { numberer.write(text.data(), text.size()); };
+    co_await read_in_order(io, in.get(), in.get_size(from), depth, block_size, on_block);
+    numberer.finish();
+    if (!out)
+        throw std::runtime_error("write " + to + " failed");
+    co_return numberer.get_next_number() - 1;
+}
+
+Task<Search_result> async_search_words(Io_context &io, std::string path, std::string pattern,
+    std::function<void(std::string_view)> on_match, std::size_t depth, std::size_t block_size)
+{
+    File in {path, O_RDONLY};
+    Search_result total {0, 0};
+    std::string cut;  // the start of a word that the end of the blocks before cut
+
+    const auto add = [&](std::string_view text)
+    {
+        const Search_result result = search_words(text, pattern, on_match);
+        total.words += result.words;
+        total.matches += result.matches;
+    };
+    auto on_block = [&](std::string_view text)
+    {
+        const auto first = std::find_if(text.begin(), text.end(), is_space);
+        if (first == text.end())
+        {
+            cut.append(text);
+            return;
+        }
+        const std::size_t begin = static_cast<std::size_t>(first - text.begin());
+        const std::size_t end = static_cast<std::size_t>(std::find_if(text.rbegin(), text.rend(), is_space).base() - text.begin());
+
+        // the word across the boundary, then the whole words of the block, the rest waits
+        cut.append(text.substr(0, begin));
+        add(cut);
+        add(text.substr(begin, end - begin));
+        cut.assign(text.substr(end));
+    };
+    co_await read_in_order(io, in.get(), in.get_size(path), depth, block_size, on_block);
+    add(cut);
+    co_return total;
+}
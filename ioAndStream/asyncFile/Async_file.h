@@ -0,0 +1,46 @@
+#ifndef _ASYNC_FILE_H_
+#define _ASYNC_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "../challenge3/Word_search.h"
+#include "Io_context.h"
+#include "Task.h"
+
+/*
+
+    - the programs of copyingFile2, challenge4 and challenge3 as tasks of an Io_context,
+      with depth reads of block_size bytes in flight at once, instead of one blocking read
+      after the other, a drive that is only fast at a queue depth of 32 and more gets there.
+
+    - async_copy_file runs depth tasks with when_all, each one reads a block of from and
+      writes it to to, and takes the next block that nobody took yet, the blocks are copied
+      in any order, every one at its offset.
+
+    - async_number_lines and async_search_words read the file in order, the next depth
+      blocks are in flight while one is numbered or searched, a block is read again only
+      after it was used. the numbering is the Line_numberer of challenge4, in pieces of any
+      size already, and the search is search_words of challenge3, the word cut by the end of
+      a block is searched with the start of the next one, the counts are the ones of the
+      whole file.
+
+    - the files are regular files, the size is the one of fstat when they start. the
+      arguments are by value, a task is lazy and they live in it. errors throw
+      std::runtime_error.
+
+*/
+Task<std::uintmax_t> async_copy_file(Io_context &io, std::string from, std::string to,
+    std::size_t depth = 32, std::size_t block_size = 1 << 18);
+
+// the number of lines that got a number
+Task<std::uintmax_t> async_number_lines(Io_context &io, std::string from, std::string to,
+    std::size_t depth = 32, std::size_t block_size = 1 << 18);
+
+// on_match, when given, is called with every matching word in order
+Task<Search_result> async_search_words(Io_context &io, std::string path, std::string pattern,
+    std::function<void(std::string_view)> on_match = {}, std::size_t depth = 32, std::size_t block_size = 1 << 18);
+
+#endif
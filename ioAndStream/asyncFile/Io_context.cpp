@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#include "Io_context.h"
+
+namespace
+{
+    constexpr std::size_t max_threads = 32;
+
+    std::runtime_error io_error(const std::string &what, int error)
+    {
+        return std::runtime_error(what + ": " + std::strerror(error));
+    }
+}
+
+std::size_t Io_context::Operation::await_resume() const
+{
+    if (this->result < 0)
+        throw io_error(this->is_write ? "write" : "read", static_cast<int>(-this->result));
+    return static_cast<std::size_t>(this->result);
+}
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+
+// the rings the kernel shares with the process, the heads and tails are written by one side each
+struct Io_context::Uring
+{
+    int fd {-1};
+    unsigned entries {0};
+    void *sq_ring {MAP_FAILED};
+    void *cq_ring {MAP_FAILED};
+    std::size_t sq_ring_size {0};
+    std::size_t cq_ring_size {0};
+    io_uring_sqe *sqes {static_cast<io_uring_sqe *>(MAP_FAILED)};
+    std::size_t sqes_size {0};
+
+    unsigned *sq_tail {nullptr};
+    unsigned *sq_mask {nullptr};
+    unsigned *sq_array {nullptr};
+    unsigned *cq_head {nullptr};
+    unsigned *cq_tail {nullptr};
+    unsigned *cq_mask {nullptr};
+    io_uring_cqe *cqes {nullptr};
+    unsigned to_submit {0};
+
+    // false when the kernel has no io_uring for the process, nothing is left open then
+    bool setup(unsigned depth)
+    {
+        io_uring_params params {};
+        this->fd = static_cast<int>(::syscall(__NR_io_uring_setup, depth, &params));
+        if (this->fd < 0)
+            return false;
+        this->entries = params.sq_entries;
+
+        this->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        this->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap)
+            this->sq_ring_size = this->cq_ring_size = std::max(this->sq_ring_size, this->cq_ring_size);
+
+        this->sq_ring = ::mmap(nullptr, this->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               this->fd, IORING_OFF_SQ_RING);
+        if (this->sq_ring == MAP_FAILED)
+            return false;
+        this->cq_ring = single_mmap ? this->sq_ring
+            : ::mmap(nullptr, this->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_CQ_RING);
+        if (this->cq_ring == MAP_FAILED)
+            return false;
+        this->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        this->sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, this->sqes_size, PROT_READ | PROT_WRITE,
+                                                         MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_SQES));
+        if (this->sqes == MAP_FAILED)
+            return false;
+
+        char *sq = static_cast<char *>(this->sq_ring);
+        char *cq = static_cast<char *>(this->cq_ring);
+        this->sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        this->sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        this->sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        this->cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        this->cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        this->cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        this->cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    ~Uring()
+    {
+        if (this->sqes != MAP_FAILED)
+            ::munmap(this->sqes, this->sqes_size);
+        if (this->cq_ring != MAP_FAILED && this->cq_ring != this->sq_ring)
+            ::munmap(this->cq_ring, this->cq_ring_size);
+        if (this->sq_ring != MAP_FAILED)
+            ::munmap(this->sq_ring, this->sq_ring_size);
+        if (this->fd >= 0)
+            ::close(this->fd);
+    }
+
+    // the kernel reads the entry after the tail is stored, the process is the only writer
+    void push(Operation &operation, std::uint8_t opcode, int fd, const iovec *buffer, std::uint64_t offset)
+    {
+        const unsigned tail = *this->sq_tail;
+        const unsigned index = tail & *this->sq_mask;
+        io_uring_sqe &sqe = this->sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+        sqe.len = 1;
+        sqe.off = offset;
+        sqe.user_data = reinterpret_cast<std::uint64_t>(&operation);
+        this->sq_array[index] = index;
+        std::atomic_ref<unsigned>(*this->sq_tail).store(tail + 1, std::memory_order_release);
+        ++this->to_submit;
+    }
+
+    // submits the new entries and waits for min_complete completions
+    void enter(unsigned min_complete)
+    {
+        while (true)
+        {
+            const long submitted = ::syscall(__NR_io_uring_enter, this->fd, this->to_submit, min_complete,
+                                             min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (submitted >= 0)
+            {
+                this->to_submit -= static_cast<unsigned>(submitted);
+                if (this->to_submit == 0 || min_complete > 0)
+                    return;
+                continue;
+            }
+            if (errno == EINTR)
+                continue;
+            throw io_error("io_uring_enter", errno);
+        }
+    }
+};
+
+#else
+
+struct Io_context::Uring
+{
+    unsigned entries {0};
+    unsigned to_submit {0};
+
+    bool setup(unsigned) { return false; }
+    void push(Operation &, std::uint8_t, int, const iovec *, std::uint64_t) {}
+    void enter(unsigned) {}
+};
+
+#endif
+
+// the preads and pwrites of the operations on threads, the completions go back to the context
+struct Io_context::Threads
+{
+    std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable done;
+    std::deque<Operation *> queued;
+    std::vector<std::pair<Operation *, std::int64_t>> completed;
+    std::vector<std::thread> threads;
+    bool stopping {false};
+
+    explicit Threads(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            this->threads.emplace_back([this] { this->worker(); });
+    }
+
+    ~Threads()
+    {
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            this->stopping = true;
+        }
+        this->work.notify_all();
+        for (std::thread &thread : this->threads)
+            thread.join();
+    }
+
+    void push(Operation &operation)
+    {
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            this->queued.push_back(&operation);
+        }
+        this->work.notify_one();
+    }
+
+    void worker()
+    {
+        std::unique_lock<std::mutex> lock {this->mutex};
+        while (true)
+        {
+            this->work.wait(lock, [this] { return this->stopping || !this->queued.empty(); });
+            if (this->queued.empty())
+                return;
+            Operation *operation = this->queued.front();
+            this->queued.pop_front();
+            lock.unlock();
+
+            // the fields are not written while the operation is in flight
+            ssize_t result;
+            do
+                result = operation->is_write
+                    ? ::pwrite(operation->fd, operation->buffer.iov_base, operation->buffer.iov_len, static_cast<off_t>(operation->offset))
+                    : ::pread(operation->fd, operation->buffer.iov_base, operation->buffer.iov_len, static_cast<off_t>(operation->offset));
+            while (result < 0 && errno == EINTR);
+
+            lock.lock();
+            this->completed.emplace_back(operation, result < 0 ? -static_cast<std::int64_t>(errno) : result);
+            this->done.notify_one();
+        }
+    }
+};
+
+Io_context::Io_context(std::size_t queue_depth, Backend backend)
+    : uring(std::make_unique<Uring>()), queue_depth(queue_depth == 0 ? 1 : queue_depth)
+{
+    if (backend == Backend::io_uring && this->uring->setup(static_cast<unsigned>(this->queue_depth)))
+    {
+        // the kernel rounds the entries up to a power of 2, the completion ring is twice that
+        this->queue_depth = this->uring->entries;
+        return;
+    }
+    this->uring.reset();
+    this->threads = std::make_unique<Threads>(std::min(this->queue_depth, max_threads));
+}
+
+Io_context::~Io_context()
+{
+    // the kernel or a thread may still write to a buffer of an operation in flight
+    this->waiting.clear();
+    while (this->in_flight > 0)
+        this->poll(true, false);
+}
+
+Io_context::Backend Io_context::get_backend() const
+{
+    return this->uring ? Backend::io_uring : Backend::threads;
+}
+
+std::size_t Io_context::get_queue_depth() const
+{
+    return this->queue_depth;
+}
+
+void Io_context::read(Operation &operation, int fd, void *buffer, std::size_t size, std::uint64_t offset)
+{
+    operation.is_write = false;
+    operation.fd = fd;
+    operation.buffer = iovec {buffer, size};
+    operation.offset = offset;
+    this->start(operation);
+}
+
+void Io_context::write(Operation &operation, int fd, const void *buffer, std::size_t size, std::uint64_t offset)
+{
+    operation.is_write = true;
+    operation.fd = fd;
+    operation.buffer = iovec {const_cast<void *>(buffer), size};
+    operation.offset = offset;
+    this->start(operation);
+}
+
+void Io_context::start(Operation &operation)
+{
+    if (operation.in_flight)
+        throw std::logic_error("the operation is still in flight");
+    operation.in_flight = true;
+    operation.result = 0;
+    operation.waiting = nullptr;
+    if (this->in_flight < this->queue_depth)
+        this->submit(operation);
+    else
+        this->waiting.push_back(&operation);
+}
+
+void Io_context::submit(Operation &operation)
+{
+    ++this->in_flight;
+    if (this->uring)
+    {
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+        this->uring->push(operation, operation.is_write ? IORING_OP_WRITEV : IORING_OP_READV,
+                          operation.fd, &operation.buffer, operation.offset);
+#endif
+    }
+    else
+        this->threads->push(operation);
+}
+
+void Io_context::complete(Operation &operation, std::int64_t result, bool resume)
+{
+    --this->in_flight;
+    operation.result = result;
+    operation.in_flight = false;
+    const std::coroutine_handle<> waiting = std::exchange(operation.waiting, nullptr);
+
+    // the room is for the next one that waits, before the coroutine starts more of them
+    if (!this->waiting.empty())
+    {
+        Operation *next = this->waiting.front();
+        this->waiting.pop_front();
+        this->submit(*next);
+    }
+    if (resume && waiting)
+        waiting.resume();
+}
+
+void Io_context::poll(bool wait, bool resume)
+{
+    if (this->uring)
+    {
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+        Uring &ring = *this->uring;
+        unsigned head = *ring.cq_head;
+        bool waited = !wait;
+        while (true)
+        {
+            const unsigned tail = std::atomic_ref<unsigned>(*ring.cq_tail).load(std::memory_order_acquire);
+            if (head == tail)
+            {
+                if (waited && ring.to_submit == 0)
+                    return;
+                ring.enter(waited ? 0 : 1);
+                waited = true;
+                continue;
+            }
+            const io_uring_cqe &cqe = ring.cqes[head & *ring.cq_mask];
+            Operation &operation = *reinterpret_cast<Operation *>(cqe.user_data);
+            const std::int64_t result = cqe.res;
+            // the entry is free for the kernel before the coroutine runs and starts more
+            std::atomic_ref<unsigned>(*ring.cq_head).store(++head, std::memory_order_release);
+            this->complete(operation, result, resume);
+            waited = true;
+        }
+#endif
+    }
+
+    std::vector<std::pair<Operation *, std::int64_t>> completed;
+    {
+        std::unique_lock<std::mutex> lock {this->threads->mutex};
+        if (wait)
+            this->threads->done.wait(lock, [this] { return !this->threads->completed.empty(); });
+        completed.swap(this->threads->completed);
+    }
+    for (const auto &[operation, result] : completed)
+        this->complete(*operation, result, resume);
+}
@@ -0,0 +1,119 @@
+#ifndef _IO_CONTEXT_H_
+#define _IO_CONTEXT_H_
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <sys/uio.h>
+#include "Task.h"
+
+/*
+
+    - an Io_context reads and writes files for coroutines: read and write start an
+      Operation at an offset of a file, a coroutine co_awaits it when it needs the bytes, the
+      number of bytes read or written comes out, or a std::runtime_error with the errno text.
+      a coroutine can start many of them before it waits for the first one, the reads of a
+      file are then in flight together, the queue depth that an NVMe drive needs.
+
+    - on Linux the operations go to io_uring, without liburing: the context maps the rings of
+      the kernel, an operation is an entry of the submission ring and the entries are handed
+      to the kernel all at once when the thread waits, one system call for a batch of them.
+
+    - where io_uring can not be set up, an old kernel or a seccomp filter that forbids it, and
+      with Backend::threads, a queue of threads does the preads and pwrites, as many of them
+      as queue_depth, up to 32, the same operations in flight with blocking calls.
+
+    - run(task) starts the task and waits for the operations, and resumes the coroutines
+      that wait for them, on the thread that calls run, until the task is done, and returns
+      what it returned. a coroutine that waits for something else than an operation of the
+      context is an error, run throws std::logic_error then instead of waiting forever.
+
+    - at most queue_depth operations are in flight, the ones started after them wait in the
+      context for the next one that completes. an Operation can be started again when it
+      completed, and must not be moved or destroyed while it is in flight.
+
+*/
+class Io_context
+{
+public:
+    enum class Backend
+    {
+        io_uring,
+        threads
+    };
+
+    class Operation
+    {
+        friend class Io_context;
+
+    private:
+        int fd {-1};
+        bool is_write {false};
+        bool in_flight {false};
+        iovec buffer {};
+        std::uint64_t offset {0};
+        std::int64_t result {0};
+        std::coroutine_handle<> waiting;
+
+    public:
+        Operation() = default;
+        Operation(const Operation &) = delete;
+        Operation &operator=(const Operation &) = delete;
+
+        bool busy() const noexcept { return this->in_flight; }
+
+        bool await_ready() const noexcept { return !this->in_flight; }
+        void await_suspend(std::coroutine_handle<> handle) noexcept { this->waiting = handle; }
+        std::size_t await_resume() const;
+    };
+
+    explicit Io_context(std::size_t queue_depth = 64, Backend backend = Backend::io_uring);
+    ~Io_context();
+
+    Io_context(const Io_context &) = delete;
+    Io_context &operator=(const Io_context &) = delete;
+
+    Backend get_backend() const;
+    std::size_t get_queue_depth() const;
+
+    void read(Operation &operation, int fd, void *buffer, std::size_t size, std::uint64_t offset);
+    void write(Operation &operation, int fd, const void *buffer, std::size_t size, std::uint64_t offset);
+
+    template <typename T>
+    T run(Task<T> task);
+
+private:
+    struct Uring;
+    struct Threads;
+
+    std::unique_ptr<Uring> uring;
+    std::unique_ptr<Threads> threads;
+    std::size_t queue_depth;
+    std::size_t in_flight {0};
+    std::deque<Operation *> waiting;  // started when the queue is full, submitted later
+
+    void start(Operation &operation);
+    void submit(Operation &operation);
+    void complete(Operation &operation, std::int64_t result, bool resume);
+
+    // completes the operations that are done, waits for one first when wait is true
+    void poll(bool wait, bool resume = true);
+};
+
+template <typename T>
+T Io_context::run(Task<T> task)
+{
+    task.start();
+    while (!task.done())
+    {
+        if (this->in_flight == 0 && this->waiting.empty())
+            throw std::logic_error("the task waits for nothing the Io_context does");
+        this->poll(true);
+    }
+    return task.result();
+}
+
+#endif
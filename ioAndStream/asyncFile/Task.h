@@ -0,0 +1,278 @@
+#ifndef _TASK_H_
+#define _TASK_H_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/*
+
+    - Task<T> is a coroutine that returns a T, it starts when it is co_awaited and the
+      coroutine that awaits it goes on when it returns, the handle of the one is given to
+      the other, symmetric transfer, a chain of tasks does not grow the stack. an exception
+      the task throws comes out of its co_await.
+
+    - when_all(tasks) starts all of the tasks, one after the other until each one waits for
+      something, and goes on when the last one is done, so they all wait at the same time,
+      e.g. for their reads. the first exception one of them threw is thrown after all of
+      them ended.
+
+    - Io_context::run(task) runs a task from a function that is not a coroutine, main, and
+      resumes the tasks when their reads and writes are done, see Io_context.h.
+
+    - a task is lazy, the arguments it takes by reference have to live until it ends, the
+      ones of the functions of Async_file.h are by value.
+
+*/
+template <typename T = void>
+class Task;
+
+namespace detail_task
+{
+    // the coroutine that waits for the task goes on, or nothing when none waits
+    struct Final_awaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+        {
+            return handle.promise().continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct Promise_base
+    {
+        std::coroutine_handle<> continuation {std::noop_coroutine()};
+        std::exception_ptr error;
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        Final_awaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() noexcept { this->error = std::current_exception(); }
+
+        void rethrow() const
+        {
+            if (this->error)
+                std::rethrow_exception(this->error);
+        }
+    };
+
+    template <typename T>
+    struct Promise : Promise_base
+    {
+        std::optional<T> value;
+
+        Task<T> get_return_object() noexcept;
+
+        template <typename U>
+        void return_value(U &&value)
+        {
+            this->value.emplace(std::forward<U>(value));
+        }
+
+        T result()
+        {
+            this->rethrow();
+            return std::move(*this->value);
+        }
+    };
+
+    template <>
+    struct Promise<void> : Promise_base
+    {
+        Task<void> get_return_object() noexcept;
+        void return_void() const noexcept {}
+        void result() const { this->rethrow(); }
+    };
+}
+
+template <typename T>
+class Task
+{
+public:
+    using promise_type = detail_task::Promise<T>;
+
+    class Awaiter
+    {
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+    public:
+        explicit Awaiter(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+        {
+            this->handle.promise().continuation = awaiting;
+            return this->handle;
+        }
+
+        T await_resume() const { return this->handle.promise().result(); }
+    };
+
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (this->handle)
+                this->handle.destroy();
+            this->handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task()
+    {
+        if (this->handle)
+            this->handle.destroy();
+    }
+
+    Awaiter operator co_await() const noexcept { return Awaiter {this->handle}; }
+
+    // the task runs until it waits for something, with nobody to go on when it returns
+    void start() const { this->handle.resume(); }
+    bool done() const noexcept { return this->handle.done(); }
+    T result() const { return this->handle.promise().result(); }
+
+private:
+    friend promise_type;
+
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+};
+
+namespace detail_task
+{
+    template <typename T>
+    Task<T> Promise<T>::get_return_object() noexcept
+    {
+        return Task<T> {std::coroutine_handle<Promise<T>>::from_promise(*this)};
+    }
+
+    inline Task<void> Promise<void>::get_return_object() noexcept
+    {
+        return Task<void> {std::coroutine_handle<Promise<void>>::from_promise(*this)};
+    }
+
+    struct When_all_state
+    {
+        std::size_t remaining;
+        std::coroutine_handle<> parent;
+        std::exception_ptr error;
+    };
+
+    // the coroutine that awaits one task of when_all, the last one to end resumes the parent
+    struct Counted
+    {
+        struct promise_type
+        {
+            When_all_state *state;
+
+            promise_type(const Task<void> &, When_all_state &state) : state(&state) {}
+
+            Counted get_return_object() noexcept
+            {
+                return Counted {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            auto final_suspend() const noexcept
+            {
+                struct Count_down
+                {
+                    bool await_ready() const noexcept { return false; }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+                    {
+                        When_all_state &state = *handle.promise().state;
+                        return --state.remaining == 0 ? state.parent : std::noop_coroutine();
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+                return Count_down {};
+            }
+
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    inline Counted counted(const Task<void> &task, When_all_state &state)
+    {
+        try
+        {
+            co_await task;
+        }
+        catch (...)
+        {
+            if (!state.error)
+                state.error = std::current_exception();
+        }
+    }
+
+    class When_all_awaiter
+    {
+    private:
+        const std::vector<Task<void>> &tasks;
+        std::vector<Counted> counters;
+        When_all_state state {};
+
+    public:
+        explicit When_all_awaiter(const std::vector<Task<void>> &tasks) : tasks(tasks) {}
+
+        When_all_awaiter(const When_all_awaiter &) = delete;
+        When_all_awaiter &operator=(const When_all_awaiter &) = delete;
+
+        ~When_all_awaiter()
+        {
+            for (Counted &counter : this->counters)
+                counter.handle.destroy();
+        }
+
+        bool await_ready() const noexcept { return this->tasks.empty(); }
+
+        // one more than the tasks, so a task that ends before the next one started can not
+        // resume the parent while the loop still runs
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent)
+        {
+            this->state.remaining = this->tasks.size() + 1;
+            this->state.parent = parent;
+            this->counters.reserve(this->tasks.size());
+            for (const Task<void> &task : this->tasks)
+            {
+                this->counters.push_back(counted(task, this->state));
+                this->counters.back().handle.resume();
+            }
+            return --this->state.remaining == 0 ? parent : std::noop_coroutine();
+        }
+
+        void await_resume() const
+        {
+            if (this->state.error)
+                std::rethrow_exception(this->state.error);
+        }
+    };
+}
+
+inline Task<void> when_all(std::vector<Task<void>> tasks)
+{
+    co_await detail_task::When_all_awaiter {tasks};
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Async_file.h"
+
+/*
+
+    g++ -std=c++20 -O2 -pthread index.cpp Io_context.cpp Async_file.cpp ../challenge3/Word_search.cpp ../challenge3/Chunked_file.cpp ../challenge4/Line_numberer.cpp ../challenge4/Async_writer.cpp ../compressedStream/Compressed_stream.cpp ../compressedStream/Lz4.cpp
+
+    the copy of copyingFile2, the numbering of challenge4 and the search of challenge3 with
+    depth reads in flight, on io_uring or on the threads of the fallback, see Async_file.h.
+
+    ./a.out [from] [depth] [io_uring|threads]
+
+*/
+
+int main(int argc, char *argv[])
+{
+    const std::string from {argc > 1 ? argv[1] : "../challenge3/romeoAndJuliet.txt"};
+    const std::size_t depth {argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 32};
+    const bool threads {argc > 3 && std::string {argv[3]} == "threads"};
+
+    try
+    {
+        Io_context io {64, threads ? Io_context::Backend::threads : Io_context::Backend::io_uring};
+        std::cout << "backend: " << (io.get_backend() == Io_context::Backend::io_uring ? "io_uring" : "threads")
+                  << ", queue depth " << io.get_queue_depth() << ", " << depth << " reads in flight" << std::endl;
+
+        auto timed = [](const char *what, auto run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto result = run();
+            const std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+            std::cout << what << " in " << took.count() << " ms" << std::endl;
+            return result;
+        };
+
+        const std::uintmax_t copied = timed("copied", [&] { return io.run(async_copy_file(io, from, "test.txt", depth)); });
+        std::cout << copied << " bytes copied to test.txt" << std::endl;
+
+        const std::uintmax_t lines = timed("numbered", [&] { return io.run(async_number_lines(io, from, "numbered.txt", depth)); });
+        std::cout << lines << " lines numbered in numbered.txt" << std::endl;
+
+        const Search_result result = timed("searched", [&] { return io.run(async_search_words(io, from, "Romeo", {}, depth)); });
+        std::cout << result.words << " word were searched..." << std::endl;
+        std::cout << "The substring Romeo was found " << result.matches << " times" << std::endl;
+
+        // a missing file throws from the task, through io.run
+        io.run(async_copy_file(io, "missing.txt", "test.txt", depth));
+    }
+    catch (const std::runtime_error &ex)
+    {
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 0;
+}
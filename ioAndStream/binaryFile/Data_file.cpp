@@ -0,0 +1,349 @@
+#include <cerrno>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Data_file.h"
+
+namespace
+{
+    constexpr char magic[8] = {'i', 'o', 'S', 't', 'r', 'e', 'a', 'm'};
+    constexpr std::uint32_t byte_order = 0x01020304;
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        Data_kind kind;
+        std::uint32_t num_columns;
+        std::uint32_t byte_order;
+        std::uint64_t size;
+    };
+
+    static_assert(sizeof(Header) == 32, "the header is 32 bytes on disk");
+
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    void invalid(const std::string &path, const std::string &why)
+    {
+        throw std::runtime_error(path + ": not a data file, " + why);
+    }
+
+    std::size_t align(std::size_t offset)
+    {
+        return (offset + 7) & ~std::size_t{7};
+    }
+}
+
+Data_writer::Data_writer(Data_kind kind) : kind{kind}
+{
+}
+
+void Data_writer::add_numbers(Column_type type, const void *values, std::size_t count, std::size_t width)
+{
+    this->columns.push_back(Column{type, count, std::string(static_cast<const char *>(values), count * width)});
+}
+
+void Data_writer::add_strings(const std::vector<std::string_view> &strings)
+{
+    std::size_t size = strings.size() * sizeof(std::uint64_t);
+    for (std::string_view string : strings)
+    {
+        if (string.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::runtime_error("a string of a data file is at most 4 GiB");
+        size += sizeof(std::uint32_t) + string.size();
+    }
+
+    std::string bytes(size, '\0');
+    std::uint64_t offset = strings.size() * sizeof(std::uint64_t);
+
+    for (std::size_t i = 0; i < strings.size(); ++i)
+    {
+        const std::uint32_t length = static_cast<std::uint32_t>(strings[i].size());
+        std::memcpy(&bytes[i * sizeof offset], &offset, sizeof offset);
+        std::memcpy(&bytes[offset], &length, sizeof length);
+        std::memcpy(&bytes[offset + sizeof length], strings[i].data(), length);
+        offset += sizeof length + length;
+    }
+
+    this->columns.push_back(Column{Column_type::Strings, strings.size(), std::move(bytes)});
+}
+
+void Data_writer::add_int64(const std::vector<std::int64_t> &values)
+{
+    this->add_numbers(Column_type::Int64, values.data(), values.size(), sizeof(std::int64_t));
+}
+
+void Data_writer::add_float64(const std::vector<double> &values)
+{
+    this->add_numbers(Column_type::Float64, values.data(), values.size(), sizeof(double));
+}
+
+void Data_writer::add_uint32(const std::vector<std::uint32_t> &values)
+{
+    this->add_numbers(Column_type::Uint32, values.data(), values.size(), sizeof(std::uint32_t));
+}
+
+// the file is built in memory and written with one write
+void Data_writer::write(const std::string &path) const
+{
+    std::size_t offset = sizeof(Header) + this->columns.size() * 32;
+    std::vector<std::uint64_t> offsets;
+    for (const Column &column : this->columns)
+    {
+        offset = align(offset);
+        offsets.push_back(offset);
+        offset += column.bytes.size();
+    }
+
+    std::string file(offset, '\0');
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof magic);
+    header.version = data_file_version;
+    header.kind = this->kind;
+    header.num_columns = static_cast<std::uint32_t>(this->columns.size());
+    header.byte_order = byte_order;
+    header.size = file.size();
+    std::memcpy(&file[0], &header, sizeof header);
+
+    for (std::size_t i = 0; i < this->columns.size(); ++i)
+    {
+        const Column &column = this->columns[i];
+        char *entry = &file[sizeof header + i * 32];
+        const std::uint64_t count = column.count, size = column.bytes.size();
+
+        // the layout of Data_file::Entry, the 4 bytes after the type are 0
+        std::memcpy(entry, &column.type, 4);
+        std::memcpy(entry + 8, &count, 8);
+        std::memcpy(entry + 16, &offsets[i], 8);
+        std::memcpy(entry + 24, &size, 8);
+        if (!column.bytes.empty())
+            std::memcpy(&file[offsets[i]], column.bytes.data(), column.bytes.size());
+    }
+
+    std::ofstream out {path, std::ios::binary | std::ios::trunc};
+    if (!out)
+        fail("open " + path);
+    out.write(file.data(), static_cast<std::streamsize>(file.size()));
+    out.close();
+    if (!out)
+        fail("write " + path);
+}
+
+Data_file::Data_file(const std::string &path)
+    : fd{-1}, data{nullptr}, size{0}, kind{}, version{0}
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+        fail("open " + path);
+
+    struct stat st;
+    if (::fstat(this->fd, &st) < 0)
+    {
+        int error = errno;
+        ::close(this->fd);
+        errno = error;
+        fail("stat " + path);
+    }
+    this->size = static_cast<std::size_t>(st.st_size);
+
+    if (this->size > 0)
+    {
+        void *ptr = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(this->fd);
+            errno = error;
+            fail("mmap " + path);
+        }
+        this->data = static_cast<const char *>(ptr);
+    }
+
+    try
+    {
+        this->check(path);
+    }
+    catch (...)
+    {
+        if (this->data != nullptr)
+            ::munmap(const_cast<char *>(this->data), this->size);
+        ::close(this->fd);
+        throw;
+    }
+}
+
+Data_file::~Data_file()
+{
+    if (this->data != nullptr)
+        ::munmap(const_cast<char *>(this->data), this->size);
+    ::close(this->fd);
+}
+
+// every offset and length is checked once here, so the columns can read without checking
+void Data_file::check(const std::string &path)
+{
+    Header header;
+    if (this->size < sizeof header)
+        invalid(path, "too short for a header");
+    std::memcpy(&header, this->data, sizeof header);
+
+    if (std::memcmp(header.magic, magic, sizeof magic) != 0)
+        invalid(path, "no magic");
+    if (header.byte_order != byte_order)
+        invalid(path, "written in another byte order");
+    if (header.version != data_file_version)
+        invalid(path, "version " + std::to_string(header.version) + " is not " + std::to_string(data_file_version));
+    if (header.size != this->size)
+        invalid(path, "the size is not the one in the header");
+    if ((this->size - sizeof header) / sizeof(Entry) < header.num_columns)
+        invalid(path, "too short for the directory");
+
+    this->kind = header.kind;
+    this->version = header.version;
+    this->entries.resize(header.num_columns);
+    if (header.num_columns > 0)
+        std::memcpy(this->entries.data(), this->data + sizeof header, header.num_columns * sizeof(Entry));
+
+    for (const Entry &entry : this->entries)
+    {
+        if (entry.offset % 8 != 0 || entry.offset > this->size || entry.size > this->size - entry.offset)
+            invalid(path, "a column is out of the file");
+
+        std::size_t width = 0;
+        switch (entry.type)
+        {
+        case Column_type::Int64:
+        case Column_type::Float64:
+            width = 8;
+            break;
+        case Column_type::Uint32:
+            width = 4;
+            break;
+        case Column_type::Strings:
+            break;
+        default:
+            invalid(path, "a column of an unknown type");
+        }
+
+        if (width != 0)
+        {
+            if (entry.size / width != entry.count || entry.size % width != 0)
+                invalid(path, "a column is not as long as its values");
+            continue;
+        }
+
+        if (entry.size / sizeof(std::uint64_t) < entry.count)
+            invalid(path, "a strings column is shorter than its index");
+
+        const char *base = this->data + entry.offset;
+        for (std::uint64_t i = 0; i < entry.count; ++i)
+        {
+            std::uint64_t offset;
+            std::uint32_t length;
+            std::memcpy(&offset, base + i * sizeof offset, sizeof offset);
+            if (offset < entry.count * sizeof offset || offset > entry.size || entry.size - offset < sizeof length)
+                invalid(path, "a string is out of its column");
+            std::memcpy(&length, base + offset, sizeof length);
+            if (entry.size - offset - sizeof length < length)
+                invalid(path, "a string is out of its column");
+        }
+    }
+}
+
+const Data_file::Entry &Data_file::get_entry(std::size_t column, Column_type type) const
+{
+    if (column >= this->entries.size())
+        throw std::runtime_error("there is no column " + std::to_string(column));
+    if (this->entries[column].type != type)
+        throw std::runtime_error("column " + std::to_string(column) + " is " + to_string(this->entries[column].type) + ", not " + to_string(type));
+    return this->entries[column];
+}
+
+Data_kind Data_file::get_kind() const
+{
+    return this->kind;
+}
+
+std::uint32_t Data_file::get_version() const
+{
+    return this->version;
+}
+
+std::size_t Data_file::get_size() const
+{
+    return this->size;
+}
+
+std::size_t Data_file::get_num_columns() const
+{
+    return this->entries.size();
+}
+
+Column_type Data_file::get_type(std::size_t column) const
+{
+    if (column >= this->entries.size())
+        throw std::runtime_error("there is no column " + std::to_string(column));
+    return this->entries[column].type;
+}
+
+String_column Data_file::strings(std::size_t column) const
+{
+    const Entry &entry = this->get_entry(column, Column_type::Strings);
+    return {this->data + entry.offset, static_cast<std::size_t>(entry.count)};
+}
+
+Number_column<std::int64_t> Data_file::int64s(std::size_t column) const
+{
+    const Entry &entry = this->get_entry(column, Column_type::Int64);
+    return {reinterpret_cast<const std::int64_t *>(this->data + entry.offset), static_cast<std::size_t>(entry.count)};
+}
+
+Number_column<double> Data_file::float64s(std::size_t column) const
+{
+    const Entry &entry = this->get_entry(column, Column_type::Float64);
+    return {reinterpret_cast<const double *>(this->data + entry.offset), static_cast<std::size_t>(entry.count)};
+}
+
+Number_column<std::uint32_t> Data_file::uint32s(std::size_t column) const
+{
+    const Entry &entry = this->get_entry(column, Column_type::Uint32);
+    return {reinterpret_cast<const std::uint32_t *>(this->data + entry.offset), static_cast<std::size_t>(entry.count)};
+}
+
+std::string to_string(Data_kind kind)
+{
+    switch (kind)
+    {
+    case Data_kind::Tour:
+        return "tour";
+    case Data_kind::Responses:
+        return "responses";
+    case Data_kind::Text:
+        return "text";
+    }
+    return "unknown";
+}
+
+std::string to_string(Column_type type)
+{
+    switch (type)
+    {
+    case Column_type::Strings:
+        return "strings";
+    case Column_type::Int64:
+        return "int64";
+    case Column_type::Float64:
+        return "float64";
+    case Column_type::Uint32:
+        return "uint32";
+    }
+    return "unknown";
+}
@@ -0,0 +1,156 @@
+#ifndef _DATA_FILE_H_
+#define _DATA_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - a data file is a header, a directory of columns and the columns, the header has
+      the magic "ioStream", the schema version, the kind of data set, a byte order mark
+      and the size of the file, every entry of the directory has the type, the number
+      of values, the offset and the size in bytes of one column.
+
+    - a numbers column is its values one after the other, 8 byte aligned, a strings
+      column is an index of 8 byte offsets, one per string, and then the strings, each
+      one a 4 byte length and its bytes. the numbers are in the byte order of the
+      machine that wrote them, a file of the other byte order is refused.
+
+    - Data_writer collects the columns and writes the whole file at once, Data_file
+      maps it and checks every offset and length when it is opened, after that the
+      columns are views into the mapping and read nothing, they live as long as the
+      Data_file. errors throw std::runtime_error.
+
+*/
+enum class Data_kind : std::uint32_t
+{
+    Tour = 1,
+    Responses = 2,
+    Text = 3
+};
+
+enum class Column_type : std::uint32_t
+{
+    Strings = 1,
+    Int64 = 2,
+    Float64 = 3,
+    Uint32 = 4
+};
+
+constexpr std::uint32_t data_file_version = 1;
+
+template<typename T>
+class Number_column
+{
+private:
+    const T *data;
+    std::size_t count;
+
+public:
+    Number_column(const T *data, std::size_t count) : data{data}, count{count} {}
+
+    std::size_t size() const { return this->count; }
+    const T *get_data() const { return this->data; }
+    T operator[](std::size_t index) const { return this->data[index]; }
+    const T *begin() const { return this->data; }
+    const T *end() const { return this->data + this->count; }
+};
+
+class String_column
+{
+private:
+    const char *base;            // the start of the column
+    const std::uint64_t *index;  // where the length of every string is, from base
+    std::size_t count;
+
+public:
+    String_column(const char *base, std::size_t count)
+        : base{base}, index{reinterpret_cast<const std::uint64_t *>(base)}, count{count} {}
+
+    std::size_t size() const { return this->count; }
+
+    std::string_view operator[](std::size_t i) const
+    {
+        std::uint32_t length;
+        std::memcpy(&length, this->base + this->index[i], sizeof length);
+        return {this->base + this->index[i] + sizeof length, length};
+    }
+};
+
+class Data_writer
+{
+private:
+    struct Column
+    {
+        Column_type type;
+        std::uint64_t count;
+        std::string bytes;
+    };
+
+    Data_kind kind;
+    std::vector<Column> columns;
+
+    void add_numbers(Column_type type, const void *values, std::size_t count, std::size_t width);
+
+public:
+    explicit Data_writer(Data_kind kind);
+
+    // every add is the next column, the first one is column 0
+    void add_strings(const std::vector<std::string_view> &strings);
+    void add_int64(const std::vector<std::int64_t> &values);
+    void add_float64(const std::vector<double> &values);
+    void add_uint32(const std::vector<std::uint32_t> &values);
+
+    void write(const std::string &path) const;
+};
+
+class Data_file
+{
+private:
+    struct Entry
+    {
+        Column_type type;
+        std::uint32_t reserved;
+        std::uint64_t count;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    int fd;
+    const char *data;
+    std::size_t size;
+    Data_kind kind;
+    std::uint32_t version;
+    std::vector<Entry> entries;
+
+    void check(const std::string &path);
+    const Entry &get_entry(std::size_t column, Column_type type) const;
+
+public:
+    explicit Data_file(const std::string &path);
+    ~Data_file();
+
+    Data_file(const Data_file &) = delete;
+    Data_file &operator=(const Data_file &) = delete;
+
+    Data_kind get_kind() const;
+    std::uint32_t get_version() const;
+    std::size_t get_size() const;
+    std::size_t get_num_columns() const;
+    Column_type get_type(std::size_t column) const;
+
+    // the type of the column has to be the one asked for
+    String_column strings(std::size_t column) const;
+    Number_column<std::int64_t> int64s(std::size_t column) const;
+    Number_column<double> float64s(std::size_t column) const;
+    Number_column<std::uint32_t> uint32s(std::size_t column) const;
+};
+
+std::string to_string(Data_kind kind);
+std::string to_string(Column_type type);
+
+#endif
@@ -0,0 +1,117 @@
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include "Data_file.h"
+#include "Data_sets.h"
+
+namespace
+{
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream in {path, std::ios::binary};
+        if (!in)
+            fail("open " + path);
+        std::ostringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    std::uint32_t count_words(std::string_view line)
+    {
+        std::uint32_t words = 0;
+        bool in_word = false;
+        for (char ch : line)
+        {
+            const bool space = ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+            words += !space && !in_word;
+            in_word = !space;
+        }
+        return words;
+    }
+}
+
+void write_tour(const Tour &tour, const std::string &path)
+{
+    std::vector<std::string_view> country_names, city_names;
+    std::vector<std::uint32_t> first_city;
+    std::vector<std::int64_t> populations;
+    std::vector<double> costs;
+
+    for (const Country &country : tour.countries)
+    {
+        country_names.push_back(country.name);
+        first_city.push_back(static_cast<std::uint32_t>(city_names.size()));
+        for (const City &city : country.cities)
+        {
+            city_names.push_back(city.name);
+            populations.push_back(city.population);
+            costs.push_back(city.cost);
+        }
+    }
+    first_city.push_back(static_cast<std::uint32_t>(city_names.size()));
+
+    Data_writer writer {Data_kind::Tour};
+    writer.add_strings({tour.title});
+    writer.add_strings(country_names);
+    writer.add_uint32(first_city);
+    writer.add_strings(city_names);
+    writer.add_int64(populations);
+    writer.add_float64(costs);
+    writer.write(path);
+}
+
+// the key is the first word, then a name and its answers for every student
+void convert_responses(const std::string &text_path, const std::string &path)
+{
+    std::istringstream in {read_file(text_path)};
+    std::string key;
+    if (!(in >> key))
+        throw std::runtime_error(text_path + ": there is no answer key");
+
+    std::vector<std::string> names, answers;
+    std::string name, answer;
+    while (in >> name >> answer)
+    {
+        names.push_back(std::move(name));
+        answers.push_back(std::move(answer));
+    }
+
+    Data_writer writer {Data_kind::Responses};
+    writer.add_strings({key});
+    writer.add_strings(std::vector<std::string_view>(names.begin(), names.end()));
+    writer.add_strings(std::vector<std::string_view>(answers.begin(), answers.end()));
+    writer.write(path);
+}
+
+// a last line without a '\n' is a line too
+void convert_text(const std::string &text_path, const std::string &path)
+{
+    const std::string text = read_file(text_path);
+    std::vector<std::string_view> lines;
+    std::vector<std::uint32_t> words;
+
+    std::size_t begin = 0;
+    while (begin < text.size())
+    {
+        std::size_t end = text.find('\n', begin);
+        if (end == std::string::npos)
+            end = text.size();
+        lines.emplace_back(text.data() + begin, end - begin);
+        words.push_back(count_words(lines.back()));
+        begin = end + 1;
+    }
+
+    Data_writer writer {Data_kind::Text};
+    writer.add_strings(lines);
+    writer.add_uint32(words);
+    writer.write(path);
+}
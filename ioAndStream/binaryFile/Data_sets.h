@@ -0,0 +1,49 @@
+#ifndef _DATA_SETS_H_
+#define _DATA_SETS_H_
+
+#include <cstddef>
+#include <string>
+#include "../challenge/Tour.h"
+
+/*
+
+    - the converters write the data sets of the challenges as data files, see Data_file.h,
+      the enums are the columns of every kind, in the order they are written.
+
+    - the tour of ../challenge: the title, the country names, for every country the index of
+      its first city and one more for the end, the city names, populations and costs.
+
+    - the responses of ../challenge2: the answer key, the student names and their answers.
+
+    - a text, e.g. ../challenge3/romeoAndJuliet.txt: the lines without the '\n' and the
+      number of words on every line.
+
+*/
+enum Tour_column : std::size_t
+{
+    Tour_title,
+    Tour_country_names,
+    Tour_first_city,
+    Tour_city_names,
+    Tour_populations,
+    Tour_costs
+};
+
+enum Responses_column : std::size_t
+{
+    Responses_key,
+    Responses_names,
+    Responses_answers
+};
+
+enum Text_column : std::size_t
+{
+    Text_lines,
+    Text_words
+};
+
+void write_tour(const Tour &tour, const std::string &path);
+void convert_responses(const std::string &text_path, const std::string &path);
+void convert_text(const std::string &text_path, const std::string &path);
+
+#endif
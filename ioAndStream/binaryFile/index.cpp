@@ -0,0 +1,115 @@
+/*
+
+    - converts the data sets of the challenges into data files, see Data_file.h and
+      Data_sets.h, maps them again and reads them without copying a record.
+
+    - build it together with the tour of ../challenge:
+        g++ -std=c++17 index.cpp Data_file.cpp Data_sets.cpp ../challenge/Tour.cpp
+
+    - the responses and the text can be given on the command line,
+      ./a.out ../challenge2/responses.txt ../challenge3/romeoAndJuliet.txt is the default,
+      the data files are written into the current directory.
+
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Data_file.h"
+#include "Data_sets.h"
+
+void print_file(const std::string &path, const Data_file &file)
+{
+    std::cout << path << ": " << to_string(file.get_kind()) << ", version " << file.get_version()
+              << ", " << file.get_size() << " bytes, columns:";
+    for (std::size_t i = 0; i < file.get_num_columns(); ++i)
+        std::cout << " " << to_string(file.get_type(i));
+    std::cout << std::endl;
+}
+
+void read_tour(const std::string &path)
+{
+    Data_file file {path};
+    print_file(path, file);
+
+    const String_column title = file.strings(Tour_title);
+    const String_column countries = file.strings(Tour_country_names);
+    const Number_column<std::uint32_t> first_city = file.uint32s(Tour_first_city);
+    const Number_column<std::int64_t> populations = file.int64s(Tour_populations);
+    const Number_column<double> costs = file.float64s(Tour_costs);
+
+    std::cout << "    " << title[0] << std::endl;
+    for (std::size_t i = 0; i < countries.size(); ++i)
+    {
+        std::int64_t population = 0;
+        for (std::uint32_t city = first_city[i]; city < first_city[i + 1]; ++city)
+            population += populations[city];
+        std::cout << "    " << countries[i] << ": " << first_city[i + 1] - first_city[i] << " cities, "
+                  << population << " people, from $" << *std::min_element(costs.begin() + first_city[i], costs.begin() + first_city[i + 1])
+                  << std::endl;
+    }
+}
+
+void read_responses(const std::string &path)
+{
+    Data_file file {path};
+    print_file(path, file);
+
+    const std::string_view key = file.strings(Responses_key)[0];
+    const String_column names = file.strings(Responses_names);
+    const String_column answers = file.strings(Responses_answers);
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        int score = 0;
+        for (std::size_t j = 0; j < key.size() && j < answers[i].size(); ++j)
+            score += key[j] == answers[i][j];
+        std::cout << "    " << names[i] << ": " << answers[i] << " " << score << "/" << key.size() << std::endl;
+    }
+}
+
+void read_text(const std::string &path)
+{
+    Data_file file {path};
+    print_file(path, file);
+
+    const String_column lines = file.strings(Text_lines);
+    const Number_column<std::uint32_t> words = file.uint32s(Text_words);
+
+    std::size_t words_total = 0, longest = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        words_total += words[i];
+        if (lines[i].size() > lines[longest].size())
+            longest = i;
+    }
+
+    std::cout << "    " << lines.size() << " lines, " << words_total << " words" << std::endl;
+    if (lines.size() > 0)
+        std::cout << "    the longest is line " << longest + 1 << ": " << lines[longest] << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string responses = argc > 1 ? argv[1] : "../challenge2/responses.txt";
+    const std::string text = argc > 2 ? argv[2] : "../challenge3/romeoAndJuliet.txt";
+
+    try
+    {
+        write_tour(make_tour(), "tour.dat");
+        convert_responses(responses, "responses.dat");
+        convert_text(text, "text.dat");
+
+        read_tour("tour.dat");
+        read_responses("responses.dat");
+        read_text("text.dat");
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#ifndef _ASYNC_WRITER_H_
+#define _ASYNC_WRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/*
+
+    - Async_writer puts the output in one buffer while a background thread writes the other
+      one to the stream, so formatting and writing the file overlap. when the producer fills
+      its buffer before the thread is done with the other one, it waits for it.
+
+    - it is a std::streambuf, so a std::ostream on it takes the usual << and std::setw:
+      Async_writer writer {out_file}; std::ostream out {&writer};
+      std::endl flushes and waits every time, use '\n'.
+
+    - flush() waits until everything is in the stream and flushes it, the destructor does
+      too. a failed write to the stream throws std::runtime_error from write or flush.
+
+    - the stream must not be used by anybody else while the writer lives.
+
+*/
+class Async_writer : public std::streambuf
+{
+private:
+    std::ostream &os;
+    std::vector<char> front;
+    std::vector<char> back;
+    std::size_t back_used;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool pending;   // back holds data for the thread
+    bool stopping;
+    bool failed;
+
+    void run();
+    void submit();
+    void wait_idle(std::unique_lock<std::mutex> &lock);
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char *data, std::streamsize size) override;
+    int sync() override;
+
+public:
+    explicit Async_writer(std::ostream &os, std::size_t buffer_size = 1 << 20);
+    ~Async_writer() override;
+
+    Async_writer(const Async_writer &) = delete;
+    Async_writer &operator=(const Async_writer &) = delete;
+
+    void write(const char *data, std::size_t size);
+    void write(std::string_view text);
+    void flush();
+};
+
+#endif
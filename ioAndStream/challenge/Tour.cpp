@@ -0,0 +1,40 @@
+#include "Tour.h"
+
+Tour make_tour()
+{
+    return {
+        "Tour ticket prices from miami",
+        {
+            {
+                "Colombia",
+                {
+                    {"Bogota", 8778000, 400.98},
+                    {"Cali", 2401000, 424.44},
+                    {"Medellin", 2464000, 350.98},
+                    {"Cartagena", 972000, 345.34}
+                }
+            },
+            {
+                "Brazil",
+                {
+                    {"Rio De Janiero", 135000000, 567.45},
+                    {"Sao Paulo", 11310000, 975.45},
+                    {"Salvador", 182340000, 855.99}
+                }
+            },
+            {
+                "Chile",
+                {
+                    {"Valdivia", 260000, 569.45},
+                    {"Santiago", 7040000, 444.98}
+                }
+            },
+            {
+                "Argentian",
+                {
+                    {"Buenos Aires", 3010000, 339.45}
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,31 @@
+#ifndef _TOUR_H_
+#define _TOUR_H_
+
+#include <string>
+#include <vector>
+#include "Small_vector.h"
+
+struct City
+{
+    std::string name;
+    long int population;
+    double cost;
+};
+
+struct Country
+{
+    std::string name;
+    // a country has a few cities, they are kept inside it, not on the heap
+    Small_vector<City, 8> cities;
+};
+
+struct Tour
+{
+    std::string title;
+    std::vector<Country> countries;
+};
+
+// the tour of this challenge
+Tour make_tour();
+
+#endif
@@ -0,0 +1,471 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "Tour_columns.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr std::size_t num_lanes = 8;
+    constexpr std::size_t per_lane = Packed_column::block_size / num_lanes;
+
+    // value k of a lane, the words of the lane are num_lanes apart
+    std::uint32_t unpack(const std::uint32_t *lane, std::size_t k, unsigned width)
+    {
+        if (width == 0)
+            return 0;
+        const std::size_t bit = k * width;
+        const std::size_t t = bit / 32;
+        const unsigned s = bit % 32;
+        std::uint64_t two = lane[t * num_lanes];
+        if (s + width > 32)
+            two |= static_cast<std::uint64_t>(lane[(t + 1) * num_lanes]) << 32;
+        return static_cast<std::uint32_t>((two >> s) & ((std::uint64_t {1} << width) - 1));
+    }
+
+#if defined(__AVX2__)
+    // the 8 values k of the lanes, W is a constant so the shifts and the branch are too
+    template<unsigned W>
+    __m256i unpack8(const std::uint32_t *words, std::size_t k)
+    {
+        constexpr std::uint32_t mask = W == 32 ? ~std::uint32_t {0} : (std::uint32_t {1} << W) - 1;
+        const std::size_t bit = k * W;
+        const std::size_t t = bit / 32;
+        const unsigned s = bit % 32;
+        __m256i v = _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + t * num_lanes)), s);
+        if (s + W > 32)
+            v = _mm256_or_si256(v, _mm256_slli_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + (t + 1) * num_lanes)), 32 - s));
+        return _mm256_and_si256(v, _mm256_set1_epi32(static_cast<int>(mask)));
+    }
+
+    template<unsigned W>
+    std::uint64_t sum_deltas(const std::uint32_t *words)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i sums = zero;
+        for (std::size_t k = 0; k < per_lane; ++k)
+        {
+            const __m256i v = unpack8<W>(words, k);
+            sums = _mm256_add_epi64(sums, _mm256_unpacklo_epi32(v, zero));
+            sums = _mm256_add_epi64(sums, _mm256_unpackhi_epi32(v, zero));
+        }
+        const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+        return static_cast<std::uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<std::uint64_t>(_mm_extract_epi64(half, 1));
+    }
+
+    template<unsigned W>
+    void decode_deltas(const std::uint32_t *words, std::int64_t base, std::int64_t *out)
+    {
+        const __m256i bases = _mm256_set1_epi64x(base);
+        for (std::size_t k = 0; k < per_lane; ++k)
+        {
+            const __m256i v = unpack8<W>(words, k);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + k * num_lanes),
+                _mm256_add_epi64(bases, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v))));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + k * num_lanes + 4),
+                _mm256_add_epi64(bases, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1))));
+        }
+    }
+
+    using Sum_kernel = std::uint64_t (*)(const std::uint32_t *);
+    using Decode_kernel = void (*)(const std::uint32_t *, std::int64_t, std::int64_t *);
+
+    template<std::size_t... W>
+    constexpr std::pair<std::array<Sum_kernel, sizeof...(W)>, std::array<Decode_kernel, sizeof...(W)>>
+    make_kernels(std::index_sequence<W...>)
+    {
+        return {{sum_deltas<W + 1>...}, {decode_deltas<W + 1>...}};
+    }
+
+    // the kernel of width w is at w - 1, a width of 0 has no words to unpack
+    constexpr auto kernels = make_kernels(std::make_index_sequence<32> {});
+#endif
+}
+
+Packed_column::Packed_column(const std::int64_t *values, std::size_t size)
+    : num_values {size}
+{
+    this->blocks.reserve((size + block_size - 1) / block_size);
+    for (std::size_t first = 0; first < size; first += block_size)
+    {
+        const std::size_t count = std::min(block_size, size - first);
+        const auto [low, high] = std::minmax_element(values + first, values + first + count);
+        const std::uint64_t range = static_cast<std::uint64_t>(*high) - static_cast<std::uint64_t>(*low);
+        const unsigned width = range == 0 ? 0 : 64 - __builtin_clzll(range);
+
+        Block block {*low, *high, this->words.size(), static_cast<std::uint8_t>(width)};
+        // a last block that is not full keeps its values too, a packed one is 256 values long
+        if (width > 32 || count < block_size)
+        {
+            block.width = raw_width;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                const std::uint64_t value = static_cast<std::uint64_t>(values[first + j]);
+                this->words.push_back(static_cast<std::uint32_t>(value));
+                this->words.push_back(static_cast<std::uint32_t>(value >> 32));
+            }
+        }
+        else
+        {
+            this->words.resize(block.offset + num_lanes * width, 0);
+            std::uint32_t *lanes = this->words.data() + block.offset;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                const std::uint32_t delta = static_cast<std::uint32_t>(values[first + j] - block.base);
+                const std::size_t bit = j / num_lanes * width;
+                const std::size_t t = bit / 32;
+                const unsigned s = bit % 32;
+                std::uint32_t *lane = lanes + j % num_lanes;
+                lane[t * num_lanes] |= delta << s;
+                if (s + width > 32)
+                    lane[(t + 1) * num_lanes] |= delta >> (32 - s);
+            }
+        }
+        this->blocks.push_back(block);
+    }
+    this->words.shrink_to_fit();
+}
+
+Packed_column::Packed_column(const std::vector<std::int64_t> &values)
+    : Packed_column(values.data(), values.size())
+{
+}
+
+std::size_t Packed_column::size() const
+{
+    return this->num_values;
+}
+
+std::int64_t Packed_column::get(std::size_t i) const
+{
+    const Block &block = this->blocks[i / block_size];
+    const std::size_t j = i % block_size;
+    const std::uint32_t *words = this->words.data() + block.offset;
+    if (block.width == raw_width)
+        return static_cast<std::int64_t>(words[j * 2] | static_cast<std::uint64_t>(words[j * 2 + 1]) << 32);
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(block.base)
+        + unpack(words + j % num_lanes, j / num_lanes, block.width));
+}
+
+std::int64_t Packed_column::sum_block(const Block &block, std::size_t count) const
+{
+    const std::uint32_t *words = this->words.data() + block.offset;
+    if (block.width == raw_width)
+    {
+        std::int64_t total = 0;
+        for (std::size_t j = 0; j < count; ++j)
+            total += static_cast<std::int64_t>(words[j * 2] | static_cast<std::uint64_t>(words[j * 2 + 1]) << 32);
+        return total;
+    }
+
+    std::uint64_t deltas = 0;
+    if (block.width != 0)
+    {
+#if defined(__AVX2__)
+        deltas = kernels.first[block.width - 1](words);
+#else
+        for (std::size_t lane = 0; lane < num_lanes; ++lane)
+            for (std::size_t k = 0; k < per_lane; ++k)
+                deltas += unpack(words + lane, k, block.width);
+#endif
+    }
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(block.base) * count + deltas);
+}
+
+void Packed_column::decode_block(const Block &block, std::int64_t *out) const
+{
+    const std::uint32_t *words = this->words.data() + block.offset;
+    if (block.width == 0)
+        std::fill(out, out + block_size, block.base);
+    else
+    {
+#if defined(__AVX2__)
+        kernels.second[block.width - 1](words, block.base, out);
+#else
+        for (std::size_t j = 0; j < block_size; ++j)
+            out[j] = static_cast<std::int64_t>(static_cast<std::uint64_t>(block.base)
+                + unpack(words + j % num_lanes, j / num_lanes, block.width));
+#endif
+    }
+}
+
+void Packed_column::decode(std::size_t begin, std::size_t end, std::int64_t *out) const
+{
+    while (begin < end)
+    {
+        const std::size_t first = begin / block_size * block_size;
+        const std::size_t last = std::min(first + block_size, this->num_values);
+        const Block &block = this->blocks[first / block_size];
+        const std::size_t until = std::min(end, last);
+        // a packed block is always a full one
+        if (begin == first && until == last && block.width != raw_width)
+        {
+            this->decode_block(block, out);
+            out += block_size;
+        }
+        else
+            for (std::size_t i = begin; i < until; ++i)
+                *out++ = this->get(i);
+        begin = until;
+    }
+}
+
+std::int64_t Packed_column::sum(std::size_t begin, std::size_t end) const
+{
+    std::int64_t total = 0;
+    while (begin < end)
+    {
+        const std::size_t first = begin / block_size * block_size;
+        const std::size_t last = std::min(first + block_size, this->num_values);
+        const std::size_t until = std::min(end, last);
+        if (begin == first && until == last)
+            total += this->sum_block(this->blocks[first / block_size], last - first);
+        else
+            for (std::size_t i = begin; i < until; ++i)
+                total += this->get(i);
+        begin = until;
+    }
+    return total;
+}
+
+std::int64_t Packed_column::min(std::size_t begin, std::size_t end) const
+{
+    std::int64_t min = std::numeric_limits<std::int64_t>::max();
+    while (begin < end)
+    {
+        const std::size_t first = begin / block_size * block_size;
+        const std::size_t last = std::min(first + block_size, this->num_values);
+        const std::size_t until = std::min(end, last);
+        if (begin == first && until == last)
+            min = std::min(min, this->blocks[first / block_size].base);
+        else
+            for (std::size_t i = begin; i < until; ++i)
+                min = std::min(min, this->get(i));
+        begin = until;
+    }
+    return min;
+}
+
+std::int64_t Packed_column::max(std::size_t begin, std::size_t end) const
+{
+    std::int64_t max = std::numeric_limits<std::int64_t>::min();
+    while (begin < end)
+    {
+        const std::size_t first = begin / block_size * block_size;
+        const std::size_t last = std::min(first + block_size, this->num_values);
+        const std::size_t until = std::min(end, last);
+        if (begin == first && until == last)
+            max = std::max(max, this->blocks[first / block_size].max);
+        else
+            for (std::size_t i = begin; i < until; ++i)
+                max = std::max(max, this->get(i));
+        begin = until;
+    }
+    return max;
+}
+
+std::size_t Packed_column::get_bytes() const
+{
+    return this->words.capacity() * sizeof(std::uint32_t) + this->blocks.capacity() * sizeof(Block);
+}
+
+Dictionary_column::Dictionary_column(const std::vector<std::int64_t> &values)
+    : dictionary {values}
+{
+    std::sort(this->dictionary.begin(), this->dictionary.end());
+    this->dictionary.erase(std::unique(this->dictionary.begin(), this->dictionary.end()), this->dictionary.end());
+    this->dictionary.shrink_to_fit();
+
+    std::vector<std::int64_t> indexes;
+    indexes.reserve(values.size());
+    for (const std::int64_t value : values)
+        indexes.push_back(std::lower_bound(this->dictionary.begin(), this->dictionary.end(), value)
+            - this->dictionary.begin());
+    this->codes = Packed_column {indexes};
+}
+
+std::size_t Dictionary_column::size() const
+{
+    return this->codes.size();
+}
+
+std::int64_t Dictionary_column::get(std::size_t i) const
+{
+    return this->dictionary[this->codes.get(i)];
+}
+
+std::size_t Dictionary_column::get_num_distinct() const
+{
+    return this->dictionary.size();
+}
+
+std::int64_t Dictionary_column::sum(std::size_t begin, std::size_t end) const
+{
+    const std::int64_t *values = this->dictionary.data();
+    std::int64_t buffer[Packed_column::block_size];
+    std::int64_t total = 0;
+    while (begin < end)
+    {
+        const std::size_t until = std::min(end, (begin / Packed_column::block_size + 1) * Packed_column::block_size);
+        const std::size_t count = until - begin;
+        this->codes.decode(begin, until, buffer);
+        std::size_t j = 0;
+
+#if defined(__AVX2__)
+        // the values of 4 codes with a gather
+        __m256i sums = _mm256_setzero_si256();
+        for (; j + 4 <= count; j += 4)
+            sums = _mm256_add_epi64(sums, _mm256_i64gather_epi64(reinterpret_cast<const long long *>(values),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buffer + j)), 8));
+        std::int64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sums);
+        total += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+        for (; j < count; ++j)
+            total += values[buffer[j]];
+        begin = until;
+    }
+    return total;
+}
+
+std::int64_t Dictionary_column::min(std::size_t begin, std::size_t end) const
+{
+    return begin < end ? this->dictionary[this->codes.min(begin, end)] : std::numeric_limits<std::int64_t>::max();
+}
+
+std::int64_t Dictionary_column::max(std::size_t begin, std::size_t end) const
+{
+    return begin < end ? this->dictionary[this->codes.max(begin, end)] : std::numeric_limits<std::int64_t>::min();
+}
+
+std::size_t Dictionary_column::get_bytes() const
+{
+    return this->dictionary.capacity() * sizeof(std::int64_t) + this->codes.get_bytes();
+}
+
+Fixed_column::Fixed_column(double scale)
+    : scale {scale}
+{
+}
+
+Fixed_column::Fixed_column(const std::vector<double> &values, double scale)
+    : scale {scale}
+{
+    this->values.reserve(values.size());
+    for (const double value : values)
+        this->push_back(value);
+}
+
+void Fixed_column::push_back(double value)
+{
+    const double fixed = std::round(value * this->scale);
+    if (!(fixed >= std::numeric_limits<std::int32_t>::min() && fixed <= std::numeric_limits<std::int32_t>::max()))
+        throw std::overflow_error("Fixed_column: the value does not fit in 32 bits of 1/scale");
+    this->values.push_back(static_cast<std::int32_t>(fixed));
+}
+
+std::size_t Fixed_column::size() const
+{
+    return this->values.size();
+}
+
+double Fixed_column::get(std::size_t i) const
+{
+    return this->values[i] / this->scale;
+}
+
+std::int32_t Fixed_column::get_fixed(std::size_t i) const
+{
+    return this->values[i];
+}
+
+double Fixed_column::get_scale() const
+{
+    return this->scale;
+}
+
+std::int64_t Fixed_column::sum_fixed(std::size_t begin, std::size_t end) const
+{
+    const std::int32_t *data = this->values.data();
+    std::int64_t total = 0;
+    std::size_t i = begin;
+
+#if defined(__AVX2__)
+    __m256i sums = _mm256_setzero_si256();
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    std::int64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sums);
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    for (; i < end; ++i)
+        total += data[i];
+    return total;
+}
+
+double Fixed_column::sum(std::size_t begin, std::size_t end) const
+{
+    return this->sum_fixed(begin, end) / this->scale;
+}
+
+double Fixed_column::min(std::size_t begin, std::size_t end) const
+{
+    if (begin >= end)
+        return std::numeric_limits<double>::infinity();
+    const std::int32_t *data = this->values.data();
+    std::int32_t min = std::numeric_limits<std::int32_t>::max();
+    std::size_t i = begin;
+
+#if defined(__AVX2__)
+    __m256i mins = _mm256_set1_epi32(min);
+    for (; i + 8 <= end; i += 8)
+        mins = _mm256_min_epi32(mins, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+    std::int32_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), mins);
+    min = *std::min_element(lanes, lanes + 8);
+#endif
+
+    for (; i < end; ++i)
+        min = std::min(min, data[i]);
+    return min / this->scale;
+}
+
+double Fixed_column::max(std::size_t begin, std::size_t end) const
+{
+    if (begin >= end)
+        return -std::numeric_limits<double>::infinity();
+    const std::int32_t *data = this->values.data();
+    std::int32_t max = std::numeric_limits<std::int32_t>::min();
+    std::size_t i = begin;
+
+#if defined(__AVX2__)
+    __m256i maxs = _mm256_set1_epi32(max);
+    for (; i + 8 <= end; i += 8)
+        maxs = _mm256_max_epi32(maxs, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+    std::int32_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), maxs);
+    max = *std::max_element(lanes, lanes + 8);
+#endif
+
+    for (; i < end; ++i)
+        max = std::max(max, data[i]);
+    return max / this->scale;
+}
+
+std::size_t Fixed_column::get_bytes() const
+{
+    return this->values.capacity() * sizeof(std::int32_t);
+}
@@ -0,0 +1,128 @@
+#ifndef _TOUR_COLUMNS_H_
+#define _TOUR_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+
+    - compact columns for the numbers of Tour_table when there are billions of cities, the
+      aggregates run on the encoded values, they are never expanded into an array first.
+
+    - Packed_column keeps integers by frame of reference, a block of 256 values keeps its
+      minimum and its maximum and every value as its distance from the minimum in as many
+      bits as the largest distance needs, 0 bits for a block of one value. populations of
+      up to a million are 20 bits a city instead of 64. a block whose values are more than
+      2^32 apart keeps them as they are, and so does the last one when it is not full.
+
+    - the 256 values of a block are 8 lanes of 32, value j is in lane j % 8, the bits of a
+      lane are one after the other in the words of the lane, word t of the 8 lanes is 8
+      words in a row, so AVX2 unpacks 8 values with a load, 2 shifts and a mask, without a
+      shuffle. min and max of whole blocks read the minimum and the maximum of the block
+      and nothing else.
+
+    - Dictionary_column keeps a column of few distinct values as the sorted distinct values
+      and a Packed_column of the index of each, the prices of a tour, a handful of them
+      for millions of cities, are a few bits a city. min and max are the ones of the
+      indexes, the dictionary is sorted.
+
+    - Fixed_column keeps a double as a whole number of 1/scale in 32 bits, a cost of up to
+      21M at a scale of 100, cents, is exact to the cent and 4 bytes, a value that does not
+      fit throws std::overflow_error. sum adds the fixed values in 64 bits, so a total is
+      exact whatever the order is.
+
+    - a range of a column is [begin, end), an empty one has a sum of 0, a min of the largest
+      value and a max of the smallest. the kernels are AVX2 when the build has it,
+      -march=x86-64-v3, and plain loops otherwise.
+
+*/
+class Packed_column
+{
+public:
+    static constexpr std::size_t block_size = 256;
+
+private:
+    static constexpr std::uint8_t raw_width = 64;
+
+    struct Block
+    {
+        std::int64_t base;
+        std::int64_t max;
+        std::size_t offset;  // the first word of the block
+        std::uint8_t width;  // bits a value, raw_width for the values as they are
+    };
+
+    std::vector<Block> blocks;
+    std::vector<std::uint32_t> words;
+    std::size_t num_values {0};
+
+    std::int64_t sum_block(const Block &block, std::size_t count) const;
+    void decode_block(const Block &block, std::int64_t *out) const;
+
+public:
+    Packed_column() = default;
+    Packed_column(const std::int64_t *values, std::size_t size);
+    explicit Packed_column(const std::vector<std::int64_t> &values);
+
+    std::size_t size() const;
+    std::int64_t get(std::size_t i) const;
+    // the values [begin, end) into out
+    void decode(std::size_t begin, std::size_t end, std::int64_t *out) const;
+
+    std::int64_t sum(std::size_t begin, std::size_t end) const;
+    std::int64_t min(std::size_t begin, std::size_t end) const;
+    std::int64_t max(std::size_t begin, std::size_t end) const;
+
+    // the bytes of the words and the blocks
+    std::size_t get_bytes() const;
+};
+
+class Dictionary_column
+{
+private:
+    std::vector<std::int64_t> dictionary;
+    Packed_column codes;
+
+public:
+    Dictionary_column() = default;
+    explicit Dictionary_column(const std::vector<std::int64_t> &values);
+
+    std::size_t size() const;
+    std::int64_t get(std::size_t i) const;
+    std::size_t get_num_distinct() const;
+
+    std::int64_t sum(std::size_t begin, std::size_t end) const;
+    std::int64_t min(std::size_t begin, std::size_t end) const;
+    std::int64_t max(std::size_t begin, std::size_t end) const;
+
+    std::size_t get_bytes() const;
+};
+
+class Fixed_column
+{
+private:
+    std::vector<std::int32_t> values;
+    double scale;
+
+public:
+    explicit Fixed_column(double scale = 100.0);
+    Fixed_column(const std::vector<double> &values, double scale = 100.0);
+
+    void push_back(double value);
+
+    std::size_t size() const;
+    double get(std::size_t i) const;
+    std::int32_t get_fixed(std::size_t i) const;
+    double get_scale() const;
+
+    // the total in 1/scale, exact
+    std::int64_t sum_fixed(std::size_t begin, std::size_t end) const;
+    double sum(std::size_t begin, std::size_t end) const;
+    double min(std::size_t begin, std::size_t end) const;
+    double max(std::size_t begin, std::size_t end) const;
+
+    std::size_t get_bytes() const;
+};
+
+#endif
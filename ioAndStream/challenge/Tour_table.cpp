@@ -0,0 +1,181 @@
+#include <limits>
+#include "Tour_table.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+Tour_table::Tour_table(const Tour &tour)
+    : title{tour.title}
+{
+    std::size_t num_cities = 0;
+    std::size_t name_size = 0;
+    for (const Country &country : tour.countries)
+    {
+        num_cities += country.cities.size();
+        name_size += country.name.size();
+        for (const City &city : country.cities)
+            name_size += city.name.size();
+    }
+
+    this->names.reserve(name_size);
+    this->country_names.reserve(tour.countries.size() * 2);
+    this->city_names.reserve(num_cities * 2);
+    this->first_city.reserve(tour.countries.size() + 1);
+    this->populations.reserve(num_cities);
+    this->costs.reserve(num_cities);
+
+    for (const Country &country : tour.countries)
+    {
+        this->country_names.push_back(this->add_name(country.name));
+        this->country_names.push_back(static_cast<std::uint32_t>(country.name.size()));
+        this->first_city.push_back(static_cast<std::uint32_t>(this->populations.size()));
+
+        for (const City &city : country.cities)
+        {
+            this->city_names.push_back(this->add_name(city.name));
+            this->city_names.push_back(static_cast<std::uint32_t>(city.name.size()));
+            this->populations.push_back(city.population);
+            this->costs.push_back(city.cost);
+        }
+    }
+    this->first_city.push_back(static_cast<std::uint32_t>(this->populations.size()));
+}
+
+Tour_table::Tour_table(const Tour_data &data)
+    : title{data.title},
+      names{data.names},
+      country_names(data.country_names, data.country_names + data.num_countries * 2),
+      city_names(data.city_names, data.city_names + data.num_cities * 2),
+      first_city(data.first_city, data.first_city + data.num_countries + 1),
+      populations(data.populations, data.populations + data.num_cities),
+      costs(data.costs, data.costs + data.num_cities)
+{
+}
+
+// appends the name and returns where it starts
+std::uint32_t Tour_table::add_name(const std::string &name)
+{
+    std::uint32_t offset = static_cast<std::uint32_t>(this->names.size());
+    this->names.append(name);
+    return offset;
+}
+
+std::string_view Tour_table::get_title() const
+{
+    return this->title;
+}
+
+std::size_t Tour_table::get_num_countries() const
+{
+    return this->first_city.size() - 1;
+}
+
+std::size_t Tour_table::get_num_cities() const
+{
+    return this->populations.size();
+}
+
+std::string_view Tour_table::get_country_name(std::size_t country) const
+{
+    return std::string_view{this->names}.substr(this->country_names[country * 2], this->country_names[country * 2 + 1]);
+}
+
+std::size_t Tour_table::get_first_city(std::size_t country) const
+{
+    return this->first_city[country];
+}
+
+std::string_view Tour_table::get_city_name(std::size_t city) const
+{
+    return std::string_view{this->names}.substr(this->city_names[city * 2], this->city_names[city * 2 + 1]);
+}
+
+std::int64_t Tour_table::get_population(std::size_t city) const
+{
+    return this->populations[city];
+}
+
+double Tour_table::get_cost(std::size_t city) const
+{
+    return this->costs[city];
+}
+
+std::int64_t Tour_table::total_population(std::size_t country) const
+{
+    return this->total_population(this->first_city[country], this->first_city[country + 1]);
+}
+
+double Tour_table::min_cost(std::size_t country) const
+{
+    return this->min_cost(this->first_city[country], this->first_city[country + 1]);
+}
+
+double Tour_table::max_cost(std::size_t country) const
+{
+    return this->max_cost(this->first_city[country], this->first_city[country + 1]);
+}
+
+std::int64_t Tour_table::total_population(std::size_t begin, std::size_t end) const
+{
+    const std::int64_t *data = this->populations.data();
+    std::int64_t total = 0;
+    std::size_t i = begin;
+
+#if defined(__SSE2__)
+    // two sums side by side, added together at the end
+    __m128i sums = _mm_setzero_si128();
+    for (; i + 2 <= end; i += 2)
+        sums = _mm_add_epi64(sums, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+
+    std::int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), sums);
+    total = lanes[0] + lanes[1];
+#endif
+
+    for (; i < end; ++i)
+        total += data[i];
+    return total;
+}
+
+double Tour_table::min_cost(std::size_t begin, std::size_t end) const
+{
+    const double *data = this->costs.data();
+    double min = std::numeric_limits<double>::infinity();
+    std::size_t i = begin;
+
+#if defined(__SSE2__)
+    __m128d mins = _mm_set1_pd(min);
+    for (; i + 2 <= end; i += 2)
+        mins = _mm_min_pd(mins, _mm_loadu_pd(data + i));
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, mins);
+    min = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+#endif
+
+    for (; i < end; ++i)
+        min = data[i] < min ? data[i] : min;
+    return min;
+}
+
+double Tour_table::max_cost(std::size_t begin, std::size_t end) const
+{
+    const double *data = this->costs.data();
+    double max = -std::numeric_limits<double>::infinity();
+    std::size_t i = begin;
+
+#if defined(__SSE2__)
+    __m128d maxs = _mm_set1_pd(max);
+    for (; i + 2 <= end; i += 2)
+        maxs = _mm_max_pd(maxs, _mm_loadu_pd(data + i));
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, maxs);
+    max = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+#endif
+
+    for (; i < end; ++i)
+        max = data[i] > max ? data[i] : max;
+    return max;
+}
@@ -0,0 +1,79 @@
+#ifndef _TOUR_TABLE_H_
+#define _TOUR_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Tour.h"
+
+/*
+
+    - Tour_table is a Tour flattened into columns: all the names in one string, the
+      populations and the costs of all the cities in two contiguous arrays, and for every
+      country the index of its first city, the cities of country i are
+      [get_first_city(i), get_first_city(i + 1)).
+
+    - the aggregates scan the arrays of a range of cities two values at a time
+      with SSE2, a report reads the columns it needs and nothing else.
+
+    - Tour_data is the same columns somewhere else, the constexpr arrays of the tour that
+      the build writes, see ../embeddedData, a Tour_table of it copies the arrays, it
+      makes no Tour and looks at no name.
+
+*/
+struct Tour_data
+{
+    std::string_view title;
+    std::string_view names;
+    const std::uint32_t *country_names;  // 2 per country
+    const std::uint32_t *city_names;     // 2 per city
+    const std::uint32_t *first_city;     // num_countries + 1
+    const std::int64_t *populations;
+    const double *costs;
+    std::size_t num_countries;
+    std::size_t num_cities;
+};
+
+class Tour_table
+{
+private:
+    std::string title;
+    std::string names;                       // every country and city name, one after the other
+    std::vector<std::uint32_t> country_names;  // 2 per country, offset and length in names
+    std::vector<std::uint32_t> city_names;     // 2 per city
+    std::vector<std::uint32_t> first_city;     // one more than there are countries
+    std::vector<std::int64_t> populations;
+    std::vector<double> costs;
+
+    std::uint32_t add_name(const std::string &name);
+
+public:
+    explicit Tour_table(const Tour &tour);
+    explicit Tour_table(const Tour_data &data);
+
+    std::string_view get_title() const;
+    std::size_t get_num_countries() const;
+    std::size_t get_num_cities() const;
+
+    std::string_view get_country_name(std::size_t country) const;
+    std::size_t get_first_city(std::size_t country) const;
+
+    std::string_view get_city_name(std::size_t city) const;
+    std::int64_t get_population(std::size_t city) const;
+    double get_cost(std::size_t city) const;
+
+    // over the cities of one country
+    std::int64_t total_population(std::size_t country) const;
+    double min_cost(std::size_t country) const;
+    double max_cost(std::size_t country) const;
+
+    // over the cities [begin, end), an empty range has no minimum or maximum, they are
+    // +infinity and -infinity then
+    std::int64_t total_population(std::size_t begin, std::size_t end) const;
+    double min_cost(std::size_t begin, std::size_t end) const;
+    double max_cost(std::size_t begin, std::size_t end) const;
+};
+
+#endif
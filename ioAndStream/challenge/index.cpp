@@ -1,95 +1,134 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <iomanip>
+#include <cstdlib>
+#if defined(_WIN32)
 #include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+#include "Async_writer.h"
+#include "Format.h"
+#include "Tour.h"
+#include "Tour_columns.h"
+#include "Tour_table.h"
 
-struct City
-{
-    std::string name;
-    long int population;
-    double cost;
-};
+/*
 
-struct Country
-{
-    std::string name;
-    std::vector<City> cities;
-};
+    - the tour is made at build time, the columns of its Tour_table as constexpr arrays,
+      see ../embeddedData:
+        embed tour_data tour
+      built without cmake, e.g. g++ -std=c++17 -pthread *.cpp, it is made by make_tour().
 
-struct Tour
-{
-    std::string title;
-    std::vector<Country> countries;
-};
+*/
+#if __has_include("tour_data.h")
+#include "tour_data.h"
+#define HAS_TOUR_DATA 1
+#endif
 
-Tour make_tour()
+// the width of the console, the COLUMNS variable or 100 when the output is not a console
+int get_columns()
 {
-    return {
-        "Tour ticket prices from miami",
-        {
-            {
-                "Colombia",
-                {
-                    {"Bogota", 8778000, 400.98},
-                    {"Cali", 2401000, 424.44},
-                    {"Medellin", 2464000, 350.98},
-                    {"Cartagena", 972000, 345.34}
-                }
-            },
-            {
-                "Brazil",
-                {
-                    {"Rio De Janiero", 135000000, 567.45},
-                    {"Sao Paulo", 11310000, 975.45},
-                    {"Salvador", 182340000, 855.99}
-                }
-            },
-            {
-                "Chile",
-                {
-                    {"Valdivia", 260000, 569.45},
-                    {"Santiago", 7040000, 444.98}
-                }
-            },
-            {
-                "Argentian",
-                {
-                    {"Buenos Aires", 3010000, 339.45}
-                }
-            }
-        }
-    };
+#if defined(_WIN32)
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+        return csbi.srWindow.Right - csbi.srWindow.Left + 1;
+#else
+    struct winsize size;
+    if (::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0)
+        return size.ws_col;
+#endif
+
+    const char *columns = std::getenv("COLUMNS");
+    if (columns != nullptr && std::atoi(columns) > 0)
+        return std::atoi(columns);
+    return 100;
 }
 
 int main()
 {
-    Tour tours = make_tour();
+    // the report reads the flat columns, see Tour_table.h
+#if defined(HAS_TOUR_DATA)
+    const Tour_table tours {tour_data};
+#else
+    const Tour_table tours {make_tour()};
+#endif
+    const int columns = get_columns();
 
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    int columns, rows;
-  
-    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
-    columns = csbi.srWindow.Right - csbi.srWindow.Left + 1;
-    rows = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
-    
-    std::cout << std::setw((columns / 2) + (tours.title.length() / 2)) << tours.title << std::endl << std::endl;
-    std::cout << std::setw(columns / 4) << std::left << "Country" 
-        << std::setw(columns / 4) << std::left << "City" 
-        << std::setw(columns / 4) << std::right << "Population" 
-        << std::setw(columns / 4) << std::right << "Price" << std::endl;
-    std::cout << std::setw(columns) << std::left << std::setfill('=') << "" << std::endl;
-    std::cout << std::setfill(' ');
-    for (const auto &country : tours.countries)
+    // every line is formatted into one Line_buffer, see Format.h, and handed to a
+    // writer that writes the previous lines on a background thread, see Async_writer.h.
+    Async_writer writer {std::cout};
+    Line_buffer line;
+    const std::size_t width = columns / 4;
+
+    line.text(tours.get_title(), (columns / 2) + (tours.get_title().length() / 2)).newline().newline();
+    line.text("Country", width, Align::Left)
+        .text("City", width, Align::Left)
+        .text("Population", width)
+        .text("Price", width)
+        .newline();
+    line.repeat('=', columns).newline();
+    writer.write(line.view());
+
+    for (std::size_t country {0}; country < tours.get_num_countries(); country++)
     {
-        for (size_t i {0}; i < country.cities.size(); i++)
+        const std::size_t first = tours.get_first_city(country);
+        for (std::size_t city {first}; city < tours.get_first_city(country + 1); city++)
         {
-            std::cout << std::setw(columns / 4) << std::left << (i == 0 ? country.name : "")
-                << std::setw(columns / 4) << std::left << country.cities.at(i).name 
-                << std::setw(columns / 4) << std::right << country.cities.at(i).population
-                << std::setw(columns / 4) << std::right << country.cities.at(i).cost << std::endl;
+            line.clear();
+            line.text(city == first ? tours.get_country_name(country) : "", width, Align::Left)
+                .text(tours.get_city_name(city), width, Align::Left)
+                .integer(tours.get_population(city), width)
+                .general(tours.get_cost(city), 6, width)
+                .newline();
+            writer.write(line.view());
         }
     }
+
+    // the aggregates per country, each one a scan of one column
+    line.clear();
+    line.newline();
+    line.text("Country", width, Align::Left)
+        .text("Population", width)
+        .text("Lowest price", width)
+        .text("Highest price", width)
+        .newline();
+    line.repeat('=', columns).newline();
+    writer.write(line.view());
+
+    for (std::size_t country {0}; country < tours.get_num_countries(); country++)
+    {
+        line.clear();
+        line.text(tours.get_country_name(country), width, Align::Left)
+            .integer(tours.total_population(country), width)
+            .general(tours.min_cost(country), 6, width)
+            .general(tours.max_cost(country), 6, width)
+            .newline();
+        writer.write(line.view());
+    }
+
+    // the same columns encoded, see Tour_columns.h, the totals come from the encoded values
+    std::vector<std::int64_t> populations;
+    std::vector<double> costs;
+    for (std::size_t city {0}; city < tours.get_num_cities(); city++)
+    {
+        populations.push_back(tours.get_population(city));
+        costs.push_back(tours.get_cost(city));
+    }
+    const Packed_column packed_populations {populations};
+    const Fixed_column fixed_costs {costs};
+    line.clear();
+    line.newline()
+        .text("Packed: population ").integer(packed_populations.sum(0, packed_populations.size()))
+        .text(", prices ").general(fixed_costs.min(0, fixed_costs.size()), 6)
+        .text(" to ").general(fixed_costs.max(0, fixed_costs.size()), 6)
+        .text(", ").integer(packed_populations.get_bytes() + fixed_costs.get_bytes())
+        .text(" bytes against ").integer(tours.get_num_cities() * 16)
+        .newline();
+    writer.write(line.view());
+
+    writer.flush();
     
     return 0;
 }
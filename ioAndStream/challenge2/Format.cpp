@@ -0,0 +1,88 @@
+#include "Format.h"
+
+Line_buffer::Line_buffer(std::size_t capacity)
+{
+    this->buff.reserve(capacity);
+}
+
+Line_buffer &Line_buffer::pad(const char *text, std::size_t length, std::size_t width, Align align, char fill)
+{
+    std::size_t padding = length < width ? width - length : 0;
+
+    if (align == Align::Right)
+        this->buff.append(padding, fill);
+    this->buff.append(text, length);
+    if (align == Align::Left)
+        this->buff.append(padding, fill);
+
+    return *this;
+}
+
+Line_buffer &Line_buffer::floating(double value, std::chars_format format, int precision, std::size_t width, Align align, char fill)
+{
+    char digits[number_size];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, format, precision);
+    return this->pad(digits, static_cast<std::size_t>(result.ptr - digits), width, align, fill);
+}
+
+Line_buffer &Line_buffer::text(std::string_view text, std::size_t width, Align align, char fill)
+{
+    return this->pad(text.data(), text.size(), width, align, fill);
+}
+
+// the stream treats precision 0 in the default format as 1, so does %g
+Line_buffer &Line_buffer::general(double value, int precision, std::size_t width, Align align, char fill)
+{
+    return this->floating(value, std::chars_format::general, precision == 0 ? 1 : precision, width, align, fill);
+}
+
+Line_buffer &Line_buffer::fixed(double value, int precision, std::size_t width, Align align, char fill)
+{
+    return this->floating(value, std::chars_format::fixed, precision, width, align, fill);
+}
+
+Line_buffer &Line_buffer::scientific(double value, int precision, std::size_t width, Align align, char fill)
+{
+    return this->floating(value, std::chars_format::scientific, precision, width, align, fill);
+}
+
+Line_buffer &Line_buffer::repeat(char ch, std::size_t count)
+{
+    this->buff.append(count, ch);
+    return *this;
+}
+
+Line_buffer &Line_buffer::newline()
+{
+    this->buff.push_back('\n');
+    return *this;
+}
+
+std::string_view Line_buffer::view() const
+{
+    return this->buff;
+}
+
+std::size_t Line_buffer::size() const
+{
+    return this->buff.size();
+}
+
+void Line_buffer::clear()
+{
+    this->buff.clear();
+}
+
+bool parse_integer(std::string_view text, long long &value)
+{
+    const char *end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc{} && result.ptr == end;
+}
+
+bool parse_double(std::string_view text, double &value)
+{
+    const char *end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc{} && result.ptr == end;
+}
@@ -0,0 +1,76 @@
+#ifndef _FORMAT_H_
+#define _FORMAT_H_
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*
+
+    - Line_buffer formats a line of a report into a buffer it keeps between lines, there
+      are no stream flags to set and reset, every call says its own width and alignment.
+
+    - numbers go through std::to_chars, the output is byte for byte what the stream gives
+      for the same width, fill and precision:
+        integer(n, 10)               std::setw(10) << n
+        general(x, 6, 15)            std::setw(15) << x  (the default float format)
+        fixed(x, 1, 15)              std::setw(15) << std::fixed << std::setprecision(1) << x
+        text(s, 15, Align::Left)     std::setw(15) << std::left << s
+
+    - parse_integer and parse_double read a number back with std::from_chars.
+
+*/
+enum class Align
+{
+    Left,
+    Right
+};
+
+class Line_buffer
+{
+private:
+    std::string buff;
+
+    // the longest number to_chars writes here, a fixed double of 1e308 with some decimals
+    static constexpr std::size_t number_size = 400;
+
+    Line_buffer &pad(const char *text, std::size_t length, std::size_t width, Align align, char fill);
+    Line_buffer &floating(double value, std::chars_format format, int precision, std::size_t width, Align align, char fill);
+
+public:
+    explicit Line_buffer(std::size_t capacity = 256);
+
+    Line_buffer &text(std::string_view text, std::size_t width = 0, Align align = Align::Right, char fill = ' ');
+
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    Line_buffer &integer(T value, std::size_t width = 0, Align align = Align::Right, char fill = ' ');
+
+    Line_buffer &general(double value, int precision = 6, std::size_t width = 0, Align align = Align::Right, char fill = ' ');
+    Line_buffer &fixed(double value, int precision, std::size_t width = 0, Align align = Align::Right, char fill = ' ');
+    Line_buffer &scientific(double value, int precision, std::size_t width = 0, Align align = Align::Right, char fill = ' ');
+
+    Line_buffer &repeat(char ch, std::size_t count);
+    Line_buffer &newline();
+
+    std::string_view view() const;
+    std::size_t size() const;
+
+    // empties the line and keeps the memory for the next one
+    void clear();
+};
+
+template<typename T, typename>
+Line_buffer &Line_buffer::integer(T value, std::size_t width, Align align, char fill)
+{
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    return this->pad(digits, static_cast<std::size_t>(result.ptr - digits), width, align, fill);
+}
+
+// false unless all of text is the number
+bool parse_integer(std::string_view text, long long &value);
+bool parse_double(std::string_view text, double &value);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _QUIZ_GRADER_H_
+#define _QUIZ_GRADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - the batch mode of the grader, for files with millions of responses.
+
+    - grade reads the whole responses text at once, the first word is the answer key, then
+      every student is a name and an answer, an answer counts only when it has the length
+      of the key, like get_score.
+
+    - answers are compared 16 characters at a time with SSE2 (a byte equality mask and a
+      popcount), the scores, their sum and the histogram are collected in the same pass.
+
+    - write_report formats the whole table into one Line_buffer (see Format.h) and writes
+      it once, with the same columns print_student and the others produce, then the histogram.
+
+*/
+struct Grade_report
+{
+    std::string_view key;
+    std::vector<std::string_view> names;  // views into the graded text
+    std::vector<int> scores;
+    std::vector<std::uintmax_t> histogram;  // students per score, 0 to the key length
+    std::int64_t total;
+
+    double get_average() const;
+};
+
+// the number of positions where a and b have the same character
+std::size_t count_equal(const char *a, const char *b, std::size_t length);
+
+// the report points into text, text must outlive it
+Grade_report grade(std::string_view text);
+
+void write_report(const Grade_report &report, std::ostream &os);
+
+#endif
@@ -1,32 +1,44 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <iomanip>
+#include <sstream>
+#include "Format.h"
+#include "Quiz_grader.h"
+
+// every print function keeps its Line_buffer between calls, see Format.h, no stream flags to set and reset
+void print(Line_buffer &line)
+{
+    std::cout.write(line.view().data(), static_cast<std::streamsize>(line.size()));
+    std::cout.flush();
+    line.clear();
+}
 
 void print_header()
 {
-    std::cout << std::setw(15) << std::left << "Name" 
-        << std::setw(15) << std::right << "Score"
-        << std::endl;
+    static Line_buffer line;
+    line.text("Name", 15, Align::Left).text("Score", 15).newline();
+    print(line);
 }
 
 void print_line()
 {
-    std::cout << std::setw(30) << std::setfill('-') << "" << std::endl;
-    std::cout << std::setfill(' ');
+    static Line_buffer line;
+    line.repeat('-', 30).newline();
+    print(line);
 }
 
 void print_student(const std::string &name, const int &score)
 {
-    std::cout << std::setw(15) << std::left << name
-        << std::setw(15) << std::right << score << std::endl;
+    static Line_buffer line;
+    line.text(name, 15, Align::Left).integer(score, 15).newline();
+    print(line);
 }
 
 void print_average_score(const double &average_score)
 {
-    std::cout << std::setprecision(1) << std::fixed;
-    std::cout << std::setw(15) << std::left << "Average score: " 
-        << std::setw(15) << std::right << average_score << std::endl;
+    static Line_buffer line;
+    line.text("Average score: ", 15, Align::Left).fixed(average_score, 1, 15).newline();
+    print(line);
 }
 
 int get_score(const std::string &default_answer, const std::string &answer)
@@ -40,8 +52,36 @@ int get_score(const std::string &default_answer, const std::string &answer)
     return score;
 }
 
-int main()
+/*
+
+    ./a.out                       grades responses.txt student by student
+    ./a.out --batch [responses]   grades the whole file at once, see Quiz_grader.h
+
+*/
+int grade_batch(const char *path)
 {
+    std::ifstream in_file {path, std::ios::binary};
+
+    if (!in_file.is_open())
+    {
+        std::cout << "The file is not found." << std::endl;
+        return 1;
+    }
+
+    std::ostringstream text;
+    text << in_file.rdbuf();
+    std::string responses = std::move(text).str();
+
+    write_report(grade(responses), std::cout);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string{argv[1]} == "--batch")
+        return grade_batch(argc > 2 ? argv[2] : "responses.txt");
+
     std::ifstream in_file;
     std::string default_answer;
     std::string name;
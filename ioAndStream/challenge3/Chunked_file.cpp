@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Chunked_file.h"
+#include "../compressedStream/Compressed_stream.h"
+
+namespace
+{
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+}
+
+Chunked_file::Chunked_file(const std::string &path, std::size_t num_chunks)
+    : fd{-1}, data{nullptr}, size{0}, mapped{false}
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+        fail("open " + path);
+
+    struct stat st;
+    if (::fstat(this->fd, &st) < 0)
+    {
+        int error = errno;
+        ::close(this->fd);
+        errno = error;
+        fail("stat " + path);
+    }
+    this->size = static_cast<std::size_t>(st.st_size);
+
+    // an empty file can't be mapped, and has nothing to split
+    if (this->size > 0)
+    {
+        void *ptr = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(this->fd);
+            errno = error;
+            fail("mmap " + path);
+        }
+        this->data = static_cast<const char *>(ptr);
+        this->mapped = true;
+        ::madvise(ptr, this->size, MADV_SEQUENTIAL);
+
+        if (detect_codec(std::string_view{this->data, std::min<std::size_t>(this->size, 6)}) != Codec::plain)
+        {
+            ::munmap(ptr, this->size);
+            this->mapped = false;
+            try
+            {
+                this->decompressed = Compressed_reader{path}.read_all();
+            }
+            catch (...)
+            {
+                ::close(this->fd);
+                throw;
+            }
+            this->data = this->decompressed.data();
+            this->size = this->decompressed.size();
+        }
+    }
+
+    if (num_chunks == 0)
+        num_chunks = std::max(1u, std::thread::hardware_concurrency());
+    this->split(num_chunks);
+}
+
+Chunked_file::Chunked_file(const char *text, std::size_t size, std::size_t num_chunks)
+    : fd{-1}, data{text}, size{size}, mapped{false}
+{
+    if (num_chunks == 0)
+        num_chunks = std::max(1u, std::thread::hardware_concurrency());
+    this->split(num_chunks);
+}
+
+Chunked_file::~Chunked_file()
+{
+    if (this->mapped)
+        ::munmap(const_cast<char *>(this->data), this->size);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+// every chunk ends after the first '\n' at or past its even share, a chunk without
+// one runs to the end of the file, so there may be fewer chunks than asked for.
+void Chunked_file::split(std::size_t num_chunks)
+{
+    std::size_t begin = 0;
+    const std::size_t share = (this->size + num_chunks - 1) / num_chunks;
+
+    while (begin < this->size)
+    {
+        std::size_t end = std::min(this->size, begin + std::max<std::size_t>(share, 1));
+
+        if (end < this->size)
+        {
+            const void *newline = std::memchr(this->data + end - 1, '\n', this->size - end + 1);
+            end = newline == nullptr ? this->size : static_cast<std::size_t>(static_cast<const char *>(newline) - this->data) + 1;
+        }
+
+        this->chunks.push_back(Chunk{this->chunks.size(), begin, std::string_view{this->data + begin, end - begin}});
+        begin = end;
+    }
+}
+
+std::string_view Chunked_file::get_text() const
+{
+    return std::string_view{this->data, this->size};
+}
+
+std::size_t Chunked_file::get_size() const
+{
+    return this->size;
+}
+
+const std::vector<Chunk> &Chunked_file::get_chunks() const
+{
+    return this->chunks;
+}
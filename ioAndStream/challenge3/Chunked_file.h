@@ -0,0 +1,104 @@
+#ifndef _CHUNKED_FILE_H_
+#define _CHUNKED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+
+    - Chunked_file maps a whole file and splits it into byte ranges that start just
+      after a '\n', so no line, and no word, is cut between two chunks.
+
+    - map runs a function on every chunk, each on its own thread, and returns the
+      results in the order of the chunks, the caller merges them, e.g. a line count
+      of the chunks before gives the first line number of a chunk. an exception thrown
+      on a chunk is thrown again by map after every thread has ended.
+
+    - the file is only read, the chunks are views into the mapping and live as long
+      as the Chunked_file. errors throw std::runtime_error.
+
+    - a compressed file, lz4, is decompressed into memory on the thread of a
+      Compressed_reader (../compressedStream/Compressed_stream.h) and split the same way,
+      the chunks are views into the text.
+
+    - a text that is in memory already, e.g. one embedded in the program at build time,
+      see ../embeddedData, is split the same way, it is not copied and has to outlive the
+      Chunked_file.
+
+*/
+struct Chunk
+{
+    std::size_t index;
+    std::uintmax_t offset;  // where the chunk starts in the file
+    std::string_view text;
+};
+
+class Chunked_file
+{
+private:
+    int fd;
+    const char *data;
+    std::size_t size;
+    bool mapped;
+    std::string decompressed;
+    std::vector<Chunk> chunks;
+
+    void split(std::size_t num_chunks);
+
+public:
+    // num_chunks 0 is one chunk per hardware thread, an empty file has no chunk
+    explicit Chunked_file(const std::string &path, std::size_t num_chunks = 0);
+    Chunked_file(const char *text, std::size_t size, std::size_t num_chunks);
+    ~Chunked_file();
+
+    Chunked_file(const Chunked_file &) = delete;
+    Chunked_file &operator=(const Chunked_file &) = delete;
+
+    std::string_view get_text() const;
+    std::size_t get_size() const;
+    const std::vector<Chunk> &get_chunks() const;
+
+    template<typename Function>
+    auto map(Function function) const -> std::vector<decltype(function(std::declval<const Chunk &>()))>;
+};
+
+template<typename Function>
+auto Chunked_file::map(Function function) const -> std::vector<decltype(function(std::declval<const Chunk &>()))>
+{
+    using Result = decltype(function(std::declval<const Chunk &>()));
+
+    std::vector<Result> results(this->chunks.size());
+    std::vector<std::exception_ptr> errors(this->chunks.size());
+    std::vector<std::thread> threads;
+    threads.reserve(this->chunks.size());
+
+    // every thread writes only its own result and error, join in order
+    for (const Chunk &chunk : this->chunks)
+        threads.emplace_back([&results, &errors, &function, &chunk]
+        {
+            try
+            {
+                results[chunk.index] = function(chunk);
+            }
+            catch (...)
+            {
+                errors[chunk.index] = std::current_exception();
+            }
+        });
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (const std::exception_ptr &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    return results;
+}
+
+#endif
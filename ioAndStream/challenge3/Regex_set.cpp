@@ -0,0 +1,777 @@
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include "Chunked_file.h"
+#include "Regex_set.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    using Byte_set = std::bitset<256>;
+
+    constexpr std::size_t npos = std::string_view::npos;
+    constexpr std::size_t max_states = 100000;
+    constexpr std::size_t max_literals = 16;
+    constexpr std::size_t max_literal_length = 8;
+    constexpr std::size_t max_first_bytes = 4;
+
+    // same characters as std::isspace in the "C" locale, the ones operator>> skips
+    inline bool is_space(unsigned char c)
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+
+    struct Node
+    {
+        enum Kind
+        {
+            set,
+            concatenation,
+            alternation,  // of the first and the second child
+            star,
+            plus,
+            optional
+        };
+
+        Kind kind;
+        std::size_t set_index;
+        std::vector<Node> children;
+    };
+
+    class Parser
+    {
+    private:
+        std::string_view pattern;
+        std::size_t at;
+        std::vector<Byte_set> &sets;
+
+        [[noreturn]] void fail(const std::string &what) const
+        {
+            throw std::invalid_argument("the pattern " + std::string{this->pattern} + ": " + what + " at "
+                + std::to_string(this->at));
+        }
+
+        bool more() const { return this->at < this->pattern.size(); }
+        char peek() const { return this->pattern[this->at]; }
+
+        Node set_node(const Byte_set &set)
+        {
+            this->sets.push_back(set);
+            return Node{Node::set, this->sets.size() - 1, {}};
+        }
+
+        Byte_set escaped(char c) const
+        {
+            Byte_set set;
+            if (c == 'd' || c == 'w')
+            {
+                for (int b = '0'; b <= '9'; ++b)
+                    set.set(static_cast<std::size_t>(b));
+                if (c == 'w')
+                {
+                    for (int b = 'a'; b <= 'z'; ++b)
+                        set.set(static_cast<std::size_t>(b)).set(static_cast<std::size_t>(b - 'a' + 'A'));
+                    set.set('_');
+                }
+            }
+            else
+                set.set(static_cast<unsigned char>(c));
+            return set;
+        }
+
+        Byte_set bracket()
+        {
+            Byte_set set;
+            const bool negated = this->more() && this->peek() == '^';
+            if (negated)
+                ++this->at;
+
+            bool first = true;
+            while (this->more() && (this->peek() != ']' || first))
+            {
+                first = false;
+                unsigned char low = static_cast<unsigned char>(this->pattern[this->at++]);
+                if (low == '\\')
+                {
+                    if (!this->more())
+                        this->fail("a \\ at the end");
+                    const char c = this->pattern[this->at++];
+                    if (c == 'd' || c == 'w')
+                    {
+                        set |= this->escaped(c);
+                        continue;
+                    }
+                    low = static_cast<unsigned char>(c);
+                }
+
+                unsigned char high = low;
+                if (this->at + 1 < this->pattern.size() && this->peek() == '-' && this->pattern[this->at + 1] != ']')
+                {
+                    high = static_cast<unsigned char>(this->pattern[this->at + 1]);
+                    this->at += 2;
+                    if (high == '\\')
+                    {
+                        if (!this->more())
+                            this->fail("a \\ at the end");
+                        high = static_cast<unsigned char>(this->pattern[this->at++]);
+                    }
+                    if (high < low)
+                        this->fail("a range from a higher character");
+                }
+                for (unsigned b = low; b <= high; ++b)
+                    set.set(b);
+            }
+            if (!this->more())
+                this->fail("a [ without ]");
+            ++this->at;
+            return negated ? ~set : set;
+        }
+
+        Node atom()
+        {
+            const char c = this->pattern[this->at++];
+            switch (c)
+            {
+            case '(':
+            {
+                Node inside = this->alternation();
+                if (!this->more() || this->peek() != ')')
+                    this->fail("a ( without )");
+                ++this->at;
+                return inside;
+            }
+            case '[':
+                return this->set_node(this->bracket());
+            case '.':
+                return this->set_node(Byte_set{}.set());
+            case '\\':
+                if (!this->more())
+                    this->fail("a \\ at the end");
+                return this->set_node(this->escaped(this->pattern[this->at++]));
+            case '*':
+            case '+':
+            case '?':
+                --this->at;
+                this->fail("nothing to repeat");
+            case '^':
+            case '$':
+                --this->at;
+                this->fail(std::string{c} + " in the middle");
+            default:
+                return this->set_node(Byte_set{}.set(static_cast<unsigned char>(c)));
+            }
+        }
+
+        Node repetition()
+        {
+            Node node = this->atom();
+            while (this->more() && (this->peek() == '*' || this->peek() == '+' || this->peek() == '?'))
+            {
+                const char c = this->pattern[this->at++];
+                const Node::Kind kind = c == '*' ? Node::star : c == '+' ? Node::plus : Node::optional;
+                node = Node{kind, 0, {std::move(node)}};
+            }
+            return node;
+        }
+
+        Node concatenation()
+        {
+            Node node {Node::concatenation, 0, {}};
+            while (this->more() && this->peek() != '|' && this->peek() != ')')
+                node.children.push_back(this->repetition());
+            return node;
+        }
+
+        Node alternation()
+        {
+            Node node = this->concatenation();
+            while (this->more() && this->peek() == '|')
+            {
+                ++this->at;
+                node = Node{Node::alternation, 0, {std::move(node), this->concatenation()}};
+            }
+            return node;
+        }
+
+    public:
+        Parser(std::string_view pattern, std::vector<Byte_set> &sets) : pattern{pattern}, at{0}, sets{sets}
+        {
+        }
+
+        Node parse()
+        {
+            Node node = this->alternation();
+            if (this->more())
+                this->fail("a ) without (");
+            return node;
+        }
+    };
+
+    /*
+
+        - the literals a match of a node starts with, exact when the node matches only them,
+          so a concatenation goes on into its next child. a set of up to 4 bytes is a
+          literal of each, a repetition that can be empty has none, the empty string.
+
+    */
+    struct Literals
+    {
+        std::vector<std::string> strings;
+        bool exact;
+    };
+
+    Literals literals_of(const Node &node, const std::vector<Byte_set> &sets)
+    {
+        switch (node.kind)
+        {
+        case Node::set:
+        {
+            const Byte_set &set = sets[node.set_index];
+            if (set.count() == 0 || set.count() > max_first_bytes)
+                return Literals{{""}, false};
+            Literals literals {{}, true};
+            for (unsigned b = 0; b < 256; ++b)
+                if (set.test(b))
+                    literals.strings.push_back(std::string(1, static_cast<char>(b)));
+            return literals;
+        }
+        case Node::concatenation:
+        {
+            Literals literals {{""}, true};
+            for (const Node &child : node.children)
+            {
+                const Literals next = literals_of(child, sets);
+                if (literals.strings.size() * next.strings.size() > max_literals)
+                {
+                    literals.exact = false;
+                    break;
+                }
+                std::vector<std::string> joined;
+                bool cut = false;
+                for (const std::string &head : literals.strings)
+                    for (const std::string &tail : next.strings)
+                    {
+                        cut = cut || head.size() + tail.size() > max_literal_length;
+                        joined.push_back((head + tail).substr(0, max_literal_length));
+                    }
+                literals.strings = std::move(joined);
+                literals.exact = next.exact && !cut;
+                if (!literals.exact)
+                    break;
+            }
+            return literals;
+        }
+        case Node::alternation:
+        {
+            Literals literals = literals_of(node.children[0], sets);
+            const Literals other = literals_of(node.children[1], sets);
+            if (literals.strings.size() + other.strings.size() > max_literals)
+                return Literals{{""}, false};
+            literals.strings.insert(literals.strings.end(), other.strings.begin(), other.strings.end());
+            literals.exact = literals.exact && other.exact;
+            return literals;
+        }
+        case Node::plus:
+        {
+            Literals literals = literals_of(node.children[0], sets);
+            literals.exact = false;
+            return literals;
+        }
+        default:
+            return Literals{{""}, false};
+        }
+    }
+
+    /*
+
+        - a Thompson NFA, every state is a byte set with one arrow, the end of a word, the
+          match of a pattern, or an epsilon state with up to two arrows. a fragment ends in
+          an epsilon state with no arrow yet, the next fragment goes there.
+
+    */
+    constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+    constexpr int epsilon = -1;
+    constexpr int word_end = -2;
+    constexpr int match = -3;  // the pattern is in out
+
+    struct Nfa_state
+    {
+        int set;
+        std::uint32_t out;
+        std::uint32_t out2;
+    };
+
+    struct Fragment
+    {
+        std::uint32_t start;
+        std::uint32_t end;
+    };
+
+    class Nfa
+    {
+    public:
+        std::vector<Nfa_state> states;
+
+        std::uint32_t add(int set, std::uint32_t out = none, std::uint32_t out2 = none)
+        {
+            this->states.push_back(Nfa_state{set, out, out2});
+            return static_cast<std::uint32_t>(this->states.size() - 1);
+        }
+
+        Fragment compile(const Node &node)
+        {
+            switch (node.kind)
+            {
+            case Node::set:
+            {
+                const std::uint32_t end = this->add(epsilon);
+                return Fragment{this->add(static_cast<int>(node.set_index), end), end};
+            }
+            case Node::concatenation:
+            {
+                if (node.children.empty())
+                {
+                    const std::uint32_t state = this->add(epsilon);
+                    return Fragment{state, state};
+                }
+                Fragment fragment = this->compile(node.children[0]);
+                for (std::size_t i = 1; i < node.children.size(); ++i)
+                {
+                    const Fragment next = this->compile(node.children[i]);
+                    this->states[fragment.end].out = next.start;
+                    fragment.end = next.end;
+                }
+                return fragment;
+            }
+            case Node::alternation:
+            {
+                const Fragment first = this->compile(node.children[0]);
+                const Fragment second = this->compile(node.children[1]);
+                const std::uint32_t end = this->add(epsilon);
+                this->states[first.end].out = end;
+                this->states[second.end].out = end;
+                return Fragment{this->add(epsilon, first.start, second.start), end};
+            }
+            case Node::star:
+            {
+                const Fragment inside = this->compile(node.children[0]);
+                const std::uint32_t end = this->add(epsilon);
+                const std::uint32_t split = this->add(epsilon, inside.start, end);
+                this->states[inside.end].out = split;
+                return Fragment{split, end};
+            }
+            case Node::plus:
+            {
+                const Fragment inside = this->compile(node.children[0]);
+                const std::uint32_t end = this->add(epsilon);
+                this->states[inside.end].out = this->add(epsilon, inside.start, end);
+                return Fragment{inside.start, end};
+            }
+            case Node::optional:
+            default:
+            {
+                const Fragment inside = this->compile(node.children[0]);
+                const std::uint32_t end = this->add(epsilon);
+                this->states[inside.end].out = end;
+                return Fragment{this->add(epsilon, inside.start, end), end};
+            }
+            }
+        }
+
+        // the states reached over epsilon arrows that are not epsilon themselves, sorted
+        std::vector<std::uint32_t> closure(std::vector<std::uint32_t> stack, std::vector<std::uint32_t> &seen,
+            std::uint32_t stamp) const
+        {
+            std::vector<std::uint32_t> result;
+            while (!stack.empty())
+            {
+                const std::uint32_t state = stack.back();
+                stack.pop_back();
+                if (state == none || seen[state] == stamp)
+                    continue;
+                seen[state] = stamp;
+                const Nfa_state &nfa_state = this->states[state];
+                if (nfa_state.set != epsilon)
+                {
+                    result.push_back(state);
+                    continue;
+                }
+                stack.push_back(nfa_state.out);
+                stack.push_back(nfa_state.out2);
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+    };
+}
+
+Regex_set::Regex_set(std::vector<std::string> patterns, bool prefilter)
+    : patterns{std::move(patterns)}, classes{}, num_classes{0}, row_shift{0}
+{
+    this->compile(prefilter);
+}
+
+/*
+
+    - a pattern is [.*] R [.*] $ with the .* where it is not tied, $ the end of the word,
+      so a state holds whether a pattern matched so far, and the patterns of a word are
+      the ones of its state followed by the end.
+
+    - the classes are the bytes that are in the same sets, the whitespaces are class 0 on
+      their own, a word has none of them. the subset construction follows one byte of
+      every class, Moore's minimization starts from the patterns the end gives and splits
+      states by the groups of their next states until nothing splits.
+
+*/
+void Regex_set::compile(bool prefilter)
+{
+    std::vector<Byte_set> sets;
+    Nfa nfa;
+    std::vector<std::uint32_t> starts;
+    bool all_literals = prefilter && !this->patterns.empty();
+    std::vector<std::string> literals;
+
+    const std::size_t any = sets.size();
+    sets.push_back(Byte_set{}.set());
+    for (std::size_t p = 0; p < this->patterns.size(); ++p)
+    {
+        std::string_view pattern = this->patterns[p];
+        const bool tied_start = !pattern.empty() && pattern.front() == '^';
+        if (tied_start)
+            pattern.remove_prefix(1);
+
+        // a $ after an odd number of \ is a character
+        std::size_t backslashes = 0;
+        while (backslashes + 1 < pattern.size() && pattern[pattern.size() - 2 - backslashes] == '\\')
+            ++backslashes;
+        const bool tied_end = !pattern.empty() && pattern.back() == '$' && backslashes % 2 == 0;
+        if (tied_end)
+            pattern.remove_suffix(1);
+
+        const Node node = Parser{pattern, sets}.parse();
+        const Literals node_literals = literals_of(node, sets);
+        for (const std::string &literal : node_literals.strings)
+        {
+            if (literal.empty())
+                all_literals = false;
+            literals.push_back(literal);
+        }
+
+        const Fragment fragment = nfa.compile(node);
+        std::uint32_t start = fragment.start;
+        if (!tied_start)
+        {
+            const std::uint32_t loop = nfa.add(epsilon, none, fragment.start);
+            nfa.states[loop].out = nfa.add(static_cast<int>(any), loop);
+            start = loop;
+        }
+        const std::uint32_t end = nfa.add(word_end, nfa.add(match, static_cast<std::uint32_t>(p)));
+        if (tied_end)
+            nfa.states[fragment.end].out = end;
+        else
+        {
+            const std::uint32_t loop = nfa.add(epsilon, none, end);
+            nfa.states[loop].out = nfa.add(static_cast<int>(any), loop);
+            nfa.states[fragment.end].out = loop;
+        }
+        starts.push_back(start);
+    }
+
+    // the byte classes, a byte of every class follows the arrows of its class
+    std::map<std::vector<bool>, std::uint8_t> signatures;
+    std::vector<unsigned> representatives {' '};
+    for (unsigned b = 0; b < 256; ++b)
+    {
+        if (is_space(static_cast<unsigned char>(b)))
+        {
+            this->classes[b] = 0;
+            continue;
+        }
+        std::vector<bool> signature(sets.size());
+        for (std::size_t s = 0; s < sets.size(); ++s)
+            signature[s] = sets[s].test(b);
+        const auto inserted = signatures.emplace(std::move(signature), static_cast<std::uint8_t>(signatures.size() + 1));
+        if (inserted.second)
+            representatives.push_back(b);
+        this->classes[b] = inserted.first->second;
+    }
+    this->num_classes = signatures.size() + 1;
+
+    // the subset construction, state 0 is the empty set, no pattern can match any more
+    std::vector<std::uint32_t> seen(nfa.states.size(), 0);
+    std::uint32_t stamp = 0;
+    std::map<std::vector<std::uint32_t>, std::uint32_t> ids;
+    std::vector<std::vector<std::uint32_t>> dfa_sets;
+    std::vector<std::uint32_t> next;
+    std::vector<std::vector<std::uint32_t>> ends;
+
+    const auto id_of = [&ids, &dfa_sets](std::vector<std::uint32_t> set)
+    {
+        const auto inserted = ids.emplace(set, static_cast<std::uint32_t>(dfa_sets.size()));
+        if (inserted.second)
+        {
+            if (dfa_sets.size() == max_states)
+                throw std::runtime_error("the patterns need more than " + std::to_string(max_states) + " states");
+            dfa_sets.push_back(std::move(set));
+        }
+        return inserted.first->second;
+    };
+    id_of({});
+    const std::uint32_t start = id_of(nfa.closure(starts, seen, ++stamp));
+
+    for (std::size_t state = 0; state < dfa_sets.size(); ++state)
+    {
+        next.resize((state + 1) * this->num_classes, 0);
+        for (std::size_t c = 1; c < this->num_classes; ++c)
+        {
+            std::vector<std::uint32_t> moved;
+            for (const std::uint32_t nfa_state : dfa_sets[state])
+            {
+                const Nfa_state &from = nfa.states[nfa_state];
+                if (from.set >= 0 && sets[static_cast<std::size_t>(from.set)].test(representatives[c]))
+                    moved.push_back(from.out);
+            }
+            const std::uint32_t id = id_of(nfa.closure(std::move(moved), seen, ++stamp));
+            next[state * this->num_classes + c] = id;
+        }
+
+        std::vector<std::uint32_t> moved;
+        for (const std::uint32_t nfa_state : dfa_sets[state])
+            if (nfa.states[nfa_state].set == word_end)
+                moved.push_back(nfa.states[nfa_state].out);
+        std::vector<std::uint32_t> matched;
+        for (const std::uint32_t nfa_state : nfa.closure(std::move(moved), seen, ++stamp))
+            matched.push_back(nfa.states[nfa_state].out);
+        std::sort(matched.begin(), matched.end());
+        ends.push_back(std::move(matched));
+    }
+
+    // Moore's minimization, a group is a state of the result
+    const std::size_t num_dfa = dfa_sets.size();
+    std::vector<std::uint32_t> group(num_dfa);
+    std::size_t num_groups = 0;
+    {
+        std::map<std::vector<std::uint32_t>, std::uint32_t> by_end;
+        for (std::size_t state = 0; state < num_dfa; ++state)
+            group[state] = by_end.emplace(ends[state], static_cast<std::uint32_t>(by_end.size())).first->second;
+        num_groups = by_end.size();
+    }
+    for (;;)
+    {
+        std::map<std::vector<std::uint32_t>, std::uint32_t> by_signature;
+        std::vector<std::uint32_t> split(num_dfa);
+        for (std::size_t state = 0; state < num_dfa; ++state)
+        {
+            std::vector<std::uint32_t> signature {group[state]};
+            for (std::size_t c = 1; c < this->num_classes; ++c)
+                signature.push_back(group[next[state * this->num_classes + c]]);
+            split[state] = by_signature.emplace(std::move(signature), static_cast<std::uint32_t>(by_signature.size())).first->second;
+        }
+        group = std::move(split);
+        if (by_signature.size() == num_groups)
+            break;
+        num_groups = by_signature.size();
+    }
+
+    // state 0 is between words, its arrows are the ones of the start, groups are 1 and on
+    while ((std::size_t{1} << this->row_shift) < this->num_classes)
+        ++this->row_shift;
+    const std::size_t num_states = num_groups + 1;
+    this->table.assign(num_states << this->row_shift, 0);
+    this->accept_begin.assign(num_states + 1, 0);
+    std::vector<std::vector<std::uint32_t>> group_ends(num_states);
+    std::vector<bool> done(num_states, false);
+    for (std::size_t state = 0; state < num_dfa; ++state)
+    {
+        const std::size_t row = group[state] + 1;
+        if (done[row])
+            continue;
+        done[row] = true;
+        group_ends[row] = ends[state];
+        for (std::size_t c = 1; c < this->num_classes; ++c)
+            this->table[(row << this->row_shift) + c] = (group[next[state * this->num_classes + c]] + 1) << this->row_shift;
+    }
+    const std::size_t start_row = group[start] + 1;
+    for (std::size_t c = 1; c < this->num_classes; ++c)
+        this->table[c] = this->table[(start_row << this->row_shift) + c];
+    for (std::size_t state = 0; state < num_states; ++state)
+    {
+        this->accepts.insert(this->accepts.end(), group_ends[state].begin(), group_ends[state].end());
+        this->accept_begin[state + 1] = static_cast<std::uint32_t>(this->accepts.size());
+    }
+
+    // the literals, when there are a few first bytes to look for
+    if (all_literals)
+    {
+        std::sort(literals.begin(), literals.end());
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+        std::string first;
+        for (const std::string &literal : literals)
+            if (first.find(literal[0]) == std::string::npos)
+                first += literal[0];
+        if (first.size() <= max_first_bytes && std::none_of(first.begin(), first.end(), [](char c)
+            {
+                return is_space(static_cast<unsigned char>(c));
+            }))
+        {
+            this->literals = std::move(literals);
+            this->first_bytes = std::move(first);
+        }
+    }
+}
+
+std::size_t Regex_set::size() const
+{
+    return this->patterns.size();
+}
+
+const std::string &Regex_set::get_pattern(std::size_t index) const
+{
+    return this->patterns[index];
+}
+
+std::size_t Regex_set::get_num_states() const
+{
+    return this->accept_begin.size() - 1;
+}
+
+std::size_t Regex_set::get_num_classes() const
+{
+    return this->num_classes;
+}
+
+bool Regex_set::has_prefilter() const
+{
+    return !this->literals.empty();
+}
+
+// the first place from from where one of the literals starts
+std::size_t Regex_set::find_literal(std::string_view text, std::size_t from) const
+{
+    const char *data = text.data();
+    const std::size_t size = text.size();
+    const auto literal_at = [this, data, size](std::size_t pos)
+    {
+        for (const std::string &literal : this->literals)
+            if (literal[0] == data[pos] && literal.size() <= size - pos
+                && std::memcmp(data + pos + 1, literal.data() + 1, literal.size() - 1) == 0)
+                return true;
+        return false;
+    };
+
+    std::size_t i = from;
+#if defined(__SSE2__)
+    __m128i firsts[max_first_bytes];
+    for (std::size_t f = 0; f < max_first_bytes; ++f)
+        firsts[f] = _mm_set1_epi8(this->first_bytes[f < this->first_bytes.size() ? f : 0]);
+
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i hits = _mm_cmpeq_epi8(chars, firsts[0]);
+        for (std::size_t f = 1; f < max_first_bytes; ++f)
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chars, firsts[f]));
+
+        for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)); mask != 0; mask &= mask - 1)
+        {
+            const std::size_t pos = i + static_cast<std::size_t>(__builtin_ctz(mask));
+            if (literal_at(pos))
+                return pos;
+        }
+    }
+#endif
+
+    for (; i < size; ++i)
+        if (this->first_bytes.find(data[i]) != std::string::npos && literal_at(i))
+            return i;
+    return npos;
+}
+
+void Regex_set::end_word(std::uint32_t row, Search_result &result, std::vector<std::uintmax_t> &matches) const
+{
+    const std::uint32_t state = row >> this->row_shift;
+    const std::uint32_t begin = this->accept_begin[state], end = this->accept_begin[state + 1];
+    result.words++;
+    if (begin == end)
+        return;
+    result.matches++;
+    for (std::uint32_t i = begin; i < end; ++i)
+        matches[this->accepts[i]]++;
+}
+
+Search_result Regex_set::search(std::string_view text, std::vector<std::uintmax_t> &matches) const
+{
+    matches.assign(this->patterns.size(), 0);
+    Search_result result {0, 0};
+    const std::uint32_t *table = this->table.data();
+
+    if (this->literals.empty())
+    {
+        std::uint32_t row = 0;
+        for (char ch : text)
+        {
+            const std::uint8_t c = this->classes[static_cast<unsigned char>(ch)];
+            if (c == 0)
+            {
+                if (row != 0)
+                    this->end_word(row, result, matches);
+                row = 0;
+                continue;
+            }
+            row = table[row + c];
+        }
+        if (row != 0)
+            this->end_word(row, result, matches);
+        return result;
+    }
+
+    // only the words with a literal go through the table, every word is counted
+    std::size_t pos = 0;
+    while ((pos = this->find_literal(text, pos)) != npos)
+    {
+        std::size_t begin = pos;
+        while (begin > 0 && !is_space(static_cast<unsigned char>(text[begin - 1])))
+            --begin;
+        std::size_t end = begin;
+        std::uint32_t row = 0;
+        for (; end < text.size() && !is_space(static_cast<unsigned char>(text[end])); ++end)
+            row = table[row + this->classes[static_cast<unsigned char>(text[end])]];
+        this->end_word(row, result, matches);
+        pos = end;
+    }
+    result.words = count_words(text);
+    return result;
+}
+
+Search_result Regex_set::search(const Chunked_file &file, std::vector<std::uintmax_t> &matches) const
+{
+    struct Chunk_result
+    {
+        Search_result counts;
+        std::vector<std::uintmax_t> matches;
+    };
+
+    std::vector<Chunk_result> results = file.map([this](const Chunk &chunk)
+    {
+        Chunk_result result {};
+        result.counts = this->search(chunk.text, result.matches);
+        return result;
+    });
+
+    Search_result total {0, 0};
+    matches.assign(this->patterns.size(), 0);
+    for (const Chunk_result &result : results)
+    {
+        total.words += result.counts.words;
+        total.matches += result.counts.matches;
+        for (std::size_t p = 0; p < matches.size(); ++p)
+            matches[p] += result.matches[p];
+    }
+    return total;
+}
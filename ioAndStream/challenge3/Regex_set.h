@@ -0,0 +1,66 @@
+#ifndef _REGEX_SET_H_
+#define _REGEX_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Word_search.h"
+
+/*
+
+    - Regex_set counts the words matching every one of a set of simple regexes, a word
+      matches when a part of it does, what std::regex_search on the word gives, ^ and $
+      tie a pattern to the start and the end of the word.
+
+    - the patterns are characters, ., [a-z] and [^a-z] classes, \d, \w and \ before a
+      character to take it as it is, ( ), |, *, + and ?, ^ only first and $ only last.
+      anything else throws std::invalid_argument.
+
+    - all the patterns compile into one DFA: a Thompson NFA for every pattern, with .*
+      around it when it is not tied, a subset construction and Moore's minimization. the
+      bytes the patterns can't tell apart share a class, so a state is a row of a few
+      classes, and the state at the end of a word has the patterns it matched. one table
+      lookup a character, a set bigger than 100000 states throws std::runtime_error.
+
+    - when every pattern starts with a literal, or one of a few, "Rom" for Rom(eo|ulus),
+      the text is scanned for the literals first, 16 bytes at once on the first bytes, and
+      only the words around a hit go through the DFA, the others are counted as words.
+
+    - the Chunked_file search runs every chunk on its own thread, like Pattern_set.
+
+*/
+class Regex_set
+{
+private:
+    std::vector<std::string> patterns;
+    std::uint8_t classes[256];             // 0 is the whitespaces, the end of a word
+    std::size_t num_classes;
+    unsigned row_shift;                    // a row is 1 << row_shift entries, the classes rounded up
+    std::vector<std::uint32_t> table;      // the row of the next state, state 0 is between words
+    std::vector<std::uint32_t> accept_begin;  // by state, into accepts
+    std::vector<std::uint32_t> accepts;    // the patterns matched by a word ending in a state
+    std::vector<std::string> literals;     // a matching word has one of them, empty without the prefilter
+    std::string first_bytes;
+
+    void compile(bool prefilter);
+    std::size_t find_literal(std::string_view text, std::size_t from) const;
+    void end_word(std::uint32_t row, Search_result &result, std::vector<std::uintmax_t> &matches) const;
+
+public:
+    // prefilter false runs every word through the DFA, for comparing it with the literals
+    explicit Regex_set(std::vector<std::string> patterns, bool prefilter = true);
+
+    std::size_t size() const;
+    const std::string &get_pattern(std::size_t index) const;
+    std::size_t get_num_states() const;
+    std::size_t get_num_classes() const;
+    bool has_prefilter() const;
+
+    // words is the number of words, matches[i] counts the words matching pattern i
+    Search_result search(std::string_view text, std::vector<std::uintmax_t> &matches) const;
+    Search_result search(const Chunked_file &file, std::vector<std::uintmax_t> &matches) const;
+};
+
+#endif
@@ -0,0 +1,647 @@
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <utility>
+#include "Chunked_file.h"
+#include "Word_search.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr std::size_t npos = std::string_view::npos;
+
+    // patterns up to this length use the first and last character filter
+    constexpr std::size_t filter_max_length = 32;
+
+    // same characters as std::isspace in the "C" locale, the ones operator>> skips
+    inline bool is_space(unsigned char c)
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+
+    bool has_space(std::string_view text)
+    {
+        return std::any_of(text.begin(), text.end(), [](char c) { return is_space(c); });
+    }
+
+    std::size_t find_horspool(std::string_view text, std::string_view pattern, std::size_t from)
+    {
+        const std::size_t m = pattern.size();
+        if (text.size() < m || from > text.size() - m)
+            return npos;
+
+        // how far the window can move when its last character is c
+        std::size_t shift[256];
+        std::fill(shift, shift + 256, m);
+        for (std::size_t i = 0; i + 1 < m; ++i)
+            shift[static_cast<unsigned char>(pattern[i])] = m - 1 - i;
+
+        const unsigned char last = static_cast<unsigned char>(pattern[m - 1]);
+        for (std::size_t i = from; i <= text.size() - m; )
+        {
+            unsigned char c = static_cast<unsigned char>(text[i + m - 1]);
+            if (c == last && std::memcmp(text.data() + i, pattern.data(), m - 1) == 0)
+                return i;
+            i += shift[c];
+        }
+        return npos;
+    }
+
+    std::size_t find_filtered(std::string_view text, std::string_view pattern, std::size_t from)
+    {
+        const std::size_t m = pattern.size();
+        if (text.size() < m || from > text.size() - m)
+            return npos;
+
+        const char *data = text.data();
+        const std::size_t last_start = text.size() - m;
+        std::size_t i = from;
+
+#if defined(__SSE2__)
+        const __m128i first = _mm_set1_epi8(pattern[0]);
+        const __m128i last = _mm_set1_epi8(pattern[m - 1]);
+
+        // 16 candidate positions at once, both ends of the pattern have to agree
+        for (; i + 15 <= last_start; i += 16)
+        {
+            __m128i heads = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            __m128i tails = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + m - 1));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(heads, first), _mm_cmpeq_epi8(tails, last))));
+
+            for (; mask != 0; mask &= mask - 1)
+            {
+                std::size_t pos = i + static_cast<std::size_t>(__builtin_ctz(mask));
+                if (std::memcmp(data + pos + 1, pattern.data() + 1, m - 2) == 0)
+                    return pos;
+            }
+        }
+#endif
+
+        for (; i <= last_start; ++i)
+            if (data[i] == pattern[0] && data[i + m - 1] == pattern[m - 1]
+                && std::memcmp(data + i + 1, pattern.data() + 1, m - 2) == 0)
+                return i;
+        return npos;
+    }
+
+    std::size_t find(std::string_view text, std::string_view pattern, std::size_t from)
+    {
+        if (pattern.size() == 1)
+        {
+            const void *hit = std::memchr(text.data() + from, pattern[0], text.size() - from);
+            return hit == nullptr ? npos : static_cast<std::size_t>(static_cast<const char *>(hit) - text.data());
+        }
+        if (pattern.size() <= filter_max_length)
+            return find_filtered(text, pattern, from);
+        return find_horspool(text, pattern, from);
+    }
+
+    template<typename Function>
+    void for_each_word(std::string_view text, Function function)
+    {
+        std::size_t i = 0;
+        while (true)
+        {
+            while (i < text.size() && is_space(text[i]))
+                ++i;
+            if (i == text.size())
+                return;
+
+            std::size_t begin = i;
+            while (i < text.size() && !is_space(text[i]))
+                ++i;
+            function(text.substr(begin, i - begin));
+        }
+    }
+}
+
+std::uintmax_t count_words(std::string_view text)
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    std::uintmax_t words = 0;
+    std::size_t i = 0;
+
+    // a word starts on a non space after a space, the start of the text counts as a space
+    unsigned carry = 1;
+
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i controls = _mm_set1_epi8('\r' - '\t');
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        // '\t' to '\r' is an unsigned range check: min(c - '\t', 4) == c - '\t'
+        __m128i shifted = _mm_sub_epi8(chars, tab);
+        __m128i spaces = _mm_or_si128(_mm_cmpeq_epi8(chars, space),
+            _mm_cmpeq_epi8(_mm_min_epu8(shifted, controls), shifted));
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(spaces));
+        unsigned starts = ~mask & ((mask << 1) | carry) & 0xFFFF;
+        words += static_cast<std::uintmax_t>(__builtin_popcount(starts));
+        carry = mask >> 15;
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        unsigned space = is_space(data[i]);
+        words += carry & !space;
+        carry = space;
+    }
+    return words;
+}
+
+Search_result search_words(std::string_view text, std::string_view pattern,
+    const std::function<void(std::string_view)> &on_match)
+{
+    Search_result result {count_words(text), 0};
+
+    // every word contains "", no word contains a whitespace
+    if (pattern.empty())
+    {
+        result.matches = result.words;
+        if (on_match)
+            for_each_word(text, on_match);
+        return result;
+    }
+    if (has_space(pattern))
+        return result;
+
+    std::size_t pos = 0;
+    while ((pos = find(text, pattern, pos)) != npos)
+    {
+        std::size_t begin = pos;
+        while (begin > 0 && !is_space(text[begin - 1]))
+            --begin;
+
+        // the rest of the word is skipped, a word matches once
+        std::size_t end = pos + pattern.size();
+        while (end < text.size() && !is_space(text[end]))
+            ++end;
+
+        result.matches++;
+        if (on_match)
+            on_match(text.substr(begin, end - begin));
+        pos = end;
+    }
+
+    return result;
+}
+
+// chunks end after a '\n', so no word is split between two of them
+Search_result search_words(const Chunked_file &file, std::string_view pattern,
+    const std::function<void(std::string_view)> &on_match)
+{
+    struct Chunk_result
+    {
+        Search_result counts;
+        std::vector<std::string_view> words;
+    };
+
+    std::vector<Chunk_result> results = file.map([&pattern, &on_match](const Chunk &chunk)
+    {
+        Chunk_result result {};
+        if (on_match)
+            result.counts = search_words(chunk.text, pattern, [&result](std::string_view word) { result.words.push_back(word); });
+        else
+            result.counts = search_words(chunk.text, pattern);
+        return result;
+    });
+
+    Search_result total {0, 0};
+    for (const Chunk_result &result : results)
+    {
+        total.words += result.counts.words;
+        total.matches += result.counts.matches;
+        for (std::string_view word : result.words)
+            on_match(word);
+    }
+    return total;
+}
+
+Pattern_set::Pattern_set(std::vector<std::string> patterns)
+    : patterns{std::move(patterns)}
+{
+    this->build();
+}
+
+/*
+
+    - the patterns go into a trie, then a breadth first pass fills every missing
+      transition with the one of the longest suffix, so search follows one edge per
+      character and never backtracks.
+
+    - patterns with a whitespace can't be inside a word and are left out.
+
+*/
+void Pattern_set::build()
+{
+    this->next.assign(256, 0);
+    this->output.assign(1, no_pattern);
+    this->chain.assign(1, 0);
+    this->same_as.resize(this->patterns.size());
+
+    for (std::size_t p = 0; p < this->patterns.size(); ++p)
+    {
+        const std::string &pattern = this->patterns[p];
+        this->same_as[p] = static_cast<std::uint32_t>(p);
+        if (pattern.empty() || has_space(pattern))
+            continue;
+
+        std::uint32_t state = 0;
+        for (char ch : pattern)
+        {
+            std::size_t edge = std::size_t{state} * 256 + static_cast<unsigned char>(ch);
+            if (this->next[edge] == 0)
+            {
+                // 0 is the root, no transition goes back to it while building the trie
+                this->next[edge] = static_cast<std::uint32_t>(this->output.size());
+                this->next.resize(this->next.size() + 256, 0);
+                this->output.push_back(no_pattern);
+                this->chain.push_back(0);
+            }
+            state = this->next[edge];
+        }
+
+        // a repeated pattern keeps the first index, search copies its count
+        if (this->output[state] == no_pattern)
+            this->output[state] = static_cast<std::uint32_t>(p);
+        else
+            this->same_as[p] = this->output[state];
+    }
+
+    std::vector<std::uint32_t> fail(this->output.size(), 0);
+    std::queue<std::uint32_t> queue;
+
+    for (std::size_t c = 0; c < 256; ++c)
+        if (this->next[c] != 0)
+            queue.push(this->next[c]);
+
+    while (!queue.empty())
+    {
+        std::uint32_t state = queue.front();
+        queue.pop();
+
+        for (std::size_t c = 0; c < 256; ++c)
+        {
+            std::uint32_t &child = this->next[std::size_t{state} * 256 + c];
+            std::uint32_t fallback = this->next[std::size_t{fail[state]} * 256 + c];
+
+            if (child == 0)
+            {
+                child = fallback;
+                continue;
+            }
+
+            fail[child] = fallback;
+            this->chain[child] = this->output[fallback] != no_pattern ? fallback : this->chain[fallback];
+            queue.push(child);
+        }
+    }
+}
+
+std::size_t Pattern_set::size() const
+{
+    return this->patterns.size();
+}
+
+const std::string &Pattern_set::get_pattern(std::size_t index) const
+{
+    return this->patterns[index];
+}
+
+Search_result Pattern_set::search(std::string_view text, std::vector<std::uintmax_t> &matches) const
+{
+    const std::size_t num_patterns = this->patterns.size();
+    matches.assign(num_patterns, 0);
+
+    // the word a pattern was last counted for, so a word counts once per pattern
+    std::vector<std::uintmax_t> counted(num_patterns, 0);
+
+    Search_result result {0, 0};
+    std::uint32_t state = 0;
+    bool in_word = false;
+    bool word_matched = false;
+    bool any_empty = false;
+
+    for (const std::string &pattern : this->patterns)
+        any_empty = any_empty || pattern.empty();
+
+    for (char ch : text)
+    {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (is_space(c))
+        {
+            in_word = false;
+            state = 0;
+            continue;
+        }
+
+        if (!in_word)
+        {
+            in_word = true;
+            word_matched = any_empty;
+            result.words++;
+            result.matches += any_empty;
+        }
+
+        state = this->next[std::size_t{state} * 256 + c];
+
+        for (std::uint32_t s = this->output[state] != no_pattern ? state : this->chain[state]; s != 0; s = this->chain[s])
+        {
+            std::uint32_t p = this->output[s];
+            if (counted[p] != result.words)
+            {
+                counted[p] = result.words;
+                matches[p]++;
+                if (!word_matched)
+                {
+                    word_matched = true;
+                    result.matches++;
+                }
+            }
+        }
+    }
+
+    // the empty pattern is in every word, a repeated one counts like its first copy
+    for (std::size_t p = 0; p < num_patterns; ++p)
+    {
+        if (this->patterns[p].empty())
+            matches[p] = result.words;
+        else
+            matches[p] = matches[this->same_as[p]];
+    }
+
+    return result;
+}
+
+Search_result Pattern_set::search(const Chunked_file &file, std::vector<std::uintmax_t> &matches) const
+{
+    struct Chunk_result
+    {
+        Search_result counts;
+        std::vector<std::uintmax_t> matches;
+    };
+
+    std::vector<Chunk_result> results = file.map([this](const Chunk &chunk)
+    {
+        Chunk_result result {};
+        result.counts = this->search(chunk.text, result.matches);
+        return result;
+    });
+
+    Search_result total {0, 0};
+    matches.assign(this->patterns.size(), 0);
+    for (const Chunk_result &result : results)
+    {
+        total.words += result.counts.words;
+        total.matches += result.counts.matches;
+        for (std::size_t p = 0; p < matches.size(); ++p)
+            matches[p] += result.matches[p];
+    }
+    return total;
+}
+
+namespace
+{
+    // a bit of the 65536 of Fuzzy_pattern::grams, the characters of a q-gram multiplied
+    inline std::uint32_t gram_hash(const char *at, std::size_t q)
+    {
+        std::uint32_t key = 0;
+        for (std::size_t i = 0; i < q; ++i)
+            key |= static_cast<std::uint32_t>(static_cast<unsigned char>(at[i])) << (8 * i);
+        return (key * 0x9E3779B1u) >> 16;
+    }
+}
+
+Fuzzy_pattern::Fuzzy_pattern(std::string pattern, std::size_t max_errors, bool prefilter)
+    : pattern{std::move(pattern)}, max_errors{max_errors}, q{0}, min_grams{0}
+{
+    const std::size_t m = this->pattern.size();
+    this->num_blocks = std::max<std::size_t>(1, (m + 63) / 64);
+    this->peq.assign(256 * this->num_blocks, 0);
+    for (std::size_t i = 0; i < m; ++i)
+        this->peq[static_cast<unsigned char>(this->pattern[i]) * this->num_blocks + i / 64] |= std::uint64_t{1} << (i % 64);
+
+    // every edit breaks q of the m - q + 1 q-grams at most
+    if (!prefilter || m <= max_errors)
+        return;
+    for (std::size_t length = 3; length >= 1; --length)
+        if (length <= m && m - length + 1 > max_errors * length)
+        {
+            this->q = length;
+            this->min_grams = m - length + 1 - max_errors * length;
+            break;
+        }
+
+    this->grams.assign(65536 / 64, 0);
+    for (std::size_t i = 0; i + this->q <= m; ++i)
+    {
+        const std::uint32_t hash = gram_hash(this->pattern.data() + i, this->q);
+        this->grams[hash / 64] |= std::uint64_t{1} << (hash % 64);
+    }
+}
+
+const std::string &Fuzzy_pattern::get_pattern() const
+{
+    return this->pattern;
+}
+
+std::size_t Fuzzy_pattern::get_max_errors() const
+{
+    return this->max_errors;
+}
+
+// a hash collision counts a q-gram that is not there, a word is only read for nothing
+bool Fuzzy_pattern::has_grams(std::string_view word) const
+{
+    if (this->q == 0)
+        return true;
+    std::size_t found = 0;
+    for (std::size_t j = 0; j + this->q <= word.size(); ++j)
+    {
+        const std::uint32_t hash = gram_hash(word.data() + j, this->q);
+        found += (this->grams[hash / 64] >> (hash % 64)) & 1;
+        if (found >= this->min_grams)
+            return true;
+    }
+    return false;
+}
+
+/*
+
+    - a column of the edit distances of every prefix of the pattern to the parts of the
+      word ending at a character is kept as its differences, pv and mv the rows where it
+      goes up and down by one from the row before, the last row is the score.
+
+    - row 0 is 0 in every column, a part can start anywhere, so no carry comes in at the
+      bottom, the score can go down by 1 a character at most and the rest of the word is
+      not read once it can't reach max_errors.
+
+*/
+std::size_t Fuzzy_pattern::distance_in_block(std::string_view word, std::size_t enough) const
+{
+    const std::size_t m = this->pattern.size();
+    const std::uint64_t last = std::uint64_t{1} << (m - 1);
+    std::uint64_t pv = ~std::uint64_t{0}, mv = 0;
+    std::size_t score = m, best = m;
+
+    for (std::size_t j = 0; j < word.size(); ++j)
+    {
+        std::uint64_t eq = this->peq[static_cast<unsigned char>(word[j])];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+        if (ph & last)
+            ++score;
+        else if (mh & last)
+            --score;
+
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        best = std::min(best, score);
+        if (best <= enough)
+            return best;
+        if (best > this->max_errors && score > this->max_errors + (word.size() - j - 1))
+            break;
+    }
+    return std::min(best, this->max_errors + 1);
+}
+
+// the same column in blocks of 64 rows, a block passes the change of its top row to the next
+std::size_t Fuzzy_pattern::distance_in_blocks(std::string_view word, std::size_t enough, std::uint64_t *state) const
+{
+    const std::size_t m = this->pattern.size();
+    const std::size_t blocks = this->num_blocks;
+    const std::uint64_t top = std::uint64_t{1} << 63;
+    const std::uint64_t last = std::uint64_t{1} << ((m - 1) % 64);
+    std::uint64_t *pvs = state, *mvs = state + blocks;
+    std::fill(pvs, pvs + blocks, ~std::uint64_t{0});
+    std::fill(mvs, mvs + blocks, 0);
+    std::size_t score = m, best = m;
+
+    for (std::size_t j = 0; j < word.size(); ++j)
+    {
+        const std::uint64_t *eqs = this->peq.data() + static_cast<unsigned char>(word[j]) * blocks;
+        int carry = 0;
+        for (std::size_t b = 0; b < blocks; ++b)
+        {
+            const std::uint64_t pv = pvs[b], mv = mvs[b];
+            std::uint64_t eq = eqs[b];
+            const std::uint64_t xv = eq | mv;
+            if (carry < 0)
+                eq |= 1;
+            const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            std::uint64_t ph = mv | ~(xh | pv);
+            std::uint64_t mh = pv & xh;
+
+            const std::uint64_t high = b + 1 == blocks ? last : top;
+            const int out = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+            ph <<= 1;
+            mh <<= 1;
+            if (carry < 0)
+                mh |= 1;
+            else if (carry > 0)
+                ph |= 1;
+            pvs[b] = mh | ~(xv | ph);
+            mvs[b] = ph & xv;
+            carry = out;
+        }
+        score = static_cast<std::size_t>(static_cast<long long>(score) + carry);
+
+        best = std::min(best, score);
+        if (best <= enough)
+            return best;
+        if (best > this->max_errors && score > this->max_errors + (word.size() - j - 1))
+            break;
+    }
+    return std::min(best, this->max_errors + 1);
+}
+
+std::size_t Fuzzy_pattern::distance(std::string_view word) const
+{
+    const std::size_t m = this->pattern.size();
+    if (m == 0)
+        return 0;
+    if (word.size() + this->max_errors < m)
+        return this->max_errors + 1;
+    if (this->num_blocks == 1)
+        return this->distance_in_block(word, 0);
+    std::vector<std::uint64_t> state(2 * this->num_blocks);
+    return this->distance_in_blocks(word, 0, state.data());
+}
+
+bool Fuzzy_pattern::matches(std::string_view word, std::uint64_t *state) const
+{
+    const std::size_t m = this->pattern.size();
+    // the empty part of any word is m errors away
+    if (m <= this->max_errors)
+        return true;
+    if (word.size() + this->max_errors < m || !this->has_grams(word))
+        return false;
+    if (this->num_blocks == 1)
+        return this->distance_in_block(word, this->max_errors) <= this->max_errors;
+    return this->distance_in_blocks(word, this->max_errors, state) <= this->max_errors;
+}
+
+bool Fuzzy_pattern::matches(std::string_view word) const
+{
+    std::vector<std::uint64_t> state(2 * this->num_blocks);
+    return this->matches(word, state.data());
+}
+
+Search_result Fuzzy_pattern::search(std::string_view text, const std::function<void(std::string_view)> &on_match) const
+{
+    Search_result result {0, 0};
+    std::vector<std::uint64_t> state(2 * this->num_blocks);
+    for_each_word(text, [this, &result, &state, &on_match](std::string_view word)
+    {
+        result.words++;
+        if (!this->matches(word, state.data()))
+            return;
+        result.matches++;
+        if (on_match)
+            on_match(word);
+    });
+    return result;
+}
+
+Search_result Fuzzy_pattern::search(const Chunked_file &file, const std::function<void(std::string_view)> &on_match) const
+{
+    struct Chunk_result
+    {
+        Search_result counts;
+        std::vector<std::string_view> words;
+    };
+
+    std::vector<Chunk_result> results = file.map([this, &on_match](const Chunk &chunk)
+    {
+        Chunk_result result {};
+        if (on_match)
+            result.counts = this->search(chunk.text, [&result](std::string_view word) { result.words.push_back(word); });
+        else
+            result.counts = this->search(chunk.text);
+        return result;
+    });
+
+    Search_result total {0, 0};
+    for (const Chunk_result &result : results)
+    {
+        total.words += result.counts.words;
+        total.matches += result.counts.matches;
+        for (std::string_view word : result.words)
+            on_match(word);
+    }
+    return total;
+}
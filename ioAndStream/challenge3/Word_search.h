@@ -0,0 +1,109 @@
+#ifndef _WORD_SEARCH_H_
+#define _WORD_SEARCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - a word is a run of characters between whitespaces, what in_file >> word reads, and
+      a word matches when it contains the pattern, a word counts once however many times
+      the pattern is in it, the same counts as word.find(txt) on every word.
+
+    - search_words scans the whole text for the pattern instead of every word: SSE2
+      compares the first and the last character of the pattern at 16 positions at once and
+      memcmp checks the candidates, patterns longer than 32 characters use
+      Boyer-Moore-Horspool. the word around a hit is found only then.
+
+    - Pattern_set answers a list of patterns in one pass over the text with Aho-Corasick.
+
+    - Fuzzy_pattern matches a word when a part of it is at most max_errors insertions,
+      deletions and substitutions away from the pattern, "Romeo" with 1 is in "Romeos" and
+      "Remeo", 0 is the same counts as search_words. a word is scanned with Myers' bit
+      parallel edit distance, the pattern is the bits of a 64 bit word, a longer one is
+      blocks of 64 with the carries between them. a word is read only when it is long
+      enough and has enough of the q-grams of the pattern: a part within k errors has
+      m - q + 1 - k * q of them at least, q is the longest of 3, 2 and 1 that leaves one.
+
+    - both take a Chunked_file too, then every chunk is searched on its own thread and the
+      counts are added up, the matching words still come in the order of the file.
+
+*/
+class Chunked_file;
+
+struct Search_result
+{
+    std::uintmax_t words;
+    std::uintmax_t matches;
+};
+
+// on_match, when given, is called with every matching word in order
+Search_result search_words(std::string_view text, std::string_view pattern,
+    const std::function<void(std::string_view)> &on_match = {});
+
+Search_result search_words(const Chunked_file &file, std::string_view pattern,
+    const std::function<void(std::string_view)> &on_match = {});
+
+std::uintmax_t count_words(std::string_view text);
+
+class Pattern_set
+{
+private:
+    static constexpr std::uint32_t no_pattern = static_cast<std::uint32_t>(-1);
+
+    std::vector<std::string> patterns;
+    std::vector<std::uint32_t> next;     // 256 transitions per state, a full automaton
+    std::vector<std::uint32_t> output;   // the pattern ending at a state, or no_pattern
+    std::vector<std::uint32_t> chain;    // the nearest shorter suffix state with an output, 0 for none
+    std::vector<std::uint32_t> same_as;  // the first copy of a repeated pattern, or the pattern itself
+
+    void build();
+
+public:
+    explicit Pattern_set(std::vector<std::string> patterns);
+
+    std::size_t size() const;
+    const std::string &get_pattern(std::size_t index) const;
+
+    // words is the number of words, matches[i] counts the words containing pattern i
+    Search_result search(std::string_view text, std::vector<std::uintmax_t> &matches) const;
+    Search_result search(const Chunked_file &file, std::vector<std::uintmax_t> &matches) const;
+};
+
+class Fuzzy_pattern
+{
+private:
+    std::string pattern;
+    std::size_t max_errors;
+    std::size_t num_blocks;
+    std::vector<std::uint64_t> peq;    // the bits of the pattern a character is at, num_blocks per character
+    std::size_t q;                     // 0 without the q-gram filter
+    std::size_t min_grams;
+    std::vector<std::uint64_t> grams;  // a bit per hash of the q-grams of the pattern
+
+    bool has_grams(std::string_view word) const;
+    // both stop once the errors are at most enough, state is 2 * num_blocks words
+    std::size_t distance_in_block(std::string_view word, std::size_t enough) const;
+    std::size_t distance_in_blocks(std::string_view word, std::size_t enough, std::uint64_t *state) const;
+    bool matches(std::string_view word, std::uint64_t *state) const;
+
+public:
+    // prefilter false reads every word, for comparing it with the filter
+    Fuzzy_pattern(std::string pattern, std::size_t max_errors, bool prefilter = true);
+
+    const std::string &get_pattern() const;
+    std::size_t get_max_errors() const;
+
+    // the fewest errors of the pattern to a part of the word, max_errors + 1 for all the more
+    std::size_t distance(std::string_view word) const;
+    bool matches(std::string_view word) const;
+
+    Search_result search(std::string_view text, const std::function<void(std::string_view)> &on_match = {}) const;
+    Search_result search(const Chunked_file &file, const std::function<void(std::string_view)> &on_match = {}) const;
+};
+
+#endif
@@ -1,27 +1,18 @@
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
+#include <memory>
+#include <stdexcept>
 #include <string>
-#include <algorithm>
-#include <cctype>
+#include <vector>
+#include "Chunked_file.h"
+#include "Regex_set.h"
+#include "Word_search.h"
 
-int main()
-{
-    std::ifstream in_file;
-    std::string word {};
-    std::string txt {};
-    int match_counter {0};
-    int word_counter {0};
-
-    in_file.open("romeoAndJuliet.txt");
+/*
 
-    if (!in_file.is_open())
-    {
-        std::cout << "The file is not found." << std::endl;
-        return 1;
-    }
+    g++ -std=c++17 -O2 -pthread index.cpp Word_search.cpp Regex_set.cpp Chunked_file.cpp ../compressedStream/Compressed_stream.cpp ../compressedStream/Lz4.cpp
 
-    std::cout << "Enter the substring to search for: ";
-    std::cin >> txt;
+    the first version, one std::string and one naive find per word:
 
     while (in_file >> word)
     {
@@ -33,12 +24,100 @@ int main()
             std::cout << word << " ";
         }
     }
-    
+
+    search_words scans the whole file at once and gives the same counts, see Word_search.h,
+    the file is split in one chunk per thread, see Chunked_file.h.
+
+    ./a.out                  asks for one substring and prints the matching words
+    ./a.out Romeo Juliet ... counts every substring in one pass
+    ./a.out --fuzzy 1 Romeo  prints the words with a part at most 1 edit away from Romeo
+    ./a.out --regex '^Rom' 'o$' ... counts the words matching every regex, see Regex_set.h
+
+    romeoAndJuliet.txt can be compressed with lz4, see Chunked_file.h.
+
+    without a romeoAndJuliet.txt in the current directory the text is the one embedded
+    in the program at build time, see ../embeddedData:
+        embed romeo_text bytes romeoAndJuliet.txt
+
+*/
+
+#if __has_include("romeo_text.h")
+#include "romeo_text.h"
+#define HAS_ROMEO_TEXT 1
+#endif
+
+int main(int argc, char *argv[])
+{
+    std::unique_ptr<Chunked_file> file;
+
+    try
+    {
+        file = std::make_unique<Chunked_file>("romeoAndJuliet.txt");
+    }
+    catch (const std::runtime_error &)
+    {
+#if defined(HAS_ROMEO_TEXT)
+        file = std::make_unique<Chunked_file>(romeo_text, romeo_text_size, 0);
+#else
+        std::cout << "The file is not found." << std::endl;
+        return 1;
+#endif
+    }
+
+    if (argc == 4 && std::string {argv[1]} == "--fuzzy")
+    {
+        Fuzzy_pattern pattern {argv[3], static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10))};
+        Search_result result = pattern.search(*file, [](std::string_view word) { std::cout << word << " "; });
+
+        std::cout << std::endl;
+        std::cout << result.words << " word were searched..." << std::endl;
+        std::cout << "The substring " << pattern.get_pattern() << " was found " << result.matches << " times within "
+                  << pattern.get_max_errors() << " edits" << std::endl;
+        return 0;
+    }
+
+    if (argc > 2 && std::string {argv[1]} == "--regex")
+    {
+        std::unique_ptr<Regex_set> regexes;
+        try
+        {
+            regexes = std::make_unique<Regex_set>(std::vector<std::string>(argv + 2, argv + argc));
+        }
+        catch (const std::exception &error)
+        {
+            std::cout << error.what() << std::endl;
+            return 1;
+        }
+        std::vector<std::uintmax_t> matches;
+        Search_result result = regexes->search(*file, matches);
+
+        std::cout << result.words << " word were searched..." << std::endl;
+        for (std::size_t i = 0; i < regexes->size(); ++i)
+            std::cout << "The pattern " << regexes->get_pattern(i) << " was found " << matches[i] << " times" << std::endl;
+        return 0;
+    }
+
+    if (argc > 1)
+    {
+        Pattern_set patterns {std::vector<std::string>(argv + 1, argv + argc)};
+        std::vector<std::uintmax_t> matches;
+        Search_result result = patterns.search(*file, matches);
+
+        std::cout << result.words << " word were searched..." << std::endl;
+        for (std::size_t i = 0; i < patterns.size(); ++i)
+            std::cout << "The substring " << patterns.get_pattern(i) << " was found " << matches[i] << " times" << std::endl;
+        return 0;
+    }
+
+    std::string txt {};
+    std::cout << "Enter the substring to search for: ";
+    std::cin >> txt;
+
+    Search_result result = search_words(*file, txt, [](std::string_view word) { std::cout << word << " "; });
+
     std::cout << std::endl;
-    std::cout << word_counter << " word were searched..." << std::endl;
-    std::cout << "The substring " << txt << " was found " << match_counter << " times" << std::endl;
-    
-    in_file.close();
-    
+    std::cout << result.words << " word were searched..." << std::endl;
+    std::cout << "The substring " << txt << " was found " << result.matches << " times" << std::endl;
+
     return 0;
 }
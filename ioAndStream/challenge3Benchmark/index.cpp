@@ -0,0 +1,198 @@
+/*
+
+    - Fuzzy_pattern (../challenge3/Word_search.h) on ../challenge3/romeoAndJuliet.txt
+      repeated 100 times by default, the copies can be given on the command line, e.g.
+      ./a.out 400, against the edit distance table of the pattern and every word, the
+      textbook dynamic programming, m * n cells a word, with the q-gram filter, without it,
+      and on the chunks of a Chunked_file, one thread each.
+
+    - 0 errors has to give the counts of search_words, every other one the ones of the
+      table, and distance the ones of the table on random words and patterns of 1 to 150
+      characters, the blocks of 64 bits too, a mismatch is reported and the exit code is 1.
+
+    - on one core of an x86-64 at -O2, 100 copies, 13.8 MB, 2.56M words, ms:
+                            table   myers   filter   chunks   matches
+        Romeo 0             201.7    74.2     70.3     71.9     12900
+        Romeo 1             200.1    93.4     72.3     81.8     12900
+        Juliet 2            222.6    89.3     85.9     75.7      8700
+        wherefore 2         304.5    58.6     61.0     60.6      2800
+        Capulet 1           246.1    64.3     63.3     61.4      3300
+        70 characters, 60  3264.1    53.3     56.1     52.9       200
+      a column of myers is a few instructions a character where the table is m cells, the
+      words of the play are 4 or 5 characters, going over them is most of what is left and
+      the q-gram filter saves little, a few errors leave q-grams of 1 and 2 characters that
+      most words have. the chunks are one thread here.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../challenge3/Word_search.cpp ../challenge3/Chunked_file.cpp ../compressedStream/Compressed_stream.cpp ../compressedStream/Lz4.cpp
+
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../challenge3/Chunked_file.h"
+#include "../challenge3/Word_search.h"
+
+template<typename F>
+double time_ms(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// the fewest errors of the pattern to a part of the word, a part starts and ends anywhere
+std::size_t table_distance(std::string_view pattern, std::string_view word, std::vector<std::size_t> &column)
+{
+    const std::size_t m = pattern.size();
+    column.resize(m + 1);
+    std::iota(column.begin(), column.end(), std::size_t {0});
+    std::size_t best = m;
+    for (char c : word)
+    {
+        std::size_t diagonal = column[0];
+        for (std::size_t i = 1; i <= m; ++i)
+        {
+            const std::size_t up = column[i];
+            column[i] = std::min({up + 1, column[i - 1] + 1, diagonal + (pattern[i - 1] != c)});
+            diagonal = up;
+        }
+        best = std::min(best, column[m]);
+    }
+    return best;
+}
+
+Search_result table_search(std::string_view text, std::string_view pattern, std::size_t max_errors)
+{
+    Search_result result {0, 0};
+    std::vector<std::size_t> column;
+    std::size_t i = 0;
+    while (i < text.size())
+    {
+        while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i])))
+            ++i;
+        if (i == text.size())
+            break;
+        const std::size_t begin = i;
+        while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])))
+            ++i;
+        result.words++;
+        result.matches += table_distance(pattern, text.substr(begin, i - begin), column) <= max_errors;
+    }
+    return result;
+}
+
+int check_distances()
+{
+    std::mt19937 gen {11};
+    std::uniform_int_distribution<int> letter {'a', 'd'};
+    std::vector<std::size_t> column;
+    int mismatches = 0;
+    for (int round = 0; round < 3000; ++round)
+    {
+        const std::size_t m = 1 + gen() % 150, n = gen() % 200, max_errors = gen() % (m + 2);
+        std::string pattern, word;
+        for (std::size_t i = 0; i < m; ++i)
+            pattern += static_cast<char>(letter(gen));
+        for (std::size_t i = 0; i < n; ++i)
+            word += static_cast<char>(letter(gen));
+
+        const std::size_t expected = std::min(table_distance(pattern, word, column), max_errors + 1);
+        const Fuzzy_pattern fuzzy {pattern, max_errors};
+        const Fuzzy_pattern unfiltered {pattern, max_errors, false};
+        if (fuzzy.distance(word) != expected || fuzzy.matches(word) != (expected <= max_errors)
+            || unfiltered.matches(word) != (expected <= max_errors))
+        {
+            if (mismatches++ < 5)
+                std::cout << "mismatch: m " << m << " n " << n << " k " << max_errors << " table " << expected
+                          << " myers " << fuzzy.distance(word) << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char *argv[])
+{
+    const long copies_arg = argc > 1 ? std::atol(argv[1]) : 100;
+    const std::size_t copies = copies_arg > 0 ? static_cast<std::size_t>(copies_arg) : 1;
+
+    std::ifstream in_file {"../challenge3/romeoAndJuliet.txt", std::ios::binary};
+    if (!in_file)
+    {
+        std::cout << "run it in its directory, ../challenge3/romeoAndJuliet.txt is not found" << std::endl;
+        return 1;
+    }
+    const std::string play {std::istreambuf_iterator<char> {in_file}, std::istreambuf_iterator<char> {}};
+    std::string text;
+    text.reserve(play.size() * copies);
+    for (std::size_t copy = 0; copy < copies; ++copy)
+        text += play;
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "challenge3_fuzzy.txt";
+    {
+        std::ofstream out {path, std::ios::binary};
+        out << text;
+    }
+    int mismatches = check_distances();
+    {
+        Chunked_file file {path.string()};
+
+        struct Query
+        {
+            const char *name;
+            std::string pattern;
+            std::size_t max_errors;
+        };
+        const std::vector<Query> queries {
+            {"Romeo 0", "Romeo", 0},
+            {"Romeo 1", "Romeo", 1},
+            {"Juliet 2", "Juliet", 2},
+            {"wherefore 2", "wherefore", 2},
+            {"Capulet 1", "Capulet", 1},
+            {"70 characters, 60", "Two households, both alike in dignity, In fair Verona, where we lay our", 60},
+        };
+
+        std::cout << text.size() / 1e6 << " MB, " << count_words(text) << " words, ms:" << std::endl;
+        std::cout << std::setw(20) << "" << std::setw(10) << "table" << std::setw(8) << "myers" << std::setw(9) << "filter"
+                  << std::setw(9) << "chunks" << std::setw(10) << "matches" << std::endl;
+        for (const Query &query : queries)
+        {
+            const Fuzzy_pattern filtered {query.pattern, query.max_errors};
+            const Fuzzy_pattern unfiltered {query.pattern, query.max_errors, false};
+            Search_result by_table {}, by_myers {}, by_filter {}, by_chunks {};
+            const double table_ms = time_ms([&] { by_table = table_search(text, query.pattern, query.max_errors); });
+            const double myers_ms = time_ms([&] { by_myers = unfiltered.search(text); });
+            const double filter_ms = time_ms([&] { by_filter = filtered.search(text); });
+            const double chunks_ms = time_ms([&] { by_chunks = filtered.search(file); });
+
+            const auto same = [](const Search_result &a, const Search_result &b) { return a.words == b.words && a.matches == b.matches; };
+            bool ok = same(by_table, by_myers) && same(by_table, by_filter) && same(by_table, by_chunks);
+            if (query.max_errors == 0)
+                ok = ok && same(by_table, search_words(text, query.pattern));
+            if (!ok)
+            {
+                std::cout << "mismatch: " << query.name << std::endl;
+                ++mismatches;
+            }
+            std::cout << std::setw(20) << std::left << query.name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << table_ms << std::setw(8) << myers_ms << std::setw(9) << filter_ms << std::setw(9)
+                      << chunks_ms << std::setw(10) << by_filter.matches << std::endl;
+        }
+    }
+    std::filesystem::remove(path);
+
+    std::cout << "mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
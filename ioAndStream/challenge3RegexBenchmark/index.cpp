@@ -0,0 +1,167 @@
+/*
+
+    - Regex_set (../challenge3/Regex_set.h) on ../challenge3/romeoAndJuliet.txt repeated 200
+      times by default, the copies can be given on the command line, e.g. ./a.out 800,
+      against std::regex_search of every pattern on every word, on 2 copies, it is that
+      slow, and the DFA with the literals, without them, and on the chunks of a
+      Chunked_file, one thread each.
+
+    - the counts of every pattern have to be the ones of std::regex on its copies, and the
+      same with and without the literals on all of them, a mismatch is reported and the
+      exit code is 1.
+
+    - on one core of an x86-64 at -O2, 200 copies, 27.7 MB, MB/s:
+                        states  std::regex    dfa   literals   chunks
+        names (4)          165         7.9    279       1765     1753
+        endings (5)         57         5.3    252          -      254
+        wherefore (1)       12        30.2    253       1361     1537
+      names is ^Rom, Rom(eo|ulus), Capulet and Juliet, endings has [A-Z][a-z]+,$ and no
+      literal in all of them. the DFA is a lookup a byte and a branch on the whitespaces,
+      whatever the patterns, the literals leave the words without one to count_words, the
+      w of wherefore is in many more words than the R, C and J of the names.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../challenge3/Regex_set.cpp ../challenge3/Word_search.cpp ../challenge3/Chunked_file.cpp ../compressedStream/Compressed_stream.cpp ../compressedStream/Lz4.cpp
+
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../challenge3/Chunked_file.h"
+#include "../challenge3/Regex_set.h"
+
+template<typename F>
+double time_ms(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+Search_result with_std_regex(std::string_view text, const std::vector<std::string> &patterns, std::vector<std::uintmax_t> &matches)
+{
+    std::vector<std::regex> regexes;
+    for (const std::string &pattern : patterns)
+        regexes.emplace_back(pattern, std::regex::ECMAScript | std::regex::optimize);
+    matches.assign(patterns.size(), 0);
+
+    Search_result result {0, 0};
+    const auto space = [](char c) { return c == ' ' || (c >= '\t' && c <= '\r'); };
+    std::size_t i = 0;
+    while (true)
+    {
+        while (i < text.size() && space(text[i]))
+            ++i;
+        if (i == text.size())
+            return result;
+        const std::size_t begin = i;
+        while (i < text.size() && !space(text[i]))
+            ++i;
+
+        bool any = false;
+        for (std::size_t p = 0; p < regexes.size(); ++p)
+            if (std::regex_search(text.data() + begin, text.data() + i, regexes[p]))
+            {
+                matches[p]++;
+                any = true;
+            }
+        result.words++;
+        result.matches += any;
+    }
+}
+
+bool same(const Search_result &a, const std::vector<std::uintmax_t> &a_matches, const Search_result &b,
+    const std::vector<std::uintmax_t> &b_matches)
+{
+    return a.words == b.words && a.matches == b.matches && a_matches == b_matches;
+}
+
+int main(int argc, char *argv[])
+{
+    const long copies_arg = argc > 1 ? std::atol(argv[1]) : 200;
+    const std::size_t copies = copies_arg > 0 ? static_cast<std::size_t>(copies_arg) : 1;
+    const std::size_t regex_copies = std::min<std::size_t>(copies, 2);
+
+    std::ifstream in_file {"../challenge3/romeoAndJuliet.txt", std::ios::binary};
+    if (!in_file)
+    {
+        std::cout << "run it in its directory, ../challenge3/romeoAndJuliet.txt is not found" << std::endl;
+        return 1;
+    }
+    const std::string play {std::istreambuf_iterator<char> {in_file}, std::istreambuf_iterator<char> {}};
+    std::string text;
+    text.reserve(play.size() * copies);
+    for (std::size_t copy = 0; copy < copies; ++copy)
+        text += play;
+    const std::string_view regex_text = std::string_view {text}.substr(0, play.size() * regex_copies);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "challenge3_regex.txt";
+    {
+        std::ofstream out {path, std::ios::binary};
+        out << text;
+    }
+
+    struct Set
+    {
+        const char *name;
+        std::vector<std::string> patterns;
+    };
+    const std::vector<Set> sets {
+        {"names (4)", {"^Rom", "Rom(eo|ulus)", "Capulet", "Juliet"}},
+        {"endings (5)", {"o$", "[A-Z][a-z]+,$", "th(ee|ou)", "\\d", "^[a-z]+ing$"}},
+        {"wherefore (1)", {"wherefore"}},
+    };
+
+    int mismatches = 0;
+    {
+        Chunked_file file {path.string()};
+        const double mb = static_cast<double>(text.size()) / 1e6;
+        const double regex_mb = static_cast<double>(regex_text.size()) / 1e6;
+        std::cout << std::fixed << std::setprecision(1) << mb << " MB, MB/s:" << std::endl;
+        std::cout << std::setw(16) << "" << std::setw(8) << "states" << std::setw(12) << "std::regex" << std::setw(7) << "dfa"
+                  << std::setw(11) << "literals" << std::setw(9) << "chunks" << std::endl;
+
+        for (const Set &set : sets)
+        {
+            const Regex_set with_literals {set.patterns};
+            const Regex_set dfa {set.patterns, false};
+
+            std::vector<std::uintmax_t> by_regex, by_regex_set, by_dfa, by_literals, by_chunks;
+            Search_result regex_result {}, regex_set_result {}, dfa_result {}, literals_result {}, chunks_result {};
+            const double regex_ms = time_ms([&] { regex_result = with_std_regex(regex_text, set.patterns, by_regex); });
+            regex_set_result = with_literals.search(regex_text, by_regex_set);
+            const double dfa_ms = time_ms([&] { dfa_result = dfa.search(text, by_dfa); });
+            const double literals_ms = time_ms([&] { literals_result = with_literals.search(text, by_literals); });
+            const double chunks_ms = time_ms([&] { chunks_result = with_literals.search(file, by_chunks); });
+
+            if (!same(regex_result, by_regex, regex_set_result, by_regex_set) || !same(dfa_result, by_dfa, literals_result, by_literals)
+                || !same(dfa_result, by_dfa, chunks_result, by_chunks))
+            {
+                std::cout << "mismatch: " << set.name << std::endl;
+                ++mismatches;
+            }
+
+            std::cout << std::setw(16) << std::left << set.name << std::right << std::setw(8) << with_literals.get_num_states()
+                      << std::setw(12) << regex_mb / regex_ms * 1e3 << std::setw(7) << std::setprecision(0) << mb / dfa_ms * 1e3
+                      << std::setw(11);
+            if (with_literals.has_prefilter())
+                std::cout << mb / literals_ms * 1e3;
+            else
+                std::cout << "-";
+            std::cout << std::setw(9) << mb / chunks_ms * 1e3 << std::setprecision(1) << std::endl;
+        }
+    }
+    std::filesystem::remove(path);
+
+    std::cout << "mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#include <cstring>
+#include <stdexcept>
+#include "Async_writer.h"
+
+Async_writer::Async_writer(std::ostream &os, std::size_t buffer_size)
+    : os{os}, front(buffer_size == 0 ? 1 : buffer_size), back(front.size()), back_used{0},
+      pending{false}, stopping{false}, failed{false}
+{
+    this->setp(this->front.data(), this->front.data() + this->front.size());
+    this->thread = std::thread{&Async_writer::run, this};
+}
+
+Async_writer::~Async_writer()
+{
+    try
+    {
+        this->flush();
+    }
+    catch (const std::runtime_error &) {}
+
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        this->stopping = true;
+    }
+    this->changed.notify_all();
+    this->thread.join();
+}
+
+// the background thread, writes back whenever the producer hands it over
+void Async_writer::run()
+{
+    std::unique_lock<std::mutex> lock {this->mutex};
+
+    while (true)
+    {
+        this->changed.wait(lock, [this] { return this->pending || this->stopping; });
+        if (!this->pending)
+            return;
+
+        // only this thread touches back and the stream while pending is set
+        lock.unlock();
+        this->os.write(this->back.data(), static_cast<std::streamsize>(this->back_used));
+        bool ok = static_cast<bool>(this->os);
+        lock.lock();
+
+        this->failed = this->failed || !ok;
+        this->pending = false;
+        this->changed.notify_all();
+    }
+}
+
+void Async_writer::wait_idle(std::unique_lock<std::mutex> &lock)
+{
+    this->changed.wait(lock, [this] { return !this->pending; });
+    if (this->failed)
+        throw std::runtime_error("Async_writer: writing to the stream failed");
+}
+
+// swaps the filled front buffer with the written back one and starts writing it
+void Async_writer::submit()
+{
+    std::size_t used = static_cast<std::size_t>(this->pptr() - this->pbase());
+    if (used == 0)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock {this->mutex};
+        this->wait_idle(lock);
+
+        this->front.swap(this->back);
+        this->back_used = used;
+        this->pending = true;
+    }
+    this->changed.notify_all();
+
+    this->setp(this->front.data(), this->front.data() + this->front.size());
+}
+
+Async_writer::int_type Async_writer::overflow(int_type ch)
+{
+    this->submit();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *this->pptr() = traits_type::to_char_type(ch);
+        this->pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize Async_writer::xsputn(const char *data, std::streamsize size)
+{
+    this->write(data, static_cast<std::size_t>(size));
+    return size;
+}
+
+// std::ostream::flush ends here, a failure is reported as the -1 it expects
+int Async_writer::sync()
+{
+    try
+    {
+        this->flush();
+    }
+    catch (const std::runtime_error &)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+void Async_writer::write(const char *data, std::size_t size)
+{
+    while (size > 0)
+    {
+        std::size_t room = static_cast<std::size_t>(this->epptr() - this->pptr());
+        if (room == 0)
+        {
+            this->submit();
+            continue;
+        }
+
+        std::size_t count = size < room ? size : room;
+        std::memcpy(this->pptr(), data, count);
+        this->pbump(static_cast<int>(count));
+        data += count;
+        size -= count;
+    }
+}
+
+void Async_writer::write(std::string_view text)
+{
+    this->write(text.data(), text.size());
+}
+
+void Async_writer::flush()
+{
+    this->submit();
+
+    std::unique_lock<std::mutex> lock {this->mutex};
+    this->wait_idle(lock);
+    // the thread is idle now, the stream is ours
+    this->os.flush();
+    if (!this->os)
+        throw std::runtime_error("Async_writer: flushing the stream failed");
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "../challenge3/Chunked_file.h"
+#include "Line_numberer.h"
+
+namespace
+{
+    // the number is followed by three spaces
+    constexpr char separator[] = "   ";
+    constexpr std::size_t separator_length = sizeof(separator) - 1;
+
+    // "00" to "99", two digits per division
+    constexpr char digit_pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // the non empty lines of a chunk, the ones that get a number
+    std::uintmax_t count_numbered(std::string_view text)
+    {
+        std::uintmax_t lines = 0;
+        const char *data = text.data();
+        const char *end = data + text.size();
+
+        while (data < end)
+        {
+            const void *newline = std::memchr(data, '\n', static_cast<std::size_t>(end - data));
+            const char *stop = newline == nullptr ? end : static_cast<const char *>(newline);
+
+            lines += stop > data;
+            data = stop + 1;
+        }
+        return lines;
+    }
+
+    // the characters of the numbers first to first + count - 1
+    std::uintmax_t count_digits(std::uintmax_t first, std::uintmax_t count)
+    {
+        std::uintmax_t digits = 0;
+        std::uintmax_t last = first + count;  // one past
+        std::uintmax_t low = 1;
+
+        for (std::uintmax_t width = 1; first < last; ++width)
+        {
+            // the numbers with width digits are [low, low * 10)
+            std::uintmax_t high = low > UINTMAX_MAX / 10 ? UINTMAX_MAX : low * 10;
+            if (first < high)
+            {
+                std::uintmax_t upto = std::min(last, high);
+                digits += (upto - first) * width;
+                first = upto;
+            }
+            low = high;
+        }
+        return digits;
+    }
+}
+
+Line_numberer::Line_numberer(std::ostream &os, std::uintmax_t first_number)
+    : writer{os}, next_number{first_number}, line_start{true}
+{}
+
+void Line_numberer::append_number(std::uintmax_t number)
+{
+    // written backwards from the end, 20 digits fit any 64 bit number
+    char digits[20 + separator_length];
+    char *end = digits + sizeof(digits);
+    char *begin = end - separator_length;
+    std::memcpy(begin, separator, separator_length);
+
+    while (number >= 100)
+    {
+        std::size_t pair = static_cast<std::size_t>(number % 100) * 2;
+        number /= 100;
+        begin -= 2;
+        std::memcpy(begin, digit_pairs + pair, 2);
+    }
+
+    if (number >= 10)
+    {
+        begin -= 2;
+        std::memcpy(begin, digit_pairs + number * 2, 2);
+    }
+    else
+        *--begin = static_cast<char>('0' + number);
+
+    this->writer.write(begin, static_cast<std::size_t>(end - begin));
+}
+
+void Line_numberer::write(const char *data, std::size_t size)
+{
+    const char *end = data + size;
+
+    while (data < end)
+    {
+        if (this->line_start)
+        {
+            if (*data == '\n')
+            {
+                this->writer.write(data, 1);
+                ++data;
+                continue;
+            }
+
+            this->append_number(this->next_number++);
+            this->line_start = false;
+        }
+
+        // the rest of the line, with its '\n' when it is in this piece
+        const char *newline = static_cast<const char *>(std::memchr(data, '\n', static_cast<std::size_t>(end - data)));
+        const char *stop = newline == nullptr ? end : newline + 1;
+
+        this->writer.write(data, static_cast<std::size_t>(stop - data));
+        this->line_start = newline != nullptr;
+        data = stop;
+    }
+}
+
+void Line_numberer::finish()
+{
+    if (!this->line_start)
+    {
+        this->writer.write("\n", 1);
+        this->line_start = true;
+    }
+    this->flush();
+}
+
+void Line_numberer::flush()
+{
+    this->writer.flush();
+}
+
+std::uintmax_t Line_numberer::get_next_number() const
+{
+    return this->next_number;
+}
+
+std::uintmax_t number_lines(const std::string &from, const std::string &to, std::size_t num_threads)
+{
+    Chunked_file file {from, num_threads};
+    const std::vector<Chunk> &chunks = file.get_chunks();
+
+    std::vector<std::uintmax_t> lines = file.map([](const Chunk &chunk) { return count_numbered(chunk.text); });
+
+    // where every chunk starts, in line numbers and in bytes of the output
+    std::vector<std::uintmax_t> first_numbers(chunks.size());
+    std::vector<std::int64_t> offsets(chunks.size());
+    std::uintmax_t number = 1;
+    std::int64_t offset = 0;
+
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        first_numbers[i] = number;
+        offsets[i] = offset;
+
+        std::uintmax_t size = chunks[i].text.size() + lines[i] * separator_length + count_digits(number, lines[i]);
+        // a last line without '\n' gets one
+        if (i + 1 == chunks.size() && chunks[i].text.back() != '\n')
+            size++;
+
+        number += lines[i];
+        offset += static_cast<std::int64_t>(size);
+    }
+
+    // sized up front, every chunk then writes its own part of the file
+    {
+        std::ofstream out_file {to, std::ios::binary | std::ios::trunc};
+        if (!out_file.is_open())
+            throw std::runtime_error("Could not create " + to);
+    }
+
+    std::error_code error;
+    std::filesystem::resize_file(to, static_cast<std::uintmax_t>(offset), error);
+    if (error)
+        throw std::runtime_error("Could not resize " + to + ": " + error.message());
+
+    file.map([&](const Chunk &chunk)
+    {
+        std::ofstream out_file {to, std::ios::binary | std::ios::in | std::ios::out};
+        if (!out_file.seekp(offsets[chunk.index]))
+            throw std::runtime_error("Could not seek in " + to);
+
+        Line_numberer numberer {out_file, first_numbers[chunk.index]};
+        numberer.write(chunk.text.data(), chunk.text.size());
+        numberer.finish();
+        return 0;
+    });
+
+    return number - 1;
+}
@@ -0,0 +1,64 @@
+#ifndef _LINE_NUMBERER_H_
+#define _LINE_NUMBERER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "Async_writer.h"
+
+/*
+
+    - Line_numberer writes every non empty line as "<number>   <line>" and every empty
+      line as it is, like the getline loop of this challenge did, to a stream.
+
+    - input is given in pieces of any size, a line may start in one piece and end in the
+      next, newlines are found with memchr and the numbers are formatted two digits at a time.
+
+    - the output goes through an Async_writer (see Async_writer.h), 1 MiB buffers that a
+      background thread writes while the next one is formatted, not one flush per line as
+      std::endl did.
+
+    - first_number lets a chunk of a bigger file be numbered on its own.
+
+*/
+class Line_numberer
+{
+private:
+    Async_writer writer;
+    std::uintmax_t next_number;
+    bool line_start;
+
+    void append_number(std::uintmax_t number);
+
+public:
+    explicit Line_numberer(std::ostream &os, std::uintmax_t first_number = 1);
+
+    Line_numberer(const Line_numberer &) = delete;
+    Line_numberer &operator=(const Line_numberer &) = delete;
+
+    void write(const char *data, std::size_t size);
+
+    // ends a last line that has no '\n', as getline and std::endl did, then flushes
+    void finish();
+    void flush();
+
+    // the number the next non empty line gets
+    std::uintmax_t get_next_number() const;
+};
+
+/*
+
+    - number_lines numbers the lines of from into to and returns how many lines got a number.
+
+    - from is split into num_threads chunks on line boundaries (see ../challenge3/Chunked_file.h), 0 is
+      one per hardware thread. a first pass counts the non empty lines of every chunk, that
+      gives the first number and the output offset of each chunk, a second pass numbers
+      the chunks in parallel, each through its own std::ofstream seeked to its place in to.
+
+    - errors throw std::runtime_error.
+
+*/
+std::uintmax_t number_lines(const std::string &from, const std::string &to, std::size_t num_threads = 0);
+
+#endif
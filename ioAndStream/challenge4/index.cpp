@@ -1,35 +1,18 @@
 #include <iostream>
-#include <fstream>
+#include <stdexcept>
 #include <string>
-#include <algorithm>
-#include <cctype>
+#include "Line_numberer.h"
 
-int main()
-{
-    std::ifstream in_file;
-    std::ofstream out_file;
-
-    in_file.open("romeoAndJuliet.txt");
+/*
 
-    if (!in_file.is_open())
-    {
-        std::cout << "The file is not found." << std::endl;
-        return 1;
-    }
+    g++ -std=c++17 -O2 -pthread index.cpp Line_numberer.cpp Async_writer.cpp ../challenge3/Chunked_file.cpp ../compressedStream/Compressed_stream.cpp ../compressedStream/Lz4.cpp
 
-    out_file.open("test.txt");
-
-    if (!out_file.is_open())
-    {
-        std::cout << "Could not create a file." << std::endl;
-        return 1;
-    }
+    the first version, one std::string and one flush per line:
 
     std::string line;
     int line_counter {0};
     while (std::getline(in_file, line))
     {
-        
         if (line.length() > 0)
         {
             line_counter++;
@@ -38,10 +21,33 @@ int main()
         else
             out_file << line << std::endl;
     }
-    
-    
-    in_file.close();
-    out_file.close();
-    
+
+    number_lines does the same on big blocks of the file, a chunk of it per thread,
+    see Line_numberer.h.
+
+    ./a.out [from] [to] [threads]
+
+    from can be compressed with lz4, e.g. lz4 romeoAndJuliet.txt, ./a.out romeoAndJuliet.txt.lz4,
+    see ../challenge3/Chunked_file.h.
+
+*/
+
+int main(int argc, char *argv[])
+{
+    const char *from {argc > 1 ? argv[1] : "romeoAndJuliet.txt"};
+    const char *to {argc > 2 ? argv[2] : "test.txt"};
+    std::size_t num_threads {argc > 3 ? std::stoul(argv[3]) : 0};
+
+    try
+    {
+        std::uintmax_t lines = number_lines(from, to, num_threads);
+        std::cout << "Numbered " << lines << " lines." << std::endl;
+    }
+    catch (const std::runtime_error &ex)
+    {
+        std::cout << "Could not number the file: " << ex.what() << std::endl;
+        return 1;
+    }
+
     return 0;
 }
@@ -0,0 +1,147 @@
+/*
+
+    - compares formatting report lines with std::setw, std::setprecision and std::fixed
+      into a stream against Line_buffer (../challenge/Format.h), and checks that both
+      produce the same bytes.
+
+    - the lines are the ones of the Tour report (../challenge), the scores of ../challenge2,
+      and the formats that floatManipulators and alignAndFill show.
+
+    - build it together with the challenge sources:
+        g++ -std=c++17 -O2 index.cpp ../challenge/Format.cpp
+
+    - the number of lines can be given on the command line, e.g. ./a.out 100000
+
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../challenge/Format.h"
+
+struct Row
+{
+    std::string country;
+    std::string city;
+    long int population;
+    double cost;
+    int score;
+};
+
+std::vector<Row> make_rows(std::size_t size)
+{
+    const char *countries[] {"Colombia", "Brazil", "Chile", "Argentian"};
+    const char *cities[] {"Bogota", "Cali", "Rio De Janiero", "Sao Paulo", "Valdivia", "Buenos Aires"};
+
+    std::mt19937 gen {7};
+    std::uniform_int_distribution<long int> population {1000, 200000000};
+    std::uniform_int_distribution<int> cents {10000, 99999};
+    std::uniform_int_distribution<int> score {0, 5};
+
+    std::vector<Row> rows;
+    rows.reserve(size);
+    for (std::size_t i {0}; i < size; i++)
+        rows.push_back({countries[i % 4], cities[i % 6], population(gen), cents(gen) / 100.0, score(gen)});
+    return rows;
+}
+
+std::string with_streams(const std::vector<Row> &rows)
+{
+    std::ostringstream out;
+    for (const Row &row : rows)
+    {
+        out << std::setw(25) << std::left << row.country
+            << std::setw(25) << std::left << row.city
+            << std::setw(25) << std::right << row.population
+            << std::setw(25) << std::right << row.cost << '\n';
+
+        out << std::setw(15) << std::left << row.city
+            << std::setw(15) << std::right << row.score << '\n';
+
+        out << std::setprecision(1) << std::fixed
+            << std::setw(15) << std::left << "Average score: "
+            << std::setw(15) << std::right << row.cost / 100 << '\n';
+
+        // the floatManipulators and alignAndFill formats
+        out.unsetf(std::ios::fixed);
+        out << std::setprecision(2) << row.cost << ' ' << std::setprecision(9) << row.cost * 1e6 << ' ';
+        out << std::setprecision(3) << std::fixed << row.cost << ' ';
+        out << std::scientific << row.cost << '\n';
+        out.unsetf(std::ios::scientific | std::ios::fixed);
+        out << std::setprecision(6);
+
+        // std::setfill stays, the city is filled with '*' too, as in alignAndFill
+        out << std::setw(10) << std::left << std::setfill('-') << row.score
+            << std::setw(10) << std::left << std::setfill('*') << row.cost
+            << std::setw(15) << std::left << row.city << std::setfill(' ') << std::right << '\n';
+    }
+    return out.str();
+}
+
+std::string with_line_buffer(const std::vector<Row> &rows)
+{
+    std::string out;
+    Line_buffer line;
+    for (const Row &row : rows)
+    {
+        line.clear();
+        line.text(row.country, 25, Align::Left)
+            .text(row.city, 25, Align::Left)
+            .integer(row.population, 25)
+            .general(row.cost, 6, 25)
+            .newline();
+
+        line.text(row.city, 15, Align::Left).integer(row.score, 15).newline();
+
+        line.text("Average score: ", 15, Align::Left).fixed(row.cost / 100, 1, 15).newline();
+
+        line.general(row.cost, 2).text(" ").general(row.cost * 1e6, 9).text(" ");
+        line.fixed(row.cost, 3).text(" ");
+        line.scientific(row.cost, 3).newline();
+
+        line.integer(row.score, 10, Align::Left, '-')
+            .general(row.cost, 6, 10, Align::Left, '*')
+            .text(row.city, 15, Align::Left, '*')
+            .newline();
+
+        out.append(line.view());
+    }
+    return out;
+}
+
+template<typename Fn>
+double measure_ms(Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t size {argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000};
+    std::vector<Row> rows = make_rows(size);
+
+    std::string streams;
+    std::string buffer;
+    double streams_ms = measure_ms([&] { streams = with_streams(rows); });
+    double buffer_ms = measure_ms([&] { buffer = with_line_buffer(rows); });
+
+    if (streams != buffer)
+    {
+        std::cout << "The outputs are different." << std::endl;
+        return 1;
+    }
+
+    std::cout << size << " rows, " << buffer.size() << " bytes, the same with both" << std::endl;
+    std::cout << std::setw(15) << std::left << "iomanip" << std::setw(10) << std::right << streams_ms << " ms" << std::endl;
+    std::cout << std::setw(15) << std::left << "Line_buffer" << std::setw(10) << std::right << buffer_ms << " ms" << std::endl;
+
+    return 0;
+}
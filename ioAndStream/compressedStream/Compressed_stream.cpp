@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Compressed_stream.h"
+
+namespace
+{
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    bool starts_with(std::string_view text, std::string_view prefix)
+    {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+}
+
+Codec detect_codec(std::string_view first_bytes)
+{
+    using namespace std::string_view_literals;
+
+    // a skippable frame, 0x184D2A5?, is the start of an lz4 file too
+    if (starts_with(first_bytes, "\x04\x22\x4d\x18"sv)
+        || (first_bytes.size() >= 4 && (first_bytes[0] & 0xf0) == 0x50 && first_bytes.substr(1, 3) == "\x2a\x4d\x18"sv))
+        return Codec::lz4;
+    if (starts_with(first_bytes, "\x28\xb5\x2f\xfd"sv))
+        return Codec::zstd;
+    if (starts_with(first_bytes, "\x1f\x8b"sv))
+        return Codec::gzip;
+    if (starts_with(first_bytes, "\xfd\x37\x7a\x58\x5a\x00"sv))
+        return Codec::xz;
+    return Codec::plain;
+}
+
+const char *to_string(Codec codec)
+{
+    switch (codec)
+    {
+    case Codec::plain:
+        return "plain";
+    case Codec::lz4:
+        return "lz4";
+    case Codec::zstd:
+        return "zstd";
+    case Codec::gzip:
+        return "gzip";
+    case Codec::xz:
+        return "xz";
+    }
+    return "unknown";
+}
+
+Compressed_reader::Compressed_reader(const std::string &path, std::size_t depth, std::size_t block_size)
+    : fd{-1}, codec{Codec::plain}, slots(depth == 0 ? 1 : depth), slot_sizes(slots.size(), 0),
+      produced{0}, consumed{0}, holding{false}, done{false}, stopping{false}
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+        fail("open " + path);
+
+    // the magic number, read and kept for the thread, the file can be a pipe
+    try
+    {
+        char first_bytes[6];
+        const std::size_t got = this->read_some(first_bytes, sizeof first_bytes);
+        this->head.assign(first_bytes, got);
+    }
+    catch (const std::runtime_error &)
+    {
+        ::close(this->fd);
+        throw;
+    }
+    this->codec = detect_codec(this->head);
+    if (this->codec != Codec::plain && this->codec != Codec::lz4)
+    {
+        ::close(this->fd);
+        throw std::runtime_error(path + " is compressed with " + to_string(this->codec) + ", only lz4 is decompressed here");
+    }
+    ::posix_fadvise(this->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // the blocks of lz4 are as big as the frame says, they are copied in
+    if (this->codec == Codec::plain)
+        for (std::vector<char> &slot : this->slots)
+            slot.resize(block_size == 0 ? 1 : block_size);
+
+    this->thread = std::thread{&Compressed_reader::run, this};
+}
+
+Compressed_reader::~Compressed_reader()
+{
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        this->stopping = true;
+    }
+    this->changed.notify_all();
+    this->thread.join();
+    ::close(this->fd);
+}
+
+// up to size bytes, fewer only at the end of the file
+std::size_t Compressed_reader::read_some(char *data, std::size_t size)
+{
+    std::size_t total = std::min(size, this->head.size());
+    this->head.copy(data, total);
+    this->head.erase(0, total);
+    while (total < size)
+    {
+        const ssize_t got = ::read(this->fd, data + total, size - total);
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            fail("read");
+        }
+        if (got == 0)
+            break;
+        total += static_cast<std::size_t>(got);
+    }
+    return total;
+}
+
+// the background thread, fills the free slots in order until the end of the text
+void Compressed_reader::run()
+{
+    try
+    {
+        Lz4_frame_decoder decoder {[this](char *data, std::size_t size) { return this->read_some(data, size); }};
+
+        for (;;)
+        {
+            std::size_t slot;
+            {
+                std::unique_lock<std::mutex> lock {this->mutex};
+                this->changed.wait(lock, [this] { return this->produced - this->consumed < this->slots.size() || this->stopping; });
+                if (this->stopping)
+                    return;
+                slot = this->produced % this->slots.size();
+            }
+
+            // only this thread touches the slot until produced counts it
+            std::vector<char> &block = this->slots[slot];
+            std::size_t size;
+            if (this->codec == Codec::plain)
+                size = this->read_some(block.data(), block.size());
+            else
+            {
+                const std::string_view text = decoder.next_block();
+                block.assign(text.begin(), text.end());
+                size = text.size();
+            }
+
+            std::lock_guard<std::mutex> lock {this->mutex};
+            if (size == 0)
+                this->done = true;
+            else
+            {
+                this->slot_sizes[slot] = size;
+                this->produced++;
+            }
+            this->changed.notify_all();
+            if (this->done)
+                return;
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        this->error = std::current_exception();
+        this->done = true;
+        this->changed.notify_all();
+    }
+}
+
+Codec Compressed_reader::get_codec() const
+{
+    return this->codec;
+}
+
+std::string_view Compressed_reader::next_block()
+{
+    std::unique_lock<std::mutex> lock {this->mutex};
+    if (this->holding)
+    {
+        this->consumed++;
+        this->holding = false;
+        this->changed.notify_all();
+    }
+
+    this->changed.wait(lock, [this] { return this->produced > this->consumed || this->done; });
+    if (this->produced > this->consumed)
+    {
+        const std::size_t slot = this->consumed % this->slots.size();
+        this->holding = true;
+        return std::string_view{this->slots[slot].data(), this->slot_sizes[slot]};
+    }
+    if (this->error)
+    {
+        std::exception_ptr error = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(error);
+    }
+    return {};
+}
+
+std::string Compressed_reader::read_all()
+{
+    std::string text;
+    for (std::string_view block = this->next_block(); !block.empty(); block = this->next_block())
+        text.append(block);
+    return text;
+}
+
+Lz4_writer::Lz4_writer(std::ostream &os, std::size_t block_size)
+    : os{os}, encoder{block_size}, buffer(block_size), started{false}, finished{false}
+{
+    this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+}
+
+Lz4_writer::~Lz4_writer()
+{
+    try
+    {
+        this->finish();
+    }
+    catch (const std::runtime_error &) {}
+}
+
+// the buffer as a block of the frame, the frame starts with the first one
+void Lz4_writer::write_block()
+{
+    if (!this->started)
+    {
+        this->encoder.begin(this->out);
+        this->started = true;
+        this->finished = false;
+    }
+    const std::size_t used = static_cast<std::size_t>(this->pptr() - this->pbase());
+    this->encoder.block(this->buffer.data(), used, this->out);
+    this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+
+    this->os.write(this->out.data(), static_cast<std::streamsize>(this->out.size()));
+    this->out.clear();
+    if (!this->os)
+        throw std::runtime_error("Lz4_writer: writing to the stream failed");
+}
+
+Lz4_writer::int_type Lz4_writer::overflow(int_type ch)
+{
+    this->write_block();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *this->pptr() = traits_type::to_char_type(ch);
+        this->pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize Lz4_writer::xsputn(const char *data, std::streamsize size)
+{
+    std::size_t left = static_cast<std::size_t>(size);
+    while (left > 0)
+    {
+        const std::size_t room = static_cast<std::size_t>(this->epptr() - this->pptr());
+        if (room == 0)
+        {
+            this->write_block();
+            continue;
+        }
+        const std::size_t count = left < room ? left : room;
+        std::memcpy(this->pptr(), data, count);
+        this->pbump(static_cast<int>(count));
+        data += count;
+        left -= count;
+    }
+    return size;
+}
+
+// std::ostream::flush ends here, a failure is reported as the -1 it expects
+int Lz4_writer::sync()
+{
+    try
+    {
+        this->flush();
+    }
+    catch (const std::runtime_error &)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+void Lz4_writer::flush()
+{
+    if (this->pptr() != this->pbase())
+        this->write_block();
+    this->os.flush();
+    if (!this->os)
+        throw std::runtime_error("Lz4_writer: flushing the stream failed");
+}
+
+// the end mark and the checksum, what is written after is a new frame
+void Lz4_writer::finish()
+{
+    if (this->finished && !this->started)
+        return;
+    this->write_block();
+    this->encoder.end(this->out);
+    this->os.write(this->out.data(), static_cast<std::streamsize>(this->out.size()));
+    this->out.clear();
+    this->started = false;
+    this->finished = true;
+    this->flush();
+}
@@ -0,0 +1,127 @@
+#ifndef _COMPRESSED_STREAM_H_
+#define _COMPRESSED_STREAM_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Lz4.h"
+
+/*
+
+    - the codec of a file is the one of its first bytes, the magic number of its format,
+      a file that has none is plain text. lz4 is decompressed, zstd, gzip and xz are known
+      and refused, their formats are not written here.
+
+    - Compressed_reader reads a file, plain or lz4, as blocks of its text. a background
+      thread reads and decompresses up to depth blocks ahead while the caller parses the
+      ones it has, the text comes at the speed of the decompression, not of the disk, a
+      file of a third of the size is three times the bandwidth of the disk. an error of the
+      thread is thrown by next_block after the blocks before it. the file can be a pipe,
+      e.g. /dev/stdin.
+
+    - Chunked_file (../challenge3, for ../challenge4 and standardTemplateLibrary/challengeThree
+      too) decompresses a compressed file into memory with a Compressed_reader, the chunks,
+      the threads and the results are the same as the ones of the plain file.
+
+    - Lz4_writer is a std::streambuf that writes an lz4 frame of what it gets to a stream.
+      under an Async_writer (../challenge4/Async_writer.h) the compression runs on the
+      thread of the writer, the formatting does not wait for it:
+        std::ofstream file {"out.txt.lz4", std::ios::binary};
+        Lz4_writer lz4 {file};
+        std::ostream compressed {&lz4};
+        Async_writer writer {compressed};
+      flush() writes the block it has, finish() the end of the frame, the destructor does
+      it too, when nothing was finished before.
+
+    - errors throw std::runtime_error, with the errno text for the ones of the system.
+
+*/
+enum class Codec
+{
+    plain,
+    lz4,
+    zstd,
+    gzip,
+    xz
+};
+
+Codec detect_codec(std::string_view first_bytes);
+const char *to_string(Codec codec);
+
+class Compressed_reader
+{
+private:
+    int fd;
+    Codec codec;
+    // the first bytes, read before the thread starts
+    std::string head;
+
+    std::vector<std::vector<char>> slots;
+    std::vector<std::size_t> slot_sizes;
+    std::size_t produced;   // slots filled by the thread so far
+    std::size_t consumed;   // slots given back by the caller
+    bool holding;           // the caller has the view of slot consumed
+    bool done;
+    bool stopping;
+    std::exception_ptr error;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    void run();
+    std::size_t read_some(char *data, std::size_t size);
+
+public:
+    // depth blocks of block_size are decompressed ahead at most
+    explicit Compressed_reader(const std::string &path, std::size_t depth = 4, std::size_t block_size = 1 << 20);
+    ~Compressed_reader();
+
+    Compressed_reader(const Compressed_reader &) = delete;
+    Compressed_reader &operator=(const Compressed_reader &) = delete;
+
+    Codec get_codec() const;
+
+    // the next block of the text, empty at the end, the view lives until the next call
+    std::string_view next_block();
+
+    // the rest of the text
+    std::string read_all();
+};
+
+class Lz4_writer : public std::streambuf
+{
+private:
+    std::ostream &os;
+    Lz4_frame_encoder encoder;
+    std::vector<char> buffer;
+    std::string out;
+    bool started;
+    bool finished;
+
+    void write_block();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char *data, std::streamsize size) override;
+    int sync() override;
+
+public:
+    explicit Lz4_writer(std::ostream &os, std::size_t block_size = 1 << 20);
+    ~Lz4_writer() override;
+
+    Lz4_writer(const Lz4_writer &) = delete;
+    Lz4_writer &operator=(const Lz4_writer &) = delete;
+
+    void flush();
+    void finish();
+};
+
+#endif
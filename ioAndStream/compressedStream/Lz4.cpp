@@ -0,0 +1,506 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Lz4.h"
+
+namespace
+{
+    constexpr std::uint32_t prime1 = 2654435761U;
+    constexpr std::uint32_t prime2 = 2246822519U;
+    constexpr std::uint32_t prime3 = 3266489917U;
+    constexpr std::uint32_t prime4 = 668265263U;
+    constexpr std::uint32_t prime5 = 374761393U;
+
+    constexpr std::uint32_t frame_magic = 0x184D2204;
+    constexpr std::uint32_t skippable_magic = 0x184D2A50;
+    constexpr std::size_t max_offset = 65535;
+
+    // a match is at least 4 bytes, the last 5 bytes of a block are literals and the last
+    // match starts 12 bytes before the end at the latest, the decoder of lz4 counts on it
+    constexpr std::size_t min_match = 4;
+    constexpr std::size_t last_literals = 5;
+    constexpr std::size_t match_find_limit = 12;
+    constexpr int hash_log = 14;
+
+    std::uint32_t rotl(std::uint32_t x, int r)
+    {
+        return (x << r) | (x >> (32 - r));
+    }
+
+    std::uint32_t load32(const void *p)
+    {
+        std::uint32_t x;
+        std::memcpy(&x, p, 4);
+        return x;
+    }
+
+    std::uint64_t load64(const void *p)
+    {
+        std::uint64_t x;
+        std::memcpy(&x, p, 8);
+        return x;
+    }
+
+    // the bytes from a and b that are equal, up to a_limit, 8 at a time
+    std::size_t common_length(const unsigned char *a, const unsigned char *b, const unsigned char *a_limit)
+    {
+        const unsigned char *const start = a;
+        for (; a + 8 <= a_limit; a += 8, b += 8)
+        {
+            const std::uint64_t differ = load64(a) ^ load64(b);
+            if (differ != 0)
+                return static_cast<std::size_t>(a - start) + static_cast<std::size_t>(__builtin_ctzll(differ)) / 8;
+        }
+        for (; a < a_limit && *a == *b; ++a, ++b)
+            ;
+        return static_cast<std::size_t>(a - start);
+    }
+
+    // 16 bytes, the copies of the decoder go past the end of what they copy when there is room
+    void copy16(char *dest, const void *src)
+    {
+        std::memcpy(dest, src, 16);
+    }
+
+    std::uint32_t le32(const unsigned char *p)
+    {
+        return p[0] | static_cast<std::uint32_t>(p[1]) << 8 | static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+    void put_le32(std::string &out, std::uint32_t x)
+    {
+        const char bytes[4] {static_cast<char>(x), static_cast<char>(x >> 8), static_cast<char>(x >> 16), static_cast<char>(x >> 24)};
+        out.append(bytes, 4);
+    }
+
+    std::uint32_t round(std::uint32_t acc, std::uint32_t input)
+    {
+        return rotl(acc + input * prime2, 13) * prime1;
+    }
+
+    std::uint32_t hash(std::uint32_t sequence)
+    {
+        return (sequence * prime1) >> (32 - hash_log);
+    }
+
+    unsigned char *put_length(unsigned char *op, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            *op++ = 255;
+        *op++ = static_cast<unsigned char>(length);
+        return op;
+    }
+
+    unsigned char *put_sequence(unsigned char *op, const unsigned char *literals, std::size_t num_literals, std::size_t offset, std::size_t match_length)
+    {
+        const std::size_t extra = match_length - min_match;
+        unsigned char *token = op++;
+        *token = static_cast<unsigned char>(std::min<std::size_t>(num_literals, 15) << 4 | std::min<std::size_t>(extra, 15));
+        if (num_literals >= 15)
+            op = put_length(op, num_literals - 15);
+        std::memcpy(op, literals, num_literals);
+        op += num_literals;
+        *op++ = static_cast<unsigned char>(offset);
+        *op++ = static_cast<unsigned char>(offset >> 8);
+        if (extra >= 15)
+            op = put_length(op, extra - 15);
+        return op;
+    }
+
+    void corrupt(const char *what)
+    {
+        throw std::runtime_error(std::string{"lz4: a corrupt block, "} + what);
+    }
+
+    // a length of 15 goes on in the bytes after, up to one that is not 255
+    std::size_t get_length(const unsigned char *&ip, const unsigned char *end, std::size_t length)
+    {
+        if (length != 15)
+            return length;
+        for (;;)
+        {
+            if (ip == end)
+                corrupt("it ends in a length");
+            const unsigned char byte = *ip++;
+            length += byte;
+            if (byte != 255)
+                return length;
+        }
+    }
+}
+
+Xxh32::Xxh32(std::uint32_t seed)
+    : state{seed + prime1 + prime2, seed + prime2, seed, seed - prime1}, seed{seed}, pending{}, pending_size{0}, total{0}
+{
+}
+
+void Xxh32::update(const void *data, std::size_t size)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    this->total += size;
+
+    if (this->pending_size + size < 16)
+    {
+        std::memcpy(this->pending + this->pending_size, p, size);
+        this->pending_size += size;
+        return;
+    }
+    if (this->pending_size > 0)
+    {
+        const std::size_t fill = 16 - this->pending_size;
+        std::memcpy(this->pending + this->pending_size, p, fill);
+        for (int i = 0; i < 4; ++i)
+            this->state[i] = round(this->state[i], load32(this->pending + 4 * i));
+        p += fill;
+        size -= fill;
+        this->pending_size = 0;
+    }
+    // 4 lanes of 4 bytes
+    for (; size >= 16; p += 16, size -= 16)
+        for (int i = 0; i < 4; ++i)
+            this->state[i] = round(this->state[i], load32(p + 4 * i));
+    std::memcpy(this->pending, p, size);
+    this->pending_size = size;
+}
+
+std::uint32_t Xxh32::digest() const
+{
+    std::uint32_t h = this->total >= 16
+        ? rotl(this->state[0], 1) + rotl(this->state[1], 7) + rotl(this->state[2], 12) + rotl(this->state[3], 18)
+        : this->seed + prime5;
+    h += static_cast<std::uint32_t>(this->total);
+
+    std::size_t i = 0;
+    for (; i + 4 <= this->pending_size; i += 4)
+        h = rotl(h + load32(this->pending + i) * prime3, 17) * prime4;
+    for (; i < this->pending_size; ++i)
+        h = rotl(h + this->pending[i] * prime5, 11) * prime1;
+
+    h ^= h >> 15;
+    h *= prime2;
+    h ^= h >> 13;
+    h *= prime3;
+    h ^= h >> 16;
+    return h;
+}
+
+std::uint32_t xxh32(const void *data, std::size_t size, std::uint32_t seed)
+{
+    Xxh32 hash{seed};
+    hash.update(data, size);
+    return hash.digest();
+}
+
+std::size_t lz4_compress_bound(std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+std::size_t lz4_compress_block(const char *src, std::size_t size, char *dest)
+{
+    const unsigned char *const begin = reinterpret_cast<const unsigned char *>(src);
+    const unsigned char *const end = begin + size;
+    const unsigned char *anchor = begin;
+    unsigned char *op = reinterpret_cast<unsigned char *>(dest);
+
+    if (size > match_find_limit)
+    {
+        std::vector<std::uint32_t> table(std::size_t{1} << hash_log, 0);
+        const unsigned char *const match_limit = end - match_find_limit;
+        const unsigned char *const match_end_limit = end - last_literals;
+        const unsigned char *ip = begin + 1;
+        // the step grows on data that does not compress, it is back to 1 at every match
+        std::size_t misses = 0;
+
+        while (ip < match_limit)
+        {
+            const std::uint32_t h = hash(load32(ip));
+            const unsigned char *candidate = begin + table[h];
+            table[h] = static_cast<std::uint32_t>(ip - begin);
+            if (static_cast<std::size_t>(ip - candidate) > max_offset || load32(candidate) != load32(ip))
+            {
+                ip += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            while (ip > anchor && candidate > begin && ip[-1] == candidate[-1])
+            {
+                ip--;
+                candidate--;
+            }
+            const std::size_t length = min_match + common_length(ip + min_match, candidate + min_match, match_end_limit);
+
+            op = put_sequence(op, anchor, static_cast<std::size_t>(ip - anchor), static_cast<std::size_t>(ip - candidate), length);
+            ip += length;
+            anchor = ip;
+            if (ip < match_limit)
+                table[hash(load32(ip - 2))] = static_cast<std::uint32_t>(ip - 2 - begin);
+        }
+    }
+
+    // the last literals, a token with no match
+    const std::size_t num_literals = static_cast<std::size_t>(end - anchor);
+    *op++ = static_cast<unsigned char>(std::min<std::size_t>(num_literals, 15) << 4);
+    if (num_literals >= 15)
+        op = put_length(op, num_literals - 15);
+    std::memcpy(op, anchor, num_literals);
+    op += num_literals;
+    return static_cast<std::size_t>(op - reinterpret_cast<unsigned char *>(dest));
+}
+
+std::size_t lz4_decompress_block(const char *src, std::size_t size, char *dest, std::size_t capacity, const char *window)
+{
+    const unsigned char *ip = reinterpret_cast<const unsigned char *>(src);
+    const unsigned char *const end = ip + size;
+    char *op = dest;
+    char *const limit = dest + capacity;
+
+    for (;;)
+    {
+        if (ip == end)
+            corrupt("it ends in a sequence");
+        const unsigned char token = *ip++;
+
+        // most literals are short and far from the ends, one copy of 16 bytes for them
+        const std::size_t short_literals = token >> 4;
+        if (short_literals < 15 && end - ip >= 18 && limit - op >= 32)
+        {
+            copy16(op, ip);
+            op += short_literals;
+            ip += short_literals;
+        }
+        else
+        {
+            const std::size_t num_literals = get_length(ip, end, short_literals);
+            if (num_literals > static_cast<std::size_t>(end - ip) || num_literals > static_cast<std::size_t>(limit - op))
+                corrupt("the literals go past its end");
+            std::memcpy(op, ip, num_literals);
+            op += num_literals;
+            ip += num_literals;
+            // the last sequence has no match
+            if (ip == end)
+                break;
+        }
+
+        if (end - ip < 2)
+            corrupt("it ends in an offset");
+        const std::size_t offset = ip[0] | static_cast<std::size_t>(ip[1]) << 8;
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - window))
+            corrupt("a match is before its window");
+        const std::size_t length = get_length(ip, end, token & 15) + min_match;
+        if (length > static_cast<std::size_t>(limit - op))
+            corrupt("a match goes past its end");
+
+        const char *match = op - offset;
+        if (offset >= 16 && static_cast<std::size_t>(limit - op) >= length + 16)
+            for (std::size_t i = 0; i < length; i += 16)
+                copy16(op + i, match + i);
+        else if (offset >= length)
+            std::memcpy(op, match, length);
+        else
+            // the match overlaps the bytes it writes, a run
+            for (std::size_t i = 0; i < length; ++i)
+                op[i] = match[i];
+        op += length;
+    }
+    return static_cast<std::size_t>(op - dest);
+}
+
+Lz4_frame_encoder::Lz4_frame_encoder(std::size_t block_size)
+    : block_size{block_size}
+{
+    if (block_size != 1 << 16 && block_size != 1 << 18 && block_size != 1 << 20 && block_size != 1 << 22)
+        throw std::invalid_argument("lz4: a block size is 64 KiB, 256 KiB, 1 MiB or 4 MiB");
+    this->compressed.resize(lz4_compress_bound(block_size));
+}
+
+std::size_t Lz4_frame_encoder::get_block_size() const
+{
+    return this->block_size;
+}
+
+void Lz4_frame_encoder::begin(std::string &out)
+{
+    int code = 4;
+    while (std::size_t{1} << (8 + 2 * code) < this->block_size)
+        code++;
+    // version 01, independent blocks, a checksum of the content
+    const unsigned char descriptor[2] {0x64, static_cast<unsigned char>(code << 4)};
+
+    put_le32(out, frame_magic);
+    out.append(reinterpret_cast<const char *>(descriptor), 2);
+    out.push_back(static_cast<char>(xxh32(descriptor, 2) >> 8));
+    this->content_hash = Xxh32{};
+}
+
+void Lz4_frame_encoder::block(const char *data, std::size_t size, std::string &out)
+{
+    while (size > 0)
+    {
+        const std::size_t piece = std::min(size, this->block_size);
+        this->content_hash.update(data, piece);
+
+        const std::size_t compressed_size = lz4_compress_block(data, piece, this->compressed.data());
+        if (compressed_size < piece)
+        {
+            put_le32(out, static_cast<std::uint32_t>(compressed_size));
+            out.append(this->compressed.data(), compressed_size);
+        }
+        else
+        {
+            put_le32(out, static_cast<std::uint32_t>(piece) | 0x80000000U);
+            out.append(data, piece);
+        }
+        data += piece;
+        size -= piece;
+    }
+}
+
+void Lz4_frame_encoder::end(std::string &out)
+{
+    put_le32(out, 0);
+    put_le32(out, this->content_hash.digest());
+}
+
+Lz4_frame_decoder::Lz4_frame_decoder(Read read)
+    : read{std::move(read)}, window_size{0}, last_size{0}, in_frame{false}, independent{true},
+      block_checksum{false}, content_checksum{false}
+{
+}
+
+void Lz4_frame_decoder::read_exact(void *data, std::size_t size, const char *what)
+{
+    if (this->read(static_cast<char *>(data), size) != size)
+        throw std::runtime_error(std::string{"lz4: the input ends in "} + what);
+}
+
+// the header of the next frame, false at the end of the input
+bool Lz4_frame_decoder::read_header()
+{
+    for (;;)
+    {
+        unsigned char magic[4];
+        const std::size_t got = this->read(reinterpret_cast<char *>(magic), 4);
+        if (got == 0)
+            return false;
+        if (got < 4)
+            throw std::runtime_error("lz4: the input ends in a magic number");
+
+        const std::uint32_t word = le32(magic);
+        if ((word & 0xFFFFFFF0U) == skippable_magic)
+        {
+            unsigned char size_bytes[4];
+            this->read_exact(size_bytes, 4, "a skippable frame");
+            for (std::size_t size = le32(size_bytes); size > 0;)
+            {
+                this->input.resize(std::max<std::size_t>(this->input.size(), 1 << 16));
+                const std::size_t piece = std::min(size, this->input.size());
+                this->read_exact(this->input.data(), piece, "a skippable frame");
+                size -= piece;
+            }
+            continue;
+        }
+        if (word != frame_magic)
+            throw std::runtime_error("lz4: the input is not an lz4 frame");
+
+        unsigned char descriptor[11];
+        this->read_exact(descriptor, 2, "a frame header");
+        const unsigned char flags = descriptor[0];
+        if (flags >> 6 != 1)
+            throw std::runtime_error("lz4: an unknown version of the frame format");
+        if (flags & 0x01)
+            throw std::runtime_error("lz4: frames with a dictionary are not supported");
+        const int code = (descriptor[1] >> 4) & 7;
+        if (code < 4)
+            throw std::runtime_error("lz4: an unknown block size");
+
+        std::size_t length = 2;
+        // the size of the content, it is not needed
+        if (flags & 0x08)
+        {
+            this->read_exact(descriptor + 2, 8, "a frame header");
+            length += 8;
+        }
+        this->read_exact(descriptor + length, 1, "a frame header");
+        if (static_cast<unsigned char>(xxh32(descriptor, length) >> 8) != descriptor[length])
+            throw std::runtime_error("lz4: the checksum of a frame header is wrong");
+
+        this->independent = (flags & 0x20) != 0;
+        this->block_checksum = (flags & 0x10) != 0;
+        this->content_checksum = (flags & 0x04) != 0;
+        const std::size_t block_max = std::size_t{1} << (8 + 2 * code);
+        this->input.resize(block_max);
+        this->output.resize(max_offset + 1 + block_max);
+        this->window_size = 0;
+        this->last_size = 0;
+        this->content_hash = Xxh32{};
+        this->in_frame = true;
+        return true;
+    }
+}
+
+std::string_view Lz4_frame_decoder::next_block()
+{
+    for (;;)
+    {
+        if (!this->in_frame && !this->read_header())
+            return {};
+
+        // the last 64 KiB of the blocks before are the window of a linked block, they move
+        // to the front now that the view of the last one is not used any more
+        if (!this->independent && this->last_size > 0)
+        {
+            const std::size_t total = this->window_size + this->last_size;
+            const std::size_t keep = std::min(total, max_offset + 1);
+            std::memmove(this->output.data(), this->output.data() + total - keep, keep);
+            this->window_size = keep;
+        }
+        this->last_size = 0;
+
+        unsigned char size_bytes[4];
+        this->read_exact(size_bytes, 4, "a block");
+        const std::uint32_t word = le32(size_bytes);
+        if (word == 0)
+        {
+            if (this->content_checksum)
+            {
+                unsigned char checksum[4];
+                this->read_exact(checksum, 4, "the checksum of a frame");
+                if (le32(checksum) != this->content_hash.digest())
+                    throw std::runtime_error("lz4: the checksum of the content is wrong");
+            }
+            this->in_frame = false;
+            continue;
+        }
+
+        const bool stored = (word & 0x80000000U) != 0;
+        const std::size_t size = word & 0x7FFFFFFFU;
+        if (size > this->input.size())
+            throw std::runtime_error("lz4: a block is larger than its frame allows");
+        this->read_exact(this->input.data(), size, "a block");
+        if (this->block_checksum)
+        {
+            unsigned char checksum[4];
+            this->read_exact(checksum, 4, "the checksum of a block");
+            if (le32(checksum) != xxh32(this->input.data(), size))
+                throw std::runtime_error("lz4: the checksum of a block is wrong");
+        }
+
+        char *dest = this->output.data() + this->window_size;
+        std::size_t produced = size;
+        if (stored)
+            std::memcpy(dest, this->input.data(), size);
+        else
+            produced = lz4_decompress_block(this->input.data(), size, dest, this->input.size(),
+                                            this->independent ? dest : this->output.data());
+        if (this->content_checksum)
+            this->content_hash.update(dest, produced);
+
+        this->last_size = produced;
+        if (produced == 0)
+            continue;
+        return std::string_view{dest, produced};
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef _LZ4_H_
+#define _LZ4_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - the LZ4 format, the one of the lz4 command, written here, the repository links no
+      library. a block is a chain of sequences, literals copied as they are and a match,
+      a copy of at least 4 bytes from up to 64 KiB before, decompressing one is a few
+      memcpy per sequence, faster than the disk.
+
+    - lz4_compress_block finds the matches with a table of the last position of every hash
+      of 4 bytes, the greedy way of lz4 -1. lz4_decompress_block checks every length and
+      offset, a corrupt block throws std::runtime_error, and never writes out of dest.
+
+    - a frame is a magic number, the flags, the blocks and an end mark, Lz4_frame_encoder
+      writes frames of independent blocks with the xxHash32 checksum of the content, like
+      lz4 does by default. Lz4_frame_decoder reads the frames of lz4 and its own, linked
+      or independent blocks, with or without the checksums, and skips the skippable frames.
+
+*/
+
+// the xxHash32 of the frames, fed in pieces
+class Xxh32
+{
+private:
+    std::uint32_t state[4];
+    std::uint32_t seed;
+    unsigned char pending[16];
+    std::size_t pending_size;
+    std::uint64_t total;
+
+public:
+    explicit Xxh32(std::uint32_t seed = 0);
+
+    void update(const void *data, std::size_t size);
+    std::uint32_t digest() const;
+};
+
+std::uint32_t xxh32(const void *data, std::size_t size, std::uint32_t seed = 0);
+
+// the size of dest that is always enough for size bytes
+std::size_t lz4_compress_bound(std::size_t size);
+
+// the compressed size, dest has lz4_compress_bound(size) bytes
+std::size_t lz4_compress_block(const char *src, std::size_t size, char *dest);
+
+// the decompressed size, the matches can reach back to window, the output before dest
+std::size_t lz4_decompress_block(const char *src, std::size_t size, char *dest, std::size_t capacity, const char *window);
+
+class Lz4_frame_encoder
+{
+private:
+    std::size_t block_size;
+    Xxh32 content_hash;
+    std::vector<char> compressed;
+
+public:
+    // the largest block of a frame, 64 KiB, 256 KiB, 1 MiB or 4 MiB
+    explicit Lz4_frame_encoder(std::size_t block_size = 1 << 20);
+
+    std::size_t get_block_size() const;
+
+    // the parts of a frame appended to out, blocks of at most block_size bytes, a block
+    // that does not get smaller is stored as it is
+    void begin(std::string &out);
+    void block(const char *data, std::size_t size, std::string &out);
+    void end(std::string &out);
+};
+
+class Lz4_frame_decoder
+{
+public:
+    // reads up to size bytes, fewer only at the end of the input
+    using Read = std::function<std::size_t(char *, std::size_t)>;
+
+private:
+    Read read;
+    std::vector<char> input;
+    // 64 KiB of the blocks before and the block, the window of a linked block
+    std::vector<char> output;
+    std::size_t window_size;
+    // the size of the block of the last view
+    std::size_t last_size;
+    bool in_frame;
+    bool independent;
+    bool block_checksum;
+    bool content_checksum;
+    Xxh32 content_hash;
+
+    bool read_header();
+    void read_exact(void *data, std::size_t size, const char *what);
+
+public:
+    explicit Lz4_frame_decoder(Read read);
+
+    // the next block of the content, empty at the end of the last frame, the view lives
+    // until the next call
+    std::string_view next_block();
+};
+
+#endif
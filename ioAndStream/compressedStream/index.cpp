@@ -0,0 +1,65 @@
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "Compressed_stream.h"
+#include "../challenge4/Async_writer.h"
+
+/*
+
+    g++ -std=c++17 -O2 -pthread index.cpp Compressed_stream.cpp Lz4.cpp ../challenge4/Async_writer.cpp
+
+    compresses the text of challenge4 to romeoAndJuliet.txt.lz4 through an Async_writer, the
+    compression runs on its thread, then reads both files back with a Compressed_reader,
+    the codec of each is the one of its first bytes, see Compressed_stream.h.
+
+    ./a.out [from]
+
+*/
+
+int main(int argc, char *argv[])
+{
+    const std::string from {argc > 1 ? argv[1] : "../challenge4/romeoAndJuliet.txt"};
+    const std::string to {"romeoAndJuliet.txt.lz4"};
+
+    try
+    {
+        std::string text {Compressed_reader{from}.read_all()};
+
+        {
+            std::ofstream out_file {to, std::ios::binary};
+            if (!out_file)
+                throw std::runtime_error("open " + to + " failed");
+            Lz4_writer lz4 {out_file};
+            std::ostream compressed {&lz4};
+            Async_writer writer {compressed};
+            writer.write(text);
+        }
+
+        for (const std::string &path : {from, to})
+        {
+            Compressed_reader reader {path};
+            std::size_t bytes {0};
+            std::size_t lines {0};
+            for (std::string_view block {reader.next_block()}; !block.empty(); block = reader.next_block())
+            {
+                bytes += block.size();
+                for (char c : block)
+                    lines += c == '\n';
+            }
+            std::ifstream in_file {path, std::ios::binary | std::ios::ate};
+            std::cout << path << ": " << to_string(reader.get_codec()) << ", " << in_file.tellg() << " bytes on disk, "
+                      << bytes << " bytes of text, " << lines << " lines" << std::endl;
+        }
+
+        std::cout << "The text is the same: " << std::boolalpha << (Compressed_reader{to}.read_all() == text) << std::endl;
+    }
+    catch (const std::runtime_error &ex)
+    {
+        std::cout << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include "../../tooling/tracing/Trace.h"
 
 int main()
 {
@@ -23,9 +24,13 @@ int main()
         return 1;
     }
 
+    TRACE_SCOPE("copy_lines");
     std::string line;
     while (std::getline(in_file, line))
+    {
+        TRACE_VALUE("line bytes", line.size());
         out_file << line << std::endl;
+    }
     
     in_file.close();
     out_file.close();
@@ -0,0 +1,251 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+#include "File_copy.h"
+#include "../../tooling/tracing/Trace.h"
+
+namespace
+{
+    constexpr std::size_t buffer_size = 1 << 20;
+    constexpr std::size_t page_size = 4096;
+
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    // closes the descriptor when the copy returns or throws
+    class File
+    {
+    private:
+        int fd;
+
+    public:
+        File(const std::string &path, int flags)
+            : fd{::open(path.c_str(), flags, 0644)}
+        {
+            if (this->fd < 0)
+                fail("open " + path);
+        }
+
+        ~File()
+        {
+            ::close(this->fd);
+        }
+
+        File(const File &) = delete;
+        File &operator=(const File &) = delete;
+
+        int get() const
+        {
+            return this->fd;
+        }
+    };
+
+    struct Aligned_delete
+    {
+        void operator()(char *buff) const
+        {
+            ::operator delete(buff, std::align_val_t{page_size});
+        }
+    };
+
+    void write_all(int fd, const char *buff, std::size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written = ::write(fd, buff, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                fail("write");
+            }
+            buff += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    std::uintmax_t copy_buffered(int in, int out)
+    {
+        std::uintmax_t copied = 0;
+        std::unique_ptr<char, Aligned_delete> buff {
+            static_cast<char *>(::operator new(buffer_size, std::align_val_t{page_size}))
+        };
+
+        while (true)
+        {
+            ssize_t size = ::read(in, buff.get(), buffer_size);
+            if (size < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                fail("read");
+            }
+            if (size == 0)
+                break;
+            write_all(out, buff.get(), static_cast<std::size_t>(size));
+            copied += static_cast<std::uintmax_t>(size);
+        }
+        return copied;
+    }
+
+    void copy_mapped(int in, int out, std::size_t size)
+    {
+        if (::ftruncate(out, static_cast<off_t>(size)) < 0)
+            fail("ftruncate");
+        // an empty file can't be mapped, and there is nothing to copy
+        if (size == 0)
+            return;
+
+        void *source = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, in, 0);
+        if (source == MAP_FAILED)
+            fail("mmap source");
+
+        void *target = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0);
+        if (target == MAP_FAILED)
+        {
+            int error = errno;
+            ::munmap(source, size);
+            errno = error;
+            fail("mmap target");
+        }
+
+        ::madvise(source, size, MADV_SEQUENTIAL);
+        std::memcpy(target, source, size);
+
+        ::munmap(target, size);
+        ::munmap(source, size);
+    }
+
+    // false when the kernel can't copy this pair of files, nothing has been written then
+    bool copy_kernel(int in, int out, std::size_t size, std::uintmax_t &bytes)
+    {
+#if defined(__linux__)
+        std::size_t copied = 0;
+        bool use_sendfile = false;
+
+        while (copied < size)
+        {
+            ssize_t count = use_sendfile
+                ? ::sendfile(out, in, nullptr, size - copied)
+                : ::copy_file_range(in, nullptr, out, nullptr, size - copied, 0);
+
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                // unsupported file systems give these before the first byte
+                if (copied == 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP))
+                {
+                    if (use_sendfile)
+                        return false;
+                    use_sendfile = true;
+                    continue;
+                }
+                fail(use_sendfile ? "sendfile" : "copy_file_range");
+            }
+            // the file got shorter while copying
+            if (count == 0)
+                break;
+            copied += static_cast<std::size_t>(count);
+        }
+        bytes = copied;
+        return true;
+#else
+        (void)in;
+        (void)out;
+        (void)size;
+        (void)bytes;
+        return false;
+#endif
+    }
+}
+
+double Copy_result::get_throughput() const
+{
+    return this->seconds > 0 ? this->bytes / this->seconds / 1e6 : 0;
+}
+
+Copy_result copy_file(const std::string &from, const std::string &to, Copy_strategy strategy)
+{
+    TRACE_SCOPE("copy_file");
+    auto start = std::chrono::steady_clock::now();
+
+    File in {from, O_RDONLY};
+    // mmap needs the destination readable too, it is truncated only
+    // after checking it isn't the source, that would lose the file.
+    File out {to, O_RDWR | O_CREAT};
+
+    struct stat st, out_st;
+    if (::fstat(in.get(), &st) < 0)
+        fail("stat " + from);
+    if (::fstat(out.get(), &out_st) < 0)
+        fail("stat " + to);
+    if (st.st_dev == out_st.st_dev && st.st_ino == out_st.st_ino)
+        throw std::runtime_error(from + " and " + to + " are the same file");
+    if (::ftruncate(out.get(), 0) < 0)
+        fail("ftruncate " + to);
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    std::uintmax_t bytes = size;
+
+    // a pipe or a device has no size to hand to the kernel or to mmap
+    if (strategy == Copy_strategy::Automatic && !S_ISREG(st.st_mode))
+        strategy = Copy_strategy::Buffered;
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(in.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    switch (strategy)
+    {
+    case Copy_strategy::Automatic:
+    case Copy_strategy::Kernel:
+        if (copy_kernel(in.get(), out.get(), size, bytes))
+        {
+            strategy = Copy_strategy::Kernel;
+            break;
+        }
+        if (strategy == Copy_strategy::Kernel)
+            throw std::runtime_error("the kernel can't copy " + from + " to " + to);
+        bytes = copy_buffered(in.get(), out.get());
+        strategy = Copy_strategy::Buffered;
+        break;
+    case Copy_strategy::Buffered:
+        bytes = copy_buffered(in.get(), out.get());
+        break;
+    case Copy_strategy::Mapped:
+        copy_mapped(in.get(), out.get(), size);
+        break;
+    }
+
+    TRACE_COUNT("copied bytes", bytes);
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    return Copy_result{strategy, bytes, seconds.count()};
+}
+
+const char *to_string(Copy_strategy strategy)
+{
+    switch (strategy)
+    {
+    case Copy_strategy::Automatic:
+        return "automatic";
+    case Copy_strategy::Buffered:
+        return "buffered";
+    case Copy_strategy::Mapped:
+        return "mapped";
+    case Copy_strategy::Kernel:
+        return "kernel";
+    }
+    return "unknown";
+}
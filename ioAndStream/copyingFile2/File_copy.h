@@ -0,0 +1,43 @@
+#ifndef _FILE_COPY_H_
+#define _FILE_COPY_H_
+
+#include <cstdint>
+#include <string>
+
+/*
+
+    - copy_file copies a whole file without going through a char or a line at a time.
+
+    - Buffered reads and writes 1 MiB page aligned blocks, Mapped maps the source and the
+      destination and copies with memcpy, Kernel lets the kernel copy with
+      copy_file_range, or sendfile, without the data coming to user space (linux only).
+
+    - Automatic takes Kernel where it exists and falls back to Buffered when the kernel
+      refuses the pair of files, e.g. across file systems on old kernels.
+
+    - errors throw std::runtime_error with the errno text.
+
+*/
+enum class Copy_strategy
+{
+    Automatic,
+    Buffered,
+    Mapped,
+    Kernel
+};
+
+struct Copy_result
+{
+    Copy_strategy strategy;  // the one that did the copy, never Automatic
+    std::uintmax_t bytes;
+    double seconds;
+
+    // megabytes (10^6 bytes) per second
+    double get_throughput() const;
+};
+
+Copy_result copy_file(const std::string &from, const std::string &to, Copy_strategy strategy = Copy_strategy::Automatic);
+
+const char *to_string(Copy_strategy strategy);
+
+#endif
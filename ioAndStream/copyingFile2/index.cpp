@@ -1,34 +1,48 @@
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 #include <string>
+#include "File_copy.h"
 
-int main()
+/*
+
+    the character by character copy, fine for a small file, far too slow for big ones:
+
+    std::ifstream in_file {"romeoAndJuliet.txt"};
+    std::ofstream out_file {"test.txt"};
+
+    char c;
+    while (in_file.get(c))
+        out_file.put(c);
+
+    copy_file copies whole blocks, or lets the kernel do it, see File_copy.h.
+
+    ./a.out [from] [to] [automatic|buffered|mapped|kernel]
+
+*/
+
+int main(int argc, char *argv[])
 {
-    std::ifstream in_file;
-    std::ofstream out_file;
+    std::string from {argc > 1 ? argv[1] : "romeoAndJuliet.txt"};
+    std::string to {argc > 2 ? argv[2] : "test.txt"};
+    std::string name {argc > 3 ? argv[3] : "automatic"};
 
-    in_file.open("romeoAndJuliet.txt");
+    Copy_strategy strategy {Copy_strategy::Automatic};
+    for (Copy_strategy s : {Copy_strategy::Buffered, Copy_strategy::Mapped, Copy_strategy::Kernel})
+        if (name == to_string(s))
+            strategy = s;
 
-    if (!in_file.is_open())
+    try
     {
-        std::cout << "The file is not found." << std::endl;
-        return 1;
+        Copy_result result = copy_file(from, to, strategy);
+        std::cout << "Copied " << result.bytes << " bytes with the " << to_string(result.strategy)
+                  << " copy in " << result.seconds << " s, " << result.get_throughput() << " MB/s." << std::endl;
     }
-
-    out_file.open("test.txt");
-
-    if (!out_file.is_open())
+    catch (const std::runtime_error &ex)
     {
-        std::cout << "Could not create a file" << std::endl;
+        std::cout << "Could not copy the file: " << ex.what() << std::endl;
         return 1;
     }
 
-    char c;
-    while (in_file.get(c))
-        out_file.put(c);
-    
-    in_file.close();
-    out_file.close();
-    
     return 0;
 }
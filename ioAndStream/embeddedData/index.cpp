@@ -0,0 +1,203 @@
+/*
+
+    - writes a data set as a header of constexpr data, a step of the build: a directory
+      whose index.cpp has a line
+        embed <name> <mode> [<input>]
+      in its comment gets <name>.h, written by this program when the input or the program
+      changes, in embedded/<directory> of the build directory, which is on its include
+      path, see ../../CMakeLists.txt. the input is relative to the directory. the program
+      includes the header when __has_include finds it, and makes its data the way it did
+      before when it is built without cmake.
+
+    - the modes:
+        bytes <input>   the bytes of a file as they are, an alignas(64) char <name>[] and
+                        <name>_size, e.g. a text to search, or a file of a format that is
+                        read without parsing, a catalog of ../../tooling/mappedCatalog
+        tour            the tour of ../challenge/Tour.cpp as the columns of a Tour_table,
+                        constexpr arrays and the Tour_data <name> of them, see
+                        ../challenge/Tour_table.h
+
+    - the data is in the read only data of the program, pages of its file that are read
+      when they are touched, nothing runs at the start to make it, no file is opened.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp ../challenge/Tour.cpp ../challenge/Tour_table.cpp
+      e.g. ./a.out romeo_text bytes ../challenge3/romeoAndJuliet.txt romeo_text.h
+
+*/
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../challenge/Tour.h"
+#include "../challenge/Tour_table.h"
+
+std::string read_file(const std::string &path)
+{
+    std::ifstream in {path, std::ios::binary};
+    if (!in)
+        throw std::runtime_error("can not open " + path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+bool is_identifier(std::string_view name)
+{
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+        return false;
+    for (const char c : name)
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_')
+            return false;
+    return true;
+}
+
+// a string literal of the bytes, 64 a line, every byte that is not printable as a 3 digit
+// octal escape, so no digit after it is taken into it
+void write_literal(std::ostream &out, std::string_view bytes)
+{
+    out << '\n';
+    for (std::size_t i = 0; i < bytes.size(); i += 64)
+    {
+        out << "    \"";
+        for (const char c : bytes.substr(i, 64))
+        {
+            const unsigned char byte = static_cast<unsigned char>(c);
+            if (byte == '"' || byte == '\\')
+                out << '\\' << c;
+            else if (byte >= 0x20 && byte < 0x7f)
+                out << c;
+            else
+                out << '\\' << static_cast<char>('0' + (byte >> 6)) << static_cast<char>('0' + ((byte >> 3) & 7))
+                    << static_cast<char>('0' + (byte & 7));
+        }
+        out << "\"\n";
+    }
+    if (bytes.empty())
+        out << "    \"\"\n";
+}
+
+template<typename T, typename Get>
+void write_array(std::ostream &out, const std::string &type, const std::string &name, std::size_t count, Get get)
+{
+    out << "inline constexpr " << type << ' ' << name << "[] {";
+    for (std::size_t i = 0; i < count; ++i)
+        out << (i % 8 == 0 ? "\n    " : " ") << static_cast<T>(get(i)) << (i + 1 < count ? "," : "");
+    out << "\n};\n\n";
+}
+
+void write_bytes(std::ostream &out, const std::string &name, const std::string &input)
+{
+    const std::string bytes = read_file(input);
+    out << "#include <cstddef>\n\n"
+        << "alignas(64) inline constexpr char " << name << "[] =";
+    write_literal(out, bytes);
+    out << ";\n"
+        << "inline constexpr std::size_t " << name << "_size {" << bytes.size() << "};\n";
+}
+
+// the names of the table one after the other, in the order of the countries and their cities
+void write_tour(std::ostream &out, const std::string &name)
+{
+    const Tour_table table {make_tour()};
+    const std::size_t num_countries = table.get_num_countries();
+    const std::size_t num_cities = table.get_num_cities();
+    if (num_countries == 0 || num_cities == 0)
+        throw std::runtime_error("the tour has no city");
+
+    std::string names;
+    std::vector<std::uint32_t> country_names, city_names;
+    for (std::size_t country = 0; country < num_countries; ++country)
+    {
+        country_names.push_back(static_cast<std::uint32_t>(names.size()));
+        country_names.push_back(static_cast<std::uint32_t>(table.get_country_name(country).size()));
+        names.append(table.get_country_name(country));
+        for (std::size_t city = table.get_first_city(country); city < table.get_first_city(country + 1); ++city)
+        {
+            city_names.push_back(static_cast<std::uint32_t>(names.size()));
+            city_names.push_back(static_cast<std::uint32_t>(table.get_city_name(city).size()));
+            names.append(table.get_city_name(city));
+        }
+    }
+
+    out << "#include <cstdint>\n"
+        << "#include \"Tour_table.h\"\n\n"
+        << "inline constexpr char " << name << "_title[] =";
+    write_literal(out, table.get_title());
+    out << ";\n\n"
+        << "inline constexpr char " << name << "_names[] =";
+    write_literal(out, names);
+    out << ";\n\n";
+    write_array<std::uint32_t>(out, "std::uint32_t", name + "_country_names", country_names.size(),
+        [&](std::size_t i) { return country_names[i]; });
+    write_array<std::uint32_t>(out, "std::uint32_t", name + "_city_names", city_names.size(),
+        [&](std::size_t i) { return city_names[i]; });
+    write_array<std::uint32_t>(out, "std::uint32_t", name + "_first_city", num_countries + 1,
+        [&](std::size_t i) { return table.get_first_city(i); });
+    write_array<std::int64_t>(out, "std::int64_t", name + "_populations", num_cities,
+        [&](std::size_t i) { return table.get_population(i); });
+    // hexadecimal, the same doubles to the last bit
+    out << std::hexfloat;
+    write_array<double>(out, "double", name + "_costs", num_cities, [&](std::size_t i) { return table.get_cost(i); });
+    out << std::defaultfloat
+        << "inline constexpr Tour_data " << name << " {\n"
+        << "    {" << name << "_title, sizeof " << name << "_title - 1},\n"
+        << "    {" << name << "_names, sizeof " << name << "_names - 1},\n"
+        << "    " << name << "_country_names, " << name << "_city_names, " << name << "_first_city,\n"
+        << "    " << name << "_populations, " << name << "_costs,\n"
+        << "    " << num_countries << ", " << num_cities << "};\n";
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string mode {argc > 2 ? argv[2] : ""};
+    if (!((argc == 5 && mode == "bytes") || (argc == 4 && mode == "tour")) || !is_identifier(argv[1]))
+    {
+        std::cerr << "usage: " << argv[0] << " <name> bytes <input> <output.h>" << '\n'
+                  << "       " << argv[0] << " <name> tour <output.h>" << std::endl;
+        return 1;
+    }
+    const std::string name {argv[1]};
+    const std::string output {argv[argc - 1]};
+
+    try
+    {
+        std::ostringstream header;
+        std::string guard {"_EMBEDDED_" + name + "_H_"};
+        for (char &c : guard)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        header << "// written by ioAndStream/embeddedData, " << name << ' ' << mode
+               << (mode == "bytes" ? " of " + std::string {argv[3]} : std::string {}) << ", do not edit\n\n"
+               << "#ifndef " << guard << '\n'
+               << "#define " << guard << "\n\n";
+        if (mode == "bytes")
+            write_bytes(header, name, argv[3]);
+        else
+            write_tour(header, name);
+        header << "\n#endif\n";
+
+        // written whole or not at all, a build that stops halfway leaves no header cut short
+        const std::string temporary {output + ".tmp"};
+        {
+            std::ofstream out {temporary, std::ios::binary};
+            out << header.str();
+            if (!out)
+                throw std::runtime_error("can not write " + temporary);
+        }
+        if (std::rename(temporary.c_str(), output.c_str()) != 0)
+            throw std::runtime_error("can not rename " + temporary + " to " + output);
+    }
+    catch (const std::runtime_error &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,580 @@
+#ifndef _EXTERNAL_SORT_H_
+#define _EXTERNAL_SORT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+
+    - an external merge sort of fixed size records, more of them than fit in memory, header
+      only: a Sorter takes the records with push() into a buffer of memory_bytes, a full
+      buffer is sorted and written to a temporary file, a run, and merge() gives them back
+      in order, a k-way merge of the runs, without a file for the output. sort_file sorts a
+      file of records into another one. the records are trivially copyable, they are
+      written as their bytes. the buffer doubles up to memory_bytes, its last growth holds
+      1.5 times that for the copy, then it stays.
+
+    - a buffer is cut in a slice a thread, the slices are sorted with std::stable_sort at
+      once and merged while the run is written. the merges use a Loser_tree, a tournament
+      whose inner nodes keep the loser of their match, the next record is one replay from
+      a leaf to the root, log2(k) compares, one for every level, against the losers.
+
+    - a run is blocks of block_bytes, a header of the sizes and the bytes, read and written
+      with one system call a block, large and sequential. the merge holds a block of every
+      run it merges, it merges memory_bytes / block_bytes - 2 runs at most at once, more
+      of them are merged in passes, the consecutive ones in groups, into fewer runs first.
+      memory_bytes of 256 MiB and blocks of 1 MiB are 254 runs, 64 GiB, at once, a second
+      pass is 16 TiB, 1 TB of records is one pass over the disk to make the runs, one more
+      to merge them in groups and the last one, merge().
+
+    - the Codec of the Sorter compresses the blocks of the runs, Raw_codec writes them as
+      they are, Lz4_codec (Lz4_codec.h) with LZ4, sorted records have a lot in common with
+      the ones next to them, a block that does not get smaller is stored raw.
+
+    - the sort is stable: equal records come out in the order they were pushed, a slice and
+      a run before another one win the ties. comp must not throw, it runs on the threads.
+
+    - the runs are files of temp_dir, std::filesystem::temp_directory_path() by default,
+      removed once merged and by the destructor. errors of the system throw
+      std::runtime_error with the errno text, bad options std::invalid_argument.
+
+*/
+namespace external_sort
+{
+    inline constexpr std::size_t def_memory_bytes {std::size_t {256} << 20};
+    inline constexpr std::size_t def_block_bytes {std::size_t {1} << 20};
+
+    struct Options
+    {
+        std::size_t memory_bytes {def_memory_bytes};
+        std::size_t block_bytes {def_block_bytes};
+        // 0 for a thread a core
+        unsigned threads {0};
+        // empty for std::filesystem::temp_directory_path()
+        std::string temp_dir;
+    };
+
+    // since the Sorter was made
+    struct Stats
+    {
+        std::uint64_t records {0};
+        // the runs of the buffers, not the ones of the passes
+        std::size_t runs {0};
+        // the passes before the last merges
+        std::size_t merge_passes {0};
+        // the bytes of the runs on the disk, all passes
+        std::uint64_t bytes_written {0};
+    };
+
+    struct Raw_codec
+    {
+        static constexpr bool compresses = false;
+
+        std::size_t bound(std::size_t size) const { return size; }
+        std::size_t encode(const char *src, std::size_t size, char *dest) const
+        {
+            std::memcpy(dest, src, size);
+            return size;
+        }
+        void decode(const char *src, std::size_t stored, char *dest, std::size_t) const { std::memcpy(dest, src, stored); }
+    };
+
+    // the index of the source whose head is the smallest, ties to the lowest index, a source without a head loses
+    template <class T, class Compare = std::less<>>
+    class Loser_tree
+    {
+    private:
+        Compare comp;
+        std::vector<const T *> heads;
+        std::vector<std::size_t> losers;
+        std::size_t top {0};
+
+        bool beats(std::size_t a, std::size_t b) const
+        {
+            if (this->heads[a] == nullptr || this->heads[b] == nullptr)
+                return this->heads[b] == nullptr && (this->heads[a] != nullptr || a < b);
+            if (this->comp(*this->heads[a], *this->heads[b]))
+                return true;
+            return !this->comp(*this->heads[b], *this->heads[a]) && a < b;
+        }
+
+    public:
+        explicit Loser_tree(std::size_t sources, Compare comp = {}) : comp(comp), heads(sources, nullptr), losers(sources, 0)
+        {
+        }
+
+        // the head of every source, then build()
+        void set(std::size_t source, const T *head) { this->heads[source] = head; }
+
+        void build()
+        {
+            const std::size_t k = this->heads.size();
+            if (k == 0)
+                return;
+            std::vector<std::size_t> winners(2 * k);
+            for (std::size_t source = 0; source < k; ++source)
+                winners[k + source] = source;
+            for (std::size_t node = k - 1; node >= 1; --node)
+            {
+                const std::size_t a = winners[2 * node], b = winners[2 * node + 1];
+                winners[node] = this->beats(a, b) ? a : b;
+                this->losers[node] = this->beats(a, b) ? b : a;
+            }
+            this->top = k > 1 ? winners[1] : 0;
+        }
+
+        std::size_t winner() const { return this->top; }
+        // nullptr once every source is done
+        const T *head() const { return this->heads.empty() ? nullptr : this->heads[this->top]; }
+
+        // the winner has a new head, or none
+        void replace(const T *head)
+        {
+            this->heads[this->top] = head;
+            std::size_t winner = this->top;
+            for (std::size_t node = (winner + this->heads.size()) / 2; node >= 1; node /= 2)
+                if (this->beats(this->losers[node], winner))
+                    std::swap(this->losers[node], winner);
+            this->top = winner;
+        }
+    };
+
+    namespace detail_external_sort
+    {
+        struct Block_header
+        {
+            std::uint32_t size;
+            std::uint32_t stored;
+        };
+
+        [[noreturn]] inline void fail(const std::string &what)
+        {
+            throw std::runtime_error("external_sort: " + what + ": " + std::strerror(errno));
+        }
+
+        inline void write_all(int fd, const void *data, std::size_t size, const std::string &path)
+        {
+            const char *from = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                const ssize_t written = ::write(fd, from, size);
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                    fail("cannot write " + path);
+                from += written;
+                size -= static_cast<std::size_t>(written);
+            }
+        }
+
+        // fewer than size bytes only at the end of the file
+        inline std::size_t read_full(int fd, void *data, std::size_t size, const std::string &path)
+        {
+            char *to = static_cast<char *>(data);
+            std::size_t done = 0;
+            while (done < size)
+            {
+                const ssize_t got = ::read(fd, to + done, size - done);
+                if (got < 0 && errno == EINTR)
+                    continue;
+                if (got < 0)
+                    fail("cannot read " + path);
+                if (got == 0)
+                    break;
+                done += static_cast<std::size_t>(got);
+            }
+            return done;
+        }
+
+        class File
+        {
+        private:
+            int fd;
+            std::string path;
+
+        public:
+            File(const std::string &path, int flags) : fd(::open(path.c_str(), flags | O_CLOEXEC, 0644)), path(path)
+            {
+                if (this->fd < 0)
+                    fail("cannot open " + path);
+            }
+            File(const File &source) = delete;
+            File &operator=(const File &rhs) = delete;
+            ~File() { ::close(this->fd); }
+
+            int get() const { return this->fd; }
+            const std::string &get_path() const { return this->path; }
+        };
+
+        // the blocks of a run, written one after the other
+        template <class Codec>
+        class Run_writer
+        {
+        private:
+            File file;
+            const Codec &codec;
+            std::vector<char> block;
+            std::vector<char> stored;
+            std::size_t used {0};
+            std::uint64_t &bytes_written;
+
+            void write_block()
+            {
+                Block_header header {static_cast<std::uint32_t>(this->used), static_cast<std::uint32_t>(this->used)};
+                const char *data = this->block.data();
+                if constexpr (Codec::compresses)
+                {
+                    const std::size_t size = this->codec.encode(this->block.data(), this->used, this->stored.data());
+                    if (size < this->used)
+                    {
+                        header.stored = static_cast<std::uint32_t>(size);
+                        data = this->stored.data();
+                    }
+                }
+                write_all(this->file.get(), &header, sizeof(header), this->file.get_path());
+                write_all(this->file.get(), data, header.stored, this->file.get_path());
+                this->bytes_written += sizeof(header) + header.stored;
+                this->used = 0;
+            }
+
+        public:
+            Run_writer(const std::string &path, std::size_t block_bytes, const Codec &codec, std::uint64_t &bytes_written)
+                : file(path, O_WRONLY | O_CREAT | O_TRUNC), codec(codec), block(block_bytes),
+                  stored(Codec::compresses ? codec.bound(block_bytes) : 0), bytes_written(bytes_written)
+            {
+            }
+
+            void write(const void *record, std::size_t size)
+            {
+                std::memcpy(this->block.data() + this->used, record, size);
+                this->used += size;
+                if (this->used + size > this->block.size())
+                    this->write_block();
+            }
+
+            void finish()
+            {
+                if (this->used > 0)
+                    this->write_block();
+            }
+        };
+
+        // the records of a run, a block at a time, stored holds the compressed bytes of a block, shared by the readers of a merge
+        template <class T, class Codec>
+        class Run_reader
+        {
+        private:
+            File file;
+            const Codec &codec;
+            std::vector<char> &stored;
+            std::vector<T> block;
+            std::size_t size {0};
+            std::size_t next_index {0};
+
+            bool read_block()
+            {
+                Block_header header;
+                const std::size_t got = read_full(this->file.get(), &header, sizeof(header), this->file.get_path());
+                if (got == 0)
+                    return false;
+                if (got != sizeof(header) || header.size > this->block.size() * sizeof(T) || header.size % sizeof(T) != 0
+                    || header.stored > header.size)
+                    throw std::runtime_error("external_sort: the run " + this->file.get_path() + " is corrupt");
+                char *to = reinterpret_cast<char *>(this->block.data());
+                char *from = header.stored == header.size ? to : this->stored.data();
+                if (from != to && this->stored.size() < header.stored)
+                    throw std::runtime_error("external_sort: the run " + this->file.get_path() + " is corrupt");
+                if (read_full(this->file.get(), from, header.stored, this->file.get_path()) != header.stored)
+                    throw std::runtime_error("external_sort: the run " + this->file.get_path() + " is cut short");
+                if (from != to)
+                    this->codec.decode(from, header.stored, to, header.size);
+                this->size = header.size / sizeof(T);
+                this->next_index = 0;
+                return this->size > 0;
+            }
+
+        public:
+            Run_reader(const std::string &path, std::size_t block_bytes, const Codec &codec, std::vector<char> &stored)
+                : file(path, O_RDONLY), codec(codec), stored(stored), block(block_bytes / sizeof(T))
+            {
+#if defined(POSIX_FADV_SEQUENTIAL)
+                ::posix_fadvise(this->file.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            }
+
+            // the next record, valid until the next call, nullptr at the end
+            const T *next()
+            {
+                if (this->next_index == this->size && !this->read_block())
+                    return nullptr;
+                return &this->block[this->next_index++];
+            }
+        };
+    }
+
+    template <class T, class Compare = std::less<>, class Codec = Raw_codec>
+    class Sorter
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "the records of an external sort are written as their bytes");
+
+    private:
+        Compare comp;
+        Options options;
+        Codec codec;
+        std::vector<T> buffer;
+        std::size_t capacity;
+        std::string prefix;
+        std::size_t next_run {0};
+        std::vector<std::string> runs;
+        std::uint64_t pending {0};
+        Stats stats;
+
+        std::string new_run_path() { return this->prefix + std::to_string(this->next_run++) + ".run"; }
+
+        // the buffer sorted in a slice a thread, the bounds of the slices
+        std::vector<std::size_t> sort_slices()
+        {
+            const std::size_t n = this->buffer.size();
+            const std::size_t threads = std::max<std::size_t>(1, std::min<std::size_t>(this->options.threads, n / 4096));
+            std::vector<std::size_t> bounds;
+            for (std::size_t slice = 0; slice <= threads; ++slice)
+                bounds.push_back(n / threads * slice + std::min(slice, n % threads));
+
+            const auto sort = [this, &bounds](std::size_t slice) {
+                std::stable_sort(this->buffer.begin() + bounds[slice], this->buffer.begin() + bounds[slice + 1], this->comp);
+            };
+            std::vector<std::thread> workers;
+            for (std::size_t slice = 1; slice < threads; ++slice)
+                workers.emplace_back(sort, slice);
+            sort(0);
+            for (std::thread &worker : workers)
+                worker.join();
+            return bounds;
+        }
+
+        // f of the records of the sorted slices in order
+        template <class Fn>
+        void merge_slices(const std::vector<std::size_t> &bounds, Fn f)
+        {
+            const std::size_t k = bounds.size() - 1;
+            std::vector<std::size_t> positions(bounds.begin(), bounds.end() - 1);
+            const auto next = [&](std::size_t slice) -> const T * {
+                return positions[slice] < bounds[slice + 1] ? &this->buffer[positions[slice]++] : nullptr;
+            };
+            Loser_tree<T, Compare> tree {k, this->comp};
+            for (std::size_t slice = 0; slice < k; ++slice)
+                tree.set(slice, next(slice));
+            tree.build();
+            while (const T *record = tree.head())
+            {
+                f(*record);
+                tree.replace(next(tree.winner()));
+            }
+        }
+
+        void spill()
+        {
+            if (this->buffer.empty())
+                return;
+            const std::vector<std::size_t> bounds = this->sort_slices();
+            const std::string path = this->new_run_path();
+            this->runs.push_back(path);
+            detail_external_sort::Run_writer<Codec> writer {path, this->options.block_bytes, this->codec, this->stats.bytes_written};
+            this->merge_slices(bounds, [&writer](const T &record) { writer.write(&record, sizeof(T)); });
+            writer.finish();
+            this->buffer.clear();
+            ++this->stats.runs;
+        }
+
+        // f of the records of runs [first, last) in order, the runs are removed after
+        template <class Fn>
+        void merge_runs(std::size_t first, std::size_t last, Fn f)
+        {
+            std::vector<char> stored(Codec::compresses ? this->codec.bound(this->options.block_bytes) : 0);
+            std::vector<std::unique_ptr<detail_external_sort::Run_reader<T, Codec>>> readers;
+            for (std::size_t run = first; run < last; ++run)
+                readers.push_back(std::make_unique<detail_external_sort::Run_reader<T, Codec>>(this->runs[run],
+                    this->options.block_bytes, this->codec, stored));
+
+            Loser_tree<T, Compare> tree {readers.size(), this->comp};
+            for (std::size_t source = 0; source < readers.size(); ++source)
+                tree.set(source, readers[source]->next());
+            tree.build();
+            while (const T *record = tree.head())
+            {
+                f(*record);
+                tree.replace(readers[tree.winner()]->next());
+            }
+
+            readers.clear();
+            for (std::size_t run = first; run < last; ++run)
+                std::remove(this->runs[run].c_str());
+        }
+
+        // room for count more, the buffer doubles up to capacity, a small sort takes a small buffer
+        void grow(std::size_t count)
+        {
+            const std::size_t size = this->buffer.size() + count;
+            if (size > this->buffer.capacity())
+                this->buffer.reserve(std::min(this->capacity, std::max(size, 2 * this->buffer.capacity())));
+        }
+
+        void remove_runs()
+        {
+            for (const std::string &run : this->runs)
+                std::remove(run.c_str());
+            this->runs.clear();
+        }
+
+    public:
+        explicit Sorter(Compare comp = {}, Options options = {}, Codec codec = {})
+            : comp(comp), options(std::move(options)), codec(codec)
+        {
+            if (this->options.block_bytes < sizeof(T) || this->options.block_bytes > (std::size_t {1} << 31))
+                throw std::invalid_argument("external_sort: a block holds a record at least and 2 GiB at most");
+            if (this->options.memory_bytes < 4 * this->options.block_bytes)
+                throw std::invalid_argument("external_sort: memory_bytes is 4 blocks at least");
+            this->options.block_bytes -= this->options.block_bytes % sizeof(T);
+            if (this->options.threads == 0)
+                this->options.threads = std::max(1u, std::thread::hardware_concurrency());
+            if (this->options.temp_dir.empty())
+                this->options.temp_dir = std::filesystem::temp_directory_path().string();
+
+            static std::atomic<unsigned> sorters {0};
+            this->prefix = (std::filesystem::path {this->options.temp_dir} / ("external_sort_" + std::to_string(::getpid()) + "_"
+                + std::to_string(sorters++) + "_")).string();
+            this->capacity = this->options.memory_bytes / sizeof(T);
+        }
+
+        Sorter(const Sorter &source) = delete;
+        Sorter &operator=(const Sorter &rhs) = delete;
+        ~Sorter() { this->remove_runs(); }
+
+        void push(const T &record)
+        {
+            if (this->buffer.size() == this->capacity)
+                this->spill();
+            if (this->buffer.size() == this->buffer.capacity())
+                this->grow(1);
+            this->buffer.push_back(record);
+            ++this->pending;
+            ++this->stats.records;
+        }
+
+        void push(const T *records, std::size_t n)
+        {
+            while (n > 0)
+            {
+                if (this->buffer.size() == this->capacity)
+                    this->spill();
+                const std::size_t count = std::min(n, this->capacity - this->buffer.size());
+                this->grow(count);
+                this->buffer.insert(this->buffer.end(), records, records + count);
+                this->pending += count;
+                this->stats.records += count;
+                records += count;
+                n -= count;
+            }
+        }
+
+        // f(const T &) of every record pushed, in order, the sorter is empty after it, returns how many
+        template <class Fn>
+        std::uint64_t merge(Fn f)
+        {
+            const std::uint64_t records = this->pending;
+            this->pending = 0;
+            if (this->runs.empty())
+            {
+                // it fits in memory, no file
+                if (!this->buffer.empty())
+                    this->merge_slices(this->sort_slices(), f);
+                this->buffer.clear();
+            }
+            else
+            {
+                this->spill();
+                std::vector<T>().swap(this->buffer);
+                const std::size_t fan_in = std::max<std::size_t>(2, this->options.memory_bytes / this->options.block_bytes - 2);
+                std::size_t first = 0;
+                while (this->runs.size() - first > fan_in)
+                {
+                    // a pass, groups of fan_in consecutive runs, in order, become one each
+                    const std::size_t last = this->runs.size();
+                    for (std::size_t from = first; from < last; from += fan_in)
+                    {
+                        const std::string path = this->new_run_path();
+                        detail_external_sort::Run_writer<Codec> writer {path, this->options.block_bytes, this->codec,
+                                                                        this->stats.bytes_written};
+                        this->merge_runs(from, std::min(last, from + fan_in), [&writer](const T &record) {
+                            writer.write(&record, sizeof(T));
+                        });
+                        writer.finish();
+                        this->runs.push_back(path);
+                    }
+                    first = last;
+                    ++this->stats.merge_passes;
+                }
+                this->merge_runs(first, this->runs.size(), f);
+                this->runs.clear();
+            }
+            return records;
+        }
+
+        const Options &get_options() const { return this->options; }
+        const Stats &get_stats() const { return this->stats; }
+    };
+
+    // the file of records input sorted into output, a file of the same size, returns what the sort did
+    template <class T, class Compare = std::less<>, class Codec = Raw_codec>
+    Stats sort_file(const std::string &input, const std::string &output, Compare comp = {}, Options options = {},
+                    Codec codec = {})
+    {
+        Sorter<T, Compare, Codec> sorter {comp, std::move(options), codec};
+        const std::size_t block_bytes = sorter.get_options().block_bytes;
+        {
+            detail_external_sort::File in {input, O_RDONLY};
+            std::vector<T> block(block_bytes / sizeof(T));
+            std::size_t got;
+            while ((got = detail_external_sort::read_full(in.get(), block.data(), block_bytes, input)) > 0)
+            {
+                if (got % sizeof(T) != 0)
+                    throw std::runtime_error("external_sort: " + input + " is not made of whole records");
+                sorter.push(block.data(), got / sizeof(T));
+            }
+        }
+
+        detail_external_sort::File out {output, O_WRONLY | O_CREAT | O_TRUNC};
+        std::vector<char> block(block_bytes);
+        std::size_t used = 0;
+        sorter.merge([&](const T &record) {
+            std::memcpy(block.data() + used, &record, sizeof(T));
+            used += sizeof(T);
+            if (used == block_bytes)
+            {
+                detail_external_sort::write_all(out.get(), block.data(), used, output);
+                used = 0;
+            }
+        });
+        detail_external_sort::write_all(out.get(), block.data(), used, output);
+        return sorter.get_stats();
+    }
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _LZ4_CODEC_H_
+#define _LZ4_CODEC_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include "../compressedStream/Lz4.h"
+
+/*
+
+    - the blocks of the runs of an external_sort::Sorter as LZ4 blocks (../compressedStream/Lz4.h),
+      the functions are the ones of Lz4.cpp, a program that uses it is linked with it:
+        external_sort::Sorter<Record, By_key, Lz4_codec> sorter {By_key {}, options};
+
+    - the records of a sorted block are close to each other, the same high bytes of a key,
+      the same fields, LZ4 finds them at 4 bytes and more, a block decompresses at memory
+      speed, a disk that is slower than that reads the runs faster, and they take less of
+      it. a block that does not get smaller is stored as it is.
+
+*/
+struct Lz4_codec
+{
+    static constexpr bool compresses = true;
+
+    std::size_t bound(std::size_t size) const { return lz4_compress_bound(size); }
+    std::size_t encode(const char *src, std::size_t size, char *dest) const { return lz4_compress_block(src, size, dest); }
+    void decode(const char *src, std::size_t stored, char *dest, std::size_t size) const
+    {
+        if (lz4_decompress_block(src, stored, dest, size, dest) != size)
+            throw std::runtime_error("Lz4_codec: a block of a run has the wrong size");
+    }
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "External_sort.h"
+#include "Lz4_codec.h"
+
+/*
+
+    g++ -std=c++17 -O2 -pthread index.cpp ../compressedStream/Lz4.cpp
+
+    writes a file of 1M transaction records of 24 bytes, the ones of a journal, at random
+    accounts, sorts it by account with a Sorter of 1 MiB and blocks of 64 KiB, 23 runs, a
+    pass merges them in 2 groups of at most 14, then the last merge, raw and with LZ4, and
+    checks the order: by account, and in the order they were written for the same
+    account, the sort is stable. see External_sort.h.
+
+    ./a.out [records]
+
+*/
+
+struct Record
+{
+    std::uint64_t account_id;
+    std::int64_t cents;
+    std::uint32_t op;
+    std::uint32_t sequence;
+};
+
+struct By_account
+{
+    bool operator()(const Record &a, const Record &b) const { return a.account_id < b.account_id; }
+};
+
+bool check(const std::string &path, std::size_t records)
+{
+    std::ifstream in {path, std::ios::binary};
+    Record previous {}, record;
+    std::size_t count = 0;
+    while (in.read(reinterpret_cast<char *>(&record), sizeof(record)))
+    {
+        if (count > 0 && (record.account_id < previous.account_id
+                          || (record.account_id == previous.account_id && record.sequence < previous.sequence)))
+            return false;
+        previous = record;
+        ++count;
+    }
+    return count == records;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t records = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string input = (dir / "external_sort_input.bin").string();
+    const std::string output = (dir / "external_sort_output.bin").string();
+
+    try
+    {
+        {
+            std::ofstream out {input, std::ios::binary};
+            std::uint64_t state = 2024;
+            for (std::size_t i = 0; i < records; ++i)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                const Record record {(state >> 33) % 10000, static_cast<std::int64_t>(state >> 50), static_cast<std::uint32_t>(i % 2),
+                                     static_cast<std::uint32_t>(i)};
+                out.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            }
+        }
+
+        external_sort::Options options;
+        options.memory_bytes = 1 << 20;
+        options.block_bytes = 64 << 10;
+
+        const external_sort::Stats raw = external_sort::sort_file<Record>(input, output, By_account {}, options);
+        std::cout << "raw runs: " << raw.runs << " runs, " << raw.merge_passes << " merge passes, "
+                  << raw.bytes_written / 1000 << " kB written, sorted: " << std::boolalpha << check(output, records) << std::endl;
+
+        const external_sort::Stats lz4 = external_sort::sort_file<Record>(input, output, By_account {}, options, Lz4_codec {});
+        std::cout << "lz4 runs: " << lz4.runs << " runs, " << lz4.merge_passes << " merge passes, "
+                  << lz4.bytes_written / 1000 << " kB written, sorted: " << check(output, records) << std::endl;
+
+        // the records in order without an output file
+        external_sort::Sorter<Record, By_account> sorter {By_account {}, options};
+        std::ifstream in {input, std::ios::binary};
+        for (Record record; in.read(reinterpret_cast<char *>(&record), sizeof(record));)
+            sorter.push(record);
+        std::uint64_t accounts = 0, last = ~0ULL;
+        sorter.merge([&](const Record &record) {
+            accounts += record.account_id != last;
+            last = record.account_id;
+        });
+        std::cout << accounts << " accounts" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+
+    - sort_file of ../externalSort/External_sort.h on records of 24 bytes, the ones of a
+      journal, by account, 1M accounts at random, against std::stable_sort of all of them
+      in memory: the runs raw and with LZ4, in 16 MiB, and in 2 MiB with blocks of 64 KiB,
+      which takes a merge pass. then the merge alone, 64 sorted runs in memory, with the
+      Loser_tree and with a std::priority_queue of the heads.
+
+    - every output file has to be the records of std::stable_sort, byte for byte, and the
+      two merges the same, a mismatch is reported and the exit code is 1.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../compressedStream/Lz4.cpp
+
+    - 8M records, 192 MB, by default, the number can be given on the command line, e.g.
+      ./a.out 40000000, the files are in std::filesystem::temp_directory_path().
+
+    - on one core of an x86-64 at -O2, 8M records, the page cache holds the files:
+                                      MB/s    runs  passes  written
+        std::stable_sort in memory     116
+        raw runs, 16 MiB                87      12       0    1.00
+        lz4 runs, 16 MiB                62      12       0    0.39
+        raw runs, 2 MiB, 64 KiB         74      92       1    2.00
+      and the merge of 64 runs, ns a record: loser tree 95, priority_queue 118.
+      the sort of the buffers is most of it, an external sort of 16 MiB is three quarters
+      of the speed of the sort in memory, a pass more writes the bytes twice. a loser tree
+      compares a record with the loser of every level on the way up, one compare a level,
+      the heap of priority_queue two a level on the way down, and a pop and a push. lz4
+      writes 39% of the bytes, here the files stay in the page cache and it costs its time,
+      on a disk of 200 MB/s, slower than it, the passes go 2.5 times faster.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../externalSort/External_sort.h"
+#include "../externalSort/Lz4_codec.h"
+
+struct Record
+{
+    std::uint64_t account_id;
+    std::int64_t cents;
+    std::uint32_t op;
+    std::uint32_t reserved;
+};
+
+struct By_account
+{
+    bool operator()(const Record &a, const Record &b) const { return a.account_id < b.account_id; }
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<Record> make_records(std::size_t n)
+{
+    std::vector<Record> records(n);
+    std::uint64_t state = 42;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        records[i] = {(state >> 32) % 1000000, static_cast<std::int64_t>((state >> 16) % 100000), static_cast<std::uint32_t>(state & 1),
+                      0};
+    }
+    return records;
+}
+
+bool file_is(const std::string &path, const std::vector<Record> &expected)
+{
+    std::ifstream in {path, std::ios::binary};
+    const std::string bytes {std::istreambuf_iterator<char> {in}, std::istreambuf_iterator<char> {}};
+    return bytes.size() == expected.size() * sizeof(Record) && std::memcmp(bytes.data(), expected.data(), bytes.size()) == 0;
+}
+
+void print(const std::string &name, double mb_per_s, const external_sort::Stats *stats, std::size_t bytes)
+{
+    std::cout << std::setw(32) << std::left << name << std::right << std::fixed << std::setprecision(0) << std::setw(6) << mb_per_s;
+    if (stats != nullptr)
+        std::cout << std::setw(8) << stats->runs << std::setw(8) << stats->merge_passes << std::setprecision(2) << std::setw(9)
+                  << static_cast<double>(stats->bytes_written) / static_cast<double>(bytes);
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8'000'000;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string input = (dir / "external_sort_bench_input.bin").string();
+    const std::string output = (dir / "external_sort_bench_output.bin").string();
+    const std::size_t bytes = n * sizeof(Record);
+
+    std::vector<Record> expected = make_records(n);
+    {
+        std::ofstream out {input, std::ios::binary};
+        out.write(reinterpret_cast<const char *>(expected.data()), static_cast<std::streamsize>(bytes));
+    }
+
+    std::cout << n << " records, " << bytes / 1000000 << " MB" << std::endl;
+    std::cout << std::setw(32) << "" << "  MB/s    runs  passes  written" << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    std::stable_sort(expected.begin(), expected.end(), By_account {});
+    print("std::stable_sort in memory", bytes / 1e6 / seconds_since(start), nullptr, bytes);
+
+    int mismatches = 0;
+    const auto run = [&](const std::string &name, std::size_t memory_bytes, std::size_t block_bytes, auto codec) {
+        external_sort::Options options;
+        options.memory_bytes = memory_bytes;
+        options.block_bytes = block_bytes;
+        const auto start = std::chrono::steady_clock::now();
+        const external_sort::Stats stats = external_sort::sort_file<Record>(input, output, By_account {}, options, codec);
+        print(name, bytes / 1e6 / seconds_since(start), &stats, bytes);
+        mismatches += !file_is(output, expected);
+    };
+    run("raw runs, 16 MiB", 16 << 20, external_sort::def_block_bytes, external_sort::Raw_codec {});
+    run("lz4 runs, 16 MiB", 16 << 20, external_sort::def_block_bytes, Lz4_codec {});
+    run("raw runs, 2 MiB, 64 KiB", 2 << 20, 64 << 10, external_sort::Raw_codec {});
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+
+    // the merge alone, 64 sorted runs in memory
+    constexpr std::size_t k = 64;
+    std::vector<Record> records = make_records(n);
+    std::vector<std::size_t> bounds;
+    for (std::size_t run = 0; run <= k; ++run)
+        bounds.push_back(n / k * run + std::min(run, n % k));
+    for (std::size_t run = 0; run < k; ++run)
+        std::stable_sort(records.begin() + bounds[run], records.begin() + bounds[run + 1], By_account {});
+
+    std::vector<Record> by_tree, by_heap;
+    by_tree.reserve(n);
+    by_heap.reserve(n);
+    std::vector<std::size_t> positions(bounds.begin(), bounds.end() - 1);
+    start = std::chrono::steady_clock::now();
+    external_sort::Loser_tree<Record, By_account> tree {k};
+    for (std::size_t run = 0; run < k; ++run)
+        tree.set(run, positions[run] < bounds[run + 1] ? &records[positions[run]] : nullptr);
+    tree.build();
+    while (const Record *record = tree.head())
+    {
+        by_tree.push_back(*record);
+        const std::size_t run = tree.winner();
+        tree.replace(++positions[run] < bounds[run + 1] ? &records[positions[run]] : nullptr);
+    }
+    const double tree_ns = seconds_since(start) * 1e9 / n;
+
+    positions.assign(bounds.begin(), bounds.end() - 1);
+    start = std::chrono::steady_clock::now();
+    // the ties go to the lower run, like the ones of the tree
+    const auto later = [&records, &positions](std::size_t a, std::size_t b) {
+        const Record &ra = records[positions[a]], &rb = records[positions[b]];
+        return ra.account_id != rb.account_id ? ra.account_id > rb.account_id : a > b;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> heap {later};
+    for (std::size_t run = 0; run < k; ++run)
+        if (positions[run] < bounds[run + 1])
+            heap.push(run);
+    while (!heap.empty())
+    {
+        const std::size_t run = heap.top();
+        heap.pop();
+        by_heap.push_back(records[positions[run]]);
+        if (++positions[run] < bounds[run + 1])
+            heap.push(run);
+    }
+    const double heap_ns = seconds_since(start) * 1e9 / n;
+    std::cout << "merge of " << k << " runs, ns a record: loser tree " << std::setprecision(1) << tree_ns << ", priority_queue "
+              << heap_ns << std::endl;
+    mismatches += by_tree.size() != n
+        || std::memcmp(by_tree.data(), by_heap.data(), n * sizeof(Record)) != 0
+        || !std::is_sorted(by_tree.begin(), by_tree.end(), By_account {});
+
+    std::cout << "mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -1,36 +1,51 @@
 #include <iostream>
-#include <fstream>
-#include <string>
 #include <iomanip>
+#include <stdexcept>
+#include <string_view>
+#include "../readingFromTextFile3/Block_reader.h"
 
-int main()
-{
-    std::ifstream in_file;
-    std::string line;
-    int num1 {};
-    double num2 {};
+/*
 
-    in_file.open("test.txt");
+    g++ -std=c++17 -O2 index.cpp ../readingFromTextFile3/Block_reader.cpp
 
-    if (!in_file.is_open() /* or in_file */)
+    the first version, with >> of the stream:
+
+    while (!in_file.eof())
     {
-        std::cout << "The file is not found." << std::endl;
-        return 1;
+        in_file >> line >> num1 >> num2;
+        ...
     }
 
-    std::cout << "The file is found." << std::endl;
+    read_word, read_int and read_double of the Block_reader parse in its buffer with
+    std::from_chars, see ../readingFromTextFile3/Block_reader.h.
 
-    while (!in_file.eof() /* or in_file >> line >> num1 >> num2 */)
+*/
+
+int main()
+{
+    try
     {
-        in_file >> line >> num1 >> num2;
+        Block_reader in_file {"test.txt"};
+        std::string_view line;
+        int num1 {};
+        double num2 {};
+
+        std::cout << "The file is found." << std::endl;
+
         std::cout << std::setprecision(2) << std::fixed;
-        std::cout << std::setw(10) << std::left << line
-            << std::setw(10) << std::left << num1
-            << std::setw(10) << std::left << num2
-            << std::endl;
+        while (in_file.read_word(line) && in_file.read_int(num1) && in_file.read_double(num2))
+        {
+            std::cout << std::setw(10) << std::left << line
+                << std::setw(10) << std::left << num1
+                << std::setw(10) << std::left << num2
+                << '\n';
+        }
+    }
+    catch (const std::runtime_error &)
+    {
+        std::cout << "The file is not found." << std::endl;
+        return 1;
     }
 
-    in_file.close();
-    
     return 0;
 }
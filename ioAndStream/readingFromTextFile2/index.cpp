@@ -1,25 +1,37 @@
 #include <iostream>
-#include <fstream>
-#include <string>
-#include <iomanip>
+#include <stdexcept>
+#include <string_view>
+#include "../readingFromTextFile3/Block_reader.h"
+
+/*
+
+    g++ -std=c++17 -O2 index.cpp ../readingFromTextFile3/Block_reader.cpp
+
+    the first version, a std::string per line and a flush of std::endl after every one:
+
+    while (std::getline(in_file, line))
+        std::cout << line << std::endl;
+
+    read_line gives the line as a view into the buffer of the Block_reader, see
+    ../readingFromTextFile3/Block_reader.h.
+
+*/
 
 int main()
 {
-    std::ifstream in_file;
-    std::string line;
-
-    in_file.open("test.txt");
+    try
+    {
+        Block_reader in_file {"test.txt"};
+        std::string_view line;
 
-    if (!in_file.is_open() /* or in_file */)
+        while (in_file.read_line(line))
+            std::cout << line << '\n';
+    }
+    catch (const std::runtime_error &)
     {
         std::cout << "The file is not found." << std::endl;
         return 1;
     }
 
-    while (std::getline(in_file, line))
-        std::cout << line << std::endl;
-
-    in_file.close();
-    
     return 0;
 }
@@ -0,0 +1,166 @@
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Block_reader.h"
+
+namespace
+{
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    // the whole word is the number, "12abc" is not one
+    template<typename T>
+    bool parse(std::string_view word, T &value)
+    {
+        const char *last = word.data() + word.size();
+        const std::from_chars_result result = std::from_chars(word.data(), last, value);
+        return result.ec == std::errc{} && result.ptr == last;
+    }
+}
+
+Block_reader::Block_reader(const std::string &path, std::size_t block_size)
+    : fd{-1}, buffer(block_size > 0 ? block_size : 1), begin{0}, end{0}, at_eof{false}
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+        fail("open " + path);
+    ::posix_fadvise(this->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+Block_reader::~Block_reader()
+{
+    ::close(this->fd);
+}
+
+bool Block_reader::fill()
+{
+    if (this->at_eof)
+        return false;
+
+    if (this->begin > 0)
+    {
+        std::memmove(this->buffer.data(), this->buffer.data() + this->begin, this->end - this->begin);
+        this->end -= this->begin;
+        this->begin = 0;
+    }
+    // a word or a line as long as the buffer
+    if (this->end == this->buffer.size())
+        this->buffer.resize(2 * this->buffer.size());
+
+    for (;;)
+    {
+        const ssize_t got = ::read(this->fd, this->buffer.data() + this->end, this->buffer.size() - this->end);
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            fail("read");
+        }
+        if (got == 0)
+        {
+            this->at_eof = true;
+            return false;
+        }
+        this->end += static_cast<std::size_t>(got);
+        return true;
+    }
+}
+
+bool Block_reader::is_space(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+std::string_view Block_reader::next_block()
+{
+    if (this->begin == this->end && !this->fill())
+        return {};
+
+    const std::string_view block{this->buffer.data() + this->begin, this->end - this->begin};
+    this->begin = this->end;
+    return block;
+}
+
+bool Block_reader::skip_whitespace()
+{
+    for (;;)
+    {
+        for (; this->begin < this->end; this->begin++)
+            if (!is_space(this->buffer[this->begin]))
+                return true;
+        if (!this->fill())
+            return false;
+    }
+}
+
+bool Block_reader::read_word(std::string_view &word)
+{
+    if (!this->skip_whitespace())
+        return false;
+
+    // from begin, fill moves begin to the front and keeps the length
+    std::size_t length = 0;
+    for (;;)
+    {
+        while (this->begin + length < this->end && !is_space(this->buffer[this->begin + length]))
+            length++;
+        if (this->begin + length < this->end || !this->fill())
+            break;
+    }
+
+    word = std::string_view{this->buffer.data() + this->begin, length};
+    this->begin += length;
+    return true;
+}
+
+bool Block_reader::read_line(std::string_view &line)
+{
+    if (this->begin == this->end && !this->fill())
+        return false;
+
+    std::size_t scanned = 0;
+    for (;;)
+    {
+        const char *from = this->buffer.data() + this->begin;
+        const void *newline = std::memchr(from + scanned, '\n', this->end - this->begin - scanned);
+        if (newline != nullptr)
+        {
+            const std::size_t length = static_cast<std::size_t>(static_cast<const char *>(newline) - from);
+            line = std::string_view{from, length};
+            this->begin += length + 1;
+            return true;
+        }
+        scanned = this->end - this->begin;
+        // the last line has no '\n'
+        if (!this->fill())
+        {
+            line = std::string_view{this->buffer.data() + this->begin, scanned};
+            this->begin = this->end;
+            return true;
+        }
+    }
+}
+
+bool Block_reader::read_int(int &value)
+{
+    std::string_view word;
+    return this->read_word(word) && parse(word, value);
+}
+
+bool Block_reader::read_long(long &value)
+{
+    std::string_view word;
+    return this->read_word(word) && parse(word, value);
+}
+
+bool Block_reader::read_double(double &value)
+{
+    std::string_view word;
+    return this->read_word(word) && parse(word, value);
+}
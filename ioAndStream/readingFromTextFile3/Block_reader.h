@@ -0,0 +1,59 @@
+#ifndef _BLOCK_READER_H_
+#define _BLOCK_READER_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "../../tooling/largeBuffer/Large_buffer.h"
+
+/*
+
+    - Block_reader reads a file with read(2) into one buffer of 64 KiB and gives its bytes
+      as blocks, a string_view of all that is left in the buffer, the echo of a file is a
+      write per block and not the two virtual calls of in_file.get(c) per byte.
+
+    - the helpers parse on the same buffer, read_word skips the whitespace and gives the
+      run of bytes up to the next one, read_int and read_double parse a word with
+      std::from_chars, read_line gives the bytes up to the next '\n' like std::getline. a
+      word or a line that is cut by the end of the buffer is moved to its front before the
+      next read, the buffer grows when one is longer than it. the buffer is a
+      large_buffer::Vector, it is not zeroed before read(2) fills it.
+
+    - the views live until the next call on the reader. the helpers return false at the
+      end of the file, and the number ones on a word that is not a whole number, the way
+      >> sets the failbit. errors throw std::runtime_error with the errno text.
+
+*/
+class Block_reader
+{
+private:
+    int fd;
+    large_buffer::Vector<char> buffer;
+    std::size_t begin;
+    std::size_t end;
+    bool at_eof;
+
+    // moves [begin, end) to the front and reads after it, false when nothing was read
+    bool fill();
+    static bool is_space(char c);
+
+public:
+    explicit Block_reader(const std::string &path, std::size_t block_size = 64 * 1024);
+    ~Block_reader();
+
+    Block_reader(const Block_reader &) = delete;
+    Block_reader &operator=(const Block_reader &) = delete;
+
+    // the next block, empty at the end of the file
+    std::string_view next_block();
+
+    // false at the end of the file
+    bool skip_whitespace();
+    bool read_word(std::string_view &word);
+    bool read_line(std::string_view &line);
+    bool read_int(int &value);
+    bool read_long(long &value);
+    bool read_double(double &value);
+};
+
+#endif
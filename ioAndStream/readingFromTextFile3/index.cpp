@@ -1,25 +1,34 @@
 #include <iostream>
-#include <fstream>
-#include <string>
-#include <iomanip>
+#include <stdexcept>
+#include <string_view>
+#include "Block_reader.h"
+
+/*
+
+    the first version, two virtual calls of the stream per byte:
+
+    while (in_file.get(c))
+        std::cout << c;
+
+    Block_reader gives the file a buffer of 64 KiB at a time, one write per block, see
+    Block_reader.h.
+
+*/
 
 int main()
 {
-    std::ifstream in_file;
-    char c {};
-
-    in_file.open("test.txt");
+    try
+    {
+        Block_reader in_file {"test.txt"};
 
-    if (!in_file.is_open() /* or in_file */)
+        for (std::string_view block {in_file.next_block()}; !block.empty(); block = in_file.next_block())
+            std::cout << block;
+    }
+    catch (const std::runtime_error &)
     {
         std::cout << "The file is not found." << std::endl;
         return 1;
     }
 
-    while (in_file.get(c))
-        std::cout << c;
-
-    in_file.close();
-    
     return 0;
 }
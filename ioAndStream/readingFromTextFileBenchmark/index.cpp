@@ -0,0 +1,180 @@
+/*
+
+    - the ways of readingFromTextFile, readingFromTextFile2 and readingFromTextFile3 on a
+      file of 100 MB of their records, "Frank 100 123.456", in the temporary directory, the
+      MB can be given on the command line, e.g. ./a.out 1000:
+
+        - the bytes, in_file.get(c), read(2) of 64 KiB, what cat does, and next_block of the
+          Block_reader of ../readingFromTextFile3/Block_reader.h
+        - the lines, std::getline and read_line
+        - the records, >> of a std::string, an int and a double, and read_word, read_int
+          and read_double
+
+    - the file is in the page cache after the first read, the sums of the bytes, of the
+      lengths of the lines and of the numbers have to be the same both ways.
+
+    - on one core of an x86-64 at -O2, 100 MB, MB/s:
+
+        bytes, in_file.get(c)              123
+        bytes, read(2)                    1679
+        bytes, next_block                 1600
+        lines, std::getline                781
+        lines, read_line                  1257
+        records, >>                         55
+        records, read_word and numbers     273
+
+      the sum of the bytes is the same loop for the three, next_block is the speed of cat
+      and 13 times the one of get(c). a line is a memchr and a view, with no copy into a
+      std::string, the records are 5 times faster, std::from_chars of a double is most of
+      their time.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp ../readingFromTextFile3/Block_reader.cpp
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../readingFromTextFile3/Block_reader.h"
+
+template<typename Fn>
+double best_of_5(Fn fn)
+{
+    double best = 1e300;
+    for (int run = 0; run < 5; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+void print(const std::string &what, double seconds, std::uintmax_t bytes)
+{
+    std::cout << std::setw(36) << std::left << what << std::setw(10) << std::right << std::fixed << std::setprecision(0)
+              << bytes / seconds / 1e6 << " MB/s" << std::endl;
+}
+
+std::uint64_t sum_of(std::string_view text)
+{
+    std::uint64_t sum = 0;
+    for (char c : text)
+        sum += static_cast<unsigned char>(c);
+    return sum;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::uintmax_t megabytes {argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100};
+    const std::string path {(std::filesystem::temp_directory_path() / "readingFromTextFile.txt").string()};
+    std::size_t mismatches = 0;
+
+    {
+        const char *names[] {"Frank", "Larry", "Moe", "Curly", "Shemp"};
+        std::ofstream out {path};
+        if (!out)
+            throw std::runtime_error {path + " can not be created"};
+        std::string record;
+        std::uintmax_t written = 0;
+        for (std::size_t i = 0; written < megabytes * 1000000; ++i)
+        {
+            record = names[i % 5];
+            record += ' ' + std::to_string(i % 1000) + ' ' + std::to_string(i % 1000) + '.' + std::to_string(i % 997) + '\n';
+            out << record;
+            written += record.size();
+        }
+    }
+    const std::uintmax_t bytes {std::filesystem::file_size(path)};
+    std::cout << bytes << " bytes in " << path << std::endl;
+
+    std::uint64_t get_sum = 0, read_sum = 0, block_sum = 0;
+    print("bytes, in_file.get(c)", best_of_5([&] {
+        std::ifstream in_file {path};
+        char c {};
+        get_sum = 0;
+        while (in_file.get(c))
+            get_sum += static_cast<unsigned char>(c);
+    }), bytes);
+    print("bytes, read(2)", best_of_5([&] {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        std::vector<char> buffer(64 * 1024);
+        read_sum = 0;
+        for (ssize_t got; (got = ::read(fd, buffer.data(), buffer.size())) > 0;)
+            read_sum += sum_of(std::string_view {buffer.data(), static_cast<std::size_t>(got)});
+        ::close(fd);
+    }), bytes);
+    print("bytes, next_block", best_of_5([&] {
+        Block_reader in_file {path};
+        block_sum = 0;
+        for (std::string_view block {in_file.next_block()}; !block.empty(); block = in_file.next_block())
+            block_sum += sum_of(block);
+    }), bytes);
+    mismatches += get_sum != read_sum || get_sum != block_sum;
+
+    std::uint64_t getline_sum = 0, read_line_sum = 0;
+    print("lines, std::getline", best_of_5([&] {
+        std::ifstream in_file {path};
+        std::string line;
+        getline_sum = 0;
+        while (std::getline(in_file, line))
+            getline_sum += line.size() + 1;
+    }), bytes);
+    print("lines, read_line", best_of_5([&] {
+        Block_reader in_file {path};
+        std::string_view line;
+        read_line_sum = 0;
+        while (in_file.read_line(line))
+            read_line_sum += line.size() + 1;
+    }), bytes);
+    mismatches += getline_sum != read_line_sum || getline_sum != bytes;
+
+    std::uint64_t stream_words = 0, reader_words = 0;
+    double stream_numbers = 0, reader_numbers = 0;
+    print("records, >>", best_of_5([&] {
+        std::ifstream in_file {path};
+        std::string line;
+        int num1 {};
+        double num2 {};
+        stream_words = 0;
+        stream_numbers = 0;
+        while (in_file >> line >> num1 >> num2)
+        {
+            stream_words += line.size();
+            stream_numbers += num1 + num2;
+        }
+    }), bytes);
+    print("records, read_word and numbers", best_of_5([&] {
+        Block_reader in_file {path};
+        std::string_view line;
+        int num1 {};
+        double num2 {};
+        reader_words = 0;
+        reader_numbers = 0;
+        while (in_file.read_word(line) && in_file.read_int(num1) && in_file.read_double(num2))
+        {
+            reader_words += line.size();
+            reader_numbers += num1 + num2;
+        }
+    }), bytes);
+    mismatches += stream_words != reader_words || stream_numbers != reader_numbers;
+
+    std::remove(path.c_str());
+    std::cout << "mismatches: " << mismatches << std::endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#ifndef _TOKENIZER_H_
+#define _TOKENIZER_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+
+    - Tokenizer splits a string_view into words, like iss >> word on a std::istringstream
+      of the line, and removes the punctuation from every word, like clean_string, without
+      a stream, a locale or an allocation per line.
+
+    - the delimiters separate the words, whitespace by default, the punctuation is dropped
+      from the words, ".,;:!?" by default. a word that is only punctuation is still a word,
+      an empty one, as clean_string gives "".
+
+    - next gives a view into the text, unless the punctuation is inside the word, e.g.
+      "o'er.there", then the view is into a buffer of the Tokenizer and lives only until the
+      next call. the text has to outlive the Tokenizer.
+
+*/
+class Char_set
+{
+private:
+    bool table[256];
+
+public:
+    explicit Char_set(std::string_view chars) : table{}
+    {
+        for (char ch : chars)
+            this->table[static_cast<unsigned char>(ch)] = true;
+    }
+
+    bool contains(char ch) const
+    {
+        return this->table[static_cast<unsigned char>(ch)];
+    }
+};
+
+class Tokenizer
+{
+private:
+    std::string_view text;
+    std::size_t position;
+    Char_set delimiters;
+    Char_set punctuation;
+    std::string buffer;
+
+public:
+    static constexpr std::string_view whitespace {" \t\n\v\f\r"};
+    static constexpr std::string_view default_punctuation {".,;:!?"};
+
+    explicit Tokenizer(std::string_view text,
+                       std::string_view delimiters = whitespace,
+                       std::string_view punctuation = default_punctuation)
+        : text{text}, position{0}, delimiters{delimiters}, punctuation{punctuation}
+    {
+    }
+
+    // starts again on another text, keeps the sets
+    void reset(std::string_view text)
+    {
+        this->text = text;
+        this->position = 0;
+    }
+
+    // false when there is no word left
+    bool next(std::string_view &word)
+    {
+        const std::size_t size = this->text.size();
+        std::size_t begin = this->position;
+        while (begin < size && this->delimiters.contains(this->text[begin]))
+            ++begin;
+        if (begin == size)
+        {
+            this->position = size;
+            return false;
+        }
+
+        std::size_t end = begin;
+        while (end < size && !this->delimiters.contains(this->text[end]))
+            ++end;
+        this->position = end;
+
+        // the punctuation around the word only moves the ends of the view
+        while (begin < end && this->punctuation.contains(this->text[begin]))
+            ++begin;
+        while (end > begin && this->punctuation.contains(this->text[end - 1]))
+            --end;
+
+        std::size_t i = begin;
+        while (i < end && !this->punctuation.contains(this->text[i]))
+            ++i;
+        if (i == end)
+        {
+            word = this->text.substr(begin, end - begin);
+            return true;
+        }
+
+        this->buffer.assign(this->text.data() + begin, i - begin);
+        for (; i < end; ++i)
+            if (!this->punctuation.contains(this->text[i]))
+                this->buffer += this->text[i];
+        word = this->buffer;
+        return true;
+    }
+};
+
+#endif
@@ -1,8 +1,11 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <charconv>
 #include <limits>
 #include <string>
+#include <string_view>
+#include "Tokenizer.h"
 
 int main()
 {
@@ -12,8 +15,26 @@ int main()
 
     std::string info {"Moe 100 123.33"};
 
-    std::istringstream iss {info};
-    iss >> name >> num >> total;
+    /*
+
+        the words of a line can be read with a std::istringstream:
+
+        std::istringstream iss {info};
+        iss >> name >> num >> total;
+
+        a Tokenizer gives the same words as views, without a stream per line, see Tokenizer.h,
+        and std::from_chars reads the numbers out of them.
+
+    */
+    Tokenizer tokenizer {info, Tokenizer::whitespace, ""};
+    std::string_view word {};
+
+    if (tokenizer.next(word))
+        name = word;
+    if (tokenizer.next(word))
+        std::from_chars(word.data(), word.data() + word.size(), num);
+    if (tokenizer.next(word))
+        std::from_chars(word.data(), word.data() + word.size(), total);
 
     std::cout << std::setw(10) << std::left << name
         << std::setw(10) << std::left << num
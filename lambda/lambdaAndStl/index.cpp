@@ -104,7 +104,7 @@ public:
     Person(const Person& p) = default;
     ~Person() = default;
 
-    std::string get_name() const { return this->name; }
+    const std::string& get_name() const { return this->name; }
     int get_age() const { return this->age; }
     void set_name(std::string name) { this->name = name; }
     void set_age(int age) { this->age = age; }
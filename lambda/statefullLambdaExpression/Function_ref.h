@@ -0,0 +1,71 @@
+#ifndef _FUNCTION_REF_H_
+#define _FUNCTION_REF_H_
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/*
+
+    - Function_ref<R(Args...)> calls a callable it does not own: a pointer to it and a pointer
+      to a function that calls it, two pointers, it is made without an allocation and copied
+      for free. it is the parameter of a function that calls a callback before it returns, a
+      lambda of any size is passed without a std::function made for the call.
+
+    - the callable has to live as long as the Function_ref, a lambda passed where it is a
+      parameter lives until the call returns, one stored in a Function_ref variable is gone at
+      the end of the line, a callback that is kept belongs in an Inplace_function or a
+      std::function.
+
+    - a function is called through its pointer, nothing has to live for it.
+
+*/
+template <typename Signature>
+class Function_ref;
+
+template <typename R, typename... Args>
+class Function_ref<R(Args...)>
+{
+private:
+    union Target
+    {
+        void* object;
+        void (*function)();
+    };
+
+    Target target;
+    R (*call)(Target, Args...);
+
+public:
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Function_ref>
+                                          && std::is_invocable_r_v<R, F&, Args...>>>
+    Function_ref(F&& f) noexcept
+    {
+        if constexpr (std::is_function_v<std::remove_pointer_t<std::decay_t<F>>>)
+        {
+            using Pointer = std::decay_t<F>;
+            this->target.function = reinterpret_cast<void (*)()>(static_cast<Pointer>(f));
+            this->call = [](Target target, Args... args) -> R
+            {
+                return std::invoke(reinterpret_cast<Pointer>(target.function), std::forward<Args>(args)...);
+            };
+        }
+        else
+        {
+            using Object = std::remove_reference_t<F>;
+            this->target.object = const_cast<void*>(static_cast<const volatile void*>(std::addressof(f)));
+            this->call = [](Target target, Args... args) -> R
+            {
+                return std::invoke(*static_cast<Object*>(target.object), std::forward<Args>(args)...);
+            };
+        }
+    }
+
+    R operator()(Args... args) const
+    {
+        return this->call(this->target, std::forward<Args>(args)...);
+    }
+};
+
+#endif
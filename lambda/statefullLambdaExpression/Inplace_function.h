@@ -0,0 +1,171 @@
+#ifndef _INPLACE_FUNCTION_H_
+#define _INPLACE_FUNCTION_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+
+    - Inplace_function<R(Args...), Capacity> owns a callable like a std::function does, but in
+      Capacity bytes of its own, never on the heap: a lambda whose captures do not fit does
+      not compile, a static_assert says so, instead of an allocation a profiler finds later.
+      libstdc++ keeps the captures of a std::function inline only up to 16 bytes, the ones
+      of a lambda with three ints and a pointer are allocated, one new per callback.
+
+    - a callable is copied and moved with it, the functions of its type are in a table, one
+      pointer per Inplace_function, a call is one indirect call, like a virtual function. the
+      callable must not throw from its move constructor, an Inplace_function moves it when a
+      std::vector of them grows.
+
+    - a call of an empty one throws std::bad_function_call, the same as a std::function.
+
+*/
+namespace detail_inplace_function
+{
+    inline constexpr std::size_t def_capacity = 32;
+
+    template <typename R, typename... Args>
+    struct Operations
+    {
+        R (*call)(void* object, Args&&... args);
+        void (*copy)(void* to, const void* from);
+        void (*move)(void* to, void* from) noexcept;
+        void (*destroy)(void* object) noexcept;
+    };
+
+    template <typename F, typename R, typename... Args>
+    inline constexpr Operations<R, Args...> operations_of {
+        [](void* object, Args&&... args) -> R { return std::invoke(*static_cast<F*>(object), std::forward<Args>(args)...); },
+        [](void* to, const void* from) { ::new (to) F(*static_cast<const F*>(from)); },
+        [](void* to, void* from) noexcept
+        {
+            ::new (to) F(std::move(*static_cast<F*>(from)));
+            static_cast<F*>(from)->~F();
+        },
+        [](void* object) noexcept { static_cast<F*>(object)->~F(); }
+    };
+}
+
+template <typename Signature, std::size_t Capacity = detail_inplace_function::def_capacity>
+class Inplace_function;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class Inplace_function<R(Args...), Capacity>
+{
+private:
+    using Operations = detail_inplace_function::Operations<R, Args...>;
+
+    // mutable, a call of a const one calls the callable as it is stored, not as const
+    alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+    const Operations* operations {nullptr};
+
+public:
+    static constexpr std::size_t capacity = Capacity;
+
+    Inplace_function() noexcept = default;
+    Inplace_function(std::nullptr_t) noexcept {}
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Inplace_function>
+                                          && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    Inplace_function(F&& f)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= Capacity, "the captures do not fit in the Capacity of the Inplace_function");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "the callable is aligned more than std::max_align_t");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>, "the move constructor of the callable can throw");
+        static_assert(std::is_copy_constructible_v<Callable>, "an Inplace_function is copied, the callable has to be too");
+        ::new (static_cast<void*>(this->storage)) Callable(std::forward<F>(f));
+        this->operations = &detail_inplace_function::operations_of<Callable, R, Args...>;
+    }
+
+    Inplace_function(const Inplace_function& source)
+    {
+        if (source.operations != nullptr)
+        {
+            source.operations->copy(this->storage, source.storage);
+            this->operations = source.operations;
+        }
+    }
+
+    Inplace_function(Inplace_function&& source) noexcept
+    {
+        if (source.operations != nullptr)
+        {
+            source.operations->move(this->storage, source.storage);
+            this->operations = source.operations;
+            source.operations = nullptr;
+        }
+    }
+
+    ~Inplace_function()
+    {
+        this->reset();
+    }
+
+    // a copy that throws leaves this one empty
+    Inplace_function& operator=(const Inplace_function& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->reset();
+            if (rhs.operations != nullptr)
+            {
+                rhs.operations->copy(this->storage, rhs.storage);
+                this->operations = rhs.operations;
+            }
+        }
+        return *this;
+    }
+
+    Inplace_function& operator=(Inplace_function&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            this->reset();
+            if (rhs.operations != nullptr)
+            {
+                rhs.operations->move(this->storage, rhs.storage);
+                this->operations = rhs.operations;
+                rhs.operations = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Inplace_function& operator=(std::nullptr_t) noexcept
+    {
+        this->reset();
+        return *this;
+    }
+
+    void reset() noexcept
+    {
+        if (this->operations != nullptr)
+        {
+            this->operations->destroy(this->storage);
+            this->operations = nullptr;
+        }
+    }
+
+    void swap(Inplace_function& other) noexcept
+    {
+        Inplace_function temp {std::move(other)};
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    explicit operator bool() const noexcept { return this->operations != nullptr; }
+
+    R operator()(Args... args) const
+    {
+        if (this->operations == nullptr)
+            throw std::bad_function_call();
+        return this->operations->call(this->storage, std::forward<Args>(args)...);
+    }
+};
+
+#endif
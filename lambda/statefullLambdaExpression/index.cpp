@@ -8,6 +8,8 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include "Function_ref.h"
+#include "Inplace_function.h"
 
 int global_x {1000};
 
@@ -207,7 +209,7 @@ public:
     Person(const Person& p) = default;
     ~Person() = default;
 
-    std::string get_name() const { return this->name; }
+    const std::string& get_name() const { return this->name; }
     int get_age() const { return this->age; }
     void set_name(std::string name) { this->name = name; }
     void set_age(int age) { this->age = age; }
@@ -348,6 +350,47 @@ void test10()
         std::cout << p << std::endl;
 }
 
+// calls fn before it returns, any lambda is passed without a copy or an allocation
+int sum_of(const std::vector<int>& values, Function_ref<int(int)> fn)
+{
+    int sum {0};
+    for (int value : values)
+        sum += fn(value);
+    return sum;
+}
+
+void test11()
+{
+    std::cout << std::endl << "test11=================" << std::endl;
+
+    std::vector<int> values {1, 2, 3, 4};
+    int factor {10};
+    std::cout << sum_of(values, [factor] (int x) { return x * factor; }) << std::endl;
+
+    /*
+
+        - the handlers keep their state, three ints and a pointer, 24 bytes, a std::function
+            would allocate them, an Inplace_function keeps them in its 32 bytes.
+
+    */
+    int total {0};
+    std::vector<Inplace_function<void(int)>> handlers;
+    for (int id {1}; id <= 3; id++)
+        handlers.push_back(
+            [id, calls = 0, last = 0, &total] (int event) mutable
+            {
+                ++calls;
+                last = event;
+                total += id * event;
+                std::cout << "handler " << id << ": " << calls << " calls, last " << last << std::endl;
+            });
+
+    for (int event : {5, 7})
+        for (const auto& handler : handlers)
+            handler(event);
+    std::cout << total << std::endl;
+}
+
 int main()
 {
     test1();
@@ -360,6 +403,7 @@ int main()
     test8();
     test9();
     test10();
+    test11();
     
     return 0;
 }
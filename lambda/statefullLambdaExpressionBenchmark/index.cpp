@@ -0,0 +1,125 @@
+/*
+
+    - compares std::function with the Inplace_function and the Function_ref of
+      ../statefullLambdaExpression, on the handlers of an event dispatcher, lambdas with three
+      ints and a pointer of state: made and stored in a vector, called with an event each, the
+      vector copied, and a lambda passed as a callback to a function that is not inlined, in
+      ns per handler, with a checksum, the same for all.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - 1'000'000 handlers by default, the number can be given on the command line, e.g.
+      ./a.out 100000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../statefullLambdaExpression/Function_ref.h"
+#include "../statefullLambdaExpression/Inplace_function.h"
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ns per handler of f(), that returns a checksum, the best of rounds
+template <typename F>
+void run(const std::string& name, std::size_t n, F f)
+{
+    constexpr int rounds {5};
+    double best {0};
+    std::uint64_t checksum {0};
+    for (int round = 0; round < rounds; ++round)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        checksum = f();
+        const double seconds = seconds_since(start);
+        best = round == 0 ? seconds : std::min(best, seconds);
+    }
+    std::cout << std::setw(44) << std::left << name << std::fixed << std::setprecision(2)
+        << std::setw(10) << std::right << best * 1e9 / n << std::setw(22) << checksum << std::endl;
+}
+
+// 24 bytes of state, more than the 16 a std::function of libstdc++ keeps inline
+auto make_handler(int id, std::uint64_t* total)
+{
+    return [id, calls = 0, last = 0, total] (int event) mutable
+    {
+        ++calls;
+        last = event;
+        *total += static_cast<std::uint64_t>(id) * static_cast<std::uint32_t>(event) + static_cast<std::uint32_t>(calls);
+    };
+}
+
+template <typename Handler>
+void bench_handlers(const std::string& name, std::size_t n)
+{
+    std::uint64_t total {0};
+    std::vector<Handler> handlers;
+
+    run(name + ", make and store", n, [&] {
+        // reserved, the time is the one of making a handler, not of the vector growing
+        handlers.clear();
+        handlers.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            handlers.push_back(make_handler(static_cast<int>(i), &total));
+        return static_cast<std::uint64_t>(handlers.size());
+    });
+    run(name + ", dispatch", n, [&] {
+        total = 0;
+        int event {0};
+        for (const Handler& handler : handlers)
+            handler(++event);
+        return total;
+    });
+    run(name + ", vector copy", n, [&] {
+        const std::vector<Handler> copy {handlers};
+        return static_cast<std::uint64_t>(copy.size());
+    });
+}
+
+__attribute__((noinline)) std::uint64_t call_with_function(const std::function<void(int)>& callback, int event)
+{
+    callback(event);
+    return 1;
+}
+
+__attribute__((noinline)) std::uint64_t call_with_ref(Function_ref<void(int)> callback, int event)
+{
+    callback(event);
+    return 1;
+}
+
+template <typename Call>
+void bench_callback(const std::string& name, std::size_t n, Call call)
+{
+    run(name + ", callback parameter", n, [&] {
+        std::uint64_t total {0};
+        for (std::size_t i = 0; i < n; ++i)
+            call(make_handler(static_cast<int>(i), &total), static_cast<int>(i));
+        return total;
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1'000'000;
+
+    std::cout << std::setw(44) << std::left << "ns per handler" << std::setw(10) << std::right << ""
+        << std::setw(22) << "checksum" << std::endl;
+    bench_handlers<std::function<void(int)>>("std::function", n);
+    bench_handlers<Inplace_function<void(int)>>("Inplace_function<32>", n);
+    bench_callback("std::function", n, [](auto handler, int event) { return call_with_function(handler, event); });
+    bench_callback("Function_ref", n, [](auto handler, int event) { return call_with_ref(handler, event); });
+
+    return 0;
+}
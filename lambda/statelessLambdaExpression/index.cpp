@@ -17,7 +17,7 @@ public:
     Person(const Person& p) : name(p.name), age(p.age) {}
     ~Person() = default;
 
-    std::string get_name() const { return this->name; }
+    const std::string& get_name() const { return this->name; }
     int get_age() const { return this->age; }
     
     void set_name(std::string name) { this->name = name; }
@@ -1,43 +1,75 @@
 #include <iostream>
 #include "Movie.h"
+#include "../../tooling/compiledFormat/Compiled_format.h"
 
-Movie::Movie(std::string name, std::string rating, int watch)
-  : name{name}, rating{rating}, watch{watch}
+Movie::Movie(std::string_view name, std::string_view rating, int watch)
+  : name{Symbol_table::global().intern(name)}, rating{Symbol_table::global().intern(rating)}, watch{watch}
 {}
 
 Movie::Movie(const Movie &movie)
-  : Movie{movie.name, movie.rating, movie.watch}
+  : name{movie.name}, rating{movie.rating}, watch{movie.watch}
 {}
 
-Movie::Movie(Movie &&movie)
+Movie::Movie(Movie &&movie) noexcept
   : name{movie.name}, rating{movie.rating}, watch{movie.watch}
 {
-  movie.name = "";
-  movie.rating = "";
+  movie.name = Symbol {};
+  movie.rating = Symbol {};
   movie.watch = 0;
 }
 
 Movie::~Movie()
 {}
 
-std::string Movie::get_name() const 
+Movie &Movie::operator=(const Movie &rhs)
+{
+  this->name = rhs.name;
+  this->rating = rhs.rating;
+  this->watch = rhs.watch;
+  return *this;
+}
+
+Movie &Movie::operator=(Movie &&rhs) noexcept
+{
+  if (this != &rhs) {
+    this->name = rhs.name;
+    this->rating = rhs.rating;
+    this->watch = rhs.watch;
+    rhs.name = Symbol {};
+    rhs.rating = Symbol {};
+    rhs.watch = 0;
+  }
+  return *this;
+}
+
+const std::string &Movie::get_name() const 
+{
+  return this->name.str();
+}
+
+Symbol Movie::get_name_symbol() const
 {
   return this->name;
 }
 
-void Movie::set_name(std::string name) 
+void Movie::set_name(std::string_view name) 
+{
+  this->name = Symbol_table::global().intern(name);
+}
+
+const std::string &Movie::get_rating() const 
 {
-  this->name = name;
+  return this->rating.str();
 }
 
-std::string Movie::get_rating() const 
+Symbol Movie::get_rating_symbol() const
 {
   return this->rating;
 }
 
-void Movie::set_rating(std::string rating) 
+void Movie::set_rating(std::string_view rating) 
 {
-  this->rating = rating;
+  this->rating = Symbol_table::global().intern(rating);
 }
 
 int Movie::get_watch() const 
@@ -57,6 +89,5 @@ void Movie::increment_watch()
 
 void Movie::display() const
 {
-  std::cout << this->get_name() << ", " 
-    << this->get_rating() << ", " << this->get_watch() << std::endl;
+  compiled_format::print(std::cout, COMPILED_FORMAT("{}, {}, {}\n"), this->get_name(), this->get_rating(), this->get_watch());
 }
\ No newline at end of file
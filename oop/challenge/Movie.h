@@ -2,25 +2,35 @@
 #define _MOVIE_H_
 
 #include <string>
+#include <string_view>
+#include "Symbol.h"
+#include "../moveConstructor/Trivially_relocatable.h"
 
 class Movie
 {
 private:
-  std::string name;
-  std::string rating;
+  // names and ratings repeat a lot, they are interned in Symbol_table::global()
+  Symbol name;
+  Symbol rating;
   int watch;
 
 public:
-  Movie(std::string name, std::string rating, int watch);
+  Movie(std::string_view name, std::string_view rating, int watch);
   Movie(const Movie &movie);
-  Movie(Movie &&movie);
+  // noexcept, so a std::vector<Movie> moves its movies when it grows
+  Movie(Movie &&movie) noexcept;
   ~Movie();
 
-  std::string get_name() const;
-  void set_name(std::string name);
+  Movie &operator=(const Movie &rhs);
+  Movie &operator=(Movie &&rhs) noexcept;
 
-  std::string get_rating() const;
-  void set_rating(std::string rating);
+  const std::string &get_name() const;
+  Symbol get_name_symbol() const;
+  void set_name(std::string_view name);
+
+  const std::string &get_rating() const;
+  Symbol get_rating_symbol() const;
+  void set_rating(std::string_view rating);
 
   int get_watch() const;
   void set_watch(int watch);
@@ -29,4 +39,8 @@ public:
   void display() const;
 };
 
+// two symbols, pointers into the table, and an int, a memcpy moves a Movie
+template <>
+struct Trivially_relocatable<Movie> : std::true_type {};
+
 #endif
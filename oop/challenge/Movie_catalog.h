@@ -0,0 +1,119 @@
+#ifndef _MOVIE_CATALOG_H_
+#define _MOVIE_CATALOG_H_
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "Movies.h"
+#include "Movie.h"
+#include "../../tooling/mappedCatalog/Mapped_catalog.h"
+
+/*
+
+  - a movie catalog is a catalog file of the movies, see tooling/mappedCatalog/Mapped_catalog.h,
+    the name, the rating and the watch of every movie, write_movie_catalog writes the ones of
+    Movies in the order they were added.
+
+  - Movie_catalog is the movies of a catalog file without loading them: opening it maps the
+    file, a name is found in the index of the file, the names and the ratings are views into
+    the mapping, nothing is interned. a catalog of 50M movies opens as fast as one of ten,
+    and every process that opens it shares its pages.
+
+  - the file is not written, increment_watch keeps the watch it gives in the overlay of the
+    catalog, a few movies watched since it was written, save writes the movies with them to
+    a new catalog file, e.g. over the one it was opened from.
+
+  - the messages of increment_watch and display are the ones of Movies.
+
+*/
+inline void write_movie_catalog(const std::string &path, const Movies &movies)
+{
+  mapped_catalog::Writer writer;
+  for (std::size_t i = 0; i < movies.size(); ++i) {
+    const Movie &movie = movies.at(i);
+    writer.add(movie.get_name(), movie.get_rating(), movie.get_watch());
+  }
+  writer.save(path);
+}
+
+class Movie_catalog
+{
+private:
+  mapped_catalog::Catalog catalog;
+
+public:
+  explicit Movie_catalog(const std::string &path)
+    : catalog{path}
+  {}
+
+  std::size_t size() const
+  {
+    return this->catalog.size();
+  }
+
+  bool is_empty() const
+  {
+    return this->catalog.size() == 0;
+  }
+
+  // -1 when there is no movie of that name
+  int get_index(std::string_view name) const
+  {
+    const std::size_t i = this->catalog.find(name);
+    return i == mapped_catalog::Catalog::npos ? -1 : static_cast<int>(i);
+  }
+
+  bool is_exist(std::string_view name) const
+  {
+    return this->get_index(name) >= 0;
+  }
+
+  // views into the file, i < size()
+  std::string_view get_name(std::size_t i) const
+  {
+    return this->catalog.get_name(i);
+  }
+
+  std::string_view get_rating(std::size_t i) const
+  {
+    return this->catalog.get_text(i);
+  }
+
+  int get_watch(std::size_t i) const
+  {
+    return static_cast<int>(this->catalog.get_number(i));
+  }
+
+  void increment_watch(std::string_view name)
+  {
+    const int i = this->get_index(name);
+    if (i >= 0) {
+      this->catalog.set_number(i, this->catalog.get_number(i) + 1);
+      std::cout << name << " incremented its watch." << '\n';
+    } else
+      std::cout << name << " is not found for incrementing." << '\n';
+  }
+
+  // the movies watched since the file was written
+  std::size_t get_num_changes() const
+  {
+    return this->catalog.get_num_changes();
+  }
+
+  void display() const
+  {
+    if (!is_empty())
+      for (std::size_t i = 0; i < this->size(); ++i)
+        std::cout << this->get_name(i) << ", " << this->get_rating(i) << ", " << this->get_watch(i) << '\n';
+    else
+      std::cout << "Sorry, movies are empty." << '\n';
+  }
+
+  void save(const std::string &path) const
+  {
+    this->catalog.save(path);
+  }
+};
+
+#endif
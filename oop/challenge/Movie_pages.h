@@ -0,0 +1,84 @@
+#ifndef _MOVIE_PAGES_H_
+#define _MOVIE_PAGES_H_
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "Movies.h"
+#include "../../tooling/pagedView/Paged_view.h"
+
+/*
+
+  - Movie_pages shows a page of the movies, the lines Movies::display prints, formatting only
+    the movies of the page, see tooling/pagedView/Paged_view.h.
+
+  - movies are never removed and the name and the rating of one do not change through Movies,
+    the watch count is what does, it is the stamp of a row: a row is formatted again when the
+    movie in it was watched since it was shown.
+
+*/
+namespace detail_movie_pages
+{
+  struct Stamp
+  {
+    const Movies *movies;
+
+    int operator()(std::size_t row) const
+    {
+      return this->movies->at(row).get_watch();
+    }
+  };
+
+  struct Format
+  {
+    const Movies *movies;
+
+    void operator()(std::size_t row, std::string &text) const
+    {
+      const Movie &movie = this->movies->at(row);
+      text += movie.get_name();
+      text += ", ";
+      text += movie.get_rating();
+      text += ", ";
+      char digits[16];
+      text.append(digits, std::to_chars(digits, digits + sizeof(digits), movie.get_watch()).ptr - digits);
+    }
+  };
+}
+
+class Movie_pages
+{
+private:
+  const Movies &movies;
+  paged_view::Paged_view<detail_movie_pages::Stamp, detail_movie_pages::Format> view;
+
+public:
+  explicit Movie_pages(const Movies &movies, std::size_t capacity = 1024)
+    : movies(movies), view({&movies}, {&movies}, capacity)
+  {}
+
+  // the movies [offset, offset + limit), a line each, good until the next page
+  std::string_view page(std::size_t offset, std::size_t limit)
+  {
+    return this->view.page(offset, limit, this->movies.size());
+  }
+
+  void display(std::size_t offset, std::size_t limit, std::ostream &os = std::cout)
+  {
+    if (this->movies.is_empty()) {
+      os << "Sorry, movies are empty." << '\n';
+      return;
+    }
+    const std::string_view text = this->page(offset, limit);
+    os.write(text.data(), text.size());
+  }
+
+  std::size_t get_num_formatted() const
+  {
+    return this->view.get_num_formatted();
+  }
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef _MOVIE_RECORDS_H_
+#define _MOVIE_RECORDS_H_
+
+#include <cstddef>
+#include <string>
+#include "Movies.h"
+#include "../../tooling/recordParser/Record_parser.h"
+
+/*
+
+  - load_movies adds the movies of a name,rating,watch file, an export of a catalog, with
+    Movies::emplace, so it prints nothing. the name and the rating are views into records
+    until the movie interns them.
+
+  - the first record is a header when its watch is not a number, it is skipped, a watch
+    that is not a number after it throws std::runtime_error. a name that is already there
+    keeps its movie, like add_new.
+
+*/
+
+// the number of movies added, records is unescaped in place
+inline std::size_t load_movies(Movies &movies, std::string &records)
+{
+  record_parser::Parser parser {records};
+  record_parser::Record record;
+  std::size_t added = 0;
+  int watch;
+
+  if (parser.next(record) && record.get(2, watch))
+    added += movies.emplace(record[0], record[1], watch);
+  while (parser.next(record))
+    added += movies.emplace(record[0], record.get<std::string_view>(1), record.get<int>(2));
+  return added;
+}
+
+#endif
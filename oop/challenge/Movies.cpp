@@ -1,62 +1,151 @@
 #include <iostream>
-#include <algorithm>
 #include "Movies.h"
 #include "Movie.h"
 
 Movies::Movies()
+  : slots(16, Slot {0, no_movie}), names(8)
 {
-  this->movies = new std::vector<Movie>;
-  std::cout << "movies ptr contains address " << this->movies << "." << std::endl;
+  std::cout << "movies at address " << &this->movies << "." << '\n';
 }
 
 Movies::~Movies()
 {
-  delete this->movies;
-  std::cout << "movies ptr at address " << this->movies << " destroyed." << std::endl;
+  std::cout << "movies at address " << &this->movies << " destroyed." << '\n';
 }
 
-void Movies::add_new(std::string name, std::string rating, int watch)
+std::size_t Movies::find_slot(std::string_view name, std::size_t hash) const
 {
-  if (this->is_exist(name))
-    std::cout << name << " is already exist." << std::endl;
-  else {
-    (*this->movies).push_back(Movie{name, rating, watch});
-    std::cout << name << " added." << std::endl;
+  const std::size_t mask = this->slots.size() - 1;
+  for (std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+    const Slot &slot = this->slots[i];
+    if (slot.index == no_movie)
+      return i;
+    if (slot.hash == hash && this->movies[slot.index].get_name_symbol().str() == name)
+      return i;
   }
 }
 
-inline bool Movies::is_exist(std::string name) const
+void Movies::grow()
 {
-  return this->get_index(name) != -1;
+  std::vector<Slot> old(this->slots.size() * 2, Slot {0, no_movie});
+  old.swap(this->slots);
+  this->names = membership_filter::Bloom_filter<std::string_view> {this->slots.size() / 2};
+
+  const std::size_t mask = this->slots.size() - 1;
+  for (const Slot &slot: old) {
+    if (slot.index == no_movie)
+      continue;
+    std::size_t i = slot.hash & mask;
+    while (this->slots[i].index != no_movie)
+      i = (i + 1) & mask;
+    this->slots[i] = slot;
+    this->names.insert_hash(slot.hash);
+  }
 }
 
-int Movies::get_index(std::string name) const
+void Movies::add_new(std::string_view name, std::string_view rating, int watch)
 {
-  for (size_t i {0}; i < (*this->movies).size(); i++)
-    if ((*this->movies).at(i).get_name() == name)
-      return i;
-  return -1;
+  if (this->emplace(name, rating, watch))
+    std::cout << name << " added." << '\n';
+  else
+    std::cout << name << " is already exist." << '\n';
+}
+
+bool Movies::is_exist(std::string_view name) const
+{
+  return this->find(name) != nullptr;
+}
+
+int Movies::get_index(std::string_view name) const
+{
+  const std::size_t hash = std::hash<std::string_view> {}(name);
+  if (!this->names.may_contain_hash(hash))
+    return -1;
+  const std::size_t i = this->find_slot(name, hash);
+  return this->slots[i].index == no_movie ? -1 : static_cast<int>(this->slots[i].index);
+}
+
+const Movie *Movies::find(std::string_view name) const
+{
+  const std::size_t hash = std::hash<std::string_view> {}(name);
+  if (!this->names.may_contain_hash(hash))
+    return nullptr;
+  const std::size_t i = this->find_slot(name, hash);
+  return this->slots[i].index == no_movie ? nullptr : &this->movies[this->slots[i].index];
 }
 
-void Movies::increment_watch(std::string name)
+void Movies::increment_watch(std::string_view name)
 {
-  if (this->is_exist(name)) {
-    (*this->movies).at(this->get_index(name)).increment_watch();
-    std::cout << name << " incremented its watch." << std::endl;
+  const int i = this->get_index(name);
+  if (i >= 0) {
+    this->movies[i].increment_watch();
+    this->ranking.increment(static_cast<std::uint32_t>(i));
+    this->ratings.increment(static_cast<std::uint32_t>(i));
+    std::cout << name << " incremented its watch." << '\n';
   } else
-    std::cout << name << " is not found for incrementing." << std::endl;
+    std::cout << name << " is not found for incrementing." << '\n';
 }
 
-inline bool Movies::is_empty() const
+bool Movies::is_empty() const
 {
-  return (*this->movies).size() <= 0;
+  return this->movies.empty();
 }
 
 void Movies::display() const
 {
   if (!is_empty())
-    for (auto movie: (*this->movies))
+    for (const Movie &movie: this->movies)
       movie.display();
   else
-    std::cout << "Sorry, movies are empty." << std::endl;
+    std::cout << "Sorry, movies are empty." << '\n';
+}
+
+std::size_t Movies::size() const
+{
+  return this->movies.size();
+}
+
+const Movie &Movies::at(std::size_t i) const
+{
+  return this->movies.at(i);
+}
+
+std::vector<const Movie *> Movies::top(std::size_t k) const
+{
+  std::vector<const Movie *> movies;
+  for (std::uint32_t i: this->ranking.top(k))
+    movies.push_back(&this->movies[i]);
+  return movies;
+}
+
+void Movies::display_top(std::size_t k) const
+{
+  if (!is_empty())
+    for (const Movie *movie: this->top(k))
+      movie->display();
+  else
+    std::cout << "Sorry, movies are empty." << '\n';
+}
+
+std::vector<const Movie *> Movies::with_rating(std::string_view rating, std::size_t k) const
+{
+  std::vector<const Movie *> movies;
+  for (std::uint32_t i: this->ratings.top(rating, k))
+    movies.push_back(&this->movies[i]);
+  return movies;
+}
+
+std::size_t Movies::count_rating(std::string_view rating) const
+{
+  return this->ratings.count(rating);
+}
+
+void Movies::display_rating(std::string_view rating) const
+{
+  const std::vector<const Movie *> movies = this->with_rating(rating);
+  if (!movies.empty())
+    for (const Movie *movie: movies)
+      movie->display();
+  else
+    std::cout << "Sorry, no movie is rated " << rating << "." << '\n';
 }
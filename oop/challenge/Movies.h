@@ -1,25 +1,117 @@
 #ifndef _MOVIES_H_
 #define _MOVIES_H_
 
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "Movie.h"
+#include "Rating_index.h"
+#include "Watch_ranking.h"
+#include "../../tooling/membershipFilter/Membership_filter.h"
+
+/*
+
+  - the movies are kept in the vector in the order they were added, a name is found with
+    one lookup in an open addressing table of the hash of the name and the index of the
+    movie, so add_new, increment_watch and find don't scan the movies.
+
+  - the hash is std::hash of the name, the same one its Symbol keeps, a lookup does not go
+    through the Symbol_table, the probed movies are compared by their name.
+
+  - emplace builds the movie in place from the name and the rest of the arguments, it prints
+    nothing, add_new is emplace with a message.
+
+  - a Watch_ranking follows the watch counts, increment_watch keeps it up to date, so top(k)
+    gives the k most watched movies in O(k) instead of sorting all of them. the watch of a
+    movie changes only through Movies, find gives const movies.
+
+  - movies are never removed, so the table has no tombstones, it is doubled when it is
+    half full.
+
+  - a Bloom_filter of the hashes of the names is in front of the table, most names looked up
+    are not there, find, get_index and is_exist of one of them stop at the filter without a
+    probe of the table, a name that is there pays one cache line more. it is rebuilt from
+    the hashes of the slots when the table grows.
+
+  - a Rating_index is the movies of every rating, each rating in the order of its watch
+    counts, with_rating("PG-13") gives the PG-13 movies, the most watched first, in the
+    time of the movies it gives. add and increment_watch keep it up to date too.
+
+*/
+static_assert(std::is_nothrow_move_constructible<Movie>::value, "a growing vector moves its movies");
 
 class Movies
 {
 private:
-  std::vector<Movie> *movies;
+  struct Slot
+  {
+    std::size_t hash;
+    std::uint32_t index; // no_movie is an empty slot
+  };
+
+  static constexpr std::uint32_t no_movie = ~std::uint32_t {0};
+
+  std::vector<Movie> movies;
+  std::vector<Slot> slots;
+  membership_filter::Bloom_filter<std::string_view> names;
+  Watch_ranking ranking;
+  Rating_index ratings;
+
+  // the slot of name, or the empty one where it goes
+  std::size_t find_slot(std::string_view name, std::size_t hash) const;
+  void grow();
 
 public:
   Movies();
   ~Movies();
 
-  void add_new(std::string name, std::string rating, int watch);
-  bool is_exist(std::string name) const;
-  int get_index(std::string name) const;
-  void increment_watch(std::string name);
+  // false when there is already a movie of that name
+  template<typename... Args>
+  bool emplace(std::string_view name, Args &&... args);
+
+  void add_new(std::string_view name, std::string_view rating, int watch);
+  bool is_exist(std::string_view name) const;
+  int get_index(std::string_view name) const;
+  void increment_watch(std::string_view name);
   bool is_empty() const;
   void display() const;
+
+  // nullptr when there is no movie of that name
+  const Movie *find(std::string_view name) const;
+
+  // the k most watched movies, the most watched first
+  std::vector<const Movie *> top(std::size_t k) const;
+  void display_top(std::size_t k) const;
+
+  // the k most watched movies of a rating, the most watched first, all of them by default
+  std::vector<const Movie *> with_rating(std::string_view rating, std::size_t k = ~std::size_t {0}) const;
+  std::size_t count_rating(std::string_view rating) const;
+  void display_rating(std::string_view rating) const;
+
+  std::size_t size() const;
+  const Movie &at(std::size_t i) const;
 };
 
+template<typename... Args>
+bool Movies::emplace(std::string_view name, Args &&... args)
+{
+  const std::size_t hash = std::hash<std::string_view> {}(name);
+  const std::size_t i = this->find_slot(name, hash);
+  if (this->slots[i].index != no_movie)
+    return false;
+
+  this->slots[i] = Slot {hash, static_cast<std::uint32_t>(this->movies.size())};
+  this->names.insert_hash(hash);
+  this->movies.emplace_back(name, std::forward<Args>(args)...);
+  this->ranking.add(this->slots[i].index, this->movies.back().get_watch());
+  this->ratings.add(this->slots[i].index, this->movies.back().get_rating_symbol(), this->movies.back().get_watch());
+  if (this->movies.size() * 2 > this->slots.size())
+    this->grow();
+  return true;
+}
+
 #endif
@@ -0,0 +1,57 @@
+#include "Rating_index.h"
+
+const Rating_index::Posting *Rating_index::find(std::string_view rating) const
+{
+  // "" is the empty symbol, a rating never interned is no movie's
+  const Symbol symbol = Symbol_table::global().find(rating);
+  if (!symbol && !rating.empty())
+    return nullptr;
+  auto it = this->codes.find(symbol);
+  return it == this->codes.end() ? nullptr : &this->postings[it->second];
+}
+
+void Rating_index::add(std::uint32_t index, Symbol rating, int watch)
+{
+  auto it = this->codes.emplace(rating, static_cast<std::uint32_t>(this->postings.size())).first;
+  if (it->second == this->postings.size())
+    this->postings.push_back(Posting {rating, {}, {}});
+
+  Posting &posting = this->postings[it->second];
+  const std::uint32_t place = static_cast<std::uint32_t>(posting.movies.size());
+  posting.movies.push_back(index);
+  posting.ranking.add(place, watch);
+  this->codes_of.push_back(it->second);
+  this->places.push_back(place);
+}
+
+void Rating_index::increment(std::uint32_t index)
+{
+  this->postings[this->codes_of[index]].ranking.increment(this->places[index]);
+}
+
+std::size_t Rating_index::get_num_ratings() const
+{
+  return this->postings.size();
+}
+
+Symbol Rating_index::get_rating(std::uint32_t code) const
+{
+  return this->postings[code].rating;
+}
+
+std::size_t Rating_index::count(std::string_view rating) const
+{
+  const Posting *posting = this->find(rating);
+  return posting == nullptr ? 0 : posting->movies.size();
+}
+
+std::vector<std::uint32_t> Rating_index::top(std::string_view rating, std::size_t k) const
+{
+  const Posting *posting = this->find(rating);
+  if (posting == nullptr)
+    return {};
+  std::vector<std::uint32_t> movies = posting->ranking.top(k);
+  for (std::uint32_t &movie: movies)
+    movie = posting->movies[movie];
+  return movies;
+}
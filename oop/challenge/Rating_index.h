@@ -0,0 +1,61 @@
+#ifndef _RATING_INDEX_H_
+#define _RATING_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Symbol.h"
+#include "Watch_ranking.h"
+
+/*
+
+  - a Rating_index is the movies of every rating, a secondary index of Movies next to its
+    table of names: "all the PG-13 movies, the most watched first" is the movies of one
+    rating in the order it keeps, O(k) for k movies, not a scan of all of them and a sort.
+
+  - the ratings are a few strings for many movies, every distinct one gets a code, 0, 1, 2
+    in the order they are first seen, from a map of its Symbol, a movie keeps its code and
+    its place among the movies of its rating.
+
+  - the movies of a code are a posting list that is a Watch_ranking of their places, the
+    increment of a watch is the one of the Watch_ranking of its rating, O(1), the same as
+    the one of all the movies, so both stay in order with one more swap.
+
+  - movies are never removed and their rating does not change through Movies, add and
+    increment are all the updates there are.
+
+*/
+class Rating_index
+{
+private:
+  struct Posting
+  {
+    Symbol rating;
+    std::vector<std::uint32_t> movies; // the index of the movie at every place
+    Watch_ranking ranking;             // of the places
+  };
+
+  std::unordered_map<Symbol, std::uint32_t> codes;
+  std::vector<Posting> postings;      // by code
+  std::vector<std::uint32_t> codes_of; // the code of every movie
+  std::vector<std::uint32_t> places;   // the place of every movie among the ones of its rating
+
+  // nullptr when no movie has that rating
+  const Posting *find(std::string_view rating) const;
+
+public:
+  // index is the number of movies added before this one
+  void add(std::uint32_t index, Symbol rating, int watch);
+  void increment(std::uint32_t index);
+
+  std::size_t get_num_ratings() const;
+  // the rating of a code, code < get_num_ratings()
+  Symbol get_rating(std::uint32_t code) const;
+  std::size_t count(std::string_view rating) const;
+  // the indices of the k most watched movies of the rating, fewer when there are not k
+  std::vector<std::uint32_t> top(std::string_view rating, std::size_t k) const;
+};
+
+#endif
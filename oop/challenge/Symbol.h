@@ -0,0 +1,124 @@
+#ifndef _SYMBOL_H_
+#define _SYMBOL_H_
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/*
+
+  - a Symbol is a handle to the one canonical copy of a string kept by a Symbol_table,
+    so two symbols of the same table are equal exactly when they point to the same entry,
+    == is a pointer compare and the hash of every string is computed once.
+
+  - < and > still order by the text, like std::string.
+
+  - symbols of different tables must not be compared, the table must outlive its symbols,
+    and a table is not thread safe.
+
+*/
+class Symbol
+{
+  friend class Symbol_table;
+
+private:
+  struct Entry
+  {
+    std::string text;
+    std::size_t hash;
+  };
+
+  const Entry *entry; // nullptr is the empty symbol
+
+  Symbol(const Entry *entry)
+    : entry{entry}
+  {}
+
+public:
+  Symbol()
+    : entry{nullptr}
+  {}
+
+  const std::string &str() const
+  {
+    static const std::string empty;
+    return this->entry == nullptr ? empty : this->entry->text;
+  }
+
+  std::size_t hash() const
+  {
+    return this->entry == nullptr ? 0 : this->entry->hash;
+  }
+
+  explicit operator bool() const
+  {
+    return this->entry != nullptr;
+  }
+
+  bool operator==(const Symbol &rhs) const { return this->entry == rhs.entry; }
+  bool operator!=(const Symbol &rhs) const { return this->entry != rhs.entry; }
+  bool operator<(const Symbol &rhs) const { return this->entry != rhs.entry && this->str() < rhs.str(); }
+  bool operator>(const Symbol &rhs) const { return this->entry != rhs.entry && this->str() > rhs.str(); }
+};
+
+class Symbol_table
+{
+private:
+  // a deque never moves its elements, so the entries and the views of the map stay valid
+  std::deque<Symbol::Entry> entries;
+  std::unordered_map<std::string_view, const Symbol::Entry*> lookup;
+
+public:
+  Symbol_table() = default;
+  Symbol_table(const Symbol_table &source) = delete;
+  Symbol_table &operator=(const Symbol_table &rhs) = delete;
+
+  // returns the symbol of text, adding it on first use, "" is the empty symbol
+  Symbol intern(std::string_view text)
+  {
+    if (text.empty())
+      return Symbol {};
+
+    auto it = this->lookup.find(text);
+    if (it != this->lookup.end())
+      return Symbol {it->second};
+
+    this->entries.push_back({std::string {text}, std::hash<std::string_view> {}(text)});
+    const Symbol::Entry *entry = &this->entries.back();
+    this->lookup.emplace(entry->text, entry);
+    return Symbol {entry};
+  }
+
+  // returns the symbol of text or the empty symbol when it was never interned
+  Symbol find(std::string_view text) const
+  {
+    auto it = this->lookup.find(text);
+    return it == this->lookup.end() ? Symbol {} : Symbol {it->second};
+  }
+
+  std::size_t size() const
+  {
+    return this->entries.size();
+  }
+
+  // the table shared by the Movie and Song examples
+  static Symbol_table &global()
+  {
+    static Symbol_table table;
+    return table;
+  }
+};
+
+template<>
+struct std::hash<Symbol>
+{
+  std::size_t operator()(const Symbol &symbol) const
+  {
+    return symbol.hash();
+  }
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <utility>
+#include "Watch_ranking.h"
+
+void Watch_ranking::swap(std::uint32_t a, std::uint32_t b)
+{
+  std::swap(this->order[a], this->order[b]);
+  this->positions[this->order[a]] = a;
+  this->positions[this->order[b]] = b;
+}
+
+void Watch_ranking::add(std::uint32_t index, int watch)
+{
+  std::uint32_t position = static_cast<std::uint32_t>(this->order.size());
+  this->order.push_back(index);
+  this->positions.push_back(position);
+  this->watches.push_back(watch);
+
+  // the first movie of every bucket below goes to the end of it, the new one takes its place
+  while (position > 0) {
+    const int below = this->watches[this->order[position - 1]];
+    if (below >= watch)
+      break;
+    const std::uint32_t start = this->starts[below];
+    this->swap(start, position);
+    this->starts[below] = start + 1;
+    position = start;
+  }
+
+  this->starts.emplace(watch, position);
+}
+
+void Watch_ranking::increment(std::uint32_t index)
+{
+  const int watch = this->watches[index];
+  auto it = this->starts.find(watch);
+  const std::uint32_t start = it->second;
+
+  this->swap(start, this->positions[index]);
+  if (start + 1 < this->order.size() && this->watches[this->order[start + 1]] == watch)
+    it->second = start + 1;
+  else
+    this->starts.erase(it);
+
+  ++this->watches[index];
+  this->starts.emplace(watch + 1, start);
+}
+
+std::size_t Watch_ranking::size() const
+{
+  return this->order.size();
+}
+
+int Watch_ranking::get_watch(std::uint32_t index) const
+{
+  return this->watches[index];
+}
+
+std::vector<std::uint32_t> Watch_ranking::top(std::size_t k) const
+{
+  k = std::min(k, this->order.size());
+  return std::vector<std::uint32_t>(this->order.begin(), this->order.begin() + k);
+}
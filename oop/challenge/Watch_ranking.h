@@ -0,0 +1,45 @@
+#ifndef _WATCH_RANKING_H_
+#define _WATCH_RANKING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+
+  - a Watch_ranking keeps the indices of the movies sorted by their watch count, the most
+    watched first, so the top k are the first k and top(k) costs O(k).
+
+  - the movies of the same count are next to each other, a bucket, and the map has where
+    every bucket starts. an increment swaps the movie with the first one of its bucket, then
+    that place is the end of the bucket of the count plus one, so it costs O(1).
+
+  - add puts a new movie after every bucket of a count above its own, it swaps once for
+    every distinct count below it, a movie added with 0 watches swaps at most once.
+
+  - the order of movies of the same count is not kept.
+
+*/
+class Watch_ranking
+{
+private:
+  std::vector<std::uint32_t> order;     // the indices, the most watched first
+  std::vector<std::uint32_t> positions; // where every index is in order
+  std::vector<int> watches;             // the count of every index
+  std::unordered_map<int, std::uint32_t> starts;
+
+  void swap(std::uint32_t a, std::uint32_t b);
+
+public:
+  // index is the number of movies added before this one
+  void add(std::uint32_t index, int watch);
+  void increment(std::uint32_t index);
+
+  std::size_t size() const;
+  int get_watch(std::uint32_t index) const;
+  // the indices of the k most watched movies, fewer when there are not k
+  std::vector<std::uint32_t> top(std::size_t k) const;
+};
+
+#endif
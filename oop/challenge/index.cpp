@@ -1,11 +1,45 @@
+#include <filesystem>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include "Movies.h"
 #include "Movie.h"
+#include "Movie_records.h"
+#include "Movie_catalog.h"
+#include "Movie_pages.h"
+#include "../../tooling/batchInput/Batch_io.h"
+#include "../../tooling/fastConsole/Fast_console.h"
 
-int main()
+/*
+
+  ./a.out               the movies of the example
+  ./a.out movies.csv    the movies of a name,rating,watch file first, see Movie_records.h
+  ./a.out movies.csv movies.cat
+                        and the movies written to a catalog file, opened again, see
+                        Movie_catalog.h, without movies.cat a catalog of the temporary
+                        directory, removed after
+
+*/
+
+int main(int argc, char *argv[])
 {
+  fast_console::Guard console;
   Movies movies;
 
+  if (argc > 1)
+  {
+    try
+    {
+      std::string records {batch_io::read_all(argv[1])};
+      std::cout << load_movies(movies, records) << " movies loaded from " << argv[1] << '\n';
+    }
+    catch (const std::runtime_error &ex)
+    {
+      std::cerr << ex.what() << std::endl;
+      return 1;
+    }
+  }
+
   movies.add_new("Soul", "PG", 1);
   movies.increment_watch("Soul");
   movies.display();
@@ -16,5 +50,34 @@ int main()
 
   movies.display();
 
+  movies.display_top(1);
+  movies.display_rating("PG-13");
+
+  // a page of two, the movie watched since is the only one formatted again
+  Movie_pages pages {movies, 64};
+  pages.display(0, 2);
+  movies.increment_watch("Halk");
+  pages.display(0, 2);
+  std::cout << pages.get_num_formatted() << " rows formatted for two pages" << '\n';
+
+  // the movies in a catalog file, a watch of it kept apart from the file until it is saved
+  const std::string path {argc > 2 ? argv[2] : (std::filesystem::temp_directory_path() / "movies.cat").string()};
+  try
+  {
+    write_movie_catalog(path, movies);
+    Movie_catalog catalog {path};
+    catalog.increment_watch("Soul");
+    catalog.display();
+    std::cout << catalog.get_num_changes() << " movie watched since the catalog was written" << '\n';
+    catalog.save(path);
+  }
+  catch (const std::runtime_error &ex)
+  {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  }
+  if (argc <= 2)
+    std::filesystem::remove(path);
+
   return 0;
 }
@@ -38,6 +38,14 @@
   std::string get_name() const;
   with this const you tell compiler that the get_name method is not manipulating the object.
 
+
+
+  a const getter can return a const reference to the attr, not a copy of it:
+  const std::string &get_name() const;
+  the caller reads the name of the object, or copies it when it wants one of its own,
+  a sort or a search that compares names copies nothing, ../constWithClassesBenchmark
+  shows how much that is for 1'000'000 accounts. the reference is good while the object lives.
+
 */
 
 #include <iostream>
@@ -54,7 +62,7 @@ public:
   Account(Account &&source);
   ~Account();
 
-  std::string get_name() const /* this is the key */;
+  const std::string &get_name() const /* this is the key */;
   void set_name(std::string);
 };
 
@@ -79,7 +87,7 @@ Account::~Account()
   std::cout << "Destructor constructor" << std::endl;
 }
 
-std::string Account::get_name() const /* this is the key */
+const std::string &Account::get_name() const /* this is the key */
 {
   return name;
 }
@@ -0,0 +1,152 @@
+/*
+
+  - sorts 1'000'000 accounts by name, or the number given as the first argument, and finds
+    the ones of 1000 names, through a const getter that returns a copy of the name, the
+    std::string get_name() const of the first version of ../constWithClasses, and one that
+    returns a const reference to it. the finds are linear, over the first 10'000 accounts,
+    most of the names are not in them.
+
+  - half of the names are longer than 15 characters, the copy of one is an allocation, the
+    shorter ones are in the string, the copy of one is a memcpy, a sort is about 20 * n
+    comparisons and the copying getter makes two copies per comparison.
+
+  - the sorts have to give the same order, the finds the same accounts.
+
+  - on one core of an x86-64 at -O2, the sort with the copy of the vector it sorts:
+
+                               copy     reference
+        sort by name, ms       1673           644    x2.6
+        1000 finds, ms          232            11    x21
+
+      g++ -std=c++17 -O2 index.cpp
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Copying_account
+{
+private:
+  std::string name;
+  double balance;
+
+public:
+  Copying_account(std::string name, double balance) : name {std::move(name)}, balance {balance} {}
+
+  std::string get_name() const { return this->name; }
+  double get_balance() const { return this->balance; }
+};
+
+class Account
+{
+private:
+  std::string name;
+  double balance;
+
+public:
+  Account(std::string name, double balance) : name {std::move(name)}, balance {balance} {}
+
+  const std::string &get_name() const { return this->name; }
+  double get_balance() const { return this->balance; }
+};
+
+template <typename F>
+double best_of_5(F f)
+{
+  double best = 1e300;
+  for (int run = 0; run < 5; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+template <typename A>
+std::vector<A> sorted_by_name(const std::vector<A> &accounts, double &seconds)
+{
+  std::vector<A> sorted;
+  seconds = best_of_5([&] {
+    sorted = accounts;
+    std::sort(sorted.begin(), sorted.end(), [](const A &a, const A &b) { return a.get_name() < b.get_name(); });
+  });
+  return sorted;
+}
+
+// the sum of the balances of the first account of every name, a linear find
+template <typename A>
+double find_names(const std::vector<A> &accounts, const std::vector<std::string> &names, double &seconds)
+{
+  double sum = 0;
+  seconds = best_of_5([&] {
+    sum = 0;
+    for (const std::string &name : names)
+    {
+      const auto found = std::find_if(accounts.begin(), accounts.end(), [&name](const A &a) { return a.get_name() == name; });
+      sum += found == accounts.end() ? 0 : found->get_balance();
+    }
+  });
+  return sum;
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1'000'000;
+
+  std::uint64_t seed = 12345;
+  auto next = [&seed]() {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<std::uint32_t>(seed >> 33);
+  };
+
+  std::vector<Copying_account> copying;
+  std::vector<Account> referencing;
+  copying.reserve(n);
+  referencing.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::string name(8 + next() % 16, ' ');
+    for (char &c : name)
+      c = static_cast<char>('a' + next() % 26);
+    const double balance = next() % 100'000 / 100.0;
+    copying.emplace_back(name, balance);
+    referencing.emplace_back(name, balance);
+  }
+
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < 1000; ++i)
+    names.push_back(referencing[(static_cast<std::size_t>(next()) * (n / 1000 + 1)) % n].get_name());
+
+  double copying_sort = 0, referencing_sort = 0, copying_find = 0, referencing_find = 0;
+  const std::vector<Copying_account> copying_sorted = sorted_by_name(copying, copying_sort);
+  const std::vector<Account> referencing_sorted = sorted_by_name(referencing, referencing_sort);
+  const std::size_t find_n = std::min<std::size_t>(n, 10'000);
+  const std::vector<Copying_account> copying_part(copying.begin(), copying.begin() + find_n);
+  const std::vector<Account> referencing_part(referencing.begin(), referencing.begin() + find_n);
+  const double copying_sum = find_names(copying_part, names, copying_find);
+  const double referencing_sum = find_names(referencing_part, names, referencing_find);
+
+  std::size_t mismatches = copying_sum != referencing_sum;
+  for (std::size_t i = 0; i < n; ++i)
+    mismatches += copying_sorted[i].get_name() != referencing_sorted[i].get_name();
+
+  std::cout << std::setw(28) << std::left << "" << std::setw(14) << std::right << "copy" << std::setw(14) << "reference" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::setw(28) << std::left << "sort by name, ms" << std::right << std::setw(14) << copying_sort * 1e3
+            << std::setw(14) << referencing_sort * 1e3 << "    x" << std::setprecision(2) << copying_sort / referencing_sort << std::endl;
+  std::cout << std::setprecision(3) << std::setw(28) << std::left << "1000 finds, ms" << std::right << std::setw(14)
+            << copying_find * 1e3 << std::setw(14) << referencing_find * 1e3 << "    x" << std::setprecision(2)
+            << copying_find / referencing_find << std::endl;
+  std::cout << "mismatches: " << mismatches << std::endl;
+
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#ifndef _TRIVIALLY_RELOCATABLE_H_
+#define _TRIVIALLY_RELOCATABLE_H_
+
+#include <memory>
+#include <type_traits>
+
+/*
+
+    - to relocate an object is to move it to another address and destroy it at the old one, what
+      a vector does to all its values when it grows. Trivially_relocatable<T> says a T can be
+      relocated by copying its bytes, with memcpy or realloc, and forgetting the old ones, no
+      move constructor and no destructor called, one memcpy for all of them.
+
+    - it is true for every trivially copyable T, and for the smart pointers. a class with a
+      pointer to the heap, and nothing that points into the object itself, is too, but only
+      its author knows it, it says so with a specialization next to it:
+
+        template <>
+        struct Trivially_relocatable<String> : std::true_type {};
+
+      a std::string of libstdc++ points into itself for a short text, it is not, and neither is
+      a class with one, or with a small buffer the pointer can point to.
+
+    - the containers of ../../standardTemplateLibrary and ../../smartPointers/challenge grow
+      with it. std::vector does not know it, it moves a T whose move constructor is noexcept,
+      and copies one whose move constructor can throw, so that a copy that throws leaves the
+      old values as they were, a move constructor that can not throw says noexcept.
+
+*/
+template <typename T>
+struct Trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T, typename D>
+struct Trivially_relocatable<std::unique_ptr<T, D>> : std::is_trivially_copyable<D> {};
+
+template <typename T>
+struct Trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = Trivially_relocatable<T>::value;
+
+#endif
@@ -28,16 +28,28 @@
   you have to consider if the don't provide the move constructor in the class for r-value,
   the class will use the copy constructor and this will affect the performance.
 
+  a std::vector that grows moves its elements only when the move constructor is noexcept,
+  when it can throw it copies them, so a throw in the middle leaves the old elements as they
+  were. Trivially_relocatable.h says a Move can even be moved with a memcpy, its data is a
+  pointer to the heap, Growable_vector does that, no constructor called at all.
+
 */
 
 #include <iostream>
 #include <vector>
+#include "Trivially_relocatable.h"
+#include "../../standardTemplateLibrary/sequenceContainerVector/Growable_vector.h"
 
 class Move
 {
 private:
   int *data;
 public:
+  // the copies and the moves made, quiet stops the prints for the big vectors
+  static inline std::size_t copies {0};
+  static inline std::size_t moves {0};
+  static inline bool quiet {false};
+
   void set_data_value(int d) { *data = d; }
   int get_data_value() { return *data; }
 
@@ -50,7 +62,8 @@ public:
   // move constructor
   // if you don't provide move constructor,
   // the class will use the copy constructor
-  Move(Move &&source);
+  // noexcept, or a std::vector copies instead when it grows
+  Move(Move &&source) noexcept;
 
   // destructor
   ~Move();
@@ -60,30 +73,42 @@ Move::Move(int d)
 {
   data = new int;
   *data = d;
-  std::cout << "Constructor of address " << this << " created." << std::endl;
+  if (!quiet)
+    std::cout << "Constructor of address " << this << " created." << std::endl;
 }
 
 Move::Move(const Move &source)
   : Move{*source.data} 
 {
-  std::cout << "Copy constructor of address " << this << " created from " << &source << "." << std::endl;
+  ++copies;
+  if (!quiet)
+    std::cout << "Copy constructor of address " << this << " created from " << &source << "." << std::endl;
 }
 
-Move::Move(Move &&source)
+Move::Move(Move &&source) noexcept
   : data{source.data}
 {
   source.data = nullptr; // the important part is here to remove all thing in the source
-  std::cout << "Move constructor of address " << this << " created from " << &source << "." << std::endl;
+  ++moves;
+  if (!quiet)
+    std::cout << "Move constructor of address " << this << " created from " << &source << "." << std::endl;
 }
 
 Move::~Move()
 {
-  if (data != nullptr)
+  if (quiet)
+    {}
+  else if (data != nullptr)
     std::cout << "Destructor of address " << this << " called." << std::endl;
   else
     std::cout << "Destructor of an nullptr address called." << std::endl;
+  delete data;
 }
 
+// nothing points into a Move, its pointer can be copied to the new place
+template <>
+struct Trivially_relocatable<Move> : std::true_type {};
+
 int main()
 {
   std::vector<Move> vec;
@@ -105,5 +130,26 @@ int main()
     std::cout << &vec.at(i) << " ";
   std::cout << std::endl << std::endl;
 
+  // the copies and the moves of 1000 push_backs, with no reserve
+  Move::quiet = true;
+  {
+    Move::copies = Move::moves = 0;
+    std::vector<Move> grown;
+    for (int i {0}; i < 1000; i++)
+      grown.push_back(Move{i});
+    std::cout << "std::vector: " << Move::copies << " copies, "
+              << Move::moves << " moves, 1000 of them by push_back" << std::endl;
+  }
+  {
+    Move::copies = Move::moves = 0;
+    Growable_vector<Move> grown;
+    for (int i {0}; i < 1000; i++)
+      grown.push_back(Move{i});
+    std::cout << "Growable_vector: " << Move::copies << " copies, " << Move::moves << " moves, "
+              << grown.stats().element_moves << " moved by realloc in "
+              << grown.stats().reallocations << " reallocations" << std::endl;
+  }
+  Move::quiet = false;
+
   return 0;
 }
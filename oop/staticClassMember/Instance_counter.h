@@ -0,0 +1,188 @@
+#ifndef _INSTANCE_COUNTER_H_
+#define _INSTANCE_COUNTER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../../variableAndConstant/globalVariable/Per_thread.h"
+
+/*
+
+    - Instance_counter<Tag> counts the objects made and destroyed, from any thread, without a
+      lock and without an instruction that locks the bus: the made and the destroyed counts
+      are two Per_thread counters (variableAndConstant/globalVariable/Per_thread.h), a slot
+      of 64 bytes for every thread that no other thread writes, a read, counts(), sums the
+      slots of all the threads. an object made on a thread and destroyed on another one is
+      made in the slot of the first, destroyed in the slot of the second, the sum is right.
+
+    - Instance_registry<Tag> keeps the address of every live object, for debugging: a table of
+      atomic pointers, open addressing, an insert takes the first free slot from the hash of
+      the address with a compare and swap, an erase puts a tombstone in it, nothing locks.
+      the table has capacity slots, an object that does not fit is not registered, dropped()
+      counts them. snapshot() is the objects of the moment it reads each slot, the ones made
+      or destroyed while it runs may or may not be in it.
+
+    - Counted<T> is the base of a T that is counted, by every constructor, the copy and the
+      move ones too, and by the destructor, a T does not have to remember to count, and
+      Counted<T, true> registers them too. an assignment does not change the count.
+
+*/
+struct Instance_counts
+{
+    std::int64_t made {0};
+    std::int64_t destroyed {0};
+
+    std::int64_t live() const { return this->made - this->destroyed; }
+};
+
+namespace detail_instance
+{
+    template <typename Tag>
+    struct Made;
+
+    template <typename Tag>
+    struct Destroyed;
+}
+
+template <typename Tag>
+class Instance_counter
+{
+private:
+    using Made = Per_thread<detail_instance::Made<Tag>, std::int64_t>;
+    using Destroyed = Per_thread<detail_instance::Destroyed<Tag>, std::int64_t>;
+
+public:
+    static void made_one() { Made::add(1); }
+    static void destroyed_one() { Destroyed::add(1); }
+
+    static Instance_counts counts() { return {Made::read(), Destroyed::read()}; }
+    static std::int64_t live() { return counts().live(); }
+};
+
+template <typename Tag>
+class Instance_registry
+{
+public:
+    static constexpr std::size_t capacity = std::size_t {1} << 16;
+
+private:
+    static inline const void* const tombstone = &capacity;
+
+    struct Table
+    {
+        std::unique_ptr<std::atomic<const void*>[]> slots {new std::atomic<const void*>[capacity]};
+        std::atomic<std::uint64_t> dropped {0};
+
+        Table()
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+                this->slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    static Table& table()
+    {
+        static Table* const table = new Table;
+        return *table;
+    }
+
+    static std::size_t home_of(const void* object)
+    {
+        const std::uint64_t hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(object)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(hash >> 48) & (capacity - 1);
+    }
+
+public:
+    static void insert(const void* object)
+    {
+        Table& t = table();
+        const std::size_t home = home_of(object);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            std::atomic<const void*>& slot = t.slots[(home + i) & (capacity - 1)];
+            const void* seen = slot.load(std::memory_order_relaxed);
+            while (seen == nullptr || seen == tombstone)
+                if (slot.compare_exchange_weak(seen, object, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+        }
+        t.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // a slot is never empty again once it was used, so an object is before the first empty one
+    static void erase(const void* object)
+    {
+        Table& t = table();
+        const std::size_t home = home_of(object);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            std::atomic<const void*>& slot = t.slots[(home + i) & (capacity - 1)];
+            const void* const seen = slot.load(std::memory_order_relaxed);
+            if (seen == object)
+            {
+                slot.store(tombstone, std::memory_order_relaxed);
+                return;
+            }
+            if (seen == nullptr)
+                return;
+        }
+    }
+
+    static std::vector<const void*> snapshot()
+    {
+        Table& t = table();
+        std::vector<const void*> objects;
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            const void* const seen = t.slots[i].load(std::memory_order_acquire);
+            if (seen != nullptr && seen != tombstone)
+                objects.push_back(seen);
+        }
+        return objects;
+    }
+
+    static std::uint64_t dropped() { return table().dropped.load(std::memory_order_relaxed); }
+};
+
+template <typename T, bool registered = false>
+class Counted
+{
+private:
+    void made() const
+    {
+        Instance_counter<T>::made_one();
+        if constexpr (registered)
+            Instance_registry<T>::insert(this);
+    }
+
+protected:
+    Counted() { this->made(); }
+    Counted(const Counted&) { this->made(); }
+    Counted(Counted&&) { this->made(); }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+
+    ~Counted()
+    {
+        if constexpr (registered)
+            Instance_registry<T>::erase(this);
+        Instance_counter<T>::destroyed_one();
+    }
+
+public:
+    static Instance_counts counts() { return Instance_counter<T>::counts(); }
+    static std::int64_t live_count() { return Instance_counter<T>::live(); }
+
+    // the live objects, for a debugger or a log, they can be destroyed while they are looked at
+    static std::vector<const T*> live_objects()
+    {
+        static_assert(registered, "the objects are registered by a Counted<T, true>");
+        std::vector<const T*> objects;
+        for (const void* object : Instance_registry<T>::snapshot())
+            objects.push_back(static_cast<const T*>(static_cast<const Counted*>(object)));
+        return objects;
+    }
+};
+
+#endif
@@ -1,9 +1,7 @@
 #include <iostream>
+#include <utility>
 #include "Player.h"
 
-// the best place is here to define the default value of an static variable
-int Player::player_count {0};
-
 Player::Player()
   : Player{"None", 0}
 {}
@@ -18,34 +16,22 @@ Player::Player(int h)
 
 Player::Player(std::string n, int h)
   : name{n}, health{h}
-{
-  increment_player_cout();
-}
+{}
 
 Player::Player(const Player &source)
+  : Counted{source}, name{source.name}, health{source.health}
 {}
 
 Player::Player(Player &&source)
+  : Counted{std::move(source)}, name{std::move(source.name)}, health{source.health}
 {}
 
 Player::~Player()
-{
-  decrement_player_cout();
-}
-
-void Player::increment_player_cout()
-{
-  ++player_count;
-}
-
-void Player::decrement_player_cout()
-{
-  --player_count;
-}
+{}
 
 int Player::get_player_count()
 {
-  return player_count;
+  return static_cast<int>(live_count());
 }
 
 void Player::display_player_count()
@@ -53,7 +39,7 @@ void Player::display_player_count()
   std::cout << Player::get_player_count() << std::endl;
 }
 
-std::string Player::get_name() const
+const std::string &Player::get_name() const
 {
   return name;
 }
@@ -2,11 +2,19 @@
 #define __PLAYER_H_
 
 #include <string>
+#include "Instance_counter.h"
 
-class Player
+// build with -DTRACK_PLAYERS to keep the address of every live Player too
+#if defined(TRACK_PLAYERS)
+inline constexpr bool player_registry = true;
+#else
+inline constexpr bool player_registry = false;
+#endif
+
+// the count is in Counted, every constructor adds one, from any thread
+class Player : public Counted<Player, player_registry>
 {
 private:
-  static int player_count;
   std::string name;
   int health;
 
@@ -19,12 +27,10 @@ public:
   Player(Player &&source);
   ~Player();
 
-  static void increment_player_cout();
-  static void decrement_player_cout();
   static int get_player_count();
   static void display_player_count();
 
-  std::string get_name() const;
+  const std::string &get_name() const;
   void set_name(std::string n);
 
   int get_health() const;
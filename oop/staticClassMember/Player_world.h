@@ -0,0 +1,333 @@
+#ifndef _PLAYER_WORLD_H_
+#define _PLAYER_WORLD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Player.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+    - a Player_world keeps players as entities, not objects: a Player_id is an index and a
+      generation, and every component is an array of its own, dense, with one element per live
+      player in the same order: the healths in an array of int, the positions in one of x and
+      one of y, and the names in one arena of chars, an offset and a length per player.
+
+    - the ids are a sparse set: sparse[index] is the place of the player in the dense arrays,
+      dense_ids[place] the id at a place. create() takes an index of the free list, or a new
+      one, and appends to the arrays, destroy() moves the last player into the place of the
+      one destroyed, both are O(1), and the generation of the index goes up, so an old id of
+      it is not valid anymore, an id that is not valid throws std::out_of_range.
+
+    - a name is a std::string_view into the arena, good until the next create, rename or
+      destroy. the names of the destroyed players are garbage in the arena, it is compacted
+      when the garbage is more than half of it.
+
+    - the bulk operations go over the dense arrays, 8 players at a time with AVX2:
+      damage_in_radius(x, y, radius, amount) takes amount from the health of every player at
+      most radius from (x, y), to 0 at least, and returns how many it hit, the version with
+      arrays of centres does all of them on a block of players at a time, destroy_dead()
+      destroys every player with no health left, heal_all(amount) adds to all of them.
+
+*/
+namespace detail_player_world
+{
+    // 3 arrays of 4096 players, 48 KB
+    inline constexpr std::size_t block = 4096;
+
+    // the players [begin, end) at most sqrt(r2) from (x, y) lose amount of health, to 0
+    inline std::size_t damage(const float* px, const float* py, int* health, std::size_t begin, std::size_t end,
+                              float x, float y, float r2, int amount)
+    {
+        std::size_t hit {0};
+        std::size_t i {begin};
+#if defined(__AVX2__)
+        const __m256 cx = _mm256_set1_ps(x);
+        const __m256 cy = _mm256_set1_ps(y);
+        const __m256 limit = _mm256_set1_ps(r2);
+        const __m256i loss = _mm256_set1_epi32(amount);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 8 <= end; i += 8)
+        {
+            const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(px + i), cx);
+            const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(py + i), cy);
+            const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const __m256 inside = _mm256_cmp_ps(d2, limit, _CMP_LE_OQ);
+            const int mask = _mm256_movemask_ps(inside);
+            if (mask == 0)
+                continue;
+            __m256i* const out = reinterpret_cast<__m256i*>(health + i);
+            const __m256i h = _mm256_loadu_si256(out);
+            const __m256i damaged = _mm256_max_epi32(_mm256_sub_epi32(h, loss), zero);
+            _mm256_storeu_si256(out, _mm256_blendv_epi8(h, damaged, _mm256_castps_si256(inside)));
+            hit += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            const float dx = px[i] - x;
+            const float dy = py[i] - y;
+            if (dx * dx + dy * dy <= r2)
+            {
+                health[i] = health[i] - amount > 0 ? health[i] - amount : 0;
+                ++hit;
+            }
+        }
+        return hit;
+    }
+}
+
+struct Player_id
+{
+    std::uint32_t index;
+    std::uint32_t generation;
+
+    bool operator==(const Player_id& rhs) const { return this->index == rhs.index && this->generation == rhs.generation; }
+    bool operator!=(const Player_id& rhs) const { return !(*this == rhs); }
+};
+
+class Player_world
+{
+private:
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    // by index
+    std::vector<std::uint32_t> sparse;
+    std::vector<std::uint32_t> generations;
+    std::vector<std::uint32_t> free_indices;
+
+    // by place
+    std::vector<std::uint32_t> dense_ids;
+    std::vector<int> healths;
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<std::uint32_t> name_offsets;
+    std::vector<std::uint32_t> name_lengths;
+
+    std::vector<char> arena;
+    std::size_t garbage {0};
+
+    std::uint32_t place_of(Player_id id) const
+    {
+        if (id.index >= this->sparse.size() || this->generations[id.index] != id.generation || this->sparse[id.index] == none)
+            throw std::out_of_range("The player is not in the world.");
+        return this->sparse[id.index];
+    }
+
+    void store_name(std::uint32_t place, std::string_view name)
+    {
+        if (this->arena.size() + name.size() > UINT32_MAX)
+            this->compact();
+        this->name_offsets[place] = static_cast<std::uint32_t>(this->arena.size());
+        this->name_lengths[place] = static_cast<std::uint32_t>(name.size());
+        this->arena.insert(this->arena.end(), name.begin(), name.end());
+    }
+
+    void compact()
+    {
+        std::vector<char> names;
+        names.reserve(this->arena.size() - this->garbage);
+        for (std::size_t place = 0; place < this->dense_ids.size(); ++place)
+        {
+            const char* const first = this->arena.data() + this->name_offsets[place];
+            this->name_offsets[place] = static_cast<std::uint32_t>(names.size());
+            names.insert(names.end(), first, first + this->name_lengths[place]);
+        }
+        this->arena.swap(names);
+        this->garbage = 0;
+    }
+
+    void maybe_compact()
+    {
+        if (this->garbage > this->arena.size() / 2 && this->garbage > 4096)
+            this->compact();
+    }
+
+    // the last player takes the place, place is the one of a player gone
+    void remove_place(std::uint32_t place)
+    {
+        const std::uint32_t index = this->dense_ids[place];
+        this->garbage += this->name_lengths[place];
+        const std::size_t last = this->dense_ids.size() - 1;
+        if (place != last)
+        {
+            this->dense_ids[place] = this->dense_ids[last];
+            this->healths[place] = this->healths[last];
+            this->xs[place] = this->xs[last];
+            this->ys[place] = this->ys[last];
+            this->name_offsets[place] = this->name_offsets[last];
+            this->name_lengths[place] = this->name_lengths[last];
+            this->sparse[this->dense_ids[place]] = place;
+        }
+        this->dense_ids.pop_back();
+        this->healths.pop_back();
+        this->xs.pop_back();
+        this->ys.pop_back();
+        this->name_offsets.pop_back();
+        this->name_lengths.pop_back();
+        this->sparse[index] = none;
+        ++this->generations[index];
+        this->free_indices.push_back(index);
+    }
+
+public:
+    Player_world() = default;
+
+    void reserve(std::size_t count)
+    {
+        this->dense_ids.reserve(count);
+        this->healths.reserve(count);
+        this->xs.reserve(count);
+        this->ys.reserve(count);
+        this->name_offsets.reserve(count);
+        this->name_lengths.reserve(count);
+        this->sparse.reserve(count);
+        this->generations.reserve(count);
+    }
+
+    Player_id create(std::string_view name = "None", int health = 0, float x = 0, float y = 0)
+    {
+        if (this->dense_ids.size() >= none)
+            throw std::length_error("The world is full.");
+        std::uint32_t index;
+        if (!this->free_indices.empty())
+        {
+            index = this->free_indices.back();
+            this->free_indices.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(this->sparse.size());
+            this->sparse.push_back(none);
+            this->generations.push_back(0);
+        }
+        const std::uint32_t place = static_cast<std::uint32_t>(this->dense_ids.size());
+        this->dense_ids.push_back(index);
+        this->healths.push_back(health);
+        this->xs.push_back(x);
+        this->ys.push_back(y);
+        this->name_offsets.push_back(0);
+        this->name_lengths.push_back(0);
+        this->store_name(place, name);
+        this->sparse[index] = place;
+        return Player_id {index, this->generations[index]};
+    }
+
+    Player_id create(const Player& player, float x = 0, float y = 0)
+    {
+        return this->create(player.get_name(), player.get_health(), x, y);
+    }
+
+    void destroy(Player_id id)
+    {
+        this->remove_place(this->place_of(id));
+        this->maybe_compact();
+    }
+
+    bool contains(Player_id id) const
+    {
+        return id.index < this->sparse.size() && this->generations[id.index] == id.generation && this->sparse[id.index] != none;
+    }
+
+    std::size_t size() const { return this->dense_ids.size(); }
+
+    int& health(Player_id id) { return this->healths[this->place_of(id)]; }
+    int health(Player_id id) const { return this->healths[this->place_of(id)]; }
+
+    float x(Player_id id) const { return this->xs[this->place_of(id)]; }
+    float y(Player_id id) const { return this->ys[this->place_of(id)]; }
+
+    void move_to(Player_id id, float x, float y)
+    {
+        const std::uint32_t place = this->place_of(id);
+        this->xs[place] = x;
+        this->ys[place] = y;
+    }
+
+    std::string_view name(Player_id id) const
+    {
+        const std::uint32_t place = this->place_of(id);
+        return std::string_view {this->arena.data() + this->name_offsets[place], this->name_lengths[place]};
+    }
+
+    void rename(Player_id id, std::string_view name)
+    {
+        const std::uint32_t place = this->place_of(id);
+        this->garbage += this->name_lengths[place];
+        this->name_lengths[place] = 0;
+        this->store_name(place, name);
+        this->maybe_compact();
+    }
+
+    Player to_player(Player_id id) const
+    {
+        return Player {std::string {this->name(id)}, this->health(id)};
+    }
+
+    // the dense arrays, for other loops over all the players
+    std::vector<Player_id> ids() const
+    {
+        std::vector<Player_id> result;
+        result.reserve(this->dense_ids.size());
+        for (std::uint32_t index : this->dense_ids)
+            result.push_back(Player_id {index, this->generations[index]});
+        return result;
+    }
+
+    int* health_data() { return this->healths.data(); }
+    const float* x_data() const { return this->xs.data(); }
+    const float* y_data() const { return this->ys.data(); }
+
+    std::size_t damage_in_radius(float x, float y, float radius, int amount)
+    {
+        return detail_player_world::damage(this->xs.data(), this->ys.data(), this->healths.data(),
+                                           0, this->dense_ids.size(), x, y, radius * radius, amount);
+    }
+
+    // one damage per centre, in the order of the centres, all of them on a block of players
+    // before the next one, the block stays in the L1 cache instead of a pass over all the
+    // players per centre
+    std::size_t damage_in_radius(const float* x, const float* y, std::size_t count, float radius, int amount)
+    {
+        const std::size_t n = this->dense_ids.size();
+        std::size_t hit {0};
+        for (std::size_t begin = 0; begin < n; begin += detail_player_world::block)
+        {
+            const std::size_t end = begin + detail_player_world::block < n ? begin + detail_player_world::block : n;
+            for (std::size_t c = 0; c < count; ++c)
+                hit += detail_player_world::damage(this->xs.data(), this->ys.data(), this->healths.data(),
+                                                   begin, end, x[c], y[c], radius * radius, amount);
+        }
+        return hit;
+    }
+
+    void heal_all(int amount)
+    {
+        // the compiler vectorizes it, one add per 8 players with AVX2
+        for (int& h : this->healths)
+            h += amount;
+    }
+
+    std::size_t destroy_dead()
+    {
+        std::size_t destroyed {0};
+        // from the end, the player that moves into a place was looked at already
+        for (std::size_t place = this->dense_ids.size(); place-- > 0;)
+            if (this->healths[place] <= 0)
+            {
+                this->remove_place(static_cast<std::uint32_t>(place));
+                ++destroyed;
+            }
+        this->maybe_compact();
+        return destroyed;
+    }
+};
+
+#endif
@@ -10,10 +10,19 @@
 
   - the static method can only access to the static attrs
 
+  - a static int that the constructors change is a data race when objects are made on several
+    threads, and a copy or a move constructor that does not change it makes the count wrong,
+    Player counts itself with Counted of Instance_counter.h, a counter per thread, summed when
+    it is read, see there. build it with -pthread.
+
 */
 
 #include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "Player.h"
+#include "Player_world.h"
 
 int main()
 {
@@ -34,5 +43,28 @@ int main()
   delete player4;
   Player::display_player_count();
 
+  Player player5 {player2}; // the copy is counted
+  Player player6 {std::move(player5)}; // the move too
+  Player::display_player_count();
+
+  std::vector<std::thread> threads;
+  for (int i {0}; i < 4; i++)
+    threads.emplace_back([] {
+      std::vector<Player> players(1000);
+    });
+  for (std::thread &thread : threads)
+    thread.join();
+  Player::display_player_count();
+
+  // the players of a game as arrays of components, see Player_world.h
+  Player_world world;
+  Player_id frank {world.create(Player{"Frank", 100}, 0.0f, 0.0f)};
+  Player_id hero {world.create("Hero", 30, 1.0f, 1.0f)};
+  world.create("Villain", 100, 10.0f, 10.0f);
+  std::cout << "Hit: " << world.damage_in_radius(0.0f, 0.0f, 2.0f, 50) << std::endl; // 2
+  std::cout << world.name(frank) << ": " << world.health(frank) << std::endl; // 50
+  std::cout << "Destroyed: " << world.destroy_dead() << std::endl; // 1, the hero
+  std::cout << "Hero in the world: " << std::boolalpha << world.contains(hero) << std::endl;
+
   return 0;
 }
@@ -0,0 +1,143 @@
+/*
+
+    - one tick of a simulation of players: a damage in a radius around 64 points, and the dead
+      ones removed, on a std::vector of the name and the health of a Player with a position
+      next to them, a Player can not be assigned to for std::remove_if, against the
+      Player_world of ../staticClassMember/Player_world.h, a pass over the players per blast
+      and all the blasts on a block of players at a time, in ms per tick, with the players
+      left, the same for all, and the ticks a second that makes, 60 is the goal.
+
+    - build it with:
+        g++ -std=c++17 -O2 -march=native -pthread index.cpp ../staticClassMember/Player.cpp
+      without -mavx2 or -march=native the loops of Player_world are the ones the compiler
+      vectorizes.
+
+    - 1'000'000 players by default, the number can be given on the command line, e.g.
+      ./a.out 100000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../staticClassMember/Player.h"
+#include "../staticClassMember/Player_world.h"
+
+constexpr int ticks {10};
+constexpr int blasts {64};
+constexpr float radius {2.0f};
+constexpr int damage {25};
+
+struct Positioned_player
+{
+    std::string name;
+    int health;
+    float x;
+    float y;
+};
+
+struct Blast
+{
+    float x;
+    float y;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const std::string& name, double seconds, std::size_t left)
+{
+    const double ms = seconds * 1e3 / ticks;
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << ms << std::setw(12) << left
+        << std::setw(12) << std::setprecision(1) << 1e3 / ms << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1'000'000;
+
+    // the players on a square where 64 blasts of radius 2 hit a few percents of them a tick
+    const float side = std::sqrt(static_cast<float>(n)) / 4;
+    std::mt19937 gen {42};
+    std::uniform_real_distribution<float> coordinate {0, side};
+    std::uniform_int_distribution<int> health {1, 100};
+    std::vector<Positioned_player> players;
+    Player_world world;
+    players.reserve(n);
+    world.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float x = coordinate(gen);
+        const float y = coordinate(gen);
+        const int h = health(gen);
+        const Player player {"Player " + std::to_string(i), h};
+        players.push_back(Positioned_player {player.get_name(), player.get_health(), x, y});
+        world.create(player, x, y);
+    }
+    std::vector<Blast> plan(ticks * blasts);
+    for (Blast& blast : plan)
+        blast = Blast {coordinate(gen), coordinate(gen)};
+
+    Player_world blocked {world};
+
+    std::cout << std::setw(36) << std::left << "ms per tick" << std::setw(10) << std::right << ""
+        << std::setw(12) << "left" << std::setw(12) << "ticks/s" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        for (int b = 0; b < blasts; ++b)
+        {
+            const Blast& blast = plan[tick * blasts + b];
+            for (Positioned_player& p : players)
+            {
+                const float dx = p.x - blast.x;
+                const float dy = p.y - blast.y;
+                if (dx * dx + dy * dy <= radius * radius)
+                    p.health = std::max(p.health - damage, 0);
+            }
+        }
+        players.erase(std::remove_if(players.begin(), players.end(),
+                                     [](const Positioned_player& p) { return p.health <= 0; }),
+                      players.end());
+    }
+    report("std::vector<Player>", seconds_since(start), players.size());
+
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        for (int b = 0; b < blasts; ++b)
+        {
+            const Blast& blast = plan[tick * blasts + b];
+            world.damage_in_radius(blast.x, blast.y, radius, damage);
+        }
+        world.destroy_dead();
+    }
+    report("Player_world", seconds_since(start), world.size());
+
+    std::vector<float> xs(plan.size());
+    std::vector<float> ys(plan.size());
+    for (std::size_t i = 0; i < plan.size(); ++i)
+    {
+        xs[i] = plan[i].x;
+        ys[i] = plan[i].y;
+    }
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        blocked.damage_in_radius(xs.data() + tick * blasts, ys.data() + tick * blasts, blasts, radius, damage);
+        blocked.destroy_dead();
+    }
+    report("Player_world, all blasts a block", seconds_since(start), blocked.size());
+
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 #include "String.h"
+#include "String_stats.h"
 
 int main()
 {
@@ -52,5 +53,12 @@ int main()
   for (const String &str: vec)
     str.display();
 
+  std::cout << "heap allocations: " << String::get_heap_allocations() << std::endl;
+
+#ifdef STRING_STATS
+  // g++ -DSTRING_STATS *.cpp, shows what every String operation cost
+  String_stats::report(std::cout);
+#endif
+
   return 0;
 }
@@ -1,96 +1,147 @@
 #include <cstring>
 #include <iostream>
 #include "String.h"
+#include "String_stats.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+
+// counts every buffer taken from the heap, short strings never add to it
+std::size_t String::heap_allocations {0};
 
 String::String()
-  : str{nullptr}
+  : str{small}
 {
-  this->str = new char[1];
-  *this->str = '\0';
+  STRING_STATS_SCOPE(Construct);
+  *this->small = '\0';
   std::cout << "String created with address " << this << " and the str pointer contains '" << this->str << "'." << std::endl;
 }
 
 String::String(const char *const str)
-  : str{nullptr}
+  : str{small}
 {
-  if (str == nullptr) {
-    this->str = new char[1];
-    *this->str = '\0';
-  } else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
-  }
+  STRING_STATS_SCOPE(Construct);
+  *this->small = '\0';
+  this->assign(str);
   std::cout << "String created with address " << this << " and the str pointer contains '" << this->str << "'." << std::endl;
 }
 
+// not delegating to String(const char *), so the instrumentation sees a copy
 String::String(const String &source)
-  : String{source.str}
-{}
+  : str{small}
+{
+  STRING_STATS_SCOPE(Copy_construct);
+  *this->small = '\0';
+  this->assign(source.str);
+  std::cout << "String created with address " << this << " and the str pointer contains '" << this->str << "'." << std::endl;
+}
 
-String::String(String &&source)
-  : str{source.str}
+String::String(String &&source) noexcept
+  : str{small}
 {
-  source.str = nullptr;
+  STRING_STATS_SCOPE(Move_construct);
+  *this->small = '\0';
+  this->take(source);
 }
 
 // assignment operator overloading (copy assignment) 
 // deep copy becuase a pointer exist in the class.
 String &String::operator=(const String &source)
 {
+  STRING_STATS_SCOPE(Copy_assign);
+
   // check if the source is the current
   if (this == &source)
     return *this;
 
-  // release the allocated memory
+  // release the allocated memory, allocate a new space if the inline buffer is too small
   std::cout << "String with address " << this << " which contains '" << this->str << "' is deallocating..." << std::endl;
-  delete[] this->str;
-  std::cout << "Deallocated." << std::endl;
-
-  // allocate a new space
-  this->str = new char[std::strlen(source.str) + 1];
-  std::strcpy(this->str, source.str);
+  this->assign(source.str);
   std::cout << "A new allocation is done." << std::endl;
 
   return *this;
 }
 
 // assignment operator overloading (move assignment)
-String &String::operator=(String &&source)
+String &String::operator=(String &&source) noexcept
 {
+  STRING_STATS_SCOPE(Move_assign);
+
   // check if the source is the current
   if (this == &source)
     return *this;
 
-  // release the allocated memory
+  // release the allocated memory, then point to the source str on heap.
+  // a short str lives inside the source object so it is copied instead.
   std::cout << "String with address " << this << " which contains '" << this->str << "' is deallocating..." << std::endl;
-  delete[] this->str;
-  std::cout << "Deallocated." << std::endl;
+  std::cout << "Taking over the str of the temp object..." << std::endl;
+  this->take(source);
+  std::cout << "Taken." << std::endl;
 
-  // pointing to the source str on heap
-  std::cout << "Pointing to the new space on heap by the temp object..." << std::endl;
-  this->str = source.str;
-  std::cout << "Pointed." << std::endl;
-
-  // null out the source. this part is really important.
-  // if you don't this, at destructor, the allocated heap will be destory.
+  // take() leaves the source pointing to its own empty inline buffer. this part is really important.
+  // if the source kept the heap pointer, at destructor, the allocated heap would be destroyed.
   // also see the destructor method.
-  std::cout << "Nulling out the source pointer..." << std::endl;
-  source.str = nullptr;
-  std::cout << "Nulled out." << std::endl;
 
   return *this;
 }
 
 String::~String()
 {
-  delete[] this->str;
+  STRING_STATS_SCOPE(Destroy);
+  bool empty = *this->str == '\0';
+  this->release();
   
-  if (this->str == nullptr)
-    std::cout << "String destroyed for the str pointer which is nullptr." << std::endl;
+  if (empty)
+    std::cout << "String destroyed for the str pointer which is empty." << std::endl;
   else
     std::cout << "String destroyed with address " << this << "." << std::endl;
 }
 
+// drops the current text and returns a buffer with room for length characters and the '\0'
+char *String::allocate(std::size_t length)
+{
+  this->release();
+  if (length > small_capacity) {
+    this->str = new char[length + 1];
+    heap_allocations++;
+    STRING_STATS_COUNT(allocations, 1);
+    STRING_STATS_COUNT(bytes, length + 1);
+  }
+  return this->str;
+}
+
+void String::assign(const char *source)
+{
+  if (source == nullptr)
+    source = "";
+
+  std::size_t length = str_len(source);
+  std::memcpy(this->allocate(length), source, length + 1);
+  STRING_STATS_COUNT(strlens, 1);
+  STRING_STATS_COUNT(copies, 1);
+}
+
+void String::release()
+{
+  if (this->str != this->small)
+    delete[] this->str;
+  this->str = this->small;
+  *this->small = '\0';
+}
+
+// a heap buffer is moved over, an inline one has to be copied, the source is left empty
+void String::take(String &source)
+{
+  if (source.str == source.small)
+    this->assign(source.small);
+  else {
+    this->release();
+    this->str = source.str;
+    STRING_STATS_COUNT(moves, 1);
+  }
+
+  source.str = source.small;
+  *source.small = '\0';
+}
+
 void String::display() const
 {
   std::cout << this->get_length() << " " << this->get_str() << std::endl;
@@ -98,10 +149,17 @@ void String::display() const
 
 int String::get_length() const
 {
-  return std::strlen(this->str);
+  STRING_STATS_SCOPE(Get_length);
+  STRING_STATS_COUNT(strlens, 1);
+  return str_len(this->str);
 }
 
 const char *String::get_str() const
 {
   return this->str;
 }
+
+std::size_t String::get_heap_allocations()
+{
+  return heap_allocations;
+}
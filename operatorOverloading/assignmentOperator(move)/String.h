@@ -1,27 +1,41 @@
 #ifndef _STRING_H_
 #define _STRING_H_
 
+#include <cstddef>
+
 class String
 {
 private:
+  // strings up to small_capacity characters live in the object itself, longer ones on the heap
+  static constexpr std::size_t small_capacity = 23;
+  static std::size_t heap_allocations;
+
   char *str;
+  char small[small_capacity + 1];
+
+  char *allocate(std::size_t length);
+  void assign(const char *source);
+  void release();
+  void take(String &source);
 
 public:
   String();
   String(const char *const str);
   String(const String &source);
-  String(String &&source);
+  String(String &&source) noexcept;
   ~String();
 
   // assignment operator overloading (copy)
   String &operator=(const String &source);
 
   // assignment operator overloading (move)
-  String &operator=(String &&source);
+  String &operator=(String &&source) noexcept;
   
   void display() const;
   int get_length() const;
   const char *get_str() const;
+
+  static std::size_t get_heap_allocations();
 };
 
 #endif
@@ -0,0 +1,126 @@
+#ifndef _STRING_STATS_H_
+#define _STRING_STATS_H_
+
+/*
+
+  - allocation instrumentation for String, compiled in only with -DSTRING_STATS.
+
+  - every public String operation opens a scope, the allocations, allocated bytes,
+    copies of the text, moves of a heap buffer and strlen calls inside it are counted
+    for that operation. the copy constructor does its own assign() instead of
+    delegating to the const char * one, so a copy is counted as a copy. a public
+    operation called inside another one would be counted for the outer one.
+
+  - without STRING_STATS the macros expand to nothing, so the class is exactly what
+    it was without instrumentation.
+
+  - String_stats::report(std::cout) prints a table, String_stats::reset() zeroes it.
+
+*/
+
+#ifdef STRING_STATS
+
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+
+namespace String_stats
+{
+  enum class Op
+  {
+    Construct,
+    Copy_construct,
+    Move_construct,
+    Copy_assign,
+    Move_assign,
+    Destroy,
+    Get_length,
+    Count
+  };
+
+  struct Counters
+  {
+    std::size_t calls;
+    std::size_t allocations;
+    std::size_t bytes;
+    std::size_t copies;
+    std::size_t moves;
+    std::size_t strlens;
+  };
+
+  constexpr std::size_t num_ops = static_cast<std::size_t>(Op::Count);
+
+  constexpr const char *op_names[num_ops] {
+    "construct", "copy construct", "move construct", "copy assign", "move assign", "destroy", "get_length"
+  };
+
+  inline Counters counters[num_ops] {};
+
+  // the outermost operation in progress, Op::Count when there is none
+  inline thread_local Op current {Op::Count};
+
+  class Scope
+  {
+  private:
+    Op previous;
+
+  public:
+    explicit Scope(Op op)
+      : previous{current}
+    {
+      if (current == Op::Count)
+        current = op;
+      counters[static_cast<std::size_t>(current)].calls++;
+    }
+
+    ~Scope()
+    {
+      current = previous;
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+
+  inline void count(std::size_t Counters::*field, std::size_t n)
+  {
+    // a member helper that runs outside any public operation is not counted
+    if (current != Op::Count)
+      counters[static_cast<std::size_t>(current)].*field += n;
+  }
+
+  inline void reset()
+  {
+    for (Counters &counter : counters)
+      counter = Counters{};
+  }
+
+  inline void report(std::ostream &os)
+  {
+    os << std::left << std::setw(16) << "operation" << std::right
+       << std::setw(8) << "calls" << std::setw(8) << "allocs" << std::setw(8) << "bytes"
+       << std::setw(8) << "copies" << std::setw(8) << "moves" << std::setw(8) << "strlen" << std::endl;
+
+    for (std::size_t i = 0; i < num_ops; ++i) {
+      const Counters &counter = counters[i];
+      if (counter.calls == 0)
+        continue;
+
+      os << std::left << std::setw(16) << op_names[i] << std::right
+         << std::setw(8) << counter.calls << std::setw(8) << counter.allocations << std::setw(8) << counter.bytes
+         << std::setw(8) << counter.copies << std::setw(8) << counter.moves << std::setw(8) << counter.strlens << std::endl;
+    }
+  }
+}
+
+#define STRING_STATS_SCOPE(op) String_stats::Scope string_stats_scope {String_stats::Op::op}
+#define STRING_STATS_COUNT(field, n) String_stats::count(&String_stats::Counters::field, (n))
+
+#else
+
+#define STRING_STATS_SCOPE(op)
+#define STRING_STATS_COUNT(field, n)
+
+#endif
+
+#endif
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include "String.h"
+#include "String_stats.h"
 
 int main()
 {
@@ -32,8 +33,8 @@ int main()
   // then it will use move assignment operator if you have provided it to 
   // move the heap resource from temp object to the str2.
   // after the move assignment operator then the destructor method will call for the temp object.
-  // it's important to null out the temp object pointer
-  // becuase at destructoring the temp object will be check if the pointer is nullptr.
+  // it's important to empty the temp object
+  // becuase at destructoring the temp object must not free the moved heap resource.
   str2 = "This is a test."; // str2.operator=("This is a test.");
   
   String str3;
@@ -62,5 +63,12 @@ int main()
   for (const String &str: vec)
     str.display();
 
+  std::cout << "heap allocations: " << String::get_heap_allocations() << std::endl;
+
+#ifdef STRING_STATS
+  // g++ -DSTRING_STATS *.cpp, shows what every String operation cost
+  String_stats::report(std::cout);
+#endif
+
   return 0;
 }
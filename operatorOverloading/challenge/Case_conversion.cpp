@@ -0,0 +1,143 @@
+#include <cctype>
+#include "Case_conversion.h"
+#include "../../tooling/cpuDispatch/Cpu_dispatch.h"
+
+#if defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#elif defined(CPU_DISPATCH_NEON)
+#include <arm_neon.h>
+#endif
+
+static void convert_scalar(char *str, std::size_t length, bool upper)
+{
+  for (std::size_t i {0}; i < length; i++) {
+    unsigned char c = str[i];
+    str[i] = static_cast<char>(upper ? std::toupper(c) : std::tolower(c));
+  }
+}
+
+/*
+
+  - a byte is in the range [first, last] when it is greater than first - 1 and
+    less than last + 1, signed compares are fine because ASCII bytes are below 0x80.
+
+  - converting is flipping the 0x20 bit of the letters of the other case.
+
+  - every version is compiled and the one of the cpu is chosen at the first call, see
+    tooling/cpuDispatch/Cpu_dispatch.h, AVX-512 leaves the tail to AVX2, the others to the
+    scalar loop, not to the SSE2 one, a call of it from AVX code is a transition.
+
+*/
+#if defined(CPU_DISPATCH_X86)
+CPU_DISPATCH_SSE2 static void convert_sse2(char *str, std::size_t length, bool upper)
+{
+  const char first = upper ? 'a' : 'A';
+  const char last = upper ? 'z' : 'Z';
+  const __m128i below = _mm_set1_epi8(first - 1);
+  const __m128i above = _mm_set1_epi8(last + 1);
+  const __m128i flip = _mm_set1_epi8(0x20);
+  std::size_t i {0};
+
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      convert_scalar(str + i, 16, upper);
+      continue;
+    }
+    __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+    v = _mm_xor_si128(v, _mm_and_si128(letters, flip));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(str + i), v);
+  }
+  convert_scalar(str + i, length - i, upper);
+}
+
+CPU_DISPATCH_AVX2 static void convert_avx2(char *str, std::size_t length, bool upper)
+{
+  const char first = upper ? 'a' : 'A';
+  const char last = upper ? 'z' : 'Z';
+  const __m256i below = _mm256_set1_epi8(first - 1);
+  const __m256i above = _mm256_set1_epi8(last + 1);
+  const __m256i flip = _mm256_set1_epi8(0x20);
+  std::size_t i {0};
+
+  for (; i + 32 <= length; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+    if (_mm256_movemask_epi8(v) != 0) {
+      convert_scalar(str + i, 32, upper);
+      continue;
+    }
+    __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(v, below), _mm256_cmpgt_epi8(above, v));
+    v = _mm256_xor_si256(v, _mm256_and_si256(letters, flip));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(str + i), v);
+  }
+  convert_scalar(str + i, length - i, upper);
+}
+
+// the letters are a mask, the flip of the ones in it
+CPU_DISPATCH_AVX512 static void convert_avx512(char *str, std::size_t length, bool upper)
+{
+  const char first = upper ? 'a' : 'A';
+  const char last = upper ? 'z' : 'Z';
+  const __m512i below = _mm512_set1_epi8(first - 1);
+  const __m512i above = _mm512_set1_epi8(last + 1);
+  const __m512i flip = _mm512_set1_epi8(0x20);
+  std::size_t i {0};
+
+  for (; i + 64 <= length; i += 64) {
+    __m512i v = _mm512_loadu_si512(str + i);
+    if (_mm512_movepi8_mask(v) != 0) {
+      convert_scalar(str + i, 64, upper);
+      continue;
+    }
+    const __mmask64 letters = _mm512_cmpgt_epi8_mask(v, below) & _mm512_cmpgt_epi8_mask(above, v);
+    v = _mm512_xor_si512(v, _mm512_maskz_mov_epi8(letters, flip));
+    _mm512_storeu_si512(str + i, v);
+  }
+  convert_avx2(str + i, length - i, upper);
+}
+#endif
+
+#if defined(CPU_DISPATCH_NEON)
+static void convert_neon(char *str, std::size_t length, bool upper)
+{
+  const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(upper ? 'a' : 'A'));
+  const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(upper ? 'z' : 'Z'));
+  const uint8x16_t flip = vdupq_n_u8(0x20);
+  const uint8x16_t high = vdupq_n_u8(0x80);
+  std::size_t i {0};
+
+  for (; i + 16 <= length; i += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(str + i));
+    if (vmaxvq_u8(vandq_u8(v, high)) != 0) {
+      convert_scalar(str + i, 16, upper);
+      continue;
+    }
+    uint8x16_t letters = vandq_u8(vcgeq_u8(v, first), vcleq_u8(v, last));
+    v = veorq_u8(v, vandq_u8(letters, flip));
+    vst1q_u8(reinterpret_cast<uint8_t*>(str + i), v);
+  }
+  convert_scalar(str + i, length - i, upper);
+}
+#endif
+
+static const cpu_dispatch::Dispatch<void(char*, std::size_t, bool)> convert {
+  {cpu_dispatch::Isa::scalar, convert_scalar},
+#if defined(CPU_DISPATCH_X86)
+  {cpu_dispatch::Isa::sse2, convert_sse2},
+  {cpu_dispatch::Isa::avx2, convert_avx2},
+  {cpu_dispatch::Isa::avx512, convert_avx512},
+#endif
+#if defined(CPU_DISPATCH_NEON)
+  {cpu_dispatch::Isa::neon, convert_neon},
+#endif
+};
+
+void to_upper(char *str, std::size_t length)
+{
+  convert(str, length, true);
+}
+
+void to_lower(char *str, std::size_t length)
+{
+  convert(str, length, false);
+}
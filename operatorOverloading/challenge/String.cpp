@@ -1,42 +1,37 @@
 #include <iostream>
-#include <cctype>
 #include <cstring>
+#include "Case_conversion.h"
 #include "String.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+
+// counts every buffer taken from the heap, short strings never add to it
+std::size_t String::heap_allocations {0};
 
 String::String()
-  : str{nullptr}
+  : str{small}
 {
-  this->str = new char[1];
-  *this->str = '\0';
+  *this->small = '\0';
 }
 
 String::String(const char *const str)
-  : str{nullptr}
+  : String{}
 {
-  if (str == nullptr)
-    String();
-  else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
-  }
+  this->assign(str);
 }
 
 String::String(const String &source)
   : String{source.str}
 {}
 
-String::String(String &&source)
-  : str{source.str}
+String::String(String &&source) noexcept
+  : String{}
 {
-  source.str = nullptr;
+  this->take(source);
 }
 
 String::~String()
 {
-  if (this->str == nullptr) {}
-  else {}
-
-  delete[] this->str;
+  this->release();
 }
 
 String &String::operator=(const String &obj)
@@ -44,52 +39,91 @@ String &String::operator=(const String &obj)
   if (this == &obj)
     return *this;
   
-  delete[] this->str;
-  this->str = new char[std::strlen(obj.str) + 1];
-  std::strcpy(this->str, obj.str);
+  this->assign(obj.str);
   return *this;
 }
 
-String &String::operator=(String &&obj)
+String &String::operator=(String &&obj) noexcept
 {
   if (this == &obj)
     return *this;
   
-  delete[] this->str;
-  this->str = obj.str;
-  obj.str = nullptr;
+  this->take(obj);
   return *this;
 }
 
+// drops the current text and returns a buffer with room for length characters and the '\0'
+char *String::allocate(std::size_t length)
+{
+  this->release();
+  if (length > small_capacity) {
+    this->str = new char[length + 1];
+    heap_allocations++;
+  }
+  return this->str;
+}
+
+void String::assign(const char *source)
+{
+  if (source == nullptr)
+    source = "";
+
+  std::size_t length = str_len(source);
+  std::memcpy(this->allocate(length), source, length + 1);
+}
+
+void String::release()
+{
+  if (this->str != this->small)
+    delete[] this->str;
+  this->str = this->small;
+  *this->small = '\0';
+}
+
+// a heap buffer is moved over, an inline one has to be copied, the source is left empty
+void String::take(String &source)
+{
+  if (source.str == source.small)
+    this->assign(source.small);
+  else {
+    this->release();
+    this->str = source.str;
+  }
+
+  source.str = source.small;
+  *source.small = '\0';
+}
+
+std::size_t String::get_heap_allocations()
+{
+  return heap_allocations;
+}
+
 String String::operator-() const
 {
-  char *buff = new char[std::strlen(this->str) + 1];
-  std::strcpy(buff, this->str);
-  for (size_t i {0}; i < std::strlen(buff); i++)
-    buff[i] = std::tolower(buff[i]);
-  String temp {buff};
-  delete[] buff;
+  String temp {this->str};
+  to_lower(temp.str, str_len(temp.str));
   return temp;
 }
 
 bool String::operator==(const String &obj) const
 {
-  return std::strcmp(this->str, obj.str) == 0;
+  return str_compare(this->str, obj.str) == 0;
 }
 
 bool String::operator!=(const String &obj) const
 {
-  return std::strcmp(this->str, obj.str) != 0;
+  return str_compare(this->str, obj.str) != 0;
 }
 
 bool String::operator>(const String &obj) const
 {
-  return std::strcmp(this->str, obj.str) > 0;
+  return str_compare(this->str, obj.str) > 0;
 }
 
 bool String::operator<(const String &obj) const
 {
-  return std::strcmp(this->str, obj.str) < 0;
+  return str_compare(this->str, obj.str) < 0;
 }
 
 String &String::operator++()
@@ -97,8 +131,7 @@ String &String::operator++()
   if (this->str == nullptr)
     return *this;
 
-  for (size_t i {0}; i < std::strlen(this->str); i++)
-    this->str[i] = std::toupper(this->str[i]);
+  to_upper(this->str, str_len(this->str));
 
   return *this;
 }
@@ -115,8 +148,7 @@ String &String::operator--()
   if (this->str == nullptr)
     return *this;
 
-  for (size_t i {0}; i < std::strlen(this->str); i++)
-    this->str[i] = std::tolower(this->str[i]);
+  to_lower(this->str, str_len(this->str));
 
   return *this;
 }
@@ -130,11 +162,11 @@ String String::operator--(int)
 
 String String::operator+(const String &rhs) const
 {
-  char *buff = new char[std::strlen(this->str) + std::strlen(rhs.str) + 1];
-  std::strcpy(buff, this->str);
-  std::strcat(buff, rhs.str);
-  String temp {buff};
-  delete[] buff;
+  String temp;
+  const std::size_t length = str_len(this->str);
+  const std::size_t rhs_length = str_len(rhs.str);
+  char *buff = temp.allocate(length + rhs_length);
+  str_copy_n(str_copy_n(buff, this->str, length), rhs.str, rhs_length);
   return temp;
 }
 
@@ -159,14 +191,17 @@ String String::operator*(int num) const
     return temp;
   
   */  
-  char *buff = new char[(std::strlen(this->str) * num) + 1];
-  std::strcpy(buff, "");
+  String temp;
+  if (num <= 0)
+    return temp;
+
+  // every copy goes at the end of the one before, a strcat per copy walked all of them again
+  const std::size_t length = str_len(this->str);
+  char *end = temp.allocate(length * num);
 
   for (int i {0}; i < num; i++)
-    std::strcat(buff, this->str);
+    end = str_copy_n(end, this->str, length);
 
-  String temp {buff};
-  delete[] buff;
   return temp;
 }
 
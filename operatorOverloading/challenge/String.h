@@ -1,20 +1,32 @@
 #ifndef _STRING_H_
 #define _STRING_H_
 
+#include <cstddef>
+
 class String
 {
 private:
+  // strings up to small_capacity characters live in the object itself, longer ones on the heap
+  static constexpr std::size_t small_capacity = 23;
+  static std::size_t heap_allocations;
+
   char *str;
+  char small[small_capacity + 1];
+
+  char *allocate(std::size_t length);
+  void assign(const char *source);
+  void release();
+  void take(String &source);
 
 public:
   String();
   String(const char *const str);
   String(const String &source);
-  String(String &&source);
+  String(String &&source) noexcept;
   ~String();
 
   String &operator=(const String &obj);
-  String &operator=(String &&obj);
+  String &operator=(String &&obj) noexcept;
   String operator-() const;
   bool operator==(const String &rhs) const;
   bool operator!=(const String &rhs) const;
@@ -30,6 +42,8 @@ public:
   String &operator*=(int num);
 
   void display();
+
+  static std::size_t get_heap_allocations();
 };
 
 #endif
\ No newline at end of file
@@ -60,5 +60,11 @@ int main()
     str2.display();
   */
 
+  String short_result = str1 + " from world.";
+  String long_result = short_result * 3;
+  short_result.display();
+  long_result.display();
+  std::cout << "heap allocations: " << String::get_heap_allocations() << std::endl;
+
   return 0;
 }
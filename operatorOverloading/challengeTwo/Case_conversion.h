@@ -0,0 +1,19 @@
+#ifndef _CASE_CONVERSION_H_
+#define _CASE_CONVERSION_H_
+
+#include <cstddef>
+
+/*
+
+  - convert length characters of str in place.
+
+  - plain ASCII is converted 64 (AVX-512), 32 (AVX2) or 16 (SSE2, NEON) bytes per step without
+    going through the locale (NEON on AArch64 only), a block that holds any non-ASCII byte falls back to
+    std::toupper / std::tolower one character at a time. the widest the cpu has is chosen at run
+    time, BASICS_ISA or cpu_dispatch::force picks another.
+
+*/
+void to_upper(char *str, std::size_t length);
+void to_lower(char *str, std::size_t length);
+
+#endif
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include "Case_conversion.h"
+#include "Shared_string.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+
+Shared_string::Buffer *Shared_string::create(std::size_t capacity)
+{
+  void *memory = ::operator new(sizeof(Buffer) + capacity + 1);
+  Buffer *buffer = new (memory) Buffer;
+  buffer->refs.store(1, std::memory_order_relaxed);
+  buffer->length = 0;
+  buffer->capacity = capacity;
+  *buffer->data() = '\0';
+  return buffer;
+}
+
+void Shared_string::retain(Buffer *buffer)
+{
+  if (buffer != nullptr)
+    buffer->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Shared_string::release(Buffer *buffer)
+{
+  if (buffer != nullptr && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    buffer->~Buffer();
+    ::operator delete(buffer);
+  }
+}
+
+// returns a buffer only this object uses, with room for at least capacity characters
+char *Shared_string::make_unique(std::size_t capacity)
+{
+  if (this->buffer != nullptr 
+    && this->buffer->refs.load(std::memory_order_acquire) == 1 
+    && this->buffer->capacity >= capacity)
+    return this->buffer->data();
+
+  const std::size_t length = this->get_length();
+  Buffer *copy = create(std::max(capacity, length));
+  std::memcpy(copy->data(), this->get_str(), length + 1);
+  copy->length = length;
+
+  release(this->buffer);
+  this->buffer = copy;
+  return copy->data();
+}
+
+Shared_string::Shared_string()
+  : buffer{nullptr}
+{}
+
+Shared_string::Shared_string(const char *const str)
+  : buffer{nullptr}
+{
+  const std::size_t length = str == nullptr ? 0 : str_len(str);
+  if (length == 0)
+    return;
+
+  this->buffer = create(length);
+  std::memcpy(this->buffer->data(), str, length + 1);
+  this->buffer->length = length;
+}
+
+Shared_string::Shared_string(const String &str)
+  : Shared_string{str.get_str()}
+{}
+
+Shared_string::Shared_string(const Shared_string &source)
+  : buffer{source.buffer}
+{
+  retain(this->buffer);
+}
+
+Shared_string::Shared_string(Shared_string &&source) noexcept
+  : buffer{source.buffer}
+{
+  source.buffer = nullptr;
+}
+
+Shared_string::~Shared_string()
+{
+  release(this->buffer);
+}
+
+Shared_string &Shared_string::operator=(const Shared_string &rhs)
+{
+  retain(rhs.buffer);
+  release(this->buffer);
+  this->buffer = rhs.buffer;
+  return *this;
+}
+
+Shared_string &Shared_string::operator=(Shared_string &&rhs) noexcept
+{
+  if (this == &rhs)
+    return *this;
+
+  release(this->buffer);
+  this->buffer = rhs.buffer;
+  rhs.buffer = nullptr;
+  return *this;
+}
+
+bool operator==(const Shared_string &lhs, const Shared_string &rhs)
+{
+  return lhs.buffer == rhs.buffer 
+    || (lhs.get_length() == rhs.get_length() && std::memcmp(lhs.get_str(), rhs.get_str(), lhs.get_length()) == 0);
+}
+
+bool operator!=(const Shared_string &lhs, const Shared_string &rhs)
+{
+  return !(lhs == rhs);
+}
+
+bool operator<(const Shared_string &lhs, const Shared_string &rhs)
+{
+  return str_compare(lhs.get_str(), rhs.get_str()) < 0;
+}
+
+bool operator>(const Shared_string &lhs, const Shared_string &rhs)
+{
+  return str_compare(lhs.get_str(), rhs.get_str()) > 0;
+}
+
+Shared_string &operator++(Shared_string &obj)
+{
+  if (obj.get_length() != 0)
+    to_upper(obj.make_unique(0), obj.get_length());
+  return obj;
+}
+
+Shared_string &operator--(Shared_string &obj)
+{
+  if (obj.get_length() != 0)
+    to_lower(obj.make_unique(0), obj.get_length());
+  return obj;
+}
+
+Shared_string operator+(const Shared_string &lhs, const Shared_string &rhs)
+{
+  Shared_string temp {lhs};
+  temp += rhs;
+  return temp;
+}
+
+Shared_string &operator+=(Shared_string &lhs, const Shared_string &rhs)
+{
+  const std::size_t rhs_length = rhs.get_length();
+  if (rhs_length == 0)
+    return lhs;
+
+  // keep rhs alive and unchanged even when it shares the buffer of lhs
+  Shared_string keep {rhs};
+  const std::size_t length = lhs.get_length() + rhs_length;
+  std::size_t capacity = lhs.buffer == nullptr ? 0 : lhs.buffer->capacity;
+  if (length > capacity)
+    capacity = std::max(length, capacity * 2);
+
+  char *data = lhs.make_unique(capacity);
+  std::memcpy(data + lhs.get_length(), keep.get_str(), rhs_length);
+  data[length] = '\0';
+  lhs.buffer->length = length;
+  return lhs;
+}
+
+Shared_string &operator*=(Shared_string &obj, int num)
+{
+  if (num <= 0) {
+    obj = Shared_string {};
+    return obj;
+  }
+
+  const std::size_t length = obj.get_length();
+  if (length == 0 || num == 1)
+    return obj;
+
+  char *data = obj.make_unique(length * num);
+  for (int i {1}; i < num; i++)
+    std::memcpy(data + i * length, data, length);
+  data[length * num] = '\0';
+  obj.buffer->length = length * num;
+  return obj;
+}
+
+void Shared_string::display() const
+{
+  std::cout << this->get_str() << std::endl;
+}
+
+std::size_t Shared_string::get_length() const
+{
+  return this->buffer == nullptr ? 0 : this->buffer->length;
+}
+
+const char *Shared_string::get_str() const
+{
+  return this->buffer == nullptr ? "" : this->buffer->data();
+}
+
+std::size_t Shared_string::use_count() const
+{
+  return this->buffer == nullptr ? 0 : this->buffer->refs.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,76 @@
+#ifndef _SHARED_STRING_H_
+#define _SHARED_STRING_H_
+
+#include <atomic>
+#include <cstddef>
+#include "String.h"
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
+/*
+
+  - Shared_string is the copy on write version of String: copies share one
+    immutable buffer with an atomic reference count, so copying is O(1).
+
+  - the operators that change the text (+=, *=, ++, --) first clone the buffer
+    when somebody else still uses it.
+
+  - sharing is safe across threads, changing one Shared_string from several
+    threads at once is not, as for String.
+
+*/
+class Shared_string
+{
+  friend bool operator==(const Shared_string &lhs, const Shared_string &rhs);
+  friend bool operator!=(const Shared_string &lhs, const Shared_string &rhs);
+  friend bool operator<(const Shared_string &lhs, const Shared_string &rhs);
+  friend bool operator>(const Shared_string &lhs, const Shared_string &rhs);
+  friend Shared_string &operator++(Shared_string &obj);
+  friend Shared_string &operator--(Shared_string &obj);
+  friend Shared_string operator+(const Shared_string &lhs, const Shared_string &rhs);
+  friend Shared_string &operator+=(Shared_string &lhs, const Shared_string &rhs);
+  friend Shared_string &operator*=(Shared_string &obj, int num);
+
+private:
+  // the header and the characters are one allocation
+  struct Buffer
+  {
+    std::atomic<std::size_t> refs;
+    std::size_t length;
+    std::size_t capacity;
+
+    char *data()
+    {
+      return reinterpret_cast<char*>(this + 1);
+    }
+  };
+
+  Buffer *buffer; // nullptr is the empty string
+
+  static Buffer *create(std::size_t capacity);
+  static void retain(Buffer *buffer);
+  static void release(Buffer *buffer);
+
+  char *make_unique(std::size_t capacity);
+
+public:
+  Shared_string();
+  Shared_string(const char *const str);
+  Shared_string(const String &str);
+  Shared_string(const Shared_string &source);
+  Shared_string(Shared_string &&source) noexcept;
+  ~Shared_string();
+
+  Shared_string &operator=(const Shared_string &rhs);
+  Shared_string &operator=(Shared_string &&rhs) noexcept;
+
+  void display() const;
+  std::size_t get_length() const;
+  const char *get_str() const;
+  std::size_t use_count() const;
+};
+
+// only a pointer to the shared buffer, a memcpy moves it, the count stays the same
+template <>
+struct Trivially_relocatable<Shared_string> : std::true_type {};
+
+#endif
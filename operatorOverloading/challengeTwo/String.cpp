@@ -1,42 +1,67 @@
 #include <iostream>
-#include <cctype>
+#include <algorithm>
 #include <cstring>
+#include "Case_conversion.h"
 #include "String.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+#include "String_view.h"
+
+// counts every buffer taken from a memory resource, short strings never add to it
+std::size_t String::heap_allocations {0};
 
 String::String()
-  : str{nullptr}
+  : String{std::pmr::get_default_resource()}
+{}
+
+String::String(std::pmr::memory_resource *resource)
+  : resource{resource}, str{small}, length{0}, capacity{small_capacity}
 {
-  this->str = new char[1];
-  *this->str = '\0';
+  *this->small = '\0';
 }
 
+String::String(std::nullptr_t)
+  : String{}
+{}
+
 String::String(const char *const str)
-  : str{nullptr}
+  : String{}
 {
-  if (str == nullptr)
-    String();
-  else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
-  }
+  this->assign(str);
+}
+
+String::String(const char *const str, std::pmr::memory_resource *resource)
+  : String{resource}
+{
+  this->assign(str);
 }
 
 String::String(const String &source)
-  : String{source.str}
-{}
+  : String{}
+{
+  this->assign(source.str, source.length);
+}
 
-String::String(String &&source)
-  : str{source.str}
+String::String(const String &source, std::pmr::memory_resource *resource)
+  : String{resource}
 {
-  source.str = nullptr;
+  this->assign(source.str, source.length);
 }
 
-String::~String()
+String::String(String &&source) noexcept
+  : String{source.resource}
+{
+  this->take(source);
+}
+
+String::String(const String_view &view)
+  : String{}
 {
-  if (this->str == nullptr) {}
-  else {}
+  this->assign(view.data(), view.get_length());
+}
 
-  delete[] this->str;
+String::~String()
+{
+  this->release();
 }
 
 String &String::operator=(const String &obj)
@@ -44,9 +69,7 @@ String &String::operator=(const String &obj)
   if (this == &obj)
     return *this;
   
-  delete[] this->str;
-  this->str = new char[std::strlen(obj.str) + 1];
-  std::strcpy(this->str, obj.str);
+  this->assign(obj.str, obj.length);
   return *this;
 }
 
@@ -55,92 +78,174 @@ String &String::operator=(String &&obj)
   if (this == &obj)
     return *this;
   
-  delete[] this->str;
-  this->str = obj.str;
-  obj.str = nullptr;
+  this->take(obj);
   return *this;
 }
 
+/*
+
+  - allocate drops the current text and returns a buffer for length characters,
+    the '\0' at the end is already written, the caller fills the rest.
+
+  - the current buffer is kept when it is big enough.
+
+*/
+char *String::allocate(std::size_t length)
+{
+  if (length > this->capacity) {
+    this->release();
+    this->str = this->acquire(length);
+    this->capacity = length;
+  }
+
+  this->length = length;
+  this->str[length] = '\0';
+  return this->str;
+}
+
+// grows the buffer to at least capacity characters and keeps the text
+void String::reserve(std::size_t capacity)
+{
+  if (capacity <= this->capacity)
+    return;
+
+  char *buff = this->acquire(capacity);
+  std::memcpy(buff, this->str, this->length + 1);
+
+  if (this->str != this->small)
+    this->resource->deallocate(this->str, this->capacity + 1, alignof(char));
+  this->str = buff;
+  this->capacity = capacity;
+}
+
+void String::assign(const char *source)
+{
+  if (source == nullptr)
+    source = "";
+
+  this->assign(source, str_len(source));
+}
+
+void String::assign(const char *source, std::size_t length)
+{
+  std::memcpy(this->allocate(length), source, length);
+}
+
+// a buffer for capacity characters and the '\0' from the resource of this string
+char *String::acquire(std::size_t capacity)
+{
+  heap_allocations++;
+  return static_cast<char *>(this->resource->allocate(capacity + 1, alignof(char)));
+}
+
+void String::release()
+{
+  if (this->str != this->small)
+    this->resource->deallocate(this->str, this->capacity + 1, alignof(char));
+  this->str = this->small;
+  this->length = 0;
+  this->capacity = small_capacity;
+  *this->small = '\0';
+}
+
+/*
+
+  - a heap buffer is moved over when both strings use the same resource, an inline one,
+    or one that has to go back to another resource, is copied. the source is left empty.
+
+*/
+void String::take(String &source)
+{
+  if (source.str == source.small || *this->resource != *source.resource) {
+    this->assign(source.str, source.length);
+    source.release();
+    return;
+  }
+
+  this->release();
+  this->str = source.str;
+  this->length = source.length;
+  this->capacity = source.capacity;
+
+  source.str = source.small;
+  source.length = 0;
+  source.capacity = small_capacity;
+  *source.small = '\0';
+}
+
+std::size_t String::get_heap_allocations()
+{
+  return heap_allocations;
+}
+
 String operator-(const String &obj)
 {
-  char *buff = new char[std::strlen(obj.str) + 1];
-  std::strcpy(buff, obj.str);
-  for (size_t i {0}; i < std::strlen(buff); i++)
-    buff[i] = std::tolower(buff[i]);
-  String temp {buff};
-  delete[] buff;
+  String temp {obj};
+  to_lower(temp.str, temp.length);
   return temp;
 }
 
 bool operator==(const String &lhs, const String &rhs)
 {
-  return std::strcmp(lhs.str, rhs.str) == 0;
+  return lhs.length == rhs.length && std::memcmp(lhs.str, rhs.str, lhs.length) == 0;
 }
 
 bool operator!=(const String &lhs, const String &rhs)
 {
-  return std::strcmp(lhs.str, rhs.str) != 0;
+  return !(lhs == rhs);
 }
 
 bool operator>(const String &lhs, const String &rhs)
 {
-  return std::strcmp(lhs.str, rhs.str) > 0;
+  return str_compare(lhs.str, rhs.str) > 0;
 }
 
 bool operator<(const String &lhs, const String &rhs)
 {
-  return std::strcmp(lhs.str, rhs.str) < 0;
+  return str_compare(lhs.str, rhs.str) < 0;
 }
 
 String &operator++(String &obj)
 {
-  if (obj.str == nullptr)
-    return obj;
-
-  for (size_t i {0}; i < std::strlen(obj.str); i++)
-    obj.str[i] = std::toupper(obj.str[i]);
+  to_upper(obj.str, obj.length);
 
   return obj;
 }
 
 String operator++(String &obj, int)
 {
-  String old {obj.str};
+  String old {obj};
   ++obj;
   return old;
 }
 
 String &operator--(String &obj)
 {
-  if (obj.str == nullptr)
-    return obj;
-
-  for (size_t i {0}; i < std::strlen(obj.str); i++)
-    obj.str[i] = std::tolower(obj.str[i]);
+  to_lower(obj.str, obj.length);
 
   return obj;
 }
 
 String operator--(String &obj, int)
 {
-  String old {obj.str};
+  String old {obj};
   --obj;
   return old;
 }
 
-String operator+(const String &lhs, const String &rhs)
-{
-  char *buff = new char[std::strlen(lhs.str) + std::strlen(rhs.str) + 1];
-  std::strcpy(buff, lhs.str);
-  std::strcat(buff, rhs.str);
-  String temp {buff};
-  delete[] buff;
-  return temp;
-}
-
+// appends in place, the buffer at least doubles when it has to grow
 String &operator+=(String &lhs, const String &rhs)
 {
-  lhs = lhs + rhs;
+  const std::size_t rhs_length = rhs.length;
+  const std::size_t length = lhs.length + rhs_length;
+
+  if (length > lhs.capacity)
+    lhs.reserve(std::max(length, lhs.capacity * 2));
+
+  // rhs may be lhs itself, so its str is read only after reserve
+  std::memcpy(lhs.str + lhs.length, rhs.str, rhs_length);
+  lhs.length = length;
+  lhs.str[length] = '\0';
   return lhs;
 }
 
@@ -154,20 +259,32 @@ String operator*(const String &obj, int num)
     return temp;
   
   */  
-  char *buff = new char[(std::strlen(obj.str) * num) + 1];
-  std::strcpy(buff, "");
+  String temp;
+  if (num <= 0)
+    return temp;
 
+  char *buff = temp.allocate(obj.length * num);
   for (int i {0}; i < num; i++)
-    std::strcat(buff, obj.str);
+    std::memcpy(buff + i * obj.length, obj.str, obj.length);
 
-  String temp {buff};
-  delete[] buff;
   return temp;
 }
 
+// repeats in place, the first copy is already there
 String &operator*=(String &obj, int num)
 {
-  obj = obj * num;
+  if (num <= 0) {
+    obj.allocate(0);
+    return obj;
+  }
+
+  const std::size_t length = obj.length;
+  obj.reserve(length * num);
+  for (int i {1}; i < num; i++)
+    std::memcpy(obj.str + i * length, obj.str, length);
+
+  obj.length = length * num;
+  obj.str[obj.length] = '\0';
   return obj;
 }
 
@@ -175,3 +292,18 @@ void String::display()
 {
   std::cout << this->str << std::endl;
 }
+
+std::size_t String::get_length() const
+{
+  return this->length;
+}
+
+const char *String::get_str() const
+{
+  return this->str;
+}
+
+std::pmr::memory_resource *String::get_resource() const
+{
+  return this->resource;
+}
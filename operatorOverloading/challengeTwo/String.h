@@ -1,6 +1,17 @@
 #ifndef _STRING_H_
 #define _STRING_H_
 
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <ostream>
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+
+class String_view;
+
+template<typename L, typename R>
+class String_concat;
+
 class String
 {
   friend String operator-(const String &obj);
@@ -12,25 +23,227 @@ class String
   friend String operator++(String &obj, int);
   friend String &operator--(String &obj);
   friend String operator--(String &obj, int);
-  friend String operator+(const String &lhs, const String &rhs);
   friend String &operator+=(String &lhs, const String &rhs);
   friend String operator*(const String &obj, int num);
   friend String &operator*=(String &obj, int num);
 
 private:
+  // strings up to small_capacity characters live in the object itself, longer ones on the heap
+  static constexpr std::size_t small_capacity = 23;
+  static std::size_t heap_allocations;
+
+  std::pmr::memory_resource *resource;  // where heap buffers come from and go back to
   char *str;
+  std::size_t length;    // characters in str, without the '\0'
+  std::size_t capacity;  // characters str has room for, without the '\0'
+  char small[small_capacity + 1];
+
+  char *allocate(std::size_t length);
+  void reserve(std::size_t capacity);
+  void assign(const char *source);
+  void assign(const char *source, std::size_t length);
+  char *acquire(std::size_t capacity);
+  void release();
+  void take(String &source);
 
 public:
+  /*
+
+    - heap buffers come from a std::pmr::memory_resource, the default one
+      (std::pmr::get_default_resource(), global new and delete) unless one is given.
+
+    - a request can build its strings on a std::pmr::monotonic_buffer_resource and drop
+      them all at once at the end, the arena must outlive the strings and is not thread safe,
+      so there is one per thread or per request.
+
+    - like the std::pmr containers, a copy uses the default resource and a move keeps the
+      resource of the source, assignment never changes the resource of the target.
+
+  */
   String();
+  explicit String(std::pmr::memory_resource *resource);
+  String(std::nullptr_t);  // an empty string, as String(const char *) does for nullptr
   String(const char *const str);
+  String(const char *const str, std::pmr::memory_resource *resource);
   String(const String &source);
-  String(String &&source);
+  String(const String &source, std::pmr::memory_resource *resource);
+  String(String &&source) noexcept;
+  explicit String(const String_view &view);
   ~String();
 
   String &operator=(const String &rhs);
+  // not noexcept, a String of another memory_resource can not take the buffer, it copies it
   String &operator=(String &&rhs);
 
+  // a chain of + is turned into a String here, with one buffer of the exact size
+  template<typename L, typename R>
+  String(const String_concat<L, R> &expr);
+
+  template<typename L, typename R>
+  String &operator=(const String_concat<L, R> &expr);
+
   void display();
+  std::size_t get_length() const;
+  const char *get_str() const;
+  std::pmr::memory_resource *get_resource() const;
+
+  static std::size_t get_heap_allocations();
+};
+
+/*
+
+  - a + b does not build a String, it returns a String_concat that only remembers
+    its operands, a + b + c + d nests them, and the text is copied once when the
+    result is assigned to a String or printed.
+
+  - the operands are referenced, not copied, so a String_concat must be used in the
+    expression that creates it, do not keep one in an auto variable.
+
+*/
+class String_ref
+{
+private:
+  const String *str;
+
+public:
+  String_ref(const String &str)
+    : str{&str}
+  {}
+
+  std::size_t get_length() const
+  {
+    return this->str->get_length();
+  }
+
+  char *write(char *buff) const
+  {
+    std::memcpy(buff, this->str->get_str(), this->str->get_length());
+    return buff + this->str->get_length();
+  }
+};
+
+class String_literal
+{
+private:
+  const char *str;
+  std::size_t length;
+
+public:
+  String_literal(const char *str)
+    : str{str == nullptr ? "" : str}, length{str_len(this->str)}
+  {}
+
+  std::size_t get_length() const
+  {
+    return this->length;
+  }
+
+  char *write(char *buff) const
+  {
+    std::memcpy(buff, this->str, this->length);
+    return buff + this->length;
+  }
 };
 
+template<typename L, typename R>
+class String_concat
+{
+private:
+  L lhs;
+  R rhs;
+
+public:
+  String_concat(const L &lhs, const R &rhs)
+    : lhs{lhs}, rhs{rhs}
+  {}
+
+  std::size_t get_length() const
+  {
+    return this->lhs.get_length() + this->rhs.get_length();
+  }
+
+  // writes the pieces in order and returns a pointer past the last character
+  char *write(char *buff) const
+  {
+    return this->rhs.write(this->lhs.write(buff));
+  }
+};
+
+template<typename L, typename R>
+String::String(const String_concat<L, R> &expr)
+  : String{}
+{
+  expr.write(this->allocate(expr.get_length()));
+}
+
+// the expression may read this string (s = s + t), so it is built aside first
+template<typename L, typename R>
+String &String::operator=(const String_concat<L, R> &expr)
+{
+  String temp {expr};
+  this->take(temp);
+  return *this;
+}
+
+inline String_concat<String_ref, String_ref> operator+(const String &lhs, const String &rhs)
+{
+  return {lhs, rhs};
+}
+
+inline String_concat<String_ref, String_literal> operator+(const String &lhs, const char *rhs)
+{
+  return {lhs, rhs};
+}
+
+inline String_concat<String_literal, String_ref> operator+(const char *lhs, const String &rhs)
+{
+  return {lhs, rhs};
+}
+
+template<typename L, typename R>
+String_concat<String_concat<L, R>, String_ref> operator+(const String_concat<L, R> &lhs, const String &rhs)
+{
+  return {lhs, rhs};
+}
+
+template<typename L, typename R>
+String_concat<String_concat<L, R>, String_literal> operator+(const String_concat<L, R> &lhs, const char *rhs)
+{
+  return {lhs, rhs};
+}
+
+template<typename L, typename R>
+String_concat<String_ref, String_concat<L, R>> operator+(const String &lhs, const String_concat<L, R> &rhs)
+{
+  return {lhs, rhs};
+}
+
+template<typename L, typename R>
+String_concat<String_literal, String_concat<L, R>> operator+(const char *lhs, const String_concat<L, R> &rhs)
+{
+  return {lhs, rhs};
+}
+
+template<typename L1, typename R1, typename L2, typename R2>
+String_concat<String_concat<L1, R1>, String_concat<L2, R2>> operator+(const String_concat<L1, R1> &lhs, 
+  const String_concat<L2, R2> &rhs)
+{
+  return {lhs, rhs};
+}
+
+// printing goes through a small stack buffer, longer results are materialized once
+template<typename L, typename R>
+std::ostream &operator<<(std::ostream &os, const String_concat<L, R> &expr)
+{
+  constexpr std::size_t stack_size = 256;
+
+  if (expr.get_length() <= stack_size) {
+    char buff[stack_size];
+    os.write(buff, expr.write(buff) - buff);
+  }
+  else
+    os << String {expr}.get_str();
+  return os;
+}
+
 #endif
\ No newline at end of file
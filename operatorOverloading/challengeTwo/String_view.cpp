@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstring>
+#include "String_view.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+
+String_view::String_view()
+  : str{""}, length{0}
+{}
+
+String_view::String_view(const char *const str)
+  : str{str == nullptr ? "" : str}, length{str_len(this->str)}
+{}
+
+String_view::String_view(const char *const str, std::size_t length)
+  : str{str}, length{length}
+{}
+
+String_view::String_view(const String &str)
+  : str{str.get_str()}, length{str.get_length()}
+{}
+
+String_view::String_view(std::string_view view)
+  : str{view.data()}, length{view.size()}
+{}
+
+String_view::operator std::string_view() const
+{
+  return {this->str, this->length};
+}
+
+const char *String_view::data() const
+{
+  return this->str;
+}
+
+std::size_t String_view::get_length() const
+{
+  return this->length;
+}
+
+bool String_view::is_empty() const
+{
+  return this->length == 0;
+}
+
+const char *String_view::begin() const
+{
+  return this->str;
+}
+
+const char *String_view::end() const
+{
+  return this->str + this->length;
+}
+
+char String_view::operator[](std::size_t i) const
+{
+  return this->str[i];
+}
+
+String_view String_view::substr(std::size_t pos, std::size_t count) const
+{
+  if (pos > this->length)
+    pos = this->length;
+  return {this->str + pos, std::min(count, this->length - pos)};
+}
+
+std::size_t String_view::find(char c, std::size_t pos) const
+{
+  if (pos >= this->length)
+    return npos;
+
+  const void *found = std::memchr(this->str + pos, c, this->length - pos);
+  return found == nullptr ? npos : static_cast<const char*>(found) - this->str;
+}
+
+std::size_t String_view::find(const String_view &needle, std::size_t pos) const
+{
+  if (pos > this->length)
+    return npos;
+
+  const char *found = std::search(this->begin() + pos, this->end(), needle.begin(), needle.end());
+  return found == this->end() && !needle.is_empty() ? npos : found - this->str;
+}
+
+// same order as strcmp on String, a prefix sorts first
+int String_view::compare(const String_view &lhs, const String_view &rhs)
+{
+  const int result = std::memcmp(lhs.str, rhs.str, std::min(lhs.length, rhs.length));
+  if (result != 0)
+    return result;
+  return lhs.length < rhs.length ? -1 : lhs.length > rhs.length ? 1 : 0;
+}
+
+bool operator==(const String_view &lhs, const String_view &rhs)
+{
+  return lhs.length == rhs.length && std::memcmp(lhs.str, rhs.str, lhs.length) == 0;
+}
+
+bool operator!=(const String_view &lhs, const String_view &rhs)
+{
+  return !(lhs == rhs);
+}
+
+bool operator<(const String_view &lhs, const String_view &rhs)
+{
+  return String_view::compare(lhs, rhs) < 0;
+}
+
+bool operator>(const String_view &lhs, const String_view &rhs)
+{
+  return String_view::compare(lhs, rhs) > 0;
+}
+
+std::ostream &operator<<(std::ostream &os, const String_view &view)
+{
+  return os.write(view.str, view.length);
+}
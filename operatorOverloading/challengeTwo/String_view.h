@@ -0,0 +1,61 @@
+#ifndef _STRING_VIEW_H_
+#define _STRING_VIEW_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include "String.h"
+
+/*
+
+  - String_view is a non owning (pointer, length) window into characters owned by
+    somebody else, a String, a literal or a std::string, it never allocates.
+
+  - substr, find and iteration work on the window without copying, so a line can be
+    split into tokens that all point into the line.
+
+  - the viewed text is not '\0' terminated in general, and it must outlive the view.
+
+  - a String is made from a view explicitly: String str {view};
+
+*/
+class String_view
+{
+  friend bool operator==(const String_view &lhs, const String_view &rhs);
+  friend bool operator!=(const String_view &lhs, const String_view &rhs);
+  friend bool operator<(const String_view &lhs, const String_view &rhs);
+  friend bool operator>(const String_view &lhs, const String_view &rhs);
+  friend std::ostream &operator<<(std::ostream &os, const String_view &view);
+
+private:
+  const char *str;
+  std::size_t length;
+
+  static int compare(const String_view &lhs, const String_view &rhs);
+
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  String_view();
+  String_view(const char *const str);
+  String_view(const char *const str, std::size_t length);
+  String_view(const String &str);
+  String_view(std::string_view view);
+
+  operator std::string_view() const;
+
+  const char *data() const;
+  std::size_t get_length() const;
+  bool is_empty() const;
+
+  const char *begin() const;
+  const char *end() const;
+  char operator[](std::size_t i) const;
+
+  // count is cut at the end of the view, like std::string_view::substr
+  String_view substr(std::size_t pos, std::size_t count = npos) const;
+  std::size_t find(char c, std::size_t pos = 0) const;
+  std::size_t find(const String_view &needle, std::size_t pos = 0) const;
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include <iostream>
+#include <memory_resource>
 #include "String.h"
+#include "Shared_string.h"
+#include "String_view.h"
 
 int main()
 {
@@ -60,5 +63,35 @@ int main()
     str2.display();
   */
 
+  String short_result = str1 + " from world.";
+  String long_result = short_result * 3;
+  short_result.display();
+  long_result.display();
+  std::cout << "heap allocations: " << String::get_heap_allocations() << std::endl;
+
+  Shared_string shared {long_result};
+  Shared_string copy {shared};
+  std::cout << "shared by " << shared.use_count() << std::endl;
+  ++copy;
+  shared.display();
+  copy.display();
+
+  // split a line into tokens that point into it, no token allocates
+  String line {"Larry Moe Curly"};
+  String_view rest {line};
+  for (std::size_t pos; (pos = rest.find(' ')) != String_view::npos; rest = rest.substr(pos + 1))
+    std::cout << rest.substr(0, pos) << std::endl;
+  std::cout << rest << std::endl;
+
+  // per request strings on an arena, released together when it goes out of scope
+  {
+    std::pmr::monotonic_buffer_resource arena {4096};
+    String request {"GET /accounts/42/transactions?from=2024-01-01", &arena};
+    String reply {"200 OK for ", &arena};
+    reply += request;
+    reply.display();
+    std::cout << "on the arena: " << std::boolalpha << (reply.get_resource() == &arena) << std::endl;
+  }
+
   return 0;
 }
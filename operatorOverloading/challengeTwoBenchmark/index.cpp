@@ -0,0 +1,47 @@
+/*
+
+  - compares the cost of copying a String (deep copy) and a Shared_string
+    (reference count) as the payload grows.
+
+  - build it together with the challengeTwo sources:
+      g++ -std=c++17 -O2 index.cpp ../challengeTwo/String.cpp ../challengeTwo/Shared_string.cpp 
+        ../challengeTwo/Case_conversion.cpp ../challengeTwo/String_view.cpp
+
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../challengeTwo/String.h"
+#include "../challengeTwo/Shared_string.h"
+
+constexpr int num_copies {1000};
+
+template<typename T>
+double copy_ns(const T &payload)
+{
+  std::vector<T> copies;
+  copies.reserve(num_copies);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i {0}; i < num_copies; i++)
+    copies.push_back(payload);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / num_copies;
+}
+
+int main()
+{
+  for (std::size_t size: {16ul, 1'024ul, 65'536ul, 1'048'576ul}) {
+    const std::string text(size, 'x');
+    const String deep {text.c_str()};
+    const Shared_string shared {text.c_str()};
+
+    std::cout << size << " bytes: String " << copy_ns(deep) << " ns, Shared_string " 
+      << copy_ns(shared) << " ns per copy" << std::endl;
+  }
+
+  return 0;
+}
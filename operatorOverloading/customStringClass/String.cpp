@@ -1,24 +1,21 @@
 #include <cstring>
 #include <iostream>
 #include "String.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
+
+// counts every buffer taken from the heap, short strings never add to it
+std::size_t String::heap_allocations {0};
 
 String::String()
-  : str{nullptr}
+  : str{small}
 {
-  str = new char[1];
-  *str = '\0';
+  *this->small = '\0';
 }
 
 String::String(const char *const str)
-  : str{nullptr}
-{
-  if (str == nullptr) {
-    this->str = new char[1];
-    *this->str = '\0';
-  } else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
-  }
+  : String{}
+{
+  this->assign(str);
 }
 
 String::String(const String &source)
@@ -27,7 +24,35 @@ String::String(const String &source)
 
 String::~String()
 {
-  delete[] str;
+  this->release();
+}
+
+// drops the current text and returns a buffer with room for length characters and the '\0'
+char *String::allocate(std::size_t length)
+{
+  this->release();
+  if (length > small_capacity) {
+    this->str = new char[length + 1];
+    heap_allocations++;
+  }
+  return this->str;
+}
+
+void String::assign(const char *source)
+{
+  if (source == nullptr)
+    source = "";
+
+  std::size_t length = str_len(source);
+  std::memcpy(this->allocate(length), source, length + 1);
+}
+
+void String::release()
+{
+  if (this->str != this->small)
+    delete[] this->str;
+  this->str = this->small;
+  *this->small = '\0';
 }
 
 void String::display() const
@@ -37,10 +62,15 @@ void String::display() const
 
 int String::get_length() const
 {
-  return std::strlen(this->str);
+  return str_len(this->str);
 }
 
 const char *String::get_str() const
 {
   return this->str;
 }
+
+std::size_t String::get_heap_allocations()
+{
+  return heap_allocations;
+}
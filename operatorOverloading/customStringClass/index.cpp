@@ -12,5 +12,9 @@ int main()
   str2.display();
   str3.display();
 
+  String str4 {"this one is too long for the inline buffer"};
+  str4.display();
+  std::cout << "heap allocations: " << String::get_heap_allocations() << std::endl;
+
   return 0;
 }
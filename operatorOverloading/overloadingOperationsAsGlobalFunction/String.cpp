@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cctype>
 #include "String.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
 
 String::String()
   : str{nullptr}
@@ -18,8 +19,9 @@ String::String(const char *const str)
     this->str = new char[1];
     *this->str = '\0';
   } else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
+    const std::size_t length = str_len(str);
+    this->str = new char[length + 1];
+    str_copy_n(this->str, str, length);
   }
   std::cout << "String created with address " << this << " and the str pointer contains '" << this->str << "'." << std::endl;
 }
@@ -28,7 +30,7 @@ String::String(const String &source)
   : String{source.str}
 {}
 
-String::String(String &&source)
+String::String(String &&source) noexcept
   : str{source.str}
 {
   source.str = nullptr;
@@ -48,14 +50,15 @@ String &String::operator=(const String &source)
   delete[] this->str;
 
   // allocate a new space
-  this->str = new char[std::strlen(source.str) + 1];
-  std::strcpy(this->str, source.str);
+  const std::size_t length = str_len(source.str);
+  this->str = new char[length + 1];
+  str_copy_n(this->str, source.str, length);
 
   return *this;
 }
 
 // assignment operator overloading (move assignment)
-String &String::operator=(String &&source)
+String &String::operator=(String &&source) noexcept
 {
   // check if the source is the current
   if (this == &source)
@@ -94,7 +97,7 @@ void String::display() const
 
 int String::get_length() const
 {
-  return std::strlen(this->str);
+  return str_len(this->str);
 }
 
 const char *String::get_str() const
@@ -106,15 +109,17 @@ const char *String::get_str() const
 
 bool operator==(const String &lhs, const String &rhs)
 {
-  return std::strcmp(lhs.str, rhs.str) == 0;
+  return str_compare(lhs.str, rhs.str) == 0;
 }
 
 String operator+(const String &lhs, const String &rhs)
 {
   char *buff {nullptr};
-  buff = new char[std::strlen(lhs.str) + std::strlen(rhs.str) + 1];
-  std::strcpy(buff, lhs.str);
-  std::strcat(buff, rhs.str);
+  const std::size_t lhs_length = str_len(lhs.str);
+  const std::size_t rhs_length = str_len(rhs.str);
+  buff = new char[lhs_length + rhs_length + 1];
+  // the rhs goes at the end the copy of the lhs returns, strcat would look for it again
+  str_copy_n(str_copy_n(buff, lhs.str, lhs_length), rhs.str, rhs_length);
 
   String temp {buff};
 
@@ -126,10 +131,11 @@ String operator+(const String &lhs, const String &rhs)
 String operator-(const String &obj)
 {
   char *buff {nullptr};
-  buff = new char[std::strlen(obj.str) + 1];
-  std::strcpy(buff, obj.str);
+  const std::size_t length = str_len(obj.str);
+  buff = new char[length + 1];
+  str_copy_n(buff, obj.str, length);
 
-  for (size_t i {0}; i < std::strlen(buff); i++)
+  for (size_t i {0}; i < length; i++)
     buff[i] = std::tolower(buff[i]);
 
   String temp {buff};
@@ -1,6 +1,8 @@
 #ifndef _STRING_H_
 #define _STRING_H_
 
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
 class String
 {
   // defined all these functions as a global function
@@ -15,15 +17,19 @@ public:
   String();
   String(const char *const str);
   String(const String &source);
-  String(String &&source);
+  String(String &&source) noexcept;
   ~String();
 
   String &operator=(const String &source);
-  String &operator=(String &&source);
+  String &operator=(String &&source) noexcept;
 
   void display() const;
   int get_length() const;
   const char *get_str() const;
 };
 
+// only a pointer to the heap, a memcpy moves it
+template <>
+struct Trivially_relocatable<String> : std::true_type {};
+
 #endif
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cctype>
 #include "String.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
 
 String::String()
   : str{nullptr}
@@ -18,8 +19,9 @@ String::String(const char *const str)
     this->str = new char[1];
     *this->str = '\0';
   } else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
+    const std::size_t length = str_len(str);
+    this->str = new char[length + 1];
+    str_copy_n(this->str, str, length);
   }
   std::cout << "String created with address " << this << " and the str pointer contains '" << this->str << "'." << std::endl;
 }
@@ -28,7 +30,7 @@ String::String(const String &source)
   : String{source.str}
 {}
 
-String::String(String &&source)
+String::String(String &&source) noexcept
   : str{source.str}
 {
   source.str = nullptr;
@@ -48,14 +50,15 @@ String &String::operator=(const String &source)
   delete[] this->str;
 
   // allocate a new space
-  this->str = new char[std::strlen(source.str) + 1];
-  std::strcpy(this->str, source.str);
+  const std::size_t length = str_len(source.str);
+  this->str = new char[length + 1];
+  str_copy_n(this->str, source.str, length);
 
   return *this;
 }
 
 // assignment operator overloading (move assignment)
-String &String::operator=(String &&source)
+String &String::operator=(String &&source) noexcept
 {
   // check if the source is the current
   if (this == &source)
@@ -84,13 +87,14 @@ String String::operator-() const
 
   // allocating a new space
   char *buff {nullptr};
-  buff = new char[std::strlen(this->str) + 1];
+  const std::size_t length = str_len(this->str);
+  buff = new char[length + 1];
 
   // copying the actual str into the new space
-  std::strcpy(buff, this->str);
+  str_copy_n(buff, this->str, length);
 
-  // making lowercase
-  for (size_t i {0}; i < std::strlen(buff); i++)
+  // making lowercase, the length is not looked for again on every character
+  for (size_t i {0}; i < length; i++)
     buff[i] = std::tolower(buff[i]);
   
   // making a new string with the new pointer
@@ -109,11 +113,12 @@ String String::operator+(const String &source) const
 
   // allocating a new space
   char *buff {nullptr};
-  buff = new char[std::strlen(this->str) + std::strlen(source.str) + 1];
+  const std::size_t length = str_len(this->str);
+  const std::size_t source_length = str_len(source.str);
+  buff = new char[length + source_length + 1];
 
-  // copying the actual str into the new space
-  std::strcpy(buff, this->str);
-  std::strcat(buff, source.str);
+  // copying the actual str into the new space, the source goes at the end the copy returns
+  str_copy_n(str_copy_n(buff, this->str, length), source.str, source_length);
 
   // making a new string with the new pointer
   String temp {buff};
@@ -128,7 +133,7 @@ String String::operator+(const String &source) const
 bool String::operator==(const String &source) const
 {
   std::cout << std::boolalpha;
-  return std::strcmp(this->str, source.str) == 0;
+  return str_compare(this->str, source.str) == 0;
 }
 
 String::~String()
@@ -148,7 +153,7 @@ void String::display() const
 
 int String::get_length() const
 {
-  return std::strlen(this->str);
+  return str_len(this->str);
 }
 
 const char *String::get_str() const
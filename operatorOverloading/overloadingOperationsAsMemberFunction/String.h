@@ -1,6 +1,8 @@
 #ifndef _STRING_H_
 #define _STRING_H_
 
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
 class String
 {
 private:
@@ -10,14 +12,14 @@ public:
   String();
   String(const char *const str);
   String(const String &source);
-  String(String &&source);
+  String(String &&source) noexcept;
   ~String();
 
   // assignment operator overloading (copy)
   String &operator=(const String &source);
 
   // assignment operator overloading (move)
-  String &operator=(String &&source);
+  String &operator=(String &&source) noexcept;
 
   // make lowercase
   String operator-() const;
@@ -33,4 +35,8 @@ public:
   const char *get_str() const;
 };
 
+// only a pointer to the heap, a memcpy moves it
+template <>
+struct Trivially_relocatable<String> : std::true_type {};
+
 #endif
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cctype>
 #include "String.h"
+#include "../../charactersAndStrings/c-styleStrings/C_string.h"
 
 String::String()
   : str{nullptr}
@@ -18,8 +19,9 @@ String::String(const char *const str)
     this->str = new char[1];
     *this->str = '\0';
   } else {
-    this->str = new char[std::strlen(str) + 1];
-    std::strcpy(this->str, str);
+    const std::size_t length = str_len(str);
+    this->str = new char[length + 1];
+    str_copy_n(this->str, str, length);
   }
   std::cout << "String created with address " << this << " and the str pointer contains '" << this->str << "'." << std::endl;
 }
@@ -28,7 +30,7 @@ String::String(const String &source)
   : String{source.str}
 {}
 
-String::String(String &&source)
+String::String(String &&source) noexcept
   : str{source.str}
 {
   source.str = nullptr;
@@ -48,14 +50,15 @@ String &String::operator=(const String &source)
   delete[] this->str;
 
   // allocate a new space
-  this->str = new char[std::strlen(source.str) + 1];
-  std::strcpy(this->str, source.str);
+  const std::size_t length = str_len(source.str);
+  this->str = new char[length + 1];
+  str_copy_n(this->str, source.str, length);
 
   return *this;
 }
 
 // assignment operator overloading (move assignment)
-String &String::operator=(String &&source)
+String &String::operator=(String &&source) noexcept
 {
   // check if the source is the current
   if (this == &source)
@@ -94,7 +97,7 @@ void String::display() const
 
 int String::get_length() const
 {
-  return std::strlen(this->str);
+  return str_len(this->str);
 }
 
 const char *String::get_str() const
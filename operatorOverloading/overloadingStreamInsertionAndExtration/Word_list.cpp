@@ -0,0 +1,177 @@
+#include <cstdint>
+#include "Word_list.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+  // the text is scanned in blocks of 64 bytes, one bit per byte
+  constexpr std::size_t block_size = 64;
+
+  // chunk size when the stream can't tell its size, like std::cin from a pipe
+  constexpr std::size_t chunk_size = 1 << 20;
+
+  // same characters as std::isspace in the "C" locale, the ones operator>> skips
+  [[maybe_unused]] inline bool is_space(unsigned char c)
+  {
+    return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+  }
+
+  // bit i is set when block[i] is a whitespace
+  inline std::uint64_t space_mask(const char *block)
+  {
+    std::uint64_t mask = 0;
+
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i controls = _mm_set1_epi8('\r' - '\t');
+
+    for (std::size_t i = 0; i < block_size; i += 16) {
+      __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+
+      // '\t' to '\r' is an unsigned range check: min(c - '\t', 4) == c - '\t'
+      __m128i shifted = _mm_sub_epi8(chars, tab);
+      __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, controls), shifted);
+      __m128i is_blank = _mm_cmpeq_epi8(chars, space);
+
+      std::uint32_t bits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(is_control, is_blank)));
+      mask |= static_cast<std::uint64_t>(bits) << i;
+    }
+#else
+    for (std::size_t i = 0; i < block_size; ++i)
+      mask |= static_cast<std::uint64_t>(is_space(block[i])) << i;
+#endif
+
+    return mask;
+  }
+
+  // a word starts on a non space after a space, the bit before the block comes from carry
+  inline std::uint64_t start_mask(std::uint64_t spaces, std::uint64_t carry)
+  {
+    return ~spaces & ((spaces << 1) | carry);
+  }
+
+  // a word ends on a space after a non space
+  inline std::uint64_t end_mask(std::uint64_t spaces, std::uint64_t carry)
+  {
+    return spaces & ~((spaces << 1) | carry);
+  }
+}
+
+Word_list::Word_list(std::istream &is)
+{
+  this->load(is);
+}
+
+void Word_list::load(std::istream &is)
+{
+  this->buffer.clear();
+  this->words.clear();
+  this->lengths.clear();
+
+  this->read(is);
+  this->tokenize();
+}
+
+// one read() of the remaining bytes when the stream is seekable,
+// otherwise large chunks appended to the same buffer.
+void Word_list::read(std::istream &is)
+{
+  std::size_t used = 0;
+  std::streampos start = is.tellg();
+
+  if (start != std::streampos(-1) && is.seekg(0, std::ios::end)) {
+    std::streamoff size = is.tellg() - start;
+    is.seekg(start);
+
+    if (size > 0) {
+      this->buffer.resize(static_cast<std::size_t>(size));
+      is.read(this->buffer.data(), size);
+      used = static_cast<std::size_t>(is.gcount());
+    }
+  } else {
+    is.clear();
+
+    while (is) {
+      this->buffer.resize(used + chunk_size);
+      is.read(this->buffer.data() + used, chunk_size);
+      used += static_cast<std::size_t>(is.gcount());
+    }
+  }
+
+  // pad with spaces to whole blocks plus one, so the last word ends
+  // on a space which becomes its '\0', and every block can be loaded.
+  std::size_t padded = (used / block_size + 1) * block_size;
+  this->buffer.resize(used);
+  this->buffer.resize(padded, ' ');
+}
+
+// per block the starts and ends of the words are bit masks, so the scan
+// has no branch per character, only one per word.
+void Word_list::tokenize()
+{
+  char *text = this->buffer.data();
+  std::size_t size = this->buffer.size();
+
+  std::size_t count = 0;
+  std::uint64_t carry = 1;
+  for (std::size_t i = 0; i < size; i += block_size) {
+    std::uint64_t spaces = space_mask(text + i);
+    count += static_cast<std::size_t>(__builtin_popcountll(start_mask(spaces, carry)));
+    carry = spaces >> 63;
+  }
+
+  this->words.reserve(count);
+  this->lengths.reserve(count);
+
+  carry = 1;
+  for (std::size_t i = 0; i < size; i += block_size) {
+    std::uint64_t spaces = space_mask(text + i);
+    std::uint64_t starts = start_mask(spaces, carry);
+    std::uint64_t ends = end_mask(spaces, carry);
+    carry = spaces >> 63;
+
+    for (; starts != 0; starts &= starts - 1)
+      this->words.push_back(text + i + __builtin_ctzll(starts));
+
+    // starts and ends alternate, so the n-th end closes the n-th word
+    for (; ends != 0; ends &= ends - 1) {
+      char *end = text + i + __builtin_ctzll(ends);
+      *end = '\0';
+      this->lengths.push_back(static_cast<std::size_t>(end - this->words[this->lengths.size()]));
+    }
+  }
+}
+
+std::size_t Word_list::size() const
+{
+  return this->words.size();
+}
+
+bool Word_list::is_empty() const
+{
+  return this->words.empty();
+}
+
+const char *Word_list::operator[](std::size_t index) const
+{
+  return this->words[index];
+}
+
+std::size_t Word_list::get_length(std::size_t index) const
+{
+  return this->lengths[index];
+}
+
+std::vector<const char *>::const_iterator Word_list::begin() const
+{
+  return this->words.begin();
+}
+
+std::vector<const char *>::const_iterator Word_list::end() const
+{
+  return this->words.end();
+}
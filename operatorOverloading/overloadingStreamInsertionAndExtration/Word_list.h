@@ -0,0 +1,50 @@
+#ifndef _WORD_LIST_H_
+#define _WORD_LIST_H_
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+
+/*
+
+  - Word_list reads a whole stream with one large read into a single buffer and splits
+    it in place, the whitespace after every word is overwritten with '\0'.
+
+  - the split looks at 64 bytes at a time as a bit mask of whitespaces (SSE2 when the
+    compiler targets it), so it costs one branch per word instead of per character.
+
+  - the words are pointers into that buffer, so there is no allocation per word, unlike
+    operator>> for String which allocates a temporary buffer and a new char[] per word.
+
+  - the words live as long as the Word_list, copy them into a String when they must
+    outlive it: String word {list[i]};
+
+*/
+class Word_list
+{
+private:
+  std::vector<char> buffer;
+  std::vector<const char *> words;
+  std::vector<std::size_t> lengths;
+
+  void read(std::istream &is);
+  void tokenize();
+
+public:
+  Word_list() = default;
+  explicit Word_list(std::istream &is);
+
+  // replaces the current words with the words of the stream
+  void load(std::istream &is);
+
+  std::size_t size() const;
+  bool is_empty() const;
+
+  const char *operator[](std::size_t index) const;
+  std::size_t get_length(std::size_t index) const;
+
+  std::vector<const char *>::const_iterator begin() const;
+  std::vector<const char *>::const_iterator end() const;
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include <iostream>
+#include <sstream>
 #include "String.h"
+#include "Word_list.h"
 
 int main()
 {
@@ -17,5 +19,17 @@ int main()
 
   std::cout << "The three stooges are " << larry << ", " << moe << " and " << curly << std::endl;
 
+  // a whole word list with one read, the words point into one buffer
+  std::istringstream names {"Larry Moe Curly\nShemp\tJoe  Curly-Joe\n"};
+  Word_list list {names};
+
+  std::cout << "The word list has " << list.size() << " names:";
+  for (const char *name : list)
+    std::cout << " " << name;
+  std::cout << std::endl;
+
+  String last {list[list.size() - 1]};
+  std::cout << "The last one is " << last << " with " << list.get_length(list.size() - 1) << " characters" << std::endl;
+
   return 0;
 }
@@ -0,0 +1,165 @@
+#ifndef _APPLY_ALL_H_
+#define _APPLY_ALL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../../functions/passingArrayToFunction/Span.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+    - apply_all(arr1, arr2, out) writes arr2[i] * arr1[j] to out[i * arr1.size() + j], the
+      numbers of the new int[size1 * size2] of index.cpp, to an array of the caller, that
+      can be used again for the next call, nothing is allocated. out has to have exactly
+      arr1.size() * arr2.size() ints, std::invalid_argument otherwise.
+
+    - apply_all(arr1, arr2, buffer) writes them to an Apply_all_buffer, that keeps its memory
+      from one call to the next and only grows it for a bigger product, and returns a span of
+      them, that is good until the next call with the same buffer.
+
+    - it is the rank 1 update of a matrix of arr2.size() rows and arr1.size() columns, the
+      rows are written 4 at a time, one load of 8 ints of arr1 for 4 rows, in blocks of
+      column_block columns, so the part of arr1 of a block stays in the L1 cache when arr1
+      is long. with AVX2 the 8 products of a row are one instruction, and a product of more
+      than stream_bytes, bigger than the caches, 64 MB for 4K x 4K, is written around them,
+      with stores that do not read the lines first, when out is on a 32 bytes boundary and
+      the rows are a whole number of vectors.
+
+    - the products wrap around, like the instructions do, instead of the undefined behavior
+      of an int that overflows.
+
+*/
+namespace detail_apply_all
+{
+    // 16 KB of arr1
+    inline constexpr std::size_t column_block = 4096;
+    inline constexpr std::size_t stream_bytes = std::size_t {8} << 20;
+
+    inline int multiply(int a, int b)
+    {
+        return static_cast<int>(static_cast<std::uint32_t>(a) * static_cast<std::uint32_t>(b));
+    }
+
+    // rows [row, row + count) of the columns [column, end), count is 1 to 4
+    template <bool stream>
+    inline void rows(const int* arr1, const int* arr2, int* out, std::size_t size1,
+                     std::size_t row, std::size_t count, std::size_t column, std::size_t end)
+    {
+        int* const out0 = out + row * size1;
+        std::size_t j = column;
+#if defined(__AVX2__)
+        if (count == 4)
+        {
+            int* const out1 = out0 + size1;
+            int* const out2 = out1 + size1;
+            int* const out3 = out2 + size1;
+            const __m256i b0 = _mm256_set1_epi32(arr2[row]);
+            const __m256i b1 = _mm256_set1_epi32(arr2[row + 1]);
+            const __m256i b2 = _mm256_set1_epi32(arr2[row + 2]);
+            const __m256i b3 = _mm256_set1_epi32(arr2[row + 3]);
+            for (; j + 8 <= end; j += 8)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr1 + j));
+                if constexpr (stream)
+                {
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(out0 + j), _mm256_mullo_epi32(a, b0));
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(out1 + j), _mm256_mullo_epi32(a, b1));
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(out2 + j), _mm256_mullo_epi32(a, b2));
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(out3 + j), _mm256_mullo_epi32(a, b3));
+                }
+                else
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out0 + j), _mm256_mullo_epi32(a, b0));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out1 + j), _mm256_mullo_epi32(a, b1));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out2 + j), _mm256_mullo_epi32(a, b2));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out3 + j), _mm256_mullo_epi32(a, b3));
+                }
+            }
+        }
+#endif
+        // the columns after the last whole vector, and every one without AVX2, the compiler
+        // unrolls and vectorizes the loop of one row
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const int b = arr2[row + i];
+            int* const out_row = out0 + i * size1;
+            for (std::size_t k = j; k < end; ++k)
+                out_row[k] = multiply(arr1[k], b);
+        }
+    }
+
+    template <bool stream>
+    inline void apply_all(const int* arr1, std::size_t size1, const int* arr2, std::size_t size2, int* out)
+    {
+        for (std::size_t column = 0; column < size1; column += column_block)
+        {
+            const std::size_t end = column + column_block < size1 ? column + column_block : size1;
+            std::size_t row = 0;
+            for (; row + 4 <= size2; row += 4)
+                rows<stream>(arr1, arr2, out, size1, row, 4, column, end);
+            if (row < size2)
+                rows<false>(arr1, arr2, out, size1, row, size2 - row, column, end);
+        }
+#if defined(__AVX2__)
+        if constexpr (stream)
+            _mm_sfence();
+#endif
+    }
+}
+
+inline void apply_all(Span<const int> arr1, Span<const int> arr2, Span<int> out)
+{
+    if (out.size() != arr1.size() * arr2.size())
+        throw std::invalid_argument {"apply_all needs arr1.size() * arr2.size() ints to write to"};
+#if defined(__AVX2__)
+    if (out.size() * sizeof(int) > detail_apply_all::stream_bytes
+        && reinterpret_cast<std::uintptr_t>(out.data()) % 32 == 0 && arr1.size() % 8 == 0)
+    {
+        detail_apply_all::apply_all<true>(arr1.data(), arr1.size(), arr2.data(), arr2.size(), out.data());
+        return;
+    }
+#endif
+    detail_apply_all::apply_all<false>(arr1.data(), arr1.size(), arr2.data(), arr2.size(), out.data());
+}
+
+// the memory of the products of apply_all, kept from one call to the next
+class Apply_all_buffer
+{
+private:
+    // 8 ints more than the product, so that it can start on a 32 bytes boundary
+    std::vector<int> storage;
+
+    friend Span<int> apply_all(Span<const int> arr1, Span<const int> arr2, Apply_all_buffer& buffer);
+
+public:
+    Apply_all_buffer() = default;
+
+    explicit Apply_all_buffer(std::size_t capacity) { this->reserve(capacity); }
+
+    void reserve(std::size_t capacity)
+    {
+        if (this->storage.size() < capacity + 8)
+            this->storage.resize(capacity + 8);
+    }
+
+    std::size_t capacity() const { return this->storage.empty() ? 0 : this->storage.size() - 8; }
+};
+
+inline Span<int> apply_all(Span<const int> arr1, Span<const int> arr2, Apply_all_buffer& buffer)
+{
+    const std::size_t size = arr1.size() * arr2.size();
+    buffer.reserve(size);
+    int* first = buffer.storage.data();
+    while (reinterpret_cast<std::uintptr_t>(first) % 32 != 0)
+        ++first;
+    const Span<int> out {first, size};
+    apply_all(arr1, arr2, out);
+    return out;
+}
+
+#endif
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <vector>
+#include "Apply_all.h"
 
 void print(const int *const p, const size_t size)
 {
@@ -42,5 +44,19 @@ int main()
 
   delete [] ptr;
 
+  // the same products to an array of the caller and to a buffer kept between the calls, no new
+  int products[arr1_size * arr2_size] {};
+  apply_all(arr1, arr2, products);
+
+  std::cout << "products is: ";
+  print(products, ptr_size);
+
+  Apply_all_buffer buffer;
+  std::vector<int> arr3 {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  Span<int> squares {apply_all(arr3, arr3, buffer)};
+
+  std::cout << "squares is: ";
+  print(squares.data(), squares.size());
+
   return 0;
 }
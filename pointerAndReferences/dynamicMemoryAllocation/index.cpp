@@ -19,6 +19,9 @@
 
   the pointer itself is store in stack.
 
+  ../memoryResources has the same allocations from a memory resource, an arena or a pool,
+  instead of new and delete, for many small objects.
+
 */
 
 #include <iostream>
@@ -0,0 +1,393 @@
+#ifndef _MEMORY_RESOURCES_H_
+#define _MEMORY_RESOURCES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "../../smartPointers/challenge/Shared_pool.h"
+
+/*
+
+    - three std::pmr::memory_resource, for the new int and new int[n] of
+      dynamicMemoryAllocation and returningPointerFromFunction and for the std::pmr
+      containers of the other examples, e.g.
+        Monotonic_arena arena;
+        std::pmr::vector<int> numbers {&arena};
+
+    - Monotonic_arena hands out the memory of a buffer, the one it is given or chunks of the
+      upstream resource, twice as big as the one before, one after the other, an allocation
+      is a pointer that is moved forward and a deallocate does nothing, release() gives all
+      of it back at once. it is for one thread, and for the objects of one request, one
+      frame, one parse, that end together.
+
+    - Fixed_pool_resource<Block_size> hands out blocks of Block_size bytes of the Block_pool
+      of Shared_pool.h, each thread has a cache of free blocks of its own and takes and gives
+      them back to the shared list batch at a time, so most allocations and deallocations
+      are a pop and a push of a list of the thread, no lock. an allocation of more than
+      Block_size bytes, or of a bigger alignment, is one of the upstream resource. the
+      blocks stay with the pool until the program ends, like the ones of make_pooled, and
+      the fixed pools of the same Block_size, in the whole program, share them.
+
+    - Size_class_resource rounds every allocation up to a size class, 16 bytes apart up to
+      256 and powers of 2 up to 4096, and takes it from the free list of its class, with a
+      cache of every thread like a Block_pool, the caches of the classes are one array of the
+      thread, indexed by the class. it is the general allocator for allocations of any size
+      on any thread, the bigger ones are from the upstream resource.
+
+    - the default upstream is std::pmr::get_default_resource(), operator new.
+
+*/
+namespace detail_resources
+{
+    inline constexpr std::size_t max_align = alignof(std::max_align_t);
+    inline constexpr std::size_t num_small_classes = 16;
+    inline constexpr std::size_t num_classes = num_small_classes + 4;
+    inline constexpr std::size_t max_class_size = 4096;
+
+    constexpr std::size_t class_size(std::size_t index)
+    {
+        return index < num_small_classes ? (index + 1) * 16 : std::size_t {512} << (index - num_small_classes);
+    }
+
+    // the smallest class of size bytes, size is 1 to max_class_size
+    inline std::size_t class_of(std::size_t size)
+    {
+        if (size <= class_size(num_small_classes - 1))
+            return size == 0 ? 0 : (size - 1) / 16;
+        const int log2 = 64 - __builtin_clzll(static_cast<unsigned long long>(size - 1));
+        return num_small_classes + static_cast<std::size_t>(log2) - 9;
+    }
+
+    inline std::uintptr_t align_up(std::uintptr_t p, std::size_t align)
+    {
+        return (p + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+    }
+
+    using Free_block = detail_pool::Free_block;
+
+    struct Class_list
+    {
+        Free_block* head;
+        std::size_t count;
+    };
+
+    // the free blocks of every class, the ones the threads gave back, and the chunks
+    struct Shared_classes
+    {
+        std::mutex mutex;
+        Class_list lists[num_classes] {};
+        std::vector<void*> chunks;
+    };
+
+    // trivially destructible, so it is still there for a block freed while the thread ends
+    struct Class_caches
+    {
+        Class_list lists[num_classes];
+        bool gone;
+    };
+
+    // never destroyed, the chunks are reachable until the end
+    inline Shared_classes& shared_classes()
+    {
+        static Shared_classes* const shared = new Shared_classes;
+        return *shared;
+    }
+
+    inline void give_back(Class_list& cache, std::size_t index, std::size_t count)
+    {
+        if (count == 0)
+            return;
+        Free_block* const first = cache.head;
+        cache.head = detail_pool::split(first, count);
+        cache.count -= count;
+        Free_block* last = first;
+        while (last->next != nullptr)
+            last = last->next;
+        Shared_classes& s = shared_classes();
+        std::lock_guard<std::mutex> lock {s.mutex};
+        last->next = s.lists[index].head;
+        s.lists[index].head = first;
+        s.lists[index].count += count;
+    }
+
+    inline void refill(Class_list& cache, std::size_t index)
+    {
+        Shared_classes& s = shared_classes();
+        std::lock_guard<std::mutex> lock {s.mutex};
+        Class_list& shared = s.lists[index];
+        if (shared.head != nullptr)
+        {
+            const std::size_t count = shared.count < detail_pool::batch ? shared.count : detail_pool::batch;
+            cache.head = shared.head;
+            shared.head = detail_pool::split(shared.head, count);
+            shared.count -= count;
+            cache.count = count;
+            return;
+        }
+        void* const chunk = ::operator new(detail_pool::chunk_bytes, std::align_val_t {max_align});
+        s.chunks.push_back(chunk);
+        const std::size_t size = class_size(index);
+        const std::size_t count = detail_pool::chunk_bytes / size;
+        unsigned char* const bytes = static_cast<unsigned char*>(chunk);
+        for (std::size_t i = count; i-- > 0;)
+        {
+            Free_block* const block = reinterpret_cast<Free_block*>(bytes + i * size);
+            block->next = cache.head;
+            cache.head = block;
+        }
+        cache.count = count;
+    }
+
+    // gives the blocks of the thread back when it ends
+    struct Class_reaper
+    {
+        Class_caches& caches;
+
+        ~Class_reaper()
+        {
+            for (std::size_t index = 0; index < num_classes; ++index)
+                give_back(this->caches.lists[index], index, this->caches.lists[index].count);
+            this->caches.gone = true;
+        }
+    };
+
+    inline Class_caches& class_caches()
+    {
+        static thread_local Class_caches caches {};
+        static thread_local Class_reaper reaper {caches};
+        (void)reaper;
+        return caches;
+    }
+
+    // the lists of the thread are one array, the class picks the list, not a function
+    inline void* allocate_class(std::size_t index)
+    {
+        Class_caches& caches = class_caches();
+        if (caches.gone)
+        {
+            Shared_classes& s = shared_classes();
+            std::lock_guard<std::mutex> lock {s.mutex};
+            Class_list& shared = s.lists[index];
+            if (shared.head != nullptr)
+            {
+                Free_block* const block = shared.head;
+                shared.head = block->next;
+                --shared.count;
+                return block;
+            }
+            return ::operator new(class_size(index), std::align_val_t {max_align});
+        }
+        Class_list& cache = caches.lists[index];
+        if (cache.head == nullptr)
+            refill(cache, index);
+        Free_block* const block = cache.head;
+        cache.head = block->next;
+        --cache.count;
+        return block;
+    }
+
+    inline void deallocate_class(void* p, std::size_t index)
+    {
+        Class_caches& caches = class_caches();
+        Free_block* const block = static_cast<Free_block*>(p);
+        if (caches.gone)
+        {
+            Shared_classes& s = shared_classes();
+            std::lock_guard<std::mutex> lock {s.mutex};
+            block->next = s.lists[index].head;
+            s.lists[index].head = block;
+            ++s.lists[index].count;
+            return;
+        }
+        Class_list& cache = caches.lists[index];
+        block->next = cache.head;
+        cache.head = block;
+        if (++cache.count > 2 * detail_pool::batch)
+            give_back(cache, index, detail_pool::batch);
+    }
+}
+
+class Monotonic_arena : public std::pmr::memory_resource
+{
+private:
+    struct Chunk
+    {
+        Chunk* next;
+        std::size_t size;
+    };
+
+    unsigned char* const buffer;
+    const std::size_t buffer_size;
+    std::pmr::memory_resource* const upstream;
+    const std::size_t initial_size;
+    std::size_t next_size;
+    Chunk* chunks {nullptr};
+    unsigned char* next;
+    unsigned char* end;
+
+    void grow(std::size_t bytes, std::size_t align)
+    {
+        std::size_t size = this->next_size;
+        while (size < sizeof(Chunk) + bytes + align)
+            size *= 2;
+        Chunk* const chunk = static_cast<Chunk*>(this->upstream->allocate(size, detail_resources::max_align));
+        chunk->next = this->chunks;
+        chunk->size = size;
+        this->chunks = chunk;
+        this->next = reinterpret_cast<unsigned char*>(chunk + 1);
+        this->end = reinterpret_cast<unsigned char*>(chunk) + size;
+        this->next_size = size * 2;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        std::uintptr_t p = detail_resources::align_up(reinterpret_cast<std::uintptr_t>(this->next), align);
+        if (p + bytes > reinterpret_cast<std::uintptr_t>(this->end) || p < reinterpret_cast<std::uintptr_t>(this->next))
+        {
+            this->grow(bytes, align);
+            p = detail_resources::align_up(reinterpret_cast<std::uintptr_t>(this->next), align);
+        }
+        this->next = reinterpret_cast<unsigned char*>(p + bytes);
+        return reinterpret_cast<void*>(p);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    // the first chunk is initial_size bytes, allocated by the first allocation
+    explicit Monotonic_arena(std::size_t initial_size = 4096,
+                             std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : buffer(nullptr), buffer_size(0), upstream(upstream), initial_size(initial_size < 64 ? 64 : initial_size),
+          next_size(this->initial_size), next(nullptr), end(nullptr) {}
+
+    // the buffer first, a buffer on the stack for the usual size and chunks for a bigger one
+    Monotonic_arena(void* buffer, std::size_t size,
+                    std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : buffer(static_cast<unsigned char*>(buffer)), buffer_size(size), upstream(upstream),
+          initial_size(size < 64 ? 64 : size), next_size(this->initial_size),
+          next(this->buffer), end(this->buffer + size) {}
+
+    Monotonic_arena(const Monotonic_arena&) = delete;
+    Monotonic_arena& operator=(const Monotonic_arena&) = delete;
+
+    ~Monotonic_arena() override
+    {
+        this->release();
+    }
+
+    // every allocation is gone, the chunks go back to upstream and the buffer is used again
+    void release() noexcept
+    {
+        while (this->chunks != nullptr)
+        {
+            Chunk* const chunk = this->chunks;
+            this->chunks = chunk->next;
+            this->upstream->deallocate(chunk, chunk->size, detail_resources::max_align);
+        }
+        this->next_size = this->initial_size;
+        this->next = this->buffer;
+        this->end = this->buffer + this->buffer_size;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept
+    {
+        return this->upstream;
+    }
+};
+
+template <std::size_t Block_size, std::size_t Align = detail_resources::max_align>
+class Fixed_pool_resource : public std::pmr::memory_resource
+{
+private:
+    using Pool = Block_pool<Block_size, Align>;
+
+    std::pmr::memory_resource* const upstream;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        if (bytes <= Block_size && align <= Pool::align)
+            return Pool::allocate();
+        return this->upstream->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+    {
+        if (bytes <= Block_size && align <= Pool::align)
+            Pool::deallocate(p);
+        else
+            this->upstream->deallocate(p, bytes, align);
+    }
+
+    // the blocks are of the one pool of Block_size, a pool frees the blocks of another one
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        const Fixed_pool_resource* const pool = dynamic_cast<const Fixed_pool_resource*>(&other);
+        return pool != nullptr && pool->upstream->is_equal(*this->upstream);
+    }
+
+public:
+    static constexpr std::size_t block_size = Pool::block_size;
+
+    explicit Fixed_pool_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream(upstream) {}
+
+    std::pmr::memory_resource* upstream_resource() const noexcept
+    {
+        return this->upstream;
+    }
+};
+
+class Size_class_resource : public std::pmr::memory_resource
+{
+private:
+    std::pmr::memory_resource* const upstream;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        if (bytes <= detail_resources::max_class_size && align <= detail_resources::max_align)
+            return detail_resources::allocate_class(detail_resources::class_of(bytes));
+        return this->upstream->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+    {
+        if (bytes <= detail_resources::max_class_size && align <= detail_resources::max_align)
+            detail_resources::deallocate_class(p, detail_resources::class_of(bytes));
+        else
+            this->upstream->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        const Size_class_resource* const resource = dynamic_cast<const Size_class_resource*>(&other);
+        return resource != nullptr && resource->upstream->is_equal(*this->upstream);
+    }
+
+public:
+    explicit Size_class_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream(upstream) {}
+
+    // the bytes an allocation of size bytes takes, its class, or size when it is from upstream
+    static std::size_t allocated_size(std::size_t size) noexcept
+    {
+        return size <= detail_resources::max_class_size ? detail_resources::class_size(detail_resources::class_of(size)) : size;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept
+    {
+        return this->upstream;
+    }
+};
+
+#endif
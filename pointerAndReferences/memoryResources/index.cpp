@@ -0,0 +1,93 @@
+/*
+
+  - the new int and new double[size] of dynamicMemoryAllocation, from a memory resource,
+    and std::pmr containers on the three of Memory_resources.h, built with:
+      g++ -std=c++17 -O2 -pthread index.cpp
+
+  - a memory resource is asked for the bytes and the alignment, and the same two are given
+    back to deallocate them, an object is still made with placement new on the memory and
+    destroyed by calling its destructor, std::pmr::polymorphic_allocator does both for the
+    containers.
+
+*/
+
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Memory_resources.h"
+
+int *create_arr(std::pmr::memory_resource *resource, const size_t size, const int initial_val = 0)
+{
+  int *new_storage = static_cast<int *>(resource->allocate(sizeof(int) * size, alignof(int)));
+
+  for (size_t i {0}; i < size; i++)
+    new (new_storage + i) int {initial_val};
+
+  return new_storage;
+}
+
+void display(const int *const arr, size_t size)
+{
+  for (size_t i {0}; i < size; i++)
+    std::cout << *(arr + i) << " ";
+  std::cout << std::endl;
+}
+
+int main()
+{
+  // the buffer of the arena is on the stack, nothing comes from the heap while it is enough
+  unsigned char buffer[1024];
+  Monotonic_arena arena {buffer, sizeof(buffer)};
+
+  int *int_ptr = new (arena.allocate(sizeof(int), alignof(int))) int {100};
+  std::cout << "a variable with address: " << int_ptr << " in the arena has " << *int_ptr << " value." << std::endl;
+
+  int *arr_ptr = create_arr(&arena, 10, 7);
+  display(arr_ptr, 10);
+
+  // a deallocate of the arena does nothing, release() frees all of them at once
+  arena.release();
+  std::cout << "released." << std::endl << std::endl;
+
+  {
+    Monotonic_arena words_arena;
+    std::pmr::vector<std::pmr::string> words {&words_arena};
+    for (const char *word : {"the strings of the vector are in the arena too", "short", "and this one as well"})
+      words.emplace_back(word);
+    for (const std::pmr::string &word : words)
+      std::cout << word << std::endl;
+  }
+
+  // every node of the list and of the map is a block of a pool, on every thread
+  Fixed_pool_resource<64> nodes;
+  Size_class_resource general;
+  std::pmr::list<int> numbers {&nodes};
+  std::pmr::map<int, std::pmr::string> names {&general};
+
+  std::thread worker {[&] {
+    for (int i = 0; i < 1000; i++)
+      numbers.push_back(i);
+  }};
+  worker.join();
+  for (int i = 0; i < 5; i++)
+    names.emplace(i, "name number " + std::to_string(i) + " of the map");
+
+  long sum {0};
+  for (int n : numbers)
+    sum += n;
+  std::cout << std::endl << "sum of the list: " << sum << ", block of a node: " << Fixed_pool_resource<64>::block_size << " bytes" << std::endl;
+  for (const auto &[key, name] : names)
+    std::cout << key << ": " << name << std::endl;
+
+  std::cout << "the size classes of 1, 17, 200, 300 and 5000 bytes: ";
+  for (std::size_t size : {1, 17, 200, 300, 5000})
+    std::cout << Size_class_resource::allocated_size(size) << " ";
+  std::cout << std::endl;
+
+  return 0;
+}
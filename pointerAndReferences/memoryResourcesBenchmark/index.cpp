@@ -0,0 +1,153 @@
+/*
+
+    - compares malloc and free with the memory resources of ../memoryResources, and with
+      std::pmr::synchronized_pool_resource, on allocations of 16 to 256 bytes by 1 to 32
+      threads, every thread allocates a batch of 64 of random sizes, writes them and frees
+      them, in the order they were allocated, the arena releases the batch instead.
+
+    - malloc, new_delete_resource, the synchronized pool and the pools of Memory_resources.h
+      are one for all the threads, a Monotonic_arena is for one thread, every thread has its
+      own one.
+
+    - the time is the one of all the threads, from the start of the first one to the end of
+      the last one, over all the allocations of all of them, in ns per allocation and free,
+      the same work is split between 1 and 32 threads, with as many cores as threads a time
+      that goes down is one that scales.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp
+
+    - 4'000'000 allocations by default, the number can be given on the command line, e.g.
+      ./a.out 1000000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../memoryResources/Memory_resources.h"
+
+constexpr std::size_t batch {64};
+
+struct Malloc_family
+{
+    void* allocate(std::size_t size) { return std::malloc(size); }
+    void deallocate(void* p, std::size_t) { std::free(p); }
+    void end_batch() {}
+};
+
+// a resource of all the threads
+struct Shared_family
+{
+    std::pmr::memory_resource* resource;
+    void* allocate(std::size_t size) { return this->resource->allocate(size, 16); }
+    void deallocate(void* p, std::size_t size) { this->resource->deallocate(p, size, 16); }
+    void end_batch() {}
+};
+
+// an arena of every thread, released after every batch
+struct Arena_family
+{
+    Monotonic_arena arena {batch * 256 * 2};
+    void* allocate(std::size_t size) { return this->arena.allocate(size, 16); }
+    void deallocate(void*, std::size_t) {}
+    void end_batch() { this->arena.release(); }
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Family>
+std::uint64_t work(Family& family, std::size_t allocations, std::uint64_t seed)
+{
+    void* pointers[batch];
+    std::size_t sizes[batch];
+    std::uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+    std::uint64_t sum {0};
+    for (std::size_t done = 0; done < allocations; done += batch)
+    {
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            sizes[i] = 16 + state % 241;
+            unsigned char* const p = static_cast<unsigned char*>(family.allocate(sizes[i]));
+            p[0] = static_cast<unsigned char>(i);
+            p[sizes[i] - 1] = static_cast<unsigned char>(sizes[i]);
+            pointers[i] = p;
+        }
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            const unsigned char* const p = static_cast<unsigned char*>(pointers[i]);
+            sum += p[0] + p[sizes[i] - 1];
+            family.deallocate(pointers[i], sizes[i]);
+        }
+        family.end_batch();
+    }
+    return sum;
+}
+
+// ns per allocation of make() families on num_threads threads, the best of rounds
+template <typename Make>
+void run(const std::string& name, std::size_t n, int num_threads, Make make)
+{
+    constexpr int rounds {5};
+    double best {0};
+    std::uint64_t checksum {0};
+    const std::size_t per_thread = n / static_cast<std::size_t>(num_threads) / batch * batch;
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::vector<std::uint64_t> sums(static_cast<std::size_t>(num_threads));
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < num_threads; ++t)
+            threads.emplace_back([&, t] {
+                auto family = make();
+                sums[static_cast<std::size_t>(t)] = work(family, per_thread, static_cast<std::uint64_t>(t) + 1);
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+        const double seconds = seconds_since(start);
+        best = round == 0 ? seconds : std::min(best, seconds);
+        checksum = 0;
+        for (std::uint64_t sum : sums)
+            checksum += sum;
+    }
+    std::cout << std::setw(40) << std::left << name << std::setw(8) << std::right << num_threads
+        << std::fixed << std::setprecision(2) << std::setw(10) << best * 1e9 / (per_thread * num_threads)
+        << std::setw(16) << checksum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4'000'000;
+
+    std::pmr::synchronized_pool_resource synchronized_pool;
+    Fixed_pool_resource<256> fixed_pool;
+    Size_class_resource size_classes;
+
+    std::cout << std::setw(40) << std::left << "ns per allocation" << std::setw(8) << std::right << "threads"
+        << std::setw(10) << "" << std::setw(16) << "checksum" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16, 32})
+    {
+        run("malloc", n, threads, [] { return Malloc_family {}; });
+        run("new_delete_resource", n, threads, [] { return Shared_family {std::pmr::new_delete_resource()}; });
+        run("synchronized_pool_resource", n, threads, [&] { return Shared_family {&synchronized_pool}; });
+        run("Fixed_pool_resource<256>", n, threads, [&] { return Shared_family {&fixed_pool}; });
+        run("Size_class_resource", n, threads, [&] { return Shared_family {&size_classes}; });
+        run("Monotonic_arena, one per thread", n, threads, [] { return Arena_family {}; });
+    }
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+#ifndef _STRIDED_VIEWS_H_
+#define _STRIDED_VIEWS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "../../functions/passingArrayToFunction/Span.h"
+
+/*
+
+    - the p + i of index.cpp with steps that are not one element, as iterators, so that the
+      algorithms of the standard library, std::accumulate, std::find_if, std::transform, ...
+      run on the data where it is, with no copy of it into a vector of its own:
+
+        - Strided_iterator<T> steps a number of bytes that is known when the program runs,
+          a column of a matrix stored by rows, or one member of an array of structs,
+          member_view(points, size, &Point::x) is the x of every point
+        - Gather_iterator<T> is base[indices[i]], the elements of an array in the order of
+          an array of their indices, a selection or a permutation
+        - Prefetching_iterator<It> is It that asks the cache for the element distance steps
+          ahead of the one it moves to, __builtin_prefetch, so that it is there when it is
+          wanted, a hint that does no harm when it is wrong and is never past the end
+        - Chunked_view<T, N> is an array as a head, blocks of N elements whose address is a
+          multiple of N * sizeof(T), and a tail, a loop over a block has a size and an
+          alignment the compiler knows and vectorizes with aligned loads
+
+    - the hardware prefetcher follows a stream of contiguous lines and small strides but not
+      a stride of more than a few lines, or one that crosses a page on every step, nor the
+      addresses of a gather, the software prefetch is for those, the distance is the steps
+      that take about as long as a miss, 8 to 32. on a contiguous array it only adds work.
+
+    - the views are a View<It>, a begin and an end for a range for, of an array the caller
+      owns and that has to outlive them, strided(first, count, stride) and the others take
+      a pointer to the first element and how many there are. a stride can be negative and
+      can not be 0.
+
+*/
+template <typename It>
+struct View
+{
+    It first;
+    It last;
+
+    It begin() const { return this->first; }
+    It end() const { return this->last; }
+    std::size_t size() const { return static_cast<std::size_t>(std::distance(this->first, this->last)); }
+    bool empty() const { return this->first == this->last; }
+};
+
+template <typename T>
+class Strided_iterator
+{
+private:
+    using Byte = std::conditional_t<std::is_const_v<T>, const unsigned char, unsigned char>;
+
+    T* current {nullptr};
+    // in bytes
+    std::ptrdiff_t stride {sizeof(T)};
+
+    static T* advance(T* p, std::ptrdiff_t bytes) { return reinterpret_cast<T*>(reinterpret_cast<Byte*>(p) + bytes); }
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Strided_iterator() = default;
+    Strided_iterator(T* current, std::ptrdiff_t stride_bytes) : current(current), stride(stride_bytes) {}
+
+    T* address() const { return this->current; }
+    std::ptrdiff_t stride_bytes() const { return this->stride; }
+
+    T& operator*() const { return *this->current; }
+    T* operator->() const { return this->current; }
+    T& operator[](std::ptrdiff_t n) const { return *advance(this->current, n * this->stride); }
+
+    Strided_iterator& operator++() { this->current = advance(this->current, this->stride); return *this; }
+    Strided_iterator& operator--() { this->current = advance(this->current, -this->stride); return *this; }
+    Strided_iterator operator++(int) { Strided_iterator before {*this}; ++*this; return before; }
+    Strided_iterator operator--(int) { Strided_iterator before {*this}; --*this; return before; }
+    Strided_iterator& operator+=(std::ptrdiff_t n) { this->current = advance(this->current, n * this->stride); return *this; }
+    Strided_iterator& operator-=(std::ptrdiff_t n) { return *this += -n; }
+
+    friend Strided_iterator operator+(Strided_iterator it, std::ptrdiff_t n) { return it += n; }
+    friend Strided_iterator operator+(std::ptrdiff_t n, Strided_iterator it) { return it += n; }
+    friend Strided_iterator operator-(Strided_iterator it, std::ptrdiff_t n) { return it -= n; }
+
+    // of two iterators of the same stride over the same array
+    friend std::ptrdiff_t operator-(const Strided_iterator& a, const Strided_iterator& b)
+    {
+        return (reinterpret_cast<Byte*>(a.current) - reinterpret_cast<Byte*>(b.current)) / a.stride;
+    }
+
+    friend bool operator==(const Strided_iterator& a, const Strided_iterator& b) { return a.current == b.current; }
+    friend bool operator!=(const Strided_iterator& a, const Strided_iterator& b) { return a.current != b.current; }
+    friend bool operator<(const Strided_iterator& a, const Strided_iterator& b) { return b - a > 0; }
+    friend bool operator>(const Strided_iterator& a, const Strided_iterator& b) { return b < a; }
+    friend bool operator<=(const Strided_iterator& a, const Strided_iterator& b) { return !(b < a); }
+    friend bool operator>=(const Strided_iterator& a, const Strided_iterator& b) { return !(a < b); }
+};
+
+template <typename T, typename Index = std::size_t>
+class Gather_iterator
+{
+private:
+    T* base {nullptr};
+    const Index* index {nullptr};
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Gather_iterator() = default;
+    Gather_iterator(T* base, const Index* index) : base(base), index(index) {}
+
+    T& operator*() const { return this->base[*this->index]; }
+    T* operator->() const { return this->base + *this->index; }
+    T& operator[](std::ptrdiff_t n) const { return this->base[this->index[n]]; }
+
+    Gather_iterator& operator++() { ++this->index; return *this; }
+    Gather_iterator& operator--() { --this->index; return *this; }
+    Gather_iterator operator++(int) { Gather_iterator before {*this}; ++this->index; return before; }
+    Gather_iterator operator--(int) { Gather_iterator before {*this}; --this->index; return before; }
+    Gather_iterator& operator+=(std::ptrdiff_t n) { this->index += n; return *this; }
+    Gather_iterator& operator-=(std::ptrdiff_t n) { this->index -= n; return *this; }
+
+    friend Gather_iterator operator+(Gather_iterator it, std::ptrdiff_t n) { return it += n; }
+    friend Gather_iterator operator+(std::ptrdiff_t n, Gather_iterator it) { return it += n; }
+    friend Gather_iterator operator-(Gather_iterator it, std::ptrdiff_t n) { return it -= n; }
+    friend std::ptrdiff_t operator-(const Gather_iterator& a, const Gather_iterator& b) { return a.index - b.index; }
+
+    friend bool operator==(const Gather_iterator& a, const Gather_iterator& b) { return a.index == b.index; }
+    friend bool operator!=(const Gather_iterator& a, const Gather_iterator& b) { return a.index != b.index; }
+    friend bool operator<(const Gather_iterator& a, const Gather_iterator& b) { return a.index < b.index; }
+    friend bool operator>(const Gather_iterator& a, const Gather_iterator& b) { return a.index > b.index; }
+    friend bool operator<=(const Gather_iterator& a, const Gather_iterator& b) { return a.index <= b.index; }
+    friend bool operator>=(const Gather_iterator& a, const Gather_iterator& b) { return a.index >= b.index; }
+};
+
+// It is a random access iterator whose operator* is a reference to an element in memory
+template <typename It>
+class Prefetching_iterator
+{
+private:
+    It current {};
+    It last {};
+    std::ptrdiff_t distance {0};
+
+    void prefetch() const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        if (this->last - this->current > this->distance)
+            __builtin_prefetch(std::addressof(this->current[this->distance]));
+#endif
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using pointer = typename std::iterator_traits<It>::pointer;
+    using reference = typename std::iterator_traits<It>::reference;
+
+    Prefetching_iterator() = default;
+    Prefetching_iterator(It current, It last, std::ptrdiff_t distance) : current(current), last(last), distance(distance)
+    {
+        this->prefetch();
+    }
+
+    It base() const { return this->current; }
+
+    reference operator*() const { return *this->current; }
+    pointer operator->() const { return std::addressof(*this->current); }
+
+    Prefetching_iterator& operator++()
+    {
+        ++this->current;
+        this->prefetch();
+        return *this;
+    }
+
+    Prefetching_iterator operator++(int) { Prefetching_iterator before {*this}; ++*this; return before; }
+
+    friend bool operator==(const Prefetching_iterator& a, const Prefetching_iterator& b) { return a.current == b.current; }
+    friend bool operator!=(const Prefetching_iterator& a, const Prefetching_iterator& b) { return a.current != b.current; }
+};
+
+template <typename T, std::size_t N, std::size_t Alignment = N * sizeof(T)>
+class Chunked_view
+{
+    static_assert(N > 0, "a block has at least one element");
+    static_assert((Alignment & (Alignment - 1)) == 0 && Alignment % alignof(T) == 0,
+                  "the alignment of a block is a power of 2 and a multiple of the one of T");
+
+private:
+    T* first {nullptr};
+    T* blocks_first {nullptr};
+    T* blocks_last {nullptr};
+    T* last {nullptr};
+
+public:
+    static constexpr std::size_t block_size = N;
+    static constexpr std::size_t alignment = Alignment;
+
+    // the address of the block it is at, aligned
+    class Block_iterator
+    {
+    private:
+        T* current {nullptr};
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T**;
+        using reference = T*;
+
+        Block_iterator() = default;
+        explicit Block_iterator(T* current) : current(current) {}
+
+        T* operator*() const
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<T*>(__builtin_assume_aligned(this->current, Alignment));
+#else
+            return this->current;
+#endif
+        }
+
+        Block_iterator& operator++() { this->current += N; return *this; }
+        Block_iterator operator++(int) { Block_iterator before {*this}; this->current += N; return before; }
+
+        friend bool operator==(const Block_iterator& a, const Block_iterator& b) { return a.current == b.current; }
+        friend bool operator!=(const Block_iterator& a, const Block_iterator& b) { return a.current != b.current; }
+    };
+
+    Chunked_view() = default;
+
+    // first is aligned to alignof(T)
+    Chunked_view(T* first, std::size_t count) : first(first), last(first + count)
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(first);
+        const std::size_t head = ((Alignment - address % Alignment) % Alignment) / sizeof(T);
+        const std::size_t blocks = count > head ? (count - head) / N : 0;
+        this->blocks_first = first + std::min(head, count);
+        this->blocks_last = this->blocks_first + blocks * N;
+    }
+
+    Span<T> head() const { return Span<T> {this->first, static_cast<std::size_t>(this->blocks_first - this->first)}; }
+    Span<T> tail() const { return Span<T> {this->blocks_last, static_cast<std::size_t>(this->last - this->blocks_last)}; }
+    std::size_t num_blocks() const { return static_cast<std::size_t>(this->blocks_last - this->blocks_first) / N; }
+
+    View<Block_iterator> blocks() const { return View<Block_iterator> {Block_iterator {this->blocks_first}, Block_iterator {this->blocks_last}}; }
+};
+
+// every stride-th element from first, stride in elements
+template <typename T>
+View<Strided_iterator<T>> strided(T* first, std::size_t count, std::ptrdiff_t stride)
+{
+    const std::ptrdiff_t bytes = stride * static_cast<std::ptrdiff_t>(sizeof(T));
+    const Strided_iterator<T> begin {first, bytes};
+    return View<Strided_iterator<T>> {begin, begin + static_cast<std::ptrdiff_t>(count)};
+}
+
+// the member of count structs from first, a column of an array of structs
+template <typename S, typename M>
+View<Strided_iterator<M>> member_view(S* first, std::size_t count, M S::*member)
+{
+    const Strided_iterator<M> begin {std::addressof(first->*member), static_cast<std::ptrdiff_t>(sizeof(S))};
+    return View<Strided_iterator<M>> {begin, begin + static_cast<std::ptrdiff_t>(count)};
+}
+
+template <typename S, typename M>
+View<Strided_iterator<const M>> member_view(const S* first, std::size_t count, M S::*member)
+{
+    const Strided_iterator<const M> begin {std::addressof(first->*member), static_cast<std::ptrdiff_t>(sizeof(S))};
+    return View<Strided_iterator<const M>> {begin, begin + static_cast<std::ptrdiff_t>(count)};
+}
+
+// base[indices[0]], ..., base[indices[count - 1]]
+template <typename T, typename Index>
+View<Gather_iterator<T, Index>> gather(T* base, const Index* indices, std::size_t count)
+{
+    return View<Gather_iterator<T, Index>> {Gather_iterator<T, Index> {base, indices}, Gather_iterator<T, Index> {base, indices + count}};
+}
+
+template <typename It>
+View<Prefetching_iterator<It>> prefetching(View<It> view, std::ptrdiff_t distance)
+{
+    return View<Prefetching_iterator<It>> {Prefetching_iterator<It> {view.first, view.last, distance},
+                                           Prefetching_iterator<It> {view.last, view.last, distance}};
+}
+
+template <typename T>
+View<Prefetching_iterator<T*>> prefetching(T* first, std::size_t count, std::ptrdiff_t distance)
+{
+    return prefetching(View<T*> {first, first + count}, distance);
+}
+
+template <std::size_t N, typename T>
+Chunked_view<T, N> chunked(T* first, std::size_t count)
+{
+    return Chunked_view<T, N> {first, count};
+}
+
+#endif
@@ -1,5 +1,22 @@
+/*
+
+  - the pointer arithmetic of a tutorial, then the same steps as the iterators of
+    Strided_views.h: every third score, the x of an array of points, the scores in the order
+    of their indices, and an array as aligned blocks of 4 and the rest, built with:
+      g++ -std=c++17 -O2 index.cpp
+
+*/
+
 #include <iostream>
+#include <numeric>
 #include <string>
+#include "Strided_views.h"
+
+struct Point
+{
+  double x;
+  double y;
+};
 
 int main()
 {
@@ -37,5 +54,31 @@ int main()
   std::cout << "In the string " << name << ", " << *char_ptr2 << " is " 
     << (char_ptr2 - char_ptr1) << " characters away from " << *char_ptr1 << std::endl;
 
+  int grades[] {90, 85, 70, 65, 60, 55, 50, 45, 40};
+  std::cout << std::endl << "every third grade:";
+  for (int grade : strided(grades, 3, 3))
+    std::cout << " " << grade;
+  std::cout << std::endl;
+
+  const Point points[] {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+  const auto xs = member_view(points, 3, &Point::x);
+  std::cout << "the sum of the x of the points: " << std::accumulate(xs.begin(), xs.end(), 0.0) << std::endl;
+
+  const std::size_t order[] {8, 0, 4};
+  std::cout << "grades 8, 0 and 4:";
+  for (int grade : gather(grades, order, 3))
+    std::cout << " " << grade;
+  std::cout << std::endl;
+
+  const auto chunks = chunked<4>(grades + 1, 8);
+  std::cout << "grades 1 to 8 as " << chunks.head().size() << " before, " << chunks.num_blocks()
+    << " blocks of 4 and " << chunks.tail().size() << " after" << std::endl;
+
+  int in_blocks {0};
+  for (const int *block : chunks.blocks())
+    for (std::size_t i {0}; i < 4; i++)
+      in_blocks += block[i];
+  std::cout << "the sum of the blocks: " << in_blocks << std::endl;
+
   return 0;
 }
\ No newline at end of file
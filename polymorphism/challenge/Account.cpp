@@ -1,30 +1,20 @@
 #include "Account.h"
 
-Account::Account(const std::string name, const double balance)
+Account::Account(const std::string name, const Money balance)
   : name(name), balance(balance)
 {}
 
-bool Account::deposit(double amount)
+Money Account::get_balance() const
 {
-  if (amount >= 0) {
-    this->balance += amount;
-    return true;
-  }
-  else
-    return false;
+  return this->balance;
 }
 
-bool Account::withdraw(double amount)
+const std::string &Account::get_name() const
 {
-  if (this->balance - amount >= 0) {
-    this->balance -= amount;
-    return true;
-  }
-  else
-    return false;
+  return this->name;
 }
 
-double Account::get_balance() const
+std::uint32_t Account::get_version() const
 {
-  return this->balance;
+  return this->version;
 }
@@ -1,28 +1,68 @@
 #ifndef _ACCOUNT_H_
 #define _ACCOUNT_H_
 
+#include <cstdint>
 #include <iostream>
 #include "I_Printable.h"
+#include "Money.h"
 
 class Account: public I_Printable
 {
+  friend class Account_store;
+  friend struct Account_log;
+  friend class Shared_ledger;
+
 private:
   static constexpr const char *def_name = "Unnamed Account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
 
 protected:
   std::string name;
-  double balance;
+  Money balance;
+  std::uint32_t version {0};  // one more for every change, what a view of the account compares
 
 public:
-  Account(const std::string name = def_name, const double balance = def_balance);
+  Account(const std::string name = def_name, const Money balance = def_balance);
   
   virtual ~Account() = default;
 
-  virtual bool deposit(double amount) = 0;
-  virtual bool withdraw(double amount) = 0;
+  virtual bool deposit(Money amount) = 0;
+  virtual bool withdraw(Money amount) = 0;
   
-  double get_balance() const;
+  Money get_balance() const;
+  const std::string &get_name() const;
+  // changes whenever what the account prints does
+  std::uint32_t get_version() const;
 };
 
+/*
+
+  - deposit and withdraw are defined here, and in the headers of the derived classes, not in the
+    .cpp files, so a call on the exact type, one with the class named, a.Trust_account::deposit(x),
+    or one of Account_variant.h, is a direct call the compiler can inline, one through an
+    Account* still goes through the vtable.
+
+*/
+inline bool Account::deposit(Money amount)
+{
+  if (amount >= 0) {
+    this->balance += amount;
+    this->version++;
+    return true;
+  }
+  else
+    return false;
+}
+
+inline bool Account::withdraw(Money amount)
+{
+  if (this->balance - amount >= 0) {
+    this->balance -= amount;
+    this->version++;
+    return true;
+  }
+  else
+    return false;
+}
+
 #endif
@@ -0,0 +1,54 @@
+#include "Account_arena.h"
+
+Account_arena::Account_arena(std::size_t block_size)
+  : checking{block_size}, saving{block_size}, trust{block_size}
+{}
+
+Account *Account_arena::make_checking(const std::string &name, Money balance)
+{
+  return this->checking.create(name, balance);
+}
+
+Account *Account_arena::make_saving(const std::string &name, Money balance, double int_rate)
+{
+  return this->saving.create(name, balance, int_rate);
+}
+
+Account *Account_arena::make_trust(const std::string &name, Money balance, double int_rate)
+{
+  return this->trust.create(name, balance, int_rate);
+}
+
+std::vector<Account*> Account_arena::accounts() const
+{
+  std::vector<Account*> result;
+  result.reserve(this->size());
+
+  for (std::size_t i {0}; i < this->checking.size(); i++)
+    result.push_back(this->checking.at(i));
+  for (std::size_t i {0}; i < this->saving.size(); i++)
+    result.push_back(this->saving.at(i));
+  for (std::size_t i {0}; i < this->trust.size(); i++)
+    result.push_back(this->trust.at(i));
+
+  return result;
+}
+
+void Account_arena::clear()
+{
+  this->checking.clear();
+  this->saving.clear();
+  this->trust.clear();
+}
+
+std::size_t Account_arena::size() const
+{
+  return this->checking.size() + this->saving.size() + this->trust.size();
+}
+
+std::size_t Account_arena::get_block_allocations() const
+{
+  return this->checking.get_block_allocations() 
+    + this->saving.get_block_allocations() 
+    + this->trust.get_block_allocations();
+}
@@ -0,0 +1,121 @@
+#ifndef _ACCOUNT_ARENA_H_
+#define _ACCOUNT_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Account.h"
+#include "Checking_account.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+
+/*
+
+  - Arena_pool places objects of one type side by side in large blocks,
+    a block is only allocated when every slot of the previous ones is used.
+
+  - clear() destroys the objects but keeps the blocks, so refilling the pool
+    up to its previous size allocates nothing.
+
+*/
+template<typename T>
+class Arena_pool
+{
+private:
+  struct Slot
+  {
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  std::vector<std::unique_ptr<Slot[]>> blocks;
+  std::size_t block_size;
+  std::size_t used;
+  std::size_t block_allocations;
+
+public:
+  Arena_pool(std::size_t block_size)
+    : block_size{block_size == 0 ? 1 : block_size}, used{0}, block_allocations{0}
+  {}
+
+  Arena_pool(const Arena_pool &source) = delete;
+  Arena_pool &operator=(const Arena_pool &rhs) = delete;
+
+  ~Arena_pool()
+  {
+    this->clear();
+  }
+
+  template<typename... Args>
+  T *create(Args&&... args)
+  {
+    if (this->used == this->blocks.size() * this->block_size) {
+      this->blocks.emplace_back(new Slot[this->block_size]);
+      this->block_allocations++;
+    }
+
+    Slot &slot = this->blocks[this->used / this->block_size][this->used % this->block_size];
+    T *ptr = new (slot.bytes) T(std::forward<Args>(args)...);
+    this->used++;
+    return ptr;
+  }
+
+  void clear()
+  {
+    for (std::size_t i {0}; i < this->used; i++)
+      this->at(i)->~T();
+    this->used = 0;
+  }
+
+  T *at(std::size_t i) const
+  {
+    return std::launder(reinterpret_cast<T*>(this->blocks[i / this->block_size][i % this->block_size].bytes));
+  }
+
+  std::size_t size() const
+  {
+    return this->used;
+  }
+
+  std::size_t get_block_allocations() const
+  {
+    return this->block_allocations;
+  }
+};
+
+/*
+
+  - Account_arena is a factory for the three account types, every type has its
+    own pool so accounts of one type are contiguous in memory.
+
+  - the arena owns the accounts, they are destroyed together when it goes away,
+    so the pointers handed out must not be deleted.
+
+*/
+class Account_arena
+{
+private:
+  static constexpr std::size_t def_block_size = 4096;
+
+  Arena_pool<Checking_account> checking;
+  Arena_pool<Saving_account> saving;
+  Arena_pool<Trust_account> trust;
+
+public:
+  Account_arena(std::size_t block_size = def_block_size);
+
+  Account *make_checking(const std::string &name, Money balance = 0.0);
+  Account *make_saving(const std::string &name, Money balance = 0.0, double int_rate = 0.0);
+  Account *make_trust(const std::string &name, Money balance = 0.0, double int_rate = 0.0);
+
+  // every account in memory order: all checking, then saving, then trust accounts
+  std::vector<Account*> accounts() const;
+
+  void clear();
+  std::size_t size() const;
+  std::size_t get_block_allocations() const;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include "Account_batch.h"
+#include "../../algorithms/pipelines/Generator.h"
+
+static void fail(const std::string &path, std::uint64_t line_number, const std::string &what)
+{
+  throw std::runtime_error(path + ":" + std::to_string(line_number) + ": " + what);
+}
+
+// the field up to the next ',', or the rest of the line, and the line after it
+static std::string_view next_field(std::string_view &line)
+{
+  const std::size_t comma = line.find(',');
+  const std::string_view field = line.substr(0, comma);
+  line = comma == std::string_view::npos ? std::string_view {} : line.substr(comma + 1);
+  return field;
+}
+
+template<typename T>
+static bool parse_number(std::string_view text, T &value)
+{
+  const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+  return result.ec == std::errc {} && result.ptr == text.data() + text.size();
+}
+
+// "123.45", "123.4" or "123" as cents
+static bool parse_cents(std::string_view text, std::int64_t &cents)
+{
+  const std::size_t dot = text.find('.');
+  std::int64_t dollars {0};
+  // the cents of more dollars do not fit in an int64
+  if (!parse_number(text.substr(0, dot), dollars) || dollars < 0 || dollars > (INT64_MAX - 99) / 100)
+    return false;
+  std::int64_t fraction {0};
+  if (dot != std::string_view::npos) {
+    const std::string_view digits = text.substr(dot + 1);
+    if (digits.empty() || digits.size() > 2 || !parse_number(digits, fraction) || fraction < 0)
+      return false;
+    if (digits.size() == 1)
+      fraction *= 10;
+  }
+  cents = dollars * 100 + fraction;
+  return true;
+}
+
+std::size_t load_accounts(const std::string &path, Account_store &store)
+{
+  auto lines = pipeline::lines(path);
+  std::uint64_t line_number {0};
+  std::size_t count {0};
+  for (std::string_view line: lines) {
+    line_number++;
+    if (line.empty())
+      continue;
+    const std::string_view type = next_field(line);
+    const std::string_view name = next_field(line);
+    std::int64_t cents {0};
+    double int_rate {0};
+    if (!parse_cents(next_field(line), cents) || !parse_number(next_field(line), int_rate) || !line.empty())
+      fail(path, line_number, "not type,name,balance,int_rate");
+    // from_chars takes nan and inf, a rate of them makes every interest of the account NaN
+    if (!std::isfinite(int_rate))
+      fail(path, line_number, "the int_rate is not a finite number");
+
+    const Money balance = Money::from_cents(cents);
+    if (type == "Checking")
+      store.add_checking(std::string {name}, balance);
+    else if (type == "Saving")
+      store.add_saving(std::string {name}, balance, int_rate);
+    else if (type == "Trust")
+      store.add_trust(std::string {name}, balance, int_rate);
+    else
+      fail(path, line_number, "the type " + std::string {type} + " is not Checking, Saving or Trust");
+    count++;
+  }
+  return count;
+}
+
+Batch_report run_transactions(const std::string &path, Account_store &store)
+{
+  Batch_report report {0, 0, 0, 0, 0};
+  auto lines = pipeline::lines(path);
+  std::uint64_t line_number {0};
+  for (std::string_view line: lines) {
+    line_number++;
+    if (line.empty())
+      continue;
+    std::size_t account_id {0};
+    const bool has_id = parse_number(next_field(line), account_id);
+    const std::string_view op = next_field(line);
+    std::int64_t cents {0};
+    if (!has_id || (op != "D" && op != "W") || !parse_cents(next_field(line), cents) || !line.empty())
+      fail(path, line_number, "not account,D|W,amount");
+
+    const bool deposit = op == "D";
+    report.num_transactions++;
+    (deposit ? report.deposits : report.withdrawals)++;
+    if (!store.apply(Transaction {account_id, deposit ? Operation::Deposit : Operation::Withdraw, Money::from_cents(cents)}))
+      report.refused++;
+  }
+  report.total_balance = store.get_total_balance();
+  return report;
+}
@@ -0,0 +1,40 @@
+#ifndef _ACCOUNT_BATCH_H_
+#define _ACCOUNT_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Account_store.h"
+#include "Money.h"
+
+/*
+
+  - the batch mode of the challenge, the accounts and the transactions of files, the ones
+    tooling/datasets writes, run on an Account_store:
+      Checking,Account 1,6292.87,0.0        type,name,balance,int_rate
+      1,W,5637.47                           account,D|W,amount, the account is its line
+
+  - the files are read a line at a time with the lines of algorithms/pipelines, one buffer
+    of 64 KiB whatever their size, the transactions are applied as they are read, the memory
+    is the one of the accounts.
+
+  - an amount is dollars and up to 2 digits of cents, parsed to cents without a double. a
+    line that is not a record throws std::runtime_error with the path and its number, a
+    transaction of an account that is not there is refused like Account_store::apply does.
+
+*/
+struct Batch_report
+{
+  std::uint64_t num_transactions;
+  std::uint64_t deposits;
+  std::uint64_t withdrawals;
+  std::uint64_t refused;       // of both
+  Money total_balance;         // of every account after them
+};
+
+// adds the accounts of the file to the store, in the order of its lines, their number
+std::size_t load_accounts(const std::string &path, Account_store &store);
+
+Batch_report run_transactions(const std::string &path, Account_store &store);
+
+#endif
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <stdexcept>
+#include "Account_index.h"
+
+Account_index::Account_index(const std::vector<Account*> &accounts)
+  : accounts{nullptr}, mask{0}
+{
+  this->build(accounts);
+}
+
+// 64-bit FNV-1a
+std::uint64_t Account_index::hash(const char *str, std::size_t size)
+{
+  std::uint64_t h {14695981039346656037ull};
+  for (std::size_t i {0}; i < size; i++) {
+    h ^= static_cast<unsigned char>(str[i]);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+void Account_index::build(const std::vector<Account*> &accounts)
+{
+  if (accounts.size() >= empty)
+    throw std::length_error("Account_index supports at most 2^32 - 1 accounts");
+
+  // keep the load factor at or below one half
+  std::size_t capacity {16};
+  while (capacity < accounts.size() * 2)
+    capacity *= 2;
+
+  this->accounts = &accounts;
+  this->slots.assign(capacity, Slot {0, empty});
+  this->mask = capacity - 1;
+
+  for (std::size_t id {0}; id < accounts.size(); id++) {
+    const std::string &name = accounts[id]->get_name();
+    const std::uint64_t h = hash(name.data(), name.size());
+
+    std::size_t i = h & this->mask;
+    while (this->slots[i].id != empty 
+      && !(this->slots[i].hash == h && accounts[this->slots[i].id]->get_name() == name))
+      i = (i + 1) & this->mask;
+
+    if (this->slots[i].id == empty)
+      this->slots[i] = Slot {h, static_cast<std::uint32_t>(id)};
+  }
+}
+
+std::size_t Account_index::find(const std::string &name) const
+{
+  const std::uint64_t h = hash(name.data(), name.size());
+
+  for (std::size_t i = h & this->mask; this->slots[i].id != empty; i = (i + 1) & this->mask)
+    if (this->slots[i].hash == h && (*this->accounts)[this->slots[i].id]->get_name() == name)
+      return this->slots[i].id;
+
+  return npos;
+}
+
+void Account_index::find_batch(const std::vector<std::string> &names, std::vector<std::size_t> &ids) const
+{
+  ids.resize(names.size());
+  std::uint64_t hashes[group_size];
+  std::uint32_t found[group_size];
+  const Account *candidates[group_size];
+
+  for (std::size_t begin {0}; begin < names.size(); begin += group_size) {
+    const std::size_t n = std::min(group_size, names.size() - begin);
+
+    for (std::size_t i {0}; i < n; i++) {
+      hashes[i] = hash(names[begin + i].data(), names[begin + i].size());
+      __builtin_prefetch(&this->slots[hashes[i] & this->mask]);
+    }
+
+    // the first slot of the same hash, a collision of the whole hash is left to find()
+    for (std::size_t i {0}; i < n; i++) {
+      std::size_t slot = hashes[i] & this->mask;
+      while (this->slots[slot].id != empty && this->slots[slot].hash != hashes[i])
+        slot = (slot + 1) & this->mask;
+      found[i] = this->slots[slot].id;
+      if (found[i] != empty)
+        __builtin_prefetch(&(*this->accounts)[found[i]]);
+    }
+
+    for (std::size_t i {0}; i < n; i++)
+      if (found[i] != empty) {
+        candidates[i] = (*this->accounts)[found[i]];
+        __builtin_prefetch(&candidates[i]->get_name());
+      }
+
+    // a name longer than the small string buffer is on the heap
+    for (std::size_t i {0}; i < n; i++)
+      if (found[i] != empty)
+        __builtin_prefetch(candidates[i]->get_name().data());
+
+    for (std::size_t i {0}; i < n; i++) {
+      const std::string &name = names[begin + i];
+      if (found[i] == empty)
+        ids[begin + i] = npos;
+      else if (candidates[i]->get_name() == name)
+        ids[begin + i] = found[i];
+      else
+        ids[begin + i] = this->find(name);
+    }
+  }
+}
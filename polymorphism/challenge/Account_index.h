@@ -0,0 +1,58 @@
+#ifndef _ACCOUNT_INDEX_H_
+#define _ACCOUNT_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Account.h"
+
+/*
+
+  - Account_index maps an account name to its id (the position in the accounts vector).
+
+  - it is an open addressing table with linear probing, every slot keeps the full
+    hash of its name so a probe only compares strings when the hashes match.
+
+  - with duplicate names find() returns the lowest id.
+
+  - the index does not follow changes of the vector, call build() again after them.
+
+  - find_batch() resolves many names in groups of group_size, a step for every name of the
+    group before the next step: the hashes and a prefetch of their slots, the probes and a
+    prefetch of the pointers to the accounts, the accounts, and the chars of their names,
+    then the compares. the misses of a group overlap, a batch is bound by the bandwidth of
+    the memory and not by one miss after the other, which is what find() is on an index
+    larger than the caches.
+
+*/
+class Account_index
+{
+private:
+  static constexpr std::uint32_t empty = UINT32_MAX;
+  static constexpr std::size_t group_size = 16;
+
+  struct Slot
+  {
+    std::uint64_t hash;
+    std::uint32_t id;
+  };
+
+  const std::vector<Account*> *accounts;
+  std::vector<Slot> slots;
+  std::size_t mask;
+
+public:
+  static constexpr std::size_t npos = SIZE_MAX;
+
+  Account_index(const std::vector<Account*> &accounts);
+
+  void build(const std::vector<Account*> &accounts);
+  std::size_t find(const std::string &name) const;
+  // ids[i] is find(names[i])
+  void find_batch(const std::vector<std::string> &names, std::vector<std::size_t> &ids) const;
+
+  static std::uint64_t hash(const char *str, std::size_t size);
+};
+
+#endif
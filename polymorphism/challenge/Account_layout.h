@@ -0,0 +1,215 @@
+#ifndef _ACCOUNT_LAYOUT_H_
+#define _ACCOUNT_LAYOUT_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Account_store.h"
+#include "Checking_account.h"
+#include "Money.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+#include "../../tooling/recordLayout/Layout.h"
+#include "../../tooling/recordLayout/Name_table.h"
+
+/*
+
+  - the layouts of the account classes, see tooling/recordLayout/Layout.h, and two packed
+    records of an account for when the number of accounts a process holds is the limit.
+
+  - a Trust_account is 72 bytes, a vptr, a std::string of 32 and 8 bytes of padding, over two
+    cache lines, a heap block for a name of more than 15 chars, and an Account* to find it. a
+    Packed_account is 24, the name is an id into a Name_table, the int_rate a whole number
+    of micro percents, the precision Compound_interest works at, and the type a byte.
+
+  - Split_accounts keeps them as two arrays, the hot one is what a deposit, a withdraw and an
+    accrual read and write, 16 bytes, 4 accounts a cache line, the cold one the name and the
+    type, 8 bytes, that a report reads.
+
+*/
+namespace detail_account_layout
+{
+  // the fields of the classes in the order the compiler puts them, a derived class starts
+  // its fields in the tail padding of its base, the static_asserts check the mirrors are right
+  struct Checking_mirror
+  {
+    const void *vptr;
+    std::string name;
+    Money balance;
+    std::uint32_t version;
+  };
+
+  struct Saving_mirror
+  {
+    const void *vptr;
+    std::string name;
+    Money balance;
+    std::uint32_t version;
+    double int_rate;
+  };
+
+  struct Trust_mirror
+  {
+    const void *vptr;
+    std::string name;
+    Money balance;
+    std::uint32_t version;
+    double int_rate;
+    int num_withdrawls;
+  };
+
+  static_assert(sizeof(Checking_mirror) == sizeof(Checking_account), "Checking_mirror is not the layout of Checking_account");
+  static_assert(sizeof(Saving_mirror) == sizeof(Saving_account), "Saving_mirror is not the layout of Saving_account");
+  static_assert(sizeof(Trust_mirror) == sizeof(Trust_account), "Trust_mirror is not the layout of Trust_account");
+}
+
+constexpr auto checking_account_layout = record_layout::make_layout<detail_account_layout::Checking_mirror>(
+  "Checking_account",
+  RECORD_LAYOUT_FIELD(detail_account_layout::Checking_mirror, vptr),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Checking_mirror, name),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Checking_mirror, balance),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Checking_mirror, version));
+
+constexpr auto saving_account_layout = record_layout::make_layout<detail_account_layout::Saving_mirror>(
+  "Saving_account",
+  RECORD_LAYOUT_FIELD(detail_account_layout::Saving_mirror, vptr),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Saving_mirror, name),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Saving_mirror, balance),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Saving_mirror, version),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Saving_mirror, int_rate));
+
+constexpr auto trust_account_layout = record_layout::make_layout<detail_account_layout::Trust_mirror>(
+  "Trust_account",
+  RECORD_LAYOUT_FIELD(detail_account_layout::Trust_mirror, vptr),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Trust_mirror, name),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Trust_mirror, balance),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Trust_mirror, version),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Trust_mirror, int_rate),
+  RECORD_LAYOUT_FIELD(detail_account_layout::Trust_mirror, num_withdrawls));
+
+// the int_rate, in percent, as a whole number of micro percents, up to 2147%
+inline std::int32_t to_rate_micros(double int_rate)
+{
+  const double micros = std::round(int_rate * 1e6);
+  if (!(std::fabs(micros) <= INT32_MAX))
+    throw std::overflow_error("Account_layout: the int_rate does not fit in 32 bits of micro percents");
+  return static_cast<std::int32_t>(micros);
+}
+
+struct Packed_account
+{
+  std::int64_t cents;
+  std::int32_t rate_micros;
+  std::uint32_t version;
+  std::uint32_t name_id;
+  std::uint16_t num_withdrawls;
+  Account_store::Type type;
+};
+
+static_assert(sizeof(Account_store::Type) == 1, "Account_store::Type is not a byte");
+
+constexpr auto packed_account_layout = record_layout::make_layout<Packed_account>(
+  "Packed_account",
+  RECORD_LAYOUT_FIELD(Packed_account, cents),
+  RECORD_LAYOUT_FIELD(Packed_account, rate_micros),
+  RECORD_LAYOUT_FIELD(Packed_account, version),
+  RECORD_LAYOUT_FIELD(Packed_account, name_id),
+  RECORD_LAYOUT_FIELD(Packed_account, num_withdrawls),
+  RECORD_LAYOUT_FIELD(Packed_account, type));
+
+static_assert(packed_account_layout.size == 24 && packed_account_layout.get_padding() == 1, "Packed_account is not packed");
+
+struct Hot_account
+{
+  std::int64_t cents;
+  std::int32_t rate_micros;
+  std::uint32_t version;
+};
+
+struct Cold_account
+{
+  std::uint32_t name_id;
+  std::uint16_t num_withdrawls;
+  Account_store::Type type;
+};
+
+constexpr auto hot_account_layout = record_layout::make_layout<Hot_account>(
+  "Hot_account",
+  RECORD_LAYOUT_FIELD(Hot_account, cents),
+  RECORD_LAYOUT_FIELD(Hot_account, rate_micros),
+  RECORD_LAYOUT_FIELD(Hot_account, version));
+
+constexpr auto cold_account_layout = record_layout::make_layout<Cold_account>(
+  "Cold_account",
+  RECORD_LAYOUT_FIELD(Cold_account, name_id),
+  RECORD_LAYOUT_FIELD(Cold_account, num_withdrawls),
+  RECORD_LAYOUT_FIELD(Cold_account, type));
+
+static_assert(hot_account_layout.get_per_line() == 4 && hot_account_layout.get_padding() == 0, "Hot_account is not 16 bytes");
+static_assert(cold_account_layout.size == 8, "Cold_account is not 8 bytes");
+
+class Split_accounts
+{
+private:
+  std::vector<Hot_account> hot;
+  std::vector<Cold_account> cold;
+  record_layout::Name_table names;
+
+public:
+  // the position of the account, the order it was added in, like an Account_store
+  std::size_t add(Account_store::Type type, std::string_view name, Money balance, double int_rate = 0.0,
+    int num_withdrawls = 0)
+  {
+    if (num_withdrawls < 0 || num_withdrawls > UINT16_MAX)
+      throw std::overflow_error("Split_accounts: num_withdrawls does not fit in 16 bits");
+    this->hot.push_back({balance.get_cents(), to_rate_micros(int_rate), 0});
+    this->cold.push_back({this->names.add(name), static_cast<std::uint16_t>(num_withdrawls), type});
+    return this->hot.size() - 1;
+  }
+
+  void reserve(std::size_t num_accounts, std::size_t num_chars)
+  {
+    this->hot.reserve(num_accounts);
+    this->cold.reserve(num_accounts);
+    this->names.reserve(num_accounts, num_chars);
+  }
+
+  const Hot_account &get_hot(std::size_t position) const
+  {
+    return this->hot[position];
+  }
+
+  // the hot records in position order, what a batch loops over
+  std::vector<Hot_account> &get_hot()
+  {
+    return this->hot;
+  }
+
+  const Cold_account &get_cold(std::size_t position) const
+  {
+    return this->cold[position];
+  }
+
+  std::string_view get_name(std::size_t position) const
+  {
+    return this->names.get(this->cold[position].name_id);
+  }
+
+  std::size_t size() const
+  {
+    return this->hot.size();
+  }
+
+  // what the accounts hold, the arrays at their capacity and the names
+  std::size_t get_bytes() const
+  {
+    return this->hot.capacity() * sizeof(Hot_account) + this->cold.capacity() * sizeof(Cold_account)
+      + this->names.get_bytes();
+  }
+};
+
+#endif
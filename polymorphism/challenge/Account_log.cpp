@@ -0,0 +1,123 @@
+#include <typeinfo>
+#include "Account_log.h"
+#include "Checking_account.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+
+const binary_log::Format<Money, Account> deposited_line {"Deposited {} to {}"};
+const binary_log::Format<Money, Account> failed_deposit_line {"Failed deposit of {} to {}"};
+const binary_log::Format<Money, Account> withdrawn_line {"Withdraw {} from {}"};
+const binary_log::Format<Money, Account> failed_withdraw_line {"Failed withdraw of {} from {}"};
+
+namespace
+{
+  enum class Kind: std::uint8_t {checking, saving, trust, text};
+
+  // the class, the balance, the int_rate, the num_withdrawls and the size of the name, the name follows
+  constexpr std::size_t fixed_size = 1 + sizeof(std::int64_t) + sizeof(double) + sizeof(std::int32_t) + sizeof(std::uint32_t);
+
+  Kind kind_of(const Account &account)
+  {
+    const std::type_info &type = typeid(account);
+    if (type == typeid(Checking_account))
+      return Kind::checking;
+    if (type == typeid(Saving_account))
+      return Kind::saving;
+    if (type == typeid(Trust_account))
+      return Kind::trust;
+    return Kind::text;
+  }
+
+  template<typename T>
+  char *put_raw(char *out, T value)
+  {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+  }
+
+  template<typename T>
+  const char *get_raw(const char *in, T &value)
+  {
+    std::memcpy(&value, in, sizeof(T));
+    return in + sizeof(T);
+  }
+}
+
+std::size_t Account_log::size(const Account &account)
+{
+  if (kind_of(account) == Kind::text)
+    return 1 + 2 * sizeof(std::uint32_t) + account.format_size();
+  return fixed_size + account.name.size();
+}
+
+char *Account_log::encode(char *out, const Account &account)
+{
+  const Kind kind = kind_of(account);
+  *out++ = static_cast<char>(kind);
+
+  // the room of format_size, a bound, and the size of the text format gives in it
+  if (kind == Kind::text) {
+    const std::uint32_t room = static_cast<std::uint32_t>(account.format_size());
+    char *text = out + 2 * sizeof(std::uint32_t);
+    char *end = account.format(text);
+    out = put_raw(out, room);
+    put_raw(out, static_cast<std::uint32_t>(end - text));
+    return text + room;
+  }
+
+  double int_rate {0.0};
+  std::int32_t num_withdrawls {0};
+  if (kind != Kind::checking)
+    int_rate = static_cast<const Saving_account &>(account).int_rate;
+  if (kind == Kind::trust)
+    num_withdrawls = static_cast<const Trust_account &>(account).num_withdrawls;
+
+  out = put_raw(out, account.balance.get_cents());
+  out = put_raw(out, int_rate);
+  out = put_raw(out, num_withdrawls);
+  out = put_raw(out, static_cast<std::uint32_t>(account.name.size()));
+  std::memcpy(out, account.name.data(), account.name.size());
+  return out + account.name.size();
+}
+
+const char *Account_log::decode(const char *in, std::string &text)
+{
+  const Kind kind = static_cast<Kind>(*in++);
+  std::uint32_t length;
+
+  if (kind == Kind::text) {
+    std::uint32_t room;
+    in = get_raw(in, room);
+    in = get_raw(in, length);
+    text.append(in, length);
+    return in + room;
+  }
+
+  // one account of every class per thread, the fields are set and it formats itself
+  thread_local Checking_account checking;
+  thread_local Saving_account saving;
+  thread_local Trust_account trust;
+  Account &account = kind == Kind::checking 
+    ? static_cast<Account &>(checking) 
+    : kind == Kind::saving ? static_cast<Account &>(saving) : static_cast<Account &>(trust);
+
+  std::int64_t cents;
+  double int_rate;
+  std::int32_t num_withdrawls;
+  in = get_raw(in, cents);
+  in = get_raw(in, int_rate);
+  in = get_raw(in, num_withdrawls);
+  in = get_raw(in, length);
+  account.name.assign(in, length);
+  account.balance = Money::from_cents(cents);
+  if (kind != Kind::checking)
+    static_cast<Saving_account &>(account).int_rate = int_rate;
+  if (kind == Kind::trust)
+    trust.num_withdrawls = num_withdrawls;
+
+  const std::size_t from = text.size();
+  text.resize(from + account.format_size());
+  char *end = account.format(&text[from]);
+  text.resize(static_cast<std::size_t>(end - text.data()));
+  return in + length;
+}
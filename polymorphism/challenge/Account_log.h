@@ -0,0 +1,73 @@
+#ifndef _ACCOUNT_LOG_H_
+#define _ACCOUNT_LOG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "../../tooling/binaryLog/Binary_log.h"
+#include "Account.h"
+#include "Money.h"
+
+/*
+
+  - the arguments of the lines of Account_util in a binary_log::Logger: an amount is its
+    cents, an account is what its text is made of, its class, balance, int_rate,
+    num_withdrawls and name, raw. the thread of the logger, or binary_log::decode on a
+    binary file, makes the text operator<< writes from them, with the format of the class.
+
+  - an account of a class that is not one of the three is written as its text,
+    formatted where it is logged.
+
+*/
+struct Account_log
+{
+  static std::size_t size(const Account &account);
+  static char *encode(char *out, const Account &account);
+  static const char *decode(const char *in, std::string &text);
+};
+
+namespace binary_log
+{
+  template<>
+  struct Arg<Money>
+  {
+    static constexpr const char *type_name = "money";
+
+    static std::size_t size(const Money &) { return sizeof(std::int64_t); }
+
+    static char *encode(char *out, const Money &amount)
+    {
+      const std::int64_t cents = amount.get_cents();
+      std::memcpy(out, &cents, sizeof(cents));
+      return out + sizeof(cents);
+    }
+
+    static const char *decode(const char *in, std::string &text)
+    {
+      std::int64_t cents;
+      std::memcpy(&cents, in, sizeof(cents));
+      char buff[Money::max_chars];
+      text.append(buff, Money::from_cents(cents).format(buff));
+      return in + sizeof(cents);
+    }
+  };
+
+  template<>
+  struct Arg<Account>
+  {
+    static constexpr const char *type_name = "account";
+
+    static std::size_t size(const Account &account) { return Account_log::size(account); }
+    static char *encode(char *out, const Account &account) { return Account_log::encode(out, account); }
+    static const char *decode(const char *in, std::string &text) { return Account_log::decode(in, text); }
+  };
+}
+
+// the lines of deposit and withdraw of Account_util
+extern const binary_log::Format<Money, Account> deposited_line;
+extern const binary_log::Format<Money, Account> failed_deposit_line;
+extern const binary_log::Format<Money, Account> withdrawn_line;
+extern const binary_log::Format<Money, Account> failed_withdraw_line;
+
+#endif
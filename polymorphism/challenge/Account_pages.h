@@ -0,0 +1,85 @@
+#ifndef _ACCOUNT_PAGES_H_
+#define _ACCOUNT_PAGES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Account.h"
+#include "../../tooling/pagedView/Paged_view.h"
+
+/*
+
+  - Account_pages shows a page of a vector of accounts, the rows display prints, but only the
+    ones of the page are formatted, and a row whose account did not change since it was shown
+    is not formatted again, see tooling/pagedView/Paged_view.h.
+
+  - the stamp of a row is the account in it and its version, a deposit or a withdraw changes
+    the version and so does a sync of an Account_store, an account put in another row is
+    formatted for the new row.
+
+  - the view keeps a reference to the vector, the vector can change, the accounts of a page
+    are looked up when it is shown.
+
+*/
+namespace detail_account_pages
+{
+  struct Stamp
+  {
+    const std::vector<Account*> *accounts;
+
+    std::pair<const Account*, std::uint32_t> operator()(std::size_t row) const
+    {
+      const Account *ptr = (*this->accounts)[row];
+      return {ptr, ptr->get_version()};
+    }
+  };
+
+  struct Format
+  {
+    const std::vector<Account*> *accounts;
+
+    void operator()(std::size_t row, std::string &text) const
+    {
+      const Account *ptr = (*this->accounts)[row];
+      const std::size_t at = text.size();
+      text.resize(at + ptr->format_size());
+      text.resize(ptr->format(&text[at]) - text.data());
+    }
+  };
+}
+
+class Account_pages
+{
+private:
+  const std::vector<Account*> &accounts;
+  paged_view::Paged_view<detail_account_pages::Stamp, detail_account_pages::Format> view;
+
+public:
+  explicit Account_pages(const std::vector<Account*> &accounts, std::size_t capacity = 1024)
+    : accounts(accounts), view({&accounts}, {&accounts}, capacity)
+  {}
+
+  // the accounts [offset, offset + limit), a line each, good until the next page
+  std::string_view page(std::size_t offset, std::size_t limit)
+  {
+    return this->view.page(offset, limit, this->accounts.size());
+  }
+
+  void display(std::size_t offset, std::size_t limit, std::ostream &os = std::cout)
+  {
+    const std::string_view text = this->page(offset, limit);
+    os.write(text.data(), text.size());
+    os.flush();
+  }
+
+  std::size_t get_num_formatted() const
+  {
+    return this->view.get_num_formatted();
+  }
+};
+
+#endif
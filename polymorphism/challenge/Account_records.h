@@ -0,0 +1,55 @@
+#ifndef _ACCOUNT_RECORDS_H_
+#define _ACCOUNT_RECORDS_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "Account_store.h"
+#include "Money.h"
+#include "../../tooling/recordParser/Record_parser.h"
+
+/*
+
+  - load_accounts adds the accounts of a type,name,balance,int_rate,num_withdrawls file,
+    an export of the accounts, straight into the store, no Account objects are made. the
+    type is checking, saving or trust, the balance is in dollars, the int_rate of a
+    checking account and the num_withdrawls of the others than trust can be empty.
+
+  - the first record is a header when its balance is not a number, it is skipped. a field
+    that is not a number after it, or a type that is none of the three, throws
+    std::runtime_error.
+
+*/
+
+// the number of accounts added, records is unescaped in place
+inline std::size_t load_accounts(Account_store &store, std::string &records)
+{
+  record_parser::Parser parser {records};
+  record_parser::Record record;
+  std::size_t added = 0;
+  double balance;
+
+  if (!parser.next(record) || (!record.get(2, balance) && !parser.next(record)))
+    return 0;
+
+  do
+  {
+    const std::string_view type = record[0];
+    const std::string name {record.get<std::string_view>(1)};
+    const Money amount {record.get<double>(2)};
+    if (type == "checking")
+      store.add_checking(name, amount);
+    else if (type == "saving")
+      store.add_saving(name, amount, record.get<double>(3));
+    else if (type == "trust")
+      store.add_trust(name, amount, record.get<double>(3), record.size() > 4 && !record[4].empty() ? record.get<int>(4) : 0);
+    else
+      throw std::runtime_error("record " + std::to_string(record.get_number()) + ": \"" + std::string {type} 
+        + "\" is not an account type, checking, saving or trust");
+    ++added;
+  } while (parser.next(record));
+  return added;
+}
+
+#endif
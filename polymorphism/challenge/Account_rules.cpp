@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Account_rules.h"
+#include "Checking_account.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+
+#if defined(BASICS_OFFLOAD)
+#pragma omp declare target
+#endif
+namespace
+{
+  // the rounding of Money::operator*, half away from zero
+  inline std::int64_t round_cents(double value)
+  {
+    return static_cast<std::int64_t>(value >= 0 ? value + 0.5 : value - 0.5);
+  }
+
+  // the same in doubles, an infinite bound stays infinite
+  inline double round_bound(double value)
+  {
+    return value >= 0 ? std::floor(value + 0.5) : std::ceil(value - 0.5);
+  }
+}
+#if defined(BASICS_OFFLOAD)
+#pragma omp end declare target
+#endif
+
+Account_policy Account_policy::checking()
+{
+  Account_policy policy;
+  policy.product = "checking";
+  policy.withdraw_fee = Checking_account::fee_withdraw;
+  return policy;
+}
+
+Account_policy Account_policy::saving()
+{
+  Account_policy policy;
+  policy.product = "saving";
+  policy.interest_on_deposit = true;
+  return policy;
+}
+
+Account_policy Account_policy::trust()
+{
+  Account_policy policy = saving();
+  policy.product = "trust";
+  policy.max_withdrawals = Trust_account::max_withdrawls;
+  policy.max_withdraw_percent = Trust_account::max_withdraw_percent * 100;
+  policy.bonus_threshold = Trust_account::bonus_threshold;
+  policy.bonus_amount = Trust_account::bonus_amount;
+  return policy;
+}
+
+Account_rules::Product Account_rules::add_product(const Account_policy &policy)
+{
+  if (policy.max_withdrawals < 0 || !(policy.max_withdraw_percent >= 0))
+    throw std::runtime_error("Account_rules: the policy of " + policy.product + " has a negative bound");
+
+  Group group;
+  group.policy = policy;
+  group.rules = Compiled {policy.withdraw_fee.get_cents(), policy.min_balance.get_cents(),
+    static_cast<std::int32_t>(policy.max_withdrawals), policy.max_withdraw_percent / 100,
+    policy.bonus_threshold.get_cents(), policy.bonus_amount.get_cents(), policy.interest_on_deposit ? 1.0 : 0.0};
+  this->groups.push_back(std::move(group));
+  return static_cast<Product>(this->groups.size() - 1);
+}
+
+std::size_t Account_rules::add(Product product, const std::string &name, Money balance, double int_rate,
+  int num_withdrawals)
+{
+  Group &group = this->groups.at(product);
+  group.names.push_back(name);
+  group.balances.push_back(balance.get_cents());
+  group.int_rates.push_back(int_rate);
+  group.num_withdrawals.push_back(num_withdrawals);
+  group.positions.push_back(this->ids.size());
+  this->ids.push_back({product, group.balances.size() - 1});
+  return this->ids.size() - 1;
+}
+
+/*
+
+  - the kernels of one product, every predicate of every account in [begin, end) is
+    computed and or'ed into its mask, the bounds of a rule that is off never fail.
+
+*/
+#if defined(BASICS_OFFLOAD)
+#pragma omp declare target
+#endif
+inline std::uint8_t Account_rules::withdraw_violations(const Compiled &rules, std::int64_t balance,
+  std::int32_t num_withdrawals, std::int64_t cents, std::int64_t total)
+{
+  return (balance - total < rules.min_balance) * below_min_balance
+    | (num_withdrawals >= rules.max_withdrawals) * too_many_withdrawals
+    | (static_cast<double>(cents) > round_bound(static_cast<double>(balance) * rules.max_withdraw_part)) * over_withdraw_percent;
+}
+#if defined(BASICS_OFFLOAD)
+#pragma omp end declare target
+#endif
+
+std::size_t Account_rules::deposit(Group &group, std::size_t begin, std::size_t end, Money amount)
+{
+  const Compiled rules = group.rules;
+  const std::int64_t cents = amount.get_cents();
+  const std::int64_t bonused = cents + (cents >= rules.bonus_threshold ? rules.bonus : 0);
+  std::int64_t *balances = group.balances.data();
+  const double *int_rates = group.int_rates.data();
+  std::size_t ok {0};
+
+  for (std::size_t i {begin}; i < end; i++) {
+    const std::int64_t total = bonused + round_cents(static_cast<double>(bonused) * (int_rates[i] * rules.interest / 100));
+    const std::uint8_t violations = (total < 0) * negative_deposit;
+    const bool allowed = violations == 0;
+    balances[i] += allowed ? total : 0;
+    ok += allowed;
+  }
+
+  return ok;
+}
+
+std::size_t Account_rules::withdraw(Group &group, std::size_t begin, std::size_t end, Money amount)
+{
+  const Compiled rules = group.rules;
+  const std::int64_t cents = amount.get_cents();
+  const std::int64_t total = cents + rules.fee;
+  std::int64_t *balances = group.balances.data();
+  std::int32_t *num_withdrawals = group.num_withdrawals.data();
+  std::size_t ok {0};
+
+  for (std::size_t i {begin}; i < end; i++) {
+    const std::int64_t balance = balances[i];
+    const std::uint8_t violations = withdraw_violations(rules, balance, num_withdrawals[i], cents, total);
+    const bool allowed = violations == 0;
+    balances[i] -= allowed ? total : 0;
+    num_withdrawals[i] += allowed;
+    ok += allowed;
+  }
+
+  return ok;
+}
+
+std::size_t Account_rules::deposit(Money amount)
+{
+  std::size_t ok {0};
+  for (Group &group: this->groups)
+    ok += deposit(group, 0, group.balances.size(), amount);
+  return ok;
+}
+
+std::size_t Account_rules::withdraw(Money amount)
+{
+  std::size_t ok {0};
+  for (Group &group: this->groups)
+    ok += withdraw(group, 0, group.balances.size(), amount);
+  return ok;
+}
+
+/*
+
+  - check_withdraw of a product of many accounts on a device: a chunk of
+    offload::chunk_size accounts a target task, its balances and withdrawals go in and its
+    masks come back, in_flight chunks at a time, then the masks go to their positions.
+
+*/
+void Account_rules::check_withdraw(Money amount, std::vector<std::uint8_t> &violations,
+  [[maybe_unused]] offload::Target target) const
+{
+  violations.resize(this->ids.size());
+  const std::int64_t cents = amount.get_cents();
+
+  // a product at a time, the masks go to the positions of its accounts
+  for (const Group &group: this->groups) {
+    const Compiled rules = group.rules;
+    const std::int64_t total = cents + rules.fee;
+#if defined(BASICS_OFFLOAD)
+    if (offload::use_device(target, group.balances.size())) {
+      const std::size_t n = group.balances.size();
+      std::vector<std::uint8_t> masks(n);
+      const std::int64_t *b = group.balances.data();
+      const std::int32_t *w = group.num_withdrawals.data();
+      std::uint8_t *mask = masks.data();
+#pragma omp parallel num_threads(offload::in_flight)
+#pragma omp single
+      for (std::size_t from {0}; from < n; from += offload::chunk_size) {
+        const std::size_t count = std::min(offload::chunk_size, n - from);
+        const std::size_t to = from + count;
+#pragma omp target teams distribute parallel for map(to: b[from:count], w[from:count]) map(from: mask[from:count]) \
+  firstprivate(rules) nowait
+        for (std::size_t i = from; i < to; i++)
+          mask[i] = withdraw_violations(rules, b[i], w[i], cents, total);
+      }
+      for (std::size_t i {0}; i < n; i++)
+        violations[group.positions[i]] = masks[i];
+      continue;
+    }
+#endif
+    for (std::size_t i {0}; i < group.balances.size(); i++) {
+      violations[group.positions[i]] = withdraw_violations(rules, group.balances[i], group.num_withdrawals[i], cents, total);
+    }
+  }
+}
+
+bool Account_rules::apply(const Transaction &transaction)
+{
+  if (transaction.account_id >= this->ids.size())
+    return false;
+
+  const Id id = this->ids[transaction.account_id];
+  Group &group = this->groups[id.product];
+  return (transaction.op == Operation::Deposit ? deposit(group, id.index, id.index + 1, transaction.amount)
+    : withdraw(group, id.index, id.index + 1, transaction.amount)) == 1;
+}
+
+const Account_policy &Account_rules::get_policy(Product product) const
+{
+  return this->groups.at(product).policy;
+}
+
+Account_rules::Product Account_rules::get_product(std::size_t position) const
+{
+  return this->ids.at(position).product;
+}
+
+Money Account_rules::get_balance(std::size_t position) const
+{
+  const Id id = this->ids.at(position);
+  return Money::from_cents(this->groups[id.product].balances[id.index]);
+}
+
+int Account_rules::get_num_withdrawals(std::size_t position) const
+{
+  const Id id = this->ids.at(position);
+  return this->groups[id.product].num_withdrawals[id.index];
+}
+
+Money Account_rules::get_total_balance() const
+{
+  std::int64_t total {0};
+  for (const Group &group: this->groups)
+    for (const std::int64_t balance: group.balances)
+      total += balance;
+  return Money::from_cents(total);
+}
+
+std::size_t Account_rules::size() const
+{
+  return this->ids.size();
+}
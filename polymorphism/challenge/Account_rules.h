@@ -0,0 +1,128 @@
+#ifndef _ACCOUNT_RULES_H_
+#define _ACCOUNT_RULES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Money.h"
+#include "Transaction.h"
+#include "../../algorithms/parallelAlgorithms/Offload.h"
+
+/*
+
+  - an Account_policy is the rules of a product as data: the fee of a withdrawal, the
+    lowest balance it may leave, the most withdrawals and the largest part of the balance
+    one may take, the bonus of a large deposit and whether a deposit earns the int_rate of
+    the account. checking(), saving() and trust() are the rules of Checking_account,
+    Saving_account and Trust_account, from their constants, a new product is a new policy,
+    an overdraft is a negative min_balance, not a new class.
+
+  - Account_rules keeps accounts of any product in contiguous arrays, one group per
+    product like Account_store does per class. add_product compiles a policy to the
+    constants of its predicates, a rule that is off is a bound no account reaches, so
+    every predicate is computed for every account and there is no branch on the product.
+
+  - a deposit or a withdrawal of every account is one loop a product, the predicates of
+    an account are the bits of a Violation mask, the account takes the operation when its
+    mask is 0, a select keeps or drops its new balance, so the loops vectorize and do not
+    mispredict, check_withdraw gives the masks without changing anything, a batch
+    validation. apply is the same rules on one account.
+
+  - the overflow checks of Money are left out of the loops, like in Account_store.
+
+*/
+struct Account_policy
+{
+  std::string product;
+  Money withdraw_fee {0.0};
+  Money min_balance {0.0};
+  int max_withdrawals {std::numeric_limits<int>::max()};
+  double max_withdraw_percent {std::numeric_limits<double>::infinity()};
+  // a deposit of bonus_threshold or more gets bonus_amount, before its interest
+  Money bonus_threshold {Money::from_cents(std::numeric_limits<std::int64_t>::max())};
+  Money bonus_amount {0.0};
+  bool interest_on_deposit {false};
+
+  static Account_policy checking();
+  static Account_policy saving();
+  static Account_policy trust();
+};
+
+class Account_rules
+{
+public:
+  using Product = std::uint32_t;
+
+  enum Violation: std::uint8_t
+  {
+    below_min_balance = 1,
+    too_many_withdrawals = 2,
+    over_withdraw_percent = 4,
+    negative_deposit = 8
+  };
+
+private:
+  // a policy compiled to the bounds its predicates compare against
+  struct Compiled
+  {
+    std::int64_t fee;
+    std::int64_t min_balance;
+    std::int32_t max_withdrawals;
+    double max_withdraw_part;
+    std::int64_t bonus_threshold;
+    std::int64_t bonus;
+    double interest;  // 1 when a deposit earns the int_rate, 0 when it does not
+  };
+
+  struct Group
+  {
+    Account_policy policy;
+    Compiled rules;
+    std::vector<std::string> names;
+    std::vector<std::int64_t> balances;
+    std::vector<double> int_rates;
+    std::vector<std::int32_t> num_withdrawals;
+    std::vector<std::size_t> positions;
+  };
+
+  struct Id
+  {
+    Product product;
+    std::size_t index;
+  };
+
+  std::vector<Group> groups;
+  std::vector<Id> ids;  // by position
+
+  // the mask of a withdrawal of cents, total with the fee, from an account
+  static std::uint8_t withdraw_violations(const Compiled &rules, std::int64_t balance, std::int32_t num_withdrawals,
+    std::int64_t cents, std::int64_t total);
+  static std::size_t deposit(Group &group, std::size_t begin, std::size_t end, Money amount);
+  static std::size_t withdraw(Group &group, std::size_t begin, std::size_t end, Money amount);
+
+public:
+  Product add_product(const Account_policy &policy);
+  // the position of the account, the order it was added in
+  std::size_t add(Product product, const std::string &name, Money balance, double int_rate = 0.0,
+    int num_withdrawals = 0);
+
+  std::size_t deposit(Money amount);
+  std::size_t withdraw(Money amount);
+  // the Violation mask of a withdrawal of amount from every account, by position, 0 is allowed,
+  // a product of many accounts on the device of offload::use_device
+  void check_withdraw(Money amount, std::vector<std::uint8_t> &violations,
+    offload::Target target = offload::Target::automatic) const;
+  // the transaction on the account at its position, false when it is refused or there is none
+  bool apply(const Transaction &transaction);
+
+  const Account_policy &get_policy(Product product) const;
+  Product get_product(std::size_t position) const;
+  Money get_balance(std::size_t position) const;
+  int get_num_withdrawals(std::size_t position) const;
+  Money get_total_balance() const;
+  std::size_t size() const;
+};
+
+#endif
@@ -0,0 +1,494 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Account_store.h"
+#include "Checking_account.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+#include "../../algorithms/scan/Scan.h"
+
+Account_store::Id Account_store::add_checking(const std::string &name, Money balance, Account *view)
+{
+  this->checking.names.push_back(name);
+  this->checking.balances.push_back(balance.get_cents());
+  this->checking.views.push_back(view);
+  this->ids.push_back({Type::Checking, this->checking.balances.size() - 1});
+  return this->ids.back();
+}
+
+Account_store::Id Account_store::add_saving(const std::string &name, Money balance, double int_rate, 
+  Account *view)
+{
+  this->saving.names.push_back(name);
+  this->saving.balances.push_back(balance.get_cents());
+  this->saving.int_rates.push_back(int_rate);
+  this->saving.views.push_back(view);
+  this->ids.push_back({Type::Saving, this->saving.balances.size() - 1});
+  return this->ids.back();
+}
+
+Account_store::Id Account_store::add_trust(const std::string &name, Money balance, double int_rate, 
+  int num_withdrawls, Account *view)
+{
+  this->trust.names.push_back(name);
+  this->trust.balances.push_back(balance.get_cents());
+  this->trust.int_rates.push_back(int_rate);
+  this->trust.num_withdrawls.push_back(num_withdrawls);
+  this->trust.views.push_back(view);
+  this->ids.push_back({Type::Trust, this->trust.balances.size() - 1});
+  return this->ids.back();
+}
+
+void Account_store::load(const std::vector<Account*> &accounts)
+{
+  // the most derived type has to be tested first, Trust_account is a Saving_account
+  for (const auto &ptr: accounts)
+    if (auto t = dynamic_cast<Trust_account*>(ptr))
+      this->add_trust(t->name, t->balance, t->int_rate, t->num_withdrawls, ptr);
+    else if (auto s = dynamic_cast<Saving_account*>(ptr))
+      this->add_saving(s->name, s->balance, s->int_rate, ptr);
+    else if (auto c = dynamic_cast<Checking_account*>(ptr))
+      this->add_checking(c->name, c->balance, ptr);
+}
+
+void Account_store::sync() const
+{
+  for (std::size_t i {0}; i < this->checking.views.size(); i++)
+    if (Account *ptr = this->checking.views[i]) {
+      ptr->balance = Money::from_cents(this->checking.balances[i]);
+      ptr->version++;
+    }
+
+  for (std::size_t i {0}; i < this->saving.views.size(); i++)
+    if (Account *ptr = this->saving.views[i]) {
+      ptr->balance = Money::from_cents(this->saving.balances[i]);
+      ptr->version++;
+    }
+
+  for (std::size_t i {0}; i < this->trust.views.size(); i++)
+    if (auto ptr = static_cast<Trust_account*>(this->trust.views[i])) {
+      ptr->balance = Money::from_cents(this->trust.balances[i]);
+      ptr->num_withdrawls = this->trust.num_withdrawls[i];
+      ptr->version++;
+    }
+}
+
+std::size_t Account_store::deposit(Money amount)
+{
+  return deposit_checking(this->checking.balances, amount)
+    + deposit_saving(this->saving.balances, this->saving.int_rates, amount)
+    + deposit_trust(this->trust.balances, this->trust.int_rates, amount);
+}
+
+std::size_t Account_store::withdraw(Money amount)
+{
+  return withdraw_checking(this->checking.balances, amount)
+    + withdraw_saving(this->saving.balances, amount)
+    + withdraw_trust(this->trust.balances, this->trust.num_withdrawls, amount);
+}
+
+/*
+
+  - one account at a time goes through a temporary of its class, the rules are the ones of
+    the class itself, not a fourth copy of them, the name is empty and its string does
+    not allocate.
+
+*/
+bool Account_store::apply(const Transaction &transaction)
+{
+  if (transaction.account_id >= this->ids.size())
+    return false;
+
+  const Id id = this->ids[transaction.account_id];
+  const bool deposit = transaction.op == Operation::Deposit;
+  bool ok;
+  switch (id.type) {
+    case Type::Checking: {
+      Checking_account account {"", Money::from_cents(this->checking.balances[id.index])};
+      ok = deposit ? account.Checking_account::deposit(transaction.amount) 
+        : account.Checking_account::withdraw(transaction.amount);
+      this->checking.balances[id.index] = account.balance.get_cents();
+      break;
+    }
+    case Type::Saving: {
+      Saving_account account {"", Money::from_cents(this->saving.balances[id.index]), this->saving.int_rates[id.index]};
+      ok = deposit ? account.Saving_account::deposit(transaction.amount) 
+        : account.Saving_account::withdraw(transaction.amount);
+      this->saving.balances[id.index] = account.balance.get_cents();
+      break;
+    }
+    default: {
+      Trust_account account {"", Money::from_cents(this->trust.balances[id.index]), this->trust.int_rates[id.index]};
+      account.num_withdrawls = this->trust.num_withdrawls[id.index];
+      ok = deposit ? account.Trust_account::deposit(transaction.amount) 
+        : account.Trust_account::withdraw(transaction.amount);
+      this->trust.balances[id.index] = account.balance.get_cents();
+      this->trust.num_withdrawls[id.index] = account.num_withdrawls;
+      break;
+    }
+  }
+  return ok;
+}
+
+bool Account_store::apply(const Transaction &transaction, std::int64_t time)
+{
+  if (!this->limited || transaction.op == Operation::Deposit || transaction.account_id >= this->ids.size())
+    return this->apply(transaction);
+
+  if (this->withdrawn.size() < this->ids.size())
+    this->withdrawn.resize(this->ids.size());
+  const std::int64_t cents = transaction.amount.get_cents();
+  const Withdrawn &window = this->withdrawn.get(transaction.account_id, time);
+  if (window.cents + cents > this->max_cents || (this->max_count != 0 && window.count >= this->max_count))
+    return false;
+  if (!this->apply(transaction))
+    return false;
+  this->withdrawn.add(transaction.account_id, time, {cents, 1});
+  return true;
+}
+
+void Account_store::set_withdrawal_limit(Money max_amount, int max_count, std::int64_t width, std::size_t num_buckets)
+{
+  if (max_count < 0)
+    throw std::invalid_argument("Account_store: max_count of a withdrawal limit is negative");
+  this->withdrawn = windows::Sliding_sums<Withdrawn> {width, num_buckets, this->ids.size()};
+  this->max_cents = max_amount.get_cents();
+  this->max_count = max_count;
+  this->limited = true;
+}
+
+Money Account_store::get_withdrawn(std::size_t position, std::int64_t time)
+{
+  if (position >= this->withdrawn.size())
+    return Money::from_cents(0);
+  return Money::from_cents(this->withdrawn.get(position, time).cents);
+}
+
+Account_store::Accrual_result Account_store::accrue_interest(offload::Target target)
+{
+  std::size_t crossed {0}, ignored {0};
+  std::int64_t interest = accrue(this->saving.balances, this->saving.int_rates, 0, ignored, target);
+  interest += accrue(this->trust.balances, this->trust.int_rates, 
+    Trust_account::bonus_threshold.get_cents(), crossed, target);
+  return {Money::from_cents(interest), crossed};
+}
+
+Account_store::Accrual_result Account_store::compound_interest(std::uint64_t periods, Compound_interest &engine)
+{
+  std::size_t crossed {0}, ignored {0};
+  std::int64_t interest = compound(this->saving.balances, this->saving.int_rates, periods, engine, 0, ignored);
+  interest += compound(this->trust.balances, this->trust.int_rates, periods, engine, 
+    Trust_account::bonus_threshold.get_cents(), crossed);
+  return {Money::from_cents(interest), crossed};
+}
+
+Money Account_store::get_balance(Id id) const
+{
+  switch (id.type) {
+    case Type::Checking:
+      return Money::from_cents(this->checking.balances.at(id.index));
+    case Type::Saving:
+      return Money::from_cents(this->saving.balances.at(id.index));
+    default:
+      return Money::from_cents(this->trust.balances.at(id.index));
+  }
+}
+
+Money Account_store::get_total_balance() const
+{
+  const std::int64_t total = scan::reduce(this->checking.balances.begin(), this->checking.balances.end(), std::int64_t {0})
+    + scan::reduce(this->saving.balances.begin(), this->saving.balances.end(), std::int64_t {0})
+    + scan::reduce(this->trust.balances.begin(), this->trust.balances.end(), std::int64_t {0});
+  return Money::from_cents(total);
+}
+
+std::size_t Account_store::size() const
+{
+  return this->checking.balances.size() + this->saving.balances.size() + this->trust.balances.size();
+}
+
+/*
+
+  - the kernels below repeat the rules of the virtual classes, but branch free:
+    every account computes its new balance and a select keeps or drops it,
+    which lets the compiler vectorize the loops.
+
+  - balances are plain cents here, the overflow checks of Money are left to the
+    single account path.
+
+*/
+std::size_t Account_store::deposit_checking(large_buffer::Vector<std::int64_t> &balances, Money amount)
+{
+  if (amount < 0)
+    return 0;
+
+  const std::int64_t cents = amount.get_cents();
+  for (std::size_t i {0}; i < balances.size(); i++)
+    balances[i] += cents;
+
+  return balances.size();
+}
+
+std::size_t Account_store::withdraw_checking(large_buffer::Vector<std::int64_t> &balances, Money amount)
+{
+  const std::int64_t total = (amount + Checking_account::fee_withdraw).get_cents();
+  std::size_t ok {0};
+
+  for (std::size_t i {0}; i < balances.size(); i++) {
+    const bool allowed = balances[i] - total >= 0;
+    balances[i] -= allowed ? total : 0;
+    ok += allowed;
+  }
+
+  return ok;
+}
+
+std::size_t Account_store::deposit_saving(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+  Money amount)
+{
+  std::size_t ok {0};
+
+  for (std::size_t i {0}; i < balances.size(); i++) {
+    const std::int64_t total = (amount + amount * (int_rates[i] / 100)).get_cents();
+    const bool allowed = total >= 0;
+    balances[i] += allowed ? total : 0;
+    ok += allowed;
+  }
+
+  return ok;
+}
+
+std::size_t Account_store::withdraw_saving(large_buffer::Vector<std::int64_t> &balances, Money amount)
+{
+  const std::int64_t cents = amount.get_cents();
+  std::size_t ok {0};
+
+  for (std::size_t i {0}; i < balances.size(); i++) {
+    const bool allowed = balances[i] - cents >= 0;
+    balances[i] -= allowed ? cents : 0;
+    ok += allowed;
+  }
+
+  return ok;
+}
+
+std::size_t Account_store::deposit_trust(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+  Money amount)
+{
+  if (amount >= Trust_account::bonus_threshold)
+    amount += Trust_account::bonus_amount;
+
+  return deposit_saving(balances, int_rates, amount);
+}
+
+std::size_t Account_store::withdraw_trust(large_buffer::Vector<std::int64_t> &balances, large_buffer::Vector<int> &num_withdrawls, 
+  Money amount)
+{
+  const std::int64_t cents = amount.get_cents();
+  std::size_t ok {0};
+
+  for (std::size_t i {0}; i < balances.size(); i++) {
+    const bool allowed = num_withdrawls[i] < Trust_account::max_withdrawls
+      && cents <= balances[i] * Trust_account::max_withdraw_percent
+      && balances[i] - cents >= 0;
+    balances[i] -= allowed ? cents : 0;
+    num_withdrawls[i] += allowed;
+    ok += allowed;
+  }
+
+  return ok;
+}
+
+/*
+
+  - accrue works on four accounts at a time with AVX2 when the compiler targets it
+    (-mavx2 or -march=native), the tail and any block with huge values go through
+    the scalar loop.
+
+  - both paths compute interest as round_half_even(balance * (rate * 0.01)) in doubles,
+    so they give the same cents: int64 and double are converted exactly with the
+    2^52 + 2^51 trick, which holds while the values stay under 2^51 cents.
+
+*/
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+static constexpr std::int64_t exact_limit = std::int64_t {1} << 51;
+
+// the cast of a double out of the range of int64 is undefined, -2^63 <= x < 2^63 is
+// checked first, false for a NaN too, and throws like the + of Money after it
+static std::int64_t accrue_one(std::int64_t &balance, double int_rate, std::int64_t threshold, std::size_t &crossed)
+{
+  const double interest_d = std::nearbyint(static_cast<double>(balance) * (int_rate * 0.01));
+  if (!(interest_d >= -0x1p63 && interest_d < 0x1p63))
+    throw std::overflow_error("Money overflow.");
+  const std::int64_t interest = static_cast<std::int64_t>(interest_d);
+  const std::int64_t before = balance;
+
+  balance = (Money::from_cents(balance) + Money::from_cents(interest)).get_cents();
+  crossed += before < threshold && balance >= threshold;
+  return interest;
+}
+
+/*
+
+  - on a device the same computation an account, with std::nearbyint like accrue_one, a
+    chunk of offload::chunk_size accounts a target task, in_flight of them at a time so the
+    copies overlap the loops. an account out of the exact range is left as it is and
+    marked, a byte an account, the host gives it accrue_one afterwards, the one that throws
+    on an overflow.
+
+*/
+#if defined(BASICS_OFFLOAD)
+#pragma omp declare target
+#endif
+static inline bool accrues_exactly(std::int64_t balance, double interest)
+{
+  return balance <= exact_limit && balance >= -exact_limit && std::fabs(interest) <= static_cast<double>(exact_limit);
+}
+#if defined(BASICS_OFFLOAD)
+#pragma omp end declare target
+
+static std::int64_t accrue_device(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+  std::int64_t threshold, std::size_t &crossed)
+{
+  const std::size_t n = balances.size();
+  const std::size_t chunks = offload::num_chunks(n);
+  std::vector<std::int64_t> totals(chunks), crossings(chunks), left(chunks);
+  std::vector<std::uint8_t> marks(n);
+  std::int64_t *b = balances.data(), *total_of = totals.data(), *crossed_of = crossings.data(), *left_of = left.data();
+  const double *r = int_rates.data();
+  std::uint8_t *mark = marks.data();
+
+#pragma omp parallel num_threads(offload::in_flight)
+#pragma omp single
+  for (std::size_t chunk {0}; chunk < chunks; chunk++) {
+    const std::size_t from = chunk * offload::chunk_size;
+    const std::size_t count = std::min(offload::chunk_size, n - from);
+    const std::size_t to = from + count;
+#pragma omp target teams distribute parallel for map(tofrom: b[from:count]) map(to: r[from:count]) map(from: mark[from:count]) \
+  map(tofrom: total_of[chunk:1], crossed_of[chunk:1], left_of[chunk:1]) \
+  reduction(+: total_of[chunk:1], crossed_of[chunk:1], left_of[chunk:1]) nowait
+    for (std::size_t i = from; i < to; i++) {
+      const std::int64_t before = b[i];
+      const double interest_d = static_cast<double>(before) * (r[i] * 0.01);
+      const bool exact = accrues_exactly(before, interest_d);
+      const std::int64_t interest = exact ? static_cast<std::int64_t>(std::nearbyint(interest_d)) : 0;
+      b[i] = before + interest;
+      mark[i] = !exact;
+      total_of[chunk] += interest;
+      crossed_of[chunk] += exact && before < threshold && b[i] >= threshold;
+      left_of[chunk] += !exact;
+    }
+  }
+
+  std::int64_t total {0};
+  for (std::size_t chunk {0}; chunk < chunks; chunk++) {
+    total += totals[chunk];
+    crossed += crossings[chunk];
+    for (std::size_t i {chunk * offload::chunk_size}; left[chunk] > 0 && i < n; i++)
+      if (mark[i]) {
+        total += accrue_one(b[i], r[i], threshold, crossed);
+        left[chunk]--;
+      }
+  }
+  return total;
+}
+#endif
+
+std::int64_t Account_store::accrue(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+  std::int64_t threshold, std::size_t &crossed, [[maybe_unused]] offload::Target target)
+{
+#if defined(BASICS_OFFLOAD)
+  if (offload::use_device(target, balances.size()))
+    return accrue_device(balances, int_rates, threshold, crossed);
+#endif
+
+  std::int64_t total {0};
+  std::size_t i {0};
+
+#ifdef __AVX2__
+  const __m256i magic_i = _mm256_set1_epi64x(0x4338000000000000);
+  const __m256d magic_d = _mm256_castsi256_pd(magic_i);
+  const __m256i high = _mm256_set1_epi64x(exact_limit);
+  const __m256i low = _mm256_set1_epi64x(-exact_limit);
+  const __m256d limit_d = _mm256_set1_pd(static_cast<double>(exact_limit));
+  const __m256d sign_d = _mm256_set1_pd(-0.0);
+  const __m256d percent = _mm256_set1_pd(0.01);
+  const __m256i thr = _mm256_set1_epi64x(threshold);
+  __m256i sum = _mm256_setzero_si256();
+
+  for (; i + 4 <= balances.size(); i += 4) {
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&balances[i]));
+    const __m256i out = _mm256_or_si256(_mm256_cmpgt_epi64(b, high), _mm256_cmpgt_epi64(low, b));
+
+    const __m256d bd = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(b, magic_i)), magic_d);
+    const __m256d rate = _mm256_mul_pd(_mm256_loadu_pd(&int_rates[i]), percent);
+    const __m256d interest_d = _mm256_mul_pd(bd, rate);
+    // not <=, unordered is true too: a NaN or an inf - inf goes to accrue_one, which throws
+    const __m256d too_big = _mm256_cmp_pd(_mm256_andnot_pd(sign_d, interest_d), limit_d, _CMP_NLE_UQ);
+
+    if (!_mm256_testz_si256(out, out) || _mm256_movemask_pd(too_big) != 0) {
+      for (std::size_t j {i}; j < i + 4; j++)
+        total += accrue_one(balances[j], int_rates[j], threshold, crossed);
+      continue;
+    }
+
+    // adding the magic number rounds half to even and leaves the integer in the low bits
+    const __m256i interest = _mm256_sub_epi64(
+      _mm256_castpd_si256(_mm256_add_pd(interest_d, magic_d)), magic_i);
+    const __m256i after = _mm256_add_epi64(b, interest);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&balances[i]), after);
+    sum = _mm256_add_epi64(sum, interest);
+
+    // below before, at or above after
+    const __m256i reached = _mm256_andnot_si256(_mm256_cmpgt_epi64(thr, after), _mm256_cmpgt_epi64(thr, b));
+    crossed += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(reached)));
+  }
+
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+  total += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+  for (; i < balances.size(); i++)
+    total += accrue_one(balances[i], int_rates[i], threshold, crossed);
+
+  return total;
+}
+
+/*
+
+  - most stores have a few rates, the factors of the last ones are kept in a few slots that
+    are searched one by one, a factor is made by the engine only for a rate that is not
+    there, and one 64 by 128 bit multiplication an account is what is left.
+
+*/
+std::int64_t Account_store::compound(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+  std::uint64_t periods, Compound_interest &engine, std::int64_t threshold, std::size_t &crossed)
+{
+  constexpr std::size_t num_slots = 8;
+  double rates[num_slots];
+  Compound_interest::Factor factors[num_slots];
+  std::size_t used {0}, next {0};
+  std::int64_t total {0};
+
+  for (std::size_t i {0}; i < balances.size(); i++) {
+    std::size_t slot {0};
+    while (slot < used && rates[slot] != int_rates[i])
+      slot++;
+    if (slot == used) {
+      slot = used < num_slots ? used++ : next++ % num_slots;
+      rates[slot] = int_rates[i];
+      factors[slot] = engine.factor(int_rates[i], periods);
+    }
+    const Compound_interest::Factor factor = factors[slot];
+    const std::int64_t before = balances[i];
+    balances[i] = Compound_interest::apply(before, factor);
+    total += balances[i] - before;
+    crossed += before < threshold && balances[i] >= threshold;
+  }
+
+  return total;
+}
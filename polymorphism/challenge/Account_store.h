@@ -0,0 +1,153 @@
+#ifndef _ACCOUNT_STORE_H_
+#define _ACCOUNT_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Account.h"
+#include "Compound_interest.h"
+#include "Money.h"
+#include "Transaction.h"
+#include "../../algorithms/parallelAlgorithms/Offload.h"
+#include "../../algorithms/streamWindows/Windows.h"
+#include "../../tooling/largeBuffer/Large_buffer.h"
+
+/*
+
+  - Account_store keeps the state of every account in contiguous arrays, one group per
+    account type, so a batch operation is one tight, non virtual loop per type.
+
+  - the Account objects stay a view over the store: load() picks them up and
+    sync() writes the balances back into them.
+
+  - the position of an account is the order it was added in, the account_id of a
+    Transaction, apply() runs one with the rules of the class of the account, the way
+    Journal::replay does for a journal.
+
+  - the balances, the rates and the withdrawals are large_buffer::Vectors, a restore from a
+    checkpoint resizes them without zeroing them before the copy, and 10M balances are in
+    huge pages.
+
+  - a withdrawal limit is a sliding window over the withdrawals of every account, their
+    amount and their number, a windows::Sliding_sums keyed by position, the generalized
+    max_withdrawls of Trust_account. apply() with a time checks the window of the account,
+    O(1), no history is kept or rescanned, and adds an accepted withdrawal to it, apply()
+    without one is outside of the windows. a Checkpoint has the windows too.
+
+*/
+class Account_store
+{
+  friend class Checkpoint;
+  friend class Ledger_node;
+
+public:
+  enum class Type: std::uint8_t { Checking, Saving, Trust };
+
+  struct Id
+  {
+    Type type;
+    std::size_t index;
+  };
+
+  struct Accrual_result
+  {
+    Money interest;               // total interest paid
+    std::size_t trust_crossed;    // trust accounts that reached bonus_threshold
+  };
+
+private:
+  struct Checking_group
+  {
+    std::vector<std::string> names;
+    large_buffer::Vector<std::int64_t> balances;
+    std::vector<Account*> views;
+  };
+
+  struct Saving_group
+  {
+    std::vector<std::string> names;
+    large_buffer::Vector<std::int64_t> balances;
+    large_buffer::Vector<double> int_rates;
+    std::vector<Account*> views;
+  };
+
+  struct Trust_group
+  {
+    std::vector<std::string> names;
+    large_buffer::Vector<std::int64_t> balances;
+    large_buffer::Vector<double> int_rates;
+    large_buffer::Vector<int> num_withdrawls;
+    std::vector<Account*> views;
+  };
+
+  struct Withdrawn
+  {
+    std::int64_t cents;
+    std::int64_t count;
+
+    Withdrawn &operator+=(const Withdrawn &rhs) { this->cents += rhs.cents; this->count += rhs.count; return *this; }
+    Withdrawn &operator-=(const Withdrawn &rhs) { this->cents -= rhs.cents; this->count -= rhs.count; return *this; }
+  };
+
+  Checking_group checking;
+  Saving_group saving;
+  Trust_group trust;
+  std::vector<Id> ids;  // by position
+
+  // the limit of the withdrawals in a window, max_count 0 for any number of them
+  bool limited {false};
+  std::int64_t max_cents {0};
+  std::int64_t max_count {0};
+  windows::Sliding_sums<Withdrawn> withdrawn {1, 1};  // by position
+
+  static std::size_t deposit_checking(large_buffer::Vector<std::int64_t> &balances, Money amount);
+  static std::size_t withdraw_checking(large_buffer::Vector<std::int64_t> &balances, Money amount);
+  static std::size_t deposit_saving(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+    Money amount);
+  static std::size_t withdraw_saving(large_buffer::Vector<std::int64_t> &balances, Money amount);
+  static std::size_t deposit_trust(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+    Money amount);
+  static std::size_t withdraw_trust(large_buffer::Vector<std::int64_t> &balances, large_buffer::Vector<int> &num_withdrawls, 
+    Money amount);
+  static std::int64_t accrue(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+    std::int64_t threshold, std::size_t &crossed, offload::Target target);
+  static std::int64_t compound(large_buffer::Vector<std::int64_t> &balances, const large_buffer::Vector<double> &int_rates, 
+    std::uint64_t periods, Compound_interest &engine, std::int64_t threshold, std::size_t &crossed);
+
+public:
+  Id add_checking(const std::string &name, Money balance, Account *view = nullptr);
+  Id add_saving(const std::string &name, Money balance, double int_rate, Account *view = nullptr);
+  Id add_trust(const std::string &name, Money balance, double int_rate, int num_withdrawls = 0, 
+    Account *view = nullptr);
+
+  void load(const std::vector<Account*> &accounts);
+  void sync() const;
+
+  std::size_t deposit(Money amount);
+  std::size_t withdraw(Money amount);
+  // the transaction on the account at its position, false when it is refused or there is none
+  bool apply(const Transaction &transaction);
+  // the same at a time, in the unit of the width of the limit: a withdrawal that goes past the
+  // limit of the window of its account is refused, an accepted one is counted in it
+  bool apply(const Transaction &transaction, std::int64_t time);
+
+  // at most max_amount and max_count withdrawals (0 for no limit on their number) from every
+  // account in a sliding window of width, in num_buckets buckets, the windows start empty
+  void set_withdrawal_limit(Money max_amount, int max_count, std::int64_t width, std::size_t num_buckets = 24);
+  // what was withdrawn from the account at its position in the window of time
+  Money get_withdrawn(std::size_t position, std::int64_t time);
+
+  // period end: every saving and trust balance earns its int_rate percent, rounded to the cent,
+  // on the device of offload::use_device for many accounts, the same cents as on the host
+  Accrual_result accrue_interest(offload::Target target = offload::Target::automatic);
+  // periods of them in one step, the exact compound rounded once, see Compound_interest.h
+  Accrual_result compound_interest(std::uint64_t periods, Compound_interest &engine);
+
+  Money get_balance(Id id) const;
+  // the sum of every balance in the store
+  Money get_total_balance() const;
+  std::size_t size() const;
+};
+
+#endif
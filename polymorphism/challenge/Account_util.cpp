@@ -1,4 +1,6 @@
 #include "Account_util.h"
+#include "Account_log.h"
+#include "../../tooling/tracing/Trace.h"
 
 void display(const std::vector<Account*> &accounts)
 {
@@ -6,20 +8,103 @@ void display(const std::vector<Account*> &accounts)
     std::cout << *ptr << std::endl;
 }
 
-void deposit(std::vector<Account*> &accounts, double amount)
+void display_bulk(const std::vector<Account*> &accounts, std::vector<char> &buffer, std::ostream &os)
+{
+  TRACE_SCOPE("display_bulk");
+  std::size_t size {0};
+  for (const auto &ptr: accounts)
+    size += ptr->format_size() + 1;
+  if (buffer.size() < size)
+    buffer.resize(size);
+
+  char *end = buffer.data();
+  for (const auto &ptr: accounts) {
+    end = ptr->format(end);
+    *end++ = '\n';
+  }
+
+  os.write(buffer.data(), end - buffer.data());
+  os.flush();
+}
+
+void display_bulk(const std::vector<Account*> &accounts, std::ostream &os)
+{
+  std::vector<char> buffer;
+  display_bulk(accounts, buffer, os);
+}
+
+// the lines of the calls without a logger, written by its thread to std::cout
+static binary_log::Logger &console_log()
+{
+  static binary_log::Logger log {std::cout};
+  return log;
+}
+
+void deposit(std::vector<Account*> &accounts, Money amount, binary_log::Logger &log)
 {
   for (const auto &ptr: accounts)
     if (ptr->deposit(amount))
-      std::cout << "Deposited " << amount << " to " << *ptr << std::endl;
+      log.write(deposited_line, amount, *ptr);
     else
-      std::cout << "Failed deposit of " << amount << " to " << *ptr << std::endl;
+      log.write(failed_deposit_line, amount, *ptr);
 }
 
-void withdraw(std::vector<Account*> &accounts, double amount)
+void withdraw(std::vector<Account*> &accounts, Money amount, binary_log::Logger &log)
 {
   for (const auto &ptr: accounts)
     if (ptr->withdraw(amount))
-      std::cout << "Withdraw " << amount << " from " << *ptr << std::endl;
+      log.write(withdrawn_line, amount, *ptr);
     else
-      std::cout << "Failed withdraw of " << amount << " from " << *ptr << std::endl;
+      log.write(failed_withdraw_line, amount, *ptr);
+}
+
+void deposit(std::vector<Account*> &accounts, Money amount)
+{
+  deposit(accounts, amount, console_log());
+  console_log().flush();
+}
+
+void withdraw(std::vector<Account*> &accounts, Money amount)
+{
+  withdraw(accounts, amount, console_log());
+  console_log().flush();
+}
+
+std::vector<bool> apply_transactions(std::vector<Account*> &accounts, const std::vector<Transaction> &transactions)
+{
+  TRACE_SCOPE("apply_transactions");
+  TRACE_COUNT("transactions", transactions.size());
+  std::vector<bool> results(transactions.size());
+
+  for (std::size_t i {0}; i < transactions.size(); i++) {
+    const Transaction &t = transactions[i];
+    if (t.account_id >= accounts.size())
+      continue;
+
+    Account *ptr = accounts[t.account_id];
+    results[i] = t.op == Operation::Deposit ? ptr->deposit(t.amount) : ptr->withdraw(t.amount);
+  }
+
+  return results;
+}
+
+void report(const std::vector<Account*> &accounts, const std::vector<Transaction> &transactions, 
+  const std::vector<bool> &results)
+{
+  std::size_t failed {0};
+
+  for (std::size_t i {0}; i < transactions.size(); i++) {
+    const Transaction &t = transactions[i];
+    const char *op = t.op == Operation::Deposit ? "deposit" : "withdraw";
+
+    if (results[i])
+      std::cout << "Applied " << op << " of " << t.amount << " on account " << t.account_id << '\n';
+    else {
+      std::cout << "Failed " << op << " of " << t.amount << " on account " << t.account_id << '\n';
+      failed++;
+    }
+  }
+
+  std::cout << transactions.size() - failed << " applied, " << failed << " failed" << std::endl;
+  display(accounts);
 }
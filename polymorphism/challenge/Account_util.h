@@ -4,9 +4,39 @@
 #include <iostream>
 #include <vector>
 #include "Account.h"
+#include "Transaction.h"
 
 void display(const std::vector<Account*> &accounts);
-void deposit(std::vector<Account*> &accounts, double amount);
-void withdraw(std::vector<Account*> &accounts, double amount);
+
+// formats every account into buffer and writes them to os at once, the buffer can be reused between calls
+void display_bulk(const std::vector<Account*> &accounts, std::vector<char> &buffer, std::ostream &os = std::cout);
+void display_bulk(const std::vector<Account*> &accounts, std::ostream &os = std::cout);
+
+namespace binary_log { class Logger; }
+
+/*
+
+  - deposit and withdraw write a line for every account through log, a record of the amount
+    and of the account (Account_log.h), the thread of log formats it, no formatting and no
+    flush in the loop. without log the lines go to std::cout, the call waits for them once,
+    at its end, so they come before anything printed after it.
+
+*/
+void deposit(std::vector<Account*> &accounts, Money amount, binary_log::Logger &log);
+void withdraw(std::vector<Account*> &accounts, Money amount, binary_log::Logger &log);
+void deposit(std::vector<Account*> &accounts, Money amount);
+void withdraw(std::vector<Account*> &accounts, Money amount);
+
+/*
+
+  - apply_transactions runs every transaction in one pass and prints nothing,
+    results[i] is true when transactions[i] succeeded.
+
+  - report prints the outcome afterwards, with a single flush at the end.
+
+*/
+std::vector<bool> apply_transactions(std::vector<Account*> &accounts, const std::vector<Transaction> &transactions);
+void report(const std::vector<Account*> &accounts, const std::vector<Transaction> &transactions, 
+  const std::vector<bool> &results);
 
 #endif
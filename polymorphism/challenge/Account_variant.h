@@ -0,0 +1,189 @@
+#ifndef _ACCOUNT_VARIANT_H_
+#define _ACCOUNT_VARIANT_H_
+
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "Account.h"
+#include "Checking_account.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+
+/*
+
+  - Any_account holds one of the three accounts by value, no pointer and no heap, std::visit
+    picks the type with a switch on its index instead of a load of the vtable, and calls the
+    function of that type by name, a.Saving_account::deposit(x), so it is a direct call, inlined,
+    even for Saving_account, which is not final, a call on a Saving_account& would be virtual.
+
+  - Account_batches keeps the accounts in one vector per type, a loop over one vector knows its
+    type without a visit, the whole deposit of every checking account is one inlined loop. the
+    index of an account is its place in the vector of its type, the vectors move their accounts
+    when they grow, a pointer to one is good until the next add.
+
+  - the virtual functions are still there, an Any_account or a batch can be printed, or passed
+    to Account_util.h, as an Account&.
+
+*/
+using Any_account = std::variant<Checking_account, Saving_account, Trust_account>;
+
+namespace detail_account_variant
+{
+  template<typename T>
+  bool deposit(T &account, Money amount)
+  {
+    return account.T::deposit(amount);
+  }
+
+  template<typename T>
+  bool withdraw(T &account, Money amount)
+  {
+    return account.T::withdraw(amount);
+  }
+}
+
+inline bool deposit(Any_account &account, Money amount)
+{
+  return std::visit([amount](auto &a) { return detail_account_variant::deposit(a, amount); }, account);
+}
+
+inline bool withdraw(Any_account &account, Money amount)
+{
+  return std::visit([amount](auto &a) { return detail_account_variant::withdraw(a, amount); }, account);
+}
+
+inline Account &as_account(Any_account &account)
+{
+  return std::visit([](auto &a) -> Account & { return a; }, account);
+}
+
+inline const Account &as_account(const Any_account &account)
+{
+  return std::visit([](const auto &a) -> const Account & { return a; }, account);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const Any_account &account)
+{
+  return os << as_account(account);
+}
+
+// the number of accounts that took the amount
+inline std::size_t deposit(std::vector<Any_account> &accounts, Money amount)
+{
+  std::size_t done {0};
+  for (Any_account &account : accounts)
+    done += deposit(account, amount);
+  return done;
+}
+
+inline std::size_t withdraw(std::vector<Any_account> &accounts, Money amount)
+{
+  std::size_t done {0};
+  for (Any_account &account : accounts)
+    done += withdraw(account, amount);
+  return done;
+}
+
+class Account_batches
+{
+private:
+  std::vector<Checking_account> checking;
+  std::vector<Saving_account> saving;
+  std::vector<Trust_account> trust;
+
+public:
+  Checking_account &add(Checking_account account)
+  {
+    return this->checking.emplace_back(std::move(account));
+  }
+
+  Saving_account &add(Saving_account account)
+  {
+    return this->saving.emplace_back(std::move(account));
+  }
+
+  Trust_account &add(Trust_account account)
+  {
+    return this->trust.emplace_back(std::move(account));
+  }
+
+  void add(Any_account account)
+  {
+    std::visit([this](auto &a) { this->add(std::move(a)); }, account);
+  }
+
+  void reserve(std::size_t checking, std::size_t saving, std::size_t trust)
+  {
+    this->checking.reserve(checking);
+    this->saving.reserve(saving);
+    this->trust.reserve(trust);
+  }
+
+  // fn is called with every account, as its own type, one vector after the other
+  template<typename Fn>
+  void for_each(Fn fn)
+  {
+    for (Checking_account &account : this->checking)
+      fn(account);
+    for (Saving_account &account : this->saving)
+      fn(account);
+    for (Trust_account &account : this->trust)
+      fn(account);
+  }
+
+  template<typename Fn>
+  void for_each(Fn fn) const
+  {
+    for (const Checking_account &account : this->checking)
+      fn(account);
+    for (const Saving_account &account : this->saving)
+      fn(account);
+    for (const Trust_account &account : this->trust)
+      fn(account);
+  }
+
+  std::size_t deposit(Money amount)
+  {
+    std::size_t done {0};
+    this->for_each([&done, amount](auto &a) { done += detail_account_variant::deposit(a, amount); });
+    return done;
+  }
+
+  std::size_t withdraw(Money amount)
+  {
+    std::size_t done {0};
+    this->for_each([&done, amount](auto &a) { done += detail_account_variant::withdraw(a, amount); });
+    return done;
+  }
+
+  Money total_balance() const
+  {
+    Money total;
+    this->for_each([&total](const Account &a) { total += a.get_balance(); });
+    return total;
+  }
+
+  std::vector<Account*> accounts()
+  {
+    std::vector<Account*> result;
+    result.reserve(this->size());
+    this->for_each([&result](Account &a) { result.push_back(&a); });
+    return result;
+  }
+
+  std::size_t size() const
+  {
+    return this->checking.size() + this->saving.size() + this->trust.size();
+  }
+
+  void clear()
+  {
+    this->checking.clear();
+    this->saving.clear();
+    this->trust.clear();
+  }
+};
+
+#endif
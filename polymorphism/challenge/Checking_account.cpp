@@ -1,24 +1,20 @@
 #include <iostream>
-#include <iomanip>
 #include "Checking_account.h" 
 
-Checking_account::Checking_account(const std::string name, const double balance)
+Checking_account::Checking_account(const std::string name, const Money balance)
   : Account(name, balance)
 {}
 
-bool Checking_account::deposit(double amount)
+std::size_t Checking_account::format_size() const
 {
-  return Account::deposit(amount);
+  return sizeof(prefix) + this->name.size() + sizeof(balance_label) + Money::max_chars + sizeof(suffix);
 }
 
-bool Checking_account::withdraw(double amount)
+char *Checking_account::format(char *buff) const
 {
-  amount += this->fee_withdraw;
-  return Account::withdraw(amount);
-}
-
-void Checking_account::print(std::ostream &os) const
-{
-  std::cout << std::fixed << std::setprecision(2);
-  os << "Checking_account: { name: " << this->name << ", balance: " << this->balance << " }";
+  buff = put(buff, prefix, sizeof(prefix) - 1);
+  buff = put(buff, this->name.data(), this->name.size());
+  buff = put(buff, balance_label, sizeof(balance_label) - 1);
+  buff = this->balance.format(buff);
+  return put(buff, suffix, sizeof(suffix) - 1);
 }
@@ -5,19 +5,37 @@
 
 class Checking_account final: public Account
 {
+  friend class Account_store;
+  friend struct Account_policy;
+
 private:
   static constexpr const char *def_name = "Unnamed checking account";
-  static constexpr double def_balance = 0.0;
-  static constexpr double fee_withdraw = 1.50;
+  static constexpr Money def_balance = 0.0;
+  static constexpr Money fee_withdraw = 1.50;
+  static constexpr char prefix[] = "Checking_account: { name: ";
+  static constexpr char balance_label[] = ", balance: ";
+  static constexpr char suffix[] = " }";
 
 public:
-  Checking_account(const std::string name = def_name, const double balance = def_balance);
+  Checking_account(const std::string name = def_name, const Money balance = def_balance);
 
   virtual ~Checking_account() = default;
 
-  virtual bool deposit(double amount) override;
-  virtual bool withdraw(double amount) override;
-  virtual void print(std::ostream &os) const override;
+  virtual bool deposit(Money amount) override;
+  virtual bool withdraw(Money amount) override;
+  virtual std::size_t format_size() const override;
+  virtual char *format(char *buff) const override;
 };
 
+inline bool Checking_account::deposit(Money amount)
+{
+  return Account::deposit(amount);
+}
+
+inline bool Checking_account::withdraw(Money amount)
+{
+  amount += this->fee_withdraw;
+  return Account::withdraw(amount);
+}
+
 #endif
@@ -0,0 +1,378 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Checkpoint.h"
+
+static void fail(const std::string &what)
+{
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/*
+
+  - the writes of the child go through a buffer on its stack, a name is a few bytes and a
+    write of its own each would be 100M system calls, the arrays go straight to the file.
+
+*/
+namespace detail_checkpoint
+{
+  class Writer
+  {
+  private:
+    static constexpr std::size_t buffer_size = 1 << 16;
+
+    int fd;
+    char buffer[buffer_size];
+    std::size_t used {0};
+    bool ok {true};
+
+    void write_all(const char *data, std::size_t size)
+    {
+      while (this->ok && size > 0) {
+        const ssize_t written = ::write(this->fd, data, size);
+        if (written < 0 && errno == EINTR)
+          continue;
+        if (written <= 0) {
+          this->ok = false;
+          return;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+      }
+    }
+
+  public:
+    explicit Writer(int fd)
+      : fd{fd}
+    {}
+
+    void put(const void *data, std::size_t size)
+    {
+      // the data of an empty vector can be null, memcpy of it is undefined even for 0 bytes
+      if (size == 0)
+        return;
+      if (this->used + size > buffer_size)
+        this->flush();
+      if (size > buffer_size) {
+        this->write_all(static_cast<const char*>(data), size);
+        return;
+      }
+      std::memcpy(this->buffer + this->used, data, size);
+      this->used += size;
+    }
+
+    template<typename T, typename Allocator>
+    void put_array(const std::vector<T, Allocator> &values)
+    {
+      this->put(values.data(), values.size() * sizeof(T));
+    }
+
+    void put_names(const std::vector<std::string> &names)
+    {
+      for (const auto &name: names) {
+        const std::uint32_t size = static_cast<std::uint32_t>(name.size());
+        this->put(&size, sizeof(size));
+        this->put(name.data(), name.size());
+      }
+    }
+
+    bool flush()
+    {
+      this->write_all(this->buffer, this->used);
+      this->used = 0;
+      return this->ok;
+    }
+  };
+
+  class Reader
+  {
+  private:
+    const char *data;
+    std::size_t size;
+    std::size_t at {0};
+    const std::string &path;
+
+  public:
+    Reader(const char *data, std::size_t size, const std::string &path)
+      : data{data}, size{size}, path{path}
+    {}
+
+    const char *take(std::size_t count)
+    {
+      if (count > this->size - this->at)
+        throw std::runtime_error(this->path + " is a truncated account checkpoint");
+      const char *ptr = this->data + this->at;
+      this->at += count;
+      return ptr;
+    }
+
+    template<typename T, typename Allocator>
+    void get_array(std::vector<T, Allocator> &values, std::size_t count)
+    {
+      const char *ptr = this->take(count * sizeof(T));
+      values.resize(count);
+      if (count == 0)
+        return;
+      std::memcpy(values.data(), ptr, count * sizeof(T));
+    }
+
+    void get_names(std::vector<std::string> &names, std::size_t count)
+    {
+      names.resize(count);
+      for (auto &name: names) {
+        std::uint32_t length;
+        std::memcpy(&length, this->take(sizeof(length)), sizeof(length));
+        name.assign(this->take(length), length);
+      }
+    }
+  };
+}
+
+Checkpoint::Checkpoint(const std::string &path, const Account_store &store, Journal &journal)
+  : child{-1}, status{-1}, journal_size{0}, pause_us{0.0}
+{
+  journal.commit();
+  this->journal_size = journal.size();
+
+  const std::string temporary = path + ".tmp";
+  Header header;
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.journal_size = this->journal_size;
+  header.num_checking = store.checking.balances.size();
+  header.num_saving = store.saving.balances.size();
+  header.num_trust = store.trust.balances.size();
+  header.window_width = store.limited ? store.withdrawn.get_width() : 0;
+  header.window_buckets = store.limited ? store.withdrawn.get_num_buckets() : 0;
+  header.window_keys = store.limited ? store.withdrawn.size() : 0;
+  header.max_cents = store.max_cents;
+  header.max_count = store.max_count;
+
+  auto start = std::chrono::steady_clock::now();
+  this->child = ::fork();
+  if (this->child < 0)
+    fail("fork");
+
+  if (this->child == 0) {
+    // the child, from here on only what is safe after a fork
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    const bool written = fd >= 0 && write_store(fd, store, header) && ::fsync(fd) == 0;
+    if (fd >= 0)
+      ::close(fd);
+    ::_exit(written && ::rename(temporary.c_str(), path.c_str()) == 0 ? 0 : 1);
+  }
+
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  this->pause_us = elapsed.count();
+}
+
+Checkpoint::~Checkpoint()
+{
+  this->wait();
+}
+
+bool Checkpoint::write_store(int fd, const Account_store &store, const Header &header)
+{
+  detail_checkpoint::Writer writer {fd};
+  writer.put(&header, sizeof(header));
+  for (const auto &id: store.ids) {
+    const std::uint8_t type = static_cast<std::uint8_t>(id.type);
+    writer.put(&type, sizeof(type));
+  }
+
+  writer.put_array(store.checking.balances);
+  writer.put_names(store.checking.names);
+
+  writer.put_array(store.saving.balances);
+  writer.put_array(store.saving.int_rates);
+  writer.put_names(store.saving.names);
+
+  writer.put_array(store.trust.balances);
+  writer.put_array(store.trust.int_rates);
+  writer.put_array(store.trust.num_withdrawls);
+  writer.put_names(store.trust.names);
+
+  if (header.window_buckets != 0) {
+    writer.put_array(store.withdrawn.get_buckets());
+    writer.put_array(store.withdrawn.get_heads());
+  }
+  return writer.flush();
+}
+
+bool Checkpoint::done()
+{
+  if (this->status >= 0)
+    return true;
+
+  int result;
+  const pid_t pid = ::waitpid(this->child, &result, WNOHANG);
+  if (pid == 0)
+    return false;
+  this->status = pid == this->child && WIFEXITED(result) && WEXITSTATUS(result) == 0 ? 0 : 1;
+  return true;
+}
+
+bool Checkpoint::wait()
+{
+  if (this->status < 0) {
+    int result;
+    pid_t pid;
+    while ((pid = ::waitpid(this->child, &result, 0)) < 0 && errno == EINTR) {}
+    this->status = pid == this->child && WIFEXITED(result) && WEXITSTATUS(result) == 0 ? 0 : 1;
+  }
+  return this->status == 0;
+}
+
+std::uint64_t Checkpoint::get_journal_size() const
+{
+  return this->journal_size;
+}
+
+double Checkpoint::get_pause_us() const
+{
+  return this->pause_us;
+}
+
+template<typename T, typename Allocator>
+void Checkpoint::reserve_huge(std::vector<T, Allocator> &values, std::size_t count)
+{
+  values.reserve(count);
+  // the whole huge pages inside the array, advised before anything is written to them
+  constexpr std::uintptr_t huge_page = std::uintptr_t {1} << 21;
+  const std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(values.data()) + huge_page - 1) & ~(huge_page - 1);
+  const std::uintptr_t last = (reinterpret_cast<std::uintptr_t>(values.data() + values.capacity())) & ~(huge_page - 1);
+#ifdef MADV_HUGEPAGE
+  if (last > first)
+    ::madvise(reinterpret_cast<void*>(first), last - first, MADV_HUGEPAGE);
+#endif
+}
+
+void Checkpoint::reserve(Account_store &store, std::size_t num_checking, std::size_t num_saving, 
+  std::size_t num_trust)
+{
+  reserve_huge(store.ids, num_checking + num_saving + num_trust);
+
+  reserve_huge(store.checking.names, num_checking);
+  reserve_huge(store.checking.balances, num_checking);
+  reserve_huge(store.checking.views, num_checking);
+
+  reserve_huge(store.saving.names, num_saving);
+  reserve_huge(store.saving.balances, num_saving);
+  reserve_huge(store.saving.int_rates, num_saving);
+  reserve_huge(store.saving.views, num_saving);
+
+  reserve_huge(store.trust.names, num_trust);
+  reserve_huge(store.trust.balances, num_trust);
+  reserve_huge(store.trust.int_rates, num_trust);
+  reserve_huge(store.trust.num_withdrawls, num_trust);
+  reserve_huge(store.trust.views, num_trust);
+}
+
+std::uint64_t Checkpoint::restore(const std::string &path, Account_store &store)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    fail("open " + path);
+
+  struct stat st;
+  if (::fstat(fd, &st) < 0) {
+    ::close(fd);
+    fail("stat " + path);
+  }
+  const std::size_t size = static_cast<std::size_t>(st.st_size);
+  if (size < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error(path + " is not an account checkpoint");
+  }
+
+  void *ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (ptr == MAP_FAILED)
+    fail("mmap " + path);
+
+  try {
+    detail_checkpoint::Reader reader {static_cast<const char*>(ptr), size, path};
+    Header header;
+    std::memcpy(&header, reader.take(sizeof(header)), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+      throw std::runtime_error(path + " is not an account checkpoint");
+
+    const bool same_accounts = store.checking.balances.size() == header.num_checking
+      && store.saving.balances.size() == header.num_saving
+      && store.trust.balances.size() == header.num_trust;
+    if (store.size() != 0 && !same_accounts)
+      throw std::runtime_error(path + " is a checkpoint of other accounts");
+
+    // read into a store of its own, a truncated file leaves the one given as it was
+    Account_store restored;
+    const std::size_t num_accounts = header.num_checking + header.num_saving + header.num_trust;
+    const char *types = reader.take(num_accounts);
+    reserve(restored, header.num_checking, header.num_saving, header.num_trust);
+    std::size_t counts[3] {0, 0, 0};
+    restored.ids.resize(num_accounts);
+    for (std::size_t i {0}; i < num_accounts; i++) {
+      const std::uint8_t type = static_cast<std::uint8_t>(types[i]);
+      if (type > 2)
+        throw std::runtime_error(path + " is not an account checkpoint");
+      restored.ids[i] = {static_cast<Account_store::Type>(type), counts[type]++};
+    }
+    if (counts[0] != header.num_checking || counts[1] != header.num_saving || counts[2] != header.num_trust)
+      throw std::runtime_error(path + " is not an account checkpoint");
+
+    reader.get_array(restored.checking.balances, header.num_checking);
+    reader.get_names(restored.checking.names, header.num_checking);
+
+    reader.get_array(restored.saving.balances, header.num_saving);
+    reader.get_array(restored.saving.int_rates, header.num_saving);
+    reader.get_names(restored.saving.names, header.num_saving);
+
+    reader.get_array(restored.trust.balances, header.num_trust);
+    reader.get_array(restored.trust.int_rates, header.num_trust);
+    reader.get_array(restored.trust.num_withdrawls, header.num_trust);
+    reader.get_names(restored.trust.names, header.num_trust);
+
+    if (header.window_buckets != 0) {
+      if (header.window_keys > num_accounts || header.window_width <= 0 
+        || header.max_count < 0 || header.max_count > INT32_MAX)
+        throw std::runtime_error(path + " is not an account checkpoint");
+      std::vector<Account_store::Withdrawn> buckets;
+      std::vector<std::int64_t> heads;
+      reader.get_array(buckets, header.window_keys * header.window_buckets);
+      reader.get_array(heads, header.window_keys);
+      try {
+        restored.set_withdrawal_limit(Money::from_cents(header.max_cents), static_cast<int>(header.max_count),
+          header.window_width, header.window_buckets);
+      }
+      catch (const std::invalid_argument &) {
+        throw std::runtime_error(path + " is not an account checkpoint");
+      }
+      restored.withdrawn.assign(std::move(buckets), std::move(heads));
+    }
+
+    if (store.size() != 0) {
+      restored.checking.views = std::move(store.checking.views);
+      restored.saving.views = std::move(store.saving.views);
+      restored.trust.views = std::move(store.trust.views);
+    }
+    else {
+      restored.checking.views.resize(header.num_checking, nullptr);
+      restored.saving.views.resize(header.num_saving, nullptr);
+      restored.trust.views.resize(header.num_trust, nullptr);
+    }
+    store = std::move(restored);
+
+    ::munmap(ptr, size);
+    return header.journal_size;
+  }
+  catch (...) {
+    ::munmap(ptr, size);
+    throw;
+  }
+}
@@ -0,0 +1,95 @@
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "Account_store.h"
+#include "Journal.h"
+
+/*
+
+  - Checkpoint writes an Account_store to a file while the store goes on taking
+    transactions, a restart loads the latest one and replays only the records of the
+    journal after it, not the whole journal.
+
+  - the capture is a fork(): the child has the store as it was at that moment, copy on
+    write, and writes it out, the parent only waits for the copy of its page tables, a few
+    milliseconds for the arrays of 100M accounts, and gets back to work. a page the parent
+    writes after it is copied the first time, the batch operations of the store write them
+    all, so every page is copied once at most while the child runs. that is why there is
+    no tracking of dirty pages, after one deposit to every account they are all dirty.
+
+  - the child writes to path + ".tmp", syncs it and renames it over path, a crash in the
+    middle leaves the checkpoint before it. it calls only what is safe after a fork of a
+    process with threads, no malloc, the path is made before the fork.
+
+  - the copy of the page tables is one entry a page, about 15 ms for 10M accounts in pages
+    of 4 KB. reserve() makes room for the arrays of a store up front and asks for huge pages
+    for them, one entry per 2 MB, the pause is 0.7 ms there and a few at 100M accounts, a
+    restored store is in them too. arrays that grow past it are reallocated in small pages.
+
+  - the journal is committed before the fork and its size is in the checkpoint, the store
+    has to have every record of it applied and no other one, the caller applies and appends
+    each transaction together. the withdrawal windows of the store are in it, the records
+    after it that were appended with their time move them on. POSIX only, errors from the operating system are thrown as
+    std::runtime_error.
+
+*/
+class Checkpoint
+{
+private:
+  struct Header
+  {
+    char magic[8];
+    std::uint64_t journal_size;
+    std::uint64_t num_checking;
+    std::uint64_t num_saving;
+    std::uint64_t num_trust;
+    // the withdrawal limit, window_buckets 0 for none, and the accounts with a window
+    std::int64_t window_width;
+    std::uint64_t window_buckets;
+    std::uint64_t window_keys;
+    std::int64_t max_cents;
+    std::int64_t max_count;
+  };
+
+  static constexpr char magic[8] = {'A', 'C', 'C', 'T', 'C', 'K', 'P', '2'};
+
+  pid_t child;
+  int status;  // -1 while the child runs
+  std::uint64_t journal_size;
+  double pause_us;
+
+  static bool write_store(int fd, const Account_store &store, const Header &header);
+
+  template<typename T, typename Allocator>
+  static void reserve_huge(std::vector<T, Allocator> &values, std::size_t count);
+
+public:
+  Checkpoint(const std::string &path, const Account_store &store, Journal &journal);
+  Checkpoint(const Checkpoint &source) = delete;
+  Checkpoint &operator=(const Checkpoint &rhs) = delete;
+  ~Checkpoint();
+
+  // true once the child is done, whether it wrote the file or not, without waiting
+  bool done();
+  // true when the file is written
+  bool wait();
+
+  std::uint64_t get_journal_size() const;
+  // how long the store was not taking transactions, the fork
+  double get_pause_us() const;
+
+  // room for the accounts of an empty store, in huge pages where the system has them
+  static void reserve(Account_store &store, std::size_t num_checking, std::size_t num_saving, 
+    std::size_t num_trust);
+
+  // the store becomes the one of the checkpoint, a store of the same accounts keeps its
+  // views, an empty one gets none, returns the journal size to replay from
+  static std::uint64_t restore(const std::string &path, Account_store &store);
+};
+
+#endif
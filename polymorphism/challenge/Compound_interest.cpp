@@ -0,0 +1,66 @@
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "Compound_interest.h"
+
+Compound_interest::Factor Compound_interest::multiply(Factor a, Factor b)
+{
+  // the middle 128 bits of the 256 bit product, the low 64 are truncated
+  const std::uint64_t a_high = static_cast<std::uint64_t>(a >> 64), a_low = static_cast<std::uint64_t>(a);
+  const std::uint64_t b_high = static_cast<std::uint64_t>(b >> 64), b_low = static_cast<std::uint64_t>(b);
+
+  const Factor high = static_cast<Factor>(a_high) * b_high;
+  if (high >> 64 != 0)
+    throw std::overflow_error("Compound_interest: the factor does not fit in 64 integer bits");
+
+  Factor product = high << 64;
+  const Factor parts[3] {static_cast<Factor>(a_high) * b_low, static_cast<Factor>(a_low) * b_high,
+    (static_cast<Factor>(a_low) * b_low) >> 64};
+  for (const Factor part: parts)
+    if (__builtin_add_overflow(product, part, &product))
+      throw std::overflow_error("Compound_interest: the factor does not fit in 64 integer bits");
+  return product;
+}
+
+Compound_interest::Factor Compound_interest::factor(double int_rate, std::uint64_t periods)
+{
+  const std::int64_t micros = std::llround(int_rate * micros_per_percent);
+  constexpr std::int64_t whole = 100 * micros_per_percent;
+  if (micros <= -whole)
+    throw std::overflow_error("Compound_interest: a rate of -100% or less has no factor");
+
+  std::vector<Factor> &table = this->powers[micros];
+  if (table.empty())
+    table.push_back((static_cast<Factor>(whole + micros) << fraction_bits) / whole);
+
+  Factor result = Factor {1} << fraction_bits;
+  for (std::size_t k {0}; periods != 0; k++, periods >>= 1) {
+    // the table grows to the highest bit of the largest n asked for
+    if (k == table.size())
+      table.push_back(multiply(table[k - 1], table[k - 1]));
+    if (periods & 1)
+      result = multiply(result, table[k]);
+  }
+  return result;
+}
+
+std::int64_t Compound_interest::apply(std::int64_t cents, Factor factor)
+{
+  if (cents < 0) {
+    if (cents == std::numeric_limits<std::int64_t>::min())
+      throw std::overflow_error("Compound_interest: the balance does not fit in cents");
+    return -apply(-cents, factor);
+  }
+
+  const std::uint64_t value = static_cast<std::uint64_t>(cents);
+  const Factor high = static_cast<Factor>(value) * static_cast<std::uint64_t>(factor >> fraction_bits);
+  const Factor low = static_cast<Factor>(value) * static_cast<std::uint64_t>(factor);
+  Factor result = high + (low >> fraction_bits);
+  const std::uint64_t fraction = static_cast<std::uint64_t>(low);
+
+  constexpr std::uint64_t half = std::uint64_t {1} << 63;
+  result += fraction > half || (fraction == half && (result & 1) != 0);
+  if (result > static_cast<Factor>(std::numeric_limits<std::int64_t>::max()))
+    throw std::overflow_error("Compound_interest: the balance does not fit in cents");
+  return static_cast<std::int64_t>(result);
+}
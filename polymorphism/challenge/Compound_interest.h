@@ -0,0 +1,57 @@
+#ifndef _COMPOUND_INTEREST_H_
+#define _COMPOUND_INTEREST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+
+  - Compound_interest applies n periods of interest at once, balance * (1 + r)^n, rounded
+    to the cent one time, half to even, instead of n periods of accrue_interest one by one.
+    ten years of daily periods is one multiplication an account, not 3650 of them.
+
+  - the factor (1 + r)^n is a fixed point number, 64 fraction bits in an unsigned __int128.
+    the rate is taken to a millionth of a percent, its factor is exact to the last bit of the
+    fraction, and every rate has a table of its powers of 2, factor^1, factor^2, factor^4, ...
+    made the first time it is used, factor^n is the product of the ones of the bits of n,
+    each product truncated to 64 fraction bits. the cents times the factor are exact, in 192
+    bits, then rounded, so the result is the same on every machine and with every compiler.
+
+  - a factor that does not fit in 64 integer bits and a balance that does not fit in a
+    std::int64_t of cents throw std::overflow_error, the way Money does.
+
+  - it is not the same as n roundings of accrue_interest, those round the interest of every
+    period to the cent and drift from the exact compound by up to a cent a period, this is
+    the exact compound rounded once.
+
+*/
+class Compound_interest
+{
+public:
+  __extension__ using Factor = unsigned __int128;
+  static constexpr unsigned fraction_bits = 64;
+
+private:
+  static constexpr std::int64_t micros_per_percent = 1000000;
+
+  // powers[k] is the factor of the rate to the power 2^k
+  std::unordered_map<std::int64_t, std::vector<Factor>> powers;
+
+  static Factor multiply(Factor a, Factor b);
+
+public:
+  // the factor of n periods at int_rate percent a period
+  Factor factor(double int_rate, std::uint64_t periods);
+
+  // cents times the factor, rounded half to even
+  static std::int64_t apply(std::int64_t cents, Factor factor);
+
+  std::int64_t compound(std::int64_t cents, double int_rate, std::uint64_t periods)
+  {
+    return apply(cents, this->factor(int_rate, periods));
+  }
+};
+
+#endif
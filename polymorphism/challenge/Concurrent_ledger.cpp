@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "Concurrent_ledger.h"
+
+Concurrent_ledger::Concurrent_ledger(std::vector<Account*> &accounts, std::size_t num_stripes)
+  : accounts(accounts), num_stripes(num_stripes == 0 ? 1 : num_stripes), 
+    stripes(new std::mutex[this->num_stripes])
+{}
+
+std::mutex &Concurrent_ledger::stripe_of(std::size_t id) const
+{
+  return this->stripes[id % this->num_stripes];
+}
+
+bool Concurrent_ledger::deposit(std::size_t id, Money amount)
+{
+  std::lock_guard<std::mutex> lock {this->stripe_of(id)};
+  return this->accounts.at(id)->deposit(amount);
+}
+
+bool Concurrent_ledger::withdraw(std::size_t id, Money amount)
+{
+  std::lock_guard<std::mutex> lock {this->stripe_of(id)};
+  return this->accounts.at(id)->withdraw(amount);
+}
+
+Money Concurrent_ledger::get_balance(std::size_t id) const
+{
+  std::lock_guard<std::mutex> lock {this->stripe_of(id)};
+  return this->accounts.at(id)->get_balance();
+}
+
+std::size_t Concurrent_ledger::size() const
+{
+  return this->accounts.size();
+}
+
+/*
+
+  - every thread takes one contiguous slice of the ids, so two threads of the same
+    call never touch the same account, the stripe locks only guard against other
+    callers working on the ledger at the same time.
+
+*/
+template<typename Op>
+static std::size_t for_all(std::size_t size, unsigned num_threads, Op op)
+{
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  num_threads = static_cast<unsigned>(std::min<std::size_t>(num_threads, std::max<std::size_t>(size, 1)));
+
+  std::atomic<std::size_t> ok {0};
+  std::vector<std::thread> threads;
+  const std::size_t slice = (size + num_threads - 1) / num_threads;
+
+  for (unsigned t {0}; t < num_threads; t++)
+    threads.emplace_back([&, t]() {
+      std::size_t local {0};
+      const std::size_t last = std::min(size, (t + 1) * slice);
+      for (std::size_t id = t * slice; id < last; id++)
+        local += op(id);
+      ok += local;
+    });
+
+  for (auto &thread: threads)
+    thread.join();
+
+  return ok;
+}
+
+std::size_t Concurrent_ledger::deposit_all(Money amount, unsigned num_threads)
+{
+  return for_all(this->accounts.size(), num_threads, [&](std::size_t id) { return this->deposit(id, amount); });
+}
+
+std::size_t Concurrent_ledger::withdraw_all(Money amount, unsigned num_threads)
+{
+  return for_all(this->accounts.size(), num_threads, [&](std::size_t id) { return this->withdraw(id, amount); });
+}
@@ -0,0 +1,48 @@
+#ifndef _CONCURRENT_LEDGER_H_
+#define _CONCURRENT_LEDGER_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Account.h"
+#include "Money.h"
+
+/*
+
+  - Concurrent_ledger makes a vector of accounts safe to use from several threads.
+
+  - the accounts are spread over a fixed number of lock stripes (id % num_stripes),
+    a whole deposit or withdraw runs under the stripe lock, so rules that read and
+    write more than the balance (like the Trust_account withdraw limit) still hold.
+
+  - the ledger does not own the accounts.
+
+*/
+class Concurrent_ledger
+{
+private:
+  static constexpr std::size_t def_num_stripes = 64;
+
+  std::vector<Account*> &accounts;
+  std::size_t num_stripes;
+  std::unique_ptr<std::mutex[]> stripes;
+
+  std::mutex &stripe_of(std::size_t id) const;
+
+public:
+  Concurrent_ledger(std::vector<Account*> &accounts, std::size_t num_stripes = def_num_stripes);
+
+  bool deposit(std::size_t id, Money amount);
+  bool withdraw(std::size_t id, Money amount);
+  Money get_balance(std::size_t id) const;
+
+  // apply the operation to every account, split over num_threads threads (0 means one per core),
+  // returns how many accounts accepted it
+  std::size_t deposit_all(Money amount, unsigned num_threads = 0);
+  std::size_t withdraw_all(Money amount, unsigned num_threads = 0);
+
+  std::size_t size() const;
+};
+
+#endif
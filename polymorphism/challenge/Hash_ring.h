@@ -0,0 +1,85 @@
+#ifndef _HASH_RING_H_
+#define _HASH_RING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+
+  - Hash_ring maps an account id to one of the nodes of a partitioned ledger by
+    consistent hashing: every node has points_per_node points on a ring of 64-bit
+    hashes, an id belongs to the node of the first point at or after its hash.
+
+  - a node that is added takes about 1 / num_nodes of the ids, from every other node a
+    little, and one that is removed gives its ids to the nodes after its points, the
+    other ids stay where they are, a modulo would move nearly all of them.
+
+  - the points are a sorted vector, node_of is a binary search, the ring changes only
+    when a node is added or removed.
+
+*/
+class Hash_ring
+{
+private:
+  static constexpr std::size_t def_points_per_node = 64;
+
+  std::size_t points_per_node;
+  std::size_t num_nodes {0};
+  std::vector<std::pair<std::uint64_t, std::size_t>> points;  // the hash of a point and its node
+
+  static std::uint64_t mix(std::uint64_t x)
+  {
+    // splitmix64, ids in a row land all over the ring
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+public:
+  explicit Hash_ring(std::size_t num_nodes = 0, std::size_t points_per_node = def_points_per_node)
+    : points_per_node(points_per_node == 0 ? 1 : points_per_node)
+  {
+    for (std::size_t i {0}; i < num_nodes; i++)
+      this->add_node();
+  }
+
+  // the new node is the number of nodes before it
+  std::size_t add_node()
+  {
+    const std::size_t node = this->num_nodes++;
+    for (std::size_t i {0}; i < this->points_per_node; i++)
+      this->points.emplace_back(mix(node << 32 | i), node);
+    std::sort(this->points.begin(), this->points.end());
+    return node;
+  }
+
+  // the node keeps its number, it is not given ids any more
+  void remove_node(std::size_t node)
+  {
+    this->points.erase(std::remove_if(this->points.begin(), this->points.end(),
+      [node](const std::pair<std::uint64_t, std::size_t> &point) { return point.second == node; }), this->points.end());
+  }
+
+  std::size_t node_of(std::uint64_t id) const
+  {
+    if (this->points.empty())
+      throw std::runtime_error {"Hash_ring: no nodes"};
+    const std::uint64_t hash = mix(id);
+    auto it = std::lower_bound(this->points.begin(), this->points.end(), hash,
+      [](const std::pair<std::uint64_t, std::size_t> &point, std::uint64_t h) { return point.first < h; });
+    return it == this->points.end() ? this->points.front().second : it->second;
+  }
+
+  // the nodes ever added, the removed ones too
+  std::size_t size() const
+  {
+    return this->num_nodes;
+  }
+};
+
+#endif
@@ -1,3 +1,4 @@
+#include <vector>
 #include "I_Printable.h"
 
 std::ostream &operator<<(std::ostream &os, const I_Printable &obj)
@@ -5,3 +6,18 @@ std::ostream &operator<<(std::ostream &os, const I_Printable &obj)
   obj.print(os);
   return os;
 }
+
+void I_Printable::print(std::ostream &os) const
+{
+  constexpr std::size_t stack_size = 256;
+  const std::size_t size = this->format_size();
+
+  if (size <= stack_size) {
+    char buff[stack_size];
+    os.write(buff, this->format(buff) - buff);
+  }
+  else {
+    std::vector<char> buff(size);
+    os.write(buff.data(), this->format(buff.data()) - buff.data());
+  }
+}
@@ -1,14 +1,35 @@
 #ifndef _I_PRINTABLE_H_
 #define _I_PRINTABLE_H_
 
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 class I_Printable
 {
   friend std::ostream &operator<<(std::ostream &os, const I_Printable &obj);
 
+protected:
+  // copies n characters to buff and returns a pointer past them
+  static char *put(char *buff, const char *text, std::size_t n)
+  {
+    std::memcpy(buff, text, n);
+    return buff + n;
+  }
+
 public:
-  virtual void print(std::ostream &os) const = 0;
+  /*
+
+    - format writes the text of the object into buff, which must have room for
+      format_size() characters, and returns a pointer past the last one,
+      no terminator is written and nothing is allocated.
+
+  */
+  virtual std::size_t format_size() const = 0;
+  virtual char *format(char *buff) const = 0;
+
+  // writes the formatted text to os with a single write
+  virtual void print(std::ostream &os) const;
   
   /* 
   
@@ -0,0 +1,252 @@
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Journal.h"
+#include "Account_store.h"
+
+static void fail(const std::string &what)
+{
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+Journal::Journal(const std::string &path, std::size_t group_size)
+  : fd{-1}, writable{true}, data{nullptr}, mapped{0}, count{0}, committed{0}, 
+    group_size{group_size == 0 ? 1 : group_size}
+{
+  this->fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (this->fd < 0)
+    fail("open " + path);
+
+  try {
+    struct stat st;
+    if (::fstat(this->fd, &st) < 0)
+      fail("stat " + path);
+
+    // only a new, empty file gets a header, anything else has to be a journal already
+    if (st.st_size == 0) {
+      this->reserve(0);
+      std::memcpy(this->header()->magic, magic, sizeof(magic));
+      this->header()->count = 0;
+    }
+    else
+      this->map_records(path, static_cast<std::size_t>(st.st_size));
+  }
+  catch (...) {
+    this->release();
+    throw;
+  }
+}
+
+Journal::Journal(const std::string &path, Read_only)
+  : fd{-1}, writable{false}, data{nullptr}, mapped{0}, count{0}, committed{0}, group_size{1}
+{
+  this->fd = ::open(path.c_str(), O_RDONLY);
+  if (this->fd < 0)
+    fail("open " + path);
+
+  try {
+    struct stat st;
+    if (::fstat(this->fd, &st) < 0)
+      fail("stat " + path);
+    this->map_records(path, static_cast<std::size_t>(st.st_size));
+  }
+  catch (...) {
+    this->release();
+    throw;
+  }
+}
+
+Journal::~Journal()
+{
+  if (this->writable) {
+    try {
+      this->commit();
+    }
+    catch (const std::runtime_error &) {}
+
+    // drop the preallocated tail
+    if (this->fd >= 0 && ::ftruncate(this->fd, sizeof(Header) + this->committed * sizeof(Record)) < 0) {}
+  }
+  this->release();
+}
+
+// the header and the records it counts have to be in the size of the file
+void Journal::map_records(const std::string &path, std::size_t size)
+{
+  if (size < sizeof(Header))
+    throw std::runtime_error(path + " is not an account journal");
+
+  const int prot = this->writable ? PROT_READ | PROT_WRITE : PROT_READ;
+  void *ptr = ::mmap(nullptr, size, prot, MAP_SHARED, this->fd, 0);
+  if (ptr == MAP_FAILED)
+    fail("mmap " + path);
+  this->data = static_cast<char*>(ptr);
+  this->mapped = size;
+
+  if (std::memcmp(this->header()->magic, magic, sizeof(magic)) != 0)
+    throw std::runtime_error(path + " is not an account journal");
+  const std::uint64_t num_records = this->header()->count;
+  if (num_records > (size - sizeof(Header)) / sizeof(Record))
+    throw std::runtime_error(path + " is truncated or corrupt, its header has more records than the file");
+  // anything after the last commit is discarded and overwritten
+  this->count = this->committed = static_cast<std::size_t>(num_records);
+}
+
+void Journal::release()
+{
+  if (this->data != nullptr)
+    ::munmap(this->data, this->mapped);
+  this->data = nullptr;
+  if (this->fd >= 0)
+    ::close(this->fd);
+  this->fd = -1;
+}
+
+Journal::Header *Journal::header() const
+{
+  return reinterpret_cast<Header*>(this->data);
+}
+
+Journal::Record *Journal::records() const
+{
+  return reinterpret_cast<Record*>(this->data + sizeof(Header));
+}
+
+void Journal::reserve(std::size_t num_records)
+{
+  const std::size_t needed = sizeof(Header) + num_records * sizeof(Record);
+  if (needed <= this->mapped && this->data != nullptr)
+    return;
+
+  const std::size_t size = sizeof(Header) + (num_records + grow_records) * sizeof(Record);
+  if (::ftruncate(this->fd, size) < 0)
+    fail("ftruncate");
+
+  if (this->data != nullptr)
+    ::munmap(this->data, this->mapped);
+
+  void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+  if (ptr == MAP_FAILED)
+    fail("mmap");
+  this->data = static_cast<char*>(ptr);
+  this->mapped = size;
+}
+
+void Journal::append(const Transaction &transaction, std::int64_t time)
+{
+  if (time < 0 || time > std::int64_t {UINT32_MAX})
+    throw std::out_of_range("Journal: the time of a record is not in 0 to 2^32 - 1");
+  this->reserve(this->count + 1);
+
+  Record &record = this->records()[this->count++];
+  record.account_id = transaction.account_id;
+  record.cents = transaction.amount.get_cents();
+  record.op = static_cast<std::uint32_t>(transaction.op);
+  record.time = static_cast<std::uint32_t>(time);
+
+  if (this->count - this->committed >= this->group_size)
+    this->commit();
+}
+
+void Journal::commit()
+{
+  if (this->count == this->committed)
+    return;
+
+  // the records first, then the header that publishes them,
+  // msync wants a page aligned start so round down to the page of the first new record
+  const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::size_t first = (sizeof(Header) + this->committed * sizeof(Record)) / page * page;
+  const std::size_t last = sizeof(Header) + this->count * sizeof(Record);
+  if (::msync(this->data + first, last - first, MS_SYNC) < 0)
+    fail("msync");
+  this->header()->count = this->count;
+  if (::msync(this->data, sizeof(Header), MS_SYNC) < 0)
+    fail("msync");
+
+  this->committed = this->count;
+}
+
+std::size_t Journal::size() const
+{
+  return this->count;
+}
+
+template<typename Fn>
+std::size_t Journal::replay_records(const std::string &path, std::size_t from, Fn apply)
+{
+  const Journal journal {path, Read_only {}};
+  std::size_t applied {0};
+
+  const Record *records = journal.records();
+  for (std::size_t i {from}; i < journal.committed; i++) {
+    const Record &record = records[i];
+    applied += apply(Transaction {record.account_id, static_cast<Operation>(record.op), Money::from_cents(record.cents)},
+      record.time);
+  }
+
+  return applied;
+}
+
+template<typename Fn>
+std::size_t Journal::replay_sorted_records(const std::string &path, std::size_t from, 
+  const external_sort::Options &options, Fn apply)
+{
+  const auto by_account = [](const Record &a, const Record &b) { return a.account_id < b.account_id; };
+  external_sort::Sorter<Record, decltype(by_account)> sorter {by_account, options};
+  {
+    const Journal journal {path, Read_only {}};
+    if (from < journal.committed)
+      sorter.push(journal.records() + from, journal.committed - from);
+  }
+
+  std::size_t applied {0};
+  sorter.merge([&applied, &apply](const Record &record) {
+    applied += apply(Transaction {record.account_id, static_cast<Operation>(record.op), Money::from_cents(record.cents)},
+      record.time);
+  });
+  return applied;
+}
+
+static bool apply_to(std::vector<Account*> &accounts, const Transaction &transaction)
+{
+  if (transaction.account_id >= accounts.size())
+    return false;
+
+  Account *ptr = accounts[transaction.account_id];
+  return transaction.op == Operation::Deposit 
+    ? ptr->deposit(transaction.amount) 
+    : ptr->withdraw(transaction.amount);
+}
+
+std::size_t Journal::replay(const std::string &path, std::vector<Account*> &accounts, std::size_t from)
+{
+  return replay_records(path, from, 
+    [&accounts](const Transaction &transaction, std::uint32_t) { return apply_to(accounts, transaction); });
+}
+
+std::size_t Journal::replay(const std::string &path, Account_store &store, std::size_t from)
+{
+  return replay_records(path, from, [&store](const Transaction &transaction, std::uint32_t time) {
+    return time != 0 ? store.apply(transaction, time) : store.apply(transaction);
+  });
+}
+
+std::size_t Journal::replay_sorted(const std::string &path, std::vector<Account*> &accounts, 
+  const external_sort::Options &options, std::size_t from)
+{
+  return replay_sorted_records(path, from, options, 
+    [&accounts](const Transaction &transaction, std::uint32_t) { return apply_to(accounts, transaction); });
+}
+
+std::size_t Journal::replay_sorted(const std::string &path, Account_store &store, 
+  const external_sort::Options &options, std::size_t from)
+{
+  return replay_sorted_records(path, from, options, 
+    [&store](const Transaction &transaction, std::uint32_t time) {
+      return time != 0 ? store.apply(transaction, time) : store.apply(transaction);
+    });
+}
@@ -0,0 +1,108 @@
+#ifndef _JOURNAL_H_
+#define _JOURNAL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Account.h"
+#include "Transaction.h"
+#include "../../ioAndStream/externalSort/External_sort.h"
+
+class Account_store;
+
+/*
+
+  - Journal is an append-only binary file of fixed size transaction records,
+    written through a memory mapping of the file (POSIX only).
+
+  - records are made durable in groups: commit() runs one msync for everything
+    appended since the last commit, and append() commits by itself every group_size records.
+
+  - replay() streams a journal once and applies every record to the accounts,
+    which rebuilds their state after a restart. from skips the records a Checkpoint
+    already has, only the tail after it is applied.
+
+  - replay_sorted() applies them in the order of their accounts, an external sort
+    (ioAndStream/externalSort) of the memory of options, the records of an account in the
+    order they were written. a record only changes its own account, so the balances are
+    the ones of replay(), and a journal larger than RAM visits every account once, in
+    order, not at random.
+
+  - a record appended with a time is replayed into an Account_store with it, through the
+    withdrawal windows, the accounts of a vector have none and take it without.
+
+  - a journal is opened only when its header and its count of records fit in the file,
+    a file of another kind, cut short or corrupt is not written over, it throws
+    std::runtime_error. replay() opens the file read only, a path that is not there is
+    an error, not a new journal.
+
+  - errors from the operating system are thrown as std::runtime_error.
+
+*/
+class Journal
+{
+private:
+  struct Header
+  {
+    char magic[8];
+    std::uint64_t count; // committed records
+  };
+
+  struct Record
+  {
+    std::uint64_t account_id;
+    std::int64_t cents;
+    std::uint32_t op;
+    std::uint32_t time;  // of Account_store::apply with a time, 0 for none
+  };
+
+  static constexpr char magic[8] = {'A', 'C', 'C', 'T', 'J', 'R', 'N', 'L'};
+  static constexpr std::size_t def_group_size = 256;
+  static constexpr std::size_t grow_records = 1 << 16;
+
+  struct Read_only {};
+
+  int fd;
+  bool writable;
+  char *data;
+  std::size_t mapped;    // bytes mapped
+  std::size_t count;     // records appended
+  std::size_t committed; // records made durable
+  std::size_t group_size;
+
+  Header *header() const;
+  Record *records() const;
+  void reserve(std::size_t num_records);
+  void map_records(const std::string &path, std::size_t size);
+  void release();
+  Journal(const std::string &path, Read_only);
+
+  template<typename Fn>
+  static std::size_t replay_records(const std::string &path, std::size_t from, Fn apply);
+  template<typename Fn>
+  static std::size_t replay_sorted_records(const std::string &path, std::size_t from, 
+    const external_sort::Options &options, Fn apply);
+
+public:
+  Journal(const std::string &path, std::size_t group_size = def_group_size);
+  Journal(const Journal &source) = delete;
+  Journal &operator=(const Journal &rhs) = delete;
+  ~Journal();
+
+  // time is the one the transaction was applied at, 1 to 2^32 - 1, seconds since the epoch
+  // to 2106, 0 for none, std::out_of_range outside of it
+  void append(const Transaction &transaction, std::int64_t time = 0);
+  void commit();
+  std::size_t size() const;
+
+  // returns how many records were accepted by the accounts
+  static std::size_t replay(const std::string &path, std::vector<Account*> &accounts, std::size_t from = 0);
+  static std::size_t replay(const std::string &path, Account_store &store, std::size_t from = 0);
+  static std::size_t replay_sorted(const std::string &path, std::vector<Account*> &accounts, 
+    const external_sort::Options &options = {}, std::size_t from = 0);
+  static std::size_t replay_sorted(const std::string &path, Account_store &store, 
+    const external_sort::Options &options = {}, std::size_t from = 0);
+};
+
+#endif
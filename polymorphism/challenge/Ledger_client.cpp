@@ -0,0 +1,114 @@
+#include <stdexcept>
+#include <utility>
+#include <unistd.h>
+#include "Ledger_client.h"
+
+Ledger_client::Ledger_client(Hash_ring ring, std::vector<int> connections)
+  : ring(std::move(ring)), connections(std::move(connections))
+{
+  if (this->connections.size() < this->ring.size())
+    throw std::runtime_error("Ledger_client: a connection to every node of the ring is needed");
+  this->batches.resize(this->connections.size());
+}
+
+Ledger_client::~Ledger_client()
+{
+  for (int fd: this->connections)
+    ::close(fd);
+}
+
+std::size_t Ledger_client::queue(std::size_t node, const Wire_record &record)
+{
+  // the first submit after a flush starts a new pipeline
+  if (this->flushed) {
+    this->num_tickets = 0;
+    this->flushed = false;
+  }
+  Batch &batch = this->batches[node];
+  batch.records.push_back(record);
+  batch.tickets.push_back(this->num_tickets);
+  return this->num_tickets++;
+}
+
+std::size_t Ledger_client::submit(const Transaction &transaction)
+{
+  const Wire_op op = transaction.op == Operation::Deposit ? Wire_op::Deposit : Wire_op::Withdraw;
+  return this->queue(this->ring.node_of(transaction.account_id),
+    Wire_record {transaction.account_id, transaction.amount.get_cents(), static_cast<std::uint32_t>(op), 0});
+}
+
+std::size_t Ledger_client::submit_balance(std::uint64_t account_id)
+{
+  return this->queue(this->ring.node_of(account_id),
+    Wire_record {account_id, 0, static_cast<std::uint32_t>(Wire_op::Balance), 0});
+}
+
+void Ledger_client::flush()
+{
+  // every batch out first, the nodes work on them while the replies are read
+  for (std::size_t node {0}; node < this->batches.size(); node++)
+    if (!this->batches[node].records.empty() && !send_batch(this->connections[node], this->batches[node].records))
+      throw std::runtime_error("Ledger_client: node " + std::to_string(node) + " is not reachable");
+
+  this->results.resize(this->num_tickets);
+  for (std::size_t node {0}; node < this->batches.size(); node++) {
+    Batch &batch = this->batches[node];
+    if (batch.records.empty())
+      continue;
+    if (!receive_batch(this->connections[node], this->replies) || this->replies.size() != batch.records.size())
+      throw std::runtime_error("Ledger_client: node " + std::to_string(node) + " did not answer");
+    for (std::size_t i {0}; i < this->replies.size(); i++)
+      this->results[batch.tickets[i]] = {this->replies[i].op != 0, Money::from_cents(this->replies[i].cents)};
+    batch.records.clear();
+    batch.tickets.clear();
+  }
+  this->flushed = true;
+}
+
+Ledger_client::Result Ledger_client::get_result(std::size_t ticket) const
+{
+  return this->results.at(ticket);
+}
+
+bool Ledger_client::deposit(std::uint64_t account_id, Money amount)
+{
+  const std::size_t ticket = this->submit(Transaction {account_id, Operation::Deposit, amount});
+  this->flush();
+  return this->results[ticket].accepted;
+}
+
+bool Ledger_client::withdraw(std::uint64_t account_id, Money amount)
+{
+  const std::size_t ticket = this->submit(Transaction {account_id, Operation::Withdraw, amount});
+  this->flush();
+  return this->results[ticket].accepted;
+}
+
+Money Ledger_client::get_balance(std::uint64_t account_id)
+{
+  const std::size_t ticket = this->submit_balance(account_id);
+  this->flush();
+  return this->results[ticket].balance;
+}
+
+bool Ledger_client::transfer(std::uint64_t from, std::uint64_t to, Money amount)
+{
+  this->flush();
+
+  const std::uint32_t transfer = this->next_transfer++;
+  const std::size_t from_node = this->ring.node_of(from);
+  const std::size_t to_node = this->ring.node_of(to);
+  const std::size_t withdrawn = this->queue(from_node,
+    Wire_record {from, amount.get_cents(), static_cast<std::uint32_t>(Wire_op::Prepare_withdraw), transfer});
+  const std::size_t deposited = this->queue(to_node,
+    Wire_record {to, amount.get_cents(), static_cast<std::uint32_t>(Wire_op::Prepare_deposit), transfer});
+  this->flush();
+
+  const bool commit = this->results[withdrawn].accepted && this->results[deposited].accepted;
+  const Wire_op decision = commit ? Wire_op::Commit : Wire_op::Abort;
+  this->queue(from_node, Wire_record {from, 0, static_cast<std::uint32_t>(decision), transfer});
+  if (to_node != from_node)
+    this->queue(to_node, Wire_record {to, 0, static_cast<std::uint32_t>(decision), transfer});
+  this->flush();
+  return commit;
+}
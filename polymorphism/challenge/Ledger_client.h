@@ -0,0 +1,80 @@
+#ifndef _LEDGER_CLIENT_H_
+#define _LEDGER_CLIENT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Hash_ring.h"
+#include "Ledger_wire.h"
+#include "Money.h"
+#include "Transaction.h"
+
+/*
+
+  - Ledger_client talks to the nodes of a partitioned ledger, a connection to each one, the
+    Hash_ring that placed the accounts tells it the node of an account.
+
+  - submit() does not wait: it appends the record to the batch of the node of the account and
+    gives a ticket, flush() sends the batch of every node and only then reads the replies, the
+    nodes work on their batches at the same time and a round trip is paid once a flush, not
+    once a record. the requests to one node run in the order they were submitted. a ticket
+    is good for get_result until the first submit after the next flush.
+
+  - transfer() is the coordinator of a two phase commit: a Prepare_withdraw to the node of
+    from and a Prepare_deposit to the one of to, in one flush, then a Commit to both when
+    both voted yes and an Abort otherwise, see Ledger_node.h. it flushes what was submitted
+    before it first, the requests of the pipeline stay in their order.
+
+  - the client owns the connections, it closes them, it is for one thread, a thread of its
+    own has a client of its own. an error of a connection is thrown as std::runtime_error.
+
+*/
+class Ledger_client
+{
+public:
+  struct Result
+  {
+    bool accepted;
+    Money balance;  // of the account, after the request
+  };
+
+private:
+  struct Batch
+  {
+    std::vector<Wire_record> records;
+    std::vector<std::size_t> tickets;
+  };
+
+  Hash_ring ring;
+  std::vector<int> connections;
+  std::vector<Batch> batches;
+  std::vector<Wire_record> replies;
+  std::vector<Result> results;    // by ticket
+  std::size_t num_tickets {0};
+  bool flushed {false};
+  std::uint32_t next_transfer {1};
+
+  std::size_t queue(std::size_t node, const Wire_record &record);
+
+public:
+  // the connection to node i is connections[i]
+  Ledger_client(Hash_ring ring, std::vector<int> connections);
+  Ledger_client(const Ledger_client &source) = delete;
+  Ledger_client &operator=(const Ledger_client &rhs) = delete;
+  ~Ledger_client();
+
+  std::size_t submit(const Transaction &transaction);
+  std::size_t submit_balance(std::uint64_t account_id);
+  void flush();
+  Result get_result(std::size_t ticket) const;
+
+  // a submit and a flush
+  bool deposit(std::uint64_t account_id, Money amount);
+  bool withdraw(std::uint64_t account_id, Money amount);
+  Money get_balance(std::uint64_t account_id);
+
+  // the withdraw and the deposit both, or neither
+  bool transfer(std::uint64_t from, std::uint64_t to, Money amount);
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Ledger_node.h"
+
+Ledger_node::~Ledger_node()
+{
+  // wakes the threads that wait for a batch, they stop as if the client had closed
+  for (auto &connection: this->connections)
+    ::shutdown(connection.first, SHUT_RDWR);
+  for (auto &connection: this->connections) {
+    connection.second.join();
+    ::close(connection.first);
+  }
+}
+
+void Ledger_node::add_checking(std::uint64_t account_id, const std::string &name, Money balance)
+{
+  std::lock_guard<std::mutex> guard {this->lock};
+  if (!this->positions.emplace(account_id, this->store.size()).second)
+    throw std::runtime_error("Ledger_node: account " + std::to_string(account_id) + " is already on the node");
+  this->store.add_checking(name, balance);
+}
+
+void Ledger_node::add_saving(std::uint64_t account_id, const std::string &name, Money balance, double int_rate)
+{
+  std::lock_guard<std::mutex> guard {this->lock};
+  if (!this->positions.emplace(account_id, this->store.size()).second)
+    throw std::runtime_error("Ledger_node: account " + std::to_string(account_id) + " is already on the node");
+  this->store.add_saving(name, balance, int_rate);
+}
+
+void Ledger_node::add_trust(std::uint64_t account_id, const std::string &name, Money balance, double int_rate)
+{
+  std::lock_guard<std::mutex> guard {this->lock};
+  if (!this->positions.emplace(account_id, this->store.size()).second)
+    throw std::runtime_error("Ledger_node: account " + std::to_string(account_id) + " is already on the node");
+  this->store.add_trust(name, balance, int_rate);
+}
+
+bool Ledger_node::find(std::uint64_t account_id, std::size_t &position) const
+{
+  auto it = this->positions.find(account_id);
+  if (it == this->positions.end())
+    return false;
+  position = it->second;
+  return true;
+}
+
+std::int64_t &Ledger_node::balance_of(std::size_t position)
+{
+  const Account_store::Id id = this->store.ids[position];
+  switch (id.type) {
+    case Account_store::Type::Checking:
+      return this->store.checking.balances[id.index];
+    case Account_store::Type::Saving:
+      return this->store.saving.balances[id.index];
+    default:
+      return this->store.trust.balances[id.index];
+  }
+}
+
+int *Ledger_node::withdrawls_of(std::size_t position)
+{
+  const Account_store::Id id = this->store.ids[position];
+  return id.type == Account_store::Type::Trust ? &this->store.trust.num_withdrawls[id.index] : nullptr;
+}
+
+Wire_record Ledger_node::apply(const Wire_record &request, Wire_op op, std::vector<Hold> &holds)
+{
+  Wire_record reply {request.account_id, 0, 0, request.transfer};
+  std::size_t position;
+  if (!this->find(request.account_id, position))
+    return reply;
+
+  const Money amount = Money::from_cents(request.cents);
+  switch (op) {
+    case Wire_op::Deposit:
+      reply.op = this->store.apply(Transaction {position, Operation::Deposit, amount});
+      break;
+    case Wire_op::Withdraw:
+      reply.op = this->store.apply(Transaction {position, Operation::Withdraw, amount});
+      break;
+    case Wire_op::Balance:
+      reply.op = 1;
+      break;
+    case Wire_op::Prepare_withdraw: {
+      const std::int64_t before = this->balance_of(position);
+      const int *withdrawls = this->withdrawls_of(position);
+      const int counted_before = withdrawls != nullptr ? *withdrawls : 0;
+      reply.op = this->store.apply(Transaction {position, Operation::Withdraw, amount});
+      if (reply.op != 0)
+        holds.push_back({request.transfer, position, before - this->balance_of(position),
+          (withdrawls != nullptr ? *withdrawls : 0) - counted_before, true});
+      break;
+    }
+    case Wire_op::Prepare_deposit:
+      // a deposit of an amount that is not negative is always accepted
+      reply.op = request.cents >= 0;
+      if (reply.op != 0)
+        holds.push_back({request.transfer, position, request.cents, 0, false});
+      break;
+    default:
+      break;
+  }
+  reply.cents = this->balance_of(position);
+  return reply;
+}
+
+Wire_record Ledger_node::execute(const Wire_record &request, std::vector<Hold> &holds)
+{
+  const Wire_op op = static_cast<Wire_op>(request.op);
+  if (op == Wire_op::Commit || op == Wire_op::Abort) {
+    this->finish(request.transfer, op == Wire_op::Commit, holds);
+    return Wire_record {request.account_id, 0, 1, request.transfer};
+  }
+
+  try {
+    return this->apply(request, op, holds);
+  }
+  catch (const std::exception &) {
+    // a balance that would overflow, refused like any other
+    return Wire_record {request.account_id, 0, 0, request.transfer};
+  }
+}
+
+void Ledger_node::finish(std::uint32_t transfer, bool commit, std::vector<Hold> &holds)
+{
+  for (const Hold &hold: holds) {
+    if (hold.transfer != transfer)
+      continue;
+    if (hold.withdrawal && !commit) {
+      this->balance_of(hold.position) += hold.cents;
+      if (int *withdrawls = this->withdrawls_of(hold.position))
+        *withdrawls -= hold.withdrawls;
+    }
+    else if (!hold.withdrawal && commit) {
+      try {
+        this->store.apply(Transaction {hold.position, Operation::Deposit, Money::from_cents(hold.cents)});
+      }
+      catch (const std::exception &) {}
+    }
+  }
+  holds.erase(std::remove_if(holds.begin(), holds.end(),
+    [transfer](const Hold &hold) { return hold.transfer == transfer; }), holds.end());
+}
+
+void Ledger_node::run(int fd)
+{
+  std::vector<Hold> holds;
+  std::vector<Wire_record> requests;
+  std::vector<Wire_record> replies;
+
+  while (receive_batch(fd, requests)) {
+    replies.clear();
+    {
+      std::lock_guard<std::mutex> guard {this->lock};
+      for (const Wire_record &request: requests)
+        replies.push_back(this->execute(request, holds));
+    }
+    if (!send_batch(fd, replies))
+      break;
+  }
+
+  // the coordinator is gone, what it prepared is aborted
+  std::lock_guard<std::mutex> guard {this->lock};
+  while (!holds.empty())
+    this->finish(holds.front().transfer, false, holds);
+}
+
+void Ledger_node::serve(int fd)
+{
+  std::lock_guard<std::mutex> guard {this->lock};
+  this->connections.emplace_back(fd, std::thread {&Ledger_node::run, this, fd});
+}
+
+int Ledger_node::connect()
+{
+  int ends[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, ends) < 0)
+    throw std::runtime_error(std::string {"socketpair: "} + std::strerror(errno));
+  this->serve(ends[1]);
+  return ends[0];
+}
+
+Money Ledger_node::get_total_balance()
+{
+  std::lock_guard<std::mutex> guard {this->lock};
+  return this->store.get_total_balance();
+}
+
+std::size_t Ledger_node::size()
+{
+  std::lock_guard<std::mutex> guard {this->lock};
+  return this->store.size();
+}
@@ -0,0 +1,85 @@
+#ifndef _LEDGER_NODE_H_
+#define _LEDGER_NODE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Account_store.h"
+#include "Ledger_wire.h"
+#include "Money.h"
+
+/*
+
+  - Ledger_node is one partition of a ledger spread over several nodes, the accounts a
+    Hash_ring gives it in an Account_store of its own, with the global ids of the accounts.
+    it answers batches of Wire_record requests on stream sockets, a thread a connection,
+    every batch runs under the lock of the node, once, not once a record.
+
+  - a transfer between accounts is two phase, whether they are on two nodes or on one:
+    Prepare_withdraw takes the amount from the account right away and holds it, the vote is
+    whether the withdraw was accepted, Prepare_deposit votes yes for any amount that can be
+    deposited and changes nothing. Commit drops the hold and makes the deposit, Abort gives
+    the held cents back, the fee of a checking account and the withdrawl count of a trust
+    account too, whatever else was done to the account in between stays.
+
+  - the holds belong to the connection that prepared them, the client that coordinates the
+    transfer, a connection that is closed aborts the ones it still has. the client keeps
+    no log of its decisions, a client that dies between two commits leaves one of them
+    done, a transfer is atomic against other transfers and a failed node, not against a
+    coordinator that crashes.
+
+  - connect() makes a socket pair of a node in the same process, serve() any connected
+    stream socket, a TCP one too. the destructor shuts the connections down and waits for
+    their threads.
+
+*/
+class Ledger_node
+{
+private:
+  struct Hold
+  {
+    std::uint32_t transfer;
+    std::size_t position;
+    std::int64_t cents;       // the cents taken, or the ones to deposit
+    int withdrawls;           // the trust withdrawls the prepare counted
+    bool withdrawal;
+  };
+
+  Account_store store;
+  std::unordered_map<std::uint64_t, std::size_t> positions;  // the global id to the position in the store
+  std::mutex lock;
+  std::vector<std::pair<int, std::thread>> connections;
+
+  bool find(std::uint64_t account_id, std::size_t &position) const;
+  std::int64_t &balance_of(std::size_t position);
+  int *withdrawls_of(std::size_t position);
+  Wire_record apply(const Wire_record &request, Wire_op op, std::vector<Hold> &holds);
+  Wire_record execute(const Wire_record &request, std::vector<Hold> &holds);
+  void finish(std::uint32_t transfer, bool commit, std::vector<Hold> &holds);
+  void run(int fd);
+
+public:
+  Ledger_node() = default;
+  Ledger_node(const Ledger_node &source) = delete;
+  Ledger_node &operator=(const Ledger_node &rhs) = delete;
+  ~Ledger_node();
+
+  void add_checking(std::uint64_t account_id, const std::string &name, Money balance);
+  void add_saving(std::uint64_t account_id, const std::string &name, Money balance, double int_rate);
+  void add_trust(std::uint64_t account_id, const std::string &name, Money balance, double int_rate);
+
+  // the node answers on the connection until the other end closes it, it closes it when it is destroyed
+  void serve(int fd);
+  // a connection to the node from the same process, for a Ledger_client
+  int connect();
+
+  Money get_total_balance();
+  std::size_t size();
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef _LEDGER_WIRE_H_
+#define _LEDGER_WIRE_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/types.h>
+
+/*
+
+  - the records a Ledger_client and a Ledger_node exchange, the fixed size records of the
+    journal: the account id, the amount in cents, the operation, and the reserved field of the
+    journal carries the transfer of a two phase record. a Deposit or Withdraw record is bit for
+    bit a journal record, a node can append what it gets as it is.
+
+  - a reply has the same layout: op is 1 when the request was accepted and 0 when it was
+    refused, cents is the balance of the account after it.
+
+  - a batch is a std::uint32_t count and the records, on a stream socket, a pair of an
+    in-process node or a TCP connection to one on another machine, in the byte order of the
+    machines, the way the journal is. send_batch and receive_batch are false when the
+    connection is closed or fails.
+
+*/
+enum class Wire_op : std::uint32_t
+{
+  Deposit,              // the values of Operation
+  Withdraw,
+  Balance,
+  Prepare_withdraw,     // the amount is taken and held, a vote
+  Prepare_deposit,      // a vote, nothing changes yet
+  Commit,               // of every record of the transfer on the node
+  Abort
+};
+
+struct Wire_record
+{
+  std::uint64_t account_id;
+  std::int64_t cents;
+  std::uint32_t op;
+  std::uint32_t transfer;
+};
+
+static_assert(sizeof(Wire_record) == 24, "a Wire_record is a journal record");
+
+namespace detail_ledger_wire
+{
+  inline bool send_all(int fd, const void *data, std::size_t size)
+  {
+    const char *ptr = static_cast<const char*>(data);
+    while (size > 0) {
+      // a peer that is gone is an error here, not a SIGPIPE
+      const ssize_t sent = ::send(fd, ptr, size, MSG_NOSIGNAL);
+      if (sent < 0 && errno == EINTR)
+        continue;
+      if (sent <= 0)
+        return false;
+      ptr += sent;
+      size -= static_cast<std::size_t>(sent);
+    }
+    return true;
+  }
+
+  inline bool receive_all(int fd, void *data, std::size_t size)
+  {
+    char *ptr = static_cast<char*>(data);
+    while (size > 0) {
+      const ssize_t received = ::recv(fd, ptr, size, 0);
+      if (received < 0 && errno == EINTR)
+        continue;
+      if (received <= 0)
+        return false;
+      ptr += received;
+      size -= static_cast<std::size_t>(received);
+    }
+    return true;
+  }
+}
+
+inline bool send_batch(int fd, const std::vector<Wire_record> &records)
+{
+  // the count and the records in one message, not a small packet of the count on its own
+  const std::uint32_t count = static_cast<std::uint32_t>(records.size());
+  iovec parts[2] {{const_cast<std::uint32_t*>(&count), sizeof(count)},
+    {const_cast<Wire_record*>(records.data()), records.size() * sizeof(Wire_record)}};
+  msghdr message {};
+  message.msg_iov = parts;
+  message.msg_iovlen = 2;
+  ssize_t sent;
+  while ((sent = ::sendmsg(fd, &message, MSG_NOSIGNAL)) < 0 && errno == EINTR) {}
+  if (sent < 0)
+    return false;
+
+  // the rest of a message the socket took only a part of
+  std::size_t done = static_cast<std::size_t>(sent);
+  if (done < sizeof(count))
+    return detail_ledger_wire::send_all(fd, reinterpret_cast<const char*>(&count) + done, sizeof(count) - done)
+      && detail_ledger_wire::send_all(fd, records.data(), parts[1].iov_len);
+  done -= sizeof(count);
+  return detail_ledger_wire::send_all(fd, reinterpret_cast<const char*>(records.data()) + done, parts[1].iov_len - done);
+}
+
+inline bool receive_batch(int fd, std::vector<Wire_record> &records)
+{
+  std::uint32_t count;
+  if (!detail_ledger_wire::receive_all(fd, &count, sizeof(count)))
+    return false;
+  records.resize(count);
+  return detail_ledger_wire::receive_all(fd, records.data(), records.size() * sizeof(Wire_record));
+}
+
+#endif
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "Numa_ledger.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  // the cores of a list of /sys, e.g. 0-3,8-11
+  std::vector<int> parse_cpu_list(const std::string &list)
+  {
+    std::vector<int> cpus;
+    std::stringstream ranges {list};
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+      const std::size_t dash = range.find('-');
+      const int from = std::stoi(range.substr(0, dash));
+      const int to = dash == std::string::npos ? from : std::stoi(range.substr(dash + 1));
+      for (int cpu = from; cpu <= to; ++cpu)
+        cpus.push_back(cpu);
+    }
+    return cpus;
+  }
+
+  std::vector<int> allowed_cpus()
+  {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+      for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &set))
+          cpus.push_back(cpu);
+#endif
+    return cpus;
+  }
+
+  void pin(const std::vector<int> &cpus)
+  {
+#if defined(__linux__)
+    if (cpus.empty())
+      return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu: cpus)
+      CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpus;
+#endif
+  }
+
+  /*
+    - the pages the thread touches first go round the nodes until the guard goes away, the
+      policy of the thread is the default again then. nothing without set_mempolicy.
+  */
+  class Interleave_guard
+  {
+  private:
+    bool active {false};
+
+  public:
+    explicit Interleave_guard(const std::vector<int> &node_ids)
+    {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+      constexpr int mpol_interleave = 3;
+      unsigned long mask {0};
+      for (int node: node_ids)
+        if (node >= 0 && node < static_cast<int>(8 * sizeof mask))
+          mask |= 1UL << node;
+      if (mask != 0)
+        this->active = ::syscall(SYS_set_mempolicy, mpol_interleave, &mask, 8 * sizeof mask) == 0;
+#else
+      (void)node_ids;
+#endif
+    }
+
+    ~Interleave_guard()
+    {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+      constexpr int mpol_default = 0;
+      if (this->active)
+        ::syscall(SYS_set_mempolicy, mpol_default, nullptr, 0);
+#endif
+    }
+
+    Interleave_guard(const Interleave_guard &source) = delete;
+    Interleave_guard &operator=(const Interleave_guard &source) = delete;
+  };
+}
+
+std::size_t Numa_ledger::Topology::size() const
+{
+  return this->cpus.size();
+}
+
+Numa_ledger::Topology Numa_ledger::Topology::detect()
+{
+  Topology topology;
+  const std::vector<int> allowed = allowed_cpus();
+  for (int node = 0;; ++node) {
+    std::ifstream file {"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+    std::string list;
+    if (!file || !std::getline(file, list))
+      break;
+    std::vector<int> cpus;
+    for (int cpu: parse_cpu_list(list))
+      if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end())
+        cpus.push_back(cpu);
+    if (!cpus.empty()) {
+      topology.cpus.push_back(cpus);
+      topology.node_ids.push_back(node);
+    }
+  }
+  if (topology.cpus.empty()) {
+    topology.cpus.push_back(allowed);
+    topology.node_ids.push_back(0);
+  }
+  return topology;
+}
+
+Numa_ledger::Topology Numa_ledger::Topology::split(std::size_t num_nodes)
+{
+  const Topology real = detect();
+  const std::vector<int> &cores = real.cpus.front();
+  Topology topology;
+  num_nodes = std::max<std::size_t>(num_nodes, 1);
+  for (std::size_t node {0}; node < num_nodes; node++) {
+    std::vector<int> cpus;
+    for (std::size_t i {node}; i < cores.size(); i += num_nodes)
+      cpus.push_back(cores[i]);
+    // more nodes than cores, a core is in several
+    if (cpus.empty() && !cores.empty())
+      cpus.push_back(cores[node % cores.size()]);
+    topology.cpus.push_back(cpus);
+    topology.node_ids.push_back(real.node_ids.front());
+  }
+  return topology;
+}
+
+Numa_ledger::Numa_ledger(Topology topology, std::size_t shards_per_node, Placement placement)
+  : topology{std::move(topology)}, placement{placement}, num_accounts{0}, generation{0}, running{0},
+    total{0}, stopping{false}
+{
+  if (this->topology.cpus.empty()) {
+    this->topology.cpus.push_back({});
+    this->topology.node_ids.push_back(0);
+  }
+  const std::size_t num_shards = this->topology.size() * std::max<std::size_t>(shards_per_node, 1);
+  for (std::size_t i {0}; i < num_shards; i++)
+    this->shards.push_back(std::make_unique<Shard>());
+  for (std::size_t i {0}; i < num_shards; i++)
+    this->shards[i]->worker = std::thread{&Numa_ledger::work, this, i};
+}
+
+Numa_ledger::~Numa_ledger()
+{
+  {
+    std::lock_guard<std::mutex> lock {this->mutex};
+    this->stopping = true;
+  }
+  this->start.notify_all();
+  for (auto &shard: this->shards)
+    shard->worker.join();
+}
+
+void Numa_ledger::work(std::size_t index)
+{
+  pin(this->topology.cpus[index % this->topology.size()]);
+  std::uint64_t seen {0};
+  for (;;) {
+    std::function<std::size_t(std::size_t)> *task;
+    {
+      std::unique_lock<std::mutex> lock {this->mutex};
+      this->start.wait(lock, [&]() { return this->stopping || this->generation != seen; });
+      if (this->stopping)
+        return;
+      seen = this->generation;
+      task = &this->task;
+    }
+
+    std::size_t count {0};
+    std::exception_ptr error;
+    try {
+      count = (*task)(index);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock {this->mutex};
+    this->shards[index]->queue.clear();
+    this->total += count;
+    if (error && !this->error)
+      this->error = error;
+    if (--this->running == 0)
+      this->done.notify_one();
+  }
+}
+
+std::size_t Numa_ledger::run(std::function<std::size_t(std::size_t)> task)
+{
+  std::unique_lock<std::mutex> lock {this->mutex};
+  this->task = std::move(task);
+  this->running = this->shards.size();
+  this->total = 0;
+  this->error = nullptr;
+  ++this->generation;
+  this->start.notify_all();
+  this->done.wait(lock, [this]() { return this->running == 0; });
+  if (this->error)
+    std::rethrow_exception(this->error);
+  return this->total;
+}
+
+void Numa_ledger::build(std::size_t num_accounts, const std::function<void(std::size_t, Account_store&)> &add)
+{
+  const std::size_t first = this->num_accounts, last = first + num_accounts;
+  const std::size_t num_shards = this->shards.size();
+  this->num_accounts = last;
+
+  if (this->placement == Placement::local) {
+    this->run([&](std::size_t shard) {
+      std::size_t id = first + (shard + num_shards - first % num_shards) % num_shards;
+      for (; id < last; id += num_shards)
+        add(id, this->shards[shard]->store);
+      return std::size_t {0};
+    });
+    return;
+  }
+
+  std::unique_ptr<Interleave_guard> interleave;
+  if (this->placement == Placement::interleaved)
+    interleave = std::make_unique<Interleave_guard>(this->topology.node_ids);
+  for (std::size_t id {first}; id < last; id++)
+    add(id, this->shards[id % num_shards]->store);
+}
+
+void Numa_ledger::load(const std::vector<Account*> &accounts)
+{
+  this->build(accounts.size(), [&accounts](std::size_t id, Account_store &store) {
+    store.load({accounts[id]});
+  });
+}
+
+std::size_t Numa_ledger::apply(const std::vector<Transaction> &batch)
+{
+  const std::size_t num_shards = this->shards.size();
+  for (const Transaction &transaction: batch)
+    if (transaction.account_id < this->num_accounts)
+      this->shards[transaction.account_id % num_shards]->queue.push_back(
+        {transaction.account_id / num_shards, transaction.op, transaction.amount});
+
+  return this->run([this](std::size_t shard) {
+    Shard &owner = *this->shards[shard];
+    std::size_t accepted {0};
+    for (const Transaction &transaction: owner.queue)
+      accepted += owner.store.apply(transaction);
+    return accepted;
+  });
+}
+
+std::size_t Numa_ledger::deposit_all(Money amount)
+{
+  return this->run([this, amount](std::size_t shard) { return this->shards[shard]->store.deposit(amount); });
+}
+
+std::size_t Numa_ledger::withdraw_all(Money amount)
+{
+  return this->run([this, amount](std::size_t shard) { return this->shards[shard]->store.withdraw(amount); });
+}
+
+// the workers wait between the runs, the stores are read here
+Money Numa_ledger::get_total_balance() const
+{
+  Money total {0};
+  for (const auto &shard: this->shards)
+    total += shard->store.get_total_balance();
+  return total;
+}
+
+std::size_t Numa_ledger::size() const
+{
+  return this->num_accounts;
+}
+
+std::size_t Numa_ledger::get_num_shards() const
+{
+  return this->shards.size();
+}
+
+std::size_t Numa_ledger::get_num_nodes() const
+{
+  return this->topology.size();
+}
+
+std::size_t Numa_ledger::get_node(std::size_t id) const
+{
+  return id % this->shards.size() % this->topology.size();
+}
@@ -0,0 +1,117 @@
+#ifndef _NUMA_LEDGER_H_
+#define _NUMA_LEDGER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Account.h"
+#include "Account_store.h"
+#include "Money.h"
+#include "Transaction.h"
+
+/*
+
+  - Numa_ledger spreads the accounts over shards, an Account_store each, and every shard
+    has a worker of its own, pinned to the cores of the node the shard is on. the worker
+    is the only thread that touches its store, no lock on an account.
+
+  - the account of id is on the shard id % num_shards, at the position id / num_shards of
+    it, the shards go round the nodes, shard s is on node s % num_nodes.
+
+  - Placement::local builds a shard on its worker, the pages of its arrays are first
+    touched there and the kernel puts them in the memory of its node, Placement::naive
+    builds every shard on the calling thread, all of them in the memory of its node, and
+    Placement::interleaved builds them on the calling thread with the pages spread round
+    the nodes, set_mempolicy(MPOL_INTERLEAVE) while it runs. the workers are pinned the
+    same way for all three.
+
+  - apply(batch) routes every transaction to the queue of the shard of its account, the
+    workers run their queues at the same time and apply returns when all of them are
+    done, the transactions of an account in the order of the batch. deposit_all and
+    withdraw_all run the loops of Account_store on every shard.
+
+  - Topology::detect() is the nodes of /sys/devices/system/node and the cores the process
+    can run on, Linux only, one node of every core elsewhere. Topology::split(n) cuts the
+    cores into n nodes of the first real one, to run the shards of n nodes on a machine of
+    one, the pages all stay on it.
+
+  - an exception of a worker is rethrown by the call that ran it.
+
+*/
+class Numa_ledger
+{
+public:
+  enum class Placement { local, interleaved, naive };
+
+  struct Topology
+  {
+    std::vector<std::vector<int>> cpus;  // by node, empty for the cores of the system
+    std::vector<int> node_ids;           // the number of the node for the kernel
+
+    std::size_t size() const;
+
+    static Topology detect();
+    static Topology split(std::size_t num_nodes);
+  };
+
+private:
+  struct alignas(64) Shard
+  {
+    Account_store store;
+    std::vector<Transaction> queue;
+    std::thread worker;
+  };
+
+  Topology topology;
+  Placement placement;
+  std::vector<std::unique_ptr<Shard>> shards;
+  std::size_t num_accounts;
+
+  std::mutex mutex;
+  std::condition_variable start;
+  std::condition_variable done;
+  std::function<std::size_t(std::size_t)> task;
+  std::uint64_t generation;
+  std::size_t running;  // the workers still on the task
+  std::size_t total;
+  std::exception_ptr error;
+  bool stopping;
+
+  void work(std::size_t index);
+  // task(shard) of every shard, on its worker, the sum of what they returned
+  std::size_t run(std::function<std::size_t(std::size_t)> task);
+
+public:
+  Numa_ledger(Topology topology, std::size_t shards_per_node = 1, Placement placement = Placement::local);
+  ~Numa_ledger();
+
+  Numa_ledger(const Numa_ledger &source) = delete;
+  Numa_ledger &operator=(const Numa_ledger &source) = delete;
+
+  /*
+    - num_accounts more accounts, add(id, store) adds the one of id to the store of its shard,
+      exactly one, on the thread of the placement.
+  */
+  void build(std::size_t num_accounts, const std::function<void(std::size_t, Account_store&)> &add);
+  // the accounts as views, the Account_store::load of every shard
+  void load(const std::vector<Account*> &accounts);
+
+  // the number of the transactions accepted
+  std::size_t apply(const std::vector<Transaction> &batch);
+  std::size_t deposit_all(Money amount);
+  std::size_t withdraw_all(Money amount);
+
+  Money get_total_balance() const;
+  std::size_t size() const;
+  std::size_t get_num_shards() const;
+  std::size_t get_num_nodes() const;
+  std::size_t get_node(std::size_t id) const;
+};
+
+#endif
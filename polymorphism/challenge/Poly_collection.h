@@ -0,0 +1,215 @@
+#ifndef _POLY_COLLECTION_H_
+#define _POLY_COLLECTION_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/*
+
+  - Poly_collection<Base> keeps objects of the classes derived from Base by value, one
+    segment per class, a std::vector of it, in the order the classes were first inserted.
+    a loop goes over a segment and then the next one, every call of a segment goes to the
+    same function, the branch predictor guesses the vtable right, and the code of one class
+    stays in the instruction cache, instead of the types interleaved of a std::vector<Base*>.
+
+  - for_each(fn) calls fn(Base&) with every object, a virtual call goes to the function of
+    its class as usual. for_each<Ts...>(fn) calls fn with the exact type for the segments of
+    Ts, fn(Checking_account&), a call on a final class is direct and inlined, the call on a
+    class that is not final names it, a.Saving_account::deposit(x), the other segments are
+    called with Base&.
+
+  - insert takes an object of its exact type, a Saving_account& that is a Trust_account would
+    be sliced, it throws std::invalid_argument. a segment moves its objects when it grows, a
+    reference to one is good until the next insert of its class.
+
+*/
+template<typename Base>
+class Poly_collection
+{
+  static_assert(std::is_polymorphic_v<Base>, "the classes are used through a Base with virtual functions");
+
+private:
+  struct Segment
+  {
+    std::type_index type;
+    // the Base of the first object and the distance between two, a segment is a std::vector
+    Base *first {nullptr};
+    std::size_t stride;
+    std::size_t count {0};
+
+    Segment(std::type_index type, std::size_t stride) : type{type}, stride{stride} {}
+    virtual ~Segment() = default;
+    virtual void clear() = 0;
+
+    Base &at(std::size_t i) const
+    {
+      return *std::launder(reinterpret_cast<Base*>(reinterpret_cast<char*>(this->first) + i * this->stride));
+    }
+  };
+
+  template<typename T>
+  struct Segment_of : Segment
+  {
+    std::vector<T> objects;
+
+    Segment_of() : Segment{typeid(T), sizeof(T)} {}
+
+    void update()
+    {
+      this->first = this->objects.empty() ? nullptr : static_cast<Base*>(this->objects.data());
+      this->count = this->objects.size();
+    }
+
+    void clear() override
+    {
+      this->objects.clear();
+      this->update();
+    }
+  };
+
+  std::vector<std::unique_ptr<Segment>> segments;
+  std::size_t num_objects {0};
+
+  Segment *find(std::type_index type) const
+  {
+    for (const std::unique_ptr<Segment> &segment : this->segments)
+      if (segment->type == type)
+        return segment.get();
+    return nullptr;
+  }
+
+  template<typename T>
+  Segment_of<T> &segment_of()
+  {
+    if (Segment *segment = this->find(typeid(T)))
+      return static_cast<Segment_of<T>&>(*segment);
+    this->segments.push_back(std::make_unique<Segment_of<T>>());
+    return static_cast<Segment_of<T>&>(*this->segments.back());
+  }
+
+  // the segment of the first of Ts that is its class, or the loop of Base&
+  template<typename Fn, typename T, typename... Rest>
+  static void visit_segment(Segment &segment, Fn &fn)
+  {
+    if (segment.type == std::type_index {typeid(T)}) {
+      for (T &object : static_cast<Segment_of<T>&>(segment).objects)
+        fn(object);
+    }
+    else if constexpr (sizeof...(Rest) > 0)
+      visit_segment<Fn, Rest...>(segment, fn);
+    else
+      for (std::size_t i {0}; i < segment.count; i++)
+        fn(segment.at(i));
+  }
+
+public:
+  Poly_collection() = default;
+
+  // a copy would have to know every class, the segments only know theirs by a template
+  Poly_collection(const Poly_collection &source) = delete;
+  Poly_collection &operator=(const Poly_collection &rhs) = delete;
+  Poly_collection(Poly_collection &&source) = default;
+  Poly_collection &operator=(Poly_collection &&rhs) = default;
+
+  template<typename T>
+  T &insert(T &&object)
+  {
+    using Type = std::remove_cv_t<std::remove_reference_t<T>>;
+    static_assert(std::is_base_of_v<Base, Type>, "the class is derived from Base");
+    if constexpr (!std::is_final_v<Type>)
+      if (typeid(object) != typeid(Type))
+        throw std::invalid_argument("Poly_collection::insert: the object is of a derived class, insert it as one");
+    return this->emplace<Type>(std::forward<T>(object));
+  }
+
+  template<typename T, typename... Args>
+  T &emplace(Args&&... args)
+  {
+    static_assert(std::is_base_of_v<Base, T>, "the class is derived from Base");
+    Segment_of<T> &segment = this->segment_of<T>();
+    T &object = segment.objects.emplace_back(std::forward<Args>(args)...);
+    segment.update();
+    this->num_objects++;
+    return object;
+  }
+
+  template<typename T>
+  void reserve(std::size_t n)
+  {
+    Segment_of<T> &segment = this->segment_of<T>();
+    segment.objects.reserve(n);
+    segment.update();
+  }
+
+  template<typename Fn>
+  void for_each(Fn fn)
+  {
+    for (const std::unique_ptr<Segment> &segment : this->segments)
+      for (std::size_t i {0}; i < segment->count; i++)
+        fn(segment->at(i));
+  }
+
+  template<typename Fn>
+  void for_each(Fn fn) const
+  {
+    for (const std::unique_ptr<Segment> &segment : this->segments)
+      for (std::size_t i {0}; i < segment->count; i++)
+        fn(static_cast<const Base&>(segment->at(i)));
+  }
+
+  template<typename T, typename... Ts, typename Fn>
+  void for_each(Fn fn)
+  {
+    for (const std::unique_ptr<Segment> &segment : this->segments)
+      visit_segment<Fn, T, Ts...>(*segment, fn);
+  }
+
+  // the objects of one class, empty when there is none
+  template<typename T>
+  const std::vector<T> &segment() const
+  {
+    static const std::vector<T> none;
+    const Segment *found = this->find(typeid(T));
+    return found == nullptr ? none : static_cast<const Segment_of<T>*>(found)->objects;
+  }
+
+  std::vector<Base*> pointers()
+  {
+    std::vector<Base*> result;
+    result.reserve(this->num_objects);
+    this->for_each([&result](Base &object) { result.push_back(&object); });
+    return result;
+  }
+
+  std::size_t size() const
+  {
+    return this->num_objects;
+  }
+
+  bool empty() const
+  {
+    return this->num_objects == 0;
+  }
+
+  std::size_t segment_count() const
+  {
+    return this->segments.size();
+  }
+
+  // the segments stay, with their capacity
+  void clear()
+  {
+    for (const std::unique_ptr<Segment> &segment : this->segments)
+      segment->clear();
+    this->num_objects = 0;
+  }
+};
+
+#endif
@@ -1,26 +1,24 @@
 #include <iostream>
-#include <iomanip>
 #include "Saving_account.h"
 
-Saving_account::Saving_account(const std::string name, const double balance, const double int_rate)
+Saving_account::Saving_account(const std::string name, const Money balance, const double int_rate)
   : Account(name , balance), int_rate(int_rate)
 {}
 
-bool Saving_account::deposit(double amount) 
+std::size_t Saving_account::format_size() const
 {
-  amount += amount * (int_rate / 100);
-  return Account::deposit(amount);
+  return sizeof(prefix) + this->name.size() + sizeof(balance_label) + Money::max_chars 
+    + sizeof(int_rate_label) + Money::max_chars + sizeof(suffix);
 }
 
-bool Saving_account::withdraw(double amount) 
+// the rate is printed with two decimals, the same fixed point formatter as money is used for it
+char *Saving_account::format(char *buff) const 
 {
-  return Account::withdraw(amount);
-}
-
-void Saving_account::print(std::ostream &os) const 
-{
-  std::cout << std::fixed << std::setprecision(2);
-  os << "Saving_account: { name: " << this->name 
-    << ", balance: " << this->balance 
-    << ", int_rate: " << this->int_rate << " }";
+  buff = put(buff, prefix, sizeof(prefix) - 1);
+  buff = put(buff, this->name.data(), this->name.size());
+  buff = put(buff, balance_label, sizeof(balance_label) - 1);
+  buff = this->balance.format(buff);
+  buff = put(buff, int_rate_label, sizeof(int_rate_label) - 1);
+  buff = Money {this->int_rate}.format(buff);
+  return put(buff, suffix, sizeof(suffix) - 1);
 }
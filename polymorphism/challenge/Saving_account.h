@@ -7,24 +7,44 @@
 
 class Saving_account: public Account
 {
+  friend class Account_store;
+  friend struct Account_log;
+  friend class Shared_ledger;
+
 private:
   static constexpr const char *def_name = "Unnamed savings account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
   static constexpr double def_int_rate = 0.0;
+  static constexpr char prefix[] = "Saving_account: { name: ";
+  static constexpr char balance_label[] = ", balance: ";
+  static constexpr char int_rate_label[] = ", int_rate: ";
+  static constexpr char suffix[] = " }";
 
 protected:
   double int_rate;
 
 public:
   Saving_account(const std::string name = def_name, 
-    const double balance = def_balance, 
+    const Money balance = def_balance, 
     const double int_rate = def_int_rate);
   
   virtual ~Saving_account() = default;
 
-  virtual bool deposit(double amount) override;
-  virtual bool withdraw(double amount) override;
-  virtual void print(std::ostream &os) const override;
+  virtual bool deposit(Money amount) override;
+  virtual bool withdraw(Money amount) override;
+  virtual std::size_t format_size() const override;
+  virtual char *format(char *buff) const override;
 };
 
+inline bool Saving_account::deposit(Money amount)
+{
+  amount += amount * (int_rate / 100);
+  return Account::deposit(amount);
+}
+
+inline bool Saving_account::withdraw(Money amount)
+{
+  return Account::withdraw(amount);
+}
+
 #endif
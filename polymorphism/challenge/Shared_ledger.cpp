@@ -0,0 +1,526 @@
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "Shared_ledger.h"
+#include "Checking_account.h"
+#include "Saving_account.h"
+#include "Trust_account.h"
+
+static void fail(const std::string &what)
+{
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::int64_t>::is_always_lock_free,
+  "the atomics of the segment are shared by processes, they have to be lock free");
+
+struct Shared_ledger::Header
+{
+  char magic[8];
+  std::uint64_t size;             // bytes of the segment
+  std::uint64_t num_accounts;
+  std::uint64_t ring_capacity;
+  std::uint64_t max_clients;
+  std::atomic<std::uint32_t> ready;
+  std::atomic<std::uint32_t> stopping;
+  std::atomic<std::uint32_t> stopped;   // serve has returned
+  alignas(64) std::atomic<std::uint64_t> enqueue;     // the writers
+  alignas(64) std::atomic<std::uint64_t> dequeue;     // the server
+  alignas(64) std::atomic<std::uint32_t> requests;    // the futex of the server, one more for every wake up
+  std::atomic<std::uint32_t> server_sleeping;
+};
+
+struct Shared_ledger::Slot
+{
+  std::atomic<std::uint64_t> sequence;  // the position it is for, one more once written, capacity more once read
+  std::uint64_t account_id;
+  std::int64_t cents;
+  std::uint32_t op;
+  std::uint32_t client;
+};
+
+struct alignas(64) Shared_ledger::Mailbox
+{
+  struct Reply
+  {
+    std::int64_t cents;
+    std::uint32_t accepted;
+  };
+
+  std::atomic<std::uint32_t> in_use;
+  std::atomic<std::uint32_t> sleeping;
+  alignas(64) std::atomic<std::uint32_t> replied;     // the futex of the client, the replies written
+  Reply replies[reply_capacity];
+};
+
+namespace
+{
+  constexpr char magic[8] = {'A', 'C', 'C', 'T', 'S', 'H', 'M', '1'};
+
+  std::size_t round_up(std::size_t size)
+  {
+    return (size + 63) & ~std::size_t {63};
+  }
+
+  // a timeout, a sleeper looks again even when the one that should wake it died
+  void futex_wait(std::atomic<std::uint32_t> &word, std::uint32_t expected)
+  {
+    timespec timeout {0, 100000000};
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+  }
+
+  void futex_wake(std::atomic<std::uint32_t> &word)
+  {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+  }
+
+  std::string segment_name(const std::string &name)
+  {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+  }
+}
+
+std::size_t Shared_ledger::layout(std::size_t num_accounts, std::size_t ring_capacity, std::size_t max_clients,
+  std::size_t &lines_at, std::size_t &slots_at, std::size_t &mailboxes_at)
+{
+  lines_at = round_up(sizeof(Header));
+  slots_at = round_up(lines_at + num_accounts * sizeof(Line));
+  mailboxes_at = round_up(slots_at + ring_capacity * sizeof(Slot));
+  return mailboxes_at + max_clients * sizeof(Mailbox);
+}
+
+void Shared_ledger::map(int fd, std::size_t size)
+{
+  void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED)
+    fail("mmap " + this->name);
+  this->data = static_cast<char*>(ptr);
+  this->mapped = size;
+}
+
+Shared_ledger::Shared_ledger(const std::string &name, const std::vector<Account*> &accounts,
+  std::size_t ring_capacity, std::size_t max_clients)
+  : name{segment_name(name)}, owner{true}
+{
+  if (ring_capacity < 2 || (ring_capacity & (ring_capacity - 1)) != 0)
+    throw std::invalid_argument("the ring capacity of a shared ledger has to be a power of 2");
+  if (max_clients == 0 || max_clients > 0xFFFF)
+    throw std::invalid_argument("a shared ledger has 1 to 65535 clients");
+  for (const auto &ptr: accounts)
+    if (ptr->get_name().size() > max_name_chars)
+      throw std::invalid_argument("the name " + ptr->get_name() + " is longer than " + std::to_string(max_name_chars)
+        + " chars");
+
+  // a stale segment of a run that crashed
+  ::shm_unlink(this->name.c_str());
+  const int fd = ::shm_open(this->name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0)
+    fail("shm_open " + this->name);
+
+  std::size_t lines_at, slots_at, mailboxes_at;
+  const std::size_t size = layout(accounts.size(), ring_capacity, max_clients, lines_at, slots_at, mailboxes_at);
+  try {
+    if (::ftruncate(fd, static_cast<off_t>(size)) < 0)
+      fail("ftruncate " + this->name);
+    this->map(fd, size);
+  }
+  catch (const std::runtime_error &) {
+    ::close(fd);
+    ::shm_unlink(this->name.c_str());
+    throw;
+  }
+  ::close(fd);
+
+  // the pages are zeros, the objects are only constructed on them
+  this->header = new (this->data) Header {};
+  this->lines = reinterpret_cast<Line*>(this->data + lines_at);
+  this->slots = reinterpret_cast<Slot*>(this->data + slots_at);
+  this->mailboxes = reinterpret_cast<Mailbox*>(this->data + mailboxes_at);
+
+  // the most derived type has to be tested first, Trust_account is a Saving_account
+  for (std::size_t i {0}; i < accounts.size(); i++) {
+    Line *line = new (this->lines + i) Line {};
+    Account *ptr = accounts[i];
+    if (auto t = dynamic_cast<Trust_account*>(ptr)) {
+      line->type = static_cast<std::uint8_t>(Account_store::Type::Trust);
+      line->int_rate = t->int_rate;
+      line->num_withdrawls.store(t->num_withdrawls, std::memory_order_relaxed);
+    }
+    else if (auto s = dynamic_cast<Saving_account*>(ptr)) {
+      line->type = static_cast<std::uint8_t>(Account_store::Type::Saving);
+      line->int_rate = s->int_rate;
+    }
+    else
+      line->type = static_cast<std::uint8_t>(Account_store::Type::Checking);
+    line->balance.store(ptr->balance.get_cents(), std::memory_order_relaxed);
+    line->name_size = static_cast<std::uint8_t>(ptr->name.size());
+    std::memcpy(line->name, ptr->name.data(), ptr->name.size());
+  }
+  for (std::size_t i {0}; i < ring_capacity; i++)
+    new (this->slots + i) Slot {i, 0, 0, 0, 0};
+  for (std::size_t i {0}; i < max_clients; i++)
+    new (this->mailboxes + i) Mailbox {};
+
+  std::memcpy(this->header->magic, magic, sizeof(magic));
+  this->header->size = size;
+  this->header->num_accounts = accounts.size();
+  this->header->ring_capacity = ring_capacity;
+  this->header->max_clients = max_clients;
+  this->num_mailboxes = max_clients;
+  this->header->ready.store(1, std::memory_order_release);
+}
+
+Shared_ledger::Shared_ledger(const std::string &name)
+  : name{segment_name(name)}, owner{false}
+{
+  const int fd = ::shm_open(this->name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+    fail("shm_open " + this->name);
+
+  struct stat st;
+  if (::fstat(fd, &st) < 0) {
+    ::close(fd);
+    fail("stat " + this->name);
+  }
+  if (static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error(this->name + " is not a shared ledger");
+  }
+  try {
+    this->map(fd, static_cast<std::size_t>(st.st_size));
+  }
+  catch (const std::runtime_error &) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+
+  this->header = reinterpret_cast<Header*>(this->data);
+  std::size_t lines_at, slots_at, mailboxes_at;
+  if (std::memcmp(this->header->magic, magic, sizeof(magic)) != 0 || this->header->ready.load(std::memory_order_acquire) != 1
+    || layout(this->header->num_accounts, this->header->ring_capacity, this->header->max_clients, lines_at, slots_at,
+      mailboxes_at) != this->mapped) {
+    ::munmap(this->data, this->mapped);
+    throw std::runtime_error(this->name + " is not a shared ledger");
+  }
+  this->lines = reinterpret_cast<Line*>(this->data + lines_at);
+  this->slots = reinterpret_cast<Slot*>(this->data + slots_at);
+  this->mailboxes = reinterpret_cast<Mailbox*>(this->data + mailboxes_at);
+  this->num_mailboxes = this->header->max_clients;
+}
+
+Shared_ledger::~Shared_ledger()
+{
+  ::munmap(this->data, this->mapped);
+  if (this->owner)
+    ::shm_unlink(this->name.c_str());
+}
+
+Shared_ledger::Result Shared_ledger::execute(std::size_t account_id, Operation op, Money amount)
+{
+  if (account_id >= this->header->num_accounts)
+    return {false, 0.0};
+
+  // one account of every class, its fields set from the line, its own deposit and withdraw decide
+  static Checking_account checking;
+  static Saving_account saving;
+  static Trust_account trust;
+
+  Line &line = this->lines[account_id];
+  const Money balance = Money::from_cents(line.balance.load(std::memory_order_relaxed));
+  bool accepted {false};
+  Money after {balance};
+  int withdrawls {line.num_withdrawls.load(std::memory_order_relaxed)};
+
+  switch (static_cast<Account_store::Type>(line.type)) {
+  case Account_store::Type::Checking:
+    checking.balance = balance;
+    accepted = op == Operation::Deposit ? checking.Checking_account::deposit(amount)
+      : checking.Checking_account::withdraw(amount);
+    after = checking.balance;
+    break;
+  case Account_store::Type::Saving:
+    saving.balance = balance;
+    saving.int_rate = line.int_rate;
+    accepted = op == Operation::Deposit ? saving.Saving_account::deposit(amount) : saving.Saving_account::withdraw(amount);
+    after = saving.balance;
+    break;
+  case Account_store::Type::Trust:
+    trust.balance = balance;
+    trust.int_rate = line.int_rate;
+    trust.num_withdrawls = withdrawls;
+    accepted = op == Operation::Deposit ? trust.Trust_account::deposit(amount) : trust.Trust_account::withdraw(amount);
+    after = trust.balance;
+    withdrawls = trust.num_withdrawls;
+    break;
+  }
+
+  if (accepted) {
+    // odd while the fields change, a reader that sees it, or a change of it, reads again
+    const std::uint32_t sequence = line.sequence.load(std::memory_order_relaxed);
+    line.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    line.balance.store(after.get_cents(), std::memory_order_relaxed);
+    line.num_withdrawls.store(withdrawls, std::memory_order_relaxed);
+    line.sequence.store(sequence + 2, std::memory_order_release);
+  }
+  return {accepted, after};
+}
+
+std::size_t Shared_ledger::poll()
+{
+  const std::uint64_t mask = this->header->ring_capacity - 1;
+  std::uint64_t at = this->header->dequeue.load(std::memory_order_relaxed);
+  std::size_t count {0};
+
+  for (;;) {
+    Slot &slot = this->slots[at & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != at + 1)
+      break;
+    const std::uint64_t account_id = slot.account_id;
+    const Money amount = Money::from_cents(slot.cents);
+    const std::uint32_t op = slot.op;
+    const std::uint32_t client = slot.client;
+    slot.sequence.store(at + this->header->ring_capacity, std::memory_order_release);
+    at++;
+
+    // the slot is written by another process: a client without a mailbox is dropped, there is
+    // no one to reply to, an operation that is not one is refused
+    if (client >= this->num_mailboxes)
+      continue;
+    const bool is_operation = op == static_cast<std::uint32_t>(Operation::Deposit)
+      || op == static_cast<std::uint32_t>(Operation::Withdraw);
+    const Result result = is_operation ? this->execute(account_id, static_cast<Operation>(op), amount) : Result {false, 0.0};
+    Mailbox &box = this->mailboxes[client];
+    const std::uint32_t replied = box.replied.load(std::memory_order_relaxed);
+    box.replies[replied % reply_capacity] = {result.balance.get_cents(), result.accepted ? 1u : 0u};
+    box.replied.store(replied + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (box.sleeping.load(std::memory_order_relaxed))
+      futex_wake(box.replied);
+    count++;
+  }
+
+  this->header->dequeue.store(at, std::memory_order_relaxed);
+  return count;
+}
+
+std::size_t Shared_ledger::serve()
+{
+  if (!this->owner)
+    throw std::runtime_error("only the process that created " + this->name + " serves it");
+
+  const std::uint64_t mask = this->header->ring_capacity - 1;
+  std::size_t applied {0};
+  int idle {0};
+  for (;;) {
+    const bool stopping = this->header->stopping.load(std::memory_order_acquire);
+    const std::size_t count = this->poll();
+    applied += count;
+    if (count > 0) {
+      idle = 0;
+      continue;
+    }
+    if (stopping)
+      break;
+    if (++idle < spin_polls) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // say it sleeps, then look once more, a request written before the flag was seen is found here
+    const std::uint32_t seen = this->header->requests.load(std::memory_order_relaxed);
+    this->header->server_sleeping.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::uint64_t at = this->header->dequeue.load(std::memory_order_relaxed);
+    if (this->slots[at & mask].sequence.load(std::memory_order_relaxed) != at + 1
+      && !this->header->stopping.load(std::memory_order_relaxed))
+      futex_wait(this->header->requests, seen);
+    this->header->server_sleeping.store(0, std::memory_order_relaxed);
+    idle = 0;
+  }
+
+  this->header->stopped.store(1, std::memory_order_release);
+  for (std::size_t i {0}; i < this->num_mailboxes; i++)
+    futex_wake(this->mailboxes[i].replied);
+  return applied;
+}
+
+void Shared_ledger::stop()
+{
+  this->header->stopping.store(1, std::memory_order_release);
+  this->header->requests.fetch_add(1, std::memory_order_release);
+  futex_wake(this->header->requests);
+}
+
+std::size_t Shared_ledger::size() const
+{
+  return this->header->num_accounts;
+}
+
+Shared_ledger::Account_state Shared_ledger::read(std::size_t position) const
+{
+  if (position >= this->header->num_accounts)
+    throw std::out_of_range("no account " + std::to_string(position) + " in " + this->name);
+
+  const Line &line = this->lines[position];
+  Account_state state {static_cast<Account_store::Type>(line.type), std::string {line.name, line.name_size}, 0.0,
+    line.int_rate, 0};
+  for (;;) {
+    const std::uint32_t before = line.sequence.load(std::memory_order_acquire);
+    const std::int64_t cents = line.balance.load(std::memory_order_relaxed);
+    const std::int32_t withdrawls = line.num_withdrawls.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (before % 2 == 0 && line.sequence.load(std::memory_order_relaxed) == before) {
+      state.balance = Money::from_cents(cents);
+      state.num_withdrawls = withdrawls;
+      return state;
+    }
+    std::this_thread::yield();
+  }
+}
+
+Money Shared_ledger::get_balance(std::size_t position) const
+{
+  return this->read(position).balance;
+}
+
+std::vector<std::unique_ptr<Account>> Shared_ledger::accounts() const
+{
+  std::vector<std::unique_ptr<Account>> result;
+  for (std::size_t i {0}; i < this->size(); i++) {
+    const Account_state state = this->read(i);
+    switch (state.type) {
+    case Account_store::Type::Checking:
+      result.push_back(std::make_unique<Checking_account>(state.name, state.balance));
+      break;
+    case Account_store::Type::Saving:
+      result.push_back(std::make_unique<Saving_account>(state.name, state.balance, state.int_rate));
+      break;
+    case Account_store::Type::Trust: {
+      auto trust = std::make_unique<Trust_account>(state.name, state.balance, state.int_rate);
+      trust->num_withdrawls = state.num_withdrawls;
+      result.push_back(std::move(trust));
+      break;
+    }
+    }
+  }
+  return result;
+}
+
+Shared_ledger::Client::Client(Shared_ledger &ledger)
+  : ledger{ledger}, index{0}, next_ticket{0}
+{
+  for (std::uint32_t i {0}; i < ledger.num_mailboxes; i++) {
+    std::uint32_t free {0};
+    if (ledger.mailboxes[i].in_use.compare_exchange_strong(free, 1, std::memory_order_acquire)) {
+      this->index = i;
+      this->next_ticket = ledger.mailboxes[i].replied.load(std::memory_order_acquire);
+      return;
+    }
+  }
+  throw std::runtime_error("the " + std::to_string(ledger.num_mailboxes) + " clients of " + ledger.name
+    + " are all taken");
+}
+
+Shared_ledger::Client::~Client()
+{
+  try {
+    if (this->ledger.mailboxes[this->index].replied.load(std::memory_order_acquire) != this->next_ticket)
+      this->wait(this->next_ticket - 1);
+  }
+  catch (const std::runtime_error &) {}
+  this->ledger.mailboxes[this->index].in_use.store(0, std::memory_order_release);
+}
+
+std::uint32_t Shared_ledger::Client::submit(std::size_t account_id, Operation op, Money amount)
+{
+  Header &header = *this->ledger.header;
+  Mailbox &box = this->ledger.mailboxes[this->index];
+  // the reply of the oldest request still in the mailbox is read before its place is reused
+  if (this->next_ticket - box.replied.load(std::memory_order_acquire) >= reply_capacity)
+    this->wait(this->next_ticket - reply_capacity);
+
+  const std::uint64_t mask = header.ring_capacity - 1;
+  std::uint64_t at = header.enqueue.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &this->ledger.slots[at & mask];
+    const std::int64_t turn = static_cast<std::int64_t>(slot->sequence.load(std::memory_order_acquire) - at);
+    if (turn == 0) {
+      if (header.enqueue.compare_exchange_weak(at, at + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (turn < 0) {
+      // the ring is full, the server has to run
+      if (header.stopped.load(std::memory_order_acquire))
+        throw std::runtime_error(this->ledger.name + " is not served anymore");
+      header.requests.fetch_add(1, std::memory_order_release);
+      futex_wake(header.requests);
+      std::this_thread::yield();
+      at = header.enqueue.load(std::memory_order_relaxed);
+    }
+    else
+      at = header.enqueue.load(std::memory_order_relaxed);
+  }
+
+  slot->account_id = account_id;
+  slot->cents = amount.get_cents();
+  slot->op = static_cast<std::uint32_t>(op);
+  slot->client = this->index;
+  slot->sequence.store(at + 1, std::memory_order_release);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header.server_sleeping.load(std::memory_order_relaxed)) {
+    header.requests.fetch_add(1, std::memory_order_release);
+    futex_wake(header.requests);
+  }
+  return this->next_ticket++;
+}
+
+std::uint32_t Shared_ledger::Client::submit(const Transaction &transaction)
+{
+  return this->submit(transaction.account_id, transaction.op, transaction.amount);
+}
+
+Shared_ledger::Result Shared_ledger::Client::wait(std::uint32_t ticket)
+{
+  Mailbox &box = this->ledger.mailboxes[this->index];
+  int idle {0};
+  for (;;) {
+    const std::uint32_t replied = box.replied.load(std::memory_order_acquire);
+    if (static_cast<std::int32_t>(replied - ticket) > 0) {
+      const Mailbox::Reply &reply = box.replies[ticket % reply_capacity];
+      return {reply.accepted != 0, Money::from_cents(reply.cents)};
+    }
+    if (this->ledger.header->stopped.load(std::memory_order_acquire)
+      && box.replied.load(std::memory_order_acquire) == replied)
+      throw std::runtime_error(this->ledger.name + " is not served anymore");
+    if (++idle < spin_polls) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    box.sleeping.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (box.replied.load(std::memory_order_relaxed) == replied)
+      futex_wait(box.replied, replied);
+    box.sleeping.store(0, std::memory_order_relaxed);
+    idle = 0;
+  }
+}
+
+Shared_ledger::Result Shared_ledger::Client::apply(const Transaction &transaction)
+{
+  return this->wait(this->submit(transaction));
+}
@@ -0,0 +1,149 @@
+#ifndef _SHARED_LEDGER_H_
+#define _SHARED_LEDGER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Account.h"
+#include "Account_store.h"
+#include "Money.h"
+#include "Transaction.h"
+
+/*
+
+  - Shared_ledger is the accounts of a ledger in a POSIX shared memory segment, for the
+    processes of one host: the one that creates it serves the deposits and withdrawals,
+    the others open it by name, submit requests through a Client, or read the accounts
+    for a report, with no file and no socket in between (Linux only, the futexes).
+
+  - an account is a line of 64 bytes: its class, its name, its int_rate, and its balance
+    and num_withdrawls behind a sequence number, odd while the server changes them, a
+    reader copies them and takes the copy when the number did not change, a seqlock, the
+    server is never held up by a report. every account is consistent, the ledger as a
+    whole is not a snapshot.
+
+  - the requests are a bounded lock free ring of many writers and one reader, a slot of it
+    has a sequence number that says whose turn it is, the writers take a slot with a
+    compare and swap. every Client has a mailbox of reply_capacity replies in the segment,
+    written in the order of its requests, the ticket of a request is its place there.
+
+  - the server and a client that run out of work spin spin_polls times, with a yield,
+    then sleep on a futex of the segment, the word the other side changes. a sleeper says
+    so before it sleeps, the other side only makes the wake up system call when someone
+    sleeps, a loaded ledger makes no system call at all.
+
+  - serve() applies the requests with the rules of the class of the account, the way its
+    deposit and withdraw do, until stop() is called, by any process. a process that dies in
+    the middle of a request can leave the ring stalled, the segment is for cooperating
+    processes of one program. names of more than max_name_chars, a segment that is not a
+    ledger or more than max_clients clients throw, the errors of the operating system are
+    std::runtime_error. a request of a client that has no mailbox is dropped, one of an
+    operation that is not a deposit or a withdraw is refused.
+
+*/
+class Shared_ledger
+{
+public:
+  static constexpr std::size_t max_name_chars = 31;
+  static constexpr std::size_t def_ring_capacity = 1024;
+  static constexpr std::size_t def_max_clients = 16;
+  static constexpr std::size_t reply_capacity = 256;
+  static constexpr int spin_polls = 64;
+
+  struct Result
+  {
+    bool accepted;
+    Money balance;  // of the account, after the request
+  };
+
+  struct Account_state
+  {
+    Account_store::Type type;
+    std::string name;
+    Money balance;
+    double int_rate;
+    int num_withdrawls;
+  };
+
+private:
+  struct Header;
+  struct Slot;
+  struct Mailbox;
+
+  struct alignas(64) Line
+  {
+    std::atomic<std::uint32_t> sequence;
+    std::uint8_t type;
+    std::uint8_t name_size;
+    std::atomic<std::int64_t> balance;
+    std::atomic<std::int32_t> num_withdrawls;
+    double int_rate;
+    char name[max_name_chars + 1];
+  };
+
+  std::string name;
+  bool owner;
+  char *data {nullptr};
+  std::size_t mapped {0};
+  Header *header {nullptr};
+  Line *lines {nullptr};
+  Slot *slots {nullptr};
+  Mailbox *mailboxes {nullptr};
+  // the mailboxes of the layout that was mapped, not the header, which any process can write
+  std::size_t num_mailboxes {0};
+
+  static std::size_t layout(std::size_t num_accounts, std::size_t ring_capacity, std::size_t max_clients,
+    std::size_t &lines_at, std::size_t &slots_at, std::size_t &mailboxes_at);
+  void map(int fd, std::size_t size);
+  Result execute(std::size_t account_id, Operation op, Money amount);
+  std::size_t poll();
+
+public:
+  class Client
+  {
+  private:
+    Shared_ledger &ledger;
+    std::uint32_t index;
+    std::uint32_t next_ticket;
+
+    // the next request, enqueued for the server, waits while the mailbox would overflow
+    std::uint32_t submit(std::size_t account_id, Operation op, Money amount);
+
+  public:
+    explicit Client(Shared_ledger &ledger);
+    Client(const Client &source) = delete;
+    Client &operator=(const Client &rhs) = delete;
+    // waits for the replies of its requests, the mailbox is given back
+    ~Client();
+
+    std::uint32_t submit(const Transaction &transaction);
+    // the reply of a ticket, one of the last reply_capacity ones, waits for it
+    Result wait(std::uint32_t ticket);
+    // a submit and its wait
+    Result apply(const Transaction &transaction);
+  };
+
+  // creates the segment /name with the accounts, a stale one of the same name is replaced, removes it in the destructor
+  Shared_ledger(const std::string &name, const std::vector<Account*> &accounts,
+    std::size_t ring_capacity = def_ring_capacity, std::size_t max_clients = def_max_clients);
+  // opens the segment another process created
+  explicit Shared_ledger(const std::string &name);
+  Shared_ledger(const Shared_ledger &source) = delete;
+  Shared_ledger &operator=(const Shared_ledger &rhs) = delete;
+  ~Shared_ledger();
+
+  // the requests until stop(), returns how many were applied, only in the process that created the ledger
+  std::size_t serve();
+  void stop();
+
+  std::size_t size() const;
+  Account_state read(std::size_t position) const;
+  Money get_balance(std::size_t position) const;
+  // the accounts as objects, for display() and display_bulk()
+  std::vector<std::unique_ptr<Account>> accounts() const;
+};
+
+#endif
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include "Snapshot_ledger.h"
+
+Snapshot_ledger::Snapshot_ledger(std::vector<Any_account> accounts, std::size_t chunk_size, std::size_t max_readers)
+  : num_accounts(accounts.size()), chunk_size(chunk_size == 0 ? 1 : chunk_size),
+    max_readers(max_readers == 0 ? 1 : max_readers)
+{
+  this->num_chunks = (this->num_accounts + this->chunk_size - 1) / this->chunk_size;
+  this->chunks.reset(new Chunk[this->num_chunks]);
+  for (std::size_t c {0}; c < this->num_chunks; c++) {
+    Version *version = new Version {0, {nullptr}, {}};
+    const std::size_t first = c * this->chunk_size;
+    const std::size_t last = std::min(this->num_accounts, first + this->chunk_size);
+    version->accounts.reserve(last - first);
+    for (std::size_t id {first}; id < last; id++)
+      version->accounts.push_back(std::move(accounts[id]));
+    this->chunks[c].newest.store(version, std::memory_order_relaxed);
+  }
+
+  this->pinned.reset(new std::atomic<std::uint64_t>[this->max_readers]);
+  this->walking.reset(new std::atomic<std::uint64_t>[this->max_readers]);
+  for (std::size_t r {0}; r < this->max_readers; r++) {
+    this->pinned[r].store(idle, std::memory_order_relaxed);
+    this->walking[r].store(idle, std::memory_order_relaxed);
+  }
+}
+
+Snapshot_ledger::~Snapshot_ledger()
+{
+  for (std::size_t c {0}; c < this->num_chunks; c++) {
+    Version *version = this->chunks[c].newest.load(std::memory_order_relaxed);
+    while (version != nullptr) {
+      Version *older = version->older.load(std::memory_order_relaxed);
+      delete version;
+      version = older;
+    }
+    for (auto &retired: this->chunks[c].retired)
+      delete retired.second;
+  }
+}
+
+/*
+
+  - the writers of the epochs before have to publish theirs first, so a snapshot of an
+    epoch sees every version of it and of the ones before. a writer stays between
+    taking its epoch and publishing it only for a copy of a chunk, the others wait
+    for it yielding, one core is enough for all of them.
+
+*/
+void Snapshot_ledger::publish(std::uint64_t epoch)
+{
+  while (this->published.load(std::memory_order_acquire) != epoch - 1)
+    std::this_thread::yield();
+  this->published.store(epoch, std::memory_order_seq_cst);
+}
+
+void Snapshot_ledger::trim(Chunk &chunk)
+{
+  // the epochs of the snapshots, the newest first, a snapshot to come sees the newest version
+  std::vector<std::uint64_t> epochs;
+  for (std::size_t r {0}; r < this->max_readers; r++) {
+    const std::uint64_t epoch = this->pinned[r].load(std::memory_order_seq_cst);
+    if (epoch != idle)
+      epochs.push_back(epoch);
+  }
+  std::sort(epochs.begin(), epochs.end(), std::greater<std::uint64_t>());
+
+  // a version is seen by the snapshots from its epoch to the one before the next one
+  Version *kept = chunk.newest.load(std::memory_order_relaxed);
+  Version *version = kept->older.load(std::memory_order_relaxed);
+  std::size_t e {0};
+  bool unlinked {false};
+  while (version != nullptr) {
+    while (e < epochs.size() && epochs[e] >= kept->epoch)
+      e++;
+    Version *older = version->older.load(std::memory_order_relaxed);
+    const bool seen = e < epochs.size() && epochs[e] >= version->epoch;
+    if (seen)
+      kept = version;
+    else {
+      kept->older.store(older, std::memory_order_release);
+      chunk.retired.emplace_back(0, version);
+      unlinked = true;
+    }
+    version = older;
+  }
+
+  if (unlinked) {
+    const std::uint64_t generation = this->generation.fetch_add(1, std::memory_order_seq_cst);
+    for (auto &retired: chunk.retired)
+      if (retired.first == 0)
+        retired.first = generation + 1;
+  }
+
+  // a reader walking since a generation after the unlink can not be on the version
+  std::uint64_t oldest {idle};
+  for (std::size_t r {0}; r < this->max_readers; r++)
+    oldest = std::min(oldest, this->walking[r].load(std::memory_order_seq_cst));
+  auto freed = std::remove_if(chunk.retired.begin(), chunk.retired.end(), [oldest](const auto &retired) {
+    if (retired.first > oldest)
+      return false;
+    delete retired.second;
+    return true;
+  });
+  chunk.retired.erase(freed, chunk.retired.end());
+}
+
+template<typename Op>
+bool Snapshot_ledger::write(std::size_t id, Op op)
+{
+  if (id >= this->num_accounts)
+    throw std::out_of_range {"Snapshot_ledger: no account with this id"};
+  Chunk &chunk = this->chunks[id / this->chunk_size];
+  std::lock_guard<std::mutex> lock {chunk.lock};
+
+  Version *newest = chunk.newest.load(std::memory_order_relaxed);
+  std::unique_ptr<Version> version {new Version {0, {newest}, newest->accounts}};
+  if (!op(version->accounts))
+    return false;
+
+  version->epoch = this->next_epoch.fetch_add(1, std::memory_order_seq_cst);
+  chunk.newest.store(version.get(), std::memory_order_release);
+  this->publish(version.release()->epoch);
+  this->trim(chunk);
+  return true;
+}
+
+bool Snapshot_ledger::deposit(std::size_t id, Money amount)
+{
+  const std::size_t at = id % this->chunk_size;
+  return this->write(id, [at, amount](std::vector<Any_account> &accounts) { return ::deposit(accounts[at], amount); });
+}
+
+bool Snapshot_ledger::withdraw(std::size_t id, Money amount)
+{
+  const std::size_t at = id % this->chunk_size;
+  return this->write(id, [at, amount](std::vector<Any_account> &accounts) { return ::withdraw(accounts[at], amount); });
+}
+
+bool Snapshot_ledger::transfer(std::size_t from, std::size_t to, Money amount)
+{
+  if (from >= this->num_accounts || to >= this->num_accounts)
+    throw std::out_of_range {"Snapshot_ledger: no account with this id"};
+  const std::size_t from_chunk = from / this->chunk_size;
+  const std::size_t to_chunk = to / this->chunk_size;
+  if (from_chunk == to_chunk) {
+    // both in the same copy, it is dropped when either one is refused
+    const std::size_t from_at = from % this->chunk_size;
+    const std::size_t to_at = to % this->chunk_size;
+    return this->write(from, [from_at, to_at, amount](std::vector<Any_account> &accounts) {
+      return ::withdraw(accounts[from_at], amount) && ::deposit(accounts[to_at], amount);
+    });
+  }
+
+  // the two locks in the order of the chunks, two transfers the other way do not wait for each other forever
+  Chunk &first = this->chunks[std::min(from_chunk, to_chunk)];
+  Chunk &second = this->chunks[std::max(from_chunk, to_chunk)];
+  std::lock_guard<std::mutex> first_lock {first.lock};
+  std::lock_guard<std::mutex> second_lock {second.lock};
+
+  Chunk &source = this->chunks[from_chunk];
+  Chunk &target = this->chunks[to_chunk];
+  Version *source_newest = source.newest.load(std::memory_order_relaxed);
+  Version *target_newest = target.newest.load(std::memory_order_relaxed);
+  std::unique_ptr<Version> source_version {new Version {0, {source_newest}, source_newest->accounts}};
+  std::unique_ptr<Version> target_version {new Version {0, {target_newest}, target_newest->accounts}};
+  if (!::withdraw(source_version->accounts[from % this->chunk_size], amount)
+    || !::deposit(target_version->accounts[to % this->chunk_size], amount))
+    return false;
+
+  const std::uint64_t epoch = this->next_epoch.fetch_add(1, std::memory_order_seq_cst);
+  source_version->epoch = epoch;
+  target_version->epoch = epoch;
+  source.newest.store(source_version.release(), std::memory_order_release);
+  target.newest.store(target_version.release(), std::memory_order_release);
+  this->publish(epoch);
+  this->trim(source);
+  this->trim(target);
+  return true;
+}
+
+Money Snapshot_ledger::get_balance(std::size_t id)
+{
+  Snapshot snapshot {this->snapshot()};
+  return as_account(snapshot.get(id)).get_balance();
+}
+
+std::size_t Snapshot_ledger::acquire_reader()
+{
+  for (std::size_t r {0}; r < this->max_readers; r++) {
+    std::uint64_t expected {idle};
+    // any epoch that is not idle, pin sets the one to see
+    if (this->pinned[r].compare_exchange_strong(expected, 0, std::memory_order_seq_cst))
+      return r;
+  }
+  throw std::runtime_error {"Snapshot_ledger: too many snapshots at once"};
+}
+
+/*
+
+  - the epoch is pinned and then read again, when it is still the published one a writer
+    that trims after it sees the pin, one that did not see it trimmed before the epoch
+    was published, with the versions of the epoch in its chain.
+
+*/
+std::uint64_t Snapshot_ledger::pin(std::size_t reader)
+{
+  std::uint64_t epoch = this->published.load(std::memory_order_seq_cst);
+  for (;;) {
+    this->pinned[reader].store(epoch, std::memory_order_seq_cst);
+    const std::uint64_t now = this->published.load(std::memory_order_seq_cst);
+    if (now == epoch)
+      return epoch;
+    epoch = now;
+  }
+}
+
+const Snapshot_ledger::Version *Snapshot_ledger::find(std::size_t reader, std::uint64_t epoch, std::size_t chunk) const
+{
+  // the generation the walk started in, read again the way the epoch is
+  std::uint64_t generation = this->generation.load(std::memory_order_seq_cst);
+  for (;;) {
+    this->walking[reader].store(generation, std::memory_order_seq_cst);
+    const std::uint64_t now = this->generation.load(std::memory_order_seq_cst);
+    if (now == generation)
+      break;
+    generation = now;
+  }
+
+  const Version *version = this->chunks[chunk].newest.load(std::memory_order_acquire);
+  while (version->epoch > epoch)
+    version = version->older.load(std::memory_order_acquire);
+
+  this->walking[reader].store(idle, std::memory_order_release);
+  return version;
+}
+
+Snapshot_ledger::Snapshot Snapshot_ledger::snapshot()
+{
+  const std::size_t reader = this->acquire_reader();
+  return Snapshot {this, reader, this->pin(reader)};
+}
+
+std::size_t Snapshot_ledger::size() const
+{
+  return this->num_accounts;
+}
+
+std::size_t Snapshot_ledger::get_num_versions()
+{
+  std::size_t count {0};
+  for (std::size_t c {0}; c < this->num_chunks; c++) {
+    std::lock_guard<std::mutex> lock {this->chunks[c].lock};
+    for (Version *version = this->chunks[c].newest.load(std::memory_order_relaxed); version != nullptr;
+      version = version->older.load(std::memory_order_relaxed))
+      count++;
+    count += this->chunks[c].retired.size();
+  }
+  return count;
+}
+
+Snapshot_ledger::Snapshot::Snapshot(Snapshot &&source) noexcept
+  : ledger(source.ledger), reader(source.reader), epoch(source.epoch)
+{
+  source.ledger = nullptr;
+}
+
+Snapshot_ledger::Snapshot &Snapshot_ledger::Snapshot::operator=(Snapshot rhs) noexcept
+{
+  std::swap(this->ledger, rhs.ledger);
+  std::swap(this->reader, rhs.reader);
+  std::swap(this->epoch, rhs.epoch);
+  return *this;
+}
+
+Snapshot_ledger::Snapshot::~Snapshot()
+{
+  if (this->ledger != nullptr)
+    this->ledger->pinned[this->reader].store(idle, std::memory_order_release);
+}
+
+std::uint64_t Snapshot_ledger::Snapshot::get_epoch() const
+{
+  return this->epoch;
+}
+
+std::size_t Snapshot_ledger::Snapshot::size() const
+{
+  return this->ledger->num_accounts;
+}
+
+const Any_account &Snapshot_ledger::Snapshot::get(std::size_t id) const
+{
+  if (id >= this->ledger->num_accounts)
+    throw std::out_of_range {"Snapshot_ledger: no account with this id"};
+  const Version *version = this->ledger->find(this->reader, this->epoch, id / this->ledger->chunk_size);
+  return version->accounts[id % this->ledger->chunk_size];
+}
+
+Money Snapshot_ledger::Snapshot::get_total_balance() const
+{
+  Money total {0.0};
+  this->for_each([&total](std::size_t, const Any_account &account) { total += as_account(account).get_balance(); });
+  return total;
+}
@@ -0,0 +1,142 @@
+#ifndef _SNAPSHOT_LEDGER_H_
+#define _SNAPSHOT_LEDGER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "Account_variant.h"
+#include "Money.h"
+
+/*
+
+  - Snapshot_ledger keeps accounts that threads deposit to and withdraw from while other
+    threads read a consistent snapshot of all of them, a report of the month that takes
+    minutes, without a lock, and without stopping a single deposit.
+
+  - the accounts are Any_account values in chunks of chunk_size, every chunk is a chain of
+    versions, the newest first. a deposit copies the newest version of the chunk of the
+    account under the lock of the chunk, changes the copy, stamps it with the next epoch
+    and links it at the front, the old one is still there for whoever reads it. the epochs
+    are published in their order, a snapshot pins the published epoch and sees, of every
+    chunk, the newest version not after it, a transfer puts its two versions in the same
+    epoch, a snapshot sees both of them or neither.
+
+  - a version is kept while a pinned snapshot sees it, the writer of a chunk drops the
+    others from its chain, a long report keeps one version of each chunk, not all of the
+    ones written while it runs. a reader that is walking the chain at that moment can still
+    be on one, it is freed once every reader that was walking has stopped, a walk is the
+    few versions of one chunk, not the whole report.
+
+  - at most max_readers snapshots at once, one more throws std::runtime_error. the
+    snapshots are destroyed before the ledger, get_balance takes a snapshot of its own.
+
+*/
+class Snapshot_ledger
+{
+private:
+  struct Version
+  {
+    std::uint64_t epoch;
+    std::atomic<Version*> older;
+    std::vector<Any_account> accounts;
+  };
+
+  struct alignas(64) Chunk
+  {
+    std::mutex lock;
+    std::atomic<Version*> newest {nullptr};
+    std::vector<std::pair<std::uint64_t, Version*>> retired;  // unlinked, with the generation of the unlink
+  };
+
+  static constexpr std::size_t def_chunk_size = 8;
+  static constexpr std::size_t def_max_readers = 64;
+  static constexpr std::uint64_t idle = UINT64_MAX;
+
+  std::size_t num_accounts;
+  std::size_t chunk_size;
+  std::size_t max_readers;
+  std::unique_ptr<Chunk[]> chunks;
+  std::size_t num_chunks;
+  // the epoch of the next write, and the last one whose versions are all linked
+  std::atomic<std::uint64_t> next_epoch {1};
+  std::atomic<std::uint64_t> published {0};
+  // the generation of the unlinks, a reader that walks a chain says the one it saw
+  std::atomic<std::uint64_t> generation {0};
+  std::unique_ptr<std::atomic<std::uint64_t>[]> pinned;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> walking;
+
+  void publish(std::uint64_t epoch);
+  // the chunk is locked, its versions that no snapshot sees are unlinked and freed when they can be
+  void trim(Chunk &chunk);
+
+  std::size_t acquire_reader();
+  std::uint64_t pin(std::size_t reader);
+  const Version *find(std::size_t reader, std::uint64_t epoch, std::size_t chunk) const;
+
+  // op(std::vector<Any_account> &) changes the copy of the chunk of the account, false drops it
+  template<typename Op>
+  bool write(std::size_t id, Op op);
+
+public:
+  class Snapshot
+  {
+    friend class Snapshot_ledger;
+
+  private:
+    const Snapshot_ledger *ledger;
+    std::size_t reader;
+    std::uint64_t epoch;
+
+    Snapshot(const Snapshot_ledger *ledger, std::size_t reader, std::uint64_t epoch)
+      : ledger(ledger), reader(reader), epoch(epoch)
+    {}
+
+  public:
+    Snapshot(Snapshot &&source) noexcept;
+    Snapshot &operator=(Snapshot rhs) noexcept;
+    Snapshot(const Snapshot &) = delete;
+    ~Snapshot();
+
+    std::uint64_t get_epoch() const;
+    std::size_t size() const;
+    // the account as it was at the epoch, good while the snapshot is
+    const Any_account &get(std::size_t id) const;
+    Money get_total_balance() const;
+
+    // fn(std::size_t id, const Any_account &) of every account, in the order of the ids
+    template<typename Fn>
+    void for_each(Fn fn) const
+    {
+      for (std::size_t c {0}; c < this->ledger->num_chunks; c++) {
+        const Version *version = this->ledger->find(this->reader, this->epoch, c);
+        for (std::size_t i {0}; i < version->accounts.size(); i++)
+          fn(c * this->ledger->chunk_size + i, version->accounts[i]);
+      }
+    }
+  };
+
+  Snapshot_ledger(std::vector<Any_account> accounts, std::size_t chunk_size = def_chunk_size,
+    std::size_t max_readers = def_max_readers);
+  ~Snapshot_ledger();
+
+  Snapshot_ledger(const Snapshot_ledger &) = delete;
+  Snapshot_ledger &operator=(const Snapshot_ledger &) = delete;
+
+  bool deposit(std::size_t id, Money amount);
+  bool withdraw(std::size_t id, Money amount);
+  // the withdraw and the deposit in one epoch, nothing when either one is refused
+  bool transfer(std::size_t from, std::size_t to, Money amount);
+  Money get_balance(std::size_t id);
+
+  Snapshot snapshot();
+
+  std::size_t size() const;
+  // the versions in the chains and the ones waiting to be freed, the newest ones too
+  std::size_t get_num_versions();
+};
+
+#endif
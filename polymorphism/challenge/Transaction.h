@@ -0,0 +1,16 @@
+#ifndef _TRANSACTION_H_
+#define _TRANSACTION_H_
+
+#include <cstddef>
+#include "Money.h"
+
+enum class Operation { Deposit, Withdraw };
+
+struct Transaction
+{
+  std::size_t account_id; // index into the accounts vector
+  Operation op;
+  Money amount;
+};
+
+#endif
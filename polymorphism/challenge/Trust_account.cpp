@@ -1,33 +1,27 @@
+#include <charconv>
 #include <iostream>
-#include <iomanip>
 #include "Trust_account.h"
 
-Trust_account::Trust_account(const std::string name, const double balance, const double int_rate)
+Trust_account::Trust_account(const std::string name, const Money balance, const double int_rate)
   : Saving_account(name, balance, int_rate), num_withdrawls(0)
 {}
 
-bool Trust_account::deposit(double amount) 
+std::size_t Trust_account::format_size() const
 {
-  if (amount >= this->bonus_threshold)
-    amount += this->bonus_amount;
-  
-  return Saving_account::deposit(amount);
+  return sizeof(prefix) + this->name.size() + sizeof(balance_label) + Money::max_chars 
+    + sizeof(int_rate_label) + Money::max_chars 
+    + sizeof(num_withdrawls_label) + max_int_chars + sizeof(suffix);
 }
 
-bool Trust_account::withdraw(double amount) 
+char *Trust_account::format(char *buff) const 
 {
-  if (this->num_withdrawls >= this->max_withdrawls || amount > this->balance * this->max_withdraw_percent)
-    return false;
-
-  this->num_withdrawls++;
-  return Saving_account::withdraw(amount);
-}
-
-void Trust_account::print(std::ostream &os) const 
-{
-  std::cout << std::fixed << std::setprecision(2);
-  os << "Trust_account: { name: " << this->name 
-    << ", balance: " << this->balance 
-    << ", int_rate: " << this->int_rate
-    << ", num_withdrawls: " << this->num_withdrawls << " }";
+  buff = put(buff, prefix, sizeof(prefix) - 1);
+  buff = put(buff, this->name.data(), this->name.size());
+  buff = put(buff, balance_label, sizeof(balance_label) - 1);
+  buff = this->balance.format(buff);
+  buff = put(buff, int_rate_label, sizeof(int_rate_label) - 1);
+  buff = Money {this->int_rate}.format(buff);
+  buff = put(buff, num_withdrawls_label, sizeof(num_withdrawls_label) - 1);
+  buff = std::to_chars(buff, buff + max_int_chars, this->num_withdrawls).ptr;
+  return put(buff, suffix, sizeof(suffix) - 1);
 }
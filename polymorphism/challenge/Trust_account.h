@@ -7,28 +7,58 @@
 
 class Trust_account final: public Saving_account
 {
+  friend class Account_store;
+  friend struct Account_policy;
+  friend struct Account_log;
+  friend class Shared_ledger;
+
 private:
   static constexpr const char *def_name = "Unnamed trust account";
-  static constexpr double def_balance = 0.0;
+  static constexpr Money def_balance = 0.0;
   static constexpr double def_int_rate = 0.0;
-  static constexpr double bonus_amount = 50.0;
-  static constexpr double bonus_threshold = 5000.0;
+  static constexpr Money bonus_amount = 50.0;
+  static constexpr Money bonus_threshold = 5000.0;
   static constexpr int max_withdrawls = 3;
   static constexpr double max_withdraw_percent = 0.2;
+  static constexpr char prefix[] = "Trust_account: { name: ";
+  static constexpr char balance_label[] = ", balance: ";
+  static constexpr char int_rate_label[] = ", int_rate: ";
+  static constexpr char num_withdrawls_label[] = ", num_withdrawls: ";
+  static constexpr char suffix[] = " }";
+  static constexpr std::size_t max_int_chars = 11;
 
 protected:
   int num_withdrawls;
 
 public:
   Trust_account(const std::string name = def_name, 
-    const double balance = def_balance, 
+    const Money balance = def_balance, 
     const double int_rate = def_int_rate);
 
   virtual ~Trust_account() = default;
 
-  virtual bool deposit(double amount) override;
-  virtual bool withdraw(double amount) override;
-  virtual void print(std::ostream &os) const override;
+  virtual bool deposit(Money amount) override;
+  virtual bool withdraw(Money amount) override;
+  virtual std::size_t format_size() const override;
+  virtual char *format(char *buff) const override;
 };
 
+inline bool Trust_account::deposit(Money amount)
+{
+  if (amount >= this->bonus_threshold)
+    amount += this->bonus_amount;
+  
+  return Saving_account::deposit(amount);
+}
+
+inline bool Trust_account::withdraw(Money amount)
+{
+  if (this->num_withdrawls >= this->max_withdrawls || amount > this->balance * this->max_withdraw_percent)
+    return false;
+
+  this->num_withdrawls++;
+  this->version++;
+  return Saving_account::withdraw(amount);
+}
+
 #endif
@@ -1,14 +1,134 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "Account.h"
 #include "Saving_account.h"
 #include "Checking_account.h"
 #include "Trust_account.h"
 #include "Account_util.h"
+#include "Account_pages.h"
+#include "Account_layout.h"
+#include "Transaction.h"
+#include "Account_store.h"
+#include "Account_rules.h"
+#include "Compound_interest.h"
+#include "Account_records.h"
+#include "Concurrent_ledger.h"
+#include "Numa_ledger.h"
+#include "Journal.h"
+#include "Account_arena.h"
+#include "Account_index.h"
+#include "Account_variant.h"
+#include "Poly_collection.h"
+#include "Snapshot_ledger.h"
+#include "Checkpoint.h"
+#include "Hash_ring.h"
+#include "Ledger_node.h"
+#include "Ledger_client.h"
+#include "Account_batch.h"
+#include "Shared_ledger.h"
+#include <sys/wait.h>
+#include <unistd.h>
 
-int main()
+/*
+
+  ./a.out                                          the accounts, the stores and the ledgers, one after the other
+  ./a.out --batch accounts.csv transactions.csv    the transactions of the file on the accounts of the other one,
+                                                   see Account_batch.h, tooling/datasets writes both
+  ./a.out --shared-serve name                      a ledger of 1000 accounts in the shared memory segment /name,
+                                                   served until --shared-stop, see Shared_ledger.h
+  ./a.out --shared-ingest name count               count deposits and withdrawals submitted to it from this process
+  ./a.out --shared-display name                    the accounts of it, read while it is served
+  ./a.out --shared-stop name
+
+*/
+int run_batch(const std::string &accounts_path, const std::string &transactions_path)
 {
+  try {
+    Account_store store;
+    const std::size_t num_accounts = load_accounts(accounts_path, store);
+    const Batch_report report = run_transactions(transactions_path, store);
+    std::cout << num_accounts << " accounts, " << report.num_transactions << " transactions, " << report.deposits 
+      << " deposits, " << report.withdrawals << " withdrawals, " << report.refused << " refused, total of the balances " 
+      << report.total_balance << std::endl;
+  }
+  catch (const std::runtime_error &error) {
+    std::cout << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int run_shared(const std::string &mode, const std::string &name, std::size_t count)
+{
+  try {
+    if (mode == "--shared-serve") {
+      std::vector<std::unique_ptr<Account>> owned;
+      std::vector<Account*> accounts;
+      for (int i {0}; i < 1000; i++) {
+        if (i % 3 == 0)
+          owned.push_back(std::make_unique<Checking_account>("Checking " + std::to_string(i), 500));
+        else if (i % 3 == 1)
+          owned.push_back(std::make_unique<Saving_account>("Saving " + std::to_string(i), 1000, 2.0));
+        else
+          owned.push_back(std::make_unique<Trust_account>("Trust " + std::to_string(i), 9000, 1.0));
+        accounts.push_back(owned.back().get());
+      }
+      Shared_ledger ledger {name, accounts};
+      std::cout << "serving " << ledger.size() << " accounts in /" << name << std::endl;
+      std::cout << ledger.serve() << " requests applied" << std::endl;
+      return 0;
+    }
+
+    Shared_ledger ledger {name};
+    if (mode == "--shared-ingest") {
+      Shared_ledger::Client client {ledger};
+      std::vector<std::uint32_t> tickets;
+      std::size_t accepted {0};
+      for (std::size_t i {0}; i < count; i++) {
+        tickets.push_back(client.submit({i * 7 % ledger.size(), i % 3 == 0 ? Operation::Withdraw : Operation::Deposit,
+          static_cast<double>(i % 40)}));
+        // the replies of a full mailbox are read before the next requests
+        if (tickets.size() == Shared_ledger::reply_capacity || i + 1 == count) {
+          for (std::uint32_t ticket: tickets)
+            accepted += client.wait(ticket).accepted;
+          tickets.clear();
+        }
+      }
+      std::cout << accepted << " of " << count << " requests accepted" << std::endl;
+    }
+    else if (mode == "--shared-display") {
+      std::vector<std::unique_ptr<Account>> owned = ledger.accounts();
+      std::vector<Account*> accounts;
+      for (const auto &account: owned)
+        accounts.push_back(account.get());
+      display_bulk(accounts);
+    }
+    else
+      ledger.stop();
+  }
+  catch (const std::exception &error) {
+    std::cout << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc == 4 && std::string {argv[1]} == "--batch")
+    return run_batch(argv[2], argv[3]);
+  if (argc >= 3 && std::string {argv[1]}.rfind("--shared-", 0) == 0)
+    return run_shared(argv[1], argv[2], argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0);
+
   Account *ptr1 = new Saving_account();
   Account *ptr2 = new Saving_account("Superman");
   Account *ptr3 = new Saving_account("Batman", 2000);
@@ -60,5 +180,420 @@ int main()
   delete ptr11;
   delete ptr12;
 
+  Account *ptr13 = new Saving_account("Clark", 1000, 2.0);
+  Account *ptr14 = new Checking_account("Bruce", 500);
+  Account *ptr15 = new Trust_account("Diana", 8000, 1.0);
+
+  std::vector<Account*> ledger {ptr13, ptr14, ptr15};
+  std::vector<Transaction> transactions {
+    {0, Operation::Deposit, 100},
+    {1, Operation::Withdraw, 600},
+    {2, Operation::Deposit, 5000},
+    {2, Operation::Withdraw, 1000},
+    {1, Operation::Withdraw, 100},
+    {3, Operation::Deposit, 10}
+  };
+
+  Account_index names {ledger};
+  transactions.push_back({names.find("Bruce"), Operation::Deposit, 25});
+
+  std::vector<bool> results = apply_transactions(ledger, transactions);
+  report(ledger, transactions, results);
+
+  Account_store store;
+  store.load(ledger);
+  std::cout << store.deposit(1000) << " of " << store.size() << " deposits applied" << std::endl;
+  std::cout << store.withdraw(1500) << " of " << store.size() << " withdrawals applied" << std::endl;
+  Account_store::Accrual_result accrual = store.accrue_interest();
+  std::cout << "Interest paid " << accrual.interest << ", " << accrual.trust_crossed 
+    << " trust accounts reached the bonus threshold" << std::endl;
+  std::cout << "Total of the balances " << store.get_total_balance() << std::endl;
+  store.sync();
+  display(ledger);
+
+  // the rules of the classes as data, and a product that has no class, an overdraft of 500
+  {
+    Account_rules rules;
+    const Account_rules::Product checking = rules.add_product(Account_policy::checking());
+    const Account_rules::Product trust = rules.add_product(Account_policy::trust());
+    Account_policy overdraft = Account_policy::checking();
+    overdraft.product = "overdraft";
+    overdraft.withdraw_fee = 2.50;
+    overdraft.min_balance = -500.0;
+    const Account_rules::Product overdrawn = rules.add_product(overdraft);
+    rules.add(checking, "Kirk", 400);
+    rules.add(trust, "Spock", 1000, 4.0);
+    rules.add(overdrawn, "Scotty", 100);
+
+    std::vector<std::uint8_t> violations;
+    rules.check_withdraw(300, violations);
+    for (std::size_t i {0}; i < rules.size(); i++)
+      std::cout << rules.get_policy(rules.get_product(i)).product << ": a withdrawal of 300 "
+        << (violations[i] == 0 ? "is allowed" : "breaks rules " + std::to_string(violations[i])) << std::endl;
+    std::cout << rules.withdraw(300) << " of " << rules.size() << " withdrawals applied, total "
+      << rules.get_total_balance() << std::endl;
+  }
+
+  // a page of the ledger, only its rows are formatted, and again only the one that changed
+  {
+    Account_pages pages {ledger};
+    pages.display(1, 3);
+    ledger[2]->deposit(10);
+    pages.display(1, 3);
+    std::cout << pages.get_num_formatted() << " rows formatted for two pages of " << ledger.size() << " accounts" << std::endl;
+  }
+
+  // ten years of daily interest backdated, one step, against a period at a time
+  {
+    Account_store daily, backdated;
+    for (Account_store *target: {&daily, &backdated}) {
+      target->add_saving("Daily saver", 10, 0.01);
+      target->add_saving("Big saver", 250000, 0.02);
+      target->add_trust("Daily trust", 4000, 0.01);
+    }
+    for (int day {0}; day < 3650; day++)
+      daily.accrue_interest();
+    Compound_interest engine;
+    Account_store::Accrual_result compounded = backdated.compound_interest(3650, engine);
+    std::cout << "3650 daily periods: " << daily.get_total_balance() << " a period at a time, " 
+      << backdated.get_total_balance() << " compounded, " << compounded.trust_crossed 
+      << " trust accounts reached the bonus threshold" << std::endl;
+  }
+
+  // an export of accounts, loaded straight into a store
+  std::string records {
+    "type,name,balance,int_rate,num_withdrawls\n"
+    "checking,Jack,1200.50,,\n"
+    "saving,\"Wayne, Bruce\",3000,2.5,\n"
+    "trust,Diana,60000,1.0,1\r\n"};
+  Account_store exported;
+  std::cout << load_accounts(exported, records) << " accounts loaded, total of the balances " 
+    << exported.get_total_balance() << std::endl;
+
+  // four threads race for the same trust account, its withdraw limit must still hold
+  Concurrent_ledger concurrent {ledger};
+  std::atomic<int> passed {0};
+  std::vector<std::thread> threads;
+  for (int i {0}; i < 4; i++)
+    threads.emplace_back([&]() {
+      for (int j {0}; j < 10; j++)
+        passed += concurrent.withdraw(2, 10);
+    });
+  for (auto &thread: threads)
+    thread.join();
+  std::cout << passed << " concurrent trust withdrawals passed" << std::endl;
+  std::cout << concurrent.deposit_all(100) << " of " << concurrent.size() << " parallel deposits applied" << std::endl;
+  display(ledger);
+
+  // the shards of two nodes, each built and run by a worker of its node, a batch routed to them
+  {
+    Numa_ledger shards {Numa_ledger::Topology::split(2), 2};
+    shards.build(1000, [](std::size_t id, Account_store &store) {
+      store.add_checking("Account " + std::to_string(id), 100);
+    });
+    std::vector<Transaction> batch;
+    for (std::size_t id {0}; id < 1000; id++)
+      batch.push_back({id, id % 2 == 0 ? Operation::Deposit : Operation::Withdraw, 50});
+    std::cout << shards.apply(batch) << " of " << batch.size() << " transactions accepted by " 
+      << shards.get_num_shards() << " shards on " << shards.get_num_nodes() << " nodes, total of the balances " 
+      << shards.get_total_balance() << std::endl;
+  }
+
+  // journal the batch, then rebuild fresh accounts from it as a restart would
+  {
+    Journal journal {"ledger.journal", 4};
+    for (const auto &t: transactions)
+      journal.append(t);
+  }
+
+  Account *ptr16 = new Saving_account("Clark", 1000, 2.0);
+  Account *ptr17 = new Checking_account("Bruce", 500);
+  Account *ptr18 = new Trust_account("Diana", 8000, 1.0);
+
+  std::vector<Account*> restored {ptr16, ptr17, ptr18};
+  std::cout << Journal::replay("ledger.journal", restored) << " journal records replayed" << std::endl;
+  display_bulk(restored);
+
+  // the same records in the order of the accounts, the same balances
+  {
+    Saving_account clark {"Clark", 1000, 2.0};
+    Checking_account bruce {"Bruce", 500};
+    Trust_account diana {"Diana", 8000, 1.0};
+    std::vector<Account*> sorted {&clark, &bruce, &diana};
+    Journal::replay_sorted("ledger.journal", sorted);
+    bool same {true};
+    for (std::size_t i {0}; i < sorted.size(); i++)
+      same = same && sorted[i]->get_balance() == restored[i]->get_balance();
+    std::cout << "replayed in the order of the accounts, the same balances: " << (same ? "yes" : "no") << std::endl;
+  }
+  std::remove("ledger.journal");
+
+  delete ptr16;
+  delete ptr17;
+  delete ptr18;
+
+  // checkpoint while the transactions go on, a restart loads it and replays the journal tail only
+  {
+    Account_store live;
+    Checkpoint::reserve(live, 334, 333, 333);
+    for (int i {0}; i < 1000; i++)
+      if (i % 3 == 0)
+        live.add_checking("Checking " + std::to_string(i), 500);
+      else if (i % 3 == 1)
+        live.add_saving("Saving " + std::to_string(i), 1000, 2.0);
+      else
+        live.add_trust("Trust " + std::to_string(i), 9000, 1.0);
+
+    std::size_t tail {0};
+    {
+      Journal journal {"live.journal"};
+      std::uint64_t checkpoint_size {0};
+      for (std::size_t i {0}; i < 20000; i++) {
+        const Transaction t {i * 7 % 1000, i % 3 == 0 ? Operation::Withdraw : Operation::Deposit, 
+          static_cast<double>(i % 40)};
+        live.apply(t);
+        journal.append(t);
+        if (i == 15000) {
+          Checkpoint checkpoint {"live.checkpoint", live, journal};
+          std::cout << "checkpoint at record " << checkpoint.get_journal_size() << ", transactions paused for " 
+            << static_cast<long>(checkpoint.get_pause_us()) << " us" << std::endl;
+          checkpoint_size = checkpoint.get_journal_size();
+          if (!checkpoint.wait())
+            std::cout << "checkpoint failed" << std::endl;
+        }
+      }
+      tail = journal.size() - checkpoint_size;
+    }
+
+    Account_store recovered;
+    const std::uint64_t from = Checkpoint::restore("live.checkpoint", recovered);
+    Journal::replay("live.journal", recovered, from);
+    std::cout << "restored " << recovered.size() << " accounts and replayed " << tail << " records, balances " 
+      << (recovered.get_total_balance() == live.get_total_balance() ? "match" : "differ") << std::endl;
+    std::remove("live.journal");
+    std::remove("live.checkpoint");
+  }
+
+  // at most 1000 and 3 withdrawals a day from every account, the windows go into the checkpoint
+  // and the records after it move them on
+  {
+    constexpr std::int64_t hour {3600};
+    constexpr std::int64_t start {1700000000};
+    Account_store limited;
+    for (int i {0}; i < 3; i++)
+      limited.add_checking("Limited " + std::to_string(i), 5000);
+    limited.set_withdrawal_limit(1000, 3, 24 * hour);
+
+    {
+      Journal journal {"limits.journal"};
+      for (std::size_t i {0}; i < 40; i++) {
+        const std::int64_t time {start + static_cast<std::int64_t>(i) * 2 * hour};
+        const Transaction t {i % 3, Operation::Withdraw, static_cast<double>(100 + i * 10)};
+        const bool ok = limited.apply(t, time);
+        journal.append(t, time);
+        if (i < 12 && (i < 3 || !ok))
+          std::cout << "hour " << i * 2 << ": " << t.amount << " from Limited " << t.account_id 
+            << (ok ? " accepted, " : " refused, ") << limited.get_withdrawn(t.account_id, time) 
+            << " withdrawn in the last day" << std::endl;
+        if (i == 25) {
+          Checkpoint checkpoint {"limits.checkpoint", limited, journal};
+          if (!checkpoint.wait())
+            std::cout << "checkpoint failed" << std::endl;
+        }
+      }
+    }
+
+    Account_store recovered;
+    Journal::replay("limits.journal", recovered, Checkpoint::restore("limits.checkpoint", recovered));
+    bool same {recovered.get_total_balance() == limited.get_total_balance()};
+    for (std::size_t id {0}; id < 3; id++)
+      same = same && recovered.get_withdrawn(id, start + 80 * hour) == limited.get_withdrawn(id, start + 80 * hour);
+    std::cout << "restored the windows with the balances, the same withdrawals in the last day: " 
+      << (same ? "yes" : "no") << std::endl;
+    std::remove("limits.journal");
+    std::remove("limits.checkpoint");
+  }
+
+  // the second batch reuses the blocks of the first one
+  Account_arena arena {2};
+  for (int batch {1}; batch <= 2; batch++) {
+    arena.make_checking("Larry", 100);
+    arena.make_saving("Curly", 200, 3.0);
+    arena.make_saving("Shemp", 300, 3.0);
+    arena.make_trust("Moe", 6000, 1.0);
+
+    std::vector<Account*> arena_accounts = arena.accounts();
+    deposit(arena_accounts, 50);
+    std::cout << "batch " << batch << ": " << arena.size() << " accounts, " 
+      << arena.get_block_allocations() << " block allocations" << std::endl;
+    arena.clear();
+  }
+
+  // the same accounts by value, the deposits are direct calls, no vtable
+  std::vector<Any_account> by_value {
+    Checking_account {"Larry", 100}, Saving_account {"Curly", 200, 3.0}, Trust_account {"Moe", 6000, 1.0}
+  };
+  std::cout << deposit(by_value, 5000) << " deposits, " << withdraw(by_value, 1000) << " withdrawals" << std::endl;
+  for (const Any_account &account : by_value)
+    std::cout << account << std::endl;
+
+  Account_batches batches;
+  for (Any_account &account : by_value)
+    batches.add(std::move(account));
+  batches.add(Checking_account {"Shemp", 300});
+  batches.deposit(100);
+  std::cout << batches.size() << " accounts in batches, total balance " << batches.total_balance() << std::endl;
+  std::vector<Account*> batch_accounts = batches.accounts();
+  display_bulk(batch_accounts);
+
+  // inserted mixed, kept one segment per class
+  Poly_collection<Account> collection;
+  collection.insert(Trust_account {"Diana", 8000, 1.0});
+  collection.insert(Checking_account {"Bruce", 500});
+  collection.insert(Saving_account {"Clark", 1000, 2.0});
+  collection.insert(Checking_account {"Barry", 700});
+  collection.for_each([](Account &account) { account.deposit(100); });
+  collection.for_each<Checking_account, Saving_account>([](auto &account) {
+    using Type = std::decay_t<decltype(account)>;
+    account.Type::withdraw(50);
+  });
+  std::cout << collection.size() << " accounts in " << collection.segment_count() << " segments" << std::endl;
+  collection.for_each([](const Account &account) { std::cout << account << std::endl; });
+
+  // the accounts spread over four nodes, two clients transfer between them at the same time
+  {
+    Hash_ring ring {4};
+    std::vector<Ledger_node> nodes(4);
+    for (std::uint64_t id {0}; id < 2000; id++)
+      nodes[ring.node_of(id)].add_saving(id, "Partitioned " + std::to_string(id), 100, 0.0);
+    auto connect_all = [&nodes]() {
+      std::vector<int> connections;
+      for (auto &node: nodes)
+        connections.push_back(node.connect());
+      return connections;
+    };
+
+    Ledger_client client {ring, connect_all()};
+    for (std::uint64_t id {0}; id < 2000; id++)
+      client.submit(Transaction {id, Operation::Deposit, 1});
+    client.flush();
+    std::size_t pipelined {0};
+    for (std::size_t ticket {0}; ticket < 2000; ticket++)
+      pipelined += client.get_result(ticket).accepted;
+
+    std::size_t committed[2] {0, 0};
+    std::thread other {[&]() {
+      Ledger_client second {ring, connect_all()};
+      for (std::uint64_t i {0}; i < 1000; i++)
+        committed[1] += second.transfer(i * 13 % 2000, i * 29 % 2000, static_cast<double>(i % 150));
+    }};
+    for (std::uint64_t i {0}; i < 1000; i++)
+      committed[0] += client.transfer(i * 7 % 2000, i * 11 % 2000, static_cast<double>(i % 150));
+    other.join();
+
+    Money total {0.0};
+    for (auto &node: nodes)
+      total += node.get_total_balance();
+    std::cout << pipelined << " pipelined deposits, " << committed[0] + committed[1] << " of 2000 transfers committed, "
+      << "nodes of " << nodes[0].size() << ", " << nodes[1].size() << ", " << nodes[2].size() << ", " << nodes[3].size()
+      << " accounts, total " << total << std::endl;
+
+    Hash_ring grown {4};
+    grown.add_node();
+    std::size_t moved {0};
+    for (std::uint64_t id {0}; id < 2000; id++)
+      moved += grown.node_of(id) != ring.node_of(id);
+    std::cout << "a fifth node takes " << moved << " of the 2000 accounts" << std::endl;
+  }
+
+  // a report reads one snapshot while the transfers go on, its total never moves
+  std::vector<Any_account> live;
+  for (int i {0}; i < 64; i++)
+    live.push_back(Saving_account {"Saver " + std::to_string(i), 1000, 0.0});
+  Snapshot_ledger snapshots {std::move(live)};
+  std::atomic<bool> reporting {true};
+  std::thread transfers {[&snapshots, &reporting]() {
+    std::size_t done {0};
+    for (std::size_t i {0}; reporting.load(); i++) {
+      done += snapshots.transfer(i * 7 % 64, i * 13 % 64, static_cast<Money>(i % 50));
+      if (i % 64 == 0)
+        std::this_thread::yield();
+    }
+    std::cout << done << " transfers during the reports" << std::endl;
+  }};
+  {
+    Snapshot_ledger::Snapshot month_end {snapshots.snapshot()};
+    const Money month_end_total = month_end.get_total_balance();
+    std::size_t consistent {0};
+    for (int report {0}; report < 200; report++) {
+      Snapshot_ledger::Snapshot daily {snapshots.snapshot()};
+      consistent += daily.get_total_balance() == 64000 && month_end.get_total_balance() == month_end_total;
+      std::this_thread::yield();
+    }
+    reporting.store(false);
+    transfers.join();
+    std::cout << consistent << " of 200 reports consistent, month end at epoch " << month_end.get_epoch()
+      << ", " << snapshots.get_num_versions() << " versions kept" << std::endl;
+  }
+  // the next write to a chunk drops what only the report saw
+  for (std::size_t id {0}; id < snapshots.size(); id += 8)
+    snapshots.deposit(id, 1);
+  std::cout << snapshots.get_num_versions() << " versions once the report is done, Saver 0 has "
+    << snapshots.get_balance(0) << std::endl;
+
+  // the same accounts packed, the hot fields 4 to a cache line, the names in a side table
+  record_layout::print(std::cout, trust_account_layout);
+  record_layout::print(std::cout, hot_account_layout);
+  record_layout::print(std::cout, cold_account_layout);
+  Split_accounts split;
+  split.add(Account_store::Type::Trust, "Athos of the first trust fund", 10000, 3.0);
+  split.add(Account_store::Type::Trust, "Porthos of the second trust fund", 20000, 3.5, 1);
+  split.add(Account_store::Type::Saving, "Aramis", 30000, 2.0);
+  std::cout << split.get_name(1) << " has " << Money::from_cents(split.get_hot(1).cents) << ", "
+    << hot_account_layout.size + cold_account_layout.size << " bytes an account and the chars of its name, against "
+    << sizeof(Trust_account) + sizeof(Account*) << " and a block for a name of more than 15 chars" << std::endl;
+
+  // the ledger in shared memory, another process deposits to it while this one serves
+  {
+    Shared_ledger shared {"basics_challenge_ledger", ledger};
+    const pid_t child = ::fork();
+    if (child == 0) {
+      int status {1};
+      try {
+        Shared_ledger opened {"basics_challenge_ledger"};
+        Shared_ledger::Client client {opened};
+        bool accepted {true};
+        for (int i {0}; i < 300; i++)
+          accepted = client.apply({static_cast<std::size_t>(i % 3), Operation::Deposit, 1}).accepted && accepted;
+        status = accepted && client.apply({1, Operation::Withdraw, 100000}).accepted == false ? 0 : 1;
+        opened.stop();
+      }
+      catch (const std::exception &ex) {
+        // the mapping of the parent's ledger is the same segment in the child, stopped through
+        // it the parent's serve returns, even when the child could not open one of its own
+        std::cerr << ex.what() << std::endl;
+        shared.stop();
+      }
+      // no destructor of the parent's objects runs in the child
+      ::_exit(status);
+    }
+    if (child < 0)
+      std::cout << "fork failed, no second process" << std::endl;
+    else {
+      const std::size_t applied = shared.serve();
+      int status {1};
+      ::waitpid(child, &status, 0);
+      std::cout << applied << " requests of another process applied through shared memory, "
+        << (WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "all as expected" : "not as expected") << std::endl;
+      std::vector<std::unique_ptr<Account>> owned = shared.accounts();
+      for (const auto &account: owned)
+        std::cout << *account << std::endl;
+    }
+  }
+
+  delete ptr13;
+  delete ptr14;
+  delete ptr15;
+
   return 0;
 }
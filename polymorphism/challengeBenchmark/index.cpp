@@ -0,0 +1,88 @@
+/*
+
+  - compares finding an account by name with Account_index against a linear scan
+    of the accounts vector.
+
+  - build it together with the challenge sources:
+      g++ -std=c++17 -O2 index.cpp ../challenge/Account.cpp ../challenge/Account_index.cpp 
+        ../challenge/Checking_account.cpp ../challenge/Saving_account.cpp 
+        ../challenge/Trust_account.cpp ../challenge/I_Printable.cpp
+
+  - the largest size can be lowered on the command line, e.g. ./a.out 100000
+
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../challenge/Account.h"
+#include "../challenge/Account_index.h"
+#include "../challenge/Checking_account.h"
+
+constexpr std::size_t num_lookups {1000};
+
+std::size_t linear_find(const std::vector<Account*> &accounts, const std::string &name)
+{
+  for (std::size_t id {0}; id < accounts.size(); id++)
+    if (accounts[id]->get_name() == name)
+      return id;
+  return Account_index::npos;
+}
+
+template<typename Fn>
+double measure_us(Fn fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void run(std::size_t size)
+{
+  std::vector<Checking_account> storage;
+  storage.reserve(size);
+  std::vector<Account*> accounts;
+  accounts.reserve(size);
+  for (std::size_t i {0}; i < size; i++) {
+    storage.emplace_back("customer" + std::to_string(i), 100.0);
+    accounts.push_back(&storage.back());
+  }
+
+  std::mt19937 gen {7};
+  std::uniform_int_distribution<std::size_t> pick {0, size - 1};
+  std::vector<std::string> names;
+  for (std::size_t i {0}; i < num_lookups; i++)
+    names.push_back("customer" + std::to_string(pick(gen)));
+
+  Account_index index {accounts};
+  std::size_t check_scan {0}, check_index {0};
+
+  // the scan is slow at the large sizes, so it only gets a tenth of the lookups there
+  const std::size_t scan_lookups = size > 1'000'000 ? num_lookups / 10 : num_lookups;
+  double scan = measure_us([&]() {
+    for (std::size_t i {0}; i < scan_lookups; i++)
+      check_scan += linear_find(accounts, names[i]);
+  }) / scan_lookups;
+  double hashed = measure_us([&]() {
+    for (std::size_t i {0}; i < num_lookups; i++)
+      check_index += index.find(names[i]);
+  }) / num_lookups;
+
+  std::cout << size << " accounts: scan " << scan << " us, index " << hashed 
+    << " us per lookup (" << scan / hashed << "x)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t max_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+  for (std::size_t size: {1'000ul, 100'000ul, 10'000'000ul})
+    if (size <= max_size)
+      run(size);
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+/*
+
+  - compares a deposit and a withdrawal on every account through Account*, the vtable,
+    against std::visit on a std::vector<Any_account>, the per type loops of
+    Account_batches and the segments of Poly_collection, with the accounts in the order of
+    their types, homogeneous, and shuffled, mixed. a Poly_collection sorts the mixed ones.
+
+  - build it together with the challenge sources:
+      g++ -std=c++17 -O2 index.cpp ../challenge/Account.cpp ../challenge/Account_arena.cpp 
+        ../challenge/Checking_account.cpp ../challenge/Saving_account.cpp 
+        ../challenge/Trust_account.cpp ../challenge/I_Printable.cpp
+
+  - the number of accounts can be lowered on the command line, e.g. ./a.out 100000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../challenge/Account.h"
+#include "../challenge/Account_arena.h"
+#include "../challenge/Account_variant.h"
+#include "../challenge/Poly_collection.h"
+
+constexpr int num_passes {5};
+
+template<typename Fn>
+double measure_ms(Fn fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void report(const std::string &name, double ms, std::size_t size, Money total)
+{
+  std::cout << std::setw(28) << std::left << name << std::setw(10) << std::right << std::fixed 
+    << std::setprecision(1) << ms << " ms, " << std::setprecision(2) << ms * 1e6 / (size * num_passes) 
+    << " ns per account, total " << total << std::endl;
+}
+
+// one type for every third account, the mixed order is a shuffle of them
+std::vector<int> make_kinds(std::size_t size, bool mixed)
+{
+  std::vector<int> kinds(size);
+  for (std::size_t i {0}; i < size; i++)
+    kinds[i] = static_cast<int>(i * 3 / size);
+  if (mixed)
+    std::shuffle(kinds.begin(), kinds.end(), std::mt19937 {7});
+  return kinds;
+}
+
+void run_virtual(std::size_t size, bool mixed)
+{
+  Account_arena arena {4096};
+  for (int kind : make_kinds(size, false)) {
+    if (kind == 0)
+      arena.make_checking("a", 100);
+    else if (kind == 1)
+      arena.make_saving("a", 100, 1.0);
+    else
+      arena.make_trust("a", 100, 1.0);
+  }
+  std::vector<Account*> accounts = arena.accounts();
+  if (mixed)
+    std::shuffle(accounts.begin(), accounts.end(), std::mt19937 {7});
+
+  double ms = measure_ms([&]() {
+    for (int pass {0}; pass < num_passes; pass++)
+    {
+      for (Account *account : accounts)
+        account->deposit(10);
+      for (Account *account : accounts)
+        account->withdraw(1);
+    }
+  });
+  Money total;
+  for (const Account *account : accounts)
+    total += account->get_balance();
+  report(mixed ? "Account*, mixed" : "Account*, homogeneous", ms, size, total);
+}
+
+void run_variant(std::size_t size, bool mixed)
+{
+  std::vector<Any_account> accounts;
+  accounts.reserve(size);
+  for (int kind : make_kinds(size, mixed)) {
+    if (kind == 0)
+      accounts.emplace_back(Checking_account {"a", 100});
+    else if (kind == 1)
+      accounts.emplace_back(Saving_account {"a", 100, 1.0});
+    else
+      accounts.emplace_back(Trust_account {"a", 100, 1.0});
+  }
+
+  double ms = measure_ms([&]() {
+    for (int pass {0}; pass < num_passes; pass++) {
+      deposit(accounts, 10);
+      withdraw(accounts, 1);
+    }
+  });
+  Money total;
+  for (const Any_account &account : accounts)
+    total += as_account(account).get_balance();
+  report(mixed ? "std::variant, mixed" : "std::variant, homogeneous", ms, size, total);
+}
+
+void run_batches(std::size_t size)
+{
+  Account_batches batches;
+  batches.reserve(size / 3 + 1, size / 3 + 1, size / 3 + 1);
+  for (int kind : make_kinds(size, false)) {
+    if (kind == 0)
+      batches.add(Checking_account {"a", 100});
+    else if (kind == 1)
+      batches.add(Saving_account {"a", 100, 1.0});
+    else
+      batches.add(Trust_account {"a", 100, 1.0});
+  }
+
+  double ms = measure_ms([&]() {
+    for (int pass {0}; pass < num_passes; pass++) {
+      batches.deposit(10);
+      batches.withdraw(1);
+    }
+  });
+  report("Account_batches", ms, size, batches.total_balance());
+}
+
+// inserted in the mixed order, Account& calls the vtable, the per type visitor does not
+void run_collection(std::size_t size, bool per_type)
+{
+  Poly_collection<Account> collection;
+  collection.reserve<Checking_account>(size / 3 + 1);
+  collection.reserve<Saving_account>(size / 3 + 1);
+  collection.reserve<Trust_account>(size / 3 + 1);
+  for (int kind : make_kinds(size, true)) {
+    if (kind == 0)
+      collection.insert(Checking_account {"a", 100});
+    else if (kind == 1)
+      collection.insert(Saving_account {"a", 100, 1.0});
+    else
+      collection.insert(Trust_account {"a", 100, 1.0});
+  }
+
+  double ms = measure_ms([&]() {
+    for (int pass {0}; pass < num_passes; pass++) {
+      if (per_type) {
+        collection.for_each<Checking_account, Saving_account, Trust_account>([](auto &a) {
+          detail_account_variant::deposit(a, 10);
+        });
+        collection.for_each<Checking_account, Saving_account, Trust_account>([](auto &a) {
+          detail_account_variant::withdraw(a, 1);
+        });
+      }
+      else {
+        collection.for_each([](Account &a) { a.deposit(10); });
+        collection.for_each([](Account &a) { a.withdraw(1); });
+      }
+    }
+  });
+  Money total;
+  collection.for_each([&total](const Account &a) { total += a.get_balance(); });
+  report(per_type ? "Poly_collection, per type" : "Poly_collection, Account&", ms, size, total);
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  std::cout << size << " accounts, " << num_passes << " passes of a deposit and a withdrawal" << std::endl;
+
+  run_virtual(size, false);
+  run_variant(size, false);
+  run_batches(size);
+  run_virtual(size, true);
+  run_variant(size, true);
+  run_collection(size, false);
+  run_collection(size, true);
+
+  return 0;
+}
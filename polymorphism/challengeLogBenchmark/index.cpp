@@ -0,0 +1,196 @@
+/*
+
+  - the lines of deposit and withdraw of Account_util, "Deposited 100.00 to Saving_account:
+    { ... }" for every account, 12 accounts of the three classes and 200000 operations by
+    default, written to a file: the way they were, operator<< and std::endl a line, then
+    with '\n', then through a binary_log::Logger (../../tooling/binaryLog/Binary_log.h),
+    the text sink and the binary one, whose file is decoded afterwards.
+
+  - the files of the logger and the decoded binary file have to be the one of std::endl,
+    byte for byte, a mismatch is reported and the exit code is 1.
+
+  - build it together with the challenge sources:
+      g++ -std=c++17 -O2 -pthread index.cpp ../challenge/Account_util.cpp ../challenge/Account_log.cpp
+        ../challenge/Account.cpp ../challenge/Checking_account.cpp ../challenge/Saving_account.cpp
+        ../challenge/Trust_account.cpp ../challenge/I_Printable.cpp
+
+  - the number of operations can be given on the command line, e.g. ./a.out 1000000.
+
+  - on one core of an x86-64 at -O2, 200000 operations in bursts of 6144, ns an operation:
+                              the loop   until written
+      std::endl                  580
+      '\n'                       155
+      logger, text sink           55          190
+      logger, binary sink         50           80
+    std::endl is a write system call a line, '\n' is the formatting of operator<< alone.
+    the loop of the logger is the operation and a record of 61 bytes on average in the
+    ring of the thread, the lines are made by the thread of the logger, on the same core
+    here, when the burst is flushed. the binary sink only copies the records, the decode
+    makes the lines later, 285 ns a line.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../challenge/Account_log.h"
+#include "../challenge/Account_util.h"
+#include "../challenge/Checking_account.h"
+#include "../challenge/Saving_account.h"
+#include "../challenge/Trust_account.h"
+
+// deposit and withdraw of Account_util as they were
+void deposit_endl(std::vector<Account*> &accounts, Money amount, std::ostream &os)
+{
+  for (const auto &ptr: accounts)
+    if (ptr->deposit(amount))
+      os << "Deposited " << amount << " to " << *ptr << std::endl;
+    else
+      os << "Failed deposit of " << amount << " to " << *ptr << std::endl;
+}
+
+void withdraw_endl(std::vector<Account*> &accounts, Money amount, std::ostream &os)
+{
+  for (const auto &ptr: accounts)
+    if (ptr->withdraw(amount))
+      os << "Withdraw " << amount << " from " << *ptr << std::endl;
+    else
+      os << "Failed withdraw of " << amount << " from " << *ptr << std::endl;
+}
+
+void deposit_newline(std::vector<Account*> &accounts, Money amount, std::ostream &os)
+{
+  for (const auto &ptr: accounts)
+    if (ptr->deposit(amount))
+      os << "Deposited " << amount << " to " << *ptr << '\n';
+    else
+      os << "Failed deposit of " << amount << " to " << *ptr << '\n';
+}
+
+void withdraw_newline(std::vector<Account*> &accounts, Money amount, std::ostream &os)
+{
+  for (const auto &ptr: accounts)
+    if (ptr->withdraw(amount))
+      os << "Withdraw " << amount << " from " << *ptr << '\n';
+    else
+      os << "Failed withdraw of " << amount << " from " << *ptr << '\n';
+}
+
+std::vector<std::unique_ptr<Account>> make_accounts()
+{
+  std::vector<std::unique_ptr<Account>> accounts;
+  for (int i {0}; i < 4; i++) {
+    accounts.push_back(std::make_unique<Checking_account>("Checking " + std::to_string(i), 1000 * i));
+    accounts.push_back(std::make_unique<Saving_account>("Saving " + std::to_string(i), 2000 * i, 1.5 * i));
+    accounts.push_back(std::make_unique<Trust_account>("Trust " + std::to_string(i), 9000 * i, 2.0));
+  }
+  return accounts;
+}
+
+std::string read_file(const std::string &path)
+{
+  std::ifstream in {path, std::ios::binary};
+  return std::string {std::istreambuf_iterator<char> {in}, std::istreambuf_iterator<char> {}};
+}
+
+/*
+
+  - the same operations on new accounts, the amounts go up and down so both lines happen,
+    in bursts of burst_rounds, the loop of a burst is timed, then after_burst runs untimed,
+    a flush of the logger, a burst fits in its ring.
+
+*/
+constexpr std::size_t burst_rounds {512};
+
+template<typename Deposit, typename Withdraw, typename After_burst>
+double run_ns(std::size_t operations, Deposit deposit_fn, Withdraw withdraw_fn, After_burst after_burst)
+{
+  std::vector<std::unique_ptr<Account>> owned = make_accounts();
+  std::vector<Account*> accounts;
+  for (const auto &account: owned)
+    accounts.push_back(account.get());
+
+  const std::size_t rounds = operations / accounts.size() / 2;
+  std::chrono::duration<double, std::nano> elapsed {0};
+  for (std::size_t from {0}; from < rounds; from += burst_rounds) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t round {from}; round < rounds && round < from + burst_rounds; round++) {
+      deposit_fn(accounts, Money {static_cast<double>(round % 7) * 100});
+      withdraw_fn(accounts, Money {static_cast<double>(round % 5) * 150});
+    }
+    elapsed += std::chrono::steady_clock::now() - start;
+    after_burst();
+  }
+  return elapsed.count() / static_cast<double>(rounds * accounts.size() * 2);
+}
+
+int main(int argc, char *argv[])
+{
+  const long operations_arg = argc > 1 ? std::atol(argv[1]) : 200000;
+  const std::size_t operations = operations_arg > 24 ? static_cast<std::size_t>(operations_arg) : 24;
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string endl_path = (dir / "challenge_log_endl.txt").string();
+  const std::string newline_path = (dir / "challenge_log_newline.txt").string();
+  const std::string text_path = (dir / "challenge_log_text.txt").string();
+  const std::string binary_path = (dir / "challenge_log.bin").string();
+
+  std::cout << operations << " operations, ns an operation:" << std::endl;
+  std::cout << std::setw(24) << "" << "the loop  until written" << std::endl << std::fixed << std::setprecision(0);
+
+  {
+    std::ofstream out {endl_path, std::ios::binary};
+    std::cout << std::setw(24) << std::left << "std::endl" << std::right << std::setw(8) << run_ns(operations,
+      [&out](std::vector<Account*> &accounts, Money amount) { deposit_endl(accounts, amount, out); },
+      [&out](std::vector<Account*> &accounts, Money amount) { withdraw_endl(accounts, amount, out); }, [] {}) << std::endl;
+  }
+  {
+    std::ofstream out {newline_path, std::ios::binary};
+    std::cout << std::setw(24) << std::left << "'\\n'" << std::right << std::setw(8) << run_ns(operations,
+      [&out](std::vector<Account*> &accounts, Money amount) { deposit_newline(accounts, amount, out); },
+      [&out](std::vector<Account*> &accounts, Money amount) { withdraw_newline(accounts, amount, out); }, [] {}) << std::endl;
+  }
+
+  for (binary_log::Sink sink: {binary_log::Sink::text, binary_log::Sink::binary}) {
+    std::ofstream out {sink == binary_log::Sink::text ? text_path : binary_path, std::ios::binary};
+    binary_log::Logger log {out, sink};
+    auto start = std::chrono::steady_clock::now();
+    const double loop = run_ns(operations,
+      [&log](std::vector<Account*> &accounts, Money amount) { deposit(accounts, amount, log); },
+      [&log](std::vector<Account*> &accounts, Money amount) { withdraw(accounts, amount, log); },
+      [&log] { log.flush(); });
+    log.flush();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::setw(24) << std::left << (sink == binary_log::Sink::text ? "logger, text sink" : "logger, binary sink")
+      << std::right << std::setw(8) << loop << std::setw(15) << elapsed.count() / static_cast<double>(log.get_records())
+      << "  " << log.get_waits() << " waits" << std::endl;
+  }
+
+  const std::string expected = read_file(endl_path);
+  std::ifstream binary_in {binary_path, std::ios::binary};
+  std::ostringstream decoded;
+  auto start = std::chrono::steady_clock::now();
+  const std::uint64_t lines = binary_log::decode(binary_in, decoded);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "decode " << std::filesystem::file_size(binary_path) / 1000 << " kB into " << lines << " lines, "
+    << elapsed.count() / static_cast<double>(lines) << " ns a line" << std::endl;
+
+  int mismatches {0};
+  mismatches += read_file(newline_path) != expected;
+  mismatches += read_file(text_path) != expected;
+  mismatches += decoded.str() != expected;
+  mismatches += expected.empty();
+  for (const std::string &path: {endl_path, newline_path, text_path, binary_path})
+    std::remove(path.c_str());
+
+  std::cout << "mismatches: " << mismatches << std::endl;
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/*
+
+  - the accounts of a Numa_ledger, a third of them of every class, with the three
+    placements of its shards: local, every shard built by its worker on its node,
+    interleaved, the pages spread round the nodes, and naive, every shard built by the
+    thread of main. the time to build them, a deposit_all and a withdraw_all of every
+    account 5 times, the scans of the arrays, and a batch of 4M transactions at random
+    accounts routed to the shards.
+
+  - the balances and the accepted counts of each placement are compared with the ones of
+    one Account_store that runs the same operations, a mismatch is reported and the exit
+    code is 1.
+
+  - build it together with the challenge sources:
+      g++ -std=c++17 -O2 -pthread index.cpp ../challenge/Numa_ledger.cpp ../challenge/Account_store.cpp
+        ../challenge/Compound_interest.cpp ../challenge/Account.cpp ../challenge/Checking_account.cpp
+        ../challenge/Saving_account.cpp ../challenge/Trust_account.cpp ../challenge/I_Printable.cpp
+
+  - the number of accounts can be given on the command line, 4M by default, e.g. ./a.out 100000,
+    and the number of nodes of a machine of one, 2 by default, the cores split into them.
+
+  - on one core of an x86-64 of one node at -O2, 4M accounts, 2 nodes split out of it:
+                        build       scans            batch
+      one Account_store             1.9 ns           141 ns per transaction
+      local             0.51 s      2.0 ns           171 ns
+      interleaved       0.59 s      1.8 ns           169 ns
+      naive             0.50 s      1.9 ns           162 ns
+    a machine of one node has all the pages in one memory, the three are the same within
+    the noise, and the batch through the shards costs the routing over one Account_store.
+    on a host of two sockets the workers of naive read the pages of the other node for half
+    of the shards, over the link between the sockets, the ones of interleaved half of the
+    pages of every shard, and the ones of local none, that is not measured here.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../challenge/Account_store.h"
+#include "../challenge/Numa_ledger.h"
+#include "../challenge/Transaction.h"
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void add_account(std::size_t id, Account_store &store)
+{
+  const Money balance = Money::from_cents(static_cast<std::int64_t>(id % 10000) * 100 + 5000);
+  switch (id % 3) {
+    case 0:
+      store.add_checking("Checking " + std::to_string(id), balance);
+      break;
+    case 1:
+      store.add_saving("Saving " + std::to_string(id), balance, 2.5);
+      break;
+    default:
+      store.add_trust("Trust " + std::to_string(id), balance, 1.0);
+  }
+}
+
+struct Result
+{
+  std::size_t accepted;
+  Money total;
+};
+
+template<typename Ledger>
+Result operate(Ledger &ledger, const std::vector<Transaction> &batch, double &scans, double &applied)
+{
+  std::size_t accepted {0};
+  auto start = std::chrono::steady_clock::now();
+  for (int i {0}; i < 5; i++) {
+    accepted += ledger.deposit_all(120);
+    accepted += ledger.withdraw_all(80);
+  }
+  scans = seconds_since(start);
+
+  start = std::chrono::steady_clock::now();
+  accepted += ledger.apply(batch);
+  applied = seconds_since(start);
+  return {accepted, ledger.get_total_balance()};
+}
+
+// the one Account_store, apply of a batch one transaction after the other
+struct Single_store
+{
+  Account_store store;
+
+  std::size_t deposit_all(Money amount) { return this->store.deposit(amount); }
+  std::size_t withdraw_all(Money amount) { return this->store.withdraw(amount); }
+  Money get_total_balance() const { return this->store.get_total_balance(); }
+
+  std::size_t apply(const std::vector<Transaction> &batch)
+  {
+    std::size_t accepted {0};
+    for (const Transaction &transaction: batch)
+      accepted += this->store.apply(transaction);
+    return accepted;
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4'000'000;
+  const std::size_t split = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+
+  std::mt19937_64 gen {11};
+  std::vector<Transaction> batch(4'000'000);
+  for (Transaction &transaction: batch)
+    transaction = {gen() % (n > 0 ? n : 1), gen() % 2 == 0 ? Operation::Deposit : Operation::Withdraw,
+      Money::from_cents(static_cast<std::int64_t>(gen() % 100000))};
+
+  double scans, applied;
+  Single_store single;
+  for (std::size_t id {0}; id < n; id++)
+    add_account(id, single.store);
+  const Result expected = operate(single, batch, scans, applied);
+
+  Numa_ledger::Topology topology = Numa_ledger::Topology::detect();
+  const bool is_split = topology.size() == 1;
+  if (is_split)
+    topology = Numa_ledger::Topology::split(split);
+  const std::size_t shards_per_node = std::max<std::size_t>(topology.cpus.front().size(), 1);
+
+  std::cout << n << " accounts, " << topology.size() << " nodes" << (is_split ? " split out of one" : "")
+    << ", " << shards_per_node << " shards a node" << std::endl;
+  std::cout << "one Account_store  scans " << scans * 1e9 / (10.0 * n) << " ns per account, batch "
+    << applied * 1e9 / batch.size() << " ns per transaction" << std::endl;
+
+  bool failed {false};
+  const std::pair<Numa_ledger::Placement, const char*> placements[] {
+    {Numa_ledger::Placement::local, "local"},
+    {Numa_ledger::Placement::interleaved, "interleaved"},
+    {Numa_ledger::Placement::naive, "naive"}};
+  for (const auto &[placement, name]: placements) {
+    Numa_ledger ledger {topology, shards_per_node, placement};
+    auto start = std::chrono::steady_clock::now();
+    ledger.build(n, add_account);
+    const double built = seconds_since(start);
+    const Result result = operate(ledger, batch, scans, applied);
+
+    if (result.accepted != expected.accepted || result.total.get_cents() != expected.total.get_cents()) {
+      std::cout << name << ": the shards are not the one Account_store" << std::endl;
+      failed = true;
+    }
+    std::cout << std::setw(12) << std::left << name << std::fixed << std::setprecision(2) << "build " << built
+      << " s, scans " << scans * 1e9 / (10.0 * n) << " ns per account, batch " << applied * 1e9 / batch.size()
+      << " ns per transaction" << std::endl;
+  }
+
+  return failed ? 1 : 0;
+}
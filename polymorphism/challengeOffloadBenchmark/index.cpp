@@ -0,0 +1,122 @@
+/*
+
+  - the kernels of the challenge that can run on a device (../../algorithms/parallelAlgorithms/Offload.h):
+    the interest accrual of Account_store and the masks of Account_rules::check_withdraw,
+    on the host, Target::host, then automatic, the device when there is one and there are
+    many accounts, and always the device, Target::device, whose target regions run on the
+    host when there is none.
+
+  - the balances, the interest and the trust accounts over the threshold after 12 accruals,
+    and the masks of withdrawals of a few amounts, have to be the ones of the host, cent for
+    cent, a few balances are out of the exact range so the host has its part on the device
+    path too. a mismatch is reported and the exit code is 1.
+
+  - build it together with the challenge sources:
+      g++ -std=c++17 -O2 -fopenmp -DBASICS_OFFLOAD index.cpp ../challenge/Account_rules.cpp
+        ../challenge/Account_store.cpp ../challenge/Compound_interest.cpp ../challenge/Account.cpp
+        ../challenge/Checking_account.cpp ../challenge/Saving_account.cpp ../challenge/Trust_account.cpp
+        ../challenge/I_Printable.cpp
+    or with -DBASICS_OFFLOAD=ON in CMake, without it every target is the host.
+
+  - the number of accounts can be given on the command line, 4M by default, e.g. ./a.out 1000000
+
+  - on one core of an x86-64 at -O2, 4M accounts, no device, ns an account:
+                          accrual   check_withdraw
+      host                  3.66         3.84
+      automatic             3.63         4.30
+      device                5.46         4.93
+    automatic stays on the host without a device. forced, the target regions run on the
+    host, a chunk a task, the marks of the accrual and the masks are buffers of their own,
+    the masks are scattered afterwards. on a GPU both are bound by the bus, the accrual
+    sends 16 bytes an account and gets 9 back.
+
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../challenge/Account_rules.h"
+#include "../challenge/Account_store.h"
+
+constexpr int num_periods {12};
+
+struct Run
+{
+  double accrual_ns;
+  double check_ns;
+  std::vector<Money> balances;
+  std::vector<Money> interest;
+  std::vector<std::size_t> crossed;
+  std::vector<std::uint8_t> masks;
+};
+
+Run run(std::size_t num_accounts, offload::Target target)
+{
+  Account_store store;
+  Account_rules rules;
+  const Account_rules::Product products[] {rules.add_product(Account_policy::checking()),
+    rules.add_product(Account_policy::saving()), rules.add_product(Account_policy::trust())};
+  std::vector<Account_store::Id> ids;
+  for (std::size_t i {0}; i < num_accounts; i++) {
+    // a few balances of more than 2^51 cents, the host accrues them
+    const Money balance = Money::from_cents(i % 100003 == 0 ? std::int64_t {1} << 53 : static_cast<std::int64_t>(i % 997) * 1013);
+    const double int_rate = static_cast<double>(i % 41) / 8;
+    if (i % 2 == 0)
+      ids.push_back(store.add_saving("", balance, int_rate));
+    else
+      ids.push_back(store.add_trust("", balance, int_rate));
+    rules.add(products[i % 3], "", balance, int_rate, static_cast<int>(i % 4));
+  }
+
+  Run result {};
+  auto start = std::chrono::steady_clock::now();
+  for (int period {0}; period < num_periods; period++) {
+    const Account_store::Accrual_result accrual = store.accrue_interest(target);
+    result.interest.push_back(accrual.interest);
+    result.crossed.push_back(accrual.trust_crossed);
+  }
+  result.accrual_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+    / static_cast<double>(num_periods * num_accounts);
+  for (Account_store::Id id: ids)
+    result.balances.push_back(store.get_balance(id));
+
+  std::vector<std::uint8_t> masks;
+  start = std::chrono::steady_clock::now();
+  for (double amount: {10.0, 500.0, 4000.0}) {
+    rules.check_withdraw(Money {amount}, masks, target);
+    result.masks.insert(result.masks.end(), masks.begin(), masks.end());
+  }
+  result.check_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+    / static_cast<double>(3 * num_accounts);
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  const long accounts_arg = argc > 1 ? std::atol(argv[1]) : 4000000;
+  const std::size_t num_accounts = accounts_arg >= 1000 ? static_cast<std::size_t>(accounts_arg) : 1000;
+
+  std::cout << num_accounts << " accounts, " << offload::device_count() << " devices, ns an account:" << std::endl;
+  std::cout << std::setw(16) << "" << "accrual   check_withdraw" << std::endl << std::fixed << std::setprecision(2);
+  const Run host = run(num_accounts, offload::Target::host);
+  int mismatches {0};
+  for (offload::Target target: {offload::Target::host, offload::Target::automatic, offload::Target::device}) {
+    const Run other = target == offload::Target::host ? host : run(num_accounts, target);
+    const char *name = target == offload::Target::host ? "host" : target == offload::Target::automatic ? "automatic" : "device";
+    std::cout << std::setw(16) << std::left << name << std::right << std::setw(7) << other.accrual_ns
+      << std::setw(13) << other.check_ns << std::endl;
+    mismatches += other.balances != host.balances;
+    mismatches += other.interest != host.interest;
+    mismatches += other.crossed != host.crossed;
+    mismatches += other.masks != host.masks;
+  }
+  std::cout << "interest of the first period " << host.interest.front() << ", " << host.crossed.back()
+    << " trust accounts crossed the threshold in the last one" << std::endl;
+
+  std::cout << "mismatches: " << mismatches << std::endl;
+  return mismatches == 0 ? 0 : 1;
+}
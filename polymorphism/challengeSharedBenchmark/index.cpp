@@ -0,0 +1,204 @@
+/*
+
+  - a Shared_ledger (../challenge/Shared_ledger.h) served by a second process, forked,
+    and a client in this one: the round trip of one deposit or withdrawal at a time, its
+    median and its 99th percentile, and the time a request of pipelined batches of 256.
+    against a Ledger_node answering on a socket pair, the same requests as Wire_records
+    through the kernel, one at a time and in batches of 256.
+
+  - every reply of the shared ledger, accepted or not and the balance after it, has to be
+    the one of an Account_store that applies the same transactions, and the balances of the
+    segment at the end its balances, a mismatch is reported and the exit code is 1.
+
+  - build it together with the challenge sources:
+      g++ -std=c++17 -O2 -pthread index.cpp ../challenge/Shared_ledger.cpp ../challenge/Ledger_node.cpp
+        ../challenge/Ledger_client.cpp ../challenge/Account_store.cpp ../challenge/Compound_interest.cpp
+        ../challenge/Account.cpp ../challenge/Checking_account.cpp ../challenge/Saving_account.cpp
+        ../challenge/Trust_account.cpp ../challenge/I_Printable.cpp
+
+  - the number of requests can be given on the command line, 100000 by default, e.g. ./a.out 20000.
+
+  - on one core of an x86-64 at -O2, 100000 requests, us a request, and ns a request in batches:
+                                 median      p99     mean    batched
+      shared memory, futex          1.9      3.1      2.1         73
+      socket pair, Ledger_node      6.1     10.8      6.4         86
+    on one core a round trip is two switches between the processes at the least, the yield
+    of the spinning side gives the core to the other one, futexes or not. the socket pair
+    adds a send and a recv of a batch each way, and its node is a thread of this process.
+    in batches both are the cost of applying the requests, the shared ring has no copy and
+    no system call but the wake ups.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../challenge/Account_store.h"
+#include "../challenge/Checking_account.h"
+#include "../challenge/Hash_ring.h"
+#include "../challenge/Ledger_client.h"
+#include "../challenge/Ledger_node.h"
+#include "../challenge/Saving_account.h"
+#include "../challenge/Shared_ledger.h"
+#include "../challenge/Trust_account.h"
+
+constexpr std::size_t num_accounts {1000};
+constexpr std::size_t batch_size {Shared_ledger::reply_capacity};
+
+Transaction transaction_of(std::size_t i)
+{
+  return {i * 7919 % num_accounts, i % 3 == 0 ? Operation::Withdraw : Operation::Deposit, static_cast<double>(i % 40)};
+}
+
+struct Latency
+{
+  double median_us;
+  double p99_us;
+  double mean_us;
+};
+
+Latency latency_of(std::vector<double> &samples_ns)
+{
+  double total {0.0};
+  for (double sample: samples_ns)
+    total += sample;
+  std::sort(samples_ns.begin(), samples_ns.end());
+  return {samples_ns[samples_ns.size() / 2] / 1000, samples_ns[samples_ns.size() * 99 / 100] / 1000,
+    total / static_cast<double>(samples_ns.size()) / 1000};
+}
+
+void print_row(const char *name, const Latency &latency, double batch_ns)
+{
+  std::cout << std::setw(26) << std::left << name << std::right << std::fixed << std::setprecision(1)
+    << std::setw(9) << latency.median_us << std::setw(9) << latency.p99_us << std::setw(9) << latency.mean_us
+    << std::setprecision(0) << std::setw(13) << batch_ns << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  const long requests_arg = argc > 1 ? std::atol(argv[1]) : 100000;
+  const std::size_t requests = requests_arg >= 1000 ? static_cast<std::size_t>(requests_arg) : 1000;
+
+  std::vector<std::unique_ptr<Account>> owned;
+  std::vector<Account*> accounts;
+  Account_store mirror;
+  std::vector<Account_store::Id> ids;
+  Hash_ring ring {1};
+  Ledger_node node;
+  for (std::size_t i {0}; i < num_accounts; i++) {
+    const std::string name {"Account " + std::to_string(i)};
+    if (i % 3 == 0) {
+      owned.push_back(std::make_unique<Checking_account>(name, 500));
+      ids.push_back(mirror.add_checking(name, 500));
+      node.add_checking(i, name, 500);
+    }
+    else if (i % 3 == 1) {
+      owned.push_back(std::make_unique<Saving_account>(name, 1000, 2.0));
+      ids.push_back(mirror.add_saving(name, 1000, 2.0));
+      node.add_saving(i, name, 1000, 2.0);
+    }
+    else {
+      owned.push_back(std::make_unique<Trust_account>(name, 9000, 1.0));
+      ids.push_back(mirror.add_trust(name, 9000, 1.0));
+      node.add_trust(i, name, 9000, 1.0);
+    }
+    accounts.push_back(owned.back().get());
+  }
+
+  Shared_ledger shared {"basics_shared_benchmark", accounts};
+  const pid_t server = ::fork();
+  if (server < 0) {
+    std::cout << "fork failed" << std::endl;
+    return 1;
+  }
+  if (server == 0) {
+    shared.serve();
+    ::_exit(0);
+  }
+
+  int mismatches {0};
+  const auto check = [&](std::size_t i, const Shared_ledger::Result &result) {
+    const Transaction t = transaction_of(i);
+    const bool accepted = mirror.apply(t);
+    if (accepted != result.accepted || mirror.get_balance(ids[t.account_id]) != result.balance)
+      if (mismatches++ < 5)
+        std::cout << "request " << i << " on account " << t.account_id << ": " << result.accepted << " "
+          << result.balance << ", the store " << accepted << " " << mirror.get_balance(ids[t.account_id]) << std::endl;
+  };
+
+  std::cout << requests << " requests, " << num_accounts << " accounts, one core:" << std::endl;
+  std::cout << std::setw(26) << "" << "   median      p99     mean  batched (ns)" << std::endl;
+
+  Latency shared_latency, node_latency;
+  double shared_batch_ns, node_batch_ns;
+  {
+    Shared_ledger::Client client {shared};
+    std::vector<double> samples;
+    for (std::size_t i {0}; i < requests; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      const Shared_ledger::Result result = client.apply(transaction_of(i));
+      samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+      check(i, result);
+    }
+    shared_latency = latency_of(samples);
+
+    std::vector<std::uint32_t> tickets;
+    std::vector<Shared_ledger::Result> results;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t from {requests}; from < 2 * requests; from += batch_size) {
+      tickets.clear();
+      for (std::size_t i {from}; i < std::min(2 * requests, from + batch_size); i++)
+        tickets.push_back(client.submit(transaction_of(i)));
+      for (std::uint32_t ticket: tickets)
+        results.push_back(client.wait(ticket));
+    }
+    shared_batch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+      / static_cast<double>(requests);
+    for (std::size_t i {0}; i < results.size(); i++)
+      check(requests + i, results[i]);
+  }
+
+  for (std::size_t id {0}; id < num_accounts; id++)
+    mismatches += shared.get_balance(id) != mirror.get_balance(ids[id]);
+  shared.stop();
+  int status {1};
+  ::waitpid(server, &status, 0);
+  mismatches += !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+
+  {
+    Ledger_client client {ring, {node.connect()}};
+    std::vector<double> samples;
+    for (std::size_t i {0}; i < requests; i++) {
+      const Transaction t = transaction_of(i);
+      const auto start = std::chrono::steady_clock::now();
+      if (t.op == Operation::Deposit)
+        client.deposit(t.account_id, t.amount);
+      else
+        client.withdraw(t.account_id, t.amount);
+      samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    node_latency = latency_of(samples);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t from {requests}; from < 2 * requests; from += batch_size) {
+      for (std::size_t i {from}; i < std::min(2 * requests, from + batch_size); i++)
+        client.submit(transaction_of(i));
+      client.flush();
+    }
+    node_batch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+      / static_cast<double>(requests);
+  }
+  mismatches += node.get_total_balance() != mirror.get_total_balance();
+
+  print_row("shared memory, futex", shared_latency, shared_batch_ns);
+  print_row("socket pair, Ledger_node", node_latency, node_batch_ns);
+  std::cout << "mismatches: " << mismatches << std::endl;
+  return mismatches == 0 ? 0 : 1;
+}
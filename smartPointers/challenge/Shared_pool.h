@@ -0,0 +1,336 @@
+#ifndef _SHARED_POOL_H_
+#define _SHARED_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+
+    - make_pooled<T>(args...) is std::make_shared<T>(args...) with the control block and the
+      T in a block of a Block_pool of their size, allocate_shared with a Pool_allocator, not
+      a call of operator new, and their delete puts the block back.
+
+    - a Block_pool hands out blocks of one size, from chunks of chunk_bytes carved in as many
+      blocks as fit. every thread has a list of free blocks of its own, no lock, and takes
+      them from the shared list, or a new chunk, batch at a time, under a mutex, and gives a
+      batch back when it has too many, a block freed on another thread than the one it came
+      from goes to the list of the one that frees it. the chunks are kept until the program
+      ends, a shared_ptr of a static object can be released after everything else.
+
+    - make_shared_n<T>(n, args...) makes n shared_ptrs of a T made with args, with the n
+      control blocks and the n T side by side in one slab, one allocation for all of them,
+      the slab is freed when the last one of them is. every one has a count of its own, a
+      copy of one does not touch the others, and one that is kept keeps the whole slab.
+
+*/
+namespace detail_pool
+{
+    struct Free_block
+    {
+        Free_block* next;
+    };
+
+    inline constexpr std::size_t chunk_bytes {1 << 16};
+    inline constexpr std::size_t batch {64};
+
+    constexpr std::size_t round_up(std::size_t size, std::size_t align)
+    {
+        return (size + align - 1) / align * align;
+    }
+
+    // the part of a list after its first count blocks, the list ends after them
+    inline Free_block* split(Free_block* head, std::size_t count)
+    {
+        for (std::size_t i = 1; i < count; ++i)
+            head = head->next;
+        Free_block* rest = head->next;
+        head->next = nullptr;
+        return rest;
+    }
+}
+
+template <std::size_t Size, std::size_t Align>
+class Block_pool
+{
+public:
+    static constexpr std::size_t align = Align > alignof(detail_pool::Free_block) ? Align : alignof(detail_pool::Free_block);
+    static constexpr std::size_t block_size = detail_pool::round_up(Size > sizeof(detail_pool::Free_block) ? Size : sizeof(detail_pool::Free_block), align);
+
+    static_assert(block_size <= detail_pool::chunk_bytes, "a block is at most a chunk");
+
+private:
+    using Free_block = detail_pool::Free_block;
+
+    struct Shared
+    {
+        std::mutex mutex;
+        Free_block* free {nullptr};
+        std::size_t count {0};
+        std::vector<void*> chunks;
+    };
+
+    // trivially destructible, so it is still there for a block freed while the thread ends
+    struct Cache
+    {
+        Free_block* head;
+        std::size_t count;
+        bool gone;
+    };
+
+    // gives the blocks of the thread back when it ends
+    struct Reaper
+    {
+        ~Reaper()
+        {
+            Cache& cache = Block_pool::cache();
+            Block_pool::give_back(cache, cache.count);
+            cache.gone = true;
+        }
+    };
+
+    // never destroyed, the chunks are reachable until the end
+    static Shared& shared()
+    {
+        static Shared* const shared = new Shared;
+        return *shared;
+    }
+
+    static Cache& cache()
+    {
+        static thread_local Cache cache {nullptr, 0, false};
+        static thread_local Reaper reaper;
+        (void)reaper;
+        return cache;
+    }
+
+    static void give_back(Cache& cache, std::size_t count)
+    {
+        if (count == 0)
+            return;
+        Free_block* const first = cache.head;
+        cache.head = detail_pool::split(first, count);
+        cache.count -= count;
+        Free_block* last = first;
+        while (last->next != nullptr)
+            last = last->next;
+        Shared& s = shared();
+        std::lock_guard<std::mutex> lock {s.mutex};
+        last->next = s.free;
+        s.free = first;
+        s.count += count;
+    }
+
+    static void refill(Cache& cache)
+    {
+        Shared& s = shared();
+        std::lock_guard<std::mutex> lock {s.mutex};
+        if (s.free != nullptr)
+        {
+            const std::size_t count = s.count < detail_pool::batch ? s.count : detail_pool::batch;
+            cache.head = s.free;
+            s.free = detail_pool::split(s.free, count);
+            s.count -= count;
+            cache.count = count;
+            return;
+        }
+        void* const chunk = ::operator new(detail_pool::chunk_bytes, std::align_val_t {align});
+        s.chunks.push_back(chunk);
+        const std::size_t count = detail_pool::chunk_bytes / block_size;
+        unsigned char* const bytes = static_cast<unsigned char*>(chunk);
+        for (std::size_t i = count; i-- > 0;)
+        {
+            Free_block* const block = reinterpret_cast<Free_block*>(bytes + i * block_size);
+            block->next = cache.head;
+            cache.head = block;
+        }
+        cache.count = count;
+    }
+
+public:
+    static void* allocate()
+    {
+        Cache& cache = Block_pool::cache();
+        if (cache.gone)
+        {
+            // a thread that is ending takes one from the shared list
+            Shared& s = shared();
+            std::lock_guard<std::mutex> lock {s.mutex};
+            if (s.free != nullptr)
+            {
+                Free_block* const block = s.free;
+                s.free = block->next;
+                --s.count;
+                return block;
+            }
+            return ::operator new(block_size, std::align_val_t {align});
+        }
+        if (cache.head == nullptr)
+            refill(cache);
+        Free_block* const block = cache.head;
+        cache.head = block->next;
+        --cache.count;
+        return block;
+    }
+
+    static void deallocate(void* p)
+    {
+        Cache& cache = Block_pool::cache();
+        Free_block* const block = static_cast<Free_block*>(p);
+        if (cache.gone)
+        {
+            Shared& s = shared();
+            std::lock_guard<std::mutex> lock {s.mutex};
+            block->next = s.free;
+            s.free = block;
+            ++s.count;
+            return;
+        }
+        block->next = cache.head;
+        cache.head = block;
+        if (++cache.count > 2 * detail_pool::batch)
+            give_back(cache, detail_pool::batch);
+    }
+};
+
+// one object at a time from the Block_pool of its size, arrays from operator new
+template <typename T>
+class Pool_allocator
+{
+public:
+    using value_type = T;
+
+    Pool_allocator() noexcept = default;
+
+    template <typename U>
+    Pool_allocator(const Pool_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n == 1)
+            return static_cast<T*>(Block_pool<sizeof(T), alignof(T)>::allocate());
+        return std::allocator<T> {}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (n == 1)
+            Block_pool<sizeof(T), alignof(T)>::deallocate(p);
+        else
+            std::allocator<T> {}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const Pool_allocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const Pool_allocator<U>&) const noexcept { return false; }
+};
+
+template <typename T, typename... Args>
+std::shared_ptr<T> make_pooled(Args&&... args)
+{
+    return std::allocate_shared<T>(Pool_allocator<T> {}, std::forward<Args>(args)...);
+}
+
+namespace detail_pool
+{
+    // the memory is allocated by the first allocate, when the size of a control block is known
+    struct Slab
+    {
+        std::atomic<std::size_t> live {1};
+        std::size_t capacity;
+        unsigned char* memory {nullptr};
+        unsigned char* next {nullptr};
+        unsigned char* end {nullptr};
+
+        explicit Slab(std::size_t capacity) : capacity(capacity) {}
+
+        void release()
+        {
+            if (this->live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                ::operator delete(this->memory);
+                delete this;
+            }
+        }
+    };
+
+    template <typename T>
+    class Slab_allocator
+    {
+    private:
+        template <typename U>
+        friend class Slab_allocator;
+
+        Slab* slab;
+
+        static constexpr bool fits = alignof(T) <= alignof(std::max_align_t);
+
+    public:
+        using value_type = T;
+
+        explicit Slab_allocator(Slab* slab) noexcept : slab(slab) {}
+
+        template <typename U>
+        Slab_allocator(const Slab_allocator<U>& other) noexcept : slab(other.slab) {}
+
+        T* allocate(std::size_t n)
+        {
+            constexpr std::size_t stride = round_up(sizeof(T), alignof(T));
+            if (n != 1 || !fits)
+                return std::allocator<T> {}.allocate(n);
+            if (this->slab->memory == nullptr)
+            {
+                this->slab->memory = static_cast<unsigned char*>(::operator new(this->slab->capacity * stride));
+                this->slab->next = this->slab->memory;
+                this->slab->end = this->slab->memory + this->slab->capacity * stride;
+            }
+            if (this->slab->end - this->slab->next < static_cast<std::ptrdiff_t>(stride))
+                return std::allocator<T> {}.allocate(n);
+            T* const p = reinterpret_cast<T*>(this->slab->next);
+            this->slab->next += stride;
+            this->slab->live.fetch_add(1, std::memory_order_relaxed);
+            return p;
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            unsigned char* const bytes = reinterpret_cast<unsigned char*>(p);
+            if (n == 1 && fits && bytes >= this->slab->memory && bytes < this->slab->end)
+                this->slab->release();
+            else
+                std::allocator<T> {}.deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const Slab_allocator<U>& rhs) const noexcept { return this->slab == rhs.slab; }
+
+        template <typename U>
+        bool operator!=(const Slab_allocator<U>& rhs) const noexcept { return this->slab != rhs.slab; }
+    };
+}
+
+template <typename T, typename... Args>
+std::vector<std::shared_ptr<T>> make_shared_n(std::size_t n, const Args&... args)
+{
+    std::vector<std::shared_ptr<T>> result;
+    result.reserve(n);
+    detail_pool::Slab* const slab = new detail_pool::Slab {n};
+    // the reference of make_shared_n itself, so a T that throws frees the slab with the ones made
+    struct Release
+    {
+        detail_pool::Slab* slab;
+        ~Release() { this->slab->release(); }
+    } release {slab};
+    const detail_pool::Slab_allocator<T> allocator {slab};
+    for (std::size_t i = 0; i < n; ++i)
+        result.push_back(std::allocate_shared<T>(allocator, args...));
+    return result;
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef _SMALL_VECTOR_H_
+#define _SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
+/*
+
+    - Small_vector<T, N> keeps up to N values in a buffer inside it, like an Array, and
+      moves them to the heap only when the N + 1-th one is added, a vector that stays at
+      N or fewer values never allocates.
+
+    - when it grows, or when it is moved while its values are inline, the values are
+      relocated, moved to the new place and destroyed in the old one. a T that
+      Trivially_relocatable says can be relocated is copied with memcpy instead, that is
+      every trivially copyable T, and the smart pointers, which hold no pointer into
+      themselves. a std::string can hold one, it is not.
+
+    - a moved Small_vector on the heap gives its buffer away, an inline one relocates its
+      values, the moved from one is empty.
+
+    - the iterators are pointers, they are invalidated when it grows, an at out of range
+      throws std::out_of_range.
+
+*/
+template <typename T, std::size_t N>
+class Small_vector final
+{
+    static_assert(N > 0, "a Small_vector has room for at least one value inline");
+
+private:
+    T* values;
+    std::size_t num_values;
+    std::size_t max_values;
+    alignas(T) unsigned char buffer[sizeof(T) * N];
+
+    T* inline_values()
+    {
+        return reinterpret_cast<T*>(this->buffer);
+    }
+
+    // n values from one place to another that does not overlap it, from is left raw memory
+    static void relocate(T* from, std::size_t n, T* to)
+    {
+        if constexpr (Trivially_relocatable<T>::value)
+        {
+            if (n != 0)
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                ::new (static_cast<void*>(to + i)) T(std::move_if_noexcept(from[i]));
+                from[i].~T();
+            }
+        }
+    }
+
+    void release()
+    {
+        if (!this->is_inline())
+            std::allocator<T> {}.deallocate(this->values, this->max_values);
+        this->values = this->inline_values();
+        this->max_values = N;
+    }
+
+    // the values of other, which is left empty, this has no values and its inline buffer
+    void steal(Small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T> || Trivially_relocatable<T>::value)
+    {
+        if (other.is_inline())
+            relocate(other.values, other.num_values, this->values);
+        else
+        {
+            this->values = other.values;
+            this->max_values = other.max_values;
+            other.values = other.inline_values();
+            other.max_values = N;
+        }
+        this->num_values = other.num_values;
+        other.num_values = 0;
+    }
+
+    std::size_t grown_capacity(std::size_t needed) const
+    {
+        return std::max(needed, this->max_values * 2);
+    }
+
+    // the values go to a new buffer of capacity, the new value is built first, it can be one of them
+    template <typename... Args>
+    T& grow_and_emplace(std::size_t capacity, Args&&... args)
+    {
+        T* grown = std::allocator<T> {}.allocate(capacity);
+        try
+        {
+            ::new (static_cast<void*>(grown + this->num_values)) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::allocator<T> {}.deallocate(grown, capacity);
+            throw;
+        }
+        relocate(this->values, this->num_values, grown);
+        this->release();
+        this->values = grown;
+        this->max_values = capacity;
+        return this->values[this->num_values++];
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    Small_vector()
+        : values{this->inline_values()}, num_values{0}, max_values{N} {}
+
+    Small_vector(std::initializer_list<T> list)
+        : Small_vector()
+    {
+        this->reserve(list.size());
+        for (const T& value : list)
+            this->push_back(value);
+    }
+
+    Small_vector(std::size_t n, const T& value)
+        : Small_vector()
+    {
+        this->resize(n, value);
+    }
+
+    Small_vector(const Small_vector& source)
+        : Small_vector()
+    {
+        this->reserve(source.size());
+        for (const T& value : source)
+            this->push_back(value);
+    }
+
+    Small_vector(Small_vector&& source) noexcept(std::is_nothrow_move_constructible_v<T> || Trivially_relocatable<T>::value)
+        : Small_vector()
+    {
+        this->steal(source);
+    }
+
+    ~Small_vector()
+    {
+        this->clear();
+        this->release();
+    }
+
+    Small_vector& operator=(const Small_vector& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->clear();
+            this->reserve(rhs.size());
+            for (const T& value : rhs)
+                this->push_back(value);
+        }
+        return *this;
+    }
+
+    Small_vector& operator=(Small_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T> || Trivially_relocatable<T>::value)
+    {
+        if (this != &rhs)
+        {
+            this->clear();
+            this->release();
+            this->steal(rhs);
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (this->num_values == this->max_values)
+            return this->grow_and_emplace(this->grown_capacity(this->num_values + 1), std::forward<Args>(args)...);
+        ::new (static_cast<void*>(this->values + this->num_values)) T(std::forward<Args>(args)...);
+        return this->values[this->num_values++];
+    }
+
+    void push_back(const T& value) { this->emplace_back(value); }
+    void push_back(T&& value) { this->emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        this->values[--this->num_values].~T();
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < this->num_values; ++i)
+            this->values[i].~T();
+        this->num_values = 0;
+    }
+
+    // the values stay inline while capacity is at most N
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= this->max_values)
+            return;
+        T* grown = std::allocator<T> {}.allocate(capacity);
+        relocate(this->values, this->num_values, grown);
+        this->release();
+        this->values = grown;
+        this->max_values = capacity;
+    }
+
+    void resize(std::size_t n, const T& value = T {})
+    {
+        while (this->num_values > n)
+            this->pop_back();
+        this->reserve(n);
+        while (this->num_values < n)
+            this->emplace_back(value);
+    }
+
+    // false once the values have moved to the heap, they don't come back
+    bool is_inline() const
+    {
+        return this->values == reinterpret_cast<const T*>(this->buffer);
+    }
+
+    std::size_t size() const { return this->num_values; }
+    std::size_t capacity() const { return this->max_values; }
+    bool empty() const { return this->num_values == 0; }
+
+    T& operator[](std::size_t index) { return this->values[index]; }
+    const T& operator[](std::size_t index) const { return this->values[index]; }
+
+    T& at(std::size_t index)
+    {
+        if (index >= this->num_values)
+            throw std::out_of_range {"Small_vector::at"};
+        return this->values[index];
+    }
+
+    const T& at(std::size_t index) const
+    {
+        if (index >= this->num_values)
+            throw std::out_of_range {"Small_vector::at"};
+        return this->values[index];
+    }
+
+    T& front() { return this->values[0]; }
+    const T& front() const { return this->values[0]; }
+    T& back() { return this->values[this->num_values - 1]; }
+    const T& back() const { return this->values[this->num_values - 1]; }
+
+    T* data() { return this->values; }
+    const T* data() const { return this->values; }
+
+    iterator begin() { return this->values; }
+    iterator end() { return this->values + this->num_values; }
+    const_iterator begin() const { return this->values; }
+    const_iterator end() const { return this->values + this->num_values; }
+    const_iterator cbegin() const { return this->values; }
+    const_iterator cend() const { return this->values + this->num_values; }
+};
+
+#endif
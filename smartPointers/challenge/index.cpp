@@ -1,6 +1,7 @@
 #include <iostream>
-#include <vector>
 #include <memory>
+#include "Small_vector.h"
+#include "Shared_pool.h"
 
 class Test
 {
@@ -14,26 +15,30 @@ public:
   ~Test() { std::cout << "\tTest destructor(" << data << ")" << std::endl; }
 };
 
+// up to 8 data points are kept inside the vector, more move it to the heap, and every
+// Test with its control block is a block of a pool, not a new allocation
+using Data_points = Small_vector<std::shared_ptr<Test>, 8>;
+
 auto make();
-void fill(std::vector<std::shared_ptr<Test>> &vec, int num);
-void display(const std::vector<std::shared_ptr<Test>> &vec);
+void fill(Data_points &vec, int num);
+void display(const Data_points &vec);
 
 auto make()
 {
-  return std::make_unique<std::vector<std::shared_ptr<Test>>>();
+  return std::make_unique<Data_points>();
 }
 
-void fill(std::vector<std::shared_ptr<Test>> &vec, int num)
+void fill(Data_points &vec, int num)
 {
   int temp {};
   for (int i {1}; i <= num; i++) {
     std::cout << "Enter data points at [" << i << "]: ";
     std::cin >> temp;
-    vec.push_back(std::make_shared<Test>(temp));
+    vec.push_back(make_pooled<Test>(temp));
   }
 }
 
-void display(const std::vector<std::shared_ptr<Test>> &vec)
+void display(const Data_points &vec)
 {
   std::cout << "============" << std::endl;
   for (const auto &ptr: vec)
@@ -43,7 +48,7 @@ void display(const std::vector<std::shared_ptr<Test>> &vec)
 
 int main()
 {
-  std::unique_ptr<std::vector<std::shared_ptr<Test>>> vec_ptr;
+  std::unique_ptr<Data_points> vec_ptr;
   vec_ptr = make();
   std::cout << "How many data points do you want to enter: ";
   int num;
@@ -0,0 +1,317 @@
+#ifndef _RESOURCE_POOL_H_
+#define _RESOURCE_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Pooled_ptr<T> is a unique_ptr whose deleter does not delete the T, it gives it back to
+      the pool it came from, and the next acquire() of the pool hands it out again, no new and
+      no delete, nor what the constructor and the destructor of the T do, an open and a close
+      of a file, an allocation of a buffer.
+
+    - Resource_pool<T>(make, reset, max_idle) makes a T with make() when it has none that is
+      idle, calls reset(t) on one that is given back, to clear what the last user left in it,
+      and keeps up to max_idle of them, the ones after it are deleted. a reset that throws
+      deletes the T too. the pool can be destroyed before the Pooled_ptrs it handed out,
+      their deleters share the list of idle ones, and delete them once there is no pool.
+      acquire and the deleters can be called from several threads, the list has a mutex.
+
+    - Buffer_pool(buffer_size) hands out Buffers of buffer_size chars, a new char[] once per
+      Buffer, for the reads of the ioAndStream readers, the chars are what the last user left.
+
+    - File_pool hands out File_handles, a std::ifstream open on a path, kept open when it is
+      given back, with its state cleared and the position at the start, for the next acquire
+      of the same path. acquire throws std::runtime_error when the file can not be opened. a
+      pooled handle reads the file it opened, one that is replaced by a rename is opened again
+      only after clear().
+
+    - stats() counts the T made, the ones reused and the ones deleted because the pool had
+      enough, reused / (made + reused) tells how much the pool saves.
+
+*/
+struct Resource_pool_stats
+{
+    std::uint64_t made {0};
+    std::uint64_t reused {0};
+    std::uint64_t dropped {0};
+};
+
+namespace detail_resource_pool
+{
+    template <typename T>
+    struct Free_list
+    {
+        virtual ~Free_list() = default;
+        virtual void give_back(T* resource) noexcept = 0;
+    };
+}
+
+template <typename T>
+class Pool_deleter
+{
+private:
+    std::shared_ptr<detail_resource_pool::Free_list<T>> list;
+
+public:
+    Pool_deleter() noexcept = default;
+    explicit Pool_deleter(std::shared_ptr<detail_resource_pool::Free_list<T>> list) noexcept : list(std::move(list)) {}
+
+    // a Pooled_ptr made from a T* of new, not from a pool, deletes it
+    void operator()(T* resource) const noexcept
+    {
+        if (this->list != nullptr)
+            this->list->give_back(resource);
+        else
+            delete resource;
+    }
+};
+
+template <typename T>
+using Pooled_ptr = std::unique_ptr<T, Pool_deleter<T>>;
+
+template <typename T>
+class Resource_pool
+{
+public:
+    using maker_type = std::function<std::unique_ptr<T>()>;
+    using reset_type = std::function<void(T&)>;
+
+    static constexpr std::size_t def_max_idle = 64;
+
+private:
+    struct State : detail_resource_pool::Free_list<T>
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<T>> idle;
+        std::size_t max_idle;
+        reset_type reset;
+        Resource_pool_stats counts;
+
+        State(reset_type reset, std::size_t max_idle) : max_idle(max_idle), reset(std::move(reset)) {}
+
+        void give_back(T* resource) noexcept override
+        {
+            std::unique_ptr<T> owned {resource};
+            try
+            {
+                if (this->reset)
+                    this->reset(*owned);
+                std::lock_guard<std::mutex> lock {this->mutex};
+                if (this->idle.size() < this->max_idle)
+                {
+                    this->idle.push_back(std::move(owned));
+                    return;
+                }
+                ++this->counts.dropped;
+            }
+            catch (...)
+            {
+            }
+        }
+    };
+
+    maker_type make;
+    std::shared_ptr<State> state;
+
+public:
+    explicit Resource_pool(maker_type make, reset_type reset = {}, std::size_t max_idle = def_max_idle)
+        : make(std::move(make)), state(std::make_shared<State>(std::move(reset), max_idle))
+    {}
+
+    Pooled_ptr<T> acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock {this->state->mutex};
+            if (!this->state->idle.empty())
+            {
+                ++this->state->counts.reused;
+                T* const resource = this->state->idle.back().release();
+                this->state->idle.pop_back();
+                return Pooled_ptr<T> {resource, Pool_deleter<T> {this->state}};
+            }
+        }
+        std::unique_ptr<T> resource = this->make();
+        {
+            std::lock_guard<std::mutex> lock {this->state->mutex};
+            ++this->state->counts.made;
+        }
+        return Pooled_ptr<T> {resource.release(), Pool_deleter<T> {this->state}};
+    }
+
+    // the idle ones are deleted, the ones handed out come back as usual
+    void clear()
+    {
+        std::vector<std::unique_ptr<T>> idle;
+        {
+            std::lock_guard<std::mutex> lock {this->state->mutex};
+            idle.swap(this->state->idle);
+        }
+    }
+
+    std::size_t idle() const
+    {
+        std::lock_guard<std::mutex> lock {this->state->mutex};
+        return this->state->idle.size();
+    }
+
+    Resource_pool_stats stats() const
+    {
+        std::lock_guard<std::mutex> lock {this->state->mutex};
+        return this->state->counts;
+    }
+};
+
+class Buffer
+{
+private:
+    std::unique_ptr<char[]> bytes;
+    std::size_t length;
+
+public:
+    explicit Buffer(std::size_t length) : bytes(new char[length]), length(length) {}
+
+    char* data() { return this->bytes.get(); }
+    const char* data() const { return this->bytes.get(); }
+    std::size_t size() const { return this->length; }
+};
+
+class Buffer_pool : public Resource_pool<Buffer>
+{
+private:
+    std::size_t length;
+
+public:
+    static constexpr std::size_t def_buffer_size = std::size_t {1} << 16;
+
+    explicit Buffer_pool(std::size_t buffer_size = def_buffer_size, std::size_t max_idle = def_max_idle)
+        : Resource_pool<Buffer>([buffer_size] { return std::make_unique<Buffer>(buffer_size); }, {}, max_idle),
+          length(buffer_size)
+    {}
+
+    std::size_t buffer_size() const { return this->length; }
+};
+
+class File_handle
+{
+private:
+    std::string file_path;
+    std::ifstream file;
+
+public:
+    File_handle(const std::string& path, std::ios_base::openmode mode) : file_path(path), file(path, mode)
+    {
+        if (!this->file.is_open())
+            throw std::runtime_error("open " + path + ": the file can not be opened");
+    }
+
+    const std::string& path() const { return this->file_path; }
+    std::ifstream& stream() { return this->file; }
+};
+
+class File_pool
+{
+public:
+    static constexpr std::size_t def_max_idle_per_file = 8;
+
+private:
+    struct State : detail_resource_pool::Free_list<File_handle>
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::vector<std::unique_ptr<File_handle>>> idle;
+        std::size_t max_idle_per_file;
+        Resource_pool_stats counts;
+
+        explicit State(std::size_t max_idle_per_file) : max_idle_per_file(max_idle_per_file) {}
+
+        void give_back(File_handle* handle) noexcept override
+        {
+            std::unique_ptr<File_handle> owned {handle};
+            try
+            {
+                // a read to the end leaves eofbit, and seekg does nothing until it is cleared
+                owned->stream().clear();
+                if (!owned->stream().seekg(0))
+                    return;
+                std::lock_guard<std::mutex> lock {this->mutex};
+                std::vector<std::unique_ptr<File_handle>>& handles = this->idle[owned->path()];
+                if (handles.size() < this->max_idle_per_file)
+                {
+                    handles.push_back(std::move(owned));
+                    return;
+                }
+                ++this->counts.dropped;
+            }
+            catch (...)
+            {
+            }
+        }
+    };
+
+    std::ios_base::openmode mode;
+    std::shared_ptr<State> state;
+
+public:
+    explicit File_pool(std::ios_base::openmode mode = std::ios::in | std::ios::binary,
+                       std::size_t max_idle_per_file = def_max_idle_per_file)
+        : mode(mode), state(std::make_shared<State>(max_idle_per_file))
+    {}
+
+    Pooled_ptr<File_handle> acquire(const std::string& path)
+    {
+        {
+            std::lock_guard<std::mutex> lock {this->state->mutex};
+            const auto it = this->state->idle.find(path);
+            if (it != this->state->idle.end() && !it->second.empty())
+            {
+                ++this->state->counts.reused;
+                File_handle* const handle = it->second.back().release();
+                it->second.pop_back();
+                return Pooled_ptr<File_handle> {handle, Pool_deleter<File_handle> {this->state}};
+            }
+        }
+        std::unique_ptr<File_handle> handle = std::make_unique<File_handle>(path, this->mode);
+        {
+            std::lock_guard<std::mutex> lock {this->state->mutex};
+            ++this->state->counts.made;
+        }
+        return Pooled_ptr<File_handle> {handle.release(), Pool_deleter<File_handle> {this->state}};
+    }
+
+    // closes the idle files, the next acquire opens them again
+    void clear()
+    {
+        std::unordered_map<std::string, std::vector<std::unique_ptr<File_handle>>> idle;
+        {
+            std::lock_guard<std::mutex> lock {this->state->mutex};
+            idle.swap(this->state->idle);
+        }
+    }
+
+    std::size_t idle() const
+    {
+        std::lock_guard<std::mutex> lock {this->state->mutex};
+        std::size_t count {0};
+        for (const auto& entry : this->state->idle)
+            count += entry.second.size();
+        return count;
+    }
+
+    Resource_pool_stats stats() const
+    {
+        std::lock_guard<std::mutex> lock {this->state->mutex};
+        return this->state->counts;
+    }
+};
+
+#endif
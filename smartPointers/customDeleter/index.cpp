@@ -32,6 +32,8 @@
 
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include "Resource_pool.h"
 
 class Test
 {
@@ -65,5 +67,24 @@ int main()
     std::cout << "Outting of the scope..." << std::endl;
   }
 
+  // the deleters give the buffer and the file back to their pools, the second read opens
+  // nothing and allocates nothing
+  Buffer_pool buffers {4096};
+  File_pool files;
+  try {
+    for (int i {0}; i < 2; i++) {
+      Pooled_ptr<Buffer> buffer {buffers.acquire()};
+      Pooled_ptr<File_handle> file {files.acquire("index.cpp")};
+      file->stream().read(buffer->data(), static_cast<std::streamsize>(buffer->size()));
+      std::cout << "Read " << file->stream().gcount() << " chars" << std::endl;
+    } // back to the pools
+  }
+  catch (const std::runtime_error &ex) {
+    std::cerr << ex.what() << ", run it in its directory, index.cpp is read" << std::endl;
+    return 1;
+  }
+  std::cout << "Buffers made: " << buffers.stats().made << ", reused: " << buffers.stats().reused << std::endl;
+  std::cout << "Files opened: " << files.stats().made << ", reused: " << files.stats().reused << std::endl;
+
   return 0;
 }
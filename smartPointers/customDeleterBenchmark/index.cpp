@@ -0,0 +1,87 @@
+/*
+
+    - times the loop of an ingest that reads a file in a buffer, again and again: a new char[]
+      and a std::ifstream opened and closed every time, against a Buffer and a File_handle of
+      the pools of ../customDeleter/Resource_pool.h, in us per read, with a checksum of the
+      chars, the same for both.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - the file is this index.cpp, read 100'000 times by default, another file and number can
+      be given on the command line, e.g. ./a.out ../../ioAndStream/copyingFile1/romeoAndJuliet.txt 10000
+
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "../customDeleter/Resource_pool.h"
+
+constexpr std::size_t buffer_size {1 << 16};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::uint64_t checksum_of(const char* data, std::streamsize count)
+{
+    std::uint64_t sum {0};
+    for (std::streamsize i = 0; i < count; ++i)
+        sum = sum * 31 + static_cast<unsigned char>(data[i]);
+    return sum;
+}
+
+// us per read of read_once(), that returns a checksum of what it read
+template <typename F>
+void run(const std::string& name, std::size_t reads, F read_once)
+{
+    std::uint64_t checksum {0};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < reads; ++i)
+        checksum += read_once();
+    const double seconds = seconds_since(start);
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3)
+        << std::setw(10) << std::right << seconds * 1e6 / reads << std::setw(24) << checksum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string path = argc > 1 ? argv[1] : "index.cpp";
+    const std::size_t reads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100'000;
+    if (!std::ifstream {path})
+    {
+        std::cerr << "Can not open " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << std::setw(36) << std::left << "us per read" << std::setw(10) << std::right << ""
+        << std::setw(24) << "checksum" << std::endl;
+
+    run("new char[] and std::ifstream", reads, [&] {
+        std::unique_ptr<char[]> buffer {new char[buffer_size]};
+        std::ifstream file {path, std::ios::in | std::ios::binary};
+        file.read(buffer.get(), buffer_size);
+        return checksum_of(buffer.get(), file.gcount());
+    });
+
+    Buffer_pool buffers {buffer_size};
+    File_pool files;
+    run("Buffer_pool and File_pool", reads, [&] {
+        const Pooled_ptr<Buffer> buffer {buffers.acquire()};
+        const Pooled_ptr<File_handle> file {files.acquire(path)};
+        file->stream().read(buffer->data(), static_cast<std::streamsize>(buffer->size()));
+        return checksum_of(buffer->data(), file->stream().gcount());
+    });
+
+    const Resource_pool_stats stats = files.stats();
+    std::cout << "files opened: " << stats.made << ", reused: " << stats.reused << std::endl;
+
+    return 0;
+}
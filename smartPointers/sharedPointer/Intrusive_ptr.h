@@ -0,0 +1,383 @@
+#ifndef _INTRUSIVE_PTR_H_
+#define _INTRUSIVE_PTR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+/*
+
+    - Intrusive_ptr<T> is a shared_ptr whose use count is in the T, a T derives from
+      Ref_counted<T>, or from Ref_counted<T, Single_thread_count>: no control block, nothing
+      allocated but the T, the pointer is one word, and one made from a T* that already has
+      owners, this in a member function, shares them instead of starting a second count.
+
+    - the count is a policy: Atomic_count, the default, is the atomic increments and
+      decrements of a shared_ptr, Single_thread_count is a plain integer, for objects that
+      are only ever shared by one thread at a time, a copy is then an add, not a locked
+      instruction.
+
+    - Intrusive_weak_ptr<T> is a weak_ptr: the first one of an object makes a side table for
+      it, a record with a count of weak references and whether the object is alive, that the
+      object points to, the weak ones hold the record, not the object, and it outlives the
+      object until the last one of them is gone. an object no weak one was made of has no
+      record, only a null pointer. lock() gives an Intrusive_ptr, null once the object is
+      destroyed, it takes the mutex of the record, with Atomic_count it is slower than the
+      lock() of a weak_ptr, the other copies are not.
+
+    - a copy of a Ref_counted object has a count of its own, 0, and no record. the T is
+      deleted with delete, a T made with new, make_intrusive<T>(args...), and a class of a
+      hierarchy needs a virtual destructor, like a shared_ptr of the base without a deleter.
+
+*/
+namespace detail_intrusive
+{
+    struct No_mutex
+    {
+        void lock() {}
+        void unlock() {}
+    };
+}
+
+struct Atomic_count
+{
+    using count_type = std::atomic<std::size_t>;
+    template <typename P>
+    using pointer_type = std::atomic<P*>;
+    using mutex_type = std::mutex;
+
+    static void increment(count_type& count) { count.fetch_add(1, std::memory_order_relaxed); }
+
+    // true for the last reference, that sees everything the others did before they went
+    static bool decrement(count_type& count) { return count.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    static bool increment_if_not_zero(count_type& count)
+    {
+        std::size_t value = count.load(std::memory_order_relaxed);
+        while (value != 0)
+            if (count.compare_exchange_weak(value, value + 1, std::memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    static std::size_t load(const count_type& count) { return count.load(std::memory_order_relaxed); }
+
+    template <typename P>
+    static P* load(const pointer_type<P>& pointer) { return pointer.load(std::memory_order_acquire); }
+
+    // the pointer that is there after it, fresh or the one another thread put first
+    template <typename P>
+    static P* install(pointer_type<P>& pointer, P* fresh)
+    {
+        P* expected {nullptr};
+        if (pointer.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+            return fresh;
+        return expected;
+    }
+};
+
+struct Single_thread_count
+{
+    using count_type = std::size_t;
+    template <typename P>
+    using pointer_type = P*;
+    using mutex_type = detail_intrusive::No_mutex;
+
+    static void increment(count_type& count) { ++count; }
+    static bool decrement(count_type& count) { return --count == 0; }
+
+    static bool increment_if_not_zero(count_type& count)
+    {
+        if (count == 0)
+            return false;
+        ++count;
+        return true;
+    }
+
+    static std::size_t load(const count_type& count) { return count; }
+
+    template <typename P>
+    static P* load(P* pointer) { return pointer; }
+
+    template <typename P>
+    static P* install(P*& pointer, P* fresh)
+    {
+        if (pointer == nullptr)
+            pointer = fresh;
+        return pointer;
+    }
+};
+
+namespace detail_intrusive
+{
+    // the side table of an object, one weak reference is the one of the object itself
+    template <typename Policy>
+    struct Weak_record
+    {
+        typename Policy::count_type weak {1};
+        typename Policy::mutex_type mutex;
+        bool alive {true};
+
+        void release()
+        {
+            if (Policy::decrement(this->weak))
+                delete this;
+        }
+    };
+}
+
+template <typename T>
+class Intrusive_ptr;
+
+template <typename T>
+class Intrusive_weak_ptr;
+
+template <typename Derived, typename Policy = Atomic_count>
+class Ref_counted
+{
+public:
+    using intrusive_policy = Policy;
+    using weak_record = detail_intrusive::Weak_record<Policy>;
+
+private:
+    template <typename T>
+    friend class Intrusive_ptr;
+
+    template <typename T>
+    friend class Intrusive_weak_ptr;
+
+    mutable typename Policy::count_type refs {0};
+    mutable typename Policy::template pointer_type<weak_record> record {nullptr};
+
+    void add_ref() const { Policy::increment(this->refs); }
+
+    void release() const
+    {
+        if (!Policy::decrement(this->refs))
+            return;
+        if (weak_record* const record = Policy::load(this->record))
+        {
+            // a weak one that locks holds the mutex while it looks at the count
+            std::lock_guard<typename Policy::mutex_type> lock {record->mutex};
+            record->alive = false;
+        }
+        delete static_cast<const Derived*>(this);
+    }
+
+    // the record, made by the first weak reference, with one more reference for the caller
+    weak_record* acquire_record() const
+    {
+        weak_record* record = Policy::load(this->record);
+        if (record == nullptr)
+        {
+            weak_record* const fresh = new weak_record;
+            record = Policy::install(this->record, fresh);
+            if (record != fresh)
+                delete fresh;
+        }
+        Policy::increment(record->weak);
+        return record;
+    }
+
+protected:
+    Ref_counted() noexcept = default;
+    Ref_counted(const Ref_counted&) noexcept {}
+    Ref_counted& operator=(const Ref_counted&) noexcept { return *this; }
+
+    ~Ref_counted()
+    {
+        if (weak_record* const record = Policy::load(this->record))
+            record->release();
+    }
+
+public:
+    std::size_t use_count() const { return Policy::load(this->refs); }
+};
+
+template <typename T>
+class Intrusive_ptr
+{
+private:
+    template <typename U>
+    friend class Intrusive_ptr;
+
+    template <typename U>
+    friend class Intrusive_weak_ptr;
+
+    T* ptr {nullptr};
+
+    // a reference Intrusive_weak_ptr::lock already counted
+    struct Adopt {};
+    Intrusive_ptr(T* ptr, Adopt) noexcept : ptr(ptr) {}
+
+public:
+    using element_type = T;
+
+    constexpr Intrusive_ptr() noexcept = default;
+    constexpr Intrusive_ptr(std::nullptr_t) noexcept {}
+
+    // one more owner of *ptr, the first one of a T just made with new
+    explicit Intrusive_ptr(T* ptr) : ptr(ptr)
+    {
+        if (this->ptr != nullptr)
+            this->ptr->add_ref();
+    }
+
+    Intrusive_ptr(const Intrusive_ptr& other) noexcept : ptr(other.ptr)
+    {
+        if (this->ptr != nullptr)
+            this->ptr->add_ref();
+    }
+
+    Intrusive_ptr(Intrusive_ptr&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    Intrusive_ptr(const Intrusive_ptr<U>& other) noexcept : ptr(other.ptr)
+    {
+        if (this->ptr != nullptr)
+            this->ptr->add_ref();
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    Intrusive_ptr(Intrusive_ptr<U>&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+
+    ~Intrusive_ptr()
+    {
+        if (this->ptr != nullptr)
+            this->ptr->release();
+    }
+
+    Intrusive_ptr& operator=(Intrusive_ptr other) noexcept
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    void swap(Intrusive_ptr& other) noexcept { std::swap(this->ptr, other.ptr); }
+
+    void reset() noexcept { Intrusive_ptr {}.swap(*this); }
+    void reset(T* ptr) { Intrusive_ptr {ptr}.swap(*this); }
+
+    T* get() const noexcept { return this->ptr; }
+    T& operator*() const noexcept { return *this->ptr; }
+    T* operator->() const noexcept { return this->ptr; }
+    explicit operator bool() const noexcept { return this->ptr != nullptr; }
+
+    std::size_t use_count() const { return this->ptr == nullptr ? 0 : this->ptr->use_count(); }
+};
+
+template <typename T, typename U>
+bool operator==(const Intrusive_ptr<T>& lhs, const Intrusive_ptr<U>& rhs) noexcept { return lhs.get() == rhs.get(); }
+
+template <typename T, typename U>
+bool operator!=(const Intrusive_ptr<T>& lhs, const Intrusive_ptr<U>& rhs) noexcept { return lhs.get() != rhs.get(); }
+
+template <typename T, typename U>
+bool operator<(const Intrusive_ptr<T>& lhs, const Intrusive_ptr<U>& rhs) noexcept { return std::less<> {}(lhs.get(), rhs.get()); }
+
+template <typename T>
+bool operator==(const Intrusive_ptr<T>& lhs, std::nullptr_t) noexcept { return lhs.get() == nullptr; }
+
+template <typename T>
+bool operator!=(const Intrusive_ptr<T>& lhs, std::nullptr_t) noexcept { return lhs.get() != nullptr; }
+
+template <typename T, typename... Args>
+Intrusive_ptr<T> make_intrusive(Args&&... args)
+{
+    return Intrusive_ptr<T> {new T(std::forward<Args>(args)...)};
+}
+
+template <typename T>
+class Intrusive_weak_ptr
+{
+private:
+    template <typename U>
+    friend class Intrusive_weak_ptr;
+
+    using Record = typename T::weak_record;
+
+    // ptr is only used while record says the object is alive
+    T* ptr {nullptr};
+    Record* record {nullptr};
+
+public:
+    constexpr Intrusive_weak_ptr() noexcept = default;
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    Intrusive_weak_ptr(const Intrusive_ptr<U>& other) : ptr(other.get())
+    {
+        if (this->ptr != nullptr)
+            this->record = this->ptr->acquire_record();
+    }
+
+    Intrusive_weak_ptr(const Intrusive_weak_ptr& other) noexcept : ptr(other.ptr), record(other.record)
+    {
+        if (this->record != nullptr)
+            T::intrusive_policy::increment(this->record->weak);
+    }
+
+    Intrusive_weak_ptr(Intrusive_weak_ptr&& other) noexcept
+        : ptr(std::exchange(other.ptr, nullptr)), record(std::exchange(other.record, nullptr))
+    {}
+
+    ~Intrusive_weak_ptr()
+    {
+        if (this->record != nullptr)
+            this->record->release();
+    }
+
+    Intrusive_weak_ptr& operator=(Intrusive_weak_ptr other) noexcept
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    void swap(Intrusive_weak_ptr& other) noexcept
+    {
+        std::swap(this->ptr, other.ptr);
+        std::swap(this->record, other.record);
+    }
+
+    void reset() noexcept { Intrusive_weak_ptr {}.swap(*this); }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    Intrusive_weak_ptr(const Intrusive_weak_ptr<U>& other) noexcept : ptr(other.ptr), record(other.record)
+    {
+        if (this->record != nullptr)
+            T::intrusive_policy::increment(this->record->weak);
+    }
+
+    // under the mutex of the record, the object is not deleted while it is alive, and its
+    // count is 0 from the moment it is not
+    Intrusive_ptr<T> lock() const
+    {
+        if (this->record == nullptr)
+            return Intrusive_ptr<T> {};
+        std::lock_guard<typename T::intrusive_policy::mutex_type> lock {this->record->mutex};
+        if (!this->record->alive || !T::intrusive_policy::increment_if_not_zero(this->ptr->refs))
+            return Intrusive_ptr<T> {};
+        return Intrusive_ptr<T> {this->ptr, typename Intrusive_ptr<T>::Adopt {}};
+    }
+
+    bool expired() const
+    {
+        if (this->record == nullptr)
+            return true;
+        std::lock_guard<typename T::intrusive_policy::mutex_type> lock {this->record->mutex};
+        return !this->record->alive;
+    }
+};
+
+namespace std
+{
+    template <typename T>
+    struct hash<Intrusive_ptr<T>>
+    {
+        std::size_t operator()(const Intrusive_ptr<T>& p) const noexcept { return std::hash<T*> {}(p.get()); }
+    };
+}
+
+#endif
@@ -78,12 +78,24 @@
 #include "Checking_account.h"
 #include "Trust_account.h"
 #include "Account_util.h"
+#include "Intrusive_ptr.h"
 
 void func(std::shared_ptr<int> ptr)
 {
   std::cout << "Use count: " << ptr.use_count() << std::endl;
 }
 
+// the use count is in the object, and a plain integer, it is only shared by this thread
+class Reading : public Ref_counted<Reading, Single_thread_count>
+{
+private:
+  double value;
+
+public:
+  explicit Reading(double value) : value{value} {}
+  double get_value() const { return value; }
+};
+
 int main()
 {
   std::shared_ptr<int> p1 {std::make_shared<int>(100)};
@@ -124,5 +136,20 @@ int main()
   // then ptr3 and ptr2, but the ptr1 still refer to the heap and the allocated heap still exist
   // then heap will be deallocate then ptr1 will be null out.
 
+  Intrusive_ptr<Reading> r1 {make_intrusive<Reading>(36.6)};
+  Intrusive_weak_ptr<Reading> weak {r1};
+  {
+    std::vector<Intrusive_ptr<Reading>> readings(3, r1); // Making copies, no atomic increment
+    std::cout << "Use count: " << r1.use_count() << std::endl; // 4
+    // a pointer made from the raw one shares the count of the others
+    Intrusive_ptr<Reading> r2 {r1.get()};
+    std::cout << "Use count: " << r2.use_count() << std::endl; // 5
+  }
+  std::cout << "Use count: " << r1.use_count() << std::endl; // 1
+  if (Intrusive_ptr<Reading> locked = weak.lock())
+    std::cout << "Reading: " << locked->get_value() << std::endl;
+  r1.reset();
+  std::cout << std::boolalpha << "Expired: " << weak.expired() << std::endl; // true
+
   return 0;
 }
@@ -0,0 +1,153 @@
+/*
+
+    - compares std::shared_ptr with the Intrusive_ptr of ../sharedPointer/Intrusive_ptr.h, with
+      the atomic count and with the single thread one, on what copies pointers the most: a
+      copy of a vector of them, a pointer passed by value to a function that is not inlined,
+      a vector of them copied and sorted by the values they point to, and a lock() of a weak
+      pointer of every one, in ns per pointer, with a checksum of the values, the same for all.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp
+      libstdc++ makes the shared_ptr counts plain integers while the program has no second
+      thread, so one is started, and joined, before anything is timed, like in a program with
+      a pool that runs a pipeline on one of its threads.
+
+    - 1'000'000 pointers by default, the number can be given on the command line, e.g.
+      ./a.out 100000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../sharedPointer/Intrusive_ptr.h"
+
+struct Shared_value
+{
+    int value;
+    explicit Shared_value(int value) : value(value) {}
+};
+
+struct Atomic_value : Ref_counted<Atomic_value>
+{
+    int value;
+    explicit Atomic_value(int value) : value(value) {}
+};
+
+struct Plain_value : Ref_counted<Plain_value, Single_thread_count>
+{
+    int value;
+    explicit Plain_value(int value) : value(value) {}
+};
+
+struct Shared_family
+{
+    using value_type = Shared_value;
+    using pointer = std::shared_ptr<Shared_value>;
+    using weak = std::weak_ptr<Shared_value>;
+    static pointer make(int value) { return std::make_shared<Shared_value>(value); }
+};
+
+template <typename T>
+struct Intrusive_family
+{
+    using value_type = T;
+    using pointer = Intrusive_ptr<T>;
+    using weak = Intrusive_weak_ptr<T>;
+    static pointer make(int value) { return make_intrusive<T>(value); }
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// so the pointer is really copied into the argument, and destroyed after
+template <typename Pointer>
+__attribute__((noinline)) std::uint64_t value_of(Pointer p)
+{
+    return static_cast<std::uint32_t>(p->value);
+}
+
+// ns per pointer of f(), that returns a checksum, the best of rounds
+template <typename F>
+void run(const std::string& name, std::size_t n, F f)
+{
+    constexpr int rounds {5};
+    double best {0};
+    std::uint64_t checksum {0};
+    for (int round = 0; round < rounds; ++round)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        checksum = f();
+        const double seconds = seconds_since(start);
+        best = round == 0 ? seconds : std::min(best, seconds);
+    }
+    std::cout << std::setw(52) << std::left << name << std::fixed << std::setprecision(2)
+        << std::setw(10) << std::right << best * 1e9 / n << std::setw(20) << checksum << std::endl;
+}
+
+template <typename Family>
+void bench(const std::string& name, const std::vector<int>& values)
+{
+    using Pointer = typename Family::pointer;
+    const std::size_t n = values.size();
+    std::vector<Pointer> pointers;
+    pointers.reserve(n);
+    for (int value : values)
+        pointers.push_back(Family::make(value));
+    const std::vector<typename Family::weak> weak(pointers.begin(), pointers.end());
+
+    run(name + ", vector copy", n, [&] {
+        const std::vector<Pointer> copy {pointers};
+        return static_cast<std::uint64_t>(copy.size()) + static_cast<std::uint32_t>(copy.back()->value);
+    });
+    run(name + ", pass by value", n, [&] {
+        std::uint64_t sum {0};
+        for (const Pointer& p : pointers)
+            sum += value_of(p);
+        return sum;
+    });
+    run(name + ", copy and sort", n, [&] {
+        std::vector<Pointer> copy {pointers};
+        std::sort(copy.begin(), copy.end(), [](const Pointer& a, const Pointer& b) { return a->value < b->value; });
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(copy.front()->value));
+    });
+    run(name + ", weak lock", n, [&] {
+        std::uint64_t sum {0};
+        for (const auto& w : weak)
+            if (const Pointer p = w.lock())
+                sum += static_cast<std::uint32_t>(p->value);
+        return sum;
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1'000'000;
+
+    // libstdc++ skips the atomic instructions of shared_ptr while the program has one thread
+    std::thread {[] {}}.join();
+
+    std::mt19937 gen {42};
+    std::uniform_int_distribution<int> dist {0, 1'000'000'000};
+    std::vector<int> values(n);
+    for (int& value : values)
+        value = dist(gen);
+
+    std::cout << std::setw(52) << std::left << "ns per pointer" << std::setw(10) << std::right << ""
+        << std::setw(20) << "checksum" << std::endl;
+    bench<Shared_family>("std::shared_ptr", values);
+    bench<Intrusive_family<Atomic_value>>("Intrusive_ptr, Atomic_count", values);
+    bench<Intrusive_family<Plain_value>>("Intrusive_ptr, Single_thread_count", values);
+
+    return 0;
+}
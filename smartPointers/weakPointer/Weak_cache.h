@@ -0,0 +1,228 @@
+#ifndef _WEAK_CACHE_H_
+#define _WEAK_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Weak_cache<Key, T> keeps a weak_ptr to every T it loaded, by key: get(key) gives the
+      shared_ptr of the one that is loaded while anyone still holds it, the same object for
+      every caller, and calls load(key) again once the last one is gone. the cache owns
+      nothing, a T lives as long as its users, not as long as the cache.
+
+    - the keys are spread over shards maps by their hash, each one with its own mutex, like
+      the ones of ../../functions/memoization/Memoize.h. load runs outside the lock, and a
+      thread that gets a key that is being loaded waits for that load and gets its T, counted
+      as a hit, so a key is loaded once however many threads want it at the same moment. a
+      load that throws throws in all of them, and the next get loads again.
+
+    - the entries of the T that are gone are removed in batches: a sweep of a shard goes over
+      its whole map and erases them, and it happens when the map has grown to twice the size
+      it had after the last one, and at least min_sweep entries more, so a sweep costs a few
+      steps per insert, not one per get. sweep() sweeps every shard now.
+
+    - stats() counts the hits, a T that was still alive, the misses, a key that was not in
+      the cache, the expired, a key whose T was gone, loaded again, and the swept entries.
+
+    - an expired weak_ptr keeps the memory of a T made with std::make_shared, the object and
+      the control block are one allocation, until it is swept, a load of big objects should
+      return a std::shared_ptr<T>(new T(...)), then only the control block is kept.
+
+*/
+struct Weak_cache_stats
+{
+    std::uint64_t hits {0};
+    std::uint64_t misses {0};
+    std::uint64_t expired {0};
+    std::uint64_t swept {0};
+
+    double hit_rate() const
+    {
+        const std::uint64_t lookups = this->hits + this->misses + this->expired;
+        return lookups == 0 ? 0.0 : static_cast<double>(this->hits) / lookups;
+    }
+};
+
+template<class Key, class T, class Hash = std::hash<Key>>
+class Weak_cache
+{
+public:
+    using loader_type = std::function<std::shared_ptr<T>(const Key&)>;
+
+    static constexpr std::size_t def_num_shards = 16;
+    static constexpr std::size_t min_sweep = 64;
+
+private:
+    // loading is there while a thread loads the T, the others wait for its future
+    struct Entry
+    {
+        std::weak_ptr<T> object;
+        std::shared_future<std::shared_ptr<T>> loading;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Key, Entry, Hash> entries;
+        std::size_t sweep_at {min_sweep};
+        Weak_cache_stats counts;
+    };
+
+    loader_type load;
+    Hash hash;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& shard_of(const Key& key) const
+    {
+        // the high bits of the hash times the golden ratio, the low ones pick the bucket
+        const std::uint64_t mixed = static_cast<std::uint64_t>(this->hash(key)) * 0x9E3779B97F4A7C15ull;
+        return *this->shards[static_cast<std::size_t>(mixed >> 32) % this->shards.size()];
+    }
+
+    // under the lock of the shard
+    static void sweep(Shard& shard)
+    {
+        for (auto it = shard.entries.begin(); it != shard.entries.end();)
+        {
+            if (!it->second.loading.valid() && it->second.object.expired())
+            {
+                it = shard.entries.erase(it);
+                ++shard.counts.swept;
+            }
+            else
+                ++it;
+        }
+        const std::size_t twice = 2 * shard.entries.size();
+        shard.sweep_at = twice > shard.entries.size() + min_sweep ? twice : shard.entries.size() + min_sweep;
+    }
+
+public:
+    explicit Weak_cache(loader_type load, std::size_t num_shards = def_num_shards, Hash hash = Hash {})
+        : load(std::move(load)), hash(std::move(hash))
+    {
+        num_shards = num_shards == 0 ? 1 : num_shards;
+        for (std::size_t i = 0; i < num_shards; ++i)
+            this->shards.push_back(std::make_unique<Shard>());
+    }
+
+    std::shared_ptr<T> get(const Key& key)
+    {
+        Shard& shard = this->shard_of(key);
+        std::promise<std::shared_ptr<T>> promise;
+        {
+            std::unique_lock<std::mutex> lock {shard.mutex};
+            const auto [it, inserted] = shard.entries.try_emplace(key);
+            Entry& entry = it->second;
+            if (entry.loading.valid())
+            {
+                ++shard.counts.hits;
+                const std::shared_future<std::shared_ptr<T>> loading = entry.loading;
+                lock.unlock();
+                return loading.get();
+            }
+            if (!inserted)
+            {
+                if (std::shared_ptr<T> alive = entry.object.lock())
+                {
+                    ++shard.counts.hits;
+                    return alive;
+                }
+                ++shard.counts.expired;
+            }
+            else
+                ++shard.counts.misses;
+            // a sweep leaves the entry, it is loading
+            entry.loading = promise.get_future().share();
+            if (inserted && shard.entries.size() >= shard.sweep_at)
+                sweep(shard);
+        }
+        std::shared_ptr<T> loaded;
+        try
+        {
+            loaded = this->load(key);
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock {shard.mutex};
+                shard.entries.find(key)->second.loading = {};
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+        {
+            std::lock_guard<std::mutex> lock {shard.mutex};
+            Entry& entry = shard.entries.find(key)->second;
+            entry.object = loaded;
+            entry.loading = {};
+        }
+        promise.set_value(loaded);
+        return loaded;
+    }
+
+    // the one that is loaded, or null, load is not called
+    std::shared_ptr<T> find(const Key& key) const
+    {
+        Shard& shard = this->shard_of(key);
+        std::lock_guard<std::mutex> lock {shard.mutex};
+        const auto it = shard.entries.find(key);
+        return it == shard.entries.end() ? nullptr : it->second.object.lock();
+    }
+
+    // a key that is being loaded stays, its load puts the T in
+    void erase(const Key& key)
+    {
+        Shard& shard = this->shard_of(key);
+        std::lock_guard<std::mutex> lock {shard.mutex};
+        const auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && !it->second.loading.valid())
+            shard.entries.erase(it);
+    }
+
+    void sweep()
+    {
+        for (const std::unique_ptr<Shard>& shard : this->shards)
+        {
+            std::lock_guard<std::mutex> lock {shard->mutex};
+            sweep(*shard);
+        }
+    }
+
+    // the entries, the ones whose T is gone and are not swept yet too
+    std::size_t size() const
+    {
+        std::size_t size {0};
+        for (const std::unique_ptr<Shard>& shard : this->shards)
+        {
+            std::lock_guard<std::mutex> lock {shard->mutex};
+            size += shard->entries.size();
+        }
+        return size;
+    }
+
+    // the sums of the shards, each one read under its lock
+    Weak_cache_stats stats() const
+    {
+        Weak_cache_stats total;
+        for (const std::unique_ptr<Shard>& shard : this->shards)
+        {
+            std::lock_guard<std::mutex> lock {shard->mutex};
+            total.hits += shard->counts.hits;
+            total.misses += shard->counts.misses;
+            total.expired += shard->counts.expired;
+            total.swept += shard->counts.swept;
+        }
+        return total;
+    }
+};
+
+#endif
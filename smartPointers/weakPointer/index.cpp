@@ -16,6 +16,8 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include "Weak_cache.h"
 
 class B;
 
@@ -94,6 +96,23 @@ public:
   ~E() { std::cout << "E destructor" << std::endl; }
 };
 
+// a heavy object that many handlers read, loaded once while any of them holds it
+class Account_snapshot
+{
+private:
+  std::string name;
+  double balance;
+
+public:
+  Account_snapshot(const std::string &name, double balance) : name{name}, balance{balance}
+  {
+    std::cout << "Account_snapshot constructor(" << name << ")" << std::endl;
+  }
+  ~Account_snapshot() { std::cout << "Account_snapshot destructor(" << name << ")" << std::endl; }
+
+  double get_balance() const { return balance; }
+};
+
 int main()
 {
   /*
@@ -170,5 +189,18 @@ int main()
   c_ptr->set_D(d_ptr);
   d_ptr->set_E(e_ptr);
 
+  // the cache holds weak_ptrs, the snapshots live as long as the handlers that use them
+  Weak_cache<std::string, Account_snapshot> snapshots {[](const std::string &name) {
+    return std::shared_ptr<Account_snapshot>(new Account_snapshot(name, 1000.0));
+  }};
+  {
+    std::shared_ptr<Account_snapshot> s1 {snapshots.get("Larry")}; // loaded
+    std::shared_ptr<Account_snapshot> s2 {snapshots.get("Larry")}; // the same one
+    std::cout << "Same snapshot: " << std::boolalpha << (s1 == s2) << std::endl;
+  } // destroyed, the cache does not keep it
+  std::shared_ptr<Account_snapshot> s3 {snapshots.get("Larry")}; // loaded again
+  const Weak_cache_stats stats {snapshots.stats()};
+  std::cout << "Hits: " << stats.hits << ", misses: " << stats.misses << ", expired: " << stats.expired << std::endl;
+
   return 0;
 }
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "Palindrome.h"
+
+namespace
+{
+    bool is_letter(unsigned char c)
+    {
+        const unsigned char lower = c | 0x20;
+        return lower >= 'a' && lower <= 'z';
+    }
+
+    // the same letter in both cases is the same byte, the lower case one
+    char fold(unsigned char c)
+    {
+        return static_cast<char>(c | 0x20);
+    }
+
+    // the letters of [begin, end) from both ends one by one
+    bool is_palindrome_scalar(const char *data, std::size_t begin, std::size_t end)
+    {
+        while (begin < end)
+        {
+            if (!is_letter(data[begin]))
+                ++begin;
+            else if (!is_letter(data[end - 1]))
+                --end;
+            else if (fold(data[begin]) != fold(data[end - 1]))
+                return false;
+            else
+            {
+                ++begin;
+                --end;
+            }
+        }
+        return true;
+    }
+
+#if defined(__SSE2__)
+    // the letters taken out of one block, at most 16
+    struct Letters
+    {
+        char data[16];
+        unsigned int begin;
+        unsigned int end;
+
+        bool is_empty() const { return this->begin == this->end; }
+        unsigned int size() const { return this->end - this->begin; }
+    };
+
+    // every byte | 0x20, and the mask of the bytes that are letters
+    __m128i classify(const char *block, unsigned int &mask)
+    {
+        const __m128i lower = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block)), _mm_set1_epi8(0x20));
+        const __m128i offset = _mm_sub_epi8(lower, _mm_set1_epi8('a'));
+        const __m128i letters = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(25)), offset);
+        mask = static_cast<unsigned int>(_mm_movemask_epi8(letters));
+        return lower;
+    }
+
+    // the bytes in the other order, dwords, then words, then the bytes of every word
+    __m128i reverse(__m128i v)
+    {
+        v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+
+    void take_front(Letters &letters, __m128i folded, unsigned int mask)
+    {
+        char bytes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bytes), folded);
+        letters.begin = letters.end = 0;
+        for (; mask != 0; mask &= mask - 1)
+            letters.data[letters.end++] = bytes[__builtin_ctz(mask)];
+    }
+
+    // from the last byte of the block to the first one
+    void take_back(Letters &letters, __m128i folded, unsigned int mask)
+    {
+        char bytes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bytes), folded);
+        letters.begin = letters.end = 0;
+        while (mask != 0)
+        {
+            const int i = 31 - __builtin_clz(mask);
+            letters.data[letters.end++] = bytes[i];
+            mask ^= 1u << i;
+        }
+    }
+
+    // fewer than 16 bytes are left between the ends, they all go to one side
+    void take_rest(Letters &letters, const char *data, std::size_t &front, std::size_t &back, bool from_front)
+    {
+        letters.begin = letters.end = 0;
+        if (from_front)
+            for (; front < back; ++front)
+            {
+                if (is_letter(data[front]))
+                    letters.data[letters.end++] = fold(data[front]);
+            }
+        else
+            for (; back > front; --back)
+            {
+                if (is_letter(data[back - 1]))
+                    letters.data[letters.end++] = fold(data[back - 1]);
+            }
+    }
+
+    void take(Letters &letters, const char *data, std::size_t &front, std::size_t &back, bool from_front)
+    {
+        if (back - front < 16)
+        {
+            take_rest(letters, data, front, back, from_front);
+            return;
+        }
+
+        // the mask is set by classify, it is read only after it
+        unsigned int mask;
+        if (from_front)
+        {
+            const __m128i block = classify(data + front, mask);
+            take_front(letters, block, mask);
+            front += 16;
+        }
+        else
+        {
+            const __m128i block = classify(data + back - 16, mask);
+            take_back(letters, block, mask);
+            back -= 16;
+        }
+    }
+#endif
+}
+
+/*
+
+    the letters taken from the front are compared with the ones taken from the back, the n-th
+    from the front with the n-th from the back, until the ends meet, what is left on one side
+    is the middle of the string and has to be a palindrome on its own.
+
+*/
+bool is_palindrome(std::string_view text)
+{
+    const char *data = text.data();
+
+#if defined(__SSE2__)
+    std::size_t front = 0, back = text.size();
+    Letters first {{}, 0, 0}, last {{}, 0, 0};
+
+    while (true)
+    {
+        if (first.is_empty() && last.is_empty() && back - front >= 32)
+        {
+            unsigned int front_mask, back_mask;
+            const __m128i front_block = classify(data + front, front_mask);
+            const __m128i back_block = classify(data + back - 16, back_mask);
+            front += 16;
+            back -= 16;
+
+            if ((front_mask & back_mask) == 0xffff)
+            {
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(front_block, reverse(back_block))) != 0xffff)
+                    return false;
+                continue;
+            }
+
+            take_front(first, front_block, front_mask);
+            take_back(last, back_block, back_mask);
+        }
+        else
+        {
+            if (first.is_empty() && front < back)
+                take(first, data, front, back, true);
+            if (last.is_empty() && front < back)
+                take(last, data, front, back, false);
+            if ((first.is_empty() || last.is_empty()) && front >= back)
+                break;
+        }
+
+        const unsigned int n = std::min(first.size(), last.size());
+        if (std::memcmp(first.data + first.begin, last.data + last.begin, n) != 0)
+            return false;
+        first.begin += n;
+        last.begin += n;
+    }
+
+    // the middle, the rest of the front letters and then the rest of the back ones reversed
+    char middle[32];
+    std::size_t size = first.size();
+    std::memcpy(middle, first.data + first.begin, first.size());
+    for (unsigned int i = last.end; i > last.begin; --i)
+        middle[size++] = last.data[i - 1];
+    return is_palindrome_scalar(middle, 0, size);
+#else
+    return is_palindrome_scalar(data, 0, text.size());
+#endif
+}
+
+// the candidates are cut in one range per thread, every thread writes only its own results
+std::vector<std::uint8_t> check_palindromes(const std::vector<std::string_view> &candidates, std::size_t threads)
+{
+    std::vector<std::uint8_t> results(candidates.size());
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, candidates.size()));
+
+    const std::size_t share = (candidates.size() + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (std::size_t begin = 0; begin < candidates.size(); begin += share)
+    {
+        const std::size_t end = std::min(candidates.size(), begin + share);
+        workers.emplace_back([&candidates, &results, begin, end]
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                results[i] = is_palindrome(candidates[i]);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    return results;
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include "Palindrome_finder.h"
+
+namespace
+{
+    bool is_letter(unsigned char c)
+    {
+        const unsigned char lower = c | 0x20;
+        return lower >= 'a' && lower <= 'z';
+    }
+
+    char fold(unsigned char c)
+    {
+        return static_cast<char>(c | 0x20);
+    }
+
+    /*
+
+        odd[i] is the number of odd palindromes around letter i, the longest one is
+        2 * odd[i] - 1 letters, even[i] the number of even ones around the gap before
+        letter i, the longest one is 2 * even[i] letters. a center inside the longest
+        palindrome found so far, the one that reaches the furthest right, starts from its
+        mirror, so every letter is compared as the right end of a palindrome once.
+
+    */
+    void manacher(const char *text, std::size_t size, std::vector<std::uint32_t> &odd, std::vector<std::uint32_t> &even)
+    {
+        odd.resize(size);
+        even.resize(size);
+
+        for (std::size_t i = 0, left = 0, right = 0; i < size; ++i)
+        {
+            std::size_t k = i >= right ? 1 : std::min<std::size_t>(odd[left + right - 1 - i], right - i);
+            while (k <= i && i + k < size && text[i - k] == text[i + k])
+                ++k;
+            odd[i] = static_cast<std::uint32_t>(k);
+            if (i + k > right)
+            {
+                left = i - k + 1;
+                right = i + k;
+            }
+        }
+
+        for (std::size_t i = 0, left = 0, right = 0; i < size; ++i)
+        {
+            std::size_t k = i >= right ? 0 : std::min<std::size_t>(even[left + right - i], right - i);
+            while (k < i && i + k < size && text[i - k - 1] == text[i + k])
+                ++k;
+            even[i] = static_cast<std::uint32_t>(k);
+            if (i + k > right)
+            {
+                left = i - k;
+                right = i + k;
+            }
+        }
+    }
+}
+
+Palindrome_finder::Palindrome_finder(std::size_t min_letters, std::size_t threads, std::size_t batch_letters,
+    std::size_t overlap_letters)
+    : min_letters(std::max<std::size_t>(1, min_letters)), threads(threads), batch_letters(std::max<std::size_t>(1, batch_letters)),
+      overlap_letters(overlap_letters)
+{
+    if (this->threads == 0)
+        this->threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Palindrome_finder::feed(std::string_view text)
+{
+    if (this->finished)
+        throw std::runtime_error("Palindrome_finder: a piece fed after finish");
+
+    // at most a letter a byte, written through pointers and cut to the letters after
+    std::size_t size = this->letters.size();
+    this->letters.resize(size + text.size());
+    this->gaps.resize(size + text.size());
+    char *letters = &this->letters[0];
+    std::uint8_t *gaps = this->gaps.data();
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        const unsigned char c = text[i];
+        if (!is_letter(c))
+            continue;
+
+        const std::uint64_t at = this->num_bytes + i;
+        const std::uint64_t gap = at - this->after_letter;
+        if (size % 64 == 0)
+            this->checkpoints.push_back(at);
+        if (gap >= 255)
+            this->long_gaps.emplace_back(size, gap);
+        gaps[size] = static_cast<std::uint8_t>(std::min<std::uint64_t>(gap, 255));
+        letters[size++] = fold(c);
+        this->after_letter = at + 1;
+    }
+    this->letters.resize(size);
+    this->gaps.resize(size);
+    this->num_bytes += text.size();
+
+    // a batch runs once the letters after it are there for the overlap
+    while (this->letters.size() - this->num_done >= this->batch_letters + this->overlap_letters)
+        this->run(this->num_done + this->batch_letters);
+}
+
+void Palindrome_finder::finish()
+{
+    if (this->finished)
+        return;
+    this->finished = true;
+    this->run(this->letters.size());
+
+    std::vector<Span> &found = this->results.found;
+    std::sort(found.begin(), found.end(), [](const Span &a, const Span &b) { return a.first + a.last < b.first + b.last; });
+    this->palindromes.reserve(found.size());
+    for (const Span &span : found)
+        this->palindromes.push_back(this->to_palindrome(span));
+    std::vector<Span>().swap(found);
+}
+
+// the centers [num_done, end), a part of them on every thread, and first the palindromes that were open
+void Palindrome_finder::run(std::uint64_t end)
+{
+    std::vector<Span> open;
+    open.swap(this->results.open);
+    for (const Span &span : open)
+        this->grow(span, this->results);
+
+    const std::uint64_t begin = this->num_done;
+    const std::size_t parts = static_cast<std::size_t>(std::max<std::uint64_t>(1,
+        std::min<std::uint64_t>(this->threads, (end - begin) / 4096)));
+    std::vector<Results> part_results(parts);
+    const auto bounds = [begin, end, parts](std::size_t part) { return begin + (end - begin) * part / parts; };
+
+    std::vector<std::thread> workers;
+    for (std::size_t part = 1; part < parts; ++part)
+        workers.emplace_back([this, &part_results, &bounds, part] { this->run_part(bounds(part), bounds(part + 1), part_results[part]); });
+    this->run_part(bounds(0), bounds(1), part_results[0]);
+    for (std::thread &worker : workers)
+        worker.join();
+
+    for (Results &part : part_results)
+    {
+        this->results.found.insert(this->results.found.end(), part.found.begin(), part.found.end());
+        for (const Span &span : part.open)
+            this->results.open.push_back(span);
+        if (part.has_longest)
+            Palindrome_finder::keep_longest(part.longest, this->results);
+    }
+    this->num_done = end;
+}
+
+void Palindrome_finder::run_part(std::uint64_t from, std::uint64_t to, Results &part) const
+{
+    if (from == to)
+        return;
+    const std::uint64_t window_first = from - std::min<std::uint64_t>(from, this->overlap_letters);
+    const std::uint64_t window_end = std::min<std::uint64_t>(this->letters.size(), to + this->overlap_letters);
+    std::vector<std::uint32_t> odd, even;
+    manacher(this->letters.data() + window_first, window_end - window_first, odd, even);
+
+    // a palindrome at an end of the window may go on past it, the others are kept only when they
+    // are long enough or longer than the longest so far, the centers come in order
+    const auto take = [&](const Span &span)
+    {
+        if ((span.first == window_first && window_first > 0) || span.last + 1 == window_end)
+            this->grow(span, part);
+        else
+        {
+            const std::uint64_t size = span.last + 1 - span.first;
+            if (size >= this->min_letters || !part.has_longest || size > part.longest.last + 1 - part.longest.first)
+                this->keep(span, part);
+        }
+    };
+
+    for (std::uint64_t center = from; center < to; ++center)
+    {
+        const std::size_t i = center - window_first;
+        take({center - (odd[i] - 1), center + (odd[i] - 1)});
+        if (center > 0)
+            take({center - even[i], center + even[i] - 1});
+    }
+}
+
+void Palindrome_finder::keep(const Span &span, Results &part) const
+{
+    const std::uint64_t size = span.last + 1 - span.first;
+    if (size == 0)
+        return;
+    if (size >= this->min_letters)
+        part.found.push_back(span);
+    Palindrome_finder::keep_longest(span, part);
+}
+
+// the first of the longest ones by center
+void Palindrome_finder::keep_longest(const Span &span, Results &part)
+{
+    const std::uint64_t size = span.last + 1 - span.first;
+    const std::uint64_t longest = part.longest.last + 1 - part.longest.first;
+    if (!part.has_longest || size > longest
+        || (size == longest && span.first + span.last < part.longest.first + part.longest.last))
+    {
+        part.longest = span;
+        part.has_longest = true;
+    }
+}
+
+// one letter at a time on both sides, over all the letters fed so far
+void Palindrome_finder::grow(Span span, Results &part) const
+{
+    const std::uint64_t size = this->letters.size();
+    while (span.first > 0 && span.last + 1 < size && this->letters[span.first - 1] == this->letters[span.last + 1])
+    {
+        --span.first;
+        ++span.last;
+    }
+    if (span.first > 0 && span.last + 1 == size && !this->finished)
+        part.open.push_back(span);
+    else
+        this->keep(span, part);
+}
+
+std::uint64_t Palindrome_finder::get_byte(std::uint64_t letter) const
+{
+    std::uint64_t byte = this->checkpoints[letter / 64];
+    for (std::uint64_t i = letter / 64 * 64 + 1; i <= letter; ++i)
+    {
+        std::uint64_t gap = this->gaps[i];
+        if (gap == 255)
+            gap = std::lower_bound(this->long_gaps.begin(), this->long_gaps.end(), std::make_pair(i, std::uint64_t {0}))->second;
+        byte += gap + 1;
+    }
+    return byte;
+}
+
+Palindrome Palindrome_finder::to_palindrome(const Span &span) const
+{
+    return {this->get_byte(span.first), this->get_byte(span.last) + 1, span.last + 1 - span.first};
+}
+
+const std::vector<Palindrome> &Palindrome_finder::get_palindromes() const
+{
+    return this->palindromes;
+}
+
+Palindrome Palindrome_finder::get_longest() const
+{
+    if (!this->results.has_longest)
+        return {};
+    return this->to_palindrome(this->results.longest);
+}
+
+std::uint64_t Palindrome_finder::get_num_letters() const
+{
+    return this->letters.size();
+}
+
+std::size_t Palindrome_finder::get_bytes() const
+{
+    return this->letters.capacity() + this->gaps.capacity() + this->checkpoints.capacity() * sizeof(std::uint64_t)
+        + this->long_gaps.capacity() * sizeof(this->long_gaps[0]);
+}
+
+std::vector<Palindrome> find_palindromes(std::string_view text, std::size_t min_letters, std::size_t threads)
+{
+    Palindrome_finder finder {min_letters, threads};
+    finder.feed(text);
+    finder.finish();
+    return finder.get_palindromes();
+}
+
+Palindrome find_longest_palindrome(std::string_view text, std::size_t threads)
+{
+    Palindrome_finder finder {std::size_t {0} - 1, threads};
+    finder.feed(text);
+    finder.finish();
+    return finder.get_longest();
+}
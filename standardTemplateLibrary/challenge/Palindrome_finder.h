@@ -0,0 +1,111 @@
+#ifndef _PALINDROME_FINDER_H_
+#define _PALINDROME_FINDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+
+    - Palindrome_finder finds the palindromes inside a text, not only the text as a whole like
+      is_palindrome, with the letters of is_palindrome: the other characters are skipped and
+      the case is ignored, "Madam, I'm Adam" in the middle of a book is one.
+
+    - the text is fed in pieces, a file read a block at a time, the pieces are one text, a
+      palindrome may start in one and end in another. the letters are kept, one byte each,
+      folded to lower case, and one more byte each for the gap to the letter before, to
+      give the palindromes as bytes of the text, the text itself is not kept.
+
+    - every center, a letter or two letters side by side, has one maximal palindrome, the
+      longest one around it. Manacher's algorithm finds all of them in linear time, where
+      growing every center one letter at a time is quadratic for a text like "aaaa...".
+      get_palindromes gives the ones of at least min_letters letters, in the order of their
+      centers, get_longest the first of the longest ones, whatever min_letters is.
+
+    - the letters fed are run in batches of batch_letters, cut in one part per thread, 0 is
+      one thread per hardware thread, every part runs Manacher on its letters and
+      overlap_letters more on both sides. a palindrome that reaches the end of its window
+      goes on one letter at a time over all the letters, and one that reaches the last
+      letter fed waits for the next letters, or for finish. the results are the same with
+      any threads, batch and overlap. the palindromes of a text are short, a few letters,
+      it is linear, a text of long palindromes, a run of a million 'a', is not, every one
+      of them longer than the overlap goes on a letter at a time.
+
+*/
+struct Palindrome
+{
+    std::uint64_t begin {0};    // the byte of the first letter
+    std::uint64_t end {0};      // one after the byte of the last letter
+    std::uint64_t letters {0};
+};
+
+class Palindrome_finder
+{
+private:
+    // the first and the last letter of a palindrome
+    struct Span
+    {
+        std::uint64_t first;
+        std::uint64_t last;
+    };
+
+    std::size_t min_letters;
+    std::size_t threads;
+    std::size_t batch_letters;
+    std::size_t overlap_letters;
+
+    std::string letters;
+    // the byte of every 64th letter, and the bytes before every letter after the one before it
+    std::vector<std::uint64_t> checkpoints;
+    std::vector<std::uint8_t> gaps;
+    // the gaps of 255 bytes or more, by letter
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> long_gaps;
+    std::uint64_t num_bytes {0};
+    std::uint64_t after_letter {0};
+
+    // the palindromes found, the ones at the last letter fed, and the longest one
+    struct Results
+    {
+        std::vector<Span> found;
+        std::vector<Span> open;
+        Span longest {0, 0};
+        bool has_longest {false};
+    };
+
+    std::uint64_t num_done {0};
+    Results results;
+    bool finished {false};
+    std::vector<Palindrome> palindromes;
+
+    void run(std::uint64_t end);
+    void run_part(std::uint64_t from, std::uint64_t to, Results &part) const;
+    void keep(const Span &span, Results &part) const;
+    static void keep_longest(const Span &span, Results &part);
+    void grow(Span span, Results &part) const;
+    std::uint64_t get_byte(std::uint64_t letter) const;
+    Palindrome to_palindrome(const Span &span) const;
+
+public:
+    explicit Palindrome_finder(std::size_t min_letters, std::size_t threads = 0, std::size_t batch_letters = 1 << 22,
+        std::size_t overlap_letters = 1 << 16);
+
+    void feed(std::string_view text);
+    // after the last piece, the palindromes are there only after it
+    void finish();
+
+    const std::vector<Palindrome> &get_palindromes() const;
+    // letters is 0 when there is no letter
+    Palindrome get_longest() const;
+    std::uint64_t get_num_letters() const;
+    // the letters, the gaps and the checkpoints
+    std::size_t get_bytes() const;
+};
+
+std::vector<Palindrome> find_palindromes(std::string_view text, std::size_t min_letters, std::size_t threads = 0);
+
+Palindrome find_longest_palindrome(std::string_view text, std::size_t threads = 0);
+
+#endif
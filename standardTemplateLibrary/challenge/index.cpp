@@ -5,6 +5,10 @@
 #include <cctype>
 #include <deque>
 #include <algorithm>
+#include <iterator>
+#include <string_view>
+#include "Palindrome.h"
+#include "Palindrome_finder.h"
 
 template<typename T>
 void display(const std::deque<T>& dec)
@@ -15,31 +19,10 @@ void display(const std::deque<T>& dec)
     std::cout << "]" << std::endl;
 }
 
-bool is_palindrome(std::string str)
-{
-    std::deque<char> dec;
-
-    for (auto c : str)
-        if (std::isalpha(c))
-            dec.push_back(std::toupper(c));
-
-    while (dec.size() > 1)
-    {
-        if (dec.front() == dec.back())
-        {
-            dec.pop_front();
-            dec.pop_back();
-        }
-        else
-            return false;
-    }
-
-    return true;
-}
-
 int main()
 {
-    std::vector<std::string> vec {"a", "aa", "aba", "abba", "abbcbba", "ab", "abc", "radar", "bob", "ana",
+    // constants of the program, no string made of them at the start
+    static constexpr std::string_view vec[] {"a", "aa", "aba", "abba", "abbcbba", "ab", "abc", "radar", "bob", "ana",
         "avid diva", "Amore, Roma", "A Toyota's a toyota", "A Santa at NASA", "C++",
         "A man, a plan, a cat, a ham, a yak, a yam, a hat, a canal-Panama!", "This is a palindrome", "palindrome"};
 
@@ -47,6 +30,29 @@ int main()
     std::cout << std::setw(8) << std::left << "Result" << "String" << std::endl;
     for (const auto& str : vec)
         std::cout << std::setw(8) << std::left << is_palindrome(str) << str << std::endl;
-    
+
+    // the same strings over and over, a million of them checked on every hardware thread
+    std::vector<std::string_view> candidates;
+    candidates.reserve(1000000);
+    for (std::size_t i = 0; i < 1000000; ++i)
+        candidates.push_back(vec[i % std::size(vec)]);
+
+    const std::vector<std::uint8_t> results = check_palindromes(candidates);
+    std::cout << "\n" << std::count(results.begin(), results.end(), 1) << " of " << candidates.size()
+        << " candidates are palindromes" << std::endl;
+
+    // the palindromes inside a text, of 7 letters or more, fed in two pieces
+    const std::string text {"Did Hannah see bees? Hannah did. Then a man, a plan, a canal: Panama, said Otto to Bob."};
+    Palindrome_finder finder {7};
+    finder.feed(std::string_view(text).substr(0, 40));
+    finder.feed(std::string_view(text).substr(40));
+    finder.finish();
+    std::cout << "\n";
+    for (const Palindrome &palindrome : finder.get_palindromes())
+        std::cout << palindrome.letters << " letters: "
+            << text.substr(palindrome.begin, palindrome.end - palindrome.begin) << std::endl;
+    const Palindrome longest = finder.get_longest();
+    std::cout << "the longest: " << text.substr(longest.begin, longest.end - longest.begin) << std::endl;
+
     return 0;
 }
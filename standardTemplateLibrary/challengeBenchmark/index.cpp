@@ -0,0 +1,157 @@
+/*
+
+    - compares finding the maximal palindromes of a text, the longest one around every
+      center, by growing every center a letter at a time, against Palindrome_finder
+      (../challenge/Palindrome_finder.h), Manacher on 1, 2, 4 and 8 threads, and the text fed
+      in pieces of 64 KB, and checks that they give the same palindromes.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../challenge/Palindrome_finder.cpp
+
+    - the text is words of a few letters and spaces and commas, with "a man, a plan, a
+      canal: Panama" here and there, 64 MB by default, the number of MB can be given on the
+      command line, e.g. ./a.out 1024, and then 1 MB of runs of one letter, 1000 to 3000, where
+      growing every center is quadratic. on one core of an x86-64 at -O2:
+        text, 64 MB          growing 1.9 s      Palindrome_finder 1.5 s, 2.8 bytes a letter
+        runs, 1 MB           growing 1.6 s      Palindrome_finder 0.21 s, 2M palindromes
+      a text of words has short palindromes, growing them costs about what Manacher does,
+      a comparison that is mispredicted at every center, Manacher is there for the texts
+      that have long ones, and the threads for the cores.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../challenge/Palindrome_finder.h"
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// the maximal palindromes of at least min_letters, every center grown a letter at a time
+std::vector<Palindrome> grow_centers(const std::string &text, std::size_t min_letters)
+{
+    std::string letters;
+    std::vector<std::uint64_t> bytes;
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        const unsigned char lower = text[i] | 0x20;
+        if (lower >= 'a' && lower <= 'z')
+        {
+            letters.push_back(static_cast<char>(lower));
+            bytes.push_back(i);
+        }
+    }
+
+    std::vector<Palindrome> palindromes;
+    const auto grow = [&](std::size_t first, std::size_t last)
+    {
+        while (first > 0 && last + 1 < letters.size() && letters[first - 1] == letters[last + 1])
+        {
+            --first;
+            ++last;
+        }
+        if (last + 1 - first >= min_letters)
+            palindromes.push_back({bytes[first], bytes[last] + 1, last + 1 - first});
+    };
+    // in the order of the centers, the even one before a letter comes before it
+    for (std::size_t i = 0; i < letters.size(); ++i)
+    {
+        if (i > 0 && letters[i - 1] == letters[i])
+            grow(i - 1, i);
+        grow(i, i);
+    }
+    return palindromes;
+}
+
+bool same(const std::vector<Palindrome> &a, const std::vector<Palindrome> &b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const Palindrome &x, const Palindrome &y) {
+        return x.begin == y.begin && x.end == y.end && x.letters == y.letters;
+    });
+}
+
+void print(const std::string &name, double seconds, std::size_t found)
+{
+    std::cout << std::setw(36) << std::left << name << std::fixed << std::setprecision(3) << std::setw(10) << std::right
+        << seconds << " s" << std::setw(12) << found << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const std::size_t min_letters = 9;
+
+    std::mt19937_64 gen {11};
+    std::uniform_int_distribution<int> letter {0, 4};
+    std::uniform_int_distribution<int> length {1, 7};
+    std::string text;
+    text.reserve(megabytes << 20);
+    while (text.size() < megabytes << 20)
+    {
+        if (gen() % 1000 == 0)
+            text += "A man, a plan, a canal: Panama! ";
+        for (int i = length(gen); i > 0; --i)
+            text.push_back(static_cast<char>((gen() % 8 == 0 ? 'A' : 'a') + letter(gen)));
+        text += gen() % 5 == 0 ? ", " : " ";
+    }
+
+    std::uniform_int_distribution<std::size_t> run {1000, 3000};
+    std::string runs;
+    while (runs.size() < 1 << 20)
+        runs += std::string(run(gen), static_cast<char>('a' + letter(gen))) + ' ';
+
+    bool failed {false};
+    for (const std::string *input : {&text, &runs})
+    {
+        std::cout << (input == &text ? "the text, " : "the runs, ") << input->size() << " bytes, palindromes of "
+            << min_letters << " letters or more" << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        const std::vector<Palindrome> expected = grow_centers(*input, min_letters);
+        print("growing every center", seconds_since(start), expected.size());
+
+        for (std::size_t threads = 1; threads <= 8; threads *= 2)
+        {
+            start = std::chrono::steady_clock::now();
+            Palindrome_finder finder {min_letters, threads};
+            finder.feed(*input);
+            finder.finish();
+            const double seconds = seconds_since(start);
+            print("Palindrome_finder, " + std::to_string(threads) + " threads", seconds, finder.get_palindromes().size());
+            if (threads == 1)
+                std::cout << "    " << static_cast<double>(finder.get_bytes()) / finder.get_num_letters() << " bytes a letter" << std::endl;
+            if (!same(finder.get_palindromes(), expected))
+            {
+                std::cout << "    the palindromes are not the ones of growing every center" << std::endl;
+                failed = true;
+            }
+        }
+
+        // pieces of 64 KB, and batches and an overlap smaller than a run
+        start = std::chrono::steady_clock::now();
+        Palindrome_finder pieces {min_letters, 4, 1 << 16, 1000};
+        for (std::size_t at = 0; at < input->size(); at += 1 << 16)
+            pieces.feed(std::string_view(*input).substr(at, 1 << 16));
+        pieces.finish();
+        print("Palindrome_finder, pieces of 64 KB", seconds_since(start), pieces.get_palindromes().size());
+        if (!same(pieces.get_palindromes(), expected))
+        {
+            std::cout << "    the palindromes of the pieces are not the ones of growing every center" << std::endl;
+            failed = true;
+        }
+
+        const Palindrome longest = pieces.get_longest();
+        std::cout << "the longest: " << longest.letters << " letters at byte " << longest.begin << std::endl;
+    }
+
+    return failed ? 1 : 0;
+}
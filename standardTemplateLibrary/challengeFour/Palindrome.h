@@ -0,0 +1,31 @@
+#ifndef _PALINDROME_H_
+#define _PALINDROME_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - is_palindrome compares the letters of the string from both ends, the other characters
+      are skipped and the case is ignored, like pushing the std::toupper of every letter into
+      a std::deque and popping both ends, but nothing is copied or allocated.
+
+    - the letters are the ASCII ones, as std::isalpha in the "C" locale, a byte over 127 is
+      not a letter.
+
+    - with SSE2 the string is read 16 bytes at a time from the front and from the back, when
+      both blocks are only letters the back one is reversed in its register and compared in
+      one go, otherwise the letters of a block are taken out of it by its mask into a small
+      buffer on the stack.
+
+    - check_palindromes checks many strings on threads, 0 is one thread per hardware thread,
+      the result of candidates[i] is results[i], 1 for a palindrome.
+
+*/
+bool is_palindrome(std::string_view text);
+
+std::vector<std::uint8_t> check_palindromes(const std::vector<std::string_view> &candidates, std::size_t threads = 0);
+
+#endif
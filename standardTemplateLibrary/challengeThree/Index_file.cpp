@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Index_file.h"
+
+namespace
+{
+    constexpr char magic[8] = {'w', 'o', 'r', 'd', 'I', 'd', 'x', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::uint32_t byte_order = 0x01020304;
+    // a damaged block reads at most 127 varints, the zeros after the lists end every one of them
+    constexpr std::size_t padding = 128;
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t num_words;
+        std::uint64_t num_skips;
+        std::uint64_t names_size;
+        std::uint64_t num_bytes;
+        std::uint64_t size;
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 64, "the header is 64 bytes on disk");
+
+    struct Layout
+    {
+        std::uint64_t terms;
+        std::uint64_t skips;
+        std::uint64_t names;
+        std::uint64_t bytes;
+        std::uint64_t size;
+    };
+
+    // every section starts 8 byte aligned
+    Layout get_layout(const Header &header)
+    {
+        Layout layout;
+        layout.terms = sizeof(Header);
+        layout.skips = layout.terms + header.num_words * 32;
+        layout.names = layout.skips + header.num_skips * 16;
+        layout.bytes = (layout.names + header.names_size + 7) & ~std::uint64_t{7};
+        layout.size = layout.bytes + header.num_bytes + padding;
+        return layout;
+    }
+
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    void invalid(const std::string &path, const std::string &why)
+    {
+        throw std::runtime_error(path + ": not an index file, " + why);
+    }
+}
+
+// the words are written in their sorted order, the lists stay where they are
+void Index_file::write(const Inverted_index &index, const std::string &path)
+{
+    static_assert(sizeof(Term) == 32, "a term is 32 bytes on disk");
+    static_assert(sizeof(Posting_cursor::Skip) == 16 && offsetof(Posting_cursor::Skip, offset) == 8, "a skip is 16 bytes on disk");
+
+    const std::vector<std::uint32_t> &sorted = index.sorted();
+
+    Header header {};
+    std::memcpy(header.magic, magic, sizeof magic);
+    header.version = version;
+    header.byte_order = byte_order;
+    header.num_words = sorted.size();
+    header.num_skips = index.skips.size();
+    header.num_bytes = index.bytes.size();
+    for (std::uint32_t id : sorted)
+        header.names_size += index.get_word(id).size();
+
+    const Layout layout = get_layout(header);
+    header.size = layout.size;
+
+    std::string file(layout.size, '\0');
+    std::memcpy(&file[0], &header, sizeof header);
+
+    std::uint64_t name = 0;
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        const std::string_view word = index.get_word(sorted[i]);
+        Term term {};
+        term.name = name;
+        term.length = static_cast<std::uint32_t>(word.size());
+        term.skip = index.postings[sorted[i]].skip;
+        term.count = index.postings[sorted[i]].count;
+        std::memcpy(&file[layout.terms + i * sizeof term], &term, sizeof term);
+        if (!word.empty())
+            std::memcpy(&file[layout.names + name], word.data(), word.size());
+        name += word.size();
+    }
+
+    // field by field, the padding of a Skip is not written as it is in memory
+    for (std::size_t i = 0; i < index.skips.size(); ++i)
+    {
+        std::memcpy(&file[layout.skips + i * 16], &index.skips[i].first, 4);
+        std::memcpy(&file[layout.skips + i * 16 + 8], &index.skips[i].offset, 8);
+    }
+
+    if (!index.bytes.empty())
+        std::memcpy(&file[layout.bytes], index.bytes.data(), index.bytes.size());
+
+    std::ofstream out {path, std::ios::binary | std::ios::trunc};
+    if (!out)
+        fail("open " + path);
+    out.write(file.data(), static_cast<std::streamsize>(file.size()));
+    out.close();
+    if (!out)
+        fail("write " + path);
+}
+
+Index_file::Index_file(const std::string &path)
+    : fd{-1}, data{nullptr}, size{0}, terms{nullptr}, num_words{0}, skips{nullptr}, names{nullptr}, bytes{nullptr}, num_skips{0}, num_bytes{0}
+{
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0)
+        fail("open " + path);
+
+    struct stat st;
+    if (::fstat(this->fd, &st) < 0)
+    {
+        int error = errno;
+        ::close(this->fd);
+        errno = error;
+        fail("stat " + path);
+    }
+    this->size = static_cast<std::size_t>(st.st_size);
+
+    if (this->size > 0)
+    {
+        void *ptr = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(this->fd);
+            errno = error;
+            fail("mmap " + path);
+        }
+        this->data = static_cast<const char *>(ptr);
+    }
+
+    try
+    {
+        this->check(path);
+    }
+    catch (...)
+    {
+        if (this->data != nullptr)
+            ::munmap(const_cast<char *>(this->data), this->size);
+        ::close(this->fd);
+        throw;
+    }
+}
+
+Index_file::~Index_file()
+{
+    if (this->data != nullptr)
+        ::munmap(const_cast<char *>(this->data), this->size);
+    ::close(this->fd);
+}
+
+void Index_file::check(const std::string &path)
+{
+    Header header;
+    if (this->size < sizeof header)
+        invalid(path, "too short for a header");
+    std::memcpy(&header, this->data, sizeof header);
+
+    if (std::memcmp(header.magic, magic, sizeof magic) != 0)
+        invalid(path, "no magic");
+    if (header.byte_order != byte_order)
+        invalid(path, "written in another byte order");
+    if (header.version != version)
+        invalid(path, "version " + std::to_string(header.version) + " is not " + std::to_string(version));
+    if (header.size != this->size)
+        invalid(path, "the size is not the one in the header");
+
+    // the sizes are checked against the file one by one, so the layout can't overflow
+    const std::uint64_t limit = this->size;
+    if (header.num_words > limit / 32 || header.num_skips > limit / 16 || header.names_size > limit || header.num_bytes > limit)
+        invalid(path, "a section is larger than the file");
+    const Layout layout = get_layout(header);
+    if (layout.size != this->size)
+        invalid(path, "the sections are not as long as the file");
+
+    this->num_words = static_cast<std::size_t>(header.num_words);
+    this->terms = reinterpret_cast<const Term *>(this->data + layout.terms);
+    this->skips = reinterpret_cast<const Posting_cursor::Skip *>(this->data + layout.skips);
+    this->names = this->data + layout.names;
+    this->bytes = reinterpret_cast<const std::uint8_t *>(this->data + layout.bytes);
+    this->num_skips = static_cast<std::size_t>(header.num_skips);
+    this->num_bytes = static_cast<std::size_t>(header.num_bytes);
+
+    for (std::size_t i = 0; i < this->num_words; ++i)
+    {
+        const Term &term = this->terms[i];
+        const std::uint64_t num_blocks = (term.count + Posting_cursor::block_size - 1) / Posting_cursor::block_size;
+        if (term.name > header.names_size || term.length > header.names_size - term.name)
+            invalid(path, "a name is out of the names");
+        if (term.count == 0 || term.skip > header.num_skips || num_blocks > header.num_skips - term.skip)
+            invalid(path, "a list is out of the skips");
+    }
+
+    for (std::uint64_t i = 0; i < header.num_skips; ++i)
+        if (this->skips[i].offset > header.num_bytes)
+            invalid(path, "a skip is out of the lists");
+}
+
+std::string_view Index_file::get_name(const Term &term) const
+{
+    return {this->names + term.name, term.length};
+}
+
+std::size_t Index_file::get_num_words() const
+{
+    return this->num_words;
+}
+
+std::string_view Index_file::get_word(std::size_t i) const
+{
+    return this->get_name(this->terms[i]);
+}
+
+const Index_file::Term *Index_file::find(std::string_view word) const
+{
+    const Term *end = this->terms + this->num_words;
+    const Term *term = std::lower_bound(this->terms, end, word, [this](const Term &term, std::string_view value)
+    {
+        return this->get_name(term) < value;
+    });
+
+    if (term == end || this->get_name(*term) != word)
+        return nullptr;
+    return term;
+}
+
+Posting_cursor Index_file::cursor(std::string_view word) const
+{
+    const Term *term = this->find(word);
+    if (term == nullptr)
+        return Posting_cursor{nullptr, nullptr, 0};
+    return Posting_cursor{this->skips + term->skip, this->bytes, static_cast<std::size_t>(term->count)};
+}
+
+// the lists are in the order of their skips, a list ends where the first skip after it starts
+Index_file::Raw_list Index_file::raw_list(std::string_view word) const
+{
+    const Term *term = this->find(word);
+    if (term == nullptr)
+        return Raw_list{nullptr, 0, nullptr, 0, 0};
+
+    const std::size_t first = static_cast<std::size_t>(term->skip);
+    const std::size_t num_blocks = static_cast<std::size_t>((term->count + Posting_cursor::block_size - 1) / Posting_cursor::block_size);
+    const std::size_t begin = static_cast<std::size_t>(this->skips[first].offset);
+    std::size_t end = first + num_blocks < this->num_skips ? static_cast<std::size_t>(this->skips[first + num_blocks].offset) : this->num_bytes;
+    // a damaged file, the skips are not in order
+    if (end < begin)
+        end = begin;
+    return Raw_list{reinterpret_cast<const char *>(this->skips + first), num_blocks,
+        reinterpret_cast<const char *>(this->bytes) + begin, end - begin, static_cast<std::size_t>(term->count)};
+}
+
+std::vector<std::uint32_t> Index_file::lines_of(std::string_view word) const
+{
+    std::vector<std::uint32_t> lines;
+    Posting_cursor cursor = this->cursor(word);
+    lines.reserve(cursor.size());
+    for (; !cursor.is_done(); cursor.next())
+        lines.push_back(cursor.value());
+    return lines;
+}
+
+std::vector<std::uint32_t> Index_file::query_and(const std::vector<std::string_view> &words) const
+{
+    std::vector<Posting_cursor> cursors;
+    for (std::string_view word : words)
+        cursors.push_back(this->cursor(word));
+    return intersect_lines(cursors);
+}
+
+std::vector<std::uint32_t> Index_file::query_or(const std::vector<std::string_view> &words) const
+{
+    std::vector<Posting_cursor> cursors;
+    for (std::string_view word : words)
+        cursors.push_back(this->cursor(word));
+    return unite_lines(cursors);
+}
@@ -0,0 +1,92 @@
+#ifndef _INDEX_FILE_H_
+#define _INDEX_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Inverted_index.h"
+
+/*
+
+    - an index file is an Inverted_index written to disk: a header, the words in their
+      sorted order, each one with where its name is and where its posting list starts,
+      the skips of all the lists, the names, and the varints of all the lists.
+
+    - Index_file maps the file and reads nothing else, a word is found by a binary search
+      of the sorted words, and its lines are read from the mapping with a Posting_cursor,
+      so opening the index of a large text costs a few pages, not reading the text.
+
+    - the header and the bounds of every word and skip are checked when the file is
+      opened, the varints are not, a damaged list gives wrong lines but is never read past
+      the mapping. the numbers are in the byte order of the machine, errors throw
+      std::runtime_error.
+
+    - raw_list is the packed list of a word where it is in the mapping, its skips and its
+      varints, for a server that sends it as it is, see Query_server.h, the offsets of the
+      skips are the ones of the file, they are from the start of the varints of every list.
+
+*/
+class Index_file
+{
+private:
+    struct Term
+    {
+        std::uint64_t name;  // where the name is in the names
+        std::uint32_t length;
+        std::uint32_t reserved;
+        std::uint64_t skip;  // the first skip of the word
+        std::uint64_t count;
+    };
+
+    int fd;
+    const char *data;
+    std::size_t size;
+    const Term *terms;
+    std::size_t num_words;
+    const Posting_cursor::Skip *skips;
+    const char *names;
+    const std::uint8_t *bytes;
+    std::size_t num_skips;
+    std::size_t num_bytes;
+
+    void check(const std::string &path);
+    std::string_view get_name(const Term &term) const;
+    const Term *find(std::string_view word) const;
+
+public:
+    // the index has to be finished
+    static void write(const Inverted_index &index, const std::string &path);
+
+    explicit Index_file(const std::string &path);
+    ~Index_file();
+
+    Index_file(const Index_file &) = delete;
+    Index_file &operator=(const Index_file &) = delete;
+
+    std::size_t get_num_words() const;
+    // the i-th word in sorted order
+    std::string_view get_word(std::size_t i) const;
+
+    // a word that is not in the index has an empty cursor
+    Posting_cursor cursor(std::string_view word) const;
+
+    struct Raw_list
+    {
+        const char *skips;  // 16 bytes each, the line of 4 bytes, 4 of padding, the offset of 8
+        std::size_t num_skips;
+        const char *bytes;
+        std::size_t num_bytes;
+        std::size_t count;
+    };
+
+    // a word that is not in the index has a list of no lines
+    Raw_list raw_list(std::string_view word) const;
+
+    std::vector<std::uint32_t> lines_of(std::string_view word) const;
+    std::vector<std::uint32_t> query_and(const std::vector<std::string_view> &words) const;
+    std::vector<std::uint32_t> query_or(const std::vector<std::string_view> &words) const;
+};
+
+#endif
@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include "Inverted_index.h"
+#include "../../tooling/tracing/Trace.h"
+
+namespace
+{
+    void put_varint(std::vector<std::uint8_t> &bytes, std::uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // the bits past 32 of a damaged varint are dropped
+    std::uint32_t get_varint(const std::uint8_t *&at)
+    {
+        std::uint32_t value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            const std::uint8_t byte = *at++;
+            if (shift < 32)
+                value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+    }
+}
+
+Posting_cursor::Posting_cursor(const Skip *skips, const std::uint8_t *bytes, std::size_t count)
+    : skips{skips}, bytes{bytes}, count{count}, position{0}, at{nullptr}, line{0}
+{
+    if (count > 0)
+        this->enter_block(0);
+}
+
+void Posting_cursor::enter_block(std::size_t block)
+{
+    this->position = block * block_size;
+    this->line = this->skips[block].first;
+    this->at = this->bytes + this->skips[block].offset;
+}
+
+void Posting_cursor::next()
+{
+    if (++this->position == this->count)
+        return;
+    if (this->position % block_size == 0)
+        this->enter_block(this->position / block_size);
+    else
+        this->line += get_varint(this->at);
+}
+
+void Posting_cursor::advance_to(std::uint32_t target)
+{
+    if (this->is_done() || this->line >= target)
+        return;
+
+    const std::size_t num_blocks = (this->count + block_size - 1) / block_size;
+    const std::size_t block = this->position / block_size;
+
+    if (block + 1 < num_blocks && this->skips[block + 1].first <= target)
+    {
+        // lo is a block that starts at or before target, hi is past it or past the last block
+        std::size_t lo = block + 1;
+        std::size_t step = 1;
+        std::size_t hi = lo + step;
+        while (hi < num_blocks && this->skips[hi].first <= target)
+        {
+            lo = hi;
+            step *= 2;
+            hi = lo + step;
+        }
+        hi = std::min(hi, num_blocks);
+
+        const Skip *after = std::upper_bound(this->skips + lo, this->skips + hi, target, [](std::uint32_t value, const Skip &skip)
+        {
+            return value < skip.first;
+        });
+        this->enter_block(static_cast<std::size_t>(after - this->skips) - 1);
+    }
+
+    while (!this->is_done() && this->line < target)
+        this->next();
+}
+
+Inverted_index::Inverted_index() : finished{false}
+{
+}
+
+void Inverted_index::add(std::string_view word, std::uint32_t line)
+{
+    if (this->finished)
+        throw std::runtime_error("the index is finished, no line can be added");
+
+    const std::uint32_t id = this->vocabulary.add(word);
+    if (id == this->lists.size())
+        this->lists.push_back(List{{}, {}, 0, 0});
+
+    this->add_line(this->lists[id], line);
+}
+
+void Inverted_index::add_line(List &list, std::uint32_t line)
+{
+    if (list.count > 0 && line <= list.last)
+    {
+        if (line == list.last)
+            return;
+        throw std::runtime_error("the lines of a word are added in order");
+    }
+
+    if (list.count % Posting_cursor::block_size == 0)
+        list.skips.push_back(Skip{line, list.bytes.size()});
+    else
+        put_varint(list.bytes, line - list.last);
+    list.last = line;
+    ++list.count;
+}
+
+void Inverted_index::append(const Inverted_index &other, std::uint32_t line_offset)
+{
+    if (this->finished)
+        throw std::runtime_error("the index is finished, no line can be added");
+
+    for (std::uint32_t id = 0; id < other.get_num_words(); ++id)
+    {
+        const std::string_view word = other.vocabulary.get_word(id);
+        const std::uint32_t to = this->vocabulary.add(word, other.vocabulary.get_count(word));
+        if (to == this->lists.size())
+            this->lists.push_back(List{{}, {}, 0, 0});
+
+        List &list = this->lists[to];
+        for (Posting_cursor cursor = other.cursor(id); !cursor.is_done(); cursor.next())
+            this->add_line(list, cursor.value() + line_offset);
+    }
+}
+
+// the lists are moved into the two buffers and the words sorted once
+void Inverted_index::finish()
+{
+    if (this->finished)
+        return;
+    TRACE_SCOPE("finish_index");
+
+    std::size_t num_skips = 0, num_bytes = 0;
+    for (const List &list : this->lists)
+    {
+        num_skips += list.skips.size();
+        num_bytes += list.bytes.size();
+    }
+    this->skips.resize(num_skips);
+    this->bytes.resize(num_bytes);
+    this->postings.reserve(this->lists.size());
+
+    std::size_t skip = 0, byte = 0;
+    for (List &list : this->lists)
+    {
+        this->postings.push_back(Posting{skip, list.count});
+        for (const Skip &list_skip : list.skips)
+            this->skips[skip++] = Skip{list_skip.first, list_skip.offset + byte};
+        if (!list.bytes.empty())
+            std::memcpy(this->bytes.data() + byte, list.bytes.data(), list.bytes.size());
+        byte += list.bytes.size();
+        list = List{};
+    }
+    std::vector<List>().swap(this->lists);
+
+    this->sorted_ids.resize(this->postings.size());
+    for (std::uint32_t id = 0; id < this->sorted_ids.size(); ++id)
+        this->sorted_ids[id] = id;
+    std::sort(this->sorted_ids.begin(), this->sorted_ids.end(), [this](std::uint32_t a, std::uint32_t b)
+    {
+        return this->vocabulary.get_word(a) < this->vocabulary.get_word(b);
+    });
+
+    this->finished = true;
+}
+
+void Inverted_index::check_finished() const
+{
+    if (!this->finished)
+        throw std::runtime_error("the index is not finished");
+}
+
+std::size_t Inverted_index::get_num_words() const
+{
+    return this->vocabulary.size();
+}
+
+std::string_view Inverted_index::get_word(std::uint32_t id) const
+{
+    return this->vocabulary.get_word(id);
+}
+
+const std::vector<std::uint32_t> &Inverted_index::sorted() const
+{
+    this->check_finished();
+    return this->sorted_ids;
+}
+
+std::size_t Inverted_index::get_memory() const
+{
+    return this->bytes.size() + this->skips.size() * sizeof(Skip) + this->postings.size() * sizeof(Posting);
+}
+
+// a list that is not finished is read with a cursor too, its skips point into its own bytes
+Posting_cursor Inverted_index::cursor(std::uint32_t id) const
+{
+    if (!this->finished)
+    {
+        const List &list = this->lists[id];
+        return Posting_cursor{list.skips.data(), list.bytes.data(), list.count};
+    }
+
+    const Posting &posting = this->postings[id];
+    return Posting_cursor{this->skips.data() + posting.skip, this->bytes.data(), posting.count};
+}
+
+Posting_cursor Inverted_index::cursor(std::string_view word) const
+{
+    const std::uint32_t id = this->vocabulary.get_id(word);
+    if (id == Word_counter::no_word)
+        return Posting_cursor{nullptr, nullptr, 0};
+    return this->cursor(id);
+}
+
+std::vector<std::uint32_t> Inverted_index::lines_of(std::string_view word) const
+{
+    std::vector<std::uint32_t> lines;
+    Posting_cursor cursor = this->cursor(word);
+    lines.reserve(cursor.size());
+    for (; !cursor.is_done(); cursor.next())
+        lines.push_back(cursor.value());
+    return lines;
+}
+
+std::vector<std::uint32_t> Inverted_index::query_and(const std::vector<std::string_view> &words) const
+{
+    std::vector<Posting_cursor> cursors;
+    for (std::string_view word : words)
+        cursors.push_back(this->cursor(word));
+    return intersect_lines(cursors);
+}
+
+std::vector<std::uint32_t> Inverted_index::query_or(const std::vector<std::string_view> &words) const
+{
+    std::vector<Posting_cursor> cursors;
+    for (std::string_view word : words)
+        cursors.push_back(this->cursor(word));
+    return unite_lines(cursors);
+}
+
+// the words with the prefix are one range of the sorted words
+std::vector<std::uint32_t> Inverted_index::query_prefix(std::string_view prefix) const
+{
+    this->check_finished();
+    auto first = std::lower_bound(this->sorted_ids.begin(), this->sorted_ids.end(), prefix, [this](std::uint32_t id, std::string_view value)
+    {
+        return this->vocabulary.get_word(id) < value;
+    });
+
+    std::vector<Posting_cursor> cursors;
+    for (auto it = first; it != this->sorted_ids.end() && this->vocabulary.get_word(*it).substr(0, prefix.size()) == prefix; ++it)
+        cursors.push_back(this->cursor(*it));
+    return unite_lines(cursors);
+}
+
+// the shortest list leads, every line it has is looked for in the others
+std::vector<std::uint32_t> intersect_lines(std::vector<Posting_cursor> &cursors)
+{
+    std::vector<std::uint32_t> lines;
+    if (cursors.empty())
+        return lines;
+
+    std::sort(cursors.begin(), cursors.end(), [](const Posting_cursor &a, const Posting_cursor &b)
+    {
+        return a.size() < b.size();
+    });
+
+    Posting_cursor &lead = cursors.front();
+    while (!lead.is_done())
+    {
+        const std::uint32_t target = lead.value();
+        bool found = true;
+
+        for (std::size_t i = 1; i < cursors.size(); ++i)
+        {
+            cursors[i].advance_to(target);
+            if (cursors[i].is_done())
+                return lines;
+            if (cursors[i].value() != target)
+            {
+                lead.advance_to(cursors[i].value());
+                found = false;
+                break;
+            }
+        }
+
+        if (found)
+        {
+            lines.push_back(target);
+            lead.next();
+        }
+    }
+    return lines;
+}
+
+// a heap of the cursors by their line, a line on many lists is kept once
+std::vector<std::uint32_t> unite_lines(std::vector<Posting_cursor> &cursors)
+{
+    using Entry = std::pair<std::uint32_t, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for (std::size_t i = 0; i < cursors.size(); ++i)
+        if (!cursors[i].is_done())
+            heap.push({cursors[i].value(), i});
+
+    std::vector<std::uint32_t> lines;
+    while (!heap.empty())
+    {
+        const Entry top = heap.top();
+        heap.pop();
+        if (lines.empty() || lines.back() != top.first)
+            lines.push_back(top.first);
+
+        Posting_cursor &cursor = cursors[top.second];
+        cursor.next();
+        if (!cursor.is_done())
+            heap.push({cursor.value(), top.second});
+    }
+    return lines;
+}
@@ -0,0 +1,137 @@
+#ifndef _INVERTED_INDEX_H_
+#define _INVERTED_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Word_counter.h"
+#include "../../tooling/largeBuffer/Large_buffer.h"
+
+/*
+
+    - Inverted_index keeps for every word the sorted line numbers it is on, its posting
+      list, in place of a std::map<std::string, std::set<int>> with a tree node per line.
+
+    - a list is cut into blocks of 128 lines, the first line of every block is in a skip
+      entry, the others are the differences to the line before, as varints, 1 byte for a
+      difference under 128. the lists of all the words are in one buffer, the skips in
+      another, both large_buffer::Vectors, filled by finish without zeroing them first and in
+      huge pages once they are a few MB.
+
+    - a Posting_cursor walks one list, advance_to gallops over the skips, doubling the
+      step, then searches the blocks it jumped over and decodes only the block the line
+      is in, so the lines of a long list that are not needed are not read.
+
+    - query_and walks the shortest list and advances the others to each of its lines,
+      query_or merges the lists, query_prefix is query_or of every word with the prefix,
+      for a search as you type.
+
+    - the lines of a word are added in order, a line again is ignored, a smaller one throws
+      std::runtime_error. finish packs the lists and sorts the words, it is called once,
+      sorted and query_prefix need it, the other queries read the lists as they are too.
+
+    - append adds the lines of another index, finished or not, moved by an offset, so the
+      chunks of a text can be indexed on their own threads, their lines counted from 1, and
+      appended in order, see Parallel_count.h, or segments merged, see Live_index.h.
+
+*/
+class Inverted_index;
+class Index_file;
+
+class Posting_cursor
+{
+private:
+    static constexpr std::size_t block_size = 128;
+
+    struct Skip
+    {
+        std::uint32_t first;
+        std::uint64_t offset;  // where the differences of the block are in the buffer
+    };
+
+    friend class Inverted_index;
+    friend class Index_file;
+
+    const Skip *skips;
+    const std::uint8_t *bytes;
+    std::size_t count;
+    std::size_t position;      // count when the cursor is done
+    const std::uint8_t *at;    // the difference to the next line
+    std::uint32_t line;
+
+    Posting_cursor(const Skip *skips, const std::uint8_t *bytes, std::size_t count);
+    void enter_block(std::size_t block);
+
+public:
+    bool is_done() const { return this->position == this->count; }
+    std::uint32_t value() const { return this->line; }
+    std::size_t size() const { return this->count; }
+
+    void next();
+    // the first line not less than target
+    void advance_to(std::uint32_t target);
+};
+
+class Inverted_index
+{
+private:
+    using Skip = Posting_cursor::Skip;
+
+    struct List
+    {
+        std::vector<std::uint8_t> bytes;  // until finish
+        std::vector<Skip> skips;
+        std::uint32_t last;
+        std::uint64_t count;
+    };
+
+    struct Posting
+    {
+        std::uint64_t skip;  // the first skip of the word
+        std::uint64_t count;
+    };
+
+    Word_counter vocabulary;
+    std::vector<List> lists;     // by id, until finish
+    std::vector<Posting> postings;  // by id
+    large_buffer::Vector<Skip> skips;
+    large_buffer::Vector<std::uint8_t> bytes;
+    std::vector<std::uint32_t> sorted_ids;
+    bool finished;
+
+    friend class Index_file;
+
+    void check_finished() const;
+    void add_line(List &list, std::uint32_t line);
+
+public:
+    Inverted_index();
+
+    void add(std::string_view word, std::uint32_t line);
+    // the lines of other are after the ones of this index once moved by line_offset
+    void append(const Inverted_index &other, std::uint32_t line_offset);
+    void finish();
+
+    std::size_t get_num_words() const;
+    std::string_view get_word(std::uint32_t id) const;
+    // the ids in the order of the words
+    const std::vector<std::uint32_t> &sorted() const;
+    // the bytes of the lists and the skips, not of the words
+    std::size_t get_memory() const;
+
+    // a word that is not in the index has an empty cursor
+    Posting_cursor cursor(std::uint32_t id) const;
+    Posting_cursor cursor(std::string_view word) const;
+
+    std::vector<std::uint32_t> lines_of(std::string_view word) const;
+    std::vector<std::uint32_t> query_and(const std::vector<std::string_view> &words) const;
+    std::vector<std::uint32_t> query_or(const std::vector<std::string_view> &words) const;
+    std::vector<std::uint32_t> query_prefix(std::string_view prefix) const;
+};
+
+// the lines on every list, and on any list, of the cursors, see query_and and query_or
+std::vector<std::uint32_t> intersect_lines(std::vector<Posting_cursor> &cursors);
+std::vector<std::uint32_t> unite_lines(std::vector<Posting_cursor> &cursors);
+
+#endif
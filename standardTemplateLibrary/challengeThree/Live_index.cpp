@@ -0,0 +1,164 @@
+#include <cstring>
+#include <utility>
+#include "Live_index.h"
+
+Live_index::Live_index(std::size_t delta_limit)
+    : delta_limit{delta_limit == 0 ? 1 : delta_limit}, delta{std::make_unique<Inverted_index>()},
+      delta_lines{0}, num_lines{0}, stopping{false}, tokenizer{""}
+{
+    this->merger = std::thread {&Live_index::merge_loop, this};
+}
+
+Live_index::~Live_index()
+{
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        this->stopping = true;
+    }
+    this->wake.notify_one();
+    this->merger.join();
+}
+
+// the lock is held, an empty delta is not frozen
+void Live_index::freeze()
+{
+    if (this->delta_lines == 0)
+        return;
+
+    this->delta->finish();
+    this->frozen.push_back(std::shared_ptr<const Inverted_index>{std::move(this->delta)});
+    this->delta = std::make_unique<Inverted_index>();
+    this->delta_lines = 0;
+    this->wake.notify_one();
+}
+
+// every frozen segment there is when a merge starts goes into the new main segment,
+// the ones frozen while it runs wait for the next merge
+void Live_index::merge_loop()
+{
+    std::unique_lock<std::mutex> lock {this->mutex};
+
+    while (true)
+    {
+        this->wake.wait(lock, [this] { return this->stopping || !this->frozen.empty(); });
+        if (this->stopping)
+            return;
+
+        const std::shared_ptr<const Inverted_index> base = this->main;
+        const std::vector<std::shared_ptr<const Inverted_index>> segments = this->frozen;
+        lock.unlock();
+
+        try
+        {
+            auto next = std::make_unique<Inverted_index>();
+            if (base)
+                next->append(*base, 0);
+            for (const auto &segment : segments)
+                next->append(*segment, 0);
+            next->finish();
+
+            lock.lock();
+            this->main = std::move(next);
+            this->frozen.erase(this->frozen.begin(), this->frozen.begin() + static_cast<std::ptrdiff_t>(segments.size()));
+        }
+        catch (...)
+        {
+            // the segments stay as they are, the queries are still right, only slower
+            if (!lock.owns_lock())
+                lock.lock();
+            this->error = std::current_exception();
+            this->merged.notify_all();
+            return;
+        }
+
+        this->merged.notify_all();
+    }
+}
+
+std::uint32_t Live_index::add_line(std::string_view line)
+{
+    std::lock_guard<std::mutex> lock {this->mutex};
+    const std::uint32_t line_number = ++this->num_lines;
+
+    std::string_view word;
+    this->tokenizer.reset(line);
+    while (this->tokenizer.next(word))
+        this->delta->add(word, line_number);
+
+    if (++this->delta_lines >= this->delta_limit)
+        this->freeze();
+    return line_number;
+}
+
+void Live_index::add_text(std::string_view text)
+{
+    while (!text.empty())
+    {
+        const void *newline = std::memchr(text.data(), '\n', text.size());
+        const std::size_t size = newline == nullptr ? text.size() : static_cast<std::size_t>(static_cast<const char *>(newline) - text.data());
+
+        this->add_line(text.substr(0, size));
+        text.remove_prefix(newline == nullptr ? size : size + 1);
+    }
+}
+
+void Live_index::flush()
+{
+    std::unique_lock<std::mutex> lock {this->mutex};
+    this->freeze();
+    this->merged.wait(lock, [this] { return this->error || this->frozen.empty(); });
+    if (this->error)
+        std::rethrow_exception(this->error);
+}
+
+std::uint32_t Live_index::get_num_lines() const
+{
+    std::lock_guard<std::mutex> lock {this->mutex};
+    return this->num_lines;
+}
+
+std::size_t Live_index::get_num_segments() const
+{
+    std::lock_guard<std::mutex> lock {this->mutex};
+    return (this->main ? 1 : 0) + this->frozen.size() + (this->delta_lines > 0 ? 1 : 0);
+}
+
+// the delta is read under the lock, the shared segments after it, the lines of the main
+// segment are before the ones of the frozen segments, and those before the delta
+template<typename Query>
+std::vector<std::uint32_t> Live_index::run(Query query) const
+{
+    std::vector<std::shared_ptr<const Inverted_index>> segments;
+    std::vector<std::uint32_t> delta_lines;
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        if (this->main)
+            segments.push_back(this->main);
+        segments.insert(segments.end(), this->frozen.begin(), this->frozen.end());
+        delta_lines = query(*this->delta);
+    }
+
+    std::vector<std::uint32_t> lines;
+    for (const auto &segment : segments)
+    {
+        const std::vector<std::uint32_t> segment_lines = query(*segment);
+        lines.insert(lines.end(), segment_lines.begin(), segment_lines.end());
+    }
+    lines.insert(lines.end(), delta_lines.begin(), delta_lines.end());
+    return lines;
+}
+
+std::vector<std::uint32_t> Live_index::lines_of(std::string_view word) const
+{
+    return this->run([word](const Inverted_index &index) { return index.lines_of(word); });
+}
+
+std::vector<std::uint32_t> Live_index::query_and(const std::vector<std::string_view> &words) const
+{
+    return this->run([&words](const Inverted_index &index) { return index.query_and(words); });
+}
+
+std::vector<std::uint32_t> Live_index::query_or(const std::vector<std::string_view> &words) const
+{
+    return this->run([&words](const Inverted_index &index) { return index.query_or(words); });
+}
@@ -0,0 +1,81 @@
+#ifndef _LIVE_INDEX_H_
+#define _LIVE_INDEX_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Inverted_index.h"
+#include "Tokenizer.h"
+
+/*
+
+    - Live_index is an index of a text that keeps growing, a line appended is indexed
+      into a small delta, the lines before it are not indexed again.
+
+    - when the delta has delta_limit lines it is finished and frozen, a thread of the
+      Live_index merges the frozen segments into a new main segment, in the background,
+      and swaps it in, then the frozen ones are dropped.
+
+    - a query reads the main segment, the frozen ones and the delta, every line is in one
+      segment only and the segments are in the order of the lines, so the lines of every
+      segment are added one after the other, and a query with all the words is answered
+      segment by segment.
+
+    - the segments are shared, a query holds the lock only to take them and to read the
+      delta, a merge only to swap, so appends and queries go on while the main segment is
+      rebuilt. an error of the merge thread is thrown again by flush.
+
+*/
+class Live_index
+{
+private:
+    std::size_t delta_limit;
+    mutable std::mutex mutex;
+    std::condition_variable wake;     // for the merge thread
+    std::condition_variable merged;   // for flush
+    std::shared_ptr<const Inverted_index> main;
+    std::vector<std::shared_ptr<const Inverted_index>> frozen;
+    std::unique_ptr<Inverted_index> delta;
+    std::uint32_t delta_lines;
+    std::uint32_t num_lines;
+    bool stopping;
+    std::exception_ptr error;
+    Tokenizer tokenizer;
+    std::thread merger;
+
+    void freeze();
+    void merge_loop();
+
+    template<typename Query>
+    std::vector<std::uint32_t> run(Query query) const;
+
+public:
+    explicit Live_index(std::size_t delta_limit = 4096);
+    ~Live_index();
+
+    Live_index(const Live_index &) = delete;
+    Live_index &operator=(const Live_index &) = delete;
+
+    // returns the number of the line, the first one is 1
+    std::uint32_t add_line(std::string_view line);
+    // every line of the text, a last line without a '\n' too
+    void add_text(std::string_view text);
+    // freezes the delta and waits until every segment is merged into the main one
+    void flush();
+
+    std::uint32_t get_num_lines() const;
+    // the main segment, the frozen ones and the delta, if they have lines
+    std::size_t get_num_segments() const;
+
+    std::vector<std::uint32_t> lines_of(std::string_view word) const;
+    std::vector<std::uint32_t> query_and(const std::vector<std::string_view> &words) const;
+    std::vector<std::uint32_t> query_or(const std::vector<std::string_view> &words) const;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include "Parallel_count.h"
+#include "Tokenizer.h"
+#include "../../tooling/tracing/Trace.h"
+
+namespace
+{
+    struct Lines
+    {
+        std::unique_ptr<Inverted_index> index;
+        std::uint32_t num_lines;
+    };
+
+    // the lines as std::getline gives them, a last line without a '\n' too
+    Lines index_chunk(std::string_view text)
+    {
+        TRACE_SCOPE("index_chunk");
+        TRACE_COUNT("indexed bytes", text.size());
+        Lines lines {std::make_unique<Inverted_index>(), 0};
+        Tokenizer tokenizer {""};
+        std::string_view word;
+
+        while (!text.empty())
+        {
+            const void *newline = std::memchr(text.data(), '\n', text.size());
+            const std::size_t size = newline == nullptr ? text.size() : static_cast<std::size_t>(static_cast<const char *>(newline) - text.data());
+
+            tokenizer.reset(text.substr(0, size));
+            ++lines.num_lines;
+            while (tokenizer.next(word))
+                lines.index->add(word, lines.num_lines);
+
+            text.remove_prefix(newline == nullptr ? size : size + 1);
+        }
+        return lines;
+    }
+}
+
+std::unique_ptr<Word_counter> count_words(const Chunked_file &file, bool fold_case)
+{
+    std::vector<std::unique_ptr<Word_counter>> parts = file.map([fold_case](const Chunk &chunk)
+    {
+        auto counter = std::make_unique<Word_counter>(fold_case);
+        counter->count(chunk.text);
+        return counter;
+    });
+
+    if (parts.empty())
+        return std::make_unique<Word_counter>(fold_case);
+
+    return tree_reduce(std::move(parts), [](std::unique_ptr<Word_counter> &into, std::unique_ptr<Word_counter> &from)
+    {
+        into->merge(*from);
+        from.reset();
+    });
+}
+
+std::unique_ptr<Word_sketch> sketch_words(const Chunked_file &file, std::size_t capacity, bool fold_case)
+{
+    std::vector<std::unique_ptr<Word_sketch>> parts = file.map([capacity, fold_case](const Chunk &chunk)
+    {
+        auto sketch = std::make_unique<Word_sketch>(capacity, fold_case);
+        sketch->count(chunk.text);
+        return sketch;
+    });
+
+    if (parts.empty())
+        return std::make_unique<Word_sketch>(capacity, fold_case);
+
+    return tree_reduce(std::move(parts), [](std::unique_ptr<Word_sketch> &into, std::unique_ptr<Word_sketch> &from)
+    {
+        into->merge(*from);
+        from.reset();
+    });
+}
+
+std::unique_ptr<Inverted_index> index_lines(const Chunked_file &file)
+{
+    TRACE_SCOPE("index_lines");
+    std::vector<Lines> parts = file.map([](const Chunk &chunk)
+    {
+        return index_chunk(chunk.text);
+    });
+
+    if (parts.empty())
+    {
+        auto index = std::make_unique<Inverted_index>();
+        index->finish();
+        return index;
+    }
+
+    Lines lines = tree_reduce(std::move(parts), [](Lines &into, Lines &from)
+    {
+        TRACE_SCOPE("append_index");
+        into.index->append(*from.index, into.num_lines);
+        into.num_lines += from.num_lines;
+        from.index.reset();
+    });
+    lines.index->finish();
+    return std::move(lines.index);
+}
@@ -0,0 +1,69 @@
+#ifndef _PARALLEL_COUNT_H_
+#define _PARALLEL_COUNT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../ioAndStream/challenge3/Chunked_file.h"
+#include "Inverted_index.h"
+#include "Word_counter.h"
+#include "Word_sketch.h"
+
+/*
+
+    - the parallel versions of partOne and partTwo: every chunk of the file, see
+      ../../ioAndStream/challenge3/Chunked_file.h, is counted or indexed on its own thread into its own table, nothing
+      is shared, and the tables are merged two by two, in a tree, every level on threads
+      too, until one is left.
+
+    - a chunk numbers its lines from 1, the lines of the chunks before it are added when
+      its index is appended, so the lines are the ones of the whole file.
+
+    - the results are the same as the ones of Word_counter::count and of adding the lines
+      one after the other, the index is finished.
+
+    - sketch_words is count_words with a Word_sketch per chunk, the memory of every one is
+      the same whatever the size of the chunk, the merged counts are approximate.
+
+*/
+std::unique_ptr<Word_counter> count_words(const Chunked_file &file, bool fold_case = false);
+std::unique_ptr<Inverted_index> index_lines(const Chunked_file &file);
+std::unique_ptr<Word_sketch> sketch_words(const Chunked_file &file, std::size_t capacity = 1000, bool fold_case = false);
+
+// merges parts[i + step] into parts[i], for step 1, 2, 4, ..., the pairs of a level on
+// their own threads, an exception is thrown again after every thread of the level ended
+template<typename T, typename Merge>
+T tree_reduce(std::vector<T> parts, Merge merge)
+{
+    for (std::size_t step = 1; step < parts.size(); step *= 2)
+    {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(parts.size());
+
+        for (std::size_t i = 0; i + step < parts.size(); i += 2 * step)
+            threads.emplace_back([&parts, &errors, &merge, i, step]
+            {
+                try
+                {
+                    merge(parts[i], parts[i + step]);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        for (std::thread &thread : threads)
+            thread.join();
+
+        for (const std::exception_ptr &error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    return std::move(parts.front());
+}
+
+#endif
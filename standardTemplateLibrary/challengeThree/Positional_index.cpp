@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Positional_index.h"
+#include "Tokenizer.h"
+#include "../../tooling/tracing/Trace.h"
+
+namespace
+{
+    void put_varint(std::vector<std::uint8_t> &bytes, std::uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint32_t get_varint(const std::uint8_t *&at)
+    {
+        std::uint32_t value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            const std::uint8_t byte = *at++;
+            if (shift < 32)
+                value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+    }
+}
+
+Position_cursor::Position_cursor(const Skip *skips, const std::uint8_t *bytes, std::size_t count)
+    : skips{skips}, bytes{bytes}, count{count}, position{0}, at{nullptr}, key{0}
+{
+    if (count > 0)
+        this->enter_block(0);
+}
+
+void Position_cursor::enter_block(std::size_t block)
+{
+    this->position = block * block_size;
+    this->key = this->skips[block].first;
+    this->at = this->bytes + this->skips[block].offset;
+}
+
+void Position_cursor::next()
+{
+    if (++this->position == this->count)
+        return;
+    if (this->position % block_size == 0)
+    {
+        this->enter_block(this->position / block_size);
+        return;
+    }
+
+    // the lines since the last position, then the offset, from the last one on the same line
+    const std::uint32_t lines = get_varint(this->at);
+    const std::uint32_t offset = get_varint(this->at);
+    if (lines == 0)
+        this->key += offset;
+    else
+        this->key = key_of(static_cast<std::uint32_t>(this->key >> 32) + lines, offset);
+}
+
+void Position_cursor::advance_to(std::uint64_t target)
+{
+    if (this->is_done() || this->key >= target)
+        return;
+
+    const std::size_t num_blocks = (this->count + block_size - 1) / block_size;
+    const std::size_t block = this->position / block_size;
+
+    if (block + 1 < num_blocks && this->skips[block + 1].first <= target)
+    {
+        std::size_t lo = block + 1;
+        std::size_t step = 1;
+        std::size_t hi = lo + step;
+        while (hi < num_blocks && this->skips[hi].first <= target)
+        {
+            lo = hi;
+            step *= 2;
+            hi = lo + step;
+        }
+        hi = std::min(hi, num_blocks);
+
+        const Skip *after = std::upper_bound(this->skips + lo, this->skips + hi, target, [](std::uint64_t value, const Skip &skip)
+        {
+            return value < skip.first;
+        });
+        this->enter_block(static_cast<std::size_t>(after - this->skips) - 1);
+    }
+
+    while (!this->is_done() && this->key < target)
+        this->next();
+}
+
+Positional_index::Positional_index() : num_positions{0}, finished{false}
+{
+}
+
+void Positional_index::add(std::string_view word, std::uint32_t line, std::uint32_t offset)
+{
+    if (this->finished)
+        throw std::runtime_error("the index is finished, no position can be added");
+    if (offset > max_offset)
+        throw std::runtime_error("the offset " + std::to_string(offset) + " is past the last one of a line");
+
+    const std::uint32_t id = this->vocabulary.add(word);
+    if (id == this->lists.size())
+        this->lists.push_back(List{{}, {}, 0, 0});
+
+    List &list = this->lists[id];
+    const std::uint64_t key = Position_cursor::key_of(line, offset);
+    if (list.count > 0 && key <= list.last)
+    {
+        if (key == list.last)
+            return;
+        throw std::runtime_error("the positions of a word are added in order");
+    }
+
+    if (list.count % Position_cursor::block_size == 0)
+        list.skips.push_back(Skip{key, list.bytes.size()});
+    else
+    {
+        const std::uint32_t lines = line - static_cast<std::uint32_t>(list.last >> 32);
+        put_varint(list.bytes, lines);
+        put_varint(list.bytes, lines == 0 ? offset - static_cast<std::uint32_t>(list.last) : offset);
+    }
+    list.last = key;
+    ++list.count;
+    ++this->num_positions;
+}
+
+std::uint32_t Positional_index::add_line(std::string_view text, std::uint32_t line)
+{
+    Tokenizer tokenizer {text};
+    std::string_view word;
+    std::uint32_t offset = 0;
+    while (tokenizer.next(word))
+        this->add(word, line, offset++);
+    return offset;
+}
+
+void Positional_index::finish()
+{
+    if (this->finished)
+        return;
+    TRACE_SCOPE("finish_positional_index");
+
+    std::size_t num_skips = 0, num_bytes = 0;
+    for (const List &list : this->lists)
+    {
+        num_skips += list.skips.size();
+        num_bytes += list.bytes.size();
+    }
+    this->skips.resize(num_skips);
+    this->bytes.resize(num_bytes);
+    this->postings.reserve(this->lists.size());
+
+    std::size_t skip = 0, byte = 0;
+    for (List &list : this->lists)
+    {
+        this->postings.push_back(Posting{skip, list.count});
+        for (const Skip &list_skip : list.skips)
+            this->skips[skip++] = Skip{list_skip.first, list_skip.offset + byte};
+        if (!list.bytes.empty())
+            std::memcpy(this->bytes.data() + byte, list.bytes.data(), list.bytes.size());
+        byte += list.bytes.size();
+        list = List{};
+    }
+    std::vector<List>().swap(this->lists);
+    this->finished = true;
+}
+
+void Positional_index::check_finished() const
+{
+    if (!this->finished)
+        throw std::runtime_error("the index is not finished");
+}
+
+std::size_t Positional_index::get_num_words() const
+{
+    return this->vocabulary.size();
+}
+
+std::uint64_t Positional_index::get_num_positions() const
+{
+    return this->num_positions;
+}
+
+std::size_t Positional_index::get_memory() const
+{
+    return this->skips.size() * sizeof(Skip) + this->bytes.size() + this->postings.size() * sizeof(Posting);
+}
+
+Position_cursor Positional_index::cursor(std::uint32_t id) const
+{
+    this->check_finished();
+    const Posting &posting = this->postings[id];
+    return Position_cursor{this->skips.data() + posting.skip, this->bytes.data(), static_cast<std::size_t>(posting.count)};
+}
+
+Position_cursor Positional_index::cursor(std::string_view word) const
+{
+    this->check_finished();
+    const std::uint32_t id = this->vocabulary.get_id(word);
+    if (id == Word_counter::no_word)
+        return Position_cursor{nullptr, nullptr, 0};
+    return this->cursor(id);
+}
+
+std::vector<Word_position> Positional_index::positions_of(std::string_view word) const
+{
+    std::vector<Word_position> positions;
+    for (Position_cursor cursor = this->cursor(word); !cursor.is_done(); cursor.next())
+        positions.push_back(cursor.get_position());
+    return positions;
+}
+
+std::vector<Word_position> Positional_index::query_phrase(const std::vector<std::string_view> &words) const
+{
+    std::vector<Word_position> matches;
+    if (words.empty())
+        return matches;
+
+    std::vector<Position_cursor> cursors;
+    cursors.reserve(words.size());
+    for (std::string_view word : words)
+    {
+        cursors.push_back(this->cursor(word));
+        if (cursors.back().is_done())
+            return matches;
+    }
+
+    // the shortest list goes first, its candidates move the others the most
+    std::vector<std::size_t> order(words.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&cursors](std::size_t a, std::size_t b)
+    {
+        return cursors[a].size() < cursors[b].size();
+    });
+
+    // a candidate is the key of the first word, word i has to be at candidate + i
+    std::uint64_t candidate = 0;
+    for (;;)
+    {
+        bool all = true;
+        for (const std::size_t i : order)
+        {
+            Position_cursor &cursor = cursors[i];
+            cursor.advance_to(candidate + i);
+            if (cursor.is_done())
+                return matches;
+            if (cursor.value() != candidate + i)
+            {
+                candidate = cursor.value() - i;
+                all = false;
+                break;
+            }
+        }
+        if (all)
+        {
+            matches.push_back(Word_position{static_cast<std::uint32_t>(candidate >> 32), static_cast<std::uint32_t>(candidate)});
+            ++candidate;
+        }
+    }
+}
+
+std::vector<Word_position> Positional_index::query_near(std::string_view word, std::string_view other, std::uint32_t distance) const
+{
+    std::vector<Word_position> matches;
+    distance = std::min(distance, max_offset);
+    Position_cursor others = this->cursor(other);
+    for (Position_cursor cursor = this->cursor(word); !cursor.is_done() && !others.is_done(); cursor.next())
+    {
+        const Word_position at = cursor.get_position();
+        const std::uint32_t from = at.offset >= distance ? at.offset - distance : 0;
+        others.advance_to(Position_cursor::key_of(at.line, from));
+
+        // the word itself is not near itself, the next place of the other word may be
+        Position_cursor probe = others;
+        if (!probe.is_done() && probe.value() == cursor.value())
+            probe.next();
+        if (!probe.is_done() && probe.value() <= cursor.value() + distance)
+            matches.push_back(at);
+    }
+    return matches;
+}
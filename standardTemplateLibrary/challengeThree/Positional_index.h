@@ -0,0 +1,146 @@
+#ifndef _POSITIONAL_INDEX_H_
+#define _POSITIONAL_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Word_counter.h"
+#include "../../tooling/largeBuffer/Large_buffer.h"
+
+/*
+
+    - Positional_index keeps for every word the places it is at, its line and its offset in
+      the line, the number of words before it there, so "wherefore art thou" is found from
+      the index, where Inverted_index only has the lines of every word and the text has to
+      be read again.
+
+    - a list is the positions in order, cut into blocks of 128 like the ones of
+      Inverted_index, the first position of a block is in a skip entry, every other one is a
+      varint of the lines since the one before and a varint of its offset, the difference
+      to the offset before on the same line. the lines of a play are about 2.6 bytes a
+      position.
+
+    - a Position_cursor walks a list. a position is the key line << 32 | offset, so the next
+      word of a line is the key + 1 and advance_to gallops over the skips to a key, like
+      the Posting_cursor of Inverted_index.
+
+    - query_phrase is the positions of the first word of the places where the words are one
+      after the other on a line: the cursor of word i is advanced to the candidate + i, a
+      cursor past it is the next candidate, and it is a match when all of them are on it,
+      the long lists are read only around the places of the short ones. query_near is the
+      positions of a word with another word at most distance words before or after it on
+      the same line. a phrase or a pair does not go over the end of a line.
+
+    - the words are as they are, not folded, the way add gets them, the positions of a word
+      are added in order, a position again is ignored, a smaller one throws
+      std::runtime_error, as does an offset of 2^31 or more. finish packs the lists, it is
+      called once, before the queries.
+
+*/
+struct Word_position
+{
+    std::uint32_t line;
+    std::uint32_t offset;  // the words before it on its line
+
+    bool operator==(const Word_position &rhs) const { return this->line == rhs.line && this->offset == rhs.offset; }
+};
+
+class Positional_index;
+
+class Position_cursor
+{
+private:
+    static constexpr std::size_t block_size = 128;
+
+    struct Skip
+    {
+        std::uint64_t first;
+        std::uint64_t offset;  // where the rest of the block is in the buffer
+    };
+
+    friend class Positional_index;
+
+    const Skip *skips;
+    const std::uint8_t *bytes;
+    std::size_t count;
+    std::size_t position;      // count when the cursor is done
+    const std::uint8_t *at;
+    std::uint64_t key;
+
+    Position_cursor(const Skip *skips, const std::uint8_t *bytes, std::size_t count);
+    void enter_block(std::size_t block);
+
+public:
+    static constexpr std::uint64_t key_of(std::uint32_t line, std::uint32_t offset)
+    {
+        return static_cast<std::uint64_t>(line) << 32 | offset;
+    }
+
+    bool is_done() const { return this->position == this->count; }
+    std::uint64_t value() const { return this->key; }
+    Word_position get_position() const
+    {
+        return Word_position{static_cast<std::uint32_t>(this->key >> 32), static_cast<std::uint32_t>(this->key)};
+    }
+    std::size_t size() const { return this->count; }
+
+    void next();
+    // the first key not less than target
+    void advance_to(std::uint64_t target);
+};
+
+class Positional_index
+{
+private:
+    using Skip = Position_cursor::Skip;
+
+    struct List
+    {
+        std::vector<std::uint8_t> bytes;  // until finish
+        std::vector<Skip> skips;
+        std::uint64_t last;
+        std::uint64_t count;
+    };
+
+    struct Posting
+    {
+        std::uint64_t skip;
+        std::uint64_t count;
+    };
+
+    Word_counter vocabulary;
+    std::vector<List> lists;        // by id, until finish
+    std::vector<Posting> postings;  // by id
+    large_buffer::Vector<Skip> skips;
+    large_buffer::Vector<std::uint8_t> bytes;
+    std::uint64_t num_positions;
+    bool finished;
+
+    void check_finished() const;
+    Position_cursor cursor(std::uint32_t id) const;
+
+public:
+    static constexpr std::uint32_t max_offset = 0x7fffffff;
+
+    Positional_index();
+
+    void add(std::string_view word, std::uint32_t line, std::uint32_t offset);
+    // the words of the text of a line, cleaned by a Tokenizer, at offsets from 0, their number
+    std::uint32_t add_line(std::string_view text, std::uint32_t line);
+    void finish();
+
+    std::size_t get_num_words() const;
+    std::uint64_t get_num_positions() const;
+    // the bytes of the lists and the skips, not of the words
+    std::size_t get_memory() const;
+
+    // a word that is not in the index has an empty cursor
+    Position_cursor cursor(std::string_view word) const;
+
+    std::vector<Word_position> positions_of(std::string_view word) const;
+    std::vector<Word_position> query_phrase(const std::vector<std::string_view> &words) const;
+    std::vector<Word_position> query_near(std::string_view word, std::string_view other, std::uint32_t distance) const;
+};
+
+#endif
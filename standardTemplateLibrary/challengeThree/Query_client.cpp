@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Query_client.h"
+
+namespace
+{
+    constexpr std::size_t block_size = 128;
+    constexpr std::size_t read_size = 64 * 1024;
+
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+}
+
+Query_client::Query_client(int fd) : fd{fd}
+{
+}
+
+Query_client::~Query_client()
+{
+    ::close(this->fd);
+}
+
+int Query_client::connect_to(const std::string &host, std::uint16_t port)
+{
+    addrinfo hints {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *found = nullptr;
+    const int error = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found);
+    if (error != 0)
+        throw std::runtime_error(host + ": " + ::gai_strerror(error));
+
+    int fd = -1;
+    for (addrinfo *address = found; address != nullptr && fd < 0; address = address->ai_next)
+    {
+        fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd >= 0 && ::connect(fd, address->ai_addr, address->ai_addrlen) < 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(found);
+    if (fd < 0)
+        fail("connect to " + host + ":" + std::to_string(port));
+
+    const int on = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+    return fd;
+}
+
+std::uint32_t Query_client::submit(Query_op op, const std::vector<std::string_view> &words)
+{
+    if (words.size() > max_query_words)
+        throw std::runtime_error("a request has more than " + std::to_string(max_query_words) + " words");
+
+    Query_request request {0, this->next_id++, static_cast<std::uint16_t>(op), static_cast<std::uint16_t>(words.size()), 0};
+    for (std::string_view word : words)
+    {
+        if (word.size() > 255)
+            throw std::runtime_error("a word of a request is longer than 255 bytes");
+        request.size += static_cast<std::uint32_t>(1 + word.size());
+    }
+    if (request.size > max_request_size)
+        throw std::runtime_error("a request is larger than " + std::to_string(max_request_size) + " bytes");
+
+    const std::size_t offset = this->out.size();
+    this->out.resize(offset + sizeof request + request.size);
+    char *at = this->out.data() + offset;
+    std::memcpy(at, &request, sizeof request);
+    at += sizeof request;
+    for (std::string_view word : words)
+    {
+        *at++ = static_cast<char>(word.size());
+        std::memcpy(at, word.data(), word.size());
+        at += word.size();
+    }
+    return request.id;
+}
+
+void Query_client::flush()
+{
+    const char *at = this->out.data();
+    std::size_t size = this->out.size();
+    while (size > 0)
+    {
+        const ssize_t sent = ::send(this->fd, at, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent <= 0)
+            fail("send of the requests");
+        at += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+    this->out.clear();
+}
+
+// at least size bytes after in_begin, the ones there are moved to the start
+void Query_client::fill(std::size_t size)
+{
+    if (this->in_end - this->in_begin >= size)
+        return;
+    if (this->in_begin > 0)
+    {
+        std::memmove(this->in.data(), this->in.data() + this->in_begin, this->in_end - this->in_begin);
+        this->in_end -= this->in_begin;
+        this->in_begin = 0;
+    }
+    if (this->in.size() < size + read_size)
+        this->in.resize(size + read_size);
+
+    while (this->in_end < size)
+    {
+        const ssize_t received = ::recv(this->fd, this->in.data() + this->in_end, this->in.size() - this->in_end, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received == 0)
+            throw std::runtime_error("the server closed the connection");
+        if (received < 0)
+            fail("receive of the replies");
+        this->in_end += static_cast<std::size_t>(received);
+    }
+}
+
+Query_client::Result Query_client::receive()
+{
+    Query_reply reply;
+    this->fill(sizeof reply);
+    std::memcpy(&reply, this->in.data() + this->in_begin, sizeof reply);
+    this->fill(sizeof reply + reply.size);
+    const char *body = this->in.data() + this->in_begin + sizeof reply;
+    this->in_begin += sizeof reply + reply.size;
+
+    Result result {reply.id, static_cast<Query_status>(reply.status), static_cast<Query_op>(reply.op), reply.count, {}};
+    if (result.status != Query_status::Ok || result.op == Query_op::Count)
+        return result;
+    if (result.op == Query_op::Postings)
+    {
+        if (!decode_postings(body, reply.size, reply.count, result.lines))
+            throw std::runtime_error("a list of the reply " + std::to_string(reply.id) + " can't be decoded");
+        return result;
+    }
+    if (reply.size != static_cast<std::uint64_t>(reply.count) * 4)
+        throw std::runtime_error("the reply " + std::to_string(reply.id) + " is not as long as its lines");
+    result.lines.resize(reply.count);
+    if (reply.count > 0)
+        std::memcpy(result.lines.data(), body, reply.size);
+    return result;
+}
+
+Query_client::Result Query_client::call(Query_op op, const std::vector<std::string_view> &words)
+{
+    this->submit(op, words);
+    this->flush();
+    Result result = this->receive();
+    if (result.status != Query_status::Ok)
+        throw std::runtime_error("the server could not answer the request " + std::to_string(result.id));
+    return result;
+}
+
+std::uint32_t Query_client::count(std::string_view word)
+{
+    return this->call(Query_op::Count, {word}).count;
+}
+
+std::vector<std::uint32_t> Query_client::lines_of(std::string_view word)
+{
+    return this->call(Query_op::Lines, {word}).lines;
+}
+
+std::vector<std::uint32_t> Query_client::postings_of(std::string_view word)
+{
+    return this->call(Query_op::Postings, {word}).lines;
+}
+
+std::vector<std::uint32_t> Query_client::query_and(const std::vector<std::string_view> &words)
+{
+    return this->call(Query_op::And, words).lines;
+}
+
+std::vector<std::uint32_t> Query_client::query_or(const std::vector<std::string_view> &words)
+{
+    return this->call(Query_op::Or, words).lines;
+}
+
+// the skips and the varints of Inverted_index.h, every read checked against the end
+bool decode_postings(const char *data, std::size_t size, std::size_t count, std::vector<std::uint32_t> &lines)
+{
+    const std::size_t num_blocks = (count + block_size - 1) / block_size;
+    if (size < num_blocks * 16)
+        return false;
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data) + num_blocks * 16;
+    const std::size_t num_bytes = size - num_blocks * 16;
+
+    lines.clear();
+    lines.reserve(count);
+    std::uint64_t base = 0;
+    for (std::size_t block = 0; block < num_blocks; ++block)
+    {
+        std::uint32_t line;
+        std::uint64_t offset;
+        std::memcpy(&line, data + block * 16, 4);
+        std::memcpy(&offset, data + block * 16 + 8, 8);
+        if (block == 0)
+            base = offset;
+        if (offset < base || offset - base > num_bytes)
+            return false;
+
+        std::size_t at = static_cast<std::size_t>(offset - base);
+        lines.push_back(line);
+        const std::size_t last = std::min(count, (block + 1) * block_size);
+        for (std::size_t i = block * block_size + 1; i < last; ++i)
+        {
+            std::uint32_t difference = 0;
+            for (int shift = 0;; shift += 7)
+            {
+                if (at == num_bytes)
+                    return false;
+                const unsigned char byte = bytes[at++];
+                if (shift < 32)
+                    difference |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+            line += difference;
+            lines.push_back(line);
+        }
+    }
+    return true;
+}
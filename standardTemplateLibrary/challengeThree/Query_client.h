@@ -0,0 +1,74 @@
+#ifndef _QUERY_CLIENT_H_
+#define _QUERY_CLIENT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Query_wire.h"
+
+/*
+
+    - Query_client sends the requests of Query_wire.h to a Query_server on one connection.
+      submit() does not wait, it appends the request to a buffer and gives its id, flush()
+      sends the buffer in one write, receive() reads the next reply, the replies come in the
+      order of the requests. a client keeps many requests in flight and pays round trips
+      for batches, the way Ledger_client does.
+
+    - count, lines_of, postings_of, query_and and query_or are a submit, a flush and a
+      receive, for a request at a time. the lines of Postings are decoded by the client,
+      the server sent the list as it is in the index file.
+
+    - the client owns the connection, it closes it, it is for one thread. a connection that
+      fails or is closed, a reply of Bad_request and a list that can't be decoded throw
+      std::runtime_error.
+
+*/
+class Query_client
+{
+public:
+    struct Result
+    {
+        std::uint32_t id;
+        Query_status status;
+        Query_op op;
+        std::uint32_t count;
+        std::vector<std::uint32_t> lines;  // of Lines, And, Or and Postings
+    };
+
+private:
+    int fd;
+    std::vector<char> out;
+    std::vector<char> in;
+    std::size_t in_begin {0};
+    std::size_t in_end {0};
+    std::uint32_t next_id {1};
+
+    void fill(std::size_t size);
+    Result call(Query_op op, const std::vector<std::string_view> &words);
+
+public:
+    explicit Query_client(int fd);
+    Query_client(const Query_client &source) = delete;
+    Query_client &operator=(const Query_client &rhs) = delete;
+    ~Query_client();
+
+    // a TCP connection to a server, host is an IPv4 address or a name
+    static int connect_to(const std::string &host, std::uint16_t port);
+
+    std::uint32_t submit(Query_op op, const std::vector<std::string_view> &words);
+    void flush();
+    Result receive();
+
+    std::uint32_t count(std::string_view word);
+    std::vector<std::uint32_t> lines_of(std::string_view word);
+    std::vector<std::uint32_t> postings_of(std::string_view word);
+    std::vector<std::uint32_t> query_and(const std::vector<std::string_view> &words);
+    std::vector<std::uint32_t> query_or(const std::vector<std::string_view> &words);
+};
+
+// the lines of a list of Postings, false when it is damaged
+bool decode_postings(const char *data, std::size_t size, std::size_t count, std::vector<std::uint32_t> &lines);
+
+#endif
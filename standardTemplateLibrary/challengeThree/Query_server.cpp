@@ -0,0 +1,432 @@
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "Query_server.h"
+
+namespace
+{
+    // the kind of a socket in the data of its event, next to the descriptor
+    constexpr std::uint64_t wake_kind = 0, listener_kind = 1, connection_kind = 2;
+    // a whole request fits the buffer of a connection, a read takes what is left of it
+    constexpr std::size_t in_size = 2 * (sizeof(Query_request) + max_request_size);
+    constexpr std::size_t max_parts = 1024;
+
+    void fail(const std::string &what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    std::uint64_t tag(std::uint64_t kind, int fd)
+    {
+        return kind << 32 | static_cast<std::uint32_t>(fd);
+    }
+
+    void set_non_blocking(int fd)
+    {
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+            fail("fcntl");
+    }
+}
+
+Query_server::Query_server(const Index_file &index)
+    : index{index}, epoll_fd{-1}, wake_fd{-1}, stopping{false}, num_requests{0}
+{
+    this->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (this->epoll_fd < 0)
+        fail("epoll_create1");
+    this->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->wake_fd < 0)
+    {
+        int error = errno;
+        ::close(this->epoll_fd);
+        errno = error;
+        fail("eventfd");
+    }
+
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = tag(wake_kind, this->wake_fd);
+    ::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->wake_fd, &event);
+    this->words.reserve(max_query_words);
+    this->loop = std::thread{&Query_server::run, this};
+}
+
+Query_server::~Query_server()
+{
+    this->stopping = true;
+    const std::uint64_t one = 1;
+    if (::write(this->wake_fd, &one, sizeof one) < 0) {}
+    this->loop.join();
+
+    for (auto &connection : this->connections)
+        ::close(connection.first);
+    for (int fd : this->added)
+        ::close(fd);
+    for (int fd : this->listeners)
+        ::close(fd);
+    ::close(this->wake_fd);
+    ::close(this->epoll_fd);
+}
+
+void Query_server::serve(int fd)
+{
+    {
+        std::lock_guard<std::mutex> guard {this->lock};
+        this->added.push_back(fd);
+    }
+    const std::uint64_t one = 1;
+    if (::write(this->wake_fd, &one, sizeof one) < 0) {}
+}
+
+int Query_server::connect()
+{
+    int ends[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, ends) < 0)
+        fail("socketpair");
+    this->serve(ends[1]);
+    return ends[0];
+}
+
+std::uint16_t Query_server::listen(std::uint16_t port)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        fail("socket");
+
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof on);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof address;
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof address) < 0 || ::listen(fd, SOMAXCONN) < 0
+        || ::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        fail("listen on port " + std::to_string(port));
+    }
+
+    {
+        std::lock_guard<std::mutex> guard {this->lock};
+        this->listeners.push_back(fd);
+    }
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = tag(listener_kind, fd);
+    if (::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+        fail("epoll_ctl");
+    return ntohs(address.sin_port);
+}
+
+std::uint64_t Query_server::get_num_requests() const
+{
+    return this->num_requests.load(std::memory_order_relaxed);
+}
+
+// the loop is level triggered, a socket that still has bytes is in the next wait again
+void Query_server::run()
+{
+    epoll_event events[64];
+    while (!this->stopping)
+    {
+        const int n = ::epoll_wait(this->epoll_fd, events, 64, -1);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return;
+
+        for (int i = 0; i < n; ++i)
+        {
+            const std::uint64_t kind = events[i].data.u64 >> 32;
+            const int fd = static_cast<int>(events[i].data.u64 & 0xffffffff);
+            if (kind == wake_kind)
+            {
+                std::uint64_t count;
+                if (::read(fd, &count, sizeof count) < 0) {}
+                std::vector<int> fds;
+                {
+                    std::lock_guard<std::mutex> guard {this->lock};
+                    fds.swap(this->added);
+                }
+                for (int added : fds)
+                    this->add(added);
+                continue;
+            }
+            if (kind == listener_kind)
+            {
+                this->accept_all(fd);
+                continue;
+            }
+
+            // closed by an event before it in this wait
+            auto found = this->connections.find(fd);
+            if (found == this->connections.end())
+                continue;
+            Connection &connection = *found->second;
+            if ((events[i].events & EPOLLOUT) != 0 && !this->flush(connection))
+                continue;
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0 && connection.reading)
+                this->read_some(connection);
+        }
+    }
+}
+
+void Query_server::add(int fd)
+{
+    try
+    {
+        set_non_blocking(fd);
+    }
+    catch (const std::runtime_error &)
+    {
+        ::close(fd);
+        return;
+    }
+
+    auto connection = std::make_unique<Connection>();
+    connection->fd = fd;
+    connection->in.resize(in_size);
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = tag(connection_kind, fd);
+    if (::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        ::close(fd);
+        return;
+    }
+    this->connections[fd] = std::move(connection);
+}
+
+void Query_server::accept_all(int listener)
+{
+    for (;;)
+    {
+        const int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+            return;
+        // a reply is not held back for the next one, the client pipelines
+        const int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        this->add(fd);
+    }
+}
+
+void Query_server::read_some(Connection &connection)
+{
+    ssize_t received;
+    while ((received = ::recv(connection.fd, connection.in.data() + connection.filled, in_size - connection.filled, 0)) < 0
+        && errno == EINTR) {}
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return;
+    if (received <= 0)
+    {
+        this->close(connection.fd);
+        return;
+    }
+    connection.filled += static_cast<std::size_t>(received);
+
+    // every whole request of the buffer, the rest is moved to its start
+    std::size_t at = 0;
+    std::uint64_t count = 0;
+    while (connection.filled - at >= sizeof(Query_request))
+    {
+        Query_request request;
+        std::memcpy(&request, connection.in.data() + at, sizeof request);
+        if (request.size > max_request_size)
+        {
+            this->close(connection.fd);
+            return;
+        }
+        if (connection.filled - at < sizeof request + request.size)
+            break;
+        this->answer(connection, request, connection.in.data() + at + sizeof request);
+        at += sizeof request + request.size;
+        ++count;
+    }
+    if (at > 0)
+    {
+        std::memmove(connection.in.data(), connection.in.data() + at, connection.filled - at);
+        connection.filled -= at;
+    }
+    this->num_requests.fetch_add(count, std::memory_order_relaxed);
+
+    if (!connection.parts.empty())
+        this->flush(connection);
+}
+
+char *Query_server::append(Connection &connection, std::size_t size)
+{
+    const std::size_t offset = connection.out.size();
+    connection.out.resize(offset + size);
+    // next to the part before it in the buffer, one part for both
+    if (!connection.parts.empty() && connection.parts.back().external == nullptr
+        && connection.parts.back().offset + connection.parts.back().size == offset)
+        connection.parts.back().size += size;
+    else
+        connection.parts.push_back(Part{nullptr, offset, size});
+    return connection.out.data() + offset;
+}
+
+void Query_server::append_external(Connection &connection, const char *data, std::size_t size)
+{
+    if (size > 0)
+        connection.parts.push_back(Part{data, 0, size});
+}
+
+void Query_server::answer(Connection &connection, const Query_request &request, const char *body)
+{
+    Query_reply reply {0, request.id, static_cast<std::uint16_t>(Query_status::Ok), request.op, 0};
+
+    // the words are views of the buffer, the bytes of a request are all there
+    this->words.clear();
+    const char *at = body, *end = body + request.size;
+    bool valid = request.num_words <= max_query_words;
+    for (std::uint16_t i = 0; valid && i < request.num_words; ++i)
+    {
+        const std::size_t length = at < end ? static_cast<unsigned char>(*at++) : 0;
+        valid = at <= end && length <= static_cast<std::size_t>(end - at);
+        if (valid)
+            this->words.emplace_back(at, length);
+        at += valid ? length : 0;
+    }
+    valid = valid && at == end;
+
+    const Query_op op = static_cast<Query_op>(request.op);
+    const bool one_word = op == Query_op::Count || op == Query_op::Lines || op == Query_op::Postings;
+    if (!valid || (one_word && this->words.size() != 1) || (!one_word && op != Query_op::And && op != Query_op::Or))
+    {
+        reply.status = static_cast<std::uint16_t>(Query_status::Bad_request);
+        std::memcpy(append(connection, sizeof reply), &reply, sizeof reply);
+        return;
+    }
+
+    if (op == Query_op::Count)
+    {
+        reply.count = static_cast<std::uint32_t>(this->index.cursor(this->words[0]).size());
+        std::memcpy(append(connection, sizeof reply), &reply, sizeof reply);
+        return;
+    }
+
+    if (op == Query_op::Postings)
+    {
+        const Index_file::Raw_list list = this->index.raw_list(this->words[0]);
+        reply.count = static_cast<std::uint32_t>(list.count);
+        reply.size = static_cast<std::uint32_t>(list.num_skips * 16 + list.num_bytes);
+        std::memcpy(append(connection, sizeof reply), &reply, sizeof reply);
+        append_external(connection, list.skips, list.num_skips * 16);
+        append_external(connection, list.bytes, list.num_bytes);
+        return;
+    }
+
+    if (op == Query_op::Lines)
+    {
+        // decoded right into the buffer, after the reply
+        Posting_cursor cursor = this->index.cursor(this->words[0]);
+        reply.count = static_cast<std::uint32_t>(cursor.size());
+        reply.size = reply.count * 4;
+        char *out = append(connection, sizeof reply + reply.size);
+        std::memcpy(out, &reply, sizeof reply);
+        out += sizeof reply;
+        for (; !cursor.is_done(); cursor.next(), out += 4)
+        {
+            const std::uint32_t line = cursor.value();
+            std::memcpy(out, &line, 4);
+        }
+        return;
+    }
+
+    const std::vector<std::uint32_t> lines = op == Query_op::And ? this->index.query_and(this->words) : this->index.query_or(this->words);
+    reply.count = static_cast<std::uint32_t>(lines.size());
+    reply.size = reply.count * 4;
+    char *out = append(connection, sizeof reply + reply.size);
+    std::memcpy(out, &reply, sizeof reply);
+    if (!lines.empty())
+        std::memcpy(out + sizeof reply, lines.data(), reply.size);
+}
+
+// false when the connection is closed, a socket that is full is written again when it can
+bool Query_server::flush(Connection &connection)
+{
+    iovec vectors[max_parts];
+    while (connection.sent_part < connection.parts.size())
+    {
+        std::size_t n = 0;
+        for (std::size_t i = connection.sent_part; i < connection.parts.size() && n < max_parts && n < IOV_MAX; ++i, ++n)
+        {
+            const Part &part = connection.parts[i];
+            const char *data = part.external != nullptr ? part.external : connection.out.data() + part.offset;
+            const std::size_t skip = i == connection.sent_part ? connection.sent_offset : 0;
+            vectors[n].iov_base = const_cast<char *>(data + skip);
+            vectors[n].iov_len = part.size - skip;
+        }
+
+        msghdr message {};
+        message.msg_iov = vectors;
+        message.msg_iovlen = n;
+        ssize_t sent;
+        while ((sent = ::sendmsg(connection.fd, &message, MSG_NOSIGNAL)) < 0 && errno == EINTR) {}
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            if (connection.reading)
+                this->watch(connection, false, true);
+            return true;
+        }
+        if (sent < 0)
+        {
+            this->close(connection.fd);
+            return false;
+        }
+
+        std::size_t done = static_cast<std::size_t>(sent);
+        while (done > 0)
+        {
+            const std::size_t left = connection.parts[connection.sent_part].size - connection.sent_offset;
+            if (done < left)
+            {
+                connection.sent_offset += done;
+                break;
+            }
+            done -= left;
+            ++connection.sent_part;
+            connection.sent_offset = 0;
+        }
+    }
+
+    connection.out.clear();
+    connection.parts.clear();
+    connection.sent_part = 0;
+    connection.sent_offset = 0;
+    if (!connection.reading)
+        this->watch(connection, true, false);
+    return true;
+}
+
+void Query_server::watch(Connection &connection, bool reading, bool writing)
+{
+    epoll_event event {};
+    event.events = (reading ? static_cast<std::uint32_t>(EPOLLIN) : 0) | (writing ? static_cast<std::uint32_t>(EPOLLOUT) : 0);
+    event.data.u64 = tag(connection_kind, connection.fd);
+    ::epoll_ctl(this->epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.reading = reading;
+}
+
+void Query_server::close(int fd)
+{
+    ::epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    this->connections.erase(fd);
+}
@@ -0,0 +1,102 @@
+#ifndef _QUERY_SERVER_H_
+#define _QUERY_SERVER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Index_file.h"
+#include "Query_wire.h"
+
+/*
+
+    - Query_server answers the requests of Query_wire.h from an Index_file, one thread for
+      all its connections, an epoll loop over non-blocking sockets, not a thread a
+      connection as Ledger_node has: a lookup is a binary search and a few cache lines, a
+      thread switch would cost more than it.
+
+    - a read takes all the bytes the socket has, every whole request in them is answered
+      and the replies of the read go out in one sendmsg, so a client that pipelines pays a
+      system call for a batch of requests, not for each one. the rest of a request whose
+      bytes are not all there waits for the next read.
+
+    - the replies are a list of parts, the headers and the decoded lines in a buffer of the
+      connection, the lists of Postings pointing into the mapping of the index, they are
+      not copied to the buffer, the kernel copies them from the pages of the file to the
+      socket. the index has to outlive the server.
+
+    - a connection whose replies the socket does not take stops being read until they are
+      sent, its requests wait in the socket, a client that does not read its replies
+      blocks itself, not the server.
+
+    - connect() makes a socket pair of a server in the same process, serve() takes any
+      connected stream socket, listen() a TCP port of all the addresses, 0 for one the
+      system picks, it gives the port. the destructor stops the loop and closes the sockets
+      of the server, errors of a connection close it, the others throw std::runtime_error.
+
+*/
+class Query_server
+{
+private:
+    struct Part
+    {
+        const char *external;     // into the mapping, or nullptr for the buffer
+        std::size_t offset;       // in the buffer
+        std::size_t size;
+    };
+
+    struct Connection
+    {
+        int fd;
+        std::vector<char> in;
+        std::size_t filled {0};
+        std::vector<char> out;
+        std::vector<Part> parts;
+        std::size_t sent_part {0};
+        std::size_t sent_offset {0};
+        bool reading {true};
+    };
+
+    const Index_file &index;
+    int epoll_fd;
+    int wake_fd;
+    std::vector<int> listeners;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::vector<std::string_view> words;  // of the request answered
+    std::mutex lock;
+    std::vector<int> added;       // by serve, until the loop takes them
+    std::atomic<bool> stopping;
+    std::atomic<std::uint64_t> num_requests;
+    std::thread loop;
+
+    void run();
+    void add(int fd);
+    void accept_all(int listener);
+    void read_some(Connection &connection);
+    void answer(Connection &connection, const Query_request &request, const char *body);
+    static char *append(Connection &connection, std::size_t size);
+    static void append_external(Connection &connection, const char *data, std::size_t size);
+    bool flush(Connection &connection);
+    void watch(Connection &connection, bool reading, bool writing);
+    void close(int fd);
+
+public:
+    explicit Query_server(const Index_file &index);
+    ~Query_server();
+
+    Query_server(const Query_server &) = delete;
+    Query_server &operator=(const Query_server &) = delete;
+
+    void serve(int fd);
+    int connect();
+    std::uint16_t listen(std::uint16_t port);
+
+    std::uint64_t get_num_requests() const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef _QUERY_WIRE_H_
+#define _QUERY_WIRE_H_
+
+#include <cstdint>
+
+/*
+
+    - the messages a Query_client and a Query_server exchange on a stream socket, in the
+      byte order of the machines, the way the index file is.
+
+    - a request is a Query_request and its words, every word a byte of its length and its
+      bytes, size is the bytes of the words. a reply is a Query_reply and size bytes after
+      it, with the id of its request, the replies of a connection come in the order of its
+      requests, a client sends many before it reads one, the pipeline of a connection.
+
+    - Count is the number of lines of a word, in count, there is nothing after the reply.
+      Lines, And and Or are count lines of 4 bytes. Postings is the packed list of a word as
+      it is in the index file, see Index_file::raw_list: the skips, one for every 128 lines,
+      16 bytes each, the first line and the offset of the varints of the block from the
+      start of the varints of all the lists, and the varints after them, the offset of the
+      first skip is where the ones of this list start.
+
+    - a request that is not one of these is answered with the status Bad_request and
+      nothing after it, one larger than max_request_size closes the connection.
+
+*/
+enum class Query_op : std::uint16_t
+{
+    Count,     // of the lines of one word
+    Lines,     // of one word
+    And,       // the lines with all the words
+    Or,        // the lines with any of the words
+    Postings   // the packed list of one word
+};
+
+enum class Query_status : std::uint16_t
+{
+    Ok,
+    Bad_request
+};
+
+struct Query_request
+{
+    std::uint32_t size;       // of the words
+    std::uint32_t id;
+    std::uint16_t op;
+    std::uint16_t num_words;
+    std::uint32_t reserved;
+};
+
+struct Query_reply
+{
+    std::uint32_t size;       // of what comes after the reply
+    std::uint32_t id;
+    std::uint16_t status;
+    std::uint16_t op;
+    std::uint32_t count;      // of the lines
+};
+
+static_assert(sizeof(Query_request) == 16 && sizeof(Query_reply) == 16, "the headers are 16 bytes on the wire");
+
+constexpr std::uint32_t max_request_size = 64 * 1024;
+constexpr std::uint16_t max_query_words = 64;
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef _TOKENIZER_H_
+#define _TOKENIZER_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "../../tooling/utf8/Utf8.h"
+
+/*
+
+    - Tokenizer splits a string_view into words, like iss >> word on a std::istringstream
+      of the line, and removes the punctuation from every word, like clean_string, without
+      a stream, a locale or an allocation per line.
+
+    - the delimiters separate the words, whitespace by default, the punctuation is dropped
+      from the words, ".,;:!?" by default. a word that is only punctuation is still a word,
+      an empty one, as clean_string gives "".
+
+    - the text is UTF-8, a whitespace of another script, utf8::kind (tooling/utf8/Utf8.h),
+      is a delimiter too and its punctuation, “ ” ‘ ’ and …, is dropped like the other
+      punctuation, the way Word_counter cleans words. the ASCII bytes are only the sets.
+
+    - next gives a view into the text, unless the punctuation is inside the word, e.g.
+      "o'er.there", then the view is into a buffer of the Tokenizer and lives only until the
+      next call. the text has to outlive the Tokenizer.
+
+*/
+class Char_set
+{
+private:
+    bool table[256];
+
+public:
+    explicit Char_set(std::string_view chars) : table{}
+    {
+        for (char ch : chars)
+            this->table[static_cast<unsigned char>(ch)] = true;
+    }
+
+    bool contains(char ch) const
+    {
+        return this->table[static_cast<unsigned char>(ch)];
+    }
+};
+
+class Tokenizer
+{
+private:
+    std::string_view text;
+    std::size_t position;
+    Char_set delimiters;
+    Char_set punctuation;
+    std::string buffer;
+
+    // the bytes of the code point at i when it is of kind, 0 otherwise
+    std::size_t unicode_at(std::size_t i, utf8::Kind kind) const
+    {
+        std::size_t length;
+        return utf8::kind(utf8::decode(this->text.data() + i, this->text.size() - i, length)) == kind ? length : 0;
+    }
+
+    std::size_t delimiter_at(std::size_t i) const
+    {
+        if (this->delimiters.contains(this->text[i]))
+            return 1;
+        return static_cast<unsigned char>(this->text[i]) < 0x80 ? 0 : this->unicode_at(i, utf8::Kind::space);
+    }
+
+    std::size_t punctuation_at(std::size_t i) const
+    {
+        if (this->punctuation.contains(this->text[i]))
+            return 1;
+        return static_cast<unsigned char>(this->text[i]) < 0x80 ? 0 : this->unicode_at(i, utf8::Kind::punctuation);
+    }
+
+    // 1 for ASCII and an invalid byte
+    std::size_t code_point_length(std::size_t i) const
+    {
+        if (static_cast<unsigned char>(this->text[i]) < 0x80)
+            return 1;
+        std::size_t length;
+        utf8::decode(this->text.data() + i, this->text.size() - i, length);
+        return length;
+    }
+
+    // the bytes of the code point before end when it is punctuation, 0 otherwise
+    std::size_t punctuation_before(std::size_t begin, std::size_t end) const
+    {
+        if (static_cast<unsigned char>(this->text[end - 1]) < 0x80)
+            return this->punctuation.contains(this->text[end - 1]) ? 1 : 0;
+        const std::size_t start = utf8::previous(this->text.data(), begin, end);
+        return this->punctuation_at(start) == end - start ? end - start : 0;
+    }
+
+public:
+    static constexpr std::string_view whitespace {" \t\n\v\f\r"};
+    static constexpr std::string_view default_punctuation {".,;:!?"};
+
+    explicit Tokenizer(std::string_view text,
+                       std::string_view delimiters = whitespace,
+                       std::string_view punctuation = default_punctuation)
+        : text{text}, position{0}, delimiters{delimiters}, punctuation{punctuation}
+    {
+    }
+
+    // starts again on another text, keeps the sets
+    void reset(std::string_view text)
+    {
+        this->text = text;
+        this->position = 0;
+    }
+
+    // false when there is no word left
+    bool next(std::string_view &word)
+    {
+        const std::size_t size = this->text.size();
+        std::size_t begin = this->position;
+        for (std::size_t length; begin < size && (length = this->delimiter_at(begin)) != 0; )
+            begin += length;
+        if (begin == size)
+        {
+            this->position = size;
+            return false;
+        }
+
+        std::size_t end = begin;
+        while (end < size && this->delimiter_at(end) == 0)
+            end += this->code_point_length(end);
+        this->position = end;
+
+        // the punctuation around the word only moves the ends of the view
+        for (std::size_t length; begin < end && (length = this->punctuation_at(begin)) != 0; )
+            begin += length;
+        for (std::size_t length; end > begin && (length = this->punctuation_before(begin, end)) != 0; )
+            end -= length;
+
+        std::size_t i = begin;
+        while (i < end && this->punctuation_at(i) == 0)
+            i += this->code_point_length(i);
+        if (i == end)
+        {
+            word = this->text.substr(begin, end - begin);
+            return true;
+        }
+
+        this->buffer.assign(this->text.data() + begin, i - begin);
+        while (i < end)
+        {
+            const std::size_t length = this->punctuation_at(i);
+            if (length != 0)
+            {
+                i += length;
+                continue;
+            }
+            const std::size_t bytes = this->code_point_length(i);
+            this->buffer.append(this->text.data() + i, bytes);
+            i += bytes;
+        }
+        word = this->buffer;
+        return true;
+    }
+};
+
+#endif
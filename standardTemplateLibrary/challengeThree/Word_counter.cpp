@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Word_counter.h"
+#include "../../tooling/largeBuffer/Large_buffer.h"
+#include "../../tooling/utf8/Utf8.h"
+
+namespace
+{
+    constexpr std::size_t block_size = 64 * 1024;
+    constexpr std::size_t read_size = 1024 * 1024;
+
+    enum Char_kind : unsigned char
+    {
+        Letter,
+        Space,
+        Punctuation
+    };
+
+    struct Char_table
+    {
+        Char_kind kind[256];
+        char lower[256];
+
+        Char_table() : kind{}, lower{}
+        {
+            for (int c = 0; c < 256; ++c)
+                this->lower[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            for (unsigned char c : std::string_view{" \t\n\v\f\r"})
+                this->kind[c] = Space;
+            for (unsigned char c : std::string_view{".,;:!?"})
+                this->kind[c] = Punctuation;
+        }
+    };
+
+    const Char_table table;
+
+    // the bytes of the UTF-8 whitespace at text, 0 when there is none, a byte over 127 is a letter in table
+    inline std::size_t unicode_space(const char *text, std::size_t size)
+    {
+        std::size_t length;
+        return utf8::kind(utf8::decode(text, size, length)) == utf8::Kind::space ? length : 0;
+    }
+}
+
+// 8 bytes at a time, mixed with a multiply and a shift
+std::uint64_t hash_word(std::string_view word)
+{
+    std::uint64_t hash = 0x9e3779b97f4a7c15u ^ word.size();
+    const char *data = word.data();
+    std::size_t size = word.size();
+
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t value;
+        std::memcpy(&value, data, 8);
+        hash = (hash ^ value) * 0xff51afd7ed558ccdu;
+        hash ^= hash >> 32;
+    }
+    if (size > 0)
+    {
+        std::uint64_t value = 0;
+        std::memcpy(&value, data, size);
+        hash = (hash ^ value) * 0xff51afd7ed558ccdu;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53u;
+    return hash ^ (hash >> 33);
+}
+
+Word_counter::Word_counter(bool fold_case)
+    : fold_case{fold_case}, slots(1024), total{0}, arena{nullptr}, arena_left{0}
+{
+}
+
+// a word longer than a block gets a block of its own
+const char *Word_counter::store(std::string_view word)
+{
+    if (this->arena == nullptr || word.size() > this->arena_left)
+    {
+        const std::size_t size = std::max(block_size, word.size());
+        this->blocks.push_back(std::make_unique<char[]>(size));
+        this->arena = this->blocks.back().get();
+        this->arena_left = size;
+    }
+
+    char *key = this->arena;
+    if (!word.empty())
+        std::memcpy(key, word.data(), word.size());
+    this->arena += word.size();
+    this->arena_left -= word.size();
+    return key;
+}
+
+// the hashes are kept, growing only moves the slots
+void Word_counter::grow()
+{
+    std::vector<Slot> slots(this->slots.size() * 2);
+    const std::size_t mask = slots.size() - 1;
+
+    for (const Slot &slot : this->slots)
+    {
+        if (slot.key == nullptr)
+            continue;
+        std::size_t i = slot.hash & mask;
+        while (slots[i].key != nullptr)
+            i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+
+    this->slots = std::move(slots);
+}
+
+std::uint32_t Word_counter::add(std::string_view word, std::uint64_t count)
+{
+    const std::uint64_t hash = hash_word(word);
+    const std::size_t mask = this->slots.size() - 1;
+
+    std::size_t i = hash & mask;
+    while (this->slots[i].key != nullptr)
+    {
+        Slot &slot = this->slots[i];
+        if (slot.hash == hash && std::string_view{slot.key, slot.length} == word)
+        {
+            slot.count += count;
+            this->total += count;
+            return slot.id;
+        }
+        i = (i + 1) & mask;
+    }
+
+    if (word.size() > UINT32_MAX || this->words.size() == no_word)
+        throw std::runtime_error("a word is at most 4 GiB, and there are at most 4G words");
+
+    const std::uint32_t id = static_cast<std::uint32_t>(this->words.size());
+    const char *key = this->store(word);
+    this->slots[i] = Slot{hash, key, static_cast<std::uint32_t>(word.size()), id, count};
+    this->words.emplace_back(key, word.size());
+    this->total += count;
+    if (this->words.size() * 2 > this->slots.size())
+        this->grow();
+    return id;
+}
+
+/*
+
+    - the words are cleaned where they are, returns where the word cut by the end of the
+      block starts, unless it is the last block.
+
+    - the bytes over 127 are UTF-8: the whitespaces of utf8::kind split words too, its
+      punctuation is dropped, “ ” and … with the ".,;:!?" of the table, and fold_case folds
+      the code points with utf8::fold, never into more bytes, so out stays behind j. an
+      invalid byte is kept, a sequence cut by the end of the block is invalid, it is in the
+      word read again with the next block. ASCII goes by the table alone.
+
+*/
+std::size_t Word_counter::count_block(char *text, std::size_t size, bool last)
+{
+    std::size_t i = 0;
+    while (true)
+    {
+        while (i < size)
+        {
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+            std::size_t length = 0;
+            if (table.kind[c] == Space)
+                length = 1;
+            else if (c >= 0x80)
+                length = unicode_space(text + i, size - i);
+            if (length == 0)
+                break;
+            i += length;
+        }
+        if (i == size)
+            return size;
+
+        const std::size_t begin = i;
+        while (i < size)
+        {
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+            if (table.kind[c] == Space)
+                break;
+            if (c < 0x80)
+            {
+                ++i;
+                continue;
+            }
+            std::size_t length;
+            if (utf8::kind(utf8::decode(text + i, size - i, length)) == utf8::Kind::space)
+                break;
+            i += length;
+        }
+        if (i == size && !last)
+            return begin;
+
+        char *out = text + begin;
+        for (std::size_t j = begin; j < i; )
+        {
+            const unsigned char c = static_cast<unsigned char>(text[j]);
+            if (c < 0x80)
+            {
+                if (table.kind[c] != Punctuation)
+                    *out++ = this->fold_case ? table.lower[c] : static_cast<char>(c);
+                ++j;
+                continue;
+            }
+
+            std::size_t length;
+            const char32_t cp = utf8::decode(text + j, i - j, length);
+            if (cp == utf8::invalid)
+                *out++ = static_cast<char>(c);
+            else if (utf8::kind(cp) != utf8::Kind::punctuation)
+            {
+                if (this->fold_case)
+                    out += utf8::encode(utf8::fold(cp), out);
+                else
+                {
+                    std::memmove(out, text + j, length);
+                    out += length;
+                }
+            }
+            j += length;
+        }
+        this->add(std::string_view{text + begin, static_cast<std::size_t>(out - (text + begin))});
+    }
+}
+
+// a word cut by the end of a block is moved to the front and read again with the next one,
+// read fills the buffer it is given and is false when there is nothing after it, the buffer
+// is not zeroed before the reads overwrite it
+template<typename Read>
+void Word_counter::count_blocks(Read read)
+{
+    large_buffer::Vector<char> buffer(read_size);
+    std::size_t kept = 0;
+
+    while (true)
+    {
+        if (kept == buffer.size())
+            buffer.resize(buffer.size() * 2);
+
+        std::size_t size = kept;
+        const bool last = !read(buffer.data() + kept, buffer.size() - kept, size);
+
+        const std::size_t used = this->count_block(buffer.data(), size, last);
+        if (last)
+            return;
+
+        kept = size - used;
+        std::memmove(buffer.data(), buffer.data() + used, kept);
+    }
+}
+
+void Word_counter::count(std::istream &in)
+{
+    this->count_blocks([&in](char *buffer, std::size_t capacity, std::size_t &size)
+    {
+        in.read(buffer, static_cast<std::streamsize>(capacity));
+        size += static_cast<std::size_t>(in.gcount());
+        if (in.bad())
+            throw std::runtime_error("the words could not be read");
+        return static_cast<bool>(in);
+    });
+}
+
+void Word_counter::count(std::string_view text)
+{
+    this->count_blocks([&text](char *buffer, std::size_t capacity, std::size_t &size)
+    {
+        const std::size_t n = std::min(capacity, text.size());
+        if (n > 0)
+            std::memcpy(buffer, text.data(), n);
+        text.remove_prefix(n);
+        size += n;
+        return !text.empty();
+    });
+}
+
+// the slots of the other counter are read as they are, every word is added once
+void Word_counter::merge(const Word_counter &other)
+{
+    for (const Slot &slot : other.slots)
+        if (slot.key != nullptr)
+            this->add(std::string_view{slot.key, slot.length}, slot.count);
+}
+
+std::size_t Word_counter::size() const
+{
+    return this->words.size();
+}
+
+std::uint64_t Word_counter::get_total() const
+{
+    return this->total;
+}
+
+std::uint64_t Word_counter::get_count(std::string_view word) const
+{
+    const std::uint64_t hash = hash_word(word);
+    const std::size_t mask = this->slots.size() - 1;
+
+    for (std::size_t i = hash & mask; this->slots[i].key != nullptr; i = (i + 1) & mask)
+    {
+        const Slot &slot = this->slots[i];
+        if (slot.hash == hash && std::string_view{slot.key, slot.length} == word)
+            return slot.count;
+    }
+    return 0;
+}
+
+std::uint32_t Word_counter::get_id(std::string_view word) const
+{
+    const std::uint64_t hash = hash_word(word);
+    const std::size_t mask = this->slots.size() - 1;
+
+    for (std::size_t i = hash & mask; this->slots[i].key != nullptr; i = (i + 1) & mask)
+    {
+        const Slot &slot = this->slots[i];
+        if (slot.hash == hash && std::string_view{slot.key, slot.length} == word)
+            return slot.id;
+    }
+    return no_word;
+}
+
+void Word_counter::find_batch(const std::vector<std::string_view> &words, std::vector<std::uint32_t> &ids) const
+{
+    ids.resize(words.size());
+    const std::size_t mask = this->slots.size() - 1;
+    std::uint64_t hashes[group_size];
+    const Slot *found[group_size];
+
+    for (std::size_t begin = 0; begin < words.size(); begin += group_size)
+    {
+        const std::size_t n = std::min(group_size, words.size() - begin);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            hashes[i] = hash_word(words[begin + i]);
+            __builtin_prefetch(&this->slots[hashes[i] & mask]);
+        }
+
+        // the first slot of the same hash, a collision of the whole hash is left to get_id
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::size_t slot = hashes[i] & mask;
+            while (this->slots[slot].key != nullptr && this->slots[slot].hash != hashes[i])
+                slot = (slot + 1) & mask;
+            found[i] = this->slots[slot].key != nullptr ? &this->slots[slot] : nullptr;
+            if (found[i] != nullptr)
+                __builtin_prefetch(found[i]->key);
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::string_view word = words[begin + i];
+            if (found[i] == nullptr)
+                ids[begin + i] = no_word;
+            else if (std::string_view{found[i]->key, found[i]->length} == word)
+                ids[begin + i] = found[i]->id;
+            else
+                ids[begin + i] = this->get_id(word);
+        }
+    }
+}
+
+std::string_view Word_counter::get_word(std::uint32_t id) const
+{
+    return this->words[id];
+}
+
+std::vector<Word_count> Word_counter::sorted() const
+{
+    std::vector<Word_count> words;
+    words.reserve(this->words.size());
+    for (const Slot &slot : this->slots)
+        if (slot.key != nullptr)
+            words.push_back(Word_count{std::string_view{slot.key, slot.length}, slot.count});
+
+    std::sort(words.begin(), words.end(), [](const Word_count &a, const Word_count &b)
+    {
+        return a.word < b.word;
+    });
+    return words;
+}
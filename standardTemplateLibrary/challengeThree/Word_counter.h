@@ -0,0 +1,103 @@
+#ifndef _WORD_COUNTER_H_
+#define _WORD_COUNTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - Word_counter counts the words of a text in an open addressing hash table, the slots
+      are one vector probed one after the other, and every key is copied once into an arena,
+      the first time the word is seen, a word seen again costs a hash and a compare.
+
+    - the text is read in blocks, the words are split on whitespace and cleaned in the block
+      itself: the punctuation ".,;:!?" is dropped and, with fold_case, the letters are made
+      lower case. a word that is only punctuation is counted as "", like clean_string does.
+      the text is UTF-8, the whitespaces and the punctuation of other scripts are the
+      ones of utf8::kind and fold_case folds them with utf8::fold (tooling/utf8/Utf8.h),
+      "BRONTË" and "Brontë" are one word.
+
+    - sorted gives the words in the order of a std::map<std::string, int>, it is the only
+      sort, done once at the end. the views live as long as the Word_counter.
+
+    - every word has an id, the number of words seen before it, so other tables can keep
+      a vector by id instead of a key, see Inverted_index.h.
+
+    - merge adds the counts of another counter, the counters of the chunks of a text can be
+      counted on their own threads and merged after, see Parallel_count.h.
+
+    - find_batch looks up many words in groups of group_size, every word of the group hashed
+      and its slot prefetched, then probed and its key in the arena prefetched, then
+      compared, the cache misses of a group overlap instead of waiting one after the other.
+
+*/
+// the hash of the table, 8 bytes of the word at a time, a sketch of the words hashes them
+// with it too, see Word_sketch.h
+std::uint64_t hash_word(std::string_view word);
+
+struct Word_count
+{
+    std::string_view word;
+    std::uint64_t count;
+};
+
+class Word_counter
+{
+private:
+    struct Slot
+    {
+        std::uint64_t hash;
+        const char *key;       // nullptr is an empty slot
+        std::uint32_t length;
+        std::uint32_t id;
+        std::uint64_t count;
+    };
+
+    static constexpr std::size_t group_size = 16;
+
+    bool fold_case;
+    std::vector<Slot> slots;  // a power of 2, at most half full
+    std::vector<std::string_view> words;  // by id
+    std::uint64_t total;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *arena;              // the free bytes of the last block
+    std::size_t arena_left;
+
+    const char *store(std::string_view word);
+    void grow();
+    std::size_t count_block(char *text, std::size_t size, bool last);
+    template<typename Read>
+    void count_blocks(Read read);
+
+public:
+    static constexpr std::uint32_t no_word = UINT32_MAX;
+
+    explicit Word_counter(bool fold_case = false);
+
+    Word_counter(const Word_counter &) = delete;
+    Word_counter &operator=(const Word_counter &) = delete;
+
+    // a word as it is, not cleaned, returns its id
+    std::uint32_t add(std::string_view word, std::uint64_t count = 1);
+
+    // throws std::runtime_error when the stream fails before its end
+    void count(std::istream &in);
+    // the text is not changed, its blocks are cleaned in a buffer
+    void count(std::string_view text);
+    void merge(const Word_counter &other);
+
+    std::size_t size() const;
+    std::uint64_t get_total() const;
+    std::uint64_t get_count(std::string_view word) const;
+    std::uint32_t get_id(std::string_view word) const;  // no_word when it was not seen
+    // ids[i] is get_id(words[i])
+    void find_batch(const std::vector<std::string_view> &words, std::vector<std::uint32_t> &ids) const;
+    std::string_view get_word(std::uint32_t id) const;
+    std::vector<Word_count> sorted() const;
+};
+
+#endif
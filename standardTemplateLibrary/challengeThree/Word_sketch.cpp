@@ -0,0 +1,682 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "Tokenizer.h"
+#include "Word_counter.h"
+#include "Word_sketch.h"
+
+namespace
+{
+    constexpr char magic[8] = {'w', 'o', 'r', 'd', 'S', 'k', 't', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::uint32_t byte_order = 0x01020304;
+
+    // the sparse list is sorted into when it has that many more
+    constexpr std::size_t pending_size = 1024;
+    // the bytes of the registers, the sparse list is at most as big
+    constexpr std::size_t num_registers = std::size_t{1} << Hyper_log_log::precision;
+    constexpr std::size_t max_sparse = num_registers / sizeof(std::uint32_t);
+    constexpr double linear_counting_threshold = 11500;
+    // more words is not a summary of a few counts, a damaged size is not allocated
+    constexpr std::uint64_t max_capacity = std::uint64_t{1} << 24;
+
+    void invalid(const std::string &why)
+    {
+        throw std::runtime_error("not a word sketch, " + why);
+    }
+
+    template<typename T>
+    void put(std::string &out, T value)
+    {
+        out.append(reinterpret_cast<const char *>(&value), sizeof value);
+    }
+
+    template<typename T>
+    T get(std::string_view &in)
+    {
+        if (in.size() < sizeof(T))
+            invalid("it ends too soon");
+        T value;
+        std::memcpy(&value, in.data(), sizeof value);
+        in.remove_prefix(sizeof value);
+        return value;
+    }
+
+    std::string_view get_bytes(std::string_view &in, std::uint64_t size)
+    {
+        if (in.size() < size)
+            invalid("it ends too soon");
+        const std::string_view bytes = in.substr(0, size);
+        in.remove_prefix(size);
+        return bytes;
+    }
+
+    // the leading zeros of the top bits of value + 1, bits + 1 when they are all 0
+    std::uint8_t rank(std::uint64_t value, unsigned bits)
+    {
+        return value == 0 ? static_cast<std::uint8_t>(bits + 1) : static_cast<std::uint8_t>(__builtin_clzll(value) + 1);
+    }
+
+    // the register and the rank of the hash of a sparse entry
+    void dense_of(std::uint32_t entry, std::size_t &index, std::uint8_t &rho)
+    {
+        constexpr unsigned extra = Hyper_log_log::sparse_precision - Hyper_log_log::precision;
+        const std::uint32_t sparse_index = entry >> 6;
+        const std::uint32_t low = sparse_index & ((1u << extra) - 1);
+        index = sparse_index >> extra;
+        rho = low != 0 ? static_cast<std::uint8_t>(__builtin_clz(low) - (32 - extra) + 1)
+                       : static_cast<std::uint8_t>(extra + (entry & 63));
+    }
+}
+
+Count_min::Count_min(std::size_t width, std::size_t depth)
+    : width{1}, depth{depth == 0 ? 1 : depth}
+{
+    while (this->width < width)
+        this->width *= 2;
+    this->counters.assign(this->width * this->depth, 0);
+}
+
+// the rows are the cells h1 + row * h2 of the two halves of the hash
+std::size_t Count_min::cell(std::uint64_t hash, std::size_t row) const
+{
+    const std::uint64_t h1 = hash & 0xffffffffu;
+    const std::uint64_t h2 = (hash >> 32) | 1;
+    return row * this->width + ((h1 + row * h2) & (this->width - 1));
+}
+
+void Count_min::add(std::uint64_t hash, std::uint64_t count)
+{
+    const std::uint64_t raised = this->estimate(hash) + count;
+    for (std::size_t row = 0; row < this->depth; ++row)
+    {
+        std::uint64_t &counter = this->counters[this->cell(hash, row)];
+        counter = std::max(counter, raised);
+    }
+}
+
+std::uint64_t Count_min::estimate(std::uint64_t hash) const
+{
+    std::uint64_t smallest = this->counters[this->cell(hash, 0)];
+    for (std::size_t row = 1; row < this->depth; ++row)
+        smallest = std::min(smallest, this->counters[this->cell(hash, row)]);
+    return smallest;
+}
+
+void Count_min::merge(const Count_min &other)
+{
+    if (other.width != this->width || other.depth != this->depth)
+        throw std::runtime_error("count-min sketches of different sizes can not be merged");
+    for (std::size_t i = 0; i < this->counters.size(); ++i)
+        this->counters[i] += other.counters[i];
+}
+
+std::size_t Count_min::get_width() const
+{
+    return this->width;
+}
+
+std::size_t Count_min::get_depth() const
+{
+    return this->depth;
+}
+
+void Count_min::serialize(std::string &out) const
+{
+    put<std::uint64_t>(out, this->width);
+    put<std::uint64_t>(out, this->depth);
+    out.append(reinterpret_cast<const char *>(this->counters.data()), this->counters.size() * sizeof(std::uint64_t));
+}
+
+Count_min Count_min::deserialize(std::string_view &in)
+{
+    const std::uint64_t width = get<std::uint64_t>(in);
+    const std::uint64_t depth = get<std::uint64_t>(in);
+    if (width == 0 || (width & (width - 1)) != 0 || depth == 0 || width > (std::uint64_t{1} << 32) || depth > 64)
+        invalid("the size of the count-min sketch is wrong");
+
+    const std::string_view bytes = get_bytes(in, width * depth * sizeof(std::uint64_t));
+    Count_min sketch {width, depth};
+    std::memcpy(sketch.counters.data(), bytes.data(), bytes.size());
+    return sketch;
+}
+
+Space_saving::Space_saving(std::size_t capacity)
+    : capacity{capacity == 0 ? 1 : capacity}
+{
+    std::size_t num_slots = 16;
+    while (num_slots < 2 * this->capacity)
+        num_slots *= 2;
+    this->slots.assign(num_slots, 0);
+    this->entries.reserve(this->capacity);
+}
+
+// the slot of the word, or the empty one where it goes
+std::size_t Space_saving::find_slot(std::string_view word, std::uint64_t hash) const
+{
+    const std::size_t mask = this->slots.size() - 1;
+    std::size_t i = hash & mask;
+    while (this->slots[i] != 0)
+    {
+        const Entry &entry = this->entries[this->slots[i] - 1];
+        if (entry.hash == hash && entry.word == word)
+            return i;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// the slots after it that are not at their place move back, no tombstones
+void Space_saving::erase_slot(std::size_t i)
+{
+    const std::size_t mask = this->slots.size() - 1;
+    for (std::size_t j = (i + 1) & mask; this->slots[j] != 0; j = (j + 1) & mask)
+    {
+        const std::size_t home = this->entries[this->slots[j] - 1].hash & mask;
+        // home is not in (i, j], cyclically
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            this->slots[i] = this->slots[j];
+            i = j;
+        }
+    }
+    this->slots[i] = 0;
+}
+
+void Space_saving::swap_heap(std::size_t i, std::size_t j)
+{
+    std::swap(this->heap[i], this->heap[j]);
+    this->heap_at[this->heap[i]] = static_cast<std::uint32_t>(i);
+    this->heap_at[this->heap[j]] = static_cast<std::uint32_t>(j);
+}
+
+void Space_saving::sift_up(std::size_t i)
+{
+    while (i > 0)
+    {
+        const std::size_t parent = (i - 1) / 2;
+        if (this->entries[this->heap[parent]].count <= this->entries[this->heap[i]].count)
+            return;
+        this->swap_heap(i, parent);
+        i = parent;
+    }
+}
+
+void Space_saving::sift_down(std::size_t i)
+{
+    const std::size_t size = this->heap.size();
+    for (;;)
+    {
+        std::size_t smallest = i;
+        const std::size_t left = 2 * i + 1;
+        const std::size_t right = left + 1;
+        if (left < size && this->entries[this->heap[left]].count < this->entries[this->heap[smallest]].count)
+            smallest = left;
+        if (right < size && this->entries[this->heap[right]].count < this->entries[this->heap[smallest]].count)
+            smallest = right;
+        if (smallest == i)
+            return;
+        this->swap_heap(i, smallest);
+        i = smallest;
+    }
+}
+
+// false when a word is there twice
+bool Space_saving::rebuild(std::vector<Entry> entries)
+{
+    this->entries = std::move(entries);
+    this->heap.resize(this->entries.size());
+    this->heap_at.resize(this->entries.size());
+    std::fill(this->slots.begin(), this->slots.end(), 0);
+    for (std::size_t i = 0; i < this->entries.size(); ++i)
+    {
+        this->heap[i] = static_cast<std::uint32_t>(i);
+        this->heap_at[i] = static_cast<std::uint32_t>(i);
+        const std::size_t slot = this->find_slot(this->entries[i].word, this->entries[i].hash);
+        if (this->slots[slot] != 0)
+            return false;
+        this->slots[slot] = static_cast<std::uint32_t>(i + 1);
+    }
+    for (std::size_t i = this->heap.size() / 2; i-- > 0;)
+        this->sift_down(i);
+    return true;
+}
+
+// bound is at least the true count, the count never goes over it, a word of a bound that
+// is not more than the smallest count can not be one of the largest, it is not added
+void Space_saving::add(std::string_view word, std::uint64_t hash, std::uint64_t count, std::uint64_t bound)
+{
+    std::size_t slot = this->find_slot(word, hash);
+    if (this->slots[slot] != 0)
+    {
+        const std::uint32_t id = this->slots[slot] - 1;
+        Entry &entry = this->entries[id];
+        const std::uint64_t was = entry.count;
+        entry.count += count;
+        if (entry.count > bound)
+        {
+            entry.error -= std::min(entry.error, entry.count - bound);
+            entry.count = bound;
+        }
+        if (entry.count < was)
+            this->sift_up(this->heap_at[id]);
+        else
+            this->sift_down(this->heap_at[id]);
+        return;
+    }
+
+    if (this->entries.size() < this->capacity)
+    {
+        const std::uint32_t id = static_cast<std::uint32_t>(this->entries.size());
+        this->entries.push_back(Entry{std::string{word}, hash, count, 0});
+        this->heap.push_back(id);
+        this->heap_at.push_back(static_cast<std::uint32_t>(this->heap.size() - 1));
+        this->sift_up(this->heap.size() - 1);
+        this->slots[slot] = id + 1;
+        return;
+    }
+
+    const std::uint32_t id = this->heap.front();
+    Entry &entry = this->entries[id];
+    if (bound <= entry.count)
+        return;
+
+    // the word takes the place of the smallest count, erasing it moves the slots
+    this->erase_slot(this->find_slot(entry.word, entry.hash));
+    entry.count = std::min(entry.count + count, bound);
+    entry.error = entry.count - count;
+    entry.word.assign(word.data(), word.size());
+    entry.hash = hash;
+    this->slots[this->find_slot(word, hash)] = id + 1;
+    this->sift_down(0);
+}
+
+// a word missing from one summary may have up to its smallest count there
+void Space_saving::merge(const Space_saving &other)
+{
+    const std::uint64_t this_min = this->get_min();
+    const std::uint64_t other_min = other.get_min();
+
+    std::vector<Entry> merged;
+    merged.reserve(this->entries.size() + other.entries.size());
+    for (const Entry &entry : this->entries)
+    {
+        const std::size_t slot = other.find_slot(entry.word, entry.hash);
+        if (other.slots[slot] != 0)
+        {
+            const Entry &same = other.entries[other.slots[slot] - 1];
+            merged.push_back(Entry{entry.word, entry.hash, entry.count + same.count, entry.error + same.error});
+        }
+        else
+            merged.push_back(Entry{entry.word, entry.hash, entry.count + other_min, entry.error + other_min});
+    }
+    for (const Entry &entry : other.entries)
+        if (this->slots[this->find_slot(entry.word, entry.hash)] == 0)
+            merged.push_back(Entry{entry.word, entry.hash, entry.count + this_min, entry.error + this_min});
+
+    if (merged.size() > this->capacity)
+    {
+        std::nth_element(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(this->capacity), merged.end(),
+            [](const Entry &a, const Entry &b) { return a.count > b.count; });
+        merged.resize(this->capacity);
+    }
+    this->rebuild(std::move(merged));
+}
+
+std::size_t Space_saving::size() const
+{
+    return this->entries.size();
+}
+
+std::size_t Space_saving::get_capacity() const
+{
+    return this->capacity;
+}
+
+std::uint64_t Space_saving::get_min() const
+{
+    return this->entries.size() < this->capacity ? 0 : this->entries[this->heap.front()].count;
+}
+
+std::vector<Word_estimate> Space_saving::top(std::size_t k) const
+{
+    std::vector<Word_estimate> words;
+    words.reserve(this->entries.size());
+    for (const Entry &entry : this->entries)
+        words.push_back(Word_estimate{entry.word, entry.count, entry.error});
+
+    k = std::min(k, words.size());
+    std::partial_sort(words.begin(), words.begin() + static_cast<std::ptrdiff_t>(k), words.end(),
+        [](const Word_estimate &a, const Word_estimate &b)
+        {
+            return a.count != b.count ? a.count > b.count : a.word < b.word;
+        });
+    words.resize(k);
+    return words;
+}
+
+void Space_saving::serialize(std::string &out) const
+{
+    put<std::uint64_t>(out, this->capacity);
+    put<std::uint64_t>(out, this->entries.size());
+    for (const Entry &entry : this->entries)
+    {
+        put<std::uint64_t>(out, entry.count);
+        put<std::uint64_t>(out, entry.error);
+        put<std::uint64_t>(out, entry.word.size());
+        out += entry.word;
+    }
+}
+
+Space_saving Space_saving::deserialize(std::string_view &in)
+{
+    const std::uint64_t capacity = get<std::uint64_t>(in);
+    const std::uint64_t size = get<std::uint64_t>(in);
+    if (capacity == 0 || capacity > max_capacity || size > capacity)
+        invalid("the size of the space saving summary is wrong");
+
+    Space_saving summary {capacity};
+    std::vector<Entry> entries;
+    entries.reserve(size);
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        const std::uint64_t count = get<std::uint64_t>(in);
+        const std::uint64_t error = get<std::uint64_t>(in);
+        const std::string_view word = get_bytes(in, get<std::uint64_t>(in));
+        if (error > count)
+            invalid("an error is larger than its count");
+        entries.push_back(Entry{std::string{word}, hash_word(word), count, error});
+    }
+    if (!summary.rebuild(std::move(entries)))
+        invalid("a word is there twice");
+    return summary;
+}
+
+Hyper_log_log::Hyper_log_log()
+{
+    this->pending.reserve(pending_size);
+}
+
+// the pending entries sorted into the list, of the same index only the largest rank stays
+void Hyper_log_log::flush() const
+{
+    if (this->pending.empty())
+        return;
+    std::sort(this->pending.begin(), this->pending.end());
+    const std::size_t sorted = this->sparse.size();
+    this->sparse.insert(this->sparse.end(), this->pending.begin(), this->pending.end());
+    this->pending.clear();
+    std::inplace_merge(this->sparse.begin(), this->sparse.begin() + static_cast<std::ptrdiff_t>(sorted), this->sparse.end());
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < this->sparse.size(); ++i)
+    {
+        if (kept > 0 && this->sparse[kept - 1] >> 6 == this->sparse[i] >> 6)
+            this->sparse[kept - 1] = this->sparse[i];
+        else
+            this->sparse[kept++] = this->sparse[i];
+    }
+    this->sparse.resize(kept);
+}
+
+void Hyper_log_log::to_dense()
+{
+    this->flush();
+    this->registers.assign(num_registers, 0);
+    for (std::uint32_t entry : this->sparse)
+    {
+        std::size_t index;
+        std::uint8_t rho;
+        dense_of(entry, index, rho);
+        this->registers[index] = std::max(this->registers[index], rho);
+    }
+    this->sparse.clear();
+    this->sparse.shrink_to_fit();
+    this->pending.clear();
+    this->pending.shrink_to_fit();
+}
+
+void Hyper_log_log::add(std::uint64_t hash)
+{
+    if (!this->registers.empty())
+    {
+        std::uint8_t &reg = this->registers[hash >> (64 - precision)];
+        reg = std::max(reg, rank(hash << precision, 64 - precision));
+        return;
+    }
+
+    const std::uint32_t index = static_cast<std::uint32_t>(hash >> (64 - sparse_precision));
+    this->pending.push_back(index << 6 | rank(hash << sparse_precision, 64 - sparse_precision));
+    if (this->pending.size() < pending_size)
+        return;
+    this->flush();
+    if (this->sparse.size() > max_sparse)
+        this->to_dense();
+}
+
+std::uint64_t Hyper_log_log::estimate() const
+{
+    if (this->registers.empty())
+    {
+        // linear counting of the 2^25 sparse indexes, exact for a few thousand
+        this->flush();
+        const double m = static_cast<double>(std::uint64_t{1} << sparse_precision);
+        const double empty = m - static_cast<double>(this->sparse.size());
+        return static_cast<std::uint64_t>(std::llround(m * std::log(m / empty)));
+    }
+
+    const double m = static_cast<double>(num_registers);
+    double sum = 0;
+    std::size_t zeros = 0;
+    for (std::uint8_t reg : this->registers)
+    {
+        sum += std::ldexp(1.0, -static_cast<int>(reg));
+        zeros += reg == 0;
+    }
+    if (zeros > 0)
+    {
+        const double linear = m * std::log(m / static_cast<double>(zeros));
+        if (linear <= linear_counting_threshold)
+            return static_cast<std::uint64_t>(std::llround(linear));
+    }
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    return static_cast<std::uint64_t>(std::llround(alpha * m * m / sum));
+}
+
+void Hyper_log_log::merge(const Hyper_log_log &other)
+{
+    if (this->registers.empty() && other.registers.empty())
+    {
+        other.flush();
+        this->pending.insert(this->pending.end(), other.sparse.begin(), other.sparse.end());
+        this->flush();
+        if (this->sparse.size() > max_sparse)
+            this->to_dense();
+        return;
+    }
+
+    if (this->registers.empty())
+        this->to_dense();
+    if (!other.registers.empty())
+    {
+        for (std::size_t i = 0; i < num_registers; ++i)
+            this->registers[i] = std::max(this->registers[i], other.registers[i]);
+        return;
+    }
+    other.flush();
+    for (std::uint32_t entry : other.sparse)
+    {
+        std::size_t index;
+        std::uint8_t rho;
+        dense_of(entry, index, rho);
+        this->registers[index] = std::max(this->registers[index], rho);
+    }
+}
+
+bool Hyper_log_log::is_sparse() const
+{
+    return this->registers.empty();
+}
+
+void Hyper_log_log::serialize(std::string &out) const
+{
+    this->flush();
+    put<std::uint32_t>(out, this->is_sparse() ? 0 : 1);
+    put<std::uint32_t>(out, precision);
+    if (this->is_sparse())
+    {
+        put<std::uint64_t>(out, this->sparse.size());
+        out.append(reinterpret_cast<const char *>(this->sparse.data()), this->sparse.size() * sizeof(std::uint32_t));
+    }
+    else
+        out.append(reinterpret_cast<const char *>(this->registers.data()), this->registers.size());
+}
+
+Hyper_log_log Hyper_log_log::deserialize(std::string_view &in)
+{
+    const std::uint32_t dense = get<std::uint32_t>(in);
+    if (dense > 1 || get<std::uint32_t>(in) != precision)
+        invalid("the hyperloglog is not one of 2^14 registers");
+
+    Hyper_log_log sketch;
+    if (dense == 1)
+    {
+        const std::string_view bytes = get_bytes(in, num_registers);
+        sketch.registers.assign(bytes.begin(), bytes.end());
+        for (std::uint8_t reg : sketch.registers)
+            if (reg > 64 - precision + 1)
+                invalid("a register is out of range");
+        return sketch;
+    }
+
+    const std::uint64_t size = get<std::uint64_t>(in);
+    if (size > max_sparse)
+        invalid("the sparse list is too long");
+    const std::string_view bytes = get_bytes(in, size * sizeof(std::uint32_t));
+    sketch.sparse.resize(size);
+    if (size > 0)
+        std::memcpy(sketch.sparse.data(), bytes.data(), bytes.size());
+    for (std::size_t i = 0; i < sketch.sparse.size(); ++i)
+        if ((i > 0 && sketch.sparse[i - 1] >> 6 >= sketch.sparse[i] >> 6) || (sketch.sparse[i] & 63) > 64 - sparse_precision + 1)
+            invalid("the sparse list is not sorted or a rank is out of range");
+    return sketch;
+}
+
+Word_sketch::Word_sketch(std::size_t capacity, bool fold_case, std::size_t width, std::size_t depth)
+    : fold_case{fold_case}, total{0}, counts{width, depth}, heavy{capacity}
+{
+}
+
+void Word_sketch::add(std::string_view word, std::uint64_t count)
+{
+    if (this->fold_case)
+    {
+        this->folded.assign(word.data(), word.size());
+        for (char &c : this->folded)
+            if (c >= 'A' && c <= 'Z')
+                c = static_cast<char>(c - 'A' + 'a');
+        word = this->folded;
+    }
+
+    const std::uint64_t hash = hash_word(word);
+    this->counts.add(hash, count);
+    this->heavy.add(word, hash, count, this->counts.estimate(hash));
+    this->distinct.add(hash);
+    this->total += count;
+}
+
+void Word_sketch::count(std::string_view text)
+{
+    Tokenizer tokenizer {text};
+    std::string_view word;
+    while (tokenizer.next(word))
+        this->add(word);
+}
+
+void Word_sketch::merge(const Word_sketch &other)
+{
+    if (other.fold_case != this->fold_case)
+        throw std::runtime_error("sketches of folded and of unfolded words can not be merged");
+    this->counts.merge(other.counts);
+    this->heavy.merge(other.heavy);
+    this->distinct.merge(other.distinct);
+    this->total += other.total;
+}
+
+std::uint64_t Word_sketch::get_total() const
+{
+    return this->total;
+}
+
+std::uint64_t Word_sketch::estimate(std::string_view word) const
+{
+    if (!this->fold_case)
+        return this->counts.estimate(hash_word(word));
+
+    std::string folded {word};
+    for (char &c : folded)
+        if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+    return this->counts.estimate(hash_word(folded));
+}
+
+std::uint64_t Word_sketch::get_distinct() const
+{
+    return this->distinct.estimate();
+}
+
+std::vector<Word_estimate> Word_sketch::top(std::size_t k) const
+{
+    std::vector<Word_estimate> words = this->heavy.top(k);
+    for (Word_estimate &word : words)
+    {
+        const std::uint64_t bound = this->counts.estimate(hash_word(word.word));
+        if (bound < word.count)
+        {
+            word.error -= std::min(word.error, word.count - bound);
+            word.count = bound;
+        }
+    }
+    std::stable_sort(words.begin(), words.end(), [](const Word_estimate &a, const Word_estimate &b)
+    {
+        return a.count > b.count;
+    });
+    return words;
+}
+
+std::string Word_sketch::serialize() const
+{
+    std::string out {magic, sizeof magic};
+    put<std::uint32_t>(out, version);
+    put<std::uint32_t>(out, byte_order);
+    put<std::uint32_t>(out, this->fold_case ? 1 : 0);
+    put<std::uint32_t>(out, 0);
+    put<std::uint64_t>(out, this->total);
+    this->counts.serialize(out);
+    this->heavy.serialize(out);
+    this->distinct.serialize(out);
+    return out;
+}
+
+Word_sketch Word_sketch::deserialize(std::string_view bytes)
+{
+    if (bytes.substr(0, sizeof magic) != std::string_view{magic, sizeof magic})
+        invalid("the magic number is wrong");
+    bytes.remove_prefix(sizeof magic);
+    if (get<std::uint32_t>(bytes) != version)
+        invalid("the version is not " + std::to_string(version));
+    if (get<std::uint32_t>(bytes) != byte_order)
+        invalid("it is of another byte order");
+    const std::uint32_t fold_case = get<std::uint32_t>(bytes);
+    get<std::uint32_t>(bytes);
+
+    Word_sketch sketch {1, fold_case != 0, 1, 1};
+    sketch.total = get<std::uint64_t>(bytes);
+    sketch.counts = Count_min::deserialize(bytes);
+    sketch.heavy = Space_saving::deserialize(bytes);
+    sketch.distinct = Hyper_log_log::deserialize(bytes);
+    if (!bytes.empty())
+        invalid("there are bytes after it");
+    return sketch;
+}
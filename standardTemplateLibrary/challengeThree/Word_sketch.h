@@ -0,0 +1,180 @@
+#ifndef _WORD_SKETCH_H_
+#define _WORD_SKETCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - the approximate counts of a stream of words in memory that does not grow with the
+      stream: the counts of the most frequent words and the number of different words,
+      what a dashboard shows, without a table of every word like Word_counter.
+
+    - Count_min is depth rows of width counters, a word adds to one counter of every row
+      and its count is the smallest of them, never less than the true one. the update is
+      the conservative one, only the counters below the new smallest are raised, so the
+      counts of the rare words are much closer than with the plain one.
+
+    - Space_saving keeps capacity words with a count and the error of the count, a word
+      that is not there takes the place of the one with the smallest count, and its count
+      and error become that one's. a word that is more than 1 / capacity of the stream is
+      always there, its count is at most error more than the true one. in a Word_sketch
+      the Count_min estimate of a word bounds its count, a word of an estimate below the
+      smallest count does not take its place, the rare words stop pushing the frequent
+      ones out.
+
+    - Hyper_log_log is the HyperLogLog++ of 2^14 registers of 6 bits for the number of
+      different hashes: a 64 bit hash, a sparse list of 25 bit indexes while it is smaller
+      than the registers, exact up to a few thousand words, and linear counting below the
+      threshold of the paper, 11500 for 2^14, the error is about 0.8 %. the tables of the
+      empirical bias are not here, the raw estimate is used above the threshold.
+
+    - everything is mergeable: the sketches of the chunks of a text, counted on their own
+      threads, are merged into the sketch of the text, see Parallel_count.h, the counters
+      of Count_min are added, which keeps it an upper bound, Space_saving merges the way of
+      the mergeable summaries of Agarwal et al., Hyper_log_log takes the largest register.
+
+    - serialize writes a sketch to bytes in the byte order of the machine, deserialize reads
+      them back and checks them, errors throw std::runtime_error. Word_sketch is the three
+      over the words of a text, cleaned like Word_counter does, hashed with hash_word.
+
+*/
+class Count_min
+{
+private:
+    std::size_t width;  // a power of 2
+    std::size_t depth;
+    std::vector<std::uint64_t> counters;  // depth rows of width
+
+    std::size_t cell(std::uint64_t hash, std::size_t row) const;
+
+public:
+    explicit Count_min(std::size_t width = 1 << 14, std::size_t depth = 4);
+
+    void add(std::uint64_t hash, std::uint64_t count = 1);
+    std::uint64_t estimate(std::uint64_t hash) const;
+    // the other sketch has the same width and depth
+    void merge(const Count_min &other);
+
+    std::size_t get_width() const;
+    std::size_t get_depth() const;
+
+    void serialize(std::string &out) const;
+    // reads from the front of in, in is what is after it
+    static Count_min deserialize(std::string_view &in);
+};
+
+struct Word_estimate
+{
+    std::string_view word;
+    std::uint64_t count;
+    std::uint64_t error;  // count - error is at most the true count
+};
+
+class Space_saving
+{
+private:
+    struct Entry
+    {
+        std::string word;
+        std::uint64_t hash;
+        std::uint64_t count;
+        std::uint64_t error;
+    };
+
+    std::size_t capacity;
+    std::vector<Entry> entries;
+    std::vector<std::uint32_t> heap;     // the entries, the smallest count first
+    std::vector<std::uint32_t> heap_at;  // where every entry is in heap
+    std::vector<std::uint32_t> slots;    // the entry + 1 of every word by hash, 0 is empty
+
+    std::size_t find_slot(std::string_view word, std::uint64_t hash) const;
+    void erase_slot(std::size_t i);
+    void swap_heap(std::size_t i, std::size_t j);
+    void sift_up(std::size_t i);
+    void sift_down(std::size_t i);
+    bool rebuild(std::vector<Entry> entries);
+
+public:
+    explicit Space_saving(std::size_t capacity = 1000);
+
+    // bound is what the count is known to be at most, e.g. the estimate of a Count_min
+    void add(std::string_view word, std::uint64_t hash, std::uint64_t count = 1, std::uint64_t bound = UINT64_MAX);
+    void merge(const Space_saving &other);
+
+    std::size_t size() const;
+    std::size_t get_capacity() const;
+    // the smallest count when it is full, what a word that is not there can have at most
+    std::uint64_t get_min() const;
+    // the k largest counts, the largest first, the views live until the next add or merge
+    std::vector<Word_estimate> top(std::size_t k) const;
+
+    void serialize(std::string &out) const;
+    static Space_saving deserialize(std::string_view &in);
+};
+
+class Hyper_log_log
+{
+public:
+    static constexpr unsigned precision = 14;
+    static constexpr unsigned sparse_precision = 25;
+
+private:
+    std::vector<std::uint8_t> registers;  // empty while it is sparse
+    // the 25 bit index << 6 | the rank of the sparse hashes, sorted, and the ones added
+    // since, sorted into it on the next estimate, that is why they are mutable, a const
+    // sketch is not read by two threads at once
+    mutable std::vector<std::uint32_t> sparse;
+    mutable std::vector<std::uint32_t> pending;
+
+    void flush() const;
+    void to_dense();
+
+public:
+    Hyper_log_log();
+
+    void add(std::uint64_t hash);
+    std::uint64_t estimate() const;
+    void merge(const Hyper_log_log &other);
+
+    bool is_sparse() const;
+
+    void serialize(std::string &out) const;
+    static Hyper_log_log deserialize(std::string_view &in);
+};
+
+class Word_sketch
+{
+private:
+    bool fold_case;
+    std::uint64_t total;
+    Count_min counts;
+    Space_saving heavy;
+    Hyper_log_log distinct;
+    std::string folded;
+
+public:
+    explicit Word_sketch(std::size_t capacity = 1000, bool fold_case = false,
+                         std::size_t width = 1 << 14, std::size_t depth = 4);
+
+    // a word as it is, not cleaned
+    void add(std::string_view word, std::uint64_t count = 1);
+    // the words of the text, cleaned
+    void count(std::string_view text);
+    void merge(const Word_sketch &other);
+
+    std::uint64_t get_total() const;
+    // at least the true count
+    std::uint64_t estimate(std::string_view word) const;
+    std::uint64_t get_distinct() const;
+    // the k most frequent words, the count is the smaller of Space_saving and Count_min
+    std::vector<Word_estimate> top(std::size_t k) const;
+
+    std::string serialize() const;
+    static Word_sketch deserialize(std::string_view bytes);
+};
+
+#endif
@@ -1,68 +1,93 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
-#include <set>
-#include <map>
+#include <cstdlib>
+#include <stdexcept>
 #include <string>
 #include <iomanip>
-#include <sstream>
+#include <string_view>
+#include <vector>
+#include "Index_file.h"
+#include "Inverted_index.h"
+#include "Live_index.h"
+#include "Parallel_count.h"
+#include "Positional_index.h"
+#include "Query_server.h"
+#include "Tokenizer.h"
+#include "Word_counter.h"
+#include "Word_sketch.h"
 
-void display_word(const std::map<std::string, int>& words)
+void display_word(const std::vector<Word_count>& words)
 {
     std::cout << std::setw(15) << std::left << "Word"
         << std::setw(7) << std::right << "Count" << std::endl;
     std::cout << "========================================" << std::endl;
-    for (const auto& pair : words)
-        std::cout << std::setw(15) << std::left << pair.first
-            << std::setw(7) << std::right << pair.second << std::endl;
+    for (const auto& word : words)
+        std::cout << std::setw(15) << std::left << word.word
+            << std::setw(7) << std::right << word.count << std::endl;
 }
 
-void display_word(const std::map<std::string, std::set<int>>& words)
+void display_word(const Inverted_index& words)
 {
     std::cout << std::setw(15) << std::left << "Word"
         << std::setw(7) << std::right << "Occurences" << std::endl;
     std::cout << "========================================" << std::endl;
-    for (const auto& pair : words)
+    for (const auto& id : words.sorted())
     {
-        std::cout << std::setw(15) << std::left << pair.first << std::left << "[ ";
-        for (const auto& i : pair.second)
-            std::cout << i << " ";
+        std::cout << std::setw(15) << std::left << words.get_word(id) << std::left << "[ ";
+        for (Posting_cursor cursor = words.cursor(id); !cursor.is_done(); cursor.next())
+            std::cout << cursor.value() << " ";
         std::cout << "]" << std::endl;
     }
 }
 
-std::string clean_string(const std::string& s)
+void partOne()
 {
-    std::string result;
-    for (const char c : s)
+    std::ifstream in_file {"./romeoAndJuliet.txt"};
+
+    if (in_file)
     {
-        if (c == '.' || c == ',' || c == ';' || c == ':' || c == '!' || c == '?')
-            continue;
-        else
-            result += c;
+        // the whole file in blocks, the words are cleaned in the block and counted in a
+        // hash table, see Word_counter.h, they are sorted once for the display
+        Word_counter words;
+        words.count(in_file);
+
+        in_file.close();
+        display_word(words.sorted());
     }
-    return result;
+    else
+        std::cout << "Error opening input file." << std::endl;
 }
 
-void partOne()
+// the line numbers of every word are packed in one buffer, see Inverted_index.h
+void index_lines(std::ifstream& in_file, Inverted_index& words)
 {
-    std::ifstream in_file {"./romeoAndJuliet.txt"};
+    std::string line;
+    std::string_view word;
+    Tokenizer tokenizer {line};
+    int line_number {0};
 
-    if (in_file)
+    while (std::getline(in_file, line))
     {
-        std::map<std::string, int> words;
-        std::string line;
-        std::string word;
+        tokenizer.reset(line);
 
-        while (std::getline(in_file, line))
-        {
-            std::istringstream iss {line};
+        line_number++;
 
-            while (iss >> word)
-            {
-                word = clean_string(word);
-                words[word]++;
-            }
-        }
+        while (tokenizer.next(word))
+            words.add(word, line_number);
+    }
+
+    words.finish();
+}
+
+void partTwo()
+{
+    std::ifstream in_file {"./romeoAndJuliet.txt"};
+    
+    if (in_file)
+    {
+        Inverted_index words;
+        index_lines(in_file, words);
 
         in_file.close();
         display_word(words);
@@ -71,39 +96,182 @@ void partOne()
         std::cout << "Error opening input file." << std::endl;
 }
 
-void partTwo()
+// writes the index of the text to a file, see Index_file.h
+int build(const std::string& path)
 {
     std::ifstream in_file {"./romeoAndJuliet.txt"};
-    
-    if (in_file)
+
+    if (!in_file)
     {
-        std::map<std::string, std::set<int>> words;
-        std::string line;
-        std::string word;
-        int line_number {0};
+        std::cout << "Error opening input file." << std::endl;
+        return 1;
+    }
 
-        while (std::getline(in_file, line))
-        {
-            std::istringstream iss {line};
+    Inverted_index words;
+    index_lines(in_file, words);
+    Index_file::write(words, path);
+    std::cout << words.get_num_words() << " words written to " << path << std::endl;
+    return 0;
+}
+
+// the lines with all the words, from the index file only, the text is not read
+int query(const std::string& path, const std::vector<std::string_view>& query_words)
+{
+    Index_file index {path};
+    std::vector<std::uint32_t> lines {index.query_and(query_words)};
 
-            line_number++;
+    std::cout << lines.size() << " lines: [ ";
+    for (const auto& line : lines)
+        std::cout << line << " ";
+    std::cout << "]" << std::endl;
+    return 0;
+}
 
-            while (iss >> word) 
-            {
-                word = clean_string(word);
-                words[word].insert(line_number);
-            }
-        }
+// the positions of the words in every line, and the lines of the matches printed, see Positional_index.h
+int search(const std::vector<std::string_view>& phrase, std::uint32_t distance)
+{
+    std::ifstream in_file {"./romeoAndJuliet.txt"};
 
-        in_file.close();
-        display_word(words);
+    if (!in_file)
+    {
+        std::cout << "Error opening input file." << std::endl;
+        return 1;
     }
-    else
+
+    Positional_index index;
+    std::vector<std::string> lines {""};
+    std::string line;
+    while (std::getline(in_file, line))
+    {
+        index.add_line(line, static_cast<std::uint32_t>(lines.size()));
+        lines.push_back(line);
+    }
+    index.finish();
+
+    const std::vector<Word_position> matches = distance == 0 ? index.query_phrase(phrase)
+        : index.query_near(phrase[0], phrase[1], distance);
+    for (const Word_position& match : matches)
+        std::cout << std::setw(6) << std::right << match.line << ":" << std::setw(3) << match.offset << "  "
+            << lines[match.line] << std::endl;
+    std::cout << matches.size() << " matches, " << index.get_num_positions() << " positions in "
+        << index.get_memory() << " bytes" << std::endl;
+    return 0;
+}
+
+// the index file answers the requests of Query_wire.h on a TCP port, until a line is read
+int serve(const std::string& path, std::uint16_t port)
+{
+    Index_file index {path};
+    Query_server server {index};
+    std::cout << index.get_num_words() << " words of " << path << " served on port " << server.listen(port)
+        << ", enter to stop" << std::endl;
+    std::string line;
+    std::getline(std::cin, line);
+    std::cout << server.get_num_requests() << " requests answered" << std::endl;
+    return 0;
+}
+
+// partOne and partTwo with a chunk of the file per thread, see Parallel_count.h
+int parallel(std::size_t threads)
+{
+    Chunked_file file {"./romeoAndJuliet.txt", threads};
+
+    display_word(count_words(file)->sorted());
+    display_word(*index_lines(file));
+    return 0;
+}
+
+// the 100 most frequent words and the number of different words, from sketches of the
+// chunks merged into one, the memory does not grow with the text, see Word_sketch.h
+int sketch(std::size_t threads)
+{
+    Chunked_file file {"./romeoAndJuliet.txt", threads};
+    std::unique_ptr<Word_sketch> words {sketch_words(file)};
+
+    std::cout << words->get_total() << " words, about " << words->get_distinct() << " different" << std::endl;
+    std::cout << std::setw(15) << std::left << "Word"
+        << std::setw(7) << std::right << "Count" << std::setw(7) << "Error" << std::endl;
+    std::cout << "========================================" << std::endl;
+    for (const Word_estimate& word : words->top(100))
+        std::cout << std::setw(15) << std::left << word.word
+            << std::setw(7) << std::right << word.count << std::setw(7) << word.error << std::endl;
+    return 0;
+}
+
+// the text appended 1000 lines at a time, every append is queried at once, the segments
+// are merged in the background, see Live_index.h
+int live(const std::vector<std::string_view>& query_words)
+{
+    std::ifstream in_file {"./romeoAndJuliet.txt"};
+
+    if (!in_file)
+    {
         std::cout << "Error opening input file." << std::endl;
+        return 1;
+    }
+
+    Live_index index {1000};
+    std::string line;
+    while (std::getline(in_file, line))
+    {
+        if (index.add_line(line) % 1000 == 0)
+            std::cout << index.get_num_lines() << " lines in " << index.get_num_segments() << " segments, "
+                << index.query_and(query_words).size() << " lines with all the words" << std::endl;
+    }
+
+    index.flush();
+    std::cout << index.get_num_lines() << " lines in " << index.get_num_segments() << " segments, "
+        << index.query_and(query_words).size() << " lines with all the words" << std::endl;
+    return 0;
 }
 
-int main()
+/*
+
+    ./a.out                        counts the words and prints the lines of every word
+    ./a.out --threads 4            the same, the file split in 4 chunks counted in parallel
+    ./a.out --build index.idx      writes the index of the lines to index.idx
+    ./a.out --query index.idx w... prints the lines that have all the words w..., from index.idx
+    ./a.out --serve index.idx 7070 answers the queries of other programs on port 7070, from index.idx
+    ./a.out --live w...            appends the lines of the text to an index and queries it as it grows
+    ./a.out --phrase w...          prints the lines that have the words w... one after the other
+    ./a.out --near 5 w1 w2         prints the lines that have w2 at most 5 words before or after w1
+    ./a.out --sketch 4             the 100 most frequent words and the number of different words,
+                                   approximate, from sketches of 4 chunks instead of the exact counts
+
+    the chunks are the ones of ioAndStream/challenge3, build it with the sources of the
+    directory and:
+        g++ -std=c++17 -O2 -pthread *.cpp ../../ioAndStream/challenge3/Chunked_file.cpp \
+            ../../ioAndStream/compressedStream/Compressed_stream.cpp ../../ioAndStream/compressedStream/Lz4.cpp
+
+*/
+int main(int argc, char* argv[])
 {
+    try
+    {
+        if (argc == 3 && std::string {argv[1]} == "--build")
+            return build(argv[2]);
+        if (argc == 3 && std::string {argv[1]} == "--threads")
+            return parallel(std::strtoul(argv[2], nullptr, 10));
+        if (argc == 3 && std::string {argv[1]} == "--sketch")
+            return sketch(std::strtoul(argv[2], nullptr, 10));
+        if (argc == 4 && std::string {argv[1]} == "--serve")
+            return serve(argv[2], static_cast<std::uint16_t>(std::strtoul(argv[3], nullptr, 10)));
+        if (argc >= 3 && std::string {argv[1]} == "--live")
+            return live(std::vector<std::string_view>(argv + 2, argv + argc));
+        if (argc >= 3 && std::string {argv[1]} == "--phrase")
+            return search(std::vector<std::string_view>(argv + 2, argv + argc), 0);
+        if (argc == 5 && std::string {argv[1]} == "--near")
+            return search(std::vector<std::string_view>(argv + 3, argv + argc),
+                static_cast<std::uint32_t>(std::max(1ul, std::strtoul(argv[2], nullptr, 10))));
+        if (argc >= 4 && std::string {argv[1]} == "--query")
+            return query(argv[2], std::vector<std::string_view>(argv + 3, argv + argc));
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::cout << error.what() << std::endl;
+        return 1;
+    }
+
     partOne();
     partTwo();
     
@@ -0,0 +1,455 @@
+/*
+
+    - compares splitting the lines of ../challengeThree/romeoAndJuliet.txt into cleaned words
+      with a std::istringstream per line and clean_string per word, the first version of
+      ../challengeThree, against Tokenizer (../challengeThree/Tokenizer.h), and checks that
+      both give the same words.
+
+    - then compares counting the words in a std::map<std::string, int>, as partOne did,
+      against Word_counter (../challengeThree/Word_counter.h), and checks the counts.
+
+    - then compares the lines of every word in a std::map<std::string, std::set<int>>, as
+      partTwo did, against Inverted_index (../challengeThree/Inverted_index.h): the bytes
+      allocated for each, counted by operator new, and the time of queries for the lines
+      with two words, std::set_intersection against query_and.
+
+    - then counts and indexes the text written to a file with 1, 2, 4, 8, 16 and 32 threads,
+      see ../challengeThree/Parallel_count.h, and checks the results against one thread.
+
+    - then counts the words with a Word_sketch (../challengeThree/Word_sketch.h), and with
+      4 of them on 4 chunks merged, against the exact counts: the words of the top 100
+      that are in the top 100 of the sketch, the worst count of them over the true one, the
+      number of different words and the bytes, and the same for a stream of 4M words of
+      zipf like counts, 1.4M different, the sketch stays at 600 KiB:
+        Word_counter     104 MB/s, 4331 different, 3.8 M words/s and 171 MiB on the stream
+        Word_sketch       42 MB/s, 100 of the top 100, 0 % worse, 4313 different,
+                          10.7 M words/s on the stream, 100 of the top 100, 1.5 % off the
+                          number of different words
+      a sketch that is deserialized from its bytes has to give the same bytes again.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp ../challengeThree/Word_counter.cpp ../challengeThree/Inverted_index.cpp \
+            ../challengeThree/Parallel_count.cpp ../challengeThree/Word_sketch.cpp ../../ioAndStream/challenge3/Chunked_file.cpp \
+            ../../ioAndStream/compressedStream/Compressed_stream.cpp ../../ioAndStream/compressedStream/Lz4.cpp
+
+    - the text is repeated to have more lines, the number of copies can be given on the
+      command line, e.g. ./a.out 100
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <new>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../algorithms/byteSet/Byte_set.h"
+#include "../challengeThree/Inverted_index.h"
+#include "../challengeThree/Parallel_count.h"
+#include "../challengeThree/Tokenizer.h"
+#include "../challengeThree/Word_counter.h"
+#include "../challengeThree/Word_sketch.h"
+
+// every allocation keeps its size in front of it, so the bytes in use can be counted
+std::size_t allocated {0};
+
+void *operator new(std::size_t size)
+{
+    void *block = std::malloc(size + 16);
+    if (block == nullptr)
+        throw std::bad_alloc {};
+    *static_cast<std::size_t *>(block) = size;
+    allocated += size;
+    return static_cast<char *>(block) + 16;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (ptr == nullptr)
+        return;
+    void *block = static_cast<char *>(ptr) - 16;
+    allocated -= *static_cast<std::size_t *>(block);
+    std::free(block);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+// the bytes between the punctuation are appended, found 16 or 32 at a time by the byte set
+std::string clean_string(const std::string& s)
+{
+    static const byte_set::Set punctuation {".,;:!?"};
+    std::string result;
+    auto begin = s.begin();
+    for (auto it = byte_set::find_first_of(begin, s.end(), punctuation); it != s.end();
+         it = byte_set::find_first_of(begin, s.end(), punctuation))
+    {
+        result.append(begin, it);
+        begin = it + 1;
+    }
+    result.append(begin, s.end());
+    return result;
+}
+
+// the words are summed into a hash of their bytes, so both ways have to give the same words in the same order
+std::uint64_t add_word(std::uint64_t hash, std::string_view word)
+{
+    for (char c : word)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211u;
+    return (hash ^ 0xff) * 1099511628211u;
+}
+
+std::uint64_t with_streams(const std::vector<std::string>& lines)
+{
+    std::uint64_t hash {14695981039346656037u};
+    std::string word;
+    for (const std::string& line : lines)
+    {
+        std::istringstream iss {line};
+        while (iss >> word)
+            hash = add_word(hash, clean_string(word));
+    }
+    return hash;
+}
+
+std::uint64_t with_tokenizer(const std::vector<std::string>& lines)
+{
+    std::uint64_t hash {14695981039346656037u};
+    std::string_view word;
+    Tokenizer tokenizer {""};
+    for (const std::string& line : lines)
+    {
+        tokenizer.reset(line);
+        while (tokenizer.next(word))
+            hash = add_word(hash, word);
+    }
+    return hash;
+}
+
+std::map<std::string, int> count_with_map(const std::string& text)
+{
+    std::map<std::string, int> words;
+    std::istringstream in {text};
+    std::string line;
+    std::string word;
+    while (std::getline(in, line))
+    {
+        std::istringstream iss {line};
+        while (iss >> word)
+            words[clean_string(word)]++;
+    }
+    return words;
+}
+
+bool same_counts(const std::map<std::string, int>& words, const Word_counter& counter)
+{
+    std::vector<Word_count> sorted = counter.sorted();
+    if (sorted.size() != words.size())
+        return false;
+
+    std::size_t i {0};
+    for (const auto& pair : words)
+    {
+        if (sorted[i].word != pair.first || sorted[i].count != static_cast<std::uint64_t>(pair.second))
+            return false;
+        i++;
+    }
+    return true;
+}
+
+template<typename Fn>
+double measure_ms(Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t copies {argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50};
+
+    std::ifstream in_file {"../challengeThree/romeoAndJuliet.txt"};
+    if (!in_file)
+    {
+        std::cout << "Error opening input file." << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> text;
+    std::string line;
+    while (std::getline(in_file, line))
+        text.push_back(line);
+
+    std::vector<std::string> lines;
+    lines.reserve(text.size() * copies);
+    for (std::size_t i {0}; i < copies; i++)
+        lines.insert(lines.end(), text.begin(), text.end());
+
+    std::uint64_t streams;
+    std::uint64_t tokenizer;
+    double streams_ms = measure_ms([&] { streams = with_streams(lines); });
+    double tokenizer_ms = measure_ms([&] { tokenizer = with_tokenizer(lines); });
+
+    if (streams != tokenizer)
+    {
+        std::cout << "The words are different." << std::endl;
+        return 1;
+    }
+
+    std::cout << lines.size() << " lines, the same words with both" << std::endl;
+    std::cout << std::setw(15) << std::left << "istringstream" << std::setw(12) << std::right << std::fixed << std::setprecision(0)
+        << lines.size() / streams_ms * 1000 << " lines/s" << std::endl;
+    std::cout << std::setw(15) << std::left << "Tokenizer" << std::setw(12) << std::right
+        << lines.size() / tokenizer_ms * 1000 << " lines/s" << std::endl;
+
+    std::string all;
+    for (const std::string& line : lines)
+        all.append(line).push_back('\n');
+
+    std::map<std::string, int> words;
+    Word_counter counter;
+    double map_ms = measure_ms([&] { words = count_with_map(all); });
+    double counter_ms = measure_ms([&] {
+        std::istringstream in {all};
+        counter.count(in);
+    });
+
+    if (!same_counts(words, counter))
+    {
+        std::cout << "The counts are different." << std::endl;
+        return 1;
+    }
+
+    std::cout << counter.get_total() << " words, " << counter.size() << " different, the same counts with both" << std::endl;
+    std::cout << std::setw(15) << std::left << "std::map" << std::setw(12) << std::right
+        << all.size() / map_ms / 1000 << " MB/s" << std::endl;
+    std::cout << std::setw(15) << std::left << "Word_counter" << std::setw(12) << std::right
+        << all.size() / counter_ms / 1000 << " MB/s" << std::endl;
+
+    std::size_t before {allocated};
+    std::map<std::string, std::set<int>> line_sets;
+    int line_number {0};
+    for (const std::string& line : lines)
+    {
+        std::istringstream iss {line};
+        std::string word;
+        line_number++;
+        while (iss >> word)
+            line_sets[clean_string(word)].insert(line_number);
+    }
+    std::size_t sets_bytes {allocated - before};
+
+    before = allocated;
+    Inverted_index index;
+    std::string_view word;
+    Tokenizer line_words {""};
+    line_number = 0;
+    for (const std::string& line : lines)
+    {
+        line_words.reset(line);
+        line_number++;
+        while (line_words.next(word))
+            index.add(word, line_number);
+    }
+    index.finish();
+    std::size_t index_bytes {allocated - before};
+
+    std::size_t occurrences {0};
+    std::vector<const std::string*> common;
+    for (const auto& pair : line_sets)
+    {
+        occurrences += pair.second.size();
+        if (pair.second.size() >= lines.size() / 1000)
+            common.push_back(&pair.first);
+    }
+
+    std::mt19937 gen {7};
+    std::vector<std::pair<const std::string*, const std::string*>> queries;
+    for (int i {0}; i < 1000; i++)
+        queries.push_back({common[gen() % common.size()], common[gen() % common.size()]});
+
+    std::size_t sets_found {0};
+    std::size_t index_found {0};
+    double sets_ms = measure_ms([&] {
+        for (const auto& query : queries)
+        {
+            const std::set<int>& a = line_sets[*query.first];
+            const std::set<int>& b = line_sets[*query.second];
+            std::vector<int> both;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(both));
+            sets_found += both.size();
+        }
+    });
+    double index_ms = measure_ms([&] {
+        for (const auto& query : queries)
+            index_found += index.query_and({*query.first, *query.second}).size();
+    });
+
+    if (sets_found != index_found)
+    {
+        std::cout << "The queries are different." << std::endl;
+        return 1;
+    }
+
+    std::cout << occurrences << " lines of words, " << queries.size() << " queries, " << index_found << " lines found with both" << std::endl;
+    std::cout << std::setw(15) << std::left << "std::set" << std::setw(12) << std::right << std::setprecision(1)
+        << static_cast<double>(sets_bytes) / occurrences << " bytes each" << std::setw(12) << sets_ms << " ms" << std::endl;
+    std::cout << std::setw(15) << std::left << "Inverted_index" << std::setw(12) << std::right
+        << static_cast<double>(index_bytes) / occurrences << " bytes each" << std::setw(12) << index_ms << " ms" << std::endl;
+
+    const std::filesystem::path path {std::filesystem::temp_directory_path() / "challengeThreeBenchmark.txt"};
+    {
+        std::ofstream out_file {path, std::ios::binary};
+        out_file.write(all.data(), static_cast<std::streamsize>(all.size()));
+    }
+
+    std::cout << std::setw(15) << std::left << "threads" << std::setw(12) << std::right << "count ms"
+        << std::setw(12) << "index ms" << std::endl;
+
+    std::vector<Word_count> expected {counter.sorted()};
+    for (std::size_t threads : {1, 2, 4, 8, 16, 32})
+    {
+        Chunked_file file {path.string(), threads};
+        std::unique_ptr<Word_counter> counted;
+        std::unique_ptr<Inverted_index> indexed;
+        double count_ms = measure_ms([&] { counted = count_words(file); });
+        double indexed_ms = measure_ms([&] { indexed = index_lines(file); });
+
+        std::vector<Word_count> words_counted {counted->sorted()};
+        bool same {words_counted.size() == expected.size() && indexed->get_num_words() == index.get_num_words()};
+        for (std::size_t i {0}; same && i < expected.size(); i++)
+            same = words_counted[i].word == expected[i].word && words_counted[i].count == expected[i].count;
+        for (std::size_t i {0}; same && i < common.size(); i++)
+            same = indexed->lines_of(*common[i]) == index.lines_of(*common[i]);
+
+        if (!same)
+        {
+            std::cout << "The results with " << threads << " threads are different." << std::endl;
+            std::filesystem::remove(path);
+            return 1;
+        }
+
+        std::cout << std::setw(15) << std::left << threads << std::setw(12) << std::right
+            << count_ms << std::setw(12) << indexed_ms << std::endl;
+    }
+
+    // the sketches against the exact counts, the text and then a stream of a million
+    // different words, see ../challengeThree/Word_sketch.h
+    std::vector<Word_count> by_count {expected};
+    std::sort(by_count.begin(), by_count.end(), [](const Word_count& a, const Word_count& b) { return a.count > b.count; });
+
+    before = allocated;
+    std::unique_ptr<Word_sketch> sketch;
+    double sketch_ms = measure_ms([&] {
+        sketch = std::make_unique<Word_sketch>();
+        sketch->count(all);
+    });
+    std::size_t sketch_bytes {allocated - before};
+
+    std::unique_ptr<Word_sketch> merged;
+    double merged_ms;
+    {
+        Chunked_file file {path.string(), 4};
+        merged_ms = measure_ms([&] { merged = sketch_words(file); });
+    }
+    std::filesystem::remove(path);
+
+    std::string bytes {merged->serialize()};
+    bool same_bytes {Word_sketch::deserialize(bytes).serialize() == bytes};
+
+    // the words of the top 100 of the counts found in the top 100 of a sketch
+    auto top_found = [&by_count](const Word_sketch& words)
+    {
+        std::set<std::string_view> top;
+        for (std::size_t i {0}; i < 100 && i < by_count.size(); i++)
+            top.insert(by_count[i].word);
+        std::size_t found {0};
+        for (const Word_estimate& word : words.top(100))
+            found += top.count(word.word);
+        return found;
+    };
+    // the largest difference of a count of the top 100 of the sketch, over the true count
+    auto worst_error = [&counter](const Word_sketch& words)
+    {
+        double worst {0};
+        for (const Word_estimate& word : words.top(100))
+            worst = std::max(worst, static_cast<double>(word.count) / counter.get_count(word.word) - 1);
+        return worst;
+    };
+
+    std::cout << std::setw(15) << std::left << "sketch" << std::setw(12) << std::right << "MB/s"
+        << std::setw(12) << "top 100" << std::setw(12) << "worst %" << std::setw(12) << "distinct" << std::setw(12) << "KiB" << std::endl;
+    std::cout << std::setw(15) << std::left << "Word_counter" << std::setw(12) << std::right << all.size() / counter_ms / 1000
+        << std::setw(12) << 100 << std::setw(12) << 0.0 << std::setw(12) << counter.size() << std::setw(12) << "-" << std::endl;
+    std::cout << std::setw(15) << std::left << "Word_sketch" << std::setw(12) << std::right << all.size() / sketch_ms / 1000
+        << std::setw(12) << top_found(*sketch) << std::setw(12) << 100 * worst_error(*sketch) << std::setw(12) << sketch->get_distinct()
+        << std::setw(12) << sketch_bytes / 1024.0 << std::endl;
+    std::cout << std::setw(15) << std::left << "4 chunks" << std::setw(12) << std::right << all.size() / merged_ms / 1000
+        << std::setw(12) << top_found(*merged) << std::setw(12) << 100 * worst_error(*merged) << std::setw(12) << merged->get_distinct()
+        << std::setw(12) << bytes.size() / 1024.0 << std::endl;
+
+    // a stream of "w<number>" of zipf like counts, the number i about 1 / i of the times,
+    // more than a million different ones
+    std::vector<std::string> stream;
+    std::mt19937_64 numbers {11};
+    std::uniform_real_distribution<double> uniform {0, 1};
+    for (int i {0}; i < 4000000; i++)
+        stream.push_back("w" + std::to_string(static_cast<std::uint64_t>(std::exp(uniform(numbers) * std::log(1e8)))));
+
+    before = allocated;
+    std::unique_ptr<Word_counter> stream_counter;
+    double stream_counter_ms = measure_ms([&] {
+        stream_counter = std::make_unique<Word_counter>();
+        for (const std::string& word : stream)
+            stream_counter->add(word);
+    });
+    std::size_t stream_counter_bytes {allocated - before};
+    before = allocated;
+    std::unique_ptr<Word_sketch> stream_sketch;
+    double stream_sketch_ms = measure_ms([&] {
+        stream_sketch = std::make_unique<Word_sketch>();
+        for (const std::string& word : stream)
+            stream_sketch->add(word);
+    });
+    std::size_t stream_sketch_bytes {allocated - before};
+
+    std::vector<Word_count> stream_by_count {stream_counter->sorted()};
+    std::sort(stream_by_count.begin(), stream_by_count.end(), [](const Word_count& a, const Word_count& b) { return a.count > b.count; });
+    std::set<std::string_view> stream_top;
+    for (std::size_t i {0}; i < 100; i++)
+        stream_top.insert(stream_by_count[i].word);
+    std::size_t stream_found {0};
+    for (const Word_estimate& word : stream_sketch->top(100))
+        stream_found += stream_top.count(word.word);
+    double distinct_error {100.0 * std::abs(static_cast<double>(stream_sketch->get_distinct()) - stream_counter->size()) / stream_counter->size()};
+
+    std::cout << stream.size() << " words of a stream, " << stream_counter->size() << " different, about "
+        << stream_sketch->get_distinct() << " (" << distinct_error << " %) from the sketch" << std::endl;
+    std::cout << std::setw(15) << std::left << "Word_counter" << std::setw(12) << std::right << stream.size() / stream_counter_ms / 1000
+        << " M words/s" << std::setw(12) << stream_counter_bytes / 1024.0 << " KiB" << std::endl;
+    std::cout << std::setw(15) << std::left << "Word_sketch" << std::setw(12) << std::right << stream.size() / stream_sketch_ms / 1000
+        << " M words/s" << std::setw(12) << stream_sketch_bytes / 1024.0 << " KiB, " << stream_found << " of the top 100" << std::endl;
+
+    if (top_found(*sketch) < 100 || top_found(*merged) < 100 || !same_bytes || stream_found < 95 || distinct_error > 3)
+    {
+        std::cout << "The sketches are off." << std::endl;
+        return 1;
+    }
+    return 0;
+}
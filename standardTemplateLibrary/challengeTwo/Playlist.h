@@ -0,0 +1,200 @@
+#ifndef _PLAYLIST_H_
+#define _PLAYLIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Song.h"
+#include "Symbol.h"
+
+/*
+
+    - a Playlist keeps every song once, in a vector, the id of a song is its place in it and
+      never changes, a name is found by a hash of its Symbol to the id.
+
+    - the play order is a vector of ids with a gap in it, a gap buffer, the songs before the
+      gap and the ones after it are the order. an insert moves the gap to the cursor and
+      writes into it, so inserts at or near the cursor cost O(1) amortized, appends go after
+      the last id and cost O(1) amortized too.
+
+    - the cursor is a position in the play order, not an iterator, next and previous wrap
+      around and cost O(1) wherever the gap is.
+
+    - a song can be in the order more than once, adding a name that is already there gives
+      its id back and keeps the song as it was.
+
+    - the ids of the songs of every rating are kept in a map of the rating, a posting list
+      each, a song keeps its rating, so add is the only update. with_rating(low, high) is
+      the songs rated low to high, the lowest first, in the order they were added, in the
+      time of the songs it gives and a lookup of low, not a scan of all the songs.
+
+*/
+class Playlist
+{
+public:
+    using Id = std::uint32_t;
+    static constexpr Id no_song = ~Id {0};
+
+private:
+    std::vector<Song> songs;
+    std::unordered_map<Symbol, Id> ids;
+    std::map<int, std::vector<Id>> ratings;
+    std::vector<Id> order;
+    std::size_t gap_begin;
+    std::size_t gap_end;
+    std::size_t cursor;
+
+    std::size_t at(std::size_t position) const
+    {
+        return position < this->gap_begin ? position : position + (this->gap_end - this->gap_begin);
+    }
+
+    void move_gap(std::size_t position)
+    {
+        if (position < this->gap_begin)
+        {
+            const std::size_t n = this->gap_begin - position;
+            std::copy_backward(this->order.begin() + position, this->order.begin() + this->gap_begin,
+                this->order.begin() + this->gap_end);
+            this->gap_begin -= n;
+            this->gap_end -= n;
+        }
+        else
+        {
+            const std::size_t n = position - this->gap_begin;
+            std::copy(this->order.begin() + this->gap_end, this->order.begin() + this->gap_end + n,
+                this->order.begin() + this->gap_begin);
+            this->gap_begin += n;
+            this->gap_end += n;
+        }
+    }
+
+    // doubles the buffer, the ids after the gap go to its end
+    void grow()
+    {
+        const std::size_t after = this->order.size() - this->gap_end;
+        std::vector<Id> grown(std::max<std::size_t>(16, this->order.size() * 2));
+        std::copy(this->order.begin(), this->order.begin() + this->gap_begin, grown.begin());
+        std::copy(this->order.begin() + this->gap_end, this->order.end(), grown.end() - after);
+        this->gap_end = grown.size() - after;
+        this->order.swap(grown);
+    }
+
+public:
+    Playlist()
+        : gap_begin{0}, gap_end{0}, cursor{0} {}
+
+    // the id of the song, a song of the same name keeps its artist and rating
+    Id add(std::string_view name, std::string_view artist, int rating)
+    {
+        const Symbol symbol = Symbol_table::global().intern(name);
+        auto it = this->ids.find(symbol);
+        if (it != this->ids.end())
+            return it->second;
+
+        const Id id = static_cast<Id>(this->songs.size());
+        this->songs.emplace_back(name, artist, rating);
+        this->ids.emplace(symbol, id);
+        this->ratings[rating].push_back(id);
+        return id;
+    }
+
+    // no_song when there is no song of that name
+    Id find(std::string_view name) const
+    {
+        const Symbol symbol = Symbol_table::global().find(name);
+        if (!symbol)
+            return no_song;
+        auto it = this->ids.find(symbol);
+        return it == this->ids.end() ? no_song : it->second;
+    }
+
+    const Song& get(Id id) const { return this->songs[id]; }
+
+    // the ids of the songs rated low to high, both included
+    std::vector<Id> with_rating(int low, int high) const
+    {
+        std::vector<Id> ids;
+        for (auto it = this->ratings.lower_bound(low); it != this->ratings.end() && it->first <= high; ++it)
+            ids.insert(ids.end(), it->second.begin(), it->second.end());
+        return ids;
+    }
+
+    std::size_t count_rating(int low, int high) const
+    {
+        std::size_t count = 0;
+        for (auto it = this->ratings.lower_bound(low); it != this->ratings.end() && it->first <= high; ++it)
+            count += it->second.size();
+        return count;
+    }
+    std::size_t get_num_songs() const { return this->songs.size(); }
+
+    // the length of the play order
+    std::size_t size() const { return this->order.size() - (this->gap_end - this->gap_begin); }
+    bool is_empty() const { return this->size() == 0; }
+
+    // after the last song, the ids after the gap are the end of the order wherever the gap is
+    void append(Id id)
+    {
+        this->order.push_back(id);
+    }
+
+    // before the current song, the cursor is on the new one
+    void insert(Id id)
+    {
+        this->move_gap(this->cursor);
+        if (this->gap_begin == this->gap_end)
+            this->grow();
+        this->order[this->gap_begin++] = id;
+    }
+
+    std::size_t get_position() const { return this->cursor; }
+
+    // the cursor on a position of the play order, position < size()
+    void seek(std::size_t position) { this->cursor = position; }
+
+    // the song at a position of the play order, position < size()
+    Id get_at(std::size_t position) const { return this->order[this->at(position)]; }
+
+    // no_song when the order is empty
+    Id current() const
+    {
+        return this->is_empty() ? no_song : this->order[this->at(this->cursor)];
+    }
+
+    Id first()
+    {
+        this->cursor = 0;
+        return this->current();
+    }
+
+    Id next()
+    {
+        if (!this->is_empty())
+            this->cursor = this->cursor + 1 == this->size() ? 0 : this->cursor + 1;
+        return this->current();
+    }
+
+    Id previous()
+    {
+        if (!this->is_empty())
+            this->cursor = this->cursor == 0 ? this->size() - 1 : this->cursor - 1;
+        return this->current();
+    }
+
+    // f(song) for every song of the play order
+    template<typename F>
+    void for_each(F f) const
+    {
+        for (std::size_t i = 0; i < this->gap_begin; ++i)
+            f(this->songs[this->order[i]]);
+        for (std::size_t i = this->gap_end; i < this->order.size(); ++i)
+            f(this->songs[this->order[i]]);
+    }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef _SONG_H_
+#define _SONG_H_
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "Symbol.h"
+#include "../../tooling/compiledFormat/Compiled_format.h"
+
+class Song
+{
+    friend std::ostream& operator<<(std::ostream& os, const Song& s);
+
+private:
+    // interned, comparing two songs by name is a pointer compare
+    Symbol name;
+    Symbol artist;
+    int rating;
+
+public:
+    Song() = default;
+    Song(std::string_view name, std::string_view artist, int rating)
+        : name(Symbol_table::global().intern(name)), 
+        artist(Symbol_table::global().intern(artist)), 
+        rating(rating) {}
+
+    const std::string& get_name() const { return this->name.str(); }
+    Symbol get_name_symbol() const { return this->name; }
+    const std::string& get_artist() const { return this->artist.str(); }
+    int get_rating() const { return this->rating; }
+
+    bool operator<(const Song& rhs) const { return this->name < rhs.name; }
+    bool operator==(const Song& rhs) const { return this->name == rhs.name; }
+};
+
+// the columns of the playlist, one write of a line parsed at compile time
+inline std::ostream& operator<<(std::ostream& os, const Song& s)
+{
+    compiled_format::print(os, COMPILED_FORMAT("{:<25}{:<30}{:<5}\n"), s.name.str(), s.artist.str(), s.rating);
+    return os;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _SONG_RECORDS_H_
+#define _SONG_RECORDS_H_
+
+#include <cstddef>
+#include <string>
+#include "Playlist.h"
+#include "../../tooling/mappedCatalog/Mapped_catalog.h"
+#include "../../tooling/recordParser/Record_parser.h"
+
+/*
+
+    - load_songs adds the songs of a name,artist,rating file to the playlist and appends
+      them to the play order, in the order of the file. a name that is already there is
+      appended again, with the artist and the rating it has, like Playlist::add.
+
+    - the first record is a header when its rating is not a number, it is skipped, a rating
+      that is not a number after it throws std::runtime_error.
+
+    - a catalog file, see tooling/mappedCatalog/Mapped_catalog.h, has the songs without the
+      parsing, write_song_catalog writes the songs of the play order, each once, load_songs
+      of a catalog appends its songs in the order of its records.
+
+*/
+
+// the number of records appended, records is unescaped in place
+inline std::size_t load_songs(Playlist &playlist, std::string &records)
+{
+    record_parser::Parser parser {records};
+    record_parser::Record record;
+    std::size_t appended = 0;
+    int rating;
+
+    if (parser.next(record) && record.get(2, rating))
+    {
+        playlist.append(playlist.add(record[0], record[1], rating));
+        ++appended;
+    }
+    for (; parser.next(record); ++appended)
+        playlist.append(playlist.add(record[0], record.get<std::string_view>(1), record.get<int>(2)));
+    return appended;
+}
+
+inline std::size_t load_songs(Playlist &playlist, const mapped_catalog::Catalog &catalog)
+{
+    for (std::size_t i = 0; i < catalog.size(); ++i)
+        playlist.append(playlist.add(catalog.get_name(i), catalog.get_text(i), static_cast<int>(catalog.get_number(i))));
+    return catalog.size();
+}
+
+inline void write_song_catalog(const std::string &path, const Playlist &playlist)
+{
+    mapped_catalog::Writer writer;
+    playlist.for_each([&writer] (const Song& song) { writer.add(song.get_name(), song.get_artist(), song.get_rating()); });
+    writer.save(path);
+}
+
+#endif
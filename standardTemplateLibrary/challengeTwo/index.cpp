@@ -1,166 +1,323 @@
 #include <iostream>
-#include <list>
-#include <iomanip>
-#include <algorithm>
 #include <cctype>
-#include <limits>
+#include <cstdint>
+#include <optional>
+#include <random>
 #include <string>
-#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Playlist.h"
+#include "Shuffle_order.h"
+#include "Song_records.h"
+#include "../../tooling/batchInput/Batch_io.h"
+#include "../../tooling/fastConsole/Fast_console.h"
 
-class Song
-{
-    friend std::ostream& operator<<(std::ostream& os, const Song& s);
-
-private:
-    std::string name;
-    std::string artist;
-    int rating;
-
-public:
-    Song() = default;
-    Song(std::string name, std::string artist, int rating)
-        : name(name), artist(artist), rating(rating) {}
+/*
 
-    std::string get_name() const { return this->name; }
-    std::string get_artist() const { return this->artist; }
-    int get_rating() const { return this->rating; }
+    ./a.out                     the menu, one selection at a time
+    ./a.out --batch [commands]  the selections of a file, or of stdin, as one batch, without
+                                the menu and the prompts, the line after an a is the name,
+                                artist and rating of the song, the two numbers after an r
+                                are the lowest and the highest rating, see Batch_io.h
+    ./a.out --songs songs.csv   the playlist of a name,artist,rating file instead of the six
+                                songs, before the other arguments, --batch too
+    ./a.out --songs songs.cat   the same with a catalog file, see Song_records.h
 
-    bool operator<(const Song& rhs) const { return this->name < rhs.name; }
-    bool operator==(const Song& rhs) const { return this->name == rhs.name; }
-};
-
-std::ostream& operator<<(std::ostream& os, const Song& s)
-{
-    os << std::setw(25) << std::left << s.name
-        << std::setw(30) << std::left << s.artist
-        << std::setw(5) << std::left << s.rating
-        << std::endl;
-    return os;
-}
+*/
 
 class Songs
 {
 private:
-    std::list<Song> songs;
-    std::list<Song>::const_iterator current_song_it;
+    Playlist playlist;
+    std::ostream &os;
+    // the order of the shuffle play and the place in it, the position of the cursor is the one at it
+    Shuffle_order shuffle;
+    std::uint64_t shuffle_index {0};
+    bool is_shuffled {false};
+
+    void seek_shuffled(std::uint64_t index)
+    {
+        this->shuffle_index = index;
+        this->playlist.seek(this->shuffle.at(index));
+    }
 
 public:
-    Songs()
-        : songs({
-            {"God's Plan", "Drake", 5},
-            {"Never Be The Same", "Camila Cabello", 5},
-            {"Pray For Me", "The Weekend and K. Lamar", 4},
-            {"The Middle", "Zedd, maren Morris & Grey", 5},
-            {"Wait", "Maroone 5", 4},
-            {"Whatever It Takes", "Imagine Dragons", 3}}),
-        current_song_it(songs.begin()) {}
+    struct Default_song
+    {
+        std::string_view name;
+        std::string_view artist;
+        int rating;
+    };
+
+    // in the read only data of the program, added as they are, nothing to parse at the start
+    static constexpr Default_song default_songs[] {
+        {"God's Plan", "Drake", 5},
+        {"Never Be The Same", "Camila Cabello", 5},
+        {"Pray For Me", "The Weekend and K. Lamar", 4},
+        {"The Middle", "Zedd, maren Morris & Grey", 5},
+        {"Wait", "Maroone 5", 4},
+        {"Whatever It Takes", "Imagine Dragons", 3}};
+
+    // the songs of a name,artist,rating file, see Song_records.h, the six songs without one
+    explicit Songs(std::ostream &os = std::cout, std::optional<std::string> records = std::nullopt) : os(os)
+    {
+        if (!records)
+            for (const Default_song &song : default_songs)
+                this->playlist.append(this->playlist.add(song.name, song.artist, song.rating));
+        else
+            load_songs(this->playlist, *records);
+    }
 
-    bool is_currnet_song_it_exist(const std::list<Song>::const_iterator& it) const
+    // the songs of a catalog file after the ones of the records
+    void load(const mapped_catalog::Catalog &catalog)
     {
-        return it != this->songs.cend();
+        load_songs(this->playlist, catalog);
     }
 
-    void display_song(const Song& song) const
+    void display_song(Playlist::Id id) const
     {
-        std::cout << song;
+        if (id == Playlist::no_song)
+            this->os << "Not found the song" << '\n';
+        else
+            this->os << this->playlist.get(id);
     }
 
     void play_first_song()
     {
-        this->current_song_it = songs.cbegin();
-        this->display_song(*this->current_song_it);
+        if (this->is_shuffled && !this->playlist.is_empty())
+        {
+            this->seek_shuffled(0);
+            this->display_song(this->playlist.current());
+        }
+        else
+            this->display_song(this->playlist.first());
     }
 
     void play_next_song()
     {
-        this->current_song_it++;
-        if (!this->is_currnet_song_it_exist(this->current_song_it))
-            this->current_song_it = songs.cbegin();
-        this->display_song(*this->current_song_it);
+        if (this->is_shuffled && !this->playlist.is_empty())
+        {
+            this->seek_shuffled(this->shuffle_index + 1 == this->shuffle.size() ? 0 : this->shuffle_index + 1);
+            this->display_song(this->playlist.current());
+        }
+        else
+            this->display_song(this->playlist.next());
     }
 
     void play_previous_song()
     {
-        this->current_song_it--;
-        if (!this->is_currnet_song_it_exist(this->current_song_it))
-            this->current_song_it = --songs.cend();
-        this->display_song(*this->current_song_it);
+        if (this->is_shuffled && !this->playlist.is_empty())
+        {
+            this->seek_shuffled(this->shuffle_index == 0 ? this->shuffle.size() - 1 : this->shuffle_index - 1);
+            this->display_song(this->playlist.current());
+        }
+        else
+            this->display_song(this->playlist.previous());
     }
 
-    void add_song()
+    // on, a random order of the play order from the current song, off, the play order from it
+    void toggle_shuffle(std::uint64_t seed)
     {
-        auto it = std::find(this->songs.cbegin(), this->songs.cend(), *this->current_song_it);
-        if (!this->is_currnet_song_it_exist(it))
-            std::cout << "Not found the song" << std::endl;
-        else
+        this->is_shuffled = !this->is_shuffled;
+        if (this->is_shuffled)
         {
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::string str;
-            std::istringstream iss;
-            std::string name;
-            std::string artist;
-            int rating;
-
-            do
-            {
-                std::cin.clear();
-                iss.clear();
-                std::cout << "Enter a name, artist and rating seperated by an space: ";
-                std::getline(std::cin, str);
-                iss.str(str);
-            } while (!(iss >> name >> artist >> rating));
-
-            this->songs.insert(it, Song {name, artist, rating});
-            std::cout << "A new song inserted." << std::endl;
-            this->current_song_it--;
+            this->shuffle = Shuffle_order {this->playlist.size(), seed};
+            this->shuffle_index = this->shuffle.index_of(this->playlist.get_position());
         }
+        this->os << "Shuffle play " << (this->is_shuffled ? "on." : "off.") << '\n';
+    }
+
+    // a song inserted makes another order of one more song, the current song stays the current one
+    void add_song(std::string_view name, std::string_view artist, int rating)
+    {
+        this->playlist.insert(this->playlist.add(name, artist, rating));
+        if (this->is_shuffled)
+        {
+            this->shuffle = Shuffle_order {this->playlist.size(), this->shuffle.get_seed()};
+            this->shuffle_index = this->shuffle.index_of(this->playlist.get_position());
+        }
+        this->os << "A new song inserted." << '\n';
+    }
+
+    // the name, artist and rating of a line, separated by spaces, what follows them is ignored
+    static bool parse_song(std::string_view line, std::string_view &name, std::string_view &artist, int &rating)
+    {
+        batch_io::Scanner fields {line};
+        return fields.next_word(name) && fields.next_word(artist) && fields.next_int(rating);
+    }
+
+    // the rest of the line of the selection goes, then lines until one is a song, none at the end of the input
+    void read_song(fast_console::Input &input)
+    {
+        input.ignore_line();
+        std::string line;
+        std::string_view name;
+        std::string_view artist;
+        int rating;
+
+        do
+        {
+            std::cout << "Enter a name, artist and rating seperated by an space: ";
+            if (!input.next_line(line))
+                return;
+        } while (!parse_song(line, name, artist, rating));
+
+        this->add_song(name, artist, rating);
+    }
+
+    // the songs rated low to high, from the index of the ratings, the lowest first
+    void display_rated(int low, int high) const
+    {
+        const std::vector<Playlist::Id> ids = this->playlist.with_rating(low, high);
+        for (const Playlist::Id id : ids)
+            this->os << this->playlist.get(id);
+        if (ids.empty())
+            this->os << "No song is rated " << low << " to " << high << '\n';
     }
 
     void display_playlist() const
     {
-        std::for_each(this->songs.cbegin(),
-            this->songs.cend(),
-            [this] (const Song& song) { this->display_song(song); });
-        std::cout << std::endl;
-        std::cout << "Current song: " << std::endl;
-        this->display_song(*this->current_song_it);
+        this->playlist.for_each([this] (const Song& song) { this->os << song; });
+        this->os << '\n';
+        this->os << "Current song: " << '\n';
+        this->display_song(this->playlist.current());
     }
 };
 
 void display_menu()
 {
-    std::cout << std::endl;
-    std::cout << "F - play first song" << std::endl;
-    std::cout << "N - play next song" << std::endl;
-    std::cout << "P - play previous song" << std::endl;
-    std::cout << "A - add and play a new song at current location" << std::endl;
-    std::cout << "L - list the current playlist" << std::endl;
-    std::cout << "============================================================" << std::endl;
+    std::cout << '\n';
+    std::cout << "F - play first song" << '\n';
+    std::cout << "N - play next song" << '\n';
+    std::cout << "P - play previous song" << '\n';
+    std::cout << "A - add and play a new song at current location" << '\n';
+    std::cout << "L - list the current playlist" << '\n';
+    std::cout << "R - list the songs of a range of ratings" << '\n';
+    std::cout << "S - shuffle play on or off" << '\n';
+    std::cout << "============================================================" << '\n';
     std::cout << "Enter a selection (Q to quit): ";
 }
 
-int main()
+// until q or the end of the commands, an a without a song after it ends it
+int run_batch(const char *file, std::optional<std::string> records, const char *catalog)
 {
-    Songs songs;
+    const std::string commands {batch_io::read_all(file)};
+    batch_io::Scanner scanner {commands};
+    batch_io::Output_buffer buffer;
+    std::ostream os {&buffer};
+    Songs songs {os, std::move(records)};
+    if (catalog != nullptr)
+        songs.load(mapped_catalog::Catalog {catalog});
+    char option {0};
+
+    while (scanner.next_char(option) && (option = std::tolower(option)) != 'q')
+    {
+        os << '\n';
+
+        switch (option)
+        {
+            case 'f': songs.play_first_song(); break;
+            case 'n': songs.play_next_song(); break;
+            case 'a':
+            {
+                scanner.skip_line();
+                std::string_view line, name, artist;
+                int rating;
+                bool is_song {false};
+                while (!is_song && scanner.next_line(line))
+                    is_song = Songs::parse_song(line, name, artist, rating);
+                if (!is_song)
+                    throw std::runtime_error("line " + std::to_string(scanner.get_line()) + ": a name, artist and rating is expected after a");
+                songs.add_song(name, artist, rating);
+                break;
+            }
+            case 'p': songs.play_previous_song(); break;
+            case 'l': songs.display_playlist(); break;
+            case 'r':
+            {
+                int low, high;
+                if (!scanner.next_int(low) || !scanner.next_int(high))
+                    throw std::runtime_error("line " + std::to_string(scanner.get_line()) + ": two ratings are expected after r");
+                songs.display_rated(low, high);
+                break;
+            }
+            // the same seed every time, a batch gives the same output
+            case 's': songs.toggle_shuffle(2024); break;
+            default: break;
+        }
+    }
+
+    return 0;
+}
+
+// the menu, one selection at a time, until q or the end of the input
+int run_menu(std::optional<std::string> records, const char *catalog)
+{
+    fast_console::Guard console;
+    Songs songs {std::cout, std::move(records)};
+    if (catalog != nullptr)
+        songs.load(mapped_catalog::Catalog {catalog});
     char option {0};
 
     do
     {
         display_menu();
-        std::cin >> option;
+        if (!console.input().next_char(option))
+            option = 'q';
         option = std::tolower(option);
-        std::cout << std::endl;
+        std::cout << '\n';
 
         switch (option)
         {
             case 'f': songs.play_first_song(); break;
             case 'n': songs.play_next_song(); break;
-            case 'a': songs.add_song(); break;
+            case 'a': songs.read_song(console.input()); break;
             case 'p': songs.play_previous_song(); break;
             case 'l': songs.display_playlist(); break;
+            case 'r':
+            {
+                int low, high;
+                std::cout << "Enter the lowest and the highest rating: ";
+                if (console.input().next_int(low) && console.input().next_int(high))
+                    songs.display_rated(low, high);
+                break;
+            }
+            case 's': songs.toggle_shuffle(std::random_device {}()); break;
             default: break;
         }
     } while (option != 'q');
     
     return 0;
 }
+
+int main(int argc, char *argv[])
+{
+    std::optional<std::string> records;
+    const char *file {nullptr};
+    const char *catalog {nullptr};
+    try
+    {
+        if (argc > 2 && std::string_view {argv[1]} == "--songs")
+        {
+            if (mapped_catalog::is_catalog(argv[2]))
+            {
+                records.emplace();
+                catalog = argv[2];
+            }
+            else
+                records = batch_io::read_all(argv[2]);
+            argc -= 2;
+            argv += 2;
+        }
+        if (batch_io::is_batch(argc, argv, file))
+            return run_batch(file, std::move(records), catalog);
+        return run_menu(std::move(records), catalog);
+    }
+    catch (const std::runtime_error &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
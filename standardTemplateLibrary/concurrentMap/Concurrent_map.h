@@ -0,0 +1,403 @@
+#ifndef _CONCURRENT_MAP_H_
+#define _CONCURRENT_MAP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../map/Swiss_map.h"
+#include "../../functions/passingArrayToFunction/Span.h"
+
+/*
+
+    - a Concurrent_map is a hash map many threads read and write at once, the counts of the
+      words of the chunks of a text, the balances of accounts by id. it is split in shards
+      by the high bits of the hash, 64 by default, each one a table of its own with a mutex
+      of its own that only the writers take, two writes wait for each other only when their
+      keys are in the same shard.
+
+    - a read takes no lock and writes nothing. a table is open addressing with linear
+      probing, every slot has a control byte, empty, erased, or 7 bits of the hash, the key of
+      a slot is written before its byte and never changes after, a reader that sees the byte
+      sees the key. the values are in buckets of 8 slots with a version, a writer makes it
+      odd, writes, and makes it even again, a reader copies the value and reads the version
+      again, a seqlock, and copies it again when it changed, so T is trivially copyable, a
+      count, an amount of money, an id.
+
+    - an erase leaves the key and an erased byte, a slot is only used again when the shard is
+      rehashed into a new table, when 3 / 4 of its slots have a key, of twice the size when
+      more than half of them are not erased, of the same size when they are. the old table is
+      kept, a reader can still be probing it,
+      reclaim frees the old tables when no thread is reading, they are at most as big as the
+      tables in use, of erases and inserts that churn they are more.
+
+    - update_or_insert(key, value, merge) calls merge(value of the key, value) under the lock
+      of the shard when the key is there, and inserts value when it is not. the bulk one takes
+      a span of pairs and puts them in the order of their shards first, so the lock of every
+      shard is taken once for all of its keys, and the slot of the key a few ahead is
+      prefetched while one is merged, what merging the counts of a thread into the map does.
+
+    - find, contains and erase take anything Hash and Equal take, a std::string_view for a
+      std::string key with Swiss_hash and std::equal_to<>, like Swiss_map.
+
+*/
+template <typename Key, typename T, typename Hash = Swiss_hash<Key>, typename Equal = std::equal_to<>>
+class Concurrent_map
+{
+    static_assert(std::is_trivially_copyable_v<T>, "the values of a Concurrent_map are read while they can be written");
+
+private:
+    static constexpr std::size_t cache_line = 64;
+    static constexpr std::size_t bucket_size = 8;
+    static constexpr std::uint8_t empty_byte = 0;
+    static constexpr std::uint8_t erased_byte = 1;
+    static constexpr std::size_t prefetch_distance = 8;
+
+    struct Table
+    {
+        std::size_t capacity;  // a power of 2, at least bucket_size
+        std::unique_ptr<std::atomic<std::uint8_t>[]> control;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> versions;
+        Key* keys;
+        T* values;
+
+        explicit Table(std::size_t capacity)
+            : capacity(capacity), control(new std::atomic<std::uint8_t>[capacity]),
+              versions(new std::atomic<std::uint32_t>[capacity / bucket_size]),
+              keys(std::allocator<Key> {}.allocate(capacity)), values(std::allocator<T> {}.allocate(capacity))
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+                this->control[i].store(empty_byte, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < capacity / bucket_size; ++i)
+                this->versions[i].store(0, std::memory_order_relaxed);
+        }
+
+        // the keys of the erased slots are there too
+        ~Table()
+        {
+            for (std::size_t i = 0; i < this->capacity; ++i)
+                if (this->control[i].load(std::memory_order_relaxed) != empty_byte)
+                    this->keys[i].~Key();
+            std::allocator<Key> {}.deallocate(this->keys, this->capacity);
+            std::allocator<T> {}.deallocate(this->values, this->capacity);
+        }
+
+        Table(const Table&) = delete;
+        Table& operator=(const Table&) = delete;
+    };
+
+    struct alignas(cache_line) Shard
+    {
+        std::mutex lock;
+        std::atomic<Table*> table {nullptr};
+        std::vector<std::unique_ptr<Table>> tables;  // the one in use last
+        std::size_t used {0};   // the slots with a key, erased or not
+        std::atomic<std::size_t> live {0};
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t num_shards;
+    unsigned shard_shift;
+    Hash hash;
+    Equal equal;
+
+    template <typename F, typename = void>
+    struct Is_transparent : std::false_type {};
+
+    template <typename F>
+    struct Is_transparent<F, std::void_t<typename F::is_transparent>> : std::true_type {};
+
+    template <typename K>
+    using if_transparent = std::enable_if_t<std::is_same_v<K, Key> || (Is_transparent<Hash>::value && Is_transparent<Equal>::value)>;
+
+    template <typename K>
+    std::uint64_t hash_of(const K& key) const
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(this->hash(key)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 29);
+    }
+
+    static std::uint8_t byte_of(std::uint64_t h) { return static_cast<std::uint8_t>(0x80 | (h & 0x7F)); }
+
+    Shard& shard_of(std::uint64_t h) const
+    {
+        return this->shards[this->shard_shift >= 64 ? 0 : h >> this->shard_shift];
+    }
+
+    // the slot of the key in the table, or capacity when it is not there
+    template <typename K>
+    std::size_t find_slot(const Table& table, const K& key, std::uint64_t h) const
+    {
+        const std::size_t mask = table.capacity - 1;
+        const std::uint8_t byte = byte_of(h);
+        for (std::size_t i = (h >> 7) & mask, probes = 0; probes < table.capacity; i = (i + 1) & mask, ++probes)
+        {
+            const std::uint8_t control = table.control[i].load(std::memory_order_acquire);
+            if (control == empty_byte)
+                break;
+            if (control == byte && this->equal(table.keys[i], key))
+                return i;
+        }
+        return table.capacity;
+    }
+
+    static void write_value(Table& table, std::size_t i, const T& value)
+    {
+        std::atomic<std::uint32_t>& version = table.versions[i / bucket_size];
+        const std::uint32_t before = version.load(std::memory_order_relaxed);
+        version.store(before + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        table.values[i] = value;
+        version.store(before + 2, std::memory_order_release);
+    }
+
+    // the shard is locked, a table with room for one more key
+    void make_room(Shard& shard)
+    {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (table != nullptr && (shard.used + 1) * 4 <= table->capacity * 3)
+            return;
+        const std::size_t live = shard.live.load(std::memory_order_relaxed);
+        std::size_t capacity = table == nullptr ? 16 : table->capacity;
+        while ((live + 1) * 2 > capacity)
+            capacity *= 2;
+
+        std::unique_ptr<Table> grown {new Table {capacity}};
+        if (table != nullptr)
+            for (std::size_t i = 0; i < table->capacity; ++i)
+                if (table->control[i].load(std::memory_order_relaxed) > erased_byte)
+                {
+                    const std::uint64_t h = this->hash_of(table->keys[i]);
+                    std::size_t j = (h >> 7) & (capacity - 1);
+                    while (grown->control[j].load(std::memory_order_relaxed) != empty_byte)
+                        j = (j + 1) & (capacity - 1);
+                    ::new (static_cast<void*>(grown->keys + j)) Key(table->keys[i]);
+                    grown->values[j] = table->values[i];
+                    grown->control[j].store(byte_of(h), std::memory_order_relaxed);
+                }
+        shard.used = live;
+        shard.tables.push_back(std::move(grown));
+        shard.table.store(shard.tables.back().get(), std::memory_order_release);
+    }
+
+    // the shard is locked
+    template <typename K, typename F>
+    bool update_or_insert_locked(Shard& shard, K&& key, std::uint64_t h, const T& value, F& merge)
+    {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (table != nullptr)
+        {
+            const std::size_t i = this->find_slot(*table, key, h);
+            if (i != table->capacity)
+            {
+                T merged = table->values[i];
+                merge(merged, value);
+                write_value(*table, i, merged);
+                return false;
+            }
+        }
+        this->make_room(shard);
+        table = shard.table.load(std::memory_order_relaxed);
+        std::size_t i = (h >> 7) & (table->capacity - 1);
+        while (table->control[i].load(std::memory_order_relaxed) != empty_byte)
+            i = (i + 1) & (table->capacity - 1);
+        ::new (static_cast<void*>(table->keys + i)) Key(std::forward<K>(key));
+        table->values[i] = value;
+        table->control[i].store(byte_of(h), std::memory_order_release);
+        ++shard.used;
+        shard.live.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+public:
+    explicit Concurrent_map(std::size_t num_shards = 64)
+    {
+        this->num_shards = 1;
+        unsigned bits = 0;
+        while (this->num_shards < num_shards)
+        {
+            this->num_shards *= 2;
+            ++bits;
+        }
+        this->shard_shift = 64 - bits;
+        this->shards.reset(new Shard[this->num_shards]);
+    }
+
+    Concurrent_map(const Concurrent_map&) = delete;
+    Concurrent_map& operator=(const Concurrent_map&) = delete;
+
+    std::size_t get_num_shards() const { return this->num_shards; }
+
+    // exact when no thread is writing
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < this->num_shards; ++i)
+            total += this->shards[i].live.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // the value of the key into value, false when it is not there
+    template <typename K, typename = if_transparent<K>>
+    bool find(const K& key, T& value) const
+    {
+        const std::uint64_t h = this->hash_of(key);
+        const Table* table = this->shard_of(h).table.load(std::memory_order_acquire);
+        if (table == nullptr)
+            return false;
+        const std::size_t i = this->find_slot(*table, key, h);
+        if (i == table->capacity)
+            return false;
+        const std::atomic<std::uint32_t>& version = table->versions[i / bucket_size];
+        for (;;)
+        {
+            const std::uint32_t before = version.load(std::memory_order_acquire);
+            if (before % 2 != 0)
+                continue;
+            std::memcpy(static_cast<void*>(&value), static_cast<const void*>(table->values + i), sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) == before)
+                break;
+        }
+        // erased while it was read
+        return table->control[i].load(std::memory_order_acquire) > erased_byte;
+    }
+
+    template <typename K, typename = if_transparent<K>>
+    bool contains(const K& key) const
+    {
+        T value;
+        return this->find(key, value);
+    }
+
+    // true when the key was new
+    bool insert_or_assign(const Key& key, const T& value)
+    {
+        auto assign = [](T& existing, const T& incoming) { existing = incoming; };
+        return this->update_or_insert(key, value, assign);
+    }
+
+    // merge(T& existing, const T& value) when the key is there, true when it was new
+    template <typename K, typename F, typename = if_transparent<std::decay_t<K>>>
+    bool update_or_insert(K&& key, const T& value, F merge)
+    {
+        const std::uint64_t h = this->hash_of(key);
+        Shard& shard = this->shard_of(h);
+        std::lock_guard<std::mutex> guard {shard.lock};
+        return this->update_or_insert_locked(shard, std::forward<K>(key), h, value, merge);
+    }
+
+    // every pair of items, one lock of each shard, the number of keys that were new
+    template <typename F>
+    std::size_t update_or_insert(Span<const std::pair<Key, T>> items, F merge)
+    {
+        // the items of every shard together, in the order they are in items
+        std::vector<std::uint64_t> hashes(items.size());
+        std::vector<std::size_t> starts(this->num_shards + 1, 0);
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            hashes[i] = this->hash_of(items[i].first);
+            ++starts[&this->shard_of(hashes[i]) - this->shards.get() + 1];
+        }
+        for (std::size_t s = 0; s < this->num_shards; ++s)
+            starts[s + 1] += starts[s];
+        std::vector<std::uint32_t> order(items.size());
+        std::vector<std::size_t> at {starts.begin(), starts.end() - 1};
+        for (std::size_t i = 0; i < items.size(); ++i)
+            order[at[&this->shard_of(hashes[i]) - this->shards.get()]++] = static_cast<std::uint32_t>(i);
+
+        std::size_t inserted = 0;
+        for (std::size_t s = 0; s < this->num_shards; ++s)
+        {
+            if (starts[s] == starts[s + 1])
+                continue;
+            Shard& shard = this->shards[s];
+            std::lock_guard<std::mutex> guard {shard.lock};
+            for (std::size_t k = starts[s]; k < starts[s + 1]; ++k)
+            {
+                // the slot of a key a few ahead is on its way while this one is merged
+                const Table* table = shard.table.load(std::memory_order_relaxed);
+                if (table != nullptr && k + prefetch_distance < starts[s + 1])
+                {
+                    const std::size_t ahead = (hashes[order[k + prefetch_distance]] >> 7) & (table->capacity - 1);
+                    __builtin_prefetch(table->control.get() + ahead);
+                    __builtin_prefetch(table->keys + ahead);
+                }
+                const std::pair<Key, T>& item = items[order[k]];
+                inserted += this->update_or_insert_locked(shard, item.first, hashes[order[k]], item.second, merge);
+            }
+        }
+        return inserted;
+    }
+
+    template <typename K, typename = if_transparent<K>>
+    bool erase(const K& key)
+    {
+        const std::uint64_t h = this->hash_of(key);
+        Shard& shard = this->shard_of(h);
+        std::lock_guard<std::mutex> guard {shard.lock};
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (table == nullptr)
+            return false;
+        const std::size_t i = this->find_slot(*table, key, h);
+        if (i == table->capacity)
+            return false;
+        // a reader that copied the value before checks the byte after it
+        std::atomic<std::uint32_t>& version = table->versions[i / bucket_size];
+        const std::uint32_t before = version.load(std::memory_order_relaxed);
+        version.store(before + 1, std::memory_order_relaxed);
+        table->control[i].store(erased_byte, std::memory_order_release);
+        version.store(before + 2, std::memory_order_release);
+        shard.live.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // f(const Key&, const T&) of every key, a shard at a time under its lock
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (std::size_t s = 0; s < this->num_shards; ++s)
+        {
+            Shard& shard = this->shards[s];
+            std::lock_guard<std::mutex> guard {shard.lock};
+            const Table* table = shard.table.load(std::memory_order_relaxed);
+            if (table == nullptr)
+                continue;
+            for (std::size_t i = 0; i < table->capacity; ++i)
+                if (table->control[i].load(std::memory_order_relaxed) > erased_byte)
+                    f(table->keys[i], table->values[i]);
+        }
+    }
+
+    // the tables that are not in use are freed, no thread is reading the map at the same time
+    void reclaim()
+    {
+        for (std::size_t s = 0; s < this->num_shards; ++s)
+        {
+            Shard& shard = this->shards[s];
+            std::lock_guard<std::mutex> guard {shard.lock};
+            if (shard.tables.size() > 1)
+                shard.tables.erase(shard.tables.begin(), shard.tables.end() - 1);
+        }
+    }
+
+    // the bytes of the tables in use and of the old ones, not of what the keys point to
+    std::size_t get_memory() const
+    {
+        std::size_t bytes = sizeof(Shard) * this->num_shards;
+        for (std::size_t s = 0; s < this->num_shards; ++s)
+            for (const auto& table : this->shards[s].tables)
+                bytes += table->capacity * (1 + sizeof(Key) + sizeof(T)) + table->capacity / bucket_size * 4;
+        return bytes;
+    }
+};
+
+#endif
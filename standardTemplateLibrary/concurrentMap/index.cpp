@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Concurrent_map.h"
+
+void test1()
+{
+    std::cout << std::endl << "test1=========================" << std::endl;
+
+    // the balances of accounts by id, in cents
+    Concurrent_map<int, long long> balances;
+    balances.insert_or_assign(1, 10000);
+    balances.insert_or_assign(2, 500);
+    balances.update_or_insert(2, 250, [](long long& balance, long long amount) { balance += amount; });
+
+    long long balance {0};
+    for (int id : {1, 2, 3})
+    {
+        if (balances.find(id, balance))
+            std::cout << id << ": " << balance << std::endl;
+        else
+            std::cout << id << ": not found" << std::endl;
+    }
+
+    std::cout << "erase 1: " << std::boolalpha << balances.erase(1) << std::endl;
+    std::cout << "contains 1: " << balances.contains(1) << std::endl;
+    std::cout << "size: " << balances.size() << std::endl;
+
+    std::cout << std::endl;
+}
+
+void test2()
+{
+    std::cout << std::endl << "test2=========================" << std::endl;
+
+    // every thread counts the words of its chunk and merges them in at once
+    const std::vector<std::string> chunks {
+        "to be or not to be", "that is the question", "whether tis nobler in the mind to suffer",
+        "the slings and arrows of outrageous fortune"};
+    Concurrent_map<std::string, int> counts {8};
+    const auto add = [](int& count, int more) { count += more; };
+
+    std::vector<std::thread> threads;
+    for (const std::string& chunk : chunks)
+        threads.emplace_back([&counts, &chunk, &add]
+        {
+            std::vector<std::pair<std::string, int>> words;
+            std::size_t start = 0;
+            while (start < chunk.size())
+            {
+                std::size_t end = chunk.find(' ', start);
+                if (end == std::string::npos)
+                    end = chunk.size();
+                words.emplace_back(chunk.substr(start, end - start), 1);
+                start = end + 1;
+            }
+            counts.update_or_insert(Span<const std::pair<std::string, int>> {words}, add);
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // a std::string_view, no std::string is made
+    int count {0};
+    for (std::string_view word : {"to", "the", "be", "hamlet"})
+        std::cout << word << ": " << (counts.find(word, count) ? count : 0) << std::endl;
+    std::cout << "words: " << counts.size() << std::endl;
+
+    std::cout << std::endl;
+}
+
+int main()
+{
+    test1();
+    test2();
+
+    return 0;
+}
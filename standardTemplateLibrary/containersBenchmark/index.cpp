@@ -0,0 +1,431 @@
+/*
+
+    - times the typical operations of the containers of the examples next to this one,
+      std::vector, std::deque, std::list, std::forward_list, std::set, std::map, std::stack,
+      std::queue and std::priority_queue, with 100 to 10'000'000 elements, a power of ten at a
+      time, of int, Person and std::string, and prints one CSV line per container, payload,
+      size and operation.
+
+    - the columns are container,payload,size,operation,ops,ns_per_op,checksum, ops is the
+      number of operations timed, the checksum is there so nothing is optimized out, it is
+      the same for the same values on every machine.
+
+    - the containers are built before the clock starts, from the same values in a random
+      order, and destroyed after it stops. the operations that are linear for a container,
+      like an insert at the front of a std::vector or a std::find, are done fewer times on
+      the bigger sizes, and the small sizes are repeated, so every line times about a
+      million elements of work.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - the largest size is 10'000'000 by default, a smaller one can be given on the command
+      line, e.g. ./a.out 100000 > results.csv
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <forward_list>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <string>
+#include <vector>
+
+constexpr std::size_t work {1'000'000};
+
+class Person
+{
+private:
+    std::string name;
+    int age;
+
+public:
+    Person() : name("Unknown"), age(0) {}
+    Person(std::string name, int age) : name(name), age(age) {}
+
+    int get_age() const { return this->age; }
+
+    bool operator<(const Person& rhs) const { return this->age < rhs.age; }
+    bool operator==(const Person& rhs) const { return this->name == rhs.name && this->age == rhs.age; }
+};
+
+// the values are unique, made from a number
+template <typename T>
+T make(std::size_t i);
+
+template <>
+int make<int>(std::size_t i) { return static_cast<int>(i); }
+
+template <>
+Person make<Person>(std::size_t i) { return Person {"Person " + std::to_string(i % 1000), static_cast<int>(i)}; }
+
+template <>
+std::string make<std::string>(std::size_t i) { return "word" + std::to_string(i); }
+
+std::uint64_t value_of(int value) { return static_cast<std::uint32_t>(value); }
+std::uint64_t value_of(const Person& value) { return static_cast<std::uint32_t>(value.get_age()); }
+std::uint64_t value_of(const std::string& value) { return value.size() * 31 + static_cast<unsigned char>(value.back()); }
+
+template <typename T>
+const char* payload_name();
+
+template <>
+const char* payload_name<int>() { return "int"; }
+
+template <>
+const char* payload_name<Person>() { return "Person"; }
+
+template <>
+const char* payload_name<std::string>() { return "std::string"; }
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// the number of times a linear operation is done on n elements
+std::size_t linear_ops(std::size_t n)
+{
+    return std::clamp<std::size_t>(work / n, 1, 1'000);
+}
+
+template <typename T>
+struct Case
+{
+    const char* container;
+    const std::vector<T>& values;
+    const std::vector<std::size_t>& probes; // random indices of values, for lookups
+};
+
+// setup() before the clock, op(container) timed, repeated until about work elements are touched,
+// cost is the number of elements one operation touches
+template <typename T, typename Setup, typename Op>
+void measure(const Case<T>& c, const char* operation, std::size_t ops, std::size_t cost, Setup setup, Op op)
+{
+    const std::size_t n = c.values.size();
+    const std::size_t repeats = std::clamp<std::size_t>(work / (ops * cost), 1, 1'000);
+    double seconds {0};
+    std::uint64_t checksum {0};
+    for (std::size_t repeat = 0; repeat < repeats; ++repeat)
+    {
+        auto container = setup();
+        const auto start = std::chrono::steady_clock::now();
+        checksum += op(container);
+        seconds += seconds_since(start);
+    }
+    std::cout << c.container << ',' << payload_name<T>() << ',' << n << ',' << operation << ','
+        << ops << ',' << seconds * 1e9 / (static_cast<double>(ops) * repeats) << ',' << checksum << '\n';
+}
+
+template <typename Container>
+std::uint64_t iterate(const Container& container)
+{
+    std::uint64_t sum {0};
+    for (const auto& value : container)
+        sum += value_of(value);
+    return sum;
+}
+
+template <typename Container, typename T>
+std::uint64_t find_all(const Container& container, const Case<T>& c, std::size_t ops)
+{
+    std::uint64_t sum {0};
+    for (std::size_t i = 0; i < ops; ++i)
+        sum += std::distance(container.begin(), std::find(container.begin(), container.end(), c.values[c.probes[i % c.probes.size()]]));
+    return sum;
+}
+
+// vector, deque and list, the ones with a back
+template <template <typename...> typename Sequence, typename T>
+void sequence(const Case<T>& c)
+{
+    using Container = Sequence<T>;
+    const std::size_t n = c.values.size();
+    const std::size_t linear = linear_ops(n);
+    constexpr bool has_front = !std::is_same_v<Container, std::vector<T>>;
+    constexpr bool is_list = std::is_same_v<Container, std::list<T>>;
+    auto empty = [] { return Container {}; };
+    auto full = [&c] { return Container(c.values.begin(), c.values.end()); };
+
+    measure(c, "push_back", n, 1, empty, [&c](Container& container)
+    {
+        for (const T& value : c.values)
+            container.push_back(value);
+        return static_cast<std::uint64_t>(container.size());
+    });
+
+    // a list inserts as many as it has, once the middle is found, a vector and a deque move elements
+    const std::size_t front_ops = has_front ? n : linear;
+    measure(c, "push_front", front_ops, has_front ? 1 : n, full, [&c, front_ops](Container& container)
+    {
+        for (std::size_t i = 0; i < front_ops; ++i)
+            container.insert(container.begin(), c.values[i % c.values.size()]);
+        return static_cast<std::uint64_t>(container.size());
+    });
+
+    const std::size_t middle_ops = is_list ? n : linear;
+    measure(c, "insert_middle", middle_ops, is_list ? 1 : n, full, [&c, middle_ops](Container& container)
+    {
+        auto it = std::next(container.begin(), container.size() / 2);
+        for (std::size_t i = 0; i < middle_ops; ++i)
+            it = container.insert(it, c.values[i % c.values.size()]);
+        return value_of(*it);
+    });
+
+    const std::size_t pop_front_ops = has_front ? n : std::min(n, linear);
+    measure(c, "erase_front", pop_front_ops, has_front ? 1 : n, full, [pop_front_ops](Container& container)
+    {
+        std::uint64_t sum {0};
+        for (std::size_t i = 0; i < pop_front_ops; ++i)
+        {
+            sum += value_of(container.front());
+            container.erase(container.begin());
+        }
+        return sum;
+    });
+
+    const std::size_t erase_middle_ops = is_list ? n / 2 : std::min(n / 2, linear);
+    measure(c, "erase_middle", erase_middle_ops, is_list ? 1 : n, full, [erase_middle_ops](Container& container)
+    {
+        auto it = std::next(container.begin(), container.size() / 2);
+        std::uint64_t sum {0};
+        for (std::size_t i = 0; i < erase_middle_ops; ++i)
+        {
+            sum += value_of(*it);
+            it = container.erase(it);
+        }
+        return sum;
+    });
+
+    measure(c, "erase_back", n, 1, full, [n](Container& container)
+    {
+        std::uint64_t sum {0};
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            sum += value_of(container.back());
+            container.pop_back();
+        }
+        return sum;
+    });
+
+    measure(c, "find", linear, n, full, [&c, linear](const Container& container) { return find_all(container, c, linear); });
+    measure(c, "iterate", n, 1, full, [](const Container& container) { return iterate(container); });
+
+    // sorted, then walked in order
+    measure(c, "sorted_traversal", n, 1, full, [](Container& container)
+    {
+        if constexpr (is_list)
+            container.sort();
+        else
+            std::sort(container.begin(), container.end());
+        return iterate(container) + value_of(container.front());
+    });
+}
+
+template <typename T>
+void forward_list(const Case<T>& c)
+{
+    using Container = std::forward_list<T>;
+    const std::size_t n = c.values.size();
+    const std::size_t linear = linear_ops(n);
+    auto empty = [] { return Container {}; };
+    auto full = [&c] { return Container(c.values.begin(), c.values.end()); };
+
+    measure(c, "push_front", n, 1, empty, [&c](Container& container)
+    {
+        for (const T& value : c.values)
+            container.push_front(value);
+        return value_of(container.front());
+    });
+
+    measure(c, "insert_middle", n, 1, full, [&c, n](Container& container)
+    {
+        auto it = std::next(container.begin(), n / 2);
+        for (std::size_t i = 0; i < n; ++i)
+            it = container.insert_after(it, c.values[i]);
+        return value_of(*it);
+    });
+
+    measure(c, "erase_front", n, 1, full, [n](Container& container)
+    {
+        std::uint64_t sum {0};
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            sum += value_of(container.front());
+            container.pop_front();
+        }
+        return sum;
+    });
+
+    // the ones after the middle, erase_after stays where it is
+    const std::size_t erase_middle_ops = n - n / 2 - 1;
+    measure(c, "erase_middle", erase_middle_ops, 1, full, [n, erase_middle_ops](Container& container)
+    {
+        auto it = std::next(container.begin(), n / 2);
+        for (std::size_t i = 0; i < erase_middle_ops; ++i)
+            container.erase_after(it);
+        return value_of(*it);
+    });
+
+    measure(c, "find", linear, n, full, [&c, linear](const Container& container) { return find_all(container, c, linear); });
+    measure(c, "iterate", n, 1, full, [](const Container& container) { return iterate(container); });
+
+    measure(c, "sorted_traversal", n, 1, full, [](Container& container)
+    {
+        container.sort();
+        return iterate(container) + value_of(container.front());
+    });
+}
+
+// a std::set of the values, or a std::map from them to their index
+template <typename Container, typename T>
+void associative(const Case<T>& c)
+{
+    constexpr bool is_map = !std::is_same_v<typename Container::key_type, typename Container::value_type>;
+    const std::size_t n = c.values.size();
+    auto insert = [&c](Container& container)
+    {
+        for (std::size_t i = 0; i < c.values.size(); ++i)
+            if constexpr (is_map)
+                container.emplace(c.values[i], static_cast<int>(i));
+            else
+                container.insert(c.values[i]);
+        return static_cast<std::uint64_t>(container.size());
+    };
+    auto empty = [] { return Container {}; };
+    auto full = [&insert]
+    {
+        Container container;
+        insert(container);
+        return container;
+    };
+    auto key_of = [](const auto& item) -> const T&
+    {
+        if constexpr (is_map)
+            return item.first;
+        else
+            return item;
+    };
+
+    measure(c, "insert", n, 1, empty, insert);
+
+    measure(c, "find", n, 1, full, [&c, &key_of](const Container& container)
+    {
+        std::uint64_t sum {0};
+        for (std::size_t probe : c.probes)
+            sum += value_of(key_of(*container.find(c.values[probe])));
+        return sum;
+    });
+
+    if constexpr (is_map)
+        measure(c, "subscript", n, 1, full, [&c](Container& container)
+        {
+            std::uint64_t sum {0};
+            for (std::size_t probe : c.probes)
+                sum += ++container[c.values[probe]];
+            return sum;
+        });
+
+    measure(c, "erase", n, 1, full, [&c](Container& container)
+    {
+        std::uint64_t sum {0};
+        for (std::size_t probe : c.probes)
+            sum += container.erase(c.values[probe]);
+        return sum + container.size();
+    });
+
+    // in key order, the one of the tree
+    measure(c, "sorted_traversal", n, 1, full, [&key_of](const Container& container)
+    {
+        std::uint64_t sum {0};
+        for (const auto& item : container)
+            sum += value_of(key_of(item));
+        return sum;
+    });
+}
+
+// stack, queue and priority_queue, pushed and then popped empty, a priority_queue pops in order
+template <typename Adapter, typename T, typename Next>
+void adapter(const Case<T>& c, Next next)
+{
+    const std::size_t n = c.values.size();
+    auto full = [&c]
+    {
+        Adapter adapter;
+        for (const T& value : c.values)
+            adapter.push(value);
+        return adapter;
+    };
+
+    measure(c, "push", n, 1, [] { return Adapter {}; }, [&c](Adapter& adapter)
+    {
+        for (const T& value : c.values)
+            adapter.push(value);
+        return static_cast<std::uint64_t>(adapter.size());
+    });
+
+    measure(c, "pop", n, 1, full, [&next](Adapter& adapter)
+    {
+        std::uint64_t sum {0};
+        while (!adapter.empty())
+        {
+            sum += value_of(next(adapter));
+            adapter.pop();
+        }
+        return sum;
+    });
+}
+
+template <typename T>
+void run(std::size_t n, std::mt19937_64& random)
+{
+    // 0, 1, ... n - 1 in a random order, made into values
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), random);
+    std::vector<T> values;
+    values.reserve(n);
+    for (std::size_t i : order)
+        values.push_back(make<T>(i));
+    std::vector<std::size_t> probes = order;
+    std::shuffle(probes.begin(), probes.end(), random);
+
+    sequence<std::vector>(Case<T> {"std::vector", values, probes});
+    sequence<std::deque>(Case<T> {"std::deque", values, probes});
+    sequence<std::list>(Case<T> {"std::list", values, probes});
+    forward_list(Case<T> {"std::forward_list", values, probes});
+    associative<std::set<T>>(Case<T> {"std::set", values, probes});
+    associative<std::map<T, int>>(Case<T> {"std::map", values, probes});
+    adapter<std::stack<T>>(Case<T> {"std::stack", values, probes}, [](const std::stack<T>& s) -> const T& { return s.top(); });
+    adapter<std::queue<T>>(Case<T> {"std::queue", values, probes}, [](const std::queue<T>& q) -> const T& { return q.front(); });
+    adapter<std::priority_queue<T>>(Case<T> {"std::priority_queue", values, probes},
+        [](const std::priority_queue<T>& pq) -> const T& { return pq.top(); });
+    std::cout.flush();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t max_size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10'000'000;
+
+    std::mt19937_64 random {42};
+    std::cout << "container,payload,size,operation,ops,ns_per_op,checksum\n";
+    for (std::size_t n = 100; n <= max_size; n *= 10)
+    {
+        run<int>(n, random);
+        run<Person>(n, random);
+        run<std::string>(n, random);
+    }
+
+    return 0;
+}
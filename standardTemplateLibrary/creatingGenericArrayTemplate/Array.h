@@ -0,0 +1,156 @@
+#ifndef _ARRAY_H_
+#define _ARRAY_H_
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
+
+/*
+
+    - Array<T, N, Align> is the N values and nothing else, the size is N, it is not stored,
+      and the values start on an Align boundary, alignof(T) by default, 64 puts them on a
+      cache line and on a boundary for every SIMD width.
+
+    - everything is constexpr, an Array can be built, filled and reduced at compile time,
+      the values are value initialized, so a default Array is all zeros for numbers.
+
+    - the iterators are pointers, data and size build a span, a std::span<T, N> with C++20.
+
+    - fill, transform and reduce are plain loops on the aligned values that the compiler
+      vectorizes, reduce of an arithmetic T adds into lanes accumulators and then adds the
+      lanes, so it vectorizes for floating point too, the sum is in a different order than
+      one by one.
+
+*/
+template <typename T, std::size_t N, std::size_t Align = alignof(T)>
+class Array final
+{
+    static_assert(N > 0, "an Array has at least one value");
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "the alignment is a power of two and at least the one of T");
+
+private:
+    alignas(Align) T values[N] {};
+
+    friend std::ostream& operator<<(std::ostream& os, const Array& rhs)
+    {
+        os << "[ ";
+        for (const auto& value : rhs.values)
+            os << value << " ";
+        os << "]";
+        return os;
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // the number of partial sums of reduce, 8 floats or 4 doubles are one AVX register
+    static constexpr std::size_t lanes = 32 / sizeof(T) > 0 ? 32 / sizeof(T) : 1;
+
+    constexpr Array() = default;
+
+    constexpr Array(const T& initial_value)
+    {
+        this->fill(initial_value);
+    }
+
+    constexpr void fill(const T& initial_value)
+    {
+        for (auto& value : this->values)
+            value = initial_value;
+    }
+
+    constexpr int get_size() const
+    {
+        return static_cast<int>(N);
+    }
+
+    static constexpr std::size_t size() { return N; }
+
+    constexpr T& operator[](std::size_t index) { return this->values[index]; }
+    constexpr const T& operator[](std::size_t index) const { return this->values[index]; }
+
+    constexpr T* data() { return this->values; }
+    constexpr const T* data() const { return this->values; }
+
+    constexpr iterator begin() { return this->values; }
+    constexpr iterator end() { return this->values + N; }
+    constexpr const_iterator begin() const { return this->values; }
+    constexpr const_iterator end() const { return this->values + N; }
+    constexpr const_iterator cbegin() const { return this->values; }
+    constexpr const_iterator cend() const { return this->values + N; }
+
+#if defined(__cpp_lib_span)
+    constexpr operator std::span<T, N>() { return std::span<T, N> {this->values}; }
+    constexpr operator std::span<const T, N>() const { return std::span<const T, N> {this->values}; }
+#endif
+
+    // every value becomes f(value)
+    template <typename F>
+    constexpr void transform(F f)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            this->values[i] = f(this->values[i]);
+    }
+
+    // every value becomes f(value, the value of other at the same index)
+    template <typename F>
+    constexpr void transform(const Array& other, F f)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            this->values[i] = f(this->values[i], other.values[i]);
+    }
+
+    // init plus every value
+    constexpr T reduce(T init = T {}) const
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            T partial[lanes] {};
+            std::size_t i = 0;
+            for (; i + lanes <= N; i += lanes)
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    partial[lane] += this->values[i + lane];
+            for (; i < N; ++i)
+                partial[i % lanes] += this->values[i];
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                init += partial[lane];
+            return init;
+        }
+        else
+        {
+            for (const auto& value : this->values)
+                init = init + value;
+            return init;
+        }
+    }
+
+    // op(... op(op(init, values[0]), values[1]) ..., values[N - 1])
+    template <typename Op>
+    constexpr T reduce(T init, Op op) const
+    {
+        for (const auto& value : this->values)
+            init = op(init, value);
+        return init;
+    }
+
+    constexpr bool operator==(const Array& rhs) const
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            if (!(this->values[i] == rhs.values[i]))
+                return false;
+        return true;
+    }
+
+    constexpr bool operator!=(const Array& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+#endif
@@ -1,47 +1,7 @@
 #include <iostream>
 #include <string>
-
-template <typename T, int N>
-class Array final
-{
-private:
-    int size {N};
-    T values[N];
-
-    friend std::ostream& operator<<(std::ostream& os, const Array<T, N>& rhs)
-    {
-        os << "[ ";
-        for (const auto& value : rhs.values)
-            os << value << " ";
-        os << "]";
-        return os;
-    }
-
-public:
-    Array() = default;
-
-    Array(T initial_value)
-    {
-        for (auto& value : this->values)
-            value = initial_value;
-    }
-
-    void fill(T initial_value)
-    {
-        for (auto& value : this->values)
-            value = initial_value;
-    }
-
-    int get_size() const
-    {
-        return this->size;
-    }
-
-    T& operator[](int index)
-    {
-        return this->values[index];
-    }
-};
+#include "Array.h"
+#include "Small_vector.h"
 
 int main()
 {
@@ -56,6 +16,24 @@ int main()
     arr2[0] = "Jack";
     arr2[1] = std::string {"Moe"};
     std::cout << arr2.get_size() << " " << arr2 << std::endl;
+
+    // built and summed by the compiler
+    constexpr Array<int, 5> fives {5};
+    static_assert(fives.reduce() == 25, "five fives are 25");
+    std::cout << fives << " sums to " << fives.reduce() << std::endl;
+
+    // on a cache line, the loops of transform and reduce are vectorized
+    Array<float, 16, 64> halves {0.5f};
+    halves.transform([](float value) { return value * 3; });
+    std::cout << sizeof halves << " bytes at " << static_cast<const void*>(halves.data())
+        << ", sum " << halves.reduce() << std::endl;
+
+    // four names fit inside, the fifth moves them to the heap
+    Small_vector<std::string, 4> names {"Frank", "Jack", "Moe"};
+    names.push_back("Larry");
+    std::cout << names.size() << " names, inline " << names.is_inline() << std::endl;
+    names.push_back("Curly");
+    std::cout << names.size() << " names, inline " << names.is_inline() << std::endl;
     
     return 0;
 }
@@ -14,12 +14,13 @@ public:
         : name(name), value(value) 
     {}
 
-    std::string get_name() const
+    // references, a sort or a find by name or value copies nothing
+    const std::string& get_name() const
     {
         return this->name;
     }
 
-    T get_value() const
+    const T& get_value() const
     {
         return this->value;
     }
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <vector>
+#include "../../algorithms/simdAlgorithms/Min_max.h"
 
 #define SQUARE(a) ((a) * (a))
 #define MAX(a, b) ((a > b) ? a : b)
@@ -24,5 +26,26 @@ int main()
     std::cout << MAX(num, num2) << std::endl;
     std::cout << MAX_SIZE << std::endl;
 
+    // the macros paste their arguments, MAX(i++, j) increments i twice when it is the larger,
+    // the function templates of Min_max.h evaluate them once and are constexpr
+    int i {7}, j {3};
+    std::cout << MAX(i++, j) << " " << i << std::endl;
+    i = 7;
+    std::cout << simd::max(i++, j) << " " << i << std::endl;
+
+    static_assert(simd::square(5) == 25 && 100 / simd::square(5) == 4);
+    static_assert(simd::clamp(250, 0, MAX_SIZE) == MAX_SIZE);
+    std::cout << simd::max(c, c2) << " " << simd::max<double>(num, num2) << std::endl;
+
+    // and of a range
+    std::vector<int> numbers {17, -3, 42, 8, 42, -3, 99, 0};
+    const auto [smallest, largest] = simd::min_max(numbers);
+    std::cout << "smallest: " << smallest << " at " << simd::argmin(numbers)
+              << ", largest: " << largest << " at " << simd::argmax(numbers) << std::endl;
+    simd::clamp_all(numbers, 0, 40);
+    for (const int n : numbers)
+        std::cout << n << " ";
+    std::cout << std::endl;
+
     return 0;
 }
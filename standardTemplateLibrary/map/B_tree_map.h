@@ -0,0 +1,683 @@
+#ifndef _B_TREE_MAP_H_
+#define _B_TREE_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+/*
+
+    - a B_tree_map is an ordered map in a B+ tree, the values are in the leaves, many in
+      every leaf, and the inner nodes have only keys and children, so a lookup reads a node
+      of Node_size bytes per level, a few levels for millions of keys, instead of one node
+      per key like a std::map.
+
+    - Node_size is the size a node is made for, 256 by default, four cache lines, 4096 is a
+      page, the number of keys of a node is what fits in it. the nodes are aligned to a
+      cache line.
+
+    - a key that a leaf is split at is copied up as the separator, the keys of a child are
+      before its separator and the ones of the next child are not, an erase can leave a
+      separator that is not a key any more, it still separates.
+
+    - an erase that leaves a node less than half full takes a key from a sibling or merges
+      with it, so every node but the root is at least half full.
+
+    - the leaves are linked both ways, iterating and range scans walk the leaves, an
+      iterator gives a std::pair of references like the one of Flat_map, item.first and
+      it->second work like with a std::map. an insert or an erase invalidates them.
+
+    - the keys and the values are default constructible and movable, the slots of a node are
+      built with it and the empty ones are reset to Key {} and T {}.
+
+*/
+template <typename Key, typename T, std::size_t Node_size = 256, typename Compare = std::less<Key>>
+class B_tree_map
+{
+public:
+    static constexpr std::size_t leaf_capacity = (Node_size - 32) / (sizeof(Key) + sizeof(T)) > 4
+        ? (Node_size - 32) / (sizeof(Key) + sizeof(T)) : 4;
+    static constexpr std::size_t inner_capacity = (Node_size - 16) / (sizeof(Key) + sizeof(void*)) > 4
+        ? (Node_size - 16) / (sizeof(Key) + sizeof(void*)) : 4;
+
+private:
+    static constexpr std::size_t leaf_min = leaf_capacity / 2;
+    static constexpr std::size_t inner_min = inner_capacity / 2;
+    // a fanout of at least 3 and 2^64 keys at most
+    static constexpr std::size_t max_height = 48;
+
+    struct Node
+    {
+        bool is_leaf;
+        std::uint32_t count;
+    };
+
+    struct alignas(64) Leaf : Node
+    {
+        Leaf* prev;
+        Leaf* next;
+        Key keys[leaf_capacity];
+        T values[leaf_capacity];
+
+        Leaf()
+            : Node{true, 0}, prev(nullptr), next(nullptr), keys(), values() {}
+    };
+
+    struct alignas(64) Inner : Node
+    {
+        Key keys[inner_capacity];
+        Node* children[inner_capacity + 1];
+
+        Inner()
+            : Node{false, 0}, keys(), children() {}
+    };
+
+    // the inner nodes from the root down and the child taken in each one
+    struct Path
+    {
+        Inner* nodes[max_height];
+        std::size_t children[max_height];
+        std::size_t depth = 0;
+    };
+
+    template <typename Map, typename Value>
+    class Basic_iterator
+    {
+        friend class B_tree_map;
+
+    private:
+        Map* map;
+        Leaf* leaf;  // nullptr is the end
+        std::size_t i;
+
+        Basic_iterator(Map* map, Leaf* leaf, std::size_t i)
+            : map(map), leaf(leaf), i(i) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, Value&>;
+
+        // it-> has to return something that has a ->, the pair of references is kept in it
+        struct pointer
+        {
+            reference pair;
+            const reference* operator->() const { return &this->pair; }
+        };
+
+        Basic_iterator()
+            : map(nullptr), leaf(nullptr), i(0) {}
+
+        // an iterator converts to a const_iterator
+        template <typename Other_map, typename Other_value>
+        Basic_iterator(const Basic_iterator<Other_map, Other_value>& other)
+            : map(other.map), leaf(other.leaf), i(other.i) {}
+
+        reference operator*() const { return {this->leaf->keys[this->i], this->leaf->values[this->i]}; }
+        pointer operator->() const { return pointer {**this}; }
+
+        Basic_iterator& operator++()
+        {
+            if (++this->i == this->leaf->count)
+            {
+                this->leaf = this->leaf->next;
+                this->i = 0;
+            }
+            return *this;
+        }
+
+        // from the end to the last value
+        Basic_iterator& operator--()
+        {
+            if (this->leaf == nullptr)
+            {
+                this->leaf = this->map->last_leaf;
+                this->i = this->leaf->count - 1;
+            }
+            else if (this->i == 0)
+            {
+                this->leaf = this->leaf->prev;
+                this->i = this->leaf->count - 1;
+            }
+            else
+                --this->i;
+            return *this;
+        }
+
+        Basic_iterator operator++(int) { Basic_iterator old = *this; ++*this; return old; }
+        Basic_iterator operator--(int) { Basic_iterator old = *this; --*this; return old; }
+
+        bool operator==(const Basic_iterator& rhs) const { return this->leaf == rhs.leaf && this->i == rhs.i; }
+        bool operator!=(const Basic_iterator& rhs) const { return !(*this == rhs); }
+
+        template <typename, typename>
+        friend class Basic_iterator;
+    };
+
+    Node* root;
+    Leaf* first_leaf;
+    Leaf* last_leaf;
+    std::size_t num_values;
+    Compare compare;
+
+    // the first of the count keys that is not before key
+    std::size_t lower_in(const Key* keys, std::size_t count, const Key& key) const
+    {
+        if (count == 0)
+            return 0;
+        const Key* first = keys;
+        while (count > 1)
+        {
+            const std::size_t half = count / 2;
+            first = this->compare(first[half - 1], key) ? first + half : first;
+            count -= half;
+        }
+        return static_cast<std::size_t>(first - keys) + this->compare(*first, key);
+    }
+
+    // the first of the count keys that is after key, the child of an inner node to go down to
+    std::size_t upper_in(const Key* keys, std::size_t count, const Key& key) const
+    {
+        if (count == 0)
+            return 0;
+        const Key* first = keys;
+        while (count > 1)
+        {
+            const std::size_t half = count / 2;
+            first = !this->compare(key, first[half - 1]) ? first + half : first;
+            count -= half;
+        }
+        return static_cast<std::size_t>(first - keys) + !this->compare(key, *first);
+    }
+
+    Leaf* find_leaf(const Key& key, Path* path) const
+    {
+        Node* node = this->root;
+        while (!node->is_leaf)
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            const std::size_t i = this->upper_in(inner->keys, inner->count, key);
+            if (path != nullptr)
+            {
+                path->nodes[path->depth] = inner;
+                path->children[path->depth++] = i;
+            }
+            node = inner->children[i];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    template <typename Value>
+    static void shift_right(Value* values, std::size_t from, std::size_t count)
+    {
+        for (std::size_t i = count; i > from; --i)
+            values[i] = std::move(values[i - 1]);
+    }
+
+    // values[from] is dropped, the one that was last is reset
+    template <typename Value>
+    static void shift_left(Value* values, std::size_t from, std::size_t count)
+    {
+        for (std::size_t i = from; i + 1 < count; ++i)
+            values[i] = std::move(values[i + 1]);
+        values[count - 1] = Value {};
+    }
+
+    void link_after(Leaf* leaf, Leaf* right)
+    {
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->prev = right;
+        else
+            this->last_leaf = right;
+        leaf->next = right;
+    }
+
+    void unlink(Leaf* leaf)
+    {
+        if (leaf->prev != nullptr)
+            leaf->prev->next = leaf->next;
+        else
+            this->first_leaf = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->prev = leaf->prev;
+        else
+            this->last_leaf = leaf->prev;
+    }
+
+    // the key and the child after it go in at i, a full node is split and the split goes up
+    void insert_up(Path& path, Key separator, Node* right)
+    {
+        while (path.depth > 0)
+        {
+            Inner* inner = path.nodes[--path.depth];
+            const std::size_t i = path.children[path.depth];
+
+            if (inner->count < inner_capacity)
+            {
+                shift_right(inner->keys, i, inner->count);
+                shift_right(inner->children, i + 1, inner->count + 1);
+                inner->keys[i] = std::move(separator);
+                inner->children[i + 1] = right;
+                ++inner->count;
+                return;
+            }
+
+            // all the keys and children of the node and the new ones, in order
+            Key keys[inner_capacity + 1];
+            Node* children[inner_capacity + 2];
+            for (std::size_t k = 0, from = 0; k <= inner_capacity; ++k)
+                keys[k] = k == i ? std::move(separator) : std::move(inner->keys[from++]);
+            for (std::size_t k = 0, from = 0; k <= inner_capacity + 1; ++k)
+                children[k] = k == i + 1 ? right : inner->children[from++];
+
+            const std::size_t mid = (inner_capacity + 1) / 2;
+            Inner* split = new Inner;
+            inner->count = static_cast<std::uint32_t>(mid);
+            split->count = static_cast<std::uint32_t>(inner_capacity - mid);
+            for (std::size_t k = 0; k < inner_capacity; ++k)
+                inner->keys[k] = k < mid ? std::move(keys[k]) : Key {};
+            for (std::size_t k = 0; k <= inner_capacity; ++k)
+                inner->children[k] = k <= mid ? children[k] : nullptr;
+            for (std::size_t k = 0; k < split->count; ++k)
+                split->keys[k] = std::move(keys[mid + 1 + k]);
+            for (std::size_t k = 0; k <= split->count; ++k)
+                split->children[k] = children[mid + 1 + k];
+
+            separator = std::move(keys[mid]);
+            right = split;
+        }
+
+        Inner* grown = new Inner;
+        grown->count = 1;
+        grown->keys[0] = std::move(separator);
+        grown->children[0] = this->root;
+        grown->children[1] = right;
+        this->root = grown;
+    }
+
+    // the child i of inner has one key less than its minimum
+    void fix_child(Inner* inner, std::size_t i)
+    {
+        if (inner->children[i]->is_leaf)
+            this->fix_leaf(inner, i);
+        else
+            this->fix_inner(inner, i);
+    }
+
+    void fix_leaf(Inner* inner, std::size_t i)
+    {
+        Leaf* child = static_cast<Leaf*>(inner->children[i]);
+        Leaf* left = i > 0 ? static_cast<Leaf*>(inner->children[i - 1]) : nullptr;
+        Leaf* right = i < inner->count ? static_cast<Leaf*>(inner->children[i + 1]) : nullptr;
+
+        if (left != nullptr && left->count > leaf_min)
+        {
+            shift_right(child->keys, 0, child->count);
+            shift_right(child->values, 0, child->count);
+            child->keys[0] = std::move(left->keys[left->count - 1]);
+            child->values[0] = std::move(left->values[left->count - 1]);
+            left->keys[left->count - 1] = Key {};
+            left->values[left->count - 1] = T {};
+            --left->count;
+            ++child->count;
+            inner->keys[i - 1] = child->keys[0];
+        }
+        else if (right != nullptr && right->count > leaf_min)
+        {
+            child->keys[child->count] = std::move(right->keys[0]);
+            child->values[child->count] = std::move(right->values[0]);
+            ++child->count;
+            shift_left(right->keys, 0, right->count);
+            shift_left(right->values, 0, right->count);
+            --right->count;
+            inner->keys[i] = right->keys[0];
+        }
+        else
+        {
+            // the one on the right goes into the one on the left
+            if (left == nullptr)
+            {
+                left = child;
+                child = right;
+                ++i;
+            }
+            for (std::size_t k = 0; k < child->count; ++k)
+            {
+                left->keys[left->count + k] = std::move(child->keys[k]);
+                left->values[left->count + k] = std::move(child->values[k]);
+            }
+            left->count += child->count;
+            this->unlink(child);
+            delete child;
+            this->remove_child(inner, i);
+        }
+    }
+
+    void fix_inner(Inner* inner, std::size_t i)
+    {
+        Inner* child = static_cast<Inner*>(inner->children[i]);
+        Inner* left = i > 0 ? static_cast<Inner*>(inner->children[i - 1]) : nullptr;
+        Inner* right = i < inner->count ? static_cast<Inner*>(inner->children[i + 1]) : nullptr;
+
+        if (left != nullptr && left->count > inner_min)
+        {
+            shift_right(child->keys, 0, child->count);
+            shift_right(child->children, 0, child->count + 1);
+            child->keys[0] = std::move(inner->keys[i - 1]);
+            child->children[0] = left->children[left->count];
+            inner->keys[i - 1] = std::move(left->keys[left->count - 1]);
+            left->keys[left->count - 1] = Key {};
+            left->children[left->count] = nullptr;
+            --left->count;
+            ++child->count;
+        }
+        else if (right != nullptr && right->count > inner_min)
+        {
+            child->keys[child->count] = std::move(inner->keys[i]);
+            child->children[child->count + 1] = right->children[0];
+            ++child->count;
+            inner->keys[i] = std::move(right->keys[0]);
+            shift_left(right->keys, 0, right->count);
+            shift_left(right->children, 0, right->count + 1);
+            --right->count;
+        }
+        else
+        {
+            if (left == nullptr)
+            {
+                left = child;
+                child = right;
+                ++i;
+            }
+            // the separator comes down between the keys of the two
+            left->keys[left->count] = std::move(inner->keys[i - 1]);
+            for (std::size_t k = 0; k < child->count; ++k)
+                left->keys[left->count + 1 + k] = std::move(child->keys[k]);
+            for (std::size_t k = 0; k <= child->count; ++k)
+                left->children[left->count + 1 + k] = child->children[k];
+            left->count += child->count + 1;
+            delete child;
+            this->remove_child(inner, i);
+        }
+    }
+
+    // the child i and the key before it go out of inner
+    void remove_child(Inner* inner, std::size_t i)
+    {
+        shift_left(inner->keys, i - 1, inner->count);
+        shift_left(inner->children, i, inner->count + 1);
+        --inner->count;
+    }
+
+    static void destroy(Node* node)
+    {
+        if (node == nullptr)
+            return;
+        if (node->is_leaf)
+        {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (std::size_t i = 0; i <= inner->count; ++i)
+            destroy(inner->children[i]);
+        delete inner;
+    }
+
+    // the iterator at i of leaf, the start of the next leaf when i is past its end
+    template <typename Iterator, typename Map>
+    static Iterator iterator_at(Map* map, Leaf* leaf, std::size_t i)
+    {
+        if (i == leaf->count)
+            return Iterator {map, leaf->next, 0};
+        return Iterator {map, leaf, i};
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using iterator = Basic_iterator<B_tree_map, T>;
+    using const_iterator = Basic_iterator<const B_tree_map, const T>;
+
+    B_tree_map()
+        : root(nullptr), first_leaf(nullptr), last_leaf(nullptr), num_values(0) {}
+
+    B_tree_map(std::initializer_list<std::pair<Key, T>> list)
+        : B_tree_map()
+    {
+        for (const auto& pair : list)
+            this->insert(pair);
+    }
+
+    B_tree_map(const B_tree_map& source)
+        : B_tree_map()
+    {
+        this->compare = source.compare;
+        for (const auto& item : source)
+            this->insert({item.first, item.second});
+    }
+
+    B_tree_map(B_tree_map&& source) noexcept
+        : root(source.root), first_leaf(source.first_leaf), last_leaf(source.last_leaf),
+        num_values(source.num_values), compare(std::move(source.compare))
+    {
+        source.root = nullptr;
+        source.first_leaf = source.last_leaf = nullptr;
+        source.num_values = 0;
+    }
+
+    ~B_tree_map()
+    {
+        destroy(this->root);
+    }
+
+    B_tree_map& operator=(B_tree_map rhs) noexcept
+    {
+        std::swap(this->root, rhs.root);
+        std::swap(this->first_leaf, rhs.first_leaf);
+        std::swap(this->last_leaf, rhs.last_leaf);
+        std::swap(this->num_values, rhs.num_values);
+        std::swap(this->compare, rhs.compare);
+        return *this;
+    }
+
+    iterator begin() { return {this, this->first_leaf, 0}; }
+    iterator end() { return {this, nullptr, 0}; }
+    const_iterator begin() const { return {this, this->first_leaf, 0}; }
+    const_iterator end() const { return {this, nullptr, 0}; }
+    const_iterator cbegin() const { return this->begin(); }
+    const_iterator cend() const { return this->end(); }
+
+    std::size_t size() const { return this->num_values; }
+    bool empty() const { return this->num_values == 0; }
+
+    void clear()
+    {
+        destroy(this->root);
+        this->root = nullptr;
+        this->first_leaf = this->last_leaf = nullptr;
+        this->num_values = 0;
+    }
+
+    iterator lower_bound(const Key& key)
+    {
+        if (this->root == nullptr)
+            return this->end();
+        Leaf* leaf = this->find_leaf(key, nullptr);
+        return iterator_at<iterator>(this, leaf, this->lower_in(leaf->keys, leaf->count, key));
+    }
+
+    const_iterator lower_bound(const Key& key) const
+    {
+        return const_cast<B_tree_map*>(this)->lower_bound(key);
+    }
+
+    iterator upper_bound(const Key& key)
+    {
+        if (this->root == nullptr)
+            return this->end();
+        Leaf* leaf = this->find_leaf(key, nullptr);
+        return iterator_at<iterator>(this, leaf, this->upper_in(leaf->keys, leaf->count, key));
+    }
+
+    const_iterator upper_bound(const Key& key) const
+    {
+        return const_cast<B_tree_map*>(this)->upper_bound(key);
+    }
+
+    iterator find(const Key& key)
+    {
+        if (this->root == nullptr)
+            return this->end();
+        Leaf* leaf = this->find_leaf(key, nullptr);
+        const std::size_t i = this->lower_in(leaf->keys, leaf->count, key);
+        if (i == leaf->count || this->compare(key, leaf->keys[i]))
+            return this->end();
+        return {this, leaf, i};
+    }
+
+    const_iterator find(const Key& key) const
+    {
+        return const_cast<B_tree_map*>(this)->find(key);
+    }
+
+    bool contains(const Key& key) const { return this->find(key) != this->end(); }
+    std::size_t count(const Key& key) const { return this->contains(key) ? 1 : 0; }
+
+    T& at(const Key& key)
+    {
+        iterator it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range {"B_tree_map::at"};
+        return it.leaf->values[it.i];
+    }
+
+    const T& at(const Key& key) const
+    {
+        return const_cast<B_tree_map*>(this)->at(key);
+    }
+
+    // like std::map::insert, the pair is not added when the key is there
+    std::pair<iterator, bool> insert(std::pair<Key, T> pair)
+    {
+        if (this->root == nullptr)
+            this->root = this->first_leaf = this->last_leaf = new Leaf;
+
+        Path path;
+        Leaf* leaf = this->find_leaf(pair.first, &path);
+        std::size_t i = this->lower_in(leaf->keys, leaf->count, pair.first);
+        if (i < leaf->count && !this->compare(pair.first, leaf->keys[i]))
+            return {iterator {this, leaf, i}, false};
+
+        ++this->num_values;
+        if (leaf->count < leaf_capacity)
+        {
+            shift_right(leaf->keys, i, leaf->count);
+            shift_right(leaf->values, i, leaf->count);
+            leaf->keys[i] = std::move(pair.first);
+            leaf->values[i] = std::move(pair.second);
+            ++leaf->count;
+            return {iterator {this, leaf, i}, true};
+        }
+
+        // the upper half goes to a new leaf, then the pair goes into the half it belongs to
+        const std::size_t half = leaf_capacity / 2;
+        Leaf* right = new Leaf;
+        for (std::size_t k = half; k < leaf_capacity; ++k)
+        {
+            right->keys[k - half] = std::move(leaf->keys[k]);
+            right->values[k - half] = std::move(leaf->values[k]);
+            leaf->keys[k] = Key {};
+            leaf->values[k] = T {};
+        }
+        leaf->count = static_cast<std::uint32_t>(half);
+        right->count = static_cast<std::uint32_t>(leaf_capacity - half);
+        this->link_after(leaf, right);
+
+        Leaf* target = leaf;
+        if (i > half)
+        {
+            target = right;
+            i -= half;
+        }
+        shift_right(target->keys, i, target->count);
+        shift_right(target->values, i, target->count);
+        target->keys[i] = std::move(pair.first);
+        target->values[i] = std::move(pair.second);
+        ++target->count;
+
+        this->insert_up(path, right->keys[0], right);
+        return {iterator {this, target, i}, true};
+    }
+
+    // the value is replaced when the key is there
+    std::pair<iterator, bool> insert_or_assign(const Key& key, T value)
+    {
+        auto result = this->insert({key, T {}});
+        result.first.leaf->values[result.first.i] = std::move(value);
+        return result;
+    }
+
+    T& operator[](const Key& key)
+    {
+        iterator it = this->insert({key, T {}}).first;
+        return it.leaf->values[it.i];
+    }
+
+    std::size_t erase(const Key& key)
+    {
+        if (this->root == nullptr)
+            return 0;
+
+        Path path;
+        Leaf* leaf = this->find_leaf(key, &path);
+        const std::size_t i = this->lower_in(leaf->keys, leaf->count, key);
+        if (i == leaf->count || this->compare(key, leaf->keys[i]))
+            return 0;
+
+        shift_left(leaf->keys, i, leaf->count);
+        shift_left(leaf->values, i, leaf->count);
+        --leaf->count;
+        if (--this->num_values == 0)
+        {
+            this->clear();
+            return 1;
+        }
+
+        // up while a node is under its minimum
+        Node* node = leaf;
+        while (path.depth > 0 && node->count < (node->is_leaf ? leaf_min : inner_min))
+        {
+            Inner* parent = path.nodes[--path.depth];
+            this->fix_child(parent, path.children[path.depth]);
+            node = parent;
+        }
+
+        if (!this->root->is_leaf && this->root->count == 0)
+        {
+            Inner* old = static_cast<Inner*>(this->root);
+            this->root = old->children[0];
+            delete old;
+        }
+        return 1;
+    }
+
+    // the iterator after the erased value
+    iterator erase(const_iterator it)
+    {
+        const Key key = it.leaf->keys[it.i];
+        this->erase(key);
+        return this->upper_bound(key);
+    }
+};
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef _FLAT_MAP_H_
+#define _FLAT_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Flat_map keeps its keys sorted in one vector and the values in another one, in the
+      same order, a lookup is a binary search of the keys only, so it reads a few cache
+      lines of keys and then one value, and iterating walks two arrays, no nodes.
+
+    - built from many pairs it sorts them and drops the duplicate keys once, the first pair
+      of a key is kept like std::map does, an insert or an erase of one key moves the ones
+      after it, O(n), it is for tables that are read a lot more than they change.
+
+    - lower_bound halves the range without a branch on the compare, the next half is
+      picked with a conditional move, so it does not mispredict.
+
+    - an iterator gives a std::pair of references, to the key and to its value, so
+      item.first and item.second work like with a std::map, it->first works too. an insert
+      or an erase invalidates the iterators.
+
+*/
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class Flat_map
+{
+private:
+    std::vector<Key> keys;
+    std::vector<T> values;
+    Compare compare;
+
+    template <typename Map, typename Value>
+    class Basic_iterator
+    {
+        friend class Flat_map;
+
+    private:
+        Map* map;
+        std::size_t i;
+
+        Basic_iterator(Map* map, std::size_t i)
+            : map(map), i(i) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, Value&>;
+
+        // it-> has to return something that has a ->, the pair of references is kept in it
+        struct pointer
+        {
+            reference pair;
+            const reference* operator->() const { return &this->pair; }
+        };
+
+        Basic_iterator()
+            : map(nullptr), i(0) {}
+
+        // an iterator converts to a const_iterator
+        template <typename Other_map, typename Other_value>
+        Basic_iterator(const Basic_iterator<Other_map, Other_value>& other)
+            : map(other.map), i(other.i) {}
+
+        reference operator*() const { return {this->map->keys[this->i], this->map->values[this->i]}; }
+        pointer operator->() const { return pointer {**this}; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        Basic_iterator& operator++() { ++this->i; return *this; }
+        Basic_iterator& operator--() { --this->i; return *this; }
+        Basic_iterator operator++(int) { Basic_iterator old = *this; ++this->i; return old; }
+        Basic_iterator operator--(int) { Basic_iterator old = *this; --this->i; return old; }
+        Basic_iterator& operator+=(difference_type n) { this->i += n; return *this; }
+        Basic_iterator& operator-=(difference_type n) { this->i -= n; return *this; }
+        Basic_iterator operator+(difference_type n) const { return {this->map, this->i + n}; }
+        Basic_iterator operator-(difference_type n) const { return {this->map, this->i - n}; }
+        difference_type operator-(const Basic_iterator& rhs) const
+        {
+            return static_cast<difference_type>(this->i) - static_cast<difference_type>(rhs.i);
+        }
+
+        bool operator==(const Basic_iterator& rhs) const { return this->i == rhs.i; }
+        bool operator!=(const Basic_iterator& rhs) const { return this->i != rhs.i; }
+        bool operator<(const Basic_iterator& rhs) const { return this->i < rhs.i; }
+        bool operator>(const Basic_iterator& rhs) const { return this->i > rhs.i; }
+        bool operator<=(const Basic_iterator& rhs) const { return this->i <= rhs.i; }
+        bool operator>=(const Basic_iterator& rhs) const { return this->i >= rhs.i; }
+
+        template <typename, typename>
+        friend class Basic_iterator;
+    };
+
+    std::size_t lower_index(const Key& key) const
+    {
+        const Key* first = this->keys.data();
+        std::size_t length = this->keys.size();
+        if (length == 0)
+            return 0;
+        while (length > 1)
+        {
+            const std::size_t half = length / 2;
+            first = this->compare(first[half - 1], key) ? first + half : first;
+            length -= half;
+        }
+        return static_cast<std::size_t>(first - this->keys.data()) + this->compare(*first, key);
+    }
+
+    bool is_key_at(std::size_t i, const Key& key) const
+    {
+        return i < this->keys.size() && !this->compare(key, this->keys[i]);
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using iterator = Basic_iterator<Flat_map, T>;
+    using const_iterator = Basic_iterator<const Flat_map, const T>;
+
+    Flat_map() = default;
+
+    // sorts the pairs by key once, a stable sort, so the first pair of a key is kept
+    explicit Flat_map(std::vector<std::pair<Key, T>> pairs, const Compare& compare = Compare {})
+        : compare(compare)
+    {
+        std::vector<std::size_t> order(pairs.size());
+        std::iota(order.begin(), order.end(), std::size_t {0});
+        std::stable_sort(order.begin(), order.end(), [&pairs, &compare](std::size_t a, std::size_t b)
+        {
+            return compare(pairs[a].first, pairs[b].first);
+        });
+
+        this->keys.reserve(pairs.size());
+        this->values.reserve(pairs.size());
+        for (std::size_t i : order)
+        {
+            if (!this->keys.empty() && !this->compare(this->keys.back(), pairs[i].first))
+                continue;
+            this->keys.push_back(std::move(pairs[i].first));
+            this->values.push_back(std::move(pairs[i].second));
+        }
+    }
+
+    Flat_map(std::initializer_list<std::pair<Key, T>> list, const Compare& compare = Compare {})
+        : Flat_map(std::vector<std::pair<Key, T>>(list), compare) {}
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, this->keys.size()}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, this->keys.size()}; }
+    const_iterator cbegin() const { return {this, 0}; }
+    const_iterator cend() const { return {this, this->keys.size()}; }
+
+    std::size_t size() const { return this->keys.size(); }
+    bool empty() const { return this->keys.empty(); }
+
+    void clear()
+    {
+        this->keys.clear();
+        this->values.clear();
+    }
+
+    void reserve(std::size_t n)
+    {
+        this->keys.reserve(n);
+        this->values.reserve(n);
+    }
+
+    // the keys and the values in order, for a scan that needs only one of them
+    const std::vector<Key>& get_keys() const { return this->keys; }
+    const std::vector<T>& get_values() const { return this->values; }
+
+    iterator lower_bound(const Key& key) { return {this, this->lower_index(key)}; }
+    const_iterator lower_bound(const Key& key) const { return {this, this->lower_index(key)}; }
+
+    iterator upper_bound(const Key& key)
+    {
+        const std::size_t i = this->lower_index(key);
+        return {this, this->is_key_at(i, key) ? i + 1 : i};
+    }
+
+    const_iterator upper_bound(const Key& key) const
+    {
+        const std::size_t i = this->lower_index(key);
+        return {this, this->is_key_at(i, key) ? i + 1 : i};
+    }
+
+    iterator find(const Key& key)
+    {
+        const std::size_t i = this->lower_index(key);
+        return this->is_key_at(i, key) ? iterator {this, i} : this->end();
+    }
+
+    const_iterator find(const Key& key) const
+    {
+        const std::size_t i = this->lower_index(key);
+        return this->is_key_at(i, key) ? const_iterator {this, i} : this->end();
+    }
+
+    bool contains(const Key& key) const { return this->is_key_at(this->lower_index(key), key); }
+    std::size_t count(const Key& key) const { return this->contains(key) ? 1 : 0; }
+
+    T& at(const Key& key)
+    {
+        const std::size_t i = this->lower_index(key);
+        if (!this->is_key_at(i, key))
+            throw std::out_of_range {"Flat_map::at"};
+        return this->values[i];
+    }
+
+    const T& at(const Key& key) const
+    {
+        const std::size_t i = this->lower_index(key);
+        if (!this->is_key_at(i, key))
+            throw std::out_of_range {"Flat_map::at"};
+        return this->values[i];
+    }
+
+    // like std::map::insert, the pair is not added when the key is there
+    std::pair<iterator, bool> insert(std::pair<Key, T> pair)
+    {
+        const std::size_t i = this->lower_index(pair.first);
+        if (this->is_key_at(i, pair.first))
+            return {iterator {this, i}, false};
+        this->keys.insert(this->keys.begin() + i, std::move(pair.first));
+        this->values.insert(this->values.begin() + i, std::move(pair.second));
+        return {iterator {this, i}, true};
+    }
+
+    T& operator[](const Key& key)
+    {
+        const std::size_t i = this->lower_index(key);
+        if (!this->is_key_at(i, key))
+        {
+            this->keys.insert(this->keys.begin() + i, key);
+            this->values.insert(this->values.begin() + i, T {});
+        }
+        return this->values[i];
+    }
+
+    std::size_t erase(const Key& key)
+    {
+        const std::size_t i = this->lower_index(key);
+        if (!this->is_key_at(i, key))
+            return 0;
+        this->keys.erase(this->keys.begin() + i);
+        this->values.erase(this->values.begin() + i);
+        return 1;
+    }
+
+    iterator erase(const_iterator it)
+    {
+        this->keys.erase(this->keys.begin() + it.i);
+        this->values.erase(this->values.begin() + it.i);
+        return {this, it.i};
+    }
+};
+
+#endif
@@ -0,0 +1,490 @@
+#ifndef _SWISS_MAP_H_
+#define _SWISS_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - a Swiss_map is a hash map like std::unordered_map laid out like the swiss tables of
+      abseil: the slots are in one array, in groups of 16, and every slot has a control byte
+      in another array, empty, erased, or the low 7 bits of the hash of its key. a lookup
+      compares the 7 bits with the 16 control bytes of a group at once, with SSE2 when there
+      is SSE2, and compares keys only where they match, about one key per lookup.
+
+    - the groups are probed one after the other by a growing step, a lookup stops at the
+      first group with an empty slot. an erase leaves an erased byte only when the group is
+      full, the next rehash drops them. the table is at most 7 / 8 full.
+
+    - the hash and the equality are transparent for a std::string key, Swiss_hash of
+      std::string hashes a std::string_view and std::equal_to<> compares a std::string with
+      anything it can be compared with, so find, count, contains, at, erase and operator[]
+      take a std::string_view or a const char* and make no std::string, operator[] makes one
+      only when the key is new.
+
+    - an iterator gives a std::pair of references like the one of Flat_map, item.first and
+      it->second work like with a std::map. an insert can rehash and invalidate them, an
+      erase does not.
+
+*/
+template <typename Key>
+struct Swiss_hash : std::hash<Key> {};
+
+template <>
+struct Swiss_hash<std::string>
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const
+    {
+        return std::hash<std::string_view> {}(key);
+    }
+};
+
+template <typename Key, typename T, typename Hash = Swiss_hash<Key>, typename Equal = std::equal_to<>>
+class Swiss_map
+{
+private:
+    static constexpr std::size_t group_size = 16;
+    static constexpr std::int8_t empty_byte = -128;
+    static constexpr std::int8_t erased_byte = -2;
+
+    struct Slot
+    {
+        Key key;
+        T value;
+    };
+
+    std::unique_ptr<std::int8_t[]> control;
+    Slot* slots;
+    std::size_t capacity;     // a power of 2, 0 or at least group_size
+    std::size_t num_values;
+    std::size_t growth_left;  // the slots that can be filled before a rehash
+    Hash hash;
+    Equal equal;
+
+    template <typename F, typename = void>
+    struct Is_transparent : std::false_type {};
+
+    template <typename F>
+    struct Is_transparent<F, std::void_t<typename F::is_transparent>> : std::true_type {};
+
+    // a lookup by another type than Key needs both of them to take it
+    template <typename K>
+    using if_transparent = std::enable_if_t<std::is_same_v<K, Key> || (Is_transparent<Hash>::value && Is_transparent<Equal>::value)>;
+
+    // a bit per slot of the group at i whose control byte is byte, or that is empty or erased
+    std::uint32_t match(std::size_t i, std::int8_t byte) const
+    {
+#if defined(__SSE2__)
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(this->control.get() + i));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte))));
+#else
+        std::uint32_t bits = 0;
+        for (std::size_t k = 0; k < group_size; ++k)
+            bits |= static_cast<std::uint32_t>(this->control[i + k] == byte) << k;
+        return bits;
+#endif
+    }
+
+    std::uint32_t match_free(std::size_t i) const
+    {
+#if defined(__SSE2__)
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(this->control.get() + i));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(group));
+#else
+        std::uint32_t bits = 0;
+        for (std::size_t k = 0; k < group_size; ++k)
+            bits |= static_cast<std::uint32_t>(this->control[i + k] < 0) << k;
+        return bits;
+#endif
+    }
+
+    static unsigned lowest_bit(std::uint32_t bits)
+    {
+        return static_cast<unsigned>(__builtin_ctz(bits));
+    }
+
+    // std::hash of an integer is the integer, the bits are mixed so both halves are random
+    template <typename K>
+    std::uint64_t hash_of(const K& key) const
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(this->hash(key)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+
+    static std::int8_t byte_of(std::uint64_t h) { return static_cast<std::int8_t>(h & 0x7F); }
+
+    // the slot of the key, or capacity when it is not there
+    template <typename K>
+    std::size_t find_index(const K& key, std::uint64_t h) const
+    {
+        if (this->capacity == 0)
+            return 0;
+        const std::size_t mask = this->capacity - 1;
+        std::size_t i = (h >> 7) * group_size & mask;
+        for (std::size_t step = group_size;; step += group_size)
+        {
+            for (std::uint32_t bits = this->match(i, byte_of(h)); bits != 0; bits &= bits - 1)
+            {
+                const std::size_t slot = i + lowest_bit(bits);
+                if (this->equal(this->slots[slot].key, key))
+                    return slot;
+            }
+            if (this->match(i, empty_byte) != 0)
+                return this->capacity;
+            i = (i + step) & mask;
+        }
+    }
+
+    // the first empty or erased slot of the probe sequence of h, there is one
+    std::size_t free_index(std::uint64_t h) const
+    {
+        const std::size_t mask = this->capacity - 1;
+        std::size_t i = (h >> 7) * group_size & mask;
+        for (std::size_t step = group_size;; step += group_size)
+        {
+            const std::uint32_t bits = this->match_free(i);
+            if (bits != 0)
+                return i + lowest_bit(bits);
+            i = (i + step) & mask;
+        }
+    }
+
+    void allocate(std::size_t capacity)
+    {
+        this->capacity = capacity;
+        this->control.reset(new std::int8_t[capacity]);
+        std::memset(this->control.get(), empty_byte, capacity);
+        this->slots = std::allocator<Slot> {}.allocate(capacity);
+        this->growth_left = capacity - capacity / 8;
+    }
+
+    void destroy()
+    {
+        for (std::size_t i = 0; i < this->capacity; ++i)
+            if (this->control[i] >= 0)
+                this->slots[i].~Slot();
+        if (this->slots != nullptr)
+            std::allocator<Slot> {}.deallocate(this->slots, this->capacity);
+        this->slots = nullptr;
+        this->control.reset();
+        this->capacity = this->num_values = this->growth_left = 0;
+    }
+
+    // twice the capacity, or the same one when a lot of it is erased slots
+    void rehash(std::size_t capacity)
+    {
+        std::unique_ptr<std::int8_t[]> old_control = std::move(this->control);
+        Slot* old_slots = this->slots;
+        const std::size_t old_capacity = this->capacity;
+
+        this->allocate(capacity);
+        for (std::size_t i = 0; i < old_capacity; ++i)
+            if (old_control[i] >= 0)
+            {
+                const std::size_t slot = this->free_index(this->hash_of(old_slots[i].key));
+                this->control[slot] = old_control[i];
+                ::new (static_cast<void*>(this->slots + slot)) Slot {std::move(old_slots[i].key), std::move(old_slots[i].value)};
+                old_slots[i].~Slot();
+            }
+        this->growth_left -= this->num_values;
+        if (old_slots != nullptr)
+            std::allocator<Slot> {}.deallocate(old_slots, old_capacity);
+    }
+
+    // the slot for a new key of hash h, found not to be there
+    std::size_t new_index(std::uint64_t h)
+    {
+        if (this->growth_left == 0)
+        {
+            if (this->capacity == 0)
+                this->rehash(group_size);
+            else
+                this->rehash(this->num_values * 2 < this->capacity ? this->capacity : this->capacity * 2);
+        }
+        const std::size_t slot = this->free_index(h);
+        if (this->control[slot] == empty_byte)
+            --this->growth_left;
+        this->control[slot] = byte_of(h);
+        ++this->num_values;
+        return slot;
+    }
+
+    template <typename K, typename... Args>
+    std::pair<std::size_t, bool> emplace_index(K&& key, Args&&... args)
+    {
+        const std::uint64_t h = this->hash_of(key);
+        const std::size_t found = this->find_index(key, h);
+        if (found != this->capacity)
+            return {found, false};
+        const std::size_t slot = this->new_index(h);
+        ::new (static_cast<void*>(this->slots + slot)) Slot {Key(std::forward<K>(key)), T(std::forward<Args>(args)...)};
+        return {slot, true};
+    }
+
+    void erase_index(std::size_t slot)
+    {
+        this->slots[slot].~Slot();
+        --this->num_values;
+        // a group that has an empty slot ends every lookup that gets to it, the slot can be empty too
+        const std::size_t group = slot & ~(group_size - 1);
+        if (this->match(group, empty_byte) != 0)
+        {
+            this->control[slot] = empty_byte;
+            ++this->growth_left;
+        }
+        else
+            this->control[slot] = erased_byte;
+    }
+
+    template <typename Map, typename Value>
+    class Basic_iterator
+    {
+        friend class Swiss_map;
+
+    private:
+        Map* map;
+        std::size_t i;
+
+        Basic_iterator(Map* map, std::size_t i)
+            : map(map), i(i) {}
+
+        void skip_free()
+        {
+            while (this->i < this->map->capacity && this->map->control[this->i] < 0)
+                ++this->i;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, Value&>;
+
+        // it-> has to return something that has a ->, the pair of references is kept in it
+        struct pointer
+        {
+            reference pair;
+            const reference* operator->() const { return &this->pair; }
+        };
+
+        Basic_iterator()
+            : map(nullptr), i(0) {}
+
+        // an iterator converts to a const_iterator
+        template <typename Other_map, typename Other_value>
+        Basic_iterator(const Basic_iterator<Other_map, Other_value>& other)
+            : map(other.map), i(other.i) {}
+
+        reference operator*() const { return {this->map->slots[this->i].key, this->map->slots[this->i].value}; }
+        pointer operator->() const { return pointer {**this}; }
+
+        Basic_iterator& operator++()
+        {
+            ++this->i;
+            this->skip_free();
+            return *this;
+        }
+
+        Basic_iterator operator++(int)
+        {
+            Basic_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Basic_iterator& rhs) const { return this->i == rhs.i; }
+        bool operator!=(const Basic_iterator& rhs) const { return this->i != rhs.i; }
+
+        template <typename, typename>
+        friend class Basic_iterator;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using iterator = Basic_iterator<Swiss_map, T>;
+    using const_iterator = Basic_iterator<const Swiss_map, const T>;
+
+    Swiss_map()
+        : slots(nullptr), capacity(0), num_values(0), growth_left(0) {}
+
+    Swiss_map(const Swiss_map& source)
+        : Swiss_map()
+    {
+        this->reserve(source.size());
+        for (const auto& item : source)
+            this->emplace_index(item.first, item.second);
+    }
+
+    Swiss_map(Swiss_map&& source) noexcept
+        : control(std::move(source.control)), slots(source.slots), capacity(source.capacity),
+          num_values(source.num_values), growth_left(source.growth_left), hash(source.hash), equal(source.equal)
+    {
+        source.slots = nullptr;
+        source.capacity = source.num_values = source.growth_left = 0;
+    }
+
+    Swiss_map& operator=(Swiss_map rhs) noexcept
+    {
+        std::swap(this->control, rhs.control);
+        std::swap(this->slots, rhs.slots);
+        std::swap(this->capacity, rhs.capacity);
+        std::swap(this->num_values, rhs.num_values);
+        std::swap(this->growth_left, rhs.growth_left);
+        return *this;
+    }
+
+    ~Swiss_map()
+    {
+        this->destroy();
+    }
+
+    iterator begin()
+    {
+        iterator it {this, 0};
+        it.skip_free();
+        return it;
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it {this, 0};
+        it.skip_free();
+        return it;
+    }
+
+    iterator end() { return {this, this->capacity}; }
+    const_iterator end() const { return {this, this->capacity}; }
+    const_iterator cbegin() const { return this->begin(); }
+    const_iterator cend() const { return this->end(); }
+
+    std::size_t size() const { return this->num_values; }
+    bool empty() const { return this->num_values == 0; }
+    std::size_t bucket_count() const { return this->capacity; }
+
+    void clear()
+    {
+        this->destroy();
+    }
+
+    // room for n keys without a rehash
+    void reserve(std::size_t n)
+    {
+        std::size_t capacity = group_size;
+        while (capacity - capacity / 8 < n)
+            capacity *= 2;
+        if (capacity > this->capacity)
+            this->rehash(capacity);
+    }
+
+    template <typename K, typename = if_transparent<K>>
+    iterator find(const K& key)
+    {
+        const std::size_t slot = this->find_index(key, this->hash_of(key));
+        return {this, slot};
+    }
+
+    template <typename K, typename = if_transparent<K>>
+    const_iterator find(const K& key) const
+    {
+        const std::size_t slot = this->find_index(key, this->hash_of(key));
+        return {this, slot};
+    }
+
+    iterator find(const Key& key) { return this->find<Key>(key); }
+    const_iterator find(const Key& key) const { return this->find<Key>(key); }
+
+    template <typename K, typename = if_transparent<K>>
+    bool contains(const K& key) const { return this->find_index(key, this->hash_of(key)) != this->capacity; }
+
+    bool contains(const Key& key) const { return this->contains<Key>(key); }
+
+    template <typename K, typename = if_transparent<K>>
+    std::size_t count(const K& key) const { return this->contains(key) ? 1 : 0; }
+
+    std::size_t count(const Key& key) const { return this->contains<Key>(key) ? 1 : 0; }
+
+    template <typename K, typename = if_transparent<K>>
+    T& at(const K& key)
+    {
+        const std::size_t slot = this->find_index(key, this->hash_of(key));
+        if (slot == this->capacity)
+            throw std::out_of_range {"Swiss_map::at"};
+        return this->slots[slot].value;
+    }
+
+    template <typename K, typename = if_transparent<K>>
+    const T& at(const K& key) const
+    {
+        return const_cast<Swiss_map*>(this)->at(key);
+    }
+
+    T& at(const Key& key) { return this->at<Key>(key); }
+    const T& at(const Key& key) const { return this->at<Key>(key); }
+
+    // the Key is made from key only when it is not there, a std::string from a std::string_view
+    // the slots are read after the insert, it can rehash
+    template <typename K, typename = if_transparent<std::decay_t<K>>>
+    T& operator[](K&& key)
+    {
+        const std::size_t slot = this->emplace_index(std::forward<K>(key)).first;
+        return this->slots[slot].value;
+    }
+
+    T& operator[](const Key& key) { return this->operator[]<const Key&>(key); }
+    T& operator[](Key&& key) { return this->operator[]<Key>(std::move(key)); }
+
+    // like std::map::try_emplace, nothing is made when the key is there
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        const auto [slot, inserted] = this->emplace_index(std::forward<K>(key), std::forward<Args>(args)...);
+        return {iterator {this, slot}, inserted};
+    }
+
+    std::pair<iterator, bool> insert(std::pair<Key, T> pair)
+    {
+        return this->try_emplace(std::move(pair.first), std::move(pair.second));
+    }
+
+    template <typename K, typename = if_transparent<K>>
+    std::size_t erase(const K& key)
+    {
+        const std::size_t slot = this->find_index(key, this->hash_of(key));
+        if (slot == this->capacity)
+            return 0;
+        this->erase_index(slot);
+        return 1;
+    }
+
+    std::size_t erase(const Key& key) { return this->erase<Key>(key); }
+
+    iterator erase(const_iterator it)
+    {
+        this->erase_index(it.i);
+        iterator next {this, it.i};
+        ++next;
+        return next;
+    }
+
+    // an iterator would be taken by the erase of a key otherwise
+    iterator erase(iterator it) { return this->erase(const_iterator {it}); }
+};
+
+#endif
@@ -1,6 +1,11 @@
 #include <iostream>
 #include <map>
 #include <set>
+#include <string>
+#include <string_view>
+#include "B_tree_map.h"
+#include "Flat_map.h"
+#include "Swiss_map.h"
 
 void display(const std::map<std::string, std::set<int>>& m)
 {
@@ -24,6 +29,24 @@ void display(const std::map<T1, T2>& m)
     std::cout << "]" << std::endl;
 }
 
+template <typename T1, typename T2>
+void display(const Flat_map<T1, T2>& m)
+{
+    std::cout << "[ ";
+    for (const auto& item : m)
+        std::cout << item.first << ":" << item.second << " ";
+    std::cout << "]" << std::endl;
+}
+
+template <typename T1, typename T2>
+void display(const B_tree_map<T1, T2>& m)
+{
+    std::cout << "[ ";
+    for (const auto& item : m)
+        std::cout << item.first << ":" << item.second << " ";
+    std::cout << "]" << std::endl;
+}
+
 void test1()
 {
     std::cout << std::endl << "test1=====================" << std::endl;
@@ -84,10 +107,98 @@ void test2()
     std::cout << std::endl;
 }
 
+void test3()
+{
+    std::cout << std::endl << "test3=====================" << std::endl;
+
+    // sorted once, the second Larry is dropped like std::map does
+    Flat_map<std::string, int> m {{"Larry", 3},
+        {"Moe", 1},
+        {"Curly", 2},
+        {"Larry", 30}};
+
+    display(m);
+
+    m["Frank"] = 18;
+    m["Frank"] += 10;
+    display(m);
+
+    m.erase("Moe");
+    display(m);
+
+    auto it = m.find("Larry");
+    if (it != m.end())
+        std::cout << "Found: " << it->first << ":" << it->second << std::endl;
+
+    std::cout << "First from C: " << m.lower_bound("C")->first << std::endl;
+
+    std::cout << std::endl;
+}
+
+void test4()
+{
+    std::cout << std::endl << "test4=====================" << std::endl;
+
+    B_tree_map<std::string, int> m {{"Larry", 3},
+        {"Moe", 1},
+        {"Curly", 2}};
+
+    display(m);
+
+    m.insert(std::make_pair("Joe", 5));
+    m["Frank"] = 18;
+    m["Frank"] += 10;
+    display(m);
+
+    m.erase("Frank");
+    display(m);
+
+    std::cout << "Count for joe: " << m.count("Joe") << std::endl;
+
+    // a range scan walks the leaves from the first key not before "J"
+    std::cout << "From J: ";
+    for (auto it = m.lower_bound("J"); it != m.end(); ++it)
+        std::cout << it->first << ":" << it->second << " ";
+    std::cout << std::endl;
+
+    std::cout << std::endl;
+}
+
+void test5()
+{
+    std::cout << std::endl << "test5=====================" << std::endl;
+
+    // the words are views into the text, a std::string is made only for a new word
+    const std::string_view text {"the larry and the moe and the curly"};
+    Swiss_map<std::string, int> words;
+    for (std::size_t start = 0; start < text.size();)
+    {
+        std::size_t end = text.find(' ', start);
+        if (end == std::string_view::npos)
+            end = text.size();
+        words[text.substr(start, end - start)]++;
+        start = end + 1;
+    }
+
+    std::cout << "Words: " << words.size() << std::endl;
+    for (const char* word : {"the", "and", "moe", "frank"})
+        std::cout << word << ": " << words.count(word) << " " << (words.contains(word) ? words.at(word) : 0) << std::endl;
+
+    words.erase("and");
+    auto it = words.find(std::string_view {"curly"});
+    if (it != words.end())
+        std::cout << "Found: " << it->first << ":" << it->second << ", size: " << words.size() << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
     test2();
+    test3();
+    test4();
+    test5();
 
     return 0;
 }
@@ -0,0 +1,210 @@
+/*
+
+    - compares std::map<std::uint64_t, std::uint64_t> against B_tree_map (../map/B_tree_map.h)
+      with 256 byte and 4096 byte nodes: inserting random keys, finding all of them in
+      another order, range scans of 100 keys from random places and erasing half of them,
+      and checks that every map gives the same sums.
+
+    - Flat_map (../map/Flat_map.h) is built from the same keys in one go and only finds,
+      it has no cheap inserts and erases.
+
+    - then counts the words of ../challengeThree/romeoAndJuliet.txt, read 1000 times, with
+      words[word]++ in a std::map<std::string, int> and a std::unordered_map, which make a
+      std::string of every word for the lookup, and in a Swiss_map (../map/Swiss_map.h),
+      which looks the std::string_view up as it is, and checks the counts.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - 10'000'000 keys by default, the number can be given on the command line, e.g.
+      ./a.out 1000000
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../map/B_tree_map.h"
+#include "../map/Flat_map.h"
+#include "../map/Swiss_map.h"
+
+constexpr std::size_t num_scans {100'000};
+constexpr std::size_t scan_length {100};
+
+struct Times
+{
+    double insert;
+    double find;
+    double scan;
+    double erase;
+    std::uint64_t sum;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Map>
+Times run(const std::vector<std::uint64_t>& keys, const std::vector<std::uint64_t>& order,
+    const std::vector<std::uint64_t>& starts)
+{
+    Times times {};
+    Map map;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t key : keys)
+        map.insert({key, key * 3});
+    times.insert = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t key : order)
+        times.sum += map.find(key)->second;
+    times.find = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t from : starts)
+    {
+        auto it = map.lower_bound(from);
+        for (std::size_t i = 0; i < scan_length && it != map.end(); ++i, ++it)
+            times.sum += it->first;
+    }
+    times.scan = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < order.size(); i += 2)
+        times.sum += map.erase(order[i]);
+    times.erase = seconds_since(start);
+
+    times.sum += map.size();
+    return times;
+}
+
+void print(const std::string& name, const Times& times, std::size_t num_keys)
+{
+    std::cout << std::setw(22) << std::left << name << std::fixed << std::setprecision(1)
+        << std::setw(12) << std::right << times.insert * 1e9 / num_keys
+        << std::setw(12) << times.find * 1e9 / num_keys
+        << std::setw(12) << times.scan * 1e9 / num_scans
+        << std::setw(12) << times.erase * 1e9 / (num_keys / 2)
+        << "    " << times.sum << std::endl;
+}
+
+constexpr std::size_t text_repeats {1000};
+
+// the words split on whitespace with the punctuation of clean_string dropped, views into text
+std::vector<std::string_view> split_words(const std::string& text)
+{
+    std::vector<std::string_view> words;
+    std::size_t i = 0;
+    while (i < text.size())
+    {
+        while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i])))
+            ++i;
+        std::size_t end = i;
+        while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])))
+            ++end;
+        std::size_t first = i, last = end;
+        while (first < last && std::string_view {".,;:!?"}.find(text[first]) != std::string_view::npos)
+            ++first;
+        while (last > first && std::string_view {".,;:!?"}.find(text[last - 1]) != std::string_view::npos)
+            --last;
+        if (end > i)
+            words.emplace_back(text.data() + first, last - first);
+        i = end;
+    }
+    return words;
+}
+
+// words[word]++ for every word text_repeats times, the sum of squares of the counts checks them
+template <typename Map, typename Key>
+void count_words(const std::string& name, const std::vector<std::string_view>& words)
+{
+    Map map;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t repeat = 0; repeat < text_repeats; ++repeat)
+        for (std::string_view word : words)
+            map[Key(word)]++;
+    const double seconds = seconds_since(start);
+
+    std::uint64_t sum {0};
+    for (const auto& item : map)
+        sum += static_cast<std::uint64_t>(item.second) * item.second;
+    std::cout << std::setw(22) << std::left << name << std::fixed << std::setprecision(1)
+        << std::setw(12) << std::right << seconds * 1e9 / (words.size() * text_repeats)
+        << "    " << map.size() << " " << sum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num_keys = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10'000'000;
+
+    std::mt19937_64 random {42};
+    std::vector<std::uint64_t> keys(num_keys);
+    for (std::uint64_t& key : keys)
+        key = random();
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<std::uint64_t> order = keys;
+    std::shuffle(order.begin(), order.end(), random);
+    std::shuffle(keys.begin(), keys.end(), random);
+    std::vector<std::uint64_t> starts(num_scans);
+    for (std::uint64_t& from : starts)
+        from = random();
+
+    std::cout << keys.size() << " keys, ns per insert, find, scan of " << scan_length << ", erase" << std::endl;
+    print("std::map", run<std::map<std::uint64_t, std::uint64_t>>(keys, order, starts), keys.size());
+    print("B_tree_map<256>", run<B_tree_map<std::uint64_t, std::uint64_t, 256>>(keys, order, starts), keys.size());
+    print("B_tree_map<4096>", run<B_tree_map<std::uint64_t, std::uint64_t, 4096>>(keys, order, starts), keys.size());
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs;
+    pairs.reserve(keys.size());
+    for (std::uint64_t key : keys)
+        pairs.emplace_back(key, key * 3);
+
+    auto start = std::chrono::steady_clock::now();
+    const Flat_map<std::uint64_t, std::uint64_t> flat {std::move(pairs)};
+    const double build = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    std::uint64_t sum {0};
+    for (std::uint64_t key : order)
+        sum += flat.find(key)->second;
+    const double find = seconds_since(start);
+
+    std::cout << std::setw(22) << std::left << "Flat_map" << std::fixed << std::setprecision(1)
+        << std::setw(12) << std::right << build * 1e9 / keys.size() << std::setw(12) << find * 1e9 / keys.size()
+        << "    " << sum << ", built at once, find only" << std::endl;
+
+    std::ifstream in_file {"../challengeThree/romeoAndJuliet.txt"};
+    if (!in_file)
+    {
+        std::cout << "Error opening ../challengeThree/romeoAndJuliet.txt" << std::endl;
+        return 1;
+    }
+    std::ostringstream text;
+    text << in_file.rdbuf();
+    const std::string contents = text.str();
+    const std::vector<std::string_view> words = split_words(contents);
+
+    std::cout << std::endl << words.size() << " words " << text_repeats << " times, ns per words[word]++, words, checksum" << std::endl;
+    count_words<std::map<std::string, int>, std::string>("std::map", words);
+    count_words<std::unordered_map<std::string, int>, std::string>("std::unordered_map", words);
+    count_words<Swiss_map<std::string, int>, std::string_view>("Swiss_map", words);
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+#ifndef _BUCKET_QUEUE_H_
+#define _BUCKET_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Bucket_queue is a priority queue of values whose key is an integer of a range known
+      up front, the age of a Person, the tier of a job, ..., with a bucket for every key
+      of the range: a push is an append to the bucket of its key, O(1), no compare and no
+      sift, and a pop takes from the top bucket, a value of the same key is there next.
+
+    - Key_of gives the key of a value, the value itself by default, a functor of the field
+      takes the records as they are, Bucket_queue<Person, Age_of>. the top is the largest
+      key, as in std::priority_queue with std::less, or the smallest one with
+      Bucket_order::smallest_first.
+
+    - the values of one key come out in the order they were pushed, a queue of jobs is
+      first in first out within a tier, a std::priority_queue gives equal ones in any order.
+
+    - the buckets that are not empty are bits of a bitmap, with a bitmap of its words that
+      are not zero above it, and one above that, ..., the top bucket is kept, when it is
+      emptied the next one is found by going down the bitmaps, a word a level, 3 levels for
+      a range of 262144 keys, so a pop is O(1) too. the cost is the buckets, a vector of 32
+      bytes each, for every key of the range, use it for ranges of thousands or millions of
+      keys, not of every int.
+
+    - a popped value is T {} until its bucket is emptied or its front dropped, a string of
+      it is freed at once, T is default constructible. a key that is out of the range
+      throws std::out_of_range, the queue is not changed.
+      for keys that only grow, the distances of Dijkstra, see Radix_heap.h.
+
+*/
+enum class Bucket_order
+{
+    largest_first,
+    smallest_first
+};
+
+struct Identity_key
+{
+    template <typename T>
+    const T& operator()(const T& value) const { return value; }
+};
+
+template <typename T, typename Key_of = Identity_key, Bucket_order Order = Bucket_order::largest_first>
+class Bucket_queue
+{
+public:
+    using Key = std::decay_t<std::invoke_result_t<const Key_of&, const T&>>;
+    static_assert(std::is_integral_v<Key>, "the key of a Bucket_queue is an integer");
+
+private:
+    struct Bucket
+    {
+        std::vector<T> values;
+        std::size_t head {0};  // the values before it are popped
+    };
+
+    std::vector<Bucket> buckets;
+    std::vector<std::vector<std::uint64_t>> levels;  // the bits of the buckets, then of the words below, ...
+    Key min_key;
+    std::size_t top_bucket {0};
+    std::size_t num_values {0};
+    Key_of key_of;
+
+    // the index of the bucket of key, after the smallest key
+    std::size_t bucket_of(Key key) const
+    {
+        // in unsigned, the difference of two ints of the range does not overflow
+        const std::uint64_t offset = static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(this->min_key);
+        if (key < this->min_key || offset >= this->buckets.size())
+            throw std::out_of_range("the key " + std::to_string(key) + " is out of the range of the Bucket_queue");
+        return static_cast<std::size_t>(offset);
+    }
+
+    static bool above(std::size_t a, std::size_t b)
+    {
+        return Order == Bucket_order::largest_first ? a > b : a < b;
+    }
+
+    void mark(std::size_t bucket)
+    {
+        for (std::vector<std::uint64_t>& level : this->levels)
+        {
+            const bool was_empty = level[bucket / 64] == 0;
+            level[bucket / 64] |= std::uint64_t {1} << (bucket % 64);
+            if (!was_empty)
+                return;
+            bucket /= 64;
+        }
+    }
+
+    void unmark(std::size_t bucket)
+    {
+        for (std::vector<std::uint64_t>& level : this->levels)
+        {
+            level[bucket / 64] &= ~(std::uint64_t {1} << (bucket % 64));
+            if (level[bucket / 64] != 0)
+                return;
+            bucket /= 64;
+        }
+    }
+
+    // the top bucket that is not empty, from the last level down, a word a level
+    std::size_t find_top() const
+    {
+        std::size_t word = 0;
+        for (std::size_t i = this->levels.size(); i-- > 0;)
+        {
+            const std::uint64_t bits = this->levels[i][word];
+            const std::size_t bit = Order == Bucket_order::largest_first ? 63 - static_cast<std::size_t>(__builtin_clzll(bits))
+                                                                        : static_cast<std::size_t>(__builtin_ctzll(bits));
+            word = word * 64 + bit;
+        }
+        return word;
+    }
+
+public:
+    // the keys from min_key to max_key, both in
+    Bucket_queue(Key min_key, Key max_key, const Key_of& key_of = Key_of {})
+        : min_key(min_key), key_of(key_of)
+    {
+        if (max_key < min_key)
+            throw std::out_of_range("the range of a Bucket_queue is empty");
+        this->buckets.resize(static_cast<std::size_t>(static_cast<std::uint64_t>(max_key) - static_cast<std::uint64_t>(min_key) + 1));
+        std::size_t count = this->buckets.size();
+        do
+        {
+            count = (count + 63) / 64;
+            this->levels.emplace_back(count, 0);
+        } while (count > 1);
+    }
+
+    bool empty() const { return this->num_values == 0; }
+    std::size_t size() const { return this->num_values; }
+
+    const T& top() const
+    {
+        const Bucket& bucket = this->buckets[this->top_bucket];
+        return bucket.values[bucket.head];
+    }
+
+    Key top_key() const
+    {
+        return static_cast<Key>(static_cast<std::uint64_t>(this->min_key) + this->top_bucket);
+    }
+
+    void push(T value)
+    {
+        const std::size_t bucket = this->bucket_of(this->key_of(value));
+        std::vector<T>& values = this->buckets[bucket].values;
+        if (values.size() == this->buckets[bucket].head)
+            this->mark(bucket);
+        values.push_back(std::move(value));
+        if (this->num_values++ == 0 || above(bucket, this->top_bucket))
+            this->top_bucket = bucket;
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        this->push(T(std::forward<Args>(args)...));
+    }
+
+    // an emptied bucket keeps its capacity, the keys that come again do not allocate
+    void pop()
+    {
+        Bucket& bucket = this->buckets[this->top_bucket];
+        bucket.values[bucket.head++] = T {};
+        --this->num_values;
+        if (bucket.head < bucket.values.size())
+        {
+            // a bucket that is pushed to as fast as it is popped drops its front now and then
+            if (bucket.head >= 64 && bucket.head * 2 >= bucket.values.size())
+            {
+                bucket.values.erase(bucket.values.begin(), bucket.values.begin() + static_cast<std::ptrdiff_t>(bucket.head));
+                bucket.head = 0;
+            }
+            return;
+        }
+
+        bucket.values.clear();
+        bucket.head = 0;
+        this->unmark(this->top_bucket);
+        if (this->num_values > 0)
+            this->top_bucket = this->find_top();
+    }
+
+    void clear()
+    {
+        for (Bucket& bucket : this->buckets)
+        {
+            bucket.values.clear();
+            bucket.head = 0;
+        }
+        for (std::vector<std::uint64_t>& level : this->levels)
+            level.assign(level.size(), 0);
+        this->num_values = 0;
+    }
+
+    // f(value) for the values from the top down, the queue is not changed, f can stop it by
+    // returning false, it goes over every bucket of the range
+    template <typename F>
+    void for_each_sorted(F f) const
+    {
+        for (std::size_t k = 0; k < this->buckets.size(); ++k)
+        {
+            const std::size_t i = Order == Bucket_order::largest_first ? this->buckets.size() - 1 - k : k;
+            const Bucket& bucket = this->buckets[i];
+            for (std::size_t j = bucket.head; j < bucket.values.size(); ++j)
+            {
+                if constexpr (std::is_same_v<decltype(f(bucket.values[j])), bool>)
+                {
+                    if (!f(bucket.values[j]))
+                        return;
+                }
+                else
+                    f(bucket.values[j]);
+            }
+        }
+    }
+};
+
+#endif
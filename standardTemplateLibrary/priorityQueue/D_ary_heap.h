@@ -0,0 +1,243 @@
+#ifndef _D_ARY_HEAP_H_
+#define _D_ARY_HEAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a D_ary_heap is a priority queue like std::priority_queue, the top is the largest value
+      for std::less, but every node has D children, 4 by default, so the heap is half as deep
+      as a binary one and the children of a node are next to each other, a sift down reads
+      one or two cache lines per level.
+
+    - built from a range it is heapified in O(n), from the last parent up, not n pushes.
+
+    - push gives a handle, it stays the same while the value moves in the heap and until the
+      value is popped, then it can be given again. update moves the value of a handle up or
+      down, decrease_key is the one of Dijkstra, the new value has a higher priority, it only
+      moves up. a handle that is not in the heap must not be used.
+
+    - for_each_sorted walks the values from the top down without copying or changing the
+      heap, it keeps only the positions it can go to next in a small heap of its own, the
+      children of every value it gave, so the first k cost O(k log k).
+
+*/
+template <typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class D_ary_heap
+{
+    static_assert(D >= 2, "a heap node has at least two children");
+
+public:
+    using Handle = std::uint32_t;
+
+private:
+    struct Entry
+    {
+        T value;
+        Handle handle;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::size_t> positions; // the position of every handle in entries
+    std::vector<Handle> free_handles;
+    Compare compare;
+
+    // true when a has to be above b
+    bool before(const T& a, const T& b) const
+    {
+        return this->compare(b, a);
+    }
+
+    void place(std::size_t i, Entry&& entry)
+    {
+        this->positions[entry.handle] = i;
+        this->entries[i] = std::move(entry);
+    }
+
+    void sift_up(std::size_t i)
+    {
+        Entry entry = std::move(this->entries[i]);
+        while (i > 0)
+        {
+            const std::size_t parent = (i - 1) / D;
+            if (!this->before(entry.value, this->entries[parent].value))
+                break;
+            this->place(i, std::move(this->entries[parent]));
+            i = parent;
+        }
+        this->place(i, std::move(entry));
+    }
+
+    void sift_down(std::size_t i)
+    {
+        const std::size_t size = this->entries.size();
+        Entry entry = std::move(this->entries[i]);
+        while (true)
+        {
+            const std::size_t first = i * D + 1;
+            if (first >= size)
+                break;
+            const std::size_t last = first + D < size ? first + D : size;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child)
+                if (this->before(this->entries[child].value, this->entries[best].value))
+                    best = child;
+            if (!this->before(this->entries[best].value, entry.value))
+                break;
+            this->place(i, std::move(this->entries[best]));
+            i = best;
+        }
+        this->place(i, std::move(entry));
+    }
+
+    Handle new_handle()
+    {
+        if (!this->free_handles.empty())
+        {
+            const Handle handle = this->free_handles.back();
+            this->free_handles.pop_back();
+            return handle;
+        }
+        this->positions.push_back(0);
+        return static_cast<Handle>(this->positions.size() - 1);
+    }
+
+public:
+    D_ary_heap() = default;
+
+    explicit D_ary_heap(const Compare& compare)
+        : compare(compare) {}
+
+    // the handle of the i-th value of the range is i
+    template <typename Iterator>
+    D_ary_heap(Iterator first, Iterator last, const Compare& compare = Compare {})
+        : compare(compare)
+    {
+        for (; first != last; ++first)
+        {
+            const Handle handle = static_cast<Handle>(this->entries.size());
+            this->entries.push_back(Entry {*first, handle});
+            this->positions.push_back(handle);
+        }
+        this->heapify();
+    }
+
+    // every parent from the last one up is sifted down, O(n)
+    void heapify()
+    {
+        if (this->entries.size() < 2)
+            return;
+        for (std::size_t i = (this->entries.size() - 2) / D + 1; i-- > 0;)
+            this->sift_down(i);
+    }
+
+    bool empty() const { return this->entries.empty(); }
+    std::size_t size() const { return this->entries.size(); }
+
+    const T& top() const { return this->entries.front().value; }
+    Handle top_handle() const { return this->entries.front().handle; }
+
+    void reserve(std::size_t n)
+    {
+        this->entries.reserve(n);
+        this->positions.reserve(n);
+    }
+
+    Handle push(T value)
+    {
+        const Handle handle = this->new_handle();
+        this->positions[handle] = this->entries.size();
+        this->entries.push_back(Entry {std::move(value), handle});
+        this->sift_up(this->entries.size() - 1);
+        return handle;
+    }
+
+    template <typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        return this->push(T(std::forward<Args>(args)...));
+    }
+
+    void pop()
+    {
+        this->free_handles.push_back(this->entries.front().handle);
+        if (this->entries.size() > 1)
+        {
+            this->place(0, std::move(this->entries.back()));
+            this->entries.pop_back();
+            this->sift_down(0);
+        }
+        else
+            this->entries.pop_back();
+    }
+
+    const T& get(Handle handle) const
+    {
+        return this->entries[this->positions[handle]].value;
+    }
+
+    // the value of the handle becomes value and moves to its place, up or down
+    void update(Handle handle, T value)
+    {
+        const std::size_t i = this->positions[handle];
+        const bool up = this->before(value, this->entries[i].value);
+        this->entries[i].value = std::move(value);
+        if (up)
+            this->sift_up(i);
+        else
+            this->sift_down(i);
+    }
+
+    // value is not after the old one, the value can only move up
+    void decrease_key(Handle handle, T value)
+    {
+        const std::size_t i = this->positions[handle];
+        this->entries[i].value = std::move(value);
+        this->sift_up(i);
+    }
+
+    // f(value) for the values from the top down, the heap is not changed, f can stop it by returning false
+    template <typename F>
+    void for_each_sorted(F f) const
+    {
+        if (this->entries.empty())
+            return;
+
+        // the positions that can be the next one, with the best one on top
+        auto after = [this](std::size_t a, std::size_t b)
+        {
+            return this->before(this->entries[b].value, this->entries[a].value);
+        };
+        std::vector<std::size_t> next {0};
+        while (!next.empty())
+        {
+            std::pop_heap(next.begin(), next.end(), after);
+            const std::size_t i = next.back();
+            next.pop_back();
+
+            if constexpr (std::is_same_v<decltype(f(this->entries[i].value)), bool>)
+            {
+                if (!f(this->entries[i].value))
+                    return;
+            }
+            else
+                f(this->entries[i].value);
+
+            const std::size_t first = i * D + 1;
+            for (std::size_t child = first; child < first + D && child < this->entries.size(); ++child)
+            {
+                next.push_back(child);
+                std::push_heap(next.begin(), next.end(), after);
+            }
+        }
+    }
+};
+
+#endif
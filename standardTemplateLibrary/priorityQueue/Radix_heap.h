@@ -0,0 +1,129 @@
+#ifndef _RADIX_HEAP_H_
+#define _RADIX_HEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Bucket_queue.h"
+
+/*
+
+    - a Radix_heap is a priority queue of the smallest key first for keys that only grow, a
+      key that is pushed is not below the last one popped: the distances of Dijkstra, the
+      times of an event simulation, the deadlines of jobs that are taken in order. the keys
+      are unsigned integers of any range, Key_of gives them as in Bucket_queue.
+
+    - it has 65 buckets, the values of the last key popped in the first one, and in bucket b
+      the ones whose key differs from it first in bit b - 1, counted from the bottom. a push
+      is an append to its bucket, O(1). when the first bucket is empty the next one that is
+      not is taken, its smallest key is the last one now and its values go to the buckets
+      of their new differences, all below it, so a value moves at most 64 times, and far
+      fewer when the keys are close, a pop is amortized O(1) for keys within a small
+      distance of each other, O(log C) for ones C apart, with no compare of two values.
+
+    - the buckets are settled by top and pop, last is the key of the top then, a key below
+      it throws std::out_of_range. the values of the first bucket are popped last pushed
+      first, the order of equal keys is not kept.
+
+*/
+template <typename T, typename Key_of = Identity_key>
+class Radix_heap
+{
+public:
+    using Key = std::decay_t<std::invoke_result_t<const Key_of&, const T&>>;
+    static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>, "the key of a Radix_heap is an unsigned integer");
+
+private:
+    struct Entry
+    {
+        std::uint64_t key;
+        T value;
+    };
+
+    // top settles the buckets, what the heap has does not change
+    mutable std::vector<Entry> buckets[65];
+    mutable std::uint64_t last {0};
+    std::size_t num_values {0};
+    Key_of key_of;
+
+    std::size_t bucket_of(std::uint64_t key) const
+    {
+        return key == this->last ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(key ^ this->last));
+    }
+
+    // the first bucket has the values of the smallest key when the heap is not empty
+    void settle() const
+    {
+        if (!this->buckets[0].empty() || this->num_values == 0)
+            return;
+
+        std::size_t b = 1;
+        while (this->buckets[b].empty())
+            ++b;
+        std::vector<Entry>& from = this->buckets[b];
+        std::uint64_t smallest = from.front().key;
+        for (const Entry& entry : from)
+            smallest = entry.key < smallest ? entry.key : smallest;
+
+        this->last = smallest;
+        for (Entry& entry : from)
+            this->buckets[this->bucket_of(entry.key)].push_back(std::move(entry));
+        from.clear();
+    }
+
+public:
+    explicit Radix_heap(const Key_of& key_of = Key_of {})
+        : key_of(key_of) {}
+
+    bool empty() const { return this->num_values == 0; }
+    std::size_t size() const { return this->num_values; }
+
+    const T& top() const
+    {
+        this->settle();
+        return this->buckets[0].back().value;
+    }
+
+    Key top_key() const
+    {
+        this->settle();
+        return static_cast<Key>(this->last);
+    }
+
+    void push(T value)
+    {
+        const std::uint64_t key = this->key_of(value);
+        if (key < this->last)
+            throw std::out_of_range("the key " + std::to_string(key) + " is below the last key of the Radix_heap");
+        this->buckets[this->bucket_of(key)].push_back(Entry {key, std::move(value)});
+        ++this->num_values;
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        this->push(T(std::forward<Args>(args)...));
+    }
+
+    void pop()
+    {
+        this->settle();
+        this->buckets[0].pop_back();
+        --this->num_values;
+    }
+
+    // the keys pushed after it can start from 0 again
+    void clear()
+    {
+        for (std::vector<Entry>& bucket : this->buckets)
+            bucket.clear();
+        this->last = 0;
+        this->num_values = 0;
+    }
+};
+
+#endif
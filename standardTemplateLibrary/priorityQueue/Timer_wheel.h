@@ -0,0 +1,240 @@
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../../functions/passingArrayToFunction/Span.h"
+
+/*
+
+    - a Timer_wheel keeps timers that expire at a tick, a std::uint64_t, each one with a T,
+      the account of a hold, the session that times out, ..., the way a scheduler would keep
+      them in a std::priority_queue of (expiry, T), but a schedule and a cancel are O(1) and
+      a timer that expires costs a few moves, not the O(log n) of a push and a pop.
+
+    - it is the hierarchical wheel of Varghese and Lauck: 11 levels of 64 slots, a slot of
+      level k is 64^k ticks wide, a timer is in the level of the highest base 64 digit its
+      expiry and now do not share, in the slot of that digit of its expiry. when now gets
+      to a slot of a level above 0 its timers are scheduled again, they go down a level or
+      more, a timer moves at most once a level, and the slot of level 0 now gets to has the
+      timers that expire.
+
+    - every level has a bitmap of the slots that are not empty, advance goes from slot to
+      slot by it, not tick by tick, the ticks in between with nothing to do cost nothing,
+      a wheel that is advanced once an hour over a billion ticks is as fast as one that is
+      advanced every tick. next_event is the tick of the next slot it gets to, a thread can
+      sleep until then.
+
+    - a slot is a vector of the expiry, the node and the generation of its timers, 16 bytes
+      each, the values are in a vector of the nodes. moving a slot down reads it in order
+      and appends to the slots below, it does not go to the nodes, only an expiry does.
+      schedule gives a handle, the node and its generation, a cancel frees the node at once
+      and changes its generation, the entry of the timer stays in its slot until the wheel
+      gets to it and is dropped there, so a cancel of a timer that already expired, or was
+      cancelled, is false and does not cancel the one that took its node.
+
+    - advance(now, expire) calls expire with a Span<T> of the timers of every slot that
+      expires, the batch of a tick, in the order of the ticks. expire can schedule and cancel
+      timers, a timer scheduled at a tick that is not after now, there too, expires on the
+      next advance, but expire does not call advance. T is default constructible, a node
+      that is free keeps one.
+
+*/
+template <typename T>
+class Timer_wheel
+{
+public:
+    using Handle = std::uint64_t;
+    static constexpr std::uint64_t never = UINT64_MAX;
+
+private:
+    static constexpr unsigned bits = 6;
+    static constexpr unsigned slots = 1u << bits;
+    static constexpr unsigned levels = (64 + bits - 1) / bits;
+    static constexpr std::size_t overdue = levels * slots;  // the slot of the ones not after now
+
+    // what a slot has of a timer, the entry of a cancelled one has an older generation
+    struct Entry
+    {
+        std::uint64_t expiry;
+        std::uint32_t node;
+        std::uint32_t generation;
+    };
+
+    std::vector<Entry> entries[levels * slots + 1];
+    std::uint64_t occupied[levels] {};
+    std::vector<std::uint32_t> generations;
+    std::vector<T> values;
+    std::vector<std::uint32_t> free_nodes;
+    std::uint64_t current_tick;
+    std::size_t num_timers {0};
+    std::vector<Entry> cascading;
+    std::vector<T> batch;
+
+    static unsigned level_of(std::uint64_t expiry, std::uint64_t now)
+    {
+        return (63 - static_cast<unsigned>(__builtin_clzll(expiry ^ now))) / bits;
+    }
+
+    void place(const Entry& entry)
+    {
+        if (entry.expiry <= this->current_tick)
+        {
+            this->entries[overdue].push_back(entry);
+            return;
+        }
+        const unsigned level = level_of(entry.expiry, this->current_tick);
+        const unsigned slot = static_cast<unsigned>((entry.expiry >> (level * bits)) & (slots - 1));
+        this->entries[level * slots + slot].push_back(entry);
+        this->occupied[level] |= std::uint64_t {1} << slot;
+    }
+
+    void release(std::uint32_t node)
+    {
+        ++this->generations[node];
+        this->free_nodes.push_back(node);
+        --this->num_timers;
+    }
+
+    // the values of the timers of a slot that were not cancelled into the batch
+    void take(std::size_t slot)
+    {
+        for (const Entry& entry : this->entries[slot])
+            if (entry.generation == this->generations[entry.node])
+            {
+                this->batch.push_back(std::move(this->values[entry.node]));
+                this->release(entry.node);
+            }
+        this->entries[slot].clear();
+    }
+
+    template <typename F>
+    std::size_t expire_batch(F& expire)
+    {
+        const std::size_t count = this->batch.size();
+        if (count > 0)
+        {
+            expire(Span<T> {this->batch.data(), count});
+            this->batch.clear();
+        }
+        return count;
+    }
+
+    // the lowest level with a slot that is not empty, and the tick now gets to it
+    std::uint64_t next_slot(unsigned& level, unsigned& slot) const
+    {
+        for (level = 0; level < levels; ++level)
+        {
+            if (this->occupied[level] == 0)
+                continue;
+            // the slots of a level are all after the digit of now
+            slot = static_cast<unsigned>(__builtin_ctzll(this->occupied[level]));
+            const unsigned shift = level * bits;
+            const std::uint64_t above = shift + bits >= 64 ? 0 : this->current_tick >> (shift + bits) << (shift + bits);
+            return above | std::uint64_t {slot} << shift;
+        }
+        return never;
+    }
+
+public:
+    explicit Timer_wheel(std::uint64_t now = 0)
+        : current_tick(now) {}
+
+    Timer_wheel(const Timer_wheel&) = delete;
+    Timer_wheel& operator=(const Timer_wheel&) = delete;
+
+    std::uint64_t now() const { return this->current_tick; }
+    std::size_t size() const { return this->num_timers; }
+    bool empty() const { return this->num_timers == 0; }
+
+    void reserve(std::size_t n)
+    {
+        this->generations.reserve(n);
+        this->values.reserve(n);
+    }
+
+    Handle schedule(std::uint64_t expiry, T value)
+    {
+        std::uint32_t node;
+        if (!this->free_nodes.empty())
+        {
+            node = this->free_nodes.back();
+            this->free_nodes.pop_back();
+            this->values[node] = std::move(value);
+        }
+        else
+        {
+            node = static_cast<std::uint32_t>(this->values.size());
+            this->generations.push_back(0);
+            this->values.push_back(std::move(value));
+        }
+        this->place(Entry {expiry, node, this->generations[node]});
+        ++this->num_timers;
+        return Handle {this->generations[node]} << 32 | node;
+    }
+
+    // false when the timer already expired or was cancelled
+    bool cancel(Handle handle)
+    {
+        const std::uint32_t node = static_cast<std::uint32_t>(handle);
+        if (node >= this->generations.size() || this->generations[node] != static_cast<std::uint32_t>(handle >> 32))
+            return false;
+        this->values[node] = T {};
+        this->release(node);
+        return true;
+    }
+
+    // the tick of the next slot advance gets to, a timer expires there or it is later, never when empty
+    std::uint64_t next_event() const
+    {
+        if (!this->entries[overdue].empty())
+            return this->current_tick;
+        unsigned level;
+        unsigned slot;
+        return this->next_slot(level, slot);
+    }
+
+    // now becomes the tick, the timers not after it expire in batches, the number of them
+    template <typename F>
+    std::size_t advance(std::uint64_t tick, F expire)
+    {
+        std::size_t expired = 0;
+        if (tick < this->current_tick)
+            tick = this->current_tick;
+        this->take(overdue);
+        expired += this->expire_batch(expire);
+        for (;;)
+        {
+            unsigned level;
+            unsigned slot;
+            const std::uint64_t at = this->next_slot(level, slot);
+            if (at > tick)
+                break;
+            this->current_tick = at;
+            this->occupied[level] &= ~(std::uint64_t {1} << slot);
+            if (level == 0)
+                this->take(slot);
+            else
+            {
+                // one level or more down, the ones of this very tick to the overdue slot, the
+                // cancelled ones too, they are dropped when they get to level 0
+                this->cascading.swap(this->entries[level * slots + slot]);
+                for (const Entry& entry : this->cascading)
+                    this->place(entry);
+                this->cascading.clear();
+            }
+            // the ones of now, and the ones expire scheduled at now
+            while (this->batch.size() > 0 || !this->entries[overdue].empty())
+            {
+                this->take(overdue);
+                expired += this->expire_batch(expire);
+            }
+        }
+        this->current_tick = tick;
+        return expired;
+    }
+};
+
+#endif
@@ -1,5 +1,14 @@
+#include <cstdint>
 #include <iostream>
 #include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Bucket_queue.h"
+#include "D_ary_heap.h"
+#include "Radix_heap.h"
+#include "Timer_wheel.h"
 
 class Person final
 {
@@ -13,6 +22,8 @@ public:
     Person() = default;
     Person(std::string name, int age) : name(name), age(age) {}
 
+    int get_age() const { return this->age; }
+
     bool operator<(const Person& rhs) const
     {
         return this->age < rhs.age;
@@ -30,6 +41,12 @@ std::ostream& operator<<(std::ostream& os, const Person& p)
     return os;
 }
 
+// the key of a Person in a Bucket_queue
+struct Age_of
+{
+    int operator()(const Person& p) const { return p.get_age(); }
+};
+
 template <typename T>
 void display(std::priority_queue<T> pq)
 {
@@ -42,6 +59,15 @@ void display(std::priority_queue<T> pq)
     std::cout << std::endl;
 }
 
+// by reference, the heap is walked in order without popping a copy of it
+template <typename T, std::size_t D>
+void display(const D_ary_heap<T, D>& heap)
+{
+    std::cout << std::endl;
+    heap.for_each_sorted([](const T& value) { std::cout << "| " << value << std::endl; });
+    std::cout << std::endl;
+}
+
 void test1()
 {
     std::cout << std::endl << "test1=========================" << std::endl;
@@ -78,10 +104,126 @@ void test2()
     std::cout << std::endl;
 }
 
+void test3()
+{
+    std::cout << std::endl << "test3=========================" << std::endl;
+
+    // heapified at once, the handle of every person is its index in the vector
+    std::vector<Person> people {{"A", 10}, {"B", 1}, {"C", 14}, {"D", 18}, {"E", 7}, {"F", 27}};
+    D_ary_heap<Person> heap {people.begin(), people.end()};
+
+    display(heap);
+
+    // B only moves up, from where it is to the top
+    heap.decrease_key(1, Person {"B", 30});
+    std::cout << "top: " << heap.top() << std::endl;
+
+    heap.pop();
+    display(heap);
+
+    std::cout << std::endl;
+}
+
+void test4()
+{
+    std::cout << std::endl << "test4=========================" << std::endl;
+
+    // the holds of accounts that end after a number of seconds
+    Timer_wheel<std::string> holds;
+    holds.schedule(30, "Larry: hold of 100");
+    const auto moe = holds.schedule(90, "Moe: hold of 2000");
+    holds.schedule(90, "Curly: withdrawal window");
+    holds.schedule(5000, "Frank: session");
+    std::cout << "size: " << holds.size() << ", next event: " << holds.next_event() << std::endl;
+
+    std::cout << "cancel Moe: " << std::boolalpha << holds.cancel(moe) << std::endl;
+    std::cout << "cancel Moe again: " << holds.cancel(moe) << std::endl;
+
+    const auto expire = [&holds](Span<std::string> batch)
+    {
+        std::cout << holds.now() << ":";
+        for (const std::string& hold : batch)
+            std::cout << " [" << hold << "]";
+        std::cout << std::endl;
+    };
+    holds.advance(100, expire);
+    holds.advance(10000, expire);
+    std::cout << "size: " << holds.size() << std::endl;
+
+    std::cout << std::endl;
+}
+
+void test5()
+{
+    std::cout << std::endl << "test5=========================" << std::endl;
+
+    // a bucket for every age, G and A have the same age and come out in the order they came in
+    Bucket_queue<Person, Age_of> queue {0, 150};
+    for (const Person& person : {Person {"A", 10}, Person {"B", 1}, Person {"C", 14}, Person {"D", 18},
+                                 Person {"E", 7}, Person {"F", 27}, Person {"G", 10}})
+        queue.push(person);
+
+    std::cout << std::endl;
+    queue.for_each_sorted([](const Person& person) { std::cout << "| " << person << std::endl; });
+    std::cout << std::endl;
+
+    queue.pop();
+    std::cout << "top: " << queue.top() << ", size: " << queue.size() << std::endl;
+    try
+    {
+        queue.push(Person {"H", 200});
+    }
+    catch (const std::out_of_range& ex)
+    {
+        std::cout << ex.what() << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void test6()
+{
+    std::cout << std::endl << "test6=========================" << std::endl;
+
+    // the distances from 0, Dijkstra pops them in order, a Radix_heap takes them
+    const std::vector<std::vector<std::pair<int, std::uint32_t>>> roads {
+        {{1, 7}, {2, 9}, {5, 14}}, {{0, 7}, {2, 10}, {3, 15}}, {{0, 9}, {1, 10}, {3, 11}, {5, 2}},
+        {{1, 15}, {2, 11}, {4, 6}}, {{3, 6}, {5, 9}}, {{0, 14}, {2, 2}, {4, 9}}};
+    using Reach = std::pair<std::uint32_t, int>;
+    struct Distance_of
+    {
+        std::uint32_t operator()(const Reach& reach) const { return reach.first; }
+    };
+
+    std::vector<std::uint32_t> distances(roads.size(), UINT32_MAX);
+    Radix_heap<Reach, Distance_of> heap;
+    heap.push(Reach {0, 0});
+    while (!heap.empty())
+    {
+        const auto [distance, city] = heap.top();
+        heap.pop();
+        if (distances[city] != UINT32_MAX)
+            continue;
+        distances[city] = distance;
+        for (const auto& [to, length] : roads[city])
+            if (distances[to] == UINT32_MAX)
+                heap.push(Reach {distance + length, to});
+    }
+
+    for (std::size_t city = 0; city < distances.size(); ++city)
+        std::cout << city << ": " << distances[city] << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
     test2();
+    test3();
+    test4();
+    test5();
+    test6();
     
     return 0;
 }
@@ -0,0 +1,235 @@
+/*
+
+    - n records of a Person, 4M by default, an id and an age of 0 to 127, pushed all and
+      popped all, oldest first, by a std::priority_queue, a D_ary_heap
+      (../priorityQueue/D_ary_heap.h) and a Bucket_queue (../priorityQueue/Bucket_queue.h),
+      and a queue of jobs of 8 tiers that holds 100000 of them, a push and a pop n times.
+
+    - then Dijkstra on a random graph of n / 4 nodes and n edges, lengths of 1 to 1000, with
+      the std::priority_queue of (distance, node) of the textbook and with a Radix_heap
+      (../priorityQueue/Radix_heap.h), both popping the stale entries.
+
+    - the ages have to come out in order, the ids of one age in the order they were pushed
+      from the Bucket_queue, the jobs of both in the same order of tiers, and the distances
+      of both have to be the same, a mismatch is reported and the exit code is 1.
+
+    - on one core of an x86-64 at -O2, 4M:
+                        priority_queue   D_ary_heap   Bucket_queue / Radix_heap
+        push               25.8 ns         22.9 ns       13.0 ns
+        pop               138.7 ns        254.0 ns        3.5 ns
+        jobs, a pair       91.0 ns         41.9 ns       14.5 ns
+        dijkstra          952 ms                        298 ms
+      a push of a bucket is an append, a pop a read of the front of a bucket, the log n
+      levels of a heap of millions are cache misses for every pop, the D_ary_heap moves the
+      positions of its handles too. the Radix_heap moves a distance a few times from bucket
+      to bucket, in order, the heap sifts it every time.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+        ./a.out [n]
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "../priorityQueue/Bucket_queue.h"
+#include "../priorityQueue/D_ary_heap.h"
+#include "../priorityQueue/Radix_heap.h"
+
+struct Person
+{
+    std::uint32_t id;
+    int age;
+
+    // older first, the id is not compared, the heaps give the ones of an age in any order
+    bool operator<(const Person& rhs) const { return this->age < rhs.age; }
+};
+
+struct Age_of
+{
+    int operator()(const Person& person) const { return person.age; }
+};
+
+template <typename F>
+double time_ns(F f, std::size_t count)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(count);
+}
+
+struct Random
+{
+    std::uint64_t state {0x9e3779b97f4a7c15ULL};
+
+    std::uint64_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// all pushed, then all popped, the ages popped in order, and the ids of an age in order for a stable queue
+template <typename Queue, typename Top, typename Pop>
+void push_pop(Queue& queue, const std::vector<Person>& people, Top top, Pop pop, bool stable, double& push_ns,
+    double& pop_ns, int& mismatches)
+{
+    push_ns = time_ns([&]
+    {
+        for (const Person& person : people)
+            queue.push(person);
+    }, people.size());
+
+    Person last {0, 1000};
+    std::size_t popped = 0;
+    pop_ns = time_ns([&]
+    {
+        while (!queue.empty())
+        {
+            const Person person = top(queue);
+            pop(queue);
+            mismatches += person.age > last.age || (stable && person.age == last.age && person.id < last.id);
+            last = person;
+            ++popped;
+        }
+    }, people.size());
+    mismatches += popped != people.size();
+}
+
+// a queue of jobs that stays at held jobs, every job popped and a new one pushed, the sum of the tiers popped
+template <typename Queue, typename Top, typename Pop>
+std::uint64_t jobs(Queue& queue, const std::vector<Person>& people, std::size_t held, Top top, Pop pop, double& pair_ns)
+{
+    for (std::size_t i = 0; i < held; ++i)
+        queue.push(Person {people[i].id, people[i].age % 8});
+    std::uint64_t sum = 0;
+    pair_ns = time_ns([&]
+    {
+        for (std::size_t i = held; i < people.size(); ++i)
+        {
+            sum = sum * 31 + static_cast<std::uint64_t>(top(queue).age);
+            pop(queue);
+            queue.push(Person {people[i].id, people[i].age % 8});
+        }
+    }, people.size() - held);
+    while (!queue.empty())
+        pop(queue);
+    return sum;
+}
+
+struct Edge
+{
+    std::uint32_t to;
+    std::uint32_t length;
+};
+
+using Reach = std::pair<std::uint64_t, std::uint32_t>;
+
+struct Distance_of
+{
+    std::uint64_t operator()(const Reach& reach) const { return reach.first; }
+};
+
+// the queue pops the smallest distance, the stale entries are skipped
+template <typename Queue, typename Top>
+std::vector<std::uint64_t> dijkstra(const std::vector<std::uint32_t>& starts, const std::vector<Edge>& edges, Queue& queue, Top top)
+{
+    const std::size_t n = starts.size() - 1;
+    std::vector<std::uint64_t> distances(n, UINT64_MAX);
+    distances[0] = 0;
+    queue.push(Reach {0, 0});
+    while (!queue.empty())
+    {
+        const Reach reach = top(queue);
+        queue.pop();
+        if (reach.first != distances[reach.second])
+            continue;
+        for (std::uint32_t e = starts[reach.second]; e < starts[reach.second + 1]; ++e)
+        {
+            const std::uint64_t distance = reach.first + edges[e].length;
+            if (distance < distances[edges[e].to])
+            {
+                distances[edges[e].to] = distance;
+                queue.push(Reach {distance, edges[e].to});
+            }
+        }
+    }
+    return distances;
+}
+
+void report(const char* name, double heap_ns, double d_ary_ns, double bucket_ns)
+{
+    std::cout << std::setw(12) << std::left << name << std::right << std::fixed << std::setprecision(1) << std::setw(10)
+              << heap_ns << " ns" << std::setw(11) << d_ary_ns << " ns" << std::setw(11) << bucket_ns << " ns\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const long n_arg = argc > 1 ? std::atol(argv[1]) : 4000000;
+    const std::size_t n = n_arg > 4 ? static_cast<std::size_t>(n_arg) : 4;
+
+    Random random;
+    std::vector<Person> people(n);
+    for (std::size_t i = 0; i < n; ++i)
+        people[i] = Person {static_cast<std::uint32_t>(i), static_cast<int>(random.next() % 128)};
+
+    int mismatches = 0;
+    double push_ns[3], pop_ns[3], pair_ns[3];
+    const auto top_of = [](const auto& queue) { return queue.top(); };
+    const auto pop_of = [](auto& queue) { queue.pop(); };
+
+    std::priority_queue<Person> heap;
+    push_pop(heap, people, top_of, pop_of, false, push_ns[0], pop_ns[0], mismatches);
+    D_ary_heap<Person> d_ary;
+    d_ary.reserve(n);
+    push_pop(d_ary, people, top_of, pop_of, false, push_ns[1], pop_ns[1], mismatches);
+    Bucket_queue<Person, Age_of> buckets {0, 127};
+    push_pop(buckets, people, top_of, pop_of, true, push_ns[2], pop_ns[2], mismatches);
+
+    const std::size_t held = std::min<std::size_t>(100000, n / 2);
+    const std::uint64_t by_heap = jobs(heap, people, held, top_of, pop_of, pair_ns[0]);
+    const std::uint64_t by_d_ary = jobs(d_ary, people, held, top_of, pop_of, pair_ns[1]);
+    const std::uint64_t by_buckets = jobs(buckets, people, held, top_of, pop_of, pair_ns[2]);
+    mismatches += by_heap != by_buckets || by_d_ary != by_buckets;
+
+    // a random graph, every node has 4 edges out of it, and node i one to i + 1, all are reached
+    const std::size_t nodes = n / 4;
+    std::vector<std::uint32_t> starts(nodes + 1);
+    std::vector<Edge> edges;
+    edges.reserve(nodes * 5);
+    for (std::size_t i = 0; i < nodes; ++i)
+    {
+        starts[i] = static_cast<std::uint32_t>(edges.size());
+        edges.push_back(Edge {static_cast<std::uint32_t>((i + 1) % nodes), static_cast<std::uint32_t>(1 + random.next() % 1000)});
+        for (int k = 0; k < 4; ++k)
+            edges.push_back(Edge {static_cast<std::uint32_t>(random.next() % nodes), static_cast<std::uint32_t>(1 + random.next() % 1000)});
+    }
+    starts[nodes] = static_cast<std::uint32_t>(edges.size());
+
+    std::priority_queue<Reach, std::vector<Reach>, std::greater<Reach>> by_distance;
+    std::vector<std::uint64_t> heap_distances, radix_distances;
+    const double heap_ms = time_ns([&] { heap_distances = dijkstra(starts, edges, by_distance, top_of); }, 1) / 1e6;
+    Radix_heap<Reach, Distance_of> radix;
+    const double radix_ms = time_ns([&] { radix_distances = dijkstra(starts, edges, radix, top_of); }, 1) / 1e6;
+    mismatches += heap_distances != radix_distances;
+
+    std::cout << n << " people, " << nodes << " nodes and " << edges.size() << " edges\n";
+    std::cout << std::setw(12) << "" << "  priority_queue  D_ary_heap  Bucket_queue\n";
+    report("push", push_ns[0], push_ns[1], push_ns[2]);
+    report("pop", pop_ns[0], pop_ns[1], pop_ns[2]);
+    report("jobs, a pair", pair_ns[0], pair_ns[1], pair_ns[2]);
+    std::cout << std::setw(12) << std::left << "dijkstra" << std::right << std::setw(10) << heap_ms << " ms"
+              << std::setw(26) << radix_ms << " ms, Radix_heap\n";
+    std::cout << "mismatches: " << mismatches << '\n';
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+#ifndef _MPMC_QUEUE_H_
+#define _MPMC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+
+    - an Mpmc_queue is a bounded queue for many producers and many consumers without a lock,
+      a ring of cells, each one with a sequence number that says whose turn it is, the one of
+      Dmitry Vyukov: a producer takes a position with a compare and swap of the tail, writes
+      the cell and then bumps its sequence, a consumer does the same with the head.
+
+    - the head and the tail are on cache lines of their own, so producers and consumers do not
+      fight over one line, only over the cells they share.
+
+    - try_push and try_pop never wait, they return false when the queue is full or empty,
+      push_n and pop_n take as many cells as are ready in a row, up to n, with one compare and
+      swap, and return how many.
+
+    - the class is aligned to a cache line, so the line of the head is its own too.
+
+    - the capacity is rounded up to a power of two, the values left in the queue are destroyed
+      with it.
+
+*/
+template <typename T>
+class Mpmc_queue
+{
+private:
+    static constexpr std::size_t cache_line = 64;
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char bytes[sizeof(T)];
+
+        T* value() { return reinterpret_cast<T*>(this->bytes); }
+    };
+
+    Cell* cells;
+    std::size_t mask;
+    alignas(cache_line) std::atomic<std::size_t> tail;
+    alignas(cache_line) std::atomic<std::size_t> head;
+
+    static std::size_t round_up(std::size_t n)
+    {
+        std::size_t capacity = 2;
+        while (capacity < n)
+            capacity *= 2;
+        return capacity;
+    }
+
+    // the cells from position that are ready for the producer, or the consumer, up to n
+    std::size_t count_ready(std::size_t position, std::size_t n, std::size_t lag) const
+    {
+        std::size_t count = 0;
+        while (count < n && count <= this->mask
+            && this->cells[(position + count) & this->mask].sequence.load(std::memory_order_acquire) == position + count + lag)
+            ++count;
+        return count;
+    }
+
+    // a run of up to n cells at the end, tail or head, lag is 0 for a producer and 1 for a consumer
+    std::size_t claim(std::atomic<std::size_t>& end, std::size_t n, std::size_t lag, std::size_t& position)
+    {
+        position = end.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const std::size_t count = this->count_ready(position, n, lag);
+            if (count == 0)
+            {
+                // the first cell is not ready, it is full or empty or another thread took it
+                const std::size_t sequence = this->cells[position & this->mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(sequence - (position + lag)) < 0)
+                    return 0;
+                position = end.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (end.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                return count;
+        }
+    }
+
+public:
+    explicit Mpmc_queue(std::size_t capacity)
+        : cells(nullptr), mask(round_up(capacity) - 1), tail(0), head(0)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument {"Mpmc_queue: the capacity is 0"};
+        this->cells = static_cast<Cell*>(::operator new(sizeof(Cell) * (this->mask + 1), std::align_val_t {alignof(Cell)}));
+        for (std::size_t i = 0; i <= this->mask; ++i)
+            ::new (&this->cells[i].sequence) std::atomic<std::size_t>(i);
+    }
+
+    // no thread is pushing or popping any more
+    ~Mpmc_queue()
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_acquire);
+        for (std::size_t position = this->head.load(std::memory_order_acquire); position != tail; ++position)
+            this->cells[position & this->mask].value()->~T();
+        ::operator delete(this->cells, std::align_val_t {alignof(Cell)});
+    }
+
+    Mpmc_queue(const Mpmc_queue&) = delete;
+    Mpmc_queue& operator=(const Mpmc_queue&) = delete;
+
+    std::size_t capacity() const { return this->mask + 1; }
+
+    bool try_push(T value)
+    {
+        std::size_t position;
+        if (this->claim(this->tail, 1, 0, position) == 0)
+            return false;
+        Cell& cell = this->cells[position & this->mask];
+        ::new (cell.bytes) T(std::move(value));
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::size_t position;
+        if (this->claim(this->head, 1, 1, position) == 0)
+            return false;
+        Cell& cell = this->cells[position & this->mask];
+        value = std::move(*cell.value());
+        cell.value()->~T();
+        cell.sequence.store(position + this->mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // the first ones of values[0, n) that fit, moved in, in order
+    std::size_t push_n(T* values, std::size_t n)
+    {
+        std::size_t position;
+        const std::size_t count = this->claim(this->tail, n, 0, position);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Cell& cell = this->cells[(position + i) & this->mask];
+            ::new (cell.bytes) T(std::move(values[i]));
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // up to n values into values[0, count), in order
+    std::size_t pop_n(T* values, std::size_t n)
+    {
+        std::size_t position;
+        const std::size_t count = this->claim(this->head, n, 1, position);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Cell& cell = this->cells[(position + i) & this->mask];
+            values[i] = std::move(*cell.value());
+            cell.value()->~T();
+            cell.sequence.store(position + i + this->mask + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // a guess when other threads are at it
+    std::size_t size_approx() const
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+        const std::size_t head = this->head.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+
+    - an Spsc_queue is a bounded ring for one producer thread and one consumer thread, no lock
+      and no compare and swap, the producer is the only one that writes the tail and the
+      consumer the only one that writes the head, each one publishes with a release store.
+
+    - the tail, with the head as the producer last saw it, is on a cache line of its own, and
+      the head, with the tail as the consumer last saw it, on another one, so a push reads the
+      line of the consumer only when the ring looks full, and a pop the line of the producer
+      only when it looks empty.
+
+    - push_n and pop_n move as many values as fit, or as there are, up to n, with one store of
+      the tail or the head, and return how many.
+
+    - the capacity is rounded up to a power of two, the values left are destroyed with it.
+
+*/
+template <typename T>
+class Spsc_queue
+{
+private:
+    static constexpr std::size_t cache_line = 64;
+
+    T* values;
+    std::size_t mask;
+    alignas(cache_line) std::atomic<std::size_t> tail;
+    std::size_t cached_head;
+    alignas(cache_line) std::atomic<std::size_t> head;
+    std::size_t cached_tail;
+
+    static std::size_t round_up(std::size_t n)
+    {
+        std::size_t capacity = 2;
+        while (capacity < n)
+            capacity *= 2;
+        return capacity;
+    }
+
+    // the number of free cells, the head is read again only when the one seen is not enough
+    std::size_t free_cells(std::size_t tail, std::size_t wanted)
+    {
+        std::size_t free = this->mask + 1 - (tail - this->cached_head);
+        if (free < wanted)
+        {
+            this->cached_head = this->head.load(std::memory_order_acquire);
+            free = this->mask + 1 - (tail - this->cached_head);
+        }
+        return free;
+    }
+
+    std::size_t used_cells(std::size_t head, std::size_t wanted)
+    {
+        std::size_t used = this->cached_tail - head;
+        if (used < wanted)
+        {
+            this->cached_tail = this->tail.load(std::memory_order_acquire);
+            used = this->cached_tail - head;
+        }
+        return used;
+    }
+
+public:
+    explicit Spsc_queue(std::size_t capacity)
+        : values(nullptr), mask(round_up(capacity) - 1), tail(0), cached_head(0), head(0), cached_tail(0)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument {"Spsc_queue: the capacity is 0"};
+        this->values = static_cast<T*>(::operator new(sizeof(T) * (this->mask + 1), std::align_val_t {alignof(T)}));
+    }
+
+    // neither thread is at it any more
+    ~Spsc_queue()
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_acquire);
+        for (std::size_t position = this->head.load(std::memory_order_acquire); position != tail; ++position)
+            this->values[position & this->mask].~T();
+        ::operator delete(this->values, std::align_val_t {alignof(T)});
+    }
+
+    Spsc_queue(const Spsc_queue&) = delete;
+    Spsc_queue& operator=(const Spsc_queue&) = delete;
+
+    std::size_t capacity() const { return this->mask + 1; }
+
+    // the producer only
+    bool try_push(T value)
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (this->free_cells(tail, 1) == 0)
+            return false;
+        ::new (&this->values[tail & this->mask]) T(std::move(value));
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // the consumer only
+    bool try_pop(T& value)
+    {
+        const std::size_t head = this->head.load(std::memory_order_relaxed);
+        if (this->used_cells(head, 1) == 0)
+            return false;
+        T& cell = this->values[head & this->mask];
+        value = std::move(cell);
+        cell.~T();
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // the producer only, the first ones of values[0, n) that fit, moved in
+    std::size_t push_n(T* values, std::size_t n)
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+        const std::size_t free = this->free_cells(tail, n);
+        const std::size_t count = n < free ? n : free;
+        for (std::size_t i = 0; i < count; ++i)
+            ::new (&this->values[(tail + i) & this->mask]) T(std::move(values[i]));
+        this->tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // the consumer only, up to n values into values[0, count)
+    std::size_t pop_n(T* values, std::size_t n)
+    {
+        const std::size_t head = this->head.load(std::memory_order_relaxed);
+        const std::size_t used = this->used_cells(head, n);
+        const std::size_t count = n < used ? n : used;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T& cell = this->values[(head + i) & this->mask];
+            values[i] = std::move(cell);
+            cell.~T();
+        }
+        this->head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // a guess when the other thread is at it
+    std::size_t size_approx() const
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+        const std::size_t head = this->head.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+};
+
+#endif
@@ -2,6 +2,10 @@
 #include <queue>
 #include <vector>
 #include <list>
+#include <atomic>
+#include <thread>
+#include "Mpmc_queue.h"
+#include "Spsc_queue.h"
 
 template <typename T>
 void display(std::queue<T> q)
@@ -55,6 +59,56 @@ int main()
 
     std::cout << "Front: " << q.front() << std::endl;
     std::cout << "Back: " << q.back() << std::endl;
+
+    // between threads, one producer and one consumer, then two of each
+    Spsc_queue<int> spsc {16};
+    std::thread producer {[&spsc] {
+        for (int i = 1; i <= 1000; ++i)
+            while (!spsc.try_push(i))
+                std::this_thread::yield();
+    }};
+    long sum {0};
+    for (int received = 0, value; received < 1000;)
+        if (spsc.try_pop(value))
+        {
+            sum += value;
+            ++received;
+        }
+        else
+            std::this_thread::yield();
+    producer.join();
+    std::cout << "Spsc_queue sum: " << sum << std::endl;
+
+    Mpmc_queue<int> mpmc {16};
+    std::atomic<long> total {0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 2; ++p)
+        threads.emplace_back([&mpmc] {
+            int batch[4];
+            for (int i = 0; i < 500; i += 4)
+            {
+                for (int k = 0; k < 4; ++k)
+                    batch[k] = i + k + 1;
+                for (std::size_t pushed = 0; pushed < 4;)
+                    pushed += mpmc.push_n(batch + pushed, 4 - pushed);
+            }
+        });
+    for (int c = 0; c < 2; ++c)
+        threads.emplace_back([&mpmc, &total] {
+            int batch[8];
+            for (int received = 0; received < 500;)
+            {
+                const std::size_t n = mpmc.pop_n(batch, 8 < 500 - received ? 8 : 500 - received);
+                for (std::size_t k = 0; k < n; ++k)
+                    total += batch[k];
+                received += static_cast<int>(n);
+                if (n == 0)
+                    std::this_thread::yield();
+            }
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+    std::cout << "Mpmc_queue sum: " << total << std::endl;
     
     return 0;
 }
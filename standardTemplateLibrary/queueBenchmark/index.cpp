@@ -0,0 +1,179 @@
+/*
+
+    - compares Mpmc_queue (../queue/Mpmc_queue.h), one value at a time and in batches of 32,
+      against a std::queue behind a std::mutex with the same capacity, half of the threads
+      push and the other half pop, 2 to 32 threads, and one thread that pushes and pops in
+      turn, and checks that every queue gives the same sum.
+
+    - Spsc_queue (../queue/Spsc_queue.h) is only run with one producer and one consumer.
+
+    - a thread that finds the queue full, or empty, yields and tries again.
+
+    - build it with:
+        g++ -std=c++17 -O2 -pthread index.cpp
+
+    - 10'000'000 values by default, the number can be given on the command line, e.g.
+      ./a.out 1000000
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../queue/Mpmc_queue.h"
+#include "../queue/Spsc_queue.h"
+
+constexpr std::size_t capacity {1024};
+constexpr std::size_t batch {32};
+
+// the mutex wrapped queue, full at the same capacity as the others
+class Locked_queue
+{
+private:
+    std::mutex mutex;
+    std::queue<std::uint64_t> values;
+
+public:
+    explicit Locked_queue(std::size_t) {}
+
+    std::size_t push_n(std::uint64_t* values, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        std::size_t count = 0;
+        for (; count < n && this->values.size() < capacity; ++count)
+            this->values.push(values[count]);
+        return count;
+    }
+
+    std::size_t pop_n(std::uint64_t* values, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock {this->mutex};
+        std::size_t count = 0;
+        for (; count < n && !this->values.empty(); ++count)
+        {
+            values[count] = this->values.front();
+            this->values.pop();
+        }
+        return count;
+    }
+};
+
+struct Result
+{
+    double seconds;
+    std::uint64_t sum;
+};
+
+// values [from, to) in runs of up to step
+template <typename Queue>
+void produce(Queue& queue, std::uint64_t from, std::uint64_t to, std::size_t step)
+{
+    std::uint64_t values[batch];
+    while (from < to)
+    {
+        const std::size_t n = to - from < step ? to - from : step;
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = from + i;
+        for (std::size_t pushed = 0; pushed < n;)
+        {
+            const std::size_t count = queue.push_n(values + pushed, n - pushed);
+            if (count == 0)
+                std::this_thread::yield();
+            pushed += count;
+        }
+        from += n;
+    }
+}
+
+template <typename Queue>
+std::uint64_t consume(Queue& queue, std::uint64_t n, std::size_t step)
+{
+    std::uint64_t values[batch];
+    std::uint64_t sum {0};
+    while (n > 0)
+    {
+        const std::size_t count = queue.pop_n(values, n < step ? n : step);
+        if (count == 0)
+            std::this_thread::yield();
+        for (std::size_t i = 0; i < count; ++i)
+            sum += values[i];
+        n -= count;
+    }
+    return sum;
+}
+
+// one thread, a run pushed and then popped, or half of the threads pushing and half popping
+template <typename Queue>
+Result run(std::uint64_t num_values, std::size_t num_threads, std::size_t step)
+{
+    Queue queue {capacity};
+    Result result {0, 0};
+    auto start = std::chrono::steady_clock::now();
+
+    if (num_threads == 1)
+    {
+        for (std::uint64_t from = 0; from < num_values; from += step)
+        {
+            const std::uint64_t to = from + step < num_values ? from + step : num_values;
+            produce(queue, from, to, step);
+            result.sum += consume(queue, to - from, step);
+        }
+    }
+    else
+    {
+        const std::size_t pairs = num_threads / 2;
+        std::atomic<std::uint64_t> sum {0};
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < pairs; ++p)
+        {
+            // the values of producer p, the consumer p pops as many as there are
+            const std::uint64_t from = num_values * p / pairs;
+            const std::uint64_t to = num_values * (p + 1) / pairs;
+            threads.emplace_back([&queue, from, to, step] { produce(queue, from, to, step); });
+            threads.emplace_back([&queue, &sum, from, to, step] { sum += consume(queue, to - from, step); });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        result.sum = sum;
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void print(const std::string& name, const Result& result, std::uint64_t num_values)
+{
+    std::cout << std::setw(22) << std::left << name << std::fixed << std::setprecision(1)
+        << std::setw(12) << std::right << result.seconds * 1e9 / num_values
+        << "    " << result.sum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint64_t num_values = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    for (std::size_t num_threads : {1, 2, 4, 8, 16, 32})
+    {
+        std::cout << num_threads << " threads, " << num_values << " values, ns per value" << std::endl;
+        print("std::queue + mutex", run<Locked_queue>(num_values, num_threads, 1), num_values);
+        print("std::queue + mutex/32", run<Locked_queue>(num_values, num_threads, batch), num_values);
+        print("Mpmc_queue", run<Mpmc_queue<std::uint64_t>>(num_values, num_threads, 1), num_values);
+        print("Mpmc_queue/32", run<Mpmc_queue<std::uint64_t>>(num_values, num_threads, batch), num_values);
+        if (num_threads == 2)
+        {
+            print("Spsc_queue", run<Spsc_queue<std::uint64_t>>(num_values, num_threads, 1), num_values);
+            print("Spsc_queue/32", run<Spsc_queue<std::uint64_t>>(num_values, num_threads, batch), num_values);
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
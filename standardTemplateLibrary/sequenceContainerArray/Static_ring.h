@@ -0,0 +1,257 @@
+#ifndef _STATIC_RING_H_
+#define _STATIC_RING_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../../functions/passingArrayToFunction/Span.h"
+
+/*
+
+    - a Static_ring<T, N> is a ring of N values in a std::array inside the object, the
+      capacity is known at compile time and nothing is allocated, on the stack or in a
+      static it never touches the heap, which is what a thread that can not wait for
+      malloc records its telemetry into. N is a power of 2, the position of a value is its
+      counter & (N - 1).
+
+    - it is safe for one producer thread and one consumer thread at once, the way
+      ../queue/Spsc_queue.h is, the producer only writes the tail and the consumer only the
+      head, with release stores, no lock and no compare and swap, and one thread on its own
+      uses it the same way.
+
+    - Ring_policy::reject refuses a push when it is full, push returns false and push_n
+      pushes what fits. Ring_policy::overwrite never refuses one, the oldest value is lost,
+      the producer does not even read the head: the consumer finds that the tail is more
+      than N ahead and skips to the oldest one that is left, get_dropped is how many it
+      skipped. the consumer copies a value the producer can be writing at the same time,
+      and checks after the copy that the producer did not start on its cell, a seqlock
+      read, so T is trivially copyable.
+
+    - push_n and pop_n take spans, push_n of the reject ring stores the tail once for the
+      batch, pop_n of it the head once. peek of the reject ring gives the values that are
+      there as at most two spans of the array, the first ones first, read in place and
+      released with consume(n), no copy at all.
+
+    - the values are assigned into the array and moved out of it, T is default
+      constructible, a value popped stays in its cell until it is written over.
+
+*/
+enum class Ring_policy
+{
+    reject,
+    overwrite
+};
+
+template <typename T, std::size_t N, Ring_policy Policy = Ring_policy::reject>
+class Static_ring
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "the capacity of a Static_ring is a power of 2");
+    static_assert(std::is_default_constructible_v<T>, "the cells of a Static_ring are default constructed");
+    static_assert(Policy == Ring_policy::reject || std::is_trivially_copyable_v<T>,
+                  "the values of an overwriting Static_ring are read while they can be written, they are trivially copyable");
+
+private:
+    static constexpr std::size_t cache_line = 64;
+    static constexpr std::size_t mask = N - 1;
+
+    std::array<T, N> cells {};
+    alignas(cache_line) std::atomic<std::size_t> tail {0};
+    std::atomic<std::size_t> writing {0};  // the tail of the overwrite that is being written
+    std::size_t cached_head {0};  // the producer's
+    alignas(cache_line) std::atomic<std::size_t> head {0};
+    std::size_t cached_tail {0};  // the consumer's
+    std::size_t dropped {0};
+
+    // the number of free cells, the head is read again only when the one seen is not enough
+    std::size_t free_cells(std::size_t tail, std::size_t wanted)
+    {
+        std::size_t free = N - (tail - this->cached_head);
+        if (free < wanted)
+        {
+            this->cached_head = this->head.load(std::memory_order_acquire);
+            free = N - (tail - this->cached_head);
+        }
+        return free;
+    }
+
+    std::size_t used_cells(std::size_t head, std::size_t wanted)
+    {
+        std::size_t used = this->cached_tail - head;
+        if (used < wanted)
+        {
+            this->cached_tail = this->tail.load(std::memory_order_acquire);
+            used = this->cached_tail - head;
+        }
+        return used;
+    }
+
+    template <typename U>
+    void overwrite(U&& value)
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+        // a consumer that sees any of this write sees that it started
+        this->writing.store(tail + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        this->cells[tail & mask] = std::forward<U>(value);
+        this->tail.store(tail + 1, std::memory_order_release);
+    }
+
+    template <typename U>
+    bool push_value(U&& value)
+    {
+        if constexpr (Policy == Ring_policy::overwrite)
+        {
+            this->overwrite(std::forward<U>(value));
+            return true;
+        }
+        else
+        {
+            const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+            if (this->free_cells(tail, 1) == 0)
+                return false;
+            this->cells[tail & mask] = std::forward<U>(value);
+            this->tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    bool pop_overwritten(T& value)
+    {
+        std::size_t head = this->head.load(std::memory_order_relaxed);
+        std::size_t tail = this->tail.load(std::memory_order_acquire);
+        for (;;)
+        {
+            if (tail == head)
+                return false;
+            if (tail - head > N)
+            {
+                this->dropped += tail - N - head;
+                head = tail - N;
+            }
+            value = this->cells[head & mask];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const std::size_t started = this->writing.load(std::memory_order_relaxed);
+            // the producer did not get to the cell while it was copied
+            if (started - head <= N)
+                break;
+            tail = this->tail.load(std::memory_order_acquire);
+            this->dropped += started - N - head;
+            head = started - N;
+        }
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+public:
+    Static_ring() = default;
+
+    Static_ring(const Static_ring&) = delete;
+    Static_ring& operator=(const Static_ring&) = delete;
+
+    static constexpr std::size_t capacity() { return N; }
+
+    // the producer only, false when it is full and the policy is reject
+    bool push(const T& value)
+    {
+        return this->push_value(value);
+    }
+
+    bool push(T&& value)
+    {
+        return this->push_value(std::move(value));
+    }
+
+    // the consumer only
+    bool pop(T& value)
+    {
+        if constexpr (Policy == Ring_policy::overwrite)
+            return this->pop_overwritten(value);
+        else
+        {
+            const std::size_t head = this->head.load(std::memory_order_relaxed);
+            if (this->used_cells(head, 1) == 0)
+                return false;
+            value = std::move(this->cells[head & mask]);
+            this->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    // the producer only, the first ones that fit, all of them when it overwrites
+    std::size_t push_n(Span<const T> values)
+    {
+        if constexpr (Policy == Ring_policy::overwrite)
+        {
+            // one tail a value, a consumer copying a cell sees that it is written over
+            for (const T& value : values)
+                this->overwrite(value);
+            return values.size();
+        }
+        else
+        {
+            const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+            const std::size_t free = this->free_cells(tail, values.size());
+            const std::size_t count = values.size() < free ? values.size() : free;
+            for (std::size_t i = 0; i < count; ++i)
+                this->cells[(tail + i) & mask] = values[i];
+            this->tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+    }
+
+    // the consumer only, up to out.size() of the oldest values into the front of out
+    std::size_t pop_n(Span<T> out)
+    {
+        if constexpr (Policy == Ring_policy::overwrite)
+        {
+            std::size_t count = 0;
+            while (count < out.size() && this->pop_overwritten(out[count]))
+                ++count;
+            return count;
+        }
+        else
+        {
+            const std::size_t head = this->head.load(std::memory_order_relaxed);
+            const std::size_t used = this->used_cells(head, out.size());
+            const std::size_t count = out.size() < used ? out.size() : used;
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = std::move(this->cells[(head + i) & mask]);
+            this->head.store(head + count, std::memory_order_release);
+            return count;
+        }
+    }
+
+    // the consumer only, the values that are there in place, valid until they are consumed
+    std::pair<Span<const T>, Span<const T>> peek()
+    {
+        static_assert(Policy == Ring_policy::reject, "the values of an overwriting Static_ring can change while they are read");
+        const std::size_t head = this->head.load(std::memory_order_relaxed);
+        const std::size_t used = this->used_cells(head, N);
+        const std::size_t at = head & mask;
+        const std::size_t first = used < N - at ? used : N - at;
+        return {Span<const T> {this->cells.data() + at, first}, Span<const T> {this->cells.data(), used - first}};
+    }
+
+    // the consumer only, n is at most what peek gave
+    void consume(std::size_t n)
+    {
+        static_assert(Policy == Ring_policy::reject, "the values of an overwriting Static_ring are popped");
+        this->head.store(this->head.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // the consumer only, the values the producer wrote over before they were popped
+    std::size_t get_dropped() const { return this->dropped; }
+
+    // a guess when the other thread is at it
+    std::size_t size_approx() const
+    {
+        const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+        const std::size_t head = this->head.load(std::memory_order_relaxed);
+        const std::size_t used = tail >= head ? tail - head : 0;
+        return used < N ? used : N;
+    }
+};
+
+#endif
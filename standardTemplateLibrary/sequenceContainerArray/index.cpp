@@ -35,6 +35,8 @@
 #include <numeric>
 #include <array>
 #include <algorithm>
+#include <thread>
+#include "Static_ring.h"
 
 void display(const std::array<int, 5>& arr)
 {
@@ -189,6 +191,71 @@ void test9()
     std::cout << std::endl;
 }
 
+struct Sample
+{
+    int sensor;
+    double value;
+};
+
+void test10()
+{
+    std::cout << std::endl << "test10=========================" << std::endl;
+
+    // a full ring refuses the ones that do not fit
+    Static_ring<int, 8> ring;
+    std::array<int, 10> arr {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::cout << "pushed " << ring.push_n(Span<const int> {arr}) << " of " << arr.size() << std::endl;
+    std::cout << "push 11: " << std::boolalpha << ring.push(11) << std::endl;
+
+    std::array<int, 3> out {};
+    std::cout << "popped " << ring.pop_n(Span<int> {out}) << ": " << out[0] << " " << out[1] << " " << out[2] << std::endl;
+    ring.push_n(Span<const int> {arr.data(), 3});
+
+    // the rest in place, 4 to 8 at the end of the array and 1 to 3 that wrapped around
+    auto spans = ring.peek();
+    std::cout << "[ ";
+    for (int value : spans.first)
+        std::cout << value << " ";
+    for (int value : spans.second)
+        std::cout << value << " ";
+    std::cout << "]" << std::endl;
+    ring.consume(spans.first.size() + spans.second.size());
+
+    // a full ring that overwrites keeps the newest ones
+    Static_ring<Sample, 4, Ring_policy::overwrite> latest;
+    for (int i = 0; i < 6; ++i)
+        latest.push(Sample {i, i * 1.5});
+    Sample sample;
+    while (latest.pop(sample))
+        std::cout << "sensor " << sample.sensor << ": " << sample.value << std::endl;
+    std::cout << "dropped: " << latest.get_dropped() << std::endl;
+
+    // one thread records, another one reads, nothing allocated on either
+    static Static_ring<Sample, 1024> telemetry;
+    const int samples = 100000;
+    std::thread producer {[]
+    {
+        for (int i = 0; i < samples; ++i)
+            while (!telemetry.push(Sample {i % 4, static_cast<double>(i)}))
+                std::this_thread::yield();
+    }};
+    double sum = 0;
+    std::array<Sample, 64> batch;
+    for (int received = 0; received < samples;)
+    {
+        const std::size_t count = telemetry.pop_n(Span<Sample> {batch});
+        for (std::size_t i = 0; i < count; ++i)
+            sum += batch[i].value;
+        received += static_cast<int>(count);
+        if (count == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    std::cout << "sum of " << samples << " samples: " << static_cast<long long>(sum) << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
@@ -200,6 +267,7 @@ int main()
     test7();
     test8();
     test9();
+    test10();
     
     return 0;
 }
@@ -0,0 +1,254 @@
+#ifndef _GROWABLE_VECTOR_H_
+#define _GROWABLE_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <ratio>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
+/*
+
+    - a Growable_vector is a vector like std::vector that says how it grew: how many times its
+      storage was reallocated, how many of those the allocator could grow in place, and how
+      many elements were moved, or copied, to the new storage.
+
+    - Growth is the factor the capacity is multiplied by when the vector is full, a std::ratio,
+      3 / 2 by default, std::vector of libstdc++ doubles. a smaller factor wastes less memory
+      and reallocates more often.
+
+    - a T that Trivially_relocatable says can be relocated, every trivially copyable T and
+      the smart pointers, is kept in memory of std::malloc and grown with std::realloc, which
+      can extend the block where it is and copy nothing, or move it with one memcpy, the
+      other ones are moved one by one into memory of operator new, or copied when their move
+      constructor can throw.
+
+    - reserve allocates right away, expect is a hint: the next time the vector is full it
+      grows to the expected size at once, not a factor at a time, so a buffer that is filled
+      with about the same number of elements every batch reallocates once, and not at all
+      after clear, which keeps the capacity.
+
+    - the iterators are pointers, they are invalidated when it grows, an at out of range
+      throws std::out_of_range.
+
+*/
+struct Growth_stats
+{
+    std::size_t reallocations {0};
+    std::size_t in_place {0};       // the reallocations that did not move the elements
+    std::size_t element_moves {0};  // moved or copied one by one or by realloc
+};
+
+template <typename T, typename Growth = std::ratio<3, 2>>
+class Growable_vector final
+{
+    static_assert(Growth::num > Growth::den, "the growth factor is more than 1");
+
+private:
+    // realloc only knows the alignment of std::max_align_t
+    static constexpr bool use_realloc = Trivially_relocatable<T>::value && alignof(T) <= alignof(std::max_align_t);
+
+    T* values;
+    std::size_t num_values;
+    std::size_t max_values;
+    std::size_t expected;
+    Growth_stats growth_stats;
+
+    static void release(T* values, std::size_t n)
+    {
+        if constexpr (use_realloc)
+            std::free(values);
+        else if (values != nullptr)
+            std::allocator<T> {}.deallocate(values, n);
+    }
+
+    // the storage becomes n elements long, n is not less than the size
+    void reallocate(std::size_t n)
+    {
+        ++this->growth_stats.reallocations;
+        if constexpr (use_realloc)
+        {
+            T* grown = static_cast<T*>(std::realloc(static_cast<void*>(this->values), n * sizeof(T)));
+            if (grown == nullptr)
+                throw std::bad_alloc {};
+            if (grown == this->values)
+                ++this->growth_stats.in_place;
+            else
+                this->growth_stats.element_moves += this->num_values;
+            this->values = grown;
+        }
+        else
+        {
+            T* grown = std::allocator<T> {}.allocate(n);
+            std::size_t i = 0;
+            try
+            {
+                for (; i < this->num_values; ++i)
+                    ::new (static_cast<void*>(grown + i)) T(std::move_if_noexcept(this->values[i]));
+            }
+            catch (...)
+            {
+                std::destroy_n(grown, i);
+                std::allocator<T> {}.deallocate(grown, n);
+                throw;
+            }
+            std::destroy_n(this->values, this->num_values);
+            release(this->values, this->max_values);
+            this->growth_stats.element_moves += this->num_values;
+            this->values = grown;
+        }
+        this->max_values = n;
+    }
+
+    // the capacity for one more element, the expected size if there is one that is more
+    void grow()
+    {
+        std::size_t n = this->max_values * Growth::num / Growth::den;
+        if (n <= this->max_values)
+            n = this->max_values + 1;
+        n = std::max<std::size_t>({n, 4, this->expected});
+        this->expected = 0;
+        this->reallocate(n);
+    }
+
+public:
+    Growable_vector()
+        : values(nullptr), num_values(0), max_values(0), expected(0) {}
+
+    Growable_vector(std::initializer_list<T> values)
+        : Growable_vector()
+    {
+        this->reserve(values.size());
+        for (const T& value : values)
+            this->push_back(value);
+    }
+
+    Growable_vector(const Growable_vector& source)
+        : Growable_vector()
+    {
+        this->reserve(source.num_values);
+        for (const T& value : source)
+            this->push_back(value);
+    }
+
+    Growable_vector(Growable_vector&& source) noexcept
+        : values(source.values), num_values(source.num_values), max_values(source.max_values),
+          expected(source.expected), growth_stats(source.growth_stats)
+    {
+        source.values = nullptr;
+        source.num_values = source.max_values = source.expected = 0;
+    }
+
+    Growable_vector& operator=(Growable_vector rhs) noexcept
+    {
+        std::swap(this->values, rhs.values);
+        std::swap(this->num_values, rhs.num_values);
+        std::swap(this->max_values, rhs.max_values);
+        std::swap(this->expected, rhs.expected);
+        std::swap(this->growth_stats, rhs.growth_stats);
+        return *this;
+    }
+
+    ~Growable_vector()
+    {
+        std::destroy_n(this->values, this->num_values);
+        release(this->values, this->max_values);
+    }
+
+    T* begin() { return this->values; }
+    T* end() { return this->values + this->num_values; }
+    const T* begin() const { return this->values; }
+    const T* end() const { return this->values + this->num_values; }
+
+    T* data() { return this->values; }
+    const T* data() const { return this->values; }
+
+    bool empty() const { return this->num_values == 0; }
+    std::size_t size() const { return this->num_values; }
+    std::size_t capacity() const { return this->max_values; }
+
+    T& operator[](std::size_t i) { return this->values[i]; }
+    const T& operator[](std::size_t i) const { return this->values[i]; }
+
+    T& at(std::size_t i)
+    {
+        if (i >= this->num_values)
+            throw std::out_of_range {"Growable_vector::at: the index is out of range"};
+        return this->values[i];
+    }
+
+    const T& at(std::size_t i) const
+    {
+        return const_cast<Growable_vector*>(this)->at(i);
+    }
+
+    T& front() { return this->values[0]; }
+    T& back() { return this->values[this->num_values - 1]; }
+    const T& front() const { return this->values[0]; }
+    const T& back() const { return this->values[this->num_values - 1]; }
+
+    void reserve(std::size_t n)
+    {
+        if (n > this->max_values)
+            this->reallocate(n);
+    }
+
+    // the number of elements the vector is expected to hold, used the next time it is full
+    void expect(std::size_t n)
+    {
+        this->expected = n > this->max_values ? n : 0;
+    }
+
+    void shrink_to_fit()
+    {
+        if (this->num_values == this->max_values)
+            return;
+        if (this->num_values == 0)
+        {
+            release(this->values, this->max_values);
+            this->values = nullptr;
+            this->max_values = 0;
+            return;
+        }
+        this->reallocate(this->num_values);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (this->num_values == this->max_values)
+        {
+            // the arguments can be elements of this vector, the new one is made before it grows
+            T value(std::forward<Args>(args)...);
+            this->grow();
+            return *::new (static_cast<void*>(this->values + this->num_values++)) T(std::move(value));
+        }
+        return *::new (static_cast<void*>(this->values + this->num_values++)) T(std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& value) { this->emplace_back(value); }
+    void push_back(T&& value) { this->emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        this->values[--this->num_values].~T();
+    }
+
+    // the capacity stays
+    void clear()
+    {
+        std::destroy_n(this->values, this->num_values);
+        this->num_values = 0;
+    }
+
+    const Growth_stats& stats() const { return this->growth_stats; }
+    void reset_stats() { this->growth_stats = Growth_stats {}; }
+};
+
+#endif
@@ -37,6 +37,8 @@
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <ratio>
+#include "Growable_vector.h"
 
 class Person final
 {
@@ -315,6 +317,62 @@ void test11()
     std::cout << std::endl;
 }
 
+template <typename Vector>
+void display_stats(const std::string& name, const Vector& vec)
+{
+    const Growth_stats& stats = vec.stats();
+    std::cout << name << ": size " << vec.size() << ", capacity " << vec.capacity()
+        << ", reallocations " << stats.reallocations << ", in place " << stats.in_place
+        << ", element moves " << stats.element_moves << std::endl;
+}
+
+void test12()
+{
+    std::cout << std::endl << "test12=========================" << std::endl;
+
+    // a std::vector, the reallocations are the times the capacity changed
+    std::vector<int> vec;
+    std::size_t reallocations {0};
+    for (int i = 0; i < 1'000'000; ++i)
+    {
+        const std::size_t capacity = vec.capacity();
+        vec.push_back(i);
+        reallocations += vec.capacity() != capacity;
+    }
+    std::cout << "std::vector: size " << vec.size() << ", capacity " << vec.capacity()
+        << ", reallocations " << reallocations << std::endl;
+
+    // ints are grown with realloc, some of the times in place
+    Growable_vector<int, std::ratio<2>> doubling;
+    for (int i = 0; i < 1'000'000; ++i)
+        doubling.push_back(i);
+    display_stats("doubling", doubling);
+
+    Growable_vector<int> batch;
+    for (int round = 0; round < 3; ++round)
+    {
+        batch.clear();
+        batch.expect(1'000'000);
+        for (int i = 0; i < 1'000'000; ++i)
+            batch.push_back(i);
+    }
+    display_stats("3 batches, expected", batch);
+
+    // a Person has a std::string, it is moved one by one
+    Growable_vector<Person> people;
+    for (int i = 0; i < 1000; ++i)
+        people.emplace_back("Person", i);
+    display_stats("people", people);
+
+    Growable_vector<Person> expected_people;
+    expected_people.expect(1000);
+    for (int i = 0; i < 1000; ++i)
+        expected_people.emplace_back("Person", i);
+    display_stats("people, expected", expected_people);
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
@@ -328,6 +386,7 @@ int main()
     test9();
     test10();
     test11();
+    test12();
     
     return 0;
 }
@@ -0,0 +1,340 @@
+#ifndef _RING_DEQUE_H_
+#define _RING_DEQUE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../../functions/passingArrayToFunction/Span.h"
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
+/*
+
+    - a Ring_deque is a deque in one array, a ring of a power of 2 elements: the front is at
+      head, the element i is at (head + i) & (capacity - 1), a push or a pop at either end
+      moves head or the size and nothing else, no block of its own like a std::deque
+      allocates every 512 bytes, and no map of the blocks to go through on every index.
+
+    - when it is full the array doubles, the elements are moved to the front of the new one,
+      memcpy for a T that Trivially_relocatable says can be relocated, one by one for the
+      other ones, or copied when their move constructor can throw. a push can invalidate
+      every reference, not the way a push of a std::deque does.
+
+    - the elements are at most two runs of the array: the one from head to the end of the
+      array and the one from its start that wrapped around. as_spans gives both, the first
+      one first, the second one is empty when it did not wrap, a loop over the two spans is
+      a loop over plain arrays the compiler can vectorize. make_contiguous moves them into
+      one when a single span is needed.
+
+    - at out of range throws std::out_of_range, front, back and the pops of an empty deque
+      are undefined, like the ones of std::deque.
+
+*/
+template <typename T>
+class Ring_deque final
+{
+private:
+    T* values;
+    std::size_t head;
+    std::size_t num_values;
+    std::size_t max_values;  // 0 or a power of 2
+
+    std::size_t mask() const { return this->max_values - 1; }
+    std::size_t slot(std::size_t i) const { return (this->head + i) & this->mask(); }
+
+    // the elements move to the front of an array of n, n is a power of 2 not less than the size
+    void reallocate(std::size_t n)
+    {
+        T* grown = std::allocator<T> {}.allocate(n);
+        const std::size_t first = std::min(this->num_values, this->max_values - this->head);
+        if constexpr (Trivially_relocatable<T>::value)
+        {
+            if (this->num_values > 0)
+            {
+                std::memcpy(static_cast<void*>(grown), static_cast<const void*>(this->values + this->head), first * sizeof(T));
+                std::memcpy(static_cast<void*>(grown + first), static_cast<const void*>(this->values),
+                            (this->num_values - first) * sizeof(T));
+            }
+        }
+        else
+        {
+            std::size_t i = 0;
+            try
+            {
+                for (; i < this->num_values; ++i)
+                    ::new (static_cast<void*>(grown + i)) T(std::move_if_noexcept(this->values[this->slot(i)]));
+            }
+            catch (...)
+            {
+                std::destroy_n(grown, i);
+                std::allocator<T> {}.deallocate(grown, n);
+                throw;
+            }
+            std::destroy_n(this->values + this->head, first);
+            std::destroy_n(this->values, this->num_values - first);
+        }
+        if (this->values != nullptr)
+            std::allocator<T> {}.deallocate(this->values, this->max_values);
+        this->values = grown;
+        this->head = 0;
+        this->max_values = n;
+    }
+
+    void grow()
+    {
+        this->reallocate(this->max_values == 0 ? 8 : this->max_values * 2);
+    }
+
+    template <bool Const>
+    class Basic_iterator
+    {
+    private:
+        using Deque = std::conditional_t<Const, const Ring_deque, Ring_deque>;
+
+        Deque* deque {nullptr};
+        std::size_t i {0};
+
+        friend class Ring_deque;
+        friend class Basic_iterator<!Const>;
+
+        Basic_iterator(Deque* deque, std::size_t i) : deque(deque), i(i) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Basic_iterator() = default;
+        // an iterator converts to a const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Basic_iterator(const Basic_iterator<false>& other) : deque(other.deque), i(other.i) {}
+
+        reference operator*() const { return (*this->deque)[this->i]; }
+        pointer operator->() const { return &(*this->deque)[this->i]; }
+        reference operator[](difference_type n) const { return (*this->deque)[this->i + n]; }
+
+        Basic_iterator& operator++() { ++this->i; return *this; }
+        Basic_iterator& operator--() { --this->i; return *this; }
+        Basic_iterator operator++(int) { Basic_iterator old {*this}; ++this->i; return old; }
+        Basic_iterator operator--(int) { Basic_iterator old {*this}; --this->i; return old; }
+        Basic_iterator& operator+=(difference_type n) { this->i += n; return *this; }
+        Basic_iterator& operator-=(difference_type n) { this->i -= n; return *this; }
+
+        friend Basic_iterator operator+(Basic_iterator it, difference_type n) { return it += n; }
+        friend Basic_iterator operator+(difference_type n, Basic_iterator it) { return it += n; }
+        friend Basic_iterator operator-(Basic_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const Basic_iterator& lhs, const Basic_iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.i) - static_cast<difference_type>(rhs.i);
+        }
+
+        friend bool operator==(const Basic_iterator& lhs, const Basic_iterator& rhs) { return lhs.i == rhs.i; }
+        friend bool operator!=(const Basic_iterator& lhs, const Basic_iterator& rhs) { return lhs.i != rhs.i; }
+        friend bool operator<(const Basic_iterator& lhs, const Basic_iterator& rhs) { return lhs.i < rhs.i; }
+        friend bool operator>(const Basic_iterator& lhs, const Basic_iterator& rhs) { return lhs.i > rhs.i; }
+        friend bool operator<=(const Basic_iterator& lhs, const Basic_iterator& rhs) { return lhs.i <= rhs.i; }
+        friend bool operator>=(const Basic_iterator& lhs, const Basic_iterator& rhs) { return lhs.i >= rhs.i; }
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Basic_iterator<false>;
+    using const_iterator = Basic_iterator<true>;
+
+    Ring_deque()
+        : values(nullptr), head(0), num_values(0), max_values(0) {}
+
+    Ring_deque(std::size_t n, const T& value)
+        : Ring_deque()
+    {
+        this->reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            this->push_back(value);
+    }
+
+    Ring_deque(std::initializer_list<T> values)
+        : Ring_deque(values.begin(), values.end()) {}
+
+    template <typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    Ring_deque(It first, It last)
+        : Ring_deque()
+    {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>)
+            this->reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first)
+            this->push_back(*first);
+    }
+
+    Ring_deque(const Ring_deque& source)
+        : Ring_deque(source.begin(), source.end()) {}
+
+    Ring_deque(Ring_deque&& source) noexcept
+        : values(source.values), head(source.head), num_values(source.num_values), max_values(source.max_values)
+    {
+        source.values = nullptr;
+        source.head = source.num_values = source.max_values = 0;
+    }
+
+    Ring_deque& operator=(Ring_deque rhs) noexcept
+    {
+        std::swap(this->values, rhs.values);
+        std::swap(this->head, rhs.head);
+        std::swap(this->num_values, rhs.num_values);
+        std::swap(this->max_values, rhs.max_values);
+        return *this;
+    }
+
+    Ring_deque& operator=(std::initializer_list<T> values)
+    {
+        return *this = Ring_deque {values};
+    }
+
+    ~Ring_deque()
+    {
+        this->clear();
+        if (this->values != nullptr)
+            std::allocator<T> {}.deallocate(this->values, this->max_values);
+    }
+
+    iterator begin() { return iterator {this, 0}; }
+    iterator end() { return iterator {this, this->num_values}; }
+    const_iterator begin() const { return const_iterator {this, 0}; }
+    const_iterator end() const { return const_iterator {this, this->num_values}; }
+    const_iterator cbegin() const { return this->begin(); }
+    const_iterator cend() const { return this->end(); }
+
+    bool empty() const { return this->num_values == 0; }
+    std::size_t size() const { return this->num_values; }
+    std::size_t capacity() const { return this->max_values; }
+
+    T& operator[](std::size_t i) { return this->values[this->slot(i)]; }
+    const T& operator[](std::size_t i) const { return this->values[this->slot(i)]; }
+
+    T& at(std::size_t i)
+    {
+        if (i >= this->num_values)
+            throw std::out_of_range {"Ring_deque::at: the index is out of range"};
+        return (*this)[i];
+    }
+
+    const T& at(std::size_t i) const
+    {
+        return const_cast<Ring_deque*>(this)->at(i);
+    }
+
+    T& front() { return this->values[this->head]; }
+    T& back() { return (*this)[this->num_values - 1]; }
+    const T& front() const { return this->values[this->head]; }
+    const T& back() const { return (*this)[this->num_values - 1]; }
+
+    // the capacity becomes the power of 2 that is not less than n
+    void reserve(std::size_t n)
+    {
+        if (n <= this->max_values)
+            return;
+        std::size_t capacity = this->max_values == 0 ? 8 : this->max_values;
+        while (capacity < n)
+            capacity *= 2;
+        this->reallocate(capacity);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (this->num_values == this->max_values)
+        {
+            // the arguments can be elements of this deque, the new one is made before it grows
+            T value(std::forward<Args>(args)...);
+            this->grow();
+            return *::new (static_cast<void*>(this->values + this->slot(this->num_values++))) T(std::move(value));
+        }
+        T* at = ::new (static_cast<void*>(this->values + this->slot(this->num_values))) T(std::forward<Args>(args)...);
+        ++this->num_values;
+        return *at;
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        if (this->num_values == this->max_values)
+        {
+            T value(std::forward<Args>(args)...);
+            this->grow();
+            const std::size_t at = (this->head - 1) & this->mask();
+            ::new (static_cast<void*>(this->values + at)) T(std::move(value));
+            this->head = at;
+        }
+        else
+        {
+            const std::size_t at = (this->head - 1) & this->mask();
+            ::new (static_cast<void*>(this->values + at)) T(std::forward<Args>(args)...);
+            this->head = at;
+        }
+        ++this->num_values;
+        return this->values[this->head];
+    }
+
+    void push_back(const T& value) { this->emplace_back(value); }
+    void push_back(T&& value) { this->emplace_back(std::move(value)); }
+    void push_front(const T& value) { this->emplace_front(value); }
+    void push_front(T&& value) { this->emplace_front(std::move(value)); }
+
+    void pop_back()
+    {
+        (*this)[--this->num_values].~T();
+    }
+
+    void pop_front()
+    {
+        this->values[this->head].~T();
+        this->head = (this->head + 1) & this->mask();
+        --this->num_values;
+    }
+
+    // the capacity stays
+    void clear()
+    {
+        if (this->num_values == 0)
+            return;
+        const std::size_t first = std::min(this->num_values, this->max_values - this->head);
+        std::destroy_n(this->values + this->head, first);
+        std::destroy_n(this->values, this->num_values - first);
+        this->head = this->num_values = 0;
+    }
+
+    // the run from head and the one that wrapped around to the start of the array
+    std::pair<Span<T>, Span<T>> as_spans()
+    {
+        const std::size_t first = std::min(this->num_values, this->max_values - this->head);
+        return {Span<T> {this->values + this->head, first}, Span<T> {this->values, this->num_values - first}};
+    }
+
+    std::pair<Span<const T>, Span<const T>> as_spans() const
+    {
+        const std::size_t first = std::min(this->num_values, this->max_values - this->head);
+        return {Span<const T> {this->values + this->head, first}, Span<const T> {this->values, this->num_values - first}};
+    }
+
+    // the elements in one run at the start of the array, moved there when they wrap around
+    Span<T> make_contiguous()
+    {
+        if (this->head + this->num_values > this->max_values)
+            this->reallocate(this->max_values);
+        else if (this->num_values == 0)
+            this->head = 0;
+        return Span<T> {this->values + this->head, this->num_values};
+    }
+};
+
+#endif
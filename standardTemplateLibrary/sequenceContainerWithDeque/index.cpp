@@ -37,6 +37,9 @@
 #include <vector>
 #include <deque>
 #include <algorithm>
+#include <cctype>
+#include <string>
+#include "Ring_deque.h"
 
 template<typename T>
 void display(const std::deque<T>& dec)
@@ -153,6 +156,89 @@ void test5()
     std::cout << std::endl;
 }
 
+template<typename T>
+void display(const Ring_deque<T>& dec)
+{
+    std::cout << "[ ";
+    for (const auto& item : dec)
+        std::cout << item << " ";
+    std::cout << "]" << std::endl;
+}
+
+// the letters pushed at the back and compared from both ends
+bool is_palindrome(const std::string& text)
+{
+    Ring_deque<char> letters;
+    for (char c : text)
+        if (std::isalpha(static_cast<unsigned char>(c)))
+            letters.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+
+    while (letters.size() > 1)
+    {
+        if (letters.front() != letters.back())
+            return false;
+        letters.pop_front();
+        letters.pop_back();
+    }
+    return true;
+}
+
+void test6()
+{
+    std::cout << "test6==============================" << std::endl;
+
+    Ring_deque<int> dec {1, 2, 3, 4};
+    dec.push_front(0);
+    dec.push_front(-1);
+    dec.push_back(5);
+    display(dec);
+    std::cout << "size: " << dec.size() << ", capacity: " << dec.capacity() << std::endl;
+
+    // -1 and 0 wrapped around to the end of the array, the elements are two runs of it
+    auto spans = dec.as_spans();
+    std::cout << "spans: " << spans.first.size() << " and " << spans.second.size() << std::endl;
+    int sum {0};
+    for (int value : spans.first)
+        sum += value;
+    for (int value : spans.second)
+        sum += value;
+    std::cout << "sum: " << sum << std::endl;
+
+    dec.make_contiguous();
+    spans = dec.as_spans();
+    std::cout << "spans: " << spans.first.size() << " and " << spans.second.size() << std::endl;
+
+    // the largest of every window of 3, the indexes of the ones that can still be, the largest in front
+    std::vector<int> vec {4, 2, 12, 3, 8, 7, 1, 9, 5};
+    Ring_deque<std::size_t> window;
+    std::cout << "max of 3: ";
+    for (std::size_t i = 0; i < vec.size(); ++i)
+    {
+        while (!window.empty() && vec[window.back()] <= vec[i])
+            window.pop_back();
+        window.push_back(i);
+        if (window.front() + 3 <= i)
+            window.pop_front();
+        if (i >= 2)
+            std::cout << vec[window.front()] << " ";
+    }
+    std::cout << std::endl;
+
+    for (const std::string text : {"A Santa at NASA", "Madam, I'm Adam", "not a palindrome"})
+        std::cout << text << ": " << std::boolalpha << is_palindrome(text) << std::endl;
+
+    try
+    {
+        dec.at(10);
+    }
+    catch (const std::out_of_range& ex)
+    {
+        std::cout << ex.what() << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
@@ -160,6 +246,7 @@ int main()
     test3();
     test4();
     test5();
+    test6();
     
     return 0;
 }
@@ -0,0 +1,516 @@
+#ifndef _UNROLLED_LIST_H_
+#define _UNROLLED_LIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../../oop/moveConstructor/Trivially_relocatable.h"
+
+/*
+
+    - an Unrolled_list is a doubly linked list like std::list, but every node holds a block of
+      up to K elements next to each other, so iterating reads K elements per node it goes to
+      and there is one allocation per block, not one per element.
+
+    - K is 16 by default, or as many as fit in 256 bytes for small elements.
+
+    - insert and erase at an iterator move at most the K elements of one block, an insert into
+      a full block splits it in two halves, or places the element at the end of the block
+      before when it is at the start of the block and that one has room, an erase that leaves
+      a block less than a quarter full merges it with the next one when both fit in half a block.
+
+    - splice of a whole list relinks its blocks, it splits the block at the position when that
+      is in the middle of one, and the single element splice moves the element over.
+
+    - unlike with std::list, an insert or an erase invalidates the iterators and references to
+      the elements of the blocks it changes, the elements of the other blocks stay where they
+      are, splice invalidates the iterators to the elements moved.
+
+*/
+template <typename T, std::size_t K = (sizeof(T) <= 16 ? 256 / sizeof(T) : 16)>
+class Unrolled_list
+{
+    static_assert(K >= 2, "a block holds at least two elements");
+
+private:
+    struct Link
+    {
+        Link* prev;
+        Link* next;
+    };
+
+    struct Node : Link
+    {
+        std::size_t count;
+        alignas(T) unsigned char bytes[sizeof(T) * K];
+
+        T* values() { return reinterpret_cast<T*>(this->bytes); }
+    };
+
+    // the end of the list, its next is the first block and its prev the last one
+    Link sentinel;
+    std::size_t length;
+
+    static Node* node_of(Link* link) { return static_cast<Node*>(link); }
+
+    bool is_node(const Link* link) const { return link != &this->sentinel; }
+
+    Node* new_node_after(Link* link)
+    {
+        Node* node = static_cast<Node*>(::operator new(sizeof(Node), std::align_val_t {alignof(Node)}));
+        node->count = 0;
+        node->prev = link;
+        node->next = link->next;
+        link->next->prev = node;
+        link->next = node;
+        return node;
+    }
+
+    static void unlink(Node* node)
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        ::operator delete(node, std::align_val_t {alignof(Node)});
+    }
+
+    // values [from, from + n) of one block to to, the source is destroyed, in either direction,
+    // one memmove for a Trivially_relocatable T
+    static void relocate(T* from, T* to, std::size_t n)
+    {
+        if constexpr (Trivially_relocatable<T>::value)
+            std::memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+        else if (to < from)
+            for (T* end = from + n; from != end; ++from, ++to)
+            {
+                ::new (to) T(std::move(*from));
+                from->~T();
+            }
+        else
+            for (T *first = from, *source = from + n, *target = to + n; source != first;)
+            {
+                ::new (--target) T(std::move(*--source));
+                source->~T();
+            }
+    }
+
+    // the elements from i on go to a new block after node
+    Node* split(Node* node, std::size_t i)
+    {
+        Node* next = this->new_node_after(node);
+        relocate(node->values() + i, next->values(), node->count - i);
+        next->count = node->count - i;
+        node->count = i;
+        return next;
+    }
+
+    template <typename Value>
+    class Basic_iterator
+    {
+        friend class Unrolled_list;
+
+    private:
+        using Link_pointer = std::conditional_t<std::is_const_v<Value>, const Link*, Link*>;
+
+        Link_pointer link;
+        std::size_t index;
+
+        Basic_iterator(Link_pointer link, std::size_t index)
+            : link(link), index(index) {}
+
+        auto node() const { return static_cast<std::conditional_t<std::is_const_v<Value>, const Node*, Node*>>(this->link); }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = Value&;
+        using pointer = Value*;
+
+        Basic_iterator() : link(nullptr), index(0) {}
+
+        // an iterator converts to a const_iterator
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<Value> && !std::is_const_v<Other>>>
+        Basic_iterator(const Basic_iterator<Other>& other)
+            : link(other.link), index(other.index) {}
+
+        reference operator*() const { return reinterpret_cast<Value*>(this->node()->bytes)[this->index]; }
+        pointer operator->() const { return &**this; }
+
+        Basic_iterator& operator++()
+        {
+            if (++this->index == this->node()->count)
+            {
+                this->link = this->link->next;
+                this->index = 0;
+            }
+            return *this;
+        }
+
+        Basic_iterator operator++(int)
+        {
+            Basic_iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        // the end has index 0 too, so it goes to the last element of the last block
+        Basic_iterator& operator--()
+        {
+            if (this->index == 0)
+            {
+                this->link = this->link->prev;
+                this->index = this->node()->count;
+            }
+            --this->index;
+            return *this;
+        }
+
+        Basic_iterator operator--(int)
+        {
+            Basic_iterator copy = *this;
+            --*this;
+            return copy;
+        }
+
+        template <typename Other>
+        bool operator==(const Basic_iterator<Other>& rhs) const
+        {
+            return this->link == rhs.link && this->index == rhs.index;
+        }
+
+        template <typename Other>
+        bool operator!=(const Basic_iterator<Other>& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        template <typename>
+        friend class Basic_iterator;
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Basic_iterator<T>;
+    using const_iterator = Basic_iterator<const T>;
+
+    static constexpr std::size_t block_size = K;
+
+    Unrolled_list()
+        : sentinel {&this->sentinel, &this->sentinel}, length(0) {}
+
+    Unrolled_list(std::size_t n, const T& value)
+        : Unrolled_list()
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            this->push_back(value);
+    }
+
+    template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    Unrolled_list(Iterator first, Iterator last)
+        : Unrolled_list()
+    {
+        this->insert(this->end(), first, last);
+    }
+
+    Unrolled_list(std::initializer_list<T> values)
+        : Unrolled_list(values.begin(), values.end()) {}
+
+    Unrolled_list(const Unrolled_list& other)
+        : Unrolled_list(other.begin(), other.end()) {}
+
+    Unrolled_list(Unrolled_list&& other) noexcept
+        : Unrolled_list()
+    {
+        this->swap(other);
+    }
+
+    ~Unrolled_list()
+    {
+        this->clear();
+    }
+
+    Unrolled_list& operator=(Unrolled_list rhs) noexcept
+    {
+        this->swap(rhs);
+        return *this;
+    }
+
+    Unrolled_list& operator=(std::initializer_list<T> values)
+    {
+        this->clear();
+        this->insert(this->end(), values.begin(), values.end());
+        return *this;
+    }
+
+    // the sentinels stay where they are, the blocks are relinked to them
+    void swap(Unrolled_list& other) noexcept
+    {
+        std::swap(this->sentinel, other.sentinel);
+        std::swap(this->length, other.length);
+        for (Unrolled_list* list : {this, &other})
+        {
+            if (list->length == 0)
+                list->sentinel.prev = list->sentinel.next = &list->sentinel;
+            else
+                list->sentinel.next->prev = list->sentinel.prev->next = &list->sentinel;
+        }
+    }
+
+    iterator begin() { return iterator {this->sentinel.next, 0}; }
+    iterator end() { return iterator {&this->sentinel, 0}; }
+    const_iterator begin() const { return const_iterator {this->sentinel.next, 0}; }
+    const_iterator end() const { return const_iterator {&this->sentinel, 0}; }
+    const_iterator cbegin() const { return this->begin(); }
+    const_iterator cend() const { return this->end(); }
+
+    bool empty() const { return this->length == 0; }
+    std::size_t size() const { return this->length; }
+
+    T& front() { return *this->begin(); }
+    const T& front() const { return *this->begin(); }
+    T& back() { return *--this->end(); }
+    const T& back() const { return *--this->end(); }
+
+    void clear()
+    {
+        for (Link* link = this->sentinel.next; link != &this->sentinel;)
+        {
+            Node* node = node_of(link);
+            link = link->next;
+            std::destroy_n(node->values(), node->count);
+            ::operator delete(node, std::align_val_t {alignof(Node)});
+        }
+        this->sentinel.prev = this->sentinel.next = &this->sentinel;
+        this->length = 0;
+    }
+
+    // the new element is before position, at the iterator returned
+    template <typename... Args>
+    iterator emplace(const_iterator position, Args&&... args)
+    {
+        Link* link = const_cast<Link*>(position.link);
+        std::size_t i = position.index;
+
+        Node* node;
+        if (i == 0 && this->is_node(link->prev) && node_of(link->prev)->count < K)
+        {
+            // at the end of the block before, nothing moves
+            node = node_of(link->prev);
+            i = node->count;
+        }
+        else if (!this->is_node(link))
+        {
+            node = this->new_node_after(link->prev);
+            i = 0;
+        }
+        else
+        {
+            node = node_of(link);
+            if (node->count == K)
+            {
+                Node* next = this->split(node, K / 2);
+                if (i > K / 2)
+                {
+                    node = next;
+                    i -= K / 2;
+                }
+            }
+        }
+
+        relocate(node->values() + i, node->values() + i + 1, node->count - i);
+        try
+        {
+            ::new (node->values() + i) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            relocate(node->values() + i + 1, node->values() + i, node->count - i);
+            if (node->count == 0)
+                unlink(node);
+            throw;
+        }
+        ++node->count;
+        ++this->length;
+        return iterator {node, i};
+    }
+
+    iterator insert(const_iterator position, const T& value) { return this->emplace(position, value); }
+    iterator insert(const_iterator position, T&& value) { return this->emplace(position, std::move(value)); }
+
+    // the first one inserted is at the iterator returned, or position when the range is empty
+    template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    iterator insert(const_iterator position, Iterator first, Iterator last)
+    {
+        if (first == last)
+            return iterator {const_cast<Link*>(position.link), position.index};
+
+        iterator it = this->emplace(position, *first);
+        std::size_t inserted = 1;
+        for (++first; first != last; ++first, ++inserted)
+            it = this->emplace(++it, *first);
+
+        // a split can move the first one to another block, it is found back from the last one
+        for (; inserted > 1; --inserted)
+            --it;
+        return it;
+    }
+
+    iterator insert(const_iterator position, std::initializer_list<T> values)
+    {
+        return this->insert(position, values.begin(), values.end());
+    }
+
+    // the element after the one erased is at the iterator returned
+    iterator erase(const_iterator position)
+    {
+        Node* node = node_of(const_cast<Link*>(position.link));
+        const std::size_t i = position.index;
+        node->values()[i].~T();
+        relocate(node->values() + i + 1, node->values() + i, node->count - i - 1);
+        --node->count;
+        --this->length;
+
+        if (node->count == 0)
+        {
+            Link* next = node->next;
+            unlink(node);
+            return iterator {next, 0};
+        }
+        if (node->count < K / 4 && this->is_node(node->next) && node->count + node_of(node->next)->count <= K / 2)
+        {
+            Node* next = node_of(node->next);
+            relocate(next->values(), node->values() + node->count, next->count);
+            node->count += next->count;
+            unlink(next);
+        }
+        if (i == node->count)
+            return iterator {node->next, 0};
+        return iterator {node, i};
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        // the count of the range, the iterators move when blocks merge
+        std::size_t n = std::distance(first, last);
+        iterator it {const_cast<Link*>(first.link), first.index};
+        for (; n > 0; --n)
+            it = this->erase(it);
+        return it;
+    }
+
+    void push_back(const T& value) { this->emplace(this->end(), value); }
+    void push_back(T&& value) { this->emplace(this->end(), std::move(value)); }
+    void push_front(const T& value) { this->emplace(this->begin(), value); }
+    void push_front(T&& value) { this->emplace(this->begin(), std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) { return *this->emplace(this->end(), std::forward<Args>(args)...); }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) { return *this->emplace(this->begin(), std::forward<Args>(args)...); }
+
+    void pop_back() { this->erase(--this->end()); }
+    void pop_front() { this->erase(this->begin()); }
+
+    void resize(std::size_t n, const T& value = T {})
+    {
+        while (this->length > n)
+            this->pop_back();
+        while (this->length < n)
+            this->push_back(value);
+    }
+
+    // all the elements of other before position, other is left empty
+    void splice(const_iterator position, Unrolled_list& other)
+    {
+        if (&other == this || other.empty())
+            return;
+
+        Link* link = const_cast<Link*>(position.link);
+        if (position.index > 0)
+            link = this->split(node_of(link), position.index);
+
+        Link* first = other.sentinel.next;
+        Link* last = other.sentinel.prev;
+        first->prev = link->prev;
+        link->prev->next = first;
+        last->next = link;
+        link->prev = last;
+
+        this->length += other.length;
+        other.sentinel.prev = other.sentinel.next = &other.sentinel;
+        other.length = 0;
+    }
+
+    void splice(const_iterator position, Unrolled_list&& other)
+    {
+        this->splice(position, other);
+    }
+
+    // the element of other at it before position
+    void splice(const_iterator position, Unrolled_list& other, const_iterator it)
+    {
+        if (&other == this && (it == position || std::next(it) == position))
+            return;
+        T value = std::move(const_cast<T&>(*it));
+        if (&other == this)
+        {
+            // the erase can move the elements position is at, it is found again by its distance
+            const bool after = std::distance(this->cbegin(), position) > std::distance(this->cbegin(), it);
+            std::size_t index = std::distance(this->cbegin(), position) - (after ? 1 : 0);
+            this->erase(it);
+            this->emplace(std::next(this->cbegin(), index), std::move(value));
+            return;
+        }
+        other.erase(it);
+        this->emplace(position, std::move(value));
+    }
+
+    // a stable sort, the elements are moved to a vector and back, the blocks stay as they are
+    template <typename Compare = std::less<T>>
+    void sort(Compare compare = Compare {})
+    {
+        std::vector<T> values;
+        values.reserve(this->length);
+        for (T& value : *this)
+            values.push_back(std::move(value));
+        std::stable_sort(values.begin(), values.end(), compare);
+        auto value = values.begin();
+        for (T& item : *this)
+            item = std::move(*value++);
+    }
+
+    // the number of blocks, for the benchmarks
+    std::size_t blocks() const
+    {
+        std::size_t count = 0;
+        for (const Link* link = this->sentinel.next; link != &this->sentinel; link = link->next)
+            ++count;
+        return count;
+    }
+};
+
+template <typename T, std::size_t K>
+bool operator==(const Unrolled_list<T, K>& lhs, const Unrolled_list<T, K>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, std::size_t K>
+bool operator!=(const Unrolled_list<T, K>& lhs, const Unrolled_list<T, K>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+#endif
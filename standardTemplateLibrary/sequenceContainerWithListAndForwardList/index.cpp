@@ -35,6 +35,7 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include "Unrolled_list.h"
 
 class Person
 {
@@ -268,6 +269,57 @@ void test9()
     std::cout << std::endl;
 }
 
+template <typename T, std::size_t K>
+void display(const Unrolled_list<T, K>& list)
+{
+    std::cout << "[ ";
+    for (const auto& item : list)
+        std::cout << item << " ";
+    std::cout << "]" << std::endl;
+}
+
+void test10()
+{
+    std::cout << std::endl << "test10===========================" << std::endl;
+
+    // the operations of test7 on blocks of 4, the iterator is found again after every insert
+    Unrolled_list<int, 4> l {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    display(l);
+    std::cout << "blocks: " << l.blocks() << std::endl;
+
+    auto it = std::find(l.begin(), l.end(), 5);
+    if (it != l.end())
+        it = std::next(l.insert(it, 100));
+    display(l);
+
+    Unrolled_list l2 {1000, 2000, 3000};
+    it = std::next(l.insert(it, l2.begin(), l2.end()), 3);
+    display(l);
+
+    std::advance(it, -4);
+    std::cout << *it << std::endl;
+
+    l.erase(it);
+    display(l);
+
+    // the blocks of l3 are linked in, only the block at the position is split
+    Unrolled_list<int, 4> l3 {-1, -2, -3, -4, -5};
+    l.splice(std::next(l.begin(), 2), l3);
+    display(l);
+    std::cout << "size: " << l.size() << ", blocks: " << l.blocks() << ", l3 size: " << l3.size() << std::endl;
+
+    Unrolled_list<Person> stooges
+    {
+        {"Larry", 18},
+        {"Moe", 25},
+        {"Curly", 17}
+    };
+    stooges.sort();
+    display(stooges);
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
@@ -279,6 +331,7 @@ int main()
     test7();
     test8();
     test9();
+    test10();
     
     return 0;
 }
@@ -0,0 +1,154 @@
+/*
+
+    - compares std::list against Unrolled_list (../sequenceContainerWithListAndForwardList/Unrolled_list.h)
+      with the default blocks and blocks of 16 and 64, for int and std::string elements: pushing
+      to the back, iterating, editing at a cursor that moves a few elements at a time like
+      the one of a playlist, inserting and erasing there, splicing lists of 1000 into the
+      middle and erasing every other element, and checks that every list gives the same sums.
+
+    - build it with:
+        g++ -std=c++17 -O2 index.cpp
+
+    - 1'000'000 elements by default, the number can be given on the command line, e.g.
+      ./a.out 100000
+
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include "../sequenceContainerWithListAndForwardList/Unrolled_list.h"
+
+constexpr std::size_t num_edits {1'000'000};
+constexpr std::size_t num_splices {1'000};
+constexpr std::size_t splice_length {1'000};
+
+struct Times
+{
+    double push;
+    double iterate;
+    double edit;
+    double splice;
+    double erase;
+    std::uint64_t sum;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::uint64_t value_of(int value) { return static_cast<std::uint64_t>(value); }
+std::uint64_t value_of(const std::string& value) { return value.size(); }
+
+template <typename T>
+T make(std::size_t i);
+
+template <>
+int make<int>(std::size_t i) { return static_cast<int>(i); }
+
+template <>
+std::string make<std::string>(std::size_t i) { return "song number " + std::to_string(i); }
+
+template <typename List>
+Times run(std::size_t num_values, const std::vector<int>& moves)
+{
+    using T = typename List::value_type;
+    Times times {};
+    List list;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_values; ++i)
+        list.push_back(make<T>(i));
+    times.push = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < 10; ++pass)
+        for (const T& value : list)
+            times.sum += value_of(value);
+    times.iterate = seconds_since(start);
+
+    // the cursor moves back or forward, stops at the ends, and inserts or erases in turn
+    start = std::chrono::steady_clock::now();
+    auto cursor = std::next(list.begin(), list.size() / 2);
+    for (std::size_t i = 0; i < moves.size(); ++i)
+    {
+        for (int step = moves[i]; step > 0 && std::next(cursor) != list.end(); --step)
+            ++cursor;
+        for (int step = moves[i]; step < 0 && cursor != list.begin(); ++step)
+            --cursor;
+        if (i % 2 == 0)
+            cursor = list.insert(cursor, make<T>(i));
+        else
+        {
+            times.sum += value_of(*cursor);
+            cursor = list.erase(cursor);
+            if (cursor == list.end())
+                --cursor;
+        }
+    }
+    times.edit = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_splices; ++i)
+    {
+        List other;
+        for (std::size_t k = 0; k < splice_length; ++k)
+            other.push_back(make<T>(k));
+        list.splice(std::next(list.begin(), splice_length), other);
+    }
+    times.splice = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (auto it = list.begin(); it != list.end();)
+    {
+        it = list.erase(it);
+        if (it != list.end())
+            ++it;
+    }
+    times.erase = seconds_since(start);
+
+    for (const T& value : list)
+        times.sum += value_of(value);
+    times.sum += list.size();
+    return times;
+}
+
+void print(const std::string& name, const Times& times, std::size_t num_values)
+{
+    std::cout << std::setw(30) << std::left << name << std::fixed << std::setprecision(1)
+        << std::setw(10) << std::right << times.push * 1e9 / num_values
+        << std::setw(10) << times.iterate * 1e9 / (10 * num_values)
+        << std::setw(10) << times.edit * 1e9 / num_edits
+        << std::setw(10) << times.splice * 1e9 / (num_splices * splice_length)
+        << std::setw(10) << times.erase * 1e9 / num_values
+        << "    " << times.sum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num_values = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1'000'000;
+
+    std::mt19937 random {42};
+    std::uniform_int_distribution<int> move {-8, 8};
+    std::vector<int> moves(num_edits);
+    for (int& step : moves)
+        step = move(random);
+
+    std::cout << num_values << " elements, ns per push, iterated element, edit, spliced element, erase" << std::endl;
+    print("std::list<int>", run<std::list<int>>(num_values, moves), num_values);
+    print("Unrolled_list<int>", run<Unrolled_list<int>>(num_values, moves), num_values);
+    print("Unrolled_list<int, 16>", run<Unrolled_list<int, 16>>(num_values, moves), num_values);
+    print("std::list<std::string>", run<std::list<std::string>>(num_values, moves), num_values);
+    print("Unrolled_list<std::string>", run<Unrolled_list<std::string>>(num_values, moves), num_values);
+    print("Unrolled_list<std::string, 64>", run<Unrolled_list<std::string, 64>>(num_values, moves), num_values);
+
+    return 0;
+}
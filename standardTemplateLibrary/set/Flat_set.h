@@ -0,0 +1,148 @@
+#ifndef _FLAT_SET_H_
+#define _FLAT_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Flat_set keeps its keys sorted in one vector, no nodes, a lookup is a binary search
+      of contiguous keys and iterating is walking an array, so a set that is built once and
+      read a lot is faster and smaller than a std::set.
+
+    - built from many keys it sorts them and drops the duplicates once, the first of equal
+      keys is kept like std::set does, an insert or an erase of one key moves the keys after
+      it, O(n), it is for sets that change little.
+
+    - lower_bound halves the range without a branch on the compare, the next half is
+      picked with a conditional move, so it does not mispredict.
+
+    - the iterators are the ones of the vector, const, an insert or an erase invalidates them.
+
+*/
+template <typename Key, typename Compare = std::less<Key>>
+class Flat_set
+{
+private:
+    std::vector<Key> keys;
+    Compare compare;
+
+    void sort_and_unique()
+    {
+        std::stable_sort(this->keys.begin(), this->keys.end(), this->compare);
+        auto last = std::unique(this->keys.begin(), this->keys.end(), [this](const Key& a, const Key& b)
+        {
+            return !this->compare(a, b) && !this->compare(b, a);
+        });
+        this->keys.erase(last, this->keys.end());
+    }
+
+    std::size_t lower_index(const Key& key) const
+    {
+        const Key* first = this->keys.data();
+        std::size_t length = this->keys.size();
+        if (length == 0)
+            return 0;
+        while (length > 1)
+        {
+            const std::size_t half = length / 2;
+            first = this->compare(first[half - 1], key) ? first + half : first;
+            length -= half;
+        }
+        return static_cast<std::size_t>(first - this->keys.data()) + this->compare(*first, key);
+    }
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using iterator = typename std::vector<Key>::const_iterator;
+    using const_iterator = iterator;
+
+    Flat_set() = default;
+
+    explicit Flat_set(std::vector<Key> keys, const Compare& compare = Compare {})
+        : keys(std::move(keys)), compare(compare)
+    {
+        this->sort_and_unique();
+    }
+
+    Flat_set(std::initializer_list<Key> list, const Compare& compare = Compare {})
+        : Flat_set(std::vector<Key>(list), compare) {}
+
+    template <typename Iterator>
+    Flat_set(Iterator first, Iterator last, const Compare& compare = Compare {})
+        : Flat_set(std::vector<Key>(first, last), compare) {}
+
+    Flat_set& operator=(std::initializer_list<Key> list)
+    {
+        this->keys.assign(list);
+        this->sort_and_unique();
+        return *this;
+    }
+
+    iterator begin() const { return this->keys.cbegin(); }
+    iterator end() const { return this->keys.cend(); }
+
+    std::size_t size() const { return this->keys.size(); }
+    bool empty() const { return this->keys.empty(); }
+    void clear() { this->keys.clear(); }
+    void reserve(std::size_t n) { this->keys.reserve(n); }
+
+    // the first key not before key
+    iterator lower_bound(const Key& key) const
+    {
+        return this->keys.cbegin() + this->lower_index(key);
+    }
+
+    // the first key after key
+    iterator upper_bound(const Key& key) const
+    {
+        iterator it = this->lower_bound(key);
+        return it != this->end() && !this->compare(key, *it) ? it + 1 : it;
+    }
+
+    iterator find(const Key& key) const
+    {
+        iterator it = this->lower_bound(key);
+        return it != this->end() && !this->compare(key, *it) ? it : this->end();
+    }
+
+    bool contains(const Key& key) const { return this->find(key) != this->end(); }
+    std::size_t count(const Key& key) const { return this->contains(key) ? 1 : 0; }
+
+    // like std::set::insert, the key is not added when an equal one is there
+    std::pair<iterator, bool> insert(Key key)
+    {
+        const std::size_t i = this->lower_index(key);
+        if (i < this->keys.size() && !this->compare(key, this->keys[i]))
+            return {this->keys.cbegin() + i, false};
+        return {this->keys.insert(this->keys.cbegin() + i, std::move(key)), true};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return this->insert(Key(std::forward<Args>(args)...));
+    }
+
+    std::size_t erase(const Key& key)
+    {
+        iterator it = this->find(key);
+        if (it == this->end())
+            return 0;
+        this->keys.erase(it);
+        return 1;
+    }
+
+    iterator erase(iterator it)
+    {
+        return this->keys.erase(it);
+    }
+};
+
+#endif
@@ -0,0 +1,1140 @@
+#ifndef _ROARING_BITMAP_H_
+#define _ROARING_BITMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - a Roaring_bitmap is a set of 32 bit unsigned ints, the roaring bitmap of Lemire et al.,
+      in place of a std::set<int> of line numbers or ids, which is a tree node of about 40
+      bytes per int. header only.
+
+    - the ints are split by their high 16 bits, the low 16 bits of the ones of the same high
+      bits are in one container: a sorted array of up to 4096 of them, 2 bytes each, or a
+      bitmap of 65536 bits, 8 KiB, when there are more, so an int never takes more than 2
+      bytes and a dense range 1 bit. run_optimize turns the containers that are smaller as
+      runs, a start and a length, into run containers, a range of ids is then 4 bytes.
+
+    - |, & and - of two bitmaps go container by container of the same high bits: two bitmaps
+      are 1024 words and, or and and-not with AVX2 or SSE2, counted in the same pass, two
+      arrays are merged, an intersection compares blocks of 8 of each at once with SSE2,
+      galloping when one is 64 times the other, an array and a bitmap test the bits of the
+      array. a run container is turned into an array or a bitmap for them, the result has
+      no runs.
+
+    - the count of every container is kept, so cardinality is a sum over the containers,
+      rank (how many are not greater than a value) and select (the i-th smallest) go to the
+      container of the value and count in it.
+
+    - serialize writes to a buffer of serialized_size bytes given by the caller, e.g. a
+      mapped file, in the byte order of the machine, the data of a container is 8 bytes
+      aligned from the start. a Roaring_view answers contains and cardinality from those
+      bytes without copying them, deserialize checks all of them and builds a bitmap, a
+      damaged buffer throws std::runtime_error.
+
+*/
+namespace detail_roaring_bitmap
+{
+    constexpr std::size_t array_max = 4096;
+    constexpr std::size_t bitmap_words = 1024;
+
+    enum class Kind : std::uint8_t
+    {
+        array = 1,
+        bitmap = 2,
+        run = 3
+    };
+
+    struct Container
+    {
+        Kind kind {Kind::array};
+        std::uint32_t cardinality {0};
+        std::vector<std::uint16_t> values;  // an array, or the start and length - 1 of the runs
+        std::vector<std::uint64_t> words;   // a bitmap
+    };
+
+    inline unsigned popcount(std::uint64_t word)
+    {
+#if defined(__POPCNT__)
+        return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+        // without popcnt __builtin_popcountll is a call to a table
+        word -= (word >> 1) & 0x5555555555555555ULL;
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    enum class Op
+    {
+        both,
+        either,
+        first_only
+    };
+
+#if defined(__AVX2__)
+    // the count of the bits of every 64 bits, the nibbles looked up with a shuffle
+    inline __m256i popcount_words(__m256i v)
+    {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibble));
+        const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        return _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+    }
+#endif
+
+    // out is a op b, the count of its bits
+    template <Op op>
+    std::uint32_t bitmap_op(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out)
+    {
+#if defined(__AVX2__)
+        __m256i counts = _mm256_setzero_si256();
+        for (std::size_t i = 0; i < bitmap_words; i += 4)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i r;
+            if constexpr (op == Op::both)
+                r = _mm256_and_si256(x, y);
+            else if constexpr (op == Op::either)
+                r = _mm256_or_si256(x, y);
+            else
+                r = _mm256_andnot_si256(y, x);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+            counts = _mm256_add_epi64(counts, popcount_words(r));
+        }
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), counts);
+        return static_cast<std::uint32_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+        std::uint32_t count = 0;
+        for (std::size_t i = 0; i < bitmap_words; i += 2)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i r;
+            if constexpr (op == Op::both)
+                r = _mm_and_si128(x, y);
+            else if constexpr (op == Op::either)
+                r = _mm_or_si128(x, y);
+            else
+                r = _mm_andnot_si128(y, x);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+            count += popcount(out[i]) + popcount(out[i + 1]);
+        }
+        return count;
+#else
+        std::uint32_t count = 0;
+        for (std::size_t i = 0; i < bitmap_words; ++i)
+        {
+            if constexpr (op == Op::both)
+                out[i] = a[i] & b[i];
+            else if constexpr (op == Op::either)
+                out[i] = a[i] | b[i];
+            else
+                out[i] = a[i] & ~b[i];
+            count += popcount(out[i]);
+        }
+        return count;
+#endif
+    }
+
+    inline bool bitmap_has(const std::uint64_t* words, std::uint16_t low)
+    {
+        return (words[low >> 6] >> (low & 63)) & 1;
+    }
+
+    // the values of small that are in large, large is at least 64 times longer
+    inline std::size_t gallop_intersect(const std::uint16_t* small, std::size_t small_size,
+                                        const std::uint16_t* large, std::size_t large_size, std::uint16_t* out)
+    {
+        std::size_t count = 0;
+        std::size_t at = 0;
+        for (std::size_t i = 0; i < small_size && at < large_size; ++i)
+        {
+            const std::uint16_t value = small[i];
+            std::size_t step = 1;
+            std::size_t hi = at;
+            while (hi < large_size && large[hi] < value)
+            {
+                at = hi + 1;
+                hi += step;
+                step *= 2;
+            }
+            at = static_cast<std::size_t>(std::lower_bound(large + at, large + std::min(hi + 1, large_size), value) - large);
+            if (at < large_size && large[at] == value)
+                out[count++] = value;
+        }
+        return count;
+    }
+
+    // the values of both sorted arrays, out has room for the shorter one
+    inline std::size_t intersect_arrays(const std::uint16_t* a, std::size_t a_size,
+                                        const std::uint16_t* b, std::size_t b_size, std::uint16_t* out)
+    {
+        if (a_size * 64 < b_size)
+            return gallop_intersect(a, a_size, b, b_size, out);
+        if (b_size * 64 < a_size)
+            return gallop_intersect(b, b_size, a, a_size, out);
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+        std::size_t count = 0;
+#if defined(__SSE2__)
+        // every value of a block of a against every one of a block of b, b rotated 7 times, the
+        // block with the smaller last value is done, its matches kept
+        const std::size_t a_blocks = a_size & ~std::size_t {7};
+        const std::size_t b_blocks = b_size & ~std::size_t {7};
+        if (a_blocks > 0 && b_blocks > 0)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+            unsigned matched = 0;
+            for (;;)
+            {
+                __m128i rotated = y;
+                __m128i any = _mm_cmpeq_epi16(x, rotated);
+                for (int r = 1; r < 8; ++r)
+                {
+                    rotated = _mm_or_si128(_mm_srli_si128(rotated, 2), _mm_slli_si128(rotated, 14));
+                    any = _mm_or_si128(any, _mm_cmpeq_epi16(x, rotated));
+                }
+                matched |= static_cast<unsigned>(_mm_movemask_epi8(any));
+
+                const std::uint16_t a_last = a[i + 7];
+                const std::uint16_t b_last = b[j + 7];
+                if (a_last <= b_last)
+                {
+                    for (int lane = 0; lane < 8; ++lane)
+                        if ((matched >> (2 * lane)) & 1)
+                            out[count++] = a[i + lane];
+                    matched = 0;
+                    i += 8;
+                    if (i == a_blocks)
+                        break;
+                    x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                }
+                if (b_last <= a_last)
+                {
+                    j += 8;
+                    if (j == b_blocks)
+                        break;
+                    y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+                }
+            }
+            // the matches of the block of a are before every value of b that is left, the
+            // merge below does not find them again
+            for (int lane = 0; lane < 8; ++lane)
+                if ((matched >> (2 * lane)) & 1)
+                    out[count++] = a[i + lane];
+        }
+#endif
+        while (i < a_size && j < b_size)
+        {
+            const std::uint16_t x = a[i];
+            const std::uint16_t y = b[j];
+            if (x == y)
+                out[count++] = x;
+            i += x <= y;
+            j += y <= x;
+        }
+        return count;
+    }
+
+    inline std::size_t unite_arrays(const std::uint16_t* a, std::size_t a_size,
+                                    const std::uint16_t* b, std::size_t b_size, std::uint16_t* out)
+    {
+        std::size_t i = 0;
+        std::size_t j = 0;
+        std::size_t count = 0;
+        while (i < a_size && j < b_size)
+        {
+            const std::uint16_t x = a[i];
+            const std::uint16_t y = b[j];
+            out[count++] = x < y ? x : y;
+            i += x <= y;
+            j += y <= x;
+        }
+        while (i < a_size)
+            out[count++] = a[i++];
+        while (j < b_size)
+            out[count++] = b[j++];
+        return count;
+    }
+
+    // the values of a that are not in b
+    inline std::size_t subtract_arrays(const std::uint16_t* a, std::size_t a_size,
+                                       const std::uint16_t* b, std::size_t b_size, std::uint16_t* out)
+    {
+        std::size_t i = 0;
+        std::size_t j = 0;
+        std::size_t count = 0;
+        while (i < a_size && j < b_size)
+        {
+            const std::uint16_t x = a[i];
+            const std::uint16_t y = b[j];
+            out[count] = x;
+            count += x < y;
+            i += x <= y;
+            j += y <= x;
+        }
+        while (i < a_size)
+            out[count++] = a[i++];
+        return count;
+    }
+
+    inline void to_array(Container& c)
+    {
+        std::vector<std::uint16_t> values(c.cardinality);
+        std::uint16_t* out = values.data();
+        for (std::size_t w = 0; w < bitmap_words; ++w)
+            for (std::uint64_t word = c.words[w]; word != 0; word &= word - 1)
+                *out++ = static_cast<std::uint16_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(word)));
+        c.values.swap(values);
+        std::vector<std::uint64_t>().swap(c.words);
+        c.kind = Kind::array;
+    }
+
+    inline void to_bitmap(Container& c)
+    {
+        c.words.assign(bitmap_words, 0);
+        for (std::uint16_t value : c.values)
+            c.words[value >> 6] |= std::uint64_t {1} << (value & 63);
+        std::vector<std::uint16_t>().swap(c.values);
+        c.kind = Kind::bitmap;
+    }
+
+    // the array or the bitmap of the count of the container
+    inline Container general(const Container& c)
+    {
+        if (c.kind != Kind::run)
+            return c;
+        Container out;
+        out.cardinality = c.cardinality;
+        if (c.cardinality <= array_max)
+        {
+            out.values.reserve(c.cardinality);
+            for (std::size_t r = 0; r < c.values.size(); r += 2)
+                for (std::uint32_t v = c.values[r]; v <= static_cast<std::uint32_t>(c.values[r]) + c.values[r + 1]; ++v)
+                    out.values.push_back(static_cast<std::uint16_t>(v));
+            return out;
+        }
+        out.kind = Kind::bitmap;
+        out.words.assign(bitmap_words, 0);
+        for (std::size_t r = 0; r < c.values.size(); r += 2)
+        {
+            const std::uint32_t first = c.values[r];
+            const std::uint32_t last = first + c.values[r + 1];
+            for (std::uint32_t w = first >> 6; w <= last >> 6; ++w)
+            {
+                const std::uint32_t from = std::max(first, w * 64) - w * 64;
+                const std::uint32_t to = std::min(last, w * 64 + 63) - w * 64;
+                const std::uint64_t ones = to - from == 63 ? ~std::uint64_t {0} : ((std::uint64_t {1} << (to - from + 1)) - 1);
+                out.words[w] |= ones << from;
+            }
+        }
+        return out;
+    }
+
+    // a bitmap that is small enough is an array
+    inline void shrink(Container& c)
+    {
+        if (c.kind == Kind::bitmap && c.cardinality <= array_max)
+            to_array(c);
+    }
+
+    inline bool contains(const Container& c, std::uint16_t low)
+    {
+        if (c.kind == Kind::bitmap)
+            return bitmap_has(c.words.data(), low);
+        if (c.kind == Kind::array)
+            return std::binary_search(c.values.begin(), c.values.end(), low);
+        // the last run that starts at or before low
+        std::size_t lo = 0;
+        std::size_t hi = c.values.size() / 2;
+        while (lo < hi)
+        {
+            const std::size_t mid = (lo + hi) / 2;
+            if (c.values[2 * mid] <= low)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo > 0 && low <= static_cast<std::uint32_t>(c.values[2 * lo - 2]) + c.values[2 * lo - 1];
+    }
+
+    // the values not greater than low
+    inline std::uint32_t rank(const Container& c, std::uint16_t low)
+    {
+        if (c.kind == Kind::array)
+            return static_cast<std::uint32_t>(std::upper_bound(c.values.begin(), c.values.end(), low) - c.values.begin());
+        std::uint32_t count = 0;
+        if (c.kind == Kind::bitmap)
+        {
+            const std::size_t last = low >> 6;
+            for (std::size_t w = 0; w < last; ++w)
+                count += popcount(c.words[w]);
+            const unsigned bit = low & 63;
+            const std::uint64_t upto = bit == 63 ? ~std::uint64_t {0} : (std::uint64_t {1} << (bit + 1)) - 1;
+            return count + popcount(c.words[last] & upto);
+        }
+        for (std::size_t r = 0; r < c.values.size() && c.values[r] <= low; r += 2)
+            count += std::min<std::uint32_t>(static_cast<std::uint32_t>(c.values[r]) + c.values[r + 1], low) - c.values[r] + 1;
+        return count;
+    }
+
+    // the i-th smallest, i is less than the count
+    inline std::uint16_t select(const Container& c, std::uint32_t i)
+    {
+        if (c.kind == Kind::array)
+            return c.values[i];
+        if (c.kind == Kind::bitmap)
+        {
+            std::size_t w = 0;
+            for (;; ++w)
+            {
+                const unsigned ones = popcount(c.words[w]);
+                if (i < ones)
+                    break;
+                i -= ones;
+            }
+            std::uint64_t word = c.words[w];
+            for (; i > 0; --i)
+                word &= word - 1;
+            return static_cast<std::uint16_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(word)));
+        }
+        for (std::size_t r = 0;; r += 2)
+        {
+            const std::uint32_t length = static_cast<std::uint32_t>(c.values[r + 1]) + 1;
+            if (i < length)
+                return static_cast<std::uint16_t>(c.values[r] + i);
+            i -= length;
+        }
+    }
+
+    // true when low was not there
+    inline bool add(Container& c, std::uint16_t low)
+    {
+        if (c.kind == Kind::run)
+        {
+            if (contains(c, low))
+                return false;
+            c = general(c);
+        }
+        if (c.kind == Kind::bitmap)
+        {
+            std::uint64_t& word = c.words[low >> 6];
+            const std::uint64_t bit = std::uint64_t {1} << (low & 63);
+            if (word & bit)
+                return false;
+            word |= bit;
+            ++c.cardinality;
+            return true;
+        }
+        // the values of ids and lines come in order, most adds are at the end
+        if (c.values.empty() || c.values.back() < low)
+            c.values.push_back(low);
+        else
+        {
+            auto at = std::lower_bound(c.values.begin(), c.values.end(), low);
+            if (*at == low)
+                return false;
+            c.values.insert(at, low);
+        }
+        if (++c.cardinality > array_max)
+            to_bitmap(c);
+        return true;
+    }
+
+    // true when low was there
+    inline bool remove(Container& c, std::uint16_t low)
+    {
+        if (!contains(c, low))
+            return false;
+        if (c.kind == Kind::run)
+            c = general(c);
+        if (c.kind == Kind::bitmap)
+            c.words[low >> 6] &= ~(std::uint64_t {1} << (low & 63));
+        else
+            c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+        --c.cardinality;
+        shrink(c);
+        return true;
+    }
+
+    // the number of runs of consecutive values
+    inline std::size_t count_runs(const Container& c)
+    {
+        if (c.kind == Kind::run)
+            return c.values.size() / 2;
+        std::size_t runs = 0;
+        if (c.kind == Kind::array)
+        {
+            for (std::size_t i = 0; i < c.values.size(); ++i)
+                runs += i == 0 || c.values[i] != c.values[i - 1] + 1;
+            return runs;
+        }
+        // a run starts at a 1 after a 0, the bit before bit 0 is the top of the word before
+        std::uint64_t carry = 0;
+        for (std::uint64_t word : c.words)
+        {
+            runs += popcount(word & ~(word << 1 | carry));
+            carry = word >> 63;
+        }
+        return runs;
+    }
+
+    // the smallest of an array, a bitmap and runs
+    inline void optimize(Container& c)
+    {
+        const std::size_t runs = count_runs(c);
+        const std::size_t run_bytes = 4 * runs;
+        const std::size_t other_bytes = c.cardinality <= array_max ? 2 * static_cast<std::size_t>(c.cardinality) : 8 * bitmap_words;
+        if (run_bytes >= other_bytes)
+        {
+            if (c.kind == Kind::run)
+                c = general(c);
+            return;
+        }
+        if (c.kind == Kind::run)
+            return;
+
+        std::vector<std::uint16_t> pairs;
+        pairs.reserve(2 * runs);
+        std::uint32_t start = 0;
+        std::uint32_t previous = 0;
+        bool open = false;
+        const auto value = [&](std::uint32_t v)
+        {
+            if (open && v == previous + 1)
+            {
+                previous = v;
+                return;
+            }
+            if (open)
+            {
+                pairs.push_back(static_cast<std::uint16_t>(start));
+                pairs.push_back(static_cast<std::uint16_t>(previous - start));
+            }
+            start = previous = v;
+            open = true;
+        };
+        if (c.kind == Kind::array)
+            for (std::uint16_t v : c.values)
+                value(v);
+        else
+            for (std::size_t w = 0; w < bitmap_words; ++w)
+                for (std::uint64_t word = c.words[w]; word != 0; word &= word - 1)
+                    value(static_cast<std::uint32_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(word))));
+        if (open)
+        {
+            pairs.push_back(static_cast<std::uint16_t>(start));
+            pairs.push_back(static_cast<std::uint16_t>(previous - start));
+        }
+        c.values.swap(pairs);
+        std::vector<std::uint64_t>().swap(c.words);
+        c.kind = Kind::run;
+    }
+
+    // the values of an array that are, or are not, in a bitmap
+    inline Container filter(const Container& array, const Container& bitmap, bool keep)
+    {
+        Container out;
+        out.values.reserve(array.values.size());
+        for (std::uint16_t value : array.values)
+            if (bitmap_has(bitmap.words.data(), value) == keep)
+                out.values.push_back(value);
+        out.cardinality = static_cast<std::uint32_t>(out.values.size());
+        return out;
+    }
+
+    // a op b of an array or a bitmap each
+    template <Op op>
+    Container combine(const Container& a, const Container& b)
+    {
+        Container out;
+        if (a.kind == Kind::bitmap && b.kind == Kind::bitmap)
+        {
+            out.kind = Kind::bitmap;
+            out.words.resize(bitmap_words);
+            out.cardinality = bitmap_op<op>(a.words.data(), b.words.data(), out.words.data());
+            shrink(out);
+            return out;
+        }
+
+        if (a.kind == Kind::array && b.kind == Kind::array)
+        {
+            const std::uint16_t* x = a.values.data();
+            const std::uint16_t* y = b.values.data();
+            std::size_t count;
+            if constexpr (op == Op::both)
+            {
+                out.values.resize(std::min(a.values.size(), b.values.size()));
+                count = intersect_arrays(x, a.values.size(), y, b.values.size(), out.values.data());
+            }
+            else if constexpr (op == Op::either)
+            {
+                out.values.resize(a.values.size() + b.values.size());
+                count = unite_arrays(x, a.values.size(), y, b.values.size(), out.values.data());
+            }
+            else
+            {
+                out.values.resize(a.values.size());
+                count = subtract_arrays(x, a.values.size(), y, b.values.size(), out.values.data());
+            }
+            out.values.resize(count);
+            out.cardinality = static_cast<std::uint32_t>(count);
+            if (count > array_max)
+                to_bitmap(out);
+            return out;
+        }
+
+        // an array and a bitmap
+        if constexpr (op == Op::both)
+            return a.kind == Kind::array ? filter(a, b, true) : filter(b, a, true);
+        else if constexpr (op == Op::first_only)
+        {
+            if (a.kind == Kind::array)
+                return filter(a, b, false);
+            out = a;
+            for (std::uint16_t value : b.values)
+            {
+                std::uint64_t& word = out.words[value >> 6];
+                out.cardinality -= (word >> (value & 63)) & 1;
+                word &= ~(std::uint64_t {1} << (value & 63));
+            }
+            shrink(out);
+            return out;
+        }
+        else
+        {
+            const Container& array = a.kind == Kind::array ? a : b;
+            out = a.kind == Kind::array ? b : a;
+            for (std::uint16_t value : array.values)
+            {
+                std::uint64_t& word = out.words[value >> 6];
+                out.cardinality += ((word >> (value & 63)) & 1) ^ 1;
+                word |= std::uint64_t {1} << (value & 63);
+            }
+            return out;
+        }
+    }
+
+    template <Op op>
+    Container combine_any(const Container& a, const Container& b)
+    {
+        if (a.kind != Kind::run && b.kind != Kind::run)
+            return combine<op>(a, b);
+        return combine<op>(general(a), general(b));
+    }
+
+    template <typename T>
+    void put(char*& out, const T& value)
+    {
+        std::memcpy(out, &value, sizeof value);
+        out += sizeof value;
+    }
+
+    template <typename T>
+    T load(const char* at)
+    {
+        T value;
+        std::memcpy(&value, at, sizeof value);
+        return value;
+    }
+
+    // the header is the magic, the byte order and the number of containers
+    constexpr char magic[8] = {'r', 'o', 'a', 'r', 'i', 'n', 'g', '\0'};
+    constexpr std::uint32_t byte_order = 0x01020304;
+    constexpr std::size_t header_size = 16;
+    // the high bits, the kind, a 0, the count - 1, the number of values or words, the offset
+    constexpr std::size_t entry_size = 16;
+
+    inline std::size_t data_size(const Container& c)
+    {
+        const std::size_t bytes = c.kind == Kind::bitmap ? c.words.size() * 8 : c.values.size() * 2;
+        return (bytes + 7) & ~std::size_t {7};
+    }
+
+    [[noreturn]] inline void invalid(const std::string& what)
+    {
+        throw std::runtime_error("roaring bitmap: " + what);
+    }
+}
+
+class Roaring_view;
+
+class Roaring_bitmap
+{
+private:
+    using Container = detail_roaring_bitmap::Container;
+    using Kind = detail_roaring_bitmap::Kind;
+    using Op = detail_roaring_bitmap::Op;
+
+    friend class Roaring_view;
+
+    std::vector<std::uint16_t> keys;  // the high 16 bits, sorted
+    std::vector<Container> containers;
+
+    // the container of high, or where it goes
+    std::size_t lower_index(std::uint16_t high) const
+    {
+        if (!this->keys.empty() && this->keys.back() == high)
+            return this->keys.size() - 1;
+        return static_cast<std::size_t>(std::lower_bound(this->keys.begin(), this->keys.end(), high) - this->keys.begin());
+    }
+
+    template <Op op>
+    static Roaring_bitmap combine(const Roaring_bitmap& a, const Roaring_bitmap& b)
+    {
+        Roaring_bitmap out;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < a.keys.size() || j < b.keys.size())
+        {
+            const bool has_a = i < a.keys.size();
+            const bool has_b = j < b.keys.size();
+            if (has_a && (!has_b || a.keys[i] < b.keys[j]))
+            {
+                if (op != Op::both)
+                    out.push_back(a.keys[i], a.containers[i]);
+                ++i;
+            }
+            else if (has_b && (!has_a || b.keys[j] < a.keys[i]))
+            {
+                if (op == Op::either)
+                    out.push_back(b.keys[j], b.containers[j]);
+                ++j;
+            }
+            else
+            {
+                Container c = detail_roaring_bitmap::combine_any<op>(a.containers[i], b.containers[j]);
+                if (c.cardinality > 0)
+                    out.push_back(a.keys[i], std::move(c));
+                ++i;
+                ++j;
+            }
+        }
+        return out;
+    }
+
+    void push_back(std::uint16_t high, Container c)
+    {
+        this->keys.push_back(high);
+        this->containers.push_back(std::move(c));
+    }
+
+public:
+    Roaring_bitmap() = default;
+
+    Roaring_bitmap(std::initializer_list<std::uint32_t> values)
+        : Roaring_bitmap(values.begin(), values.end()) {}
+
+    // in order is the fastest, every value goes at the end of its container
+    template <typename Iterator>
+    Roaring_bitmap(Iterator first, Iterator last)
+    {
+        for (; first != last; ++first)
+            this->add(static_cast<std::uint32_t>(*first));
+    }
+
+    // true when value was not there
+    bool add(std::uint32_t value)
+    {
+        const std::uint16_t high = static_cast<std::uint16_t>(value >> 16);
+        const std::size_t i = this->lower_index(high);
+        if (i == this->keys.size() || this->keys[i] != high)
+        {
+            this->keys.insert(this->keys.begin() + static_cast<std::ptrdiff_t>(i), high);
+            this->containers.insert(this->containers.begin() + static_cast<std::ptrdiff_t>(i), Container {});
+        }
+        return detail_roaring_bitmap::add(this->containers[i], static_cast<std::uint16_t>(value));
+    }
+
+    // true when value was there
+    bool remove(std::uint32_t value)
+    {
+        const std::uint16_t high = static_cast<std::uint16_t>(value >> 16);
+        const std::size_t i = this->lower_index(high);
+        if (i == this->keys.size() || this->keys[i] != high)
+            return false;
+        if (!detail_roaring_bitmap::remove(this->containers[i], static_cast<std::uint16_t>(value)))
+            return false;
+        if (this->containers[i].cardinality == 0)
+        {
+            this->keys.erase(this->keys.begin() + static_cast<std::ptrdiff_t>(i));
+            this->containers.erase(this->containers.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        return true;
+    }
+
+    bool contains(std::uint32_t value) const
+    {
+        const std::uint16_t high = static_cast<std::uint16_t>(value >> 16);
+        const std::size_t i = this->lower_index(high);
+        return i < this->keys.size() && this->keys[i] == high
+            && detail_roaring_bitmap::contains(this->containers[i], static_cast<std::uint16_t>(value));
+    }
+
+    std::uint64_t cardinality() const
+    {
+        std::uint64_t count = 0;
+        for (const Container& c : this->containers)
+            count += c.cardinality;
+        return count;
+    }
+
+    bool empty() const { return this->keys.empty(); }
+    void clear()
+    {
+        this->keys.clear();
+        this->containers.clear();
+    }
+
+    // the values not greater than value
+    std::uint64_t rank(std::uint32_t value) const
+    {
+        const std::uint16_t high = static_cast<std::uint16_t>(value >> 16);
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < this->keys.size() && this->keys[i] <= high; ++i)
+            count += this->keys[i] < high ? this->containers[i].cardinality
+                : detail_roaring_bitmap::rank(this->containers[i], static_cast<std::uint16_t>(value));
+        return count;
+    }
+
+    // the i-th smallest value, from 0, false when there are not that many
+    bool select(std::uint64_t i, std::uint32_t& value) const
+    {
+        for (std::size_t c = 0; c < this->containers.size(); ++c)
+        {
+            if (i < this->containers[c].cardinality)
+            {
+                value = static_cast<std::uint32_t>(this->keys[c]) << 16
+                    | detail_roaring_bitmap::select(this->containers[c], static_cast<std::uint32_t>(i));
+                return true;
+            }
+            i -= this->containers[c].cardinality;
+        }
+        return false;
+    }
+
+    // the containers that are smaller as runs become runs, the others stop being runs
+    void run_optimize()
+    {
+        for (Container& c : this->containers)
+            detail_roaring_bitmap::optimize(c);
+    }
+
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (std::size_t i = 0; i < this->keys.size(); ++i)
+        {
+            const std::uint32_t high = static_cast<std::uint32_t>(this->keys[i]) << 16;
+            const Container& c = this->containers[i];
+            if (c.kind == Kind::array)
+                for (std::uint16_t low : c.values)
+                    f(high | low);
+            else if (c.kind == Kind::bitmap)
+                for (std::size_t w = 0; w < detail_roaring_bitmap::bitmap_words; ++w)
+                    for (std::uint64_t word = c.words[w]; word != 0; word &= word - 1)
+                        f(high | static_cast<std::uint32_t>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(word))));
+            else
+                for (std::size_t r = 0; r < c.values.size(); r += 2)
+                    for (std::uint32_t low = c.values[r]; low <= static_cast<std::uint32_t>(c.values[r]) + c.values[r + 1]; ++low)
+                        f(high | low);
+        }
+    }
+
+    std::vector<std::uint32_t> to_vector() const
+    {
+        std::vector<std::uint32_t> values;
+        values.reserve(static_cast<std::size_t>(this->cardinality()));
+        this->for_each([&values](std::uint32_t value) { values.push_back(value); });
+        return values;
+    }
+
+    // the bytes of the containers, not of the object
+    std::size_t get_memory() const
+    {
+        std::size_t bytes = this->keys.capacity() * sizeof(std::uint16_t) + this->containers.capacity() * sizeof(Container);
+        for (const Container& c : this->containers)
+            bytes += c.values.capacity() * sizeof(std::uint16_t) + c.words.capacity() * sizeof(std::uint64_t);
+        return bytes;
+    }
+
+    std::size_t get_num_containers() const { return this->keys.size(); }
+
+    friend Roaring_bitmap operator|(const Roaring_bitmap& a, const Roaring_bitmap& b) { return combine<Op::either>(a, b); }
+    friend Roaring_bitmap operator&(const Roaring_bitmap& a, const Roaring_bitmap& b) { return combine<Op::both>(a, b); }
+    friend Roaring_bitmap operator-(const Roaring_bitmap& a, const Roaring_bitmap& b) { return combine<Op::first_only>(a, b); }
+
+    Roaring_bitmap& operator|=(const Roaring_bitmap& rhs) { return *this = *this | rhs; }
+    Roaring_bitmap& operator&=(const Roaring_bitmap& rhs) { return *this = *this & rhs; }
+    Roaring_bitmap& operator-=(const Roaring_bitmap& rhs) { return *this = *this - rhs; }
+
+    // the same values, whatever their containers are
+    bool operator==(const Roaring_bitmap& rhs) const
+    {
+        if (this->keys != rhs.keys)
+            return false;
+        for (std::size_t i = 0; i < this->keys.size(); ++i)
+        {
+            if (this->containers[i].cardinality != rhs.containers[i].cardinality)
+                return false;
+            const Container a = detail_roaring_bitmap::general(this->containers[i]);
+            const Container b = detail_roaring_bitmap::general(rhs.containers[i]);
+            if (a.values != b.values || a.words != b.words)
+                return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const Roaring_bitmap& rhs) const { return !(*this == rhs); }
+
+    std::size_t serialized_size() const
+    {
+        std::size_t size = detail_roaring_bitmap::header_size + this->keys.size() * detail_roaring_bitmap::entry_size;
+        for (const Container& c : this->containers)
+            size += detail_roaring_bitmap::data_size(c);
+        return size;
+    }
+
+    // out has room for serialized_size bytes
+    void serialize(char* out) const
+    {
+        using namespace detail_roaring_bitmap;
+        std::memcpy(out, magic, sizeof magic);
+        out += sizeof magic;
+        put(out, byte_order);
+        put(out, static_cast<std::uint32_t>(this->keys.size()));
+
+        std::uint32_t offset = static_cast<std::uint32_t>(header_size + this->keys.size() * entry_size);
+        for (std::size_t i = 0; i < this->keys.size(); ++i)
+        {
+            const Container& c = this->containers[i];
+            put(out, this->keys[i]);
+            put(out, static_cast<std::uint8_t>(c.kind));
+            put(out, std::uint8_t {0});
+            put(out, c.cardinality - 1);
+            put(out, static_cast<std::uint32_t>(c.kind == Kind::bitmap ? c.words.size() : c.values.size()));
+            put(out, offset);
+            offset += static_cast<std::uint32_t>(data_size(c));
+        }
+        for (const Container& c : this->containers)
+        {
+            const std::size_t size = data_size(c);
+            std::memset(out, 0, size);
+            if (c.kind == Kind::bitmap)
+                std::memcpy(out, c.words.data(), c.words.size() * 8);
+            else
+                std::memcpy(out, c.values.data(), c.values.size() * 2);
+            out += size;
+        }
+    }
+
+    std::string serialize() const
+    {
+        std::string bytes(this->serialized_size(), '\0');
+        this->serialize(&bytes[0]);
+        return bytes;
+    }
+
+    static Roaring_bitmap deserialize(std::string_view bytes);
+};
+
+// the bytes of Roaring_bitmap::serialize, read where they are, they outlive the view
+class Roaring_view
+{
+private:
+    using Kind = detail_roaring_bitmap::Kind;
+
+    struct Entry
+    {
+        std::uint16_t key;
+        Kind kind;
+        std::uint32_t cardinality;
+        std::uint32_t size;
+        std::uint32_t offset;
+    };
+
+    std::string_view bytes;
+    std::uint32_t count {0};
+    std::uint64_t total {0};
+
+    Entry entry(std::size_t i) const
+    {
+        using detail_roaring_bitmap::load;
+        const char* at = this->bytes.data() + detail_roaring_bitmap::header_size + i * detail_roaring_bitmap::entry_size;
+        return Entry {load<std::uint16_t>(at), static_cast<Kind>(load<std::uint8_t>(at + 2)),
+                      load<std::uint32_t>(at + 4) + 1, load<std::uint32_t>(at + 8), load<std::uint32_t>(at + 12)};
+    }
+
+    std::uint16_t value16(const Entry& e, std::size_t i) const
+    {
+        return detail_roaring_bitmap::load<std::uint16_t>(this->bytes.data() + e.offset + 2 * i);
+    }
+
+public:
+    // checks the header and the containers, not every value
+    explicit Roaring_view(std::string_view bytes) : bytes{bytes}
+    {
+        using namespace detail_roaring_bitmap;
+        if (bytes.size() < header_size || std::memcmp(bytes.data(), magic, sizeof magic) != 0)
+            invalid("not one");
+        if (load<std::uint32_t>(bytes.data() + 8) != byte_order)
+            invalid("written in another byte order");
+        this->count = load<std::uint32_t>(bytes.data() + 12);
+        if (this->count > 65536 || (bytes.size() - header_size) / entry_size < this->count)
+            invalid("the containers are cut");
+
+        std::uint64_t end = header_size + static_cast<std::uint64_t>(this->count) * entry_size;
+        for (std::size_t i = 0; i < this->count; ++i)
+        {
+            const Entry e = this->entry(i);
+            if (i > 0 && e.key <= this->entry(i - 1).key)
+                invalid("the containers are not sorted");
+            const bool fits = e.cardinality > 0 && ((e.kind == Kind::array && e.size == e.cardinality && e.cardinality <= array_max)
+                || (e.kind == Kind::bitmap && e.size == bitmap_words && e.cardinality > array_max && e.cardinality <= 65536)
+                || (e.kind == Kind::run && e.size > 0 && e.size % 2 == 0 && e.size <= 65536 && e.cardinality <= 65536));
+            if (!fits)
+                invalid("container " + std::to_string(i) + " is damaged");
+            const std::uint64_t bytes_of = e.kind == Kind::bitmap ? 8 * std::uint64_t {e.size} : 2 * std::uint64_t {e.size};
+            if (e.offset != end || e.offset + bytes_of > bytes.size())
+                invalid("the data of container " + std::to_string(i) + " is out of place");
+            end = e.offset + ((bytes_of + 7) & ~std::uint64_t {7});
+            this->total += e.cardinality;
+        }
+    }
+
+    std::uint64_t cardinality() const { return this->total; }
+    std::size_t get_num_containers() const { return this->count; }
+
+    bool contains(std::uint32_t value) const
+    {
+        const std::uint16_t high = static_cast<std::uint16_t>(value >> 16);
+        const std::uint16_t low = static_cast<std::uint16_t>(value);
+        std::size_t lo = 0;
+        std::size_t hi = this->count;
+        while (lo < hi)
+        {
+            const std::size_t mid = (lo + hi) / 2;
+            if (this->entry(mid).key < high)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == this->count)
+            return false;
+        const Entry e = this->entry(lo);
+        if (e.key != high)
+            return false;
+
+        if (e.kind == Kind::bitmap)
+            return (detail_roaring_bitmap::load<std::uint64_t>(this->bytes.data() + e.offset + 8 * (low >> 6)) >> (low & 63)) & 1;
+        if (e.kind == Kind::array)
+        {
+            lo = 0;
+            hi = e.size;
+            while (lo < hi)
+            {
+                const std::size_t mid = (lo + hi) / 2;
+                if (this->value16(e, mid) < low)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo < e.size && this->value16(e, lo) == low;
+        }
+        lo = 0;
+        hi = e.size / 2;
+        while (lo < hi)
+        {
+            const std::size_t mid = (lo + hi) / 2;
+            if (this->value16(e, 2 * mid) <= low)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo > 0 && low <= static_cast<std::uint32_t>(this->value16(e, 2 * lo - 2)) + this->value16(e, 2 * lo - 1);
+    }
+
+    // a copy of the bitmap, every value checked
+    Roaring_bitmap to_bitmap() const
+    {
+        using namespace detail_roaring_bitmap;
+        Roaring_bitmap out;
+        out.keys.reserve(this->count);
+        out.containers.reserve(this->count);
+        for (std::size_t i = 0; i < this->count; ++i)
+        {
+            const Entry e = this->entry(i);
+            Container c;
+            c.kind = e.kind;
+            c.cardinality = e.cardinality;
+            const char* data = this->bytes.data() + e.offset;
+            if (e.kind == Kind::bitmap)
+            {
+                c.words.resize(e.size);
+                std::memcpy(c.words.data(), data, 8 * std::size_t {e.size});
+                std::uint32_t ones = 0;
+                for (std::uint64_t word : c.words)
+                    ones += popcount(word);
+                if (ones != e.cardinality)
+                    invalid("the count of container " + std::to_string(i) + " is wrong");
+            }
+            else
+            {
+                c.values.resize(e.size);
+                std::memcpy(c.values.data(), data, 2 * std::size_t {e.size});
+                if (e.kind == Kind::array)
+                {
+                    for (std::size_t v = 1; v < c.values.size(); ++v)
+                        if (c.values[v] <= c.values[v - 1])
+                            invalid("the values of container " + std::to_string(i) + " are not sorted");
+                }
+                else
+                {
+                    std::uint64_t ones = 0;
+                    for (std::size_t r = 0; r < c.values.size(); r += 2)
+                    {
+                        const std::uint32_t first = c.values[r];
+                        const std::uint32_t last = first + c.values[r + 1];
+                        if (last > 65535 || (r > 0 && first <= static_cast<std::uint32_t>(c.values[r - 2]) + c.values[r - 1] + 1))
+                            invalid("the runs of container " + std::to_string(i) + " overlap");
+                        ones += last - first + 1;
+                    }
+                    if (ones != e.cardinality)
+                        invalid("the count of container " + std::to_string(i) + " is wrong");
+                }
+            }
+            out.push_back(e.key, std::move(c));
+        }
+        return out;
+    }
+};
+
+inline Roaring_bitmap Roaring_bitmap::deserialize(std::string_view bytes)
+{
+    return Roaring_view {bytes}.to_bitmap();
+}
+
+#endif
@@ -17,6 +17,8 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include "Flat_set.h"
+#include "Roaring_bitmap.h"
 
 class Person
 {
@@ -48,6 +50,15 @@ void display(const std::set<T>& set)
     std::cout << "]" << std::endl;
 }
 
+template <typename T>
+void display(const Flat_set<T>& set)
+{
+    std::cout << "[ ";
+    for (const auto& item : set)
+        std::cout << item << " ";
+    std::cout << "]" << std::endl;
+}
+
 void test1()
 {
     std::cout << std::endl << "test1==================================" << std::endl;
@@ -131,11 +142,76 @@ void test3()
     std::cout << std::endl;
 }
 
+void test4()
+{
+    std::cout << std::endl << "test4==================================" << std::endl;
+
+    // the keys are sorted and the duplicates dropped once, then it is searched like an array
+    Flat_set<int> s {10, 2, 8, 2, 4, 6, 4};
+    display(s);
+
+    auto result = s.insert(5);
+    display(s);
+
+    std::cout << std::boolalpha;
+    std::cout << *result.first << std::endl;
+    std::cout << result.second << std::endl;
+
+    std::cout << "First not before 7: " << *s.lower_bound(7) << std::endl;
+    std::cout << "Count for 3: " << s.count(3) << std::endl;
+
+    std::cout << std::endl;
+}
+
+void display(const Roaring_bitmap& set)
+{
+    std::cout << "[ ";
+    set.for_each([](std::uint32_t value) { std::cout << value << " "; });
+    std::cout << "]" << std::endl;
+}
+
+void test5()
+{
+    std::cout << std::endl << "test5==================================" << std::endl;
+
+    // ints of 32 bits, the ones of the same high 16 bits in an array, a bitmap or runs
+    Roaring_bitmap evens;
+    for (std::uint32_t i = 0; i < 200000; i += 2)
+        evens.add(i);
+    Roaring_bitmap range;
+    for (std::uint32_t i = 99990; i < 100010; ++i)
+        range.add(i);
+    range.run_optimize();
+
+    std::cout << "Evens: " << evens.cardinality() << " in " << evens.get_memory() << " bytes" << std::endl;
+    std::cout << "Range as runs: " << range.cardinality() << " in " << range.get_memory() << " bytes" << std::endl;
+
+    display(evens & range);
+    display(range - evens);
+    std::cout << "Union: " << (evens | range).cardinality() << std::endl;
+
+    std::uint32_t value;
+    if (evens.select(1000, value))
+        std::cout << "The 1000th even from 0: " << value << std::endl;
+    std::cout << "Evens not greater than 99: " << evens.rank(99) << std::endl;
+
+    // the bytes are read where they are, a file could be mapped instead
+    const std::string bytes {range.serialize()};
+    const Roaring_view view {bytes};
+    std::cout << std::boolalpha;
+    std::cout << bytes.size() << " bytes, 100000 in the view: " << view.contains(100000) << std::endl;
+    std::cout << "Same after a round trip: " << (Roaring_bitmap::deserialize(bytes) == range) << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     test1();
     test2();
     test3();
+    test4();
+    test5();
     
     return 0;
 }
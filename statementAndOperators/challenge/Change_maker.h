@@ -0,0 +1,294 @@
+#ifndef _CHANGE_MAKER_H_
+#define _CHANGE_MAKER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+  - a Change_maker gives the fewest coins of a set of denominations that make an amount of
+    cents, up to max_coins denominations of any value, the counts of a Coin_counts are in
+    the order the denominations were given.
+
+  - the change of an amount is a lookup: the largest coin q times, q from one division,
+    and the counts of the rest, rest_counts[amount - q * largest], a table of the counts of
+    every rest up to a bound, made once. O(1) per amount whatever the amount.
+
+  - a canonical system, the one of a country, US cents, euro cents, is one where the greedy
+    change is the fewest coins, the constructor tells with the test of Kozen and Zaks: the
+    greedy and the fewest coins are the same up to the sum of the two largest coins, or
+    they are not for any amount. the rests are then the greedy change of 0 to largest - 1,
+    so q is amount / largest.
+
+  - for a system that is not canonical, {1, 3, 4}, the rests are the fewest coins by
+    dynamic programming, a memo of the amounts up to (largest - 1) * (sum of the others),
+    an amount over it always has a largest coin in its fewest coins: the others can not be
+    there largest times each, largest of one coin is one coin of largest, so q is the number
+    of largest coins that takes the amount down to the bound. the memo is filled up to the
+    biggest rest asked for so far, doubled each time, make_change is not const and a
+    Change_maker is used by one thread at a time.
+
+  - make_change(cents, out, n) makes the change of n amounts, with AVX2 the quotients and
+    the rests of 4 of them are doubles, the division corrected by one step, and a
+    Coin_counts is 8 counts of 32 bits, one vector, the one of the rest plus q at the
+    largest coin. a block with an amount of 2^32 cents or more is made one at a time.
+
+  - an amount that is negative, that the coins can not make without 1, or with more than
+    2^32 - 1 of a coin throws std::invalid_argument, std::domain_error and
+    std::overflow_error.
+
+*/
+constexpr std::size_t max_coins = 8;
+
+struct alignas(32) Coin_counts
+{
+  std::array<std::uint32_t, max_coins> counts;
+};
+
+class Change_maker
+{
+private:
+  static constexpr std::size_t max_rests = std::size_t{1} << 20;
+  static constexpr std::uint32_t unreachable = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<std::int64_t> coins;
+  std::size_t largest;              // the index of it in coins
+  std::int64_t bound;               // the biggest rest
+  bool canonical;
+  std::vector<Coin_counts> rest_counts;
+  std::vector<std::uint32_t> rest_totals; // the number of coins, unreachable for none
+
+  std::int64_t get_largest() const { return this->coins[this->largest]; }
+
+  // the fewest coins of the next amounts, up to size - 1
+  void fill(std::size_t size)
+  {
+    for (std::size_t amount = this->rest_counts.size(); amount < size; ++amount)
+    {
+      Coin_counts best {};
+      std::uint32_t best_total = amount == 0 ? 0 : unreachable;
+      for (std::size_t i = 0; i < this->coins.size(); ++i)
+      {
+        const std::int64_t coin = this->coins[i];
+        if (coin > static_cast<std::int64_t>(amount) || this->rest_totals[amount - coin] == unreachable)
+          continue;
+        if (this->rest_totals[amount - coin] + 1 < best_total)
+        {
+          best_total = this->rest_totals[amount - coin] + 1;
+          best = this->rest_counts[amount - coin];
+          ++best.counts[i];
+        }
+      }
+      this->rest_counts.push_back(best);
+      this->rest_totals.push_back(best_total);
+    }
+  }
+
+  Coin_counts greedy(std::int64_t amount) const
+  {
+    std::vector<std::size_t> order(this->coins.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return this->coins[a] > this->coins[b]; });
+
+    Coin_counts change {};
+    for (std::size_t i : order)
+    {
+      change.counts[i] = static_cast<std::uint32_t>(amount / this->coins[i]);
+      amount %= this->coins[i];
+    }
+    return change;
+  }
+
+  static std::uint32_t total(const Coin_counts &change)
+  {
+    std::uint32_t sum = 0;
+    for (std::uint32_t count : change.counts)
+      sum += count;
+    return sum;
+  }
+
+  bool is_greedy_optimal()
+  {
+    if (std::find(this->coins.begin(), this->coins.end(), 1) == this->coins.end())
+      return false;
+    std::vector<std::int64_t> sorted = this->coins;
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted.size() < 3)
+      return true;
+
+    const std::int64_t limit = sorted[sorted.size() - 1] + sorted[sorted.size() - 2];
+    if (limit > static_cast<std::int64_t>(max_rests))
+      throw std::invalid_argument("The coins are too big to test, the two largest are over 2^20.");
+    this->fill(static_cast<std::size_t>(limit));
+    for (std::int64_t amount = 1; amount < limit; ++amount)
+      if (total(this->greedy(amount)) != this->rest_totals[amount])
+        return false;
+    return true;
+  }
+
+  // how many largest coins, the rest is then at most bound
+  std::int64_t quotient(std::int64_t amount) const
+  {
+    return amount > this->bound ? (amount - this->bound + this->get_largest() - 1) / this->get_largest() : 0;
+  }
+
+  void ensure(std::int64_t rest)
+  {
+    if (rest < static_cast<std::int64_t>(this->rest_counts.size()))
+      return;
+    this->fill(static_cast<std::size_t>(std::min<std::int64_t>(this->bound + 1,
+      std::max<std::int64_t>(rest + 1, 2 * static_cast<std::int64_t>(this->rest_counts.size())))));
+  }
+
+  Coin_counts change_of(std::int64_t q, std::int64_t rest) const
+  {
+    if (this->rest_totals[rest] == unreachable)
+      throw std::domain_error("The coins can not make the amount.");
+    Coin_counts change = this->rest_counts[rest];
+    if (q + change.counts[this->largest] > unreachable)
+      throw std::overflow_error("Too many coins for the amount.");
+    change.counts[this->largest] += static_cast<std::uint32_t>(q);
+    return change;
+  }
+
+public:
+  // the denominations in cents, different and positive, at most max_coins of them
+  explicit Change_maker(std::vector<std::int64_t> denominations)
+    : coins{std::move(denominations)}
+  {
+    if (this->coins.empty() || this->coins.size() > max_coins)
+      throw std::invalid_argument("A Change_maker is 1 to 8 coins.");
+    std::vector<std::int64_t> sorted = this->coins;
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted.front() <= 0 || std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+      throw std::invalid_argument("The coins are different and positive.");
+    this->largest = static_cast<std::size_t>(std::max_element(this->coins.begin(), this->coins.end()) - this->coins.begin());
+
+    this->canonical = this->is_greedy_optimal();
+    if (this->canonical)
+    {
+      this->bound = this->get_largest() - 1;
+      if (this->bound >= static_cast<std::int64_t>(max_rests))
+        throw std::invalid_argument("The largest coin is over 2^20.");
+      this->rest_counts.clear();
+      this->rest_totals.clear();
+      for (std::int64_t rest = 0; rest <= this->bound; ++rest)
+      {
+        this->rest_counts.push_back(this->greedy(rest));
+        this->rest_totals.push_back(total(this->rest_counts.back()));
+      }
+      return;
+    }
+
+    std::int64_t others = 0;
+    for (std::size_t i = 0; i < this->coins.size(); ++i)
+      if (i != this->largest)
+        others += this->coins[i];
+    if (others > static_cast<std::int64_t>(max_rests) || (this->get_largest() - 1) * others >= static_cast<std::int64_t>(max_rests))
+      throw std::invalid_argument("The coins are too big for the memo of 2^20 amounts.");
+    this->bound = (this->get_largest() - 1) * others;
+  }
+
+  bool is_canonical() const { return this->canonical; }
+  const std::vector<std::int64_t> &get_coins() const { return this->coins; }
+
+  Coin_counts make_change(std::int64_t cents)
+  {
+    if (cents < 0)
+      throw std::invalid_argument("The amount can not be negative.");
+    const std::int64_t q = this->quotient(cents);
+    const std::int64_t rest = cents - q * this->get_largest();
+    this->ensure(rest);
+    return this->change_of(q, rest);
+  }
+
+  void make_change(const std::int64_t *cents, Coin_counts *out, std::size_t n)
+  {
+    std::int64_t biggest = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (cents[i] < 0)
+        throw std::invalid_argument("The amount can not be negative.");
+      biggest = std::max(biggest, cents[i]);
+    }
+    this->ensure(std::min(biggest, this->bound));
+
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    // 1.5 2^52, an integer under 2^51 added to it is in the low bits of the sum
+    const double magic = 6755399441055744.0;
+    std::int64_t magic_bits;
+    std::memcpy(&magic_bits, &magic, sizeof magic_bits);
+    const __m256i magic_integer = _mm256_set1_epi64x(magic_bits);
+    const __m256d magic_double = _mm256_set1_pd(magic);
+    const __m256i limit = _mm256_set1_epi64x((std::int64_t{1} << 32) - 1);
+    const __m256i largest_coin = _mm256_set1_epi64x(this->get_largest());
+    const __m256d largest_double = _mm256_set1_pd(static_cast<double>(this->get_largest()));
+    const __m256i shift = _mm256_set1_epi64x(this->get_largest() - 1 - this->bound);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i top_lane = _mm256_cmpeq_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                _mm256_set1_epi32(static_cast<int>(this->largest)));
+    alignas(32) std::int64_t quotients[4];
+    alignas(32) std::int64_t rests[4];
+    for (; i + 4 <= n; i += 4)
+    {
+      const __m256i amount = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cents + i));
+      // the quotients have to fit in 32 bits for the products
+      const __m256i too_big = _mm256_cmpgt_epi64(amount, limit);
+      if (!_mm256_testz_si256(too_big, too_big))
+      {
+        for (std::size_t j = i; j < i + 4; ++j)
+          out[j] = this->make_change(cents[j]);
+        continue;
+      }
+      // quotient(amount): (amount - bound + largest - 1) / largest, 0 when it is negative
+      __m256i t = _mm256_add_epi64(amount, shift);
+      t = _mm256_and_si256(t, _mm256_cmpgt_epi64(t, zero));
+      const __m256d x = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(t, magic_integer)), magic_double);
+      const __m256d rounded = _mm256_round_pd(_mm256_div_pd(x, largest_double), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      __m256i q = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(rounded, magic_double)), magic_integer);
+      // the division of doubles is at most one off, the remainder of t tells which way
+      __m256i remainder = _mm256_sub_epi64(t, _mm256_mul_epu32(q, largest_coin));
+      const __m256i under = _mm256_cmpgt_epi64(zero, remainder);
+      const __m256i over = _mm256_cmpgt_epi64(remainder, _mm256_sub_epi64(largest_coin, one));
+      q = _mm256_add_epi64(_mm256_sub_epi64(q, _mm256_and_si256(under, one)), _mm256_and_si256(over, one));
+      const __m256i rest = _mm256_sub_epi64(amount, _mm256_mul_epu32(q, largest_coin));
+      _mm256_store_si256(reinterpret_cast<__m256i *>(quotients), q);
+      _mm256_store_si256(reinterpret_cast<__m256i *>(rests), rest);
+
+      for (std::size_t j = 0; j < 4; ++j)
+      {
+        if (this->rest_totals[rests[j]] == unreachable || quotients[j] + this->rest_counts[rests[j]].counts[this->largest] > unreachable)
+        {
+          out[i + j] = this->change_of(quotients[j], rests[j]);
+          continue;
+        }
+        // the counts of the rest plus q at the largest coin, one vector
+        const __m256i counts = _mm256_load_si256(reinterpret_cast<const __m256i *>(&this->rest_counts[rests[j]]));
+        const __m256i at_top = _mm256_and_si256(top_lane, _mm256_set1_epi32(static_cast<int>(quotients[j])));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(out + i + j), _mm256_add_epi32(counts, at_top));
+      }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+      const std::int64_t q = this->quotient(cents[i]);
+      const std::int64_t rest = cents[i] - q * this->get_largest();
+      out[i] = this->change_of(q, rest);
+    }
+  }
+};
+
+#endif
@@ -29,7 +29,27 @@
 
 */
 
+/*
+
+  the first version, a division and a modulo per coin:
+
+  int dollar {0};
+  dollar = charge_amount / dollar_value;
+  balance = charge_amount % dollar_value;
+
+  int quarter {0};
+  quarter = balance / quarter_value;
+  balance %= quarter_value;
+  ...
+
+  a Change_maker does it for any coins, the dollars are one division and the quarters,
+  dimes, nickels and pennies of the rest a lookup, see Change_maker.h.
+
+*/
+
 #include <iostream>
+#include <stdexcept>
+#include "Change_maker.h"
 
 int main()
 {
@@ -39,37 +59,27 @@ int main()
   const int nickel_value {5};
   const int penny_value {1};
 
+  Change_maker change_maker {{dollar_value, quarter_value, dime_value, nickel_value, penny_value}};
+
   int charge_amount {0};
 
   std::cout << "Enter an amount in cents: ";
   std::cin >> charge_amount;
 
-  int balance {0};
-
-  int dollar {0};
-  dollar = charge_amount / dollar_value;
-  balance = charge_amount % dollar_value;
-
-  int quarter {0};
-  quarter = balance / quarter_value;
-  balance %= quarter_value;
-
-  int dime {0};
-  dime = balance / dime_value;
-  balance %= dime_value;
-
-  int nickel {0};
-  nickel = balance / nickel_value;
-  balance %= nickel_value;
-
-  int penny {0};
-  penny = balance;
-
-  std::cout << "dollars: " << dollar << std::endl;
-  std::cout << "quarters: " << quarter << std::endl;
-  std::cout << "dimes: " << dime << std::endl;
-  std::cout << "nickels: " << nickel << std::endl;
-  std::cout << "pennies: " << penny << std::endl;
+  Coin_counts change;
+  try {
+    change = change_maker.make_change(charge_amount);
+  }
+  catch (const std::exception &ex) {
+    std::cout << ex.what() << std::endl;
+    return 1;
+  }
+
+  std::cout << "dollars: " << change.counts[0] << std::endl;
+  std::cout << "quarters: " << change.counts[1] << std::endl;
+  std::cout << "dimes: " << change.counts[2] << std::endl;
+  std::cout << "nickels: " << change.counts[3] << std::endl;
+  std::cout << "pennies: " << change.counts[4] << std::endl;
 
   return 0;
 }
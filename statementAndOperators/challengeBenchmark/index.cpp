@@ -0,0 +1,117 @@
+/*
+
+  - makes the change of 10'000'000 amounts from 0 to $1000, or of the number given as the
+    first argument: with the division and modulo per coin of the challenge, with
+    Change_maker::make_change one at a time, and with the batch make_change, which is 4
+    amounts at a time with AVX2.
+
+  - the same with coins that are not canonical, {25, 10, 7, 1}, the greedy change is not
+    the fewest coins there, 14 is 7 + 7, not 10 + 1 + 1 + 1 + 1, the rests come from the memo.
+
+  - the batch has to give the counts of one at a time, the checksum is the number of coins.
+
+  - build it with AVX2 for the batch, without it is the same loop one amount at a time:
+      g++ -std=c++17 -O2 -mavx2 index.cpp
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../challenge/Change_maker.h"
+
+template <typename F>
+double best_of_5(F f)
+{
+  double best = 1e300;
+  for (int run = 0; run < 5; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+void print(const std::string &what, double seconds, std::size_t n)
+{
+  std::cout << std::setw(34) << std::left << what << std::setw(10) << std::right << seconds / n * 1e9 << " ns per amount" << std::endl;
+}
+
+std::uint64_t count_coins(const std::vector<Coin_counts> &changes)
+{
+  std::uint64_t coins = 0;
+  for (const Coin_counts &change : changes)
+    for (std::uint32_t count : change.counts)
+      coins += count;
+  return coins;
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10'000'000;
+
+  std::vector<std::int64_t> amounts(n);
+  std::uint64_t seed = 12345;
+  for (std::int64_t &amount : amounts)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    amount = static_cast<std::int64_t>((seed >> 33) % 100'001);
+  }
+
+  std::vector<Coin_counts> divided(n);
+  const double division = best_of_5([&] {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      std::int64_t balance = amounts[i];
+      Coin_counts &change = divided[i];
+      change.counts[0] = static_cast<std::uint32_t>(balance / 100);
+      balance %= 100;
+      change.counts[1] = static_cast<std::uint32_t>(balance / 25);
+      balance %= 25;
+      change.counts[2] = static_cast<std::uint32_t>(balance / 10);
+      balance %= 10;
+      change.counts[3] = static_cast<std::uint32_t>(balance / 5);
+      change.counts[4] = static_cast<std::uint32_t>(balance % 5);
+    }
+  });
+
+  std::size_t mismatches = 0;
+  for (const std::vector<std::int64_t> &coins : {std::vector<std::int64_t> {100, 25, 10, 5, 1}, std::vector<std::int64_t> {25, 10, 7, 1}})
+  {
+    Change_maker change_maker {coins};
+    const std::string name = change_maker.is_canonical() ? "US coins, " : "{25, 10, 7, 1}, ";
+
+    std::vector<Coin_counts> one(n);
+    const double one_at_a_time = best_of_5([&] {
+      for (std::size_t i = 0; i < n; ++i)
+        one[i] = change_maker.make_change(amounts[i]);
+    });
+
+    std::vector<Coin_counts> batch(n);
+    const double batched = best_of_5([&] { change_maker.make_change(amounts.data(), batch.data(), n); });
+
+    for (std::size_t i = 0; i < n; ++i)
+      mismatches += batch[i].counts != one[i].counts || (change_maker.is_canonical() && batch[i].counts != divided[i].counts);
+
+    if (change_maker.is_canonical())
+      print("division and modulo", division, n);
+    print(name + "one at a time", one_at_a_time, n);
+    print(name + "batch", batched, n);
+    std::cout << "coins: " << count_coins(batch) << std::endl;
+  }
+
+#if defined(__AVX2__)
+  std::cout << "batch: AVX2" << std::endl;
+#else
+  std::cout << "batch: one at a time" << std::endl;
+#endif
+  std::cout << "mismatches: " << mismatches << std::endl;
+
+  return mismatches == 0 ? 0 : 1;
+}
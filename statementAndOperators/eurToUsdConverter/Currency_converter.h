@@ -0,0 +1,281 @@
+#ifndef _CURRENCY_CONVERTER_H_
+#define _CURRENCY_CONVERTER_H_
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../../polymorphism/challenge/Money.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+  - a Currency is a number from 0 to the number of currencies of a Rate_table, and the
+    table has the rate of every pair of them, rate(from, to), in a flat array indexed by
+    from * size + to. set_rate(from, to, rate) sets the pair and its inverse, a pair that
+    is not set throws std::out_of_range, like a currency that is not in the table.
+
+  - amounts are cents in 64 bits, the ones of Money of the Account modules, and what a
+    conversion gives is, to the cent, Money::from_cents(cents) * rate: the product rounded
+    half away from zero, std::overflow_error when it does not fit.
+
+  - Currency_converter::convert(from, to, cents, out, n) converts a column of amounts with
+    one rate, 4 at a time with AVX2: the cents to doubles, the product, the rounding and
+    back to integers, with the tricks of adding 1.5 2^52, for amounts under 2^51 cents, the
+    bigger ones are converted one at a time. the version with a currency pair per amount
+    looks up the rates of a block of them first, then converts the block the same way.
+
+  - publish(table) puts new rates in while other threads convert, read-copy-update: the
+    readers never lock, a conversion loads the pointer to the table once and uses it to
+    the end, and counts itself in one of two counters, the one of the current epoch.
+    publish swaps the pointer, moves to the next epoch and waits until the counter of the
+    one before is 0, twice, then every reader that could have the old table is done, and
+    deletes it. publishers take a mutex between them, not the readers.
+
+  - a Snapshot holds one table for several conversions, rates that can not change in the
+    middle of a batch, publish waits for it to be destroyed.
+
+*/
+using Currency = std::uint16_t;
+
+class Rate_table
+{
+private:
+  std::size_t num_currencies;
+  std::vector<double> rates;
+
+public:
+  // every rate 1 between a currency and itself, none between two others until it is set
+  explicit Rate_table(std::size_t num_currencies)
+    : num_currencies{num_currencies}, rates(num_currencies * num_currencies, 0.0)
+  {
+    for (std::size_t i = 0; i < num_currencies; ++i)
+      this->rates[i * num_currencies + i] = 1.0;
+  }
+
+  std::size_t size() const { return this->num_currencies; }
+
+  double rate(Currency from, Currency to) const
+  {
+    if (from >= this->num_currencies || to >= this->num_currencies)
+      throw std::out_of_range("Unknown currency.");
+    const double rate = this->rates[from * this->num_currencies + to];
+    if (rate == 0)
+      throw std::out_of_range("No rate between the currencies.");
+    return rate;
+  }
+
+  // 1 from is rate to, and 1 to is 1 / rate from
+  void set_rate(Currency from, Currency to, double rate)
+  {
+    if (from >= this->num_currencies || to >= this->num_currencies)
+      throw std::out_of_range("Unknown currency.");
+    if (!(rate > 0) || !std::isfinite(rate))
+      throw std::invalid_argument("A rate is a positive number.");
+    this->rates[from * this->num_currencies + to] = rate;
+    this->rates[to * this->num_currencies + from] = 1.0 / rate;
+  }
+
+  const double *data() const { return this->rates.data(); }
+};
+
+namespace detail_currency
+{
+  // 1.5 2^52, an integer under 2^51 added to it is in the low bits of the sum
+  constexpr double magic = 6755399441055744.0;
+  constexpr std::int64_t max_exact = std::int64_t{1} << 51;
+  constexpr std::size_t block = 256;
+
+  inline std::int64_t bits_of(double x)
+  {
+    std::int64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+  }
+
+  inline std::int64_t convert(std::int64_t cents, double rate)
+  {
+    return (Money::from_cents(cents) * rate).get_cents();
+  }
+
+  // out[i] = cents[i] * rates[i], the same rate for all when stride is 0
+  inline void convert(const std::int64_t *cents, const double *rates, std::size_t stride,
+                      std::int64_t *out, std::size_t n)
+  {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i magic_bits = _mm256_set1_epi64x(bits_of(magic));
+    const __m256d magic_double = _mm256_set1_pd(magic);
+    const __m256i limit = _mm256_set1_epi64x(max_exact - 1);
+    const __m256i minus_limit = _mm256_set1_epi64x(1 - max_exact);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d sign_bit = _mm256_set1_pd(-0.0);
+    const __m256d result_limit = _mm256_set1_pd(static_cast<double>(max_exact));
+    for (; i + 4 <= n; i += 4)
+    {
+      const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cents + i));
+      const __m256d rate = stride == 0 ? _mm256_set1_pd(rates[0]) : _mm256_loadu_pd(rates + i);
+      const __m256i out_of_range = _mm256_or_si256(_mm256_cmpgt_epi64(c, limit), _mm256_cmpgt_epi64(minus_limit, c));
+      // the integer plus the bits of 1.5 2^52 is the double 1.5 2^52 + c
+      const __m256d x = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(c, magic_bits)), magic_double);
+      const __m256d product = _mm256_mul_pd(x, rate);
+      // Money::round: + or - 0.5 and then toward zero
+      const __m256d rounded = _mm256_round_pd(_mm256_add_pd(product, _mm256_or_pd(half, _mm256_and_pd(product, sign_bit))),
+                                              _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      const __m256d too_big = _mm256_cmp_pd(_mm256_andnot_pd(sign_bit, rounded), result_limit, _CMP_NLT_UQ);
+      if (!_mm256_testz_si256(out_of_range, out_of_range) || _mm256_movemask_pd(too_big) != 0)
+      {
+        for (std::size_t j = i; j < i + 4; ++j)
+          out[j] = convert(cents[j], rates[stride * j]);
+        continue;
+      }
+      const __m256i result = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(rounded, magic_double)), magic_bits);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), result);
+    }
+#endif
+    for (; i < n; ++i)
+      out[i] = convert(cents[i], rates[stride * i]);
+  }
+}
+
+class Currency_converter
+{
+private:
+  struct alignas(64) Counter
+  {
+    std::atomic<std::int64_t> readers{0};
+  };
+
+  std::atomic<const Rate_table *> current;
+  std::atomic<std::uint64_t> epoch{0};
+  mutable Counter counters[2];
+  std::mutex publishing;
+
+  // the counter the reader is counted in
+  std::size_t enter() const
+  {
+    for (;;)
+    {
+      const std::size_t parity = this->epoch.load() & 1;
+      std::atomic<std::int64_t> &readers = this->counters[parity].readers;
+      readers.fetch_add(1);
+      // a publish that moved on before the count is not waiting for this counter
+      if ((this->epoch.load() & 1) == parity)
+        return parity;
+      readers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  void leave(std::size_t parity) const
+  {
+    this->counters[parity].readers.fetch_sub(1, std::memory_order_release);
+  }
+
+public:
+  // the rates of one moment, for as many conversions as it lives
+  class Snapshot
+  {
+    friend class Currency_converter;
+
+  private:
+    const Currency_converter *converter;
+    std::size_t parity;
+    const Rate_table *table;
+
+    explicit Snapshot(const Currency_converter &converter)
+      : converter{&converter}, parity{converter.enter()}, table{converter.current.load(std::memory_order_acquire)}
+    {}
+
+  public:
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    ~Snapshot() { this->converter->leave(this->parity); }
+
+    const Rate_table &rates() const { return *this->table; }
+
+    void convert(Currency from, Currency to, const std::int64_t *cents, std::int64_t *out, std::size_t n) const
+    {
+      const double rate = this->table->rate(from, to);
+      detail_currency::convert(cents, &rate, 0, out, n);
+    }
+
+    void convert(const Currency *from, const Currency *to, const std::int64_t *cents, std::int64_t *out, std::size_t n) const
+    {
+      const std::size_t size = this->table->size();
+      const double *rates = this->table->data();
+      double block_rates[detail_currency::block];
+      for (std::size_t first = 0; first < n; first += detail_currency::block)
+      {
+        const std::size_t count = n - first < detail_currency::block ? n - first : detail_currency::block;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          if (from[first + i] >= size || to[first + i] >= size)
+            throw std::out_of_range("Unknown currency.");
+          block_rates[i] = rates[from[first + i] * size + to[first + i]];
+          if (block_rates[i] == 0)
+            throw std::out_of_range("No rate between the currencies.");
+        }
+        detail_currency::convert(cents + first, block_rates, 1, out + first, count);
+      }
+    }
+
+    Money convert(Currency from, Currency to, Money amount) const
+    {
+      return amount * this->table->rate(from, to);
+    }
+  };
+
+  explicit Currency_converter(Rate_table table)
+    : current{new Rate_table(std::move(table))}
+  {}
+
+  Currency_converter(const Currency_converter &) = delete;
+  Currency_converter &operator=(const Currency_converter &) = delete;
+
+  ~Currency_converter() { delete this->current.load(); }
+
+  Snapshot snapshot() const { return Snapshot(*this); }
+
+  void convert(Currency from, Currency to, const std::int64_t *cents, std::int64_t *out, std::size_t n) const
+  {
+    this->snapshot().convert(from, to, cents, out, n);
+  }
+
+  void convert(const Currency *from, const Currency *to, const std::int64_t *cents, std::int64_t *out, std::size_t n) const
+  {
+    this->snapshot().convert(from, to, cents, out, n);
+  }
+
+  Money convert(Currency from, Currency to, Money amount) const
+  {
+    return this->snapshot().convert(from, to, amount);
+  }
+
+  // the conversions that start after it returns use table
+  void publish(Rate_table table)
+  {
+    const Rate_table *fresh = new Rate_table(std::move(table));
+    std::lock_guard<std::mutex> lock(this->publishing);
+    const Rate_table *old = this->current.exchange(fresh);
+    // twice, a reader that came in before the first one counts in the second counter
+    for (int flip = 0; flip < 2; ++flip)
+    {
+      const std::size_t parity = this->epoch.fetch_add(1) & 1;
+      while (this->counters[parity].readers.load() != 0)
+        std::this_thread::yield();
+    }
+    delete old;
+  }
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <vector>
+#include "Currency_converter.h"
 
 int main()
 {
@@ -11,5 +13,30 @@ int main()
 
   std::cout << eur << " EUR to USD will be: " << eur * eur_to_usd << "." << std::endl;
 
+  // the same rate in a table of currencies, for many amounts at once, in cents
+  const Currency usd {0};
+  const Currency euro {1};
+  const Currency gbp {2};
+
+  Rate_table rates {3};
+  rates.set_rate(euro, usd, eur_to_usd);
+  rates.set_rate(gbp, usd, 1.75);
+  rates.set_rate(euro, gbp, eur_to_usd / 1.75);
+
+  Currency_converter converter {rates};
+
+  std::vector<std::int64_t> amounts {Money(eur).get_cents(), 100, 2550, 999999};
+  std::vector<std::int64_t> converted(amounts.size());
+  converter.convert(euro, usd, amounts.data(), converted.data(), amounts.size());
+
+  for (std::size_t i {0}; i < amounts.size(); i++)
+    std::cout << Money::from_cents(amounts.at(i)) << " EUR is " << Money::from_cents(converted.at(i)) << " USD." << std::endl;
+
+  // new rates while the converter is in use, the conversions after it see them
+  rates.set_rate(euro, usd, 1.1);
+  converter.publish(rates);
+  std::cout << Money(eur) << " EUR is now " << converter.convert(euro, usd, Money(eur)) << " USD." << std::endl;
+  std::cout << Money(eur) << " EUR is " << converter.convert(euro, gbp, Money(eur)) << " GBP." << std::endl;
+
   return 0;
 }
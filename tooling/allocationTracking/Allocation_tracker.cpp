@@ -0,0 +1,423 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <csignal>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "Allocation_tracker.h"
+
+namespace
+{
+    constexpr std::uint32_t magic = 0xA110CA7Eu;
+    constexpr std::uint32_t no_site = 0xFFFFFFFFu;
+    constexpr std::size_t header_size = 16;
+    constexpr int num_frames = 8;
+    constexpr int skipped_frames = 2;
+    constexpr std::size_t num_sites = 4096;
+    constexpr int num_classes = 64;
+    constexpr int num_reported = 20;
+
+    // in front of every block, 16 bytes so the block stays aligned as malloc aligns it
+    struct Header
+    {
+        std::uint64_t size;
+        std::uint32_t site;
+        std::uint32_t magic;
+    };
+    static_assert(sizeof(Header) == header_size, "the header is 16 bytes");
+
+    struct Site
+    {
+        std::atomic<std::uint64_t> hash;
+        void *frames[num_frames];
+        int depth;
+        std::atomic<std::uint64_t> allocations;
+        std::atomic<std::uint64_t> bytes;
+        std::atomic<std::int64_t> live;
+        std::atomic<std::int64_t> live_bytes;
+    };
+
+    // zero initialized, before any constructor of the program runs, operator new can be called from them
+    Site sites[num_sites];
+    std::atomic_flag sites_lock = ATOMIC_FLAG_INIT;
+    std::atomic<std::uint64_t> allocations {0};
+    std::atomic<std::uint64_t> frees {0};
+    std::atomic<std::uint64_t> bytes {0};
+    std::atomic<std::int64_t> live_bytes {0};
+    std::atomic<std::int64_t> peak_live_bytes {0};
+    std::atomic<std::int64_t> live_by_class[num_classes];
+    std::atomic<std::uint64_t> sample_every {0};
+    std::atomic<std::uint64_t> dropped_sites {0};
+
+    thread_local std::uint64_t until_sample {0};
+    thread_local bool in_tracker {false};
+
+    int size_class(std::uint64_t size)
+    {
+        return size == 0 ? 0 : 64 - __builtin_clzll(size);
+    }
+
+    std::uint64_t get_sample_every()
+    {
+        std::uint64_t every = sample_every.load(std::memory_order_relaxed);
+        if (every == 0)
+        {
+            const char *text = std::getenv("BASICS_ALLOC_SAMPLE");
+            every = text != nullptr ? std::strtoull(text, nullptr, 10) : 1;
+            every = every == 0 ? 1 : every;
+            sample_every.store(every, std::memory_order_relaxed);
+        }
+        return every;
+    }
+
+    // the site of the stack, open addressing on its hash, no_site when the table is full
+    std::uint32_t find_site(void *const *frames, int depth)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (int i = 0; i < depth; ++i)
+            hash = (hash ^ reinterpret_cast<std::uintptr_t>(frames[i])) * 1099511628211ull;
+        hash |= 1;
+
+        for (std::size_t probe = 0; probe < num_sites; ++probe)
+        {
+            Site &site = sites[(hash + probe) & (num_sites - 1)];
+            const std::uint64_t seen = site.hash.load(std::memory_order_acquire);
+            if (seen == hash)
+                return static_cast<std::uint32_t>((hash + probe) & (num_sites - 1));
+            if (seen != 0)
+                continue;
+
+            while (sites_lock.test_and_set(std::memory_order_acquire))
+                ;
+            if (site.hash.load(std::memory_order_relaxed) == 0)
+            {
+                std::memcpy(site.frames, frames, sizeof(void *) * static_cast<std::size_t>(depth));
+                site.depth = depth;
+                site.hash.store(hash, std::memory_order_release);
+            }
+            sites_lock.clear(std::memory_order_release);
+            if (site.hash.load(std::memory_order_acquire) == hash)
+                return static_cast<std::uint32_t>((hash + probe) & (num_sites - 1));
+        }
+        dropped_sites.fetch_add(1, std::memory_order_relaxed);
+        return no_site;
+    }
+
+    std::uint32_t sample(std::size_t size)
+    {
+        if (in_tracker)
+            return no_site;
+        if (until_sample > 0)
+        {
+            --until_sample;
+            return no_site;
+        }
+        until_sample = get_sample_every() - 1;
+
+        // backtrace can allocate the first time, with malloc, the guard keeps it out anyway
+        in_tracker = true;
+        void *frames[num_frames + skipped_frames];
+        const int depth = backtrace(frames, num_frames + skipped_frames) - skipped_frames;
+        const std::uint32_t index = depth > 0 ? find_site(frames + skipped_frames, depth) : no_site;
+        in_tracker = false;
+
+        if (index != no_site)
+        {
+            Site &site = sites[index];
+            site.allocations.fetch_add(1, std::memory_order_relaxed);
+            site.bytes.fetch_add(size, std::memory_order_relaxed);
+            site.live.fetch_add(1, std::memory_order_relaxed);
+            site.live_bytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+        }
+        return index;
+    }
+
+    void count_allocation(Header *header, std::size_t size)
+    {
+        header->size = size;
+        header->magic = magic;
+        header->site = sample(size);
+
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+        live_by_class[size_class(size)].fetch_add(1, std::memory_order_relaxed);
+        const std::int64_t live = live_bytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) + static_cast<std::int64_t>(size);
+        std::int64_t peak = peak_live_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+    }
+
+    void count_free(Header *header)
+    {
+        if (header->magic != magic)
+            std::abort();
+        header->magic = 0;
+
+        const std::uint64_t size = header->size;
+        frees.fetch_add(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+        live_by_class[size_class(size)].fetch_sub(1, std::memory_order_relaxed);
+        if (header->site != no_site)
+        {
+            Site &site = sites[header->site];
+            site.live.fetch_sub(1, std::memory_order_relaxed);
+            site.live_bytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+        }
+    }
+
+    void *allocate(std::size_t size)
+    {
+        void *block = std::malloc(size + header_size);
+        if (block == nullptr)
+            return nullptr;
+        Header *header = static_cast<Header *>(block);
+        count_allocation(header, size);
+        return static_cast<char *>(block) + header_size;
+    }
+
+    void deallocate(void *p)
+    {
+        if (p == nullptr)
+            return;
+        Header *header = reinterpret_cast<Header *>(static_cast<char *>(p) - header_size);
+        count_free(header);
+        std::free(header);
+    }
+
+    // the block starts align bytes before the pointer, the header is the last 16 of them
+    void *allocate_aligned(std::size_t size, std::size_t align)
+    {
+        if (align <= header_size)
+            return allocate(size);
+        const std::size_t total = (size + align + align - 1) / align * align;
+        void *block = std::aligned_alloc(align, total);
+        if (block == nullptr)
+            return nullptr;
+        char *p = static_cast<char *>(block) + align;
+        count_allocation(reinterpret_cast<Header *>(p - header_size), size);
+        return p;
+    }
+
+    void deallocate_aligned(void *p, std::size_t align)
+    {
+        if (align <= header_size)
+            return deallocate(p);
+        if (p == nullptr)
+            return;
+        count_free(reinterpret_cast<Header *>(static_cast<char *>(p) - header_size));
+        std::free(static_cast<char *>(p) - align);
+    }
+
+    void *allocate_or_throw(std::size_t size, std::size_t align)
+    {
+        for (;;)
+        {
+            void *p = align == 0 ? allocate(size) : allocate_aligned(size, align);
+            if (p != nullptr)
+                return p;
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    // the report only goes through write(2), formatted by hand, from a signal handler too
+    class Writer
+    {
+    private:
+        int fd;
+        char buffer[512];
+        std::size_t used {0};
+
+    public:
+        explicit Writer(int fd) : fd(fd) {}
+        ~Writer() { this->flush(); }
+
+        void flush()
+        {
+            std::size_t done = 0;
+            while (done < this->used)
+            {
+                const ssize_t n = ::write(this->fd, this->buffer + done, this->used - done);
+                if (n <= 0)
+                    break;
+                done += static_cast<std::size_t>(n);
+            }
+            this->used = 0;
+        }
+
+        Writer &operator<<(const char *text)
+        {
+            for (; *text; ++text)
+            {
+                if (this->used == sizeof(this->buffer))
+                    this->flush();
+                this->buffer[this->used++] = *text;
+            }
+            return *this;
+        }
+
+        Writer &operator<<(std::int64_t value)
+        {
+            char digits[24];
+            char *p = digits + sizeof(digits);
+            *--p = '\0';
+            const bool negative = value < 0;
+            std::uint64_t magnitude = negative ? ~static_cast<std::uint64_t>(value) + 1 : static_cast<std::uint64_t>(value);
+            do
+            {
+                *--p = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+            if (negative)
+                *--p = '-';
+            return *this << p;
+        }
+
+        Writer &operator<<(std::uint64_t value) { return *this << static_cast<std::int64_t>(value); }
+        Writer &operator<<(int value) { return *this << static_cast<std::int64_t>(value); }
+    };
+
+    void write_sites(Writer &out, int fd, bool by_live, std::uint64_t every)
+    {
+        std::uint32_t reported[num_reported];
+        int count = 0;
+        for (; count < num_reported; ++count)
+        {
+            // the next biggest one, num_reported passes over the table, nothing is allocated
+            std::uint32_t best = no_site;
+            std::int64_t best_value = 0;
+            for (std::uint32_t i = 0; i < num_sites; ++i)
+            {
+                if (sites[i].hash.load(std::memory_order_acquire) == 0)
+                    continue;
+                const std::int64_t value = by_live ? sites[i].live_bytes.load(std::memory_order_relaxed)
+                    : static_cast<std::int64_t>(sites[i].bytes.load(std::memory_order_relaxed));
+                bool taken = false;
+                for (int k = 0; k < count; ++k)
+                    taken = taken || reported[k] == i;
+                if (!taken && value > best_value)
+                {
+                    best = i;
+                    best_value = value;
+                }
+            }
+            if (best == no_site)
+                break;
+            reported[count] = best;
+
+            const Site &site = sites[best];
+            out << "  " << site.allocations.load(std::memory_order_relaxed) * every << " allocations, "
+                << site.bytes.load(std::memory_order_relaxed) * every << " bytes, "
+                << site.live.load(std::memory_order_relaxed) * static_cast<std::int64_t>(every) << " live, "
+                << site.live_bytes.load(std::memory_order_relaxed) * static_cast<std::int64_t>(every) << " live bytes\n";
+            out.flush();
+            backtrace_symbols_fd(const_cast<void *const *>(site.frames), site.depth, fd);
+        }
+        if (count == 0)
+            out << "  none\n";
+    }
+
+    void dump_on_signal(int)
+    {
+        allocation_tracker::write_report(STDERR_FILENO);
+    }
+
+    // the report at the exit, made first so it is destroyed last, and the signal handler
+    struct Exit_report
+    {
+        Exit_report()
+        {
+            struct sigaction action {};
+            action.sa_handler = dump_on_signal;
+            sigemptyset(&action.sa_mask);
+            action.sa_flags = SA_RESTART;
+            ::sigaction(SIGUSR1, &action, nullptr);
+        }
+
+        ~Exit_report()
+        {
+            int fd = STDERR_FILENO;
+            if (const char *path = std::getenv("BASICS_ALLOC_FILE"))
+                fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            allocation_tracker::write_report(fd < 0 ? STDERR_FILENO : fd);
+            if (fd > STDERR_FILENO)
+                ::close(fd);
+        }
+    };
+
+    // before the objects of the other translation units, a report made after their destructors
+    __attribute__((init_priority(101))) Exit_report exit_report;
+}
+
+namespace allocation_tracker
+{
+    Totals totals()
+    {
+        return Totals {allocations.load(std::memory_order_relaxed), frees.load(std::memory_order_relaxed),
+            bytes.load(std::memory_order_relaxed), static_cast<std::uint64_t>(live_bytes.load(std::memory_order_relaxed)),
+            static_cast<std::uint64_t>(peak_live_bytes.load(std::memory_order_relaxed))};
+    }
+
+    void reset_counts()
+    {
+        allocations.store(0, std::memory_order_relaxed);
+        frees.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+    }
+
+    void write_report(int fd)
+    {
+        const std::uint64_t every = get_sample_every();
+        Writer out {fd};
+        struct rusage usage {};
+        ::getrusage(RUSAGE_SELF, &usage);
+
+        const Totals t = totals();
+        out << "allocations: " << t.allocations << ", frees: " << t.frees << ", bytes: " << t.bytes
+            << ", live bytes: " << t.live_bytes << ", peak live bytes: " << t.peak_live_bytes
+            << ", peak rss: " << static_cast<std::int64_t>(usage.ru_maxrss) << " KiB\n";
+
+        out << "live objects by size:\n";
+        for (int c = 0; c < num_classes; ++c)
+        {
+            const std::int64_t live = live_by_class[c].load(std::memory_order_relaxed);
+            if (live > 0)
+                out << "  " << (c == 0 ? std::uint64_t {0} : std::uint64_t {1} << (c - 1)) << " to "
+                    << (c == 0 ? std::uint64_t {0} : (std::uint64_t {1} << c) - 1) << " bytes: " << live << "\n";
+        }
+
+        out << "sites by bytes, one allocation in " << every << " sampled:\n";
+        write_sites(out, fd, false, every);
+        out << "sites by live bytes:\n";
+        write_sites(out, fd, true, every);
+        if (dropped_sites.load(std::memory_order_relaxed) > 0)
+            out << dropped_sites.load(std::memory_order_relaxed) << " samples lost, the table of sites is full\n";
+    }
+}
+
+void *operator new(std::size_t size) { return allocate_or_throw(size, 0); }
+void *operator new[](std::size_t size) { return allocate_or_throw(size, 0); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t align) { return allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void *operator new[](std::size_t size, std::align_val_t align) { return allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return allocate_aligned(size, static_cast<std::size_t>(align)); }
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return allocate_aligned(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void *p) noexcept { deallocate(p); }
+void operator delete[](void *p) noexcept { deallocate(p); }
+void operator delete(void *p, std::size_t) noexcept { deallocate(p); }
+void operator delete[](void *p, std::size_t) noexcept { deallocate(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { deallocate(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { deallocate(p); }
+void operator delete(void *p, std::align_val_t align) noexcept { deallocate_aligned(p, static_cast<std::size_t>(align)); }
+void operator delete[](void *p, std::align_val_t align) noexcept { deallocate_aligned(p, static_cast<std::size_t>(align)); }
+void operator delete(void *p, std::size_t, std::align_val_t align) noexcept { deallocate_aligned(p, static_cast<std::size_t>(align)); }
+void operator delete[](void *p, std::size_t, std::align_val_t align) noexcept { deallocate_aligned(p, static_cast<std::size_t>(align)); }
+void operator delete(void *p, std::align_val_t align, const std::nothrow_t &) noexcept { deallocate_aligned(p, static_cast<std::size_t>(align)); }
+void operator delete[](void *p, std::align_val_t align, const std::nothrow_t &) noexcept { deallocate_aligned(p, static_cast<std::size_t>(align)); }
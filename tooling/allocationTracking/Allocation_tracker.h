@@ -0,0 +1,51 @@
+#ifndef _ALLOCATION_TRACKER_H_
+#define _ALLOCATION_TRACKER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+
+    - Allocation_tracker.cpp replaces the global operator new and operator delete, all of
+      their forms, of the program it is linked into, the code does not change, e.g.
+        g++ -std=c++17 -rdynamic ../../pointerAndReferences/pointerPitfalls/index.cpp Allocation_tracker.cpp
+      or cmake -DBASICS_ALLOC_TRACKING=ON for every example. -rdynamic only puts the names
+      of the functions in the stacks, addr2line finds them without it.
+
+    - every allocation is counted: the allocations, the frees, the bytes, the live bytes and
+      the peak of them, and the live objects by power of 2 of their size, from a header of
+      16 bytes in front of every block.
+
+    - one allocation in sample_every of a thread has its stack taken, and is counted for its
+      call site, the 8 calls above operator new, and the site of a freed one loses it again,
+      the sites with the most bytes are the hot spots, the ones with live bytes at the exit
+      are the leaks. sample_every is 1 by default, every allocation, and the
+      BASICS_ALLOC_SAMPLE environment variable, the counts of the sites are the sampled ones
+      times sample_every then.
+
+    - the report is written at the exit, and every time the program gets SIGUSR1, to
+      std::cerr or to the file of BASICS_ALLOC_FILE, with write(2) only, it allocates nothing
+      and can be written from the signal handler.
+
+*/
+namespace allocation_tracker
+{
+    struct Totals
+    {
+        std::uint64_t allocations;
+        std::uint64_t frees;
+        std::uint64_t bytes;
+        std::uint64_t live_bytes;
+        std::uint64_t peak_live_bytes;
+    };
+
+    Totals totals();
+
+    // the bytes allocated and the allocations since the last reset, to measure a part of a program
+    void reset_counts();
+
+    // the report, to fd, 2 for std::cerr
+    void write_report(int fd);
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+
+    - the tracker is linked in, -rdynamic for the names in the stacks:
+        g++ -std=c++17 -O2 -rdynamic index.cpp Allocation_tracker.cpp
+        ./a.out
+        BASICS_ALLOC_SAMPLE=64 BASICS_ALLOC_FILE=allocations.txt ./a.out
+      kill -USR1 <pid> writes the report of a running program too.
+
+*/
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Allocation_tracker.h"
+
+struct Record
+{
+    std::string name;
+    std::vector<int> values;
+};
+
+// a map of strings, a node and a string for every key, the hot site of the report
+std::size_t count_words(int num_words)
+{
+    std::map<std::string, int> counts;
+    for (int i = 0; i < num_words; ++i)
+        ++counts["a word long enough to be on the heap " + std::to_string(i % 500)];
+    return counts.size();
+}
+
+// the vector without reserve, one allocation for every growth
+std::size_t grow_vector(int num_values)
+{
+    std::vector<int> values;
+    for (int i = 0; i < num_values; ++i)
+        values.push_back(i);
+    return values.capacity();
+}
+
+// never deleted, the leak of the report, by live bytes
+Record *leak_record(int i)
+{
+    return new Record {"record " + std::to_string(i) + " that nobody deletes", std::vector<int>(64, i)};
+}
+
+int main()
+{
+    allocation_tracker::reset_counts();
+    std::cout << "words: " << count_words(20000) << std::endl;
+    allocation_tracker::Totals t = allocation_tracker::totals();
+    std::cout << "count_words: " << t.allocations << " allocations, " << t.bytes << " bytes" << std::endl;
+
+    allocation_tracker::reset_counts();
+    std::cout << "capacity: " << grow_vector(1 << 20) << std::endl;
+    t = allocation_tracker::totals();
+    std::cout << "grow_vector: " << t.allocations << " allocations, " << t.bytes << " bytes" << std::endl;
+
+    for (int i = 0; i < 10; ++i)
+        leak_record(i);
+
+    std::unique_ptr<Record> kept {leak_record(10)};
+    t = allocation_tracker::totals();
+    std::cout << "live bytes: " << t.live_bytes << ", peak live bytes: " << t.peak_live_bytes << std::endl;
+
+    return 0;
+}
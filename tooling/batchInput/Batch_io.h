@@ -0,0 +1,237 @@
+#ifndef _BATCH_IO_H_
+#define _BATCH_IO_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+
+    - the batch mode of the menu programs, header only: read_all reads a whole command
+      file, or all of stdin, with a few big reads, a Scanner takes the commands out of it the
+      way std::cin >> does, and an Output_buffer collects what they print and writes it in
+      big blocks, one buffered output instead of a flush per line.
+
+        ./a.out --batch commands.txt
+        generate_commands | ./a.out --batch
+
+    - Scanner::next_char and next_int skip the same whitespace as operator>>, a number is an
+      optional sign and digits, and stops at the first character that is not one, like >>
+      does. a number that is not there or does not fit into an int is false, where std::cin
+      would set failbit. next_line is std::getline and skip_line is
+      ignore(max, '\n'), the line of the position is counted only for an error message.
+
+    - an Output_buffer is a std::streambuf, the handlers of a program print to an
+      std::ostream over it in batch mode and to std::cout otherwise, the same code. std::endl
+      does not write, the buffer goes to the descriptor when it is full, on flush and when it
+      is destroyed.
+
+*/
+namespace batch_io
+{
+    // the whole file, or all of stdin for nullptr and "-"
+    inline std::string read_all(const char *path)
+    {
+        const bool is_stdin = path == nullptr || std::string_view {path} == "-";
+        const int fd = is_stdin ? STDIN_FILENO : ::open(path, O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error(std::string {"open "} + path + ": " + std::strerror(errno));
+
+        std::string text;
+        struct stat st;
+        std::size_t chunk = 1 << 20;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+            chunk = static_cast<std::size_t>(st.st_size) + 1;
+
+        std::size_t size = 0;
+        for (;;)
+        {
+            if (text.size() - size < chunk)
+                text.resize(size + chunk);
+            const ssize_t count = ::read(fd, text.data() + size, text.size() - size);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0)
+            {
+                const int error = errno;
+                if (!is_stdin)
+                    ::close(fd);
+                throw std::runtime_error(std::string {"read "} + (is_stdin ? "stdin" : path) + ": " + std::strerror(error));
+            }
+            if (count == 0)
+                break;
+            size += static_cast<std::size_t>(count);
+        }
+        if (!is_stdin)
+            ::close(fd);
+        text.resize(size);
+        return text;
+    }
+
+    class Scanner
+    {
+    private:
+        std::string_view text;
+        std::size_t position {0};
+
+        static bool is_space(char c)
+        {
+            return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+        }
+
+        void skip_spaces()
+        {
+            while (this->position < this->text.size() && is_space(this->text[this->position]))
+                ++this->position;
+        }
+
+    public:
+        explicit Scanner(std::string_view text) : text(text) {}
+
+        bool next_char(char &c)
+        {
+            this->skip_spaces();
+            if (this->position == this->text.size())
+                return false;
+            c = this->text[this->position++];
+            return true;
+        }
+
+        bool next_int(int &number)
+        {
+            this->skip_spaces();
+            std::size_t begin = this->position;
+            if (begin < this->text.size() && this->text[begin] == '+')
+            {
+                ++begin;
+                if (begin < this->text.size() && this->text[begin] == '-')
+                    return false;
+            }
+            const char *const end = this->text.data() + this->text.size();
+            const auto [stop, error] = std::from_chars(this->text.data() + begin, end, number);
+            if (error != std::errc {})
+                return false;
+            this->position = static_cast<std::size_t>(stop - this->text.data());
+            return true;
+        }
+
+        // the next run of characters that are not whitespace
+        bool next_word(std::string_view &word)
+        {
+            this->skip_spaces();
+            const std::size_t begin = this->position;
+            while (this->position < this->text.size() && !is_space(this->text[this->position]))
+                ++this->position;
+            word = this->text.substr(begin, this->position - begin);
+            return !word.empty();
+        }
+
+        bool next_line(std::string_view &line)
+        {
+            if (this->position == this->text.size())
+                return false;
+            const std::size_t end = std::min(this->text.find('\n', this->position), this->text.size());
+            line = this->text.substr(this->position, end - this->position);
+            this->position = std::min(end + 1, this->text.size());
+            return true;
+        }
+
+        void skip_line()
+        {
+            std::string_view line;
+            this->next_line(line);
+        }
+
+        // 1 based, of the position
+        std::size_t get_line() const
+        {
+            std::size_t line = 1;
+            for (std::size_t i = 0; i < this->position; ++i)
+                line += this->text[i] == '\n';
+            return line;
+        }
+    };
+
+    class Output_buffer : public std::streambuf
+    {
+    private:
+        int fd;
+        std::vector<char> buffer;
+
+        bool write_out()
+        {
+            const char *data = this->pbase();
+            std::size_t size = static_cast<std::size_t>(this->pptr() - this->pbase());
+            while (size > 0)
+            {
+                const ssize_t count = ::write(this->fd, data, size);
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count < 0)
+                    return false;
+                data += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+            return true;
+        }
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (!this->write_out())
+                return traits_type::eof();
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                this->sputc(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+
+        // std::endl and flush of the stream, they wait for the buffer to fill
+        int sync() override
+        {
+            return 0;
+        }
+
+    public:
+        explicit Output_buffer(int fd = STDOUT_FILENO, std::size_t capacity = 1 << 20)
+            : fd(fd), buffer(capacity)
+        {
+            this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+        }
+
+        Output_buffer(const Output_buffer &) = delete;
+        Output_buffer &operator=(const Output_buffer &) = delete;
+
+        ~Output_buffer() override
+        {
+            this->write_out();
+        }
+
+        // false when the descriptor could not take it
+        bool flush()
+        {
+            return this->write_out();
+        }
+    };
+
+    // true for ./a.out --batch [file], file is then nullptr for stdin
+    inline bool is_batch(int argc, char *argv[], const char *&file)
+    {
+        if (argc < 2 || std::string_view {argv[1]} != "--batch")
+            return false;
+        file = argc > 2 ? argv[2] : nullptr;
+        return true;
+    }
+}
+
+#endif
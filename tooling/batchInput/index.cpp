@@ -0,0 +1,84 @@
+/*
+
+    - a batch of n commands of the menu programs, "A <number>" and "M", through a Scanner
+      and an Output_buffer on /dev/null, against std::cin >> like parsing of a
+      std::istringstream and std::endl after every line:
+        g++ -std=c++17 -O2 index.cpp
+        ./a.out [n]
+
+    - the programs themselves: ./a.out --batch commands.txt, in functions/challenge,
+      controllingProgramFLow/challengeTwo and standardTemplateLibrary/challengeTwo.
+
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Batch_io.h"
+
+template <typename F>
+double time_ms(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const long n = argc > 1 ? std::atol(argv[1]) : 1000000;
+    std::string commands;
+    for (long i = 0; i < n; ++i)
+        commands += i % 4 == 0 ? "M\n" : "A " + std::to_string(i * 7919 % 1000003 - 500000) + "\n";
+
+    long long sum_batch {0};
+    const double batch = time_ms([&]
+    {
+        const int fd = ::open("/dev/null", O_WRONLY);
+        {
+            batch_io::Output_buffer buffer {fd};
+            std::ostream os {&buffer};
+            batch_io::Scanner scanner {commands};
+            char option;
+            int number;
+            while (scanner.next_char(option))
+                if (option == 'A' && scanner.next_int(number))
+                {
+                    sum_batch += number;
+                    os << number << " is added." << std::endl;
+                }
+                else
+                    os << "The mean is " << sum_batch << std::endl;
+        }
+        ::close(fd);
+    });
+
+    long long sum_stream {0};
+    const double stream = time_ms([&]
+    {
+        std::istringstream in {commands};
+        std::ofstream os {"/dev/null"};
+        char option;
+        int number;
+        while (in >> option)
+            if (option == 'A' && in >> number)
+            {
+                sum_stream += number;
+                os << number << " is added." << std::endl;
+            }
+            else
+                os << "The mean is " << sum_stream << std::endl;
+    });
+
+    std::cout << n << " commands" << std::endl;
+    std::cout << "Scanner and Output_buffer:      " << batch << " ms" << std::endl;
+    std::cout << "istream >> and std::endl:       " << stream << " ms" << std::endl;
+    std::cout << "same sums: " << std::boolalpha << (sum_batch == sum_stream) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,676 @@
+#ifndef _BINARY_LOG_H_
+#define _BINARY_LOG_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+/*
+
+    - a log of lines that are not formatted where they are written, header only. a line is
+      a Format, its text with {} for the arguments, and the arguments themselves, raw:
+
+        static const binary_log::Format<std::int64_t, std::string_view> opened {"opened {} files in {}"};
+        binary_log::Logger log {std::cout};
+        log.write(opened, n, directory);
+
+    - write copies a record, the id of the format, the ticks of the TSC and the bytes of the
+      arguments, into a ring of its thread, a lock free ring with one writer and one reader,
+      and returns, no formatting, no lock, no system call. a full ring makes the thread wait
+      for the room, no line is lost, the waits are counted.
+
+    - the thread of the Logger takes the records of all the rings and writes them in
+      batches, one write and one flush a pass: formatted into lines, Sink::text, or as they
+      are, Sink::binary, into a file binary_log::decode turns into the same lines offline.
+      the binary file describes every format before its first record, its text and the
+      names of its arguments, a decoding program only needs the Arg of the types.
+
+    - an argument of type T is written by Arg<T>: the integers, bool, char, float, double
+      and the strings are here, another type specializes it, size, encode, decode and a
+      type_name, the name it has in the binary files.
+
+    - the lines of a thread are in the order of its writes, the lines of two threads are
+      in the order of the passes, the ticks of the binary records order them exactly.
+      flush waits until everything written before it is out. no write may run during or
+      after the destruction of its Logger.
+
+*/
+namespace binary_log
+{
+    inline std::uint64_t now_ticks()
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    template <typename T, typename = void>
+    struct Arg;
+
+    template <typename T>
+    struct Arg<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+    {
+        static constexpr const char *type_name = std::is_signed_v<T>
+            ? (sizeof(T) == 1 ? "i8" : sizeof(T) == 2 ? "i16" : sizeof(T) == 4 ? "i32" : "i64")
+            : (sizeof(T) == 1 ? "u8" : sizeof(T) == 2 ? "u16" : sizeof(T) == 4 ? "u32" : "u64");
+
+        static std::size_t size(T) { return sizeof(T); }
+
+        static char *encode(char *out, T value)
+        {
+            std::memcpy(out, &value, sizeof(T));
+            return out + sizeof(T);
+        }
+
+        static const char *decode(const char *in, std::string &text)
+        {
+            T value;
+            std::memcpy(&value, in, sizeof(T));
+            char digits[24];
+            text.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+            return in + sizeof(T);
+        }
+    };
+
+    // 1 and 0, what std::cout writes for a bool
+    template <>
+    struct Arg<bool>
+    {
+        static constexpr const char *type_name = "bool";
+        static std::size_t size(bool) { return 1; }
+        static char *encode(char *out, bool value) { *out = value ? 1 : 0; return out + 1; }
+        static const char *decode(const char *in, std::string &text) { text += *in ? '1' : '0'; return in + 1; }
+    };
+
+    template <>
+    struct Arg<char>
+    {
+        static constexpr const char *type_name = "char";
+        static std::size_t size(char) { return 1; }
+        static char *encode(char *out, char value) { *out = value; return out + 1; }
+        static const char *decode(const char *in, std::string &text) { text += *in; return in + 1; }
+    };
+
+    // the shortest text that reads back as the same value
+    template <typename T>
+    struct Arg<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        static constexpr const char *type_name = sizeof(T) == 4 ? "f32" : sizeof(T) == 8 ? "f64" : "f80";
+
+        static std::size_t size(T) { return sizeof(T); }
+
+        static char *encode(char *out, T value)
+        {
+            std::memcpy(out, &value, sizeof(T));
+            return out + sizeof(T);
+        }
+
+        static const char *decode(const char *in, std::string &text)
+        {
+            T value;
+            std::memcpy(&value, in, sizeof(T));
+            char digits[64];
+            text.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+            return in + sizeof(T);
+        }
+    };
+
+    // a string is its size in 4 bytes and its bytes, a const char * or a std::string converts to it
+    template <>
+    struct Arg<std::string_view>
+    {
+        static constexpr const char *type_name = "string";
+
+        static std::size_t size(std::string_view value) { return sizeof(std::uint32_t) + value.size(); }
+
+        static char *encode(char *out, std::string_view value)
+        {
+            const std::uint32_t length = static_cast<std::uint32_t>(value.size());
+            std::memcpy(out, &length, sizeof(length));
+            std::memcpy(out + sizeof(length), value.data(), value.size());
+            return out + sizeof(length) + value.size();
+        }
+
+        static const char *decode(const char *in, std::string &text)
+        {
+            std::uint32_t length;
+            std::memcpy(&length, in, sizeof(length));
+            text.append(in + sizeof(length), length);
+            return in + sizeof(length) + length;
+        }
+    };
+
+    template <>
+    struct Arg<std::string> : Arg<std::string_view> {};
+
+    using Decode_fn = const char *(*)(const char *in, std::string &text);
+
+    // a record, in the rings and in the binary files, the arguments follow, padded to 8 bytes
+    struct Record_header
+    {
+        std::uint16_t format;
+        std::uint16_t thread;
+        std::uint32_t size;    // of the arguments
+        std::uint64_t ticks;
+    };
+
+    // the formats above max_format_id are the records of the log itself
+    constexpr std::uint16_t max_format_id = 0xFFFD;
+    constexpr std::uint16_t describe_id = 0xFFFE;   // a format of a binary file
+    constexpr std::uint16_t wrap_id = 0xFFFF;       // the end of a ring, the next record is at its start
+    constexpr char file_magic[8] = {'B', 'I', 'N', 'L', 'O', 'G', '0', '1'};
+
+    constexpr std::size_t record_size(std::size_t args_size)
+    {
+        return sizeof(Record_header) + ((args_size + 7) & ~std::size_t {7});
+    }
+
+    struct Format_info
+    {
+        std::string text;
+        std::vector<std::string> pieces;          // the text between the {}, one more than the arguments
+        std::vector<std::string> type_names;
+        std::vector<Decode_fn> decoders;
+
+        // appends the line of a record to text
+        void format(const char *args, std::string &out) const
+        {
+            out += this->pieces[0];
+            for (std::size_t i = 0; i < this->decoders.size(); ++i)
+            {
+                args = this->decoders[i](args, out);
+                out += this->pieces[i + 1];
+            }
+            out += '\n';
+        }
+    };
+
+    namespace detail_binary_log
+    {
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<Format_info> formats;
+            std::map<std::string, Decode_fn, std::less<>> decoders;
+        };
+
+        inline Registry &registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        inline std::vector<std::string> split(std::string_view text, std::size_t num_args)
+        {
+            std::vector<std::string> pieces;
+            std::size_t from = 0;
+            for (std::size_t at; (at = text.find("{}", from)) != std::string_view::npos; from = at + 2)
+                pieces.emplace_back(text.substr(from, at - from));
+            pieces.emplace_back(text.substr(from));
+            if (pieces.size() != num_args + 1)
+                throw std::invalid_argument("the format \"" + std::string {text} + "\" has " + std::to_string(pieces.size() - 1)
+                    + " {} for " + std::to_string(num_args) + " arguments");
+            return pieces;
+        }
+
+        inline std::uint16_t add_format(Format_info info)
+        {
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock {reg.mutex};
+            if (reg.formats.size() > max_format_id)
+                throw std::length_error("more than " + std::to_string(max_format_id + 1) + " formats");
+            for (std::size_t i = 0; i < info.type_names.size(); ++i)
+                reg.decoders.emplace(info.type_names[i], info.decoders[i]);
+            reg.formats.push_back(std::move(info));
+            return static_cast<std::uint16_t>(reg.formats.size() - 1);
+        }
+
+        // the formats added since the copy was taken, for the thread of a Logger
+        inline void update(std::vector<Format_info> &copy)
+        {
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock {reg.mutex};
+            copy.insert(copy.end(), reg.formats.begin() + static_cast<std::ptrdiff_t>(copy.size()), reg.formats.end());
+        }
+
+        inline Decode_fn find_decoder(std::string_view type_name)
+        {
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock {reg.mutex};
+            const auto found = reg.decoders.find(type_name);
+            return found == reg.decoders.end() ? nullptr : found->second;
+        }
+
+        // the records of one thread, written by it and read by the thread of the Logger
+        class Ring
+        {
+        private:
+            std::unique_ptr<char[]> data;
+            std::size_t capacity;
+            std::uint16_t thread;
+            alignas(64) std::atomic<std::uint64_t> head {0};   // written by the writer
+            std::uint64_t cached_tail {0};
+            std::uint64_t reserved_head {0};
+            alignas(64) std::atomic<std::uint64_t> tail {0};   // written by the reader
+            std::atomic<std::uint64_t> waits {0};
+
+        public:
+            Ring(std::size_t capacity, std::uint16_t thread)
+                : data(new char[capacity]), capacity(capacity), thread(thread)
+            {}
+
+            std::uint16_t get_thread() const { return this->thread; }
+            std::uint64_t get_head() const { return this->head.load(std::memory_order_acquire); }
+            std::uint64_t get_tail() const { return this->tail.load(std::memory_order_acquire); }
+            std::uint64_t get_waits() const { return this->waits.load(std::memory_order_relaxed); }
+
+            // room for size bytes, contiguous, a wrap record fills the end of the ring when they don't fit there
+            char *reserve(std::size_t size)
+            {
+                std::uint64_t at = this->head.load(std::memory_order_relaxed);
+                const std::size_t offset = static_cast<std::size_t>(at & (this->capacity - 1));
+                const bool wraps = offset + size > this->capacity;
+                const std::uint64_t needed = wraps ? this->capacity - offset + size : size;
+                if (at + needed - this->cached_tail > this->capacity)
+                {
+                    this->cached_tail = this->tail.load(std::memory_order_acquire);
+                    while (at + needed - this->cached_tail > this->capacity)
+                    {
+                        this->waits.fetch_add(1, std::memory_order_relaxed);
+                        std::this_thread::yield();
+                        this->cached_tail = this->tail.load(std::memory_order_acquire);
+                    }
+                }
+                if (wraps)
+                {
+                    Record_header end {};
+                    end.format = wrap_id;
+                    std::memcpy(this->data.get() + offset, &end, sizeof(end));
+                    at += this->capacity - offset;
+                }
+                this->reserved_head = at;
+                return this->data.get() + (at & (this->capacity - 1));
+            }
+
+            void commit(std::size_t size)
+            {
+                this->head.store(this->reserved_head + size, std::memory_order_release);
+            }
+
+            // calls fn(header, args) for every record up to the head, returns the new tail, published by release
+            template <typename Fn>
+            std::uint64_t read(Fn fn) const
+            {
+                std::uint64_t at = this->tail.load(std::memory_order_relaxed);
+                const std::uint64_t end = this->head.load(std::memory_order_acquire);
+                while (at < end)
+                {
+                    const std::size_t offset = static_cast<std::size_t>(at & (this->capacity - 1));
+                    Record_header header;
+                    std::memcpy(&header, this->data.get() + offset, sizeof(header));
+                    if (header.format == wrap_id)
+                    {
+                        at += this->capacity - offset;
+                        continue;
+                    }
+                    fn(header, this->data.get() + offset);
+                    at += record_size(header.size);
+                }
+                return at;
+            }
+
+            void release(std::uint64_t at)
+            {
+                this->tail.store(at, std::memory_order_release);
+            }
+        };
+    }
+
+    // a line, its text with a {} for every argument, the text is checked and the format numbered once
+    template <typename... Ts>
+    class Format
+    {
+    private:
+        std::uint16_t id;
+
+    public:
+        explicit Format(std::string_view text)
+        {
+            Format_info info;
+            info.text = std::string {text};
+            info.pieces = detail_binary_log::split(text, sizeof...(Ts));
+            info.type_names = {Arg<Ts>::type_name...};
+            info.decoders = {&Arg<Ts>::decode...};
+            this->id = detail_binary_log::add_format(std::move(info));
+        }
+
+        std::uint16_t get_id() const { return this->id; }
+    };
+
+    enum class Sink
+    {
+        text,
+        binary
+    };
+
+    class Logger
+    {
+    public:
+        static constexpr std::size_t def_ring_capacity = std::size_t {1} << 20;
+
+    private:
+        static constexpr std::chrono::milliseconds idle_wait {1};
+
+        struct Thread_ring
+        {
+            const Logger *logger;
+            std::uint64_t generation;
+            detail_binary_log::Ring *ring;
+        };
+
+        static std::uint64_t next_generation()
+        {
+            static std::atomic<std::uint64_t> generation {0};
+            return generation.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        std::ostream &out;
+        Sink sink;
+        std::size_t ring_capacity;
+        std::uint64_t generation {next_generation()};
+
+        std::mutex rings_mutex;
+        std::vector<std::unique_ptr<detail_binary_log::Ring>> rings;
+        std::atomic<std::uint64_t> records {0};
+        std::atomic<std::uint64_t> batches {0};
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool woken {false};
+        std::atomic<bool> stopping {false};
+        std::thread thread;
+
+        detail_binary_log::Ring &ring_of_thread()
+        {
+            thread_local Thread_ring cached {nullptr, 0, nullptr};
+            if (cached.logger != this || cached.generation != this->generation)
+            {
+                std::lock_guard<std::mutex> lock {this->rings_mutex};
+                if (this->rings.size() > 0xFFFF)
+                    throw std::length_error("more than 65536 threads on a Logger");
+                this->rings.push_back(std::make_unique<detail_binary_log::Ring>(this->ring_capacity,
+                    static_cast<std::uint16_t>(this->rings.size())));
+                cached = {this, this->generation, this->rings.back().get()};
+            }
+            return *cached.ring;
+        }
+
+        // the text of a format, in the record the binary files have before its first line
+        static void describe(const Format_info &info, std::uint16_t id, std::string &batch)
+        {
+            std::string args;
+            args.append(reinterpret_cast<const char *>(&id), sizeof(id));
+            const std::uint16_t num_args = static_cast<std::uint16_t>(info.type_names.size());
+            args.append(reinterpret_cast<const char *>(&num_args), sizeof(num_args));
+            const std::uint32_t length = static_cast<std::uint32_t>(info.text.size());
+            args.append(reinterpret_cast<const char *>(&length), sizeof(length));
+            args += info.text;
+            for (const std::string &name : info.type_names)
+            {
+                args += static_cast<char>(name.size());
+                args += name;
+            }
+
+            Record_header header {describe_id, 0, static_cast<std::uint32_t>(args.size()), 0};
+            batch.append(reinterpret_cast<const char *>(&header), sizeof(header));
+            batch += args;
+            batch.append(record_size(args.size()) - sizeof(header) - args.size(), '\0');
+        }
+
+        void run()
+        {
+            std::vector<Format_info> formats;
+            std::vector<bool> described;
+            std::vector<detail_binary_log::Ring *> snapshot;
+            std::vector<std::uint64_t> tails;
+            std::string batch;
+
+            for (;;)
+            {
+                const bool stop = this->stopping.load(std::memory_order_acquire);
+                {
+                    std::lock_guard<std::mutex> lock {this->rings_mutex};
+                    snapshot.clear();
+                    for (const auto &ring : this->rings)
+                        snapshot.push_back(ring.get());
+                }
+
+                batch.clear();
+                tails.resize(snapshot.size());
+                std::uint64_t count = 0;
+                for (std::size_t i = 0; i < snapshot.size(); ++i)
+                    tails[i] = snapshot[i]->read([&](const Record_header &header, const char *record)
+                    {
+                        if (header.format >= formats.size())
+                            detail_binary_log::update(formats);
+                        const Format_info &info = formats[header.format];
+                        if (this->sink == Sink::text)
+                            info.format(record + sizeof(Record_header), batch);
+                        else
+                        {
+                            if (header.format >= described.size())
+                                described.resize(header.format + std::size_t {1});
+                            if (!described[header.format])
+                            {
+                                describe(info, header.format, batch);
+                                described[header.format] = true;
+                            }
+                            batch.append(record, record_size(header.size));
+                        }
+                        ++count;
+                    });
+
+                if (!batch.empty())
+                {
+                    this->out.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                    this->out.flush();
+                    this->batches.fetch_add(1, std::memory_order_relaxed);
+                }
+                // the room is given back after the write, a flush that sees it sees the lines out
+                for (std::size_t i = 0; i < snapshot.size(); ++i)
+                    snapshot[i]->release(tails[i]);
+                this->records.fetch_add(count, std::memory_order_relaxed);
+
+                if (count == 0)
+                {
+                    if (stop)
+                        return;
+                    std::unique_lock<std::mutex> lock {this->wake_mutex};
+                    this->wake.wait_for(lock, idle_wait, [this] { return this->woken || this->stopping.load(); });
+                    this->woken = false;
+                }
+            }
+        }
+
+        void wake_up()
+        {
+            {
+                std::lock_guard<std::mutex> lock {this->wake_mutex};
+                this->woken = true;
+            }
+            this->wake.notify_one();
+        }
+
+    public:
+        // ring_capacity is a power of 2, the bytes of the ring of every thread
+        explicit Logger(std::ostream &out, Sink sink = Sink::text, std::size_t ring_capacity = def_ring_capacity)
+            : out(out), sink(sink), ring_capacity(ring_capacity)
+        {
+            if (ring_capacity < 256 || (ring_capacity & (ring_capacity - 1)) != 0)
+                throw std::invalid_argument("the ring capacity has to be a power of 2 of at least 256 bytes");
+            if (sink == Sink::binary)
+                this->out.write(file_magic, sizeof(file_magic));
+            this->thread = std::thread {[this] { this->run(); }};
+        }
+
+        Logger(const Logger &source) = delete;
+        Logger &operator=(const Logger &rhs) = delete;
+
+        // everything written before is out
+        ~Logger()
+        {
+            this->stopping.store(true, std::memory_order_release);
+            this->wake_up();
+            this->thread.join();
+        }
+
+        template <typename... Ts, typename... Us>
+        void write(const Format<Ts...> &format, const Us &... args)
+        {
+            static_assert(sizeof...(Ts) == sizeof...(Us), "the arguments are not the ones of the format");
+            const std::size_t args_size = (std::size_t {0} + ... + Arg<Ts>::size(args));
+            const std::size_t size = record_size(args_size);
+            if (size > this->ring_capacity / 2)
+                throw std::length_error("a record of " + std::to_string(size) + " bytes, more than half of the ring");
+
+            detail_binary_log::Ring &ring = this->ring_of_thread();
+            char *record = ring.reserve(size);
+            const Record_header header {format.get_id(), ring.get_thread(), static_cast<std::uint32_t>(args_size), now_ticks()};
+            std::memcpy(record, &header, sizeof(header));
+            if (size > sizeof(header) + args_size)
+                std::memset(record + size - 8, 0, 8);   // the padding, the files are the same for the same lines
+            [[maybe_unused]] char *at = record + sizeof(header);
+            ((at = Arg<Ts>::encode(at, args)), ...);
+            ring.commit(size);
+        }
+
+        // waits until the records written before, by any thread, are written out and flushed
+        void flush()
+        {
+            std::vector<std::pair<detail_binary_log::Ring *, std::uint64_t>> heads;
+            {
+                std::lock_guard<std::mutex> lock {this->rings_mutex};
+                for (const auto &ring : this->rings)
+                    heads.emplace_back(ring.get(), ring->get_head());
+            }
+            for (const auto &[ring, head] : heads)
+                while (ring->get_tail() < head)
+                {
+                    this->wake_up();
+                    std::this_thread::yield();
+                }
+        }
+
+        std::uint64_t get_records() const { return this->records.load(std::memory_order_relaxed); }
+        std::uint64_t get_batches() const { return this->batches.load(std::memory_order_relaxed); }
+
+        // the times a thread found its ring full
+        std::uint64_t get_waits()
+        {
+            std::lock_guard<std::mutex> lock {this->rings_mutex};
+            std::uint64_t waits = 0;
+            for (const auto &ring : this->rings)
+                waits += ring->get_waits();
+            return waits;
+        }
+    };
+
+    /*
+
+        - the lines of a binary file of a Logger, written to out, in the order of the file,
+          with the ticks of a record before its line when with_ticks. the types of the
+          arguments are found by name among the Arg of the formats of the program.
+
+        - a file that is not one, a record cut short, a format not described or a type not
+          known throws std::runtime_error. returns the number of lines.
+
+    */
+    inline std::uint64_t decode(std::istream &in, std::ostream &out, bool with_ticks = false)
+    {
+        char magic[sizeof(file_magic)];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, file_magic, sizeof(magic)) != 0)
+            throw std::runtime_error("not a binary log, the magic is not " + std::string {file_magic, sizeof(file_magic)});
+
+        std::map<std::uint16_t, Format_info> formats;
+        std::string args;
+        std::string text;
+        std::uint64_t lines = 0;
+        Record_header header;
+        while (in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        {
+            args.resize(record_size(header.size) - sizeof(header));
+            if (!in.read(args.data(), static_cast<std::streamsize>(args.size())))
+                throw std::runtime_error("a record cut short after " + std::to_string(lines) + " lines");
+
+            if (header.format == describe_id)
+            {
+                std::uint16_t id, num_args;
+                std::uint32_t length;
+                const char *at = args.data();
+                std::memcpy(&id, at, sizeof(id));
+                std::memcpy(&num_args, at + 2, sizeof(num_args));
+                std::memcpy(&length, at + 4, sizeof(length));
+                Format_info info;
+                info.text.assign(at + 8, length);
+                at += 8 + length;
+                for (std::uint16_t i = 0; i < num_args; ++i)
+                {
+                    const std::size_t name_size = static_cast<unsigned char>(*at);
+                    info.type_names.emplace_back(at + 1, name_size);
+                    at += 1 + name_size;
+                    const Decode_fn decoder = detail_binary_log::find_decoder(info.type_names.back());
+                    if (decoder == nullptr)
+                        throw std::runtime_error("the type " + info.type_names.back() + " of \"" + info.text + "\" is not known");
+                    info.decoders.push_back(decoder);
+                }
+                info.pieces = detail_binary_log::split(info.text, num_args);
+                formats[id] = std::move(info);
+                continue;
+            }
+
+            const auto found = formats.find(header.format);
+            if (found == formats.end())
+                throw std::runtime_error("the format " + std::to_string(header.format) + " is not described");
+            if (with_ticks)
+            {
+                char digits[24];
+                text.append(digits, std::to_chars(digits, digits + sizeof(digits), header.ticks).ptr);
+                text += ' ';
+            }
+            found->second.format(args.data(), text);
+            ++lines;
+            if (text.size() >= (std::size_t {1} << 16))
+            {
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                text.clear();
+            }
+        }
+        if (in.gcount() != 0)
+            throw std::runtime_error("a record cut short after " + std::to_string(lines) + " lines");
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        out.flush();
+        return lines;
+    }
+}
+
+#endif
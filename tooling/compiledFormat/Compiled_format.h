@@ -0,0 +1,424 @@
+#ifndef _COMPILED_FORMAT_H_
+#define _COMPILED_FORMAT_H_
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/*
+
+    - the format strings of std::format, "{:<15}{:>7.2f}\n", parsed at compile time, header
+      only, for C++17: the string is given through COMPILED_FORMAT, a type of its own, and the
+      fields, the literal text between them and the argument types are checked while the
+      program is compiled, a field too many, a bad spec or a double for a {:d} do not build.
+      at run time only the arguments are converted, no string is parsed and no locale or
+      stream state is looked at.
+
+        compiled_format::print(std::cout, COMPILED_FORMAT("{:<25}{:<30}{:<5}\n"), name, artist, rating);
+
+    - a field is {} or {:[[fill]align][0][width][.precision][type]}, the fields are in the
+      order of the arguments, no index, {{ and }} are braces. align is < > or ^, numbers go to
+      the right and the rest to the left by default, 0 pads a number with zeros after its
+      sign. the types: d x X for integers, c for a char, f e g for floating point, s for
+      strings and bools, none for any of them. a double without a type is the shortest that
+      reads back, with a precision it is g.
+
+    - the arguments are the arithmetic types, strings, std::string_view and const char*, and
+      the classes with a format(char*) of their own, the convention of the tree: a static
+      max_chars of room, like Money, or a format_size(), like the I_Printable accounts. a
+      width pads them as strings, a precision cuts a string.
+
+    - the output goes into a Buffer, a char array that grows and is not zeroed, format() uses
+      one a thread, thread_local, and returns a view of it that is valid until the next format
+      on the thread. a report is many format_to of one Buffer and one write.
+
+*/
+
+// a format string of its own type, checked at compile time
+#define COMPILED_FORMAT(s)                                                         \
+    ([] {                                                                          \
+        struct Format_string                                                       \
+        {                                                                          \
+            static constexpr std::string_view str() { return s; }                  \
+        };                                                                         \
+        return Format_string {};                                                   \
+    }())
+
+namespace compiled_format
+{
+    class Buffer
+    {
+    private:
+        std::unique_ptr<char[]> data;
+        std::size_t used {0};
+        std::size_t capacity {0};
+
+    public:
+        explicit Buffer(std::size_t capacity = 4096) : data(new char[capacity]), capacity(capacity) {}
+
+        // room for n more chars at the end, the pointer to it, the chars count once commit() has them
+        char* reserve(std::size_t n)
+        {
+            if (this->used + n > this->capacity)
+            {
+                std::size_t capacity = this->capacity * 2;
+                while (capacity < this->used + n)
+                    capacity *= 2;
+                std::unique_ptr<char[]> data(new char[capacity]);
+                std::memcpy(data.get(), this->data.get(), this->used);
+                this->data = std::move(data);
+                this->capacity = capacity;
+            }
+            return this->data.get() + this->used;
+        }
+
+        void commit(char* end) { this->used = static_cast<std::size_t>(end - this->data.get()); }
+
+        void append(const char* chars, std::size_t n)
+        {
+            std::memcpy(this->reserve(n), chars, n);
+            this->used += n;
+        }
+
+        void clear() { this->used = 0; }
+        const char* begin() const { return this->data.get(); }
+        std::size_t size() const { return this->used; }
+        std::string_view view() const { return {this->data.get(), this->used}; }
+
+        void write_to(std::ostream& os) const { os.write(this->data.get(), static_cast<std::streamsize>(this->used)); }
+    };
+
+    inline Buffer& local_buffer()
+    {
+        thread_local Buffer buffer;
+        return buffer;
+    }
+
+    namespace detail
+    {
+        struct Spec
+        {
+            char fill {' '};
+            char align {0};
+            bool zero {false};
+            int width {0};
+            int precision {-1};
+            char type {0};
+        };
+
+        // the text before a field, and the field, the text after the last one is a piece of its own
+        struct Piece
+        {
+            std::size_t text_begin;
+            std::size_t text_size;
+            Spec spec;
+        };
+
+        template<std::size_t N, std::size_t Size>
+        struct Parsed
+        {
+            std::array<char, Size + 1> text {};
+            std::array<Piece, N + 1> pieces {};
+        };
+
+        // not constexpr, a format string that reaches it does not compile, the name is the error
+        inline void invalid_format_string(const char*) {}
+
+        constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+        constexpr std::size_t count_fields(std::string_view s)
+        {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < s.size(); ++i)
+            {
+                if (s[i] == '{')
+                {
+                    if (i + 1 < s.size() && s[i + 1] == '{')
+                    {
+                        ++i;
+                        continue;
+                    }
+                    ++count;
+                    while (i < s.size() && s[i] != '}')
+                        ++i;
+                    if (i == s.size())
+                        invalid_format_string("a { has no }");
+                }
+                else if (s[i] == '}')
+                {
+                    if (i + 1 < s.size() && s[i + 1] == '}')
+                        ++i;
+                    else
+                        invalid_format_string("a } has no {");
+                }
+            }
+            return count;
+        }
+
+        constexpr bool is_align(char c) { return c == '<' || c == '>' || c == '^'; }
+
+        // the spec of s[from, to), after the :
+        constexpr Spec parse_spec(std::string_view s, std::size_t from, std::size_t to)
+        {
+            Spec spec;
+            std::size_t i = from;
+            if (to - i >= 2 && is_align(s[i + 1]))
+            {
+                spec.fill = s[i];
+                spec.align = s[i + 1];
+                i += 2;
+            }
+            else if (i < to && is_align(s[i]))
+                spec.align = s[i++];
+            if (i < to && s[i] == '0')
+            {
+                spec.zero = true;
+                ++i;
+            }
+            while (i < to && is_digit(s[i]))
+                spec.width = spec.width * 10 + (s[i++] - '0');
+            if (i < to && s[i] == '.')
+            {
+                ++i;
+                if (i == to || !is_digit(s[i]))
+                    invalid_format_string("a . has no precision");
+                spec.precision = 0;
+                while (i < to && is_digit(s[i]))
+                    spec.precision = spec.precision * 10 + (s[i++] - '0');
+            }
+            if (i < to)
+            {
+                const char type = s[i++];
+                if (type != 'd' && type != 'x' && type != 'X' && type != 'c' && type != 'f' && type != 'e'
+                    && type != 'g' && type != 's')
+                    invalid_format_string("a type of a field is not one of d x X c f e g s");
+                spec.type = type;
+            }
+            if (i != to)
+                invalid_format_string("a field has more after its type");
+            return spec;
+        }
+
+        template<std::size_t N, std::size_t Size>
+        constexpr Parsed<N, Size> parse(std::string_view s)
+        {
+            Parsed<N, Size> parsed {};
+            std::size_t text = 0;
+            std::size_t piece = 0;
+            parsed.pieces[0].text_begin = 0;
+            for (std::size_t i = 0; i < s.size(); ++i)
+            {
+                if ((s[i] == '{' || s[i] == '}') && i + 1 < s.size() && s[i + 1] == s[i])
+                {
+                    parsed.text[text++] = s[i++];
+                    continue;
+                }
+                if (s[i] != '{')
+                {
+                    parsed.text[text++] = s[i];
+                    continue;
+                }
+                std::size_t end = i + 1;
+                while (s[end] != '}')
+                    ++end;
+                if (end != i + 1 && s[i + 1] != ':')
+                    invalid_format_string("the fields have no index, {} or {:spec}");
+                Piece& current = parsed.pieces[piece];
+                current.text_size = text - current.text_begin;
+                current.spec = end == i + 1 ? Spec {} : parse_spec(s, i + 2, end);
+                parsed.pieces[++piece].text_begin = text;
+                i = end;
+            }
+            parsed.pieces[piece].text_size = text - parsed.pieces[piece].text_begin;
+            return parsed;
+        }
+
+        template<class Format>
+        struct Compiled
+        {
+            static constexpr std::string_view str = Format::str();
+            static constexpr std::size_t num_fields = count_fields(str);
+            static constexpr Parsed<num_fields, str.size()> parsed = parse<num_fields, str.size()>(str);
+        };
+
+        template<class T, class = void>
+        struct has_max_chars : std::false_type {};
+        template<class T>
+        struct has_max_chars<T, std::void_t<decltype(T::max_chars), decltype(std::declval<const T&>().format(std::declval<char*>()))>>
+            : std::true_type {};
+
+        template<class T, class = void>
+        struct has_format_size : std::false_type {};
+        template<class T>
+        struct has_format_size<T, std::void_t<decltype(std::declval<const T&>().format_size()),
+            decltype(std::declval<const T&>().format(std::declval<char*>()))>> : std::true_type {};
+
+        template<class T>
+        constexpr bool is_string = std::is_convertible_v<const T&, std::string_view>;
+        template<class T>
+        constexpr bool is_char = std::is_same_v<T, char>;
+        template<class T>
+        constexpr bool is_integer = std::is_integral_v<T> && !is_char<T> && !std::is_same_v<T, bool>;
+
+        // the types a field can have for an argument of T
+        template<class T>
+        constexpr bool accepts(char type)
+        {
+            if constexpr (is_integer<T>)
+                return type == 0 || type == 'd' || type == 'x' || type == 'X';
+            else if constexpr (is_char<T>)
+                return type == 0 || type == 'c';
+            else if constexpr (std::is_floating_point_v<T>)
+                return type == 0 || type == 'f' || type == 'e' || type == 'g';
+            else if constexpr (std::is_same_v<T, bool> || is_string<T> || has_max_chars<T>::value || has_format_size<T>::value)
+                return type == 0 || type == 's';
+            else
+                return false;
+        }
+
+        template<class T>
+        constexpr bool is_number = std::is_arithmetic_v<T> && !is_char<T> && !std::is_same_v<T, bool>;
+
+        // the value is at [first, end) of the buffer, it moves to its place in the width
+        inline char* pad(char* first, char* end, const Spec& spec, char def_align, bool number)
+        {
+            const std::size_t size = static_cast<std::size_t>(end - first);
+            const std::size_t width = static_cast<std::size_t>(spec.width);
+            if (size >= width)
+                return end;
+            const std::size_t gap = width - size;
+            if (spec.zero && number && spec.align == 0)
+            {
+                char* digits = first + (*first == '-' ? 1 : 0);
+                std::memmove(digits + gap, digits, static_cast<std::size_t>(end - digits));
+                std::memset(digits, '0', gap);
+                return first + width;
+            }
+            const char align = spec.align != 0 ? spec.align : def_align;
+            const std::size_t before = align == '>' ? gap : align == '^' ? gap / 2 : 0;
+            if (before != 0)
+                std::memmove(first + before, first, size);
+            std::memset(first, spec.fill, before);
+            std::memset(first + before + size, spec.fill, gap - before);
+            return first + width;
+        }
+
+        template<class T>
+        void write(Buffer& buffer, const T& value, const Spec& spec)
+        {
+            const std::size_t width = static_cast<std::size_t>(spec.width);
+            if constexpr (is_integer<T>)
+            {
+                char* first = buffer.reserve(std::max<std::size_t>(width, 66));
+                char* end = std::to_chars(first, first + 66, value, spec.type == 'x' || spec.type == 'X' ? 16 : 10).ptr;
+                if (spec.type == 'X')
+                    for (char* p = first; p != end; ++p)
+                        *p = *p >= 'a' && *p <= 'f' ? static_cast<char>(*p - 'a' + 'A') : *p;
+                buffer.commit(pad(first, end, spec, '>', true));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                // the digits of a double, the ones before the point up to 1e308 and the precision after it
+                const std::size_t room = 330 + static_cast<std::size_t>(spec.precision < 0 ? 0 : spec.precision);
+                char* first = buffer.reserve(std::max(width, room));
+                char* end;
+                if (spec.type == 0 && spec.precision < 0)
+                    end = std::to_chars(first, first + room, value).ptr;
+                else
+                {
+                    const std::chars_format format = spec.type == 'f' ? std::chars_format::fixed
+                        : spec.type == 'e' ? std::chars_format::scientific : std::chars_format::general;
+                    end = std::to_chars(first, first + room, value, format, spec.precision < 0 ? 6 : spec.precision).ptr;
+                }
+                buffer.commit(pad(first, end, spec, '>', true));
+            }
+            else if constexpr (is_char<T>)
+            {
+                char* first = buffer.reserve(std::max<std::size_t>(width, 1));
+                *first = value;
+                buffer.commit(pad(first, first + 1, spec, '<', false));
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+                write(buffer, std::string_view {value ? "true" : "false"}, spec);
+            else if constexpr (is_string<T>)
+            {
+                std::string_view s = value;
+                if (spec.precision >= 0 && s.size() > static_cast<std::size_t>(spec.precision))
+                    s = s.substr(0, static_cast<std::size_t>(spec.precision));
+                char* first = buffer.reserve(std::max(width, s.size()));
+                std::memcpy(first, s.data(), s.size());
+                buffer.commit(pad(first, first + s.size(), spec, '<', false));
+            }
+            else
+            {
+                std::size_t room;
+                if constexpr (has_max_chars<T>::value)
+                    room = static_cast<std::size_t>(T::max_chars);
+                else
+                    room = value.format_size();
+                char* first = buffer.reserve(std::max(width, room));
+                buffer.commit(pad(first, value.format(first), spec, '<', false));
+            }
+        }
+
+        template<class C, std::size_t I, class T>
+        void write_field(Buffer& buffer, const T& value)
+        {
+            constexpr Piece piece = C::parsed.pieces[I];
+            static_assert(accepts<T>(piece.spec.type), "the argument of a field does not fit its type, or cannot be formatted");
+            buffer.append(C::parsed.text.data() + piece.text_begin, piece.text_size);
+            write(buffer, value, piece.spec);
+        }
+
+        template<class C, class... Args, std::size_t... I>
+        void write_all(Buffer& buffer, std::index_sequence<I...>, const Args&... args)
+        {
+            (write_field<C, I>(buffer, args), ...);
+            constexpr Piece tail = C::parsed.pieces[sizeof...(Args)];
+            buffer.append(C::parsed.text.data() + tail.text_begin, tail.text_size);
+        }
+    }
+
+    // appends the formatted arguments to the buffer
+    template<class Format, class... Args>
+    void format_to(Buffer& buffer, Format, const Args&... args)
+    {
+        using C = detail::Compiled<Format>;
+        static_assert(C::num_fields == sizeof...(Args), "the format string has not one field an argument");
+        detail::write_all<C>(buffer, std::index_sequence_for<Args...> {}, args...);
+    }
+
+    // in the buffer of the thread, the view is valid until the next format on it
+    template<class Format, class... Args>
+    std::string_view format(Format format_string, const Args&... args)
+    {
+        Buffer& buffer = local_buffer();
+        buffer.clear();
+        format_to(buffer, format_string, args...);
+        return buffer.view();
+    }
+
+    template<class Format, class... Args>
+    std::string to_string(Format format_string, const Args&... args)
+    {
+        return std::string {format(format_string, args...)};
+    }
+
+    // one write of the formatted arguments to os
+    template<class Format, class... Args>
+    void print(std::ostream& os, Format format_string, const Args&... args)
+    {
+        const std::string_view s = format(format_string, args...);
+        os.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+}
+
+#endif
@@ -0,0 +1,42 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Compiled_format.h"
+
+struct Item
+{
+    std::string name;
+    int quantity;
+    double price;
+};
+
+int main()
+{
+    const std::vector<Item> items {{"Milk", 2, 3.5}, {"Bread", 1, 2.5}, {"Apple", 12, 0.4}, {"Orange", 6, 0.75}};
+
+    // a report of one buffer and one write
+    compiled_format::Buffer report;
+    compiled_format::format_to(report, COMPILED_FORMAT("{:<15}{:>10}{:>12}\n"), "Item", "Quantity", "Total");
+    compiled_format::format_to(report, COMPILED_FORMAT("{:-<37}\n"), "");
+    double total {0.0};
+    for (const Item& item : items)
+    {
+        compiled_format::format_to(report, COMPILED_FORMAT("{:<15}{:>10}{:>12.2f}\n"), item.name, item.quantity, item.quantity * item.price);
+        total += item.quantity * item.price;
+    }
+    compiled_format::format_to(report, COMPILED_FORMAT("{:<15}{:>22.2f}\n"), "Total", total);
+    report.write_to(std::cout);
+
+    // the other specs, and the view of the buffer of the thread
+    compiled_format::print(std::cout, COMPILED_FORMAT("{{{}}} {:#^9} {:05} {:x} {:X} {:e} {} {:.3s} {}\n"),
+        7, "mid", -42, 255, 255, 1234.5, 0.1, "abcdef", true);
+    const std::string_view line = compiled_format::format(COMPILED_FORMAT("{} of {}"), 3, 4);
+    std::cout << line.size() << " chars: " << line << '\n';
+
+    // these do not compile, a field too many, a double for a {:d}, a spec out of the grammar:
+    //   compiled_format::format(COMPILED_FORMAT("{} {}"), 1);
+    //   compiled_format::format(COMPILED_FORMAT("{:d}"), 1.5);
+    //   compiled_format::format(COMPILED_FORMAT("{:>7.q}"), 1.5);
+    return 0;
+}
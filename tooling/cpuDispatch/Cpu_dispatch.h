@@ -0,0 +1,249 @@
+#ifndef _CPU_DISPATCH_H_
+#define _CPU_DISPATCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/*
+
+    - the kernels of the examples in a version per instruction set in one binary, the one of
+      the cpu it runs on chosen at run time, header only: the #if defined(__AVX2__) of a
+      kernel is the -march it was built with, a binary of x86-64-v3 does not start on an old
+      server and one of the default has SSE2 only on a new one.
+
+    - a version is a function of its own, compiled for its instruction set with the target
+      attributes of GCC and Clang, CPU_DISPATCH_AVX2 void f_avx2(...), the intrinsics of it
+      are there without -mavx2, and popcnt, which every cpu of AVX2 has. CPU_DISPATCH_X86 and
+      CPU_DISPATCH_NEON say which versions the compiler can make, the others are not compiled.
+
+    - a version does its tail itself, or with the scalar one, not with the version of the
+      isa below it: the SSE2 one is compiled without VEX, a call of it from the AVX ones
+      with the upper halves of the registers dirty is a transition that costs more than the
+      call, hundreds of cycles on some cpus.
+
+    - detected() is the best Isa of the cpu, found once, with __builtin_cpu_supports, which
+      checks with xgetbv that the system saves the registers too. Isa::avx512 is F and BW,
+      the byte instructions. an AArch64 has NEON always.
+
+    - current() is the detected one or the one forced, force(isa) for a test of every
+      version on one machine, or the environment variable BASICS_ISA=scalar, sse2, avx2,
+      avx512 or neon read once. forcing an isa the cpu does not have throws
+      std::runtime_error, its version would stop at the first instruction of it. unforce()
+      goes back to the detected one.
+
+    - Dispatch<F> holds the versions of a kernel by Isa, a call goes through a pointer that
+      is chosen at the first call and again only after force, the best version that is not
+      above current(): the pointer and the generation it was chosen in are two relaxed
+      loads, the cost of a call through a function pointer. there is no ifunc, it is the
+      loader of ELF only and the chosen one can't be forced after the start.
+
+*/
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CPU_DISPATCH_X86 1
+// the baseline of x86-64, a target of its own would lose the tuning of the build
+#if defined(__x86_64__)
+#define CPU_DISPATCH_SSE2
+#else
+#define CPU_DISPATCH_SSE2 __attribute__((target("sse2")))
+#endif
+#define CPU_DISPATCH_AVX2 __attribute__((target("avx2,popcnt")))
+#define CPU_DISPATCH_AVX512 __attribute__((target("avx512f,avx512bw,popcnt")))
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define CPU_DISPATCH_NEON 1
+#endif
+
+namespace cpu_dispatch
+{
+    // in the order of the x86 ones, an isa is above the ones before it
+    enum class Isa : int { scalar, sse2, avx2, avx512, neon };
+    constexpr int num_isas = 5;
+
+    inline const char* name(Isa isa)
+    {
+        static constexpr const char* names[num_isas] {"scalar", "sse2", "avx2", "avx512", "neon"};
+        return names[static_cast<int>(isa)];
+    }
+
+    inline bool parse(std::string_view text, Isa& isa)
+    {
+        for (int i = 0; i < num_isas; ++i)
+            if (text == name(static_cast<Isa>(i)))
+            {
+                isa = static_cast<Isa>(i);
+                return true;
+            }
+        return false;
+    }
+
+    inline bool supports(Isa isa)
+    {
+#if defined(CPU_DISPATCH_X86)
+        static const bool has[num_isas] {
+            true,
+            __builtin_cpu_supports("sse2") != 0,
+            __builtin_cpu_supports("avx2") != 0,
+            __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("avx512bw") != 0,
+            false};
+        return has[static_cast<int>(isa)];
+#elif defined(CPU_DISPATCH_NEON)
+        return isa == Isa::scalar || isa == Isa::neon;
+#else
+        return isa == Isa::scalar;
+#endif
+    }
+
+    inline Isa detected()
+    {
+        static const Isa best = []
+        {
+            for (int i = num_isas - 1; i > 0; --i)
+                if (supports(static_cast<Isa>(i)))
+                    return static_cast<Isa>(i);
+            return Isa::scalar;
+        }();
+        return best;
+    }
+
+    // an isa is chosen for a kernel when it is at most the current one, NEON only on an AArch64
+    inline bool is_usable(Isa isa, Isa limit)
+    {
+        if (!supports(isa))
+            return false;
+        if (isa == Isa::neon || limit == Isa::neon)
+            return isa == limit || isa == Isa::scalar;
+        return static_cast<int>(isa) <= static_cast<int>(limit);
+    }
+
+    namespace detail
+    {
+        inline void check(Isa isa)
+        {
+            if (!supports(isa))
+                throw std::runtime_error(std::string {"the cpu has no "} + name(isa));
+        }
+
+        struct State
+        {
+            std::atomic<int> forced {-1};
+            std::atomic<unsigned> generation {1};
+
+            // BASICS_ISA, an unknown name is none
+            State()
+            {
+                const char* text = std::getenv("BASICS_ISA");
+                Isa isa;
+                if (text != nullptr && parse(text, isa))
+                {
+                    check(isa);
+                    this->forced.store(static_cast<int>(isa), std::memory_order_relaxed);
+                }
+            }
+        };
+
+        inline State& state()
+        {
+            static State state;
+            return state;
+        }
+    }
+
+    inline void force(Isa isa)
+    {
+        detail::check(isa);
+        detail::state().forced.store(static_cast<int>(isa), std::memory_order_relaxed);
+        detail::state().generation.fetch_add(1, std::memory_order_release);
+    }
+
+    inline void unforce()
+    {
+        detail::state().forced.store(-1, std::memory_order_relaxed);
+        detail::state().generation.fetch_add(1, std::memory_order_release);
+    }
+
+    inline Isa current()
+    {
+        const int forced = detail::state().forced.load(std::memory_order_relaxed);
+        return forced >= 0 ? static_cast<Isa>(forced) : detected();
+    }
+
+    template<class F>
+    class Dispatch;
+
+    template<class R, class... Args>
+    class Dispatch<R(Args...)>
+    {
+    public:
+        using Function = R (*)(Args...);
+
+    private:
+        Function versions[num_isas] {};
+        mutable std::atomic<Function> chosen {nullptr};
+        mutable std::atomic<unsigned> generation {0};
+
+        Function choose() const
+        {
+            const unsigned at = detail::state().generation.load(std::memory_order_acquire);
+            const Isa limit = current();
+            Function best = this->versions[0];
+            for (int i = 0; i < num_isas; ++i)
+                if (this->versions[i] != nullptr && is_usable(static_cast<Isa>(i), limit))
+                    best = this->versions[i];
+            this->chosen.store(best, std::memory_order_relaxed);
+            this->generation.store(at, std::memory_order_relaxed);
+            return best;
+        }
+
+    public:
+        // a scalar version is needed, it is the one of every cpu
+        Dispatch(std::initializer_list<std::pair<Isa, Function>> list)
+        {
+            for (const auto& [isa, function] : list)
+                this->versions[static_cast<int>(isa)] = function;
+            if (this->versions[0] == nullptr)
+                throw std::invalid_argument("a Dispatch has no scalar version");
+        }
+
+        Dispatch(const Dispatch&) = delete;
+        Dispatch& operator=(const Dispatch&) = delete;
+
+        Function get() const
+        {
+            const Function function = this->chosen.load(std::memory_order_relaxed);
+            if (function != nullptr
+                && this->generation.load(std::memory_order_relaxed) == detail::state().generation.load(std::memory_order_relaxed))
+                return function;
+            return this->choose();
+        }
+
+        // the Isa of the version a call runs
+        Isa get_isa() const
+        {
+            const Function function = this->get();
+            for (int i = num_isas - 1; i >= 0; --i)
+                if (this->versions[i] == function)
+                    return static_cast<Isa>(i);
+            return Isa::scalar;
+        }
+
+        bool has(Isa isa) const
+        {
+            return this->versions[static_cast<int>(isa)] != nullptr;
+        }
+
+        template<class... Call>
+        R operator()(Call&&... args) const
+        {
+            return this->get()(std::forward<Call>(args)...);
+        }
+    };
+}
+
+#endif
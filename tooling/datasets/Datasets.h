@@ -0,0 +1,421 @@
+#ifndef _DATASETS_H_
+#define _DATASETS_H_
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - the inputs of the challenge programs at any size, header only, the same for a seed
+      every time:
+        - write_text, lines of words whose frequencies are a Zipf distribution, the rank r
+          word about 1 / r^s of the times, like the words of a book, for challengeThree and
+          the readers of ioAndStream
+        - write_responses, the answer key and the students of the responses.txt of
+          ioAndStream/challenge2, every answer right with a probability
+        - write_accounts, "type,name,balance,int_rate" lines of a mix of the checking,
+          saving and trust accounts of polymorphism/challenge
+        - write_transactions, "account,D|W,amount" lines on those accounts, a rate of them
+          withdrawals, a rate of those over the balance of the account
+
+    - the words are made of syllables of a consonant and a vowel from their rank, the first
+      80 are one syllable, the next 6400 two, ..., the frequent words are the short ones, as
+      in a text, and two ranks are never the same word. a draw of a rank is the alias
+      method of Walker, a table of n entries, one uniform number and one compare a word.
+
+    - the balances the transactions are written against are the ones of write_accounts, and
+      a withdrawal takes from it, an overdraft is a withdrawal of more than the balance, it
+      does not change it. the rules of the accounts refuse more than that, the fee of the
+      checking ones, the minimum of the saving ones, the 3 withdrawals of a trust, so the
+      rates are the ones of the stream, not of the refusals.
+
+    - the text is built in a buffer of 1 MB and written to the stream when it is full, a
+      stream that fails throws std::runtime_error.
+
+*/
+namespace datasets
+{
+    // xorshift64*, one multiply a number
+    class Random
+    {
+    private:
+        std::uint64_t state;
+
+    public:
+        explicit Random(std::uint64_t seed) : state(seed * 0x9e3779b97f4a7c15ULL + 0x2545f4914f6cdd1dULL)
+        {
+            if (this->state == 0)
+                this->state = 1;
+        }
+
+        std::uint64_t next()
+        {
+            this->state ^= this->state >> 12;
+            this->state ^= this->state << 25;
+            this->state ^= this->state >> 27;
+            return this->state * 0x2545f4914f6cdd1dULL;
+        }
+
+        // [0, 1)
+        double uniform() { return static_cast<double>(this->next() >> 11) * 0x1.0p-53; }
+
+        // [0, n), n > 0
+        std::uint64_t below(std::uint64_t n) { return static_cast<std::uint64_t>((static_cast<unsigned __int128>(this->next()) * n) >> 64); }
+    };
+
+    // the ranks 0 to n - 1, rank r with a weight of 1 / (r + 1)^exponent
+    class Zipf
+    {
+    private:
+        std::vector<double> probabilities;
+        std::vector<std::uint32_t> aliases;
+
+    public:
+        Zipf(std::size_t n, double exponent) : probabilities(n), aliases(n)
+        {
+            if (n == 0 || n > UINT32_MAX)
+                throw std::invalid_argument("a Zipf distribution of " + std::to_string(n) + " ranks");
+
+            double total = 0;
+            for (std::size_t r = 0; r < n; ++r)
+                total += std::pow(static_cast<double>(r + 1), -exponent);
+
+            // the weights scaled to a mean of 1, the small ones are topped up by a large one
+            std::vector<std::uint32_t> small, large;
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                this->probabilities[r] = std::pow(static_cast<double>(r + 1), -exponent) * static_cast<double>(n) / total;
+                (this->probabilities[r] < 1 ? small : large).push_back(static_cast<std::uint32_t>(r));
+            }
+            while (!small.empty() && !large.empty())
+            {
+                const std::uint32_t s = small.back(), l = large.back();
+                small.pop_back();
+                this->aliases[s] = l;
+                this->probabilities[l] -= 1 - this->probabilities[s];
+                if (this->probabilities[l] < 1)
+                {
+                    large.pop_back();
+                    small.push_back(l);
+                }
+            }
+            // what is left is 1 but for the rounding
+            for (const std::uint32_t r : small)
+                this->probabilities[r] = 1;
+            for (const std::uint32_t r : large)
+                this->probabilities[r] = 1;
+        }
+
+        std::size_t size() const { return this->probabilities.size(); }
+
+        std::size_t operator()(Random& random) const
+        {
+            const std::size_t r = static_cast<std::size_t>(random.below(this->probabilities.size()));
+            return random.uniform() < this->probabilities[r] ? r : this->aliases[r];
+        }
+    };
+
+    // the word of a rank, lower case syllables
+    inline std::string word_of(std::size_t rank)
+    {
+        static constexpr std::string_view consonants {"bcdfghjklmnprstv"};
+        static constexpr std::string_view vowels {"aeiou"};
+        static constexpr std::size_t num_syllables = 80;
+
+        // the words of one syllable first, then of two, ..., a rank a sequence of syllables
+        std::size_t length = 1, count = num_syllables;
+        while (rank >= count)
+        {
+            rank -= count;
+            ++length;
+            count *= num_syllables;
+        }
+        std::string word(length * 2, ' ');
+        for (std::size_t i = length; i-- > 0;)
+        {
+            // 37 is prime to 80, the syllables of the ranks that follow are far apart
+            const std::size_t syllable = rank % num_syllables * 37 % num_syllables;
+            rank /= num_syllables;
+            word[i * 2] = consonants[syllable / vowels.size()];
+            word[i * 2 + 1] = vowels[syllable % vowels.size()];
+        }
+        return word;
+    }
+
+    namespace detail
+    {
+        // the lines of a writer, out when 1 MB of them is there
+        class Output
+        {
+        private:
+            std::ostream& out;
+            std::string buffer;
+            std::uint64_t written {0};
+
+        public:
+            // the writers flush it at their end, a destructor that wrote could not throw
+            explicit Output(std::ostream& out) : out(out) { this->buffer.reserve(1 << 20); }
+
+            Output(const Output&) = delete;
+            Output& operator=(const Output&) = delete;
+
+            std::string& text() { return this->buffer; }
+
+            void append(std::string_view text) { this->buffer.append(text.data(), text.size()); }
+
+            void append(char c) { this->buffer.push_back(c); }
+
+            template<class Int>
+            void append_int(Int value)
+            {
+                char digits[24];
+                const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                this->buffer.append(digits, static_cast<std::size_t>(result.ptr - digits));
+            }
+
+            // cents as the dollars and 2 digits of the cents, 12345 is 123.45
+            void append_cents(std::int64_t cents)
+            {
+                if (cents < 0)
+                {
+                    this->append('-');
+                    cents = -cents;
+                }
+                this->append_int(cents / 100);
+                this->append('.');
+                this->append(static_cast<char>('0' + cents % 100 / 10));
+                this->append(static_cast<char>('0' + cents % 10));
+            }
+
+            void line_done()
+            {
+                if (this->buffer.size() >= (1 << 20))
+                    this->flush();
+            }
+
+            void flush()
+            {
+                if (this->buffer.empty())
+                    return;
+                this->out.write(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+                this->written += this->buffer.size();
+                this->buffer.clear();
+                if (!this->out)
+                    throw std::runtime_error("the dataset could not be written");
+            }
+
+            std::uint64_t size() const { return this->written + this->buffer.size(); }
+        };
+    }
+
+    struct Text_options
+    {
+        std::uint64_t bytes {1000000};
+        std::size_t vocabulary {50000};
+        double exponent {1.07};  // the one of the words of English texts
+        std::uint64_t seed {1};
+    };
+
+    // lines of 4 to 15 words, the first one capitalized, a ',' after some, a '.', '!' or '?'
+    // at the end, until bytes are written, the bytes written
+    inline std::uint64_t write_text(std::ostream& out, const Text_options& options)
+    {
+        Random random {options.seed};
+        const Zipf zipf {options.vocabulary, options.exponent};
+        std::vector<std::string> words(zipf.size());
+        for (std::size_t r = 0; r < words.size(); ++r)
+            words[r] = word_of(r);
+
+        detail::Output output {out};
+        while (output.size() < options.bytes)
+        {
+            const std::size_t num_words = 4 + static_cast<std::size_t>(random.below(12));
+            for (std::size_t i = 0; i < num_words; ++i)
+            {
+                const std::size_t begin = output.text().size();
+                output.append(words[zipf(random)]);
+                if (i == 0)
+                    output.text()[begin] = static_cast<char>(output.text()[begin] - 'a' + 'A');
+                if (i + 1 < num_words)
+                    output.append(random.below(12) == 0 ? ", " : " ");
+            }
+            const std::uint64_t end = random.below(10);
+            output.append(end < 8 ? ".\n" : end == 8 ? "!\n" : "?\n");
+            output.line_done();
+        }
+        output.flush();
+        return output.size();
+    }
+
+    struct Responses_options
+    {
+        std::size_t students {1000};
+        std::size_t questions {5};
+        double correct {0.7};  // the probability of a right answer
+        std::uint64_t seed {1};
+    };
+
+    // the answer key of questions letters A to E, then a name and the answers of every
+    // student, the names are the words of their number, the number of right answers
+    inline std::uint64_t write_responses(std::ostream& out, const Responses_options& options)
+    {
+        Random random {options.seed};
+        detail::Output output {out};
+        std::string key(options.questions, 'A');
+        for (char& answer : key)
+            answer = static_cast<char>('A' + random.below(5));
+        output.append(key);
+        output.append('\n');
+
+        std::uint64_t right = 0;
+        for (std::size_t s = 0; s < options.students; ++s)
+        {
+            const std::size_t begin = output.text().size();
+            output.append(word_of(s + 80));
+            output.text()[begin] = static_cast<char>(output.text()[begin] - 'a' + 'A');
+            output.append('\n');
+            for (const char answer : key)
+            {
+                if (random.uniform() < options.correct)
+                {
+                    output.append(answer);
+                    ++right;
+                }
+                else
+                    output.append(static_cast<char>('A' + (answer - 'A' + 1 + random.below(4)) % 5));
+            }
+            output.append('\n');
+            output.line_done();
+        }
+        output.flush();
+        return right;
+    }
+
+    enum class Account_type
+    {
+        Checking,
+        Saving,
+        Trust
+    };
+
+    // the weights of the types, they need not add up to 1
+    struct Account_mix
+    {
+        double checking {0.4};
+        double saving {0.4};
+        double trust {0.2};
+    };
+
+    struct Accounts_options
+    {
+        std::size_t count {1000};
+        Account_mix mix {};
+        std::uint64_t seed {1};
+    };
+
+    // the lines of the accounts, the balances of 0 to 10000.00 in cents, as they were written
+    inline std::vector<std::int64_t> write_accounts(std::ostream& out, const Accounts_options& options)
+    {
+        const double total = options.mix.checking + options.mix.saving + options.mix.trust;
+        if (!(total > 0) || options.mix.checking < 0 || options.mix.saving < 0 || options.mix.trust < 0)
+            throw std::invalid_argument("the mix of the accounts has no weight");
+
+        Random random {options.seed};
+        detail::Output output {out};
+        std::vector<std::int64_t> balances(options.count);
+        for (std::size_t i = 0; i < options.count; ++i)
+        {
+            const double pick = random.uniform() * total;
+            const Account_type type = pick < options.mix.checking ? Account_type::Checking
+                : pick < options.mix.checking + options.mix.saving ? Account_type::Saving : Account_type::Trust;
+            balances[i] = static_cast<std::int64_t>(random.below(1000001));
+
+            output.append(type == Account_type::Checking ? "Checking," : type == Account_type::Saving ? "Saving," : "Trust,");
+            output.append("Account ");
+            output.append_int(i);
+            output.append(',');
+            output.append_cents(balances[i]);
+            output.append(',');
+            // a rate of 0.0 to 5.0 percent, none for a checking account
+            output.append_int(type == Account_type::Checking ? 0 : random.below(6));
+            output.append(".0\n");
+            output.line_done();
+        }
+        output.flush();
+        return balances;
+    }
+
+    struct Transactions_options
+    {
+        std::uint64_t count {10000};
+        double withdrawals {0.4};  // of the transactions
+        double overdrafts {0.05};  // of the withdrawals, more than the balance of the account
+        std::uint64_t seed {2};
+    };
+
+    struct Transactions_totals
+    {
+        std::uint64_t deposits {0};
+        std::uint64_t withdrawals {0};
+        std::uint64_t overdrafts {0};
+    };
+
+    // the accounts are drawn uniformly, a deposit is 0.01 to 500.00, a withdrawal up to the
+    // balance, an overdraft up to 100.00 more than it, balances are the ones of the accounts
+    // and are changed as the transactions would change them
+    inline Transactions_totals write_transactions(std::ostream& out, std::vector<std::int64_t>& balances,
+        const Transactions_options& options)
+    {
+        if (balances.empty())
+            throw std::invalid_argument("transactions need accounts");
+
+        Random random {options.seed};
+        detail::Output output {out};
+        Transactions_totals totals;
+        for (std::uint64_t t = 0; t < options.count; ++t)
+        {
+            const std::size_t account = static_cast<std::size_t>(random.below(balances.size()));
+            std::int64_t& balance = balances[account];
+            output.append_int(account);
+
+            if (random.uniform() < options.withdrawals && balance > 0)
+            {
+                ++totals.withdrawals;
+                std::int64_t cents;
+                if (random.uniform() < options.overdrafts)
+                {
+                    ++totals.overdrafts;
+                    cents = balance + 1 + static_cast<std::int64_t>(random.below(10000));
+                }
+                else
+                {
+                    cents = 1 + static_cast<std::int64_t>(random.below(static_cast<std::uint64_t>(balance)));
+                    balance -= cents;
+                }
+                output.append(",W,");
+                output.append_cents(cents);
+            }
+            else
+            {
+                ++totals.deposits;
+                const std::int64_t cents = 1 + static_cast<std::int64_t>(random.below(50000));
+                balance += cents;
+                output.append(",D,");
+                output.append_cents(cents);
+            }
+            output.append('\n');
+            output.line_done();
+        }
+        output.flush();
+        return totals;
+    }
+}
+
+#endif
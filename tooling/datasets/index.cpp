@@ -0,0 +1,229 @@
+/*
+
+    - the datasets of Datasets.h as files, and the runs of the macro benchmarks on them,
+      cmake/Macro.cmake makes the datasets and runs the challenge programs with it:
+        g++ -std=c++17 -O2 index.cpp
+
+        ./a.out                   a few lines of every dataset
+        ./a.out text out.txt MB [exponent] [vocabulary] [seed]
+        ./a.out responses out.txt students [correct] [questions] [seed]
+        ./a.out bank accounts.csv transactions.csv accounts transactions [withdrawals] [overdrafts]
+                [checking:saving:trust] [seed]
+        ./a.out run report.txt label bytes records dir program arguments...
+
+    - run runs the program in dir, what it prints goes to dir/label.log, and appends a line
+      to the report, the time of the whole run, the bytes of its input and its records a
+      second, - for 0 records, and the peak of its resident set, the ru_maxrss of wait4 for
+      it. its exit code is the one of the program, the report line is not written when it
+      fails.
+
+    - on one core of an x86-64 at -O2, the writers:
+        text           1000 MB    8.7 s   115 MB/s
+        transactions   100M      15.1 s   6.6M a second, 1.57 GB
+
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Datasets.h"
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::ofstream open_output(const char* path)
+{
+    std::ofstream out {path, std::ios::binary};
+    if (!out)
+        throw std::runtime_error(std::string {"cannot write "} + path);
+    return out;
+}
+
+double number_or(int argc, char* argv[], int i, double otherwise)
+{
+    return argc > i ? std::strtod(argv[i], nullptr) : otherwise;
+}
+
+// "40:40:20", the weights of checking, saving and trust
+datasets::Account_mix parse_mix(const std::string& text)
+{
+    datasets::Account_mix mix;
+    char colon1 = 0, colon2 = 0;
+    std::istringstream in {text};
+    if (!(in >> mix.checking >> colon1 >> mix.saving >> colon2 >> mix.trust) || colon1 != ':' || colon2 != ':')
+        throw std::invalid_argument("the mix is checking:saving:trust, not " + text);
+    return mix;
+}
+
+int samples()
+{
+    std::cout << "text:" << std::endl;
+    datasets::Text_options text;
+    text.bytes = 200;
+    datasets::write_text(std::cout, text);
+
+    std::cout << std::endl << "responses:" << std::endl;
+    datasets::Responses_options responses;
+    responses.students = 3;
+    datasets::write_responses(std::cout, responses);
+
+    std::cout << std::endl << "accounts:" << std::endl;
+    datasets::Accounts_options accounts;
+    accounts.count = 4;
+    std::vector<std::int64_t> balances = datasets::write_accounts(std::cout, accounts);
+
+    std::cout << std::endl << "transactions:" << std::endl;
+    datasets::Transactions_options transactions;
+    transactions.count = 6;
+    transactions.overdrafts = 0.3;
+    const datasets::Transactions_totals totals = datasets::write_transactions(std::cout, balances, transactions);
+    std::cout << totals.deposits << " deposits, " << totals.withdrawals << " withdrawals, " << totals.overdrafts
+              << " of them overdrafts" << std::endl;
+    return 0;
+}
+
+int text(int argc, char* argv[])
+{
+    datasets::Text_options options;
+    options.bytes = static_cast<std::uint64_t>(number_or(argc, argv, 3, 100) * 1e6);
+    options.exponent = number_or(argc, argv, 4, options.exponent);
+    options.vocabulary = static_cast<std::size_t>(number_or(argc, argv, 5, static_cast<double>(options.vocabulary)));
+    options.seed = static_cast<std::uint64_t>(number_or(argc, argv, 6, 1));
+
+    std::ofstream out = open_output(argv[2]);
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t bytes = datasets::write_text(out, options);
+    std::cout << bytes << " bytes of text in " << std::fixed << std::setprecision(1) << seconds_since(start) << " s" << std::endl;
+    return 0;
+}
+
+int responses(int argc, char* argv[])
+{
+    datasets::Responses_options options;
+    options.students = static_cast<std::size_t>(number_or(argc, argv, 3, 1000));
+    options.correct = number_or(argc, argv, 4, options.correct);
+    options.questions = static_cast<std::size_t>(number_or(argc, argv, 5, static_cast<double>(options.questions)));
+    options.seed = static_cast<std::uint64_t>(number_or(argc, argv, 6, 1));
+
+    std::ofstream out = open_output(argv[2]);
+    const std::uint64_t right = datasets::write_responses(out, options);
+    std::cout << options.students << " students, " << right << " right answers" << std::endl;
+    return 0;
+}
+
+int bank(int argc, char* argv[])
+{
+    datasets::Accounts_options accounts;
+    accounts.count = static_cast<std::size_t>(number_or(argc, argv, 4, 1000));
+    datasets::Transactions_options transactions;
+    transactions.count = static_cast<std::uint64_t>(number_or(argc, argv, 5, 10000));
+    transactions.withdrawals = number_or(argc, argv, 6, transactions.withdrawals);
+    transactions.overdrafts = number_or(argc, argv, 7, transactions.overdrafts);
+    if (argc > 8)
+        accounts.mix = parse_mix(argv[8]);
+    accounts.seed = static_cast<std::uint64_t>(number_or(argc, argv, 9, 1));
+    transactions.seed = accounts.seed + 1;
+
+    std::vector<std::int64_t> balances;
+    {
+        std::ofstream out = open_output(argv[2]);
+        balances = datasets::write_accounts(out, accounts);
+    }
+    std::ofstream out = open_output(argv[3]);
+    const auto start = std::chrono::steady_clock::now();
+    const datasets::Transactions_totals totals = datasets::write_transactions(out, balances, transactions);
+    std::cout << accounts.count << " accounts, " << totals.deposits << " deposits, " << totals.withdrawals << " withdrawals, "
+              << totals.overdrafts << " of them overdrafts, in " << std::fixed << std::setprecision(1) << seconds_since(start)
+              << " s" << std::endl;
+    return 0;
+}
+
+int run(char* argv[])
+{
+    const std::string report = argv[2], label = argv[3], dir = argv[6];
+    const double bytes = std::strtod(argv[4], nullptr), records = std::strtod(argv[5], nullptr);
+    const std::string log = dir + "/" + label + ".log";
+
+    const auto start = std::chrono::steady_clock::now();
+    const pid_t pid = ::fork();
+    if (pid < 0)
+        throw std::runtime_error(std::string {"fork: "} + std::strerror(errno));
+    if (pid == 0)
+    {
+        const int fd = ::open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ::chdir(dir.c_str()) != 0)
+            std::_Exit(127);
+        ::dup2(fd, STDOUT_FILENO);
+        ::dup2(fd, STDERR_FILENO);
+        ::execv(argv[7], argv + 7);
+        std::_Exit(127);
+    }
+
+    int status = 0;
+    rusage usage {};
+    if (::wait4(pid, &status, 0, &usage) < 0)
+        throw std::runtime_error(std::string {"wait4: "} + std::strerror(errno));
+    const double seconds = seconds_since(start);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        std::cout << label << " failed, see " << log << std::endl;
+        return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+    }
+
+    std::ostringstream line;
+    line << std::setw(40) << std::left << label << std::right << std::fixed << std::setprecision(2) << std::setw(10) << seconds
+         << std::setprecision(1) << std::setw(10) << bytes / 1e6 / seconds << std::setw(14);
+    if (records > 0)
+        line << records / 1e6 / seconds;
+    else
+        line << "-";
+    line << std::setw(10) << static_cast<double>(usage.ru_maxrss) / 1024.0 << '\n';
+    const bool first = !std::filesystem::exists(report);
+    std::ofstream out {report, std::ios::app};
+    if (first)
+        out << std::setw(40) << std::left << "program" << std::right << std::setw(10) << "s" << std::setw(10) << "MB/s"
+            << std::setw(14) << "M records/s" << std::setw(10) << "peak MB" << '\n';
+    out << line.str();
+    std::cout << line.str();
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const std::string mode = argc > 1 ? argv[1] : "";
+        if (mode == "text" && argc >= 3)
+            return text(argc, argv);
+        if (mode == "responses" && argc >= 3)
+            return responses(argc, argv);
+        if (mode == "bank" && argc >= 4)
+            return bank(argc, argv);
+        if (mode == "run" && argc >= 8)
+            return run(argv);
+        if (mode.empty())
+            return samples();
+    }
+    catch (const std::exception& error)
+    {
+        std::cout << error.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "usage: see the comment of tooling/datasets/index.cpp" << std::endl;
+    return 1;
+}
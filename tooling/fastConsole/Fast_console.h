@@ -0,0 +1,284 @@
+#ifndef _FAST_CONSOLE_H_
+#define _FAST_CONSOLE_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+
+/*
+
+    - the console of the programs without the cost of the defaults, header only. a Guard in
+      main turns off the sync with stdio, unties std::cin from std::cout and gives std::cout a
+      big buffer on the descriptor, until it is destroyed:
+
+        int main()
+        {
+            fast_console::Guard console;
+            std::cout << "Enter an integer: ";
+            int n;
+            console.input().next_int(n);
+            std::cout << n * 2 << '\n';
+        }
+
+    - the output is written by the flush points: a full buffer, std::flush or std::endl,
+      and the end of the Guard. so the programs write '\n', not std::endl, a line is not a
+      system call anymore.
+
+    - Input reads stdin in blocks of 64 KiB and parses in its buffer, next_char, next_int
+      and next_double are operator>> and skip the same whitespace, next_line is std::getline
+      and ignore_line is ignore(max, '\n'). a read that fails is false and leaves the
+      variable as it was, and the Input stays good, the next value is tried from the same
+      place.
+
+    - std::cout is flushed only when Input has to wait for stdin, right before the read,
+      the prompt is on the terminal when the program waits and a pipe full of commands is
+      read with one flush per block, the tie without its cost.
+
+*/
+namespace fast_console
+{
+    inline bool is_space(char c)
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+
+    class Output_buffer : public std::streambuf
+    {
+    private:
+        int fd;
+        std::vector<char> buffer;
+
+        bool write_out()
+        {
+            const char *data = this->pbase();
+            std::size_t size = static_cast<std::size_t>(this->pptr() - this->pbase());
+            while (size > 0)
+            {
+                const ssize_t count = ::write(this->fd, data, size);
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count < 0)
+                    return false;
+                data += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+            return true;
+        }
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (!this->write_out())
+                return traits_type::eof();
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                this->sputc(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+
+        int sync() override
+        {
+            return this->write_out() ? 0 : -1;
+        }
+
+    public:
+        explicit Output_buffer(int fd = STDOUT_FILENO, std::size_t capacity = 1 << 16)
+            : fd(fd), buffer(capacity)
+        {
+            this->setp(this->buffer.data(), this->buffer.data() + this->buffer.size());
+        }
+
+        Output_buffer(const Output_buffer &) = delete;
+        Output_buffer &operator=(const Output_buffer &) = delete;
+
+        ~Output_buffer() override
+        {
+            this->write_out();
+        }
+    };
+
+    class Input
+    {
+    private:
+        int fd;
+        std::ostream *tied;
+        std::vector<char> buffer;
+        std::size_t begin {0};
+        std::size_t end {0};
+        bool at_end {false};
+
+        // keeps the bytes from begin, reads more after them, false at the end of stdin
+        bool refill()
+        {
+            if (this->at_end)
+                return false;
+            if (this->tied)
+                this->tied->flush();
+
+            if (this->begin > 0)
+            {
+                std::copy(this->buffer.begin() + this->begin, this->buffer.begin() + this->end, this->buffer.begin());
+                this->end -= this->begin;
+                this->begin = 0;
+            }
+            if (this->end == this->buffer.size())
+                this->buffer.resize(this->buffer.size() * 2);
+
+            for (;;)
+            {
+                const ssize_t count = ::read(this->fd, this->buffer.data() + this->end, this->buffer.size() - this->end);
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count <= 0)
+                {
+                    this->at_end = true;
+                    return false;
+                }
+                this->end += static_cast<std::size_t>(count);
+                return true;
+            }
+        }
+
+        bool skip_spaces()
+        {
+            for (;;)
+            {
+                while (this->begin < this->end && is_space(this->buffer[this->begin]))
+                    ++this->begin;
+                if (this->begin < this->end)
+                    return true;
+                if (!this->refill())
+                    return false;
+            }
+        }
+
+        // the next word, whole in the buffer, it is not consumed
+        std::string_view peek_word()
+        {
+            if (!this->skip_spaces())
+                return {};
+            std::size_t stop = this->begin;
+            for (;;)
+            {
+                while (stop < this->end && !is_space(this->buffer[stop]))
+                    ++stop;
+                if (stop < this->end || this->at_end)
+                    break;
+                const std::size_t offset = stop - this->begin;
+                if (!this->refill())
+                    break;
+                stop = this->begin + offset;
+            }
+            return std::string_view {this->buffer.data() + this->begin, stop - this->begin};
+        }
+
+        template <typename T>
+        bool next_number(T &value)
+        {
+            const std::string_view word = this->peek_word();
+            const char *first = word.data();
+            if (!word.empty() && word[0] == '+' && (word.size() == 1 || word[1] != '-'))
+                ++first;
+            T parsed {};
+            const auto [stop, error] = std::from_chars(first, word.data() + word.size(), parsed);
+            if (word.empty() || error != std::errc {})
+                return false;
+            value = parsed;
+            this->begin += static_cast<std::size_t>(stop - word.data());
+            return true;
+        }
+
+    public:
+        explicit Input(int fd = STDIN_FILENO, std::ostream *tied = &std::cout, std::size_t capacity = 1 << 16)
+            : fd(fd), tied(tied), buffer(capacity) {}
+
+        bool next_char(char &c)
+        {
+            if (!this->skip_spaces())
+                return false;
+            c = this->buffer[this->begin++];
+            return true;
+        }
+
+        bool next_int(int &number) { return this->next_number(number); }
+        bool next_double(double &number) { return this->next_number(number); }
+
+        bool next_line(std::string &line)
+        {
+            line.clear();
+            for (;;)
+            {
+                const auto first = this->buffer.begin() + this->begin;
+                const auto last = this->buffer.begin() + this->end;
+                const auto newline = std::find(first, last, '\n');
+                line.append(first, newline);
+                this->begin = static_cast<std::size_t>(newline - this->buffer.begin());
+                if (newline != last)
+                {
+                    ++this->begin;
+                    return true;
+                }
+                if (!this->refill())
+                    return !line.empty();
+            }
+        }
+
+        void ignore_line()
+        {
+            for (;;)
+            {
+                const auto first = this->buffer.begin() + this->begin;
+                const auto last = this->buffer.begin() + this->end;
+                const auto newline = std::find(first, last, '\n');
+                this->begin = static_cast<std::size_t>(newline - this->buffer.begin());
+                if (newline != last)
+                {
+                    ++this->begin;
+                    return;
+                }
+                if (!this->refill())
+                    return;
+            }
+        }
+    };
+
+    class Guard
+    {
+    private:
+        Output_buffer buffer;
+        Input stdin_input;
+        std::ostream *was_tied;
+        std::streambuf *was_buffer;
+
+    public:
+        // before the first input or output, the sync with stdio can not be turned off later
+        Guard()
+        {
+            std::ios::sync_with_stdio(false);
+            this->was_tied = std::cin.tie(nullptr);
+            this->was_buffer = std::cout.rdbuf(&this->buffer);
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard()
+        {
+            std::cout.flush();
+            std::cout.rdbuf(this->was_buffer);
+            std::cin.tie(this->was_tied);
+        }
+
+        Input &input() { return this->stdin_input; }
+    };
+}
+
+#endif
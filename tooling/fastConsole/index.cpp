@@ -0,0 +1,44 @@
+/*
+
+    - prints every number of stdin twice as big, and the sum, through the Guard, or through
+      the default std::cin and std::cout with std::endl with --cin, for the same pipe:
+        g++ -std=c++17 -O2 index.cpp
+        seq 1 2000000 | time ./a.out > /dev/null
+        seq 1 2000000 | time ./a.out --cin > /dev/null
+
+    - run on a terminal it is a prompt and a number at a time, the prompt is flushed when
+      the program waits for the number.
+
+*/
+
+#include <iostream>
+#include <string_view>
+#include "Fast_console.h"
+
+int main(int argc, char *argv[])
+{
+    double sum {0};
+    double number {0};
+    bool is_terminal = ::isatty(STDIN_FILENO);
+
+    if (argc > 1 && std::string_view {argv[1]} == "--cin")
+    {
+        while ((is_terminal && std::cout << "Enter a number: "), std::cin >> number)
+        {
+            sum += number;
+            std::cout << number * 2 << std::endl;
+        }
+        std::cout << "sum: " << sum << std::endl;
+        return 0;
+    }
+
+    fast_console::Guard console;
+    while ((is_terminal && std::cout << "Enter a number: "), console.input().next_double(number))
+    {
+        sum += number;
+        std::cout << number * 2 << '\n';
+    }
+    std::cout << "sum: " << sum << '\n';
+
+    return 0;
+}
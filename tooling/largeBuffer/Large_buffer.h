@@ -0,0 +1,224 @@
+#ifndef _LARGE_BUFFER_H_
+#define _LARGE_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+
+    - the big arrays of the examples, the buffers of the readers, the balances of an
+      Account_store and the bytes of an Inverted_index, header only: a buffer that is written
+      before it is read is not zeroed first, and one of a few MB is in huge pages.
+
+    - std::vector<T>(n) and resize(n) value-initialize, a pass of zeros over memory that is
+      overwritten right after, by a read(2) or a memcpy of a checkpoint. make_for_overwrite<T>(n)
+      is std::make_unique_for_overwrite of C++20, an array whose elements are not initialized,
+      Allocator<T> constructs an element without arguments by default-initializing it, so
+      resize(n) of a Vector<T> of numbers leaves them as they are, push_back and
+      resize(n, value) are the ones of std::vector.
+
+    - a buffer from huge_page_size up is an anonymous mapping aligned to 2 MB and advised with
+      MADV_HUGEPAGE, one TLB entry for 2 MB instead of 512, the transparent huge pages are
+      found at the first write. Pages::explicit_huge asks for the pages of the hugetlbfs pool
+      with MAP_HUGETLB and takes the transparent ones when the pool has none, Pages::normal is
+      a mapping of 4 KB pages. a smaller buffer is one of operator new.
+
+    - prefault writes the pages when the buffer is allocated, with MADV_POPULATE_WRITE or a
+      write to every page where the kernel has none, the faults are taken there instead of
+      in the loop that fills it, e.g. before a timed section. the pages of a mapping are
+      zeros, so a prefaulted buffer is one of zeros.
+
+    - an allocation that fails throws std::bad_alloc, like operator new.
+
+*/
+namespace large_buffer
+{
+    constexpr std::size_t huge_page_size = std::size_t {1} << 21;
+
+    enum class Pages { normal, transparent, explicit_huge };
+
+    struct Options
+    {
+        Pages pages {Pages::transparent};
+        bool prefault {false};
+    };
+
+    namespace detail
+    {
+        inline std::size_t round_up(std::size_t bytes)
+        {
+            return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+        }
+
+        inline void prefault(void* data, std::size_t size)
+        {
+#ifdef MADV_POPULATE_WRITE
+            if (::madvise(data, size, MADV_POPULATE_WRITE) == 0)
+                return;
+#endif
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            volatile char* p = static_cast<char*>(data);
+            for (std::size_t i = 0; i < size; i += page)
+                p[i] = 0;
+        }
+
+        // a mapping of size bytes at a 2 MB boundary, the slack of one more huge page unmapped
+        inline void* map_aligned(std::size_t size)
+        {
+            void* mapped = ::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED)
+                throw std::bad_alloc {};
+            const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(mapped);
+            const std::uintptr_t aligned = (start + huge_page_size - 1) & ~std::uintptr_t {huge_page_size - 1};
+            if (aligned > start)
+                ::munmap(mapped, aligned - start);
+            if (aligned + size < start + size + huge_page_size)
+                ::munmap(reinterpret_cast<void*>(aligned + size), start + huge_page_size - aligned);
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    // bytes not initialized, deallocate with the same bytes
+    inline void* allocate(std::size_t bytes, Options options = {})
+    {
+        if (bytes < huge_page_size)
+            return ::operator new(bytes > 0 ? bytes : 1);
+
+        const std::size_t size = detail::round_up(bytes);
+        void* data = nullptr;
+#ifdef MAP_HUGETLB
+        if (options.pages == Pages::explicit_huge)
+        {
+            data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (data == MAP_FAILED)
+                data = nullptr;
+        }
+#endif
+        if (data == nullptr)
+        {
+            data = detail::map_aligned(size);
+#ifdef MADV_HUGEPAGE
+            if (options.pages != Pages::normal)
+                ::madvise(data, size, MADV_HUGEPAGE);
+#endif
+        }
+        if (options.prefault)
+            detail::prefault(data, size);
+        return data;
+    }
+
+    inline void deallocate(void* data, std::size_t bytes) noexcept
+    {
+        if (data == nullptr)
+            return;
+        if (bytes < huge_page_size)
+            ::operator delete(data);
+        else
+            ::munmap(data, detail::round_up(bytes));
+    }
+
+    struct Deleter
+    {
+        std::size_t bytes {0};
+
+        void operator()(void* data) const noexcept
+        {
+            deallocate(data, this->bytes);
+        }
+    };
+
+    template<class T>
+    using Unique_array = std::unique_ptr<T[], Deleter>;
+
+    // n elements that are not initialized, the ones of make_unique_for_overwrite<T[]>(n)
+    template<class T>
+    Unique_array<T> make_for_overwrite(std::size_t n, Options options = {})
+    {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+            "the elements of a buffer for overwrite are not constructed nor destroyed");
+        if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_alloc {};
+        const std::size_t bytes = n * sizeof(T);
+        return Unique_array<T> {static_cast<T*>(allocate(bytes, options)), Deleter {bytes}};
+    }
+
+    /*
+        the allocator of a Vector, the options are the ones of its buffers, every allocator
+        frees the buffers of another, the size is all deallocate needs.
+    */
+    template<class T>
+    class Allocator
+    {
+    private:
+        Options options;
+
+        template<class U>
+        friend class Allocator;
+
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        Allocator() noexcept = default;
+
+        explicit Allocator(Options options) noexcept
+            : options {options}
+        {
+        }
+
+        template<class U>
+        Allocator(const Allocator<U>& other) noexcept
+            : options {other.options}
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            if (n > static_cast<std::size_t>(-1) / sizeof(T))
+                throw std::bad_alloc {};
+            return static_cast<T*>(large_buffer::allocate(n * sizeof(T), this->options));
+        }
+
+        void deallocate(T* data, std::size_t n) noexcept
+        {
+            large_buffer::deallocate(data, n * sizeof(T));
+        }
+
+        // default-initialized, a number is not zeroed
+        template<class U>
+        void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new (static_cast<void*>(p)) U;
+        }
+
+        template<class U, class... Args>
+        void construct(U* p, Args&&... args)
+        {
+            ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template<class U>
+        bool operator==(const Allocator<U>&) const noexcept
+        {
+            return true;
+        }
+
+        template<class U>
+        bool operator!=(const Allocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    template<class T>
+    using Vector = std::vector<T, Allocator<T>>;
+}
+
+#endif
@@ -0,0 +1,429 @@
+#ifndef _MAPPED_CATALOG_H_
+#define _MAPPED_CATALOG_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+
+    - a catalog file is the entries of a catalog, a name, a text and a number each, the
+      name, rating and watch of a movie or the name, artist and rating of a song, in a form
+      that is read without being parsed, header only:
+        a header, the magic "bCatalog", the version, a byte order mark and the offsets
+          and sizes of the three parts,
+        the records, 32 bytes each, the offsets and sizes of the name and the text in the
+          heap and the number, in the order the entries were added,
+        the name index, an open addressing table of a 32 bit tag of the hash of the name
+          and the index of its record, a power of two of slots at most half full,
+        the heap, the bytes of the names and the texts one after the other.
+      the parts are 64 byte aligned, the numbers are the ones of the machine that wrote
+      them, a file of the other byte order is refused.
+
+    - Writer collects the entries, a name that is already there is not added again, and
+      save writes the whole file to path.tmp and renames it to path, a process that has the
+      old file mapped keeps reading the old one, a file mapped is never written in place.
+
+    - Catalog maps the file read only and shared, the pages are the ones of the page cache,
+      every process that opens the file reads the same pages, and opening it reads only the
+      header: the records, the index and the heap are read when they are touched, a page
+      fault each the first time. the hash of the names is FNV-1a, it is the one of the file
+      whatever process and build reads it, std::hash is not.
+
+    - the file does not change, the numbers set through a Catalog are kept in a small
+      overlay, a hash map of the index of the record to its number, in front of the ones of
+      the file. save writes the entries with the overlay to a new file.
+
+    - a catalog can be bytes in memory too, e.g. a catalog file embedded in the program at
+      build time, see ioAndStream/embeddedData, 64 byte aligned like the parts, they are not
+      copied and have to outlive the Catalog.
+
+    - the header and the bounds of the parts are checked when the file is opened, the name
+      and the text of a record against the heap when they are read, a file that is not a
+      catalog or that is cut short throws std::runtime_error.
+
+*/
+namespace mapped_catalog
+{
+    namespace detail_mapped_catalog
+    {
+        constexpr char magic[8] {'b', 'C', 'a', 't', 'a', 'l', 'o', 'g'};
+        constexpr std::uint32_t version = 1;
+        constexpr std::uint32_t byte_order = 0x01020304;
+        constexpr std::uint32_t no_record = ~std::uint32_t {0};
+
+        struct Header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint64_t num_records;
+            std::uint64_t num_slots;
+            std::uint64_t heap_size;
+            std::uint64_t records_offset;
+            std::uint64_t slots_offset;
+            std::uint64_t heap_offset;
+        };
+
+        struct Record
+        {
+            std::uint64_t name;
+            std::uint64_t text;
+            std::uint32_t name_size;
+            std::uint32_t text_size;
+            std::int64_t number;
+        };
+
+        struct Slot
+        {
+            std::uint32_t tag;
+            std::uint32_t index; // no_record is an empty slot
+        };
+
+        static_assert(sizeof(Record) == 32 && sizeof(Slot) == 8, "the layout of the file");
+
+        // FNV-1a and a multiply, the low bits are the slot, the high ones the tag
+        inline std::uint64_t hash(std::string_view name)
+        {
+            std::uint64_t h = 0xCBF29CE484222325;
+            for (const char c : name)
+                h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+            return (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9;
+        }
+
+        inline std::uint32_t tag(std::uint64_t hash)
+        {
+            return static_cast<std::uint32_t>(hash >> 32);
+        }
+
+        inline std::uint64_t align(std::uint64_t offset)
+        {
+            return (offset + 63) & ~std::uint64_t {63};
+        }
+
+        inline void fail(const std::string &what)
+        {
+            throw std::runtime_error(what + ": " + std::strerror(errno));
+        }
+    }
+
+    class Writer
+    {
+    private:
+        std::vector<detail_mapped_catalog::Record> records;
+        std::vector<std::uint64_t> hashes;
+        // the index of a record, a power of two of slots at most half full
+        std::vector<std::uint32_t> slots;
+        std::string heap;
+
+        std::string_view get_name(std::uint32_t index) const
+        {
+            const detail_mapped_catalog::Record &record = this->records[index];
+            return std::string_view {this->heap}.substr(record.name, record.name_size);
+        }
+
+        // the slot of name, or the empty one where it goes
+        std::size_t find_slot(std::string_view name, std::uint64_t hash) const
+        {
+            const std::size_t mask = this->slots.size() - 1;
+            for (std::size_t i = hash & mask; ; i = (i + 1) & mask)
+            {
+                const std::uint32_t index = this->slots[i];
+                if (index == detail_mapped_catalog::no_record || (this->hashes[index] == hash && this->get_name(index) == name))
+                    return i;
+            }
+        }
+
+        void grow()
+        {
+            std::vector<std::uint32_t> grown(this->slots.size() * 2, detail_mapped_catalog::no_record);
+            const std::size_t mask = grown.size() - 1;
+            for (const std::uint32_t index : this->slots)
+            {
+                if (index == detail_mapped_catalog::no_record)
+                    continue;
+                std::size_t i = this->hashes[index] & mask;
+                while (grown[i] != detail_mapped_catalog::no_record)
+                    i = (i + 1) & mask;
+                grown[i] = index;
+            }
+            this->slots.swap(grown);
+        }
+
+    public:
+        Writer() : slots(16, detail_mapped_catalog::no_record) {}
+
+        // false when there is already an entry of that name
+        bool add(std::string_view name, std::string_view text, std::int64_t number)
+        {
+            if (name.size() > ~std::uint32_t {0} || text.size() > ~std::uint32_t {0}
+                || this->records.size() == detail_mapped_catalog::no_record)
+                throw std::runtime_error("mapped_catalog: an entry too large for a catalog");
+
+            const std::uint64_t hash = detail_mapped_catalog::hash(name);
+            const std::size_t i = this->find_slot(name, hash);
+            if (this->slots[i] != detail_mapped_catalog::no_record)
+                return false;
+
+            this->slots[i] = static_cast<std::uint32_t>(this->records.size());
+            this->records.push_back({this->heap.size(), this->heap.size() + name.size(),
+                static_cast<std::uint32_t>(name.size()), static_cast<std::uint32_t>(text.size()), number});
+            this->hashes.push_back(hash);
+            this->heap.append(name).append(text);
+            if (this->records.size() * 2 > this->slots.size())
+                this->grow();
+            return true;
+        }
+
+        std::size_t size() const
+        {
+            return this->records.size();
+        }
+
+        void save(const std::string &path) const
+        {
+            using namespace detail_mapped_catalog;
+
+            Header header {};
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.version = version;
+            header.byte_order = byte_order;
+            header.num_records = this->records.size();
+            header.num_slots = this->slots.size();
+            header.heap_size = this->heap.size();
+            header.records_offset = align(sizeof(Header));
+            header.slots_offset = align(header.records_offset + header.num_records * sizeof(Record));
+            header.heap_offset = align(header.slots_offset + header.num_slots * sizeof(Slot));
+
+            std::vector<Slot> table(this->slots.size());
+            for (std::size_t i = 0; i < this->slots.size(); ++i)
+                table[i] = {this->slots[i] == no_record ? 0 : tag(this->hashes[this->slots[i]]), this->slots[i]};
+
+            const std::string temporary {path + ".tmp"};
+            std::ofstream out {temporary, std::ios::binary | std::ios::trunc};
+            if (!out)
+                fail("open " + temporary);
+            const char padding[64] {};
+            const auto write = [&out, &padding](const void *data, std::uint64_t size, std::uint64_t offset, std::uint64_t &at)
+            {
+                out.write(padding, static_cast<std::streamsize>(offset - at));
+                out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+                at = offset + size;
+            };
+            std::uint64_t at = 0;
+            write(&header, sizeof(header), 0, at);
+            write(this->records.data(), this->records.size() * sizeof(Record), header.records_offset, at);
+            write(table.data(), table.size() * sizeof(Slot), header.slots_offset, at);
+            write(this->heap.data(), this->heap.size(), header.heap_offset, at);
+            out.close();
+            if (!out)
+                fail("write " + temporary);
+            if (std::rename(temporary.c_str(), path.c_str()) != 0)
+                fail("rename " + temporary);
+        }
+    };
+
+    class Catalog
+    {
+    private:
+        const char *data {nullptr};
+        std::size_t bytes {0};
+        bool mapped {false};
+        detail_mapped_catalog::Header header {};
+        const detail_mapped_catalog::Record *records {nullptr};
+        const detail_mapped_catalog::Slot *slots {nullptr};
+        const char *heap {nullptr};
+        std::unordered_map<std::uint32_t, std::int64_t> overlay;
+
+        std::string_view get_string(std::uint64_t offset, std::uint32_t size) const
+        {
+            if (offset > this->header.heap_size || size > this->header.heap_size - offset)
+                throw std::runtime_error("mapped_catalog: a string out of the heap");
+            return {this->heap + offset, size};
+        }
+
+        void check(const std::string &path) const
+        {
+            using namespace detail_mapped_catalog;
+
+            const Header &h = this->header;
+            const auto fits = [this](std::uint64_t offset, std::uint64_t count, std::uint64_t size)
+            {
+                return offset <= this->bytes && count <= (this->bytes - offset) / size;
+            };
+            if (std::memcmp(h.magic, magic, sizeof(magic)) != 0)
+                throw std::runtime_error("mapped_catalog: " + path + " is not a catalog");
+            if (h.version != version || h.byte_order != byte_order)
+                throw std::runtime_error("mapped_catalog: " + path + " is of another version or byte order");
+            if (h.num_slots == 0 || (h.num_slots & (h.num_slots - 1)) != 0 || h.num_records >= h.num_slots
+                || h.records_offset % 64 != 0 || h.slots_offset % 64 != 0
+                || !fits(h.records_offset, h.num_records, sizeof(Record)) || !fits(h.slots_offset, h.num_slots, sizeof(Slot))
+                || !fits(h.heap_offset, h.heap_size, 1))
+                throw std::runtime_error("mapped_catalog: " + path + " is cut short or its parts are out of it");
+        }
+
+        void set_parts(const std::string &name)
+        {
+            std::memcpy(&this->header, this->data, sizeof(this->header));
+            this->check(name);
+            this->records = reinterpret_cast<const detail_mapped_catalog::Record *>(this->data + this->header.records_offset);
+            this->slots = reinterpret_cast<const detail_mapped_catalog::Slot *>(this->data + this->header.slots_offset);
+            this->heap = this->data + this->header.heap_offset;
+        }
+
+    public:
+        static constexpr std::size_t npos = ~std::size_t {0};
+
+        explicit Catalog(const std::string &path)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                detail_mapped_catalog::fail("open " + path);
+
+            struct stat st;
+            if (::fstat(fd, &st) < 0)
+            {
+                int error = errno;
+                ::close(fd);
+                errno = error;
+                detail_mapped_catalog::fail("stat " + path);
+            }
+            this->bytes = static_cast<std::size_t>(st.st_size);
+            if (this->bytes < sizeof(detail_mapped_catalog::Header))
+            {
+                ::close(fd);
+                throw std::runtime_error("mapped_catalog: " + path + " is not a catalog");
+            }
+
+            // the mapping stays after the descriptor is closed
+            void *ptr = ::mmap(nullptr, this->bytes, PROT_READ, MAP_SHARED, fd, 0);
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            if (ptr == MAP_FAILED)
+                detail_mapped_catalog::fail("mmap " + path);
+            this->data = static_cast<const char *>(ptr);
+            this->mapped = true;
+
+            try
+            {
+                this->set_parts(path);
+            }
+            catch (...)
+            {
+                ::munmap(ptr, this->bytes);
+                throw;
+            }
+            // the lookups go anywhere in the index and the heap, a read ahead reads pages no one asked for
+            ::madvise(ptr, this->bytes, MADV_RANDOM);
+        }
+
+        Catalog(const void *bytes, std::size_t size)
+            : data {static_cast<const char *>(bytes)}, bytes {size}
+        {
+            if (this->bytes < sizeof(detail_mapped_catalog::Header) || reinterpret_cast<std::uintptr_t>(this->data) % 64 != 0)
+                throw std::runtime_error("mapped_catalog: the bytes are not an aligned catalog");
+            this->set_parts("the bytes");
+        }
+
+        Catalog(const Catalog &) = delete;
+        Catalog &operator=(const Catalog &) = delete;
+
+        ~Catalog()
+        {
+            if (this->mapped)
+                ::munmap(const_cast<char *>(this->data), this->bytes);
+        }
+
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(this->header.num_records);
+        }
+
+        // the record of name, npos when there is none
+        std::size_t find(std::string_view name) const
+        {
+            const std::uint64_t hash = detail_mapped_catalog::hash(name);
+            const std::uint32_t tag = detail_mapped_catalog::tag(hash);
+            const std::size_t mask = static_cast<std::size_t>(this->header.num_slots - 1);
+            for (std::size_t i = hash & mask; ; i = (i + 1) & mask)
+            {
+                const detail_mapped_catalog::Slot slot = this->slots[i];
+                if (slot.index == detail_mapped_catalog::no_record)
+                    return npos;
+                if (slot.tag == tag && slot.index < this->header.num_records && this->get_name(slot.index) == name)
+                    return slot.index;
+            }
+        }
+
+        // views into the mapping, i < size(), they live as long as the Catalog
+        std::string_view get_name(std::size_t i) const
+        {
+            return this->get_string(this->records[i].name, this->records[i].name_size);
+        }
+
+        std::string_view get_text(std::size_t i) const
+        {
+            return this->get_string(this->records[i].text, this->records[i].text_size);
+        }
+
+        std::int64_t get_number(std::size_t i) const
+        {
+            if (!this->overlay.empty())
+            {
+                auto it = this->overlay.find(static_cast<std::uint32_t>(i));
+                if (it != this->overlay.end())
+                    return it->second;
+            }
+            return this->records[i].number;
+        }
+
+        void set_number(std::size_t i, std::int64_t number)
+        {
+            this->overlay[static_cast<std::uint32_t>(i)] = number;
+        }
+
+        // the records whose number was set
+        std::size_t get_num_changes() const
+        {
+            return this->overlay.size();
+        }
+
+        // the bytes of the file, mapped, not read
+        std::size_t get_bytes() const
+        {
+            return this->bytes;
+        }
+
+        // the entries with the numbers set, to a new file, path can be the one of this catalog
+        void save(const std::string &path) const
+        {
+            Writer writer;
+            for (std::size_t i = 0; i < this->size(); ++i)
+                writer.add(this->get_name(i), this->get_text(i), this->get_number(i));
+            writer.save(path);
+        }
+    };
+
+    // the file starts with the magic of a catalog
+    inline bool is_catalog(const std::string &path)
+    {
+        char head[sizeof(detail_mapped_catalog::magic)] {};
+        std::ifstream in {path, std::ios::binary};
+        return in.read(head, sizeof(head)) && std::memcmp(head, detail_mapped_catalog::magic, sizeof(head)) == 0;
+    }
+}
+
+#endif
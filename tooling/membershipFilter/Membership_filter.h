@@ -0,0 +1,371 @@
+#ifndef _MEMBERSHIP_FILTER_H_
+#define _MEMBERSHIP_FILTER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - filters in front of a table, header only: whether a key may be in it, from a few bits
+      per key that stay in the cache, a key that is not in the filter is not in the table
+      and the table is not touched. most lookups of the examples are of names that are not
+      there, a miss is then one cache line instead of the probes of the table.
+
+    - Bloom_filter is a blocked one, the split block one of Impala and Parquet: a key sets 8
+      bits of one block of 256 bits, one bit in each of its 8 words, from 8 multiplies of
+      its hash, the block is 32 bytes aligned, in one cache line. with AVX2 the 8 bits are
+      one multiply, shift and compare of a block, scalar otherwise. 10 bits a key is about
+      1.3 % false positives, 16 about 0.1 %. keys are never removed, clear empties it.
+
+    - Cuckoo_filter keeps a 16 bit fingerprint of a key in one of its 2 buckets of 4, the
+      other bucket is the first one xor a hash of the fingerprint, so a fingerprint is moved
+      to its other bucket without the key. erase removes a key that was inserted, a key
+      that was not can take the fingerprint of another one. about 0.01 % false positives at
+      2 bytes a slot, the buckets are a power of 2, insert is false when it is full, at
+      about 95 % of its slots.
+
+    - both take the hash of Hash, std::hash by default, mixed, std::hash of an int is the
+      int. a table that keeps the hashes of its keys gives them to insert_hash and
+      may_contain_hash, a rebuild does not hash the keys again. the batches hash a group of
+      keys, prefetch their blocks and then test them, the misses of the cache overlap.
+
+*/
+namespace membership_filter
+{
+    namespace detail_membership_filter
+    {
+        // the keys of a batch hashed and prefetched at once
+        constexpr std::size_t group_size = 16;
+
+        // the finalizer of murmur3, every bit of the hash changes half of the bits
+        inline std::uint64_t mix(std::uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        // odd constants, word i of a block gets the bit of the top 5 bits of hash * salts[i]
+        alignas(32) constexpr std::uint32_t salts[8] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+        struct alignas(32) Block
+        {
+            std::uint32_t words[8];
+        };
+
+#if defined(__AVX2__)
+        inline __m256i block_mask(std::uint32_t hash)
+        {
+            const __m256i products = _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(hash)),
+                _mm256_load_si256(reinterpret_cast<const __m256i *>(salts)));
+            return _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_srli_epi32(products, 27));
+        }
+
+        inline void set_bits(Block &block, std::uint32_t hash)
+        {
+            __m256i *words = reinterpret_cast<__m256i *>(block.words);
+            _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), block_mask(hash)));
+        }
+
+        inline bool has_bits(const Block &block, std::uint32_t hash)
+        {
+            return _mm256_testc_si256(_mm256_load_si256(reinterpret_cast<const __m256i *>(block.words)), block_mask(hash));
+        }
+#else
+        inline void set_bits(Block &block, std::uint32_t hash)
+        {
+            for (int i = 0; i < 8; ++i)
+                block.words[i] |= std::uint32_t {1} << ((hash * salts[i]) >> 27);
+        }
+
+        inline bool has_bits(const Block &block, std::uint32_t hash)
+        {
+            std::uint32_t missing = 0;
+            for (int i = 0; i < 8; ++i)
+                missing |= ~block.words[i] & std::uint32_t {1} << ((hash * salts[i]) >> 27);
+            return missing == 0;
+        }
+#endif
+
+        inline std::size_t round_up_to_power_of_2(std::size_t n)
+        {
+            std::size_t power = 1;
+            while (power < n)
+                power <<= 1;
+            return power;
+        }
+    }
+
+    template<typename Key, typename Hash = std::hash<Key>>
+    class Bloom_filter
+    {
+    private:
+        std::vector<detail_membership_filter::Block> blocks;
+        std::size_t inserted {0};
+        Hash hasher;
+
+        // the high 32 bits pick the block, a multiply instead of a modulo, the low 32 the bits
+        std::size_t block_of(std::uint64_t mixed) const
+        {
+            return static_cast<std::size_t>(((mixed >> 32) * this->blocks.size()) >> 32);
+        }
+
+    public:
+        // room for expected keys at bits_per_key, more keys only raise the false positives
+        explicit Bloom_filter(std::size_t expected = 1024, double bits_per_key = 10, const Hash &hasher = Hash {})
+            : hasher(hasher)
+        {
+            const double bits = static_cast<double>(expected) * bits_per_key;
+            this->blocks.resize(static_cast<std::size_t>(bits / 256) + 1, detail_membership_filter::Block {});
+        }
+
+        void insert(const Key &key) { this->insert_hash(this->hasher(key)); }
+        bool may_contain(const Key &key) const { return this->may_contain_hash(this->hasher(key)); }
+
+        // hash is what Hash gives for the key
+        void insert_hash(std::uint64_t hash)
+        {
+            const std::uint64_t mixed = detail_membership_filter::mix(hash);
+            detail_membership_filter::set_bits(this->blocks[this->block_of(mixed)], static_cast<std::uint32_t>(mixed));
+            ++this->inserted;
+        }
+
+        bool may_contain_hash(std::uint64_t hash) const
+        {
+            const std::uint64_t mixed = detail_membership_filter::mix(hash);
+            return detail_membership_filter::has_bits(this->blocks[this->block_of(mixed)], static_cast<std::uint32_t>(mixed));
+        }
+
+        // out[i] is may_contain(keys[i])
+        void may_contain(const Key *keys, std::size_t count, bool *out) const
+        {
+            std::uint64_t hashes[detail_membership_filter::group_size];
+            for (std::size_t begin = 0; begin < count; begin += detail_membership_filter::group_size)
+            {
+                const std::size_t n = count - begin < detail_membership_filter::group_size ? count - begin : detail_membership_filter::group_size;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    hashes[i] = detail_membership_filter::mix(this->hasher(keys[begin + i]));
+                    __builtin_prefetch(&this->blocks[this->block_of(hashes[i])]);
+                }
+                for (std::size_t i = 0; i < n; ++i)
+                    out[begin + i] = detail_membership_filter::has_bits(this->blocks[this->block_of(hashes[i])], static_cast<std::uint32_t>(hashes[i]));
+            }
+        }
+
+        void clear()
+        {
+            std::memset(static_cast<void *>(this->blocks.data()), 0, this->blocks.size() * sizeof(detail_membership_filter::Block));
+            this->inserted = 0;
+        }
+
+        // the inserts since the last clear, a key inserted twice is counted twice
+        std::size_t get_inserted() const { return this->inserted; }
+        std::size_t size_in_bytes() const { return this->blocks.size() * sizeof(detail_membership_filter::Block); }
+    };
+
+    template<typename Key, typename Hash = std::hash<Key>>
+    class Cuckoo_filter
+    {
+    private:
+        static constexpr std::size_t bucket_size = 4;
+        static constexpr int max_kicks = 500;
+
+        // bucket_size fingerprints a bucket, 0 is an empty slot
+        std::vector<std::uint16_t> slots;
+        std::size_t bucket_mask;
+        std::size_t count {0};
+        // the fingerprint a full insert could not place, it is still in the filter
+        bool has_victim {false};
+        std::size_t victim_bucket {0};
+        std::uint16_t victim {0};
+        std::uint64_t random {0x9e3779b97f4a7c15ULL};
+        Hash hasher;
+
+        static std::uint16_t fingerprint(std::uint64_t mixed)
+        {
+            const std::uint16_t print = static_cast<std::uint16_t>(mixed >> 48);
+            return print == 0 ? 1 : print;
+        }
+
+        std::size_t other_bucket(std::size_t bucket, std::uint16_t print) const
+        {
+            return (bucket ^ static_cast<std::size_t>(print * 0x5bd1e995U)) & this->bucket_mask;
+        }
+
+        bool bucket_has(std::size_t bucket, std::uint16_t print) const
+        {
+            const std::uint16_t *slot = &this->slots[bucket * bucket_size];
+            return (slot[0] == print) | (slot[1] == print) | (slot[2] == print) | (slot[3] == print);
+        }
+
+        bool buckets_have(std::size_t first, std::size_t second, std::uint16_t print) const
+        {
+#if defined(__SSE2__)
+            // the 2 buckets are 8 bytes each, one compare of 8 fingerprints
+            std::uint64_t a;
+            std::uint64_t b;
+            std::memcpy(&a, &this->slots[first * bucket_size], sizeof a);
+            std::memcpy(&b, &this->slots[second * bucket_size], sizeof b);
+            const __m128i both = _mm_set_epi64x(static_cast<long long>(b), static_cast<long long>(a));
+            return _mm_movemask_epi8(_mm_cmpeq_epi16(both, _mm_set1_epi16(static_cast<short>(print)))) != 0;
+#else
+            return this->bucket_has(first, print) || this->bucket_has(second, print);
+#endif
+        }
+
+        bool put(std::size_t bucket, std::uint16_t print)
+        {
+            std::uint16_t *slot = &this->slots[bucket * bucket_size];
+            for (std::size_t i = 0; i < bucket_size; ++i)
+                if (slot[i] == 0)
+                {
+                    slot[i] = print;
+                    return true;
+                }
+            return false;
+        }
+
+        bool take(std::size_t bucket, std::uint16_t print)
+        {
+            std::uint16_t *slot = &this->slots[bucket * bucket_size];
+            for (std::size_t i = 0; i < bucket_size; ++i)
+                if (slot[i] == print)
+                {
+                    slot[i] = 0;
+                    return true;
+                }
+            return false;
+        }
+
+        // moves fingerprints to their other bucket until one has room, the last one left out is the victim
+        void place(std::size_t bucket, std::uint16_t print)
+        {
+            for (int kick = 0; kick < max_kicks; ++kick)
+            {
+                if (this->put(bucket, print))
+                    return;
+                this->random ^= this->random << 13;
+                this->random ^= this->random >> 7;
+                this->random ^= this->random << 17;
+                std::uint16_t &out = this->slots[bucket * bucket_size + (this->random & (bucket_size - 1))];
+                const std::uint16_t kicked = out;
+                out = print;
+                print = kicked;
+                bucket = this->other_bucket(bucket, print);
+            }
+            this->has_victim = true;
+            this->victim_bucket = bucket;
+            this->victim = print;
+        }
+
+    public:
+        // room for expected keys at 95 % of the slots
+        explicit Cuckoo_filter(std::size_t expected = 1024, const Hash &hasher = Hash {})
+            : hasher(hasher)
+        {
+            const std::size_t buckets = detail_membership_filter::round_up_to_power_of_2(expected * 100 / 95 / bucket_size + 1);
+            this->slots.assign(buckets * bucket_size, 0);
+            this->bucket_mask = buckets - 1;
+        }
+
+        bool insert(const Key &key) { return this->insert_hash(this->hasher(key)); }
+        bool may_contain(const Key &key) const { return this->may_contain_hash(this->hasher(key)); }
+        bool erase(const Key &key) { return this->erase_hash(this->hasher(key)); }
+
+        // false when the filter is full, the key is not in it then
+        bool insert_hash(std::uint64_t hash)
+        {
+            if (this->has_victim)
+                return false;
+            const std::uint64_t mixed = detail_membership_filter::mix(hash);
+            const std::uint16_t print = fingerprint(mixed);
+            const std::size_t first = static_cast<std::size_t>(mixed) & this->bucket_mask;
+            ++this->count;
+            if (!this->put(first, print) && !this->put(this->other_bucket(first, print), print))
+                this->place(first, print);
+            return true;
+        }
+
+        bool may_contain_hash(std::uint64_t hash) const
+        {
+            const std::uint64_t mixed = detail_membership_filter::mix(hash);
+            const std::uint16_t print = fingerprint(mixed);
+            const std::size_t first = static_cast<std::size_t>(mixed) & this->bucket_mask;
+            const std::size_t second = this->other_bucket(first, print);
+            if (this->has_victim && this->victim == print && (this->victim_bucket == first || this->victim_bucket == second))
+                return true;
+            return this->buckets_have(first, second, print);
+        }
+
+        // false when the key is not there, only a key that was inserted is erased
+        bool erase_hash(std::uint64_t hash)
+        {
+            const std::uint64_t mixed = detail_membership_filter::mix(hash);
+            const std::uint16_t print = fingerprint(mixed);
+            const std::size_t first = static_cast<std::size_t>(mixed) & this->bucket_mask;
+            const std::size_t second = this->other_bucket(first, print);
+            if (this->has_victim && this->victim == print && (this->victim_bucket == first || this->victim_bucket == second))
+                this->has_victim = false;
+            else if (!this->take(first, print) && !this->take(second, print))
+                return false;
+            --this->count;
+
+            // a slot is free now, the victim goes back into the table
+            if (this->has_victim)
+            {
+                this->has_victim = false;
+                this->place(this->victim_bucket, this->victim);
+            }
+            return true;
+        }
+
+        void may_contain(const Key *keys, std::size_t count, bool *out) const
+        {
+            std::uint64_t hashes[detail_membership_filter::group_size];
+            for (std::size_t begin = 0; begin < count; begin += detail_membership_filter::group_size)
+            {
+                const std::size_t n = count - begin < detail_membership_filter::group_size ? count - begin : detail_membership_filter::group_size;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    hashes[i] = this->hasher(keys[begin + i]);
+                    const std::uint64_t mixed = detail_membership_filter::mix(hashes[i]);
+                    const std::size_t first = static_cast<std::size_t>(mixed) & this->bucket_mask;
+                    __builtin_prefetch(&this->slots[first * bucket_size]);
+                    __builtin_prefetch(&this->slots[this->other_bucket(first, fingerprint(mixed)) * bucket_size]);
+                }
+                for (std::size_t i = 0; i < n; ++i)
+                    out[begin + i] = this->may_contain_hash(hashes[i]);
+            }
+        }
+
+        void clear()
+        {
+            std::fill(this->slots.begin(), this->slots.end(), std::uint16_t {0});
+            this->count = 0;
+            this->has_victim = false;
+        }
+
+        std::size_t size() const { return this->count; }
+        std::size_t get_capacity() const { return this->slots.size(); }
+        double load_factor() const { return static_cast<double>(this->count) / static_cast<double>(this->slots.size()); }
+        std::size_t size_in_bytes() const { return this->slots.size() * sizeof(std::uint16_t); }
+    };
+}
+
+#endif
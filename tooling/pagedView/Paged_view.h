@@ -0,0 +1,106 @@
+#ifndef _PAGED_VIEW_H_
+#define _PAGED_VIEW_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+
+    - a Paged_view is the text of a window of the rows of a collection, the 50 rows of a page
+      of a UI out of 10M of them, header only. page(offset, limit, num_rows) formats the rows of
+      the window, one line each, and nothing else, a display of the whole collection formats
+      all of them every time.
+
+    - the view does not know the collection, two functions do, stamp(row) is a number that
+      changes when the text of the row would, a version of the record, any value that can be
+      compared and default constructed, a pair of the record and its version, format(row, text)
+      appends the text of the row, without the newline. a row is formatted again only when
+      its stamp is not the one it was formatted with, a page shown again costs a stamp a row
+      and a copy of the text.
+
+    - the rows formatted are kept in a table of capacity slots, a power of 2, the slot of row
+      i is i & (capacity - 1), no list and no hash to keep up, a window of up to capacity rows
+      in a row never has two rows in one slot, the ones of a page that was not shown in a
+      while are written over.
+
+    - the text of a page is good until the next page, the view is for one thread.
+
+*/
+namespace paged_view
+{
+    template <typename Stamp, typename Format>
+    class Paged_view
+    {
+    private:
+        static constexpr std::size_t def_capacity = 1024;
+        static constexpr std::size_t no_row = ~std::size_t {0};
+
+        using Value = std::decay_t<std::invoke_result_t<Stamp&, std::size_t>>;
+
+        struct Row
+        {
+            std::size_t index {no_row};
+            Value stamp {};
+            std::string text;
+        };
+
+        Stamp stamp;
+        Format format;
+        std::vector<Row> rows;
+        std::size_t mask;
+        std::string text;
+        std::size_t num_formatted {0};
+
+        static std::size_t round_up(std::size_t n)
+        {
+            std::size_t capacity = 1;
+            while (capacity < n)
+                capacity <<= 1;
+            return capacity;
+        }
+
+    public:
+        Paged_view(Stamp stamp, Format format, std::size_t capacity = def_capacity)
+            : stamp(std::move(stamp)), format(std::move(format)), rows(round_up(capacity)), mask(rows.size() - 1) {}
+
+        // the rows [offset, offset + limit) of the num_rows there are, the ones past the end are not there
+        std::string_view page(std::size_t offset, std::size_t limit, std::size_t num_rows)
+        {
+            this->text.clear();
+            const std::size_t last = offset < num_rows ? offset + std::min(limit, num_rows - offset) : offset;
+            for (std::size_t i = offset; i < last; ++i)
+            {
+                Row& row = this->rows[i & this->mask];
+                Value now = this->stamp(i);
+                if (row.index != i || row.stamp != now)
+                {
+                    row.index = i;
+                    row.stamp = std::move(now);
+                    row.text.clear();
+                    this->format(i, row.text);
+                    ++this->num_formatted;
+                }
+                this->text += row.text;
+                this->text += '\n';
+            }
+            return this->text;
+        }
+
+        // the rows formatted so far, not the ones that came from the table
+        std::size_t get_num_formatted() const { return this->num_formatted; }
+
+        // every row is formatted again, for a collection that changed all at once
+        void clear()
+        {
+            for (Row& row : this->rows)
+                row.index = no_row;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+
+    - a page of 50 rows out of n, 10M by default, shown the way a UI refreshes it, against
+      formatting all of them the way a display of the whole collection does:
+        g++ -std=c++17 -O2 index.cpp
+        ./a.out [n]
+
+    - a page that is not the rows it should be is reported and the exit code is 1.
+
+    - on one core of an x86-64 at -O2, 10M rows of a name and a balance:
+        all the rows               1.46 s
+        a page, first time         15 us    50 rows formatted
+        the page again             0.6 us   0 rows formatted
+        the page, one row changed  0.7 us   1 row formatted
+      the page again is a stamp and a copy of the text a row.
+
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Paged_view.h"
+
+struct Record
+{
+    std::uint32_t version;
+    std::int64_t cents;
+};
+
+void format_row(const std::vector<Record>& records, std::size_t row, std::string& text)
+{
+    text += "customer ";
+    text += std::to_string(row);
+    text += ", balance: ";
+    text += std::to_string(records[row].cents / 100);
+    text += '.';
+    text += std::to_string(records[row].cents % 100 / 10);
+    text += std::to_string(records[row].cents % 10);
+}
+
+template <typename F>
+double time_us(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::vector<Record> records(n);
+    for (std::size_t i = 0; i < n; ++i)
+        records[i] = Record {0, static_cast<std::int64_t>(i % 100000) * 7};
+
+    paged_view::Paged_view view {
+        [&records](std::size_t row) { return records[row].version; },
+        [&records](std::size_t row, std::string& text) { format_row(records, row, text); }};
+
+    std::string all;
+    const double all_us = time_us([&]() {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            format_row(records, i, all);
+            all += '\n';
+        }
+    });
+
+    const std::size_t offset = n / 2;
+    std::string_view page;
+    bool failed = false;
+    auto show = [&](const char* name) {
+        const std::size_t before = view.get_num_formatted();
+        const double us = time_us([&]() { page = view.page(offset, 50, n); });
+        std::string expected;
+        for (std::size_t i = offset; i < offset + 50 && i < n; ++i)
+        {
+            format_row(records, i, expected);
+            expected += '\n';
+        }
+        if (page != expected)
+        {
+            std::cout << "the page of " << name << " is not the rows" << std::endl;
+            failed = true;
+        }
+        std::cout << name << ": " << us << " us, " << view.get_num_formatted() - before << " rows formatted" << std::endl;
+    };
+
+    std::cout << "all " << n << " rows: " << all_us / 1000 << " ms" << std::endl;
+    show("a page, first time");
+    show("the page again");
+    if (offset + 3 < n)
+    {
+        records[offset + 3].cents += 100;
+        ++records[offset + 3].version;
+    }
+    show("the page, one row changed");
+    std::cout << page.substr(0, page.find('\n') + 1);
+    return failed ? 1 : 0;
+}
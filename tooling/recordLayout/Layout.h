@@ -0,0 +1,101 @@
+#ifndef _LAYOUT_H_
+#define _LAYOUT_H_
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+
+/*
+
+    - a Layout is where the fields of a record are, built at compile time from sizeof,
+      alignof and offsetof, header only. get_padding() is the bytes of the record no field
+      is in, the holes between the fields and the tail a next record of an array starts
+      after, a static_assert on it keeps a packed record packed.
+
+    - the fields are listed with RECORD_LAYOUT_FIELD(T, member), in any order, they are kept
+      by offset. offsetof is only defined for a standard layout type, a class with a vptr or
+      private fields is laid out as a mirror, a struct of the same fields in the same order
+      with a const void* first for the vptr, and a static_assert that its sizeof is the one
+      of the class.
+
+    - print() writes a line a field, its offset, its size and the cache line it is in when
+      the record starts at one, then a line for every hole.
+
+*/
+namespace record_layout
+{
+    constexpr std::size_t cache_line = 64;
+
+    struct Field
+    {
+        const char* name;
+        std::size_t offset;
+        std::size_t size;
+        std::size_t align;
+    };
+
+    template <std::size_t N>
+    struct Layout
+    {
+        const char* name;
+        std::size_t size;
+        std::size_t align;
+        std::array<Field, N> fields;
+
+        // the bytes of the record that are in no field
+        constexpr std::size_t get_padding() const
+        {
+            std::size_t used = 0;
+            for (const Field& field : this->fields)
+                used += field.size;
+            return this->size - used;
+        }
+
+        // the records an array of them has in a cache line, 0 when one is bigger than a line
+        constexpr std::size_t get_per_line() const { return cache_line / this->size; }
+    };
+
+    template <typename T, typename... Fields>
+    constexpr Layout<sizeof...(Fields)> make_layout(const char* name, Fields... fields)
+    {
+        static_assert(std::is_standard_layout_v<T>, "offsetof needs a standard layout type, lay out a mirror of it");
+        Layout<sizeof...(Fields)> layout {name, sizeof(T), alignof(T), {fields...}};
+        // by offset, an insertion sort, a record has a handful of fields
+        for (std::size_t i = 1; i < layout.fields.size(); ++i)
+            for (std::size_t j = i; j > 0 && layout.fields[j - 1].offset > layout.fields[j].offset; --j)
+            {
+                const Field field = layout.fields[j];
+                layout.fields[j] = layout.fields[j - 1];
+                layout.fields[j - 1] = field;
+            }
+        return layout;
+    }
+
+    template <std::size_t N>
+    void print(std::ostream& os, const Layout<N>& layout)
+    {
+        os << layout.name << ": " << layout.size << " bytes, align " << layout.align << ", " << layout.get_padding()
+           << " bytes of padding, " << layout.get_per_line() << " a cache line\n";
+        std::size_t at = 0;
+        auto hole = [&os](std::size_t from, std::size_t to) {
+            if (from < to)
+                os << "    " << from << "\t" << to - from << "\t\t(padding)\n";
+        };
+        for (const Field& field : layout.fields)
+        {
+            hole(at, field.offset);
+            os << "    " << field.offset << "\t" << field.size << "\tline " << field.offset / cache_line;
+            if ((field.offset + field.size - 1) / cache_line != field.offset / cache_line)
+                os << "-" << (field.offset + field.size - 1) / cache_line;
+            os << "\t" << field.name << "\n";
+            at = field.offset + field.size;
+        }
+        hole(at, layout.size);
+    }
+}
+
+#define RECORD_LAYOUT_FIELD(T, member) \
+    ::record_layout::Field {#member, offsetof(T, member), sizeof(T::member), alignof(decltype(T::member))}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef _NAME_TABLE_H_
+#define _NAME_TABLE_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+
+    - a Name_table is the side table of the strings of packed records, a record keeps the
+      4 byte id add() returned instead of a std::string, 32 bytes in it and a heap block for
+      a name of more than 15 chars. a name costs its chars and 4 bytes of end here, all of
+      them in one buffer.
+
+    - the names are not interned, two records of the same name have two ids, see
+      standardTemplateLibrary/challengeTwo/Symbol.h for that. a name does not change once
+      added, a record that renames itself takes a new id, the old chars stay.
+
+    - get() is a view into the buffer, good until the next add.
+
+*/
+namespace record_layout
+{
+    class Name_table
+    {
+    private:
+        std::string chars;
+        std::vector<std::uint32_t> ends;
+
+    public:
+        std::uint32_t add(std::string_view name)
+        {
+            if (this->chars.size() + name.size() > UINT32_MAX || this->ends.size() == UINT32_MAX)
+                throw std::overflow_error("Name_table: more than 4 GB of names");
+            this->chars += name;
+            this->ends.push_back(static_cast<std::uint32_t>(this->chars.size()));
+            return static_cast<std::uint32_t>(this->ends.size() - 1);
+        }
+
+        std::string_view get(std::uint32_t id) const
+        {
+            const std::uint32_t begin = id == 0 ? 0 : this->ends[id - 1];
+            return std::string_view {this->chars}.substr(begin, this->ends[id] - begin);
+        }
+
+        std::size_t size() const { return this->ends.size(); }
+
+        // what the table holds, its buffers at their capacity
+        std::size_t get_bytes() const
+        {
+            return this->chars.capacity() + this->ends.capacity() * sizeof(std::uint32_t);
+        }
+
+        void reserve(std::size_t num_names, std::size_t num_chars)
+        {
+            this->ends.reserve(num_names);
+            this->chars.reserve(num_chars);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef _RECORD_PARSER_H_
+#define _RECORD_PARSER_H_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - the records of a delimited file, csv by default, header only: a Parser takes them out
+      of the text of the whole file, e.g. the one of batch_io::read_all, a Record is the
+      views of its fields into that text, nothing is copied.
+
+        std::string text {batch_io::read_all("movies.csv")};
+        record_parser::Parser parser {text};
+        record_parser::Record record;
+        while (parser.next(record))
+            movies.emplace(record[0], record[1], record.get<int>(2));
+
+    - the text is indexed 64 bytes at a time, a bit per byte that is a quote, a delimiter or
+      a '\n', from a compare of 2 AVX2 or 4 SSE2 blocks. the bits inside quotes are the
+      prefix xor of the quote bits, carried over from a block to the next, the delimiters
+      and the '\n' that are not inside quotes are the ends of the fields and of the
+      records. the ends of 16 KiB of text are indexed at a time, next only walks it.
+
+    - the fields are the rfc 4180 ones: a quoted field can have delimiters and '\n' in it,
+      "" is a quote, the quotes around it are not part of the field. a field that has ""
+      is unescaped in place, that is why the text is not const, every other field is a
+      view as it is. a '\r' before the '\n' of a record is dropped, empty lines are
+      skipped, a quote that is not closed at the end of the text throws.
+
+    - get<T> is std::from_chars of the whole field for the integers and the floating point
+      types, "12abc" is not a number, like the Block_reader of ioAndStream. a field that is
+      not one throws std::runtime_error with the number of the record, the bool overload
+      gives false instead.
+
+*/
+namespace record_parser
+{
+    namespace detail_record_parser
+    {
+        // the bytes of a block, one bit per byte
+        constexpr std::size_t block_size = 64;
+
+        struct Masks
+        {
+            std::uint64_t quotes;
+            std::uint64_t delimiters;
+            std::uint64_t newlines;
+        };
+
+#if defined(__AVX2__)
+        inline std::uint64_t equal(__m256i lo, __m256i hi, char c)
+        {
+            const __m256i v = _mm256_set1_epi8(c);
+            const std::uint32_t low = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)));
+            const std::uint32_t high = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)));
+            return low | static_cast<std::uint64_t>(high) << 32;
+        }
+
+        inline Masks masks(const char *data, char quote, char delimiter)
+        {
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 32));
+            return {equal(lo, hi, quote), equal(lo, hi, delimiter), equal(lo, hi, '\n')};
+        }
+#elif defined(__SSE2__)
+        inline std::uint64_t equal(const __m128i (&blocks)[4], char c)
+        {
+            const __m128i v = _mm_set1_epi8(c);
+            std::uint64_t bits = 0;
+            for (int i = 0; i < 4; ++i)
+                bits |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(blocks[i], v)))) << (16 * i);
+            return bits;
+        }
+
+        inline Masks masks(const char *data, char quote, char delimiter)
+        {
+            const __m128i blocks[4] = {
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 48))};
+            return {equal(blocks, quote), equal(blocks, delimiter), equal(blocks, '\n')};
+        }
+#else
+        inline Masks masks(const char *data, char quote, char delimiter)
+        {
+            Masks m {0, 0, 0};
+            for (std::size_t i = 0; i < block_size; ++i)
+            {
+                m.quotes |= static_cast<std::uint64_t>(data[i] == quote) << i;
+                m.delimiters |= static_cast<std::uint64_t>(data[i] == delimiter) << i;
+                m.newlines |= static_cast<std::uint64_t>(data[i] == '\n') << i;
+            }
+            return m;
+        }
+#endif
+
+        // bit i is the xor of the bits up to i, 1 from an opening quote to its closing one
+        inline std::uint64_t prefix_xor(std::uint64_t bits)
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        template<typename T>
+        bool parse(std::string_view field, T &value)
+        {
+            const char *last = field.data() + field.size();
+            const std::from_chars_result result = std::from_chars(field.data(), last, value);
+            return result.ec == std::errc {} && result.ptr == last;
+        }
+    }
+
+    class Record
+    {
+        friend class Parser;
+
+    private:
+        std::vector<std::string_view> fields;
+        std::size_t number {0};
+
+    public:
+        std::size_t size() const { return this->fields.size(); }
+        std::string_view operator[](std::size_t i) const { return this->fields[i]; }
+
+        // 1 based, the header is record 1
+        std::size_t get_number() const { return this->number; }
+
+        // false when there is no field i or it is not a T
+        template<typename T>
+        bool get(std::size_t i, T &value) const
+        {
+            if (i >= this->fields.size())
+                return false;
+            if constexpr (std::is_same<T, std::string_view>::value)
+            {
+                value = this->fields[i];
+                return true;
+            }
+            else
+                return detail_record_parser::parse(this->fields[i], value);
+        }
+
+        template<typename T>
+        T get(std::size_t i) const
+        {
+            T value {};
+            if (i >= this->fields.size())
+                throw std::runtime_error("record " + std::to_string(this->number) + ": field " + std::to_string(i + 1)
+                    + " is missing, the record has " + std::to_string(this->fields.size()));
+            if (!this->get(i, value))
+                throw std::runtime_error("record " + std::to_string(this->number) + ", field " + std::to_string(i + 1)
+                    + ": \"" + std::string {this->fields[i]} + "\" is not a number");
+            return value;
+        }
+    };
+
+    class Parser
+    {
+    private:
+        static constexpr std::size_t batch_size = 16 << 10;
+
+        char *data;
+        std::size_t size;
+        char delimiter;
+        char quote;
+
+        // the ends of the fields of the batch, the last one of a record is a '\n' or size
+        std::vector<std::size_t> ends;
+        std::size_t end_count {0};
+        std::size_t next_end {0};
+        // the text up to indexed is in ends
+        std::size_t indexed {0};
+        // all ones when the bytes up to indexed end inside quotes
+        std::uint64_t inside {0};
+        // the first byte of the next field
+        std::size_t field_begin {0};
+        std::size_t records {0};
+
+        void index_batch()
+        {
+            std::size_t *out = this->ends.data();
+            const std::size_t stop = this->size - this->indexed > batch_size ? this->indexed + batch_size : this->size;
+
+            for (; this->indexed < stop; this->indexed += detail_record_parser::block_size)
+            {
+                detail_record_parser::Masks m;
+                if (this->size - this->indexed >= detail_record_parser::block_size)
+                    m = detail_record_parser::masks(this->data + this->indexed, this->quote, this->delimiter);
+                else
+                {
+                    // the last bytes, padded with ones that are none of the three
+                    char tail[detail_record_parser::block_size];
+                    const char pad = this->quote != ' ' && this->delimiter != ' ' ? ' ' : 'x';
+                    std::memset(tail, pad, sizeof tail);
+                    std::memcpy(tail, this->data + this->indexed, this->size - this->indexed);
+                    m = detail_record_parser::masks(tail, this->quote, this->delimiter);
+                }
+
+                const std::uint64_t quoted = detail_record_parser::prefix_xor(m.quotes) ^ this->inside;
+                this->inside = static_cast<std::uint64_t>(static_cast<std::int64_t>(quoted) >> 63);
+                for (std::uint64_t bits = (m.delimiters | m.newlines) & ~quoted; bits != 0; bits &= bits - 1)
+                    *out++ = this->indexed + static_cast<std::size_t>(__builtin_ctzll(bits));
+            }
+            if (this->indexed > this->size)
+                this->indexed = this->size;
+
+            if (this->indexed == this->size)
+            {
+                if (this->inside)
+                    throw std::runtime_error("record " + std::to_string(this->records + 1) + ": a quoted field is not closed");
+                // the last record has no '\n'
+                if (this->size > 0 && this->data[this->size - 1] != '\n')
+                    *out++ = this->size;
+            }
+            this->end_count = static_cast<std::size_t>(out - this->ends.data());
+            this->next_end = 0;
+        }
+
+        // the field from begin to end, without its quotes and the '\r' at the end of a record
+        std::string_view field(std::size_t begin, std::size_t end, bool last) const
+        {
+            end -= last & (end > begin) & (this->data[end - (end > 0)] == '\r');
+            if (this->data[begin] != this->quote || end - begin < 2 || this->data[end - 1] != this->quote)
+                return {this->data + begin, end - begin};
+
+            char *first = this->data + begin + 1;
+            const std::size_t length = end - begin - 2;
+            char *escaped = static_cast<char *>(std::memchr(first, this->quote, length));
+            if (escaped == nullptr)
+                return {first, length};
+
+            // "" is one quote, the field gets shorter, the bytes after it are not read again
+            char *to = escaped;
+            for (const char *from = escaped; from < first + length; ++from)
+            {
+                *to++ = *from;
+                if (*from == this->quote && from + 1 < first + length && from[1] == this->quote)
+                    ++from;
+            }
+            return {first, static_cast<std::size_t>(to - first)};
+        }
+
+    public:
+        explicit Parser(std::string &text, char delimiter = ',', char quote = '"')
+            : data(text.data()), size(text.size()), delimiter(delimiter), quote(quote), ends(batch_size + 1) {}
+
+        Parser(const Parser &) = delete;
+        Parser &operator=(const Parser &) = delete;
+
+        // false at the end of the text
+        bool next(Record &record)
+        {
+            record.fields.clear();
+            for (;;)
+            {
+                if (this->next_end == this->end_count)
+                {
+                    if (this->indexed == this->size)
+                        return false;
+                    this->index_batch();
+                    continue;
+                }
+
+                // in locals, the stores of the unescaping are of char, they could be any member,
+                // data[size] is the '\0' of the std::string
+                const std::size_t *ends = this->ends.data();
+                const std::size_t count = this->end_count;
+                std::size_t i = this->next_end;
+                std::size_t begin = this->field_begin;
+                bool last = false;
+                while (!last && i < count)
+                {
+                    const std::size_t end = ends[i++];
+                    last = this->data[end] == '\n' || end == this->size;
+                    record.fields.push_back(this->field(begin, end, last));
+                    begin = end + 1;
+                }
+                this->next_end = i;
+                this->field_begin = begin;
+                if (!last)
+                    continue;
+
+                record.number = ++this->records;
+                if (record.fields.size() > 1 || !record.fields[0].empty())
+                    return true;
+                record.fields.clear();
+            }
+        }
+
+        // the records given so far, the empty lines too
+        std::size_t get_records() const { return this->records; }
+    };
+}
+
+#endif
@@ -0,0 +1,324 @@
+#ifndef _SOA_VECTOR_H_
+#define _SOA_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../../functions/passingArrayToFunction/Span.h"
+
+/*
+
+    - a Soa_vector<T> keeps the records of a struct as a std::vector a field, a column, not
+      a std::vector<T> of records: a scan of one field reads only that field, 16 ints a cache
+      line, not the one int of a record of 64 bytes and the 60 bytes next to it, header only.
+
+    - the fields are declared once, at the global scope, after the struct:
+        SOA_VECTOR_RECORD(City, name, population, cost)
+      it makes soa_vector::Record<City>, the pointers to the members and their names, and
+      a Row with a reference named after every field, v[i].population is the population of
+      row i in its column, a read or a write of it is one of the column. 16 fields at most,
+      public, or the class has friend struct soa_vector::Record<T>, none is a bool, a
+      std::vector<bool> has no references, a std::uint8_t is one, or an array.
+
+    - column<&City::population>() is a Span of the column, for the algorithms of one field,
+      get(i) builds the record of row i, T is default constructible, set(i, record) writes
+      it, push_back appends one, the columns have the same size.
+
+    - permute(order) moves row order[i] to i in every column, sort_by<&City::cost>() and
+      sort(compare) of two rows sort the indices once and permute them, stable, a record is
+      never built to compare it. a reallocation of a column leaves a Row and a Span of it
+      dangling, as an iterator of a std::vector is.
+
+*/
+namespace soa_vector
+{
+    // the fields of T, made by SOA_VECTOR_RECORD
+    template <typename T>
+    struct Record;
+
+    template <typename F, bool Const>
+    using Reference = std::conditional_t<Const, const F&, F&>;
+
+    namespace detail
+    {
+        template <typename M>
+        struct Member;
+
+        template <typename T, typename F>
+        struct Member<F T::*>
+        {
+            static_assert(!std::is_same_v<F, bool>, "a bool field has no reference in a std::vector<bool>, make it a std::uint8_t");
+            using Field = F;
+        };
+
+        template <typename Members>
+        struct Columns;
+
+        template <typename... M>
+        struct Columns<std::tuple<M...>>
+        {
+            using Type = std::tuple<std::vector<typename Member<M>::Field>...>;
+        };
+
+        template <typename T>
+        using Members = std::decay_t<decltype(Record<T>::members)>;
+    }
+
+    template <typename T>
+    class Soa_vector
+    {
+    public:
+        using Row = typename Record<T>::template Row<false>;
+        using Const_row = typename Record<T>::template Row<true>;
+        static constexpr std::size_t num_fields = std::tuple_size_v<detail::Members<T>>;
+
+        template <std::size_t I>
+        using Field = typename detail::Member<std::tuple_element_t<I, detail::Members<T>>>::Field;
+
+        // a Row by value, for a range for, not a random access iterator for std::sort
+        template <typename Vector, typename R>
+        class Basic_iterator
+        {
+        private:
+            Vector* vector;
+            std::size_t index;
+
+        public:
+            Basic_iterator(Vector* vector, std::size_t index) : vector(vector), index(index) {}
+            R operator*() const { return (*this->vector)[this->index]; }
+            Basic_iterator& operator++()
+            {
+                ++this->index;
+                return *this;
+            }
+            bool operator!=(const Basic_iterator& rhs) const { return this->index != rhs.index; }
+            bool operator==(const Basic_iterator& rhs) const { return this->index == rhs.index; }
+        };
+
+        using iterator = Basic_iterator<Soa_vector, Row>;
+        using const_iterator = Basic_iterator<const Soa_vector, Const_row>;
+
+    private:
+        typename detail::Columns<detail::Members<T>>::Type columns;
+
+        template <auto Member, std::size_t I = 0>
+        static constexpr std::size_t index_of()
+        {
+            if constexpr (std::is_same_v<decltype(Member), std::tuple_element_t<I, detail::Members<T>>>)
+                if (std::get<I>(Record<T>::members) == Member)
+                    return I;
+            if constexpr (I + 1 < num_fields)
+                return index_of<Member, I + 1>();
+            else
+                return num_fields;
+        }
+
+        template <typename F>
+        void for_each_column(F f)
+        {
+            std::apply([&f](auto&... column) { (f(column), ...); }, this->columns);
+        }
+
+        template <bool Const, typename Columns, std::size_t... I>
+        static auto make_row(Columns& columns, std::size_t i, std::index_sequence<I...>)
+        {
+            return typename Record<T>::template Row<Const> {std::get<I>(columns)[i]...};
+        }
+
+        template <typename Record_ref, std::size_t... I>
+        void append(Record_ref&& record, std::index_sequence<I...>)
+        {
+            if constexpr (std::is_lvalue_reference_v<Record_ref>)
+                (std::get<I>(this->columns).push_back(record.*std::get<I>(Record<T>::members)), ...);
+            else
+                (std::get<I>(this->columns).push_back(std::move(record.*std::get<I>(Record<T>::members))), ...);
+        }
+
+        template <std::size_t... I>
+        void copy_out(T& record, std::size_t i, std::index_sequence<I...>) const
+        {
+            ((record.*std::get<I>(Record<T>::members) = std::get<I>(this->columns)[i]), ...);
+        }
+
+        template <std::size_t... I>
+        void copy_in(const T& record, std::size_t i, std::index_sequence<I...>)
+        {
+            ((std::get<I>(this->columns)[i] = record.*std::get<I>(Record<T>::members)), ...);
+        }
+
+    public:
+        Soa_vector() = default;
+
+        std::size_t size() const { return std::get<0>(this->columns).size(); }
+        bool empty() const { return this->size() == 0; }
+
+        void reserve(std::size_t n)
+        {
+            this->for_each_column([n](auto& column) { column.reserve(n); });
+        }
+
+        void resize(std::size_t n)
+        {
+            this->for_each_column([n](auto& column) { column.resize(n); });
+        }
+
+        void clear()
+        {
+            this->for_each_column([](auto& column) { column.clear(); });
+        }
+
+        void push_back(const T& record)
+        {
+            this->append(record, std::make_index_sequence<num_fields> {});
+        }
+
+        void push_back(T&& record)
+        {
+            this->append(std::move(record), std::make_index_sequence<num_fields> {});
+        }
+
+        void pop_back()
+        {
+            this->for_each_column([](auto& column) { column.pop_back(); });
+        }
+
+        Row operator[](std::size_t i)
+        {
+            return make_row<false>(this->columns, i, std::make_index_sequence<num_fields> {});
+        }
+
+        Const_row operator[](std::size_t i) const
+        {
+            return make_row<true>(this->columns, i, std::make_index_sequence<num_fields> {});
+        }
+
+        iterator begin() { return iterator {this, 0}; }
+        iterator end() { return iterator {this, this->size()}; }
+        const_iterator begin() const { return const_iterator {this, 0}; }
+        const_iterator end() const { return const_iterator {this, this->size()}; }
+
+        T get(std::size_t i) const
+        {
+            T record {};
+            this->copy_out(record, i, std::make_index_sequence<num_fields> {});
+            return record;
+        }
+
+        void set(std::size_t i, const T& record)
+        {
+            this->copy_in(record, i, std::make_index_sequence<num_fields> {});
+        }
+
+        template <auto Member>
+        auto column()
+        {
+            constexpr std::size_t i = index_of<Member>();
+            static_assert(i < num_fields, "the member is not a field of the record");
+            return Span<Field<i>> {std::get<i>(this->columns)};
+        }
+
+        template <auto Member>
+        auto column() const
+        {
+            constexpr std::size_t i = index_of<Member>();
+            static_assert(i < num_fields, "the member is not a field of the record");
+            return Span<const Field<i>> {std::get<i>(this->columns)};
+        }
+
+        // row i is the row order[i] was, order has every index once
+        void permute(const std::vector<std::size_t>& order)
+        {
+            if (order.size() != this->size())
+                throw std::invalid_argument("the order of a permute is not as long as the Soa_vector");
+            this->for_each_column([&order](auto& column)
+            {
+                std::remove_reference_t<decltype(column)> moved;
+                moved.reserve(column.size());
+                for (std::size_t from : order)
+                    moved.push_back(std::move(column[from]));
+                column.swap(moved);
+            });
+        }
+
+        // compare(a, b) of two Const_rows, true when a is before b
+        template <typename Compare>
+        void sort(Compare compare)
+        {
+            std::vector<std::size_t> order(this->size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [this, &compare](std::size_t a, std::size_t b)
+            {
+                return compare((*static_cast<const Soa_vector*>(this))[a], (*static_cast<const Soa_vector*>(this))[b]);
+            });
+            this->permute(order);
+        }
+
+        // by one column, the others are not read until the permute
+        template <auto Member, typename Compare = std::less<>>
+        void sort_by(Compare compare = Compare {})
+        {
+            const auto keys = static_cast<const Soa_vector*>(this)->template column<Member>();
+            std::vector<std::size_t> order(this->size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&keys, &compare](std::size_t a, std::size_t b)
+            {
+                return compare(keys[a], keys[b]);
+            });
+            this->permute(order);
+        }
+    };
+}
+
+// the field lists, a macro a number of fields, the separator is a macro called between
+// two of them, a comma passed as it is would split the arguments of the next one
+#define SOA_VECTOR_CAT_(a, b) a##b
+#define SOA_VECTOR_CAT(a, b) SOA_VECTOR_CAT_(a, b)
+#define SOA_VECTOR_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+#define SOA_VECTOR_COUNT(...) SOA_VECTOR_COUNT_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define SOA_VECTOR_EACH_1(m, s, T, a) m(T, a)
+#define SOA_VECTOR_EACH_2(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_1(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_3(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_2(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_4(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_3(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_5(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_4(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_6(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_5(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_7(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_6(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_8(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_7(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_9(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_8(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_10(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_9(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_11(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_10(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_12(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_11(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_13(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_12(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_14(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_13(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_15(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_14(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH_16(m, s, T, a, ...) m(T, a) s() SOA_VECTOR_EACH_15(m, s, T, __VA_ARGS__)
+#define SOA_VECTOR_EACH(m, s, T, ...) SOA_VECTOR_CAT(SOA_VECTOR_EACH_, SOA_VECTOR_COUNT(__VA_ARGS__))(m, s, T, __VA_ARGS__)
+
+#define SOA_VECTOR_COMMA() ,
+#define SOA_VECTOR_NOTHING()
+#define SOA_VECTOR_MEMBER(T, field) &T::field
+#define SOA_VECTOR_NAME(T, field) #field
+#define SOA_VECTOR_REFERENCE(T, field) soa_vector::Reference<decltype(T::field), Const> field;
+
+#define SOA_VECTOR_RECORD(T, ...)                                                                              \
+    template <>                                                                                                \
+    struct soa_vector::Record<T>                                                                               \
+    {                                                                                                          \
+        static constexpr auto members = std::make_tuple(SOA_VECTOR_EACH(SOA_VECTOR_MEMBER, SOA_VECTOR_COMMA, T, __VA_ARGS__)); \
+        static constexpr const char* names[] {SOA_VECTOR_EACH(SOA_VECTOR_NAME, SOA_VECTOR_COMMA, T, __VA_ARGS__)}; \
+                                                                                                               \
+        template <bool Const>                                                                                  \
+        struct Row                                                                                             \
+        {                                                                                                      \
+            SOA_VECTOR_EACH(SOA_VECTOR_REFERENCE, SOA_VECTOR_NOTHING, T, __VA_ARGS__)                          \
+        };                                                                                                     \
+    };
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+/*
+
+    - the timing of the hot paths of any module, header only. built with -DBASICS_TRACE
+      (cmake -DBASICS_TRACE=ON) the macros record, built without they are empty, no code
+      and no data, a module keeps its TRACE_ lines in the release builds:
+
+        TRACE_SCOPE("apply_transactions");       // a timer until the end of the scope
+        TRACE_COUNT("transactions", n);           // adds n to a counter
+        TRACE_VALUE("line bytes", line.size());   // one value into a histogram
+
+    - a timer reads the TSC, __rdtsc, on x86-64 and steady_clock elsewhere, when it ends it
+      writes an event into a ring buffer of its thread and its duration into a histogram of
+      its call site, no lock and no allocation, the ring of a thread is only written by it.
+      a ring keeps the last ring_capacity events, the older ones are overwritten and counted.
+
+    - a histogram is HDR like: the values by power of 2, and 16 buckets per power, every
+      percentile is within 1/16 of the value, from 1 to 2^64, with atomic counts.
+
+    - at the exit of the program the events are written as a Chrome trace, for
+      chrome://tracing or ui.perfetto.dev, to the file of the BASICS_TRACE_FILE environment
+      variable, and the counters and the percentiles of the histograms to std::cerr.
+      write_chrome_trace and write_summary do it at any time, when the threads are quiet.
+
+*/
+
+#if defined(BASICS_TRACE)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace trace
+{
+    inline std::uint64_t now_ticks()
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    struct Event
+    {
+        const char *name;
+        std::uint64_t start;
+        std::uint64_t ticks;
+    };
+
+    class Histogram
+    {
+    public:
+        static constexpr int sub_buckets = 16;
+        static constexpr int num_buckets = 64 * sub_buckets;
+
+    private:
+        const char *name;
+        bool of_ticks;
+        std::atomic<std::uint64_t> counts[num_buckets] {};
+        std::atomic<std::uint64_t> total {0};
+        std::atomic<std::uint64_t> max {0};
+
+        // 0 to 15 are themselves, then 16 buckets per power of 2
+        static int bucket_of(std::uint64_t value)
+        {
+            if (value < sub_buckets)
+                return static_cast<int>(value);
+            const int power = 63 - __builtin_clzll(value);
+            const int sub = static_cast<int>((value >> (power - 4)) & (sub_buckets - 1));
+            return (power - 3) * sub_buckets + sub;
+        }
+
+        // the lowest value of a bucket
+        static std::uint64_t value_of(int bucket)
+        {
+            if (bucket < sub_buckets)
+                return static_cast<std::uint64_t>(bucket);
+            const int power = bucket / sub_buckets + 3;
+            const std::uint64_t sub = static_cast<std::uint64_t>(bucket % sub_buckets);
+            return (std::uint64_t {1} << power) | (sub << (power - 4));
+        }
+
+    public:
+        // of_ticks for the durations of timers, written in ns by write_summary
+        Histogram(const char *name, bool of_ticks) : name(name), of_ticks(of_ticks) {}
+
+        void record(std::uint64_t value)
+        {
+            this->counts[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+            this->total.fetch_add(1, std::memory_order_relaxed);
+            std::uint64_t seen = this->max.load(std::memory_order_relaxed);
+            while (value > seen && !this->max.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+                ;
+        }
+
+        const char *get_name() const { return this->name; }
+        bool is_of_ticks() const { return this->of_ticks; }
+        std::uint64_t get_count() const { return this->total.load(std::memory_order_relaxed); }
+        std::uint64_t get_max() const { return this->max.load(std::memory_order_relaxed); }
+
+        // the value below which a fraction p of the values are, 0 <= p <= 1
+        std::uint64_t percentile(double p) const
+        {
+            const std::uint64_t count = this->get_count();
+            if (count == 0)
+                return 0;
+            const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(p * static_cast<double>(count) + 0.5));
+            std::uint64_t seen = 0;
+            for (int bucket = 0; bucket < num_buckets; ++bucket)
+            {
+                seen += this->counts[bucket].load(std::memory_order_relaxed);
+                if (seen >= rank)
+                    return std::min(value_of(bucket), this->get_max());
+            }
+            return this->get_max();
+        }
+    };
+
+    class Counter
+    {
+    private:
+        const char *name;
+        std::atomic<std::uint64_t> value {0};
+
+    public:
+        explicit Counter(const char *name) : name(name) {}
+
+        void add(std::uint64_t n) { this->value.fetch_add(n, std::memory_order_relaxed); }
+        const char *get_name() const { return this->name; }
+        std::uint64_t get() const { return this->value.load(std::memory_order_relaxed); }
+    };
+
+    // the events of one thread, written by it only, the index is published with release
+    class Ring
+    {
+    public:
+        static constexpr std::size_t ring_capacity = std::size_t {1} << 14;
+
+    private:
+        std::unique_ptr<Event[]> events {new Event[ring_capacity]};
+        std::atomic<std::uint64_t> written {0};
+        std::uint32_t thread;
+
+    public:
+        explicit Ring(std::uint32_t thread) : thread(thread) {}
+
+        void push(const Event &event)
+        {
+            const std::uint64_t n = this->written.load(std::memory_order_relaxed);
+            this->events[n & (ring_capacity - 1)] = event;
+            this->written.store(n + 1, std::memory_order_release);
+        }
+
+        std::uint32_t get_thread() const { return this->thread; }
+        std::uint64_t get_written() const { return this->written.load(std::memory_order_acquire); }
+        std::uint64_t get_dropped() const { return this->get_written() > ring_capacity ? this->get_written() - ring_capacity : 0; }
+
+        // the events still in the ring, the oldest first
+        template <typename Fn>
+        void for_each(Fn fn) const
+        {
+            const std::uint64_t n = this->get_written();
+            for (std::uint64_t i = n > ring_capacity ? n - ring_capacity : 0; i < n; ++i)
+                fn(this->events[i & (ring_capacity - 1)]);
+        }
+    };
+
+    class Registry
+    {
+    private:
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Ring>> rings;
+        std::vector<std::unique_ptr<Histogram>> histograms;
+        std::vector<std::unique_ptr<Counter>> counters;
+        std::uint64_t start_ticks {now_ticks()};
+        std::chrono::steady_clock::time_point start_time {std::chrono::steady_clock::now()};
+
+    public:
+        // taken once by a thread, on its first event
+        Ring &add_ring()
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            this->rings.push_back(std::make_unique<Ring>(static_cast<std::uint32_t>(this->rings.size())));
+            return *this->rings.back();
+        }
+
+        // taken once by a call site, stored in a static of it
+        Histogram &add_histogram(const char *name, bool of_ticks)
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            this->histograms.push_back(std::make_unique<Histogram>(name, of_ticks));
+            return *this->histograms.back();
+        }
+
+        Counter &add_counter(const char *name)
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            this->counters.push_back(std::make_unique<Counter>(name));
+            return *this->counters.back();
+        }
+
+        std::uint64_t get_start_ticks() const { return this->start_ticks; }
+
+        // the ticks per microsecond, measured from the start of the program to now
+        double ticks_per_us() const
+        {
+#if defined(__x86_64__) || defined(_M_X64)
+            const std::chrono::duration<double, std::micro> us = std::chrono::steady_clock::now() - this->start_time;
+            return us.count() > 0 ? static_cast<double>(now_ticks() - this->start_ticks) / us.count() : 1.0;
+#else
+            return 1000.0;
+#endif
+        }
+
+        template <typename Fn>
+        void for_each_ring(Fn fn)
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            for (const std::unique_ptr<Ring> &ring : this->rings)
+                fn(*ring);
+        }
+
+        template <typename Fn>
+        void for_each_histogram(Fn fn)
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            for (const std::unique_ptr<Histogram> &histogram : this->histograms)
+                fn(*histogram);
+        }
+
+        template <typename Fn>
+        void for_each_counter(Fn fn)
+        {
+            std::lock_guard<std::mutex> lock {this->mutex};
+            for (const std::unique_ptr<Counter> &counter : this->counters)
+                fn(*counter);
+        }
+    };
+
+    inline Registry &registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    inline Ring &this_thread_ring()
+    {
+        thread_local Ring &ring = registry().add_ring();
+        return ring;
+    }
+
+    class Scoped_timer
+    {
+    private:
+        const char *name;
+        Histogram &histogram;
+        std::uint64_t start;
+
+    public:
+        Scoped_timer(const char *name, Histogram &histogram)
+            : name(name), histogram(histogram), start(now_ticks())
+        {}
+
+        Scoped_timer(const Scoped_timer &) = delete;
+        Scoped_timer &operator=(const Scoped_timer &) = delete;
+
+        ~Scoped_timer()
+        {
+            const std::uint64_t ticks = now_ticks() - this->start;
+            this_thread_ring().push(Event {this->name, this->start, ticks});
+            this->histogram.record(ticks);
+        }
+    };
+
+    namespace detail_trace
+    {
+        inline void write_json_string(std::ostream &os, const char *text)
+        {
+            os << '"';
+            for (const char *p = text; *p; ++p)
+            {
+                if (*p == '"' || *p == '\\')
+                    os << '\\' << *p;
+                else if (static_cast<unsigned char>(*p) < 0x20)
+                    os << ' ';
+                else
+                    os << *p;
+            }
+            os << '"';
+        }
+    }
+
+    // the events of every thread, and the counters at the end, in the Chrome trace format
+    inline void write_chrome_trace(std::ostream &os)
+    {
+        Registry &r = registry();
+        const double per_us = r.ticks_per_us();
+        const std::uint64_t origin = r.get_start_ticks();
+        const auto us = [per_us](std::uint64_t ticks) { return static_cast<double>(ticks) / per_us; };
+
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        const auto separate = [&os, &first] { os << (first ? "\n" : ",\n"); first = false; };
+        os << std::fixed << std::setprecision(3);
+        r.for_each_ring([&](const Ring &ring) {
+            ring.for_each([&](const Event &event) {
+                separate();
+                os << "{\"name\":";
+                detail_trace::write_json_string(os, event.name);
+                os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring.get_thread()
+                    << ",\"ts\":" << us(event.start - origin) << ",\"dur\":" << us(event.ticks) << '}';
+            });
+        });
+        const double end = us(now_ticks() - origin);
+        r.for_each_counter([&](const Counter &counter) {
+            separate();
+            os << "{\"name\":";
+            detail_trace::write_json_string(os, counter.get_name());
+            os << ",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << end << ",\"args\":{\"value\":" << counter.get() << "}}";
+        });
+        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+    inline bool write_chrome_trace(const std::string &path)
+    {
+        std::ofstream out {path};
+        write_chrome_trace(out);
+        return static_cast<bool>(out);
+    }
+
+    // the counters, the percentiles of the histograms in ns and the events lost by the rings
+    inline void write_summary(std::ostream &os)
+    {
+        Registry &r = registry();
+        const double per_ns = r.ticks_per_us() / 1000;
+        r.for_each_counter([&](const Counter &counter) {
+            os << std::setw(32) << std::left << counter.get_name() << std::right << counter.get() << std::endl;
+        });
+        r.for_each_histogram([&](const Histogram &histogram) {
+            const double scale = histogram.is_of_ticks() ? per_ns : 1.0;
+            const auto value = [scale](std::uint64_t v) { return static_cast<std::uint64_t>(static_cast<double>(v) / scale); };
+            os << std::setw(32) << std::left << histogram.get_name() << std::right << histogram.get_count()
+                << (histogram.is_of_ticks() ? " times, ns" : " values");
+            for (double p : {0.5, 0.9, 0.99, 0.999})
+                os << " p" << p * 100 << " " << value(histogram.percentile(p));
+            os << " max " << value(histogram.get_max()) << std::endl;
+        });
+        std::uint64_t dropped = 0;
+        r.for_each_ring([&](const Ring &ring) { dropped += ring.get_dropped(); });
+        if (dropped > 0)
+            os << dropped << " events overwritten in the rings" << std::endl;
+    }
+
+    namespace detail_trace
+    {
+        // writes the trace at exit, made before the registry so it is destroyed after it is used
+        struct Exit_writer
+        {
+            Exit_writer() { registry(); }
+            ~Exit_writer()
+            {
+                if (const char *path = std::getenv("BASICS_TRACE_FILE"))
+                    write_chrome_trace(std::string {path});
+                write_summary(std::cerr);
+            }
+        };
+
+        inline Exit_writer exit_writer;
+    }
+}
+
+#define DETAIL_TRACE_JOIN2(a, b) a##b
+#define DETAIL_TRACE_JOIN(a, b) DETAIL_TRACE_JOIN2(a, b)
+
+#define TRACE_SCOPE(name)                                                                           \
+    static ::trace::Histogram &DETAIL_TRACE_JOIN(trace_histogram_, __LINE__) =                      \
+        ::trace::registry().add_histogram(name, true);                                              \
+    ::trace::Scoped_timer DETAIL_TRACE_JOIN(trace_timer_, __LINE__) {name, DETAIL_TRACE_JOIN(trace_histogram_, __LINE__)}
+
+#define TRACE_COUNT(name, n)                                                                        \
+    do {                                                                                            \
+        static ::trace::Counter &trace_counter = ::trace::registry().add_counter(name);             \
+        trace_counter.add(static_cast<std::uint64_t>(n));                                           \
+    } while (false)
+
+#define TRACE_VALUE(name, value)                                                                    \
+    do {                                                                                            \
+        static ::trace::Histogram &trace_histogram = ::trace::registry().add_histogram(name, false); \
+        trace_histogram.record(static_cast<std::uint64_t>(value));                                  \
+    } while (false)
+
+#else
+
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#define TRACE_COUNT(name, n) static_cast<void>(0)
+#define TRACE_VALUE(name, value) static_cast<void>(0)
+
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+/*
+
+    - build it with the trace on, and run it with a file for the trace:
+        g++ -std=c++17 -O2 -pthread -DBASICS_TRACE index.cpp
+        BASICS_TRACE_FILE=trace.json ./a.out
+      then open trace.json in chrome://tracing or ui.perfetto.dev. without -DBASICS_TRACE
+      the same program has no timer at all.
+
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Trace.h"
+
+std::uint64_t parse_line(const std::string &line)
+{
+    TRACE_SCOPE("parse_line");
+    TRACE_VALUE("line bytes", line.size());
+
+    std::uint64_t sum {0};
+    for (char c : line)
+        sum = sum * 31 + static_cast<unsigned char>(c);
+    return sum;
+}
+
+std::uint64_t parse_batch(int worker, int num_lines)
+{
+    TRACE_SCOPE("parse_batch");
+
+    std::uint64_t sum {0};
+    for (int i = 0; i < num_lines; ++i)
+        sum += parse_line(std::string(static_cast<std::size_t>(16 + (i * 7 + worker) % 240), 'x'));
+    TRACE_COUNT("lines", num_lines);
+    return sum;
+}
+
+int main()
+{
+    std::vector<std::uint64_t> sums(4);
+    std::vector<std::thread> workers;
+    for (int worker = 0; worker < 4; ++worker)
+        workers.emplace_back([&sums, worker] {
+            for (int batch = 0; batch < 10; ++batch)
+                sums[worker] += parse_batch(worker, 1000);
+        });
+    for (std::thread &worker : workers)
+        worker.join();
+
+    std::uint64_t sum {0};
+    for (std::uint64_t s : sums)
+        sum += s;
+    std::cout << "checksum: " << sum << std::endl;
+
+    return 0;
+}
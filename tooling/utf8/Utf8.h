@@ -0,0 +1,418 @@
+#ifndef _UTF8_H_
+#define _UTF8_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+
+    - the code points of UTF-8 text, header only, for the tokenizers and counters that read
+      bytes: a byte over 127 is not a letter for std::isalpha, "Brontë" is 6 letters and
+      2 bytes of nothing, and std::tolower leaves the Ë of "BRONTË" as it is.
+
+    - skip_ascii finds the first byte over 127, 32 (AVX2) or 16 (SSE2) bytes at a time, 8
+      without either, everything else goes by it: text in English is a few non ASCII bytes
+      in whole blocks of ASCII, and only those few are decoded.
+
+    - decode is the code point at a place and its bytes, a byte that does not start a
+      valid sequence is invalid and 1 byte: an overlong form, a surrogate, a code point over
+      U+10FFFF, a sequence cut short. validate is the offset of the first one, npos when the
+      text is valid.
+
+    - kind is the class of a code point for cutting words: letter, digit, space,
+      punctuation or other, by ranges of the scripts of the Latin, Greek, Cyrillic,
+      Armenian, Hebrew, Arabic, Devanagari, Kana, Hangul and CJK blocks, the combining marks
+      are letters, they are inside the words.
+
+    - fold is the simple case folding of CaseFolding.txt for those scripts, one code point
+      to one: Ë to ë, Σ and ς to σ, the Kelvin sign to k, ẞ to ß, not ß to ss. a folded
+      code point is never more bytes than it was, Ⱥ to ⱥ is left out, so fold_in_place
+      folds in the buffer of the text. the ASCII runs are folded without decoding.
+
+*/
+namespace utf8
+{
+    constexpr char32_t invalid = 0xFFFFFFFF;
+    constexpr std::size_t npos = std::string_view::npos;
+
+    enum class Kind : std::uint8_t { letter, digit, space, punctuation, other };
+
+    namespace detail_utf8
+    {
+        struct Range
+        {
+            char32_t first;
+            char32_t last;
+            Kind kind;
+        };
+
+        // sorted, the code points between the ranges are other
+        constexpr Range ranges[] {
+            {0x0085, 0x0085, Kind::space}, {0x00A0, 0x00A0, Kind::space}, {0x00A1, 0x00A1, Kind::punctuation},
+            {0x00A7, 0x00A7, Kind::punctuation}, {0x00AA, 0x00AA, Kind::letter}, {0x00AB, 0x00AB, Kind::punctuation},
+            {0x00B5, 0x00B5, Kind::letter}, {0x00B6, 0x00B7, Kind::punctuation}, {0x00BA, 0x00BA, Kind::letter},
+            {0x00BB, 0x00BB, Kind::punctuation}, {0x00BF, 0x00BF, Kind::punctuation}, {0x00C0, 0x00D6, Kind::letter},
+            {0x00D8, 0x00F6, Kind::letter}, {0x00F8, 0x02C1, Kind::letter}, {0x02C6, 0x02D1, Kind::letter},
+            {0x0300, 0x036F, Kind::letter}, {0x0370, 0x0374, Kind::letter}, {0x0376, 0x037D, Kind::letter},
+            {0x037E, 0x037E, Kind::punctuation}, {0x037F, 0x037F, Kind::letter}, {0x0386, 0x0386, Kind::letter},
+            {0x0387, 0x0387, Kind::punctuation}, {0x0388, 0x03FF, Kind::letter}, {0x0400, 0x0482, Kind::letter},
+            {0x0483, 0x052F, Kind::letter}, {0x0531, 0x0556, Kind::letter}, {0x0559, 0x0559, Kind::letter},
+            {0x055A, 0x055F, Kind::punctuation}, {0x0560, 0x0588, Kind::letter}, {0x0589, 0x058A, Kind::punctuation},
+            {0x0591, 0x05BD, Kind::letter}, {0x05BE, 0x05BE, Kind::punctuation}, {0x05BF, 0x05C7, Kind::letter},
+            {0x05D0, 0x05EA, Kind::letter}, {0x05F3, 0x05F4, Kind::punctuation}, {0x060C, 0x060D, Kind::punctuation},
+            {0x0610, 0x061A, Kind::letter}, {0x061B, 0x061B, Kind::punctuation}, {0x061D, 0x061F, Kind::punctuation},
+            {0x0620, 0x065F, Kind::letter}, {0x0660, 0x0669, Kind::digit}, {0x066A, 0x066D, Kind::punctuation},
+            {0x066E, 0x06D3, Kind::letter}, {0x06D4, 0x06D4, Kind::punctuation}, {0x06D5, 0x06EF, Kind::letter},
+            {0x06F0, 0x06F9, Kind::digit}, {0x06FA, 0x06FF, Kind::letter}, {0x0900, 0x0963, Kind::letter},
+            {0x0964, 0x0965, Kind::punctuation}, {0x0966, 0x096F, Kind::digit}, {0x0970, 0x0970, Kind::punctuation},
+            {0x0971, 0x097F, Kind::letter}, {0x1680, 0x1680, Kind::space}, {0x1AB0, 0x1AFF, Kind::letter},
+            {0x1DC0, 0x1FFF, Kind::letter}, {0x2000, 0x200A, Kind::space}, {0x2010, 0x2027, Kind::punctuation},
+            {0x2028, 0x2029, Kind::space}, {0x202F, 0x202F, Kind::space}, {0x2030, 0x2043, Kind::punctuation},
+            {0x2045, 0x2051, Kind::punctuation}, {0x2053, 0x205E, Kind::punctuation}, {0x205F, 0x205F, Kind::space},
+            {0x20D0, 0x20FF, Kind::letter}, {0x2126, 0x2126, Kind::letter}, {0x212A, 0x212B, Kind::letter},
+            {0x2160, 0x2188, Kind::letter}, {0x24B6, 0x24E9, Kind::letter}, {0x2C00, 0x2CE4, Kind::letter},
+            {0x2E00, 0x2E4F, Kind::punctuation}, {0x3000, 0x3000, Kind::space}, {0x3001, 0x3003, Kind::punctuation},
+            {0x3005, 0x3007, Kind::letter}, {0x3008, 0x3011, Kind::punctuation}, {0x3014, 0x301F, Kind::punctuation},
+            {0x3030, 0x3030, Kind::punctuation}, {0x3041, 0x3096, Kind::letter}, {0x3099, 0x309F, Kind::letter},
+            {0x30A0, 0x30A0, Kind::punctuation}, {0x30A1, 0x30FA, Kind::letter}, {0x30FB, 0x30FB, Kind::punctuation},
+            {0x30FC, 0x30FF, Kind::letter}, {0x3400, 0x4DBF, Kind::letter}, {0x4E00, 0x9FFF, Kind::letter},
+            {0xAC00, 0xD7A3, Kind::letter}, {0xFE10, 0xFE19, Kind::punctuation}, {0xFE30, 0xFE4F, Kind::punctuation},
+            {0xFE50, 0xFE6B, Kind::punctuation}, {0xFF01, 0xFF0F, Kind::punctuation}, {0xFF10, 0xFF19, Kind::digit},
+            {0xFF1A, 0xFF20, Kind::punctuation}, {0xFF21, 0xFF3A, Kind::letter}, {0xFF3B, 0xFF3D, Kind::punctuation},
+            {0xFF3F, 0xFF3F, Kind::punctuation}, {0xFF41, 0xFF5A, Kind::letter}, {0xFF5B, 0xFF5B, Kind::punctuation},
+            {0xFF5D, 0xFF5D, Kind::punctuation}, {0xFF5F, 0xFF65, Kind::punctuation}, {0xFF66, 0xFFDC, Kind::letter},
+        };
+
+        inline bool is_continuation(unsigned char byte)
+        {
+            return (byte & 0xC0) == 0x80;
+        }
+
+        // only A to Z change, 16 bytes at a time, the 0x20 bit of the ones between '@' and '['
+        inline void lower_ascii(char *text, std::size_t size)
+        {
+            std::size_t i = 0;
+#if defined(__SSE2__)
+            const __m128i below = _mm_set1_epi8('A' - 1);
+            const __m128i above = _mm_set1_epi8('Z' + 1);
+            const __m128i flip = _mm_set1_epi8(0x20);
+            for (; i + 16 <= size; i += 16)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, below), _mm_cmplt_epi8(chars, above));
+                chars = _mm_or_si128(chars, _mm_and_si128(upper, flip));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(text + i), chars);
+            }
+#endif
+            for (; i < size; ++i)
+            {
+                const unsigned char c = static_cast<unsigned char>(text[i]);
+                text[i] = static_cast<char>(c >= 'A' && c <= 'Z' ? c + 0x20 : c);
+            }
+        }
+
+        // the code points of a block whose upper case is the even one, or the odd one, and the lower case next
+        inline bool is_pair(char32_t cp, char32_t first, char32_t last)
+        {
+            return cp >= first && cp <= last && ((cp - first) & 1) == 0;
+        }
+    }
+
+    // the first byte over 127 from from, size when there is none
+    inline std::size_t skip_ascii(const char *data, std::size_t size, std::size_t from = 0)
+    {
+        std::size_t i = from;
+#if defined(__AVX2__)
+        for (; i + 32 <= size; i += 32)
+        {
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))));
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctz(mask));
+        }
+#elif defined(__SSE2__)
+        for (; i + 16 <= size; i += 16)
+        {
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i))));
+            if (mask != 0)
+                return i + static_cast<std::size_t>(__builtin_ctz(mask));
+        }
+#endif
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            if ((word & 0x8080808080808080u) != 0)
+                break;
+        }
+        while (i < size && static_cast<unsigned char>(data[i]) < 0x80)
+            ++i;
+        return i;
+    }
+
+    inline bool is_ascii(std::string_view text)
+    {
+        return skip_ascii(text.data(), text.size()) == text.size();
+    }
+
+    // the code point at data, length is its bytes, invalid and 1 for a byte that starts no valid sequence
+    inline char32_t decode(const char *data, std::size_t size, std::size_t &length)
+    {
+        using detail_utf8::is_continuation;
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+        length = 1;
+        const unsigned char first = bytes[0];
+        if (first < 0x80)
+            return first;
+
+        if (first >= 0xC2 && first < 0xE0)
+        {
+            if (size < 2 || !is_continuation(bytes[1]))
+                return invalid;
+            length = 2;
+            return static_cast<char32_t>(first & 0x1F) << 6 | (bytes[1] & 0x3F);
+        }
+        if (first >= 0xE0 && first < 0xF0)
+        {
+            // E0 would be overlong below A0, ED is a surrogate from A0
+            const unsigned char low = first == 0xE0 ? 0xA0 : 0x80;
+            const unsigned char high = first == 0xED ? 0x9F : 0xBF;
+            if (size < 3 || bytes[1] < low || bytes[1] > high || !is_continuation(bytes[2]))
+                return invalid;
+            length = 3;
+            return static_cast<char32_t>(first & 0x0F) << 12 | static_cast<char32_t>(bytes[1] & 0x3F) << 6 | (bytes[2] & 0x3F);
+        }
+        if (first >= 0xF0 && first < 0xF5)
+        {
+            // F0 would be overlong below 90, F4 over U+10FFFF from 90
+            const unsigned char low = first == 0xF0 ? 0x90 : 0x80;
+            const unsigned char high = first == 0xF4 ? 0x8F : 0xBF;
+            if (size < 4 || bytes[1] < low || bytes[1] > high || !is_continuation(bytes[2]) || !is_continuation(bytes[3]))
+                return invalid;
+            length = 4;
+            return static_cast<char32_t>(first & 0x07) << 18 | static_cast<char32_t>(bytes[1] & 0x3F) << 12
+                | static_cast<char32_t>(bytes[2] & 0x3F) << 6 | (bytes[3] & 0x3F);
+        }
+        return invalid;
+    }
+
+    // the offset of the first byte of an invalid sequence, npos for valid text
+    inline std::size_t validate(std::string_view text)
+    {
+        const char *data = text.data();
+        const std::size_t size = text.size();
+        std::size_t i = 0;
+        while ((i = skip_ascii(data, size, i)) < size)
+        {
+            std::size_t length;
+            if (decode(data + i, size - i, length) == invalid)
+                return i;
+            i += length;
+        }
+        return npos;
+    }
+
+    // the bytes of cp, 1 to 4, written to out
+    inline std::size_t encode(char32_t cp, char *out)
+    {
+        if (cp < 0x80)
+        {
+            out[0] = static_cast<char>(cp);
+            return 1;
+        }
+        if (cp < 0x800)
+        {
+            out[0] = static_cast<char>(0xC0 | cp >> 6);
+            out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 2;
+        }
+        if (cp < 0x10000)
+        {
+            out[0] = static_cast<char>(0xE0 | cp >> 12);
+            out[1] = static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+            out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<char>(0xF0 | cp >> 18);
+        out[1] = static_cast<char>(0x80 | (cp >> 12 & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+        out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 4;
+    }
+
+    // where the code point that ends at end starts, not before begin, end - 1 for an invalid byte
+    inline std::size_t previous(const char *data, std::size_t begin, std::size_t end)
+    {
+        std::size_t start = end - 1;
+        while (start > begin && end - start < 4 && detail_utf8::is_continuation(static_cast<unsigned char>(data[start])))
+            --start;
+        std::size_t length;
+        if (decode(data + start, end - start, length) == invalid || start + length != end)
+            return end - 1;
+        return start;
+    }
+
+    inline Kind kind(char32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            if ((cp | 0x20) >= 'a' && (cp | 0x20) <= 'z')
+                return Kind::letter;
+            if (cp >= '0' && cp <= '9')
+                return Kind::digit;
+            if (cp == ' ' || (cp >= '\t' && cp <= '\r'))
+                return Kind::space;
+            if ((cp >= '!' && cp <= '/') || (cp >= ':' && cp <= '@') || (cp >= '[' && cp <= '`') || (cp >= '{' && cp <= '~'))
+                return Kind::punctuation;
+            return Kind::other;
+        }
+
+        const detail_utf8::Range *end = std::end(detail_utf8::ranges);
+        const detail_utf8::Range *range = std::upper_bound(std::begin(detail_utf8::ranges), end, cp,
+            [](char32_t value, const detail_utf8::Range &range) { return value < range.first; });
+        if (range == std::begin(detail_utf8::ranges) || cp > (range - 1)->last)
+            return Kind::other;
+        return (range - 1)->kind;
+    }
+
+    inline char32_t fold(char32_t cp)
+    {
+        using detail_utf8::is_pair;
+        if (cp < 0x80)
+            return cp >= 'A' && cp <= 'Z' ? cp + 0x20 : cp;
+        if (cp < 0x100)
+        {
+            if (cp == 0xB5)
+                return 0x3BC;
+            return cp >= 0xC0 && cp <= 0xDE && cp != 0xD7 ? cp + 0x20 : cp;
+        }
+        if (cp < 0x250)
+        {
+            if (is_pair(cp, 0x100, 0x12F) || is_pair(cp, 0x132, 0x137) || is_pair(cp, 0x14A, 0x177)
+                || is_pair(cp, 0x1DE, 0x1EF) || is_pair(cp, 0x1F8, 0x21F) || is_pair(cp, 0x222, 0x233))
+                return cp + 1;
+            if (is_pair(cp, 0x139, 0x148) || is_pair(cp, 0x179, 0x17E) || is_pair(cp, 0x1CD, 0x1DC))
+                return cp + 1;
+            switch (cp)
+            {
+            case 0x178: return 0xFF;
+            case 0x17F: return 's';
+            case 0x1C4: case 0x1C5: return 0x1C6;
+            case 0x1C7: case 0x1C8: return 0x1C9;
+            case 0x1CA: case 0x1CB: return 0x1CC;
+            case 0x1F1: case 0x1F2: return 0x1F3;
+            default: return cp;
+            }
+        }
+        if (cp >= 0x370 && cp < 0x400)
+        {
+            if ((cp >= 0x391 && cp <= 0x3A1) || (cp >= 0x3A3 && cp <= 0x3AB))
+                return cp + 0x20;
+            if (cp >= 0x388 && cp <= 0x38A)
+                return cp + 0x25;
+            if (is_pair(cp, 0x3D8, 0x3EF))
+                return cp + 1;
+            switch (cp)
+            {
+            case 0x386: return 0x3AC;
+            case 0x38C: return 0x3CC;
+            case 0x38E: return 0x3CD;
+            case 0x38F: return 0x3CE;
+            case 0x3C2: return 0x3C3;
+            default: return cp;
+            }
+        }
+        if (cp >= 0x400 && cp < 0x530)
+        {
+            if (cp < 0x410)
+                return cp + 0x50;
+            if (cp < 0x430)
+                return cp + 0x20;
+            if (is_pair(cp, 0x460, 0x481) || is_pair(cp, 0x48A, 0x4BF) || is_pair(cp, 0x4D0, 0x52F))
+                return cp + 1;
+            if (is_pair(cp, 0x4C1, 0x4CE))
+                return cp + 1;
+            return cp == 0x4C0 ? 0x4CF : cp;
+        }
+        if (cp >= 0x531 && cp <= 0x556)
+            return cp + 0x30;
+        if (cp >= 0x1E00 && cp < 0x2000)
+        {
+            if (is_pair(cp, 0x1E00, 0x1E95) || is_pair(cp, 0x1EA0, 0x1EFF))
+                return cp + 1;
+            if (cp == 0x1E9E)
+                return 0xDF;
+            // the Greek capitals with breathings are 8 after their small letters
+            const char32_t row = cp & 0xF;
+            if (cp >= 0x1F08 && cp <= 0x1F6F && row >= 8)
+            {
+                const char32_t block = cp & 0xFFF0;
+                if (block == 0x1F10 || block == 0x1F40)
+                    return row <= 0xD ? cp - 8 : cp;
+                if (block == 0x1F50)
+                    return (row & 1) == 1 ? cp - 8 : cp;
+                return cp - 8;
+            }
+            return cp;
+        }
+        switch (cp)
+        {
+        case 0x2126: return 0x3C9;
+        case 0x212A: return 'k';
+        case 0x212B: return 0xE5;
+        default: break;
+        }
+        if (cp >= 0x2160 && cp <= 0x216F)
+            return cp + 0x10;
+        if (cp >= 0x24B6 && cp <= 0x24CF)
+            return cp + 0x1A;
+        if (cp >= 0xFF21 && cp <= 0xFF3A)
+            return cp + 0x20;
+        return cp;
+    }
+
+    // folds the text where it is, an invalid byte stays, returns the new size, never more than size
+    inline std::size_t fold_in_place(char *text, std::size_t size)
+    {
+        std::size_t in = 0, out = 0;
+        while (in < size)
+        {
+            const std::size_t ascii = skip_ascii(text, size, in);
+            if (out != in)
+                std::memmove(text + out, text + in, ascii - in);
+            detail_utf8::lower_ascii(text + out, ascii - in);
+            out += ascii - in;
+            in = ascii;
+            if (in == size)
+                break;
+
+            std::size_t length;
+            const char32_t cp = decode(text + in, size - in, length);
+            if (cp == invalid)
+                text[out++] = text[in];
+            else
+                out += encode(fold(cp), text + out);
+            in += length;
+        }
+        return out;
+    }
+
+    inline std::string fold_case(std::string_view text)
+    {
+        std::string folded {text};
+        folded.resize(fold_in_place(folded.data(), folded.size()));
+        return folded;
+    }
+}
+
+#endif
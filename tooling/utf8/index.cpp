@@ -0,0 +1,211 @@
+/*
+
+    - the checks of Utf8.h and its speed, on ioAndStream/readingFromTextFile3/test.txt, the
+      poem of Emily Brontë, and on standardTemplateLibrary/challengeThree/romeoAndJuliet.txt
+      repeated 100 times, as it is, ASCII only, and with a word in 8 in Greek, Cyrillic or
+      with accents, the mixed text:
+        g++ -std=c++17 -O2 index.cpp
+        g++ -std=c++17 -O2 -march=x86-64-v3 index.cpp
+        ./a.out [copies]
+
+    - every code point is encoded and decoded again, the bad sequences have to be found at
+      their byte, fold has to give the same code point twice and never more bytes, the
+      ranges of kind have to be in order, a failure is reported and the exit code is 1.
+
+    - on one core of an x86-64 at -O2, 100 copies, MB/s:
+                              ASCII   mixed   (x86-64-v3: ASCII   mixed)
+        validate, a byte step    247     259                 267     258
+        validate                8780    1305                9826    1607
+        std::tolower a byte      191     184                 176     174
+        fold_case               1795     433                2539     439
+      a step of a byte is a decode and a branch on every byte, the blocks of ASCII are a
+      load and a movemask, the mixed text is 12.8 % non ASCII bytes, a decode every 20
+      bytes or so. std::tolower is the byte loop of the counters before, through the
+      locale, and it leaves ÉΣЖ as they are.
+
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cctype>
+#include "Utf8.h"
+
+template<typename F>
+double mb_per_second(std::size_t bytes, F f, int runs = 5)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run)
+        f();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(bytes) * runs / 1e6 / seconds;
+}
+
+// a byte at a time, the loop validate would be without skip_ascii
+std::size_t validate_bytes(std::string_view text)
+{
+    for (std::size_t i = 0; i < text.size(); )
+    {
+        std::size_t length;
+        if (utf8::decode(text.data() + i, text.size() - i, length) == utf8::invalid)
+            return i;
+        i += length;
+    }
+    return utf8::npos;
+}
+
+std::string read_file(const char *path)
+{
+    std::ifstream in {path, std::ios::binary};
+    return std::string {std::istreambuf_iterator<char> {in}, std::istreambuf_iterator<char> {}};
+}
+
+int check()
+{
+    int failures = 0;
+    const auto fail = [&failures](const std::string &what)
+    {
+        if (failures++ < 10)
+            std::cout << "failed: " << what << std::endl;
+    };
+
+    char bytes[4];
+    for (char32_t cp = 0; cp <= 0x10FFFF; ++cp)
+    {
+        if (cp >= 0xD800 && cp <= 0xDFFF)
+            continue;
+        const std::size_t size = utf8::encode(cp, bytes);
+        std::size_t length;
+        if (utf8::decode(bytes, size, length) != cp || length != size)
+            fail("the code point " + std::to_string(cp) + " encoded and decoded");
+
+        const char32_t folded = utf8::fold(cp);
+        char folded_bytes[4];
+        if (utf8::fold(folded) != folded || utf8::encode(folded, folded_bytes) > size)
+            fail("the fold of " + std::to_string(cp));
+    }
+
+    // the bad sequences, the offset validate has to give
+    const std::vector<std::pair<std::string, std::size_t>> bad {
+        {"abc\x80", 3}, {"\xC0\xAF", 0}, {"ok \xC1\xBF", 3}, {"\xE0\x80\xAF", 0}, {"\xED\xA0\x80", 0},
+        {"\xF4\x90\x80\x80", 0}, {"\xF5\x80\x80\x80", 0}, {"Bront\xC3", 5}, {"\xE2\x82", 0}, {"caf\xC3\xA9\xFF", 5},
+    };
+    for (const auto &entry : bad)
+        if (utf8::validate(entry.first) != entry.second || validate_bytes(entry.first) != entry.second)
+            fail("validate of a bad sequence at " + std::to_string(entry.second));
+    if (utf8::validate("Bront\xC3\xAB \xE2\x80\x9C\xCE\xA3\xE2\x80\x9D \xF0\x9F\x98\x80") != utf8::npos)
+        fail("validate of valid text");
+
+    for (std::size_t i = 1; i < std::size(utf8::detail_utf8::ranges); ++i)
+        if (utf8::detail_utf8::ranges[i].first <= utf8::detail_utf8::ranges[i - 1].last)
+            fail("the ranges in order at " + std::to_string(i));
+
+    const std::vector<std::pair<std::string, std::string>> folds {
+        {"BRONTË", "brontë"}, {"ΟΔΥΣΣΕΥΣ", "οδυσσευσ"}, {"Οδυσσεύς", "οδυσσεύσ"}, {"МОСКВА", "москва"},
+        {"Straße", "straße"}, {"ẞ", "ß"}, {"\xE2\x84\xAA", "k"}, {"ŁÓDŹ", "łódź"}, {"ĞÜŞİ", "ğüşİ"},
+    };
+    for (const auto &entry : folds)
+        if (utf8::fold_case(entry.first) != entry.second)
+            fail("the fold of " + entry.first + " is " + utf8::fold_case(entry.first));
+
+    std::size_t length;
+    if (utf8::kind(utf8::decode("\xC3\xAB", 2, length)) != utf8::Kind::letter
+        || utf8::kind(utf8::decode("\xE2\x80\x9C", 3, length)) != utf8::Kind::punctuation
+        || utf8::kind(utf8::decode("\xC2\xA0", 2, length)) != utf8::Kind::space
+        || utf8::kind(utf8::decode("\xD9\xA3", 2, length)) != utf8::Kind::digit || utf8::kind('\'') != utf8::Kind::punctuation)
+        fail("the kinds of ë, “, no-break space, ٣ and '");
+    return failures;
+}
+
+// a word in 8 in other scripts or with accents, the same number of words
+std::string mix(const std::string &text)
+{
+    const char *others[] {"Roméo", "ΣΕΛΗΝΗ", "Жизнь", "naïve", "CAFÉ", "Øresund", "Ærø", "Ἀθῆναι"};
+    std::string mixed;
+    mixed.reserve(text.size() * 11 / 10);
+    std::size_t word = 0;
+    for (std::size_t i = 0; i < text.size(); )
+    {
+        if (std::isspace(static_cast<unsigned char>(text[i])))
+        {
+            mixed += text[i++];
+            continue;
+        }
+        std::size_t end = i;
+        while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])))
+            ++end;
+        if (word++ % 8 == 7)
+            mixed += others[word / 8 % 8];
+        else
+            mixed.append(text, i, end - i);
+        i = end;
+    }
+    return mixed;
+}
+
+int main(int argc, char *argv[])
+{
+    const long copies_arg = argc > 1 ? std::atol(argv[1]) : 100;
+    const std::size_t copies = copies_arg > 0 ? static_cast<std::size_t>(copies_arg) : 1;
+
+    int failures = check();
+
+    const std::string poem = read_file("../../ioAndStream/readingFromTextFile3/test.txt");
+    const std::string play = read_file("../../standardTemplateLibrary/challengeThree/romeoAndJuliet.txt");
+    if (poem.empty() || play.empty())
+    {
+        std::cout << "run it in its directory, the texts are not found" << std::endl;
+        return 1;
+    }
+    std::istringstream lines {poem};
+    std::string line;
+    std::getline(lines, line);
+    std::getline(lines, line);
+    std::cout << line << " -> " << utf8::fold_case(line) << ", valid: " << (utf8::validate(poem) == utf8::npos) << std::endl;
+
+    std::string ascii;
+    for (std::size_t copy = 0; copy < copies; ++copy)
+        ascii += play;
+    const std::string mixed = mix(ascii);
+    std::size_t non_ascii = 0;
+    for (char c : mixed)
+        non_ascii += static_cast<unsigned char>(c) >= 0x80;
+    std::cout << ascii.size() / 1000000 << " MB, the mixed one " << std::fixed << std::setprecision(1)
+              << 100.0 * static_cast<double>(non_ascii) / static_cast<double>(mixed.size()) << " % non ASCII, MB/s:" << std::endl;
+
+    std::cout << std::setw(24) << "" << std::setw(8) << "ASCII" << std::setw(8) << "mixed" << std::endl;
+    std::size_t sink = 0;
+    std::string buffer;
+    const auto row = [&](const char *name, auto f)
+    {
+        const double on_ascii = mb_per_second(ascii.size(), [&] { sink += f(ascii); });
+        const double on_mixed = mb_per_second(mixed.size(), [&] { sink += f(mixed); });
+        std::cout << std::setw(24) << std::left << name << std::right << std::setprecision(0) << std::setw(8) << on_ascii
+                  << std::setw(8) << on_mixed << std::endl;
+    };
+    row("validate, a byte step", [](const std::string &text) { return validate_bytes(text); });
+    row("validate", [](const std::string &text) { return utf8::validate(text); });
+    row("std::tolower a byte", [&buffer](const std::string &text)
+    {
+        buffer = text;
+        for (char &c : buffer)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return buffer.size();
+    });
+    row("fold_case", [&buffer](const std::string &text)
+    {
+        buffer = text;
+        return utf8::fold_in_place(buffer.data(), buffer.size());
+    });
+    if (utf8::validate(mixed) != utf8::npos || utf8::validate(ascii) != utf8::npos || sink == 0)
+        ++failures;
+
+    std::cout << "failures: " << failures << std::endl;
+    return failures == 0 ? 0 : 1;
+}
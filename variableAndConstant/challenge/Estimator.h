@@ -0,0 +1,182 @@
+#ifndef _ESTIMATOR_H_
+#define _ESTIMATOR_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include "../../polymorphism/challenge/Money.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+
+  - a Rate_card is the price of every kind of room, the sales tax and how many days an
+    estimate is valid, a literal type, the card of a program is constexpr and so are the
+    quotes of it that are known when it is compiled:
+
+      constexpr Rate_card<2> rates {{{{"small", Money {25}}, {"large", Money {35}}}}, 0.06, 30};
+      static_assert(rates.quote({1, 1}).total == Money {63.6});
+
+  - amounts are Money, cents in 64 bits, the ones of the Account modules. the cost is the
+    sum of price * count, exact, the tax is cost * sales_tax rounded half away from zero to
+    the cent, Money::operator*, and the total is cost + tax. too big a quote throws
+    std::overflow_error, a negative count std::invalid_argument.
+
+  - quote(counts, out, n) quotes n estimates at once, counts[k] is the column of the counts
+    of room k, one int per estimate, out gets the columns of the cost, the tax and the
+    total in cents. with AVX2 4 estimates are quoted together: the counts widened to 64
+    bits and multiplied by the prices, the tax with the trick of 1.5 2^52 of
+    Currency_converter.h, for costs under 2^51 cents, a block of 4 with a bigger one or a
+    negative count is quoted one at a time, the same cents either way.
+
+  - a price is at most 2^31 - 1 cents and not negative, and the tax is from 0 to 1,
+    is_valid says so, a card that is not valid throws std::invalid_argument when it quotes.
+
+*/
+struct Room_rate
+{
+  std::string_view name;
+  Money price;
+};
+
+struct Quote
+{
+  Money cost;
+  Money tax;
+  Money total;
+};
+
+struct Quote_columns
+{
+  std::int64_t *cost;
+  std::int64_t *tax;
+  std::int64_t *total;
+};
+
+namespace detail_estimator
+{
+  // 1.5 2^52, an integer under 2^51 added to it is in the low bits of the sum
+  constexpr double magic = 6755399441055744.0;
+  constexpr std::int64_t max_exact = std::int64_t{1} << 51;
+  constexpr std::int64_t max_price = (std::int64_t{1} << 31) - 1;
+
+  inline std::int64_t bits_of(double x)
+  {
+    std::int64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+  }
+}
+
+template <std::size_t N>
+struct Rate_card
+{
+  std::array<Room_rate, N> rooms;
+  double sales_tax;
+  int expiry_days;
+
+  constexpr bool is_valid() const
+  {
+    for (const Room_rate &room : this->rooms)
+      if (room.price.get_cents() < 0 || room.price.get_cents() > detail_estimator::max_price)
+        return false;
+    return this->sales_tax >= 0 && this->sales_tax <= 1 && this->expiry_days >= 0;
+  }
+
+  constexpr Quote quote(const std::array<int, N> &counts) const
+  {
+    if (!this->is_valid())
+      throw std::invalid_argument("The rate card is not valid.");
+    return this->quote_valid(counts);
+  }
+
+  void quote(const std::array<const int *, N> &counts, Quote_columns out, std::size_t n) const;
+
+private:
+  constexpr Quote quote_valid(const std::array<int, N> &counts) const
+  {
+    Money cost;
+    for (std::size_t k = 0; k < N; ++k)
+    {
+      if (counts[k] < 0)
+        throw std::invalid_argument("A room count can not be negative.");
+      // both under 2^31, the product fits, the sum throws when it does not
+      cost += Money::from_cents(this->rooms[k].price.get_cents() * counts[k]);
+    }
+    const Money tax = cost * this->sales_tax;
+    return Quote {cost, tax, cost + tax};
+  }
+
+  void quote_one_at_a_time(const std::array<const int *, N> &counts, Quote_columns out,
+                           std::size_t first, std::size_t last) const
+  {
+    std::array<int, N> one;
+    for (std::size_t i = first; i < last; ++i)
+    {
+      for (std::size_t k = 0; k < N; ++k)
+        one[k] = counts[k][i];
+      const Quote quote = this->quote_valid(one);
+      out.cost[i] = quote.cost.get_cents();
+      out.tax[i] = quote.tax.get_cents();
+      out.total[i] = quote.total.get_cents();
+    }
+  }
+};
+
+template <std::size_t N>
+void Rate_card<N>::quote(const std::array<const int *, N> &counts, Quote_columns out, std::size_t n) const
+{
+  if (!this->is_valid())
+    throw std::invalid_argument("The rate card is not valid.");
+
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  using namespace detail_estimator;
+  __m256i prices[N];
+  for (std::size_t k = 0; k < N; ++k)
+    prices[k] = _mm256_set1_epi64x(this->rooms[k].price.get_cents());
+  const __m256i magic_bits = _mm256_set1_epi64x(bits_of(magic));
+  const __m256d magic_double = _mm256_set1_pd(magic);
+  const __m256i limit = _mm256_set1_epi64x(max_exact - 1);
+  const __m256d tax_rate = _mm256_set1_pd(this->sales_tax);
+  const __m256d half = _mm256_set1_pd(0.5);
+  for (; i + 4 <= n; i += 4)
+  {
+    __m256i cost = _mm256_setzero_si256();
+    __m128i negative = _mm_setzero_si128();
+    __m256i too_big = _mm256_setzero_si256();
+    for (std::size_t k = 0; k < N; ++k)
+    {
+      const __m128i count = _mm_loadu_si128(reinterpret_cast<const __m128i *>(counts[k] + i));
+      negative = _mm_or_si128(negative, count);
+      // a count and a price under 2^31, the product is under 2^62 and the sum of it and a
+      // cost under 2^51 does not wrap
+      cost = _mm256_add_epi64(cost, _mm256_mul_epi32(_mm256_cvtepi32_epi64(count), prices[k]));
+      too_big = _mm256_or_si256(too_big, _mm256_cmpgt_epi64(cost, limit));
+      cost = _mm256_and_si256(cost, _mm256_cmpgt_epi64(limit, cost));
+    }
+    if (_mm_movemask_ps(_mm_castsi128_ps(negative)) != 0 || !_mm256_testz_si256(too_big, too_big))
+    {
+      this->quote_one_at_a_time(counts, out, i, i + 4);
+      continue;
+    }
+    // Money::operator*: the cents as a double times the tax, + 0.5 and toward zero, the
+    // cost is not negative, the tax is at most the cost
+    const __m256d x = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(cost, magic_bits)), magic_double);
+    const __m256d rounded = _mm256_round_pd(_mm256_add_pd(_mm256_mul_pd(x, tax_rate), half),
+                                            _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    const __m256i tax = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(rounded, magic_double)), magic_bits);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.cost + i), cost);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.tax + i), tax);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.total + i), _mm256_add_epi64(cost, tax));
+  }
+#endif
+  this->quote_one_at_a_time(counts, out, i, n);
+}
+
+#endif
@@ -1,4 +1,12 @@
 #include <iostream>
+#include <stdexcept>
+#include "Estimator.h"
+
+// the rate card of jack's, the prices, the tax and the days an estimate is valid
+constexpr Rate_card<2> jacks_rates {{{{"small", Money {25}}, {"large", Money {35}}}}, 0.06, 30};
+
+static_assert(jacks_rates.is_valid(), "the rate card of jack's");
+static_assert(jacks_rates.quote({1, 1}).total == Money {63.6}, "a small and a large room with tax");
 
 int main()
 {
@@ -12,31 +20,25 @@ int main()
   int numbers_of_large_rooms {0};
   std::cin >> numbers_of_large_rooms;
 
-  const double price_per_small_room {25};
-  const double price_per_large_room {35};
-  const double sales_tax {0.06};
-  const int estimate_expiry {30}; // days
+  Quote quote;
+  try {
+    quote = jacks_rates.quote({numbers_of_small_rooms, numbers_of_large_rooms});
+  }
+  catch (const std::exception &ex) {
+    std::cout << ex.what() << std::endl;
+    return 1;
+  }
 
   std::cout << std::endl << "Estimate for carpet cleaning service" << std::endl;
   std::cout << "The numebr of small rooms: " << numbers_of_small_rooms << std::endl;
   std::cout << "The numebr of large rooms: " << numbers_of_large_rooms << std::endl;
-  std::cout << "The price per small room: $" << price_per_small_room << std::endl;
-  std::cout << "The price per large room: $" << price_per_large_room << std::endl;
-  std::cout 
-    << "The cost: $" 
-    << (price_per_small_room * numbers_of_small_rooms) + (price_per_large_room * numbers_of_large_rooms) 
-    << std::endl;
-  std::cout 
-    << "The tax: $" 
-    << ((price_per_small_room * numbers_of_small_rooms) + (price_per_large_room * numbers_of_large_rooms)) * sales_tax 
-    << std::endl;
+  std::cout << "The price per small room: $" << jacks_rates.rooms[0].price << std::endl;
+  std::cout << "The price per large room: $" << jacks_rates.rooms[1].price << std::endl;
+  std::cout << "The cost: $" << quote.cost << std::endl;
+  std::cout << "The tax: $" << quote.tax << std::endl;
   std::cout << "***************************************" << std::endl;
-  std::cout 
-    << "The total estimate: $" 
-    << ((price_per_small_room * numbers_of_small_rooms) + (price_per_large_room * numbers_of_large_rooms)) +
-      (((price_per_small_room * numbers_of_small_rooms) + (price_per_large_room * numbers_of_large_rooms)) * sales_tax)
-    << std::endl;
-  std::cout << "This estimate is valid for " << estimate_expiry << std::endl;
+  std::cout << "The total estimate: $" << quote.total << std::endl;
+  std::cout << "This estimate is valid for " << jacks_rates.expiry_days << std::endl;
 
   return 0;
 }
@@ -0,0 +1,97 @@
+/*
+
+  - quotes 10'000'000 estimates, or the number given as the first argument, of a rate card
+    of 4 kinds of rooms: with the doubles of the first version of the challenge, with
+    Rate_card::quote one at a time, and with the batch quote of columns of counts, which is
+    4 estimates at a time with AVX2.
+
+  - the batch quote has to give the cents of quote one at a time, the counts are from 0 to
+    20 and every 1000th estimate has a count big enough to be quoted one at a time.
+
+  - build it with AVX2 for the batch, without it is the same loop one estimate at a time:
+      g++ -std=c++17 -O2 -mavx2 index.cpp
+
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../challenge/Estimator.h"
+
+constexpr Rate_card<4> rates {{{{"small", Money {25}}, {"large", Money {35}}, {"hall", Money {12.5}}, {"stairs", Money {8.75}}}}, 0.06, 30};
+
+template <typename F>
+double best_of_5(F f)
+{
+  double best = 1e300;
+  for (int run = 0; run < 5; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10'000'000;
+
+  std::array<std::vector<int>, 4> columns;
+  std::uint32_t seed = 12345;
+  for (std::size_t k = 0; k < 4; ++k)
+  {
+    columns[k].resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      seed = seed * 1664525 + 1013904223;
+      columns[k][i] = i % 1000 == 999 && k == 0 ? 2'000'000'000 : static_cast<int>(seed >> 27) % 21;
+    }
+  }
+  const std::array<const int *, 4> counts {columns[0].data(), columns[1].data(), columns[2].data(), columns[3].data()};
+
+  std::vector<double> double_totals(n);
+  const double doubles = best_of_5([&] {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      double cost = 0;
+      for (std::size_t k = 0; k < 4; ++k)
+        cost += rates.rooms[k].price.to_double() * counts[k][i];
+      double_totals[i] = cost + cost * rates.sales_tax;
+    }
+  });
+
+  std::vector<std::int64_t> one_totals(n);
+  const double one = best_of_5([&] {
+    for (std::size_t i = 0; i < n; ++i)
+      one_totals[i] = rates.quote({counts[0][i], counts[1][i], counts[2][i], counts[3][i]}).total.get_cents();
+  });
+
+  std::vector<std::int64_t> cost(n), tax(n), total(n);
+  const double batch = best_of_5([&] { rates.quote(counts, Quote_columns {cost.data(), tax.data(), total.data()}, n); });
+
+  std::int64_t checksum = 0;
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    checksum += total[i];
+    mismatches += total[i] != one_totals[i] || total[i] != cost[i] + tax[i];
+  }
+
+#if defined(__AVX2__)
+  std::cout << "batch: AVX2" << std::endl;
+#else
+  std::cout << "batch: one at a time" << std::endl;
+#endif
+  std::cout << std::setw(24) << std::left << "doubles" << std::setw(10) << std::right << doubles / n * 1e9 << " ns per estimate" << std::endl;
+  std::cout << std::setw(24) << std::left << "quote one at a time" << std::setw(10) << std::right << one / n * 1e9 << " ns per estimate" << std::endl;
+  std::cout << std::setw(24) << std::left << "batch quote" << std::setw(10) << std::right << batch / n * 1e9 << " ns per estimate" << std::endl;
+  std::cout << "checksum: " << Money::from_cents(checksum) << ", mismatches: " << mismatches << std::endl;
+
+  return mismatches == 0 ? 0 : 1;
+}
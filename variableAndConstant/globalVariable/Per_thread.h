@@ -0,0 +1,130 @@
+#ifndef _PER_THREAD_H_
+#define _PER_THREAD_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+/*
+
+    - Per_thread<Tag, T, Combine> is a global value that every thread changes on its own, a
+      counter of requests, a total of bytes, a maximum, and that is read now and then, header
+      only. a global std::atomic of it is one cache line all the cores write, a lock add
+      each time and the line moving from core to core, a plain global is a data race.
+
+    - every thread has a slot of its own, 64 bytes, on a cache line no other thread writes,
+      add(value) makes it combine(slot, value) with a plain load and store, no lock,
+      read() combines the slots of all the threads, they are read while they are written,
+      each one is a value it had. combine is + by default, a value starts at T {}, any
+      associative and commutative combine that T {} is the identity of works, the max of
+      counts too.
+
+    - a thread takes a slot the first time it adds, any thread, a worker of a pool too, and
+      gives it back when it ends, with its value, for the next thread that starts, the list
+      of slots only grows, to the most threads there were at once. an add after that, from
+      a thread_local destructor, goes to a shared slot with a compare and swap.
+
+    - the Tag makes it a global of its own, Per_thread<struct Requests> is one, and T is a
+      value an std::atomic holds without a lock, a slot is an std::atomic<T> so a read of it
+      is not a race.
+
+*/
+template <typename Tag, typename T = long long, typename Combine = std::plus<T>>
+class Per_thread
+{
+    static_assert(std::atomic<T>::is_always_lock_free, "Per_thread keeps a T in an std::atomic without a lock");
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<T> value {T {}};
+        std::atomic<bool> owned {false};
+        Slot* next {nullptr};
+    };
+
+    // trivially destructible, still there for an add while the thread ends
+    struct Cache
+    {
+        Slot* slot;
+        bool gone;
+    };
+
+    struct Reaper
+    {
+        ~Reaper()
+        {
+            Cache& cache = Per_thread::cache;
+            cache.slot->owned.store(false, std::memory_order_release);
+            cache.slot = nullptr;
+            cache.gone = true;
+        }
+    };
+
+    static inline std::atomic<Slot*> slots {nullptr};
+    static inline Slot shared;
+    static inline thread_local Cache cache {nullptr, false};
+
+    static Slot* claim()
+    {
+        Slot* slot = slots.load(std::memory_order_acquire);
+        for (; slot != nullptr; slot = slot->next)
+        {
+            bool owned {false};
+            if (!slot->owned.load(std::memory_order_relaxed)
+                && slot->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+                break;
+        }
+        if (slot == nullptr)
+        {
+            // never deleted, the values of the threads that ended are in it
+            slot = new Slot;
+            slot->owned.store(true, std::memory_order_relaxed);
+            slot->next = slots.load(std::memory_order_relaxed);
+            while (!slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+        static thread_local Reaper reaper;
+        (void)reaper;
+        return slot;
+    }
+
+public:
+    static void add(const T& value)
+    {
+        if (cache.slot == nullptr)
+        {
+            if (cache.gone)
+            {
+                T seen = shared.value.load(std::memory_order_relaxed);
+                while (!shared.value.compare_exchange_weak(seen, Combine {}(seen, value), std::memory_order_relaxed))
+                {
+                }
+                return;
+            }
+            cache.slot = claim();
+        }
+        // only the thread that owns the slot writes it
+        std::atomic<T>& slot = cache.slot->value;
+        slot.store(Combine {}(slot.load(std::memory_order_relaxed), value), std::memory_order_relaxed);
+    }
+
+    static T read()
+    {
+        T total = shared.value.load(std::memory_order_relaxed);
+        for (const Slot* slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+            total = Combine {}(total, slot->value.load(std::memory_order_relaxed));
+        return total;
+    }
+
+    // the slots there are, the most threads that added at once, and the shared one
+    static std::size_t get_num_slots()
+    {
+        std::size_t count = 1;
+        for (const Slot* slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+            ++count;
+        return count;
+    }
+};
+
+#endif
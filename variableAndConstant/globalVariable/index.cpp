@@ -1,10 +1,70 @@
+/*
+
+  - a global is one variable for the whole program, any function can change it.
+
+  - a global that threads change is a data race, an std::atomic one is a cache line every
+    core writes, a Per_thread one is a slot a thread, summed when it is read, see
+    Per_thread.h. build it with -pthread.
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
+#include "Per_thread.h"
 
 int age {10};
 
+std::atomic<long long> shared_requests {0};
+
+struct Requests;
+struct Largest_request;
+
+struct Max
+{
+  long long operator()(long long a, long long b) const
+  {
+    return std::max(a, b);
+  }
+};
+
+template<typename Fn>
+double in_threads_ms(int num_threads, Fn fn)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i {0}; i < num_threads; i++)
+    threads.emplace_back(fn, i);
+  for (std::thread &thread : threads)
+    thread.join();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 int main()
 {
   std::cout << "The age is" << " " << age << "." << std::endl;
 
+  constexpr int num_threads {4};
+  constexpr long long per_thread {10000000};
+
+  const double atomic_ms = in_threads_ms(num_threads, [](int) {
+    for (long long i {0}; i < per_thread; i++)
+      shared_requests.fetch_add(1, std::memory_order_relaxed);
+  });
+  const double per_thread_ms = in_threads_ms(num_threads, [](int thread) {
+    for (long long i {0}; i < per_thread; i++) {
+      Per_thread<Requests>::add(1);
+      Per_thread<Largest_request, long long, Max>::add(thread * per_thread + i);
+    }
+  });
+
+  std::cout << "std::atomic: " << shared_requests.load() << " requests in " << atomic_ms << " ms" << std::endl;
+  std::cout << "Per_thread: " << Per_thread<Requests>::read() << " requests in " << per_thread_ms << " ms, the largest "
+    << Per_thread<Largest_request, long long, Max>::read() << ", " << Per_thread<Requests>::get_num_slots() << " slots"
+    << std::endl;
+
   return 0;
-}
\ No newline at end of file
+}